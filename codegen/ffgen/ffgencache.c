@@ -0,0 +1,555 @@
+/******************************************************************************
+ * Name         : ffgencache.c
+ *
+ * Copyright    : 2006-2008 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means, electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Platform     : ANSI
+ *
+ * Modifications:-
+ * $Log: ffgencache.c $
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ffgencache.h"
+#include "pvrversion.h"
+
+/* Longest cache file name that can still have the temporary file suffix added */
+#define FFGEN_CACHE_MAX_FILENAME	256
+#define FFGEN_CACHE_TEMP_SUFFIX		".tmp"
+#define FFGEN_CACHE_MAX_TEMP_TAG	32
+
+
+/******************************************************************************
+ * Function Name: FFGenCacheSetupHeader
+ * Inputs       : ui32Magic, ui32KeySizeInDWords
+ * Outputs      : psHeader
+ * Returns      : -
+ * Globals Used : -
+ * Description  : Fills in the header of the cache files and state logs that
+ *				  this build of the compiler can use
+ *****************************************************************************/
+IMG_INTERNAL IMG_VOID IMG_CALLCONV FFGenCacheSetupHeader(FFGenCacheHeader *psHeader, IMG_UINT32 ui32Magic, IMG_UINT32 ui32KeySizeInDWords)
+{
+	psHeader->ui32Magic				= ui32Magic;
+	psHeader->ui32FormatVersion		= FFGEN_CACHE_FORMAT_VERSION;
+	psHeader->ui32DDKBuild			= PVRVERSION_BUILD;
+	psHeader->ui32CoreID			= (IMG_UINT32)SGX_CORE_ID;
+#if defined(SGX_CORE_REV)
+	psHeader->ui32CoreRev			= SGX_CORE_REV;
+#else
+	psHeader->ui32CoreRev			= 0;
+#endif
+	psHeader->ui32KeySizeInDWords	= ui32KeySizeInDWords;
+}
+
+
+/******************************************************************************
+ * Function Name: FFGenCacheValidateRecord
+ * Inputs       : pui32Record, ui32KeySizeInDWords
+ * Outputs      : -
+ * Returns      : IMG_TRUE if the variable sized sections of the record exactly
+ *				  fill the size in its header
+ * Globals Used : -
+ * Description  : Checks a record read from a cache file is self-consistent
+ *****************************************************************************/
+IMG_INTERNAL IMG_BOOL IMG_CALLCONV FFGenCacheValidateRecord(const IMG_UINT32 *pui32Record, IMG_UINT32 ui32KeySizeInDWords)
+{
+	const FFGenCacheRecordHeader *psRecordHeader = (const FFGenCacheRecordHeader *)pui32Record;
+	const FFGenCacheProgram *psProgram;
+	IMG_UINT32 ui32Offset, i;
+
+	ui32Offset = FFGEN_CACHE_RECORD_HEADER_DWORDS + ui32KeySizeInDWords + FFGEN_CACHE_PROGRAM_DWORDS;
+
+	if(psRecordHeader->ui32SizeInDWords < ui32Offset)
+	{
+		return IMG_FALSE;
+	}
+
+	psProgram = (const FFGenCacheProgram *)&pui32Record[FFGEN_CACHE_RECORD_HEADER_DWORDS + ui32KeySizeInDWords];
+
+	if((psProgram->ui32NumUFConstants > FFGEN_CACHE_MAX_RECORD_DWORDS) ||
+	   (psProgram->ui32InstructionCount > FFGEN_CACHE_MAX_RECORD_DWORDS))
+	{
+		return IMG_FALSE;
+	}
+
+	ui32Offset += 2 * psProgram->ui32NumUFConstants;
+
+	for(i = 0; i < psProgram->ui32NumConstantRegs; i++)
+	{
+		if(ui32Offset >= psRecordHeader->ui32SizeInDWords)
+		{
+			return IMG_FALSE;
+		}
+
+		if(pui32Record[ui32Offset] > FFGEN_CACHE_MAX_RECORD_DWORDS)
+		{
+			return IMG_FALSE;
+		}
+
+		ui32Offset += 1 + 2 * pui32Record[ui32Offset];
+	}
+
+	ui32Offset += psProgram->ui32InstructionCount * FFGEN_CACHE_DWORDS_PER_INSTRUCTION;
+
+	return (ui32Offset == psRecordHeader->ui32SizeInDWords) ? IMG_TRUE : IMG_FALSE;
+}
+
+
+/******************************************************************************
+ * Function Name: FFGenCacheGetRecordSize
+ * Inputs       : psFFGenProgram, ui32KeySizeInDWords
+ * Outputs      : -
+ * Returns      : Size of the record of the program, 0 if it is too large
+ * Globals Used : -
+ * Description  : Works out the size of the cache record of a compiled program
+ *****************************************************************************/
+IMG_INTERNAL IMG_UINT32 IMG_CALLCONV FFGenCacheGetRecordSize(FFGenProgram *psFFGenProgram, IMG_UINT32 ui32KeySizeInDWords)
+{
+	FFGenRegList *psRegList;
+	IMG_UINT32 ui32SizeInDWords;
+
+	ui32SizeInDWords = FFGEN_CACHE_RECORD_HEADER_DWORDS + ui32KeySizeInDWords + FFGEN_CACHE_PROGRAM_DWORDS;
+	ui32SizeInDWords += 2 * psFFGenProgram->ui32NumUFConstants;
+	ui32SizeInDWords += psFFGenProgram->psFFGENProgramDetails->ui32InstructionCount * FFGEN_CACHE_DWORDS_PER_INSTRUCTION;
+
+	for(psRegList = psFFGenProgram->psConstantsList; psRegList; psRegList = psRegList->psNext)
+	{
+		ui32SizeInDWords += 1 + 2 * psRegList->psReg->ui32ConstantCount;
+	}
+
+	return (ui32SizeInDWords <= FFGEN_CACHE_MAX_RECORD_DWORDS) ? ui32SizeInDWords : 0;
+}
+
+
+/******************************************************************************
+ * Function Name: FFGenCacheBuildRecord
+ * Inputs       : psFFGenProgram, pui32Key, ui32KeySizeInDWords, ui32KeyHash
+ * Outputs      : pui32Record
+ * Returns      : -
+ * Globals Used : -
+ * Description  : Lays out the cache record of a compiled program in a buffer of
+ *				  the size given by FFGenCacheGetRecordSize()
+ *****************************************************************************/
+IMG_INTERNAL IMG_VOID IMG_CALLCONV FFGenCacheBuildRecord(FFGenProgram		*psFFGenProgram,
+														 const IMG_UINT32	*pui32Key,
+														 IMG_UINT32			ui32KeySizeInDWords,
+														 IMG_UINT32			ui32KeyHash,
+														 IMG_UINT32			*pui32Record)
+{
+	FFGEN_PROGRAM_DETAILS *psFFGENProgramDetails = psFFGenProgram->psFFGENProgramDetails;
+	FFGenCacheRecordHeader *psRecordHeader = (FFGenCacheRecordHeader *)pui32Record;
+	FFGenCacheProgram *psProgram;
+	FFGenRegList *psRegList;
+	IMG_UINT32 *pui32Data;
+	IMG_UINT32 ui32NumRegs = 0;
+
+	for(psRegList = psFFGenProgram->psConstantsList; psRegList; psRegList = psRegList->psNext)
+	{
+		ui32NumRegs++;
+	}
+
+	psRecordHeader->ui32SizeInDWords	= FFGenCacheGetRecordSize(psFFGenProgram, ui32KeySizeInDWords);
+	psRecordHeader->ui32KeyHash			= ui32KeyHash;
+
+	memcpy(&pui32Record[FFGEN_CACHE_RECORD_HEADER_DWORDS], pui32Key, ui32KeySizeInDWords * sizeof(IMG_UINT32));
+
+	psProgram = (FFGenCacheProgram *)&pui32Record[FFGEN_CACHE_RECORD_HEADER_DWORDS + ui32KeySizeInDWords];
+	psProgram->bUSEPerInstanceMode			= psFFGENProgramDetails->bUSEPerInstanceMode;
+	psProgram->ui32InstructionCount			= psFFGENProgramDetails->ui32InstructionCount;
+	psProgram->ui32PrimaryAttributeCount	= psFFGENProgramDetails->ui32PrimaryAttributeCount;
+	psProgram->ui32SecondaryAttributeCount	= psFFGENProgramDetails->ui32SecondaryAttributeCount;
+	psProgram->ui32TemporaryRegisterCount	= psFFGENProgramDetails->ui32TemporaryRegisterCount;
+	psProgram->ui32MemoryConstantCount		= psFFGENProgramDetails->ui32MemoryConstantCount;
+	psProgram->i32SAAddressAdjust			= psFFGENProgramDetails->iSAAddressAdjust;
+	psProgram->ui32NumUFConstants			= psFFGenProgram->ui32NumUFConstants;
+	psProgram->ui32NumConstantRegs			= ui32NumRegs;
+
+	pui32Data = (IMG_UINT32 *)(psProgram + 1);
+
+	if(psFFGenProgram->ui32NumUFConstants)
+	{
+		memcpy(pui32Data, psFFGenProgram->pui32UFConstantData, psFFGenProgram->ui32NumUFConstants * sizeof(IMG_UINT32));
+		pui32Data += psFFGenProgram->ui32NumUFConstants;
+
+		memcpy(pui32Data, psFFGenProgram->pui32UFConstantDest, psFFGenProgram->ui32NumUFConstants * sizeof(IMG_UINT32));
+		pui32Data += psFFGenProgram->ui32NumUFConstants;
+	}
+
+	for(psRegList = psFFGenProgram->psConstantsList; psRegList; psRegList = psRegList->psNext)
+	{
+		FFGenReg *psReg = psRegList->psReg;
+
+		*pui32Data++ = psReg->ui32ConstantCount;
+
+		memcpy(pui32Data, psReg->pui32SrcOffset, psReg->ui32ConstantCount * sizeof(IMG_UINT32));
+		pui32Data += psReg->ui32ConstantCount;
+
+		memcpy(pui32Data, psReg->pui32DstOffset, psReg->ui32ConstantCount * sizeof(IMG_UINT32));
+		pui32Data += psReg->ui32ConstantCount;
+	}
+
+	memcpy(pui32Data, psFFGENProgramDetails->pui32Instructions,
+		   psFFGENProgramDetails->ui32InstructionCount * FFGEN_CACHE_DWORDS_PER_INSTRUCTION * sizeof(IMG_UINT32));
+}
+
+
+/******************************************************************************
+ * Function Name: ReadFileHeader
+ * Inputs       : pFile, ui32Magic, ui32KeySizeInDWords, bCheckBuild
+ * Outputs      : -
+ * Returns      : IMG_TRUE if the file was written for this compiler
+ * Globals Used : -
+ * Description  : Reads and checks the header of a cache file or state log
+ *****************************************************************************/
+static IMG_BOOL ReadFileHeader(FILE *pFile, IMG_UINT32 ui32Magic, IMG_UINT32 ui32KeySizeInDWords, IMG_BOOL bCheckBuild)
+{
+	FFGenCacheHeader sExpectedHeader, sHeader;
+
+	FFGenCacheSetupHeader(&sExpectedHeader, ui32Magic, ui32KeySizeInDWords);
+
+	if(fread(&sHeader, sizeof(sHeader), 1, pFile) != 1)
+	{
+		return IMG_FALSE;
+	}
+
+	if(!bCheckBuild)
+	{
+		/* The keys of a state log don't depend on the compiler that will build them */
+		sHeader.ui32DDKBuild	= sExpectedHeader.ui32DDKBuild;
+		sHeader.ui32CoreID		= sExpectedHeader.ui32CoreID;
+		sHeader.ui32CoreRev		= sExpectedHeader.ui32CoreRev;
+	}
+
+	return (memcmp(&sHeader, &sExpectedHeader, sizeof(FFGenCacheHeader)) == 0) ? IMG_TRUE : IMG_FALSE;
+}
+
+
+/******************************************************************************
+ * Function Name: FFGenCacheReadFile
+ * Inputs       : pszFileName, ui32KeySizeInDWords, hClientHandle, pfnMalloc,
+ *				  pfnFree, pfnRecord
+ * Outputs      : -
+ * Returns      : How much of the file was read
+ * Globals Used : -
+ * Description  : Hands every record of a cache file to pfnRecord. Records are
+ *				  only passed on once they have been checked, so those read
+ *				  before a damaged one can still be used.
+ *****************************************************************************/
+IMG_INTERNAL FFGEN_CACHE_STATUS IMG_CALLCONV FFGenCacheReadFile(const IMG_CHAR		*pszFileName,
+																IMG_UINT32			ui32KeySizeInDWords,
+																IMG_HANDLE			hClientHandle,
+																FFGEN_MALLOCFN		pfnMalloc,
+																FFGEN_FREEFN		pfnFree,
+																FFGEN_CACHE_RECORDFN	pfnRecord)
+{
+	FFGenCacheRecordHeader sRecordHeader;
+	FFGEN_CACHE_STATUS eStatus = FFGEN_CACHE_OK;
+	IMG_UINT32 *pui32Record;
+	size_t uHeaderBytes;
+	FILE *pFile;
+
+	pFile = fopen(pszFileName, "rb");
+
+	if(!pFile)
+	{
+		return FFGEN_CACHE_NOT_FOUND;
+	}
+
+	if(!ReadFileHeader(pFile, FFGEN_CACHE_MAGIC, ui32KeySizeInDWords, IMG_TRUE))
+	{
+		fclose(pFile);
+
+		return FFGEN_CACHE_MISMATCH;
+	}
+
+	while((uHeaderBytes = fread(&sRecordHeader, 1, sizeof(sRecordHeader), pFile)) == sizeof(sRecordHeader))
+	{
+		IMG_UINT32 ui32BodySizeInDWords;
+
+		if((sRecordHeader.ui32SizeInDWords <= FFGEN_CACHE_RECORD_HEADER_DWORDS) ||
+		   (sRecordHeader.ui32SizeInDWords > FFGEN_CACHE_MAX_RECORD_DWORDS))
+		{
+			/* Nothing after a bad size can be trusted */
+			eStatus = FFGEN_CACHE_DAMAGED;
+
+			break;
+		}
+
+		pui32Record = pfnMalloc(hClientHandle, sRecordHeader.ui32SizeInDWords * sizeof(IMG_UINT32));
+
+		if(!pui32Record)
+		{
+			eStatus = FFGEN_CACHE_NO_MEMORY;
+
+			break;
+		}
+
+		memcpy(pui32Record, &sRecordHeader, sizeof(sRecordHeader));
+
+		ui32BodySizeInDWords = sRecordHeader.ui32SizeInDWords - FFGEN_CACHE_RECORD_HEADER_DWORDS;
+
+		if((fread(&pui32Record[FFGEN_CACHE_RECORD_HEADER_DWORDS], sizeof(IMG_UINT32), ui32BodySizeInDWords, pFile) != ui32BodySizeInDWords) ||
+		   !FFGenCacheValidateRecord(pui32Record, ui32KeySizeInDWords))
+		{
+			pfnFree(hClientHandle, pui32Record);
+
+			eStatus = FFGEN_CACHE_DAMAGED;
+
+			break;
+		}
+
+		if(!pfnRecord(hClientHandle, pui32Record))
+		{
+			pfnFree(hClientHandle, pui32Record);
+		}
+	}
+
+	/* The file must end exactly after a record, not part way through a header */
+	if((eStatus == FFGEN_CACHE_OK) && ((uHeaderBytes != 0) || !feof(pFile)))
+	{
+		eStatus = FFGEN_CACHE_DAMAGED;
+	}
+
+	fclose(pFile);
+
+	return eStatus;
+}
+
+
+/******************************************************************************
+ * Function Name: FFGenCacheWriteFile
+ * Inputs       : pszFileName, pszTempTag, ui32KeySizeInDWords, hClientHandle,
+ *				  pfnNextRecord
+ * Outputs      : -
+ * Returns      : IMG_TRUE if the cache file was replaced
+ * Globals Used : -
+ * Description  : Replaces a cache file with the records returned by
+ *				  pfnNextRecord. The records are written to a temporary file
+ *				  which is then renamed over the cache, so the cache is never
+ *				  seen partly written even if the process dies here.
+ *				  pszTempTag, if not IMG_NULL, goes into the temporary file
+ *				  name so that writers that may run at the same time each
+ *				  have their own.
+ *****************************************************************************/
+IMG_INTERNAL IMG_BOOL IMG_CALLCONV FFGenCacheWriteFile(const IMG_CHAR			*pszFileName,
+													   const IMG_CHAR			*pszTempTag,
+													   IMG_UINT32				ui32KeySizeInDWords,
+													   IMG_HANDLE				hClientHandle,
+													   FFGEN_CACHE_NEXTRECORDFN	pfnNextRecord)
+{
+	IMG_CHAR szTempFileName[FFGEN_CACHE_MAX_FILENAME + FFGEN_CACHE_MAX_TEMP_TAG + sizeof(FFGEN_CACHE_TEMP_SUFFIX)];
+	FFGenCacheHeader sHeader;
+	const IMG_UINT32 *pui32Record;
+	IMG_BOOL bSuccess = IMG_TRUE;
+	FILE *pFile;
+
+	if((strlen(pszFileName) >= FFGEN_CACHE_MAX_FILENAME) ||
+	   (pszTempTag && (strlen(pszTempTag) >= FFGEN_CACHE_MAX_TEMP_TAG)))
+	{
+		return IMG_FALSE;
+	}
+
+	strcpy(szTempFileName, pszFileName);
+
+	if(pszTempTag)
+	{
+		strcat(szTempFileName, pszTempTag);
+	}
+
+	strcat(szTempFileName, FFGEN_CACHE_TEMP_SUFFIX);
+
+	pFile = fopen(szTempFileName, "wb");
+
+	if(!pFile)
+	{
+		return IMG_FALSE;
+	}
+
+	FFGenCacheSetupHeader(&sHeader, FFGEN_CACHE_MAGIC, ui32KeySizeInDWords);
+
+	if(fwrite(&sHeader, sizeof(sHeader), 1, pFile) != 1)
+	{
+		bSuccess = IMG_FALSE;
+	}
+
+	while(bSuccess && ((pui32Record = pfnNextRecord(hClientHandle)) != IMG_NULL))
+	{
+		IMG_UINT32 ui32SizeInDWords = ((const FFGenCacheRecordHeader *)pui32Record)->ui32SizeInDWords;
+
+		if(fwrite(pui32Record, sizeof(IMG_UINT32), ui32SizeInDWords, pFile) != ui32SizeInDWords)
+		{
+			bSuccess = IMG_FALSE;
+		}
+	}
+
+	if(fclose(pFile) != 0)
+	{
+		bSuccess = IMG_FALSE;
+	}
+
+	if(bSuccess && (rename(szTempFileName, pszFileName) != 0))
+	{
+		/* Not every file system lets rename() replace an existing file */
+		remove(pszFileName);
+
+		if(rename(szTempFileName, pszFileName) != 0)
+		{
+			bSuccess = IMG_FALSE;
+		}
+	}
+
+	if(!bSuccess)
+	{
+		remove(szTempFileName);
+	}
+
+	return bSuccess;
+}
+
+
+/******************************************************************************
+ * Function Name: FFGenStateLogOpen
+ * Inputs       : pszFileName, ui32KeySizeInDWords
+ * Outputs      : -
+ * Returns      : The state log, IMG_NULL if it can't be opened
+ * Globals Used : -
+ * Description  : Opens a state log for appending, starting it again if it is
+ *				  new or was written for keys of another size
+ *****************************************************************************/
+IMG_INTERNAL IMG_VOID * IMG_CALLCONV FFGenStateLogOpen(const IMG_CHAR *pszFileName, IMG_UINT32 ui32KeySizeInDWords)
+{
+	FFGenCacheHeader sHeader;
+	IMG_BOOL bUsable = IMG_FALSE;
+	FILE *pFile;
+
+	pFile = fopen(pszFileName, "rb");
+
+	if(pFile)
+	{
+		bUsable = ReadFileHeader(pFile, FFGEN_STATELOG_MAGIC, ui32KeySizeInDWords, IMG_FALSE);
+
+		fclose(pFile);
+	}
+
+	if(bUsable)
+	{
+		return (IMG_VOID *)fopen(pszFileName, "ab");
+	}
+
+	pFile = fopen(pszFileName, "wb");
+
+	if(!pFile)
+	{
+		return IMG_NULL;
+	}
+
+	FFGenCacheSetupHeader(&sHeader, FFGEN_STATELOG_MAGIC, ui32KeySizeInDWords);
+
+	if((fwrite(&sHeader, sizeof(sHeader), 1, pFile) != 1) || fflush(pFile))
+	{
+		fclose(pFile);
+
+		return IMG_NULL;
+	}
+
+	return (IMG_VOID *)pFile;
+}
+
+
+/******************************************************************************
+ * Function Name: FFGenStateLogAppend
+ * Inputs       : pvStateLog, pui32Key, ui32KeySizeInDWords
+ * Outputs      : -
+ * Returns      : IMG_TRUE if the key was written
+ * Globals Used : -
+ * Description  : Adds a key to a state log. A crash can at worst truncate the
+ *				  last key, which FFGenStateLogRead() ignores.
+ *****************************************************************************/
+IMG_INTERNAL IMG_BOOL IMG_CALLCONV FFGenStateLogAppend(IMG_VOID *pvStateLog, const IMG_UINT32 *pui32Key, IMG_UINT32 ui32KeySizeInDWords)
+{
+	FILE *pFile = (FILE *)pvStateLog;
+
+	if((fwrite(pui32Key, sizeof(IMG_UINT32), ui32KeySizeInDWords, pFile) != ui32KeySizeInDWords) || fflush(pFile))
+	{
+		return IMG_FALSE;
+	}
+
+	return IMG_TRUE;
+}
+
+
+/******************************************************************************
+ * Function Name: FFGenStateLogClose
+ * Inputs       : pvStateLog
+ * Outputs      : -
+ * Returns      : -
+ * Globals Used : -
+ * Description  : Closes a state log opened by FFGenStateLogOpen()
+ *****************************************************************************/
+IMG_INTERNAL IMG_VOID IMG_CALLCONV FFGenStateLogClose(IMG_VOID *pvStateLog)
+{
+	fclose((FILE *)pvStateLog);
+}
+
+
+/******************************************************************************
+ * Function Name: FFGenStateLogRead
+ * Inputs       : pszFileName, ui32KeySizeInDWords, hClientHandle, pfnKey
+ * Outputs      : -
+ * Returns      : How much of the file was read
+ * Globals Used : -
+ * Description  : Hands every whole key of a state log to pfnKey, duplicates
+ *				  included
+ *****************************************************************************/
+IMG_INTERNAL FFGEN_CACHE_STATUS IMG_CALLCONV FFGenStateLogRead(const IMG_CHAR		*pszFileName,
+															   IMG_UINT32			ui32KeySizeInDWords,
+															   IMG_HANDLE			hClientHandle,
+															   FFGEN_STATELOG_KEYFN	pfnKey)
+{
+	IMG_UINT32 aui32Key[FFGEN_CACHE_MAX_KEY_DWORDS];
+	FILE *pFile;
+
+	if(ui32KeySizeInDWords > FFGEN_CACHE_MAX_KEY_DWORDS)
+	{
+		return FFGEN_CACHE_MISMATCH;
+	}
+
+	pFile = fopen(pszFileName, "rb");
+
+	if(!pFile)
+	{
+		return FFGEN_CACHE_NOT_FOUND;
+	}
+
+	if(!ReadFileHeader(pFile, FFGEN_STATELOG_MAGIC, ui32KeySizeInDWords, IMG_FALSE))
+	{
+		fclose(pFile);
+
+		return FFGEN_CACHE_MISMATCH;
+	}
+
+	while(fread(aui32Key, sizeof(IMG_UINT32), ui32KeySizeInDWords, pFile) == ui32KeySizeInDWords)
+	{
+		pfnKey(hClientHandle, aui32Key);
+	}
+
+	fclose(pFile);
+
+	return FFGEN_CACHE_OK;
+}
+
+/******************************************************************************
+ End of file (ffgencache.c)
+******************************************************************************/
@@ -0,0 +1,170 @@
+/******************************************************************************
+ * Name         : ffgencache.h
+ *
+ * Copyright    : 2006-2008 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means, electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Platform     : ANSI
+ *
+ * Modifications:-
+ * $Log: ffgencache.h $
+ *****************************************************************************/
+
+#ifndef __gl_ffgencache_h_
+#define __gl_ffgencache_h_
+
+#include "img_types.h"
+#include "ffgen.h"
+
+/*
+	On-disk format of the persistent FFGen TNL variant cache.
+
+	The file is a FFGenCacheHeader followed by any number of records. Every
+	field is a little-endian 32 bit word. A record is laid out as:
+
+		FFGenCacheRecordHeader
+		IMG_UINT32				aui32Key[ui32KeySizeInDWords]
+		FFGenCacheProgram
+		IMG_UINT32				aui32UFConstantData[ui32NumUFConstants]
+		IMG_UINT32				aui32UFConstantDest[ui32NumUFConstants]
+
+		for each of ui32NumConstantRegs constant registers, in program order:
+			IMG_UINT32			ui32ConstantCount
+			IMG_UINT32			aui32SrcOffset[ui32ConstantCount]
+			IMG_UINT32			aui32DstOffset[ui32ConstantCount]
+
+		IMG_UINT32				aui32Instructions[ui32InstructionCount * FFGEN_CACHE_DWORDS_PER_INSTRUCTION]
+
+	The key of a TNL program is its FFTNLGenDesc followed by the valid shader
+	output masks handed to the USC, which depend on texture state that is not
+	part of the description. The header records enough about the driver that
+	wrote the file for it to be rejected as a whole when it can no longer be
+	trusted.
+
+	Cache files are only ever replaced as a whole: they are written to
+	<name>.tmp which is then renamed over <name>, so a reader sees either the
+	old or the new cache and never a partly written one.
+
+	A state log is a FFGenCacheHeader, with FFGEN_STATELOG_MAGIC, followed by
+	the keys of every TNL program a driver generated. It holds no code, so it
+	stays useful after a driver update and is the input from which the cache
+	is built offline.
+*/
+#define FFGEN_CACHE_MAGIC					0x4E474646	/* "FFGN" */
+#define FFGEN_STATELOG_MAGIC				0x4C534646	/* "FFSL" */
+#define FFGEN_CACHE_FORMAT_VERSION			1
+
+#define FFGEN_CACHE_DWORDS_PER_INSTRUCTION	2
+
+/* Upper bounds used to reject corrupt records before anything is allocated */
+#define FFGEN_CACHE_MAX_KEY_DWORDS			1024
+#define FFGEN_CACHE_MAX_RECORD_DWORDS		(64 * 1024)
+
+typedef struct FFGenCacheHeader_TAG
+{
+	IMG_UINT32	ui32Magic;				/* FFGEN_CACHE_MAGIC */
+	IMG_UINT32	ui32FormatVersion;		/* FFGEN_CACHE_FORMAT_VERSION */
+	IMG_UINT32	ui32DDKBuild;			/* PVRVERSION_BUILD of the compiler that produced the code */
+	IMG_UINT32	ui32CoreID;				/* SGX core the code was compiled for */
+	IMG_UINT32	ui32CoreRev;			/* SGX core revision the code was compiled for */
+	IMG_UINT32	ui32KeySizeInDWords;	/* Size of the key at the start of every record */
+
+} FFGenCacheHeader;
+
+typedef struct FFGenCacheRecordHeader_TAG
+{
+	IMG_UINT32	ui32SizeInDWords;		/* Size of the whole record, including this header */
+	IMG_UINT32	ui32KeyHash;			/* Hash of the key, as used by the driver's hash table */
+
+} FFGenCacheRecordHeader;
+
+typedef struct FFGenCacheProgram_TAG
+{
+	IMG_UINT32	bUSEPerInstanceMode;
+	IMG_UINT32	ui32InstructionCount;
+	IMG_UINT32	ui32PrimaryAttributeCount;
+	IMG_UINT32	ui32SecondaryAttributeCount;
+	IMG_UINT32	ui32TemporaryRegisterCount;
+	IMG_UINT32	ui32MemoryConstantCount;
+	IMG_INT32	i32SAAddressAdjust;
+	IMG_UINT32	ui32NumUFConstants;
+	IMG_UINT32	ui32NumConstantRegs;
+
+} FFGenCacheProgram;
+
+#define FFGEN_CACHE_HEADER_DWORDS			(sizeof(FFGenCacheHeader) / sizeof(IMG_UINT32))
+#define FFGEN_CACHE_RECORD_HEADER_DWORDS	(sizeof(FFGenCacheRecordHeader) / sizeof(IMG_UINT32))
+#define FFGEN_CACHE_PROGRAM_DWORDS			(sizeof(FFGenCacheProgram) / sizeof(IMG_UINT32))
+
+#define FFGEN_CACHE_NUM_OUTPUT_MASKS		4
+#define FFGEN_CACHE_TNL_DESC_DWORDS			(sizeof(FFTNLGenDesc) / sizeof(IMG_UINT32))
+#define FFGEN_CACHE_TNL_KEY_DWORDS			(FFGEN_CACHE_TNL_DESC_DWORDS + FFGEN_CACHE_NUM_OUTPUT_MASKS)
+
+typedef enum
+{
+	FFGEN_CACHE_OK			= 0,	/* The whole file was read */
+	FFGEN_CACHE_NOT_FOUND	= 1,	/* The file couldn't be opened */
+	FFGEN_CACHE_MISMATCH	= 2,	/* The file was written by another driver or is of another kind */
+	FFGEN_CACHE_DAMAGED		= 3,	/* Reading stopped at a damaged record */
+	FFGEN_CACHE_NO_MEMORY	= 4		/* Reading stopped when a record couldn't be allocated */
+
+} FFGEN_CACHE_STATUS;
+
+/* Takes a record read from a cache file. Returns IMG_TRUE if it keeps the record, otherwise it is freed */
+typedef IMG_BOOL (IMG_CALLCONV *FFGEN_CACHE_RECORDFN)(IMG_HANDLE hClientHandle, IMG_UINT32 *pui32Record);
+
+/* Returns the next record to write to a cache file, or IMG_NULL after the last */
+typedef const IMG_UINT32 * (IMG_CALLCONV *FFGEN_CACHE_NEXTRECORDFN)(IMG_HANDLE hClientHandle);
+
+/* Takes a key read from a state log */
+typedef IMG_VOID (IMG_CALLCONV *FFGEN_STATELOG_KEYFN)(IMG_HANDLE hClientHandle, const IMG_UINT32 *pui32Key);
+
+IMG_INTERNAL IMG_VOID IMG_CALLCONV FFGenCacheSetupHeader(FFGenCacheHeader *psHeader, IMG_UINT32 ui32Magic, IMG_UINT32 ui32KeySizeInDWords);
+
+IMG_INTERNAL IMG_BOOL IMG_CALLCONV FFGenCacheValidateRecord(const IMG_UINT32 *pui32Record, IMG_UINT32 ui32KeySizeInDWords);
+
+IMG_INTERNAL IMG_UINT32 IMG_CALLCONV FFGenCacheGetRecordSize(FFGenProgram *psFFGenProgram, IMG_UINT32 ui32KeySizeInDWords);
+
+IMG_INTERNAL IMG_VOID IMG_CALLCONV FFGenCacheBuildRecord(FFGenProgram		*psFFGenProgram,
+														 const IMG_UINT32	*pui32Key,
+														 IMG_UINT32			ui32KeySizeInDWords,
+														 IMG_UINT32			ui32KeyHash,
+														 IMG_UINT32			*pui32Record);
+
+IMG_INTERNAL FFGEN_CACHE_STATUS IMG_CALLCONV FFGenCacheReadFile(const IMG_CHAR		*pszFileName,
+																IMG_UINT32			ui32KeySizeInDWords,
+																IMG_HANDLE			hClientHandle,
+																FFGEN_MALLOCFN		pfnMalloc,
+																FFGEN_FREEFN		pfnFree,
+																FFGEN_CACHE_RECORDFN	pfnRecord);
+
+IMG_INTERNAL IMG_BOOL IMG_CALLCONV FFGenCacheWriteFile(const IMG_CHAR			*pszFileName,
+													   const IMG_CHAR			*pszTempTag,
+													   IMG_UINT32				ui32KeySizeInDWords,
+													   IMG_HANDLE				hClientHandle,
+													   FFGEN_CACHE_NEXTRECORDFN	pfnNextRecord);
+
+IMG_INTERNAL IMG_VOID * IMG_CALLCONV FFGenStateLogOpen(const IMG_CHAR *pszFileName, IMG_UINT32 ui32KeySizeInDWords);
+
+IMG_INTERNAL IMG_BOOL IMG_CALLCONV FFGenStateLogAppend(IMG_VOID *pvStateLog, const IMG_UINT32 *pui32Key, IMG_UINT32 ui32KeySizeInDWords);
+
+IMG_INTERNAL IMG_VOID IMG_CALLCONV FFGenStateLogClose(IMG_VOID *pvStateLog);
+
+IMG_INTERNAL FFGEN_CACHE_STATUS IMG_CALLCONV FFGenStateLogRead(const IMG_CHAR		*pszFileName,
+															   IMG_UINT32			ui32KeySizeInDWords,
+															   IMG_HANDLE			hClientHandle,
+															   FFGEN_STATELOG_KEYFN	pfnKey);
+
+#endif /* __gl_ffgencache_h_ */
+
+/******************************************************************************
+ End of file (ffgencache.h)
+******************************************************************************/
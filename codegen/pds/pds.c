@@ -386,12 +386,13 @@ PDS_CALLCONV IMG_UINT32 * PDSGeneratePixelEventProgram	(PPDS_PIXEL_EVENT_PROGRAM
  Function Name	: PDSGeneratePixelShaderSAProgram
  Inputs			: psProgram		- pointer to the PDS pixel shader secondary attributes program
 				: pui32Buffer		- pointer to the buffer for the program
- Outputs		: none
+ Outputs		: psPDSPixelShaderSAProgramInfo - patch information for the program (optional)
  Returns		: pointer to just beyond the buffer for the program
  Description	: Generates the PDS pixel shader seconary attributes program
 *****************************************************************************/
-PDS_CALLCONV IMG_UINT32 * PDSGeneratePixelShaderSAProgram	(PPDS_PIXEL_SHADER_SA_PROGRAM	psProgram,
-															 IMG_UINT32 *					pui32Buffer)
+PDS_CALLCONV IMG_UINT32 * PDSGeneratePixelShaderSAProgram	(PPDS_PIXEL_SHADER_SA_PROGRAM		psProgram,
+															 IMG_UINT32 *						pui32Buffer,
+															 PPDS_PIXEL_SHADER_SA_PROGRAM_INFO	psPDSPixelShaderSAProgramInfo)
 {
 	IMG_UINT32 *	pui32Constants;
 	IMG_UINT32	ui32NextDS0Constant;
@@ -418,6 +419,19 @@ PDS_CALLCONV IMG_UINT32 * PDSGeneratePixelShaderSAProgram	(PPDS_PIXEL_SHADER_SA_
 	ui32NextDS0Constant	= PDS_DS0_CONST_BLOCK_BASE;
 	ui32NextDS1Constant	= PDS_DS1_CONST_BLOCK_BASE;
 	
+	if (psPDSPixelShaderSAProgramInfo)
+	{
+		psPDSPixelShaderSAProgramInfo->ui32NumDMAKicks    = psProgram->ui32NumDMAKicks;
+		psPDSPixelShaderSAProgramInfo->bKickUSE           = (psProgram->bKickUSE || psProgram->bKickUSEDummyProgram) ? IMG_TRUE : IMG_FALSE;
+		psPDSPixelShaderSAProgramInfo->bWriteTilePosition = psProgram->bWriteTilePosition;
+#if defined(SGX_FEATURE_ALPHATEST_SECONDARY)
+		psPDSPixelShaderSAProgramInfo->bIterateZAbs       = psProgram->bIterateZAbs;
+#endif
+#if defined(FIX_HW_BRN_22249)
+		psPDSPixelShaderSAProgramInfo->bGenerateTileAddress = psProgram->bGenerateTileAddress;
+#endif
+	}
+	
 	/*
 		Copy the DMA control words to constants
 	*/
@@ -427,17 +441,35 @@ PDS_CALLCONV IMG_UINT32 * PDSGeneratePixelShaderSAProgram	(PPDS_PIXEL_SHADER_SA_
 		PDSSetDS0Constant(pui32Constants, ui32DS0Constant + 0, psProgram->aui32DMAControl[0]);
 		PDSSetDS0Constant(pui32Constants, ui32DS0Constant + 1, psProgram->aui32DMAControl[1]);
 		
+		if (psPDSPixelShaderSAProgramInfo)
+		{
+			psPDSPixelShaderSAProgramInfo->aui32DMAControlOffsets[0] = PDSGetDS0ConstantOffset(ui32DS0Constant + 0);
+			psPDSPixelShaderSAProgramInfo->aui32DMAControlOffsets[1] = PDSGetDS0ConstantOffset(ui32DS0Constant + 1);
+		}
+		
 		if (psProgram->ui32NumDMAKicks >= 2)
 		{
 			ui32DS0Constant		= PDSGetConstants(&ui32NextDS0Constant, 2);
 			PDSSetDS0Constant(pui32Constants, ui32DS0Constant + 0, psProgram->aui32DMAControl[2]);
 			PDSSetDS0Constant(pui32Constants, ui32DS0Constant + 1, psProgram->aui32DMAControl[3]);
 			
+			if (psPDSPixelShaderSAProgramInfo)
+			{
+				psPDSPixelShaderSAProgramInfo->aui32DMAControlOffsets[2] = PDSGetDS0ConstantOffset(ui32DS0Constant + 0);
+				psPDSPixelShaderSAProgramInfo->aui32DMAControlOffsets[3] = PDSGetDS0ConstantOffset(ui32DS0Constant + 1);
+			}
+			
 			if (psProgram->ui32NumDMAKicks == 3)
 			{
 				ui32DS1Constant		= PDSGetConstants(&ui32NextDS1Constant, 2);
 				PDSSetDS1Constant(pui32Constants, ui32DS1Constant + 0, psProgram->aui32DMAControl[4]);
 				PDSSetDS1Constant(pui32Constants, ui32DS1Constant + 1, psProgram->aui32DMAControl[5]);
+				
+				if (psPDSPixelShaderSAProgramInfo)
+				{
+					psPDSPixelShaderSAProgramInfo->aui32DMAControlOffsets[4] = PDSGetDS1ConstantOffset(ui32DS1Constant + 0);
+					psPDSPixelShaderSAProgramInfo->aui32DMAControlOffsets[5] = PDSGetDS1ConstantOffset(ui32DS1Constant + 1);
+				}
 			}
 			
 		}
@@ -447,6 +479,11 @@ PDS_CALLCONV IMG_UINT32 * PDSGeneratePixelShaderSAProgram	(PPDS_PIXEL_SHADER_SA_
 	{
 		ui32DS1Constant		= PDSGetConstants(&ui32NextDS1Constant, 1);
 		PDSSetDS1Constant(pui32Constants, ui32DS1Constant, (psProgram->uTilePositionAttrDest << EURASIA_PDS_DOUTA1_AO_SHIFT));
+		
+		if (psPDSPixelShaderSAProgramInfo)
+		{
+			psPDSPixelShaderSAProgramInfo->ui32TilePositionAttrDestOffset = PDSGetDS1ConstantOffset(ui32DS1Constant);
+		}
 	}
 	
 #if defined(FIX_HW_BRN_22249)
@@ -456,6 +493,11 @@ PDS_CALLCONV IMG_UINT32 * PDSGeneratePixelShaderSAProgram	(PPDS_PIXEL_SHADER_SA_
 		PDSSetDS0Constant(pui32Constants, ui32DS0Constant + 0, psProgram->ui32RenderBaseAddress);
 		PDSSetDS0Constant(pui32Constants, ui32DS0Constant + 1, (0 << EURASIA_PDS_DOUTA1_AO_SHIFT));
 		
+		if (psPDSPixelShaderSAProgramInfo)
+		{
+			psPDSPixelShaderSAProgramInfo->ui32RenderBaseAddressOffset = PDSGetDS0ConstantOffset(ui32DS0Constant + 0);
+		}
+		
 		ui32DS1Constant		= PDSGetConstants(&ui32NextDS1Constant, 1);
 		PDSSetDS1Constant(pui32Constants, ui32DS1Constant + 0, ~EURASIA_PDS_IR0_PDM_TILEY_CLRMSK);
 	}
@@ -469,6 +511,13 @@ PDS_CALLCONV IMG_UINT32 * PDSGeneratePixelShaderSAProgram	(PPDS_PIXEL_SHADER_SA_
 		
 		ui32DS1Constant		= PDSGetConstants(&ui32NextDS1Constant, 1);
 		PDSSetDS1Constant(pui32Constants, ui32DS1Constant + 0, psProgram->aui32USETaskControl[2]);
+		
+		if (psPDSPixelShaderSAProgramInfo)
+		{
+			psPDSPixelShaderSAProgramInfo->aui32USETaskControlOffsets[0] = PDSGetDS0ConstantOffset(ui32DS0Constant + 0);
+			psPDSPixelShaderSAProgramInfo->aui32USETaskControlOffsets[1] = PDSGetDS0ConstantOffset(ui32DS0Constant + 1);
+			psPDSPixelShaderSAProgramInfo->aui32USETaskControlOffsets[2] = PDSGetDS1ConstantOffset(ui32DS1Constant + 0);
+		}
 	}
 	
 #if defined(SGX_FEATURE_ALPHATEST_SECONDARY)
@@ -669,6 +718,11 @@ PDS_CALLCONV IMG_UINT32 * PDSGeneratePixelShaderSAProgram	(PPDS_PIXEL_SHADER_SA_
 	psProgram->pui32DataSegment	= pui32Constants;
 	psProgram->ui32DataSize		= ui32NumConstants * sizeof(IMG_UINT32);
 	
+	if (psPDSPixelShaderSAProgramInfo)
+	{
+		psPDSPixelShaderSAProgramInfo->ui32DataSize = psProgram->ui32DataSize;
+	}
+	
 	return pui32Instruction;
 }
 
@@ -1078,13 +1132,14 @@ static IMG_UINT32 PDSEncodeSimpleMOVS(IMG_UINT32 ui32Dest, IMG_UINT32 ui32DSCons
  Function Name	: PDSGeneratePixelShaderProgram
  Inputs			: psProgram		- pointer to the PDS pixel shader program
 				: pui32Buffer		- pointer to the buffer for the program
- Outputs		: none
+ Outputs		: psPDSPixelShaderProgramInfo - patch information for the program (optional)
  Returns		: pointer to just beyond the buffer for the program
  Description	: Generates the PDS pixel shader program
 *****************************************************************************/
-PDS_CALLCONV IMG_UINT32* PDSGeneratePixelShaderProgram	(PPDS_TEXTURE_IMAGE_UNIT      psTextureImageUnits,
-														 PPDS_PIXEL_SHADER_PROGRAM	  psProgram,
-														 IMG_UINT32                  *pui32Buffer)
+PDS_CALLCONV IMG_UINT32* PDSGeneratePixelShaderProgram	(PPDS_TEXTURE_IMAGE_UNIT         psTextureImageUnits,
+														 PPDS_PIXEL_SHADER_PROGRAM	     psProgram,
+														 IMG_UINT32                     *pui32Buffer,
+														 PPDS_PIXEL_SHADER_PROGRAM_INFO  psPDSPixelShaderProgramInfo)
 {
 	IMG_UINT32 *pui32Constants;
 	IMG_UINT32	ui32NextDS0Constant;
@@ -1104,6 +1159,8 @@ PDS_CALLCONV IMG_UINT32* PDSGeneratePixelShaderProgram	(PPDS_TEXTURE_IMAGE_UNIT
 	IMG_UINT32 *pui32LastIterationIssue;
 	#endif
 	IMG_BOOL	abCombinedWithPreviousIssue[PVRD3D_MAXIMUM_ITERATIONS];
+	IMG_UINT32	aui32UnusedOffsets[EURASIA_TAG_TEXTURE_STATE_SIZE];
+	IMG_UINT32 *pui32Offsets;
 #if defined(SGX_FEATURE_PDS_EXTENDED_SOURCES)
 	IMG_UINT8	aui8TagSize[PVRD3D_MAXIMUM_ITERATIONS];
 #endif
@@ -1122,14 +1179,24 @@ PDS_CALLCONV IMG_UINT32* PDSGeneratePixelShaderProgram	(PPDS_TEXTURE_IMAGE_UNIT
 		Copy the USE task control words to constants
 	*/
 	
+	pui32Offsets = psPDSPixelShaderProgramInfo ? psPDSPixelShaderProgramInfo->aui32USETaskControlOffsets : aui32UnusedOffsets;
+	
 	ui32Constant = PDSGetNextConstant(&ui32NextDS0Constant, &ui32NextDS1Constant);
 	pui32Constants[ui32Constant] = psProgram->aui32USETaskControl[0];
+	pui32Offsets[0] = ui32Constant;
 	
 	ui32Constant = PDSGetNextConstant(&ui32NextDS0Constant, &ui32NextDS1Constant);
 	pui32Constants[ui32Constant] = psProgram->aui32USETaskControl[1];
+	pui32Offsets[1] = ui32Constant;
 	
 	ui32Constant = PDSGetNextConstant(&ui32NextDS0Constant, &ui32NextDS1Constant);
 	pui32Constants[ui32Constant] = psProgram->aui32USETaskControl[2];
+	pui32Offsets[2] = ui32Constant;
+	
+	if (psPDSPixelShaderProgramInfo)
+	{
+		psPDSPixelShaderProgramInfo->ui32NumTextureReads = 0;
+	}
 	
 	/*
 		Copy the FPU iterator and texture control words to constants
@@ -1220,17 +1287,36 @@ PDS_CALLCONV IMG_UINT32* PDSGeneratePixelShaderProgram	(PPDS_TEXTURE_IMAGE_UNIT
 			}
 #endif
 
+			/* Record where the texture control words go so they can be patched later */
+			if (psPDSPixelShaderProgramInfo)
+			{
+				IMG_UINT32 ui32Read = psPDSPixelShaderProgramInfo->ui32NumTextureReads++;
+				
+				PDS_ASSERT(ui32Read < PDS_MAX_TEXTURE_READS);
+				
+				psPDSPixelShaderProgramInfo->aui32TAGLayers[ui32Read] = ui32TagIssue;
+				pui32Offsets = psPDSPixelShaderProgramInfo->aui32TAGControlWordOffsets[ui32Read];
+			}
+			else
+			{
+				pui32Offsets = aui32UnusedOffsets;
+			}
+
 			pui32Constants[ui32Constant] = psTextureCtl->ui32TAGControlWord0;
+			pui32Offsets[0] = ui32Constant;
 			
 			ui32Constant = PDSGetNextConstant(&ui32NextDS0Constant, &ui32NextDS1Constant);
 			pui32Constants[ui32Constant] = psTextureCtl->ui32TAGControlWord1;
+			pui32Offsets[1] = ui32Constant;
 			
 			ui32Constant = PDSGetNextConstant(&ui32NextDS0Constant, &ui32NextDS1Constant);
 			pui32Constants[ui32Constant] = psTextureCtl->ui32TAGControlWord2;
+			pui32Offsets[2] = ui32Constant;
 			
 #if(EURASIA_TAG_TEXTURE_STATE_SIZE == 4)
 			ui32Constant = PDSGetNextConstant(&ui32NextDS0Constant, &ui32NextDS1Constant);
 			pui32Constants[ui32Constant] = psTextureCtl->ui32TAGControlWord3;
+			pui32Offsets[3] = ui32Constant;
 #endif
 		}
 		else
@@ -1358,6 +1444,12 @@ PDS_CALLCONV IMG_UINT32* PDSGeneratePixelShaderProgram	(PPDS_TEXTURE_IMAGE_UNIT
 	psProgram->pui32DataSegment	= pui32Constants;
 	psProgram->ui32DataSize		= ui32NumConstants * sizeof(IMG_UINT32);
 	
+	if (psPDSPixelShaderProgramInfo)
+	{
+		psPDSPixelShaderProgramInfo->ui32DataSize        = psProgram->ui32DataSize;
+		psPDSPixelShaderProgramInfo->ui32NumFPUIterators = psProgram->ui32NumFPUIterators;
+	}
+	
 	return pui32Instruction;
 }
 
@@ -6649,12 +6741,13 @@ PDS_CALLCONV IMG_UINT32 * PDSGeneratePixelEventProgram	(PPDS_PIXEL_EVENT_PROGRAM
  Function Name	: PDSGeneratePixelShaderSAProgram
  Inputs			: psProgram		- pointer to the PDS pixel shader secondary attributes program
 				: pui32Buffer		- pointer to the buffer for the program
- Outputs		: none
+ Outputs		: psPDSPixelShaderSAProgramInfo - patch information for the program (optional)
  Returns		: pointer to just beyond the buffer for the program
  Description	: Generates the PDS pixel shader seconary attributes program
 *****************************************************************************/
-PDS_CALLCONV IMG_UINT32 * PDSGeneratePixelShaderSAProgram	(PPDS_PIXEL_SHADER_SA_PROGRAM	psProgram,
-															 IMG_UINT32 *					pui32Buffer)
+PDS_CALLCONV IMG_UINT32 * PDSGeneratePixelShaderSAProgram	(PPDS_PIXEL_SHADER_SA_PROGRAM		psProgram,
+															 IMG_UINT32 *						pui32Buffer,
+															 PPDS_PIXEL_SHADER_SA_PROGRAM_INFO	psPDSPixelShaderSAProgramInfo)
 {
 	IMG_UINT32 *	pui32Constants;
 	IMG_UINT32	ui32NextDS0Constant;
@@ -6675,6 +6768,19 @@ PDS_CALLCONV IMG_UINT32 * PDSGeneratePixelShaderSAProgram	(PPDS_PIXEL_SHADER_SA_
 	pui32Constants		= pui32Buffer;
 	ui32NextDS0Constant	= PDS_DS0_CONST_BLOCK_BASE;
 	
+	if (psPDSPixelShaderSAProgramInfo)
+	{
+		psPDSPixelShaderSAProgramInfo->ui32NumDMAKicks    = psProgram->ui32NumDMAKicks;
+		psPDSPixelShaderSAProgramInfo->bKickUSE           = (psProgram->bKickUSE || psProgram->bKickUSEDummyProgram) ? IMG_TRUE : IMG_FALSE;
+		psPDSPixelShaderSAProgramInfo->bWriteTilePosition = psProgram->bWriteTilePosition;
+#if defined(SGX_FEATURE_ALPHATEST_SECONDARY)
+		psPDSPixelShaderSAProgramInfo->bIterateZAbs       = psProgram->bIterateZAbs;
+#endif
+#if defined(FIX_HW_BRN_22249)
+		psPDSPixelShaderSAProgramInfo->bGenerateTileAddress = psProgram->bGenerateTileAddress;
+#endif
+	}
+	
 	/*
 		Copy the DMA control words to constants
 	*/
@@ -6684,17 +6790,35 @@ PDS_CALLCONV IMG_UINT32 * PDSGeneratePixelShaderSAProgram	(PPDS_PIXEL_SHADER_SA_
 		PDSSetDS0Constant(pui32Constants, ui32DS0Constant + 0, psProgram->aui32DMAControl[0]);
 		PDSSetDS0Constant(pui32Constants, ui32DS0Constant + 1, psProgram->aui32DMAControl[1]);
 		
+		if (psPDSPixelShaderSAProgramInfo)
+		{
+			psPDSPixelShaderSAProgramInfo->aui32DMAControlOffsets[0] = PDSGetDS0ConstantOffset(ui32DS0Constant + 0);
+			psPDSPixelShaderSAProgramInfo->aui32DMAControlOffsets[1] = PDSGetDS0ConstantOffset(ui32DS0Constant + 1);
+		}
+		
 		if (psProgram->ui32NumDMAKicks >= 2)
 		{
 			ui32DS0Constant		= PDSGetConstants(&ui32NextDS0Constant, 2);
 			PDSSetDS0Constant(pui32Constants, ui32DS0Constant + 0, psProgram->aui32DMAControl[2]);
 			PDSSetDS0Constant(pui32Constants, ui32DS0Constant + 1, psProgram->aui32DMAControl[3]);
 			
+			if (psPDSPixelShaderSAProgramInfo)
+			{
+				psPDSPixelShaderSAProgramInfo->aui32DMAControlOffsets[2] = PDSGetDS0ConstantOffset(ui32DS0Constant + 0);
+				psPDSPixelShaderSAProgramInfo->aui32DMAControlOffsets[3] = PDSGetDS0ConstantOffset(ui32DS0Constant + 1);
+			}
+			
 			if (psProgram->ui32NumDMAKicks == 3)
 			{
 				ui32DS0Constant		= PDSGetConstants(&ui32NextDS0Constant, 2);
 				PDSSetDS0Constant(pui32Constants, ui32DS0Constant + 0, psProgram->aui32DMAControl[4]);
 				PDSSetDS0Constant(pui32Constants, ui32DS0Constant + 1, psProgram->aui32DMAControl[5]);
+				
+				if (psPDSPixelShaderSAProgramInfo)
+				{
+					psPDSPixelShaderSAProgramInfo->aui32DMAControlOffsets[4] = PDSGetDS0ConstantOffset(ui32DS0Constant + 0);
+					psPDSPixelShaderSAProgramInfo->aui32DMAControlOffsets[5] = PDSGetDS0ConstantOffset(ui32DS0Constant + 1);
+				}
 			}
 			
 		}
@@ -6704,6 +6828,11 @@ PDS_CALLCONV IMG_UINT32 * PDSGeneratePixelShaderSAProgram	(PPDS_PIXEL_SHADER_SA_
 	{
 		ui32DS0Constant		= PDSGetConstants(&ui32NextDS0Constant, 2); // request 2 to keep the DOUTU constant alignment ok.
 		PDSSetDS0Constant(pui32Constants, ui32DS0Constant, (psProgram->uTilePositionAttrDest << EURASIA_PDS_DOUTA1_AO_SHIFT));
+		
+		if (psPDSPixelShaderSAProgramInfo)
+		{
+			psPDSPixelShaderSAProgramInfo->ui32TilePositionAttrDestOffset = PDSGetDS0ConstantOffset(ui32DS0Constant);
+		}
 	}
 	
 	if (psProgram->bKickUSE || psProgram->bKickUSEDummyProgram)
@@ -6712,6 +6841,13 @@ PDS_CALLCONV IMG_UINT32 * PDSGeneratePixelShaderSAProgram	(PPDS_PIXEL_SHADER_SA_
 		PDSSetDS0Constant(pui32Constants, ui32DS0Constant + 0, psProgram->aui32USETaskControl[0]);
 		PDSSetDS0Constant(pui32Constants, ui32DS0Constant + 1, psProgram->aui32USETaskControl[1]);
 		PDSSetDS0Constant(pui32Constants, ui32DS0Constant + 2, psProgram->aui32USETaskControl[2]);
+		
+		if (psPDSPixelShaderSAProgramInfo)
+		{
+			psPDSPixelShaderSAProgramInfo->aui32USETaskControlOffsets[0] = PDSGetDS0ConstantOffset(ui32DS0Constant + 0);
+			psPDSPixelShaderSAProgramInfo->aui32USETaskControlOffsets[1] = PDSGetDS0ConstantOffset(ui32DS0Constant + 1);
+			psPDSPixelShaderSAProgramInfo->aui32USETaskControlOffsets[2] = PDSGetDS0ConstantOffset(ui32DS0Constant + 2);
+		}
 	}
 	
 	if(psProgram->bIterateZAbs)
@@ -6862,6 +6998,11 @@ PDS_CALLCONV IMG_UINT32 * PDSGeneratePixelShaderSAProgram	(PPDS_PIXEL_SHADER_SA_
 	psProgram->pui32DataSegment	= pui32Constants;
 	psProgram->ui32DataSize		= ui32NumConstants * sizeof(IMG_UINT32);
 	
+	if (psPDSPixelShaderSAProgramInfo)
+	{
+		psPDSPixelShaderSAProgramInfo->ui32DataSize = psProgram->ui32DataSize;
+	}
+	
 	return pui32Instruction;
 }
 
@@ -7015,13 +7156,14 @@ PDS_CALLCONV IMG_UINT32 * PDSGenerateStaticPixelShaderSAProgram	(PPDS_PIXEL_SHAD
  Function Name	: PDSGeneratePixelShaderProgram
  Inputs			: psProgram		- pointer to the PDS pixel shader program
 				: pui32Buffer		- pointer to the buffer for the program
- Outputs		: none
+ Outputs		: psPDSPixelShaderProgramInfo - patch information for the program (optional)
  Returns		: pointer to just beyond the buffer for the program
  Description	: Generates the PDS pixel shader program
 *****************************************************************************/
-PDS_CALLCONV IMG_UINT32* PDSGeneratePixelShaderProgram	(PPDS_TEXTURE_IMAGE_UNIT      psTextureImageUnits,
-														 PPDS_PIXEL_SHADER_PROGRAM	  psProgram,
-														 IMG_UINT32                  *pui32Buffer)
+PDS_CALLCONV IMG_UINT32* PDSGeneratePixelShaderProgram	(PPDS_TEXTURE_IMAGE_UNIT         psTextureImageUnits,
+														 PPDS_PIXEL_SHADER_PROGRAM	     psProgram,
+														 IMG_UINT32                     *pui32Buffer,
+														 PPDS_PIXEL_SHADER_PROGRAM_INFO  psPDSPixelShaderProgramInfo)
 {
 	IMG_UINT32 *pui32Constants;
 	IMG_UINT32	ui32DS0Constant;
@@ -7037,6 +7179,8 @@ PDS_CALLCONV IMG_UINT32* PDSGeneratePixelShaderProgram	(PPDS_TEXTURE_IMAGE_UNIT
 	IMG_UINT32 *pui32LastIterationIssue;
 	#endif
 	IMG_BOOL	abCombinedWithPreviousIssue[PVRD3D_MAXIMUM_ITERATIONS];
+	IMG_UINT32	aui32UnusedOffsets[EURASIA_TAG_TEXTURE_STATE_SIZE];
+	IMG_UINT32 *pui32Offsets;
 #if defined(SGX_FEATURE_PDS_EXTENDED_SOURCES)
 	IMG_UINT8	aui8TagSize[PVRD3D_MAXIMUM_ITERATIONS];
 #endif
@@ -7058,6 +7202,14 @@ PDS_CALLCONV IMG_UINT32* PDSGeneratePixelShaderProgram	(PPDS_TEXTURE_IMAGE_UNIT
 	PDSSetDS0Constant(pui32Constants, ui32DS0Constant + 1, psProgram->aui32USETaskControl[1]);
 	PDSSetDS0Constant(pui32Constants, ui32DS0Constant + 2, psProgram->aui32USETaskControl[2]);
 	
+	if (psPDSPixelShaderProgramInfo)
+	{
+		psPDSPixelShaderProgramInfo->aui32USETaskControlOffsets[0] = PDSGetDS0ConstantOffset(ui32DS0Constant + 0);
+		psPDSPixelShaderProgramInfo->aui32USETaskControlOffsets[1] = PDSGetDS0ConstantOffset(ui32DS0Constant + 1);
+		psPDSPixelShaderProgramInfo->aui32USETaskControlOffsets[2] = PDSGetDS0ConstantOffset(ui32DS0Constant + 2);
+		psPDSPixelShaderProgramInfo->ui32NumTextureReads		   = 0;
+	}
+	
 	/*
 		Copy the FPU iterator and texture control words to constants
 	*/
@@ -7145,6 +7297,28 @@ PDS_CALLCONV IMG_UINT32* PDSGeneratePixelShaderProgram	(PPDS_TEXTURE_IMAGE_UNIT
 			#if(EURASIA_TAG_TEXTURE_STATE_SIZE == 4)
 			PDSSetDS0Constant(pui32Constants, ui32DS0Constant + 3, psTextureCtl->ui32TAGControlWord3);
 			#endif
+			
+			/* Record where the texture control words go so they can be patched later */
+			if (psPDSPixelShaderProgramInfo)
+			{
+				IMG_UINT32 ui32Read = psPDSPixelShaderProgramInfo->ui32NumTextureReads++;
+				
+				PDS_ASSERT(ui32Read < PDS_MAX_TEXTURE_READS);
+				
+				psPDSPixelShaderProgramInfo->aui32TAGLayers[ui32Read] = ui32TagIssue;
+				pui32Offsets = psPDSPixelShaderProgramInfo->aui32TAGControlWordOffsets[ui32Read];
+			}
+			else
+			{
+				pui32Offsets = aui32UnusedOffsets;
+			}
+			
+			pui32Offsets[0] = PDSGetDS0ConstantOffset(ui32DS0Constant + 0);
+			pui32Offsets[1] = PDSGetDS0ConstantOffset(ui32DS0Constant + 1);
+			pui32Offsets[2] = PDSGetDS0ConstantOffset(ui32DS0Constant + 2);
+			#if(EURASIA_TAG_TEXTURE_STATE_SIZE == 4)
+			pui32Offsets[3] = PDSGetDS0ConstantOffset(ui32DS0Constant + 3);
+			#endif
 		}
 		else
 		{
@@ -7311,6 +7485,12 @@ PDS_CALLCONV IMG_UINT32* PDSGeneratePixelShaderProgram	(PPDS_TEXTURE_IMAGE_UNIT
 	psProgram->pui32DataSegment	= pui32Constants;
 	psProgram->ui32DataSize		= ui32NumConstants * sizeof(IMG_UINT32);
 	
+	if (psPDSPixelShaderProgramInfo)
+	{
+		psPDSPixelShaderProgramInfo->ui32DataSize        = psProgram->ui32DataSize;
+		psPDSPixelShaderProgramInfo->ui32NumFPUIterators = psProgram->ui32NumFPUIterators;
+	}
+	
 	return pui32Instruction;
 }
 
@@ -10601,6 +10781,268 @@ static IMG_UINT32 PDSGetNumConstants	(IMG_UINT32	ui32NextDS0Constant)
 
 #endif /* !FIX_HW_BRN_25339 && !(FIX_HW_BRN_27330) */
 
+/*****************************************************************************
+ Function Name	: PDSGetVertexShaderProgramKey
+ Inputs			: psProgram				- pointer to the PDS vertex shader program
+				: ui32MaxKeySizeInDWords	- size of the key buffer
+ Outputs		: pui32Key				- key of the program
+ Returns		: Size of the key in DWORDS
+ Description	: Builds a key from everything in the program that affects the
+				  generated code and the patch offsets. The stream addresses and
+				  use task control words are left out, as a program generated
+				  for one program can be made into the program for another with
+				  the same key by PDSRetargetVertexShaderProgram.
+*****************************************************************************/
+PDS_CALLCONV IMG_UINT32 PDSGetVertexShaderProgramKey(PPDS_VERTEX_SHADER_PROGRAM  psProgram,
+													 IMG_UINT32                 *pui32Key,
+													 IMG_UINT32                  ui32MaxKeySizeInDWords)
+{
+	IMG_UINT32 ui32Stream, ui32Element, ui32Size = 0;
+	
+	PDS_ASSERT(ui32MaxKeySizeInDWords >= PDS_VERTEX_SHADER_PROGRAM_KEY_DWORDS(0, 0));
+	
+	pui32Key[ui32Size++] = psProgram->ui32NumStreams;
+	pui32Key[ui32Size++] = psProgram->b32BitIndices ? 1U : 0U;
+	pui32Key[ui32Size++] = psProgram->ui32NumInstances;
+	
+	/* The ID offsets are only added when the IDs are iterated */
+	if (psProgram->bIterateVtxID)
+	{
+		pui32Key[ui32Size++] = 0x80000000U | psProgram->ui32VtxIDRegister;
+		pui32Key[ui32Size++] = psProgram->ui32VtxIDOffset;
+	}
+	else
+	{
+		pui32Key[ui32Size++] = 0;
+		pui32Key[ui32Size++] = 0;
+	}
+	
+	if (psProgram->bIterateInstanceID)
+	{
+		pui32Key[ui32Size++] = 0x80000000U | psProgram->ui32InstanceIDRegister;
+		pui32Key[ui32Size++] = psProgram->ui32InstanceIDOffset;
+	}
+	else
+	{
+		pui32Key[ui32Size++] = 0;
+		pui32Key[ui32Size++] = 0;
+	}
+	
+	for (ui32Stream = 0; ui32Stream < psProgram->ui32NumStreams; ui32Stream++)
+	{
+		PPDS_VERTEX_STREAM psStream = &psProgram->asStreams[ui32Stream];
+		
+		PDS_ASSERT(ui32Size + 5 + (psStream->ui32NumElements * 3) <= ui32MaxKeySizeInDWords);
+		
+		pui32Key[ui32Size++] = psStream->bInstanceData ? 1U : 0U;
+		pui32Key[ui32Size++] = psStream->ui32Multiplier;
+		pui32Key[ui32Size++] = psStream->ui32Shift;
+		pui32Key[ui32Size++] = psStream->ui32Stride;
+		pui32Key[ui32Size++] = psStream->ui32NumElements;
+		
+		for (ui32Element = 0; ui32Element < psStream->ui32NumElements; ui32Element++)
+		{
+			pui32Key[ui32Size++] = psStream->asElements[ui32Element].ui32Offset;
+			pui32Key[ui32Size++] = psStream->asElements[ui32Element].ui32Size;
+			pui32Key[ui32Size++] = psStream->asElements[ui32Element].ui32Register;
+		}
+	}
+	
+	return ui32Size;
+}
+
+/*****************************************************************************
+ Function Name	: PDSRetargetVertexShaderProgram
+ Inputs			: psProgram					- pointer to the PDS vertex shader program
+				: psPDSVertexShaderProgramInfo	- info of the program in pui32Buffer
+				: pui32Buffer					- copy of a program generated for a program
+											  with the same key as psProgram
+ Outputs		: psPDSVertexShaderProgramInfo, pui32Buffer
+ Returns		: Nothing
+ Description	: Patches the stream addresses and use task control words of
+				  psProgram into a copy of a previously generated program, making
+				  it identical to the program PDSGenerateVertexShaderProgram would
+				  generate for psProgram.
+*****************************************************************************/
+PDS_CALLCONV IMG_VOID PDSRetargetVertexShaderProgram(PPDS_VERTEX_SHADER_PROGRAM       psProgram,
+													 PPDS_VERTEX_SHADER_PROGRAM_INFO  psPDSVertexShaderProgramInfo,
+													 IMG_UINT32                      *pui32Buffer)
+{
+	IMG_UINT32 i;
+	
+	PDS_ASSERT(psPDSVertexShaderProgramInfo->ui32NumStreams == psProgram->ui32NumStreams);
+	
+	for (i = 0; i < psProgram->ui32NumStreams; i++)
+	{
+		psPDSVertexShaderProgramInfo->aui32StreamAddresses[i] = psProgram->asStreams[i].ui32Address;
+	}
+	
+	for (i = 0; i < PDS_NUM_USE_TASK_CONTROL_WORDS; i++)
+	{
+		psPDSVertexShaderProgramInfo->aui32USETaskControl[i] = psProgram->aui32USETaskControl[i];
+	}
+	
+	psPDSVertexShaderProgramInfo->bPatchTaskControl = IMG_TRUE;
+	
+	PDSPatchVertexShaderProgram(psPDSVertexShaderProgramInfo, pui32Buffer);
+}
+
+/*****************************************************************************
+ Function Name	: PDSPatchPixelShaderSAProgram
+ Inputs			: psPDSPixelShaderSAProgramInfo - info of the program in pui32Buffer
+				: psProgram						- pointer to the PDS secondary attribute program
+				: pui32Buffer					- copy of a previously generated program
+ Outputs		: psProgram, pui32Buffer
+ Returns		: IMG_TRUE if the program was patched, IMG_FALSE if psProgram
+				  has a different layout and must be generated instead
+ Description	: Patches the DMA control, tile position, render base address
+				  and use task control words of psProgram into a copy of a pds
+				  secondary attribute program, making it identical to the
+				  program PDSGeneratePixelShaderSAProgram would generate.
+*****************************************************************************/
+PDS_CALLCONV IMG_BOOL PDSPatchPixelShaderSAProgram(PPDS_PIXEL_SHADER_SA_PROGRAM_INFO	psPDSPixelShaderSAProgramInfo,
+												   PPDS_PIXEL_SHADER_SA_PROGRAM			psProgram,
+												   IMG_UINT32							*pui32Buffer)
+{
+	IMG_BOOL	bKickUSE = (psProgram->bKickUSE || psProgram->bKickUSEDummyProgram) ? IMG_TRUE : IMG_FALSE;
+	IMG_UINT32  i;
+	
+	if ((psPDSPixelShaderSAProgramInfo->ui32NumDMAKicks != psProgram->ui32NumDMAKicks) ||
+		(psPDSPixelShaderSAProgramInfo->bKickUSE != bKickUSE) ||
+		(psPDSPixelShaderSAProgramInfo->bWriteTilePosition != psProgram->bWriteTilePosition))
+	{
+		return IMG_FALSE;
+	}
+	
+#if defined(SGX_FEATURE_ALPHATEST_SECONDARY)
+	if (psPDSPixelShaderSAProgramInfo->bIterateZAbs != psProgram->bIterateZAbs)
+	{
+		return IMG_FALSE;
+	}
+#endif
+	
+#if defined(FIX_HW_BRN_22249)
+	if (psPDSPixelShaderSAProgramInfo->bGenerateTileAddress != psProgram->bGenerateTileAddress)
+	{
+		return IMG_FALSE;
+	}
+	
+	if (psProgram->bGenerateTileAddress)
+	{
+		pui32Buffer[psPDSPixelShaderSAProgramInfo->ui32RenderBaseAddressOffset] = psProgram->ui32RenderBaseAddress;
+	}
+#endif /* defined(FIX_HW_BRN_22249) */
+	
+	/* Write the DMA control words */
+	for (i = 0; i < psProgram->ui32NumDMAKicks * PDS_NUM_DMA_CONTROL_WORDS; i++)
+	{
+		pui32Buffer[psPDSPixelShaderSAProgramInfo->aui32DMAControlOffsets[i]] = psProgram->aui32DMAControl[i];
+	}
+	
+	if (psProgram->bWriteTilePosition)
+	{
+		pui32Buffer[psPDSPixelShaderSAProgramInfo->ui32TilePositionAttrDestOffset] = psProgram->uTilePositionAttrDest << EURASIA_PDS_DOUTA1_AO_SHIFT;
+	}
+	
+	if (bKickUSE)
+	{
+		/* Write the use task control words */
+		for (i = 0; i < PDS_NUM_USE_TASK_CONTROL_WORDS; i++)
+		{
+			pui32Buffer[psPDSPixelShaderSAProgramInfo->aui32USETaskControlOffsets[i]] = psProgram->aui32USETaskControl[i];
+		}
+	}
+	
+	/*
+		Save the data segment pointer and size
+	*/
+	psProgram->pui32DataSegment	= pui32Buffer;
+	psProgram->ui32DataSize		= psPDSPixelShaderSAProgramInfo->ui32DataSize;
+	
+	return IMG_TRUE;
+}
+
+/*****************************************************************************
+ Function Name	: PDSPatchPixelShaderProgram
+ Inputs			: psPDSPixelShaderProgramInfo	- info of the program in pui32Buffer
+				: psTextureImageUnits			- pointer to the texture control words
+				: psProgram						- pointer to the PDS pixel shader program
+				: pui32Buffer					- copy of a program previously generated
+											  with the same FPU iterators
+ Outputs		: psProgram, pui32Buffer
+ Returns		: IMG_TRUE if the program was patched, IMG_FALSE if psProgram
+				  reads different texture image units and must be generated instead
+ Description	: Patches the texture state and use task control words of
+				  psProgram into a copy of a pds pixel program, making it
+				  identical to the program PDSGeneratePixelShaderProgram would
+				  generate. The FPU iterator words are not patched; the caller
+				  must only reuse programs generated for the same iterators.
+*****************************************************************************/
+PDS_CALLCONV IMG_BOOL PDSPatchPixelShaderProgram(PPDS_PIXEL_SHADER_PROGRAM_INFO	psPDSPixelShaderProgramInfo,
+												 PPDS_TEXTURE_IMAGE_UNIT		psTextureImageUnits,
+												 PPDS_PIXEL_SHADER_PROGRAM		psProgram,
+												 IMG_UINT32						*pui32Buffer)
+{
+	IMG_UINT32 *pui32Constants;
+	IMG_UINT32	ui32Iterator, ui32Read;
+	IMG_UINT32  i;
+	
+	if (psPDSPixelShaderProgramInfo->ui32NumFPUIterators != psProgram->ui32NumFPUIterators)
+	{
+		return IMG_FALSE;
+	}
+	
+	/* The texture reads must be of the same units in the same order */
+	for (ui32Iterator = 0, ui32Read = 0; ui32Iterator < psProgram->ui32NumFPUIterators; ui32Iterator++)
+	{
+		if (psProgram->aui32TAGLayers[ui32Iterator] != 0xFFFFFFFF)
+		{
+			if ((ui32Read == psPDSPixelShaderProgramInfo->ui32NumTextureReads) ||
+				(psPDSPixelShaderProgramInfo->aui32TAGLayers[ui32Read] != psProgram->aui32TAGLayers[ui32Iterator]))
+			{
+				return IMG_FALSE;
+			}
+			
+			ui32Read++;
+		}
+	}
+	
+	if (ui32Read != psPDSPixelShaderProgramInfo->ui32NumTextureReads)
+	{
+		return IMG_FALSE;
+	}
+	
+	pui32Constants = (IMG_UINT32 *) (((IMG_UINTPTR_T)pui32Buffer + ((1UL << EURASIA_PDS_BASEADD_ALIGNSHIFT) - 1)) & ~((IMG_UINTPTR_T)(1UL << EURASIA_PDS_BASEADD_ALIGNSHIFT) - 1));
+	
+	/* Write the use task control words */
+	for (i = 0; i < PDS_NUM_USE_TASK_CONTROL_WORDS; i++)
+	{
+		pui32Constants[psPDSPixelShaderProgramInfo->aui32USETaskControlOffsets[i]] = psProgram->aui32USETaskControl[i];
+	}
+	
+	/* Write the texture control words */
+	for (i = 0; i < psPDSPixelShaderProgramInfo->ui32NumTextureReads; i++)
+	{
+		PPDS_TEXTURE_IMAGE_UNIT psTextureCtl = &psTextureImageUnits[psPDSPixelShaderProgramInfo->aui32TAGLayers[i]];
+		IMG_UINT32 *pui32Offsets = psPDSPixelShaderProgramInfo->aui32TAGControlWordOffsets[i];
+		
+		pui32Constants[pui32Offsets[0]] = psTextureCtl->ui32TAGControlWord0;
+		pui32Constants[pui32Offsets[1]] = psTextureCtl->ui32TAGControlWord1;
+		pui32Constants[pui32Offsets[2]] = psTextureCtl->ui32TAGControlWord2;
+#if (EURASIA_TAG_TEXTURE_STATE_SIZE == 4)
+		pui32Constants[pui32Offsets[3]] = psTextureCtl->ui32TAGControlWord3;
+#endif
+	}
+	
+	/*
+		Save the data segment pointer and size
+	*/
+	psProgram->pui32DataSegment	= pui32Constants;
+	psProgram->ui32DataSize		= psPDSPixelShaderProgramInfo->ui32DataSize;
+	
+	return IMG_TRUE;
+}
+
 /*****************************************************************************
  Function Name	: PDSGeneratePixelEventProgramTileXY
  Inputs			: psProgram		- pointer to the PDS pixel event program
@@ -173,6 +173,44 @@ typedef struct _PDS_PIXEL_SHADER_SA_PROGRAM_
 	
 } PDS_PIXEL_SHADER_SA_PROGRAM, *PPDS_PIXEL_SHADER_SA_PROGRAM;
 
+/*
+  Structure containing information about a program generated by PDSGeneratePixelShaderSAProgram()
+  Can subsequently be sent to PDSPatchPixelShaderSAProgram() to patch the DMA and use task control
+  words of a program with the same layout. All offsets are in DWORDS from the start of the data segment
+  
+  ui32DataSize                  - Size of the data segment in bytes
+  ui32NumDMAKicks               - Number of DMA kicks in the program
+  aui32DMAControlOffsets        - Offset into program where the DMA control words are stored
+  bKickUSE                      - Whether the program contains a use task (bKickUSE or bKickUSEDummyProgram)
+  aui32USETaskControlOffsets    - Offset into program where use task control should be written
+  bWriteTilePosition            - Whether the program writes the tile position
+  ui32TilePositionAttrDestOffset - Offset into program where the tile position attribute destination is stored
+  bIterateZAbs                  - Whether the program iterates absolute Z
+  bGenerateTileAddress          - Whether the program generates the tile address
+  ui32RenderBaseAddressOffset   - Offset into program where the render base address is stored
+*/
+typedef struct _PDS_PIXEL_SHADER_SA_PROGRAM_INFO_
+{
+	IMG_UINT32	ui32DataSize;
+	
+	IMG_UINT32	ui32NumDMAKicks;
+	IMG_UINT32	aui32DMAControlOffsets[PDS_NUM_DMA_KICKS * PDS_NUM_DMA_CONTROL_WORDS];
+	
+	IMG_BOOL	bKickUSE;
+	IMG_UINT32	aui32USETaskControlOffsets[PDS_NUM_USE_TASK_CONTROL_WORDS];
+	
+	IMG_BOOL	bWriteTilePosition;
+	IMG_UINT32	ui32TilePositionAttrDestOffset;
+#if defined(SGX_FEATURE_ALPHATEST_SECONDARY)
+	IMG_BOOL	bIterateZAbs;
+#endif
+#if defined(FIX_HW_BRN_22249)
+	IMG_BOOL	bGenerateTileAddress;
+	IMG_UINT32	ui32RenderBaseAddressOffset;
+#endif /* defined(FIX_HW_BRN_22249) */
+	
+} PDS_PIXEL_SHADER_SA_PROGRAM_INFO, *PPDS_PIXEL_SHADER_SA_PROGRAM_INFO;
+
 
 /*
 	Structure representing the static PDS pixel shader secondary attribute program
@@ -234,6 +272,33 @@ typedef struct _PDS_PIXEL_SHADER_PROGRAM_
 
 } PDS_PIXEL_SHADER_PROGRAM, *PPDS_PIXEL_SHADER_PROGRAM;
 
+/*
+  Structure containing information about a program generated by PDSGeneratePixelShaderProgram()
+  Can subsequently be sent to PDSPatchPixelShaderProgram() to perform texture state and use task patching
+  of a program generated with the same FPU iterators. All offsets are in DWORDS from the start of the
+  data segment
+  
+  ui32DataSize                  - Size of the data segment in bytes
+  ui32NumFPUIterators           - Number of FPU iterators in the program
+  aui32USETaskControlOffsets    - Offset into program where use task control should be written
+  
+  ui32NumTextureReads           - Number of texture reads (DOUTTs) in the program
+  aui32TAGLayers                - Texture image unit read by each texture read
+  aui32TAGControlWordOffsets    - Offsets into program where the texture control words should be written
+*/
+typedef struct _PDS_PIXEL_SHADER_PROGRAM_INFO_
+{
+	IMG_UINT32	ui32DataSize;
+	IMG_UINT32	ui32NumFPUIterators;
+	
+	IMG_UINT32	aui32USETaskControlOffsets[PDS_NUM_USE_TASK_CONTROL_WORDS];
+	
+	IMG_UINT32	ui32NumTextureReads;
+	IMG_UINT32	aui32TAGLayers[PDS_MAX_TEXTURE_READS];
+	IMG_UINT32	aui32TAGControlWordOffsets[PDS_MAX_TEXTURE_READS][EURASIA_TAG_TEXTURE_STATE_SIZE];
+	
+} PDS_PIXEL_SHADER_PROGRAM_INFO, *PPDS_PIXEL_SHADER_PROGRAM_INFO;
+
 /*
 	Structure representing the MTE state copy program
 	
@@ -398,6 +463,15 @@ typedef struct _PDS_VERTEX_SHADER_PROGRAM_INFO_
 	
 } PDS_VERTEX_SHADER_PROGRAM_INFO, *PPDS_VERTEX_SHADER_PROGRAM_INFO;
 
+/*
+  Size in DWORDS of the key returned by PDSGetVertexShaderProgramKey() for a program
+  with up to ui32NumStreams streams holding ui32NumElements elements between them.
+  Programs with the same key generate the same code and patch offsets, and only
+  differ in the stream addresses and use task control words
+*/
+#define PDS_VERTEX_SHADER_PROGRAM_KEY_DWORDS(ui32NumStreams, ui32NumElements)	\
+	(7 + ((ui32NumStreams) * 5) + ((ui32NumElements) * 3))
+
 /**
  * Structure representing PDS const element to be uploaded.
  *
@@ -668,12 +742,23 @@ PDS_CALLCONV IMG_UINT32 * PDSGenerateStaticVertexShaderProgram	(PPDS_VERTEX_SHAD
 																 PPDS_VERTEX_SHADER_PROGRAM_INFO  psPDSVertexShaderProgramInfo);
 																 
 PDS_CALLCONV IMG_UINT32 * PDSGeneratePixelShaderSAProgram	(PPDS_PIXEL_SHADER_SA_PROGRAM	psProgram,
-															 IMG_UINT32						*pui32Buffer);
+															 IMG_UINT32						*pui32Buffer,
+															 PPDS_PIXEL_SHADER_SA_PROGRAM_INFO	psPDSPixelShaderSAProgramInfo);
+															 
+PDS_CALLCONV IMG_BOOL PDSPatchPixelShaderSAProgram			(PPDS_PIXEL_SHADER_SA_PROGRAM_INFO	psPDSPixelShaderSAProgramInfo,
+															 PPDS_PIXEL_SHADER_SA_PROGRAM		psProgram,
+															 IMG_UINT32							*pui32Buffer);
 															 
 PDS_CALLCONV IMG_UINT32 * PDSGenerateStaticPixelShaderSAProgram	(PPDS_PIXEL_SHADER_STATIC_SA_PROGRAM	psProgram,
 															 IMG_UINT32						*pui32Buffer);
 															 
 PDS_CALLCONV IMG_UINT32 * PDSGeneratePixelShaderProgram		(PPDS_TEXTURE_IMAGE_UNIT      psTextureImageUnit,
+															 PPDS_PIXEL_SHADER_PROGRAM		psProgram,
+															 IMG_UINT32						*pui32Buffer,
+															 PPDS_PIXEL_SHADER_PROGRAM_INFO	psPDSPixelShaderProgramInfo);
+															 
+PDS_CALLCONV IMG_BOOL PDSPatchPixelShaderProgram				(PPDS_PIXEL_SHADER_PROGRAM_INFO	psPDSPixelShaderProgramInfo,
+															 PPDS_TEXTURE_IMAGE_UNIT		psTextureImageUnits,
 															 PPDS_PIXEL_SHADER_PROGRAM		psProgram,
 															 IMG_UINT32						*pui32Buffer);
 															 
@@ -690,6 +775,15 @@ PDS_CALLCONV IMG_UINT32 * PDSGenerateVertexShaderProgram		(PPDS_VERTEX_SHADER_PR
 																 
 PDS_CALLCONV IMG_VOID PDSPatchVertexShaderProgram(PPDS_VERTEX_SHADER_PROGRAM_INFO  psPDSVertexShaderProgramInfo,
 												  IMG_UINT32                      *pui32Buffer);
+
+PDS_CALLCONV IMG_UINT32 PDSGetVertexShaderProgramKey(PPDS_VERTEX_SHADER_PROGRAM  psProgram,
+													 IMG_UINT32                 *pui32Key,
+													 IMG_UINT32                  ui32MaxKeySizeInDWords);
+
+PDS_CALLCONV IMG_VOID PDSRetargetVertexShaderProgram(PPDS_VERTEX_SHADER_PROGRAM       psProgram,
+													 PPDS_VERTEX_SHADER_PROGRAM_INFO  psPDSVertexShaderProgramInfo,
+													 IMG_UINT32                      *pui32Buffer);
+
 PDS_CALLCONV IMG_UINT32 * PDSGenerateConstUploadProgram
 						(PPDS_CONST_UPLOAD_PROGRAM       psProgram,
 						 IMG_UINT32                      *pui32Buffer);
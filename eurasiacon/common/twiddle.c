@@ -559,6 +559,171 @@ IMG_INTERNAL IMG_VOID DeTwiddleAddress32bpp( IMG_VOID    *pvDestAddress,
 	}
 }		
 
+/******************************************************************************
+ * Macro Name   : DETWIDDLE_SUBRECT_BODY   INTERNAL ONLY
+ * Inputs       : PIXELTYPE - type of a texel
+ * Description  : Body of DeTwiddleSubRect8bpp, 16bpp and 32bpp.
+ *
+ *                The level is laid out as DeTwiddleAddress lays it out: tiles
+ *                of GetTileSize texels square in rows, each twiddled with x in
+ *                the odd address bits and y in the even ones. The address of a
+ *                texel is its tile's base plus the x bits and y bits of its
+ *                position in the tile, looked up separately.
+ *
+ *                Tiles the rectangle covers completely are written a 2x2 quad
+ *                at a time: a quad is 4 consecutive texels, column by column.
+ *                The edge strips through the tiles it covers in part are
+ *                written texel by texel.
+ *****************************************************************************/
+#define DETWIDDLE_SUBRECT_BODY(PIXELTYPE)																	\
+{																											\
+	PIXELTYPE *pDest = (PIXELTYPE *)pvDestAddress;															\
+	const PIXELTYPE *pSrc = (const PIXELTYPE *)pvSrcPixels;													\
+	IMG_UINT32 ui32TileSize = GetTileSize(ui32Width, ui32Height);											\
+	IMG_UINT32 ui32TileShift, ui32TileCountX;																\
+	IMG_UINT32 ui32TileX, ui32TileY, ui32TexX, ui32TexY;													\
+	IMG_UINT32 ui32EndX = ui32XOffset + ui32SubWidth;														\
+	IMG_UINT32 ui32EndY = ui32YOffset + ui32SubHeight;														\
+	IMG_UINT32 aui32XBits[EURASIA_TAG_NP2TWID_MAXTILEDIM], aui32YBits[EURASIA_TAG_NP2TWID_MAXTILEDIM];		\
+																											\
+	if(!ui32SubWidth || !ui32SubHeight)																		\
+	{																										\
+		return;																								\
+	}																										\
+																											\
+	for(ui32TileShift = 0; (1U << ui32TileShift) < ui32TileSize; ui32TileShift++);							\
+																											\
+	ui32TileCountX = (ui32Width + (ui32TileSize - 1)) >> ui32TileShift;										\
+																											\
+	for(ui32TexX = 0; ui32TexX < ui32TileSize; ui32TexX++)													\
+	{																										\
+		aui32XBits[ui32TexX] = HybridTwiddleCoord(ui32TexX, 0);												\
+		aui32YBits[ui32TexX] = HybridTwiddleCoord(0, ui32TexX);												\
+	}																										\
+																											\
+	for(ui32TileY = ui32YOffset >> ui32TileShift; ui32TileY <= ((ui32EndY - 1) >> ui32TileShift); ui32TileY++)	\
+	{																										\
+		IMG_UINT32 ui32TileTop = ui32TileY << ui32TileShift;												\
+		IMG_UINT32 ui32StartRow = MAX(ui32YOffset, ui32TileTop) - ui32TileTop;								\
+		IMG_UINT32 ui32EndRow = MIN(ui32EndY, ui32TileTop + ui32TileSize) - ui32TileTop;					\
+																											\
+		for(ui32TileX = ui32XOffset >> ui32TileShift; ui32TileX <= ((ui32EndX - 1) >> ui32TileShift); ui32TileX++)	\
+		{																									\
+			IMG_UINT32 ui32TileLeft = ui32TileX << ui32TileShift;											\
+			IMG_UINT32 ui32StartCol = MAX(ui32XOffset, ui32TileLeft) - ui32TileLeft;						\
+			IMG_UINT32 ui32EndCol = MIN(ui32EndX, ui32TileLeft + ui32TileSize) - ui32TileLeft;				\
+			PIXELTYPE *pTile = &pDest[(ui32TileX + (ui32TileY * ui32TileCountX)) << (2 * ui32TileShift)];	\
+																											\
+			const PIXELTYPE *pTileSrc = pSrc + ((ui32TileTop + ui32StartRow - ui32YOffset) * ui32StrideIn) +	\
+											   (ui32TileLeft + ui32StartCol - ui32XOffset);					\
+																											\
+			if((ui32TileSize > 1) && !ui32StartCol && !ui32StartRow &&										\
+			   (ui32EndCol == ui32TileSize) && (ui32EndRow == ui32TileSize))								\
+			{																								\
+				for(ui32TexY = 0; ui32TexY < ui32TileSize; ui32TexY += 2)									\
+				{																							\
+					const PIXELTYPE *pRow0 = pTileSrc + (ui32TexY * ui32StrideIn);							\
+					const PIXELTYPE *pRow1 = pRow0 + ui32StrideIn;											\
+																											\
+					for(ui32TexX = 0; ui32TexX < ui32TileSize; ui32TexX += 2)								\
+					{																						\
+						PIXELTYPE *pQuad = &pTile[aui32XBits[ui32TexX] | aui32YBits[ui32TexY]];				\
+																											\
+						pQuad[0] = pRow0[ui32TexX];															\
+						pQuad[1] = pRow1[ui32TexX];															\
+						pQuad[2] = pRow0[ui32TexX + 1];														\
+						pQuad[3] = pRow1[ui32TexX + 1];														\
+					}																						\
+				}																							\
+			}																								\
+			else																							\
+			{																								\
+				for(ui32TexY = ui32StartRow; ui32TexY < ui32EndRow; ui32TexY++)								\
+				{																							\
+					const PIXELTYPE *pRow = pTileSrc + ((ui32TexY - ui32StartRow) * ui32StrideIn);			\
+																											\
+					for(ui32TexX = ui32StartCol; ui32TexX < ui32EndCol; ui32TexX++)							\
+					{																						\
+						pTile[aui32XBits[ui32TexX] | aui32YBits[ui32TexY]] = pRow[ui32TexX - ui32StartCol];	\
+					}																						\
+				}																							\
+			}																								\
+		}																									\
+	}																										\
+}
+
+
+/******************************************************************************
+ * Function Name: DeTwiddleSubRect8bpp
+ * Inputs       : pvSrcPixels - first texel of the rectangle
+ *                ui32Width, ui32Height - size of the level
+ *                ui32XOffset, ui32YOffset, ui32SubWidth, ui32SubHeight -
+ *                rectangle within the level
+ *                ui32StrideIn - source stride in texels
+ * Outputs      : pvDestAddress - the twiddled level
+ * Returns      : None
+ * Globals Used : None
+ * Description  : Twiddles a rectangle of a level into place, leaving the rest
+ *                of the level untouched. The result is the same as twiddling
+ *                the whole level with DeTwiddleAddress8bpp.
+ *****************************************************************************/
+
+IMG_INTERNAL IMG_VOID DeTwiddleSubRect8bpp( IMG_VOID    *pvDestAddress,
+											const IMG_VOID *pvSrcPixels,
+											IMG_UINT32  ui32Width,
+											IMG_UINT32  ui32Height,
+											IMG_UINT32  ui32XOffset,
+											IMG_UINT32  ui32YOffset,
+											IMG_UINT32  ui32SubWidth,
+											IMG_UINT32  ui32SubHeight,
+											IMG_UINT32  ui32StrideIn)
+DETWIDDLE_SUBRECT_BODY(IMG_UINT8)
+
+
+/******************************************************************************
+ * Function Name: DeTwiddleSubRect16bpp
+ * Inputs       : As DeTwiddleSubRect8bpp
+ * Outputs      : pvDestAddress - the twiddled level
+ * Returns      : None
+ * Globals Used : None
+ * Description  : 16bpp version of DeTwiddleSubRect8bpp
+ *****************************************************************************/
+
+IMG_INTERNAL IMG_VOID DeTwiddleSubRect16bpp( IMG_VOID    *pvDestAddress,
+											const IMG_VOID *pvSrcPixels,
+											IMG_UINT32  ui32Width,
+											IMG_UINT32  ui32Height,
+											IMG_UINT32  ui32XOffset,
+											IMG_UINT32  ui32YOffset,
+											IMG_UINT32  ui32SubWidth,
+											IMG_UINT32  ui32SubHeight,
+											IMG_UINT32  ui32StrideIn)
+DETWIDDLE_SUBRECT_BODY(IMG_UINT16)
+
+
+/******************************************************************************
+ * Function Name: DeTwiddleSubRect32bpp
+ * Inputs       : As DeTwiddleSubRect8bpp
+ * Outputs      : pvDestAddress - the twiddled level
+ * Returns      : None
+ * Globals Used : None
+ * Description  : 32bpp version of DeTwiddleSubRect8bpp
+ *****************************************************************************/
+
+IMG_INTERNAL IMG_VOID DeTwiddleSubRect32bpp( IMG_VOID    *pvDestAddress,
+											const IMG_VOID *pvSrcPixels,
+											IMG_UINT32  ui32Width,
+											IMG_UINT32  ui32Height,
+											IMG_UINT32  ui32XOffset,
+											IMG_UINT32  ui32YOffset,
+											IMG_UINT32  ui32SubWidth,
+											IMG_UINT32  ui32SubHeight,
+											IMG_UINT32  ui32StrideIn)
+DETWIDDLE_SUBRECT_BODY(IMG_UINT32)
+
+#undef DETWIDDLE_SUBRECT_BODY
+
+
 
 static IMG_UINT32 GetPVRTC2bppTileSize(IMG_INT32 nUnCompressedWidth, IMG_INT32 nUnCompressedHeight)
 {
@@ -2651,6 +2816,218 @@ IMG_INTERNAL IMG_VOID DeTwiddleAddressETC1(IMG_VOID	*pvDest,
 }
 
 
+/******************************************************************************
+ * Function Name: SpreadBits   INTERNAL ONLY
+ * Inputs       : ui32Value - value of up to 16 bits
+ * Outputs      : None
+ * Returns      : The value with a zero bit inserted above each of its bits
+ * Globals Used : None
+ * Description  : Twiddled offset of a y position within a square; shifted
+ *                left by one, of an x position.
+ *****************************************************************************/
+static IMG_UINT32 SpreadBits(IMG_UINT32 ui32Value)
+{
+	ui32Value = (ui32Value | (ui32Value << 8)) & 0x00FF00FFU;
+	ui32Value = (ui32Value | (ui32Value << 4)) & 0x0F0F0F0FU;
+	ui32Value = (ui32Value | (ui32Value << 2)) & 0x33333333U;
+	ui32Value = (ui32Value | (ui32Value << 1)) & 0x55555555U;
+
+	return ui32Value;
+}
+
+/* Side of the aligned blocks DeTwiddleSubRect writes in one go */
+#define SUBRECT_BLOCK_SIZE		8
+#define SUBRECT_BLOCK_SHIFT		3
+
+/*
+	Address parts of a texel in DETWIDDLE_SUBRECT_BODY: its position in its square,
+	plus the offset of the square. Only the longer side has more than one square.
+*/
+#define SUBRECT_X_OFFSET(X)		((SpreadBits((X) & ui32SquareMask) << 1) + (((X) >> ui32SquareLog2) << (2 * ui32SquareLog2)))
+#define SUBRECT_Y_OFFSET(Y)		(SpreadBits((Y) & ui32SquareMask) + (((Y) >> ui32SquareLog2) << (2 * ui32SquareLog2)))
+
+/******************************************************************************
+ * Macro Name   : DETWIDDLE_SUBRECT_BODY   INTERNAL ONLY
+ * Inputs       : PIXELTYPE - type of a texel
+ * Description  : Body of DeTwiddleSubRect8bpp, 16bpp and 32bpp.
+ *
+ *                A power of two level is twiddled as squares the size of its
+ *                shorter side, one after another along the longer side, with
+ *                y in the even address bits of a square and x in the odd ones.
+ *                The address of a texel is then a part from x plus a part from
+ *                y, each carrying the square offset along its own axis.
+ *
+ *                Any aligned block no bigger than a square is stored as one
+ *                run in twiddled order, so the blocks the rectangle covers
+ *                completely are written sequentially, reading the source
+ *                through a table of offsets. The edge strips through the
+ *                blocks it covers in part are written texel by texel.
+ *****************************************************************************/
+#define DETWIDDLE_SUBRECT_BODY(PIXELTYPE)																	\
+{																											\
+	PIXELTYPE *pDest = (PIXELTYPE *)pvDestAddress;															\
+	const PIXELTYPE *pSrc = (const PIXELTYPE *)pvSrcPixels;													\
+	IMG_UINT32 ui32WidthLog2 = 0, ui32HeightLog2 = 0, ui32SquareLog2;										\
+	IMG_UINT32 ui32BlockLog2, ui32BlockSize, ui32BlockTexels;												\
+	IMG_UINT32 ui32SquareMask;																				\
+	IMG_UINT32 ui32BlockX, ui32BlockY, ui32TexX, ui32TexY, i;												\
+	IMG_UINT32 ui32EndX = ui32XOffset + ui32SubWidth;														\
+	IMG_UINT32 ui32EndY = ui32YOffset + ui32SubHeight;														\
+	IMG_UINT32 aui32Lookup[SUBRECT_BLOCK_SIZE * SUBRECT_BLOCK_SIZE];										\
+																											\
+	if(!ui32SubWidth || !ui32SubHeight)																		\
+	{																										\
+		return;																								\
+	}																										\
+																											\
+	while((1U << ui32WidthLog2) < ui32Width)																\
+	{																										\
+		ui32WidthLog2++;																					\
+	}																										\
+	while((1U << ui32HeightLog2) < ui32Height)																\
+	{																										\
+		ui32HeightLog2++;																					\
+	}																										\
+																											\
+	ui32SquareLog2 = MIN(ui32WidthLog2, ui32HeightLog2);													\
+	ui32BlockLog2 = MIN(ui32SquareLog2, SUBRECT_BLOCK_SHIFT);												\
+	ui32BlockSize = 1U << ui32BlockLog2;																	\
+	ui32BlockTexels = ui32BlockSize * ui32BlockSize;														\
+																											\
+	ui32SquareMask = (1U << ui32SquareLog2) - 1;															\
+																											\
+	for(i = 0; i < ui32BlockTexels; i++)																	\
+	{																										\
+		IMG_UINT32 ui32LookupX = 0, ui32LookupY = 0, ui32Bit;												\
+																											\
+		for(ui32Bit = 0; ui32Bit < ui32BlockLog2; ui32Bit++)												\
+		{																									\
+			ui32LookupY |= ((i >> (2 * ui32Bit)) & 1U) << ui32Bit;											\
+			ui32LookupX |= ((i >> (2 * ui32Bit + 1)) & 1U) << ui32Bit;										\
+		}																									\
+																											\
+		aui32Lookup[i] = ui32LookupX + (ui32LookupY * ui32StrideIn);										\
+	}																										\
+																											\
+	for(ui32BlockY = ui32YOffset >> ui32BlockLog2; ui32BlockY <= ((ui32EndY - 1) >> ui32BlockLog2); ui32BlockY++)	\
+	{																										\
+		IMG_UINT32 ui32BlockTop = ui32BlockY << ui32BlockLog2;												\
+		IMG_UINT32 ui32StartRow = MAX(ui32YOffset, ui32BlockTop);											\
+		IMG_UINT32 ui32EndRow = MIN(ui32EndY, ui32BlockTop + ui32BlockSize);								\
+																											\
+		for(ui32BlockX = ui32XOffset >> ui32BlockLog2; ui32BlockX <= ((ui32EndX - 1) >> ui32BlockLog2); ui32BlockX++)	\
+		{																									\
+			IMG_UINT32 ui32BlockLeft = ui32BlockX << ui32BlockLog2;											\
+			IMG_UINT32 ui32StartCol = MAX(ui32XOffset, ui32BlockLeft);										\
+			IMG_UINT32 ui32EndCol = MIN(ui32EndX, ui32BlockLeft + ui32BlockSize);							\
+																											\
+			if((ui32StartCol == ui32BlockLeft) && (ui32EndCol == ui32BlockLeft + ui32BlockSize) &&			\
+			   (ui32StartRow == ui32BlockTop) && (ui32EndRow == ui32BlockTop + ui32BlockSize))				\
+			{																								\
+				PIXELTYPE *pBlock = &pDest[SUBRECT_X_OFFSET(ui32BlockLeft) + SUBRECT_Y_OFFSET(ui32BlockTop)];	\
+				const PIXELTYPE *pBlockSrc = pSrc + ((ui32BlockTop - ui32YOffset) * ui32StrideIn) +		\
+													(ui32BlockLeft - ui32XOffset);							\
+																											\
+				for(i = 0; i < ui32BlockTexels; i++)														\
+				{																							\
+					pBlock[i] = pBlockSrc[aui32Lookup[i]];													\
+				}																							\
+			}																								\
+			else																							\
+			{																								\
+				for(ui32TexY = ui32StartRow; ui32TexY < ui32EndRow; ui32TexY++)								\
+				{																							\
+					IMG_UINT32 ui32RowOffset = SUBRECT_Y_OFFSET(ui32TexY);									\
+					const PIXELTYPE *pRow = pSrc + ((ui32TexY - ui32YOffset) * ui32StrideIn);				\
+																											\
+					for(ui32TexX = ui32StartCol; ui32TexX < ui32EndCol; ui32TexX++)							\
+					{																						\
+						pDest[SUBRECT_X_OFFSET(ui32TexX) + ui32RowOffset] = pRow[ui32TexX - ui32XOffset];	\
+					}																						\
+				}																							\
+			}																								\
+		}																									\
+	}																										\
+}
+
+
+
+/******************************************************************************
+ * Function Name: DeTwiddleSubRect8bpp
+ * Inputs       : pvSrcPixels - first texel of the rectangle
+ *                ui32Width, ui32Height - size of the level
+ *                ui32XOffset, ui32YOffset, ui32SubWidth, ui32SubHeight -
+ *                rectangle within the level
+ *                ui32StrideIn - source stride in texels
+ * Outputs      : pvDestAddress - the twiddled level
+ * Returns      : None
+ * Globals Used : None
+ * Description  : Twiddles a rectangle of a level into place, leaving the rest
+ *                of the level untouched. The result is the same as twiddling
+ *                the whole level with DeTwiddleAddress8bpp. Each side of the
+ *                level must be a power of two.
+ *****************************************************************************/
+
+IMG_INTERNAL IMG_VOID DeTwiddleSubRect8bpp( IMG_VOID    *pvDestAddress,
+											const IMG_VOID *pvSrcPixels,
+											IMG_UINT32  ui32Width,
+											IMG_UINT32  ui32Height,
+											IMG_UINT32  ui32XOffset,
+											IMG_UINT32  ui32YOffset,
+											IMG_UINT32  ui32SubWidth,
+											IMG_UINT32  ui32SubHeight,
+											IMG_UINT32  ui32StrideIn)
+DETWIDDLE_SUBRECT_BODY(IMG_UINT8)
+
+
+/******************************************************************************
+ * Function Name: DeTwiddleSubRect16bpp
+ * Inputs       : As DeTwiddleSubRect8bpp
+ * Outputs      : pvDestAddress - the twiddled level
+ * Returns      : None
+ * Globals Used : None
+ * Description  : 16bpp version of DeTwiddleSubRect8bpp
+ *****************************************************************************/
+
+IMG_INTERNAL IMG_VOID DeTwiddleSubRect16bpp( IMG_VOID    *pvDestAddress,
+											const IMG_VOID *pvSrcPixels,
+											IMG_UINT32  ui32Width,
+											IMG_UINT32  ui32Height,
+											IMG_UINT32  ui32XOffset,
+											IMG_UINT32  ui32YOffset,
+											IMG_UINT32  ui32SubWidth,
+											IMG_UINT32  ui32SubHeight,
+											IMG_UINT32  ui32StrideIn)
+DETWIDDLE_SUBRECT_BODY(IMG_UINT16)
+
+
+/******************************************************************************
+ * Function Name: DeTwiddleSubRect32bpp
+ * Inputs       : As DeTwiddleSubRect8bpp
+ * Outputs      : pvDestAddress - the twiddled level
+ * Returns      : None
+ * Globals Used : None
+ * Description  : 32bpp version of DeTwiddleSubRect8bpp
+ *****************************************************************************/
+
+IMG_INTERNAL IMG_VOID DeTwiddleSubRect32bpp( IMG_VOID    *pvDestAddress,
+											const IMG_VOID *pvSrcPixels,
+											IMG_UINT32  ui32Width,
+											IMG_UINT32  ui32Height,
+											IMG_UINT32  ui32XOffset,
+											IMG_UINT32  ui32YOffset,
+											IMG_UINT32  ui32SubWidth,
+											IMG_UINT32  ui32SubHeight,
+											IMG_UINT32  ui32StrideIn)
+DETWIDDLE_SUBRECT_BODY(IMG_UINT32)
+
+#undef DETWIDDLE_SUBRECT_BODY
+#undef SUBRECT_X_OFFSET
+#undef SUBRECT_Y_OFFSET
+#undef SUBRECT_BLOCK_SIZE
+#undef SUBRECT_BLOCK_SHIFT
+
+
 #endif /* defined(SGX_FEATURE_HYBRID_TWIDDLING) */
 
 
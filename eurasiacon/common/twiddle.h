@@ -99,6 +99,36 @@ IMG_VOID ReadBackTwiddleETC1(IMG_VOID *pvDest, const IMG_VOID *pvSrc,
 							 IMG_UINT32 ui32Height,
 							 IMG_UINT32 ui32DstStride);
 
+IMG_VOID DeTwiddleSubRect8bpp(IMG_VOID   *pvDestAddress,
+								const IMG_VOID *pvSrcPixels,
+								IMG_UINT32  ui32Width,
+								IMG_UINT32  ui32Height,
+								IMG_UINT32  ui32XOffset,
+								IMG_UINT32  ui32YOffset,
+								IMG_UINT32  ui32SubWidth,
+								IMG_UINT32  ui32SubHeight,
+								IMG_UINT32  ui32StrideIn);
+
+IMG_VOID DeTwiddleSubRect16bpp(IMG_VOID   *pvDestAddress,
+								const IMG_VOID *pvSrcPixels,
+								IMG_UINT32  ui32Width,
+								IMG_UINT32  ui32Height,
+								IMG_UINT32  ui32XOffset,
+								IMG_UINT32  ui32YOffset,
+								IMG_UINT32  ui32SubWidth,
+								IMG_UINT32  ui32SubHeight,
+								IMG_UINT32  ui32StrideIn);
+
+IMG_VOID DeTwiddleSubRect32bpp(IMG_VOID   *pvDestAddress,
+								const IMG_VOID *pvSrcPixels,
+								IMG_UINT32  ui32Width,
+								IMG_UINT32  ui32Height,
+								IMG_UINT32  ui32XOffset,
+								IMG_UINT32  ui32YOffset,
+								IMG_UINT32  ui32SubWidth,
+								IMG_UINT32  ui32SubHeight,
+								IMG_UINT32  ui32StrideIn);
+
 
 #endif /* _TWIDDLE_ */
 
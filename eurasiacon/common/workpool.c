@@ -0,0 +1,991 @@
+/******************************************************************************
+ * Name         : workpool.c
+ *
+ * Copyright    : 2010 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means, electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Platform     : ANSI
+ *
+ * $Log: workpool.c $
+ *****************************************************************************/
+
+#if defined(__psp2__)
+#include <kernel.h>
+#include "services.h"
+#else
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#endif
+
+#include "workpool.h"
+
+/*
+ * Locking: the pool lock protects the job slots, the counters and the two
+ * condition variables; each worker's lock protects its deque. No thread
+ * ever holds both. A job is pushed on a deque before ui32Queued counts it,
+ * so a thread which takes one from ui32Queued is sure to find a job in
+ * some deque.
+ */
+
+#define WORKPOOL_NO_JOB			0xFFFFFFFFU
+
+#define WORKPOOL_STACK_SIZE		(64 * 1024)
+
+/* Is hToken1 submitted no later than hToken2 (tokens wrap) */
+#define WORKPOOL_TOKEN_NOT_AFTER(hToken1, hToken2)	((IMG_INT32)((hToken1) - (hToken2)) <= 0)
+
+
+/******************************************************************************
+ OS layer
+******************************************************************************/
+
+#if defined(__psp2__)
+
+typedef SceKernelLwMutexWork	WORKPOOL_MUTEX;
+typedef SceKernelLwCondWork		WORKPOOL_COND;
+typedef SceUID					WORKPOOL_THREAD;
+
+#define WorkPoolOSAlloc(ui32Size)	PVRSRVCallocUserModeMem(ui32Size)
+#define WorkPoolOSFree(pvMem)		PVRSRVFreeUserModeMem(pvMem)
+#define WorkPoolOSMemCopy(a, b, c)	PVRSRVMemCopy(a, b, c)
+
+static IMG_BOOL WorkPoolOSCreateMutex(WORKPOOL_MUTEX *psMutex, const IMG_CHAR *pszName)
+{
+	return (sceKernelCreateLwMutex(psMutex, pszName, 0, 0, IMG_NULL) == SCE_OK) ? IMG_TRUE : IMG_FALSE;
+}
+
+static IMG_VOID WorkPoolOSDestroyMutex(WORKPOOL_MUTEX *psMutex)
+{
+	sceKernelDeleteLwMutex(psMutex);
+}
+
+static IMG_VOID WorkPoolOSLock(WORKPOOL_MUTEX *psMutex)
+{
+	sceKernelLockLwMutex(psMutex, 1, IMG_NULL);
+}
+
+static IMG_VOID WorkPoolOSUnlock(WORKPOOL_MUTEX *psMutex)
+{
+	sceKernelUnlockLwMutex(psMutex, 1);
+}
+
+static IMG_BOOL WorkPoolOSCreateCond(WORKPOOL_COND *psCond, const IMG_CHAR *pszName, WORKPOOL_MUTEX *psMutex)
+{
+	return (sceKernelCreateLwCond(psCond, pszName, 0, psMutex, IMG_NULL) == SCE_OK) ? IMG_TRUE : IMG_FALSE;
+}
+
+static IMG_VOID WorkPoolOSDestroyCond(WORKPOOL_COND *psCond)
+{
+	sceKernelDeleteLwCond(psCond);
+}
+
+static IMG_VOID WorkPoolOSWait(WORKPOOL_COND *psCond, WORKPOOL_MUTEX *psMutex)
+{
+	PVR_UNREFERENCED_PARAMETER(psMutex);
+
+	sceKernelWaitLwCond(psCond, IMG_NULL);
+}
+
+static IMG_VOID WorkPoolOSSignal(WORKPOOL_COND *psCond)
+{
+	sceKernelSignalLwCond(psCond);
+}
+
+static IMG_VOID WorkPoolOSBroadcast(WORKPOOL_COND *psCond)
+{
+	sceKernelSignalLwCondAll(psCond);
+}
+
+static IMG_VOID WorkPoolWorker(IMG_VOID *pvWorker);
+
+static SceInt32 WorkPoolOSThreadEntry(SceSize uArgSize, IMG_VOID *pvArgBlock)
+{
+	PVR_UNREFERENCED_PARAMETER(uArgSize);
+
+	WorkPoolWorker(*(IMG_VOID **)pvArgBlock);
+
+	return 0;
+}
+
+static IMG_BOOL WorkPoolOSCreateThread(WORKPOOL_THREAD *phThread, const WORKPOOL_CONFIG *psConfig, IMG_VOID *pvWorker)
+{
+	IMG_INT32 i32Priority = psConfig->ui32Priority ? (IMG_INT32)psConfig->ui32Priority : SCE_KERNEL_DEFAULT_PRIORITY_USER;
+
+	*phThread = sceKernelCreateThread(psConfig->pszName, WorkPoolOSThreadEntry, i32Priority, WORKPOOL_STACK_SIZE,
+									  0, (IMG_INT32)psConfig->ui32AffinityMask, IMG_NULL);
+
+	if (*phThread < 0)
+	{
+		return IMG_FALSE;
+	}
+
+	if (sceKernelStartThread(*phThread, sizeof(pvWorker), &pvWorker) != SCE_OK)
+	{
+		sceKernelDeleteThread(*phThread);
+
+		return IMG_FALSE;
+	}
+
+	return IMG_TRUE;
+}
+
+static IMG_VOID WorkPoolOSJoinThread(WORKPOOL_THREAD hThread)
+{
+	sceKernelWaitThreadEnd(hThread, IMG_NULL, IMG_NULL);
+	sceKernelDeleteThread(hThread);
+}
+
+static WORKPOOL_THREAD WorkPoolOSThreadSelf(IMG_VOID)
+{
+	return sceKernelGetThreadId();
+}
+
+static IMG_BOOL WorkPoolOSThreadEqual(WORKPOOL_THREAD hThread1, WORKPOOL_THREAD hThread2)
+{
+	return (hThread1 == hThread2) ? IMG_TRUE : IMG_FALSE;
+}
+
+#else /* defined(__psp2__) */
+
+typedef pthread_mutex_t			WORKPOOL_MUTEX;
+typedef pthread_cond_t			WORKPOOL_COND;
+typedef pthread_t				WORKPOOL_THREAD;
+
+#define WorkPoolOSAlloc(ui32Size)	calloc(1, ui32Size)
+#define WorkPoolOSFree(pvMem)		free(pvMem)
+#define WorkPoolOSMemCopy(a, b, c)	memcpy(a, b, c)
+
+static IMG_BOOL WorkPoolOSCreateMutex(WORKPOOL_MUTEX *psMutex, const IMG_CHAR *pszName)
+{
+	PVR_UNREFERENCED_PARAMETER(pszName);
+
+	return (pthread_mutex_init(psMutex, IMG_NULL) == 0) ? IMG_TRUE : IMG_FALSE;
+}
+
+static IMG_VOID WorkPoolOSDestroyMutex(WORKPOOL_MUTEX *psMutex)
+{
+	pthread_mutex_destroy(psMutex);
+}
+
+static IMG_VOID WorkPoolOSLock(WORKPOOL_MUTEX *psMutex)
+{
+	pthread_mutex_lock(psMutex);
+}
+
+static IMG_VOID WorkPoolOSUnlock(WORKPOOL_MUTEX *psMutex)
+{
+	pthread_mutex_unlock(psMutex);
+}
+
+static IMG_BOOL WorkPoolOSCreateCond(WORKPOOL_COND *psCond, const IMG_CHAR *pszName, WORKPOOL_MUTEX *psMutex)
+{
+	PVR_UNREFERENCED_PARAMETER(pszName);
+	PVR_UNREFERENCED_PARAMETER(psMutex);
+
+	return (pthread_cond_init(psCond, IMG_NULL) == 0) ? IMG_TRUE : IMG_FALSE;
+}
+
+static IMG_VOID WorkPoolOSDestroyCond(WORKPOOL_COND *psCond)
+{
+	pthread_cond_destroy(psCond);
+}
+
+static IMG_VOID WorkPoolOSWait(WORKPOOL_COND *psCond, WORKPOOL_MUTEX *psMutex)
+{
+	pthread_cond_wait(psCond, psMutex);
+}
+
+static IMG_VOID WorkPoolOSSignal(WORKPOOL_COND *psCond)
+{
+	pthread_cond_signal(psCond);
+}
+
+static IMG_VOID WorkPoolOSBroadcast(WORKPOOL_COND *psCond)
+{
+	pthread_cond_broadcast(psCond);
+}
+
+static IMG_VOID WorkPoolWorker(IMG_VOID *pvWorker);
+
+static IMG_VOID *WorkPoolOSThreadEntry(IMG_VOID *pvWorker)
+{
+	WorkPoolWorker(pvWorker);
+
+	return IMG_NULL;
+}
+
+static IMG_BOOL WorkPoolOSCreateThread(WORKPOOL_THREAD *phThread, const WORKPOOL_CONFIG *psConfig, IMG_VOID *pvWorker)
+{
+	PVR_UNREFERENCED_PARAMETER(psConfig);
+
+	return (pthread_create(phThread, IMG_NULL, WorkPoolOSThreadEntry, pvWorker) == 0) ? IMG_TRUE : IMG_FALSE;
+}
+
+static IMG_VOID WorkPoolOSJoinThread(WORKPOOL_THREAD hThread)
+{
+	pthread_join(hThread, IMG_NULL);
+}
+
+static WORKPOOL_THREAD WorkPoolOSThreadSelf(IMG_VOID)
+{
+	return pthread_self();
+}
+
+static IMG_BOOL WorkPoolOSThreadEqual(WORKPOOL_THREAD hThread1, WORKPOOL_THREAD hThread2)
+{
+	return pthread_equal(hThread1, hThread2) ? IMG_TRUE : IMG_FALSE;
+}
+
+#endif /* defined(__psp2__) */
+
+
+/******************************************************************************
+ Pool
+******************************************************************************/
+
+typedef struct _WORKPOOL_JOB_
+{
+	PFN_WORKPOOL_JOB	pfnJob;
+
+	/* WORKPOOL_NO_TOKEN when the slot is free */
+	WORKPOOL_TOKEN		hToken;
+
+	/* Next free slot */
+	IMG_UINT32			ui32NextFree;
+
+	IMG_VOID			*pvData;
+
+} WORKPOOL_JOB;
+
+typedef struct _WORKPOOL_WORKER_
+{
+	WORKPOOL			*psPool;
+	IMG_UINT32			ui32Index;
+	WORKPOOL_THREAD		hThread;
+	IMG_BOOL			bThreadCreated;
+
+	/* Set by the worker itself once it runs (under the pool lock) */
+	WORKPOOL_THREAD		hSelf;
+	IMG_BOOL			bRunning;
+
+	/* Ring of job slot indices: ui32Count of them starting at ui32Head (the oldest) */
+	WORKPOOL_MUTEX		sLock;
+	IMG_BOOL			bLockCreated;
+	IMG_UINT32			*pui32Deque;
+	IMG_UINT32			ui32Head;
+	IMG_UINT32			ui32Count;
+
+} WORKPOOL_WORKER;
+
+/* A thread running a job in WorkPoolHelp; lives on that thread's stack */
+typedef struct _WORKPOOL_HELPER_
+{
+	WORKPOOL_THREAD				hThread;
+	struct _WORKPOOL_HELPER_	*psNext;
+
+} WORKPOOL_HELPER;
+
+struct _WORKPOOL_
+{
+	WORKPOOL_CONFIG		sConfig;
+
+	WORKPOOL_MUTEX		sLock;
+
+	/* Signalled when a job is queued */
+	WORKPOOL_COND		sWorkQueued;
+
+	/* Broadcast when a job finishes */
+	WORKPOOL_COND		sJobDone;
+
+	WORKPOOL_JOB		*psJobs;
+	IMG_UINT32			ui32FirstFree;
+
+	/* Jobs in slots (queued or running) */
+	IMG_UINT32			ui32JobsInFlight;
+
+	/* Jobs in deques which no thread has claimed yet */
+	IMG_UINT32			ui32Queued;
+
+	/* Deque the next job goes to */
+	IMG_UINT32			ui32NextWorker;
+
+	WORKPOOL_TOKEN		hLastToken;
+
+	IMG_BOOL			bShutdown;
+
+	WORKPOOL_STATS		sStats;
+
+	WORKPOOL_WORKER		*psWorkers;
+
+	WORKPOOL_HELPER		*psHelpers;
+};
+
+
+/***********************************************************************************
+ Function Name      : WorkPoolTakeJob
+ Inputs             : psPool, ui32Worker
+ Outputs            : pbStolen
+ Returns            : Job slot index
+ Description        : Removes a job which the caller has claimed from ui32Queued
+					  from the deques: the oldest job of worker ui32Worker's own
+					  deque, otherwise the oldest job of the next non-empty deque.
+					  Threads which aren't workers pass ui32NumWorkers.
+************************************************************************************/
+static IMG_UINT32 WorkPoolTakeJob(WORKPOOL *psPool, IMG_UINT32 ui32Worker, IMG_BOOL *pbStolen)
+{
+	IMG_UINT32 ui32NumWorkers = psPool->sConfig.ui32NumWorkers;
+	IMG_UINT32 ui32Capacity = psPool->sConfig.ui32MaxJobs;
+	IMG_UINT32 ui32Job = WORKPOOL_NO_JOB;
+	IMG_UINT32 i;
+
+	if (ui32Worker < ui32NumWorkers)
+	{
+		WORKPOOL_WORKER *psWorker = &psPool->psWorkers[ui32Worker];
+
+		WorkPoolOSLock(&psWorker->sLock);
+
+		if (psWorker->ui32Count)
+		{
+			ui32Job = psWorker->pui32Deque[psWorker->ui32Head];
+			psWorker->ui32Head = (psWorker->ui32Head + 1) % ui32Capacity;
+			psWorker->ui32Count--;
+		}
+
+		WorkPoolOSUnlock(&psWorker->sLock);
+
+		if (ui32Job != WORKPOOL_NO_JOB)
+		{
+			*pbStolen = IMG_FALSE;
+
+			return ui32Job;
+		}
+	}
+	else
+	{
+		ui32Worker = 0;
+	}
+
+	*pbStolen = IMG_TRUE;
+
+	/*
+		Another thread may take the job we saw from under us but then there is
+		another one queued for it, so keep looking.
+	*/
+	for (;;)
+	{
+		for (i = 0; i < ui32NumWorkers; i++)
+		{
+			WORKPOOL_WORKER *psVictim = &psPool->psWorkers[(ui32Worker + i) % ui32NumWorkers];
+
+			WorkPoolOSLock(&psVictim->sLock);
+
+			if (psVictim->ui32Count)
+			{
+				ui32Job = psVictim->pui32Deque[psVictim->ui32Head];
+				psVictim->ui32Head = (psVictim->ui32Head + 1) % ui32Capacity;
+				psVictim->ui32Count--;
+			}
+
+			WorkPoolOSUnlock(&psVictim->sLock);
+
+			if (ui32Job != WORKPOOL_NO_JOB)
+			{
+				return ui32Job;
+			}
+		}
+	}
+}
+
+/***********************************************************************************
+ Function Name      : WorkPoolRunJob
+ Inputs             : psPool, ui32Job
+ Outputs            : -
+ Returns            : -
+ Description        : Runs a job and frees its slot. Called without the pool lock.
+************************************************************************************/
+static IMG_VOID WorkPoolRunJob(WORKPOOL *psPool, IMG_UINT32 ui32Job)
+{
+	WORKPOOL_JOB *psJob = &psPool->psJobs[ui32Job];
+
+	psJob->pfnJob(psJob->pvData);
+
+	WorkPoolOSLock(&psPool->sLock);
+
+	psJob->hToken = WORKPOOL_NO_TOKEN;
+	psJob->ui32NextFree = psPool->ui32FirstFree;
+	psPool->ui32FirstFree = ui32Job;
+	psPool->ui32JobsInFlight--;
+
+	WorkPoolOSBroadcast(&psPool->sJobDone);
+
+	WorkPoolOSUnlock(&psPool->sLock);
+}
+
+/***********************************************************************************
+ Function Name      : WorkPoolHelp
+ Inputs             : psPool
+ Outputs            : -
+ Returns            : -
+ Description        : Runs a queued job on a thread waiting for the pool. Called
+					  with the pool lock held and ui32Queued non-zero; returns
+					  with the lock held.
+************************************************************************************/
+static IMG_VOID WorkPoolHelp(WORKPOOL *psPool)
+{
+	WORKPOOL_HELPER sHelper;
+	WORKPOOL_HELPER **ppsHelper;
+	IMG_UINT32 ui32Job;
+	IMG_BOOL bStolen;
+
+	psPool->ui32Queued--;
+	psPool->sStats.ui32Helped++;
+
+	sHelper.hThread = WorkPoolOSThreadSelf();
+	sHelper.psNext = psPool->psHelpers;
+	psPool->psHelpers = &sHelper;
+
+	WorkPoolOSUnlock(&psPool->sLock);
+
+	ui32Job = WorkPoolTakeJob(psPool, psPool->sConfig.ui32NumWorkers, &bStolen);
+
+	WorkPoolRunJob(psPool, ui32Job);
+
+	WorkPoolOSLock(&psPool->sLock);
+
+	/* Helpers may finish in any order */
+	ppsHelper = &psPool->psHelpers;
+
+	while (*ppsHelper != &sHelper)
+	{
+		ppsHelper = &(*ppsHelper)->psNext;
+	}
+
+	*ppsHelper = sHelper.psNext;
+}
+
+/***********************************************************************************
+ Function Name      : WorkPoolWorker
+ Inputs             : pvWorker
+ Outputs            : -
+ Returns            : -
+ Description        : Worker thread body: runs jobs until the pool shuts down and
+					  no job is left.
+************************************************************************************/
+static IMG_VOID WorkPoolWorker(IMG_VOID *pvWorker)
+{
+	WORKPOOL_WORKER *psWorker = (WORKPOOL_WORKER *)pvWorker;
+	WORKPOOL *psPool = psWorker->psPool;
+
+	WorkPoolOSLock(&psPool->sLock);
+
+	psWorker->hSelf = WorkPoolOSThreadSelf();
+	psWorker->bRunning = IMG_TRUE;
+
+	for (;;)
+	{
+		if (psPool->ui32Queued)
+		{
+			IMG_UINT32 ui32Job;
+			IMG_BOOL bStolen;
+
+			psPool->ui32Queued--;
+
+			WorkPoolOSUnlock(&psPool->sLock);
+
+			ui32Job = WorkPoolTakeJob(psPool, psWorker->ui32Index, &bStolen);
+
+			WorkPoolRunJob(psPool, ui32Job);
+
+			WorkPoolOSLock(&psPool->sLock);
+
+			if (bStolen)
+			{
+				psPool->sStats.ui32Stolen++;
+			}
+		}
+		else if (psPool->bShutdown)
+		{
+			break;
+		}
+		else
+		{
+			WorkPoolOSWait(&psPool->sWorkQueued, &psPool->sLock);
+		}
+	}
+
+	WorkPoolOSUnlock(&psPool->sLock);
+}
+
+/***********************************************************************************
+ Function Name      : WorkPoolIsCompleteLocked
+ Inputs             : psPool, hToken
+ Outputs            : -
+ Returns            : Whether the job hToken and every job before it have finished
+ Description        : Called with the pool lock held.
+************************************************************************************/
+static IMG_BOOL WorkPoolIsCompleteLocked(WORKPOOL *psPool, WORKPOOL_TOKEN hToken)
+{
+	IMG_UINT32 i;
+
+	if (hToken == WORKPOOL_NO_TOKEN || !psPool->ui32JobsInFlight)
+	{
+		return IMG_TRUE;
+	}
+
+	for (i = 0; i < psPool->sConfig.ui32MaxJobs; i++)
+	{
+		WORKPOOL_TOKEN hJobToken = psPool->psJobs[i].hToken;
+
+		if (hJobToken != WORKPOOL_NO_TOKEN && WORKPOOL_TOKEN_NOT_AFTER(hJobToken, hToken))
+		{
+			return IMG_FALSE;
+		}
+	}
+
+	return IMG_TRUE;
+}
+
+/***********************************************************************************
+ Function Name      : WorkPoolDestroy
+ Inputs             : psPool
+ Outputs            : -
+ Returns            : -
+ Description        : Runs every job still queued, then stops the workers and
+					  frees the pool. Also cleans up a partly created pool.
+************************************************************************************/
+IMG_INTERNAL IMG_VOID WorkPoolDestroy(WORKPOOL *psPool)
+{
+	IMG_UINT32 i;
+
+	if (!psPool)
+	{
+		return;
+	}
+
+	if (psPool->psWorkers)
+	{
+		WorkPoolOSLock(&psPool->sLock);
+
+		psPool->bShutdown = IMG_TRUE;
+
+		WorkPoolOSBroadcast(&psPool->sWorkQueued);
+
+		/* If no worker started the jobs are ours */
+		while (psPool->ui32Queued)
+		{
+			WorkPoolHelp(psPool);
+		}
+
+		WorkPoolOSUnlock(&psPool->sLock);
+
+		for (i = 0; i < psPool->sConfig.ui32NumWorkers; i++)
+		{
+			WORKPOOL_WORKER *psWorker = &psPool->psWorkers[i];
+
+			if (psWorker->bThreadCreated)
+			{
+				WorkPoolOSJoinThread(psWorker->hThread);
+			}
+			if (psWorker->bLockCreated)
+			{
+				WorkPoolOSDestroyMutex(&psWorker->sLock);
+			}
+			if (psWorker->pui32Deque)
+			{
+				WorkPoolOSFree(psWorker->pui32Deque);
+			}
+		}
+
+		WorkPoolOSFree(psPool->psWorkers);
+
+		WorkPoolOSDestroyCond(&psPool->sJobDone);
+		WorkPoolOSDestroyCond(&psPool->sWorkQueued);
+		WorkPoolOSDestroyMutex(&psPool->sLock);
+	}
+
+	if (psPool->psJobs)
+	{
+		if (psPool->psJobs[0].pvData)
+		{
+			WorkPoolOSFree(psPool->psJobs[0].pvData);
+		}
+
+		WorkPoolOSFree(psPool->psJobs);
+	}
+
+	WorkPoolOSFree(psPool);
+}
+
+/***********************************************************************************
+ Function Name      : WorkPoolCreate
+ Inputs             : psConfig
+ Outputs            : -
+ Returns            : New pool, or IMG_NULL if it couldn't be created
+ Description        : Allocates the job slots and deques and starts the workers.
+************************************************************************************/
+IMG_INTERNAL WORKPOOL *WorkPoolCreate(const WORKPOOL_CONFIG *psConfig)
+{
+	WORKPOOL *psPool;
+	IMG_UINT8 *pui8Data;
+	IMG_UINT32 ui32DataStride, i;
+
+	if (!psConfig->ui32NumWorkers || !psConfig->ui32MaxJobs)
+	{
+		return IMG_NULL;
+	}
+
+	psPool = WorkPoolOSAlloc(sizeof(WORKPOOL));
+
+	if (!psPool)
+	{
+		return IMG_NULL;
+	}
+
+	psPool->sConfig = *psConfig;
+
+	/* Keep every argument block aligned for any type */
+	ui32DataStride = (psConfig->ui32MaxJobDataSize + 7) & ~7U;
+
+	psPool->psJobs = WorkPoolOSAlloc(psConfig->ui32MaxJobs * sizeof(WORKPOOL_JOB));
+
+	if (!psPool->psJobs)
+	{
+		goto CreateFailed;
+	}
+
+	pui8Data = WorkPoolOSAlloc((ui32DataStride ? ui32DataStride : 8) * psConfig->ui32MaxJobs);
+
+	if (!pui8Data)
+	{
+		goto CreateFailed;
+	}
+
+	for (i = 0; i < psConfig->ui32MaxJobs; i++)
+	{
+		psPool->psJobs[i].hToken = WORKPOOL_NO_TOKEN;
+		psPool->psJobs[i].ui32NextFree = (i + 1 < psConfig->ui32MaxJobs) ? (i + 1) : WORKPOOL_NO_JOB;
+		psPool->psJobs[i].pvData = pui8Data + i * ui32DataStride;
+	}
+
+	psPool->ui32FirstFree = 0;
+
+	if (!WorkPoolOSCreateMutex(&psPool->sLock, psConfig->pszName))
+	{
+		goto CreateFailed;
+	}
+
+	if (!WorkPoolOSCreateCond(&psPool->sWorkQueued, psConfig->pszName, &psPool->sLock))
+	{
+		WorkPoolOSDestroyMutex(&psPool->sLock);
+
+		goto CreateFailed;
+	}
+
+	if (!WorkPoolOSCreateCond(&psPool->sJobDone, psConfig->pszName, &psPool->sLock))
+	{
+		WorkPoolOSDestroyCond(&psPool->sWorkQueued);
+		WorkPoolOSDestroyMutex(&psPool->sLock);
+
+		goto CreateFailed;
+	}
+
+	/* From here on WorkPoolDestroy can undo a partial setup */
+	psPool->psWorkers = WorkPoolOSAlloc(psConfig->ui32NumWorkers * sizeof(WORKPOOL_WORKER));
+
+	if (!psPool->psWorkers)
+	{
+		WorkPoolOSDestroyCond(&psPool->sJobDone);
+		WorkPoolOSDestroyCond(&psPool->sWorkQueued);
+		WorkPoolOSDestroyMutex(&psPool->sLock);
+
+		goto CreateFailed;
+	}
+
+	for (i = 0; i < psConfig->ui32NumWorkers; i++)
+	{
+		WORKPOOL_WORKER *psWorker = &psPool->psWorkers[i];
+
+		psWorker->psPool = psPool;
+		psWorker->ui32Index = i;
+
+		psWorker->pui32Deque = WorkPoolOSAlloc(psConfig->ui32MaxJobs * sizeof(IMG_UINT32));
+
+		if (!psWorker->pui32Deque)
+		{
+			goto CreateFailed;
+		}
+
+		psWorker->bLockCreated = WorkPoolOSCreateMutex(&psWorker->sLock, psConfig->pszName);
+
+		if (!psWorker->bLockCreated)
+		{
+			goto CreateFailed;
+		}
+	}
+
+	for (i = 0; i < psConfig->ui32NumWorkers; i++)
+	{
+		WORKPOOL_WORKER *psWorker = &psPool->psWorkers[i];
+
+		psWorker->bThreadCreated = WorkPoolOSCreateThread(&psWorker->hThread, psConfig, psWorker);
+
+		if (!psWorker->bThreadCreated)
+		{
+			goto CreateFailed;
+		}
+	}
+
+	return psPool;
+
+CreateFailed:
+
+	WorkPoolDestroy(psPool);
+
+	return IMG_NULL;
+}
+
+/***********************************************************************************
+ Function Name      : WorkPoolSubmit
+ Inputs             : psPool, pfnJob, pvData, ui32DataSize
+ Outputs            : -
+ Returns            : Token of the job
+ Description        : Queues pfnJob with a copy of the ui32DataSize bytes at
+					  pvData. If every job slot is in use, runs queued jobs or
+					  waits until one is free.
+************************************************************************************/
+IMG_INTERNAL WORKPOOL_TOKEN WorkPoolSubmit(WORKPOOL *psPool, PFN_WORKPOOL_JOB pfnJob,
+										   const IMG_VOID *pvData, IMG_UINT32 ui32DataSize)
+{
+	WORKPOOL_WORKER *psWorker;
+	WORKPOOL_JOB *psJob;
+	WORKPOOL_TOKEN hToken;
+	IMG_UINT32 ui32Job;
+
+	WorkPoolOSLock(&psPool->sLock);
+
+	if (psPool->ui32FirstFree == WORKPOOL_NO_JOB)
+	{
+		psPool->sStats.ui32SubmitStalls++;
+
+		while (psPool->ui32FirstFree == WORKPOOL_NO_JOB)
+		{
+			if (psPool->ui32Queued)
+			{
+				WorkPoolHelp(psPool);
+			}
+			else
+			{
+				WorkPoolOSWait(&psPool->sJobDone, &psPool->sLock);
+			}
+		}
+	}
+
+	ui32Job = psPool->ui32FirstFree;
+	psJob = &psPool->psJobs[ui32Job];
+	psPool->ui32FirstFree = psJob->ui32NextFree;
+
+	hToken = psPool->hLastToken + 1;
+
+	if (hToken == WORKPOOL_NO_TOKEN)
+	{
+		hToken++;
+	}
+
+	psPool->hLastToken = hToken;
+	psPool->ui32JobsInFlight++;
+	psPool->sStats.ui32Submitted++;
+
+	psJob->pfnJob = pfnJob;
+	psJob->hToken = hToken;
+
+	psWorker = &psPool->psWorkers[psPool->ui32NextWorker];
+	psPool->ui32NextWorker = (psPool->ui32NextWorker + 1) % psPool->sConfig.ui32NumWorkers;
+
+	WorkPoolOSUnlock(&psPool->sLock);
+
+	/* The slot is ours until it is queued */
+	if (ui32DataSize)
+	{
+		WorkPoolOSMemCopy(psJob->pvData, pvData, ui32DataSize);
+	}
+
+	WorkPoolOSLock(&psWorker->sLock);
+
+	psWorker->pui32Deque[(psWorker->ui32Head + psWorker->ui32Count) % psPool->sConfig.ui32MaxJobs] = ui32Job;
+	psWorker->ui32Count++;
+
+	WorkPoolOSUnlock(&psWorker->sLock);
+
+	WorkPoolOSLock(&psPool->sLock);
+
+	psPool->ui32Queued++;
+
+	WorkPoolOSSignal(&psPool->sWorkQueued);
+
+	WorkPoolOSUnlock(&psPool->sLock);
+
+	return hToken;
+}
+
+/***********************************************************************************
+ Function Name      : WorkPoolIsComplete
+ Inputs             : psPool, hToken
+ Outputs            : -
+ Returns            : Whether the job hToken and every job before it have finished
+ Description        : -
+************************************************************************************/
+IMG_INTERNAL IMG_BOOL WorkPoolIsComplete(WORKPOOL *psPool, WORKPOOL_TOKEN hToken)
+{
+	IMG_BOOL bComplete;
+
+	if (hToken == WORKPOOL_NO_TOKEN)
+	{
+		return IMG_TRUE;
+	}
+
+	WorkPoolOSLock(&psPool->sLock);
+
+	bComplete = WorkPoolIsCompleteLocked(psPool, hToken);
+
+	WorkPoolOSUnlock(&psPool->sLock);
+
+	return bComplete;
+}
+
+/***********************************************************************************
+ Function Name      : WorkPoolWait
+ Inputs             : psPool, hToken, bHelp
+ Outputs            : -
+ Returns            : -
+ Description        : Waits until the job hToken and every job before it have
+					  finished. With bHelp the caller runs queued jobs meanwhile
+					  instead of sleeping.
+************************************************************************************/
+IMG_INTERNAL IMG_VOID WorkPoolWait(WORKPOOL *psPool, WORKPOOL_TOKEN hToken, IMG_BOOL bHelp)
+{
+	if (hToken == WORKPOOL_NO_TOKEN)
+	{
+		return;
+	}
+
+	WorkPoolOSLock(&psPool->sLock);
+
+	while (!WorkPoolIsCompleteLocked(psPool, hToken))
+	{
+		if (bHelp && psPool->ui32Queued)
+		{
+			WorkPoolHelp(psPool);
+		}
+		else
+		{
+			WorkPoolOSWait(&psPool->sJobDone, &psPool->sLock);
+		}
+	}
+
+	WorkPoolOSUnlock(&psPool->sLock);
+}
+
+/***********************************************************************************
+ Function Name      : WorkPoolLastToken
+ Inputs             : psPool
+ Outputs            : -
+ Returns            : Token of the last job submitted
+ Description        : -
+************************************************************************************/
+IMG_INTERNAL WORKPOOL_TOKEN WorkPoolLastToken(WORKPOOL *psPool)
+{
+	WORKPOOL_TOKEN hToken;
+
+	WorkPoolOSLock(&psPool->sLock);
+
+	hToken = psPool->hLastToken;
+
+	WorkPoolOSUnlock(&psPool->sLock);
+
+	return hToken;
+}
+
+/***********************************************************************************
+ Function Name      : WorkPoolInJob
+ Inputs             : psPool
+ Outputs            : -
+ Returns            : Whether the calling thread is running one of the pool's jobs
+ Description        : True on the workers and on a thread helping in WorkPoolSubmit
+					  or WorkPoolWait. A job must not wait for something which
+					  waits for the pool, since that includes the job itself.
+************************************************************************************/
+IMG_INTERNAL IMG_BOOL WorkPoolInJob(WORKPOOL *psPool)
+{
+	WORKPOOL_THREAD hSelf = WorkPoolOSThreadSelf();
+	WORKPOOL_HELPER *psHelper;
+	IMG_BOOL bInJob = IMG_FALSE;
+	IMG_UINT32 i;
+
+	WorkPoolOSLock(&psPool->sLock);
+
+	for (i = 0; i < psPool->sConfig.ui32NumWorkers && !bInJob; i++)
+	{
+		WORKPOOL_WORKER *psWorker = &psPool->psWorkers[i];
+
+		bInJob = psWorker->bRunning && WorkPoolOSThreadEqual(psWorker->hSelf, hSelf);
+	}
+
+	for (psHelper = psPool->psHelpers; psHelper && !bInJob; psHelper = psHelper->psNext)
+	{
+		bInJob = WorkPoolOSThreadEqual(psHelper->hThread, hSelf);
+	}
+
+	WorkPoolOSUnlock(&psPool->sLock);
+
+	return bInJob;
+}
+
+/***********************************************************************************
+ Function Name      : WorkPoolLaterToken
+ Inputs             : hToken1, hToken2
+ Outputs            : -
+ Returns            : The later of two tokens of the same pool
+ Description        : Waiting for the result waits for both jobs.
+************************************************************************************/
+IMG_INTERNAL WORKPOOL_TOKEN WorkPoolLaterToken(WORKPOOL_TOKEN hToken1, WORKPOOL_TOKEN hToken2)
+{
+	if (hToken1 == WORKPOOL_NO_TOKEN)
+	{
+		return hToken2;
+	}
+	if (hToken2 == WORKPOOL_NO_TOKEN)
+	{
+		return hToken1;
+	}
+
+	return WORKPOOL_TOKEN_NOT_AFTER(hToken1, hToken2) ? hToken2 : hToken1;
+}
+
+/***********************************************************************************
+ Function Name      : WorkPoolGetStats
+ Inputs             : psPool
+ Outputs            : psStats
+ Returns            : -
+ Description        : -
+************************************************************************************/
+IMG_INTERNAL IMG_VOID WorkPoolGetStats(WORKPOOL *psPool, WORKPOOL_STATS *psStats)
+{
+	WorkPoolOSLock(&psPool->sLock);
+
+	*psStats = psPool->sStats;
+
+	WorkPoolOSUnlock(&psPool->sLock);
+}
+
+/******************************************************************************
+ End of file (workpool.c)
+******************************************************************************/
@@ -0,0 +1,119 @@
+/******************************************************************************
+ * Name         : workpool.h
+ *
+ * Copyright    : 2010 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means, electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Platform     : ANSI
+ *
+ * $Log: workpool.h $
+ *****************************************************************************/
+
+#ifndef _WORKPOOL_H_
+#define _WORKPOOL_H_
+
+#include "img_defs.h"
+#include "img_types.h"
+
+/*
+ * A fixed set of worker threads running short CPU jobs (software texture
+ * uploads, mipmap generation).
+ *
+ *    - Every worker owns a deque of queued jobs. Submitted jobs are spread
+ *      over the deques; a worker runs the jobs of its own deque and, when
+ *      that is empty, steals from another one. Jobs don't spawn jobs, so
+ *      nothing is gained by running the newest first: both ends take the
+ *      oldest job, which keeps the wait for any token short.
+ *
+ *    - The pool holds at most ui32MaxJobs queued or running jobs, each with
+ *      ui32MaxJobDataSize bytes of arguments copied in at submission, so its
+ *      memory is allocated once in WorkPoolCreate. When every job slot is in
+ *      use WorkPoolSubmit runs queued jobs on the calling thread (or waits
+ *      for one to finish) until a slot is free: it never fails.
+ *
+ *    - Each job gets a token. Tokens increase in submission order, and
+ *      WorkPoolWait(hToken) returns once that job and every job submitted
+ *      before it have finished, so the token of the last job touching a
+ *      resource is all a later user of the resource has to keep.
+ *
+ * The threads, locks and condition variables are those of the OS: PSP2
+ * kernel threads with lightweight mutexes and condition variables, POSIX
+ * threads elsewhere (for testing and benchmarking the pool on a host).
+ */
+
+typedef IMG_UINT32 WORKPOOL_TOKEN;
+
+/* A token which is always complete */
+#define WORKPOOL_NO_TOKEN	((WORKPOOL_TOKEN)0)
+
+typedef IMG_VOID (*PFN_WORKPOOL_JOB)(IMG_VOID *pvData);
+
+typedef struct _WORKPOOL_ WORKPOOL;
+
+typedef struct _WORKPOOL_CONFIG_
+{
+	const IMG_CHAR	*pszName;
+
+	/* Worker threads, at least one */
+	IMG_UINT32		ui32NumWorkers;
+
+	/* Jobs queued or running at once */
+	IMG_UINT32		ui32MaxJobs;
+
+	/* Largest argument block passed to WorkPoolSubmit */
+	IMG_UINT32		ui32MaxJobDataSize;
+
+	/* Worker thread priority and CPU affinity mask (0 for the default); PSP2 only */
+	IMG_UINT32		ui32Priority;
+	IMG_UINT32		ui32AffinityMask;
+
+} WORKPOOL_CONFIG;
+
+typedef struct _WORKPOOL_STATS_
+{
+	/* Jobs submitted */
+	IMG_UINT32		ui32Submitted;
+
+	/* Jobs a worker took from another worker's deque */
+	IMG_UINT32		ui32Stolen;
+
+	/* Jobs run by a thread waiting in WorkPoolSubmit or WorkPoolWait */
+	IMG_UINT32		ui32Helped;
+
+	/* Submissions which found every job slot in use */
+	IMG_UINT32		ui32SubmitStalls;
+
+} WORKPOOL_STATS;
+
+IMG_INTERNAL WORKPOOL *WorkPoolCreate(const WORKPOOL_CONFIG *psConfig);
+
+IMG_INTERNAL IMG_VOID WorkPoolDestroy(WORKPOOL *psPool);
+
+IMG_INTERNAL WORKPOOL_TOKEN WorkPoolSubmit(WORKPOOL *psPool, PFN_WORKPOOL_JOB pfnJob,
+										   const IMG_VOID *pvData, IMG_UINT32 ui32DataSize);
+
+IMG_INTERNAL IMG_BOOL WorkPoolIsComplete(WORKPOOL *psPool, WORKPOOL_TOKEN hToken);
+
+IMG_INTERNAL IMG_VOID WorkPoolWait(WORKPOOL *psPool, WORKPOOL_TOKEN hToken, IMG_BOOL bHelp);
+
+IMG_INTERNAL WORKPOOL_TOKEN WorkPoolLastToken(WORKPOOL *psPool);
+
+IMG_INTERNAL IMG_BOOL WorkPoolInJob(WORKPOOL *psPool);
+
+IMG_INTERNAL WORKPOOL_TOKEN WorkPoolLaterToken(WORKPOOL_TOKEN hToken1, WORKPOOL_TOKEN hToken2);
+
+IMG_INTERNAL IMG_VOID WorkPoolGetStats(WORKPOOL *psPool, WORKPOOL_STATS *psStats);
+
+#endif /* _WORKPOOL_H_ */
+
+/******************************************************************************
+ End of file (workpool.h)
+******************************************************************************/
@@ -0,0 +1,818 @@
+/******************************************************************************
+ * Name         : cfg_index.c
+ * Title        : EGL Config Selection Index
+ *
+ * Copyright    : 2011 by Imagination Technologies Limited.
+ *                All rights reserved. No part of this software, either
+ *                material or conceptual may be copied or distributed,
+ *                transmitted, transcribed, stored in a retrieval system or
+ *                translated into any human or computer language in any form
+ *                by any means, electronic, mechanical, manual or otherwise,
+ *                or disclosed to third parties without the express written
+ *                permission of Imagination Technologies Limited, Home
+ *                Park Estate, Kings Langley, Hertfordshire, WD4 8LZ, U.K.
+ *
+ * Description  : Precomputed attribute bitsets and sort keys answering
+ *                eglChooseConfig. See cfg_index.h.
+ *
+ * Platform : ALL
+ *
+ * $Log: cfg_index.c $
+ *************************************************************************/
+
+#include "egl_internal.h"
+#include "cfg.h"
+#include "cfg_index.h"
+#include "qsort.h"
+
+
+#define CFGI_MASK_BITS	32
+
+static const enum
+{
+	atleast,
+	exact,
+	mask
+} aAttribMatchCriteria[] =
+{
+#define A(N,D,C) C,
+#include "attrib.h"
+#undef A
+};
+
+static const EGLint aAttribDflts[] =
+{
+#define A(N,D,C) N, D,
+#include "attrib.h"
+#undef A
+EGL_NONE
+};
+
+/* The colour bits summed by the sort, as _CompareColourBits */
+static const CFGI_ATTRIB_INDEX aeColourAttribs[4] =
+{
+	CFGI_EGL_ALPHA_SIZE,
+	CFGI_EGL_RED_SIZE,
+	CFGI_EGL_GREEN_SIZE,
+	CFGI_EGL_BLUE_SIZE
+};
+
+/* The sort keys following the colour bits, in CFG_Compare order */
+static const CFGI_ATTRIB_INDEX aeRankAttribs[] =
+{
+	CFGI_EGL_BUFFER_SIZE,
+	CFGI_EGL_SAMPLE_BUFFERS,
+	CFGI_EGL_SAMPLES,
+	CFGI_EGL_DEPTH_SIZE,
+	CFGI_EGL_STENCIL_SIZE,
+	CFGI_EGL_CONFIG_ID
+};
+
+
+/*
+   <function>
+   FUNCTION   : _CaveatOrder
+   PURPOSE    : Determine a sort order priority for a caveat, as CFG_Compare.
+   PARAMETERS : In:  caveat -
+   RETURNS    : Sort priority.
+   </function>
+ */
+static EGLint _CaveatOrder(EGLint caveat)
+{
+	switch (caveat)
+	{
+		case EGL_SLOW_CONFIG:
+		{
+			return 1;
+		}
+		case EGL_NON_CONFORMANT_CONFIG:
+		{
+			return 2;
+		}
+	}
+
+	return 0;
+}
+
+
+/*
+   <function>
+   FUNCTION   : _CompareValues
+   PURPOSE    : Order attribute values ascending. Callback to qsort_s.
+   PARAMETERS : In:  pA - 1st value
+                In:  pB - 2nd value
+                In:  pState - unused
+   RETURNS    : <0, 0 or >0 as a is less than, equal to or greater than b.
+   </function>
+ */
+static IMG_INT _CompareValues(IMG_VOID *pA, IMG_VOID *pB, IMG_VOID *pState)
+{
+	EGLint iA = *(EGLint *)pA;
+	EGLint iB = *(EGLint *)pB;
+
+	PVR_UNREFERENCED_PARAMETER(pState);
+
+	return (iA < iB) ? -1 : ((iA > iB) ? 1 : 0);
+}
+
+
+/*
+   <function>
+   FUNCTION   : _CompareRank
+   PURPOSE    :
+
+   Order configurations by the sort keys following the colour bits.
+   Callback to qsort_s.
+
+   PARAMETERS : In:  pA - 1st configuration number
+                In:  pB - 2nd configuration number
+                In:  pState - attribute values, CFGI_NUM_ATTRIBS per
+                     configuration
+   RETURNS    : <0, 0 or >0 as a sorts before, with or after b.
+   </function>
+ */
+static IMG_INT _CompareRank(IMG_VOID *pA, IMG_VOID *pB, IMG_VOID *pState)
+{
+	const EGLint *piValues = (const EGLint *)pState;
+	const EGLint *piA = piValues + *(IMG_UINT32 *)pA * CFGI_NUM_ATTRIBS;
+	const EGLint *piB = piValues + *(IMG_UINT32 *)pB * CFGI_NUM_ATTRIBS;
+	IMG_UINT32 i;
+
+	for (i = 0; i < sizeof(aeRankAttribs) / sizeof(aeRankAttribs[0]); i++)
+	{
+		EGLint iA = piA[aeRankAttribs[i]];
+		EGLint iB = piB[aeRankAttribs[i]];
+
+		if (iA != iB)
+		{
+			return (iA < iB) ? -1 : 1;
+		}
+	}
+
+	return 0;
+}
+
+
+/*
+   <function>
+   FUNCTION   : _CompareSort
+   PURPOSE    : Order matching configurations by key, then rank. Callback
+                to qsort_s.
+   PARAMETERS : In:  pA - 1st sort entry
+                In:  pB - 2nd sort entry
+                In:  pState - unused
+   RETURNS    : <0, 0 or >0 as a sorts before, with or after b.
+   </function>
+ */
+static IMG_INT _CompareSort(IMG_VOID *pA, IMG_VOID *pB, IMG_VOID *pState)
+{
+	const CFGI_SORT *psA = (const CFGI_SORT *)pA;
+	const CFGI_SORT *psB = (const CFGI_SORT *)pB;
+
+	PVR_UNREFERENCED_PARAMETER(pState);
+
+	if (psA->i64Key != psB->i64Key)
+	{
+		return (psA->i64Key < psB->i64Key) ? -1 : 1;
+	}
+
+	return (psA->ui32Rank < psB->ui32Rank) ? -1 : ((psA->ui32Rank > psB->ui32Rank) ? 1 : 0);
+}
+
+
+/*
+   <function>
+   FUNCTION   : _FindValue
+   PURPOSE    : Find the first of an attribute's values at least a value.
+   PARAMETERS : In:  psAttrib - attribute
+                In:  iValue - value to find
+   RETURNS    : Value number, or ui32NumValues if every value is less.
+   </function>
+ */
+static IMG_UINT32 _FindValue(const CFGI_ATTRIB *psAttrib, EGLint iValue)
+{
+	IMG_UINT32 ui32Low = 0;
+	IMG_UINT32 ui32High = psAttrib->ui32NumValues;
+
+	while (ui32Low < ui32High)
+	{
+		IMG_UINT32 ui32Mid = (ui32Low + ui32High) >> 1;
+
+		if (psAttrib->piValues[ui32Mid] < iValue)
+		{
+			ui32Low = ui32Mid + 1;
+		}
+		else
+		{
+			ui32High = ui32Mid;
+		}
+	}
+
+	return ui32Low;
+}
+
+
+/*
+   <function>
+   FUNCTION   : _BuildAttrib
+   PURPOSE    : Build the value bitsets of an attribute.
+   PARAMETERS : In:  psIndex - index, with the configurations counted
+                In:  eAttrib - attribute
+                In:  piValues - attribute values, CFGI_NUM_ATTRIBS per
+                     configuration
+                In:  piScratch - space for a value per configuration
+   RETURNS    : IMG_TRUE, or IMG_FALSE if out of memory.
+   </function>
+ */
+static IMG_BOOL _BuildAttrib(CFGI_INDEX *psIndex, CFGI_ATTRIB_INDEX eAttrib, const EGLint *piValues, EGLint *piScratch)
+{
+	CFGI_ATTRIB *psAttrib = &psIndex->asAttrib[eAttrib];
+	IMG_UINT32 ui32Words = psIndex->ui32SetWords;
+	IMG_UINT32 ui32NumValues;
+	IMG_UINT32 i, j;
+
+	if (aAttribMatchCriteria[eAttrib] == mask)
+	{
+		psAttrib->ui32NumValues = CFGI_MASK_BITS;
+
+		psAttrib->pui32Sets = EGLCalloc(sizeof(IMG_UINT32) * CFGI_MASK_BITS * ui32Words);
+
+		if (!psAttrib->pui32Sets)
+		{
+			return IMG_FALSE;
+		}
+
+		for (i = 0; i < psIndex->ui32NumConfigs; i++)
+		{
+			IMG_UINT32 ui32Value = (IMG_UINT32)piValues[i * CFGI_NUM_ATTRIBS + eAttrib];
+
+			for (j = 0; j < CFGI_MASK_BITS; j++)
+			{
+				if (ui32Value & (1U << j))
+				{
+					psAttrib->pui32Sets[j * ui32Words + (i >> 5)] |= 1U << (i & 31);
+				}
+			}
+		}
+
+		return IMG_TRUE;
+	}
+
+	/* Sorted distinct values */
+	for (i = 0; i < psIndex->ui32NumConfigs; i++)
+	{
+		piScratch[i] = piValues[i * CFGI_NUM_ATTRIBS + eAttrib];
+	}
+
+	/* PVR_qsort_s needs an element to start from */
+	if (psIndex->ui32NumConfigs > 1)
+	{
+		PVR_qsort_s(piScratch, (IMG_INT)psIndex->ui32NumConfigs, sizeof(EGLint), _CompareValues, IMG_NULL);
+	}
+
+	for (ui32NumValues = 0, i = 0; i < psIndex->ui32NumConfigs; i++)
+	{
+		if (!ui32NumValues || piScratch[i] != piScratch[ui32NumValues - 1])
+		{
+			piScratch[ui32NumValues++] = piScratch[i];
+		}
+	}
+
+	psAttrib->piValues = EGLMalloc(sizeof(EGLint) * ui32NumValues);
+	psAttrib->pui32Sets = EGLCalloc(sizeof(IMG_UINT32) * ui32NumValues * ui32Words);
+
+	if (!psAttrib->piValues || !psAttrib->pui32Sets)
+	{
+		return IMG_FALSE;
+	}
+
+	for (i = 0; i < ui32NumValues; i++)
+	{
+		psAttrib->piValues[i] = piScratch[i];
+	}
+	psAttrib->ui32NumValues = ui32NumValues;
+
+	/* The configurations with each value... */
+	for (i = 0; i < psIndex->ui32NumConfigs; i++)
+	{
+		IMG_UINT32 ui32Value = _FindValue(psAttrib, piValues[i * CFGI_NUM_ATTRIBS + eAttrib]);
+
+		psAttrib->pui32Sets[ui32Value * ui32Words + (i >> 5)] |= 1U << (i & 31);
+	}
+
+	/* ...or with each value or more */
+	if (aAttribMatchCriteria[eAttrib] == atleast)
+	{
+		for (i = ui32NumValues - 1; i > 0; i--)
+		{
+			for (j = 0; j < ui32Words; j++)
+			{
+				psAttrib->pui32Sets[(i - 1) * ui32Words + j] |= psAttrib->pui32Sets[i * ui32Words + j];
+			}
+		}
+	}
+
+	return IMG_TRUE;
+}
+
+
+/*
+   <function>
+   FUNCTION   : CFGI_Create
+   PURPOSE    : Generate every configuration of a display and index them.
+   PARAMETERS : In:  psDpy - Initialised display.
+   RETURNS    : Index, or IMG_NULL if out of memory.
+   </function>
+ */
+IMG_INTERNAL CFGI_INDEX *CFGI_Create(KEGL_DISPLAY *psDpy)
+{
+	CFGI_INDEX *psIndex;
+	EGLint *piValues = IMG_NULL;
+	EGLint *piScratch = IMG_NULL;
+	IMG_UINT32 *pui32Order = IMG_NULL;
+	EGLint iNumConfigs;
+	IMG_UINT32 i, j;
+
+	iNumConfigs = CFG_Variants(psDpy);
+
+	psIndex = EGLCalloc(sizeof(*psIndex));
+
+	if (!psIndex)
+	{
+		return IMG_NULL;
+	}
+
+	psIndex->ui32NumConfigs = (IMG_UINT32)iNumConfigs;
+	psIndex->ui32SetWords = (psIndex->ui32NumConfigs + 31) >> 5;
+
+	if (!psIndex->ui32NumConfigs)
+	{
+		return psIndex;
+	}
+
+	psIndex->psConfigs = EGLCalloc(sizeof(CFGI_CONFIG) * psIndex->ui32NumConfigs);
+	psIndex->pui32Matches = EGLMalloc(sizeof(IMG_UINT32) * psIndex->ui32SetWords);
+	psIndex->psSort = EGLMalloc(sizeof(CFGI_SORT) * psIndex->ui32NumConfigs);
+
+	piValues = EGLMalloc(sizeof(EGLint) * CFGI_NUM_ATTRIBS * psIndex->ui32NumConfigs);
+	piScratch = EGLMalloc(sizeof(EGLint) * psIndex->ui32NumConfigs);
+	pui32Order = EGLMalloc(sizeof(IMG_UINT32) * psIndex->ui32NumConfigs);
+
+	if (!psIndex->psConfigs || !psIndex->pui32Matches || !psIndex->psSort ||
+		!piValues || !piScratch || !pui32Order)
+	{
+		goto failed;
+	}
+
+	/* Record the attributes of every configuration, as CFG_Match and CFG_Compare read them */
+	for (i = 0; i < psIndex->ui32NumConfigs; i++)
+	{
+		CFGI_CONFIG *psConfig = &psIndex->psConfigs[i];
+		EGLint *piConfigValues = piValues + i * CFGI_NUM_ATTRIBS;
+		KEGL_CONFIG *psCfg;
+
+		if (CFG_GenerateVariant(psDpy, (KEGL_CONFIG_INDEX)(i + 1), &psCfg) != EGL_SUCCESS)
+		{
+			goto failed;
+		}
+
+		for (j = 0; j < CFGI_NUM_ATTRIBS; j++)
+		{
+			piConfigValues[j] = CFGC_GetAttrib(psCfg, aAttribDflts[j * 2]);
+		}
+
+		CFGC_Unlink(psCfg);
+
+		psConfig->iConfigID = piConfigValues[CFGI_EGL_CONFIG_ID];
+		psConfig->iCaveatOrder = _CaveatOrder(piConfigValues[CFGI_EGL_CONFIG_CAVEAT]);
+
+		for (j = 0; j < 4; j++)
+		{
+			psConfig->aiColour[j] = piConfigValues[aeColourAttribs[j]];
+		}
+
+		pui32Order[i] = i;
+	}
+
+	for (j = 0; j < CFGI_NUM_ATTRIBS; j++)
+	{
+		if (!_BuildAttrib(psIndex, (CFGI_ATTRIB_INDEX)j, piValues, piScratch))
+		{
+			goto failed;
+		}
+	}
+
+	/* Rank by the sort keys which don't depend on the request */
+	if (psIndex->ui32NumConfigs > 1)
+	{
+		PVR_qsort_s(pui32Order, (IMG_INT)psIndex->ui32NumConfigs, sizeof(IMG_UINT32), _CompareRank, piValues);
+	}
+
+	for (i = 0; i < psIndex->ui32NumConfigs; i++)
+	{
+		psIndex->psConfigs[pui32Order[i]].ui32Rank = i;
+	}
+
+	EGLFree(pui32Order);
+	EGLFree(piScratch);
+	EGLFree(piValues);
+
+	return psIndex;
+
+failed:
+
+	if (pui32Order)
+	{
+		EGLFree(pui32Order);
+	}
+	if (piScratch)
+	{
+		EGLFree(piScratch);
+	}
+	if (piValues)
+	{
+		EGLFree(piValues);
+	}
+
+	CFGI_Destroy(psIndex);
+
+	return IMG_NULL;
+}
+
+
+/*
+   <function>
+   FUNCTION   : CFGI_Destroy
+   PURPOSE    : Free an index and its memoised queries.
+   PARAMETERS : In:  psIndex - Index, or IMG_NULL.
+   RETURNS    : None
+   </function>
+ */
+IMG_INTERNAL IMG_VOID CFGI_Destroy(CFGI_INDEX *psIndex)
+{
+	IMG_UINT32 i;
+
+	if (!psIndex)
+	{
+		return;
+	}
+
+	for (i = 0; i < CFGI_MEMO_ENTRIES; i++)
+	{
+		if (psIndex->asMemo[i].piConfigIDs)
+		{
+			EGLFree(psIndex->asMemo[i].piConfigIDs);
+		}
+	}
+
+	for (i = 0; i < CFGI_NUM_ATTRIBS; i++)
+	{
+		if (psIndex->asAttrib[i].piValues)
+		{
+			EGLFree(psIndex->asAttrib[i].piValues);
+		}
+		if (psIndex->asAttrib[i].pui32Sets)
+		{
+			EGLFree(psIndex->asAttrib[i].pui32Sets);
+		}
+	}
+
+	if (psIndex->psSort)
+	{
+		EGLFree(psIndex->psSort);
+	}
+	if (psIndex->pui32Matches)
+	{
+		EGLFree(psIndex->pui32Matches);
+	}
+	if (psIndex->psConfigs)
+	{
+		EGLFree(psIndex->psConfigs);
+	}
+
+	EGLFree(psIndex);
+}
+
+
+/*
+   <function>
+   FUNCTION   : _CanonicaliseAttribList
+   PURPOSE    :
+
+   Reduce an attribute list to the value it gives each matchable
+   attribute, as CFG_PrepareConfigFilter reads it: the first occurrence
+   of an attribute counts, attributes not listed take their defaults and
+   the attributes CFG_Match ignores are dropped.
+
+   PARAMETERS : In:  pAttribList - attribute list, or IMG_NULL.
+                In:  nAttribCount - number of attribs (identifiers + values)
+                Out: aiRequest - Receives the values.
+   RETURNS    : None
+   </function>
+ */
+static IMG_VOID _CanonicaliseAttribList(const EGLint *pAttribList, EGLint nAttribCount, EGLint aiRequest[CFGI_NUM_ATTRIBS])
+{
+	IMG_BOOL abListed[CFGI_NUM_ATTRIBS];
+	EGLint i;
+	IMG_UINT32 j;
+
+	for (j = 0; j < CFGI_NUM_ATTRIBS; j++)
+	{
+		aiRequest[j] = aAttribDflts[j * 2 + 1];
+		abListed[j] = IMG_FALSE;
+	}
+
+	if (!pAttribList)
+	{
+		return;
+	}
+
+	for (i = 0; i + 1 < nAttribCount; i += 2)
+	{
+		for (j = 0; j < CFGI_NUM_ATTRIBS; j++)
+		{
+			if (aAttribDflts[j * 2] == pAttribList[i])
+			{
+				if (!abListed[j])
+				{
+					aiRequest[j] = pAttribList[i + 1];
+					abListed[j] = IMG_TRUE;
+				}
+
+				break;
+			}
+		}
+	}
+}
+
+
+/*
+   <function>
+   FUNCTION   : _Query
+   PURPOSE    : Select and sort the configurations matching an attribute
+                list into a memo entry.
+   PARAMETERS : In:  psIndex - index
+                In:  pAttribList - attribute list, or IMG_NULL.
+                In:  nAttribCount - number of attribs (identifiers + values)
+                In:  psMemo - entry, with its request filled in
+   RETURNS    : EGL_SUCCESS, EGL_BAD_ATTRIBUTE or EGL_BAD_ALLOC.
+   </function>
+ */
+static EGLint _Query(CFGI_INDEX *psIndex, const EGLint *pAttribList, EGLint nAttribCount, CFGI_MEMO *psMemo)
+{
+	IMG_UINT32 *pui32Matches = psIndex->pui32Matches;
+	IMG_UINT32 ui32Words = psIndex->ui32SetWords;
+	IMG_BOOL abColour[4];
+	KEGL_CONFIG *pRqstCfg;
+	IMG_UINT32 ui32NumMatches;
+	IMG_UINT32 i, j;
+
+	pRqstCfg = CFG_PrepareConfigFilter(pAttribList, nAttribCount);
+
+	if (!pRqstCfg)
+	{
+		return EGL_BAD_ATTRIBUTE;
+	}
+
+	for (i = 0; i < ui32Words; i++)
+	{
+		pui32Matches[i] = 0xFFFFFFFFU;
+	}
+	if (psIndex->ui32NumConfigs & 31)
+	{
+		pui32Matches[ui32Words - 1] = (1U << (psIndex->ui32NumConfigs & 31)) - 1;
+	}
+
+	/* Intersect a bitset per requested attribute, as CFG_Match tests them */
+	for (j = 0; j < CFGI_NUM_ATTRIBS; j++)
+	{
+		const CFGI_ATTRIB *psAttrib = &psIndex->asAttrib[j];
+		EGLint iRequestValue = CFGC_GetAttribNoAccumulate(pRqstCfg, aAttribDflts[j * 2]);
+		const IMG_UINT32 *pui32Set;
+		IMG_UINT32 ui32Value;
+
+		if (iRequestValue == EGL_DONT_CARE)
+		{
+			continue;
+		}
+
+		if (aAttribMatchCriteria[j] == mask)
+		{
+			for (ui32Value = 0; ui32Value < CFGI_MASK_BITS; ui32Value++)
+			{
+				if ((IMG_UINT32)iRequestValue & (1U << ui32Value))
+				{
+					pui32Set = psAttrib->pui32Sets + ui32Value * ui32Words;
+
+					for (i = 0; i < ui32Words; i++)
+					{
+						pui32Matches[i] &= pui32Set[i];
+					}
+				}
+			}
+
+			continue;
+		}
+
+		ui32Value = _FindValue(psAttrib, iRequestValue);
+
+		if (ui32Value == psAttrib->ui32NumValues ||
+			(aAttribMatchCriteria[j] == exact && psAttrib->piValues[ui32Value] != iRequestValue))
+		{
+			/* No configuration has the value (or more) */
+			for (i = 0; i < ui32Words; i++)
+			{
+				pui32Matches[i] = 0;
+			}
+
+			break;
+		}
+
+		pui32Set = psAttrib->pui32Sets + ui32Value * ui32Words;
+
+		for (i = 0; i < ui32Words; i++)
+		{
+			pui32Matches[i] &= pui32Set[i];
+		}
+	}
+
+	/* The colour bits the request sets count towards the sort */
+	for (j = 0; j < 4; j++)
+	{
+		EGLint v = CFGC_GetAttrib(pRqstCfg, aAttribDflts[aeColourAttribs[j] * 2]);
+
+		abColour[j] = ((v == EGL_DONT_CARE) || (v == 0)) ? IMG_FALSE : IMG_TRUE;
+	}
+
+	CFGC_Unlink(pRqstCfg);
+
+	for (ui32NumMatches = 0, i = 0; i < psIndex->ui32NumConfigs; i++)
+	{
+		if (pui32Matches[i >> 5] & (1U << (i & 31)))
+		{
+			const CFGI_CONFIG *psConfig = &psIndex->psConfigs[i];
+			CFGI_SORT *psSort = &psIndex->psSort[ui32NumMatches++];
+			IMG_INT64 i64Colour = 0;
+
+			for (j = 0; j < 4; j++)
+			{
+				if (abColour[j])
+				{
+					i64Colour += psConfig->aiColour[j];
+				}
+			}
+
+			/* The colour sum of four EGLints is well inside 40 bits */
+			psSort->i64Key = ((IMG_INT64)psConfig->iCaveatOrder << 40) - i64Colour;
+			psSort->ui32Rank = psConfig->ui32Rank;
+			psSort->ui32Config = i;
+		}
+	}
+
+	if (ui32NumMatches > 1)
+	{
+		PVR_qsort_s(psIndex->psSort, (IMG_INT)ui32NumMatches, sizeof(CFGI_SORT), _CompareSort, IMG_NULL);
+	}
+
+	if (ui32NumMatches)
+	{
+		psMemo->piConfigIDs = EGLMalloc(sizeof(EGLint) * ui32NumMatches);
+
+		if (!psMemo->piConfigIDs)
+		{
+			return EGL_BAD_ALLOC;
+		}
+
+		for (i = 0; i < ui32NumMatches; i++)
+		{
+			psMemo->piConfigIDs[i] = psIndex->psConfigs[psIndex->psSort[i].ui32Config].iConfigID;
+		}
+	}
+
+	psMemo->ui32NumConfigs = ui32NumMatches;
+	psMemo->bValid = IMG_TRUE;
+
+	return EGL_SUCCESS;
+}
+
+
+/*
+   <function>
+   FUNCTION   : CFGI_ChooseConfig
+   PURPOSE    :
+
+   Select the configurations matching a validated attribute list, in
+   the order eglChooseConfig returns them. The caller serialises calls
+   on one index.
+
+   PARAMETERS : In:  psIndex - Index of the display.
+                In:  pAttribList - attribute list, or IMG_NULL.
+                In:  nAttribCount - number of attribs (identifiers + values)
+                Out: configs - Receives the configurations, or IMG_NULL
+                     to count them.
+                In:  config_size - Size of configs.
+                Out: num_config - Receives the number of configurations.
+   RETURNS    : EGL_SUCCESS, EGL_BAD_ATTRIBUTE or EGL_BAD_ALLOC.
+   </function>
+ */
+IMG_INTERNAL EGLint CFGI_ChooseConfig(CFGI_INDEX *psIndex,
+									  const EGLint *pAttribList,
+									  EGLint nAttribCount,
+									  EGLConfig *configs,
+									  EGLint config_size,
+									  EGLint *num_config)
+{
+	EGLint aiRequest[CFGI_NUM_ATTRIBS];
+	CFGI_MEMO *psMemo = IMG_NULL;
+	EGLint num_config_local;
+	IMG_UINT32 i, j;
+
+	_CanonicaliseAttribList(pAttribList, nAttribCount, aiRequest);
+
+	psIndex->ui32Queries++;
+
+	for (i = 0; i < CFGI_MEMO_ENTRIES; i++)
+	{
+		CFGI_MEMO *psEntry = &psIndex->asMemo[i];
+
+		if (psEntry->bValid)
+		{
+			for (j = 0; j < CFGI_NUM_ATTRIBS; j++)
+			{
+				if (psEntry->aiRequest[j] != aiRequest[j])
+				{
+					break;
+				}
+			}
+
+			if (j == CFGI_NUM_ATTRIBS)
+			{
+				psMemo = psEntry;
+
+				break;
+			}
+		}
+	}
+
+	if (!psMemo)
+	{
+		EGLint eError;
+
+		/* Replace a free entry, or the least recently used */
+		psMemo = &psIndex->asMemo[0];
+
+		for (i = 0; i < CFGI_MEMO_ENTRIES && psMemo->bValid; i++)
+		{
+			CFGI_MEMO *psEntry = &psIndex->asMemo[i];
+
+			if (!psEntry->bValid ||
+				psIndex->ui32Queries - psEntry->ui32LastUse > psIndex->ui32Queries - psMemo->ui32LastUse)
+			{
+				psMemo = psEntry;
+			}
+		}
+
+		if (psMemo->piConfigIDs)
+		{
+			EGLFree(psMemo->piConfigIDs);
+			psMemo->piConfigIDs = IMG_NULL;
+		}
+		psMemo->bValid = IMG_FALSE;
+
+		for (j = 0; j < CFGI_NUM_ATTRIBS; j++)
+		{
+			psMemo->aiRequest[j] = aiRequest[j];
+		}
+
+		eError = _Query(psIndex, pAttribList, nAttribCount, psMemo);
+
+		if (eError != EGL_SUCCESS)
+		{
+			return eError;
+		}
+	}
+
+	psMemo->ui32LastUse = psIndex->ui32Queries;
+
+	if (configs == IMG_NULL)
+	{
+		*num_config = (EGLint)psMemo->ui32NumConfigs;
+
+		return EGL_SUCCESS;
+	}
+
+	for (num_config_local = 0;
+		 num_config_local < config_size && num_config_local < (EGLint)psMemo->ui32NumConfigs;
+		 num_config_local++)
+	{
+		configs[num_config_local] = (EGLConfig)(IMG_UINTPTR_T)psMemo->piConfigIDs[num_config_local];
+	}
+
+	*num_config = num_config_local;
+
+	return EGL_SUCCESS;
+}
+
+/******************************************************************************
+ End of file (cfg_index.c)
+******************************************************************************/
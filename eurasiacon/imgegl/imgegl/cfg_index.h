@@ -0,0 +1,198 @@
+/* -*- c-file-style: "img" -*-
+<module>
+ * Name         : cfg_index.h
+ * Title        : EGL Config Selection Index.
+ *
+ * Copyright    : 2011 by Imagination Technologies Limited.
+ *                All rights reserved.  No part of this software, either
+ *                material or conceptual may be copied or distributed,
+ *                transmitted, transcribed, stored in a retrieval system
+ *                or translated into any human or computer language in any
+ *                form by any means, electronic, mechanical, manual or
+ *                other-wise, or disclosed to third parties without the
+ *                express written permission of Imagination Technologies
+ *                Limited, Home Park Estate, Kings Langley,
+ *                Hertfordshire, WD4 8LZ, U.K.
+ *
+ * Description  :
+ *
+ * Answers eglChooseConfig without generating the configurations.
+ *
+ * When a display is initialised every configuration variant is
+ * generated once and the value of each matchable attribute is
+ * recorded. For each attribute the index keeps a bitset of the
+ * configurations with each value it takes: for "exact" attributes the
+ * configurations with that value, for "atleast" attributes those with
+ * that value or more, and for "mask" attributes one bitset per bit. A
+ * query is the intersection of one bitset per requested attribute.
+ *
+ * The configurations are also ranked once by the sort keys which do
+ * not depend on the request (buffer size, samples, depth, stencil and
+ * config ID), so the matches are sorted by caveat, colour bits and
+ * rank.
+ *
+ * Results are memoised against the attribute list, reduced to the
+ * request value of each matchable attribute, so lists which differ only
+ * in order, repeats or defaults share an entry.
+ *
+ * The results are identical to filtering with CFG_Match and sorting
+ * with CFG_Compare.
+ *
+ * Platform : ALL
+ *
+ * $Log: cfg_index.h $
+ */
+
+#ifndef _CFG_INDEX_H_
+#define _CFG_INDEX_H_
+
+#include "egl_internal.h"
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+/* Matchable attributes, in attrib.h order */
+typedef enum
+{
+#define A(N,D,C) CFGI_##N,
+#include "attrib.h"
+#undef A
+	CFGI_NUM_ATTRIBS
+
+} CFGI_ATTRIB_INDEX;
+
+/* Queries memoised per display */
+#define CFGI_MEMO_ENTRIES	8
+
+typedef struct CFGI_ATTRIB_TAG
+{
+	/* Distinct values the configurations take, ascending; unused for mask attributes */
+	EGLint		*piValues;
+
+	/* Number of values, or of bits for mask attributes */
+	IMG_UINT32	ui32NumValues;
+
+	/* One bitset of configurations per value or bit */
+	IMG_UINT32	*pui32Sets;
+
+} CFGI_ATTRIB;
+
+typedef struct CFGI_CONFIG_TAG
+{
+	EGLint		iConfigID;
+
+	/* Position in the caveat sort order */
+	EGLint		iCaveatOrder;
+
+	/* Alpha, red, green and blue sizes */
+	EGLint		aiColour[4];
+
+	/* Position by the sort keys after the colour bits */
+	IMG_UINT32	ui32Rank;
+
+} CFGI_CONFIG;
+
+typedef struct CFGI_SORT_TAG
+{
+	/* Caveat order, then colour bits descending */
+	IMG_INT64	i64Key;
+
+	IMG_UINT32	ui32Rank;
+
+	IMG_UINT32	ui32Config;
+
+} CFGI_SORT;
+
+typedef struct CFGI_MEMO_TAG
+{
+	/* Request value of each matchable attribute */
+	EGLint		aiRequest[CFGI_NUM_ATTRIBS];
+
+	IMG_BOOL	bValid;
+
+	/* Matching config IDs in EGL order */
+	EGLint		*piConfigIDs;
+
+	IMG_UINT32	ui32NumConfigs;
+
+	/* Query count when the entry was last used */
+	IMG_UINT32	ui32LastUse;
+
+} CFGI_MEMO;
+
+struct CFGI_INDEX_TAG
+{
+	IMG_UINT32	ui32NumConfigs;
+
+	/* Words per bitset */
+	IMG_UINT32	ui32SetWords;
+
+	CFGI_CONFIG	*psConfigs;
+
+	CFGI_ATTRIB	asAttrib[CFGI_NUM_ATTRIBS];
+
+	/* Query scratch: a bitset and a sort entry per configuration */
+	IMG_UINT32	*pui32Matches;
+	CFGI_SORT	*psSort;
+
+	CFGI_MEMO	asMemo[CFGI_MEMO_ENTRIES];
+
+	IMG_UINT32	ui32Queries;
+};
+
+/*
+   <function>
+   FUNCTION   : CFGI_Create
+   PURPOSE    : Generate every configuration of a display and index them.
+   PARAMETERS : In:  psDpy - Initialised display.
+   RETURNS    : Index, or IMG_NULL if out of memory.
+   </function>
+ */
+CFGI_INDEX *CFGI_Create(KEGL_DISPLAY *psDpy);
+
+/*
+   <function>
+   FUNCTION   : CFGI_Destroy
+   PURPOSE    : Free an index and its memoised queries.
+   PARAMETERS : In:  psIndex - Index, or IMG_NULL.
+   RETURNS    : None
+   </function>
+ */
+IMG_VOID CFGI_Destroy(CFGI_INDEX *psIndex);
+
+/*
+   <function>
+   FUNCTION   : CFGI_ChooseConfig
+   PURPOSE    :
+
+   Select the configurations matching a validated attribute list, in
+   the order eglChooseConfig returns them. The caller serialises calls
+   on one index.
+
+   PARAMETERS : In:  psIndex - Index of the display.
+                In:  pAttribList - attribute list, or IMG_NULL.
+                In:  nAttribCount - number of attribs (identifiers + values)
+                Out: configs - Receives the configurations, or IMG_NULL
+                     to count them.
+                In:  config_size - Size of configs.
+                Out: num_config - Receives the number of configurations.
+   RETURNS    : EGL_SUCCESS, EGL_BAD_ATTRIBUTE or EGL_BAD_ALLOC.
+   </function>
+ */
+EGLint CFGI_ChooseConfig(CFGI_INDEX *psIndex,
+						 const EGLint *pAttribList,
+						 EGLint nAttribCount,
+						 EGLConfig *configs,
+						 EGLint config_size,
+						 EGLint *num_config);
+
+#if defined (__cplusplus)
+}
+#endif
+
+#endif /* _CFG_INDEX_H_ */
+
+/******************************************************************************
+ End of file (cfg_index.h)
+******************************************************************************/
@@ -0,0 +1,232 @@
+/*!****************************************************************************
+@File           egl_fencewait.c
+
+@Title          Blocking waits on EGL fence sync objects
+
+@Author         Imagination Technologies
+
+@Date           2009/02/17
+
+@Copyright      Copyright 2009 by Imagination Technologies Limited.
+                All rights reserved. No part of this software, either material
+                or conceptual may be copied or distributed, transmitted,
+                transcribed, stored in a retrieval system or translated into
+                any human or computer language in any form by any means,
+                electronic, mechanical, manual or otherwise, or disclosed
+                to third parties without the express written permission of
+                Imagination Technologies Limited, Home Park Estate,
+                Kings Langley, Hertfordshire, WD4 8LZ, U.K.
+
+@Platform      	generic egl
+
+@Description    Waits for a fence's op counters to pass their target by
+                blocking on the device's op completion event, with the
+                waiters on one fence sharing the wait. See egl_fencewait.h.
+
+******************************************************************************/
+/******************************************************************************
+Modifications :-
+$Log: egl_fencewait.c $
+******************************************************************************/
+
+#include "egl_fencewait.h"
+
+
+/***********************************************************************************
+ Function Name      : EGLFenceWaitInit
+ Inputs             : -
+ Outputs            : psWait
+ Returns            : PVRSRV_OK, or the error creating the mutex or semaphore
+ Description        : Sets up the shared wait of a new fence
+************************************************************************************/
+IMG_INTERNAL PVRSRV_ERROR EGLFenceWaitInit(EGL_FENCE_WAIT *psWait)
+{
+	PVRSRV_ERROR eError;
+
+	psWait->bEventWaiter = IMG_FALSE;
+	psWait->ui32Sleepers = 0;
+	psWait->bComplete = IMG_FALSE;
+
+	eError = PVRSRVCreateMutex(&psWait->hMutex);
+
+	if(eError != PVRSRV_OK)
+	{
+		return eError;
+	}
+
+	eError = PVRSRVCreateSemaphore(&psWait->hSemaphore, 0);
+
+	if(eError != PVRSRV_OK)
+	{
+		PVRSRVDestroyMutex(psWait->hMutex);
+
+		return eError;
+	}
+
+	return PVRSRV_OK;
+}
+
+/***********************************************************************************
+ Function Name      : EGLFenceWaitDeinit
+ Inputs             : psWait
+ Outputs            : -
+ Returns            : -
+ Description        : Frees the shared wait of a fence no thread is waiting on
+************************************************************************************/
+IMG_INTERNAL IMG_VOID EGLFenceWaitDeinit(EGL_FENCE_WAIT *psWait)
+{
+	PVRSRVDestroySemaphore(psWait->hSemaphore);
+	PVRSRVDestroyMutex(psWait->hMutex);
+}
+
+/***********************************************************************************
+ Function Name      : CheckComplete
+ Inputs             : psWait, psOps, pvFence
+ Outputs            : -
+ Returns            : Whether the fence is complete
+ Description        : Queries the fence unless it is already known to be complete,
+                      and wakes every sleeper when it is seen to complete.
+                      Called with the mutex held.
+************************************************************************************/
+static IMG_BOOL CheckComplete(EGL_FENCE_WAIT *psWait, const EGL_FENCE_WAIT_OPS *psOps, IMG_VOID *pvFence)
+{
+	if(!psWait->bComplete && psOps->pfnIsComplete(pvFence))
+	{
+		psWait->bComplete = IMG_TRUE;
+
+		if(psWait->ui32Sleepers)
+		{
+			PVRSRVPostSemaphore(psWait->hSemaphore, (IMG_INT)psWait->ui32Sleepers);
+			psWait->ui32Sleepers = 0;
+		}
+	}
+
+	return psWait->bComplete;
+}
+
+/***********************************************************************************
+ Function Name      : EGLFenceWaitIsComplete
+ Inputs             : psWait, psOps, pvFence
+ Outputs            : -
+ Returns            : Whether the fence is complete
+ Description        : Queries the fence without waiting
+************************************************************************************/
+IMG_INTERNAL IMG_BOOL EGLFenceWaitIsComplete(EGL_FENCE_WAIT *psWait, const EGL_FENCE_WAIT_OPS *psOps, IMG_VOID *pvFence)
+{
+	IMG_BOOL bComplete;
+
+	PVRSRVLockMutex(psWait->hMutex);
+
+	bComplete = CheckComplete(psWait, psOps, pvFence);
+
+	PVRSRVUnlockMutex(psWait->hMutex);
+
+	return bComplete;
+}
+
+/***********************************************************************************
+ Function Name      : EGLFenceWait
+ Inputs             : psWait, psOps, pvFence, ui64TimeoutNs - EGLTimeKHR timeout,
+                      or EGL_FENCE_WAIT_FOREVER
+ Outputs            : -
+ Returns            : Whether the fence completed within the timeout
+ Description        : Blocks until the fence completes or the timeout passes. The
+                      timeout is rounded up to the clock's microseconds and
+                      measured from the call, however long the thread sleeps.
+************************************************************************************/
+IMG_INTERNAL IMG_BOOL EGLFenceWait(EGL_FENCE_WAIT *psWait, const EGL_FENCE_WAIT_OPS *psOps, IMG_VOID *pvFence, IMG_UINT64 ui64TimeoutNs)
+{
+	IMG_BOOL bForever = (ui64TimeoutNs == EGL_FENCE_WAIT_FOREVER) ? IMG_TRUE : IMG_FALSE;
+	IMG_UINT64 ui64DeadlineUs = 0;
+	IMG_UINT64 ui64RemainingUs = EGL_FENCE_WAIT_FOREVER;
+	IMG_BOOL bComplete;
+
+	if(!bForever)
+	{
+		ui64DeadlineUs = psOps->pfnClockus() + ui64TimeoutNs / 1000 + ((ui64TimeoutNs % 1000) ? 1 : 0);
+	}
+
+	PVRSRVLockMutex(psWait->hMutex);
+
+	while(!CheckComplete(psWait, psOps, pvFence))
+	{
+		if(!bForever)
+		{
+			IMG_UINT64 ui64NowUs = psOps->pfnClockus();
+
+			if(ui64NowUs >= ui64DeadlineUs)
+			{
+				break;
+			}
+
+			ui64RemainingUs = ui64DeadlineUs - ui64NowUs;
+		}
+
+		if(!psWait->bEventWaiter)
+		{
+			/* Wait on the event for everyone, and query the fence when it fires */
+			IMG_UINT32 ui32EventUs = (ui64RemainingUs < EGL_FENCE_WAIT_EVENT_US) ? (IMG_UINT32)ui64RemainingUs : EGL_FENCE_WAIT_EVENT_US;
+
+			psWait->bEventWaiter = IMG_TRUE;
+
+			PVRSRVUnlockMutex(psWait->hMutex);
+
+			psOps->pfnWaitEvent(pvFence, ui32EventUs);
+
+			PVRSRVLockMutex(psWait->hMutex);
+
+			psWait->bEventWaiter = IMG_FALSE;
+		}
+		else
+		{
+			PVRSRV_ERROR eError;
+
+			psWait->ui32Sleepers++;
+
+			PVRSRVUnlockMutex(psWait->hMutex);
+
+			eError = PVRSRVWaitSemaphore(psWait->hSemaphore, bForever ? IMG_SEMAPHORE_WAIT_INFINITE : ui64RemainingUs);
+
+			PVRSRVLockMutex(psWait->hMutex);
+
+			if(eError != PVRSRV_OK)
+			{
+				/*
+					Timed out. Each sleeper is either still counted or has a post
+					on its way, so if none is counted one of the posts is this
+					thread's to take.
+				*/
+				if(psWait->ui32Sleepers)
+				{
+					psWait->ui32Sleepers--;
+				}
+				else
+				{
+					PVRSRVUnlockMutex(psWait->hMutex);
+
+					PVRSRVWaitSemaphore(psWait->hSemaphore, IMG_SEMAPHORE_WAIT_INFINITE);
+
+					PVRSRVLockMutex(psWait->hMutex);
+				}
+			}
+		}
+	}
+
+	bComplete = psWait->bComplete;
+
+	/* Giving up: hand the event over to a sleeper who may still be waiting */
+	if(!bComplete && !psWait->bEventWaiter && psWait->ui32Sleepers)
+	{
+		psWait->ui32Sleepers--;
+
+		PVRSRVPostSemaphore(psWait->hSemaphore, 1);
+	}
+
+	PVRSRVUnlockMutex(psWait->hMutex);
+
+	return bComplete;
+}
+
+/*****************************************************************************
+ End of file (egl_fencewait.c)
+******************************************************************************/
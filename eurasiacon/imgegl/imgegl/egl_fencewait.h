@@ -0,0 +1,99 @@
+/******************************************************************************
+ * Name         : egl_fencewait.h
+ *
+ * Copyright    : 2009 by Imagination Technologies Limited.
+ *                All rights reserved. No part of this software, either
+ *                material or conceptual may be copied or distributed,
+ *                transmitted, transcribed, stored in a retrieval system or
+ *                translated into any human or computer language in any form
+ *                by any means, electronic, mechanical, manual or otherwise,
+ *                or disclosed to third parties without the express written
+ *                permission of Imagination Technologies Limited, Home Park
+ *                Estate, Kings Langley, Hertfordshire, WD4 8LZ, U.K.
+ *
+ * $Log: egl_fencewait.h $
+ *****************************************************************************/
+
+#ifndef _EGL_FENCEWAIT_H_
+#define _EGL_FENCEWAIT_H_
+
+#include "img_types.h"
+#include "img_defs.h"
+#include "services.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*
+ * Blocking waits on a fence sync object.
+ *
+ * Rather than query the fence's op counters in a loop, a waiter blocks on
+ * the services event raised whenever the device completes an op, and only
+ * queries the counters when it wakes: the wait returns as soon as the
+ * counters pass the fence's target, without burning the CPU meanwhile.
+ *
+ * Waiters on the same fence share one wait: the first blocks on the event
+ * and does the queries, the others sleep on a semaphore until it sees the
+ * fence complete. If it gives up first (its timeout is shorter), one of
+ * the sleepers takes its place.
+ *
+ * The device side is reached through EGL_FENCE_WAIT_OPS, so the waiter can
+ * be run on a host against a mock sync object.
+ */
+
+/* Timeout of a wait with no timeout, as EGL_FOREVER_KHR */
+#define EGL_FENCE_WAIT_FOREVER		((IMG_UINT64)0xFFFFFFFFFFFFFFFFull)
+
+/* Longest single wait on the event, in case an event is lost */
+#define EGL_FENCE_WAIT_EVENT_US		100000
+
+typedef struct _EGL_FENCE_WAIT_OPS_
+{
+	/* Whether the fence's op counters have passed its target */
+	IMG_BOOL	(*pfnIsComplete)(IMG_VOID *pvFence);
+
+	/* Blocks until the device completes an op or ui32TimeoutUs passes */
+	IMG_VOID	(*pfnWaitEvent)(IMG_VOID *pvFence, IMG_UINT32 ui32TimeoutUs);
+
+	/* Microsecond clock */
+	IMG_UINT64	(*pfnClockus)(IMG_VOID);
+
+} EGL_FENCE_WAIT_OPS;
+
+typedef struct _EGL_FENCE_WAIT_
+{
+	/* Protects the rest */
+	PVRSRV_MUTEX_HANDLE		hMutex;
+
+	/* Sleepers wait on this for the fence to complete or their turn on the event */
+	PVRSRV_SEMAPHORE_HANDLE	hSemaphore;
+
+	/* A waiter is blocked on the event */
+	IMG_BOOL				bEventWaiter;
+
+	/* Sleepers not yet posted to */
+	IMG_UINT32				ui32Sleepers;
+
+	/* Latched once the fence is seen complete */
+	IMG_BOOL				bComplete;
+
+} EGL_FENCE_WAIT;
+
+PVRSRV_ERROR EGLFenceWaitInit(EGL_FENCE_WAIT *psWait);
+
+IMG_VOID EGLFenceWaitDeinit(EGL_FENCE_WAIT *psWait);
+
+IMG_BOOL EGLFenceWaitIsComplete(EGL_FENCE_WAIT *psWait, const EGL_FENCE_WAIT_OPS *psOps, IMG_VOID *pvFence);
+
+IMG_BOOL EGLFenceWait(EGL_FENCE_WAIT *psWait, const EGL_FENCE_WAIT_OPS *psOps, IMG_VOID *pvFence, IMG_UINT64 ui64TimeoutNs);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /*_EGL_FENCEWAIT_H_*/
+
+/******************************************************************************
+ End of file (egl_fencewait.h)
+******************************************************************************/
@@ -108,6 +108,7 @@ typedef enum
 typedef struct _KEGL_SURFACE_ KEGL_SURFACE;
 typedef struct _KEGL_CONTEXT_ KEGL_CONTEXT;
 typedef EGLint KEGL_CONFIG_INDEX;
+typedef struct CFGI_INDEX_TAG CFGI_INDEX;
 
 #if defined(EGL_EXTENSION_KHR_IMAGE)
 typedef struct _KEGL_IMAGE_ KEGL_IMAGE;
@@ -167,6 +168,9 @@ typedef struct KEGL_DISPLAY_TAG
 	IMG_BOOL bUseHWForWindowSync;
 	IMG_BOOL bUseHWForPixmapSync;
 
+	/* Window drawables support adaptive swap interval */
+	IMG_BOOL bAdaptiveSwapInterval;
+
 	/* True if the EGL lock should be released around calls to WSEGL
 	   functions */
 	IMG_BOOL bUnlockedWSEGL;
@@ -175,6 +179,9 @@ typedef struct KEGL_DISPLAY_TAG
 	
 	IMG_UINT32 ui32NumConfigs;
 
+	/* Precomputed config selection, see cfg_index.h */
+	CFGI_INDEX *psCfgIndex;
+
 } KEGL_DISPLAY;
 
 
@@ -216,6 +223,7 @@ struct _KEGL_SURFACE_
 			WSEGLDrawableHandle	hDrawable;
 			WSEGLConfig			sConfig;
 			IMG_UINT32			ui32SwapCount;
+			IMG_BOOL			bAdaptiveSwapInterval;
 		} window;
 		struct
 		{
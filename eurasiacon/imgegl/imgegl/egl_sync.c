@@ -52,6 +52,25 @@ $Log: egl_sync.c $
 KEGL_DISPLAY *GetKEGLDisplay(TLS psTls, EGLDisplay eglDpy);
 
 
+/* Device side of a fence wait */
+typedef struct _EGL_FENCE_QUERY_
+{
+	PVRSRV_DEV_DATA		*psDevData;
+	KEGL_SYNC			*psSync;
+
+} EGL_FENCE_QUERY;
+
+static IMG_BOOL _fenceIsComplete(IMG_VOID *pvFence);
+static IMG_VOID _fenceWaitEvent(IMG_VOID *pvFence, IMG_UINT32 ui32TimeoutUs);
+static IMG_UINT64 _fenceClockus(IMG_VOID);
+
+static const EGL_FENCE_WAIT_OPS sFenceWaitOps =
+{
+	_fenceIsComplete,
+	_fenceWaitEvent,
+	_fenceClockus
+};
+
 static void _waitFence(KEGL_SYNC *psSync, SrvSysContext *psSysContext, EGLTimeKHR timeout);
 static EGLint IMGeglClientWaitSyncKHR_Fence(TLS psTls, KEGL_SYNC *psSync, EGLint flags, EGLTimeKHR timeout);
 
@@ -301,6 +320,8 @@ static EGLBoolean _deleteSync(KEGL_SYNC *psSync, SrvSysContext *psSysContext)
 			PVR_DPF((PVR_DBG_ERROR,"DeleteSync: Could not free Fence Sync dummy memory"));
 			return EGL_FALSE;
 		}
+
+		EGLFenceWaitDeinit(&psSync->sFenceWait);
 	}
 #if defined(EGL_EXTENSION_KHR_REUSABLE_SYNC)
 	else
@@ -564,6 +585,12 @@ IMG_INTERNAL EGLSyncKHR	IMGeglCreateSyncKHR(EGLDisplay eglDpy, EGLenum type, con
 						PVRSRV_PDUMP_FLAGS_CONTINUOUS);
 #endif /* defined(PDUMP) */
 
+		if(EGLFenceWaitInit(&psSync->sFenceWait) != PVRSRV_OK)
+		{
+			psTls->lastError = EGL_BAD_ALLOC;
+			goto err_dealloc_device_mem;
+		}
+
 		/* Flush the buffers to get the TA/3D to complete */
 		if(!_flushBuffers(psSync->psContext, psTls))
 		{
@@ -578,7 +605,7 @@ IMG_INTERNAL EGLSyncKHR	IMGeglCreateSyncKHR(EGLDisplay eglDpy, EGLenum type, con
 		/* Place a fence command into the GL command stream */
 		if(!_insertEglFence(psSync->psContext, psTls, psSync))
 		{
-			goto err_dealloc_device_mem;
+			goto err_deinit_wait;
 		}
 
 	}
@@ -608,6 +635,9 @@ IMG_INTERNAL EGLSyncKHR	IMGeglCreateSyncKHR(EGLDisplay eglDpy, EGLenum type, con
 
 	return (EGLSyncKHR)psSync; /* returns void* */
 
+err_deinit_wait:
+	EGLFenceWaitDeinit(&psSync->sFenceWait);
+
 err_dealloc_device_mem:
 	if(IMGEGLFREEDEVICEMEM( &psSysContext->s3D,
 							psSync->psSyncMemInfo) != PVRSRV_OK)
@@ -869,48 +899,88 @@ err_out:
 	return ret;
 }
 
+/***********************************************************************************
+ Function Name      : _fenceIsComplete
+ Inputs             : pvFence
+ Outputs            : -
+ Returns            : Whether the fence's TQ update has completed
+ Description        : EGL_FENCE_WAIT_OPS query of the fence's op counters
+************************************************************************************/
+static IMG_BOOL _fenceIsComplete(IMG_VOID *pvFence)
+{
+	EGL_FENCE_QUERY *psQuery = (EGL_FENCE_QUERY *)pvFence;
+
+	return EGL_FENCE_SYNC_COMPLETE(psQuery->psDevData, psQuery->psSync) ? IMG_TRUE : IMG_FALSE;
+}
+
+/***********************************************************************************
+ Function Name      : _fenceWaitEvent
+ Inputs             : pvFence, ui32TimeoutUs
+ Outputs            : -
+ Returns            : -
+ Description        : EGL_FENCE_WAIT_OPS wait for the GPU to signal an op completion
+************************************************************************************/
+static IMG_VOID _fenceWaitEvent(IMG_VOID *pvFence, IMG_UINT32 ui32TimeoutUs)
+{
+	PVR_UNREFERENCED_PARAMETER(pvFence);
+
+	/* Timing out is expected: the caller checks its own deadline */
+	sceGpuSignalWait(sceKernelGetTLSAddr(0x44), ui32TimeoutUs);
+}
+
+/***********************************************************************************
+ Function Name      : _fenceClockus
+ Inputs             : -
+ Outputs            : -
+ Returns            : Process time in microseconds
+ Description        : EGL_FENCE_WAIT_OPS clock; 64 bits so long timeouts don't wrap
+************************************************************************************/
+static IMG_UINT64 _fenceClockus(IMG_VOID)
+{
+	return sceKernelGetProcessTimeWide();
+}
+
+/***********************************************************************************
+ Function Name      : _isFenceComplete
+ Inputs             : psSync, psSysContext
+ Outputs            : -
+ Returns            : TRUE/FALSE
+ Description        : Check whether a fence has completed, without waiting
+************************************************************************************/
+static IMG_BOOL _isFenceComplete(KEGL_SYNC *psSync, SrvSysContext *psSysContext)
+{
+	EGL_FENCE_QUERY sQuery;
+
+	sQuery.psDevData = &psSysContext->s3D;
+	sQuery.psSync = psSync;
+
+	return EGLFenceWaitIsComplete(&psSync->sFenceWait, &sFenceWaitOps, &sQuery);
+}
+
 /***********************************************************************************
  Function Name      : _waitFence
  Inputs             : eglDpy, sync, timeout
  Outputs            : -
  Returns            : 
- Description        : Wait for Fence to complete
+ Description        : Wait for Fence to complete. The thread sleeps until the GPU
+                      signals op completion, and other threads waiting on the same
+                      fence share its wait.
 ************************************************************************************/
 static void _waitFence(KEGL_SYNC *psSync, SrvSysContext *psSysContext, EGLTimeKHR timeout)
 {
-	IMG_UINT32 ui32LastTime_us=0, ui32Timeout_us;
-	
-	/* note current time */
-	if(timeout != EGL_FOREVER_KHR)
+	EGL_FENCE_QUERY sQuery;
+
+	if(psSync->eglSyncType != EGL_SYNC_FENCE_KHR)
 	{
-		ui32LastTime_us = PVRSRVClockus();
+		return;
 	}
 
-	/* timeout loop */
-	ui32Timeout_us = (IMG_UINT32) (timeout / 1000);
+	sQuery.psDevData = &psSysContext->s3D;
+	sQuery.psSync = psSync;
 
-	while(timeout == EGL_FOREVER_KHR || ui32Timeout_us > 0)
+	if(EGLFenceWait(&psSync->sFenceWait, &sFenceWaitOps, &sQuery, (IMG_UINT64)timeout))
 	{
-		//This will result in inaccurate timeouts, but it is still better than what was here before
-		if (!SGX2DQueryBlitsComplete(&psSysContext->s3D, psSync->psSyncMemInfo->psClientSyncInfo, IMG_TRUE))
-		{
-			psSync->eglSyncStatus = EGL_SIGNALED_KHR;
-			break;
-		}
-
-		/* Check the object was not signalled externally (by destroy) */
-		if(psSync->eglSyncStatus==EGL_SIGNALED_KHR)
-		{
-			break;
-		}
-		
-		if(timeout != EGL_FOREVER_KHR)
-		{
-			IMG_UINT32 elapsed;
-			elapsed = PVRSRVClockus() - ui32LastTime_us;
-			ui32Timeout_us = (elapsed > ui32Timeout_us) ? 0 : ui32Timeout_us - elapsed;
-			ui32LastTime_us = PVRSRVClockus();
-		}
+		psSync->eglSyncStatus = EGL_SIGNALED_KHR;
 	}
 }
 
@@ -970,7 +1040,7 @@ static EGLint IMGeglClientWaitSyncKHR_Fence(TLS psTls, KEGL_SYNC *psSync, EGLint
 
 
 	/* Check the sync object and set the signalling state */
-	if(EGL_FENCE_SYNC_COMPLETE(&psTls->psGlobalData->sSysContext.s3D, psSync))
+	if(_isFenceComplete(psSync, &psTls->psGlobalData->sSysContext))
 	{
 		psSync->eglSyncStatus = EGL_SIGNALED_KHR;
 		ret = EGL_CONDITION_SATISFIED_KHR;
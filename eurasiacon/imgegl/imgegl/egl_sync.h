@@ -17,6 +17,8 @@
 #ifndef _EGL_SYNC_H_
 #define _EGL_SYNC_H_
 
+#include "egl_fencewait.h"
+
 #if defined(__cplusplus)
 extern "C" {
 #endif
@@ -34,6 +36,7 @@ struct _KEGL_SYNC_
 
 	PVRSRV_CLIENT_MEM_INFO		*psSyncMemInfo;
 	SGX_QUEUETRANSFER			sQueueTransfer;
+	EGL_FENCE_WAIT				sFenceWait;             /* shared by the threads waiting on a fence */
 	IMG_UINT32                  ui32WaitValue;
 
 	EGLint                      refcount;
@@ -1373,6 +1373,11 @@ static IMG_BOOL IMGSearchGLES2Extension(const char *procname)
 	EGL_COMPARE_AND_RETURN(glDiscardFramebufferEXT)
 #endif /* defined(GLES2_EXTENSION_DISCARD_FRAMEBUFFER) */
 
+#if defined(GLES2_EXTENSION_MAP_BUFFER_RANGE)
+	EGL_COMPARE_AND_RETURN(glMapBufferRangeEXT)
+	EGL_COMPARE_AND_RETURN(glFlushMappedBufferRangeEXT)
+#endif /* defined(GLES2_EXTENSION_MAP_BUFFER_RANGE) */
+
 #if defined(GLES2_EXTENSION_MULTISAMPLED_RENDER_TO_TEXTURE)
 	EGL_COMPARE_AND_RETURN(glRenderbufferStorageMultisampleIMG)
 	EGL_COMPARE_AND_RETURN(glFramebufferTexture2DMultisampleIMG)
@@ -13,8 +13,8 @@
 #include "wsegl.h"
 #include "math.h"
 #include "cfg.h"
+#include "cfg_index.h"
 #include "tls.h"
-#include "qsort.h"
 #include "srv.h"
 #include "generic_ws.h"
 #include "function_table.h"
@@ -1866,6 +1866,7 @@ IMG_EXPORT EGLBoolean IMGeglInitialize(EGLDisplay eglDpy, EGLint *major, EGLint
 			psDpy->bUseHWForWindowSync = IMG_FALSE;
 			psDpy->bUseHWForPixmapSync = IMG_FALSE;
 			psDpy->bUnlockedWSEGL = IMG_FALSE;
+			psDpy->bAdaptiveSwapInterval = IMG_FALSE;
 #if defined(EGL_EXTENSION_KHR_FENCE_SYNC)
 			psDpy->psHeadSync = IMG_NULL;
 #endif
@@ -1899,6 +1900,11 @@ IMG_EXPORT EGLBoolean IMGeglInitialize(EGLDisplay eglDpy, EGLint *major, EGLint
 						psDpy->bUnlockedWSEGL = psCapabilities->ui32CapsValue ? IMG_TRUE : IMG_FALSE;
 						break;
 					}
+					case WSEGL_CAP_ADAPTIVE_SWAP_INTERVAL:
+					{
+						psDpy->bAdaptiveSwapInterval = psCapabilities->ui32CapsValue ? IMG_TRUE : IMG_FALSE;
+						break;
+					}
 					default:
 					{
 						PVR_DPF((PVR_DBG_WARNING, "IMGeglInitialize:  Unknown caps type %d",psCapabilities->eCapsType));
@@ -1917,6 +1923,9 @@ IMG_EXPORT EGLBoolean IMGeglInitialize(EGLDisplay eglDpy, EGLint *major, EGLint
 
 		psDpy->isInitialised = EGL_TRUE;
 
+		/* If this fails eglChooseConfig tries again */
+		psDpy->psCfgIndex = CFGI_Create(psDpy);
+
 		if(psDpy->bHasBeenInitialised == IMG_FALSE)
 		{
 		  psDpy->psHeadSurface = IMG_NULL;
@@ -2110,6 +2119,10 @@ IMG_EXPORT EGLBoolean IMGeglTerminate(EGLDisplay eglDpy)
 
 			psDpy->hDisplay = IMG_NULL;
 
+			CFGI_Destroy(psDpy->psCfgIndex);
+
+			psDpy->psCfgIndex = IMG_NULL;
+
 			psDpy->isInitialised = EGL_FALSE;
 
 
@@ -2283,6 +2296,9 @@ IMG_EXPORT const char * IMGeglQueryString(EGLDisplay eglDpy, EGLint name)
 #endif
 #if defined(EGL_EXTENSION_IMG_EGL_HIBERNATION)
 				"EGL_IMG_hibernate_process "
+#endif
+#if defined(EGL_EXTENSION_IMG_PRESENT_STATS)
+				"EGL_IMG_present_stats "
 #endif
 				;
 		}
@@ -2894,13 +2910,8 @@ IMG_EXPORT EGLBoolean IMGeglChooseConfig(EGLDisplay eglDpy,
 										 EGLint *num_config)
 {
 	KEGL_DISPLAY	*psDpy;
-	KEGL_CONFIG		**working_configs;
-	EGLint			match_count;
 	EGLint			attriblist_count;
-	EGLint			i, index;
-	EGLint			cfg_variants;
-	KEGL_CONFIG		*requested_cfg;
-	EGLint			num_config_local;
+	EGLint			index;
 	TLS				psTls;
 #if defined(EGL_EXTENSION_IMG_EGL_HIBERNATION)
 	SrvSysContext *psSysContext;
@@ -2968,109 +2979,29 @@ IMG_EXPORT EGLBoolean IMGeglChooseConfig(EGLDisplay eglDpy,
 		return EGL_FALSE;
 	}
 
-	requested_cfg = CFG_PrepareConfigFilter(pAttribList, attriblist_count);
+	EGLThreadLock(psTls);
 
-	if (requested_cfg==IMG_NULL)
+	if (psDpy->psCfgIndex==IMG_NULL)
 	{
-		psTls->lastError = EGL_BAD_ATTRIBUTE;
-		IMGEGL_TIME_STOP(IMGEGL_TIMER_IMGeglChooseConfig);
-		return EGL_FALSE;
+		/* Indexing the configs failed in eglInitialize */
+		psDpy->psCfgIndex = CFGI_Create(psDpy);
 	}
 
-	cfg_variants = CFG_Variants(psDpy);
-
-	working_configs = EGLCalloc(sizeof(*working_configs) * cfg_variants);
-	if (working_configs==IMG_NULL)
+	if (psDpy->psCfgIndex==IMG_NULL)
 	{
-		CFGC_Unlink(requested_cfg);
 		psTls->lastError = EGL_BAD_ALLOC;
-		IMGEGL_TIME_STOP(IMGEGL_TIMER_IMGeglChooseConfig);
-		return EGL_FALSE;
-	}
-
-	for (match_count=0,i=1; i<=cfg_variants; i++)
-	{
-		KEGL_CONFIG *psCfg;
-
-		psTls->lastError = CFG_GenerateVariant(psDpy, i, &psCfg);
-
-		if (psTls->lastError!=EGL_SUCCESS)
-		{
-			for (i=0; i<match_count; i++)
-			{
-				CFGC_Unlink(working_configs[i]);
-			}
-
-			EGLFree(working_configs);
-
-			CFGC_Unlink(requested_cfg);
-
-			psTls->lastError = EGL_BAD_ALLOC;
-
-			IMGEGL_TIME_STOP(IMGEGL_TIMER_IMGeglChooseConfig);
-
-			return EGL_FALSE;
-		}
-
-		if (CFG_Match(requested_cfg, psCfg))
-		{
-			working_configs[match_count] = psCfg;
-
-			match_count ++;
-		}
-		else
-		{
-			CFGC_Unlink(psCfg);
-		}
 	}
-
-	if (configs==0)
-	{
-		for (i=0; i<match_count; i++)
-		{
-			CFGC_Unlink(working_configs[i]);
-		}
-
-		EGLFree(working_configs);
-
-		CFGC_Unlink(requested_cfg);
-
-		*num_config = match_count;
-
-		IMGEGL_TIME_STOP(IMGEGL_TIMER_IMGeglChooseConfig);
-
-		return EGL_TRUE;
-	}
-
-	/* sort the results */
-	PVR_qsort_s(working_configs, match_count, sizeof(*working_configs),
-				CFG_Compare, requested_cfg);
-
-	CFGC_Unlink(requested_cfg);
-
-	for (num_config_local=0;
-		 num_config_local<config_size && num_config_local < match_count;
-		 num_config_local++)
-	{
-		configs[num_config_local] = (EGLConfig) CFGC_GetAttrib(working_configs[num_config_local], EGL_CONFIG_ID);
-
-		CFGC_Unlink(working_configs[num_config_local]);
-	}
-
-	/* Write back the number of configs written */
-	*num_config = num_config_local;
-
-	/* Mop up any allocated but unrequired configs */
-	for (;num_config_local < match_count; num_config_local++)
+	else
 	{
-		CFGC_Unlink(working_configs[num_config_local]);
+		psTls->lastError = CFGI_ChooseConfig(psDpy->psCfgIndex, pAttribList, attriblist_count,
+											 configs, config_size, num_config);
 	}
 
-	EGLFree(working_configs);
+	EGLThreadUnlock(psTls);
 
 	IMGEGL_TIME_STOP(IMGEGL_TIMER_IMGeglChooseConfig);
 
-	return EGL_TRUE;
+	return (psTls->lastError==EGL_SUCCESS) ? EGL_TRUE : EGL_FALSE;
 }
 
 
@@ -4875,6 +4806,103 @@ IMG_EXPORT EGLBoolean IMGeglQuerySurface(EGLDisplay eglDpy,
 
 			break;
 		}
+#if defined(EGL_EXTENSION_IMG_PRESENT_STATS)
+		case EGL_SWAP_INTERVAL_ADAPTIVE_IMG:
+		{
+			if (psSurface->type == EGL_SURFACE_WINDOW)
+			{
+				*value = psSurface->u.window.bAdaptiveSwapInterval ? EGL_TRUE : EGL_FALSE;
+			}
+			else
+			{
+				*value = EGL_FALSE;
+			}
+
+			break;
+		}
+		case EGL_PRESENT_COUNT_IMG:
+		case EGL_PRESENT_LATE_COUNT_IMG:
+		case EGL_PRESENT_TORN_COUNT_IMG:
+		case EGL_PRESENT_MISSED_INTERVALS_IMG:
+		case EGL_PRESENT_QUEUE_DEPTH_IMG:
+		case EGL_PRESENT_LATENCY_IMG:
+		case EGL_PRESENT_AVERAGE_LATENCY_IMG:
+		case EGL_PRESENT_MAX_LATENCY_IMG:
+		case EGL_PRESENT_FRAME_TIME_IMG:
+		{
+			WSEGLPresentStats sPresentStats;
+			WSEGLError eError = WSEGL_BAD_MATCH;
+
+			if ((psSurface->type == EGL_SURFACE_WINDOW) && psDpy->pWSEGL_FT->pfnWSEGL_GetPresentStats)
+			{
+				EGLThreadLockWSEGL(psDpy, psTls);
+
+				eError = psDpy->pWSEGL_FT->pfnWSEGL_GetPresentStats(psSurface->u.window.hDrawable, &sPresentStats);
+
+				EGLThreadUnlockWSEGL(psDpy, psTls);
+			}
+
+			if (eError != WSEGL_SUCCESS)
+			{
+				psTls->lastError = EGL_BAD_MATCH;
+
+				IMGEGL_TIME_STOP(IMGEGL_TIMER_IMGeglQuerySurface);
+
+				return EGL_FALSE;
+			}
+
+			switch (attribute)
+			{
+				case EGL_PRESENT_COUNT_IMG:
+				{
+					*value = (EGLint)sPresentStats.ulPresents;
+					break;
+				}
+				case EGL_PRESENT_LATE_COUNT_IMG:
+				{
+					*value = (EGLint)sPresentStats.ulLatePresents;
+					break;
+				}
+				case EGL_PRESENT_TORN_COUNT_IMG:
+				{
+					*value = (EGLint)sPresentStats.ulTornPresents;
+					break;
+				}
+				case EGL_PRESENT_MISSED_INTERVALS_IMG:
+				{
+					*value = (EGLint)sPresentStats.ulMissedIntervals;
+					break;
+				}
+				case EGL_PRESENT_QUEUE_DEPTH_IMG:
+				{
+					*value = (EGLint)sPresentStats.ulQueueDepth;
+					break;
+				}
+				case EGL_PRESENT_LATENCY_IMG:
+				{
+					*value = (EGLint)sPresentStats.ulLastLatency;
+					break;
+				}
+				case EGL_PRESENT_AVERAGE_LATENCY_IMG:
+				{
+					*value = (EGLint)sPresentStats.ulAverageLatency;
+					break;
+				}
+				case EGL_PRESENT_MAX_LATENCY_IMG:
+				{
+					*value = (EGLint)sPresentStats.ulMaxLatency;
+					break;
+				}
+				default:
+				{
+					*value = (EGLint)sPresentStats.ulLastFrameTime;
+					break;
+				}
+			}
+
+			break;
+		}
+#endif /* defined(EGL_EXTENSION_IMG_PRESENT_STATS) */
 
 		default:
 		{
@@ -8039,6 +8067,47 @@ bad_attrib:
 			}
 			break;
 		}
+#if defined(EGL_EXTENSION_IMG_PRESENT_STATS)
+		case EGL_SWAP_INTERVAL_ADAPTIVE_IMG:
+		{
+			WSEGLError eError;
+
+			if ((value != EGL_TRUE) && (value != EGL_FALSE))
+			{
+				goto bad_attrib;
+			}
+
+			if ((psSurface->type != EGL_SURFACE_WINDOW) ||
+				!psDpy->bAdaptiveSwapInterval ||
+				!psDpy->pWSEGL_FT->pfnWSEGL_SwapControlAdaptive)
+			{
+				psTls->lastError = EGL_BAD_MATCH;
+
+				IMGEGL_TIME_STOP(IMGEGL_TIMER_IMGeglSurfaceAttrib);
+
+				return EGL_FALSE;
+			}
+
+			EGLThreadLockWSEGL(psDpy, psTls);
+
+			eError = psDpy->pWSEGL_FT->pfnWSEGL_SwapControlAdaptive(psSurface->u.window.hDrawable, (unsigned long)value);
+
+			EGLThreadUnlockWSEGL(psDpy, psTls);
+
+			if (eError != WSEGL_SUCCESS)
+			{
+				psTls->lastError = EGL_BAD_MATCH;
+
+				IMGEGL_TIME_STOP(IMGEGL_TIMER_IMGeglSurfaceAttrib);
+
+				return EGL_FALSE;
+			}
+
+			psSurface->u.window.bAdaptiveSwapInterval = (value == EGL_TRUE) ? IMG_TRUE : IMG_FALSE;
+
+			break;
+		}
+#endif /* defined(EGL_EXTENSION_IMG_PRESENT_STATS) */
 		default:
 		{
 			goto bad_attrib;
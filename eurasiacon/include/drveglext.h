@@ -199,6 +199,20 @@ typedef EGLBoolean (EGLAPIENTRYP PFNEGLGETSYNCATTRIBKHRPROC) (EGLDisplay dpy, EG
 #define EGL_CONTEXT_PRIORITY_LOW_IMG			0x3103
 #endif
 
+#ifndef EGL_IMG_present_stats
+#define EGL_IMG_present_stats 1
+#define EGL_SWAP_INTERVAL_ADAPTIVE_IMG			0x3105	/* eglSurfaceAttrib/eglQuerySurface attribute */
+#define EGL_PRESENT_COUNT_IMG					0x3106	/* eglQuerySurface attributes */
+#define EGL_PRESENT_LATE_COUNT_IMG				0x3107
+#define EGL_PRESENT_TORN_COUNT_IMG				0x3108
+#define EGL_PRESENT_MISSED_INTERVALS_IMG		0x3109
+#define EGL_PRESENT_QUEUE_DEPTH_IMG				0x310A
+#define EGL_PRESENT_LATENCY_IMG					0x310B
+#define EGL_PRESENT_AVERAGE_LATENCY_IMG			0x310C
+#define EGL_PRESENT_MAX_LATENCY_IMG				0x310D
+#define EGL_PRESENT_FRAME_TIME_IMG				0x310E
+#endif
+
 #ifndef EGL_KHR_lock_surface2
 #define EGL_KHR_lock_surface2 1
 #define EGL_BITMAP_PIXEL_SIZE_KHR		0x3110
@@ -67,6 +67,7 @@
 #define GLES2_EXTENSION_PACKED_DEPTH_STENCIL
 #define GLES2_EXTENSION_VERTEX_ARRAY_OBJECT
 #define GLES2_EXTENSION_DISCARD_FRAMEBUFFER
+#define GLES2_EXTENSION_MAP_BUFFER_RANGE
 #if !defined(GLES2_EXTENSION_EGL_IMAGE_EXTERNAL)
 #define GLES2_EXTENSION_TEXTURE_STREAM
 #endif
@@ -88,6 +89,7 @@
 #undef EGL_EXTENSION_KHR_FENCE_SYNC
 #define EGL_EXTENSION_KHR_REUSABLE_SYNC
 #define EGL_CORE_PROC
+#define EGL_EXTENSION_IMG_PRESENT_STATS
 #endif
 
 /* EGL image extensions */
@@ -42,7 +42,7 @@ extern "C" {
 // WSEGL API Version Number
 */
 
-#define WSEGL_VERSION 2
+#define WSEGL_VERSION 3
 #define WSEGL_DEFAULT_DISPLAY 0
 #define WSEGL_DEFAULT_NATIVE_ENGINE 0
 
@@ -74,6 +74,10 @@ typedef enum WSEGLCapsType_TAG
 	   its own locking in this case. */
 	WSEGL_CAP_UNLOCKED = 5, /* System default value = 0 */
 
+	/* Set when window drawables can be put in adaptive swap interval
+	   mode, where a swap that missed its vblank is flipped at once. */
+	WSEGL_CAP_ADAPTIVE_SWAP_INTERVAL = 6, /* System default value = 0 */
+
 } WSEGLCapsType;
 
 /*
@@ -252,6 +256,36 @@ typedef struct WSEGLDrawableParams_TAG
 
 } WSEGLDrawableParams;
 
+/*
+// Presentation statistics of a window drawable
+*/
+typedef struct WSEGLPresentStats_TAG
+{
+	/* Swaps presented */
+	unsigned long	ulPresents;
+
+	/* Swaps that missed the vblank their swap interval asked for */
+	unsigned long	ulLatePresents;
+
+	/* Late swaps flipped at once in adaptive swap interval mode */
+	unsigned long	ulTornPresents;
+
+	/* Vblanks lost to late swaps */
+	unsigned long	ulMissedIntervals;
+
+	/* Flips not yet shown when the last swap was queued */
+	unsigned long	ulQueueDepth;
+
+	/* Microseconds from swap to display: last swap, average and worst */
+	unsigned long	ulLastLatency;
+	unsigned long	ulAverageLatency;
+	unsigned long	ulMaxLatency;
+
+	/* Microseconds between the last two swaps */
+	unsigned long	ulLastFrameTime;
+
+} WSEGLPresentStats;
+
 
 /*
 // Table of function pointers that is returned by WSEGL_GetFunctionTablePointer()
@@ -291,6 +325,11 @@ typedef struct WSEGL_FunctionTable_TAG
 
 	WSEGLError (*pfnWSEGL_DisconnectDrawable)(WSEGLDrawableHandle);
 
+	/* Optional: only called with WSEGL_CAP_ADAPTIVE_SWAP_INTERVAL set */
+	WSEGLError (*pfnWSEGL_SwapControlAdaptive)(WSEGLDrawableHandle, unsigned long);
+
+	/* Optional: may be NULL */
+	WSEGLError (*pfnWSEGL_GetPresentStats)(WSEGLDrawableHandle, WSEGLPresentStats *);
 
 } WSEGL_FunctionTable;
 
@@ -167,7 +167,7 @@ IMG_INTERNAL IMG_BOOL InitAccumUSECodeBlocks(GLES1Context *gc)
 	pui32BufferBase = gc->sPrim.psDummyPixelSecondaryPDSCode->pui32LinAddress;
 
 	/* PRQA S 3199 1 */ /* pui32Buffer is used in the following GLES1_ASSERT. */
-	pui32Buffer = PDSGeneratePixelShaderSAProgram(&sProgram, pui32BufferBase);
+	pui32Buffer = PDSGeneratePixelShaderSAProgram(&sProgram, pui32BufferBase, IMG_NULL);
 
 	GLES1_ASSERT((IMG_UINT32)(pui32Buffer - pui32BufferBase) == ui32PDSProgramSizeInDWords);
 
@@ -926,7 +926,8 @@ IMG_INTERNAL GLES1_MEMERROR SetupBGObject(GLES1Context *gc, IMG_BOOL bIsAccumula
 	*/
 	pui32Buffer = PDSGeneratePixelShaderProgram(&sTextureImageUnit,
 												&sProgram,
-												pui32BufferBase);
+												pui32BufferBase,
+												IMG_NULL);
 
 	/* 
 	   Update Buffer Position 
@@ -619,7 +619,8 @@ static GLES1_MEMERROR SetupFragmentShaderForClear(GLES1Context *gc, IMG_UINT32 *
 	*/
 	pui32Buffer = PDSGeneratePixelShaderProgram(IMG_NULL,
 												&sProgram,
-												pui32BufferBase);
+												pui32BufferBase,
+												IMG_NULL);
 
 	/*
 	   Update buffer position 
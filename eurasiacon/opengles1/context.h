@@ -68,6 +68,7 @@
 #include "pdump.h"
 #include "ffgen.h"
 #include "fftnlgles.h"
+#include "fftnlcache.h"
 #include "useasmgles.h"
 #include "fftex.h"
 #include "shader.h"
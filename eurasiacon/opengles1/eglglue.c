@@ -1664,6 +1664,14 @@ static IMG_EGLERROR GLESFlushBuffersGC(EGLContextHandle hContext,
 			eError = ScheduleTA(gc, psRenderSurface, ui32Flags);
 		}
 
+#if defined(FFGEN_UNIFLEX)
+		/* Once the frame is kicked, save any FFTNL programs it compiled */
+		if(ui32Flags & GLES1_SCHEDULE_HW_LAST_IN_SCENE)
+		{
+			FFTNLCacheFlush(gc);
+		}
+#endif /* defined(FFGEN_UNIFLEX) */
+
 		if((eError == IMG_EGL_NO_ERROR) && bNewExternalFrame)
 		{
 			psRenderSurface->bInExternalFrame = IMG_FALSE;
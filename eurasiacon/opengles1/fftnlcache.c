@@ -0,0 +1,559 @@
+/******************************************************************************
+ * Name         : fftnlcache.c
+ *
+ * Copyright    : 2006-2008 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means, electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Platform     : ANSI
+ *
+ * $Log: fftnlcache.c $
+ *****************************************************************************/
+#include "context.h"
+
+#if defined(FFGEN_UNIFLEX)
+
+/*
+	Compiled FFTNL programs are kept in a hash table keyed by the FFTNL
+	description and output masks. The item of each entry is the record exactly
+	as it is laid out in the cache file (see ffgencache.h), so that loading the
+	file and storing a new program share the same representation. Reading and
+	writing the file is shared with host/ffgencache, which builds the cache
+	offline from state logs.
+
+	New programs only mark the cache dirty. The file is written at the end of
+	a frame and when the context is destroyed, after merging in whatever other
+	contexts have written to it since, so no context drops another's programs.
+*/
+
+
+/***********************************************************************************
+ Function Name      : DestroyFFTNLCacheRecord
+ Inputs             : gc, ui32Item
+ Outputs            : -
+ Returns            : -
+ Description        : Frees a cached FFTNL program record
+************************************************************************************/
+static IMG_VOID DestroyFFTNLCacheRecord(GLES1Context *gc, IMG_UINT32 ui32Item)
+{
+	PVR_UNREFERENCED_PARAMETER(gc);
+
+	GLES1Free(IMG_NULL, (IMG_VOID *)ui32Item);
+}
+
+
+/***********************************************************************************
+ Function Name      : InsertFFTNLCacheRecord
+ Inputs             : gc, pui32Record
+ Outputs            : -
+ Returns            : IMG_TRUE if the hash table took ownership of the record
+ Description        : Adds a record to the in-memory cache
+************************************************************************************/
+static IMG_BOOL InsertFFTNLCacheRecord(GLES1Context *gc, IMG_UINT32 *pui32Record)
+{
+	FFGenCacheRecordHeader *psRecordHeader = (FFGenCacheRecordHeader *)pui32Record;
+	IMG_UINT32 *pui32Key = &pui32Record[FFGEN_CACHE_RECORD_HEADER_DWORDS];
+	IMG_UINT32 *pui32KeyCopy;
+	IMG_UINT32 ui32Existing;
+
+	/* The same program may have been appended by more than one context */
+	if(HashTableSearch(gc, &gc->sProgram.sFFTNLCacheHashTable, psRecordHeader->ui32KeyHash,
+					   pui32Key, GLES1_FFTNL_CACHE_KEY_DWORDS, &ui32Existing))
+	{
+		return IMG_FALSE;
+	}
+
+	if(!ValidateHashTableInsert(gc, &gc->sProgram.sFFTNLCacheHashTable, psRecordHeader->ui32KeyHash))
+	{
+		return IMG_FALSE;
+	}
+
+	pui32KeyCopy = GLES1Malloc(gc, GLES1_FFTNL_CACHE_KEY_DWORDS * sizeof(IMG_UINT32));
+
+	if(!pui32KeyCopy)
+	{
+		return IMG_FALSE;
+	}
+
+	GLES1MemCopy(pui32KeyCopy, pui32Key, GLES1_FFTNL_CACHE_KEY_DWORDS * sizeof(IMG_UINT32));
+
+	HashTableInsert(gc, &gc->sProgram.sFFTNLCacheHashTable, psRecordHeader->ui32KeyHash,
+					pui32KeyCopy, GLES1_FFTNL_CACHE_KEY_DWORDS, (IMG_UINT32)pui32Record);
+
+	return IMG_TRUE;
+}
+
+
+/***********************************************************************************
+ Function Name      : FFTNLCacheMalloc / FFTNLCacheFree
+ Inputs             : hHandle, ui32Size / pvData
+ Outputs            : -
+ Returns            : -
+ Description        : Record memory for FFGenCacheReadFile()
+************************************************************************************/
+static IMG_VOID * IMG_CALLCONV FFTNLCacheMalloc(IMG_HANDLE hHandle, IMG_UINT32 ui32Size)
+{
+	return GLES1Malloc((GLES1Context *)hHandle, ui32Size);
+}
+
+static IMG_VOID IMG_CALLCONV FFTNLCacheFree(IMG_HANDLE hHandle, IMG_VOID *pvData)
+{
+	PVR_UNREFERENCED_PARAMETER(hHandle);
+
+	GLES1Free(IMG_NULL, pvData);
+}
+
+
+/***********************************************************************************
+ Function Name      : LoadFFTNLCacheRecord
+ Inputs             : hHandle, pui32Record
+ Outputs            : -
+ Returns            : IMG_TRUE if the hash table took ownership of the record
+ Description        : Adds a record read from the cache file to the in-memory cache
+************************************************************************************/
+static IMG_BOOL IMG_CALLCONV LoadFFTNLCacheRecord(IMG_HANDLE hHandle, IMG_UINT32 *pui32Record)
+{
+	/* Don't rely on the hash function being unchanged since the record was written */
+	((FFGenCacheRecordHeader *)pui32Record)->ui32KeyHash = HashFunc(&pui32Record[FFGEN_CACHE_RECORD_HEADER_DWORDS],
+																	GLES1_FFTNL_CACHE_KEY_DWORDS, STATEHASH_INIT_VALUE);
+
+	return InsertFFTNLCacheRecord((GLES1Context *)hHandle, pui32Record);
+}
+
+
+typedef struct FFTNLCacheIterator_TAG
+{
+	HashTable *psHashTable;
+	IMG_UINT32 ui32Bucket;
+	HashEntry *psEntry;
+
+} FFTNLCacheIterator;
+
+/***********************************************************************************
+ Function Name      : NextFFTNLCacheRecord
+ Inputs             : hHandle
+ Outputs            : -
+ Returns            : The next record of the in-memory cache, IMG_NULL after the last
+ Description        : Walks the in-memory cache for FFGenCacheWriteFile()
+************************************************************************************/
+static const IMG_UINT32 * IMG_CALLCONV NextFFTNLCacheRecord(IMG_HANDLE hHandle)
+{
+	FFTNLCacheIterator *psIterator = (FFTNLCacheIterator *)hHandle;
+	const IMG_UINT32 *pui32Record;
+
+	while(!psIterator->psEntry)
+	{
+		if(psIterator->ui32Bucket == psIterator->psHashTable->ui32TableSize)
+		{
+			return IMG_NULL;
+		}
+
+		psIterator->psEntry = psIterator->psHashTable->psTable[psIterator->ui32Bucket++];
+	}
+
+	pui32Record = (const IMG_UINT32 *)psIterator->psEntry->ui32Item;
+
+	psIterator->psEntry = psIterator->psEntry->psNext;
+
+	return pui32Record;
+}
+
+
+/***********************************************************************************
+ Function Name      : SaveFFTNLCache
+ Inputs             : gc
+ Outputs            : -
+ Returns            : -
+ Description        : Replaces the cache file with the in-memory cache, after
+					  first adding the records other contexts have written to
+					  the file. The file is written to one side, under a name
+					  unique to this context, and renamed over the old one, so
+					  it is always either the previous or the new cache.
+************************************************************************************/
+static IMG_VOID SaveFFTNLCache(GLES1Context *gc)
+{
+	FFTNLCacheIterator sIterator;
+	IMG_CHAR szTempTag[32];
+
+	/* Records already held are freed by the reader; a mismatched file is replaced */
+	FFGenCacheReadFile(gc->sAppHints.szFFTNLCacheFile, GLES1_FFTNL_CACHE_KEY_DWORDS,
+					   (IMG_HANDLE)gc, FFTNLCacheMalloc, FFTNLCacheFree, LoadFFTNLCacheRecord);
+
+	sIterator.psHashTable	= &gc->sProgram.sFFTNLCacheHashTable;
+	sIterator.ui32Bucket	= 0;
+	sIterator.psEntry		= IMG_NULL;
+
+	sprintf(szTempTag, ".%x.%x", PVRSRVGetCurrentProcessID(), (IMG_UINT32)gc);
+
+	if(!FFGenCacheWriteFile(gc->sAppHints.szFFTNLCacheFile, szTempTag, GLES1_FFTNL_CACHE_KEY_DWORDS, (IMG_HANDLE)&sIterator, NextFFTNLCacheRecord))
+	{
+		PVR_DPF((PVR_DBG_WARNING, "SaveFFTNLCache: Failed to write %s", gc->sAppHints.szFFTNLCacheFile));
+	}
+}
+
+
+/***********************************************************************************
+ Function Name      : InitFFTNLCache
+ Inputs             : gc
+ Outputs            : gc->sProgram.sFFTNLCacheHashTable
+ Returns            : -
+ Description        : Loads the persistent FFTNL program cache named by the
+					  FFTNLCacheFile apphint and opens the state log named by the
+					  FFTNLStateLog apphint. Either is simply left disabled if
+					  anything goes wrong.
+************************************************************************************/
+IMG_INTERNAL IMG_VOID InitFFTNLCache(GLES1Context *gc)
+{
+	FFGEN_CACHE_STATUS eStatus;
+
+	gc->sProgram.bFFTNLCacheEnabled = IMG_FALSE;
+	gc->sProgram.bFFTNLCacheDirty = IMG_FALSE;
+	gc->sProgram.bFFTNLCacheStored = IMG_FALSE;
+	gc->sProgram.pvFFTNLStateLog = IMG_NULL;
+
+	if(gc->sAppHints.szFFTNLStateLog[0] != '\0')
+	{
+		gc->sProgram.pvFFTNLStateLog = FFGenStateLogOpen(gc->sAppHints.szFFTNLStateLog, GLES1_FFTNL_CACHE_KEY_DWORDS);
+
+		if(!gc->sProgram.pvFFTNLStateLog)
+		{
+			PVR_DPF((PVR_DBG_WARNING, "InitFFTNLCache: Can't open %s for writing", gc->sAppHints.szFFTNLStateLog));
+		}
+	}
+
+	if(gc->sAppHints.szFFTNLCacheFile[0] == '\0')
+	{
+		return;
+	}
+
+	if(!HashTableCreate(gc, &gc->sProgram.sFFTNLCacheHashTable, STATEHASH_LOG2TABLESIZE, STATEHASH_MAXNUMENTRIES, DestroyFFTNLCacheRecord
+#ifdef HASHTABLE_DEBUG
+		, "FFTNLCache"
+#endif
+		))
+	{
+		PVR_DPF((PVR_DBG_WARNING, "InitFFTNLCache: Failed create FFTNL cache hash table"));
+
+		return;
+	}
+
+	eStatus = FFGenCacheReadFile(gc->sAppHints.szFFTNLCacheFile, GLES1_FFTNL_CACHE_KEY_DWORDS,
+								 (IMG_HANDLE)gc, FFTNLCacheMalloc, FFTNLCacheFree, LoadFFTNLCacheRecord);
+
+	switch(eStatus)
+	{
+		case FFGEN_CACHE_MISMATCH:
+		{
+			/* Replaced when the cache is next saved */
+			PVR_DPF((PVR_DBG_WARNING, "InitFFTNLCache: %s was built by a different driver, discarding", gc->sAppHints.szFFTNLCacheFile));
+
+			break;
+		}
+		case FFGEN_CACHE_DAMAGED:
+		case FFGEN_CACHE_NO_MEMORY:
+		{
+			/* The records read before the problem are still usable */
+			PVR_DPF((PVR_DBG_WARNING, "InitFFTNLCache: Only part of %s could be loaded", gc->sAppHints.szFFTNLCacheFile));
+
+			break;
+		}
+		default:
+		{
+			break;
+		}
+	}
+
+	gc->sProgram.bFFTNLCacheEnabled = IMG_TRUE;
+}
+
+
+/***********************************************************************************
+ Function Name      : FreeFFTNLCache
+ Inputs             : gc
+ Outputs            : -
+ Returns            : -
+ Description        : Saves and frees the persistent FFTNL program cache and
+					  closes the state log
+************************************************************************************/
+IMG_INTERNAL IMG_VOID FreeFFTNLCache(GLES1Context *gc)
+{
+	if(gc->sProgram.pvFFTNLStateLog)
+	{
+		FFGenStateLogClose(gc->sProgram.pvFFTNLStateLog);
+
+		gc->sProgram.pvFFTNLStateLog = IMG_NULL;
+	}
+
+	if(!gc->sProgram.bFFTNLCacheEnabled)
+	{
+		return;
+	}
+
+	/*
+		Save again if this context added anything, even if that was already
+		written: another context may have replaced the file in between
+	*/
+	if(gc->sProgram.bFFTNLCacheStored)
+	{
+		SaveFFTNLCache(gc);
+	}
+
+	/* Hash table call back function will free the records */
+	HashTableDestroy(gc, &gc->sProgram.sFFTNLCacheHashTable);
+
+	gc->sProgram.bFFTNLCacheEnabled = IMG_FALSE;
+}
+
+
+/***********************************************************************************
+ Function Name      : FFTNLCacheFlush
+ Inputs             : gc
+ Outputs            : -
+ Returns            : -
+ Description        : Writes the cache file if programs were added to the cache
+					  since it was last written. Called once per frame.
+************************************************************************************/
+IMG_INTERNAL IMG_VOID FFTNLCacheFlush(GLES1Context *gc)
+{
+	if(!gc->sProgram.bFFTNLCacheEnabled || !gc->sProgram.bFFTNLCacheDirty)
+	{
+		return;
+	}
+
+	SaveFFTNLCache(gc);
+
+	/* Not retried each frame if it failed; FreeFFTNLCache() tries again */
+	gc->sProgram.bFFTNLCacheDirty = IMG_FALSE;
+}
+
+
+/***********************************************************************************
+ Function Name      : FFTNLCacheLogKey
+ Inputs             : gc, pui32Key
+ Outputs            : -
+ Returns            : -
+ Description        : Records the key of a FFTNL program in the state log, from
+					  which host/ffgencache builds the cache offline
+************************************************************************************/
+IMG_INTERNAL IMG_VOID FFTNLCacheLogKey(GLES1Context *gc, IMG_UINT32 *pui32Key)
+{
+	if(!gc->sProgram.pvFFTNLStateLog)
+	{
+		return;
+	}
+
+	if(!FFGenStateLogAppend(gc->sProgram.pvFFTNLStateLog, pui32Key, GLES1_FFTNL_CACHE_KEY_DWORDS))
+	{
+		PVR_DPF((PVR_DBG_WARNING, "FFTNLCacheLogKey: Failed to write state log, no longer logging"));
+
+		FFGenStateLogClose(gc->sProgram.pvFFTNLStateLog);
+
+		gc->sProgram.pvFFTNLStateLog = IMG_NULL;
+	}
+}
+
+
+/***********************************************************************************
+ Function Name      : FFTNLCacheRestoreProgram
+ Inputs             : gc, tKeyHash, pui32Key, psFFTNLProgram
+ Outputs            : psFFTNLProgram
+ Returns            : IMG_TRUE if the compiled code was found in the cache
+ Description        : Fills in the results of CompileFFGenUniFlexCode() for a
+					  freshly generated FFTNL program from the cache. The
+					  program's register lists must match the ones the code
+					  was compiled against, otherwise the program is left
+					  untouched and must be compiled as normal.
+************************************************************************************/
+IMG_INTERNAL IMG_BOOL FFTNLCacheRestoreProgram(GLES1Context *gc, HashValue tKeyHash, IMG_UINT32 *pui32Key, FFGenProgram *psFFTNLProgram)
+{
+	FFGEN_PROGRAM_DETAILS *psFFGENProgramDetails = psFFTNLProgram->psFFGENProgramDetails;
+	FFGenCacheProgram *psProgram;
+	FFGenRegList *psRegList;
+	IMG_UINT32 *pui32Record, *pui32Data, *pui32RegData;
+	IMG_UINT32 *pui32Instructions, *pui32UFConstantData, *pui32UFConstantDest;
+	IMG_UINT32 ui32NumRegs, ui32NumUFConstants;
+
+	if(!gc->sProgram.bFFTNLCacheEnabled)
+	{
+		return IMG_FALSE;
+	}
+
+	if(!HashTableSearch(gc, &gc->sProgram.sFFTNLCacheHashTable, tKeyHash,
+						pui32Key, GLES1_FFTNL_CACHE_KEY_DWORDS, (IMG_UINT32 *)&pui32Record))
+	{
+		GLES1_INC_COUNT(GLES1_TIMER_FFTNL_CACHE_MISS_COUNT, 1);
+
+		return IMG_FALSE;
+	}
+
+	psProgram = (FFGenCacheProgram *)&pui32Record[FFGEN_CACHE_RECORD_HEADER_DWORDS + GLES1_FFTNL_CACHE_KEY_DWORDS];
+	pui32Data = (IMG_UINT32 *)(psProgram + 1);
+	ui32NumUFConstants = psProgram->ui32NumUFConstants;
+
+	/* Check the constant registers before changing anything */
+	pui32RegData = &pui32Data[2 * ui32NumUFConstants];
+	psRegList = psFFTNLProgram->psConstantsList;
+	ui32NumRegs = 0;
+
+	while(psRegList)
+	{
+		if((ui32NumRegs == psProgram->ui32NumConstantRegs) ||
+		   (pui32RegData[0] > psRegList->psReg->uSizeInDWords))
+		{
+			break;
+		}
+
+		pui32RegData += 1 + 2 * pui32RegData[0];
+		ui32NumRegs++;
+
+		psRegList = psRegList->psNext;
+	}
+
+	if(psRegList || (ui32NumRegs != psProgram->ui32NumConstantRegs))
+	{
+		PVR_DPF((PVR_DBG_WARNING, "FFTNLCacheRestoreProgram: Cached program doesn't match generated registers"));
+
+		return IMG_FALSE;
+	}
+
+	pui32Instructions = GLES1Malloc(gc, psProgram->ui32InstructionCount * EURASIA_USE_INSTRUCTION_SIZE);
+
+	if(!pui32Instructions)
+	{
+		return IMG_FALSE;
+	}
+
+	pui32UFConstantData = IMG_NULL;
+	pui32UFConstantDest = IMG_NULL;
+
+	if(ui32NumUFConstants)
+	{
+		pui32UFConstantData = GLES1Malloc(gc, ui32NumUFConstants * sizeof(IMG_UINT32));
+		pui32UFConstantDest = GLES1Malloc(gc, ui32NumUFConstants * sizeof(IMG_UINT32));
+
+		if(!pui32UFConstantData || !pui32UFConstantDest)
+		{
+			if(pui32UFConstantData)
+			{
+				GLES1Free(IMG_NULL, pui32UFConstantData);
+			}
+
+			if(pui32UFConstantDest)
+			{
+				GLES1Free(IMG_NULL, pui32UFConstantDest);
+			}
+
+			GLES1Free(IMG_NULL, pui32Instructions);
+
+			return IMG_FALSE;
+		}
+
+		GLES1MemCopy(pui32UFConstantData, pui32Data, ui32NumUFConstants * sizeof(IMG_UINT32));
+		GLES1MemCopy(pui32UFConstantDest, &pui32Data[ui32NumUFConstants], ui32NumUFConstants * sizeof(IMG_UINT32));
+	}
+
+	/* Constant register mappings */
+	pui32RegData = &pui32Data[2 * ui32NumUFConstants];
+	psRegList = psFFTNLProgram->psConstantsList;
+
+	while(psRegList)
+	{
+		FFGenReg *psReg = psRegList->psReg;
+
+		psReg->ui32ConstantCount = pui32RegData[0];
+
+		GLES1MemCopy(psReg->pui32SrcOffset, &pui32RegData[1], psReg->ui32ConstantCount * sizeof(IMG_UINT32));
+		GLES1MemCopy(psReg->pui32DstOffset, &pui32RegData[1 + psReg->ui32ConstantCount], psReg->ui32ConstantCount * sizeof(IMG_UINT32));
+
+		pui32RegData += 1 + 2 * psReg->ui32ConstantCount;
+
+		psRegList = psRegList->psNext;
+	}
+
+	GLES1MemCopy(pui32Instructions, pui32RegData, psProgram->ui32InstructionCount * EURASIA_USE_INSTRUCTION_SIZE);
+
+	/* Setup compiled code */
+	psFFGENProgramDetails->bUSEPerInstanceMode			= psProgram->bUSEPerInstanceMode;
+	psFFGENProgramDetails->ui32InstructionCount			= psProgram->ui32InstructionCount;
+	psFFGENProgramDetails->pui32Instructions			= pui32Instructions;
+	psFFGENProgramDetails->ui32PrimaryAttributeCount	= psProgram->ui32PrimaryAttributeCount;
+	psFFGENProgramDetails->ui32SecondaryAttributeCount	= psProgram->ui32SecondaryAttributeCount;
+	psFFGENProgramDetails->ui32TemporaryRegisterCount	= psProgram->ui32TemporaryRegisterCount;
+	psFFGENProgramDetails->ui32MemoryConstantCount		= psProgram->ui32MemoryConstantCount;
+	psFFGENProgramDetails->iSAAddressAdjust				= (IMG_INT16)psProgram->i32SAAddressAdjust;
+
+	psFFTNLProgram->pui32UFConstantData		= pui32UFConstantData;
+	psFFTNLProgram->pui32UFConstantDest		= pui32UFConstantDest;
+	psFFTNLProgram->ui32NumUFConstants		= ui32NumUFConstants;
+	psFFTNLProgram->ui32MaxNumUFConstants	= ui32NumUFConstants;
+
+	psFFTNLProgram->uMemoryConstantsSize	= psProgram->ui32MemoryConstantCount;
+	psFFTNLProgram->uMemConstBaseAddrSAReg	= 0;
+	psFFTNLProgram->uSecAttribStart			= GLES1_VERTEX_SECATTR_NUM_RESERVED;
+	psFFTNLProgram->uSecAttribSize			= GLES1_VERTEX_SECATTR_NUM_RESERVED + psProgram->ui32SecondaryAttributeCount;
+
+	GLES1_INC_COUNT(GLES1_TIMER_FFTNL_CACHE_HIT_COUNT, 1);
+
+	return IMG_TRUE;
+}
+
+
+/***********************************************************************************
+ Function Name      : FFTNLCacheStoreProgram
+ Inputs             : gc, tKeyHash, pui32Key, psFFTNLProgram
+ Outputs            : -
+ Returns            : -
+ Description        : Adds a compiled FFTNL program to the cache. The file is
+					  written later, by FFTNLCacheFlush() or FreeFFTNLCache().
+************************************************************************************/
+IMG_INTERNAL IMG_VOID FFTNLCacheStoreProgram(GLES1Context *gc, HashValue tKeyHash, IMG_UINT32 *pui32Key, FFGenProgram *psFFTNLProgram)
+{
+	IMG_UINT32 *pui32Record;
+	IMG_UINT32 ui32SizeInDWords;
+
+	if(!gc->sProgram.bFFTNLCacheEnabled)
+	{
+		return;
+	}
+
+	ui32SizeInDWords = FFGenCacheGetRecordSize(psFFTNLProgram, GLES1_FFTNL_CACHE_KEY_DWORDS);
+
+	if(!ui32SizeInDWords)
+	{
+		return;
+	}
+
+	pui32Record = GLES1Malloc(gc, ui32SizeInDWords * sizeof(IMG_UINT32));
+
+	if(!pui32Record)
+	{
+		return;
+	}
+
+	FFGenCacheBuildRecord(psFFTNLProgram, pui32Key, GLES1_FFTNL_CACHE_KEY_DWORDS, tKeyHash, pui32Record);
+
+	GLES1_ASSERT(FFGenCacheValidateRecord(pui32Record, GLES1_FFTNL_CACHE_KEY_DWORDS));
+
+	if(!InsertFFTNLCacheRecord(gc, pui32Record))
+	{
+		GLES1Free(IMG_NULL, pui32Record);
+
+		return;
+	}
+
+	gc->sProgram.bFFTNLCacheDirty = IMG_TRUE;
+	gc->sProgram.bFFTNLCacheStored = IMG_TRUE;
+}
+
+#endif /* defined(FFGEN_UNIFLEX) */
+
+/******************************************************************************
+ End of file (fftnlcache.c)
+******************************************************************************/
@@ -0,0 +1,48 @@
+/******************************************************************************
+ * Name         : fftnlcache.h
+ *
+ * Copyright    : 2006-2008 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means, electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Platform     : ANSI
+ *
+ * $Log: fftnlcache.h $
+ *****************************************************************************/
+
+#ifndef _FFTNLCACHE_
+#define _FFTNLCACHE_
+
+#if defined(FFGEN_UNIFLEX)
+
+#include "ffgencache.h"
+
+/*
+	The key of a cached FFTNL program is the FFTNL description followed by the
+	valid shader output masks handed to the USC (see ffgencache.h).
+*/
+#define GLES1_FFTNL_CACHE_DESC_DWORDS		FFGEN_CACHE_TNL_DESC_DWORDS
+#define GLES1_FFTNL_CACHE_KEY_DWORDS		FFGEN_CACHE_TNL_KEY_DWORDS
+
+IMG_VOID InitFFTNLCache(GLES1Context *gc);
+IMG_VOID FreeFFTNLCache(GLES1Context *gc);
+
+IMG_BOOL FFTNLCacheRestoreProgram(GLES1Context *gc, HashValue tKeyHash, IMG_UINT32 *pui32Key, FFGenProgram *psFFTNLProgram);
+IMG_VOID FFTNLCacheStoreProgram(GLES1Context *gc, HashValue tKeyHash, IMG_UINT32 *pui32Key, FFGenProgram *psFFTNLProgram);
+IMG_VOID FFTNLCacheFlush(GLES1Context *gc);
+IMG_VOID FFTNLCacheLogKey(GLES1Context *gc, IMG_UINT32 *pui32Key);
+
+#endif /* defined(FFGEN_UNIFLEX) */
+
+#endif /* _FFTNLCACHE_ */
+
+/******************************************************************************
+ End of file (fftnlcache.h)
+******************************************************************************/
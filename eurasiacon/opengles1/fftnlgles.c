@@ -295,6 +295,10 @@ IMG_INTERNAL IMG_BOOL InitFFTNLState(GLES1Context *gc)
 		return IMG_FALSE;
 	}
 
+#if defined(FFGEN_UNIFLEX)
+	InitFFTNLCache(gc);
+#endif /* defined(FFGEN_UNIFLEX) */
+
 #if defined(FFGEN_UNIFLEX) && defined(DEBUG)
 	if(gc->sAppHints.bDumpShaders)
 	{
@@ -338,6 +342,8 @@ IMG_INTERNAL IMG_VOID FreeFFTNLState(GLES1Context *gc)
 	}
 
 #if defined(FFGEN_UNIFLEX)
+	FreeFFTNLCache(gc);
+
 	PVRUniFlexDestroyContext((IMG_VOID*)gc->sProgram.hUniFlexContext);
 
 #if defined(DEBUG)
@@ -1825,51 +1831,21 @@ IMG_INTERNAL IMG_VOID SetupBuildFFTNLShaderConstants(GLES1Context *gc)
 
 
 /***********************************************************************************
- Function Name      : CompileFFGenUniFlexCode
+ Function Name      : GetFFGenValidShaderOutputs
  Inputs             : gc, psFFTNLProgram
- Outputs            : 
+ Outputs            : pui32ValidShaderOutputs
  Returns            : 
- Description        : Compiles USC FFGen code
+ Description        : Works out which shader outputs the USC must write
 ************************************************************************************/
-static IMG_BOOL CompileFFGenUniFlexCode(GLES1Context *gc, FFGenProgram *psFFTNLProgram)
+static IMG_VOID GetFFGenValidShaderOutputs(GLES1Context *gc, FFGenProgram *psFFTNLProgram, IMG_UINT32 *pui32ValidShaderOutputs)
 {
-	FFGEN_PROGRAM_DETAILS *psFFGENProgramDetails;
-	UNIFLEX_PROGRAM_PARAMETERS sProgramParameters;
-	IMG_UINT32 ui32Error;
-	SGX_CORE_INFO sTarget;
-	UNIFLEX_HW sUniFlexHW={0};
-	UNIFLEX_CONSTDEF sConstants;
-	UNIFLEX_INST *psUniFlexInstruction;
-	UNIFLEX_RANGE sConstsRanges[20];
-	IMG_UINT32 ui32NumSecAttribs, ui32NumMemConsts, i;
 	FFGenRegList *psRegList;
+	IMG_UINT32 i;
 
-	GLES1MemSet(&sProgramParameters, 0, sizeof(UNIFLEX_PROGRAM_PARAMETERS));
-
-	sTarget.eID = SGX_CORE_ID;
-
-#if defined(SGX_CORE_REV)
-	sTarget.uiRev = SGX_CORE_REV;
-#else
-	sTarget.uiRev = 0;		/* use head revision */
-#endif
-
-	psFFGENProgramDetails = psFFTNLProgram->psFFGENProgramDetails;
-
-	sProgramParameters.eShaderType					= USC_SHADERTYPE_VERTEX;
-	sProgramParameters.uInRegisterConstantOffset	= GLES1_VERTEX_SECATTR_NUM_RESERVED;
-	sProgramParameters.uInRegisterConstantLimit		= PVR_MAX_VS_SECONDARIES - GLES1_VERTEX_SECATTR_NUM_RESERVED;
-
-	sProgramParameters.uIndexableTempBase			= 1;
-	sProgramParameters.psIndexableTempArraySizes	= IMG_NULL;
-	sProgramParameters.uPackDestType				= USEASM_REGTYPE_OUTPUT;
-	sProgramParameters.uNumAvailableTemporaries		= 96;
-	sProgramParameters.sTarget						= sTarget;
-	sProgramParameters.puValidShaderOutputs[0]		= 0xFFFFFFFF;
-	sProgramParameters.puValidShaderOutputs[1]		= 0xFFFFFFFF;
-	sProgramParameters.puValidShaderOutputs[2]		= 0xFFFFFFFF;
-	sProgramParameters.puValidShaderOutputs[3]		= 0xFFFFFFFF;
-
+	pui32ValidShaderOutputs[0] = 0xFFFFFFFF;
+	pui32ValidShaderOutputs[1] = 0xFFFFFFFF;
+	pui32ValidShaderOutputs[2] = 0xFFFFFFFF;
+	pui32ValidShaderOutputs[3] = 0xFFFFFFFF;
 
 	psRegList = psFFTNLProgram->psOutputsList;
 
@@ -1897,13 +1873,87 @@ static IMG_BOOL CompileFFGenUniFlexCode(GLES1Context *gc, FFGenProgram *psFFTNLP
 					}
 #endif
 
-					sProgramParameters.puValidShaderOutputs[ui32OutputIndex] &= ~(1 << ui32OutputBit);
+					pui32ValidShaderOutputs[ui32OutputIndex] &= ~(1 << ui32OutputBit);
 				}
 				ui32TexCoordOffset += psFFTNLProgram->auOutputTexDimensions[gc->ui32TexImageUnitsEnabled[i]]; 
 			}
 		}
 		psRegList = psRegList->psNext;
 	}
+}
+
+
+/***********************************************************************************
+ Function Name      : FreeFFGenUniFlexInstructions
+ Inputs             : psFFTNLProgram
+ Outputs            : psFFTNLProgram->psUniFlexInst
+ Returns            : 
+ Description        : Frees the UniFlex input of a FFGen program
+************************************************************************************/
+static IMG_VOID FreeFFGenUniFlexInstructions(FFGenProgram *psFFTNLProgram)
+{
+	UNIFLEX_INST *psUniFlexInstruction;
+
+	psUniFlexInstruction = psFFTNLProgram->psUniFlexInst;
+
+	while(psUniFlexInstruction)
+	{
+		UNIFLEX_INST *psInstructionToFree;
+
+		psInstructionToFree  = psUniFlexInstruction;
+		psUniFlexInstruction = psUniFlexInstruction->psILink;
+
+		GLES1Free(IMG_NULL, psInstructionToFree);
+	}
+
+	psFFTNLProgram->psUniFlexInst = IMG_NULL;
+}
+
+
+/***********************************************************************************
+ Function Name      : CompileFFGenUniFlexCode
+ Inputs             : gc, psFFTNLProgram, pui32ValidShaderOutputs
+ Outputs            : 
+ Returns            : 
+ Description        : Compiles USC FFGen code
+************************************************************************************/
+static IMG_BOOL CompileFFGenUniFlexCode(GLES1Context *gc, FFGenProgram *psFFTNLProgram, const IMG_UINT32 *pui32ValidShaderOutputs)
+{
+	FFGEN_PROGRAM_DETAILS *psFFGENProgramDetails;
+	UNIFLEX_PROGRAM_PARAMETERS sProgramParameters;
+	IMG_UINT32 ui32Error;
+	SGX_CORE_INFO sTarget;
+	UNIFLEX_HW sUniFlexHW={0};
+	UNIFLEX_CONSTDEF sConstants;
+	UNIFLEX_RANGE sConstsRanges[20];
+	IMG_UINT32 ui32NumSecAttribs, ui32NumMemConsts, i;
+	FFGenRegList *psRegList;
+
+	GLES1MemSet(&sProgramParameters, 0, sizeof(UNIFLEX_PROGRAM_PARAMETERS));
+
+	sTarget.eID = SGX_CORE_ID;
+
+#if defined(SGX_CORE_REV)
+	sTarget.uiRev = SGX_CORE_REV;
+#else
+	sTarget.uiRev = 0;		/* use head revision */
+#endif
+
+	psFFGENProgramDetails = psFFTNLProgram->psFFGENProgramDetails;
+
+	sProgramParameters.eShaderType					= USC_SHADERTYPE_VERTEX;
+	sProgramParameters.uInRegisterConstantOffset	= GLES1_VERTEX_SECATTR_NUM_RESERVED;
+	sProgramParameters.uInRegisterConstantLimit		= PVR_MAX_VS_SECONDARIES - GLES1_VERTEX_SECATTR_NUM_RESERVED;
+
+	sProgramParameters.uIndexableTempBase			= 1;
+	sProgramParameters.psIndexableTempArraySizes	= IMG_NULL;
+	sProgramParameters.uPackDestType				= USEASM_REGTYPE_OUTPUT;
+	sProgramParameters.uNumAvailableTemporaries		= 96;
+	sProgramParameters.sTarget						= sTarget;
+	sProgramParameters.puValidShaderOutputs[0]		= pui32ValidShaderOutputs[0];
+	sProgramParameters.puValidShaderOutputs[1]		= pui32ValidShaderOutputs[1];
+	sProgramParameters.puValidShaderOutputs[2]		= pui32ValidShaderOutputs[2];
+	sProgramParameters.puValidShaderOutputs[3]		= pui32ValidShaderOutputs[3];
 
 	sProgramParameters.uFlags = UF_GLSL |
 								UF_DONTRESETMOEAFTERPROGRAM |
@@ -2000,19 +2050,7 @@ static IMG_BOOL CompileFFGenUniFlexCode(GLES1Context *gc, FFGenProgram *psFFTNLP
 	}
 #endif /* defined(DEBUG) */
 
-	psUniFlexInstruction = psFFTNLProgram->psUniFlexInst;
-
-	while(psUniFlexInstruction)
-	{
-		UNIFLEX_INST *psInstructionToFree;
-
-		psInstructionToFree  = psUniFlexInstruction;
-		psUniFlexInstruction = psUniFlexInstruction->psILink;
-
-		GLES1Free(IMG_NULL, psInstructionToFree);
-	}
-
-	psFFTNLProgram->psUniFlexInst = IMG_NULL;
+	FreeFFGenUniFlexInstructions(psFFTNLProgram);
 
 	if(ui32Error != UF_OK)
 	{
@@ -2685,6 +2723,10 @@ IMG_INTERNAL IMG_VOID SetupBuildFFTNLShaderConstants(GLES1Context *gc)
 static GLES1_MEMERROR SetupFFTNLShaderCode(GLES1Context *gc, GLES1Shader *psShader, HashValue tFFTNLHashValue, FFTNLGenDesc *psFFTNLGenDesc)
 {
 	FFGenProgram *psFFTNLProgram;
+#if defined(FFGEN_UNIFLEX)
+	IMG_UINT32 aui32CacheKey[GLES1_FFTNL_CACHE_KEY_DWORDS];
+	HashValue tCacheKeyHash;
+#endif /* defined(FFGEN_UNIFLEX) */
 
 
 	/* Create a new entry */
@@ -2703,19 +2745,36 @@ static GLES1_MEMERROR SetupFFTNLShaderCode(GLES1Context *gc, GLES1Shader *psShad
 
 #if defined(FFGEN_UNIFLEX)
 
+	/* Key the persistent cache on everything the USC compile depends on */
+	GLES1MemCopy(aui32CacheKey, psFFTNLGenDesc, sizeof(FFTNLGenDesc));
 
-	GLES1_TIME_START(GLES1_TIMER_USC_TIME);
+	GetFFGenValidShaderOutputs(gc, psFFTNLProgram, &aui32CacheKey[GLES1_FFTNL_CACHE_DESC_DWORDS]);
 
-	if(!CompileFFGenUniFlexCode(gc, psFFTNLProgram))
-	{
-		GLES1_TIME_STOP(GLES1_TIMER_USC_TIME);
+	FFTNLCacheLogKey(gc, aui32CacheKey);
 
-		FFGenFreeProgram((IMG_VOID *)gc->sProgram.hFFTNLGenContext, psFFTNLProgram);
+	tCacheKeyHash = HashFunc(aui32CacheKey, GLES1_FFTNL_CACHE_KEY_DWORDS, STATEHASH_INIT_VALUE);
 
-		return GLES1_HOST_MEM_ERROR;
+	if(FFTNLCacheRestoreProgram(gc, tCacheKeyHash, aui32CacheKey, psFFTNLProgram))
+	{
+		FreeFFGenUniFlexInstructions(psFFTNLProgram);
 	}
+	else
+	{
+		GLES1_TIME_START(GLES1_TIMER_USC_TIME);
+
+		if(!CompileFFGenUniFlexCode(gc, psFFTNLProgram, &aui32CacheKey[GLES1_FFTNL_CACHE_DESC_DWORDS]))
+		{
+			GLES1_TIME_STOP(GLES1_TIMER_USC_TIME);
+
+			FFGenFreeProgram((IMG_VOID *)gc->sProgram.hFFTNLGenContext, psFFTNLProgram);
+
+			return GLES1_HOST_MEM_ERROR;
+		}
+
+		GLES1_TIME_STOP(GLES1_TIMER_USC_TIME);
 
-	GLES1_TIME_STOP(GLES1_TIMER_USC_TIME);
+		FFTNLCacheStoreProgram(gc, tCacheKeyHash, aui32CacheKey, psFFTNLProgram);
+	}
 
 #endif /* defined(FFGEN_UNIFLEX) */
 
@@ -417,6 +417,7 @@ IMG_INTERNAL IMG_VOID OutputMetrics(GLES1Context *gc)
 		PVR_TRACE((" PDS Variant hit/miss totals"));
 		PVR_TRACE((" PDSPixelShaderProgram - variant hit     %10d", gc->asTimes[GLES1_TIMER_PDSVARIANT_HIT_COUNT].ui32Count));
 		PVR_TRACE((" PDSPixelShaderProgram - variant miss    %10d", gc->asTimes[GLES1_TIMER_PDSVARIANT_MISS_COUNT].ui32Count));
+		PVR_TRACE((" PDSPixelShaderProgram - miss patched    %10d", gc->asTimes[GLES1_TIMER_PDSVARIANT_PATCH_COUNT].ui32Count));
 
 		PVR_TRACE((" "));
 
@@ -515,6 +516,11 @@ IMG_INTERNAL IMG_VOID OutputMetrics(GLES1Context *gc)
 				PVR_TRACE(("  USC time                     %10d/%10.4f", gc->asTimes[GLES1_TIMER_USC_TIME].ui32Count, gc->asTimes[GLES1_TIMER_USC_TIME].ui32Total*gc->fCPUSpeed/gc->asTimes[GLES1_TIMER_USC_TIME].ui32Count));
 			}
 
+			if(gc->asTimes[GLES1_TIMER_FFTNL_CACHE_HIT_COUNT].ui32Total || gc->asTimes[GLES1_TIMER_FFTNL_CACHE_MISS_COUNT].ui32Total)
+			{
+				PVR_TRACE(("  Program cache hits/misses    %10d/%10d", gc->asTimes[GLES1_TIMER_FFTNL_CACHE_HIT_COUNT].ui32Total, gc->asTimes[GLES1_TIMER_FFTNL_CACHE_MISS_COUNT].ui32Total));
+			}
+
 			PVR_TRACE((" "));
 		}
 
@@ -246,6 +246,8 @@ IMG_VOID GetFrameTime(GLES1Context *gc);
 #define GLES1_TIMER_SETUP_FRAGMENTSHADER_TIME			68
 #define GLES1_TIMER_FFGEN_GENERATION_TIME				69
 #define GLES1_TIMER_USC_TIME							70
+#define GLES1_TIMER_FFTNL_CACHE_HIT_COUNT				71
+#define GLES1_TIMER_FFTNL_CACHE_MISS_COUNT				72
 
 #else /* (METRICS_GROUP_ENABLED & GLES1_METRICS_GROUP_VALIDATESTATE)  */
 
@@ -261,6 +263,8 @@ IMG_VOID GetFrameTime(GLES1Context *gc);
 #define GLES1_TIMER_SETUP_FRAGMENTSHADER_TIME			0
 #define GLES1_TIMER_FFGEN_GENERATION_TIME				0
 #define GLES1_TIMER_USC_TIME							0
+#define GLES1_TIMER_FFTNL_CACHE_HIT_COUNT				0
+#define GLES1_TIMER_FFTNL_CACHE_MISS_COUNT				0
 
 #endif /* (METRICS_GROUP_ENABLED & GLES1_METRICS_GROUP_VALIDATESTATE)  */
 
@@ -270,11 +274,13 @@ IMG_VOID GetFrameTime(GLES1Context *gc);
 
 #define GLES1_TIMER_PDSVARIANT_HIT_COUNT				80
 #define GLES1_TIMER_PDSVARIANT_MISS_COUNT				81
+#define GLES1_TIMER_PDSVARIANT_PATCH_COUNT				82
 
 #else /* (METRICS_GROUP_ENABLED & GLES1_METRICS_GROUP_PDSVARIANT) */
 
 #define GLES1_TIMER_PDSVARIANT_HIT_COUNT				0
 #define GLES1_TIMER_PDSVARIANT_MISS_COUNT				0
+#define GLES1_TIMER_PDSVARIANT_PATCH_COUNT				0
 
 #endif /* (METRICS_GROUP_ENABLED & GLES1_METRICS_GROUP_PDSVARIANT) */
 
@@ -712,6 +712,7 @@ IMG_INTERNAL IMG_VOID SetErrorFileLine(GLES1Context *gc, GLenum code, const IMG_
 IMG_INTERNAL IMG_BOOL GetApplicationHints(GLESAppHints *psAppHints, EGLcontextMode *psMode)
 {
 	IMG_UINT32 ui32Default;
+	IMG_CHAR szDefault[1];
 	IMG_VOID* pvHintState;
 	IMG_BOOL bDisableHWTQ = IMG_FALSE;
 
@@ -869,6 +870,14 @@ IMG_INTERNAL IMG_BOOL GetApplicationHints(GLESAppHints *psAppHints, EGLcontextMo
 	ui32Default = 0;
 	PVRSRVGetAppHint(pvHintState, "MaxDrawCallsPerCore", IMG_UINT_TYPE, &ui32Default, &psAppHints->ui32MaxDrawCallsPerCore);
 
+	/* Empty string disables the persistent FFTNL program cache */
+	szDefault[0] = '\0';
+	PVRSRVGetAppHint(pvHintState, "FFTNLCacheFile", IMG_STRING_TYPE, &szDefault, psAppHints->szFFTNLCacheFile);
+
+	/* Empty string disables logging the keys of generated FFTNL programs */
+	szDefault[0] = '\0';
+	PVRSRVGetAppHint(pvHintState, "FFTNLStateLog", IMG_STRING_TYPE, &szDefault, psAppHints->szFFTNLStateLog);
+
 	PVRSRVFreeAppHintState(IMG_OPENGLES1, pvHintState);
 
 	return IMG_TRUE;
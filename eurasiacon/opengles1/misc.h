@@ -99,6 +99,8 @@ typedef struct GLESAppHintsRec
 	IMG_BOOL bDisableAsyncTextureOp;
 	IMG_UINT32 ui32PrimitiveSplitThreshold;
 	IMG_UINT32 ui32MaxDrawCallsPerCore;
+	IMG_CHAR szFFTNLCacheFile[APPHINT_MAX_STRING_SIZE];
+	IMG_CHAR szFFTNLStateLog[APPHINT_MAX_STRING_SIZE];
 } GLESAppHints;
 
 IMG_BOOL GetApplicationHints(GLESAppHints *psAppHints, EGLcontextMode *psMode);
@@ -133,6 +133,11 @@ static IMG_VOID DestroyUSEShaderVariant(GLES1Context *gc, GLES1ShaderVariant *ps
 		psPDSVariant = psPDSVariantNext;
 	}
 
+	if(psUSEVariant->psPDSTemplate)
+	{
+		GLES1Free(IMG_NULL, psUSEVariant->psPDSTemplate);
+	}
+
 	GLES1Free(IMG_NULL, psUSEVariant);
 }
 
@@ -67,6 +67,22 @@ typedef struct GLES1PDSInfo_TAG
 } GLES1PDSInfo;
 
 
+/* The first PDS pixel program generated for a fragment USE variant. The FPU iterators
+   are fixed per USE variant, so its other PDS variants are made by patching a copy of
+   this one with their texture and USE task control words.
+*/
+typedef struct GLES1PDSPixelTemplate_TAG
+{
+	PDS_PIXEL_SHADER_PROGRAM_INFO sProgramInfo;
+
+	IMG_UINT32 ui32ProgramSizeInDWords;
+
+	/* Follows the structure in the same allocation */
+	IMG_UINT32 *pui32Program;
+
+} GLES1PDSPixelTemplate;
+
+
 struct GLES1USEShaderVariant_TAG
 {
 	/* USSE code variants are frame resources */
@@ -137,6 +153,9 @@ struct GLES1USEShaderVariant_TAG
 	GLES1PDSCodeVariant		  *psPDSVariant;
 	GLES1PDSVertexCodeVariant *psPDSVertexCodeVariant;
 
+	/* Program patched to build the PDS variants (only for fragment shaders) */
+	GLES1PDSPixelTemplate	  *psPDSTemplate;
+
 	struct GLES1USEShaderVariant_TAG	*psNext;
 };
 
@@ -239,6 +258,13 @@ typedef struct GLES1ProgramMachineRec
 
 #if defined(FFGEN_UNIFLEX)
 	IMG_HANDLE hUniFlexContext;
+
+	/* Persistent cache of compiled FFTNL programs and log of their keys (see fftnlcache.c) */
+	HashTable sFFTNLCacheHashTable;
+	IMG_BOOL bFFTNLCacheEnabled;
+	IMG_BOOL bFFTNLCacheDirty;
+	IMG_BOOL bFFTNLCacheStored;
+	IMG_VOID *pvFFTNLStateLog;
 #endif /* defined(FFGEN_UNIFLEX) */
 
 
@@ -3167,6 +3167,54 @@ bad_op:
 }
 
 
+/***********************************************************************************
+ Function Name      : TwiddleSubTexture
+ Inputs             : gc, psTex, ui32Face, ui32Lod, psMipLevel, ui32XOffset, ui32YOffset,
+					  ui32Width, ui32Height, pvPixels, ui32SrcRowSize, pfnCopyTextureData
+ Outputs            : psTex
+ Returns            : Whether the subtexture was written
+ Description        : Converts subtexture data and twiddles it straight into a loaded
+					  level of a twiddled texture. Returns IMG_FALSE, leaving the
+					  level alone, if the texture cannot be written this way or
+					  there is no memory to convert the data.
+************************************************************************************/
+static IMG_BOOL TwiddleSubTexture(GLES1Context *gc, GLESTexture *psTex, IMG_UINT32 ui32Face, IMG_UINT32 ui32Lod,
+								  GLESMipMapLevel *psMipLevel, IMG_UINT32 ui32XOffset, IMG_UINT32 ui32YOffset,
+								  IMG_UINT32 ui32Width, IMG_UINT32 ui32Height, const IMG_VOID *pvPixels,
+								  IMG_UINT32 ui32SrcRowSize, PFNCopyTextureData pfnCopyTextureData)
+{
+	GLESSubTextureInfo sSubTexInfo;
+	IMG_BOOL bWritten;
+
+	if(!CanTwiddleSubTexture(psTex, psMipLevel))
+	{
+		return IMG_FALSE;
+	}
+
+	sSubTexInfo.ui32SubTexXoffset = ui32XOffset;
+	sSubTexInfo.ui32SubTexYoffset = ui32YOffset;
+	sSubTexInfo.ui32SubTexWidth   = ui32Width;
+	sSubTexInfo.ui32SubTexHeight  = ui32Height;
+
+	/* Only the CPU reads the converted data, so keep it in cached memory */
+	sSubTexInfo.pui8SubTexBuffer = (IMG_UINT8 *)GLES1Malloc(gc, ui32Width * ui32Height * psMipLevel->psTexFormat->ui32TotalBytesPerTexel);
+
+	if(!sSubTexInfo.pui8SubTexBuffer)
+	{
+		return IMG_FALSE;
+	}
+
+	(*pfnCopyTextureData)(sSubTexInfo.pui8SubTexBuffer, pvPixels, ui32Width, ui32Height,
+						  ui32SrcRowSize, psMipLevel, IMG_FALSE);
+
+	bWritten = TwiddleSubTextureData(gc, psTex, ui32Face, ui32Lod, &sSubTexInfo);
+
+	GLES1Free(gc, sSubTexInfo.pui8SubTexBuffer);
+
+	return bWritten;
+}
+
+
 /***********************************************************************************
  Function Name      : glTexSubImage2D
  Inputs             : target, level, xoffset, yoffset, width, height, format, type, 
@@ -3189,6 +3237,7 @@ GL_API void GL_APIENTRY glTexSubImage2D(GLenum target, GLint level, GLint xoffse
 	GLESMipMapLevel *psMipLevel;
 	
 	IMG_BOOL bHWSubTextureUploaded = IMG_FALSE;
+	IMG_BOOL bSWSubTextureUploaded = IMG_FALSE;
 
 
 	__GLES1_GET_CONTEXT();
@@ -3573,7 +3622,10 @@ bad_op:
 	    GLES1_ASSERT(psTex->psEGLImageTarget->ui32Width==psMipLevel->ui32Width && psTex->psEGLImageTarget->ui32Height==psMipLevel->ui32Height);
 		GLES1_ASSERT(psMipLevel->pui8Buffer==GLES1_LOADED_LEVEL)
 
-		if(psTex->psEGLImageTarget->bTwiddled)
+		/* Twiddle the subtexture straight into the image if possible, otherwise read it back and translate it again */
+		if(psTex->psEGLImageTarget->bTwiddled &&
+		   !TwiddleSubTexture(gc, psTex, 0, 0, psMipLevel, (IMG_UINT32)xoffset, (IMG_UINT32)yoffset,
+							  (IMG_UINT32)width, (IMG_UINT32)height, pui8Src, ui32SrcRowSize, pfnCopyTextureData))
 		{
 		    IMG_UINT32 ui32BufferSize;
 
@@ -3610,7 +3662,7 @@ bad_op:
 
 			PVRSRVUnlockMutex(gc->psSharedState->hTertiaryLock);
 		}
-		else
+		else if(!psTex->psEGLImageTarget->bTwiddled)
 		{
 			ui32DstStride = psTex->psEGLImageTarget->ui32Stride;
 
@@ -3701,9 +3753,10 @@ bad_op:
 	else
 	{
 	    /* directly upload subtexture data into the device memory
-		   if the host copy of the whole level texture has already been uploaded to the device memory */
+		   if the host copy of the whole level texture has already been uploaded to the device memory,
+		   with the HWTQ or by twiddling it into place */
 
-	    if(!gc->sAppHints.bDisableHWTQTextureUpload)
+	    if(!gc->sAppHints.bDisableHWTQTextureUpload || CanTwiddleSubTexture(psTex, psMipLevel))
 		{
 			PVRSRV_CLIENT_MEM_INFO sMemInfo  = {0};
 			GLESTextureParamState  *psParams = &psTex->sState;
@@ -3762,6 +3815,7 @@ bad_op:
 			}
 
 			/* HWUpload Step 2: directly upload subtexture data to the new device memory, using hardware */
+			if(!gc->sAppHints.bDisableHWTQTextureUpload)
 			{
 				IMG_UINT32 ui32SubTexBufferSize;
 				IMG_UINT8 *pui8SubTexBuffer;
@@ -3847,12 +3901,35 @@ bad_op:
 					
 				GLES1FreeAsync(gc, pui8SubTexBuffer);
 			}
+
+			/* or twiddle it into the new device memory in software */
+			if(!bHWSubTextureUploaded)
+			{
+				const IMG_UINT8 *pui8Src = (const IMG_UINT8 *)pixels;
+				IMG_UINT32 ui32Align = gc->sState.sClientPixel.ui32UnpackAlignment;
+				IMG_UINT32 ui32SrcRowSize = (IMG_UINT32)width * ui32SrcBytesPerPixel;
+				IMG_UINT32 ui32Padding = ui32SrcRowSize % ui32Align;
+
+				if(ui32Padding)
+				{
+					ui32SrcRowSize += (ui32Align - ui32Padding);
+				}
+
+				if(TwiddleSubTexture(gc, psTex, ui32Face, ui32Lod, psMipLevel, (IMG_UINT32)xoffset, (IMG_UINT32)yoffset,
+									 (IMG_UINT32)width, (IMG_UINT32)height, pui8Src, ui32SrcRowSize, pfnCopyTextureData))
+				{
+					bSWSubTextureUploaded = IMG_TRUE;
+
+					/* Reset bResidence, to prevent going into TextureMakeResident() */
+					psTex->bResidence = IMG_TRUE;
+				}
+			}
 		}
 
 
 		/* otherwise, use the software subtexture uploading:
 		   readback the whole level texture data and copy subtexture data to the host memory. */
-        if(!bHWSubTextureUploaded)
+        if(!bHWSubTextureUploaded && !bSWSubTextureUploaded)
 		{
 			const IMG_UINT8 *pui8Src = (const IMG_UINT8 *)pixels;
 			IMG_UINT32 ui32Align = gc->sState.sClientPixel.ui32UnpackAlignment;
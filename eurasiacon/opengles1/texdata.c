@@ -2007,6 +2007,154 @@ IMG_INTERNAL IMG_VOID ReadBackTextureData(GLES1Context *gc, GLESTexture *psTex,
 }
 
 
+/***********************************************************************************
+ Function Name      : CanTwiddleSubTexture
+ Inputs             : psTex, psMipLevel
+ Outputs            : -
+ Returns            : Whether TwiddleSubTextureData can write rectangles of the level
+ Description        : True for uncompressed twiddled textures whose texel size has a
+					  sub-twiddle function.
+************************************************************************************/
+IMG_INTERNAL IMG_BOOL CanTwiddleSubTexture(const GLESTexture *psTex, const GLESMipMapLevel *psMipLevel)
+{
+	switch(psTex->sState.ui32StateWord1 & ~EURASIA_PDS_DOUTT1_TEXTYPE_CLRMSK)
+	{
+#if defined(SGX_FEATURE_TAG_POT_TWIDDLE) || defined(SGX_FEATURE_HYBRID_TWIDDLING)
+		case EURASIA_PDS_DOUTT1_TEXTYPE_2D:
+		case EURASIA_PDS_DOUTT1_TEXTYPE_CEM:
+#else
+		case EURASIA_PDS_DOUTT1_TEXTYPE_ARB_2D:
+		case EURASIA_PDS_DOUTT1_TEXTYPE_ARB_CEM:
+#endif
+		{
+			break;
+		}
+		default:
+		{
+			return IMG_FALSE;
+		}
+	}
+
+	if((psTex->ui32HWFlags & GLES1_COMPRESSED) || !psTex->pfnSubTwiddleData)
+	{
+		return IMG_FALSE;
+	}
+
+#if !defined(SGX_FEATURE_HYBRID_TWIDDLING)
+	/* Only power-of-two levels are twiddled */
+	if((psMipLevel->ui32Width & (psMipLevel->ui32Width - 1)) || (psMipLevel->ui32Height & (psMipLevel->ui32Height - 1)))
+	{
+		return IMG_FALSE;
+	}
+#else
+	PVR_UNREFERENCED_PARAMETER(psMipLevel);
+#endif
+
+	return IMG_TRUE;
+}
+
+
+/***********************************************************************************
+ Function Name      : TwiddleSubTextureData
+ Inputs             : gc, psTex, ui32Face, ui32Lod, psSubTexInfo
+ Outputs            : psTex
+ Returns            : Whether the rectangle was written
+ Description        : Twiddles a rectangle of texels, already in the texture's format
+					  and packed in psSubTexInfo->pui8SubTexBuffer, straight into a
+					  loaded level. Only the texels of the rectangle are written, so
+					  the level is neither read back nor translated again.
+************************************************************************************/
+IMG_INTERNAL IMG_BOOL TwiddleSubTextureData(GLES1Context *gc, GLESTexture *psTex, IMG_UINT32 ui32Face, 
+											IMG_UINT32 ui32Lod, const GLESSubTextureInfo *psSubTexInfo)
+{
+	GLESMipMapLevel          *psMipLevel;
+	GLESTextureParamState    *psParams = &psTex->sState;
+	PVRSRV_CLIENT_SYNC_INFO   *psDstSyncInfo;
+	IMG_UINT32                ui32TopUsize, ui32TopVsize, ui32BytesPerTexel, ui32OffsetInBytes;
+	IMG_UINT8                 *pui8Dest;
+
+	psMipLevel = &psTex->psMipLevel[ui32Lod + (ui32Face * GLES1_MAX_TEXTURE_MIPMAP_LEVELS)];
+
+	if(!CanTwiddleSubTexture(psTex, psMipLevel))
+	{
+		return IMG_FALSE;
+	}
+
+#if defined(SGX_FEATURE_TAG_POT_TWIDDLE)
+	ui32TopUsize = 1U << ((psParams->ui32StateWord1 & ~EURASIA_PDS_DOUTT1_USIZE_CLRMSK) >> EURASIA_PDS_DOUTT1_USIZE_SHIFT);
+	ui32TopVsize = 1U << ((psParams->ui32StateWord1 & ~EURASIA_PDS_DOUTT1_VSIZE_CLRMSK) >> EURASIA_PDS_DOUTT1_VSIZE_SHIFT);
+#else
+	ui32TopUsize = 1 + ((psParams->ui32StateWord1 & ~EURASIA_PDS_DOUTT1_WIDTH_CLRMSK)  >> EURASIA_PDS_DOUTT1_WIDTH_SHIFT);
+	ui32TopVsize = 1 + ((psParams->ui32StateWord1 & ~EURASIA_PDS_DOUTT1_HEIGHT_CLRMSK) >> EURASIA_PDS_DOUTT1_HEIGHT_SHIFT);
+#endif
+
+	ui32BytesPerTexel = psTex->psFormat->ui32TotalBytesPerTexel;
+
+	ui32OffsetInBytes = ui32BytesPerTexel * GetMipMapOffset(ui32Lod, ui32TopUsize, ui32TopVsize);
+
+#if defined(GLES1_EXTENSION_TEX_CUBE_MAP)
+	if(psTex->ui32TextureTarget == GLES1_TEXTURE_TARGET_CEM)
+	{
+		IMG_UINT32 ui32FaceOffset = 
+			ui32BytesPerTexel * GetMipMapOffset(psTex->ui32NumLevels, ui32TopUsize, ui32TopVsize);
+		
+		if(psTex->ui32HWFlags & GLES1_MIPMAP)
+		{
+			if(((ui32BytesPerTexel == 1) && (ui32TopUsize > EURASIA_TAG_CUBEMAP_NO_ALIGN_SIZE_8BPP)) ||
+				(ui32TopUsize > EURASIA_TAG_CUBEMAP_NO_ALIGN_SIZE_16_32BPP))
+			{
+				ui32FaceOffset = ALIGNCOUNT(ui32FaceOffset, EURASIA_TAG_CUBEMAP_FACE_ALIGN);
+			}
+		}
+
+		ui32OffsetInBytes += (ui32FaceOffset * ui32Face);
+	}	
+#endif /* defined(GLES1_EXTENSION_TEX_CUBE_MAP) */
+
+#if defined(GLES1_EXTENSION_EGL_IMAGE)
+	if(psTex->psEGLImageTarget)
+	{
+		psDstSyncInfo = psTex->psEGLImageTarget->psMemInfo->psClientSyncInfo;
+		pui8Dest = (IMG_UINT8 *)psTex->psEGLImageTarget->pvLinSurfaceAddress;
+	}
+	else
+#endif /* defined(GLES1_EXTENSION_EGL_IMAGE) */
+	{
+		psDstSyncInfo = psTex->psMemInfo->psClientSyncInfo;
+		pui8Dest = (IMG_UINT8 *)psTex->psMemInfo->pvLinAddr + ui32OffsetInBytes;
+	}
+
+	/* Software operations and transfers queued on the texture may still write the level */
+	if(psDstSyncInfo)
+	{
+#if defined(PDUMP)
+		PVRSRVPDumpSyncPol(gc->ps3DDevData->psConnection, 
+							psDstSyncInfo,
+							IMG_FALSE,
+							psDstSyncInfo->psSyncData->ui32WriteOpsPending,
+							0xFFFFFFFF);
+#endif	/*defined (PDUMP)*/
+
+		/* TwiddleSubTextureData: waiting for texture upload */
+		while (SGX2DQueryBlitsComplete(&gc->psSysContext->s3D, psDstSyncInfo, IMG_TRUE) != PVRSRV_OK)
+		{
+		}
+	}
+
+	psTex->pfnSubTwiddleData(pui8Dest, psSubTexInfo->pui8SubTexBuffer, 
+							 psMipLevel->ui32Width, psMipLevel->ui32Height,
+							 psSubTexInfo->ui32SubTexXoffset, psSubTexInfo->ui32SubTexYoffset,
+							 psSubTexInfo->ui32SubTexWidth, psSubTexInfo->ui32SubTexHeight,
+							 psSubTexInfo->ui32SubTexWidth);
+
+#if defined(PDUMP)
+	psTex->ui32LevelsToDump |= (1UL << ui32Lod);
+#endif
+
+	return IMG_TRUE;
+}
+
+
 /***********************************************************************************
  Function Name      : SetupTwiddleFns
  Inputs             : psTex
@@ -2023,6 +2171,7 @@ IMG_INTERNAL IMG_VOID SetupTwiddleFns(GLESTexture *psTex)
 		{
 			psTex->pfnTextureTwiddle = DeTwiddleAddress8bpp;
 			psTex->pfnReadBackData   = ReadBackTwiddle8bpp;
+			psTex->pfnSubTwiddleData = DeTwiddleSubRect8bpp;
 
 			break;
 		}
@@ -2030,17 +2179,20 @@ IMG_INTERNAL IMG_VOID SetupTwiddleFns(GLESTexture *psTex)
 		{
 			psTex->pfnTextureTwiddle = DeTwiddleAddress16bpp;
 			psTex->pfnReadBackData   = ReadBackTwiddle16bpp;
+			psTex->pfnSubTwiddleData = DeTwiddleSubRect16bpp;
 			break;
 		}
 		case 4:
 		{
 			psTex->pfnTextureTwiddle = DeTwiddleAddress32bpp;
 			psTex->pfnReadBackData   = ReadBackTwiddle32bpp;
+			psTex->pfnSubTwiddleData = DeTwiddleSubRect32bpp;
 			break;
 		}
 		default:
 		{
 			/* May get here for PVRTC - shouldn't use these fn pointers anyway */
+			psTex->pfnSubTwiddleData = IMG_NULL;
 			break;
 		}
 	}
@@ -140,7 +140,7 @@ typedef struct GLESMipMapLevelRec
 
 
 /* 
-** Sub texture info used for HWTQ functions.
+** Sub texture info used for HWTQ and sub-twiddle functions.
 */
 typedef struct GLESSubTextureInfoRec
 {
@@ -432,6 +432,13 @@ struct GLESTextureRec
 								  IMG_UINT32 ui32Width, IMG_UINT32 ui32Height,
 								  IMG_UINT32 ui32StrideIn);
 
+	/* Twiddles a rectangle into a level in place; IMG_NULL if the texel size has none */
+	IMG_VOID (*pfnSubTwiddleData)(IMG_VOID *pvDest, const IMG_VOID *pvSrc,
+								  IMG_UINT32 ui32Width, IMG_UINT32 ui32Height,
+								  IMG_UINT32 ui32XOffset, IMG_UINT32 ui32YOffset,
+								  IMG_UINT32 ui32SubWidth, IMG_UINT32 ui32SubHeight,
+								  IMG_UINT32 ui32StrideIn);
+
 #if defined(PDUMP)
 	/* The i-th bit marks whether the i-th mipmap level must be dumped.
 	 * In a C.E.M. it marks the i-th level of every face.
@@ -548,6 +555,9 @@ IMG_UINT8 * TextureCreateLevel(GLES1Context *gc, GLESTexture *psTex, IMG_UINT32
 							   IMG_UINT32 ui32Width, IMG_UINT32 ui32Height);
 
 IMG_VOID ReadBackTextureData(GLES1Context *gc, GLESTexture *psTex, IMG_UINT32 ui32Face, IMG_UINT32 ui32Lod, IMG_VOID *pvBuffer);
+IMG_BOOL CanTwiddleSubTexture(const GLESTexture *psTex, const GLESMipMapLevel *psMipLevel);
+IMG_BOOL TwiddleSubTextureData(GLES1Context *gc, GLESTexture *psTex, IMG_UINT32 ui32Face, IMG_UINT32 ui32Lod,
+							   const GLESSubTextureInfo *psSubTexInfo);
 IMG_VOID TextureRemoveResident(GLES1Context *gc, GLESTexture *psTex);
 IMG_VOID SetupTexNameArray(GLES1NamesArray *psNamesArray);
 IMG_VOID SetupTwiddleFns(GLESTexture *psTex);
@@ -362,7 +362,7 @@ IMG_INTERNAL GLES1_MEMERROR OutputTerminateState(GLES1Context *gc,
 
 
 		/* Dummy vertex secondary program */
-		pui32Buffer = PDSGeneratePixelShaderSAProgram(&sSAProgram, pui32BufferBase);
+		pui32Buffer = PDSGeneratePixelShaderSAProgram(&sSAProgram, pui32BufferBase, IMG_NULL);
 
 		GLES1_ASSERT((IMG_UINT32)(pui32Buffer - pui32BufferBase) <= PDS_TERMINATE_SAUPDATE_DWORDS);
 
@@ -820,6 +820,7 @@ static GLES1_MEMERROR WritePDSPixelShaderProgram(GLES1Context *gc, IMG_BOOL *pbC
 	GLES1Shader *psShader = gc->sProgram.psCurrentFragmentShader;
 	GLES1ShaderVariant *psFragmentVariant = gc->sProgram.psCurrentFragmentVariant;
 	GLES1PDSCodeVariant *psPDSVariant;
+	GLES1PDSPixelTemplate *psPDSTemplate;
 	GLES1PDSInfo *psPDSInfo;
 	GLESShaderTextureState *psShaderTextureState = &gc->sPrim.sTextureState;
 	PDS_TEXTURE_IMAGE_UNIT *psTextureImageUnit = &psShaderTextureState->asTextureImageUnits[0];
@@ -1155,11 +1156,62 @@ static GLES1_MEMERROR WritePDSPixelShaderProgram(GLES1Context *gc, IMG_BOOL *pbC
 		}
 	
 		/*
-			Generate the PDS pixel state program
+			Patch a copy of the first PDS pixel state program generated for this USE variant, or generate it
 		*/
-		pui32Buffer = PDSGeneratePixelShaderProgram(psTextureImageUnit,
-													&sProgram,
-													pui32BufferBase);
+		psPDSTemplate = psFragmentVariant->psPDSTemplate;
+
+		if(psPDSTemplate && 
+		   (psPDSTemplate->ui32ProgramSizeInDWords <= ui32PDSProgramSize))
+		{
+			GLES1MemCopy(pui32BufferBase, psPDSTemplate->pui32Program, psPDSTemplate->ui32ProgramSizeInDWords << 2);
+
+			if(PDSPatchPixelShaderProgram(&psPDSTemplate->sProgramInfo,
+										  psTextureImageUnit,
+										  &sProgram,
+										  pui32BufferBase))
+			{
+				pui32Buffer = pui32BufferBase + psPDSTemplate->ui32ProgramSizeInDWords;
+
+				GLES1_INC_COUNT(GLES1_TIMER_PDSVARIANT_PATCH_COUNT, 1);
+			}
+			else
+			{
+				pui32Buffer = IMG_NULL;
+			}
+		}
+		else
+		{
+			pui32Buffer = IMG_NULL;
+		}
+
+		if(!pui32Buffer)
+		{
+			PDS_PIXEL_SHADER_PROGRAM_INFO sProgramInfo;
+
+			pui32Buffer = PDSGeneratePixelShaderProgram(psTextureImageUnit,
+														&sProgram,
+														pui32BufferBase,
+														&sProgramInfo);
+
+			/* Failing to keep the program is not an error - the next miss will generate it again */
+			if(!psPDSTemplate)
+			{
+				IMG_UINT32 ui32ProgramSizeInDWords = (IMG_UINT32)(pui32Buffer - pui32BufferBase);
+
+				psPDSTemplate = GLES1Malloc(gc, sizeof(GLES1PDSPixelTemplate) + (ui32ProgramSizeInDWords << 2));
+
+				if(psPDSTemplate)
+				{
+					GLES1MemCopy(&psPDSTemplate->sProgramInfo, &sProgramInfo, sizeof(PDS_PIXEL_SHADER_PROGRAM_INFO));
+					psPDSTemplate->ui32ProgramSizeInDWords = ui32ProgramSizeInDWords;
+					psPDSTemplate->pui32Program = (IMG_UINT32 *)(psPDSTemplate + 1);
+
+					GLES1MemCopy(psPDSTemplate->pui32Program, pui32BufferBase, ui32ProgramSizeInDWords << 2);
+
+					psFragmentVariant->psPDSTemplate = psPDSTemplate;
+				}
+			}
+		}
 
 		if(psPDSVariant)
 		{
@@ -3049,7 +3101,7 @@ static GLES1_MEMERROR WritePDSUSEShaderSAProgram(GLES1Context *gc, IMG_UINT32 ui
 	/*
 		Generate the PDS pixel state program
 	*/
-	pui32Buffer = (IMG_UINT32 *)PDSGeneratePixelShaderSAProgram(&sProgram, pui32BufferBase);
+	pui32Buffer = (IMG_UINT32 *)PDSGeneratePixelShaderSAProgram(&sProgram, pui32BufferBase, IMG_NULL);
 
 	/* 
 	   Update buffer position 
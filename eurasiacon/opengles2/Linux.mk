@@ -62,7 +62,7 @@ opengles2_src = \
 
 opengles2_obj := \
  $(call target-intermediates-of,dmscalc,dmscalc.o) \
- $(call target-intermediates-of,common,buffers.o codeheap.o kickresource.o twiddle.o) \
+ $(call target-intermediates-of,common,buffers.o codeheap.o kickresource.o twiddle.o workpool.o) \
  $(call target-intermediates-of,pixfmts,sgxpixfmts.o) \
  $(call target-intermediates-of,pixevent,pixevent.o pixeventpbesetup.o) \
  $(call target-intermediates-of,pdsogles,pds.o) \
@@ -152,7 +152,7 @@ IMG_INTERNAL IMG_BOOL InitAccumUSECodeBlocks(GLES2Context *gc)
 	
 	pui32BufferBase = gc->sPrim.psDummyPixelSecondaryPDSCode->pui32LinAddress;
 	
-	pui32Buffer = PDSGeneratePixelShaderSAProgram(&sProgram, pui32BufferBase); /* PRQA S 3199 */ /* pui32Buffer is used in the following GLES_ASSERT. */
+	pui32Buffer = PDSGeneratePixelShaderSAProgram(&sProgram, pui32BufferBase, IMG_NULL); /* PRQA S 3199 */ /* pui32Buffer is used in the following GLES_ASSERT. */
 
 	GLES_ASSERT((IMG_UINT32)(pui32Buffer - pui32BufferBase) == ui32PDSProgramSizeInDWords);
 
@@ -930,7 +930,8 @@ IMG_INTERNAL GLES2_MEMERROR SetupBGObject(GLES2Context *gc, IMG_BOOL bIsAccumula
 	*/
 	pui32Buffer = PDSGeneratePixelShaderProgram(&sTextureImageUnit,
 												&sProgram,
-												pui32BufferBase);
+												pui32BufferBase,
+												IMG_NULL);
 
 	/* 
 	   Update Buffer Position 
@@ -1400,6 +1400,549 @@ static SGXBS_Error UnpackProgramBinary(GLES2SharedShaderState **ppsVertexState,
 	return SGXBS_NO_ERROR;
 }
 
+/*
+ * Sections of a binary in the Program Binary Format version 2.
+ */
+typedef struct SGXBS_V2ReaderTAG
+{
+	SGXBS_V2Section     asSections[SGXBS_V2_NUM_SECTION_TYPES];
+	IMG_BOOL            abPresent[SGXBS_V2_NUM_SECTION_TYPES];
+	IMG_BOOL            abHashChecked[SGXBS_V2_NUM_SECTION_TYPES];
+
+} SGXBS_V2Reader;
+
+
+/***********************************************************************************
+ Function Name      : GetSectionV2
+ Inputs             : psReader    - Sections of the binary.
+                      u32Type     - Type of the section wanted.
+                      psBuffer    - Buffer that stores the data.
+ Outputs            : ppu8Data    - Start of the section data.
+                      pu32Length  - Length of the section in bytes.
+ Returns            : SGXBS_NO_ERROR if successfull. Some other value otherwise.
+ Description        : Looks up a section of a format 2 binary. The hash of a section is
+                      only checked the first time the section is used.
+************************************************************************************/
+static SGXBS_Error GetSectionV2(SGXBS_V2Reader *psReader, IMG_UINT32 u32Type, SGXBS_Buffer *psBuffer,
+								const IMG_UINT8 **ppu8Data, IMG_UINT32 *pu32Length)
+{
+	const SGXBS_V2Section *psSection = &psReader->asSections[u32Type];
+	SGXBS_Hash             sComputedHash;
+
+	if(!psReader->abPresent[u32Type])
+	{
+		PVR_DPF((PVR_DBG_WARNING,"GetSectionV2: Section %u is missing. Corrupt binary!", u32Type));
+		return SGXBS_CORRUPT_BINARY_ERROR;
+	}
+
+	if(!psReader->abHashChecked[u32Type])
+	{
+		sComputedHash = SGXBS_ComputeHash(&psBuffer->pu8Buffer[psSection->u32Offset], psSection->u32LengthInBytes);
+
+		if(sComputedHash.u32Hash != psSection->u32Hash)
+		{
+			PVR_DPF((PVR_DBG_WARNING,"GetSectionV2: The hash of section %u is wrong. Corrupt binary!", u32Type));
+			return SGXBS_CORRUPT_BINARY_ERROR;
+		}
+
+		psReader->abHashChecked[u32Type] = IMG_TRUE;
+	}
+
+	*ppu8Data   = &psBuffer->pu8Buffer[psSection->u32Offset];
+	*pu32Length = psSection->u32LengthInBytes;
+
+	return SGXBS_NO_ERROR;
+}
+
+
+/***********************************************************************************
+ Function Name      : GetUniPatchInputV2
+ Inputs             : pu8UseCode       - USE code section.
+                      u32UseCodeLength - Length of the USE code section.
+                      u32Offset, u32Length - Location of the UniPatch input in the section.
+ Outputs            : -
+ Returns            : The UniPatch input, or IMG_NULL if its location is invalid.
+ Description        : Checks that a UniPatch input lies inside the USE code section and that
+                      its size matches the size in its header.
+************************************************************************************/
+static const IMG_UINT8 *GetUniPatchInputV2(const IMG_UINT8 *pu8UseCode, IMG_UINT32 u32UseCodeLength,
+										   IMG_UINT32 u32Offset, IMG_UINT32 u32Length)
+{
+	USP_PC_SHADER sHeader;
+
+	if((u32Length < sizeof(USP_PC_SHADER)) || (u32Length > u32UseCodeLength) ||
+	   (u32Offset > u32UseCodeLength - u32Length) || (u32Offset & 3))
+	{
+		return IMG_NULL;
+	}
+
+	memcpy(&sHeader, &pu8UseCode[u32Offset], sizeof(USP_PC_SHADER));
+
+	if(sHeader.uSize != u32Length - sizeof(USP_PC_SHADER))
+	{
+		return IMG_NULL;
+	}
+
+	return &pu8UseCode[u32Offset];
+}
+
+
+/***********************************************************************************
+ Function Name      : UnpackSharedShaderStateV2
+ Inputs             : psReader    - Sections of the binary.
+                      u32InfoSection - SGXBS_V2_SECTION_VERTEX_INFO or SGXBS_V2_SECTION_FRAGMENT_INFO.
+                      bExpectingVertexShader - IMG_TRUE if a vertex shader is being read.
+                      pvUniPatchContext - Context for UniPatch.
+                      psBuffer    - Buffer that stores the data.
+ Outputs            : ppsSharedState  - Shared shader state.
+ Returns            : SGXBS_NO_ERROR if successfull. Some other value otherwise.
+ Description        : Creates a shared shader state from a format 2 binary. The symbols, names,
+                      constants and the MSAA UniPatch input are copied into a single block and
+                      the pointers between them are fixed up; the main UniPatch input is used
+                      where it is. The MSAA UniPatch shader is only created when first used.
+************************************************************************************/
+static SGXBS_Error UnpackSharedShaderStateV2(SGXBS_V2Reader *psReader, IMG_UINT32 u32InfoSection, IMG_BOOL bExpectingVertexShader,
+											 IMG_VOID *pvUniPatchContext, SGXBS_Buffer *psBuffer, GLES2SharedShaderState **ppsSharedState)
+{
+	SGXBS_Error             eError;
+	GLES2SharedShaderState  *psSharedState;
+	SGXBS_V2ShaderInfo      sInfo;
+	SGXBS_V2Symbol          sRecord;
+	GLSLBindingSymbol       *psSymbols = IMG_NULL, *psSymbol;
+	const IMG_UINT8         *pu8Data, *pu8UseCode, *pu8UniPatchInput, *pu8MSAATransInput = IMG_NULL;
+	const IMG_UINT8         *pu8Constants = IMG_NULL, *pu8Records = IMG_NULL, *pu8Strings = IMG_NULL;
+	IMG_UINT8               *pu8Block, *pu8Next;
+	IMG_UINT32              u32Length, u32UseCodeLength, u32StringsLength = 0, u32BlockSize, i;
+
+	/*
+	 * 1- Shader info. Check that the shader type (vertex/fragment) matches.
+	 */
+	eError = GetSectionV2(psReader, u32InfoSection, psBuffer, &pu8Data, &u32Length);
+
+	if(eError != SGXBS_NO_ERROR)
+	{
+		return eError;
+	}
+
+	if(u32Length < SGXBS_V2ShaderInfo_size)
+	{
+		return SGXBS_CORRUPT_BINARY_ERROR;
+	}
+
+	memcpy(&sInfo, pu8Data, SGXBS_V2ShaderInfo_size);
+
+	if(((sInfo.u32ProgramType != GLSLPT_VERTEX) || !bExpectingVertexShader) &&
+	   ((sInfo.u32ProgramType != GLSLPT_FRAGMENT) || bExpectingVertexShader))
+	{
+		return SGXBS_INVALID_ARGUMENTS_ERROR;
+	}
+
+	if((sInfo.u32NumSymbols > sInfo.u32NumSymbolRecords) || (sInfo.u32NumSymbolRecords > SGXBS_V2_MAX_ELEMENTS) ||
+	   (sInfo.u32NumConstants > SGXBS_V2_MAX_ELEMENTS))
+	{
+		return SGXBS_CORRUPT_BINARY_ERROR;
+	}
+
+	/*
+	 * 2- Locate the UniPatch inputs
+	 */
+	eError = GetSectionV2(psReader, SGXBS_V2_SECTION_USE_CODE, psBuffer, &pu8UseCode, &u32UseCodeLength);
+
+	if(eError != SGXBS_NO_ERROR)
+	{
+		return eError;
+	}
+
+	pu8UniPatchInput = GetUniPatchInputV2(pu8UseCode, u32UseCodeLength, sInfo.u32UniPatchOffset, sInfo.u32UniPatchLength);
+
+	if(!pu8UniPatchInput)
+	{
+		PVR_DPF((PVR_DBG_ERROR,"UnpackSharedShaderStateV2: The UniPatch input is outside the USE code section. Corrupt binary!"));
+		return SGXBS_CORRUPT_BINARY_ERROR;
+	}
+
+	if(!bExpectingVertexShader && sInfo.u32UniPatchMSAATransLength)
+	{
+		pu8MSAATransInput = GetUniPatchInputV2(pu8UseCode, u32UseCodeLength, sInfo.u32UniPatchMSAATransOffset, sInfo.u32UniPatchMSAATransLength);
+
+		if(!pu8MSAATransInput)
+		{
+			PVR_DPF((PVR_DBG_ERROR,"UnpackSharedShaderStateV2: The MSAA UniPatch input is outside the USE code section. Corrupt binary!"));
+			return SGXBS_CORRUPT_BINARY_ERROR;
+		}
+	}
+
+	/*
+	 * 3- Locate the constants, symbols and names
+	 */
+	if(sInfo.u32NumConstants)
+	{
+		eError = GetSectionV2(psReader, SGXBS_V2_SECTION_CONSTANTS, psBuffer, &pu8Constants, &u32Length);
+
+		if(eError != SGXBS_NO_ERROR)
+		{
+			return eError;
+		}
+
+		if(sInfo.u32FirstConstant > u32Length / sizeof(IMG_FLOAT) - sInfo.u32NumConstants ||
+		   sInfo.u32NumConstants > u32Length / sizeof(IMG_FLOAT))
+		{
+			return SGXBS_CORRUPT_BINARY_ERROR;
+		}
+
+		pu8Constants += sInfo.u32FirstConstant * sizeof(IMG_FLOAT);
+	}
+
+	if(sInfo.u32NumSymbolRecords)
+	{
+		eError = GetSectionV2(psReader, SGXBS_V2_SECTION_SYMBOLS, psBuffer, &pu8Records, &u32Length);
+
+		if(eError != SGXBS_NO_ERROR)
+		{
+			return eError;
+		}
+
+		if(sInfo.u32NumSymbolRecords > u32Length / SGXBS_V2Symbol_size ||
+		   sInfo.u32FirstSymbol > u32Length / SGXBS_V2Symbol_size - sInfo.u32NumSymbolRecords)
+		{
+			return SGXBS_CORRUPT_BINARY_ERROR;
+		}
+
+		pu8Records += sInfo.u32FirstSymbol * SGXBS_V2Symbol_size;
+
+		eError = GetSectionV2(psReader, SGXBS_V2_SECTION_STRINGS, psBuffer, &pu8Strings, &u32StringsLength);
+
+		if(eError != SGXBS_NO_ERROR)
+		{
+			return eError;
+		}
+
+		/* A zero at the end of the pool guarantees that every name is terminated */
+		if(!u32StringsLength || pu8Strings[u32StringsLength - 1])
+		{
+			return SGXBS_CORRUPT_BINARY_ERROR;
+		}
+	}
+
+	/*
+	 * 4- Allocate the shared state and the block that holds its data
+	 */
+	psSharedState = SGXBS_Calloc(sizeof(GLES2SharedShaderState), psBuffer);
+
+	if(!psSharedState)
+	{
+		return SGXBS_OUT_OF_MEMORY_ERROR;
+	}
+
+	*ppsSharedState = psSharedState;
+
+	psSharedState->ui32RefCount = 1;
+
+	u32BlockSize = sInfo.u32NumSymbolRecords * sizeof(GLSLBindingSymbol) +
+				   sInfo.u32NumConstants * sizeof(IMG_FLOAT) +
+				   SGXBS_V2_ALIGN(sInfo.u32UniPatchMSAATransLength, 4) * (pu8MSAATransInput ? 1 : 0) +
+				   u32StringsLength;
+
+	pu8Block = SGXBS_Calloc(u32BlockSize, psBuffer);
+
+	if(u32BlockSize && !pu8Block)
+	{
+		return SGXBS_OUT_OF_MEMORY_ERROR;
+	}
+
+	psSharedState->pvBinaryData = pu8Block;
+	pu8Next = pu8Block;
+
+	if(sInfo.u32NumSymbolRecords)
+	{
+		psSymbols = (GLSLBindingSymbol *)pu8Next;
+		pu8Next  += sInfo.u32NumSymbolRecords * sizeof(GLSLBindingSymbol);
+	}
+
+	if(sInfo.u32NumConstants)
+	{
+		psSharedState->sBindingSymbolList.pfConstantData = (IMG_FLOAT *)pu8Next;
+		psSharedState->sBindingSymbolList.uNumCompsUsed  = sInfo.u32NumConstants;
+
+		memcpy(pu8Next, pu8Constants, sInfo.u32NumConstants * sizeof(IMG_FLOAT));
+		pu8Next += sInfo.u32NumConstants * sizeof(IMG_FLOAT);
+	}
+
+	if(pu8MSAATransInput)
+	{
+		psSharedState->pvUniPatchInputMSAATrans = pu8Next;
+
+		memcpy(pu8Next, pu8MSAATransInput, sInfo.u32UniPatchMSAATransLength);
+		pu8Next += SGXBS_V2_ALIGN(sInfo.u32UniPatchMSAATransLength, 4);
+	}
+
+	if(u32StringsLength)
+	{
+		memcpy(pu8Next, pu8Strings, u32StringsLength);
+		pu8Strings = pu8Next;
+	}
+
+	/*
+	 * 5- Expand the symbol records and fix up the names and the member lists
+	 */
+	for(i = 0; i < sInfo.u32NumSymbolRecords; i++)
+	{
+		memcpy(&sRecord, &pu8Records[i * SGXBS_V2Symbol_size], SGXBS_V2Symbol_size);
+
+		if(sRecord.u32NameOffset >= u32StringsLength)
+		{
+			return SGXBS_CORRUPT_BINARY_ERROR;
+		}
+
+		/* Members must come after their owner and after the top-level symbols, so there can't be a cycle */
+		if(sRecord.u32NumMembers &&
+		   ((sRecord.u32FirstMember <= i) || (sRecord.u32FirstMember < sInfo.u32NumSymbols) ||
+		    (sRecord.u32NumMembers > sInfo.u32NumSymbolRecords - sRecord.u32FirstMember)))
+		{
+			return SGXBS_CORRUPT_BINARY_ERROR;
+		}
+
+		psSymbol = &psSymbols[i];
+
+		psSymbol->pszName                         = (IMG_CHAR *)&pu8Strings[sRecord.u32NameOffset];
+		psSymbol->eBIVariableID                   = (GLSLBuiltInVariableID)sRecord.u16BIVariableID;	/* PRQA S 1482 */ /* Override enum warning. */
+		psSymbol->eTypeSpecifier                  = (GLSLTypeSpecifier)sRecord.u8TypeSpecifier;	/* PRQA S 1482 */ /* Override enum warning. */
+		psSymbol->eTypeQualifier                  = (GLSLTypeQualifier)sRecord.u8TypeQualifier;	/* PRQA S 1482 */ /* Override enum warning. */
+		psSymbol->ePrecisionQualifier             = (GLSLPrecisionQualifier)sRecord.u8PrecisionQualifier;	/* PRQA S 1482 */ /* Override enum warning. */
+		psSymbol->eVaryingModifierFlags           = (GLSLVaryingModifierFlags)sRecord.u8VaryingModifierFlags;	/* PRQA S 1482 */ /* Override enum warning. */
+		psSymbol->iActiveArraySize                = (IMG_INT32)sRecord.u16ActiveArraySize;
+		psSymbol->iDeclaredArraySize              = (IMG_INT32)sRecord.u16DeclaredArraySize;
+		psSymbol->sRegisterInfo.eRegType          = (GLSLHWRegType)sRecord.u8RegType;	/* PRQA S 1482 */ /* Override enum warning. */
+		psSymbol->sRegisterInfo.u.uBaseComp       = sRecord.u16BaseComp;
+		psSymbol->sRegisterInfo.uCompAllocCount   = sRecord.u8CompAllocCount;
+		psSymbol->sRegisterInfo.ui32CompUseMask   = sRecord.u16CompUseMask;
+		psSymbol->uNumBaseTypeMembers             = sRecord.u32NumMembers;
+		psSymbol->psBaseTypeMembers               = sRecord.u32NumMembers ? &psSymbols[sRecord.u32FirstMember] : IMG_NULL;
+	}
+
+	psSharedState->sBindingSymbolList.uNumBindings           = sInfo.u32NumSymbols;
+	psSharedState->sBindingSymbolList.psBindingSymbolEntries = sInfo.u32NumSymbols ? psSymbols : IMG_NULL;
+
+	/*
+	 * 6- Everything else
+	 */
+	psSharedState->eProgramFlags      = (GLSLProgramFlags)sInfo.u32ProgramFlags;	/* PRQA S 1482 */ /* Override enum warning. */
+	psSharedState->eActiveVaryingMask = (GLSLVaryingMask)sInfo.u32ActiveVaryingMask;	/* PRQA S 1482 */ /* Override enum warning. */
+
+	for(i = 0; i < SGXBS_NUM_TC_REGISTERS; ++i)
+	{
+		psSharedState->aui32TexCoordDims[i]    = sInfo.au8TexCoordDims[i];
+		psSharedState->aeTexCoordPrecisions[i] = (GLSLPrecisionQualifier)sInfo.au8TexCoordPrecisions[i];	/* PRQA S 1482 */ /* Override enum warning. */
+	}
+
+	/* Feed the UniPatch input into UniPatch straight from the binary. If it dislikes it, return an error */
+	psSharedState->pvUniPatchShader = PVRUniPatchCreateShader(pvUniPatchContext, (USP_PC_SHADER *)((IMG_UINTPTR_T)pu8UniPatchInput));
+
+	if(!psSharedState->pvUniPatchShader)
+	{
+		/* UniPatch didn't like the input. If it happens, there's a bug */
+		PVR_DPF((PVR_DBG_ERROR,"UnpackSharedShaderStateV2: UniPatch failed to create a shader"));
+		return SGXBS_INTERNAL_ERROR;
+	}
+
+	return SGXBS_NO_ERROR;
+}
+
+
+/***********************************************************************************
+ Function Name      : UnpackUserBindingsV2
+ Inputs             : psReader    - Sections of the binary.
+                      psBuffer    - Buffer that stores the data.
+ Outputs            : ppsUserBinding - GLSLAttribUserBinding output.
+ Returns            : SGXBS_NO_ERROR if successfull. Some other value otherwise.
+ Description        : Creates the attrib user binding list of a format 2 binary. The list
+                      is owned by the program object, which frees it node by node.
+************************************************************************************/
+static SGXBS_Error UnpackUserBindingsV2(SGXBS_V2Reader *psReader, SGXBS_Buffer *psBuffer, GLSLAttribUserBinding **ppsUserBinding)
+{
+	SGXBS_Error            eError;
+	SGXBS_V2UserBinding    sRecord;
+	GLSLAttribUserBinding  *psUserBinding, **ppsLink = ppsUserBinding;
+	const IMG_UINT8        *pu8Records, *pu8Strings = IMG_NULL;
+	IMG_UINT32             u32Length, u32StringsLength = 0, u32NameLength, i;
+
+	*ppsUserBinding = IMG_NULL;
+
+	eError = GetSectionV2(psReader, SGXBS_V2_SECTION_USER_BINDINGS, psBuffer, &pu8Records, &u32Length);
+
+	if(eError != SGXBS_NO_ERROR)
+	{
+		return eError;
+	}
+
+	if(u32Length % SGXBS_V2UserBinding_size)
+	{
+		return SGXBS_CORRUPT_BINARY_ERROR;
+	}
+
+	if(u32Length)
+	{
+		eError = GetSectionV2(psReader, SGXBS_V2_SECTION_STRINGS, psBuffer, &pu8Strings, &u32StringsLength);
+
+		if(eError != SGXBS_NO_ERROR)
+		{
+			return eError;
+		}
+
+		if(!u32StringsLength || pu8Strings[u32StringsLength - 1])
+		{
+			return SGXBS_CORRUPT_BINARY_ERROR;
+		}
+	}
+
+	for(i = 0; i < u32Length / SGXBS_V2UserBinding_size; i++)
+	{
+		memcpy(&sRecord, &pu8Records[i * SGXBS_V2UserBinding_size], SGXBS_V2UserBinding_size);
+
+		if(sRecord.u32NameOffset >= u32StringsLength)
+		{
+			return SGXBS_CORRUPT_BINARY_ERROR;
+		}
+
+		psUserBinding = SGXBS_Calloc(sizeof(GLSLAttribUserBinding), psBuffer);
+
+		if(!psUserBinding)
+		{
+			return SGXBS_OUT_OF_MEMORY_ERROR;
+		}
+
+		u32NameLength = strlen((const IMG_CHAR *)&pu8Strings[sRecord.u32NameOffset]) + 1;
+
+		psUserBinding->pszName = SGXBS_Calloc(u32NameLength, psBuffer);
+
+		if(!psUserBinding->pszName)
+		{
+			return SGXBS_OUT_OF_MEMORY_ERROR;
+		}
+
+		memcpy(psUserBinding->pszName, &pu8Strings[sRecord.u32NameOffset], u32NameLength);
+
+		psUserBinding->i32Index = sRecord.i32Index;
+
+		/* Keep the order the bindings were written in */
+		*ppsLink = psUserBinding;
+		ppsLink  = &psUserBinding->psNext;
+	}
+
+	return SGXBS_NO_ERROR;
+}
+
+
+/***********************************************************************************
+ Function Name      : UnpackProgramBinaryV2
+ Inputs             : pvUniPatchContext - Context for UniPatch.
+                      psBuffer    - Buffer that stores the data.
+ Outputs            : ppsVertexState, ppsFragmentState - Shared shader states.
+                      ppsUserBinding - GLSLAttribUserBinding output.
+ Returns            : SGXBS_NO_ERROR if successfull. Some other value otherwise.
+ Description        : Reads a program binary written in the Program Binary Format version 2
+                      (see esbinshaderinternal.h). Only the header and the section table are
+                      checked up front; each section is checked when it is first used.
+************************************************************************************/
+static SGXBS_Error UnpackProgramBinaryV2(GLES2SharedShaderState **ppsVertexState, GLES2SharedShaderState **ppsFragmentState, GLSLAttribUserBinding **ppsUserBinding,
+										 IMG_VOID *pvUniPatchContext, SGXBS_Buffer* psBuffer)
+{
+	SGXBS_Error      eError;
+	SGXBS_V2Reader   sReader;
+	SGXBS_V2Header   sHeader;
+	SGXBS_V2Section  sSection;
+	SGXBS_Hash       sComputedHash;
+	IMG_UINT32       u32ExpectedCore, u32ExpectedCoreRevision, u32TableEnd, i;
+
+	if(psBuffer->u32BufferSizeInBytes < SGXBS_V2Header_size)
+	{
+		return SGXBS_CORRUPT_BINARY_ERROR;
+	}
+
+	memcpy(&sHeader, psBuffer->pu8Buffer, SGXBS_V2Header_size);
+
+	if((sHeader.u32LengthInBytes > psBuffer->u32BufferSizeInBytes) ||
+	   !sHeader.u32NumSections || (sHeader.u32NumSections > SGXBS_V2_MAX_SECTIONS))
+	{
+		PVR_DPF((PVR_DBG_WARNING,"UnpackProgramBinaryV2: The header is inconsistent with the size of the binary. Corrupt binary!"));
+		return SGXBS_CORRUPT_BINARY_ERROR;
+	}
+
+	/* Anything after the length in the header (e.g. blob cache padding) is ignored */
+	psBuffer->u32BufferSizeInBytes = sHeader.u32LengthInBytes;
+
+	u32TableEnd = SGXBS_V2Header_size + sHeader.u32NumSections * SGXBS_V2Section_size;
+
+	if(u32TableEnd > psBuffer->u32BufferSizeInBytes)
+	{
+		return SGXBS_CORRUPT_BINARY_ERROR;
+	}
+
+	sComputedHash = SGXBS_ComputeHash(&psBuffer->pu8Buffer[2 * sizeof(IMG_UINT32)], u32TableEnd - 2 * sizeof(IMG_UINT32));
+
+	if(sComputedHash.u32Hash != sHeader.u32HeaderHash)
+	{
+		PVR_DPF((PVR_DBG_WARNING,"UnpackProgramBinaryV2: The hash in the binary header is wrong. Corrupt binary!"));
+		return SGXBS_CORRUPT_BINARY_ERROR;
+	}
+
+	/*
+	 * Check that the binary was made for this software and hardware version.
+	 */
+	GetCoreAndRevisionNumber(&u32ExpectedCore, &u32ExpectedCoreRevision);
+
+	if((sHeader.u16SoftwareVersion != SGXBS_SOFTWARE_VERSION_2) || sHeader.u16Reserved ||
+	   !SGXBS_ValidateHWRevision(sHeader.u16Core, sHeader.u16CoreRevision, u32ExpectedCore, u32ExpectedCoreRevision) ||
+	   (sHeader.u32CompiledGLSLVersion != GLSL_COMPILED_UNIFLEX_INTERFACE_VER) ||
+	   (sHeader.u32USPPCShaderVersion != USP_PC_SHADER_VER))
+	{
+		PVR_DPF((PVR_DBG_WARNING,"UnpackProgramBinaryV2: The binary doesn't match the current hardware and driver."));
+		return SGXBS_MISSING_REVISION_ERROR;
+	}
+
+	/*
+	 * Read the section table. Sections of unknown types are skipped.
+	 */
+	memset(&sReader, 0, sizeof(sReader));
+
+	for(i = 0; i < sHeader.u32NumSections; i++)
+	{
+		memcpy(&sSection, &psBuffer->pu8Buffer[SGXBS_V2Header_size + i * SGXBS_V2Section_size], SGXBS_V2Section_size);
+
+		if(sSection.u32Type >= SGXBS_V2_NUM_SECTION_TYPES)
+		{
+			continue;
+		}
+
+		if(sReader.abPresent[sSection.u32Type] ||
+		   (sSection.u32Offset < u32TableEnd) || (sSection.u32Offset & (SGXBS_V2_SECTION_ALIGNMENT - 1)) ||
+		   (sSection.u32LengthInBytes > psBuffer->u32BufferSizeInBytes) ||
+		   (sSection.u32Offset > psBuffer->u32BufferSizeInBytes - sSection.u32LengthInBytes))
+		{
+			PVR_DPF((PVR_DBG_WARNING,"UnpackProgramBinaryV2: Section %u is invalid. Corrupt binary!", sSection.u32Type));
+			return SGXBS_CORRUPT_BINARY_ERROR;
+		}
+
+		sReader.asSections[sSection.u32Type] = sSection;
+		sReader.abPresent[sSection.u32Type]  = IMG_TRUE;
+	}
+
+	eError = UnpackSharedShaderStateV2(&sReader, SGXBS_V2_SECTION_VERTEX_INFO, IMG_TRUE, pvUniPatchContext, psBuffer, ppsVertexState);
+
+	if(eError == SGXBS_NO_ERROR)
+	{
+		eError = UnpackSharedShaderStateV2(&sReader, SGXBS_V2_SECTION_FRAGMENT_INFO, IMG_FALSE, pvUniPatchContext, psBuffer, ppsFragmentState);
+
+		if(eError == SGXBS_NO_ERROR)
+		{
+			eError = UnpackUserBindingsV2(&sReader, psBuffer, ppsUserBinding);
+		}
+	}
+
+	return eError;
+}
+
+
 /* ------------------------------------------------------------------------------------------- */
 /* --------------------------------------- ENTRY POINTS  ------------------------------------- */
 /* ------------------------------------------------------------------------------------------- */
@@ -1481,18 +2024,24 @@ IMG_INTERNAL SGXBS_Error SGXBS_CreateProgramState(GLES2Context *gc, const IMG_VO
 {
 	SGXBS_Buffer          sBuffer;
 	SGXBS_Error           eError;
+	IMG_UINT32            u32Magic;
 
 	if(!SGXBS_TestBinaryShaderInterface())
 	{
 		return SGXBS_INTERNAL_ERROR;
 	}
 
-	if(!pvBinaryProgram || !ppsVertexState || !ppsFragmentState)
+	if(!pvBinaryProgram || !ppsVertexState || !ppsFragmentState || !ppsUserBinding)
 	{
 		/* Null arguments */
 		return SGXBS_INVALID_ARGUMENTS_ERROR;
 	}
 
+	/* Every failure leaves the outputs NULL */
+	*ppsVertexState   = IMG_NULL;
+	*ppsFragmentState = IMG_NULL;
+	*ppsUserBinding   = IMG_NULL;
+
 	if(i32BinaryShaderLengthInBytes < SGXBS_MINIMUM_VALID_BINARY_SIZE)
 	{
 		PVR_DPF((PVR_DBG_ERROR,"SGXBS_CreateSharedShaderState: The size of the shader is invalid. Corrupt binary!"));
@@ -1514,8 +2063,18 @@ IMG_INTERNAL SGXBS_Error SGXBS_CreateProgramState(GLES2Context *gc, const IMG_VO
 		return SGXBS_OUT_OF_MEMORY_ERROR;
 	}
 
-	/* Unpack the shader and return it */
-	eError = UnpackProgramBinary(ppsVertexState, ppsFragmentState, ppsUserBinding, pvUniPatchContext, &sBuffer);
+	/* The magic number of format 2 is stored in native byte order */
+	memcpy(&u32Magic, pvBinaryProgram, sizeof(IMG_UINT32));
+
+	/* Unpack the program and return it */
+	if(u32Magic == SGXBS_HEADER_MAGIC_NUMBER_V2)
+	{
+		eError = UnpackProgramBinaryV2(ppsVertexState, ppsFragmentState, ppsUserBinding, pvUniPatchContext, &sBuffer);
+	}
+	else
+	{
+		eError = UnpackProgramBinary(ppsVertexState, ppsFragmentState, ppsUserBinding, pvUniPatchContext, &sBuffer);
+	}
 
 	if(eError != SGXBS_NO_ERROR)
 	{
@@ -1547,6 +2106,11 @@ IMG_INTERNAL SGXBS_Error SGXBS_CreateProgramState(GLES2Context *gc, const IMG_VO
 		}
 
 		SGXBS_FreeAllocatedMemory(&sBuffer);
+
+		/* The states and the bindings were in the memory that was just freed */
+		*ppsVertexState   = IMG_NULL;
+		*ppsFragmentState = IMG_NULL;
+		*ppsUserBinding   = IMG_NULL;
 	}
 
 	/* Free the memory used by the buffer */
@@ -49,7 +49,7 @@ IMG_INTERNAL IMG_BOOL CreateBufObjState(GLES2Context *gc)
  Inputs             : gc
  Outputs            : -
  Returns            : -
- Description        : Unbinds all buffer objects.
+ Description        : Writes staged buffer updates and unbinds all buffer objects.
 					  If no other contexts are sharing the names array, will delete 
 					  this also.
 ************************************************************************************/
@@ -57,6 +57,23 @@ IMG_INTERNAL IMG_VOID FreeBufObjState(GLES2Context *gc)
 {
 	IMG_UINT32 i;
 
+	/* Other contexts may still draw with the buffers */
+	FlushStagedBufferUpdates(gc);
+
+	if(gc->sBufferObject.pui8StagingData)
+	{
+		GLES2Free(IMG_NULL, gc->sBufferObject.pui8StagingData);
+
+		gc->sBufferObject.pui8StagingData = IMG_NULL;
+	}
+
+	if(gc->sBufferObject.pui8MapStagingCache)
+	{
+		GLES2Free(IMG_NULL, gc->sBufferObject.pui8MapStagingCache);
+
+		gc->sBufferObject.pui8MapStagingCache = IMG_NULL;
+	}
+
 	/* unbind all the buffer objects */
 	for (i=0; i < GLES2_NUM_BUFOBJ_BINDINGS; i++) 
 	{
@@ -123,19 +140,366 @@ IMG_INTERNAL IMG_VOID ReclaimBufferObjectMemKRM(IMG_VOID *pvContext, KRMResource
 }	
 
 
+/***********************************************************************************
+ Function Name      : GetBufferObjectMemPoolBucket
+ Inputs             : uAllocSize
+ Outputs            : -
+ Returns            : Bucket index
+ Description        : Returns the pool bucket of storage of the given size.
+************************************************************************************/
+static IMG_UINT32 GetBufferObjectMemPoolBucket(IMG_UINT32 uAllocSize)
+{
+	IMG_UINT32 ui32Bucket = 0;
+
+	uAllocSize >>= (GLES2_BUFOBJ_MEM_POOL_MIN_LOG2 + 1);
+
+	while(uAllocSize && (ui32Bucket < GLES2_BUFOBJ_MEM_POOL_BUCKETS - 1))
+	{
+		uAllocSize >>= 1;
+		ui32Bucket++;
+	}
+
+	return ui32Bucket;
+}
+
+
+/***********************************************************************************
+ Function Name      : BufferObjectMemFits
+ Inputs             : uMemSize, ui32MemAlign, uAllocSize, ui32AllocAlign
+ Outputs            : -
+ Returns            : Whether existing storage can be used for an allocation
+ Description        : Checks that storage is large and aligned enough for an allocation,
+					  without wasting more than 1/GLES2_BUFOBJ_MEM_POOL_MAX_WASTE of it.
+************************************************************************************/
+static IMG_BOOL BufferObjectMemFits(IMG_UINT32 uMemSize, IMG_UINT32 ui32MemAlign,
+									IMG_UINT32 uAllocSize, IMG_UINT32 ui32AllocAlign)
+{
+	if((uMemSize < uAllocSize) || (uMemSize - uAllocSize > uAllocSize / GLES2_BUFOBJ_MEM_POOL_MAX_WASTE))
+	{
+		return IMG_FALSE;
+	}
+
+	return ((ui32MemAlign % ui32AllocAlign) == 0) ? IMG_TRUE : IMG_FALSE;
+}
+
+
+/***********************************************************************************
+ Function Name      : RemoveMemPoolEntry
+ Inputs             : psMemPool, ui32Bucket, psEntry
+ Outputs            : -
+ Returns            : -
+ Description        : Unlinks an entry from its pool bucket. The caller holds the
+					  secondary lock, or is destroying the share group.
+************************************************************************************/
+static IMG_VOID RemoveMemPoolEntry(GLES2BufferObjectMemPool *psMemPool, IMG_UINT32 ui32Bucket,
+								   GLES2BufferObjectMemPoolEntry *psEntry)
+{
+	if(psEntry->psNewer)
+	{
+		psEntry->psNewer->psOlder = psEntry->psOlder;
+	}
+	else
+	{
+		psMemPool->apsNewest[ui32Bucket] = psEntry->psOlder;
+	}
+
+	if(psEntry->psOlder)
+	{
+		psEntry->psOlder->psNewer = psEntry->psNewer;
+	}
+	else
+	{
+		psMemPool->apsOldest[ui32Bucket] = psEntry->psNewer;
+	}
+
+	psMemPool->ui32NumEntries--;
+	psMemPool->ui32Bytes -= psEntry->psMemInfo->uAllocSize;
+}
+
+
+/***********************************************************************************
+ Function Name      : EvictMemPoolEntries
+ Inputs             : psMemPool, ui32MaxBytes
+ Outputs            : -
+ Returns            : The evicted entries, linked through psOlder
+ Description        : Removes the entries retired longest ago until the pool holds no
+					  more than ui32MaxBytes. The caller holds the secondary lock, or is
+					  destroying the share group, and frees the entries.
+************************************************************************************/
+static GLES2BufferObjectMemPoolEntry *EvictMemPoolEntries(GLES2BufferObjectMemPool *psMemPool, IMG_UINT32 ui32MaxBytes)
+{
+	GLES2BufferObjectMemPoolEntry *psEvicted = IMG_NULL;
+
+	while(psMemPool->ui32Bytes > ui32MaxBytes)
+	{
+		GLES2BufferObjectMemPoolEntry *psOldest = IMG_NULL;
+		IMG_UINT32 ui32OldestBucket = 0, i;
+
+		/* Buckets are kept in retirement order, so the oldest entry is at one of their ends */
+		for(i = 0; i < GLES2_BUFOBJ_MEM_POOL_BUCKETS; i++)
+		{
+			GLES2BufferObjectMemPoolEntry *psEntry = psMemPool->apsOldest[i];
+
+			if(psEntry &&
+			   (!psOldest ||
+			    ((psMemPool->ui32Serial - psEntry->ui32Serial) > (psMemPool->ui32Serial - psOldest->ui32Serial))))
+			{
+				psOldest = psEntry;
+				ui32OldestBucket = i;
+			}
+		}
+
+		if(!psOldest)
+		{
+			break;
+		}
+
+		RemoveMemPoolEntry(psMemPool, ui32OldestBucket, psOldest);
+
+		psOldest->psOlder = psEvicted;
+		psEvicted = psOldest;
+
+		psMemPool->ui32Evictions++;
+	}
+
+	return psEvicted;
+}
+
+
+/***********************************************************************************
+ Function Name      : FreeMemPoolEntries
+ Inputs             : gc, psEntry
+ Outputs            : -
+ Returns            : -
+ Description        : Frees a list of evicted pool entries and their storage.
+************************************************************************************/
+static IMG_VOID FreeMemPoolEntries(GLES2Context *gc, GLES2BufferObjectMemPoolEntry *psEntry)
+{
+	while(psEntry)
+	{
+		GLES2BufferObjectMemPoolEntry *psNext = psEntry->psOlder;
+
+		GLES2FREEDEVICEMEM_HEAP(gc, psEntry->psMemInfo);
+
+		GLES2Free(IMG_NULL, psEntry);
+
+		GLES2_INC_COUNT(GLES2_TIMER_BUFOBJ_POOL_EVICT_COUNT, 1);
+
+		psEntry = psNext;
+	}
+}
+
+
+/***********************************************************************************
+ Function Name      : TrimBufferObjectMemPool
+ Inputs             : gc, ui32MaxBytes
+ Outputs            : -
+ Returns            : -
+ Description        : Frees the retired buffer storage of the share group until no
+					  more than ui32MaxBytes are left.
+************************************************************************************/
+IMG_INTERNAL IMG_VOID TrimBufferObjectMemPool(GLES2Context *gc, IMG_UINT32 ui32MaxBytes)
+{
+	GLES2BufferObjectMemPoolEntry *psEvicted;
+
+	PVRSRVLockMutex(gc->psSharedState->hSecondaryLock);
+
+	psEvicted = EvictMemPoolEntries(&gc->psSharedState->sBufferObjectMemPool, ui32MaxBytes);
+
+	PVRSRVUnlockMutex(gc->psSharedState->hSecondaryLock);
+
+	FreeMemPoolEntries(gc, psEvicted);
+}
+
+
+/***********************************************************************************
+ Function Name      : AllocBufferObjectMem
+ Inputs             : gc, uAllocSize, ui32AllocAlign
+ Outputs            : ppsMemInfo
+ Returns            : Success
+ Description        : Takes buffer storage for the given size and alignment from the
+					  shared pool of retired storage, or allocates it. If allocation
+					  fails, frees the retired storage and tries again.
+************************************************************************************/
+static IMG_BOOL AllocBufferObjectMem(GLES2Context *gc, IMG_UINT32 uAllocSize, IMG_UINT32 ui32AllocAlign,
+									 PVRSRV_CLIENT_MEM_INFO **ppsMemInfo)
+{
+	GLES2BufferObjectMemPool *psMemPool = &gc->psSharedState->sBufferObjectMemPool;
+	IMG_UINT32 ui32Bucket = GetBufferObjectMemPoolBucket(uAllocSize);
+	IMG_UINT32 ui32LastBucket = MIN(ui32Bucket + 1, GLES2_BUFOBJ_MEM_POOL_BUCKETS - 1);
+	PVRSRV_ERROR eError = PVRSRV_OK;
+	IMG_UINT32 i;
+
+	PVRSRVLockMutex(gc->psSharedState->hSecondaryLock);
+
+	/* Storage up to 1/GLES2_BUFOBJ_MEM_POOL_MAX_WASTE larger may be in the next bucket */
+	for(; ui32Bucket <= ui32LastBucket; ui32Bucket++)
+	{
+		GLES2BufferObjectMemPoolEntry *psEntry;
+
+		for(psEntry = psMemPool->apsNewest[ui32Bucket]; psEntry; psEntry = psEntry->psOlder)
+		{
+			if(BufferObjectMemFits(psEntry->psMemInfo->uAllocSize, psEntry->ui32AllocAlign, uAllocSize, ui32AllocAlign))
+			{
+				RemoveMemPoolEntry(psMemPool, ui32Bucket, psEntry);
+
+				psMemPool->ui32Hits++;
+
+				PVRSRVUnlockMutex(gc->psSharedState->hSecondaryLock);
+
+				*ppsMemInfo = psEntry->psMemInfo;
+
+				GLES2Free(IMG_NULL, psEntry);
+
+				GLES2_INC_COUNT(GLES2_TIMER_BUFOBJ_POOL_HIT_COUNT, 1);
+
+				return IMG_TRUE;
+			}
+		}
+	}
+
+	psMemPool->ui32Misses++;
+
+	PVRSRVUnlockMutex(gc->psSharedState->hSecondaryLock);
+
+	GLES2_INC_COUNT(GLES2_TIMER_BUFOBJ_POOL_MISS_COUNT, 1);
+
+	for(i = 0; i < 2; i++)
+	{
+		if(i)
+		{
+			PVR_DPF((PVR_DBG_WARNING,"AllocBufferObjectMem: Freeing retired buffer storage"));
+
+			/* Finished ghosts return their storage to the pool, which is then emptied */
+			KRM_DestroyUnneededGhosts(gc, &gc->psSharedState->sBufferObjectKRM);
+
+			TrimBufferObjectMemPool(gc, 0);
+		}
+
+		eError = GLES2ALLOCDEVICEMEM_HEAP(gc,
+			PVRSRV_MEM_READ | PVRSRV_MAP_GC_MMU,		/* Read only (by device) */
+			uAllocSize,
+			ui32AllocAlign,
+			ppsMemInfo);
+
+		if (eError != PVRSRV_OK)
+		{
+			eError = GLES2ALLOCDEVICEMEM_HEAP(gc,
+				PVRSRV_MEM_READ,							/* Read only (by device) */
+				uAllocSize,
+				ui32AllocAlign,
+				ppsMemInfo);
+		}
+
+		if (eError == PVRSRV_OK)
+		{
+			return IMG_TRUE;
+		}
+	}
+
+	*ppsMemInfo = IMG_NULL;
+
+	return IMG_FALSE;
+}
+
+
+/***********************************************************************************
+ Function Name      : ReleaseBufferObjectMem
+ Inputs             : gc, psMemInfo, ui32AllocAlign
+ Outputs            : -
+ Returns            : -
+ Description        : Returns buffer storage nothing uses any more to the shared pool,
+					  freeing the oldest storage in the pool if it grows too large.
+************************************************************************************/
+static IMG_VOID ReleaseBufferObjectMem(GLES2Context *gc, PVRSRV_CLIENT_MEM_INFO *psMemInfo, IMG_UINT32 ui32AllocAlign)
+{
+	GLES2BufferObjectMemPool *psMemPool = &gc->psSharedState->sBufferObjectMemPool;
+	GLES2BufferObjectMemPoolEntry *psEntry = IMG_NULL, *psEvicted;
+	IMG_UINT32 ui32Bucket;
+
+	/* Storage this large would push most of the pool out */
+	if(psMemInfo->uAllocSize <= GLES2_BUFOBJ_MEM_POOL_MAX_BYTES / 4)
+	{
+		psEntry = GLES2Malloc(gc, sizeof(GLES2BufferObjectMemPoolEntry));
+	}
+
+	if(!psEntry)
+	{
+		GLES2FREEDEVICEMEM_HEAP(gc, psMemInfo);
+
+		return;
+	}
+
+	ui32Bucket = GetBufferObjectMemPoolBucket(psMemInfo->uAllocSize);
+
+	psEntry->psMemInfo      = psMemInfo;
+	psEntry->ui32AllocAlign = ui32AllocAlign;
+	psEntry->psNewer        = IMG_NULL;
+
+	PVRSRVLockMutex(gc->psSharedState->hSecondaryLock);
+
+	psEntry->ui32Serial = psMemPool->ui32Serial++;
+	psEntry->psOlder    = psMemPool->apsNewest[ui32Bucket];
+
+	if(psEntry->psOlder)
+	{
+		psEntry->psOlder->psNewer = psEntry;
+	}
+	else
+	{
+		psMemPool->apsOldest[ui32Bucket] = psEntry;
+	}
+
+	psMemPool->apsNewest[ui32Bucket] = psEntry;
+
+	psMemPool->ui32NumEntries++;
+	psMemPool->ui32Bytes += psMemInfo->uAllocSize;
+
+	psEvicted = EvictMemPoolEntries(psMemPool, GLES2_BUFOBJ_MEM_POOL_MAX_BYTES);
+
+	if(psMemPool->ui32Bytes > psMemPool->ui32PeakBytes)
+	{
+		psMemPool->ui32PeakBytes = psMemPool->ui32Bytes;
+	}
+
+	PVRSRVUnlockMutex(gc->psSharedState->hSecondaryLock);
+
+	FreeMemPoolEntries(gc, psEvicted);
+}
+
+
+/***********************************************************************************
+ Function Name      : FreeBufferObjectMemPool
+ Inputs             : gc, psMemPool
+ Outputs            : -
+ Returns            : -
+ Description        : Frees the retired buffer storage of a share group being destroyed.
+************************************************************************************/
+IMG_INTERNAL IMG_VOID FreeBufferObjectMemPool(GLES2Context *gc, GLES2BufferObjectMemPool *psMemPool)
+{
+	PVR_DPF((PVR_DBG_MESSAGE, "FreeBufferObjectMemPool: %u hits, %u misses, %u evictions, peak %u bytes",
+			 psMemPool->ui32Hits, psMemPool->ui32Misses, psMemPool->ui32Evictions, psMemPool->ui32PeakBytes));
+
+	FreeMemPoolEntries(gc, EvictMemPoolEntries(psMemPool, 0));
+}
+
+
 /***********************************************************************************
  Function Name      : DestroyBufferObjectGhostKRM
  Inputs             : pvContext, psResource
  Outputs            : -
  Returns            : -
- Description        : 
+ Description        : Destroys a ghosted buffer object, keeping its storage for reuse.
 ************************************************************************************/
 IMG_INTERNAL IMG_VOID DestroyBufferObjectGhostKRM(IMG_VOID *pvContext, KRMResource *psResource)
 {
-	PVR_UNREFERENCED_PARAMETER(pvContext);
-	PVR_UNREFERENCED_PARAMETER(psResource);
+	/* Note the tricky pointer arithmetic. It is necessary */
+	GLES2BufferObjectGhost *psGhost = (GLES2BufferObjectGhost *)((IMG_UINTPTR_T)psResource - offsetof(GLES2BufferObjectGhost, sResource));
+	GLES2Context *gc = (GLES2Context *)pvContext;
 
-	PVR_DPF((PVR_DBG_WARNING, "DestroyBufferObjectGhostKRM: Called"));
+	ReleaseBufferObjectMem(gc, psGhost->psMemInfo, psGhost->ui32AllocAlign);
+
+	GLES2Free(IMG_NULL, psGhost);
 }	
 
 
@@ -199,42 +563,606 @@ static IMG_BOOL WaitUntilBufObjNotUsed(GLES2Context *gc, GLES2BufferObject *psBu
 								&psBufObj->sResource))
 		{
 
-			GLES2_INC_COUNT(GLES2_TIMER_SGXKICKTA_BUFDATA_COUNT, 1);
+			GLES2_INC_COUNT(GLES2_TIMER_SGXKICKTA_BUFDATA_COUNT, 1);
+
+			/* Kick the TA and wait for it. */
+			if(ScheduleTA(gc, gc->psRenderSurface, GLES2_SCHEDULE_HW_WAIT_FOR_TA) != IMG_EGL_NO_ERROR)
+			{
+				return IMG_FALSE;
+			}
+		}
+	}
+
+
+#if defined(PDUMP)
+
+	if(PDUMP_ISCAPTURING(gc))
+	{
+		if(!gc->sKRMTAStatusUpdate.bPDumpInitialised)
+		{
+			PDUMP_MEM(gc, gc->sKRMTAStatusUpdate.psMemInfo, 0, sizeof(IMG_UINT32));
+			gc->sKRMTAStatusUpdate.bPDumpInitialised=IMG_TRUE;
+		}
+	}
+
+	PVRSRVPDumpMemPol( gc->ps3DDevData->psConnection,
+					   gc->sKRMTAStatusUpdate.psMemInfo,
+					   0, 										/* Offset */
+					   gc->sKRMTAStatusUpdate.ui32StatusValue - 1, 	/* Value */
+					   0xFFFFFFFF, 								/* Mask */
+					   PDUMP_POLL_OPERATOR_EQUAL,				/* Operator */
+					   0); 										/* Flags */
+
+#endif /* defined(PDUMP) */
+
+	/*
+	** Case 4
+	*/
+	return KRM_WaitUntilResourceIsNotNeeded(&gc->psSharedState->sBufferObjectKRM, &psBufObj->sResource, KRM_DEFAULT_WAIT_RETRIES);
+}
+
+
+/***********************************************************************************
+ Function Name      : ApplyStagedBufferUpdates
+ Inputs             : gc, psBufObj, bWait
+ Outputs            : -
+ Returns            : -
+ Description        : Writes the context's staged updates of a buffer object, or of all
+					  of them if psBufObj is IMG_NULL, in the order they were made.
+					  If bWait is set, first waits for kicked TAs to be done with each
+					  buffer. Staged buffers are never part of the current kick.
+************************************************************************************/
+static IMG_VOID ApplyStagedBufferUpdates(GLES2Context *gc, GLES2BufferObject *psBufObj, IMG_BOOL bWait)
+{
+	GLES2BufferObjectMachine *psMachine = &gc->sBufferObject;
+	GLES2BufferObject *apsReleased[GLES2_BUFOBJ_MAX_STAGED_UPDATES];
+	IMG_UINT32 ui32NumReleased = 0, ui32NumLeft = 0;
+	IMG_UINT32 i;
+
+	if(!psMachine->ui32NumStagedUpdates)
+	{
+		return;
+	}
+
+	GLES2_TIME_START(GLES2_TIMER_BUFOBJ_STAGING_FLUSH_TIME);
+
+	for(i = 0; i < psMachine->ui32NumStagedUpdates; i++)
+	{
+		GLES2BufferObjectStagedUpdate *psUpdate = &psMachine->asStagedUpdate[i];
+
+		if(!psUpdate->psBufObj)
+		{
+			continue;
+		}
+
+		if(psBufObj && (psUpdate->psBufObj != psBufObj))
+		{
+			ui32NumLeft++;
+
+			continue;
+		}
+
+		if(bWait &&
+		   !KRM_WaitUntilResourceIsNotNeeded(&gc->psSharedState->sBufferObjectKRM, &psUpdate->psBufObj->sResource, KRM_DEFAULT_WAIT_RETRIES))
+		{
+			PVR_DPF((PVR_DBG_ERROR,"ApplyStagedBufferUpdates: Buffer didn't become free"));
+		}
+
+		GLES2MemCopy((IMG_UINT8 *)psUpdate->psBufObj->psMemInfo->pvLinAddr + psUpdate->ui32Offset,
+					 psMachine->pui8StagingData + psUpdate->ui32DataOffset,
+					 psUpdate->ui32Size);
+
+#if defined(PDUMP)
+		psUpdate->psBufObj->bDumped = IMG_FALSE;
+#endif
+
+		apsReleased[ui32NumReleased++] = psUpdate->psBufObj;
+
+		psUpdate->psBufObj = IMG_NULL;
+	}
+
+	if(!ui32NumLeft)
+	{
+		psMachine->ui32NumStagedUpdates = 0;
+		psMachine->ui32StagingDataUsed = 0;
+	}
+
+	GLES2_TIME_STOP(GLES2_TIMER_BUFOBJ_STAGING_FLUSH_TIME);
+
+	/* Drop the references last: this may free a deleted buffer object */
+	for(i = 0; i < ui32NumReleased; i++)
+	{
+		NamedItemDelRef(gc, gc->psSharedState->apsNamesArray[GLES2_NAMETYPE_BUFOBJ], (GLES2NamedItem *)apsReleased[i]);
+	}
+}
+
+
+/***********************************************************************************
+ Function Name      : DiscardStagedBufferUpdates
+ Inputs             : gc, psBufObj
+ Outputs            : -
+ Returns            : -
+ Description        : Drops the context's staged updates of a buffer object whose
+					  data is being replaced.
+************************************************************************************/
+static IMG_VOID DiscardStagedBufferUpdates(GLES2Context *gc, GLES2BufferObject *psBufObj)
+{
+	GLES2BufferObjectMachine *psMachine = &gc->sBufferObject;
+	IMG_UINT32 ui32NumLeft = 0;
+	IMG_UINT32 i;
+
+	for(i = 0; i < psMachine->ui32NumStagedUpdates; i++)
+	{
+		GLES2BufferObjectStagedUpdate *psUpdate = &psMachine->asStagedUpdate[i];
+
+		if(psUpdate->psBufObj == psBufObj)
+		{
+			psUpdate->psBufObj = IMG_NULL;
+
+			/* The caller holds a reference too, so this can't free the buffer object */
+			NamedItemDelRef(gc, gc->psSharedState->apsNamesArray[GLES2_NAMETYPE_BUFOBJ], (GLES2NamedItem *)psBufObj);
+		}
+		else if(psUpdate->psBufObj)
+		{
+			ui32NumLeft++;
+		}
+	}
+
+	if(!ui32NumLeft)
+	{
+		psMachine->ui32NumStagedUpdates = 0;
+		psMachine->ui32StagingDataUsed = 0;
+	}
+}
+
+
+/***********************************************************************************
+ Function Name      : FlushStagedBufferUpdates
+ Inputs             : gc
+ Outputs            : -
+ Returns            : -
+ Description        : Writes all the context's staged buffer updates. Called before
+					  every kick.
+************************************************************************************/
+IMG_INTERNAL IMG_VOID FlushStagedBufferUpdates(GLES2Context *gc)
+{
+	if(gc->sBufferObject.ui32NumStagedUpdates)
+	{
+		ApplyStagedBufferUpdates(gc, IMG_NULL, IMG_TRUE);
+	}
+}
+
+
+/***********************************************************************************
+ Function Name      : FlushStagedBufferUpdatesForDraw
+ Inputs             : gc
+ Outputs            : -
+ Returns            : -
+ Description        : Writes the staged updates of the buffer objects the validated
+					  draw reads, before they are attached to the current kick or read
+					  by the CPU.
+************************************************************************************/
+IMG_INTERNAL IMG_VOID FlushStagedBufferUpdatesForDraw(GLES2Context *gc)
+{
+	GLES2VertexArrayObjectMachine *psVAOMachine = &gc->sVAOMachine;
+	GLES2BufferObjectMachine *psMachine = &gc->sBufferObject;
+	IMG_UINT32 i, j;
+
+	for(i = 0; i < psMachine->ui32NumStagedUpdates; i++)
+	{
+		GLES2BufferObject *psBufObj = psMachine->asStagedUpdate[i].psBufObj;
+		IMG_BOOL bUsed = IMG_FALSE;
+
+		if(!psBufObj)
+		{
+			continue;
+		}
+
+		if(psVAOMachine->psBoundElementBuffer == psBufObj)
+		{
+			bUsed = IMG_TRUE;
+		}
+		else if(psVAOMachine->ui32ControlWord & ATTRIBARRAY_SOURCE_BUFOBJ)
+		{
+			for(j = 0; j < psVAOMachine->ui32NumItemsPerVertex; j++)
+			{
+				GLES2AttribArrayPointerMachine *psAPMachine = psVAOMachine->apsPackedAttrib[j];
+
+				if((psAPMachine->psState->psBufObj == psBufObj) && !psAPMachine->bIsCurrentState)
+				{
+					bUsed = IMG_TRUE;
+
+					break;
+				}
+			}
+		}
+
+		if(bUsed)
+		{
+			/* Writes every update of this buffer, and may empty the list */
+			ApplyStagedBufferUpdates(gc, psBufObj, IMG_TRUE);
+		}
+	}
+}
+
+
+/***********************************************************************************
+ Function Name      : StageBufferUpdate
+ Inputs             : gc, psBufObj, ui32Offset, ui32Size, pvData
+ Outputs            : -
+ Returns            : Success
+ Description        : Copies a small update of a buffer object kicked TAs still read
+					  to the context's staging area.
+************************************************************************************/
+static IMG_BOOL StageBufferUpdate(GLES2Context *gc, GLES2BufferObject *psBufObj, IMG_UINT32 ui32Offset,
+								  IMG_UINT32 ui32Size, const IMG_VOID *pvData)
+{
+	GLES2BufferObjectMachine *psMachine = &gc->sBufferObject;
+	GLES2BufferObjectStagedUpdate *psUpdate;
+	IMG_UINT32 ui32AlignedSize = ALIGNCOUNT(ui32Size, 4);
+
+	if(!psMachine->pui8StagingData)
+	{
+		psMachine->pui8StagingData = GLES2Malloc(gc, GLES2_BUFOBJ_STAGING_SIZE);
+
+		if(!psMachine->pui8StagingData)
+		{
+			return IMG_FALSE;
+		}
+	}
+
+	if((psMachine->ui32NumStagedUpdates == GLES2_BUFOBJ_MAX_STAGED_UPDATES) ||
+	   (psMachine->ui32StagingDataUsed + ui32AlignedSize > GLES2_BUFOBJ_STAGING_SIZE))
+	{
+		ApplyStagedBufferUpdates(gc, IMG_NULL, IMG_TRUE);
+	}
+
+	psUpdate = &psMachine->asStagedUpdate[psMachine->ui32NumStagedUpdates++];
+
+	psUpdate->psBufObj       = psBufObj;
+	psUpdate->ui32Offset     = ui32Offset;
+	psUpdate->ui32Size       = ui32Size;
+	psUpdate->ui32DataOffset = psMachine->ui32StagingDataUsed;
+
+	GLES2MemCopy(psMachine->pui8StagingData + psUpdate->ui32DataOffset, pvData, ui32Size);
+
+	psMachine->ui32StagingDataUsed += ui32AlignedSize;
+
+	/* Keep the buffer object alive until the update is written */
+	NamedItemAddRefByItem(gc, gc->psSharedState->apsNamesArray[GLES2_NAMETYPE_BUFOBJ], (GLES2NamedItem *)psBufObj);
+
+	return IMG_TRUE;
+}
+
+
+/***********************************************************************************
+ Function Name      : MarkVAOBufferObjectDirty
+ Inputs             : gc, pvFunctionContext, psNamedItem
+ Outputs            : -
+ Returns            : -
+ Description        : Makes a VAO which reads the buffer object in pvFunctionContext
+					  patch its stream addresses when it is next validated.
+************************************************************************************/
+static IMG_VOID MarkVAOBufferObjectDirty(GLES2Context *gc, const IMG_VOID *pvFunctionContext, GLES2NamedItem *psNamedItem)
+{
+	const GLES2BufferObject *psBufObj = (const GLES2BufferObject *)pvFunctionContext;
+	GLES2VertexArrayObject *psVAO = (GLES2VertexArrayObject *)psNamedItem;
+	IMG_UINT32 i;
+
+	PVR_UNREFERENCED_PARAMETER(gc);
+
+	if(psVAO->psBoundElementBuffer == psBufObj)
+	{
+		psVAO->ui32DirtyState |= GLES2_DIRTYFLAG_VAO_ELEMENT_BUFFER;
+	}
+
+	for(i = 0; i < GLES2_MAX_VERTEX_ATTRIBS; i++)
+	{
+		if(psVAO->asVAOState[i].psBufObj == psBufObj)
+		{
+			psVAO->ui32DirtyState |= GLES2_DIRTYFLAG_VAO_ATTRIB_STREAM;
+
+			break;
+		}
+	}
+}
+
+
+/***********************************************************************************
+ Function Name      : MarkBufferObjectVAOsDirty
+ Inputs             : gc, psBufObj
+ Outputs            : -
+ Returns            : -
+ Description        : Makes the VAOs of the context which read a buffer object patch
+					  their stream and index addresses after its storage has moved.
+************************************************************************************/
+static IMG_VOID MarkBufferObjectVAOsDirty(GLES2Context *gc, GLES2BufferObject *psBufObj)
+{
+	MarkVAOBufferObjectDirty(gc, psBufObj, (GLES2NamedItem *)&gc->sVAOMachine.sDefaultVAO);
+
+#if defined(GLES2_EXTENSION_VERTEX_ARRAY_OBJECT)
+	NamesArrayMapFunction(gc, gc->apsNamesArray[GLES2_NAMETYPE_VERARROBJ - GLES2_MAX_SHAREABLE_NAMETYPE], MarkVAOBufferObjectDirty, psBufObj);
+#endif /* defined(GLES2_EXTENSION_VERTEX_ARRAY_OBJECT) */
+}
+
+
+/***********************************************************************************
+ Function Name      : GhostBufferObjectMem
+ Inputs             : gc, psBufObj
+ Outputs            : -
+ Returns            : Success
+ Description        : Hands the storage of a buffer object the TA may still read to a
+					  ghost, which returns it to the pool once the TA is done with it.
+					  The caller gives the buffer object other storage, or none.
+************************************************************************************/
+static IMG_BOOL GhostBufferObjectMem(GLES2Context *gc, GLES2BufferObject *psBufObj)
+{
+	GLES2BufferObjectGhost *psGhost = GLES2Calloc(gc, sizeof(GLES2BufferObjectGhost));
+
+	if(!psGhost)
+	{
+		return IMG_FALSE;
+	}
+
+	psGhost->psMemInfo      = psBufObj->psMemInfo;
+	psGhost->ui32AllocAlign = psBufObj->ui32AllocAlign;
+
+	KRM_GhostResource(&gc->psSharedState->sBufferObjectKRM, &psBufObj->sResource, &psGhost->sResource);
+
+	return IMG_TRUE;
+}
+
+
+/***********************************************************************************
+ Function Name      : RenameBufferObject
+ Inputs             : gc, psBufObj, ui32Offset, ui32Size, pvData
+ Outputs            : -
+ Returns            : Success
+ Description        : Ghosts the storage of a buffer object the TA may still read and
+					  gives it new storage holding the old data with the update applied.
+************************************************************************************/
+static IMG_BOOL RenameBufferObject(GLES2Context *gc, GLES2BufferObject *psBufObj, IMG_UINT32 ui32Offset,
+								   IMG_UINT32 ui32Size, const IMG_VOID *pvData)
+{
+	PVRSRV_CLIENT_MEM_INFO *psOldMemInfo = psBufObj->psMemInfo, *psNewMemInfo;
+	IMG_UINT32 ui32End = ui32Offset + ui32Size;
+
+	/* Storage of finished ghosts goes back to the pool */
+	KRM_DestroyUnneededGhosts(gc, &gc->psSharedState->sBufferObjectKRM);
+
+	if(!AllocBufferObjectMem(gc, psOldMemInfo->uAllocSize, psBufObj->ui32AllocAlign, &psNewMemInfo))
+	{
+		return IMG_FALSE;
+	}
+
+	if(!GhostBufferObjectMem(gc, psBufObj))
+	{
+		ReleaseBufferObjectMem(gc, psNewMemInfo, psBufObj->ui32AllocAlign);
+
+		return IMG_FALSE;
+	}
+
+	/* The CPU may read storage the TA is reading */
+	if(ui32Offset)
+	{
+		GLES2MemCopy(psNewMemInfo->pvLinAddr, psOldMemInfo->pvLinAddr, ui32Offset);
+	}
+
+	if(ui32End < psBufObj->ui32BufferSize)
+	{
+		GLES2MemCopy((IMG_UINT8 *)psNewMemInfo->pvLinAddr + ui32End,
+					 (const IMG_UINT8 *)psOldMemInfo->pvLinAddr + ui32End,
+					 psBufObj->ui32BufferSize - ui32End);
+	}
+
+	psBufObj->psMemInfo = psNewMemInfo;
+
+	/* Earlier updates still staged were not in the old storage */
+	ApplyStagedBufferUpdates(gc, psBufObj, IMG_FALSE);
+
+	GLES2MemCopy((IMG_UINT8 *)psNewMemInfo->pvLinAddr + ui32Offset, pvData, ui32Size);
+
+	MarkBufferObjectVAOsDirty(gc, psBufObj);
+
+	return IMG_TRUE;
+}
+
+
+/***********************************************************************************
+ Function Name      : UpdateBusyBufferObject
+ Inputs             : gc, psBufObj, ui32Offset, ui32Size, pvData
+ Outputs            : -
+ Returns            : Whether the update was made without waiting for the TA
+ Description        : Renames the buffer object or stages the update if the TA may
+					  still read the buffer (see bufobj.h). Returns IMG_FALSE if
+					  the caller has to wait for the buffer and write it itself.
+************************************************************************************/
+static IMG_BOOL UpdateBusyBufferObject(GLES2Context *gc, GLES2BufferObject *psBufObj, IMG_UINT32 ui32Offset,
+									   IMG_UINT32 ui32Size, const IMG_VOID *pvData)
+{
+	IMG_BOOL bInCurrentKick;
+
+	if(!KRM_IsResourceNeeded(&gc->psSharedState->sBufferObjectKRM, &psBufObj->sResource))
+	{
+		return IMG_FALSE;
+	}
+
+	bInCurrentKick = gc->psRenderSurface->bPrimitivesSinceLastTA &&
+					 KRM_IsResourceInUse(&gc->psSharedState->sBufferObjectKRM,
+										 gc,
+										 &gc->sKRMTAStatusUpdate,
+										 &psBufObj->sResource);
+
+	/* Only the VAOs of this context can be told the storage has moved. A context
+	   created meanwhile has no stream addresses yet, so the unlocked read is safe */
+	if((gc->psSharedState->ui32RefCount == 1) &&
+	   ((ui32Size * GLES2_BUFOBJ_RENAME_FRACTION >= psBufObj->ui32BufferSize) ||
+	    (psBufObj->ui32BufferSize <= GLES2_BUFOBJ_RENAME_MAX_COPY)))
+	{
+		if(RenameBufferObject(gc, psBufObj, ui32Offset, ui32Size, pvData))
+		{
+			GLES2_INC_COUNT(GLES2_TIMER_BUFSUBDATA_RENAME_COUNT, 1);
+
+			return IMG_TRUE;
+		}
+	}
+
+	if(!bInCurrentKick && (ui32Size <= GLES2_BUFOBJ_MAX_STAGED_UPDATE_SIZE))
+	{
+		if(StageBufferUpdate(gc, psBufObj, ui32Offset, ui32Size, pvData))
+		{
+			GLES2_INC_COUNT(GLES2_TIMER_BUFSUBDATA_STAGE_COUNT, 1);
+
+			return IMG_TRUE;
+		}
+	}
+
+	GLES2_INC_COUNT(GLES2_TIMER_BUFSUBDATA_WAIT_COUNT, 1);
+
+	return IMG_FALSE;
+}
+
+
+/***********************************************************************************
+ Function Name      : WriteBufferObjectRange
+ Inputs             : gc, psBufObj, ui32Offset, ui32Size, pvData
+ Outputs            : -
+ Returns            : Success
+ Description        : Writes data to a buffer object, renaming the buffer or staging
+					  the data if the TA may still read it, or waiting for the TA.
+************************************************************************************/
+static IMG_BOOL WriteBufferObjectRange(GLES2Context *gc, GLES2BufferObject *psBufObj, IMG_UINT32 ui32Offset,
+									   IMG_UINT32 ui32Size, const IMG_VOID *pvData)
+{
+	if(UpdateBusyBufferObject(gc, psBufObj, ui32Offset, ui32Size, pvData))
+	{
+		/* Renamed or staged */
+		return IMG_TRUE;
+	}
+
+	if(!WaitUntilBufObjNotUsed(gc, psBufObj))
+	{
+		return IMG_FALSE;
+	}
+
+	/* Updates staged while the buffer was busy come first */
+	ApplyStagedBufferUpdates(gc, psBufObj, IMG_FALSE);
+
+	GLES2MemCopy((IMG_UINT8 *)psBufObj->psMemInfo->pvLinAddr + ui32Offset, pvData, ui32Size);
+
+	return IMG_TRUE;
+}
+
+
+/***********************************************************************************
+ Function Name      : ReplaceBufferObjectMem
+ Inputs             : gc, psBufObj
+ Outputs            : -
+ Returns            : Success
+ Description        : Orphans the storage of a buffer object the TA may still read and
+					  gives it new storage of the same size with undefined contents.
+************************************************************************************/
+static IMG_BOOL ReplaceBufferObjectMem(GLES2Context *gc, GLES2BufferObject *psBufObj)
+{
+	PVRSRV_CLIENT_MEM_INFO *psNewMemInfo;
+
+	/* As with renames, only the VAOs of this context can be told the storage has moved */
+	if(gc->psSharedState->ui32RefCount != 1)
+	{
+		return IMG_FALSE;
+	}
+
+	KRM_DestroyUnneededGhosts(gc, &gc->psSharedState->sBufferObjectKRM);
+
+	if(!AllocBufferObjectMem(gc, psBufObj->psMemInfo->uAllocSize, psBufObj->ui32AllocAlign, &psNewMemInfo))
+	{
+		return IMG_FALSE;
+	}
+
+	if(!GhostBufferObjectMem(gc, psBufObj))
+	{
+		ReleaseBufferObjectMem(gc, psNewMemInfo, psBufObj->ui32AllocAlign);
+
+		return IMG_FALSE;
+	}
+
+	/* The whole buffer is being redefined */
+	DiscardStagedBufferUpdates(gc, psBufObj);
+
+	psBufObj->psMemInfo = psNewMemInfo;
+
+	MarkBufferObjectVAOsDirty(gc, psBufObj);
+
+	return IMG_TRUE;
+}
+
+
+/***********************************************************************************
+ Function Name      : AllocMapStaging
+ Inputs             : gc, psBufObj, ui32Size
+ Outputs            : -
+ Returns            : Success
+ Description        : Gives a buffer object being mapped host memory to map instead
+					  of its storage, reusing the context's cached block if possible.
+************************************************************************************/
+static IMG_BOOL AllocMapStaging(GLES2Context *gc, GLES2BufferObject *psBufObj, IMG_UINT32 ui32Size)
+{
+	GLES2BufferObjectMachine *psMachine = &gc->sBufferObject;
+
+	if(psMachine->pui8MapStagingCache && (psMachine->ui32MapStagingCacheSize >= ui32Size))
+	{
+		psBufObj->pui8MapStaging     = psMachine->pui8MapStagingCache;
+		psBufObj->ui32MapStagingSize = psMachine->ui32MapStagingCacheSize;
+
+		psMachine->pui8MapStagingCache     = IMG_NULL;
+		psMachine->ui32MapStagingCacheSize = 0;
 
-			/* Kick the TA and wait for it. */
-			if(ScheduleTA(gc, gc->psRenderSurface, GLES2_SCHEDULE_HW_WAIT_FOR_TA) != IMG_EGL_NO_ERROR)
-			{
-				return IMG_FALSE;
-			}
-		}
+		return IMG_TRUE;
 	}
 
+	psBufObj->pui8MapStaging = GLES2Malloc(gc, ui32Size);
 
-#if defined(PDUMP)
-
-	if(PDUMP_ISCAPTURING(gc))
+	if(!psBufObj->pui8MapStaging)
 	{
-		if(!gc->sKRMTAStatusUpdate.bPDumpInitialised)
-		{
-			PDUMP_MEM(gc, gc->sKRMTAStatusUpdate.psMemInfo, 0, sizeof(IMG_UINT32));
-			gc->sKRMTAStatusUpdate.bPDumpInitialised=IMG_TRUE;
-		}
+		return IMG_FALSE;
 	}
 
-	PVRSRVPDumpMemPol( gc->ps3DDevData->psConnection,
-					   gc->sKRMTAStatusUpdate.psMemInfo,
-					   0, 										/* Offset */
-					   gc->sKRMTAStatusUpdate.ui32StatusValue - 1, 	/* Value */
-					   0xFFFFFFFF, 								/* Mask */
-					   PDUMP_POLL_OPERATOR_EQUAL,				/* Operator */
-					   0); 										/* Flags */
+	psBufObj->ui32MapStagingSize = ui32Size;
 
-#endif /* defined(PDUMP) */
+	return IMG_TRUE;
+}
 
-	/*
-	** Case 4
-	*/
-	return KRM_WaitUntilResourceIsNotNeeded(&gc->psSharedState->sBufferObjectKRM, &psBufObj->sResource, KRM_DEFAULT_WAIT_RETRIES);
+
+/***********************************************************************************
+ Function Name      : ReleaseMapStaging
+ Inputs             : gc, psBufObj
+ Outputs            : -
+ Returns            : -
+ Description        : Takes the host memory mapped instead of its storage from a buffer
+					  object, keeping the largest block up to GLES2_BUFOBJ_MAP_STAGING_CACHE_SIZE
+					  for the next staged mapping.
+************************************************************************************/
+static IMG_VOID ReleaseMapStaging(GLES2Context *gc, GLES2BufferObject *psBufObj)
+{
+	GLES2BufferObjectMachine *psMachine = &gc->sBufferObject;
+	IMG_UINT8 *pui8Staging = psBufObj->pui8MapStaging;
+
+	if((psBufObj->ui32MapStagingSize <= GLES2_BUFOBJ_MAP_STAGING_CACHE_SIZE) &&
+	   (psBufObj->ui32MapStagingSize > psMachine->ui32MapStagingCacheSize))
+	{
+		pui8Staging = psMachine->pui8MapStagingCache;
+
+		psMachine->pui8MapStagingCache     = psBufObj->pui8MapStaging;
+		psMachine->ui32MapStagingCacheSize = psBufObj->ui32MapStagingSize;
+	}
+
+	if(pui8Staging)
+	{
+		GLES2Free(IMG_NULL, pui8Staging);
+	}
+
+	psBufObj->pui8MapStaging     = IMG_NULL;
+	psBufObj->ui32MapStagingSize = 0;
 }
 
 
@@ -262,11 +1190,17 @@ static IMG_VOID FreeBufferObject(GLES2Context *gc, GLES2BufferObject *psBufObj,
 			PVR_DPF((PVR_DBG_ERROR,"FreeBufferObject: Problem freeing buffer object"));
 		}
 
-		GLES2FREEDEVICEMEM_HEAP(gc, psBufObj->psMemInfo);
-
 #if defined(DEBUG) || defined(TIMING)
 		gc->ui32VBOMemCurrent -= psBufObj->psMemInfo->uAllocSize;
 #endif /* defined(DEBUG) || defined(TIMING) */
+
+		ReleaseBufferObjectMem(gc, psBufObj->psMemInfo, psBufObj->ui32AllocAlign);
+	}
+
+	/* Deleting a mapped buffer unmaps it */
+	if(psBufObj->pui8MapStaging)
+	{
+		GLES2Free(IMG_NULL, psBufObj->pui8MapStaging);
 	}
 
 	KRM_RemoveResourceFromAllLists(&gc->psSharedState->sBufferObjectKRM, &psBufObj->sResource);
@@ -631,7 +1565,6 @@ GL_APICALL void GL_APIENTRY glBufferData(GLenum target, GLsizeiptr size, const v
 	IMG_UINT32 ui32TargetIndex, uAllocSize, ui32AllocAlign;
 	GLES2BufferObject *psBufObj;
 	GLES2VertexArrayObject *psVAO;
-	PVRSRV_ERROR eError;
 
 	__GLES2_GET_CONTEXT();
 
@@ -716,19 +1649,45 @@ GL_APICALL void GL_APIENTRY glBufferData(GLenum target, GLsizeiptr size, const v
 		ui32AllocAlign = EURASIA_VDM_INDEX_FETCH_BURST_SIZE;
 	}
 
-	/* if it already holds some data, free it first (unless it is the same size as the new request) */
+	/* if it already holds some data, free it first (unless it is large enough for the new request) */
+	if (psBufObj->psMemInfo)
+	{
+		/* The new data replaces any staged updates */
+		DiscardStagedBufferUpdates(gc, psBufObj);
+
+		/* Orphan storage the TA may still read rather than wait for it. As with renames, only 
+		   the VAOs of this context can be told the storage has moved */
+		if((gc->psSharedState->ui32RefCount == 1) &&
+		   KRM_IsResourceNeeded(&gc->psSharedState->sBufferObjectKRM, &psBufObj->sResource))
+		{
+			KRM_DestroyUnneededGhosts(gc, &gc->psSharedState->sBufferObjectKRM);
+
+			if(GhostBufferObjectMem(gc, psBufObj))
+			{
+#if defined(DEBUG) || defined(TIMING)
+				gc->ui32VBOMemCurrent -= psBufObj->psMemInfo->uAllocSize;
+#endif /* defined(DEBUG) || defined(TIMING) */
+
+				psBufObj->psMemInfo = IMG_NULL;
+
+				MarkBufferObjectVAOsDirty(gc, psBufObj);
+
+				GLES2_INC_COUNT(GLES2_TIMER_BUFDATA_ORPHAN_COUNT, 1);
+			}
+		}
+	}
+
 	if (psBufObj->psMemInfo)
 	{
 		if(WaitUntilBufObjNotUsed(gc, psBufObj))
 		{
-			if((psBufObj->psMemInfo->uAllocSize != uAllocSize) ||
-			   (psBufObj->ui32AllocAlign != ui32AllocAlign))
+			if(!BufferObjectMemFits(psBufObj->psMemInfo->uAllocSize, psBufObj->ui32AllocAlign, uAllocSize, ui32AllocAlign))
 			{
 #if defined(DEBUG) || defined(TIMING)
 				gc->ui32VBOMemCurrent -= psBufObj->psMemInfo->uAllocSize;
 #endif /* defined(DEBUG) || defined(TIMING) */
 				
-				GLES2FREEDEVICEMEM_HEAP(gc, psBufObj->psMemInfo);
+				ReleaseBufferObjectMem(gc, psBufObj->psMemInfo, psBufObj->ui32AllocAlign);
 
 				psBufObj->psMemInfo = IMG_NULL;
 			}
@@ -750,28 +1709,10 @@ GL_APICALL void GL_APIENTRY glBufferData(GLenum target, GLsizeiptr size, const v
 	{
 		if(size)
 		{
-
-			eError = GLES2ALLOCDEVICEMEM_HEAP(gc,
-				PVRSRV_MEM_READ | PVRSRV_MAP_GC_MMU,		/* Read only (by device) */
-				uAllocSize,
-				ui32AllocAlign,
-				&psBufObj->psMemInfo);
-
-			if (eError != PVRSRV_OK)
-			{
-				eError = GLES2ALLOCDEVICEMEM_HEAP(gc,
-					PVRSRV_MEM_READ,							/* Read only (by device) */
-					uAllocSize,
-					ui32AllocAlign,
-					&psBufObj->psMemInfo);
-			}
-
-			if (eError != PVRSRV_OK)
+			if(!AllocBufferObjectMem(gc, uAllocSize, ui32AllocAlign, &psBufObj->psMemInfo))
 			{
 				PVR_DPF((PVR_DBG_ERROR,"glBufferData: Can't allocate memory for object"));
 
-				psBufObj->psMemInfo = IMG_NULL;
-
 				/* Mark as dirty so we will spot the invalid memory if someone tries to draw with it */
 				psVAO->ui32DirtyState |= GLES2_DIRTYFLAG_VAO_ATTRIB_STREAM;
 			
@@ -816,6 +1757,13 @@ GL_APICALL void GL_APIENTRY glBufferData(GLenum target, GLsizeiptr size, const v
 	psBufObj->ui32BufferSize = (IMG_UINT32)size;
 	psBufObj->eUsage = usage;
 	psBufObj->bMapped = IMG_FALSE;
+	psBufObj->pvMapPointer = IMG_NULL;
+
+	/* Data written to a staged mapping is lost */
+	if(psBufObj->pui8MapStaging)
+	{
+		ReleaseMapStaging(gc, psBufObj);
+	}
 
 #if defined(PDUMP)
 	psBufObj->bDumped = IMG_FALSE;
@@ -903,17 +1851,9 @@ GL_APICALL void GL_APIENTRY glBufferSubData(GLenum target, GLintptr offset, GLsi
 		return;
 	}
 
-	if (data)
+	if (data && size)
 	{
-		if(WaitUntilBufObjNotUsed(gc, psBufObj))
-		{
-			IMG_VOID *pvDst;
-
-			pvDst = (IMG_VOID *)((IMG_UINT8 *)psBufObj->psMemInfo->pvLinAddr + offset);
-
-			GLES2MemCopy(pvDst, (const IMG_VOID *)data, (IMG_UINT32)size);
-		}
-		else
+		if(!WriteBufferObjectRange(gc, psBufObj, (IMG_UINT32)offset, (IMG_UINT32)size, data))
 		{
 			PVR_DPF((PVR_DBG_ERROR,"glBufferSubData: Can't update data as buffer didn't become free"));
 
@@ -999,7 +1939,8 @@ GL_API_EXT void * GL_APIENTRY glMapBufferOES(GLenum target, GLenum access)
 		return IMG_NULL;
 	}
 
-	if(psBufObj->psMemInfo->pvLinAddr)
+	/* A zero-size glBufferData leaves no storage */
+	if(psBufObj->psMemInfo && psBufObj->psMemInfo->pvLinAddr)
 	{
 		if(!WaitUntilBufObjNotUsed(gc, psBufObj))
 		{
@@ -1015,9 +1956,16 @@ SetOutOfMemErrorAndReturnNULL:
 			return IMG_NULL;
 		}
 
+		ApplyStagedBufferUpdates(gc, psBufObj, IMG_FALSE);
+
 		psBufObj->eAccess = access;
 		psBufObj->bMapped = IMG_TRUE;
 
+		psBufObj->ui32MapOffset = 0;
+		psBufObj->ui32MapLength = psBufObj->ui32BufferSize;
+		psBufObj->ui32MapAccess = GL_MAP_WRITE_BIT_EXT;
+		psBufObj->pvMapPointer  = psBufObj->psMemInfo->pvLinAddr;
+
 		GLES2_TIME_STOP(GLES2_TIMES_glMapBuffer);
 
 		return psBufObj->psMemInfo->pvLinAddr;
@@ -1040,6 +1988,7 @@ GL_API_EXT GLboolean GL_APIENTRY glUnmapBufferOES(GLenum target)
 {
 	GLES2BufferObject *psBufObj;
 	IMG_UINT32 ui32TargetIndex;
+	GLboolean bDataValid = GL_TRUE;
 
 	__GLES2_GET_CONTEXT_RETURN(GL_FALSE);
 
@@ -1067,7 +2016,7 @@ GL_API_EXT GLboolean GL_APIENTRY glUnmapBufferOES(GLenum target)
 
 	psBufObj = gc->sBufferObject.psActiveBuffer[ui32TargetIndex];
 	
-	if(!psBufObj || !psBufObj->bMapped || !psBufObj->psMemInfo->pvLinAddr) 
+	if(!psBufObj || !psBufObj->bMapped || !psBufObj->psMemInfo || !psBufObj->psMemInfo->pvLinAddr) 
 	{
 		SetError(gc, GL_INVALID_OPERATION);
 
@@ -1076,7 +2025,32 @@ GL_API_EXT GLboolean GL_APIENTRY glUnmapBufferOES(GLenum target)
 		return GL_FALSE;
 	}
 
+	if(psBufObj->pui8MapStaging)
+	{
+		IMG_UINT32 ui32Start = 0, ui32End = psBufObj->ui32MapLength;
+
+		if(psBufObj->ui32MapAccess & GL_MAP_FLUSH_EXPLICIT_BIT_EXT)
+		{
+			ui32Start = psBufObj->ui32FlushStart;
+			ui32End   = psBufObj->ui32FlushEnd;
+		}
+
+		if(ui32End > ui32Start)
+		{
+			if(!WriteBufferObjectRange(gc, psBufObj, psBufObj->ui32MapOffset + ui32Start, ui32End - ui32Start,
+									   psBufObj->pui8MapStaging + ui32Start))
+			{
+				PVR_DPF((PVR_DBG_ERROR,"glUnmapBuffer: Can't write mapped data as buffer didn't become free"));
+
+				bDataValid = GL_FALSE;
+			}
+		}
+
+		ReleaseMapStaging(gc, psBufObj);
+	}
+
 	psBufObj->bMapped = IMG_FALSE;
+	psBufObj->pvMapPointer = IMG_NULL;
 
 #if defined(PDUMP)
 	psBufObj->bDumped = IMG_FALSE;
@@ -1084,9 +2058,237 @@ GL_API_EXT GLboolean GL_APIENTRY glUnmapBufferOES(GLenum target)
 
 	GLES2_TIME_STOP(GLES2_TIMES_glUnmapBuffer);
 
-	return GL_TRUE;
+	return bDataValid;
+}
+
+
+#if defined(GLES2_EXTENSION_MAP_BUFFER_RANGE)
+
+/***********************************************************************************
+ Function Name      : glMapBufferRangeEXT
+ Inputs             : target, offset, length, access
+ Outputs            : -
+ Returns            : Pointer to the mapped range
+ Description        : ENTRYPOINT: Maps a range of the bound buffer object. See bufobj.h
+					  for how a buffer the TA may still read is mapped.
+************************************************************************************/
+GL_API_EXT void * GL_APIENTRY glMapBufferRangeEXT(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+	GLES2BufferObject *psBufObj;
+	IMG_UINT32 ui32TargetIndex;
+	IMG_BOOL bBusy;
+	IMG_VOID *pvPointer;
+
+	__GLES2_GET_CONTEXT_RETURN(IMG_NULL);
+
+	PVR_DPF((PVR_DBG_CALLTRACE,"glMapBufferRangeEXT"));
+
+	GLES2_TIME_START(GLES2_TIMES_glMapBufferRangeEXT);
+
+	switch(target)
+	{
+		case GL_ARRAY_BUFFER:
+		case GL_ELEMENT_ARRAY_BUFFER:
+		{
+			ui32TargetIndex = target - GL_ARRAY_BUFFER;
+
+			break;
+		}
+		default:
+		{
+			SetError(gc, GL_INVALID_ENUM);
+
+			GLES2_TIME_STOP(GLES2_TIMES_glMapBufferRangeEXT);
+
+			return IMG_NULL;
+		}
+	}
+
+	psBufObj = gc->sBufferObject.psActiveBuffer[ui32TargetIndex];
+
+	if(!psBufObj)
+	{
+		SetError(gc, GL_INVALID_OPERATION);
+
+		GLES2_TIME_STOP(GLES2_TIMES_glMapBufferRangeEXT);
+
+		return IMG_NULL;
+	}
+
+	if((offset < 0) || (length < 0) || 
+	   ((IMG_UINT32)(offset + length) > psBufObj->ui32BufferSize) ||
+	   (access & ~GLES2_BUFOBJ_MAP_ACCESS_BITS))
+	{
+		SetError(gc, GL_INVALID_VALUE);
+
+		GLES2_TIME_STOP(GLES2_TIMES_glMapBufferRangeEXT);
+
+		return IMG_NULL;
+	}
+
+	if(psBufObj->bMapped ||
+	   !(access & (GL_MAP_READ_BIT_EXT | GL_MAP_WRITE_BIT_EXT)) ||
+	   ((access & GL_MAP_READ_BIT_EXT) &&
+	    (access & (GL_MAP_INVALIDATE_RANGE_BIT_EXT | GL_MAP_INVALIDATE_BUFFER_BIT_EXT | GL_MAP_UNSYNCHRONIZED_BIT_EXT))) ||
+	   ((access & GL_MAP_FLUSH_EXPLICIT_BIT_EXT) && !(access & GL_MAP_WRITE_BIT_EXT)))
+	{
+		SetError(gc, GL_INVALID_OPERATION);
+
+		GLES2_TIME_STOP(GLES2_TIMES_glMapBufferRangeEXT);
+
+		return IMG_NULL;
+	}
+
+	if(!psBufObj->psMemInfo)
+	{
+		SetError(gc, GL_OUT_OF_MEMORY);
+
+		GLES2_TIME_STOP(GLES2_TIMES_glMapBufferRangeEXT);
+
+		return IMG_NULL;
+	}
+
+	bBusy = KRM_IsResourceNeeded(&gc->psSharedState->sBufferObjectKRM, &psBufObj->sResource);
+
+	if(bBusy && (access & GL_MAP_UNSYNCHRONIZED_BIT_EXT))
+	{
+		/* The app keeps clear of what the TA reads, but staged updates go in order */
+		ApplyStagedBufferUpdates(gc, psBufObj, IMG_TRUE);
+
+		GLES2_INC_COUNT(GLES2_TIMER_MAPRANGE_UNSYNCHRONIZED_COUNT, 1);
+	}
+	else if(bBusy && (access & GL_MAP_INVALIDATE_BUFFER_BIT_EXT) && ReplaceBufferObjectMem(gc, psBufObj))
+	{
+		GLES2_INC_COUNT(GLES2_TIMER_MAPRANGE_ORPHAN_COUNT, 1);
+	}
+	else if(bBusy && length &&
+			(access & (GL_MAP_INVALIDATE_RANGE_BIT_EXT | GL_MAP_INVALIDATE_BUFFER_BIT_EXT)) &&
+			AllocMapStaging(gc, psBufObj, (IMG_UINT32)length))
+	{
+		GLES2_INC_COUNT(GLES2_TIMER_MAPRANGE_STAGED_COUNT, 1);
+	}
+	else
+	{
+		if(!WaitUntilBufObjNotUsed(gc, psBufObj))
+		{
+			PVR_DPF((PVR_DBG_ERROR,"glMapBufferRangeEXT: Buffer didn't become free"));
+
+			SetError(gc, GL_OUT_OF_MEMORY);
+
+			GLES2_TIME_STOP(GLES2_TIMES_glMapBufferRangeEXT);
+
+			return IMG_NULL;
+		}
+
+		ApplyStagedBufferUpdates(gc, psBufObj, IMG_FALSE);
+
+		if(bBusy)
+		{
+			GLES2_INC_COUNT(GLES2_TIMER_MAPRANGE_WAIT_COUNT, 1);
+		}
+	}
+
+	if(psBufObj->pui8MapStaging)
+	{
+		pvPointer = psBufObj->pui8MapStaging;
+	}
+	else
+	{
+		pvPointer = (IMG_UINT8 *)psBufObj->psMemInfo->pvLinAddr + offset;
+	}
+
+	psBufObj->bMapped = IMG_TRUE;
+
+	psBufObj->ui32MapOffset = (IMG_UINT32)offset;
+	psBufObj->ui32MapLength = (IMG_UINT32)length;
+	psBufObj->ui32MapAccess = access;
+	psBufObj->pvMapPointer  = pvPointer;
+
+	/* Nothing flushed yet */
+	psBufObj->ui32FlushStart = psBufObj->ui32MapLength;
+	psBufObj->ui32FlushEnd   = 0;
+
+	GLES2_TIME_STOP(GLES2_TIMES_glMapBufferRangeEXT);
+
+	return pvPointer;
+}
+
+
+/***********************************************************************************
+ Function Name      : glFlushMappedBufferRangeEXT
+ Inputs             : target, offset, length
+ Outputs            : -
+ Returns            : -
+ Description        : ENTRYPOINT: Marks a range of a buffer mapped with
+					  GL_MAP_FLUSH_EXPLICIT_BIT_EXT as written. Ranges of staged
+					  mappings are written to the buffer at unmap.
+************************************************************************************/
+GL_API_EXT void GL_APIENTRY glFlushMappedBufferRangeEXT(GLenum target, GLintptr offset, GLsizeiptr length)
+{
+	GLES2BufferObject *psBufObj;
+	IMG_UINT32 ui32TargetIndex;
+
+	__GLES2_GET_CONTEXT();
+
+	PVR_DPF((PVR_DBG_CALLTRACE,"glFlushMappedBufferRangeEXT"));
+
+	GLES2_TIME_START(GLES2_TIMES_glFlushMappedBufferRangeEXT);
+
+	switch(target)
+	{
+		case GL_ARRAY_BUFFER:
+		case GL_ELEMENT_ARRAY_BUFFER:
+		{
+			ui32TargetIndex = target - GL_ARRAY_BUFFER;
+
+			break;
+		}
+		default:
+		{
+			SetError(gc, GL_INVALID_ENUM);
+
+			GLES2_TIME_STOP(GLES2_TIMES_glFlushMappedBufferRangeEXT);
+
+			return;
+		}
+	}
+
+	psBufObj = gc->sBufferObject.psActiveBuffer[ui32TargetIndex];
+
+	if(!psBufObj || !psBufObj->bMapped || !(psBufObj->ui32MapAccess & GL_MAP_FLUSH_EXPLICIT_BIT_EXT))
+	{
+		SetError(gc, GL_INVALID_OPERATION);
+
+		GLES2_TIME_STOP(GLES2_TIMES_glFlushMappedBufferRangeEXT);
+
+		return;
+	}
+
+	if((offset < 0) || (length < 0) || ((IMG_UINT32)(offset + length) > psBufObj->ui32MapLength))
+	{
+		SetError(gc, GL_INVALID_VALUE);
+
+		GLES2_TIME_STOP(GLES2_TIMES_glFlushMappedBufferRangeEXT);
+
+		return;
+	}
+
+	/* Bytes between flushed ranges were invalidated, so writing the union is enough */
+	if(length)
+	{
+		psBufObj->ui32FlushStart = MIN(psBufObj->ui32FlushStart, (IMG_UINT32)offset);
+		psBufObj->ui32FlushEnd   = MAX(psBufObj->ui32FlushEnd, (IMG_UINT32)(offset + length));
+	}
+
+#if defined(PDUMP)
+	psBufObj->bDumped = IMG_FALSE;
+#endif
+
+	GLES2_TIME_STOP(GLES2_TIMES_glFlushMappedBufferRangeEXT);
 }
 
+#endif /* defined(GLES2_EXTENSION_MAP_BUFFER_RANGE) */
+
 /******************************************************************************
  End of file (bufobj.c)
 ******************************************************************************/
@@ -69,6 +69,22 @@ typedef struct GLES2BufferObjectRec
 	/* Is the buffer mapped */
 	IMG_BOOL bMapped;
 
+	/* The mapped range, its GL_MAP_*_BIT_EXT flags and the pointer returned for it.
+	 * glMapBufferOES maps the whole buffer for writing.
+	 */
+	IMG_UINT32 ui32MapOffset;
+	IMG_UINT32 ui32MapLength;
+	IMG_UINT32 ui32MapAccess;
+	IMG_VOID *pvMapPointer;
+
+	/* Host memory mapped instead of storage the TA may still read, written at unmap */
+	IMG_UINT8 *pui8MapStaging;
+	IMG_UINT32 ui32MapStagingSize;
+
+	/* The union of the ranges flushed with glFlushMappedBufferRangeEXT, relative to the mapping */
+	IMG_UINT32 ui32FlushStart;
+	IMG_UINT32 ui32FlushEnd;
+
 #if defined(PDUMP)
 	/* Has this object been pdumped since it was last changed. */
 	IMG_BOOL bDumped;
@@ -77,10 +93,147 @@ typedef struct GLES2BufferObjectRec
 } GLES2BufferObject;
 
 
+/* 
+ * glBufferSubData on a buffer the TA may still read:
+ *
+ *  - An update covering at least 1/GLES2_BUFOBJ_RENAME_FRACTION of the buffer, or any
+ *    update of a buffer no larger than GLES2_BUFOBJ_RENAME_MAX_COPY bytes, ghosts the
+ *    old storage and writes to new storage, copying over the bytes it doesn't replace.
+ *
+ *  - A smaller update of a buffer which isn't part of the current kick is copied to
+ *    the context's staging area, and written to the buffer in order before the buffer is
+ *    next drawn with, mapped or renamed, or before the next kick at the latest.
+ *
+ *  - Anything else waits for the TA as before.
+ */
+#define GLES2_BUFOBJ_RENAME_FRACTION		2
+#define GLES2_BUFOBJ_RENAME_MAX_COPY		(16 * 1024)
+
+#define GLES2_BUFOBJ_STAGING_SIZE			(64 * 1024)
+#define GLES2_BUFOBJ_MAX_STAGED_UPDATES		64
+#define GLES2_BUFOBJ_MAX_STAGED_UPDATE_SIZE	(GLES2_BUFOBJ_STAGING_SIZE / 8)
+
+/*
+ * Storage retired by glBufferData, glDeleteBuffers and destroyed ghosts is kept for
+ * reuse by later allocations:
+ *
+ *  - Bucket i holds sizes in [2^(i + GLES2_BUFOBJ_MEM_POOL_MIN_LOG2), twice that); the
+ *    last bucket holds everything larger. A request may take storage up to 1/
+ *    GLES2_BUFOBJ_MEM_POOL_MAX_WASTE larger than it asked for.
+ *
+ *  - The pool holds at most GLES2_BUFOBJ_MEM_POOL_MAX_BYTES, freeing the storage retired
+ *    longest ago first. It is trimmed to GLES2_BUFOBJ_MEM_POOL_TRIM_BYTES when a context
+ *    is made uncurrent, and emptied when an allocation fails.
+ */
+#define GLES2_BUFOBJ_MEM_POOL_BUCKETS		16
+#define GLES2_BUFOBJ_MEM_POOL_MIN_LOG2		8
+#define GLES2_BUFOBJ_MEM_POOL_MAX_WASTE		4
+#define GLES2_BUFOBJ_MEM_POOL_MAX_BYTES		(4 * 1024 * 1024)
+#define GLES2_BUFOBJ_MEM_POOL_TRIM_BYTES	(1024 * 1024)
+
+/*
+ * glMapBufferRangeEXT on a buffer the TA may still read:
+ *
+ *  - GL_MAP_UNSYNCHRONIZED_BIT_EXT maps the storage without waiting.
+ *
+ *  - GL_MAP_INVALIDATE_BUFFER_BIT_EXT orphans the storage as glBufferData does and maps
+ *    new storage from the pool.
+ *
+ *  - GL_MAP_INVALIDATE_RANGE_BIT_EXT (or an invalidated buffer which can't be orphaned)
+ *    maps host memory, which is written to the buffer like glBufferSubData data at unmap:
+ *    the mapped range, or with GL_MAP_FLUSH_EXPLICIT_BIT_EXT the union of the flushed ranges.
+ *
+ *  - Anything else waits for the TA as glMapBufferOES does.
+ *
+ * One block of host memory of up to GLES2_BUFOBJ_MAP_STAGING_CACHE_SIZE is kept per
+ * context for the next staged mapping.
+ */
+#define GLES2_BUFOBJ_MAP_STAGING_CACHE_SIZE	(256 * 1024)
+
+#define GLES2_BUFOBJ_MAP_ACCESS_BITS		(GL_MAP_READ_BIT_EXT | GL_MAP_WRITE_BIT_EXT |					\
+											 GL_MAP_INVALIDATE_RANGE_BIT_EXT | GL_MAP_INVALIDATE_BUFFER_BIT_EXT |	\
+											 GL_MAP_FLUSH_EXPLICIT_BIT_EXT | GL_MAP_UNSYNCHRONIZED_BIT_EXT)
+
+
+/* The storage a buffer object had before it was renamed or orphaned, kept until the TA is done with it */
+typedef struct GLES2BufferObjectGhostRec
+{
+	/* Ghosts are TA-kick resources */
+	KRMResource sResource;
+
+	PVRSRV_CLIENT_MEM_INFO *psMemInfo;
+
+	IMG_UINT32 ui32AllocAlign;
+
+} GLES2BufferObjectGhost;
+
+
+typedef struct GLES2BufferObjectMemPoolEntryRec
+{
+	PVRSRV_CLIENT_MEM_INFO *psMemInfo;
+
+	IMG_UINT32 ui32AllocAlign;
+
+	/* When the storage was retired, to free the oldest first */
+	IMG_UINT32 ui32Serial;
+
+	struct GLES2BufferObjectMemPoolEntryRec *psNewer;
+	struct GLES2BufferObjectMemPoolEntryRec *psOlder;
+
+} GLES2BufferObjectMemPoolEntry;
+
+
+/* Buffer storage no longer used by any buffer object or ghost */
+typedef struct GLES2BufferObjectMemPoolRec
+{
+	/* Newest and oldest entries of each size bucket */
+	GLES2BufferObjectMemPoolEntry *apsNewest[GLES2_BUFOBJ_MEM_POOL_BUCKETS];
+	GLES2BufferObjectMemPoolEntry *apsOldest[GLES2_BUFOBJ_MEM_POOL_BUCKETS];
+
+	IMG_UINT32 ui32NumEntries;
+	IMG_UINT32 ui32Bytes;
+	IMG_UINT32 ui32Serial;
+
+	/* Statistics, reported when the share group is destroyed */
+	IMG_UINT32 ui32Hits;
+	IMG_UINT32 ui32Misses;
+	IMG_UINT32 ui32Evictions;
+	IMG_UINT32 ui32PeakBytes;
+
+} GLES2BufferObjectMemPool;
+
+
+typedef struct GLES2BufferObjectStagedUpdateRec
+{
+	/* IMG_NULL once written. Holds a reference to the buffer object until then */
+	GLES2BufferObject *psBufObj;
+
+	IMG_UINT32 ui32Offset;
+	IMG_UINT32 ui32Size;
+
+	/* Where the data is in the staging area */
+	IMG_UINT32 ui32DataOffset;
+
+} GLES2BufferObjectStagedUpdate;
+
+
 typedef struct GLES2BufferObjectMachineRec 
 {
 	GLES2BufferObject *psActiveBuffer[GLES2_NUM_BUFOBJ_BINDINGS]; 
 
+	/* Small glBufferSubData updates waiting for the TA to be done with their buffer.
+	 * The staging area is allocated on first use.
+	 */
+	IMG_UINT8 *pui8StagingData;
+	IMG_UINT32 ui32StagingDataUsed;
+
+	GLES2BufferObjectStagedUpdate asStagedUpdate[GLES2_BUFOBJ_MAX_STAGED_UPDATES];
+	IMG_UINT32 ui32NumStagedUpdates;
+
+	/* Host memory kept for the next staged glMapBufferRangeEXT */
+	IMG_UINT8 *pui8MapStagingCache;
+	IMG_UINT32 ui32MapStagingCacheSize;
+
 } GLES2BufferObjectMachine;
 
 
@@ -90,5 +243,10 @@ IMG_VOID SetupBufObjNameArray(GLES2NamesArray *psNamesArray);
 
 IMG_VOID ReclaimBufferObjectMemKRM(IMG_VOID *pvContext, KRMResource *psResource);
 IMG_VOID DestroyBufferObjectGhostKRM(IMG_VOID *pvContext, KRMResource *psResource);
+IMG_VOID FreeBufferObjectMemPool(GLES2Context *gc, GLES2BufferObjectMemPool *psMemPool);
+IMG_VOID TrimBufferObjectMemPool(GLES2Context *gc, IMG_UINT32 ui32MaxBytes);
+
+IMG_VOID FlushStagedBufferUpdates(GLES2Context *gc);
+IMG_VOID FlushStagedBufferUpdatesForDraw(GLES2Context *gc);
 
 #endif /* _BUFOBJ_ */
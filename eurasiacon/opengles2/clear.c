@@ -613,7 +613,8 @@ static GLES2_MEMERROR SetupFragmentShaderForClear(GLES2Context *gc, IMG_UINT32 *
 	*/
 	pui32Buffer = PDSGeneratePixelShaderProgram(IMG_NULL,
 												&sProgram,
-												pui32BufferBase);
+												pui32BufferBase,
+												IMG_NULL);
 
 	/* 
 	   Update buffer position 
@@ -58,6 +58,7 @@
 #include "pds.h"
 #include "texyuv.h"
 #include "texstream.h"
+#include "workpool.h"
 #include "texture.h"
 #include "state.h"
 #include "glsl2uf.h"
@@ -118,6 +119,9 @@ typedef struct GLES2ContextSharedStateTAG
 	/* Keeps track of which buffer objects are attached to any given context */
 	KRMKickResourceManager sBufferObjectKRM;
 
+	/* Storage of destroyed buffer object ghosts, reused by renames. Uses the secondary lock */
+	GLES2BufferObjectMemPool sBufferObjectMemPool;
+
 	/* Dictionaries of GL objects addressed by name. */
 	GLES2NamesArray      *apsNamesArray[GLES2_MAX_SHAREABLE_NAMETYPE]; 
 
@@ -147,6 +151,11 @@ typedef struct GLES2ContextSharedStateTAG
 	IMG_BOOL bMustDumpLineStripStaticIndices;
 #endif
 
+	/* PSP2-specific */
+
+	/* Runs software texture operations; IMG_NULL if they are synchronous */
+	WORKPOOL *psSwTexOpPool;
+
 } GLES2ContextSharedState;
 
 
@@ -279,10 +288,13 @@ struct GLES2Context_TAG
 
 	IMG_PVOID pvUNCHeap;
 	IMG_PVOID pvCDRAMHeap;
-	IMG_PVOID pvUltRuntime;
-	IMG_PVOID pvUltRuntimeWorkArea;
-	IMG_PVOID *pvUltThreadStorage;
-	IMG_UINT32 ui32AsyncTexOpNum;
+	/* Software texture operations: the last one this context submitted and the
+	   last one used by a texture attached since the previous TA kick */
+	WORKPOOL_TOKEN hSwTexOpLastToken;
+	WORKPOOL_TOKEN hSwTexOpKickToken;
+
+	/* Host buffers freed by GLES2FreeAsync and the thread which frees them */
+	struct SWTexOpFreeQueue *psSwTexOpFreeQueue;
 	IMG_BOOL bSwTexOpFin;
 	SceUID hSwTexOpThrd;
 
@@ -30,6 +30,8 @@
 #include "context.h"
 #include "osglue.h"
 
+#include "psp2/swtexop.h"
+
 #define GLES2_NUM_STATIC_INDICES 1024
 
 
@@ -2193,6 +2195,9 @@ static IMG_VOID AttachUsedTexturesToCurrentSurface(GLES2Context *gc, const GLES2
 				{
 					AttachTextureDependency(gc, psTex);
 
+					/* The kick waits for the software operations queued on the texture */
+					SWTexOpAttachTexture(gc, psTex);
+
 					/* Attach this texture to the current frame of the current render surface */
 					KRM_Attach(&gc->psSharedState->psTextureManager->sKRM, gc->psRenderSurface, 
 							   &gc->psRenderSurface->sRenderStatusUpdate, &psTex->sResource);
@@ -2481,6 +2486,9 @@ GL_APICALL void GL_APIENTRY glDrawArrays(GLenum mode, GLint first, GLsizei count
 		return;
 	}
 
+	/* Write any staged glBufferSubData updates to the buffers this draw reads */
+	FlushStagedBufferUpdatesForDraw(gc);
+
 	/* Attach all used resources to the current surface */
 	AttachAllUsedResourcesToCurrentSurface(gc);
 
@@ -2646,6 +2654,9 @@ bad_enum:
 		}
 	}
 
+	/* Write any staged glBufferSubData updates to the buffers this draw reads */
+	FlushStagedBufferUpdatesForDraw(gc);
+
 	/* Attach all used resources to the current surface */
 	AttachAllUsedResourcesToCurrentSurface(gc);
 
@@ -3763,6 +3774,9 @@ bad_value:
 		return;
 	}
 
+	/* Write any staged glBufferSubData updates to the buffers this draw reads */
+	FlushStagedBufferUpdatesForDraw(gc);
+
 	/* Attach all used resources to the current surface */
 	AttachAllUsedResourcesToCurrentSurface(gc);
 
@@ -3942,6 +3956,9 @@ bad_value:
 		}
 	}
 
+	/* Write any staged glBufferSubData updates to the buffers this draw reads */
+	FlushStagedBufferUpdatesForDraw(gc);
+
 	/*
 	 * To avoid spreading loops all over the function   
 	 * operations logically unrelated are grouped together in the following 'for' loop:
@@ -18,8 +18,6 @@
  *****************************************************************************/
 
 #include <string.h> /* For strcmp */
-#include <ult.h>
-#include <libsysmodule.h>
 #include "context.h"
 #include "eglapi.h"
 #include "pvr_debug.h"
@@ -115,6 +113,9 @@ static IMG_VOID FreeContextSharedState(GLES2Context *gc)
 		KRM_WaitForAllResources(&psSharedState->psTextureManager->sKRM,   GLES2_DEFAULT_WAIT_RETRIES);
 		KRM_WaitForAllResources(&psSharedState->sUSEShaderVariantKRM, GLES2_DEFAULT_WAIT_RETRIES);
 
+		/* Finish the software texture operations before their textures go */
+		SWTexOpDestroyPool(psSharedState);
+
 
 		/* Destroy all the shareable resources */
 		for(i = 0; i < GLES2_MAX_SHAREABLE_NAMETYPE; ++i)
@@ -141,9 +142,11 @@ static IMG_VOID FreeContextSharedState(GLES2Context *gc)
 		/* Destroy the USSE code variant manager _before_ destroying the heaps since it uses them */
 		KRM_Destroy(gc, &psSharedState->sUSEShaderVariantKRM);
 
-		/* Destroy the TA kick buffer object manager */
+		/* Destroy the TA kick buffer object manager, then the storage its ghosts retired */
 		KRM_Destroy(gc, &psSharedState->sBufferObjectKRM);
 
+		FreeBufferObjectMemPool(gc, &psSharedState->sBufferObjectMemPool);
+
 
 		/* Free the code heaps _after_ destroying the shaders and programs so the heaps are empty */
 		if(psSharedState->psUSEVertexCodeHeap)
@@ -475,6 +478,12 @@ static IMG_BOOL CreateSharedState(GLES2Context *gc, GLES2Context *psShareContext
 					return IMG_FALSE;
 				}
 			}
+
+			/* Shared so that a texture's operation token means the same to every context */
+			if (!gc->sAppHints.bDisableAsyncTextureOp)
+			{
+				psSharedState->psSwTexOpPool = SWTexOpCreatePool(gc);
+			}
 		}
 	}
 
@@ -633,40 +642,13 @@ static IMG_BOOL InitContext(GLES2Context *gc, GLES2Context *psShareContext, EGLc
 		}
 	}
 
-	sceSysmoduleLoadModuleInternal(SCE_SYSMODULE_INTERNAL_ULT);
-
-	IMG_UINT32 ui32UltRuntimeWorkAreaSize = sceUltUlthreadRuntimeGetWorkAreaSize(gc->sAppHints.ui32SwTexOpMaxUltNum, gc->sAppHints.ui32SwTexOpThreadNum);
-	gc->pvUltRuntimeWorkArea = GLES2Malloc(gc, ui32UltRuntimeWorkAreaSize);
-	gc->pvUltRuntime = GLES2Malloc(gc, _SCE_ULT_ULTHREAD_RUNTIME_SIZE);
-	gc->pvUltThreadStorage = GLES2Malloc(gc, 4 * gc->sAppHints.ui32SwTexOpMaxUltNum);
-	GLES2MemSet(gc->pvUltThreadStorage, 0, 4 * gc->sAppHints.ui32SwTexOpMaxUltNum);
-
-	SceUltUlthreadRuntimeOptParam sUltOptParam;
-	sceUltUlthreadRuntimeOptParamInitialize(&sUltOptParam);
-	sUltOptParam.oneShotThreadStackSize = 4 * 1024 + (4 * 1024 * (IMG_UINT32)((IMG_FLOAT)gc->sAppHints.ui32SwTexOpMaxUltNum / 4.0f));
-	sUltOptParam.workerThreadAttr = 0;
-	sUltOptParam.workerThreadCpuAffinityMask = gc->sAppHints.ui32SwTexOpThreadAffinity;
-	sUltOptParam.workerThreadOptParam = 0;
-	sUltOptParam.workerThreadPriority = gc->sAppHints.ui32SwTexOpThreadPriority;
-
-	i = sceUltUlthreadRuntimeCreate(gc->pvUltRuntime,
-		"OGLES2UltRuntime",
-		gc->sAppHints.ui32SwTexOpMaxUltNum,
-		gc->sAppHints.ui32SwTexOpThreadNum,
-		gc->pvUltRuntimeWorkArea,
-		&sUltOptParam);
-
-	if (i != SCE_OK)
+	if (!SWTexOpInit(gc))
 	{
-		PVR_DPF((PVR_DBG_ERROR, "InitContext: Couldn't create ULT runtime: 0x%X", i));
+		PVR_DPF((PVR_DBG_ERROR, "InitContext: Couldn't initialise software texture operations"));
 
-		goto FAILED_sceUltUlthreadRuntimeCreate;
+		goto FAILED_SWTexOpInit;
 	}
 
-	gc->bSwTexOpFin = IMG_FALSE;
-	gc->hSwTexOpThrd = sceKernelCreateThread("OGLES2AsyncTexOpCl", texOpAsyncCleanupThread, SCE_KERNEL_LOWEST_PRIORITY_USER, SCE_KERNEL_4KiB, 0, 0, SCE_NULL);
-	sceKernelStartThread(gc->hSwTexOpThrd, 4, &gc);
-
 #if defined(GLES2_EXTENSION_VERTEX_ARRAY_OBJECT)
 	/* Initialize the unshareable names arrays */
 	for (i = 0; i < GLES2_MAX_UNSHAREABLE_NAMETYPE; i++)
@@ -708,6 +690,13 @@ static IMG_BOOL InitContext(GLES2Context *gc, GLES2Context *psShareContext, EGLc
 
 	}
 
+	if(!HashTableCreate(gc, &gc->sPrim.sPDSVertexProgramHashTable, GLES2_PDS_VERTEX_PROGRAM_CACHE_LOG2SIZE, GLES2_PDS_VERTEX_PROGRAM_CACHE_MAXENTRIES, DestroyHashedPDSVertexProgram))
+	{
+		PVR_DPF((PVR_DBG_ERROR,"InitContext: HashTableCreate failed for PDS vertex programs"));
+
+		goto FAILED_CreatePDSVertexHashTable;
+	}
+
 	if(!CreateTextureState(gc))
 	{
 		PVR_DPF((PVR_DBG_ERROR,"InitContext: CreateTextureState failed"));
@@ -1039,6 +1028,10 @@ FAILED_CreateProgramState:
 
 FAILED_CreateTextureState:
 
+	HashTableDestroy(gc, &gc->sPrim.sPDSVertexProgramHashTable);
+
+FAILED_CreatePDSVertexHashTable:
+
 	HashTableDestroy(gc, &gc->sProgram.sPDSFragmentVariantHashTable);
 
 FAILED_CreateHashTable:
@@ -1047,14 +1040,11 @@ FAILED_CreateHashTable:
 
 FAILED_TASync:
 
-	FreeContextSharedState(gc);
+	SWTexOpDeInit(gc);
 
-	GLES2Free(IMG_NULL, gc->pvUltThreadStorage);
-	sceUltUlthreadRuntimeDestroy((SceUltUlthreadRuntime *)gc->pvUltRuntime);
-	GLES2Free(IMG_NULL, gc->pvUltRuntimeWorkArea);
-	GLES2Free(IMG_NULL, gc->pvUltRuntime);
+FAILED_SWTexOpInit:
 
-FAILED_sceUltUlthreadRuntimeCreate:
+	FreeContextSharedState(gc);
 
 	if (gc->pvUNCHeap)
 	{
@@ -1124,6 +1114,7 @@ static IMG_BOOL DeInitContext(GLES2Context *gc)
 	KRM_Destroy(gc, &gc->sVAOKRM);
 
 	HashTableDestroy(gc, &gc->sProgram.sPDSFragmentVariantHashTable);
+	HashTableDestroy(gc, &gc->sPrim.sPDSVertexProgramHashTable);
 
 	if(!FreeTextureState(gc))
 	{
@@ -1138,6 +1129,9 @@ static IMG_BOOL DeInitContext(GLES2Context *gc)
 	/* FrameBuffers must be freed _after_ freeing textures due to FBOs. See FreeTexture() */
 	FreeFrameBufferState(gc);
 
+	/* Before the shared state, whose work pool the cleanup thread waits on */
+	SWTexOpDeInit(gc);
+
 	FreeContextSharedState(gc);
 
 	/* TexStreamsState must be freed after freeing all the default and named textures, 
@@ -1175,9 +1169,6 @@ static IMG_BOOL DeInitContext(GLES2Context *gc)
 	PVRUniPatchDestroyContext(gc->sProgram.pvUniPatchContext);
 	gc->sProgram.pvUniPatchContext = IMG_NULL;
 
-	gc->bSwTexOpFin = IMG_TRUE;
-	sceKernelWaitThreadEnd(gc->hSwTexOpThrd, SCE_NULL, SCE_NULL);
-
 	if (gc->pvUNCHeap)
 	{
 		sceHeapDeleteHeap(gc->pvUNCHeap);
@@ -1187,11 +1178,6 @@ static IMG_BOOL DeInitContext(GLES2Context *gc)
 		sceHeapDeleteHeap(gc->pvCDRAMHeap);
 	}
 
-	GLES2Free(IMG_NULL, gc->pvUltThreadStorage);
-	sceUltUlthreadRuntimeDestroy((SceUltUlthreadRuntime *)gc->pvUltRuntime);
-	GLES2Free(IMG_NULL, gc->pvUltRuntimeWorkArea);
-	GLES2Free(IMG_NULL, gc->pvUltRuntime);
-
 	return bPass;
 }	
 
@@ -1433,9 +1419,13 @@ static IMG_VOID GLES2MakeUnCurrentGC(void)
 	KRM_RemoveAttachmentPointReferences(&gc->psSharedState->psTextureManager->sKRM, psSurface);
 	KRM_RemoveAttachmentPointReferences(&gc->psSharedState->sUSEShaderVariantKRM, psSurface);
 
-	/* Get rid of texture and shader ghosts */
+	/* Get rid of texture, shader and buffer object ghosts */
 	KRM_DestroyUnneededGhosts(gc, &gc->psSharedState->psTextureManager->sKRM);
 	KRM_DestroyUnneededGhosts(gc, &gc->psSharedState->sUSEShaderVariantKRM);
+	KRM_DestroyUnneededGhosts(gc, &gc->psSharedState->sBufferObjectKRM);
+
+	/* Keep some retired buffer storage for when the share group is next used */
+	TrimBufferObjectMemPool(gc, GLES2_BUFOBJ_MEM_POOL_TRIM_BYTES);
 
 	KRM_RemoveAttachmentPointReferences(&gc->psSharedState->sBufferObjectKRM, gc);
 
@@ -1760,6 +1750,11 @@ static GetProcAddressReturnFunc GLES2GetProcAddress(const char *procname)
 	COMPARE_AND_RETURN(glDiscardFramebufferEXT)
 #endif /* GLES2_EXTENSION_DISCARD_FRAMEBUFFER */
 
+#if defined(GLES2_EXTENSION_MAP_BUFFER_RANGE)
+	COMPARE_AND_RETURN(glMapBufferRangeEXT)
+	COMPARE_AND_RETURN(glFlushMappedBufferRangeEXT)
+#endif /* GLES2_EXTENSION_MAP_BUFFER_RANGE */
+
 #if defined(GLES2_EXTENSION_MULTISAMPLED_RENDER_TO_TEXTURE)
 	COMPARE_AND_RETURN(glRenderbufferStorageMultisampleIMG)
 	COMPARE_AND_RETURN(glFramebufferTexture2DMultisampleIMG)
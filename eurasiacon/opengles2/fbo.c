@@ -3750,6 +3750,9 @@ bad_op:
 			goto bad_op;
 		}
 
+		/* Rendering must not race a queued software operation writing the same memory */
+		SWTexOpWaitTexture(gc, psTex);
+
 		psFrameBuffer->apsAttachment[ui32Attachment] = (GLES2FrameBufferAttachable*)
 			&psTex->psMipLevel[ui32Face*GLES2_MAX_TEXTURE_MIPMAP_LEVELS + (IMG_UINT32)level];
 
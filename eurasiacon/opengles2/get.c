@@ -1161,7 +1161,7 @@ GL_API_EXT void APIENTRY glGetBufferPointervOES(GLenum target, GLenum pname, voi
 		{
 			if (psBufObj->bMapped)
 			{
-				*params = (void *)psBufObj->psMemInfo->pvLinAddr;
+				*params = psBufObj->pvMapPointer;
 			}
 			else
 			{
@@ -1422,7 +1422,7 @@ GL_APICALL void GL_APIENTRY glGetProgramiv(GLuint program, GLenum pname, GLint *
 					}
 					sCodeFrag.eActiveVaryingMask	   = psFragment->eActiveVaryingMask;
 					sCodeFrag.psUniPatchInput		   = PVRUniPatchCreatePCShader(gc->sProgram.pvUniPatchContext, (PUSP_SHADER)   psFragment->pvUniPatchShader);
-					if(psFragment->pvUniPatchShaderMSAATrans)
+					if(GetUniPatchShaderMSAATrans(gc, psFragment))
 					{
 						sCodeFrag.psUniPatchInputMSAATrans = PVRUniPatchCreatePCShader(gc->sProgram.pvUniPatchContext, (PUSP_SHADER)   psFragment->pvUniPatchShaderMSAATrans);
 					}
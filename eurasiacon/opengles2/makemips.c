@@ -24,6 +24,8 @@
 #include "context.h"
 #include <stdio.h>
 
+#include "psp2/swtexop.h"
+
 typedef struct 
 {
 	IMG_UINT32 ui32Width;
@@ -1455,6 +1457,9 @@ IMG_BOOL IMG_INTERNAL MakeTextureMipmapLevels(GLES2Context *gc, GLES2Texture *ps
 	if(psLevel->ui32Width == 1 && psLevel->ui32Height == 1)
 		return IMG_TRUE;
 
+	/* The levels are generated from what the queued software operations write */
+	SWTexOpWaitTexture(gc, psTex);
+
 	/* HW mipmap gen is implemented */
 
 	if (!gc->sAppHints.bDisableHWTQMipGen &&
@@ -395,6 +395,40 @@ IMG_INTERNAL IMG_VOID OutputMetrics(GLES2Context *gc)
 		PVR_TRACE((" PDS Variant hit/miss totals"));
 		PVR_TRACE((" PDSPixelShaderProgram - variant hit     %10d", gc->asTimes[GLES2_TIMER_PDSVARIANT_HIT_COUNT].ui32Count));
 		PVR_TRACE((" PDSPixelShaderProgram - variant miss    %10d", gc->asTimes[GLES2_TIMER_PDSVARIANT_MISS_COUNT].ui32Count));
+		PVR_TRACE((" PDSPixelShaderProgram - miss patched    %10d", gc->asTimes[GLES2_TIMER_PDSVARIANT_PATCH_COUNT].ui32Count));
+		PVR_TRACE((" PDSVertexShaderProgram - cache hit      %10d", gc->asTimes[GLES2_TIMER_PDS_VERTEX_PROGRAM_CACHE_HIT_COUNT].ui32Count));
+		PVR_TRACE((" PDSVertexShaderProgram - cache miss     %10d", gc->asTimes[GLES2_TIMER_PDS_VERTEX_PROGRAM_CACHE_MISS_COUNT].ui32Count));
+
+		PVR_TRACE((" "));
+
+		PVR_TRACE((" USE Variant hit/miss totals"));
+		PVR_TRACE((" USEShaderVariant - variant hit          %10d", gc->asTimes[GLES2_TIMER_USE_VARIANT_HIT_COUNT].ui32Count));
+		PVR_TRACE((" USEShaderVariant - variant miss         %10d", gc->asTimes[GLES2_TIMER_USE_VARIANT_MISS_COUNT].ui32Count));
+		PVR_TRACE((" USEShaderVariant - variant evicted      %10d", gc->asTimes[GLES2_TIMER_USE_VARIANT_EVICT_COUNT].ui32Count));
+
+		PVR_TRACE((" "));
+
+		PVR_TRACE((" BufferSubData on a buffer the TA uses totals"));
+		PVR_TRACE((" BufferSubData - waited for the TA       %10d", gc->asTimes[GLES2_TIMER_BUFSUBDATA_WAIT_COUNT].ui32Count));
+		PVR_TRACE((" BufferSubData - renamed the buffer      %10d", gc->asTimes[GLES2_TIMER_BUFSUBDATA_RENAME_COUNT].ui32Count));
+		PVR_TRACE((" BufferSubData - staged the update       %10d", gc->asTimes[GLES2_TIMER_BUFSUBDATA_STAGE_COUNT].ui32Count));
+		PVR_TRACE((" Staged updates written (ms)             %10.4f", gc->asTimes[GLES2_TIMER_BUFOBJ_STAGING_FLUSH_TIME].ui32Total*gc->fCPUSpeed));
+
+		PVR_TRACE((" "));
+
+		PVR_TRACE((" Buffer storage pool hit/miss totals"));
+		PVR_TRACE((" BufferStorage - pool hit                %10d", gc->asTimes[GLES2_TIMER_BUFOBJ_POOL_HIT_COUNT].ui32Count));
+		PVR_TRACE((" BufferStorage - pool miss               %10d", gc->asTimes[GLES2_TIMER_BUFOBJ_POOL_MISS_COUNT].ui32Count));
+		PVR_TRACE((" BufferStorage - pool evicted            %10d", gc->asTimes[GLES2_TIMER_BUFOBJ_POOL_EVICT_COUNT].ui32Count));
+		PVR_TRACE((" BufferData - orphaned busy storage      %10d", gc->asTimes[GLES2_TIMER_BUFDATA_ORPHAN_COUNT].ui32Count));
+
+		PVR_TRACE((" "));
+
+		PVR_TRACE((" MapBufferRange on a buffer the TA uses totals"));
+		PVR_TRACE((" MapBufferRange - waited for the TA      %10d", gc->asTimes[GLES2_TIMER_MAPRANGE_WAIT_COUNT].ui32Count));
+		PVR_TRACE((" MapBufferRange - unsynchronized         %10d", gc->asTimes[GLES2_TIMER_MAPRANGE_UNSYNCHRONIZED_COUNT].ui32Count));
+		PVR_TRACE((" MapBufferRange - orphaned the storage   %10d", gc->asTimes[GLES2_TIMER_MAPRANGE_ORPHAN_COUNT].ui32Count));
+		PVR_TRACE((" MapBufferRange - mapped staging memory  %10d", gc->asTimes[GLES2_TIMER_MAPRANGE_STAGED_COUNT].ui32Count));
 
 		PVR_TRACE((" "));
 
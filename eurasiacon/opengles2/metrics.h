@@ -150,6 +150,30 @@ IMG_VOID GetFrameTime(GLES2Context *gc);
 #define GLES2_TIMER_SGXKICKTA_FLUSHFRAMEBUFFER_COUNT				93
 #define GLES2_TIMER_SGXKICKTA_BUFDATA_COUNT				94
 
+#define GLES2_TIMER_PDS_VERTEX_PROGRAM_CACHE_HIT_COUNT	95
+#define GLES2_TIMER_PDS_VERTEX_PROGRAM_CACHE_MISS_COUNT	96
+
+#define GLES2_TIMER_USE_VARIANT_HIT_COUNT				97
+#define GLES2_TIMER_USE_VARIANT_MISS_COUNT				98
+#define GLES2_TIMER_USE_VARIANT_EVICT_COUNT				99
+
+#define GLES2_TIMER_BUFSUBDATA_WAIT_COUNT				100
+#define GLES2_TIMER_BUFSUBDATA_RENAME_COUNT				101
+#define GLES2_TIMER_BUFSUBDATA_STAGE_COUNT				102
+#define GLES2_TIMER_BUFOBJ_STAGING_FLUSH_TIME			103
+
+#define GLES2_TIMER_BUFOBJ_POOL_HIT_COUNT				104
+#define GLES2_TIMER_BUFOBJ_POOL_MISS_COUNT				105
+#define GLES2_TIMER_BUFOBJ_POOL_EVICT_COUNT				106
+#define GLES2_TIMER_BUFDATA_ORPHAN_COUNT				107
+
+#define GLES2_TIMER_MAPRANGE_WAIT_COUNT					108
+#define GLES2_TIMER_MAPRANGE_UNSYNCHRONIZED_COUNT		109
+#define GLES2_TIMER_MAPRANGE_ORPHAN_COUNT				110
+#define GLES2_TIMER_MAPRANGE_STAGED_COUNT				111
+
+#define GLES2_TIMER_PDSVARIANT_PATCH_COUNT				112
+
 /* entry point times */
 #define GLES2_TIMES_glActiveTexture					140
 #define GLES2_TIMES_glAttachShader					141
@@ -320,7 +344,10 @@ IMG_VOID GetFrameTime(GLES2Context *gc);
 
 #define GLES2_TIMES_glDiscardFramebufferEXT					300
 
-#define GLES2_NUM_TIMERS					(GLES2_TIMES_glDiscardFramebufferEXT + 1)
+#define GLES2_TIMES_glMapBufferRangeEXT						301
+#define GLES2_TIMES_glFlushMappedBufferRangeEXT				302
+
+#define GLES2_NUM_TIMERS					(GLES2_TIMES_glFlushMappedBufferRangeEXT + 1)
 
 
 #define GLES2_CALLS(X)				    PVR_MTR_CALLS(gc->asTimes[X])
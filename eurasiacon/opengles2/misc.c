@@ -77,6 +77,9 @@ static const IMG_UINT32 ui32ExtensionFlag = /*
 #if defined(GLES2_EXTENSION_DISCARD_FRAMEBUFFER)
                                             GLES2_EXTENSION_BIT_DISCARD_FRAMEBUFFER |
 #endif
+#if defined(GLES2_EXTENSION_MAP_BUFFER_RANGE)
+											GLES2_EXTENSION_BIT_MAP_BUFFER_RANGE |
+#endif
 #if defined(EGL_EXTENSION_KHR_FENCE_SYNC)
 											GLES2_EXTENSION_BIT_EGL_SYNC |
 #endif
@@ -125,6 +128,7 @@ static const struct GLES2_Extension_TAG
 	{	"GL_EXT_multi_draw_arrays ",			GLES2_EXTENSION_BIT_DRAW_ARRAYS				},
 	{	"GL_EXT_texture_format_BGRA8888 ",		GLES2_EXTENSION_BIT_TEXTURE_FORMAT_BGRA8888	},
 	{	"GL_EXT_discard_framebuffer ",			GLES2_EXTENSION_BIT_DISCARD_FRAMEBUFFER		},
+	{	"GL_EXT_map_buffer_range ",				GLES2_EXTENSION_BIT_MAP_BUFFER_RANGE		},
 	{	"GL_EXT_shader_texture_lod ",			GLES2_EXTENSION_BIT_SHADER_TEXTURE_LOD		},
 
 	{	"GL_IMG_shader_binary ",				GLES2_EXTENSION_BIT_IMG_SHADER_BINARY		},
@@ -725,11 +729,9 @@ IMG_INTERNAL IMG_BOOL GetApplicationHints(GLESAppHints *psAppHints, EGLcontextMo
 	ui32Default = 0;
 	PVRSRVGetAppHint(pvHintState, "SwTexOpThreadAffinity", IMG_UINT_TYPE, &ui32Default, &psAppHints->ui32SwTexOpThreadAffinity);
 
+	/* Still named after the ULTs it used to limit; SwTexOpCleanupDelay is no longer used */
 	ui32Default = 256;
-	PVRSRVGetAppHint(pvHintState, "SwTexOpMaxUltNum", IMG_UINT_TYPE, &ui32Default, &psAppHints->ui32SwTexOpMaxUltNum);
-
-	ui32Default = 1000000;
-	PVRSRVGetAppHint(pvHintState, "SwTexOpCleanupDelay", IMG_UINT_TYPE, &ui32Default, &psAppHints->ui32SwTexOpCleanupDelay);
+	PVRSRVGetAppHint(pvHintState, "SwTexOpMaxUltNum", IMG_UINT_TYPE, &ui32Default, &psAppHints->ui32SwTexOpMaxJobs);
 
 	ui32Default = 1;
 	PVRSRVGetAppHint(pvHintState, "DisableAsyncTextureOp", IMG_UINT_TYPE, &ui32Default, &psAppHints->bDisableAsyncTextureOp);
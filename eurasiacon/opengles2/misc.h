@@ -50,6 +50,7 @@
 #define GLES2_EXTENSION_BIT_VERTEX_ARRAY_OBJECT         0x00800000
 #define GLES2_EXTENSION_BIT_DISCARD_FRAMEBUFFER         0x01000000
 #define GLES2_EXTENSION_BIT_EGL_SYNC                    0x02000000
+#define GLES2_EXTENSION_BIT_MAP_BUFFER_RANGE			0x04000000
 #define GLES2_EXTENSION_BIT_MULTISAMPLED_RENDER_TO_TEX	0x08000000
 #define GLES2_EXTENSION_BIT_SHADER_TEXTURE_LOD			0x10000000
 #define GLES2_EXTENSION_BIT_EGL_IMAGE_EXTERNAL			0x20000000
@@ -146,8 +147,7 @@ typedef struct GLESAppHintsRec
 	IMG_UINT32 ui32SwTexOpThreadNum;
 	IMG_UINT32 ui32SwTexOpThreadPriority;
 	IMG_UINT32 ui32SwTexOpThreadAffinity;
-	IMG_UINT32 ui32SwTexOpMaxUltNum;
-	IMG_UINT32 ui32SwTexOpCleanupDelay;
+	IMG_UINT32 ui32SwTexOpMaxJobs;
 	IMG_BOOL bDisableAsyncTextureOp;
 	IMG_UINT32 ui32PrimitiveSplitThreshold;
 	IMG_UINT32 ui32MaxDrawCallsPerCore;
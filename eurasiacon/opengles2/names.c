@@ -581,6 +581,30 @@ IMG_INTERNAL GLES2NamedItem* NamedItemAddRef(GLES2NamesArray *psNamesArray, IMG_
 }
 
 
+/***********************************************************************************
+ Function Name      : NamedItemAddRefByItem
+ Inputs             : gc, psNamesArray, psNamedItem
+ Outputs            : -
+ Returns            : -
+ Description        : Increments the reference counter of an item the caller already
+					  holds a reference to, whether or not its name is still in use.
+************************************************************************************/
+IMG_INTERNAL IMG_VOID NamedItemAddRefByItem(GLES2Context *gc, GLES2NamesArray *psNamesArray, GLES2NamedItem *psNamedItem)
+{
+	PVR_UNREFERENCED_PARAMETER(gc);
+
+	GLES2_TIME_START(GLES2_TIMER_NAMES_ARRAY);
+	LOCK_NAMES_ARRAY(psNamesArray);
+
+	GLES_ASSERT(psNamedItem->ui32RefCount > 0);
+
+	psNamedItem->ui32RefCount++;
+
+	UNLOCK_NAMES_ARRAY(psNamesArray);
+	GLES2_TIME_STOP(GLES2_TIMER_NAMES_ARRAY);
+}
+
+
 /***********************************************************************************
  Function Name      : NamedItemDelRef
  Inputs             : gc, psNamesArray, psNamedItem
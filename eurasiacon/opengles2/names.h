@@ -137,6 +137,10 @@ IMG_BOOL InsertNamedItem(GLES2NamesArray *psNamesArray, GLES2NamedItem* psNamedI
 GLES2NamedItem* NamedItemAddRef(GLES2NamesArray *psNamesArray, IMG_UINT32 ui32Name);
 
 
+/* Increases the refcount of an item the caller already holds a reference to */
+IMG_VOID NamedItemAddRefByItem(GLES2Context *gc, GLES2NamesArray *psNamesArray, GLES2NamedItem *psNamedItem);
+
+
 /* Decreases the refcount of an item. The object is deleted when this function is 
  * called one more time than NamedItemAddRef had been called before.
  */
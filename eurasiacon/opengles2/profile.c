@@ -193,7 +193,10 @@ static IMG_CHAR* const pszFunctionNames[] =
 	"glGenVertexArraysOES                    ",
 	"glIsVertexArrayOES                      ",
 
-	"glDiscardFramebufferEXT                 "
+	"glDiscardFramebufferEXT                 ",
+
+	"glMapBufferRangeEXT                     ",
+	"glFlushMappedBufferRangeEXT             "
 };
 
 
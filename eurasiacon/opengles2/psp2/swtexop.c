@@ -1,280 +1,526 @@
 ﻿
 #include <kernel.h>
-#include <ult.h>
 
 #include "..\context.h"
 #include "..\texture.h"
 #include "swtexop.h"
 
-int32_t sceKernelAtomicAddAndGet32(volatile int32_t* ptr, int32_t value);
+/*
+	Software texture operations run as jobs on a work pool (workpool.h) shared by
+	all the contexts of a share group, so the token a texture keeps for its last
+	operation means the same to each of them. The device memory an operation
+	writes has a pending write op from submission until the job completes it,
+	which is what the GPU and ReadBackTextureData wait for; CPU paths which touch
+	the texture otherwise wait for the texture's token.
+*/
 
-static IMG_VOID *pvAsDstPtr[8192];
+#define SWTEXOP_POOL_NAME	"OGLES2SwTexOp"
 
-static IMG_INT32 _SWTextureUploadEntry(IMG_UINT32 arg)
+static IMG_VOID _SWTextureUploadEntry(IMG_VOID *pvData)
 {
-	SWTexUploadArg *psArg = (SWTexUploadArg *)arg;
+	SWTexUploadArg *psArg = (SWTexUploadArg *)pvData;
 
 	TextureUpload(&psArg->psTex, &psArg->psMipLevel, psArg->ui32OffsetInBytes, &psArg->psTexFmt, psArg->ui32Face, psArg->ui32Lod, psArg->ui32TopUsize, psArg->ui32TopVsize);
 
-	sceKernelAtomicAddAndGet32(&psArg->gc->ui32AsyncTexOpNum, -1);
-
 	PVRSRVModifyCompleteSyncOps(psArg->gc->psSysContext->psConnection, psArg->hOpSyncObj);
 	PVRSRVDestroySyncInfoModObj(psArg->gc->psSysContext->psConnection, psArg->hOpSyncObj);
-
-	GLES2Free(IMG_NULL, psArg);
-
-	return sceUltUlthreadExit(0);
 }
 
-static IMG_INT32 _SWTextureMipGenEntry(IMG_UINT32 arg)
+static IMG_VOID _SWTextureMipGenEntry(IMG_VOID *pvData)
 {
-	SWTexMipGenArg *psArg = (SWTexMipGenArg *)arg;
+	SWTexMipGenArg *psArg = (SWTexMipGenArg *)pvData;
 
 	MakeTextureMipmapLevelsSoftware(psArg->gc, psArg->psTex, psArg->ui32Face, psArg->ui32MaxFace, psArg->bIsNonPow2);
 
-	sceKernelAtomicAddAndGet32(&psArg->gc->ui32AsyncTexOpNum, -1);
-
 	if (psArg->psSyncInfo)
 	{
 		PVRSRVModifyCompleteSyncOps(psArg->gc->psSysContext->psConnection, psArg->hOpSyncObj);
 		PVRSRVDestroySyncInfoModObj(psArg->gc->psSysContext->psConnection, psArg->hOpSyncObj);
 	}
-
-	GLES2Free(IMG_NULL, psArg);
-
-	return sceUltUlthreadExit(0);
 }
 
-IMG_INTERNAL IMG_VOID SWTextureUpload(
-	GLES2Context *gc, GLES2Texture *psTex, GLES2MipMapLevel *psMipLevel, IMG_UINT32 ui32OffsetInBytes, GLES2TextureFormat *psTexFmt,
-	IMG_UINT32 ui32Face, IMG_UINT32 ui32Lod, IMG_UINT32 ui32TopUsize, IMG_UINT32 ui32TopVsize)
+/***********************************************************************************
+ Function Name      : SWTexOpAddPendingWrite
+ Inputs             : gc, psSyncInfo
+ Outputs            : phOpSyncObj
+ Returns            : -
+ Description        : Waits for blits to the texture memory, then takes a write op
+					  on it which the job completes.
+************************************************************************************/
+static IMG_VOID SWTexOpAddPendingWrite(GLES2Context *gc, PVRSRV_CLIENT_SYNC_INFO *psSyncInfo, IMG_SID *phOpSyncObj)
 {
 	PVRSRV_ERROR eResult;
-	IMG_INT32 i;
-	IMG_INT32 ret;
-	IMG_PVOID arg = GLES2Malloc(gc, sizeof(SWTexUploadArg));
-	SWTexUploadArg *psArg = (SWTexUploadArg *)arg;
-	psArg->gc = gc;
-	GLES2MemCopy(&psArg->psTex, psTex, sizeof(GLES2Texture));
-	GLES2MemCopy(&psArg->psMipLevel, psMipLevel, sizeof(GLES2MipMapLevel));
-	GLES2MemCopy(&psArg->psTexFmt, psTexFmt, sizeof(GLES2TextureFormat));
-	psArg->ui32OffsetInBytes = ui32OffsetInBytes;
-	psArg->ui32Face = ui32Face;
-	psArg->ui32Lod = ui32Lod;
-	psArg->ui32TopUsize = ui32TopUsize;
-	psArg->ui32TopVsize = ui32TopVsize;
-
-#if defined(GLES2_EXTENSION_EGL_IMAGE)
-	if (psTex->psEGLImageTarget)
-	{
-		psArg->psSyncInfo = psTex->psEGLImageTarget->psMemInfo->psClientSyncInfo;
-	}
-	else
-#endif /* defined(GLES2_EXTENSION_EGL_IMAGE) */
-	{
-		psArg->psSyncInfo = psTex->psMemInfo->psClientSyncInfo;
-	}
 
 	do
 	{
-		eResult = SGX2DQueryBlitsComplete(gc->ps3DDevData, psArg->psSyncInfo, IMG_TRUE);
+		eResult = SGX2DQueryBlitsComplete(gc->ps3DDevData, psSyncInfo, IMG_TRUE);
 	} while (eResult == PVRSRV_ERROR_TIMEOUT);
 
-	PVRSRVCreateSyncInfoModObj(gc->psSysContext->psConnection, &psArg->hOpSyncObj);
+	PVRSRVCreateSyncInfoModObj(gc->psSysContext->psConnection, phOpSyncObj);
 
 	PVRSRVModifyPendingSyncOps(
 		gc->psSysContext->psConnection,
-		psArg->hOpSyncObj,
-		&psArg->psSyncInfo,
+		*phOpSyncObj,
+		&psSyncInfo,
 		1,
 		PVRSRV_MODIFYSYNCOPS_FLAGS_WO_INC,
 		IMG_NULL,
 		IMG_NULL);
+}
 
-	sceKernelAtomicAddAndGet32(&gc->ui32AsyncTexOpNum, 1);
+/***********************************************************************************
+ Function Name      : SWTexOpSubmit
+ Inputs             : gc, psTex, pfnJob, pvArg, ui32ArgSize
+ Outputs            : -
+ Returns            : -
+ Description        : Queues a job on the texture. Jobs on one texture run in order
+					  because each one waits for the texture's previous job first
+					  (see TranslateLevel and MakeTextureMipmapLevels).
+************************************************************************************/
+static IMG_VOID SWTexOpSubmit(GLES2Context *gc, GLES2Texture *psTex, PFN_WORKPOOL_JOB pfnJob, const IMG_VOID *pvArg, IMG_UINT32 ui32ArgSize)
+{
+	WORKPOOL_TOKEN hToken = WorkPoolSubmit(gc->psSharedState->psSwTexOpPool, pfnJob, pvArg, ui32ArgSize);
+
+	psTex->hSwTexOpToken = hToken;
+	gc->hSwTexOpLastToken = hToken;
+}
 
-	for (i = 0; i < gc->sAppHints.ui32SwTexOpMaxUltNum; i++)
+IMG_INTERNAL IMG_VOID SWTextureUpload(
+	GLES2Context *gc, GLES2Texture *psTex, GLES2MipMapLevel *psMipLevel, IMG_UINT32 ui32OffsetInBytes, GLES2TextureFormat *psTexFmt,
+	IMG_UINT32 ui32Face, IMG_UINT32 ui32Lod, IMG_UINT32 ui32TopUsize, IMG_UINT32 ui32TopVsize)
+{
+	SWTexUploadArg sArg;
+
+	if (!gc->psSharedState->psSwTexOpPool)
 	{
-		if (gc->pvUltThreadStorage[i] == IMG_NULL)
-		{
-			gc->pvUltThreadStorage[i] = GLES2Malloc(gc, _SCE_ULT_ULTHREAD_SIZE);
-			break;
-		}
+		TextureUpload(psTex, psMipLevel, ui32OffsetInBytes, psTexFmt, ui32Face, ui32Lod, ui32TopUsize, ui32TopVsize);
+
+		return;
 	}
 
-	ret = sceUltUlthreadCreate(
-		gc->pvUltThreadStorage[i],
-		"OGLES2SWTextureUpload",
-		_SWTextureUploadEntry,
-		(IMG_UINT32)arg,
-		SCE_NULL,
-		0,
-		gc->pvUltRuntime,
-		SCE_NULL);
-
-	if (ret != SCE_OK)
+	sArg.gc = gc;
+	GLES2MemCopy(&sArg.psTex, psTex, sizeof(GLES2Texture));
+	GLES2MemCopy(&sArg.psMipLevel, psMipLevel, sizeof(GLES2MipMapLevel));
+	GLES2MemCopy(&sArg.psTexFmt, psTexFmt, sizeof(GLES2TextureFormat));
+	sArg.ui32OffsetInBytes = ui32OffsetInBytes;
+	sArg.ui32Face = ui32Face;
+	sArg.ui32Lod = ui32Lod;
+	sArg.ui32TopUsize = ui32TopUsize;
+	sArg.ui32TopVsize = ui32TopVsize;
+
+#if defined(GLES2_EXTENSION_EGL_IMAGE)
+	if (psTex->psEGLImageTarget)
+	{
+		sArg.psSyncInfo = psTex->psEGLImageTarget->psMemInfo->psClientSyncInfo;
+	}
+	else
+#endif /* defined(GLES2_EXTENSION_EGL_IMAGE) */
 	{
-		PVR_DPF((PVR_DBG_ERROR, "sceUltUlthreadCreate failed with code 0x%X. Consider increasing apphint SwTexOpMaxUltNum value", ret));
-		abort();
+		sArg.psSyncInfo = psTex->psMemInfo->psClientSyncInfo;
 	}
+
+	SWTexOpAddPendingWrite(gc, sArg.psSyncInfo, &sArg.hOpSyncObj);
+
+	SWTexOpSubmit(gc, psTex, _SWTextureUploadEntry, &sArg, sizeof(sArg));
 }
 
 IMG_INTERNAL IMG_BOOL SWMakeTextureMipmapLevels(GLES2Context *gc, GLES2Texture *psTex, IMG_UINT32 ui32Face, IMG_UINT32 ui32MaxFace, IMG_BOOL bIsNonPow2)
 {
-	PVRSRV_ERROR eResult;
-	IMG_INT32 i;
-	IMG_INT32 ret;
-	IMG_PVOID arg = GLES2Malloc(gc, sizeof(SWTexMipGenArg));
-	SWTexMipGenArg *psArg = (SWTexMipGenArg *)arg;
-	psArg->gc = gc;
-	psArg->psTex = psTex;
-	psArg->ui32Face = ui32Face;
-	psArg->ui32MaxFace = ui32MaxFace;
-	psArg->bIsNonPow2 = bIsNonPow2;
+	SWTexMipGenArg sArg;
+
+	if (!gc->psSharedState->psSwTexOpPool)
+	{
+		MakeTextureMipmapLevelsSoftware(gc, psTex, ui32Face, ui32MaxFace, bIsNonPow2);
+
+		return IMG_TRUE;
+	}
+
+	sArg.gc = gc;
+	sArg.psTex = psTex;
+	sArg.ui32Face = ui32Face;
+	sArg.ui32MaxFace = ui32MaxFace;
+	sArg.bIsNonPow2 = bIsNonPow2;
+	sArg.hOpSyncObj = 0;
 
 #if defined(GLES2_EXTENSION_EGL_IMAGE)
 	if (psTex->psEGLImageTarget)
 	{
-		psArg->psSyncInfo = psTex->psEGLImageTarget->psMemInfo->psClientSyncInfo;
+		sArg.psSyncInfo = psTex->psEGLImageTarget->psMemInfo->psClientSyncInfo;
 	}
 	else
 #endif /* defined(GLES2_EXTENSION_EGL_IMAGE) */
 	{
 		if (psTex->psMemInfo)
 		{
-			psArg->psSyncInfo = psTex->psMemInfo->psClientSyncInfo;
+			sArg.psSyncInfo = psTex->psMemInfo->psClientSyncInfo;
 		}
 		else
 		{
-			psArg->psSyncInfo = IMG_NULL;
+			sArg.psSyncInfo = IMG_NULL;
 		}
 	}
 
-	if (psArg->psSyncInfo)
+	if (sArg.psSyncInfo)
 	{
-		do
-		{
-			eResult = SGX2DQueryBlitsComplete(gc->ps3DDevData, psArg->psSyncInfo, IMG_TRUE);
-		} while (eResult == PVRSRV_ERROR_TIMEOUT);
-
-		PVRSRVCreateSyncInfoModObj(gc->psSysContext->psConnection, &psArg->hOpSyncObj);
-
-		PVRSRVModifyPendingSyncOps(
-			gc->psSysContext->psConnection,
-			psArg->hOpSyncObj,
-			&psArg->psSyncInfo,
-			1,
-			PVRSRV_MODIFYSYNCOPS_FLAGS_WO_INC,
-			IMG_NULL,
-			IMG_NULL);
+		SWTexOpAddPendingWrite(gc, sArg.psSyncInfo, &sArg.hOpSyncObj);
 	}
 
-	sceKernelAtomicAddAndGet32(&gc->ui32AsyncTexOpNum, 1);
+	SWTexOpSubmit(gc, psTex, _SWTextureMipGenEntry, &sArg, sizeof(sArg));
+
+	return IMG_TRUE;
+}
+
+/***********************************************************************************
+ Function Name      : SWTexOpCreatePool
+ Inputs             : gc
+ Outputs            : -
+ Returns            : The pool, or IMG_NULL
+ Description        : Creates the work pool for a new share group from gc's app
+					  hints. Without a pool texture operations run synchronously.
+************************************************************************************/
+IMG_INTERNAL WORKPOOL *SWTexOpCreatePool(GLES2Context *gc)
+{
+	WORKPOOL_CONFIG sConfig;
+	WORKPOOL *psPool;
+
+	sConfig.pszName = SWTEXOP_POOL_NAME;
+	sConfig.ui32NumWorkers = MAX(gc->sAppHints.ui32SwTexOpThreadNum, 1);
+	sConfig.ui32MaxJobs = MAX(gc->sAppHints.ui32SwTexOpMaxJobs, 1);
+	sConfig.ui32MaxJobDataSize = MAX(sizeof(SWTexUploadArg), sizeof(SWTexMipGenArg));
+	sConfig.ui32Priority = gc->sAppHints.ui32SwTexOpThreadPriority;
+	sConfig.ui32AffinityMask = gc->sAppHints.ui32SwTexOpThreadAffinity;
 
-	for (i = 0; i < gc->sAppHints.ui32SwTexOpMaxUltNum; i++)
+	psPool = WorkPoolCreate(&sConfig);
+
+	if (!psPool)
 	{
-		if (gc->pvUltThreadStorage[i] == IMG_NULL)
-		{
-			gc->pvUltThreadStorage[i] = GLES2Malloc(gc, _SCE_ULT_ULTHREAD_SIZE);
-			break;
-		}
+		PVR_DPF((PVR_DBG_WARNING, "SWTexOpCreatePool: Couldn't create the work pool, texture operations will be synchronous"));
 	}
 
-	ret = sceUltUlthreadCreate(
-		gc->pvUltThreadStorage[i],
-		"OGLES2SWTextureMipGen",
-		_SWTextureMipGenEntry,
-		(IMG_UINT32)arg,
-		SCE_NULL,
-		0,
-		gc->pvUltRuntime,
-		SCE_NULL);
-
-	if (ret != SCE_OK)
+	return psPool;
+}
+
+/***********************************************************************************
+ Function Name      : SWTexOpDestroyPool
+ Inputs             : psSharedState
+ Outputs            : -
+ Returns            : -
+ Description        : Runs the queued operations and destroys the share group's
+					  work pool.
+************************************************************************************/
+IMG_INTERNAL IMG_VOID SWTexOpDestroyPool(GLES2ContextSharedState *psSharedState)
+{
+	if (psSharedState->psSwTexOpPool)
 	{
-		PVR_DPF((PVR_DBG_ERROR, "sceUltUlthreadCreate failed with code 0x%X. Consider increasing apphint SwTexOpMaxUltNum value", ret));
-		abort();
+		WorkPoolDestroy(psSharedState->psSwTexOpPool);
+
+		psSharedState->psSwTexOpPool = IMG_NULL;
 	}
+}
 
-	return IMG_TRUE;
+/***********************************************************************************
+ Function Name      : SWTexOpWaitTexture
+ Inputs             : gc, psTex
+ Outputs            : -
+ Returns            : -
+ Description        : Waits for the software operations queued on the texture,
+					  running queued jobs meanwhile.
+************************************************************************************/
+IMG_INTERNAL IMG_VOID SWTexOpWaitTexture(GLES2Context *gc, GLES2Texture *psTex)
+{
+	WORKPOOL *psPool = gc->psSharedState->psSwTexOpPool;
+
+	if (psPool && psTex->hSwTexOpToken != WORKPOOL_NO_TOKEN)
+	{
+		WorkPoolWait(psPool, psTex->hSwTexOpToken, IMG_TRUE);
+
+		psTex->hSwTexOpToken = WORKPOOL_NO_TOKEN;
+	}
 }
 
-IMG_VOID texOpAsyncAddForCleanup(GLES2Context *gc, IMG_PVOID pvPtr)
+/***********************************************************************************
+ Function Name      : SWTexOpAttachTexture
+ Inputs             : gc, psTex
+ Outputs            : -
+ Returns            : -
+ Description        : Makes the next TA kick wait for the operations queued on a
+					  texture the draw reads.
+************************************************************************************/
+IMG_INTERNAL IMG_VOID SWTexOpAttachTexture(GLES2Context *gc, GLES2Texture *psTex)
 {
-	IMG_UINT32 i = 0;
+	gc->hSwTexOpKickToken = WorkPoolLaterToken(gc->hSwTexOpKickToken, psTex->hSwTexOpToken);
+}
+
+/***********************************************************************************
+ Function Name      : SWTexOpWaitKick
+ Inputs             : gc
+ Outputs            : -
+ Returns            : -
+ Description        : Waits for the operations on the textures attached since the
+					  last kick.
+************************************************************************************/
+IMG_INTERNAL IMG_VOID SWTexOpWaitKick(GLES2Context *gc)
+{
+	WORKPOOL *psPool = gc->psSharedState->psSwTexOpPool;
 
-	for (i = 0; i < sizeof(pvAsDstPtr) / 4; i++)
+	if (psPool && gc->hSwTexOpKickToken != WORKPOOL_NO_TOKEN)
 	{
-		if (pvAsDstPtr[i] == IMG_NULL)
-		{
-			pvAsDstPtr[i] = pvPtr;
-			return;
-		}
+		WorkPoolWait(psPool, gc->hSwTexOpKickToken, IMG_TRUE);
 	}
 
-	PVR_DPF((PVR_DBG_WARNING, "texOpAsyncAddForCleanup: not enough space in free queue"));
+	gc->hSwTexOpKickToken = WORKPOOL_NO_TOKEN;
+}
+
+/***********************************************************************************
+ Function Name      : SWTexOpFreeNow
+ Inputs             : gc, pvPtr, hToken
+ Outputs            : -
+ Returns            : -
+ Description        : Frees a host buffer once the operations up to hToken and the
+					  transfers have finished with it.
+************************************************************************************/
+static IMG_VOID SWTexOpFreeNow(GLES2Context *gc, IMG_PVOID pvPtr, WORKPOOL_TOKEN hToken)
+{
+	WORKPOOL *psPool = gc->psSharedState ? gc->psSharedState->psSwTexOpPool : IMG_NULL;
+
+	if (psPool)
+	{
+		WorkPoolWait(psPool, hToken, IMG_TRUE);
+	}
+
+	SGXWaitTransfer(gc->ps3DDevData, gc->psSysContext->hTransferContext);
 
 	GLES2Free(gc, pvPtr);
 }
 
-IMG_INT32 texOpAsyncCleanupThread(IMG_UINT32 argSize, IMG_VOID *pArgBlock)
+IMG_VOID texOpAsyncAddForCleanup(GLES2Context *gc, IMG_PVOID pvPtr)
+{
+	SWTexOpFreeQueue *psQueue = gc->psSwTexOpFreeQueue;
+	WORKPOOL *psPool = gc->psSharedState ? gc->psSharedState->psSwTexOpPool : IMG_NULL;
+	WORKPOOL_TOKEN hToken = psPool ? WorkPoolLastToken(psPool) : WORKPOOL_NO_TOKEN;
+	SWTexOpDeferredFree *psEntry;
+
+	/*
+		A job (software mipmap generation) only frees buffers it used itself,
+		and waiting for room in the queue or for the pool could wait for itself.
+	*/
+	if (psPool && WorkPoolInJob(psPool))
+	{
+		SWTexOpFreeNow(gc, pvPtr, WORKPOOL_NO_TOKEN);
+
+		return;
+	}
+
+	/* After SWTexOpDeInit nothing is left to free the buffer later */
+	if (!psQueue)
+	{
+		SWTexOpFreeNow(gc, pvPtr, hToken);
+
+		return;
+	}
+
+	sceKernelLockLwMutex(&psQueue->sLock, 1, IMG_NULL);
+
+	while (psQueue->ui32Count == SWTEXOP_MAX_DEFERRED_FREES)
+	{
+		sceKernelWaitLwCond(&psQueue->sNotFull, IMG_NULL);
+	}
+
+	psEntry = &psQueue->asEntries[(psQueue->ui32Head + psQueue->ui32Count) % SWTEXOP_MAX_DEFERRED_FREES];
+	psEntry->pvPtr = pvPtr;
+	psEntry->hToken = hToken;
+
+	psQueue->ui32Count++;
+
+	sceKernelSignalLwCond(&psQueue->sNotEmpty);
+
+	sceKernelUnlockLwMutex(&psQueue->sLock, 1);
+}
+
+/***********************************************************************************
+ Function Name      : texOpAsyncCleanupThread
+ Inputs             : argSize, pArgBlock
+ Outputs            : -
+ Returns            : -
+ Description        : Frees the deferred host buffers in batches: everything queued
+					  when it wakes is freed after one wait for the newest entry's
+					  token and one wait for the transfers.
+************************************************************************************/
+static IMG_INT32 texOpAsyncCleanupThread(SceSize argSize, IMG_VOID *pArgBlock)
 {
-	IMG_UINT32 i = 0;
-	IMG_UINT32 ui32TriggerTime = 0;
 	GLES2Context *gc = *(GLES2Context **)pArgBlock;
+	SWTexOpFreeQueue *psQueue = gc->psSwTexOpFreeQueue;
+	WORKPOOL *psPool = gc->psSharedState->psSwTexOpPool;
+	IMG_UINT32 ui32Count, i;
+	WORKPOOL_TOKEN hToken;
 
-	sceClibMemset(pvAsDstPtr, 0, sizeof(pvAsDstPtr));
+	PVR_UNREFERENCED_PARAMETER(argSize);
 
-	while (!gc->bSwTexOpFin)
+	for (;;)
 	{
-		ui32TriggerTime = sceKernelGetProcessTimeLow();
+		sceKernelLockLwMutex(&psQueue->sLock, 1, IMG_NULL);
 
-		for (i = 0; i < sizeof(pvAsDstPtr) / 4; i++)
+		while (!psQueue->ui32Count && !gc->bSwTexOpFin)
 		{
-			if (pvAsDstPtr[i] != IMG_NULL && !gc->ui32AsyncTexOpNum)
-			{
-				SGXWaitTransfer(gc->ps3DDevData, gc->psSysContext->hTransferContext);
-				GLES2Free(gc, pvAsDstPtr[i]);
-				pvAsDstPtr[i] = IMG_NULL;
-			}
+			sceKernelWaitLwCond(&psQueue->sNotEmpty, IMG_NULL);
 		}
 
-		for (i = 0; i < gc->sAppHints.ui32SwTexOpMaxUltNum; i++)
+		ui32Count = psQueue->ui32Count;
+
+		sceKernelUnlockLwMutex(&psQueue->sLock, 1);
+
+		if (!ui32Count)
 		{
-			if (gc->pvUltThreadStorage[i] != IMG_NULL)
-			{
-				if (sceUltUlthreadTryJoin(gc->pvUltThreadStorage[i], NULL) == SCE_OK)
-				{
-					GLES2Free(IMG_NULL, gc->pvUltThreadStorage[i]);
-					gc->pvUltThreadStorage[i] = IMG_NULL;
-				}
-			}
+			break;
 		}
 
-		sceKernelDelayThread(gc->sAppHints.ui32SwTexOpCleanupDelay);
-	}
+		/* The producers only append, so the first ui32Count entries stay ours until we retire them */
+		hToken = psQueue->asEntries[(psQueue->ui32Head + ui32Count - 1) % SWTEXOP_MAX_DEFERRED_FREES].hToken;
 
-	for (i = 0; i < sizeof(pvAsDstPtr) / 4; i++)
-	{
-		if (pvAsDstPtr[i] != IMG_NULL && !gc->ui32AsyncTexOpNum)
+		if (psPool)
 		{
-			SGXWaitTransfer(gc->ps3DDevData, gc->psSysContext->hTransferContext);
-			GLES2Free(gc, pvAsDstPtr[i]);
-			pvAsDstPtr[i] = IMG_NULL;
+			WorkPoolWait(psPool, hToken, IMG_FALSE);
 		}
-	}
 
-	for (i = 0; i < gc->sAppHints.ui32SwTexOpMaxUltNum; i++)
-	{
-		if (gc->pvUltThreadStorage[i] != IMG_NULL)
+		SGXWaitTransfer(gc->ps3DDevData, gc->psSysContext->hTransferContext);
+
+		for (i = 0; i < ui32Count; i++)
 		{
-			if (sceUltUlthreadJoin(gc->pvUltThreadStorage[i], NULL) == SCE_OK)
-			{
-				GLES2Free(IMG_NULL, gc->pvUltThreadStorage[i]);
-				gc->pvUltThreadStorage[i] = IMG_NULL;
-			}
+			GLES2Free(gc, psQueue->asEntries[(psQueue->ui32Head + i) % SWTEXOP_MAX_DEFERRED_FREES].pvPtr);
 		}
+
+		sceKernelLockLwMutex(&psQueue->sLock, 1, IMG_NULL);
+
+		psQueue->ui32Head = (psQueue->ui32Head + ui32Count) % SWTEXOP_MAX_DEFERRED_FREES;
+		psQueue->ui32Count -= ui32Count;
+
+		sceKernelSignalLwCondAll(&psQueue->sNotFull);
+
+		sceKernelUnlockLwMutex(&psQueue->sLock, 1);
+	}
+
+	return sceKernelExitThread(0);
+}
+
+/***********************************************************************************
+ Function Name      : SWTexOpInit
+ Inputs             : gc
+ Outputs            : -
+ Returns            : Success
+ Description        : Creates the context's deferred free queue and its cleanup
+					  thread. Called after the shared state is set up.
+************************************************************************************/
+IMG_INTERNAL IMG_BOOL SWTexOpInit(GLES2Context *gc)
+{
+	SWTexOpFreeQueue *psQueue;
+
+	gc->hSwTexOpLastToken = WORKPOOL_NO_TOKEN;
+	gc->hSwTexOpKickToken = WORKPOOL_NO_TOKEN;
+	gc->bSwTexOpFin = IMG_FALSE;
+
+	psQueue = GLES2Calloc(gc, sizeof(SWTexOpFreeQueue));
+
+	if (!psQueue)
+	{
+		return IMG_FALSE;
+	}
+
+	if (sceKernelCreateLwMutex(&psQueue->sLock, "OGLES2AsyncTexOpLock", 0, 0, IMG_NULL) != SCE_OK)
+	{
+		goto FAILED_CreateLock;
+	}
+
+	if (sceKernelCreateLwCond(&psQueue->sNotEmpty, "OGLES2AsyncTexOpNE", 0, &psQueue->sLock, IMG_NULL) != SCE_OK)
+	{
+		goto FAILED_CreateNotEmpty;
 	}
 
-	return sceKernelExitDeleteThread(0);
-}
\ No newline at end of file
+	if (sceKernelCreateLwCond(&psQueue->sNotFull, "OGLES2AsyncTexOpNF", 0, &psQueue->sLock, IMG_NULL) != SCE_OK)
+	{
+		goto FAILED_CreateNotFull;
+	}
+
+	gc->psSwTexOpFreeQueue = psQueue;
+
+	gc->hSwTexOpThrd = sceKernelCreateThread("OGLES2AsyncTexOpCl", texOpAsyncCleanupThread, SCE_KERNEL_LOWEST_PRIORITY_USER, SCE_KERNEL_4KiB, 0, 0, SCE_NULL);
+
+	if (gc->hSwTexOpThrd < 0)
+	{
+		goto FAILED_CreateThread;
+	}
+
+	if (sceKernelStartThread(gc->hSwTexOpThrd, sizeof(gc), &gc) != SCE_OK)
+	{
+		sceKernelDeleteThread(gc->hSwTexOpThrd);
+
+		goto FAILED_CreateThread;
+	}
+
+	return IMG_TRUE;
+
+FAILED_CreateThread:
+
+	gc->psSwTexOpFreeQueue = IMG_NULL;
+
+	sceKernelDeleteLwCond(&psQueue->sNotFull);
+
+FAILED_CreateNotFull:
+
+	sceKernelDeleteLwCond(&psQueue->sNotEmpty);
+
+FAILED_CreateNotEmpty:
+
+	sceKernelDeleteLwMutex(&psQueue->sLock);
+
+FAILED_CreateLock:
+
+	PVR_DPF((PVR_DBG_ERROR, "SWTexOpInit: Couldn't create the cleanup thread"));
+
+	GLES2Free(IMG_NULL, psQueue);
+
+	return IMG_FALSE;
+}
+
+/***********************************************************************************
+ Function Name      : SWTexOpDeInit
+ Inputs             : gc
+ Outputs            : -
+ Returns            : -
+ Description        : Waits for the operations gc submitted, frees the deferred
+					  buffers and stops the cleanup thread. Buffers freed with
+					  GLES2FreeAsync afterwards are freed synchronously.
+************************************************************************************/
+IMG_INTERNAL IMG_VOID SWTexOpDeInit(GLES2Context *gc)
+{
+	SWTexOpFreeQueue *psQueue = gc->psSwTexOpFreeQueue;
+
+	/* The jobs use gc, which may not outlive the share group's pool */
+	if (gc->psSharedState && gc->psSharedState->psSwTexOpPool)
+	{
+		WorkPoolWait(gc->psSharedState->psSwTexOpPool, gc->hSwTexOpLastToken, IMG_TRUE);
+	}
+
+	if (!psQueue)
+	{
+		return;
+	}
+
+	sceKernelLockLwMutex(&psQueue->sLock, 1, IMG_NULL);
+
+	gc->bSwTexOpFin = IMG_TRUE;
+
+	sceKernelSignalLwCond(&psQueue->sNotEmpty);
+
+	sceKernelUnlockLwMutex(&psQueue->sLock, 1);
+
+	sceKernelWaitThreadEnd(gc->hSwTexOpThrd, SCE_NULL, SCE_NULL);
+	sceKernelDeleteThread(gc->hSwTexOpThrd);
+
+	gc->psSwTexOpFreeQueue = IMG_NULL;
+
+	sceKernelDeleteLwCond(&psQueue->sNotFull);
+	sceKernelDeleteLwCond(&psQueue->sNotEmpty);
+	sceKernelDeleteLwMutex(&psQueue->sLock);
+
+	GLES2Free(IMG_NULL, psQueue);
+}
@@ -3,6 +3,9 @@
 
 #include "..\context.h"
 
+/* Host buffers whose free may be pending at once, per context */
+#define SWTEXOP_MAX_DEFERRED_FREES	1024
+
 typedef struct SWTexUploadArg
 {
 	GLES2Context *gc;
@@ -29,13 +32,50 @@ typedef struct SWTexMipGenArg
 	IMG_SID hOpSyncObj;
 } SWTexMipGenArg;
 
+typedef struct SWTexOpDeferredFree
+{
+	IMG_VOID *pvPtr;
+
+	/* The last software texture operation submitted when the free was requested */
+	WORKPOOL_TOKEN hToken;
+} SWTexOpDeferredFree;
+
+/*
+	Host buffers which software texture operations or transfers may still read,
+	freed by the context's cleanup thread. GLES2FreeAsync waits for room when
+	the ring is full.
+*/
+typedef struct SWTexOpFreeQueue
+{
+	SceKernelLwMutexWork sLock;
+	SceKernelLwCondWork sNotEmpty;
+	SceKernelLwCondWork sNotFull;
+
+	IMG_UINT32 ui32Head;
+	IMG_UINT32 ui32Count;
+
+	SWTexOpDeferredFree asEntries[SWTEXOP_MAX_DEFERRED_FREES];
+} SWTexOpFreeQueue;
+
 IMG_INTERNAL IMG_VOID SWTextureUpload(
 	GLES2Context *gc, GLES2Texture *psTex, GLES2MipMapLevel *psMipLevel, IMG_UINT32 ui32OffsetInBytes, GLES2TextureFormat *psTexFmt,
 	IMG_UINT32 ui32Face, IMG_UINT32 ui32Lod, IMG_UINT32 ui32TopUsize, IMG_UINT32 ui32TopVsize);
 
 IMG_INTERNAL IMG_BOOL SWMakeTextureMipmapLevels(GLES2Context *gc, GLES2Texture *psTex, IMG_UINT32 ui32Face, IMG_UINT32 ui32MaxFace, IMG_BOOL bIsNonPow2);
 
-IMG_INT32 texOpAsyncCleanupThread(IMG_UINT32 argSize, IMG_VOID *pArgBlock);
+IMG_INTERNAL IMG_BOOL SWTexOpInit(GLES2Context *gc);
+
+IMG_INTERNAL IMG_VOID SWTexOpDeInit(GLES2Context *gc);
+
+IMG_INTERNAL WORKPOOL *SWTexOpCreatePool(GLES2Context *gc);
+
+IMG_INTERNAL IMG_VOID SWTexOpDestroyPool(GLES2ContextSharedState *psSharedState);
+
+IMG_INTERNAL IMG_VOID SWTexOpWaitTexture(GLES2Context *gc, GLES2Texture *psTex);
+
+IMG_INTERNAL IMG_VOID SWTexOpAttachTexture(GLES2Context *gc, GLES2Texture *psTex);
+
+IMG_INTERNAL IMG_VOID SWTexOpWaitKick(GLES2Context *gc);
 
 IMG_VOID texOpAsyncAddForCleanup(GLES2Context *gc, IMG_PVOID pvPtr);
 
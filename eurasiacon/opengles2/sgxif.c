@@ -24,6 +24,8 @@
 #include "gles2errata.h"
 #include "twiddle.h"
 
+#include "psp2/swtexop.h"
+
 #if defined(EUR_CR_ISP_ZLSCTL_MSTOREEN_MASK)
 #define SGX_DRAWMASK_STORE_ENABLE_MASK	EUR_CR_ISP_ZLSCTL_MSTOREEN_MASK
 #define SGX_DRAWMASK_LOAD_ENABLE_MASK	EUR_CR_ISP_ZLSCTL_MSTOREEN_MASK
@@ -530,9 +532,10 @@ static IMG_BOOL StartFrame(GLES2Context *gc, IMG_UINT32 *pui32ClearFlags, PVRSRV
 	IMG_BOOL bFullScreenObject = IMG_FALSE;
 
 
-	/* Try to get rid of texture and shader ghosts */
+	/* Try to get rid of texture, shader and buffer object ghosts */
 	KRM_DestroyUnneededGhosts(gc, &gc->psSharedState->psTextureManager->sKRM);
 	KRM_DestroyUnneededGhosts(gc, &gc->psSharedState->sUSEShaderVariantKRM);
+	KRM_DestroyUnneededGhosts(gc, &gc->psSharedState->sBufferObjectKRM);
 	
 	GLES2InitRegs(gc, *pui32ClearFlags);
 
@@ -2041,10 +2044,8 @@ skip_zs_alloc:
 	psKickTA->sKickTACommon.ui16MaxDrawCallsPerCore = gc->sAppHints.ui32MaxDrawCallsPerCore;
 	psKickTA->sKickTACommon.ui16PrimitiveSplitThreshold = gc->sAppHints.ui32PrimitiveSplitThreshold;
 
-	while (gc->ui32AsyncTexOpNum)
-	{
-		sceKernelDelayThread(10);
-	}
+	/* Textures read by this kick may still have software operations queued */
+	SWTexOpWaitKick(gc);
 
 	GLES2_TIME_START(GLES2_TIMER_SGXKICKTA_TIME);
 
@@ -2293,6 +2294,9 @@ IMG_INTERNAL IMG_EGLERROR ScheduleTA(GLES2Context *gc, EGLRenderSurface *psRende
 		return IMG_EGL_MEMORY_INVALID_ERROR;
 	}
 
+	/* Staged glBufferSubData updates land before the kick, and before a glFlush returns */
+	FlushStagedBufferUpdates(gc);
+
 	/*
 	 * Determine whether we have to call the services or not.
 	 */
@@ -79,32 +79,40 @@ static IMG_VOID SharedShaderStateDelRef(GLES2Context *gc, GLES2SharedShaderState
 
 		if(psSharedState->ui32RefCount == 0)
 		{
-			if(psSharedState->sBindingSymbolList.uNumBindings)
+			if(psSharedState->pvBinaryData)
 			{
-				for(i=0; i < psSharedState->sBindingSymbolList.uNumBindings; i++)
+				/* Symbols, names and constants were all unpacked into this block */
+				GLES2Free(IMG_NULL, psSharedState->pvBinaryData);
+			}
+			else
+			{
+				if(psSharedState->sBindingSymbolList.uNumBindings)
 				{
-					psSymbol = &psSharedState->sBindingSymbolList.psBindingSymbolEntries[i];
+					for(i=0; i < psSharedState->sBindingSymbolList.uNumBindings; i++)
+					{
+						psSymbol = &psSharedState->sBindingSymbolList.psBindingSymbolEntries[i];
 
-					GLES2Free(IMG_NULL, psSymbol->pszName);
+						GLES2Free(IMG_NULL, psSymbol->pszName);
 
-					if(psSymbol->uNumBaseTypeMembers)
-					{
-						for(j=0; j < psSymbol->uNumBaseTypeMembers; j++)
+						if(psSymbol->uNumBaseTypeMembers)
 						{
-							GLES2Free(IMG_NULL, psSymbol->psBaseTypeMembers[j].pszName);
-						}
+							for(j=0; j < psSymbol->uNumBaseTypeMembers; j++)
+							{
+								GLES2Free(IMG_NULL, psSymbol->psBaseTypeMembers[j].pszName);
+							}
 
-						GLES2Free(IMG_NULL, psSymbol->psBaseTypeMembers);
+							GLES2Free(IMG_NULL, psSymbol->psBaseTypeMembers);
+						}
 					}
-				}
 
-				GLES2Free(IMG_NULL, psSharedState->sBindingSymbolList.psBindingSymbolEntries);
-			}
-		
+					GLES2Free(IMG_NULL, psSharedState->sBindingSymbolList.psBindingSymbolEntries);
+				}
+			
 
-			if(psSharedState->sBindingSymbolList.uNumCompsUsed)
-			{
-				GLES2Free(IMG_NULL, psSharedState->sBindingSymbolList.pfConstantData);
+				if(psSharedState->sBindingSymbolList.uNumCompsUsed)
+				{
+					GLES2Free(IMG_NULL, psSharedState->sBindingSymbolList.pfConstantData);
+				}
 			}
 
 			if(psSharedState->pvUniPatchShader)
@@ -128,6 +136,41 @@ static IMG_VOID SharedShaderStateDelRef(GLES2Context *gc, GLES2SharedShaderState
 }
 
 
+/***********************************************************************************
+ Function Name      : GetUniPatchShaderMSAATrans
+ Inputs             : gc, psSharedState
+ Outputs            : -
+ Returns            : The UniPatch shader used for translucent MSAA, or IMG_NULL
+ Description        : UTILITY: Shader state loaded from a program binary keeps the
+                      UniPatch input of the MSAA translucent variant and only creates
+                      the UniPatch shader the first time it is asked for.
+************************************************************************************/
+IMG_INTERNAL IMG_VOID *GetUniPatchShaderMSAATrans(GLES2Context *gc, GLES2SharedShaderState *psSharedState)
+{
+	if(!psSharedState->pvUniPatchShaderMSAATrans && psSharedState->pvUniPatchInputMSAATrans)
+	{
+		/* ENTER CRITICAL SECTION */
+		PVRSRVLockMutex(gc->psSharedState->hPrimaryLock);
+
+		if(!psSharedState->pvUniPatchShaderMSAATrans)
+		{
+			psSharedState->pvUniPatchShaderMSAATrans = PVRUniPatchCreateShader(gc->sProgram.pvUniPatchContext, 
+																				(USP_PC_SHADER *)psSharedState->pvUniPatchInputMSAATrans);
+
+			if(!psSharedState->pvUniPatchShaderMSAATrans)
+			{
+				PVR_DPF((PVR_DBG_ERROR,"GetUniPatchShaderMSAATrans: UniPatch failed to create the shader"));
+			}
+		}
+
+		/* EXIT CRITICAL SECTION */
+		PVRSRVUnlockMutex(gc->psSharedState->hPrimaryLock);
+	}
+
+	return psSharedState->pvUniPatchShaderMSAATrans;
+}
+
+
 /***********************************************************************************
  Function Name        : USESecondaryUploadTaskAddRef
  Inputs             : gc, psUSESecondaryUploadTask
@@ -1457,6 +1500,9 @@ IMG_INTERNAL IMG_BOOL InitializeGLSLCompiler(GLES2Context *gc)
 	psInitCompilerContext->sUnrollLoopRules.bEnableUnroll					= IMG_TRUE;	/* Enable unrolling */
 	psInitCompilerContext->sUnrollLoopRules.bUnrollRelativeAddressingOnly	= IMG_TRUE; /* Only enable unroll if contain relative addressing */
 	psInitCompilerContext->sUnrollLoopRules.uMaxNumIterations				= 50;		/* The number of iterations has to be less than */
+	psInitCompilerContext->sUnrollLoopRules.uMaxUnrolledInstrs				= 256;		/* Up to 256 intermediate instructions after unrolling */
+	psInitCompilerContext->sUnrollLoopRules.uMaxLiveComponents				= 64;		/* Up to 16 vec4s live at once */
+	psInitCompilerContext->sUnrollLoopRules.uMaxPartialUnrollFactor			= 4;		/* Otherwise up to 4 copies of the body per iteration */
 
 	if(!gc->sProgram.sGLSLFuncTable.pfnInitCompiler(psInitCompilerContext))
 	{
@@ -1813,6 +1859,161 @@ static IMG_VOID FreeListOfFragmentUSEVariants(GLES2Context *gc, GLES2USEShaderVa
 }
 
 
+/***********************************************************************************
+ Function Name      : AddUSEShaderVariant
+ Inputs             : gc, psProgramShader, psUSEVariant
+ Outputs            : -
+ Returns            : -
+ Description        : Adds a newly created variant to the list of the program shader
+                      and indexes it in the variant table by its tVariantHash.
+                      The caller should have made room with EvictUSEShaderVariants.
+************************************************************************************/
+IMG_INTERNAL IMG_VOID AddUSEShaderVariant(GLES2Context *gc, GLES2ProgramShader *psProgramShader, GLES2USEShaderVariant *psUSEVariant)
+{
+	GLES2USEVariantTable *psTable = &psProgramShader->sVariantTable;
+	IMG_UINT32 ui32Index;
+
+	PVR_UNREFERENCED_PARAMETER(gc);
+
+	psUSEVariant->psNext = psProgramShader->psVariant;
+	psProgramShader->psVariant = psUSEVariant;
+
+	psUSEVariant->ui32LastUsed = ++psTable->ui32UseStamp;
+
+	/* 
+		The table fills up when eviction isn't allowed or fails. Keep at least one
+		empty slot so probing terminates; lookups fall back to the list once it's full.
+	*/
+	if(GLES2_USE_VARIANT_TABLE_IS_FULL(psTable))
+	{
+		return;
+	}
+
+	ui32Index = psUSEVariant->tVariantHash & GLES2_USE_VARIANT_TABLE_MASK;
+
+	while(psTable->apsEntry[ui32Index])
+	{
+		ui32Index = (ui32Index + 1) & GLES2_USE_VARIANT_TABLE_MASK;
+	}
+
+	psTable->apsEntry[ui32Index] = psUSEVariant;
+	psTable->ui32NumEntries++;
+}
+
+
+/***********************************************************************************
+ Function Name      : FindLeastRecentlyUsedVariant
+ Inputs             : psTable, psExclude
+ Outputs            : -
+ Returns            : The variant which has gone longest without being selected,
+                      other than psExclude
+ Description        : UTILITY: Used to pick the variant to evict.
+************************************************************************************/
+static GLES2USEShaderVariant *FindLeastRecentlyUsedVariant(GLES2USEVariantTable *psTable, GLES2USEShaderVariant *psExclude)
+{
+	GLES2USEShaderVariant *psVariant, *psOldest = IMG_NULL;
+	IMG_UINT32 i, ui32Age, ui32OldestAge = 0;
+
+	for(i=0; i < GLES2_USE_VARIANT_TABLE_SIZE; i++)
+	{
+		psVariant = psTable->apsEntry[i];
+
+		if(psVariant && (psVariant != psExclude))
+		{
+			/* Unsigned subtraction copes with the stamp wrapping */
+			ui32Age = psTable->ui32UseStamp - psVariant->ui32LastUsed;
+
+			if(!psOldest || (ui32Age > ui32OldestAge))
+			{
+				psOldest = psVariant;
+				ui32OldestAge = ui32Age;
+			}
+		}
+	}
+
+	return psOldest;
+}
+
+
+/***********************************************************************************
+ Function Name      : EvictUSEShaderVariants
+ Inputs             : gc, psProgramShader
+ Outputs            : -
+ Returns            : -
+ Description        : Makes room for one more variant in the program shader, evicting
+                      the least recently used variants if the table is at capacity.
+                      The current variant is never chosen.
+                      Fragment variants still referenced by the hardware are ghosted,
+                      as in FreeListOfFragmentUSEVariants. Vertex variants are not
+                      tracked by the KRM, so the TA is kicked and waited for first;
+                      to amortise that wait, a quarter of the table is evicted at once.
+                      Nothing is evicted while the share group has other contexts:
+                      they may have a variant current, or queued in a TA kick this
+                      context can't flush, so the table is left to grow instead.
+************************************************************************************/
+IMG_INTERNAL IMG_VOID EvictUSEShaderVariants(GLES2Context *gc, GLES2ProgramShader *psProgramShader)
+{
+	GLES2USEVariantTable *psTable = &psProgramShader->sVariantTable;
+	GLES2USEShaderVariant *psUSEVariant;
+	IMG_UINT32 ui32TargetEntries;
+
+	if(psTable->ui32NumEntries < GLES2_USE_VARIANT_TABLE_MAX_ENTRIES)
+	{
+		return;
+	}
+
+	/* As for buffer object renames, a context created meanwhile has nothing current yet */
+	if(gc->psSharedState->ui32RefCount != 1)
+	{
+		return;
+	}
+
+	if(psProgramShader->eProgramType == GLSLPT_FRAGMENT)
+	{
+		psUSEVariant = FindLeastRecentlyUsedVariant(psTable, gc->sProgram.psCurrentFragmentVariant);
+
+		GLES_ASSERT(psUSEVariant);
+
+		if(KRM_IsResourceNeeded(&gc->psSharedState->sUSEShaderVariantKRM, &psUSEVariant->sResource))
+		{
+			GhostUSEShaderVariant(gc, psUSEVariant);
+		}
+		else
+		{
+			DestroyUSEShaderVariant(gc, psUSEVariant);
+		}
+
+		GLES2_INC_COUNT(GLES2_TIMER_USE_VARIANT_EVICT_COUNT, 1);
+
+		return;
+	}
+
+	if(gc->psRenderSurface)
+	{
+		if(ScheduleTA(gc, gc->psRenderSurface, GLES2_SCHEDULE_HW_WAIT_FOR_TA) != IMG_EGL_NO_ERROR)
+		{
+			PVR_DPF((PVR_DBG_ERROR, "EvictUSEShaderVariants: Kicking the TA failed\n"));
+
+			/* Go over the limit rather than free code the hardware may still use */
+			return;
+		}
+	}
+
+	ui32TargetEntries = GLES2_USE_VARIANT_TABLE_MAX_ENTRIES - (GLES2_USE_VARIANT_TABLE_MAX_ENTRIES >> 2);
+
+	while(psTable->ui32NumEntries > ui32TargetEntries)
+	{
+		psUSEVariant = FindLeastRecentlyUsedVariant(psTable, gc->sProgram.psCurrentVertexVariant);
+
+		GLES_ASSERT(psUSEVariant);
+
+		DestroyUSEShaderVariant(gc, psUSEVariant);
+
+		GLES2_INC_COUNT(GLES2_TIMER_USE_VARIANT_EVICT_COUNT, 1);
+	}
+}
+
+
 /***********************************************************************************
  Function Name      : ResetProgramLinkedState
  Inputs             : gc, program
@@ -4362,7 +4563,7 @@ GL_API_EXT void GL_APIENTRY glGetProgramBinaryOES (GLuint program, GLsizei bufSi
 	sCodeFrag.eActiveVaryingMask	   = psFragment->eActiveVaryingMask;
 	sCodeFrag.psUniPatchInput		   = PVRUniPatchCreatePCShader(gc->sProgram.pvUniPatchContext, (PUSP_SHADER)   psFragment->pvUniPatchShader);
 
-	if(psFragment->pvUniPatchShaderMSAATrans)
+	if(GetUniPatchShaderMSAATrans(gc, psFragment))
 	{
 		sCodeFrag.psUniPatchInputMSAATrans = PVRUniPatchCreatePCShader(gc->sProgram.pvUniPatchContext, (PUSP_SHADER)   psFragment->pvUniPatchShaderMSAATrans);
 	}
@@ -4936,6 +5137,56 @@ IMG_INTERNAL IMG_VOID FreeProgramState(GLES2Context *gc)
 }
 
 
+/***********************************************************************************
+ Function Name      : RemoveUSEShaderVariantFromTable
+ Inputs             : psTable, psUSEVariant
+ Outputs            : -
+ Returns            : -
+ Description        : UTILITY: Removes a variant from its program shader's variant table.
+                      Entries after it in the probe sequence are shifted back into the
+                      hole so lookups never need tombstones.
+************************************************************************************/
+static IMG_VOID RemoveUSEShaderVariantFromTable(GLES2USEVariantTable *psTable, GLES2USEShaderVariant *psUSEVariant)
+{
+	GLES2USEShaderVariant *psEntry;
+	IMG_UINT32 ui32Hole, ui32Index, ui32Home;
+
+	ui32Hole = psUSEVariant->tVariantHash & GLES2_USE_VARIANT_TABLE_MASK;
+
+	while(psTable->apsEntry[ui32Hole] != psUSEVariant)
+	{
+		if(!psTable->apsEntry[ui32Hole])
+		{
+			/* Not in the table */
+			return;
+		}
+
+		ui32Hole = (ui32Hole + 1) & GLES2_USE_VARIANT_TABLE_MASK;
+	}
+
+	psTable->apsEntry[ui32Hole] = IMG_NULL;
+	psTable->ui32NumEntries--;
+
+	ui32Index = (ui32Hole + 1) & GLES2_USE_VARIANT_TABLE_MASK;
+
+	while((psEntry = psTable->apsEntry[ui32Index]) != IMG_NULL)
+	{
+		ui32Home = psEntry->tVariantHash & GLES2_USE_VARIANT_TABLE_MASK;
+
+		/* Move the entry into the hole if the hole lies on its probe sequence */
+		if(((ui32Index - ui32Home) & GLES2_USE_VARIANT_TABLE_MASK) >= ((ui32Index - ui32Hole) & GLES2_USE_VARIANT_TABLE_MASK))
+		{
+			psTable->apsEntry[ui32Hole] = psEntry;
+			psTable->apsEntry[ui32Index] = IMG_NULL;
+
+			ui32Hole = ui32Index;
+		}
+
+		ui32Index = (ui32Index + 1) & GLES2_USE_VARIANT_TABLE_MASK;
+	}
+}
+
+
 /***********************************************************************************
  Function Name      : DestroyUSEShaderVariant
  Inputs             : gc, psUSEVariant
@@ -4979,6 +5230,8 @@ IMG_INTERNAL IMG_VOID DestroyUSEShaderVariant(GLES2Context *gc, GLES2USEShaderVa
 		GLES_ASSERT(psList);
 	}
 
+	RemoveUSEShaderVariantFromTable(&psUSEVariant->psProgramShader->sVariantTable, psUSEVariant);
+
 	/* Remove the variant from the KRM list */
 	KRM_RemoveResourceFromAllLists(&gc->psSharedState->sUSEShaderVariantKRM, &psUSEVariant->sResource);
 
@@ -5009,6 +5262,11 @@ IMG_INTERNAL IMG_VOID DestroyUSEShaderVariant(GLES2Context *gc, GLES2USEShaderVa
 		psPDSVariant = psPDSVariantNext;
 	}
 
+	if(psUSEVariant->psPDSTemplate)
+	{
+		GLES2Free(IMG_NULL, psUSEVariant->psPDSTemplate);
+	}
+
 	GLES2Free(IMG_NULL, psUSEVariant);
 }
 
@@ -104,6 +104,22 @@ struct GLES2PDSCodeVariant_TAG
 };
 
 
+/* The first PDS pixel program generated for a fragment USE variant. The FPU iterators
+   are fixed per USE variant, so its other PDS variants are made by patching a copy of
+   this one with their texture and USE task control words.
+*/
+typedef struct GLES2PDSPixelTemplate_TAG
+{
+	PDS_PIXEL_SHADER_PROGRAM_INFO sProgramInfo;
+
+	IMG_UINT32 ui32ProgramSizeInDWords;
+
+	/* Follows the structure in the same allocation */
+	IMG_UINT32 *pui32Program;
+
+} GLES2PDSPixelTemplate;
+
+
 typedef struct GLES2PDSCodeVariantGhost_TAG
 {
 	UCH_UseCodeBlock	*psCodeBlock;
@@ -170,6 +186,11 @@ struct GLES2USEShaderVariant_TAG
 	/* Pointer to the ProgramShader this variant belongs to (if any) */
 	GLES2ProgramShader              *psProgramShader;
 
+	/* Hash of the state this variant was finalised for, and the value of the 
+	   owning variant table's use stamp when it was last selected */
+	HashValue						tVariantHash;
+	IMG_UINT32						ui32LastUsed;
+
 	/* USSE code variants are frame resources */
 	KRMResource             		sResource;
 
@@ -257,6 +278,9 @@ struct GLES2USEShaderVariant_TAG
 
 	/* Linked list of PDS variants (only for fragment shaders) */
 	GLES2PDSCodeVariant     *psPDSVariant;
+
+	/* Program patched to build the PDS variants (only for fragment shaders) */
+	GLES2PDSPixelTemplate   *psPDSTemplate;
 	
 	/* Number of elements in the list above. NOTE: it is not a contiguous array! */
 	IMG_UINT32 ui32NumPDSVariants;
@@ -286,6 +310,31 @@ typedef struct GLES2USEShaderVariantGhost_TAG
 } GLES2USEShaderVariantGhost;
 
 
+/* Open-addressed (linear probing) table of the USE variants of a program shader,
+   indexed by tVariantHash. At most GLES2_USE_VARIANT_TABLE_MAX_ENTRIES variants
+   are kept; beyond that the least recently used one is evicted. Nothing is evicted
+   while the share group has other contexts, and variants added once the table is
+   full are only on the program shader's list. */
+#define GLES2_USE_VARIANT_TABLE_LOG2SIZE	6
+#define GLES2_USE_VARIANT_TABLE_SIZE		(1U << GLES2_USE_VARIANT_TABLE_LOG2SIZE)
+#define GLES2_USE_VARIANT_TABLE_MASK		(GLES2_USE_VARIANT_TABLE_SIZE - 1)
+#define GLES2_USE_VARIANT_TABLE_MAX_ENTRIES	24
+
+/* One slot is always left empty so probing terminates */
+#define GLES2_USE_VARIANT_TABLE_IS_FULL(psTable)	((psTable)->ui32NumEntries >= (GLES2_USE_VARIANT_TABLE_SIZE - 1))
+
+typedef struct GLES2USEVariantTable_TAG
+{
+	struct GLES2USEShaderVariant_TAG *apsEntry[GLES2_USE_VARIANT_TABLE_SIZE];
+
+	IMG_UINT32 ui32NumEntries;
+
+	/* Incremented every time a variant is selected */
+	IMG_UINT32 ui32UseStamp;
+
+} GLES2USEVariantTable;
+
+
 /* GLES2SharedShaderState represents a GL shader after it has been compiled successfully */
 /* It contains data that can be fed to UniPatch to finalise and get hardware machine code */
 typedef struct GLES2SharedShaderStateRec
@@ -305,6 +354,15 @@ typedef struct GLES2SharedShaderStateRec
 	IMG_VOID			*pvUniPatchShader;
 	IMG_VOID			*pvUniPatchShaderMSAATrans;
 
+	/*
+		State loaded from a format 2 program binary: the symbols, their names and the
+		constant data all live in this single block and are not freed one by one.
+		pvUniPatchShaderMSAATrans is only created from pvUniPatchInputMSAATrans (which
+		points into the block) the first time it is needed.
+	*/
+	IMG_VOID			*pvBinaryData;
+	IMG_VOID			*pvUniPatchInputMSAATrans;
+
 	/* Secondary attributes upload task */
 	GLES2USESecondaryUploadTask *psSecondaryUploadTask;
 
@@ -450,6 +508,9 @@ struct GLES2ProgramShaderRec
 	
 	/* Linked list of compiled use shaders for different back end linkage */
 	struct GLES2USEShaderVariant_TAG *psVariant;
+
+	/* Hashed index of the variants above */
+	GLES2USEVariantTable sVariantTable;
 };
 
 
@@ -624,8 +685,11 @@ IMG_VOID FreeProgramState(GLES2Context *gc);
 
 IMG_VOID DestroyUSEShaderVariant(GLES2Context *gc, GLES2USEShaderVariant *psUSEVariant);
 IMG_VOID DestroyUSEShaderVariantGhost(GLES2Context *gc, GLES2USEShaderVariantGhost *psUSEVariantGhost);
+IMG_VOID AddUSEShaderVariant(GLES2Context *gc, GLES2ProgramShader *psProgramShader, GLES2USEShaderVariant *psUSEVariant);
+IMG_VOID EvictUSEShaderVariants(GLES2Context *gc, GLES2ProgramShader *psProgramShader);
 IMG_VOID DestroyVertexVariants(GLES2Context *gc, const IMG_VOID* pvAttachment, GLES2NamedItem *psNamedItem);
 IMG_VOID DestroyHashedPDSVariant(GLES2Context *gc, IMG_UINT32 ui32Item);
+IMG_VOID *GetUniPatchShaderMSAATrans(GLES2Context *gc, GLES2SharedShaderState *psSharedState);
 
 IMG_BOOL InitializeGLSLCompiler(GLES2Context *gc);
 IMG_VOID DestroyGLSLCompiler(GLES2Context *gc);
@@ -3522,6 +3522,54 @@ bad_op:
 }
 
 
+/***********************************************************************************
+ Function Name      : TwiddleSubTexture
+ Inputs             : gc, psTex, ui32Face, ui32Lod, psMipLevel, ui32XOffset, ui32YOffset,
+					  ui32Width, ui32Height, pvPixels, ui32SrcRowSize, pfnCopyTextureData
+ Outputs            : psTex
+ Returns            : Whether the subtexture was written
+ Description        : Converts subtexture data and twiddles it straight into a loaded
+					  level of a twiddled texture. Returns IMG_FALSE, leaving the
+					  level alone, if the texture cannot be written this way or
+					  there is no memory to convert the data.
+************************************************************************************/
+static IMG_BOOL TwiddleSubTexture(GLES2Context *gc, GLES2Texture *psTex, IMG_UINT32 ui32Face, IMG_UINT32 ui32Lod,
+								  GLES2MipMapLevel *psMipLevel, IMG_UINT32 ui32XOffset, IMG_UINT32 ui32YOffset,
+								  IMG_UINT32 ui32Width, IMG_UINT32 ui32Height, const IMG_VOID *pvPixels,
+								  IMG_UINT32 ui32SrcRowSize, PFNCopyTextureData pfnCopyTextureData)
+{
+	GLES2SubTextureInfo sSubTexInfo;
+	IMG_BOOL bWritten;
+
+	if(!CanTwiddleSubTexture(psTex, psMipLevel))
+	{
+		return IMG_FALSE;
+	}
+
+	sSubTexInfo.ui32SubTexXoffset = ui32XOffset;
+	sSubTexInfo.ui32SubTexYoffset = ui32YOffset;
+	sSubTexInfo.ui32SubTexWidth   = ui32Width;
+	sSubTexInfo.ui32SubTexHeight  = ui32Height;
+
+	/* Only the CPU reads the converted data, so keep it in cached memory */
+	sSubTexInfo.pui8SubTexBuffer = (IMG_UINT8 *)GLES2Malloc(gc, ui32Width * ui32Height * psMipLevel->psTexFormat->ui32TotalBytesPerTexel);
+
+	if(!sSubTexInfo.pui8SubTexBuffer)
+	{
+		return IMG_FALSE;
+	}
+
+	(*pfnCopyTextureData)(sSubTexInfo.pui8SubTexBuffer, pvPixels, ui32Width, ui32Height,
+						  ui32SrcRowSize, psMipLevel, IMG_FALSE);
+
+	bWritten = TwiddleSubTextureData(gc, psTex, ui32Face, ui32Lod, &sSubTexInfo);
+
+	GLES2Free(gc, sSubTexInfo.pui8SubTexBuffer);
+
+	return bWritten;
+}
+
+
 /***********************************************************************************
  Function Name      : glTexSubImage2D
  Inputs             : target, level, xoffset, yoffset, width, height, format, type,
@@ -3545,6 +3593,7 @@ GL_APICALL void GL_APIENTRY glTexSubImage2D(GLenum target, GLint level, GLint xo
 	GLES2MipMapLevel *psMipLevel;
 
 	IMG_BOOL bHWSubTextureUploaded = IMG_FALSE;
+	IMG_BOOL bSWSubTextureUploaded = IMG_FALSE;
 
 	__GLES2_GET_CONTEXT();
 
@@ -3858,6 +3907,9 @@ bad_op:
 		return;
 	}
 
+	/* A queued upload may still read the level's host data */
+	SWTexOpWaitTexture(gc, psTex);
+
 	psMipLevel = &psTex->psMipLevel[ui32Level];
 
 	/* Get the format of the target texture */
@@ -4074,7 +4126,10 @@ bad_op:
 	    GLES_ASSERT(psTex->psEGLImageTarget->ui32Width==psMipLevel->ui32Width && psTex->psEGLImageTarget->ui32Height==psMipLevel->ui32Height);
 		GLES_ASSERT(psMipLevel->pui8Buffer==GLES2_LOADED_LEVEL)
 
-		if(psTex->psEGLImageTarget->bTwiddled)
+		/* Twiddle the subtexture straight into the image if possible, otherwise read it back and translate it again */
+		if(psTex->psEGLImageTarget->bTwiddled &&
+		   !TwiddleSubTexture(gc, psTex, 0, 0, psMipLevel, (IMG_UINT32)xoffset, (IMG_UINT32)yoffset,
+							  (IMG_UINT32)width, (IMG_UINT32)height, pui8Src, ui32SrcRowSize, pfnCopyTextureData))
 		{
 		    IMG_UINT32 ui32BufferSize;
 
@@ -4112,7 +4167,7 @@ bad_op:
 
 			PVRSRVUnlockMutex(gc->psSharedState->hTertiaryLock);
 		}
-		else
+		else if(!psTex->psEGLImageTarget->bTwiddled)
 		{
 			ui32DstStride = psTex->psEGLImageTarget->ui32Stride;
 
@@ -4179,9 +4234,10 @@ bad_op:
 	else
 	{
 	    /* directly upload subtexture data into the device memory
-		   if the host copy of the whole level texture has already been uploaded to the device memory */
+		   if the host copy of the whole level texture has already been uploaded to the device memory,
+		   with the HWTQ or by twiddling it into place */
 
-	    if(!gc->sAppHints.bDisableHWTQTextureUpload)
+	    if(!gc->sAppHints.bDisableHWTQTextureUpload || CanTwiddleSubTexture(psTex, psMipLevel))
 		{
 			PVRSRV_CLIENT_MEM_INFO sMemInfo  = {0};
 			GLES2TextureParamState  *psParams = &psTex->sState;
@@ -4194,12 +4250,15 @@ bad_op:
 			   When HWTQ is used to upload this texture level,
 			   only if the texture resource is being used in the current frame,
 			   then NEED to ghost it and create new texture device memory,
-			   otherwise NO NEED to ghost at all
-			   This optimisation can only be used if we have a valid gc->psRenderSurface
+			   otherwise NO NEED to ghost at all, as the transfer is queued behind
+			   earlier renders.
+			   This optimisation can only be used if we have a valid gc->psRenderSurface.
+			   The CPU twiddles into the memory straight away, so for that the
+			   texture must be ghosted if any render, kicked or not, still needs it.
 			*/
 			if(psTex->psMemInfo)
 			{
-				if (gc->psRenderSurface)
+				if (!gc->sAppHints.bDisableHWTQTextureUpload && gc->psRenderSurface)
 				{
 					if (KRM_IsResourceInUse(&gc->psSharedState->psTextureManager->sKRM,
 					                        gc->psRenderSurface,
@@ -4266,6 +4325,7 @@ bad_op:
 
 
 			/* directly upload subtexture data to the new device memory, using hardware */
+			if(!gc->sAppHints.bDisableHWTQTextureUpload)
 			{
 				IMG_UINT32 ui32SubTexBufferSize = (IMG_UINT32)width * (IMG_UINT32)height * psTargetTexFormat->ui32TotalBytesPerTexel;
 				IMG_UINT8 *pui8SubTexBuffer = (IMG_UINT8 *) GLES2MallocHeapUNC(gc, ui32SubTexBufferSize);
@@ -4407,13 +4467,38 @@ bad_op:
 				
 				GLES2FreeAsync(gc, pui8SubTexBuffer);
 			}
+
+			/* or twiddle it into the new device memory in software,
+			   unless the HWTQ upload failed and skipped ghosting for an earlier render */
+			if(!bHWSubTextureUploaded &&
+			   !KRM_IsResourceNeeded(&gc->psSharedState->psTextureManager->sKRM, &psTex->sResource))
+			{
+				const IMG_UINT8 *pui8Src = (const IMG_UINT8 *)pixels;
+				IMG_UINT32 ui32Align = gc->sState.sClientPixel.ui32UnpackAlignment;
+				IMG_UINT32 ui32SrcRowSize = (IMG_UINT32)width * ui32SrcBytesPerPixel;
+				IMG_UINT32 ui32Padding = ui32SrcRowSize % ui32Align;
+
+				if(ui32Padding)
+				{
+					ui32SrcRowSize += (ui32Align - ui32Padding);
+				}
+
+				if(TwiddleSubTexture(gc, psTex, ui32Face, ui32Lod, psMipLevel, (IMG_UINT32)xoffset, (IMG_UINT32)yoffset,
+									 (IMG_UINT32)width, (IMG_UINT32)height, pui8Src, ui32SrcRowSize, pfnCopyTextureData))
+				{
+					bSWSubTextureUploaded = IMG_TRUE;
+
+					/* Reset bResidence, to prevent going into TextureMakeResident() */
+					psTex->bResidence = IMG_TRUE;
+				}
+			}
 		}
 
 
 		/* otherwise use the software subtexture uploading approach
 		   readback the whole level texture data and copy subtexture data to the host memory. */
 
-		if(!bHWSubTextureUploaded)
+		if(!bHWSubTextureUploaded && !bSWSubTextureUploaded)
 		{
 			const IMG_UINT8 *pui8Src = (const IMG_UINT8 *)pixels;
 			IMG_UINT32 ui32Align = gc->sState.sClientPixel.ui32UnpackAlignment;
@@ -4732,6 +4817,9 @@ GL_APICALL void GL_APIENTRY glCompressedTexSubImage2D(GLenum target, GLint level
 		return;
 	}
 
+	/* A queued upload may still read the level's host data */
+	SWTexOpWaitTexture(gc, psTex);
+
 	psMipLevel = &psTex->psMipLevel[ui32Level];
 
 	/* Must have at least 2x2 blocks */
@@ -5562,6 +5650,9 @@ GL_APICALL void GL_APIENTRY glCopyTexSubImage2D(GLenum target, GLint level, GLin
 		return;
 	}
 
+	/* A queued upload may still read the level's host data */
+	SWTexOpWaitTexture(gc, psTex);
+
 	psMipLevel = &psTex->psMipLevel[ui32Level];
 
 	psTargetTexFormat = psMipLevel->psTexFormat;
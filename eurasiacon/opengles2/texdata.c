@@ -22,7 +22,6 @@
  **************************************************************************/
 
 #include <kernel/dmacmgr.h>	
-#include <ult.h>
 
 #include "context.h"
 #include "twiddle.h"
@@ -2439,6 +2438,9 @@ IMG_INTERNAL IMG_VOID TranslateLevel(GLES2Context *gc, GLES2Texture *psTex, IMG_
 	IMG_UINT32 ui32ImageSize;
 #endif
 
+	/* Operations on a texture run in order: the queued ones may still write any level */
+	SWTexOpWaitTexture(gc, psTex);
+
 #if defined(SGX_FEATURE_TAG_POT_TWIDDLE)
 	ui32TopUsize = 1U << ((psParams->aui32StateWord1[0] & ~EURASIA_PDS_DOUTT1_USIZE_CLRMSK) >> EURASIA_PDS_DOUTT1_USIZE_SHIFT);
 	ui32TopVsize = 1U << ((psParams->aui32StateWord1[0] & ~EURASIA_PDS_DOUTT1_VSIZE_CLRMSK) >> EURASIA_PDS_DOUTT1_VSIZE_SHIFT);
@@ -2623,6 +2625,9 @@ IMG_INTERNAL IMG_VOID ReadBackTextureData(GLES2Context *gc, GLES2Texture *psTex,
 	    psDstSyncInfo = psTex->psMemInfo->psClientSyncInfo;
 	}	
 
+	/* Run any software operation still queued rather than spin on its write op below */
+	SWTexOpWaitTexture(gc, psTex);
+
 	/* check the texture has been uploaded before reading it back */
 	if(psDstSyncInfo)
 	{		
@@ -2810,6 +2815,164 @@ IMG_INTERNAL IMG_VOID ReadBackTextureData(GLES2Context *gc, GLES2Texture *psTex,
 }
 
 
+/***********************************************************************************
+ Function Name      : CanTwiddleSubTexture
+ Inputs             : psTex, psMipLevel
+ Outputs            : -
+ Returns            : Whether TwiddleSubTextureData can write rectangles of the level
+ Description        : True for uncompressed twiddled textures of a single chunk 
+					  whose texel size has a sub-twiddle function.
+************************************************************************************/
+IMG_INTERNAL IMG_BOOL CanTwiddleSubTexture(const GLES2Texture *psTex, const GLES2MipMapLevel *psMipLevel)
+{
+	switch(psTex->sState.aui32StateWord1[0] & ~EURASIA_PDS_DOUTT1_TEXTYPE_CLRMSK)
+	{
+#if defined(SGX_FEATURE_TAG_POT_TWIDDLE) || defined(SGX_FEATURE_HYBRID_TWIDDLING)
+		case EURASIA_PDS_DOUTT1_TEXTYPE_2D:
+		case EURASIA_PDS_DOUTT1_TEXTYPE_CEM:
+#else
+		case EURASIA_PDS_DOUTT1_TEXTYPE_ARB_2D:
+		case EURASIA_PDS_DOUTT1_TEXTYPE_ARB_CEM:
+#endif
+		{
+			break;
+		}
+		default:
+		{
+			return IMG_FALSE;
+		}
+	}
+
+	if((psTex->ui32HWFlags & (GLES2_COMPRESSED | GLES2_MULTICHUNK)) || !psTex->pfnSubTwiddleData)
+	{
+		return IMG_FALSE;
+	}
+
+#if !defined(SGX_FEATURE_HYBRID_TWIDDLING)
+	/* Only power-of-two levels are twiddled */
+	if((psMipLevel->ui32Width & (psMipLevel->ui32Width - 1)) || (psMipLevel->ui32Height & (psMipLevel->ui32Height - 1)))
+	{
+		return IMG_FALSE;
+	}
+#else
+	PVR_UNREFERENCED_PARAMETER(psMipLevel);
+#endif
+
+	return IMG_TRUE;
+}
+
+
+/***********************************************************************************
+ Function Name      : TwiddleSubTextureData
+ Inputs             : gc, psTex, ui32Face, ui32Lod, psSubTexInfo
+ Outputs            : psTex
+ Returns            : Whether the rectangle was written
+ Description        : Twiddles a rectangle of texels, already in the texture's format
+					  and packed in psSubTexInfo->pui8SubTexBuffer, straight into a
+					  loaded level. Only the texels of the rectangle are written, so
+					  the level is neither read back nor translated again.
+************************************************************************************/
+IMG_INTERNAL IMG_BOOL TwiddleSubTextureData(GLES2Context *gc, GLES2Texture *psTex, IMG_UINT32 ui32Face, 
+											IMG_UINT32 ui32Lod, const GLES2SubTextureInfo *psSubTexInfo)
+{
+	GLES2MipMapLevel          *psMipLevel;
+	GLES2TextureParamState    *psParams = &psTex->sState;
+	PVRSRV_CLIENT_SYNC_INFO   *psDstSyncInfo;
+	IMG_UINT32                ui32TopUsize, ui32TopVsize, ui32BytesPerTexel, ui32OffsetInBytes;
+	IMG_UINT8                 *pui8Dest;
+
+	psMipLevel = &psTex->psMipLevel[ui32Lod + (ui32Face * GLES2_MAX_TEXTURE_MIPMAP_LEVELS)];
+
+	if(!CanTwiddleSubTexture(psTex, psMipLevel))
+	{
+		return IMG_FALSE;
+	}
+
+#if defined(SGX_FEATURE_TAG_POT_TWIDDLE)
+	ui32TopUsize = 1U << ((psParams->aui32StateWord1[0] & ~EURASIA_PDS_DOUTT1_USIZE_CLRMSK) >> EURASIA_PDS_DOUTT1_USIZE_SHIFT);
+	ui32TopVsize = 1U << ((psParams->aui32StateWord1[0] & ~EURASIA_PDS_DOUTT1_VSIZE_CLRMSK) >> EURASIA_PDS_DOUTT1_VSIZE_SHIFT);
+#else
+	ui32TopUsize = 1 + ((psParams->aui32StateWord1[0] & ~EURASIA_PDS_DOUTT1_WIDTH_CLRMSK)  >> EURASIA_PDS_DOUTT1_WIDTH_SHIFT);
+	ui32TopVsize = 1 + ((psParams->aui32StateWord1[0] & ~EURASIA_PDS_DOUTT1_HEIGHT_CLRMSK) >> EURASIA_PDS_DOUTT1_HEIGHT_SHIFT);
+#endif
+
+	ui32BytesPerTexel = psTex->psFormat->ui32TotalBytesPerTexel;
+
+	if(psTex->ui32HWFlags & GLES2_NONPOW2)
+	{
+		/* Non-power-of-two texture: cannot be  CEM */
+		GLES_ASSERT(ui32Face == 0);
+
+		ui32OffsetInBytes = ui32BytesPerTexel * GetNPOTMipMapOffset(ui32Lod, psTex);
+	}
+	else
+	{
+		ui32OffsetInBytes = ui32BytesPerTexel * GetMipMapOffset(ui32Lod, ui32TopUsize, ui32TopVsize);
+
+		if(psTex->ui32TextureTarget == GLES2_TEXTURE_TARGET_CEM)
+		{
+			IMG_UINT32 ui32FaceOffset = 
+				ui32BytesPerTexel * GetMipMapOffset(psTex->ui32NumLevels, ui32TopUsize, ui32TopVsize);
+			
+			if(psTex->ui32HWFlags & GLES2_MIPMAP)
+			{
+				if(((ui32BytesPerTexel == 1) && (ui32TopUsize > EURASIA_TAG_CUBEMAP_NO_ALIGN_SIZE_8BPP)) ||
+					(ui32TopUsize > EURASIA_TAG_CUBEMAP_NO_ALIGN_SIZE_16_32BPP))
+				{
+					ui32FaceOffset = ALIGNCOUNT(ui32FaceOffset, EURASIA_TAG_CUBEMAP_FACE_ALIGN);
+				}
+			}
+
+			ui32OffsetInBytes += (ui32FaceOffset * ui32Face);
+		}
+	}
+
+#if defined(GLES2_EXTENSION_EGL_IMAGE)
+	if(psTex->psEGLImageTarget)
+	{
+		psDstSyncInfo = psTex->psEGLImageTarget->psMemInfo->psClientSyncInfo;
+		pui8Dest = (IMG_UINT8 *)psTex->psEGLImageTarget->psMemInfo->pvLinAddr + ui32OffsetInBytes;
+	}
+	else
+#endif /* defined(GLES2_EXTENSION_EGL_IMAGE) */
+	{
+		psDstSyncInfo = psTex->psMemInfo->psClientSyncInfo;
+		pui8Dest = (IMG_UINT8 *)psTex->psMemInfo->pvLinAddr + ui32OffsetInBytes;
+	}
+
+	/* Software operations and transfers queued on the texture may still write the level */
+	SWTexOpWaitTexture(gc, psTex);
+
+	if(psDstSyncInfo)
+	{
+#if defined(PDUMP)
+		PVRSRVPDumpSyncPol( gc->ps3DDevData->psConnection,
+							psDstSyncInfo,
+							IMG_FALSE,
+							psDstSyncInfo->psSyncData->ui32WriteOpsPending,
+							0xFFFFFFFF);
+#endif	/*defined (PDUMP)*/
+
+		/* TwiddleSubTextureData: waiting for texture upload */
+		while (SGX2DQueryBlitsComplete(&gc->psSysContext->s3D, psDstSyncInfo, IMG_TRUE) != PVRSRV_OK)
+		{
+		}
+	}
+
+	psTex->pfnSubTwiddleData(pui8Dest, psSubTexInfo->pui8SubTexBuffer, 
+							 psMipLevel->ui32Width, psMipLevel->ui32Height,
+							 psSubTexInfo->ui32SubTexXoffset, psSubTexInfo->ui32SubTexYoffset,
+							 psSubTexInfo->ui32SubTexWidth, psSubTexInfo->ui32SubTexHeight,
+							 psSubTexInfo->ui32SubTexWidth);
+
+#if defined(PDUMP)
+	psTex->ui32LevelsToDump |= 1U<<ui32Lod;
+#endif
+
+	return IMG_TRUE;
+}
+
+
 /***********************************************************************************
  Function Name      : SetupTwiddleFns
  Inputs             : psTex
@@ -2840,21 +3003,25 @@ IMG_INTERNAL IMG_VOID SetupTwiddleFns(GLES2Texture *psTex)
 		case 1:
 		{
 			psTex->pfnReadBackData = ReadBackTwiddle8bpp;
+			psTex->pfnSubTwiddleData = DeTwiddleSubRect8bpp;
 			break;
 		}
 		case 2:
 		{
 			psTex->pfnReadBackData = ReadBackTwiddle16bpp;
+			psTex->pfnSubTwiddleData = DeTwiddleSubRect16bpp;
 			break;
 		}
 		case 4:
 		{
 			psTex->pfnReadBackData = ReadBackTwiddle32bpp;
+			psTex->pfnSubTwiddleData = DeTwiddleSubRect32bpp;
 			break;
 		}
 		default:
 		{
 			/* May get here for PVRTC - can't read back PVRTC anyway */
+			psTex->pfnSubTwiddleData = IMG_NULL;
 			break;
 		}
 	}
@@ -21,6 +21,8 @@
 
 #include "context.h"
 
+#include "psp2/swtexop.h"
+
 #if (defined(DEBUG) || defined(TIMING))
 IMG_INTERNAL IMG_UINT32 ui32TextureMemCurrent = 0;
 IMG_INTERNAL IMG_UINT32  ui32TextureMemHWM = 0;
@@ -877,6 +879,9 @@ IMG_INTERNAL IMG_BOOL TexMgrGhostTexture(GLES2Context *gc, GLES2Texture *psTex)
 		return IMG_FALSE;
 	}
 
+	/* The ghost's memory is freed once the hardware is done with it; the CPU must be done too */
+	SWTexOpWaitTexture(gc, psTex);
+
 	if (psTex->ui32NumRenderTargets)
 	{
 		IMG_UINT ui32MipLevel;
@@ -2677,6 +2682,9 @@ static IMG_VOID FreeTexture(GLES2Context *gc, GLES2Texture *psTex)
 
 	FlushUnflushedTextureRenders(gc, psTex);
 
+	/* Queued software operations write the texture memory and read psTex */
+	SWTexOpWaitTexture(gc, psTex);
+
 	for (i = 0; i < ui32MaxLevel; i++)
 	{
 		psMipLevel = &psTex->psMipLevel[i];
@@ -109,7 +109,7 @@ typedef struct GLES2MipMapLevelRec
 
 
 /* 
-** Sub texture info used for HWTQ functions.
+** Sub texture info used for HWTQ and sub-twiddle functions.
 */
 typedef struct GLES2SubTextureInfoRec
 {
@@ -208,6 +208,13 @@ typedef struct GLES2TextureRec
 								IMG_UINT32 ui32Width, IMG_UINT32 ui32Height, 
 								IMG_UINT32 ui32DstStride);
 
+	/* Twiddles a rectangle into a level in place; IMG_NULL if the texel size has none */
+	IMG_VOID (*pfnSubTwiddleData)(IMG_VOID *pvDest, const IMG_VOID *pvSrc,
+								  IMG_UINT32 ui32Width, IMG_UINT32 ui32Height,
+								  IMG_UINT32 ui32XOffset, IMG_UINT32 ui32YOffset,
+								  IMG_UINT32 ui32SubWidth, IMG_UINT32 ui32SubHeight,
+								  IMG_UINT32 ui32StrideIn);
+
 #if defined(PDUMP)
 	/* The i-th bit marks whether the i-th mipmap level must be dumped.
 	 * In a C.E.M. it marks the i-th level of every face.
@@ -228,6 +235,8 @@ typedef struct GLES2TextureRec
 	IMG_UINT32 ui32BufferOffset;
 #endif /* defined(GLES2_EXTENSION_TEXTURE_STREAM) */
 
+	/* The last software operation (psp2/swtexop.c) queued on this texture */
+	WORKPOOL_TOKEN hSwTexOpToken;
 
 } GLES2Texture;
 
@@ -337,6 +346,9 @@ IMG_UINT8 * TextureCreateLevel(GLES2Context *gc, GLES2Texture *psTex, IMG_UINT32
 							   const GLES2TextureFormat *psTexFormat, IMG_UINT32 ui32Width, IMG_UINT32 ui32Height);
 
 IMG_VOID ReadBackTextureData(GLES2Context *gc, GLES2Texture *psTex, IMG_UINT32 ui32Face, IMG_UINT32 ui32Lod, IMG_VOID *pvBuffer);
+IMG_BOOL CanTwiddleSubTexture(const GLES2Texture *psTex, const GLES2MipMapLevel *psMipLevel);
+IMG_BOOL TwiddleSubTextureData(GLES2Context *gc, GLES2Texture *psTex, IMG_UINT32 ui32Face, IMG_UINT32 ui32Lod,
+							   const GLES2SubTextureInfo *psSubTexInfo);
 IMG_VOID ReadBackTiledData(IMG_VOID *pvDest, const IMG_VOID *pvSrc,
 						   IMG_UINT32 ui32Width, IMG_UINT32 ui32Height, 
 						   const GLES2Texture *psTex);
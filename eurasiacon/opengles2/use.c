@@ -1803,6 +1803,101 @@ static GLES2_MEMERROR SetupUSESecondaryUploadTask(GLES2Context *gc, const USP_HW
 	return GLES2_NO_ERROR;
 }
 
+/* Largest variant key: the vertex stream type sizes or the fragment raster state, plus the enables and a format per texture unit */
+#define GLES2_USE_VARIANT_KEY_MAX_DWORDS	(GLES2_MAX_VERTEX_ATTRIBS + 2 + GLES2_MAX_TEXTURE_UNITS)
+
+/*****************************************************************************
+ Function Name	: HashUSEVariantKey
+ Inputs			: pui32Key, ui32KeySizeInDWords - state specific part of the key
+				  ui32ImageUnitEnables, apsTexFormat
+ Outputs		: pui32Key
+ Returns		: Hash of the key
+ Description	: UTILITY: Appends the texture enables and the formats of the enabled
+				  units to a variant key and hashes it. pui32Key must have room for
+				  GLES2_USE_VARIANT_KEY_MAX_DWORDS.
+*****************************************************************************/
+static HashValue HashUSEVariantKey(IMG_UINT32 *pui32Key, IMG_UINT32 ui32KeySizeInDWords,
+								   IMG_UINT32 ui32ImageUnitEnables, const GLES2TextureFormat **apsTexFormat)
+{
+	IMG_UINT32 i;
+
+	pui32Key[ui32KeySizeInDWords++] = ui32ImageUnitEnables;
+
+	for(i=0; i < GLES2_MAX_TEXTURE_UNITS; i++)
+	{
+		if(ui32ImageUnitEnables & (1U << i))
+		{
+			pui32Key[ui32KeySizeInDWords++] = (IMG_UINT32)(IMG_UINTPTR_T)apsTexFormat[i];
+		}
+	}
+
+	GLES_ASSERT(ui32KeySizeInDWords <= GLES2_USE_VARIANT_KEY_MAX_DWORDS);
+
+	return HashFunc(pui32Key, ui32KeySizeInDWords, STATEHASH_INIT_VALUE);
+}
+
+
+/*****************************************************************************
+ Function Name	: TextureFormatsMatch
+ Inputs			: ui32ImageUnitEnables, apsVariantTexFormat, apsTexFormat
+ Outputs		: -
+ Returns		: Whether the formats of all enabled units are the same
+ Description	: UTILITY
+*****************************************************************************/
+static IMG_BOOL TextureFormatsMatch(IMG_UINT32 ui32ImageUnitEnables, const GLES2TextureFormat **apsVariantTexFormat,
+									const GLES2TextureFormat **apsTexFormat)
+{
+	IMG_UINT32 i;
+
+	for(i=0; i < GLES2_MAX_TEXTURE_UNITS; i++)
+	{
+		if(ui32ImageUnitEnables & (1U << i))
+		{
+			if(apsVariantTexFormat[i] != apsTexFormat[i])
+			{
+				return IMG_FALSE;
+			}
+		}
+	}
+
+	return IMG_TRUE;
+}
+
+
+/*****************************************************************************
+ Function Name	: VertexVariantMatches
+ Inputs			: gc, psVertexVariant
+ Outputs		: -
+ Returns		: Whether the variant was finalised for the current vertex state
+ Description	: UTILITY: Full comparison, used once the variant hash has matched.
+*****************************************************************************/
+static IMG_BOOL VertexVariantMatches(GLES2Context *gc, GLES2USEShaderVariant *psVertexVariant)
+{
+	GLES2CompiledTextureState *psVertexTextureState = &gc->sPrim.sVertexTextureState;
+	GLES2VertexArrayObjectMachine *psVAOMachine = &(gc->sVAOMachine);
+	IMG_UINT32 i;
+
+	if((psVertexVariant->u.sVertex.ui32NumItemsPerVertex != psVAOMachine->ui32NumItemsPerVertex) ||
+	   (psVertexVariant->u.sVertex.ui32ImageUnitEnables != psVertexTextureState->ui32ImageUnitEnables))
+	{
+		return IMG_FALSE;
+	}
+
+	/* Check vertex streams match */
+	for(i=0; i < psVertexVariant->u.sVertex.ui32NumItemsPerVertex; i++)
+	{
+		if(psVertexVariant->u.sVertex.aui32StreamTypeSize[i] != psVAOMachine->apsPackedAttrib[i]->ui32CopyStreamTypeSize)
+		{
+			return IMG_FALSE;
+		}
+	}
+
+	return TextureFormatsMatch(psVertexTextureState->ui32ImageUnitEnables, 
+							   psVertexVariant->u.sVertex.apsTexFormat,
+							   psVertexTextureState->apsTexFormat);
+}
+
+
 /****************************************************************
  * Function Name  	: SetupUSEVertexShader
  * Returns        	: Error code
@@ -1813,12 +1908,14 @@ IMG_INTERNAL GLES2_MEMERROR SetupUSEVertexShader(GLES2Context *gc, IMG_BOOL *pbP
 {
 	GLES2CompiledTextureState *psVertexTextureState = &gc->sPrim.sVertexTextureState;
 	GLES2ProgramShader *psVertexShader = &gc->sProgram.psCurrentProgram->sVertex;
-	GLES2USEShaderVariant *psVertexVariant = psVertexShader->psVariant;
+	GLES2USEShaderVariant *psVertexVariant;
 	USP_HW_SHADER *psPatchedShader;
 	IMG_UINT32 ui32CodeSizeInBytes, *pui32Instruction, *pui32InstructionBase;
 	IMG_UINT32 ui32AlignSize;
-	IMG_BOOL bMatch;
 	IMG_UINT32 ui32ImageUnitEnables = psVertexTextureState->ui32ImageUnitEnables;
+	IMG_UINT32 aui32VariantKey[GLES2_USE_VARIANT_KEY_MAX_DWORDS];
+	IMG_UINT32 ui32Index;
+	HashValue tVariantHash;
 	IMG_UINT16 i;
 	GLES2_MEMERROR eError = GLES2_NO_ERROR;
 #if defined(SGX_FEATURE_VCB)
@@ -1833,55 +1930,52 @@ IMG_INTERNAL GLES2_MEMERROR SetupUSEVertexShader(GLES2Context *gc, IMG_BOOL *pbP
 	GLES_ASSERT(VAO(gc));
 
 
-	while(psVertexVariant)
+	/* Hash the state the variant depends on */
+	aui32VariantKey[0] = psVAOMachine->ui32NumItemsPerVertex;
+
+	for(i=0; i < psVAOMachine->ui32NumItemsPerVertex; i++)
+	{
+		aui32VariantKey[1 + i] = psVAOMachine->apsPackedAttrib[i]->ui32CopyStreamTypeSize;
+	}
+
+	tVariantHash = HashUSEVariantKey(aui32VariantKey, 1 + psVAOMachine->ui32NumItemsPerVertex,
+									 ui32ImageUnitEnables, psVertexTextureState->apsTexFormat);
+
+	ui32Index = tVariantHash & GLES2_USE_VARIANT_TABLE_MASK;
+
+	while((psVertexVariant = psVertexShader->sVariantTable.apsEntry[ui32Index]) != IMG_NULL)
 	{
-	    if(psVertexVariant->u.sVertex.ui32NumItemsPerVertex == psVAOMachine->ui32NumItemsPerVertex)
+		if((psVertexVariant->tVariantHash == tVariantHash) && VertexVariantMatches(gc, psVertexVariant))
 		{
-			bMatch = IMG_TRUE;
-			  
-			i = 0;
-			  
-			/* Check vertex streams match */
-			while((i < psVertexVariant->u.sVertex.ui32NumItemsPerVertex) && bMatch)
-			{
-				GLES2AttribArrayPointerMachine *psAttribPointer = psVAOMachine->apsPackedAttrib[i];
+			break;
+		}
 
-				if(psVertexVariant->u.sVertex.aui32StreamTypeSize[i] != psAttribPointer->ui32CopyStreamTypeSize)
-				{
-					bMatch = IMG_FALSE;
-				}
-				else
-				{
-					i++;
-				}
-			}
+		ui32Index = (ui32Index + 1) & GLES2_USE_VARIANT_TABLE_MASK;
+	}
 
-			/* If vertex streams match, check texture formats/enables */
-			if(bMatch && psVertexVariant->u.sVertex.ui32ImageUnitEnables == ui32ImageUnitEnables)
-			{
-				for(i=0; i < GLES2_MAX_TEXTURE_UNITS; i++)
-				{
-					if(ui32ImageUnitEnables & (1U << i))
-					{
-						if(psVertexVariant->u.sVertex.apsTexFormat[i] != psVertexTextureState->apsTexFormat[i])
-						{
-							/* If we have failed the search - break to next variant */
-							bMatch = IMG_FALSE;
-							break;
-						}
-					}
-				}
-			}
-				
-			/* If we have found a match, don't look any further */
-			if(bMatch)
+	/* Variants added once the table filled up are only on the list */
+	if(!psVertexVariant && GLES2_USE_VARIANT_TABLE_IS_FULL(&psVertexShader->sVariantTable))
+	{
+		for(psVertexVariant = psVertexShader->psVariant; psVertexVariant; psVertexVariant = psVertexVariant->psNext)
+		{
+			if((psVertexVariant->tVariantHash == tVariantHash) && VertexVariantMatches(gc, psVertexVariant))
 			{
 				break;
 			}
 		}
+	}
+
+	if(psVertexVariant)
+	{
+		psVertexVariant->ui32LastUsed = ++psVertexShader->sVariantTable.ui32UseStamp;
+
+		GLES2_INC_COUNT(GLES2_TIMER_USE_VARIANT_HIT_COUNT, 1);
+	}
+	else
+	{
+		GLES2_INC_COUNT(GLES2_TIMER_USE_VARIANT_MISS_COUNT, 1);
 
-		/* Check the next vertex variant */
-		psVertexVariant = psVertexVariant->psNext;
+		EvictUSEShaderVariants(gc, psVertexShader);
 	}
 
 	if(!psVertexVariant)
@@ -1894,6 +1988,7 @@ IMG_INTERNAL GLES2_MEMERROR SetupUSEVertexShader(GLES2Context *gc, IMG_BOOL *pbP
 		}
 
 		psVertexVariant->psProgramShader = psVertexShader;
+		psVertexVariant->tVariantHash = tVariantHash;
 
 		/* Add 1 instruction (PHAS) space at the beginning of uProgStartInstIdx (UniPatchShader) */
 #if defined(SGX_FEATURE_USE_UNLIMITED_PHASES)
@@ -2061,8 +2156,7 @@ IMG_INTERNAL GLES2_MEMERROR SetupUSEVertexShader(GLES2Context *gc, IMG_BOOL *pbP
 		}
 
 		/* Add to variant list */
-		psVertexVariant->psNext = psVertexShader->psVariant;
-		psVertexShader->psVariant = psVertexVariant;
+		AddUSEShaderVariant(gc, psVertexShader, psVertexVariant);
 	}
 
 	/* Set current variant */
@@ -2498,6 +2592,29 @@ static IMG_VOID SetupIteratorsAndTextureLookups(GLES2Context *gc,
  *
  ****************************************************************************************/
 
+/*****************************************************************************
+ Function Name	: FragmentVariantMatches
+ Inputs			: gc, psFragmentVariant, ui32BlendEquation, bSeparateBlendPhase
+ Outputs		: -
+ Returns		: Whether the variant was finalised for the current fragment state
+ Description	: UTILITY: Full comparison, used once the variant hash has matched.
+*****************************************************************************/
+static IMG_BOOL FragmentVariantMatches(GLES2Context *gc, GLES2USEShaderVariant *psFragmentVariant,
+									   IMG_UINT32 ui32BlendEquation, IMG_BOOL bSeparateBlendPhase)
+{
+	GLES2CompiledTextureState *psFragmentTextureState = &gc->sPrim.sFragmentTextureState;
+
+	return ((psFragmentVariant->u.sFragment.ui32ColorMask == gc->sState.sRaster.ui32ColorMask) && 
+			(psFragmentVariant->u.sFragment.ui32BlendEquation == ui32BlendEquation) && 
+			(psFragmentVariant->u.sFragment.ui32BlendFactor == gc->sState.sRaster.ui32BlendFactor) && 
+			(psFragmentVariant->u.sFragment.bSeparateBlendPhase == bSeparateBlendPhase) && 
+			(psFragmentVariant->u.sFragment.ui32ImageUnitEnables == psFragmentTextureState->ui32ImageUnitEnables) &&
+			TextureFormatsMatch(psFragmentTextureState->ui32ImageUnitEnables,
+								psFragmentVariant->u.sFragment.apsTexFormat,
+								psFragmentTextureState->apsTexFormat));
+}
+
+
 /****************************************************************
  * Function Name  	: SetupUSEFragmentShader
  * Returns        	: Error code
@@ -2512,7 +2629,7 @@ IMG_INTERNAL GLES2_MEMERROR SetupUSEFragmentShader(GLES2Context *gc, IMG_BOOL *p
 	GLES2CompiledRenderState *psRenderState = &gc->sPrim.sRenderState;
 	GLES2CompiledTextureState *psFragmentTextureState = &gc->sPrim.sFragmentTextureState;
 	GLES2ProgramShader *psFragmentShader = &gc->sProgram.psCurrentProgram->sFragment;
-	GLES2USEShaderVariant *psFragmentVariant = psFragmentShader->psVariant;
+	GLES2USEShaderVariant *psFragmentVariant;
 	USP_HW_SHADER *psPatchedShader;
 	IMG_UINT32 ui32PlaneCoeffPAReg = 0;
 	IMG_UINT32 aui32FBBlendUSECode[GLES2_FBBLEND_MAX_CODE_SIZE_IN_DWORDS];
@@ -2525,7 +2642,9 @@ IMG_INTERNAL GLES2_MEMERROR SetupUSEFragmentShader(GLES2Context *gc, IMG_BOOL *p
 	IMG_UINT32 ui32NumTemps = 0, ui32NumBlendTemps = 0;
 	IMG_UINT32 ui32BlendEquation;
 	IMG_UINT32 ui32ImageUnitEnables = psFragmentTextureState->ui32ImageUnitEnables;
-	IMG_BOOL bMatch;
+	IMG_UINT32 aui32VariantKey[GLES2_USE_VARIANT_KEY_MAX_DWORDS];
+	IMG_UINT32 ui32Index;
+	HashValue tVariantHash;
 	IMG_BOOL bSeparateBlendPhase = IMG_FALSE;
 	IMG_UINT16 i;
 	IMG_UINT32 ui32PreambleCount = 0;
@@ -2556,38 +2675,49 @@ IMG_INTERNAL GLES2_MEMERROR SetupUSEFragmentShader(GLES2Context *gc, IMG_BOOL *p
 		bSeparateBlendPhase = IMG_TRUE;
 	}
 
-	while(psFragmentVariant)
+	/* Hash the state the variant depends on */
+	aui32VariantKey[0] = gc->sState.sRaster.ui32ColorMask;
+	aui32VariantKey[1] = ui32BlendEquation;
+	aui32VariantKey[2] = gc->sState.sRaster.ui32BlendFactor;
+	aui32VariantKey[3] = (IMG_UINT32)bSeparateBlendPhase;
+
+	tVariantHash = HashUSEVariantKey(aui32VariantKey, 4, ui32ImageUnitEnables, psFragmentTextureState->apsTexFormat);
+
+	ui32Index = tVariantHash & GLES2_USE_VARIANT_TABLE_MASK;
+
+	while((psFragmentVariant = psFragmentShader->sVariantTable.apsEntry[ui32Index]) != IMG_NULL)
 	{
-		if((psFragmentVariant->u.sFragment.ui32ColorMask == gc->sState.sRaster.ui32ColorMask) && 
-			(psFragmentVariant->u.sFragment.ui32BlendEquation == ui32BlendEquation) && 
-			(psFragmentVariant->u.sFragment.ui32BlendFactor == gc->sState.sRaster.ui32BlendFactor) && 
-			(psFragmentVariant->u.sFragment.bSeparateBlendPhase == bSeparateBlendPhase) && 
-			(psFragmentVariant->u.sFragment.ui32ImageUnitEnables == ui32ImageUnitEnables))
+		if((psFragmentVariant->tVariantHash == tVariantHash) && FragmentVariantMatches(gc, psFragmentVariant, ui32BlendEquation, bSeparateBlendPhase))
 		{
-			/* If raster state matches, check texture formats */
-			bMatch = IMG_TRUE;
+			break;
+		}
 
-			for(i=0; i < GLES2_MAX_TEXTURE_UNITS; i++)
-			{
-				if(ui32ImageUnitEnables & (1 << i))
-				{
-					if(psFragmentVariant->u.sFragment.apsTexFormat[i] != psFragmentTextureState->apsTexFormat[i])
-					{
-						/* If we have failed the search - break to next variant */
-						bMatch = IMG_FALSE;
-						break;
-					}
-				}
-			}
+		ui32Index = (ui32Index + 1) & GLES2_USE_VARIANT_TABLE_MASK;
+	}
 
-			/* If we have found a match, don't look any further */
-			if(bMatch)
+	/* Variants added once the table filled up are only on the list */
+	if(!psFragmentVariant && GLES2_USE_VARIANT_TABLE_IS_FULL(&psFragmentShader->sVariantTable))
+	{
+		for(psFragmentVariant = psFragmentShader->psVariant; psFragmentVariant; psFragmentVariant = psFragmentVariant->psNext)
+		{
+			if((psFragmentVariant->tVariantHash == tVariantHash) && FragmentVariantMatches(gc, psFragmentVariant, ui32BlendEquation, bSeparateBlendPhase))
 			{
 				break;
 			}
 		}
+	}
+
+	if(psFragmentVariant)
+	{
+		psFragmentVariant->ui32LastUsed = ++psFragmentShader->sVariantTable.ui32UseStamp;
+
+		GLES2_INC_COUNT(GLES2_TIMER_USE_VARIANT_HIT_COUNT, 1);
+	}
+	else
+	{
+		GLES2_INC_COUNT(GLES2_TIMER_USE_VARIANT_MISS_COUNT, 1);
 
-		psFragmentVariant = psFragmentVariant->psNext;
+		EvictUSEShaderVariants(gc, psFragmentShader);
 	}
 
 	if(!psFragmentVariant)
@@ -2605,6 +2735,8 @@ IMG_INTERNAL GLES2_MEMERROR SetupUSEFragmentShader(GLES2Context *gc, IMG_BOOL *p
 			return GLES2_HOST_MEM_ERROR;
 		}
 
+		psFragmentVariant->tVariantHash = tVariantHash;
+
 		/* Setup state to for variant */
 		psFragmentVariant->u.sFragment.ui32BlendEquation = ui32BlendEquation;
 		psFragmentVariant->u.sFragment.ui32BlendFactor = gc->sState.sRaster.ui32BlendFactor;
@@ -3210,8 +3342,7 @@ IMG_INTERNAL GLES2_MEMERROR SetupUSEFragmentShader(GLES2Context *gc, IMG_BOOL *p
 		psFragmentVariant->ui32MaxTempRegs = MAX(psFragmentVariant->ui32MaxTempRegs,  ui32NumBlendTemps);
 	
 		/* Add to variant list */
-		psFragmentVariant->psNext = psFragmentShader->psVariant;
-		psFragmentShader->psVariant = psFragmentVariant;
+		AddUSEShaderVariant(gc, psFragmentShader, psFragmentVariant);
 
 		*pbProgramChanged = IMG_TRUE;
 
@@ -3285,6 +3416,35 @@ IMG_INTERNAL GLES2_MEMERROR SetupUSEFragmentShader(GLES2Context *gc, IMG_BOOL *p
  *
  ****************************************************************************************/
 
+/*****************************************************************************
+ Function Name	: FragmentVariantMatches
+ Inputs			: gc, psFragmentVariant, ui32BlendEquation, bReadOnlyPAs
+ Outputs		: -
+ Returns		: Whether the variant was finalised for the current fragment state
+ Description	: UTILITY: Full comparison, used once the variant hash has matched.
+*****************************************************************************/
+static IMG_BOOL FragmentVariantMatches(GLES2Context *gc, GLES2USEShaderVariant *psFragmentVariant,
+									   IMG_UINT32 ui32BlendEquation, IMG_BOOL bReadOnlyPAs)
+{
+	GLES2CompiledTextureState *psFragmentTextureState = &gc->sPrim.sFragmentTextureState;
+#if defined(FIX_HW_BRN_25077)
+	GLES2CompiledRenderState *psRenderState = &gc->sPrim.sRenderState;
+#endif
+
+	return ((psFragmentVariant->u.sFragment.ui32ColorMask == gc->sState.sRaster.ui32ColorMask) && 
+			(psFragmentVariant->u.sFragment.ui32BlendEquation == ui32BlendEquation) && 
+			(psFragmentVariant->u.sFragment.ui32BlendFactor == gc->sState.sRaster.ui32BlendFactor) && 
+			(psFragmentVariant->u.sFragment.bReadOnlyPAs == bReadOnlyPAs) && 
+#if defined(FIX_HW_BRN_25077)
+			(psFragmentVariant->u.sFragment.ui32AlphaTestFlags == psRenderState->ui32AlphaTestFlags) &&
+#endif
+			(psFragmentVariant->u.sFragment.ui32ImageUnitEnables == psFragmentTextureState->ui32ImageUnitEnables) &&
+			TextureFormatsMatch(psFragmentTextureState->ui32ImageUnitEnables,
+								psFragmentVariant->u.sFragment.apsTexFormat,
+								psFragmentTextureState->apsTexFormat));
+}
+
+
 /****************************************************************
  * Function Name  	: SetupUSEFragmentShader
  * Returns        	: Error code
@@ -3297,7 +3457,7 @@ IMG_INTERNAL GLES2_MEMERROR SetupUSEFragmentShader(GLES2Context *gc, IMG_BOOL *p
 	GLES2CompiledRenderState *psRenderState = &gc->sPrim.sRenderState;
 	GLES2CompiledTextureState *psFragmentTextureState = &gc->sPrim.sFragmentTextureState;
 	GLES2ProgramShader *psFragmentShader = &gc->sProgram.psCurrentProgram->sFragment;
-	GLES2USEShaderVariant *psFragmentVariant = psFragmentShader->psVariant;
+	GLES2USEShaderVariant *psFragmentVariant;
 	USP_HW_SHADER *psPatchedShader;
 	IMG_UINT32 ui32PlaneCoeffPAReg = 0;
 	IMG_UINT32 aui32FBBlendUSECode[GLES2_FBBLEND_MAX_CODE_SIZE_IN_DWORDS];
@@ -3310,7 +3470,9 @@ IMG_INTERNAL GLES2_MEMERROR SetupUSEFragmentShader(GLES2Context *gc, IMG_BOOL *p
 	IMG_UINT32 ui32NumTemps = 0;
 	IMG_UINT32 ui32BlendEquation;
 	IMG_UINT32 ui32ImageUnitEnables = psFragmentTextureState->ui32ImageUnitEnables;
-	IMG_BOOL bMatch;
+	IMG_UINT32 aui32VariantKey[GLES2_USE_VARIANT_KEY_MAX_DWORDS];
+	IMG_UINT32 ui32Index;
+	HashValue tVariantHash;
 	IMG_UINT16 i;
 	IMG_BOOL bReadOnlyPAs = IMG_FALSE;
 	IMG_UINT32 ui32PreambleCount = 0;
@@ -3344,41 +3506,54 @@ IMG_INTERNAL GLES2_MEMERROR SetupUSEFragmentShader(GLES2Context *gc, IMG_BOOL *p
 		bReadOnlyPAs = IMG_TRUE;
 	}
 
-	while(psFragmentVariant)
-	{
-		if((psFragmentVariant->u.sFragment.ui32ColorMask == gc->sState.sRaster.ui32ColorMask) && 
-			(psFragmentVariant->u.sFragment.ui32BlendEquation == ui32BlendEquation) && 
-			(psFragmentVariant->u.sFragment.ui32BlendFactor == gc->sState.sRaster.ui32BlendFactor) && 
-			(psFragmentVariant->u.sFragment.bReadOnlyPAs == bReadOnlyPAs) && 
+	/* Hash the state the variant depends on */
+	aui32VariantKey[0] = gc->sState.sRaster.ui32ColorMask;
+	aui32VariantKey[1] = ui32BlendEquation;
+	aui32VariantKey[2] = gc->sState.sRaster.ui32BlendFactor;
+	aui32VariantKey[3] = (IMG_UINT32)bReadOnlyPAs;
 #if defined(FIX_HW_BRN_25077)
-			(psFragmentVariant->u.sFragment.ui32AlphaTestFlags == psRenderState->ui32AlphaTestFlags) &&
+	aui32VariantKey[4] = psRenderState->ui32AlphaTestFlags;
+
+	tVariantHash = HashUSEVariantKey(aui32VariantKey, 5, ui32ImageUnitEnables, psFragmentTextureState->apsTexFormat);
+#else
+	tVariantHash = HashUSEVariantKey(aui32VariantKey, 4, ui32ImageUnitEnables, psFragmentTextureState->apsTexFormat);
 #endif
-			(psFragmentVariant->u.sFragment.ui32ImageUnitEnables == ui32ImageUnitEnables))
+
+	ui32Index = tVariantHash & GLES2_USE_VARIANT_TABLE_MASK;
+
+	while((psFragmentVariant = psFragmentShader->sVariantTable.apsEntry[ui32Index]) != IMG_NULL)
+	{
+		if((psFragmentVariant->tVariantHash == tVariantHash) && FragmentVariantMatches(gc, psFragmentVariant, ui32BlendEquation, bReadOnlyPAs))
 		{
-			/* If raster state matches, check texture formats */
-			bMatch = IMG_TRUE;
+			break;
+		}
 
-			for(i=0; i < GLES2_MAX_TEXTURE_UNITS; i++)
-			{
-				if(ui32ImageUnitEnables & (1U << i))
-				{
-					if(psFragmentVariant->u.sFragment.apsTexFormat[i] != psFragmentTextureState->apsTexFormat[i])
-					{
-						/* If we have failed the search - break to next variant */
-						bMatch = IMG_FALSE;
-						break;
-					}
-				}
-			}
+		ui32Index = (ui32Index + 1) & GLES2_USE_VARIANT_TABLE_MASK;
+	}
 
-			/* If we have found a match, don't look any further */
-			if(bMatch)
+	/* Variants added once the table filled up are only on the list */
+	if(!psFragmentVariant && GLES2_USE_VARIANT_TABLE_IS_FULL(&psFragmentShader->sVariantTable))
+	{
+		for(psFragmentVariant = psFragmentShader->psVariant; psFragmentVariant; psFragmentVariant = psFragmentVariant->psNext)
+		{
+			if((psFragmentVariant->tVariantHash == tVariantHash) && FragmentVariantMatches(gc, psFragmentVariant, ui32BlendEquation, bReadOnlyPAs))
 			{
 				break;
 			}
 		}
+	}
+
+	if(psFragmentVariant)
+	{
+		psFragmentVariant->ui32LastUsed = ++psFragmentShader->sVariantTable.ui32UseStamp;
 
-		psFragmentVariant = psFragmentVariant->psNext;
+		GLES2_INC_COUNT(GLES2_TIMER_USE_VARIANT_HIT_COUNT, 1);
+	}
+	else
+	{
+		GLES2_INC_COUNT(GLES2_TIMER_USE_VARIANT_MISS_COUNT, 1);
+
+		EvictUSEShaderVariants(gc, psFragmentShader);
 	}
 
 	if(!psFragmentVariant)
@@ -3393,6 +3568,8 @@ IMG_INTERNAL GLES2_MEMERROR SetupUSEFragmentShader(GLES2Context *gc, IMG_BOOL *p
 			return GLES2_HOST_MEM_ERROR;
 		}
 
+		psFragmentVariant->tVariantHash = tVariantHash;
+
 		/* Setup state to for variant */
 		psFragmentVariant->u.sFragment.ui32BlendEquation = ui32BlendEquation;
 		psFragmentVariant->u.sFragment.ui32BlendFactor = gc->sState.sRaster.ui32BlendFactor;
@@ -3465,7 +3642,7 @@ IMG_INTERNAL GLES2_MEMERROR SetupUSEFragmentShader(GLES2Context *gc, IMG_BOOL *p
 		if(bReadOnlyPAs)
 		{
 			psPatchedShader = PVRUniPatchFinaliseShader(gc->sProgram.pvUniPatchContext, 
-													psFragmentShader->psSharedState->pvUniPatchShaderMSAATrans);
+													GetUniPatchShaderMSAATrans(gc, psFragmentShader->psSharedState));
 		}
 		else
 		{
@@ -3867,8 +4044,7 @@ IMG_INTERNAL GLES2_MEMERROR SetupUSEFragmentShader(GLES2Context *gc, IMG_BOOL *p
 		pui32USECode[-1] |= EURASIA_USE1_END;
 		
 		/* Add to variant list */
-		psFragmentVariant->psNext = psFragmentShader->psVariant;
-		psFragmentShader->psVariant = psFragmentVariant;
+		AddUSEShaderVariant(gc, psFragmentShader, psFragmentVariant);
 
 		*pbProgramChanged = IMG_TRUE;
 
@@ -37,7 +37,8 @@
 
 #define GLES2_VISIBILITYTEST_NUM_PHASE1_INSTRUCTIONS	1
 
-/* Important! Changes to these values should be reflected in oglcompiler/esbincompiler.c */
+/* Important! Changes to these values should be reflected in oglcompiler/esbincompiler.c
+   and host/glslcsgx/main.c */
 #define GLES2_FRAGMENT_SECATTR_CONSTANTBASE				0x00000000
 #define GLES2_FRAGMENT_SECATTR_INDEXABLETEMPBASE		0x00000001
 #define GLES2_FRAGMENT_SECATTR_FBBLENDCONST				0x00000002
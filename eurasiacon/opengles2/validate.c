@@ -356,7 +356,7 @@ IMG_INTERNAL GLES2_MEMERROR OutputTerminateState(GLES2Context *gc,
 
 
 		/* Dummy vertex secondary program */
-		pui32Buffer = PDSGeneratePixelShaderSAProgram(&sSAProgram, pui32BufferBase);
+		pui32Buffer = PDSGeneratePixelShaderSAProgram(&sSAProgram, pui32BufferBase, IMG_NULL);
 
 		GLES_ASSERT((IMG_UINT32)(pui32Buffer - pui32BufferBase) <= PDS_TERMINATE_SAUPDATE_DWORDS);
 
@@ -935,6 +935,7 @@ static GLES2_MEMERROR WritePDSPixelShaderProgram(GLES2Context *gc, IMG_BOOL *pbC
 	GLES2ProgramShader *psShader = &gc->sProgram.psCurrentProgram->sFragment;
 	GLES2USEShaderVariant *psFragmentVariant = gc->sProgram.psCurrentFragmentVariant;
 	GLES2PDSCodeVariant *psPDSVariant;
+	GLES2PDSPixelTemplate *psPDSTemplate;
 	GLES2PDSInfo *psPDSInfo = &psFragmentVariant->u.sFragment.sPDSInfo;
 	USP_HW_SHADER *psPatchedShader = psFragmentVariant->psPatchedShader;
 	IMG_UINT32 *pui32ChunkCount = gc->sPrim.sFragmentTextureState.aui32ChunkCount;
@@ -1291,11 +1292,62 @@ static GLES2_MEMERROR WritePDSPixelShaderProgram(GLES2Context *gc, IMG_BOOL *pbC
 		}
 
 		/*
-			Generate the PDS pixel state program
+			Patch a copy of the first PDS pixel state program generated for this USE variant, or generate it
 		*/
-		pui32Buffer = PDSGeneratePixelShaderProgram(psTextureState->psTextureImageChunks, 
-													&sProgram, 
-													pui32BufferBase);
+		psPDSTemplate = psFragmentVariant->psPDSTemplate;
+
+		if(psPDSTemplate && 
+		   (psPDSTemplate->ui32ProgramSizeInDWords <= ui32PDSProgramSize))
+		{
+			GLES2MemCopy(pui32BufferBase, psPDSTemplate->pui32Program, psPDSTemplate->ui32ProgramSizeInDWords << 2);
+
+			if(PDSPatchPixelShaderProgram(&psPDSTemplate->sProgramInfo,
+										  psTextureState->psTextureImageChunks,
+										  &sProgram,
+										  pui32BufferBase))
+			{
+				pui32Buffer = pui32BufferBase + psPDSTemplate->ui32ProgramSizeInDWords;
+
+				GLES2_INC_COUNT(GLES2_TIMER_PDSVARIANT_PATCH_COUNT, 1);
+			}
+			else
+			{
+				pui32Buffer = IMG_NULL;
+			}
+		}
+		else
+		{
+			pui32Buffer = IMG_NULL;
+		}
+
+		if(!pui32Buffer)
+		{
+			PDS_PIXEL_SHADER_PROGRAM_INFO sProgramInfo;
+
+			pui32Buffer = PDSGeneratePixelShaderProgram(psTextureState->psTextureImageChunks, 
+														&sProgram, 
+														pui32BufferBase,
+														&sProgramInfo);
+
+			/* Failing to keep the program is not an error - the next miss will generate it again */
+			if(!psPDSTemplate)
+			{
+				IMG_UINT32 ui32ProgramSizeInDWords = (IMG_UINT32)(pui32Buffer - pui32BufferBase);
+
+				psPDSTemplate = GLES2Malloc(gc, sizeof(GLES2PDSPixelTemplate) + (ui32ProgramSizeInDWords << 2));
+
+				if(psPDSTemplate)
+				{
+					GLES2MemCopy(&psPDSTemplate->sProgramInfo, &sProgramInfo, sizeof(PDS_PIXEL_SHADER_PROGRAM_INFO));
+					psPDSTemplate->ui32ProgramSizeInDWords = ui32ProgramSizeInDWords;
+					psPDSTemplate->pui32Program = (IMG_UINT32 *)(psPDSTemplate + 1);
+
+					GLES2MemCopy(psPDSTemplate->pui32Program, pui32BufferBase, ui32ProgramSizeInDWords << 2);
+
+					psFragmentVariant->psPDSTemplate = psPDSTemplate;
+				}
+			}
+		}
 
 		GLES_ASSERT((IMG_UINT32)(pui32Buffer - pui32BufferBase) <= ui32PDSProgramSize);
 
@@ -1389,6 +1441,117 @@ static GLES2_MEMERROR WritePDSPixelShaderProgram(GLES2Context *gc, IMG_BOOL *pbC
 }
 
 
+/***********************************************************************************
+ Function Name      : DestroyHashedPDSVertexProgram
+ Inputs             : gc, ui32Item
+ Outputs            : -
+ Returns            : -
+ Description        : Frees a cached PDS vertex program when it is evicted from
+					  the PDS vertex program hash table
+************************************************************************************/
+IMG_INTERNAL IMG_VOID DestroyHashedPDSVertexProgram(GLES2Context *gc, IMG_UINT32 ui32Item)
+{
+	PVR_UNREFERENCED_PARAMETER(gc);
+
+	GLES2Free(IMG_NULL, (GLES2PDSVertexProgramCacheEntry *)ui32Item);
+}
+
+
+/****************************************************************************************************
+ Function Name	: GeneratePDSVertexShaderProgramCached
+ Inputs			: gc, psProgram
+ Outputs		: psPDSVertexState
+ Returns		: -
+ Description	: Produces the PDS vertex program for psProgram into psPDSVertexState. If a program
+				  with the same stream layout has been generated before, the cached code is copied
+				  and only the stream addresses and USE task control words are patched.
+*****************************************************************************************************/
+static IMG_VOID GeneratePDSVertexShaderProgramCached(GLES2Context *gc,
+													 PDS_VERTEX_SHADER_PROGRAM *psProgram,
+													 GLES2PDSVertexState *psPDSVertexState)
+{
+	GLES2PDSVertexProgramCacheEntry *psEntry = IMG_NULL;
+	IMG_UINT32 *pui32Key = gc->sPrim.aui32PDSVertexProgramKey;
+	IMG_UINT32 ui32KeySizeInDWords, *pui32KeyCopy, *pui32Buffer;
+	HashValue tHashValue;
+
+	ui32KeySizeInDWords = PDSGetVertexShaderProgramKey(psProgram, pui32Key, GLES2_PDS_VERTEX_PROGRAM_KEY_DWORDS);
+
+	tHashValue = HashFunc(pui32Key, ui32KeySizeInDWords, STATEHASH_INIT_VALUE);
+
+	if(HashTableSearch(gc, &gc->sPrim.sPDSVertexProgramHashTable, tHashValue,
+					   pui32Key, ui32KeySizeInDWords, (IMG_UINT32 *)&psEntry))
+	{
+		GLES2MemCopy(psPDSVertexState->aui32LastPDSProgram, psEntry->aui32Program, psEntry->ui32ProgramSize << 2);
+		GLES2MemCopy(&psPDSVertexState->sProgramInfo, &psEntry->sProgramInfo, sizeof(PDS_VERTEX_SHADER_PROGRAM_INFO));
+
+		PDSRetargetVertexShaderProgram(psProgram, &psPDSVertexState->sProgramInfo, psPDSVertexState->aui32LastPDSProgram);
+
+		psPDSVertexState->ui32ProgramSize = psEntry->ui32ProgramSize;
+
+#if defined(DEBUG)
+		{
+			/* The patched program must be identical to a freshly generated one */
+			IMG_UINT32 aui32Reference[EURASIA_NUM_PDS_VERTEX_PROGRAM_DWORDS];
+			PDS_VERTEX_SHADER_PROGRAM_INFO sReferenceInfo;
+			IMG_UINT32 i;
+
+			/* The generator leaves alignment padding unwritten, so start from the same padding */
+			GLES2MemCopy(aui32Reference, psPDSVertexState->aui32LastPDSProgram, psEntry->ui32ProgramSize << 2);
+
+			pui32Buffer = PDSGenerateVertexShaderProgram(psProgram, aui32Reference, &sReferenceInfo);
+
+			GLES_ASSERT((IMG_UINT32)(pui32Buffer - aui32Reference) == psEntry->ui32ProgramSize);
+
+			for (i = 0; i < psEntry->ui32ProgramSize; i++)
+			{
+				GLES_ASSERT(aui32Reference[i] == psPDSVertexState->aui32LastPDSProgram[i]);
+			}
+		}
+#endif /* defined(DEBUG) */
+
+		GLES2_INC_COUNT(GLES2_TIMER_PDS_VERTEX_PROGRAM_CACHE_HIT_COUNT, 1);
+
+		return;
+	}
+
+	GLES2_INC_COUNT(GLES2_TIMER_PDS_VERTEX_PROGRAM_CACHE_MISS_COUNT, 1);
+
+	/* Generate the PDS Program for this shader */
+	pui32Buffer = (IMG_UINT32 *)PDSGenerateVertexShaderProgram(psProgram, 
+															   psPDSVertexState->aui32LastPDSProgram,
+															   &(psPDSVertexState->sProgramInfo));
+
+	psPDSVertexState->ui32ProgramSize = (IMG_UINT32)(pui32Buffer - (psPDSVertexState->aui32LastPDSProgram));
+
+	/* Failing to cache the program is not an error - it will just be generated again next time */
+	psEntry = GLES2Malloc(gc, sizeof(GLES2PDSVertexProgramCacheEntry));
+
+	if(!psEntry)
+	{
+		return;
+	}
+
+	pui32KeyCopy = GLES2Malloc(gc, ui32KeySizeInDWords * sizeof(IMG_UINT32));
+
+	if(!pui32KeyCopy)
+	{
+		GLES2Free(IMG_NULL, psEntry);
+
+		return;
+	}
+
+	GLES2MemCopy(pui32KeyCopy, pui32Key, ui32KeySizeInDWords * sizeof(IMG_UINT32));
+	GLES2MemCopy(&psEntry->sProgramInfo, &psPDSVertexState->sProgramInfo, sizeof(PDS_VERTEX_SHADER_PROGRAM_INFO));
+	GLES2MemCopy(psEntry->aui32Program, psPDSVertexState->aui32LastPDSProgram, psPDSVertexState->ui32ProgramSize << 2);
+
+	psEntry->ui32ProgramSize = psPDSVertexState->ui32ProgramSize;
+
+	HashTableInsert(gc, &gc->sPrim.sPDSVertexProgramHashTable, tHashValue,
+					pui32KeyCopy, ui32KeySizeInDWords, (IMG_UINT32)psEntry);
+}
+
+
 /****************************************************************************************************
  Function Name	: WritePDSVertexShaderProgramWithVAO 
  Inputs			: gc, b32BitIndices
@@ -1398,7 +1561,7 @@ static GLES2_MEMERROR WritePDSPixelShaderProgram(GLES2Context *gc, IMG_BOOL *pbC
 *****************************************************************************************************/
 static GLES2_MEMERROR WritePDSVertexShaderProgramWithVAO(GLES2Context *gc, IMG_BOOL b32BitIndices)
 {
-    IMG_UINT32 i, *pui32Buffer;
+    IMG_UINT32 i;
 	GLES2ProgramShader    *psVertexShader  = &(gc->sProgram.psCurrentProgram->sVertex);
 	GLES2USEShaderVariant *psVertexVariant = gc->sProgram.psCurrentVertexVariant;
 	IMG_UINT32             ui32NumTemps;
@@ -1851,13 +2014,8 @@ static GLES2_MEMERROR WritePDSVertexShaderProgramWithVAO(GLES2Context *gc, IMG_B
 				}
 			}
 
-			/* Generate the PDS Program for this shader */
-			pui32Buffer = (IMG_UINT32 *)PDSGenerateVertexShaderProgram(psPDSVertexShaderProgram, 
-																	   psPDSVertexState->aui32LastPDSProgram,
-																	   &(psPDSVertexState->sProgramInfo));
-
-			psPDSVertexState->ui32ProgramSize = (IMG_UINT32)(pui32Buffer - (psPDSVertexState->aui32LastPDSProgram));
-			
+			/* Generate the PDS Program for this shader, or reuse one with the same stream layout */
+			GeneratePDSVertexShaderProgramCached(gc, psPDSVertexShaderProgram, psPDSVertexState);
 
 			GLES2_TIME_STOP(GLES2_TIMER_GENERATE_PDS_VERTEX_SHADER_PROGRAM_VAO_TIME);
 			
@@ -2521,7 +2679,7 @@ static GLES2_MEMERROR WritePDSUSEShaderSAProgram(GLES2Context *gc, IMG_UINT32 ui
 	/*
 		Generate the PDS pixel state program
 	*/
-	pui32Buffer = (IMG_UINT32 *)PDSGeneratePixelShaderSAProgram(&sProgram, pui32BufferBase);
+	pui32Buffer = (IMG_UINT32 *)PDSGeneratePixelShaderSAProgram(&sProgram, pui32BufferBase, IMG_NULL);
 
 	/*
 		Update buffer position 
@@ -146,6 +146,24 @@ typedef struct GLES2PDSVertexState_TAG
 	IMG_UINT32 ui32ProgramSize;
 }GLES2PDSVertexState;
 
+/*
+	The code and the patch offsets of a generated PDS vertex program only depend on
+	the stream layout, so programs are cached by layout and only the stream addresses
+	and USE task control words are patched on a hit.
+*/
+#define GLES2_PDS_VERTEX_PROGRAM_CACHE_LOG2SIZE		6
+#define GLES2_PDS_VERTEX_PROGRAM_CACHE_MAXENTRIES	64
+
+/* GLES2 only uses one element per stream */
+#define GLES2_PDS_VERTEX_PROGRAM_KEY_DWORDS			PDS_VERTEX_SHADER_PROGRAM_KEY_DWORDS(GLES2_MAX_VERTEX_ATTRIBS, GLES2_MAX_VERTEX_ATTRIBS)
+
+typedef struct GLES2PDSVertexProgramCacheEntry_TAG
+{
+	PDS_VERTEX_SHADER_PROGRAM_INFO sProgramInfo;
+	IMG_UINT32 ui32ProgramSize;
+	IMG_UINT32 aui32Program[EURASIA_NUM_PDS_VERTEX_PROGRAM_DWORDS];
+}GLES2PDSVertexProgramCacheEntry;
+
 
 #define GLES2_ALPHA_TEST_DISCARD		(1U << 0)
 #define GLES2_ALPHA_TEST_WAS_TWD		(1U << 1)
@@ -207,6 +225,10 @@ typedef struct GLES2PrimitiveMachine_TAG
 	
 	GLES2PDSVertexState			*psPDSVertexState;
 
+	/* Cache of generated PDS vertex programs, keyed by stream layout */
+	HashTable					sPDSVertexProgramHashTable;
+	IMG_UINT32					aui32PDSVertexProgramKey[GLES2_PDS_VERTEX_PROGRAM_KEY_DWORDS];
+
 	UCH_UseCodeBlock			*psHWBGCodeBlock;
 #if defined(FIX_HW_BRN_26922)
 	GLES2BRN26922State			sBRN26922State;
@@ -306,5 +328,7 @@ GLES2_MEMERROR SendDepthBiasPrims(GLES2Context *gc);
 
 IMG_VOID AttachAllUsedBOsAndVAOToCurrentKick(GLES2Context *gc);
 
+IMG_VOID DestroyHashedPDSVertexProgram(GLES2Context *gc, IMG_UINT32 ui32Item);
+
 
 #endif /* _VALIDATE_ */
@@ -0,0 +1,268 @@
+/******************************************************************************
+ * Name         : psp2_pacing.c
+ *
+ * Copyright    : 2010 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means, electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Platform     : ANSI
+ *
+ * $Log: psp2_pacing.c $
+ *****************************************************************************/
+
+#include "psp2_pacing.h"
+
+/* Vblank counts wrap: compare them by their difference */
+#define VCOUNT_AFTER(a, b)	((IMG_INT32)((a) - (b)) > 0)
+
+/***********************************************************************************
+ Function Name      : Psp2PacingInit
+ Inputs             : ui32RefreshUs, ui32SwapInterval
+ Outputs            : psPacing
+ Returns            : -
+ Description        : Sets up the pacer of a new flip chain with no flips queued
+************************************************************************************/
+IMG_INTERNAL IMG_VOID Psp2PacingInit(PSP2_PACING *psPacing, IMG_UINT32 ui32RefreshUs, IMG_UINT32 ui32SwapInterval)
+{
+	IMG_UINT8 *pui8Pacing = (IMG_UINT8 *)psPacing;
+	IMG_UINT32 i;
+
+	for (i = 0; i < sizeof(*psPacing); i++)
+	{
+		pui8Pacing[i] = 0;
+	}
+
+	psPacing->ui32RefreshUs = ui32RefreshUs ? ui32RefreshUs : 1;
+	psPacing->ui32SwapInterval = ui32SwapInterval;
+	psPacing->bAdaptive = IMG_FALSE;
+}
+
+/***********************************************************************************
+ Function Name      : Psp2PacingSetSwapInterval
+ Inputs             : psPacing, ui32SwapInterval
+ Outputs            : -
+ Returns            : -
+ Description        : Sets the swap interval of the following swaps
+************************************************************************************/
+IMG_INTERNAL IMG_VOID Psp2PacingSetSwapInterval(PSP2_PACING *psPacing, IMG_UINT32 ui32SwapInterval)
+{
+	psPacing->ui32SwapInterval = ui32SwapInterval;
+}
+
+/***********************************************************************************
+ Function Name      : Psp2PacingSetAdaptive
+ Inputs             : psPacing, bAdaptive
+ Outputs            : -
+ Returns            : -
+ Description        : Lets late swaps tear rather than wait for the next vblank
+************************************************************************************/
+IMG_INTERNAL IMG_VOID Psp2PacingSetAdaptive(PSP2_PACING *psPacing, IMG_BOOL bAdaptive)
+{
+	psPacing->bAdaptive = bAdaptive;
+}
+
+/***********************************************************************************
+ Function Name      : Psp2PacingVblankStart
+ Inputs             : psPacing, ui32Vcount
+ Outputs            : -
+ Returns            : Estimated start time of a vblank near the last one sampled
+************************************************************************************/
+static IMG_INT64 Psp2PacingVblankStart(const PSP2_PACING *psPacing, IMG_UINT32 ui32Vcount)
+{
+	return psPacing->i64PhaseUs + (IMG_INT64)(IMG_INT32)(ui32Vcount - psPacing->ui32PhaseVcount) * psPacing->ui32RefreshUs;
+}
+
+/***********************************************************************************
+ Function Name      : Psp2PacingUpdatePhase
+ Inputs             : psPacing, ui32Vcount, ui64TimeUs
+ Outputs            : -
+ Returns            : -
+ Description        : Refines the vblank start estimate with a clock sample. Vblank
+					  ui32Vcount started at or before ui64TimeUs, and less than a
+					  period before it: a sample which doesn't fit the estimate
+					  (the clocks have drifted) restarts it.
+************************************************************************************/
+static IMG_VOID Psp2PacingUpdatePhase(PSP2_PACING *psPacing, IMG_UINT32 ui32Vcount, IMG_UINT64 ui64TimeUs)
+{
+	IMG_INT64 i64StartUs;
+
+	if (psPacing->bHavePhase)
+	{
+		i64StartUs = Psp2PacingVblankStart(psPacing, ui32Vcount);
+
+		if ((IMG_INT64)ui64TimeUs < i64StartUs)
+		{
+			i64StartUs = (IMG_INT64)ui64TimeUs;
+		}
+		else if ((IMG_INT64)ui64TimeUs >= i64StartUs + psPacing->ui32RefreshUs)
+		{
+			i64StartUs = (IMG_INT64)ui64TimeUs;
+		}
+	}
+	else
+	{
+		i64StartUs = (IMG_INT64)ui64TimeUs;
+		psPacing->bHavePhase = IMG_TRUE;
+	}
+
+	/* Keep the estimate relative to the latest vblank, so the count can wrap */
+	psPacing->ui32PhaseVcount = ui32Vcount;
+	psPacing->i64PhaseUs = i64StartUs;
+}
+
+/***********************************************************************************
+ Function Name      : Psp2PacingBeginSwap
+ Inputs             : psPacing, ui32Vcount, ui64TimeUs - the display's vblank count
+					  and the time, sampled together
+ Outputs            : -
+ Returns            : Swap interval to queue the flip with
+ Description        : Decides how to queue a swap: with the window's swap interval,
+					  or, when the swap is late and the swap interval adaptive,
+					  immediately. Must be followed by Psp2PacingEndSwap.
+************************************************************************************/
+IMG_INTERNAL IMG_UINT32 Psp2PacingBeginSwap(PSP2_PACING *psPacing, IMG_UINT32 ui32Vcount, IMG_UINT64 ui64TimeUs)
+{
+	IMG_UINT32 ui32Interval = psPacing->ui32SwapInterval;
+	IMG_UINT32 ui32LastVcount = psPacing->aui32FlipVcount[psPacing->ui32LastFlip];
+	IMG_UINT32 ui32Depth = 0;
+	IMG_UINT32 i;
+
+	Psp2PacingUpdatePhase(psPacing, ui32Vcount, ui64TimeUs);
+
+	for (i = 0; i < psPacing->ui32NumFlips; i++)
+	{
+		IMG_UINT32 ui32Flip = (psPacing->ui32LastFlip + PSP2_PACING_MAX_FLIPS - i) % PSP2_PACING_MAX_FLIPS;
+
+		if (VCOUNT_AFTER(psPacing->aui32FlipVcount[ui32Flip], ui32Vcount))
+		{
+			ui32Depth++;
+		}
+	}
+
+	psPacing->ui32SwapVcount = ui32Vcount;
+	psPacing->ui64SwapTimeUs = ui64TimeUs;
+	psPacing->ui32SwapMissed = 0;
+	psPacing->bSwapTorn = IMG_FALSE;
+	psPacing->sStats.ui32QueueDepth = ui32Depth;
+
+	if (ui32Interval == 0)
+	{
+		/* Taken at once, but not before the flips queued ahead of it */
+		psPacing->ui32SwapDisplayVcount = ui32Vcount;
+		if (psPacing->ui32NumFlips && VCOUNT_AFTER(ui32LastVcount, ui32Vcount))
+		{
+			psPacing->ui32SwapDisplayVcount = ui32LastVcount;
+		}
+	}
+	else if (!psPacing->ui32NumFlips)
+	{
+		psPacing->ui32SwapDisplayVcount = ui32Vcount + 1;
+	}
+	else
+	{
+		IMG_UINT32 ui32Target = ui32LastVcount + ui32Interval;
+
+		if (VCOUNT_AFTER(ui32Vcount + 1, ui32Target))
+		{
+			/* Too late for the target vblank */
+			psPacing->ui32SwapMissed = ui32Vcount + 1 - ui32Target;
+
+			if (psPacing->bAdaptive)
+			{
+				psPacing->bSwapTorn = IMG_TRUE;
+				psPacing->ui32SwapDisplayVcount = ui32Vcount;
+				ui32Interval = 0;
+			}
+			else
+			{
+				psPacing->ui32SwapDisplayVcount = ui32Vcount + 1;
+			}
+		}
+		else
+		{
+			psPacing->ui32SwapDisplayVcount = ui32Target;
+		}
+	}
+
+	return ui32Interval;
+}
+
+/***********************************************************************************
+ Function Name      : Psp2PacingEndSwap
+ Inputs             : psPacing, bQueued - whether the display controller took the flip
+ Outputs            : -
+ Returns            : -
+ Description        : Records the swap started by Psp2PacingBeginSwap
+************************************************************************************/
+IMG_INTERNAL IMG_VOID Psp2PacingEndSwap(PSP2_PACING *psPacing, IMG_BOOL bQueued)
+{
+	PSP2_PACING_STATS *psStats = &psPacing->sStats;
+	IMG_INT64 i64LatencyUs;
+
+	if (!bQueued)
+	{
+		return;
+	}
+
+	psPacing->ui32LastFlip = (psPacing->ui32LastFlip + 1) % PSP2_PACING_MAX_FLIPS;
+	psPacing->aui32FlipVcount[psPacing->ui32LastFlip] = psPacing->ui32SwapDisplayVcount;
+	if (psPacing->ui32NumFlips < PSP2_PACING_MAX_FLIPS)
+	{
+		psPacing->ui32NumFlips++;
+	}
+
+	/* A flip taken at once is shown as the swap is queued */
+	i64LatencyUs = Psp2PacingVblankStart(psPacing, psPacing->ui32SwapDisplayVcount) - (IMG_INT64)psPacing->ui64SwapTimeUs;
+	if (i64LatencyUs < 0)
+	{
+		i64LatencyUs = 0;
+	}
+
+	if (psStats->ui32Presents)
+	{
+		psStats->ui32LastFrameUs = (IMG_UINT32)(psPacing->ui64SwapTimeUs - psPacing->ui64LastSwapTimeUs);
+	}
+	psPacing->ui64LastSwapTimeUs = psPacing->ui64SwapTimeUs;
+
+	psStats->ui32Presents++;
+	if (psPacing->ui32SwapMissed)
+	{
+		psStats->ui32LatePresents++;
+		psStats->ui32MissedIntervals += psPacing->ui32SwapMissed;
+	}
+	if (psPacing->bSwapTorn)
+	{
+		psStats->ui32TornPresents++;
+	}
+
+	psStats->ui32LastLatencyUs = (IMG_UINT32)i64LatencyUs;
+	if (psStats->ui32LastLatencyUs > psStats->ui32MaxLatencyUs)
+	{
+		psStats->ui32MaxLatencyUs = psStats->ui32LastLatencyUs;
+	}
+	psPacing->ui64TotalLatencyUs += psStats->ui32LastLatencyUs;
+	psStats->ui32AverageLatencyUs = (IMG_UINT32)(psPacing->ui64TotalLatencyUs / psStats->ui32Presents);
+}
+
+/***********************************************************************************
+ Function Name      : Psp2PacingGetStats
+ Inputs             : psPacing
+ Outputs            : psStats
+ Returns            : -
+ Description        : Returns the present statistics of the flip chain
+************************************************************************************/
+IMG_INTERNAL IMG_VOID Psp2PacingGetStats(const PSP2_PACING *psPacing, PSP2_PACING_STATS *psStats)
+{
+	*psStats = psPacing->sStats;
+}
+
+/******************************************************************************
+ End of file (psp2_pacing.c)
+******************************************************************************/
@@ -0,0 +1,134 @@
+/******************************************************************************
+ * Name         : psp2_pacing.h
+ *
+ * Copyright    : 2010 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means, electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Platform     : ANSI
+ *
+ * $Log: psp2_pacing.h $
+ *****************************************************************************/
+
+#ifndef _PSP2_PACING_H_
+#define _PSP2_PACING_H_
+
+#include "img_defs.h"
+#include "img_types.h"
+
+/*
+ * Swap pacing for a PSP2 window's flip chain.
+ *
+ * The display controller shows a flip queued with swap interval N at the
+ * first vblank at least N vblanks after the previous flip was shown; with
+ * interval 0 the flip is taken straight away, tearing the frame being
+ * scanned out. The pacer keeps the vblank at which each of the window's
+ * recent flips is (to be) shown, predicted from that rule, and from them
+ * works out at each swap:
+ *
+ *    - whether the swap is late: it comes after the last vblank at which
+ *      the swap interval would have had the frame shown, so vsync drops the
+ *      frame rate. With adaptive swap interval a late swap is flipped with
+ *      interval 0 and tears instead; a swap that is on time never tears.
+ *
+ *    - the queue depth: flips queued before this one and not yet shown.
+ *
+ *    - the latency: time from the swap to the vblank the frame is shown
+ *      at (0 for a torn flip).
+ *
+ * The predictions assume the frame's rendering completes by its vblank;
+ * the flip chain holds a flip back until its render sync ops complete.
+ *
+ * The pacer doesn't read any clock itself: each swap passes the vblank
+ * count and microsecond time sampled together, so it runs on a host
+ * against a simulated display controller as on the device. Vblank start
+ * times are estimated from those samples, each of which bounds the start
+ * of its vblank from above.
+ */
+
+/* Recent flips the pacer tracks, at least the longest flip chain */
+#define PSP2_PACING_MAX_FLIPS	4
+
+typedef struct _PSP2_PACING_STATS_
+{
+	/* Swaps presented */
+	IMG_UINT32	ui32Presents;
+
+	/* Swaps that missed the vblank their swap interval asked for */
+	IMG_UINT32	ui32LatePresents;
+
+	/* Late swaps flipped immediately (adaptive swap interval) */
+	IMG_UINT32	ui32TornPresents;
+
+	/* Vblanks lost to late swaps */
+	IMG_UINT32	ui32MissedIntervals;
+
+	/* Flips not yet shown when the last swap was queued */
+	IMG_UINT32	ui32QueueDepth;
+
+	/* Swap to display latency of the last swap, and the average and worst */
+	IMG_UINT32	ui32LastLatencyUs;
+	IMG_UINT32	ui32AverageLatencyUs;
+	IMG_UINT32	ui32MaxLatencyUs;
+
+	/* Time between the last two swaps */
+	IMG_UINT32	ui32LastFrameUs;
+
+} PSP2_PACING_STATS;
+
+typedef struct _PSP2_PACING_
+{
+	/* Vblank period */
+	IMG_UINT32	ui32RefreshUs;
+
+	IMG_UINT32	ui32SwapInterval;
+	IMG_BOOL	bAdaptive;
+
+	/* Estimated start of vblank ui32PhaseVcount; the others follow every ui32RefreshUs */
+	IMG_BOOL	bHavePhase;
+	IMG_UINT32	ui32PhaseVcount;
+	IMG_INT64	i64PhaseUs;
+
+	/* Vblanks at which the last flips are shown, aui32FlipVcount[ui32LastFlip] the newest */
+	IMG_UINT32	ui32NumFlips;
+	IMG_UINT32	ui32LastFlip;
+	IMG_UINT32	aui32FlipVcount[PSP2_PACING_MAX_FLIPS];
+
+	/* The swap between Psp2PacingBeginSwap and Psp2PacingEndSwap */
+	IMG_UINT32	ui32SwapVcount;
+	IMG_UINT64	ui64SwapTimeUs;
+	IMG_UINT32	ui32SwapDisplayVcount;
+	IMG_UINT32	ui32SwapMissed;
+	IMG_BOOL	bSwapTorn;
+
+	IMG_UINT64	ui64LastSwapTimeUs;
+	IMG_UINT64	ui64TotalLatencyUs;
+
+	PSP2_PACING_STATS	sStats;
+
+} PSP2_PACING;
+
+IMG_INTERNAL IMG_VOID Psp2PacingInit(PSP2_PACING *psPacing, IMG_UINT32 ui32RefreshUs, IMG_UINT32 ui32SwapInterval);
+
+IMG_INTERNAL IMG_VOID Psp2PacingSetSwapInterval(PSP2_PACING *psPacing, IMG_UINT32 ui32SwapInterval);
+
+IMG_INTERNAL IMG_VOID Psp2PacingSetAdaptive(PSP2_PACING *psPacing, IMG_BOOL bAdaptive);
+
+IMG_INTERNAL IMG_UINT32 Psp2PacingBeginSwap(PSP2_PACING *psPacing, IMG_UINT32 ui32Vcount, IMG_UINT64 ui64TimeUs);
+
+IMG_INTERNAL IMG_VOID Psp2PacingEndSwap(PSP2_PACING *psPacing, IMG_BOOL bQueued);
+
+IMG_INTERNAL IMG_VOID Psp2PacingGetStats(const PSP2_PACING *psPacing, PSP2_PACING_STATS *psStats);
+
+#endif /* _PSP2_PACING_H_ */
+
+/******************************************************************************
+ End of file (psp2_pacing.h)
+******************************************************************************/
@@ -9,18 +9,128 @@
 #include "services.h"
 #include "pvr_debug.h"
 
+#include "psp2_pacing.h"
+
 #define ALIGN(x, a)	(((x) + ((a) - 1)) & ~((a) - 1))
 
+/* Windows paced at once; more get no pacing or present statistics */
+#define PSP2_WSEGL_MAX_PACED_WINDOWS	4
+
+/* Vblank period when the display doesn't report its refresh rate (59.94Hz) */
+#define PSP2_WSEGL_DEFAULT_REFRESH_US	16683
+
 static WSEGLCaps asWSCaps[] =
 {
 	{ WSEGL_CAP_MIN_SWAP_INTERVAL, PSP2_SWAPCHAIN_MIN_INTERVAL },
 	{ WSEGL_CAP_MAX_SWAP_INTERVAL, PSP2_SWAPCHAIN_MAX_INTERVAL },
 	{ WSEGL_CAP_WINDOWS_USE_HW_SYNC, 1 },
+	{ WSEGL_CAP_ADAPTIVE_SWAP_INTERVAL, 1 },
 	{ WSEGL_NO_CAPS, 0 }
 };
 
 static WSEGLConfig asDispConfigs[3];
 
+/*
+	Pacing state of the windows with a flip chain. Psp2NativeWindow has
+	the layout of the application's window, which EGL copies, so the state
+	is kept here, found by window, rather than in the window.
+*/
+typedef struct _PSP2_WINDOW_PACING_
+{
+	NativeWindowType	hWindow;
+	PSP2_PACING			sPacing;
+} PSP2_WINDOW_PACING;
+
+static PSP2_WINDOW_PACING asWindowPacing[PSP2_WSEGL_MAX_PACED_WINDOWS];
+
+static PSP2_PACING *FindWindowPacing(NativeWindowType hWindow)
+{
+	IMG_UINT32 i;
+
+	for (i = 0; i < PSP2_WSEGL_MAX_PACED_WINDOWS; i++)
+	{
+		if (asWindowPacing[i].hWindow == hWindow)
+		{
+			return &asWindowPacing[i].sPacing;
+		}
+	}
+
+	return IMG_NULL;
+}
+
+static IMG_VOID DestroyWindowPacing(NativeWindowType hWindow)
+{
+	IMG_UINT32 i;
+
+	for (i = 0; i < PSP2_WSEGL_MAX_PACED_WINDOWS; i++)
+	{
+		if (asWindowPacing[i].hWindow == hWindow)
+		{
+			asWindowPacing[i].hWindow = IMG_NULL;
+		}
+	}
+}
+
+static IMG_VOID CreateWindowPacing(NativeWindowType hWindow)
+{
+	IMG_UINT32 ui32RefreshUs = PSP2_WSEGL_DEFAULT_REFRESH_US;
+	float fRefreshRate;
+	IMG_UINT32 i;
+
+	if ((sceDisplayGetRefreshRate(&fRefreshRate) == SCE_OK) && (fRefreshRate > 1.0f))
+	{
+		ui32RefreshUs = (IMG_UINT32)(1000000.0f / fRefreshRate + 0.5f);
+	}
+
+	/* A recreated window starts again with an empty flip chain */
+	DestroyWindowPacing(hWindow);
+
+	for (i = 0; i < PSP2_WSEGL_MAX_PACED_WINDOWS; i++)
+	{
+		if (asWindowPacing[i].hWindow == IMG_NULL)
+		{
+			asWindowPacing[i].hWindow = hWindow;
+			Psp2PacingInit(&asWindowPacing[i].sPacing, ui32RefreshUs, hWindow->swapInterval);
+			return;
+		}
+	}
+
+	PVR_DPF((PVR_DBG_WARNING, "%s: Too many windows, swaps won't be paced", __func__));
+}
+
+/*
+	Queues a flip to a swap chain buffer, with the interval the window's
+	pacer picks when it has one.
+*/
+static PVRSRV_ERROR SwapToBuffer(NativeWindowType hWindow, IMG_UINT32 ui32BufIdx)
+{
+	PSP2_PACING *psPacing = FindWindowPacing(hWindow);
+	IMG_UINT32 ui32Interval = hWindow->swapInterval;
+	PVRSRV_ERROR eError;
+
+	if (psPacing)
+	{
+		/* Vblank count first: the time then falls within its vblank period */
+		IMG_UINT32 ui32Vcount = (IMG_UINT32)sceDisplayGetVcount();
+
+		ui32Interval = Psp2PacingBeginSwap(psPacing, ui32Vcount, sceKernelGetProcessTimeWide());
+	}
+
+	eError = PVRSRVSwapToDCBuffer((IMG_HANDLE)hWindow->psConnection,
+		hWindow->ahSwapChainBuffers[ui32BufIdx],
+		0,
+		IMG_NULL,
+		ui32Interval,
+		0);
+
+	if (psPacing)
+	{
+		Psp2PacingEndSwap(psPacing, (eError == PVRSRV_OK) ? IMG_TRUE : IMG_FALSE);
+	}
+
+	return eError;
+}
+
 static WSEGLError WSEGL_IsDisplayValid(NativeDisplayType hNativeDisplay)
 {
 	WSEGL_UNREFERENCED_PARAMETER(hNativeDisplay);
@@ -189,12 +299,9 @@ static WSEGLError WSEGL_CreateWindowDrawable(WSEGLDisplayHandle hDisplay,
 		}
 	}
 
-	PVRSRVSwapToDCBuffer(psConnection,
-		hNativeWindow->ahSwapChainBuffers[0],
-		0,
-		IMG_NULL,
-		hNativeWindow->swapInterval,
-		0);
+	CreateWindowPacing(hNativeWindow);
+
+	SwapToBuffer(hNativeWindow, 0);
 
 	hNativeWindow->currBufIdx = 1;
 	*phDrawable = (WSEGLDrawableHandle)hNativeWindow;
@@ -270,6 +377,8 @@ static WSEGLError WSEGL_DeleteDrawable(WSEGLDrawableHandle hDrawable)
 		}
 
 		PVRSRVDestroyDCSwapChain((IMG_HANDLE)window->psConnection, window->swapChain);
+
+		DestroyWindowPacing(window);
 		break;
 
 	case PSP2_DRAWABLE_TYPE_PIXMAP:
@@ -295,12 +404,7 @@ static WSEGLError WSEGL_SwapDrawable(WSEGLDrawableHandle hDrawable, unsigned lon
 		return WSEGL_BAD_DRAWABLE;
 	}
 
-	eError = PVRSRVSwapToDCBuffer((IMG_HANDLE)window->psConnection,
-		window->ahSwapChainBuffers[window->currBufIdx],
-		0,
-		IMG_NULL,
-		window->swapInterval,
-		0);
+	eError = SwapToBuffer(window, window->currBufIdx);
 
 	if (eError != PVRSRV_OK)
 	{
@@ -315,6 +419,7 @@ static WSEGLError WSEGL_SwapDrawable(WSEGLDrawableHandle hDrawable, unsigned lon
 static WSEGLError WSEGL_SwapControlInterval(WSEGLDrawableHandle hDrawable, unsigned long ulInterval)
 {
 	NativeWindowType window = (NativeWindowType)hDrawable;
+	PSP2_PACING *psPacing;
 
 	if (window->type != PSP2_DRAWABLE_TYPE_WINDOW)
 	{
@@ -323,6 +428,65 @@ static WSEGLError WSEGL_SwapControlInterval(WSEGLDrawableHandle hDrawable, unsig
 
 	window->swapInterval = ulInterval;
 
+	psPacing = FindWindowPacing(window);
+	if (psPacing)
+	{
+		Psp2PacingSetSwapInterval(psPacing, ulInterval);
+	}
+
+	return WSEGL_SUCCESS;
+}
+
+static WSEGLError WSEGL_SwapControlAdaptive(WSEGLDrawableHandle hDrawable, unsigned long ulAdaptive)
+{
+	NativeWindowType window = (NativeWindowType)hDrawable;
+	PSP2_PACING *psPacing;
+
+	if (window->type != PSP2_DRAWABLE_TYPE_WINDOW)
+	{
+		return WSEGL_BAD_DRAWABLE;
+	}
+
+	psPacing = FindWindowPacing(window);
+	if (!psPacing)
+	{
+		return WSEGL_BAD_MATCH;
+	}
+
+	Psp2PacingSetAdaptive(psPacing, ulAdaptive ? IMG_TRUE : IMG_FALSE);
+
+	return WSEGL_SUCCESS;
+}
+
+static WSEGLError WSEGL_GetPresentStats(WSEGLDrawableHandle hDrawable, WSEGLPresentStats *psPresentStats)
+{
+	NativeWindowType window = (NativeWindowType)hDrawable;
+	PSP2_PACING_STATS sStats;
+	PSP2_PACING *psPacing;
+
+	if (window->type != PSP2_DRAWABLE_TYPE_WINDOW)
+	{
+		return WSEGL_BAD_DRAWABLE;
+	}
+
+	psPacing = FindWindowPacing(window);
+	if (!psPacing)
+	{
+		return WSEGL_BAD_MATCH;
+	}
+
+	Psp2PacingGetStats(psPacing, &sStats);
+
+	psPresentStats->ulPresents = sStats.ui32Presents;
+	psPresentStats->ulLatePresents = sStats.ui32LatePresents;
+	psPresentStats->ulTornPresents = sStats.ui32TornPresents;
+	psPresentStats->ulMissedIntervals = sStats.ui32MissedIntervals;
+	psPresentStats->ulQueueDepth = sStats.ui32QueueDepth;
+	psPresentStats->ulLastLatency = sStats.ui32LastLatencyUs;
+	psPresentStats->ulAverageLatency = sStats.ui32AverageLatencyUs;
+	psPresentStats->ulMaxLatency = sStats.ui32MaxLatencyUs;
+	psPresentStats->ulLastFrameTime = sStats.ui32LastFrameUs;
+
 	return WSEGL_SUCCESS;
 }
 
@@ -465,6 +629,8 @@ static const WSEGL_FunctionTable sFunctionTable =
 	WSEGL_GetDrawableParameters,
 	WSEGL_ConnectDrawable,
 	WSEGL_DisconnectDrawable,
+	WSEGL_SwapControlAdaptive,
+	WSEGL_GetPresentStats,
 };
 
 WSEGL_EXPORT const WSEGL_FunctionTable *WSEGL_GetFunctionTablePointer(void)
@@ -0,0 +1,1556 @@
+/*!****************************************************************************
+@File           blitlib.c
+
+@Title          Software blit library
+
+@Author         Imagination Technologies
+
+@date           19/10/10
+
+@Copyright      Copyright 2010 by Imagination Technologies Limited.
+                All rights reserved. No part of this software, either
+                material or conceptual may be copied or distributed,
+                transmitted, transcribed, stored in a retrieval system
+                or translated into any human or computer language in any
+                form by any means, electronic, mechanical, manual or
+                other-wise, or disclosed to third parties without the
+                express written permission of Imagination Technologies
+                Limited, Unit 8, HomePark Industrial Estate,
+                King's Langley, Hertfordshire, WD4 8LZ, U.K.
+
+@Platform       Generic
+
+@Description    Pixel format table, pixel conversion and surface addressing
+                of the software blit library.
+
+@DoxygenVer
+
+******************************************************************************/
+
+/******************************************************************************
+Modifications :-
+
+$Log: blitlib.c $
+
+*****************************************************************************/
+
+#include <math.h>
+
+#include "blitlib.h"
+
+/*
+	Layout of every PVRSRV_PIXEL_FORMAT:
+
+	{bytes per pixel, channel type, flags, {R, G, B, A lowest bit}, {R, G, B, A bits}}
+
+	Formats with BL_CHANNEL_NONE are only moved as raw pixels (copies,
+	point scaling, flips and rotations between surfaces of the same format),
+	or not at all when they have no whole pixel per byte (compressed,
+	palettised below 8 bits) or are subsampled YUV, listed for the bytes per
+	pixel of their luma plane, which the transfer queue uses for mipmap
+	chains. Channels of unspecified type are read as UNORM, except 32 bit
+	ones, which are only copied.
+*/
+const BL_EXTERNAL_PIXEL_FORMAT gas_BLExternalPixelTable[PVRSRV_PIXEL_FORMAT_RAW1024 + 1] =
+{
+	/* PVRSRV_PIXEL_FORMAT_UNKNOWN */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_RGB565 */
+	{2, BL_CHANNEL_UNORM, 0, {11, 5, 0, 0}, {5, 6, 5, 0}},
+	/* PVRSRV_PIXEL_FORMAT_RGB555 */
+	{2, BL_CHANNEL_UNORM, 0, {10, 5, 0, 0}, {5, 5, 5, 0}},
+	/* PVRSRV_PIXEL_FORMAT_RGB888 */
+	{3, BL_CHANNEL_UNORM, 0, {16, 8, 0, 0}, {8, 8, 8, 0}},
+	/* PVRSRV_PIXEL_FORMAT_BGR888 */
+	{3, BL_CHANNEL_UNORM, 0, {0, 8, 16, 0}, {8, 8, 8, 0}},
+	/* 5: unused */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* 6: unused */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* 7: unused */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_GREY_SCALE */
+	{1, BL_CHANNEL_UNORM, BL_PXFMT_FLAG_LUMINANCE, {0, 0, 0, 0}, {8, 0, 0, 0}},
+	/* 9: unused */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* 10: unused */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* 11: unused */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* 12: unused */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_PAL12 */
+	{2, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_PAL8 */
+	{1, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_PAL4 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_PAL2 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_PAL1 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_ARGB1555 */
+	{2, BL_CHANNEL_UNORM, 0, {10, 5, 0, 15}, {5, 5, 5, 1}},
+	/* PVRSRV_PIXEL_FORMAT_ARGB4444 */
+	{2, BL_CHANNEL_UNORM, 0, {8, 4, 0, 12}, {4, 4, 4, 4}},
+	/* PVRSRV_PIXEL_FORMAT_ARGB8888 */
+	{4, BL_CHANNEL_UNORM, 0, {16, 8, 0, 24}, {8, 8, 8, 8}},
+	/* PVRSRV_PIXEL_FORMAT_ABGR8888 */
+	{4, BL_CHANNEL_UNORM, 0, {0, 8, 16, 24}, {8, 8, 8, 8}},
+	/* PVRSRV_PIXEL_FORMAT_YV12 */
+	{1, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_I420 */
+	{1, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* 24: unused */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_IMC2 */
+	{1, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_XRGB8888 */
+	{4, BL_CHANNEL_UNORM, 0, {16, 8, 0, 0}, {8, 8, 8, 0}},
+	/* PVRSRV_PIXEL_FORMAT_XBGR8888 */
+	{4, BL_CHANNEL_UNORM, 0, {0, 8, 16, 0}, {8, 8, 8, 0}},
+	/* PVRSRV_PIXEL_FORMAT_BGRA8888 */
+	{4, BL_CHANNEL_UNORM, 0, {8, 16, 24, 0}, {8, 8, 8, 8}},
+	/* PVRSRV_PIXEL_FORMAT_XRGB4444 */
+	{2, BL_CHANNEL_UNORM, 0, {8, 4, 0, 0}, {4, 4, 4, 0}},
+	/* PVRSRV_PIXEL_FORMAT_ARGB8332 */
+	{2, BL_CHANNEL_UNORM, 0, {5, 2, 0, 8}, {3, 3, 2, 8}},
+	/* PVRSRV_PIXEL_FORMAT_A2RGB10 */
+	{4, BL_CHANNEL_UNORM, 0, {20, 10, 0, 30}, {10, 10, 10, 2}},
+	/* PVRSRV_PIXEL_FORMAT_A2BGR10 */
+	{4, BL_CHANNEL_UNORM, 0, {0, 10, 20, 30}, {10, 10, 10, 2}},
+	/* PVRSRV_PIXEL_FORMAT_P8 */
+	{1, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_L8 */
+	{1, BL_CHANNEL_UNORM, BL_PXFMT_FLAG_LUMINANCE, {0, 0, 0, 0}, {8, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_A8L8 */
+	{2, BL_CHANNEL_UNORM, BL_PXFMT_FLAG_LUMINANCE, {0, 0, 0, 8}, {8, 0, 0, 8}},
+	/* PVRSRV_PIXEL_FORMAT_A4L4 */
+	{1, BL_CHANNEL_UNORM, BL_PXFMT_FLAG_LUMINANCE, {0, 0, 0, 4}, {4, 0, 0, 4}},
+	/* PVRSRV_PIXEL_FORMAT_L16 */
+	{2, BL_CHANNEL_UNORM, BL_PXFMT_FLAG_LUMINANCE, {0, 0, 0, 0}, {16, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_L6V5U5 */
+	{2, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_V8U8 */
+	{2, BL_CHANNEL_SNORM, 0, {0, 8, 0, 0}, {8, 8, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_V16U16 */
+	{4, BL_CHANNEL_SNORM, 0, {0, 16, 0, 0}, {16, 16, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_QWVU8888 */
+	{4, BL_CHANNEL_SNORM, 0, {0, 8, 16, 24}, {8, 8, 8, 8}},
+	/* PVRSRV_PIXEL_FORMAT_XLVU8888 */
+	{4, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_QWVU16 */
+	{8, BL_CHANNEL_SNORM, 0, {0, 16, 32, 48}, {16, 16, 16, 16}},
+	/* PVRSRV_PIXEL_FORMAT_D16 */
+	{2, BL_CHANNEL_UNORM, 0, {0, 0, 0, 0}, {16, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_D24S8 */
+	{4, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_D24X8 */
+	{4, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_ABGR16 */
+	{8, BL_CHANNEL_UNORM, 0, {0, 16, 32, 48}, {16, 16, 16, 16}},
+	/* PVRSRV_PIXEL_FORMAT_ABGR16F */
+	{8, BL_CHANNEL_FLOAT, 0, {0, 16, 32, 48}, {16, 16, 16, 16}},
+	/* PVRSRV_PIXEL_FORMAT_ABGR32 */
+	{16, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_ABGR32F */
+	{16, BL_CHANNEL_FLOAT, 0, {0, 32, 64, 96}, {32, 32, 32, 32}},
+	/* PVRSRV_PIXEL_FORMAT_B10GR11 */
+	{4, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_GR88 */
+	{2, BL_CHANNEL_UNORM, 0, {0, 8, 0, 0}, {8, 8, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_BGR32 */
+	{12, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_GR32 */
+	{8, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_E5BGR9 */
+	{4, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_RESERVED1 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_RESERVED2 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_RESERVED3 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_RESERVED4 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_RESERVED5 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_R8G8_B8G8 */
+	{2, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_G8R8_G8B8 */
+	{2, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_NV11 */
+	{1, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_NV12 */
+	{1, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_YUY2 */
+	{2, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_YUV420 */
+	{1, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_YUV444 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_VUY444 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_YUYV */
+	{2, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_YVYU */
+	{2, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_UYVY */
+	{2, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_VYUY */
+	{2, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_FOURCC_ORG_UYVY */
+	{2, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_FOURCC_ORG_YUYV */
+	{2, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_FOURCC_ORG_YVYU */
+	{2, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_FOURCC_ORG_VYUY */
+	{2, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_FOURCC_ORG_AYUV */
+	{4, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_A32B32G32R32 */
+	{16, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_A32B32G32R32F */
+	{16, BL_CHANNEL_FLOAT, 0, {0, 32, 64, 96}, {32, 32, 32, 32}},
+	/* PVRSRV_PIXEL_FORMAT_A32B32G32R32_UINT */
+	{16, BL_CHANNEL_UINT, 0, {0, 32, 64, 96}, {32, 32, 32, 32}},
+	/* PVRSRV_PIXEL_FORMAT_A32B32G32R32_SINT */
+	{16, BL_CHANNEL_SINT, 0, {0, 32, 64, 96}, {32, 32, 32, 32}},
+	/* PVRSRV_PIXEL_FORMAT_B32G32R32 */
+	{12, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_B32G32R32F */
+	{12, BL_CHANNEL_FLOAT, 0, {0, 32, 64, 0}, {32, 32, 32, 0}},
+	/* PVRSRV_PIXEL_FORMAT_B32G32R32_UINT */
+	{12, BL_CHANNEL_UINT, 0, {0, 32, 64, 0}, {32, 32, 32, 0}},
+	/* PVRSRV_PIXEL_FORMAT_B32G32R32_SINT */
+	{12, BL_CHANNEL_SINT, 0, {0, 32, 64, 0}, {32, 32, 32, 0}},
+	/* PVRSRV_PIXEL_FORMAT_G32R32 */
+	{8, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_G32R32F */
+	{8, BL_CHANNEL_FLOAT, 0, {0, 32, 0, 0}, {32, 32, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_G32R32_UINT */
+	{8, BL_CHANNEL_UINT, 0, {0, 32, 0, 0}, {32, 32, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_G32R32_SINT */
+	{8, BL_CHANNEL_SINT, 0, {0, 32, 0, 0}, {32, 32, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_D32F */
+	{4, BL_CHANNEL_FLOAT, 0, {0, 0, 0, 0}, {32, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_R32 */
+	{4, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_R32F */
+	{4, BL_CHANNEL_FLOAT, 0, {0, 0, 0, 0}, {32, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_R32_UINT */
+	{4, BL_CHANNEL_UINT, 0, {0, 0, 0, 0}, {32, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_R32_SINT */
+	{4, BL_CHANNEL_SINT, 0, {0, 0, 0, 0}, {32, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_A16B16G16R16 */
+	{8, BL_CHANNEL_UNORM, 0, {0, 16, 32, 48}, {16, 16, 16, 16}},
+	/* PVRSRV_PIXEL_FORMAT_A16B16G16R16F */
+	{8, BL_CHANNEL_FLOAT, 0, {0, 16, 32, 48}, {16, 16, 16, 16}},
+	/* PVRSRV_PIXEL_FORMAT_A16B16G16R16_SINT */
+	{8, BL_CHANNEL_SINT, 0, {0, 16, 32, 48}, {16, 16, 16, 16}},
+	/* PVRSRV_PIXEL_FORMAT_A16B16G16R16_SNORM */
+	{8, BL_CHANNEL_SNORM, 0, {0, 16, 32, 48}, {16, 16, 16, 16}},
+	/* PVRSRV_PIXEL_FORMAT_A16B16G16R16_UINT */
+	{8, BL_CHANNEL_UINT, 0, {0, 16, 32, 48}, {16, 16, 16, 16}},
+	/* PVRSRV_PIXEL_FORMAT_A16B16G16R16_UNORM */
+	{8, BL_CHANNEL_UNORM, 0, {0, 16, 32, 48}, {16, 16, 16, 16}},
+	/* PVRSRV_PIXEL_FORMAT_G16R16 */
+	{4, BL_CHANNEL_UNORM, 0, {0, 16, 0, 0}, {16, 16, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_G16R16F */
+	{4, BL_CHANNEL_FLOAT, 0, {0, 16, 0, 0}, {16, 16, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_G16R16_UINT */
+	{4, BL_CHANNEL_UINT, 0, {0, 16, 0, 0}, {16, 16, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_G16R16_UNORM */
+	{4, BL_CHANNEL_UNORM, 0, {0, 16, 0, 0}, {16, 16, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_G16R16_SINT */
+	{4, BL_CHANNEL_SINT, 0, {0, 16, 0, 0}, {16, 16, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_G16R16_SNORM */
+	{4, BL_CHANNEL_SNORM, 0, {0, 16, 0, 0}, {16, 16, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_R16 */
+	{2, BL_CHANNEL_UNORM, 0, {0, 0, 0, 0}, {16, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_R16F */
+	{2, BL_CHANNEL_FLOAT, 0, {0, 0, 0, 0}, {16, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_R16_UINT */
+	{2, BL_CHANNEL_UINT, 0, {0, 0, 0, 0}, {16, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_R16_UNORM */
+	{2, BL_CHANNEL_UNORM, 0, {0, 0, 0, 0}, {16, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_R16_SINT */
+	{2, BL_CHANNEL_SINT, 0, {0, 0, 0, 0}, {16, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_R16_SNORM */
+	{2, BL_CHANNEL_SNORM, 0, {0, 0, 0, 0}, {16, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_X8R8G8B8 */
+	{4, BL_CHANNEL_UNORM, 0, {16, 8, 0, 0}, {8, 8, 8, 0}},
+	/* PVRSRV_PIXEL_FORMAT_X8R8G8B8_UNORM */
+	{4, BL_CHANNEL_UNORM, 0, {16, 8, 0, 0}, {8, 8, 8, 0}},
+	/* PVRSRV_PIXEL_FORMAT_X8R8G8B8_UNORM_SRGB */
+	{4, BL_CHANNEL_UNORM, BL_PXFMT_FLAG_SRGB, {16, 8, 0, 0}, {8, 8, 8, 0}},
+	/* PVRSRV_PIXEL_FORMAT_A8R8G8B8 */
+	{4, BL_CHANNEL_UNORM, 0, {16, 8, 0, 24}, {8, 8, 8, 8}},
+	/* PVRSRV_PIXEL_FORMAT_A8R8G8B8_UNORM */
+	{4, BL_CHANNEL_UNORM, 0, {16, 8, 0, 24}, {8, 8, 8, 8}},
+	/* PVRSRV_PIXEL_FORMAT_A8R8G8B8_UNORM_SRGB */
+	{4, BL_CHANNEL_UNORM, BL_PXFMT_FLAG_SRGB, {16, 8, 0, 24}, {8, 8, 8, 8}},
+	/* PVRSRV_PIXEL_FORMAT_A8B8G8R8 */
+	{4, BL_CHANNEL_UNORM, 0, {0, 8, 16, 24}, {8, 8, 8, 8}},
+	/* PVRSRV_PIXEL_FORMAT_A8B8G8R8_UINT */
+	{4, BL_CHANNEL_UINT, 0, {0, 8, 16, 24}, {8, 8, 8, 8}},
+	/* PVRSRV_PIXEL_FORMAT_A8B8G8R8_UNORM */
+	{4, BL_CHANNEL_UNORM, 0, {0, 8, 16, 24}, {8, 8, 8, 8}},
+	/* PVRSRV_PIXEL_FORMAT_A8B8G8R8_UNORM_SRGB */
+	{4, BL_CHANNEL_UNORM, BL_PXFMT_FLAG_SRGB, {0, 8, 16, 24}, {8, 8, 8, 8}},
+	/* PVRSRV_PIXEL_FORMAT_A8B8G8R8_SINT */
+	{4, BL_CHANNEL_SINT, 0, {0, 8, 16, 24}, {8, 8, 8, 8}},
+	/* PVRSRV_PIXEL_FORMAT_A8B8G8R8_SNORM */
+	{4, BL_CHANNEL_SNORM, 0, {0, 8, 16, 24}, {8, 8, 8, 8}},
+	/* PVRSRV_PIXEL_FORMAT_G8R8 */
+	{2, BL_CHANNEL_UNORM, 0, {0, 8, 0, 0}, {8, 8, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_G8R8_UINT */
+	{2, BL_CHANNEL_UINT, 0, {0, 8, 0, 0}, {8, 8, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_G8R8_UNORM */
+	{2, BL_CHANNEL_UNORM, 0, {0, 8, 0, 0}, {8, 8, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_G8R8_SINT */
+	{2, BL_CHANNEL_SINT, 0, {0, 8, 0, 0}, {8, 8, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_G8R8_SNORM */
+	{2, BL_CHANNEL_SNORM, 0, {0, 8, 0, 0}, {8, 8, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_A8 */
+	{1, BL_CHANNEL_UNORM, 0, {0, 0, 0, 0}, {0, 0, 0, 8}},
+	/* PVRSRV_PIXEL_FORMAT_R8 */
+	{1, BL_CHANNEL_UNORM, 0, {0, 0, 0, 0}, {8, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_R8_UINT */
+	{1, BL_CHANNEL_UINT, 0, {0, 0, 0, 0}, {8, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_R8_UNORM */
+	{1, BL_CHANNEL_UNORM, 0, {0, 0, 0, 0}, {8, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_R8_SINT */
+	{1, BL_CHANNEL_SINT, 0, {0, 0, 0, 0}, {8, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_R8_SNORM */
+	{1, BL_CHANNEL_SNORM, 0, {0, 0, 0, 0}, {8, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_A2B10G10R10 */
+	{4, BL_CHANNEL_UNORM, 0, {0, 10, 20, 30}, {10, 10, 10, 2}},
+	/* PVRSRV_PIXEL_FORMAT_A2B10G10R10_UNORM */
+	{4, BL_CHANNEL_UNORM, 0, {0, 10, 20, 30}, {10, 10, 10, 2}},
+	/* PVRSRV_PIXEL_FORMAT_A2B10G10R10_UINT */
+	{4, BL_CHANNEL_UINT, 0, {0, 10, 20, 30}, {10, 10, 10, 2}},
+	/* PVRSRV_PIXEL_FORMAT_B10G11R11 */
+	{4, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_B10G11R11F */
+	{4, BL_CHANNEL_FLOAT, 0, {0, 11, 22, 0}, {11, 11, 10, 0}},
+	/* PVRSRV_PIXEL_FORMAT_X24G8R32 */
+	{8, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_G8R24 */
+	{4, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_X8R24 */
+	{4, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_E5B9G9R9 */
+	{4, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_R1 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_RESERVED6 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_RESERVED7 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_RESERVED8 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_RESERVED9 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_RESERVED10 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_RESERVED11 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_RESERVED12 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_RESERVED13 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_RESERVED14 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_RESERVED15 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_RESERVED16 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_RESERVED17 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_RESERVED18 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_RESERVED19 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_RESERVED20 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_UBYTE4 */
+	{4, BL_CHANNEL_UNORM, 0, {0, 8, 16, 24}, {8, 8, 8, 8}},
+	/* PVRSRV_PIXEL_FORMAT_SHORT4 */
+	{8, BL_CHANNEL_SINT, 0, {0, 16, 32, 48}, {16, 16, 16, 16}},
+	/* PVRSRV_PIXEL_FORMAT_SHORT4N */
+	{8, BL_CHANNEL_SNORM, 0, {0, 16, 32, 48}, {16, 16, 16, 16}},
+	/* PVRSRV_PIXEL_FORMAT_USHORT4N */
+	{8, BL_CHANNEL_UNORM, 0, {0, 16, 32, 48}, {16, 16, 16, 16}},
+	/* PVRSRV_PIXEL_FORMAT_SHORT2N */
+	{4, BL_CHANNEL_SNORM, 0, {0, 16, 0, 0}, {16, 16, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_SHORT2 */
+	{4, BL_CHANNEL_SINT, 0, {0, 16, 0, 0}, {16, 16, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_USHORT2N */
+	{4, BL_CHANNEL_UNORM, 0, {0, 16, 0, 0}, {16, 16, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_UDEC3 */
+	{4, BL_CHANNEL_UINT, 0, {0, 10, 20, 0}, {10, 10, 10, 0}},
+	/* PVRSRV_PIXEL_FORMAT_DEC3N */
+	{4, BL_CHANNEL_SNORM, 0, {0, 10, 20, 0}, {10, 10, 10, 0}},
+	/* PVRSRV_PIXEL_FORMAT_F16_2 */
+	{4, BL_CHANNEL_FLOAT, 0, {0, 16, 0, 0}, {16, 16, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_F16_4 */
+	{8, BL_CHANNEL_FLOAT, 0, {0, 16, 32, 48}, {16, 16, 16, 16}},
+	/* PVRSRV_PIXEL_FORMAT_L_F16 */
+	{2, BL_CHANNEL_FLOAT, BL_PXFMT_FLAG_LUMINANCE, {0, 0, 0, 0}, {16, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_L_F16_REP */
+	{2, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_L_F16_A_F16 */
+	{4, BL_CHANNEL_FLOAT, BL_PXFMT_FLAG_LUMINANCE, {0, 0, 0, 16}, {16, 0, 0, 16}},
+	/* PVRSRV_PIXEL_FORMAT_A_F16 */
+	{2, BL_CHANNEL_FLOAT, 0, {0, 0, 0, 0}, {0, 0, 0, 16}},
+	/* PVRSRV_PIXEL_FORMAT_B16G16R16F */
+	{6, BL_CHANNEL_FLOAT, 0, {0, 16, 32, 0}, {16, 16, 16, 0}},
+	/* PVRSRV_PIXEL_FORMAT_L_F32 */
+	{4, BL_CHANNEL_FLOAT, BL_PXFMT_FLAG_LUMINANCE, {0, 0, 0, 0}, {32, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_A_F32 */
+	{4, BL_CHANNEL_FLOAT, 0, {0, 0, 0, 0}, {0, 0, 0, 32}},
+	/* PVRSRV_PIXEL_FORMAT_L_F32_A_F32 */
+	{8, BL_CHANNEL_FLOAT, BL_PXFMT_FLAG_LUMINANCE, {0, 0, 0, 32}, {32, 0, 0, 32}},
+	/* PVRSRV_PIXEL_FORMAT_PVRTC2 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_PVRTC4 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_PVRTCII2 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_PVRTCII4 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_PVRTCIII */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_PVRO8 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_PVRO88 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_PT1 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_PT2 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_PT4 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_PT8 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_PTW */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_PTB */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_MONO8 */
+	{1, BL_CHANNEL_UNORM, BL_PXFMT_FLAG_LUMINANCE, {0, 0, 0, 0}, {8, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_MONO16 */
+	{2, BL_CHANNEL_UNORM, BL_PXFMT_FLAG_LUMINANCE, {0, 0, 0, 0}, {16, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_C0_YUYV */
+	{2, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_C0_UYVY */
+	{2, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_C0_YVYU */
+	{2, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_C0_VYUY */
+	{2, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_C1_YUYV */
+	{2, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_C1_UYVY */
+	{2, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_C1_YVYU */
+	{2, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_C1_VYUY */
+	{2, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_C0_YUV420_2P_UV */
+	{1, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_C0_YUV420_2P_VU */
+	{1, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_C0_YUV420_3P */
+	{1, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_C1_YUV420_2P_UV */
+	{1, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_C1_YUV420_2P_VU */
+	{1, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_C1_YUV420_3P */
+	{1, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_A2B10G10R10F */
+	{4, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_B8G8R8_SINT */
+	{3, BL_CHANNEL_SINT, 0, {0, 8, 16, 0}, {8, 8, 8, 0}},
+	/* PVRSRV_PIXEL_FORMAT_PVRF32SIGNMASK */
+	{4, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_ABGR4444 */
+	{2, BL_CHANNEL_UNORM, 0, {0, 4, 8, 12}, {4, 4, 4, 4}},
+	/* PVRSRV_PIXEL_FORMAT_ABGR1555 */
+	{2, BL_CHANNEL_UNORM, 0, {0, 5, 10, 15}, {5, 5, 5, 1}},
+	/* PVRSRV_PIXEL_FORMAT_BGR565 */
+	{2, BL_CHANNEL_UNORM, 0, {0, 5, 11, 0}, {5, 6, 5, 0}},
+	/* PVRSRV_PIXEL_FORMAT_C0_4KYUV420_2P_UV */
+	{1, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_C0_4KYUV420_2P_VU */
+	{1, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_C1_4KYUV420_2P_UV */
+	{1, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_C1_4KYUV420_2P_VU */
+	{1, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_P208 */
+	{1, BL_CHANNEL_NONE, BL_PXFMT_FLAG_SUBSAMPLED, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_A8P8 */
+	{2, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_A4 */
+	{0, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_AYUV8888 */
+	{4, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_RAW256 */
+	{32, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_RAW512 */
+	{64, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}},
+	/* PVRSRV_PIXEL_FORMAT_RAW1024 */
+	{128, BL_CHANNEL_NONE, 0, {0, 0, 0, 0}, {0, 0, 0, 0}}
+};
+
+/* sRGB to linear, built on first use */
+static IMG_FLOAT gafBLSRGBToLinear[256];
+static IMG_BOOL gbBLSRGBTableBuilt = IMG_FALSE;
+
+typedef union _BL_FLOAT_BITS_
+{
+	IMG_FLOAT	f;
+	IMG_UINT32	ui32;
+} BL_FLOAT_BITS;
+
+/*****************************************************************************
+ * Function Name		:	BLSmallFloatToFloat
+ * Inputs				:	ui32Value - A float with a 5 bit exponent.
+ *							ui32MantissaBits - Its mantissa bits (10 for
+ *							halves, 6 and 5 for the unsigned 11 and 10 bit
+ *							floats).
+ *							bSigned - Whether a sign bit is above the exponent.
+ * Returns				:	The value as a float.
+ ******************************************************************************/
+static IMG_FLOAT BLSmallFloatToFloat(IMG_UINT32 ui32Value, IMG_UINT32 ui32MantissaBits, IMG_BOOL bSigned)
+{
+	IMG_UINT32 ui32Exponent = (ui32Value >> ui32MantissaBits) & 0x1F;
+	IMG_UINT32 ui32Mantissa = ui32Value & ((1U << ui32MantissaBits) - 1);
+	IMG_FLOAT fValue;
+
+	if (ui32Exponent == 0)
+	{
+		fValue = ldexpf((IMG_FLOAT)ui32Mantissa, -14 - (IMG_INT32)ui32MantissaBits);
+	}
+	else if (ui32Exponent == 0x1F)
+	{
+		BL_FLOAT_BITS uBits;
+
+		/* Infinity or NaN */
+		uBits.ui32 = 0x7F800000U | (ui32Mantissa ? 0x00400000U : 0);
+		fValue = uBits.f;
+	}
+	else
+	{
+		fValue = ldexpf((IMG_FLOAT)((1U << ui32MantissaBits) | ui32Mantissa),
+						(IMG_INT32)ui32Exponent - 15 - (IMG_INT32)ui32MantissaBits);
+	}
+
+	if (bSigned && ((ui32Value >> (ui32MantissaBits + 5)) & 1))
+	{
+		fValue = -fValue;
+	}
+
+	return fValue;
+}
+
+/*****************************************************************************
+ * Function Name		:	BLFloatToSmallFloat
+ * Inputs				:	fValue - The value.
+ *							ui32MantissaBits, bSigned - See BLSmallFloatToFloat.
+ * Returns				:	The value rounded to the nearest (even) small
+ *							float. Unsigned formats clamp negative values to 0.
+ ******************************************************************************/
+static IMG_UINT32 BLFloatToSmallFloat(IMG_FLOAT fValue, IMG_UINT32 ui32MantissaBits, IMG_BOOL bSigned)
+{
+	BL_FLOAT_BITS uBits;
+	IMG_UINT32 ui32Sign, ui32Result;
+	IMG_INT32 i32Exponent;
+	IMG_UINT32 ui32Mantissa;
+
+	uBits.f = fValue;
+	ui32Sign = uBits.ui32 >> 31;
+	i32Exponent = (IMG_INT32)((uBits.ui32 >> 23) & 0xFF);
+	ui32Mantissa = uBits.ui32 & 0x007FFFFF;
+
+	if (i32Exponent == 0xFF)
+	{
+		if (ui32Mantissa)
+		{
+			/* NaN */
+			ui32Result = (0x1FU << ui32MantissaBits) | (1U << (ui32MantissaBits - 1));
+			ui32Sign = 0;
+		}
+		else
+		{
+			ui32Result = 0x1FU << ui32MantissaBits;
+		}
+	}
+	else
+	{
+		i32Exponent = i32Exponent - 127 + 15;
+
+		if (i32Exponent >= 0x1F)
+		{
+			/* Too large: infinity */
+			ui32Result = 0x1FU << ui32MantissaBits;
+		}
+		else if (i32Exponent <= 0)
+		{
+			/* Denormal or zero */
+			IMG_FLOAT fScaled = ldexpf(uBits.ui32 & 0x80000000U ? -fValue : fValue, 14 + (IMG_INT32)ui32MantissaBits);
+
+			ui32Result = (IMG_UINT32)(fScaled + 0.5f);
+		}
+		else
+		{
+			IMG_UINT32 ui32Shift = 23 - ui32MantissaBits;
+			IMG_UINT32 ui32Rest = ui32Mantissa & ((1U << ui32Shift) - 1);
+			IMG_UINT32 ui32Half = 1U << (ui32Shift - 1);
+
+			ui32Result = ((IMG_UINT32)i32Exponent << ui32MantissaBits) | (ui32Mantissa >> ui32Shift);
+
+			/* Round to nearest even; a carry into the exponent is still correct */
+			if (ui32Rest > ui32Half || (ui32Rest == ui32Half && (ui32Result & 1)))
+			{
+				ui32Result++;
+			}
+		}
+	}
+
+	if (ui32Sign)
+	{
+		if (!bSigned)
+		{
+			return 0;
+		}
+		ui32Result |= 1U << (ui32MantissaBits + 5);
+	}
+
+	return ui32Result;
+}
+
+/*****************************************************************************
+ * Function Name		:	BLBuildSRGBTable
+ * Description			:	Fills gafBLSRGBToLinear. Building it twice from two
+ *							threads writes the same values, so it needs no lock.
+ ******************************************************************************/
+static IMG_VOID BLBuildSRGBTable(IMG_VOID)
+{
+	IMG_UINT32 i;
+
+	for (i = 0; i < 256; i++)
+	{
+		IMG_FLOAT fValue = (IMG_FLOAT)i / 255.0f;
+
+		gafBLSRGBToLinear[i] = (fValue <= 0.04045f) ? fValue / 12.92f : powf((fValue + 0.055f) / 1.055f, 2.4f);
+	}
+
+	gbBLSRGBTableBuilt = IMG_TRUE;
+}
+
+/*****************************************************************************
+ * Function Name		:	BLLinearToSRGB
+ * Inputs				:	fValue - Linear value.
+ * Returns				:	The sRGB encoded value, in [0, 1].
+ ******************************************************************************/
+static INLINE IMG_FLOAT BLLinearToSRGB(IMG_FLOAT fValue)
+{
+	if (!(fValue > 0.0031308f))
+	{
+		return (fValue > 0.0f) ? fValue * 12.92f : 0.0f;
+	}
+
+	return 1.055f * powf(fValue, 1.0f / 2.4f) - 0.055f;
+}
+
+/*****************************************************************************
+ * Function Name		:	BLDecodeChannel
+ * Inputs				:	eType, ui32Bits - Type and width of the channel.
+ *							ui32Value - Its bits.
+ * Returns				:	The channel as a float.
+ ******************************************************************************/
+static INLINE IMG_FLOAT BLDecodeChannel(BL_CHANNEL_TYPE eType, IMG_UINT32 ui32Bits, IMG_UINT32 ui32Value)
+{
+	switch (eType)
+	{
+		case BL_CHANNEL_UNORM:
+		{
+			return (IMG_FLOAT)ui32Value / (IMG_FLOAT)(IMG_UINT32)(0xFFFFFFFFU >> (32 - ui32Bits));
+		}
+		case BL_CHANNEL_SNORM:
+		{
+			IMG_INT32 i32Value = (IMG_INT32)(ui32Value << (32 - ui32Bits)) >> (32 - ui32Bits);
+			IMG_FLOAT fValue = (IMG_FLOAT)i32Value / (IMG_FLOAT)((1U << (ui32Bits - 1)) - 1);
+
+			return (fValue < -1.0f) ? -1.0f : fValue;
+		}
+		case BL_CHANNEL_UINT:
+		{
+			return (IMG_FLOAT)ui32Value;
+		}
+		case BL_CHANNEL_SINT:
+		{
+			return (IMG_FLOAT)((IMG_INT32)(ui32Value << (32 - ui32Bits)) >> (32 - ui32Bits));
+		}
+		case BL_CHANNEL_FLOAT:
+		{
+			switch (ui32Bits)
+			{
+				case 32:
+				{
+					BL_FLOAT_BITS uBits;
+
+					uBits.ui32 = ui32Value;
+					return uBits.f;
+				}
+				case 16:
+				{
+					return BLSmallFloatToFloat(ui32Value, 10, IMG_TRUE);
+				}
+				default:
+				{
+					return BLSmallFloatToFloat(ui32Value, ui32Bits - 5, IMG_FALSE);
+				}
+			}
+		}
+		default:
+		{
+			return 0.0f;
+		}
+	}
+}
+
+/*****************************************************************************
+ * Function Name		:	BLEncodeChannel
+ * Inputs				:	eType, ui32Bits - Type and width of the channel.
+ *							fValue - Value to store.
+ * Returns				:	The bits of the channel (clamped and rounded to
+ *							nearest).
+ ******************************************************************************/
+static INLINE IMG_UINT32 BLEncodeChannel(BL_CHANNEL_TYPE eType, IMG_UINT32 ui32Bits, IMG_FLOAT fValue)
+{
+	IMG_UINT32 ui32Mask = 0xFFFFFFFFU >> (32 - ui32Bits);
+
+	switch (eType)
+	{
+		case BL_CHANNEL_UNORM:
+		{
+			/* NaN goes to 0 */
+			if (!(fValue > 0.0f))
+			{
+				return 0;
+			}
+			if (fValue >= 1.0f)
+			{
+				return ui32Mask;
+			}
+			return (IMG_UINT32)(fValue * (IMG_FLOAT)ui32Mask + 0.5f);
+		}
+		case BL_CHANNEL_SNORM:
+		{
+			IMG_FLOAT fMax = (IMG_FLOAT)((1U << (ui32Bits - 1)) - 1);
+
+			if (!(fValue > -1.0f))
+			{
+				fValue = -1.0f;
+			}
+			if (fValue > 1.0f)
+			{
+				fValue = 1.0f;
+			}
+			fValue *= fMax;
+			return (IMG_UINT32)(IMG_INT32)((fValue >= 0.0f) ? fValue + 0.5f : fValue - 0.5f) & ui32Mask;
+		}
+		case BL_CHANNEL_UINT:
+		{
+			if (!(fValue > 0.0f))
+			{
+				return 0;
+			}
+			if ((IMG_DOUBLE)fValue >= (IMG_DOUBLE)ui32Mask)
+			{
+				return ui32Mask;
+			}
+			return (IMG_UINT32)((IMG_DOUBLE)fValue + 0.5);
+		}
+		case BL_CHANNEL_SINT:
+		{
+			IMG_DOUBLE dfMax = (IMG_DOUBLE)(ui32Mask >> 1);
+			IMG_DOUBLE dfValue = (IMG_DOUBLE)fValue;
+
+			if (!(dfValue > -dfMax - 1.0))
+			{
+				dfValue = -dfMax - 1.0;
+			}
+			if (dfValue > dfMax)
+			{
+				dfValue = dfMax;
+			}
+			return (IMG_UINT32)(IMG_INT32)((dfValue >= 0.0) ? dfValue + 0.5 : dfValue - 0.5) & ui32Mask;
+		}
+		case BL_CHANNEL_FLOAT:
+		{
+			switch (ui32Bits)
+			{
+				case 32:
+				{
+					BL_FLOAT_BITS uBits;
+
+					uBits.f = fValue;
+					return uBits.ui32;
+				}
+				case 16:
+				{
+					return BLFloatToSmallFloat(fValue, 10, IMG_TRUE);
+				}
+				default:
+				{
+					return BLFloatToSmallFloat(fValue, ui32Bits - 5, IMG_FALSE);
+				}
+			}
+		}
+		default:
+		{
+			return 0;
+		}
+	}
+}
+
+/*****************************************************************************
+ * Function Name		:	BLGetElementSize
+ * Inputs				:	psFormat - A pixel format.
+ * Returns				:	8, 16 or 32 if every channel of the format is a
+ *							whole, aligned element of that many bits, or 0.
+ ******************************************************************************/
+static IMG_UINT32 BLGetElementSize(const BL_EXTERNAL_PIXEL_FORMAT *psFormat)
+{
+	IMG_UINT32 ui32Size = 0;
+	IMG_UINT32 ui32Channel;
+
+	for (ui32Channel = 0; ui32Channel < 4; ui32Channel++)
+	{
+		IMG_UINT32 ui32Bits = psFormat->aui8Bits[ui32Channel];
+
+		if (ui32Bits == 0)
+		{
+			continue;
+		}
+		if ((ui32Bits != 8 && ui32Bits != 16 && ui32Bits != 32) ||
+			(ui32Size != 0 && ui32Size != ui32Bits) ||
+			(psFormat->aui8Shift[ui32Channel] % ui32Bits) != 0)
+		{
+			return 0;
+		}
+		ui32Size = ui32Bits;
+	}
+
+	return ui32Size;
+}
+
+/*****************************************************************************
+ * Function Name		:	BLGetRGBA8Offsets
+ * Inputs				:	psFormat - A pixel format.
+ * Outputs				:	pui32Offsets - Byte of each channel in the pixel.
+ * Returns				:	IMG_TRUE if the format is four 8 bit unsigned
+ *							normalised channels in 32 bits (ARGB8888, ABGR8888
+ *							and the like).
+ ******************************************************************************/
+static IMG_BOOL BLGetRGBA8Offsets(const BL_EXTERNAL_PIXEL_FORMAT *psFormat, IMG_UINT32 *pui32Offsets)
+{
+	IMG_UINT32 ui32Channel;
+
+	if (psFormat->ui32BytesPerPixel != 4 || psFormat->eChannelType != BL_CHANNEL_UNORM || psFormat->ui32Flags != 0)
+	{
+		return IMG_FALSE;
+	}
+
+	for (ui32Channel = 0; ui32Channel < 4; ui32Channel++)
+	{
+		if (psFormat->aui8Bits[ui32Channel] != 8 || (psFormat->aui8Shift[ui32Channel] & 7) != 0)
+		{
+			return IMG_FALSE;
+		}
+		pui32Offsets[ui32Channel] = psFormat->aui8Shift[ui32Channel] >> 3;
+	}
+
+	return IMG_TRUE;
+}
+
+/*****************************************************************************
+ * Function Name		:	BLFormatIsConvertible
+ * Inputs				:	ePixelFormat - A pixel format.
+ * Returns				:	IMG_TRUE if pixels of the format can be converted
+ *							to and from BL_FPIXELs.
+ ******************************************************************************/
+IMG_INTERNAL IMG_BOOL BLFormatIsConvertible(PVRSRV_PIXEL_FORMAT ePixelFormat)
+{
+	if ((IMG_UINT32)ePixelFormat > PVRSRV_PIXEL_FORMAT_RAW1024)
+	{
+		return IMG_FALSE;
+	}
+
+	return (gas_BLExternalPixelTable[ePixelFormat].eChannelType != BL_CHANNEL_NONE) ? IMG_TRUE : IMG_FALSE;
+}
+
+/*****************************************************************************
+ * Function Name		:	BLFormatIsCopyable
+ * Inputs				:	ePixelFormat - A pixel format.
+ * Returns				:	IMG_TRUE if pixels of the format can be moved as
+ *							raw pixels.
+ ******************************************************************************/
+IMG_INTERNAL IMG_BOOL BLFormatIsCopyable(PVRSRV_PIXEL_FORMAT ePixelFormat)
+{
+	const BL_EXTERNAL_PIXEL_FORMAT *psFormat;
+
+	if ((IMG_UINT32)ePixelFormat > PVRSRV_PIXEL_FORMAT_RAW1024)
+	{
+		return IMG_FALSE;
+	}
+
+	psFormat = &gas_BLExternalPixelTable[ePixelFormat];
+
+	return (psFormat->ui32BytesPerPixel != 0 &&
+			psFormat->ui32BytesPerPixel <= BL_MAX_RAW_PIXEL_BYTES &&
+			(psFormat->ui32Flags & BL_PXFMT_FLAG_SUBSAMPLED) == 0) ? IMG_TRUE : IMG_FALSE;
+}
+
+/*****************************************************************************
+ * Function Name		:	BLDecodeSpan
+ * Inputs				:	ePixelFormat - Format of the pixels, which must be
+ *							convertible.
+ *							pbyIn - ui32Count packed pixels.
+ * Outputs				:	psOut - The pixels as BL_FPIXELs.
+ * Description			:	Converts pixels to floating point, one channel at a
+ *							time. Formats made of aligned 8, 16 or 32 bit
+ *							channels (the common case) load each channel as an
+ *							element; the others extract bit fields.
+ ******************************************************************************/
+IMG_INTERNAL IMG_VOID BLDecodeSpan(PVRSRV_PIXEL_FORMAT ePixelFormat, const IMG_BYTE *pbyIn,
+								   IMG_UINT32 ui32Count, BL_FPIXEL *psOut)
+{
+	const BL_EXTERNAL_PIXEL_FORMAT *psFormat = &gas_BLExternalPixelTable[ePixelFormat];
+	IMG_UINT32 ui32BytesPerPixel = psFormat->ui32BytesPerPixel;
+	IMG_UINT32 ui32ElementSize = BLGetElementSize(psFormat);
+	BL_CHANNEL_TYPE eType = psFormat->eChannelType;
+	IMG_FLOAT *pfOut = &psOut[0].fR;
+	IMG_UINT32 aui32Offsets[4];
+	IMG_UINT32 ui32Channel, i;
+
+	/* The most common formats a pixel at a time, which the compiler can vectorise */
+	if (BLGetRGBA8Offsets(psFormat, aui32Offsets))
+	{
+		for (i = 0; i < ui32Count; i++)
+		{
+			const IMG_BYTE *pbyPixel = pbyIn + i * 4;
+
+			psOut[i].fR = (IMG_FLOAT)pbyPixel[aui32Offsets[BL_CHANNEL_R]] * (1.0f / 255.0f);
+			psOut[i].fG = (IMG_FLOAT)pbyPixel[aui32Offsets[BL_CHANNEL_G]] * (1.0f / 255.0f);
+			psOut[i].fB = (IMG_FLOAT)pbyPixel[aui32Offsets[BL_CHANNEL_B]] * (1.0f / 255.0f);
+			psOut[i].fA = (IMG_FLOAT)pbyPixel[aui32Offsets[BL_CHANNEL_A]] * (1.0f / 255.0f);
+		}
+		return;
+	}
+
+	if ((psFormat->ui32Flags & BL_PXFMT_FLAG_SRGB) && !gbBLSRGBTableBuilt)
+	{
+		BLBuildSRGBTable();
+	}
+
+	for (ui32Channel = 0; ui32Channel < 4; ui32Channel++)
+	{
+		IMG_UINT32 ui32Bits = psFormat->aui8Bits[ui32Channel];
+		IMG_UINT32 ui32Shift = psFormat->aui8Shift[ui32Channel];
+		IMG_FLOAT *pfChannel = pfOut + ui32Channel;
+
+		if (ui32Bits == 0)
+		{
+			IMG_FLOAT fDefault = (ui32Channel == BL_CHANNEL_A) ? 1.0f : 0.0f;
+
+			for (i = 0; i < ui32Count; i++)
+			{
+				pfChannel[i * 4] = fDefault;
+			}
+		}
+		else if ((psFormat->ui32Flags & BL_PXFMT_FLAG_SRGB) && ui32Channel != BL_CHANNEL_A)
+		{
+			const IMG_BYTE *pbyChannel = pbyIn + (ui32Shift >> 3);
+
+			for (i = 0; i < ui32Count; i++)
+			{
+				pfChannel[i * 4] = gafBLSRGBToLinear[pbyChannel[i * ui32BytesPerPixel]];
+			}
+		}
+		else if (ui32ElementSize == 8 && eType == BL_CHANNEL_UNORM)
+		{
+			const IMG_BYTE *pbyChannel = pbyIn + (ui32Shift >> 3);
+
+			for (i = 0; i < ui32Count; i++)
+			{
+				pfChannel[i * 4] = (IMG_FLOAT)pbyChannel[i * ui32BytesPerPixel] * (1.0f / 255.0f);
+			}
+		}
+		else if (ui32ElementSize == 16 && eType == BL_CHANNEL_UNORM)
+		{
+			const IMG_BYTE *pbyChannel = pbyIn + (ui32Shift >> 3);
+
+			for (i = 0; i < ui32Count; i++)
+			{
+				const IMG_BYTE *pbyElement = pbyChannel + i * ui32BytesPerPixel;
+
+				pfChannel[i * 4] = (IMG_FLOAT)(IMG_INT32)(pbyElement[0] | (pbyElement[1] << 8)) * (1.0f / 65535.0f);
+			}
+		}
+		else if (ui32ElementSize == 32 && eType == BL_CHANNEL_FLOAT)
+		{
+			const IMG_BYTE *pbyChannel = pbyIn + (ui32Shift >> 3);
+
+			for (i = 0; i < ui32Count; i++)
+			{
+				memcpy(&pfChannel[i * 4], pbyChannel + i * ui32BytesPerPixel, sizeof(IMG_FLOAT));
+			}
+		}
+		else if (eType == BL_CHANNEL_UNORM && ui32Bits < 32 && (ui32BytesPerPixel == 2 || ui32BytesPerPixel == 4))
+		{
+			/*
+				Packed 16 and 32 bit formats (RGB565, ARGB4444, A2RGB10...). Channels
+				are narrower than 32 bits, so they convert as signed integers, which
+				is cheaper than unsigned on most CPUs.
+			*/
+			IMG_UINT32 ui32Mask = 0xFFFFFFFFU >> (32 - ui32Bits);
+			IMG_FLOAT fScale = 1.0f / (IMG_FLOAT)ui32Mask;
+
+			if (ui32BytesPerPixel == 2)
+			{
+				for (i = 0; i < ui32Count; i++)
+				{
+					IMG_UINT32 ui32Word = (IMG_UINT32)pbyIn[i * 2] | ((IMG_UINT32)pbyIn[i * 2 + 1] << 8);
+
+					pfChannel[i * 4] = (IMG_FLOAT)(IMG_INT32)((ui32Word >> ui32Shift) & ui32Mask) * fScale;
+				}
+			}
+			else
+			{
+				for (i = 0; i < ui32Count; i++)
+				{
+					IMG_UINT32 ui32Word = (IMG_UINT32)pbyIn[i * 4] | ((IMG_UINT32)pbyIn[i * 4 + 1] << 8) |
+										  ((IMG_UINT32)pbyIn[i * 4 + 2] << 16) | ((IMG_UINT32)pbyIn[i * 4 + 3] << 24);
+
+					pfChannel[i * 4] = (IMG_FLOAT)(IMG_INT32)((ui32Word >> ui32Shift) & ui32Mask) * fScale;
+				}
+			}
+		}
+		else
+		{
+			IMG_UINT32 ui32Mask = 0xFFFFFFFFU >> (32 - ui32Bits);
+			const IMG_BYTE *pbyWord = pbyIn + ((ui32Shift >> 5) << 2);
+			IMG_UINT32 ui32WordBytes = BL_MIN(4, ui32BytesPerPixel - ((ui32Shift >> 5) << 2));
+			IMG_UINT32 ui32BitShift = ui32Shift & 31;
+
+			for (i = 0; i < ui32Count; i++)
+			{
+				const IMG_BYTE *pbyPixelWord = pbyWord + i * ui32BytesPerPixel;
+				IMG_UINT32 ui32Word = 0, j;
+
+				for (j = 0; j < ui32WordBytes; j++)
+				{
+					ui32Word |= (IMG_UINT32)pbyPixelWord[j] << (j * 8);
+				}
+
+				pfChannel[i * 4] = BLDecodeChannel(eType, ui32Bits, (ui32Word >> ui32BitShift) & ui32Mask);
+			}
+		}
+	}
+
+	if (psFormat->ui32Flags & BL_PXFMT_FLAG_LUMINANCE)
+	{
+		for (i = 0; i < ui32Count; i++)
+		{
+			psOut[i].fG = psOut[i].fR;
+			psOut[i].fB = psOut[i].fR;
+		}
+	}
+}
+
+/*****************************************************************************
+ * Function Name		:	BLEncodeSpan
+ * Inputs				:	ePixelFormat - Format of the pixels, which must be
+ *							convertible.
+ *							psIn - ui32Count pixels.
+ * Outputs				:	pbyOut - The pixels, packed. Bits which belong to
+ *							no channel are 0.
+ * Description			:	Converts floating point pixels to a format (the
+ *							reverse of BLDecodeSpan).
+ ******************************************************************************/
+IMG_INTERNAL IMG_VOID BLEncodeSpan(PVRSRV_PIXEL_FORMAT ePixelFormat, const BL_FPIXEL *psIn,
+								   IMG_UINT32 ui32Count, IMG_BYTE *pbyOut)
+{
+	const BL_EXTERNAL_PIXEL_FORMAT *psFormat = &gas_BLExternalPixelTable[ePixelFormat];
+	IMG_UINT32 ui32BytesPerPixel = psFormat->ui32BytesPerPixel;
+	IMG_UINT32 ui32ElementSize = BLGetElementSize(psFormat);
+	BL_CHANNEL_TYPE eType = psFormat->eChannelType;
+	const IMG_FLOAT *pfIn = &psIn[0].fR;
+	IMG_UINT32 aui32Offsets[4];
+	IMG_UINT32 ui32Channel, i;
+
+	if (BLGetRGBA8Offsets(psFormat, aui32Offsets))
+	{
+		for (i = 0; i < ui32Count; i++)
+		{
+			IMG_UINT32 ui32Pixel = 0;
+
+			for (ui32Channel = 0; ui32Channel < 4; ui32Channel++)
+			{
+				IMG_FLOAT fValue = pfIn[i * 4 + ui32Channel];
+
+				/* Written so that NaN becomes 0 */
+				fValue = (fValue > 0.0f) ? fValue : 0.0f;
+				fValue = (fValue < 1.0f) ? fValue : 1.0f;
+				ui32Pixel |= (IMG_UINT32)(IMG_INT32)(fValue * 255.0f + 0.5f) << (aui32Offsets[ui32Channel] * 8);
+			}
+
+			pbyOut[i * 4] = (IMG_BYTE)ui32Pixel;
+			pbyOut[i * 4 + 1] = (IMG_BYTE)(ui32Pixel >> 8);
+			pbyOut[i * 4 + 2] = (IMG_BYTE)(ui32Pixel >> 16);
+			pbyOut[i * 4 + 3] = (IMG_BYTE)(ui32Pixel >> 24);
+		}
+		return;
+	}
+
+	memset(pbyOut, 0, ui32Count * ui32BytesPerPixel);
+
+	for (ui32Channel = 0; ui32Channel < 4; ui32Channel++)
+	{
+		IMG_UINT32 ui32Bits = psFormat->aui8Bits[ui32Channel];
+		IMG_UINT32 ui32Shift = psFormat->aui8Shift[ui32Channel];
+		const IMG_FLOAT *pfChannel = pfIn + ui32Channel;
+
+		if (ui32Bits == 0)
+		{
+			continue;
+		}
+
+		if ((psFormat->ui32Flags & BL_PXFMT_FLAG_SRGB) && ui32Channel != BL_CHANNEL_A)
+		{
+			IMG_BYTE *pbyChannel = pbyOut + (ui32Shift >> 3);
+
+			for (i = 0; i < ui32Count; i++)
+			{
+				pbyChannel[i * ui32BytesPerPixel] = (IMG_BYTE)BLEncodeChannel(BL_CHANNEL_UNORM, 8, BLLinearToSRGB(pfChannel[i * 4]));
+			}
+		}
+		else if (ui32ElementSize == 8 && eType == BL_CHANNEL_UNORM)
+		{
+			IMG_BYTE *pbyChannel = pbyOut + (ui32Shift >> 3);
+
+			for (i = 0; i < ui32Count; i++)
+			{
+				IMG_FLOAT fValue = pfChannel[i * 4];
+
+				/* Written so that NaN becomes 0 */
+				fValue = (fValue > 0.0f) ? fValue : 0.0f;
+				fValue = (fValue < 1.0f) ? fValue : 1.0f;
+				pbyChannel[i * ui32BytesPerPixel] = (IMG_BYTE)(IMG_INT32)(fValue * 255.0f + 0.5f);
+			}
+		}
+		else if (ui32ElementSize == 32 && eType == BL_CHANNEL_FLOAT)
+		{
+			IMG_BYTE *pbyChannel = pbyOut + (ui32Shift >> 3);
+
+			for (i = 0; i < ui32Count; i++)
+			{
+				memcpy(pbyChannel + i * ui32BytesPerPixel, &pfChannel[i * 4], sizeof(IMG_FLOAT));
+			}
+		}
+		else if (eType == BL_CHANNEL_UNORM && ui32BytesPerPixel == 2)
+		{
+			IMG_FLOAT fMax = (IMG_FLOAT)(0xFFFFFFFFU >> (32 - ui32Bits));
+
+			for (i = 0; i < ui32Count; i++)
+			{
+				IMG_FLOAT fValue = pfChannel[i * 4];
+				IMG_UINT32 ui32Value;
+
+				fValue = (fValue > 0.0f) ? fValue : 0.0f;
+				fValue = (fValue < 1.0f) ? fValue : 1.0f;
+				ui32Value = (IMG_UINT32)(IMG_INT32)(fValue * fMax + 0.5f) << ui32Shift;
+
+				pbyOut[i * 2] |= (IMG_BYTE)ui32Value;
+				pbyOut[i * 2 + 1] |= (IMG_BYTE)(ui32Value >> 8);
+			}
+		}
+		else
+		{
+			IMG_BYTE *pbyWord = pbyOut + ((ui32Shift >> 5) << 2);
+			IMG_UINT32 ui32WordBytes = BL_MIN(4, ui32BytesPerPixel - ((ui32Shift >> 5) << 2));
+			IMG_UINT32 ui32BitShift = ui32Shift & 31;
+
+			for (i = 0; i < ui32Count; i++)
+			{
+				IMG_BYTE *pbyPixelWord = pbyWord + i * ui32BytesPerPixel;
+				IMG_UINT32 ui32Word = BLEncodeChannel(eType, ui32Bits, pfChannel[i * 4]) << ui32BitShift;
+				IMG_UINT32 j;
+
+				for (j = 0; j < ui32WordBytes; j++)
+				{
+					pbyPixelWord[j] |= (IMG_BYTE)(ui32Word >> (j * 8));
+				}
+			}
+		}
+	}
+}
+
+/*****************************************************************************
+ * Function Name		:	BLFloatToARGB8888
+ * Inputs				:	psPixel - A pixel.
+ * Returns				:	The pixel as ARGB8888.
+ ******************************************************************************/
+IMG_INTERNAL IMG_UINT32 BLFloatToARGB8888(const BL_FPIXEL *psPixel)
+{
+	return (BLEncodeChannel(BL_CHANNEL_UNORM, 8, psPixel->fA) << 24) |
+		   (BLEncodeChannel(BL_CHANNEL_UNORM, 8, psPixel->fR) << 16) |
+		   (BLEncodeChannel(BL_CHANNEL_UNORM, 8, psPixel->fG) << 8) |
+		   BLEncodeChannel(BL_CHANNEL_UNORM, 8, psPixel->fB);
+}
+
+/*****************************************************************************
+ * Function Name		:	BLARGB8888ToFloat
+ * Inputs				:	ui32ARGB8888 - A pixel.
+ * Outputs				:	psPixel - The pixel as floats.
+ ******************************************************************************/
+IMG_INTERNAL IMG_VOID BLARGB8888ToFloat(IMG_UINT32 ui32ARGB8888, BL_FPIXEL *psPixel)
+{
+	psPixel->fA = (IMG_FLOAT)((ui32ARGB8888 >> 24) & 0xFF) / 255.0f;
+	psPixel->fR = (IMG_FLOAT)((ui32ARGB8888 >> 16) & 0xFF) / 255.0f;
+	psPixel->fG = (IMG_FLOAT)((ui32ARGB8888 >> 8) & 0xFF) / 255.0f;
+	psPixel->fB = (IMG_FLOAT)(ui32ARGB8888 & 0xFF) / 255.0f;
+}
+
+/*****************************************************************************
+ * Function Name		:	BLPixelToFloat
+ * Inputs				:	psPixel - A colour.
+ *							eInternalFormat - How to read it.
+ * Outputs				:	psFloat - The colour as floats.
+ ******************************************************************************/
+IMG_INTERNAL IMG_VOID BLPixelToFloat(const BL_PIXEL *psPixel, BL_INTERNAL_PX_FMT eInternalFormat,
+									 BL_FPIXEL *psFloat)
+{
+	if (eInternalFormat == BL_INTERNAL_PX_FMT_ARGB8888)
+	{
+		BLARGB8888ToFloat(psPixel->ui32ARGB8888, psFloat);
+	}
+	else
+	{
+		*psFloat = psPixel->sFloat;
+	}
+}
+
+/*****************************************************************************
+ * Function Name		:	BLLog2
+ * Inputs				:	ui32Value - A value > 0.
+ * Returns				:	log2 of the smallest power of two >= ui32Value.
+ ******************************************************************************/
+static IMG_UINT32 BLLog2(IMG_UINT32 ui32Value)
+{
+	IMG_UINT32 ui32Log2 = 0;
+
+	while (ui32Log2 < 31 && (1U << ui32Log2) < ui32Value)
+	{
+		ui32Log2++;
+	}
+
+	return ui32Log2;
+}
+
+/*****************************************************************************
+ * Function Name		:	BLSpreadBits
+ * Inputs				:	ui32Value - A 16 bit value.
+ * Returns				:	The value with a 0 inserted above each bit.
+ ******************************************************************************/
+static INLINE IMG_UINT32 BLSpreadBits(IMG_UINT32 ui32Value)
+{
+	ui32Value = (ui32Value | (ui32Value << 8)) & 0x00FF00FFU;
+	ui32Value = (ui32Value | (ui32Value << 4)) & 0x0F0F0F0FU;
+	ui32Value = (ui32Value | (ui32Value << 2)) & 0x33333333U;
+	ui32Value = (ui32Value | (ui32Value << 1)) & 0x55555555U;
+
+	return ui32Value;
+}
+
+/*****************************************************************************
+ * Function Name		:	BLSurfaceInit
+ * Inputs				:	eMemLayout, ePixelFormat - Layout and format.
+ *							i32Stride - Bytes per row (linear and tiled).
+ *							ui32Width - Width in pixels (twiddled); linear and
+ *							tiled surfaces are as wide as their stride.
+ *							ui32Height - Height in pixels.
+ *							psPlanarInfo - Planes of >32 bit pixels, or
+ *							IMG_NULL.
+ * Outputs				:	psSurface - The surface.
+ ******************************************************************************/
+IMG_INTERNAL IMG_VOID BLSurfaceInit(BL_SURFACE *psSurface, BL_MEMLAYOUT eMemLayout,
+									PVRSRV_PIXEL_FORMAT ePixelFormat, IMG_INT32 i32Stride,
+									IMG_UINT32 ui32Width, IMG_UINT32 ui32Height,
+									const BL_PLANAR_SURFACE_INFO *psPlanarInfo)
+{
+	IMG_UINT32 ui32BytesPerPixel = 0;
+
+	if ((IMG_UINT32)ePixelFormat <= PVRSRV_PIXEL_FORMAT_RAW1024)
+	{
+		ui32BytesPerPixel = gas_BLExternalPixelTable[ePixelFormat].ui32BytesPerPixel;
+	}
+
+	memset(psSurface, 0, sizeof(*psSurface));
+
+	psSurface->eMemLayout = eMemLayout;
+	psSurface->ePixelFormat = ePixelFormat;
+	psSurface->ui32BytesPerPixel = ui32BytesPerPixel;
+	psSurface->i32Stride = i32Stride;
+	psSurface->ui32Height = ui32Height;
+
+	if (psPlanarInfo != IMG_NULL && psPlanarInfo->bIsPlanar &&
+		psPlanarInfo->uiNChunks * psPlanarInfo->uiPixelBytesPerPlane == ui32BytesPerPixel)
+	{
+		psSurface->ui32ChunkBytes = psPlanarInfo->uiPixelBytesPerPlane;
+		psSurface->ui32NumChunks = psPlanarInfo->uiNChunks;
+		psSurface->i32ChunkStride = psPlanarInfo->i32ChunkStride;
+	}
+	else
+	{
+		psSurface->ui32ChunkBytes = ui32BytesPerPixel;
+		psSurface->ui32NumChunks = 1;
+		psSurface->i32ChunkStride = 0;
+	}
+
+	switch (eMemLayout)
+	{
+		case BL_MEMLAYOUT_LINEAR:
+		case BL_MEMLAYOUT_TILED:
+		{
+			IMG_UINT32 ui32RowBytes = (IMG_UINT32)((i32Stride < 0) ? -i32Stride : i32Stride);
+
+			psSurface->ui32Width = psSurface->ui32ChunkBytes ? ui32RowBytes / psSurface->ui32ChunkBytes : 0;
+			break;
+		}
+		case BL_MEMLAYOUT_TWIDDLED:
+		{
+			psSurface->ui32Width = ui32Width;
+			psSurface->ui32WidthLog2 = BLLog2(ui32Width);
+			psSurface->ui32HeightLog2 = BLLog2(ui32Height);
+			break;
+		}
+		case BL_MEMLAYOUT_HYBRID_TWIDDLED:
+		{
+			/* The largest power of two tile, up to 16x16, which fits in both dimensions (see GetTileSize) */
+			IMG_UINT32 ui32MinSize = BL_MIN(ui32Width, ui32Height);
+
+			psSurface->ui32Width = ui32Width;
+			psSurface->ui32TileSize = 1;
+			psSurface->ui32TileSizeLog2 = 0;
+
+			while (psSurface->ui32TileSize < BL_HYBRID_TWIDDLE_MAX_TILE && psSurface->ui32TileSize * 2 <= ui32MinSize)
+			{
+				psSurface->ui32TileSize *= 2;
+				psSurface->ui32TileSizeLog2++;
+			}
+
+			psSurface->ui32TilesPerRow = (ui32Width + psSurface->ui32TileSize - 1) >> psSurface->ui32TileSizeLog2;
+			break;
+		}
+	}
+}
+
+/*****************************************************************************
+ * Function Name		:	BLSurfaceOffset
+ * Inputs				:	psSurface - The surface.
+ *							ui32X, ui32Y - A pixel inside it.
+ * Returns				:	Offset of (the first chunk of) the pixel.
+ ******************************************************************************/
+static INLINE IMG_INT32 BLSurfaceOffset(const BL_SURFACE *psSurface, IMG_UINT32 ui32X, IMG_UINT32 ui32Y)
+{
+	IMG_UINT32 ui32ChunkBytes = psSurface->ui32ChunkBytes;
+
+	switch (psSurface->eMemLayout)
+	{
+		case BL_MEMLAYOUT_LINEAR:
+		default:
+		{
+			return (IMG_INT32)ui32Y * psSurface->i32Stride + (IMG_INT32)(ui32X * ui32ChunkBytes);
+		}
+		case BL_MEMLAYOUT_TILED:
+		{
+			/* Rows of 32x32 tiles, each stored linearly */
+			return (IMG_INT32)(ui32Y & ~(BL_TILE_SIZE - 1)) * psSurface->i32Stride +
+				   (IMG_INT32)(((ui32X & ~(BL_TILE_SIZE - 1)) * BL_TILE_SIZE +
+								(ui32Y & (BL_TILE_SIZE - 1)) * BL_TILE_SIZE +
+								(ui32X & (BL_TILE_SIZE - 1))) * ui32ChunkBytes);
+		}
+		case BL_MEMLAYOUT_TWIDDLED:
+		{
+			/*
+				Interleave the low bits of y (even bits) and x (odd bits)
+				over the smaller dimension; the rest of the larger one goes
+				above them.
+			*/
+			IMG_UINT32 ui32Common = BL_MIN(psSurface->ui32WidthLog2, psSurface->ui32HeightLog2);
+			IMG_UINT32 ui32CommonMask = (1U << ui32Common) - 1;
+			IMG_UINT32 ui32Offset;
+
+			ui32Offset = (BLSpreadBits(ui32X & ui32CommonMask) << 1) | BLSpreadBits(ui32Y & ui32CommonMask);
+			ui32Offset |= ((ui32X >> ui32Common) | (ui32Y >> ui32Common)) << (2 * ui32Common);
+
+			return (IMG_INT32)(ui32Offset * ui32ChunkBytes);
+		}
+		case BL_MEMLAYOUT_HYBRID_TWIDDLED:
+		{
+			/* Rows of square tiles, each twiddled */
+			IMG_UINT32 ui32TileLog2 = psSurface->ui32TileSizeLog2;
+			IMG_UINT32 ui32TileMask = psSurface->ui32TileSize - 1;
+			IMG_UINT32 ui32Tile = (ui32X >> ui32TileLog2) + (ui32Y >> ui32TileLog2) * psSurface->ui32TilesPerRow;
+			IMG_UINT32 ui32Offset;
+
+			ui32Offset = (ui32Tile << (2 * ui32TileLog2)) |
+						 (BLSpreadBits(ui32X & ui32TileMask) << 1) | BLSpreadBits(ui32Y & ui32TileMask);
+
+			return (IMG_INT32)(ui32Offset * ui32ChunkBytes);
+		}
+	}
+}
+
+/*****************************************************************************
+ * Function Name		:	BLSurfaceGetRow
+ * Inputs				:	psSurface - The surface.
+ *							pbyFBAddr - Its memory.
+ *							i32Y - A row inside it.
+ * Returns				:	The address of the row if its pixels are stored
+ *							one after the other, IMG_NULL otherwise.
+ ******************************************************************************/
+IMG_INTERNAL IMG_PBYTE BLSurfaceGetRow(const BL_SURFACE *psSurface, IMG_PBYTE pbyFBAddr, IMG_INT32 i32Y)
+{
+	if (psSurface->eMemLayout != BL_MEMLAYOUT_LINEAR || psSurface->ui32NumChunks != 1)
+	{
+		return IMG_NULL;
+	}
+
+	return pbyFBAddr + i32Y * psSurface->i32Stride;
+}
+
+/*****************************************************************************
+ * Function Name		:	BLSurfaceReadSpan
+ * Inputs				:	psSurface - The surface.
+ *							pbyFBAddr - Its memory.
+ *							i32X, i32Y - First pixel of the span; pixels
+ *							outside the surface repeat its nearest edge.
+ *							ui32Count - Pixels to read.
+ * Outputs				:	pbyOut - The pixels, packed.
+ ******************************************************************************/
+IMG_INTERNAL IMG_VOID BLSurfaceReadSpan(const BL_SURFACE *psSurface, const IMG_BYTE *pbyFBAddr,
+										IMG_INT32 i32X, IMG_INT32 i32Y, IMG_UINT32 ui32Count,
+										IMG_BYTE *pbyOut)
+{
+	IMG_UINT32 ui32BytesPerPixel = psSurface->ui32BytesPerPixel;
+	IMG_UINT32 ui32ChunkBytes = psSurface->ui32ChunkBytes;
+	IMG_INT32 i32MaxX = (IMG_INT32)psSurface->ui32Width - 1;
+	IMG_INT32 i32MaxY = (IMG_INT32)psSurface->ui32Height - 1;
+	IMG_UINT32 ui32Y, i;
+
+	if (i32MaxX < 0 || i32MaxY < 0)
+	{
+		memset(pbyOut, 0, ui32Count * ui32BytesPerPixel);
+		return;
+	}
+
+	ui32Y = (IMG_UINT32)((i32Y < 0) ? 0 : ((i32Y > i32MaxY) ? i32MaxY : i32Y));
+
+	if (psSurface->eMemLayout == BL_MEMLAYOUT_LINEAR && psSurface->ui32NumChunks == 1)
+	{
+		const IMG_BYTE *pbyRow = pbyFBAddr + (IMG_INT32)ui32Y * psSurface->i32Stride;
+		IMG_INT32 i32End = i32X + (IMG_INT32)ui32Count;
+		IMG_INT32 i32First = BL_MAX(i32X, 0);
+		IMG_INT32 i32Last = BL_MIN(i32End, i32MaxX + 1);
+
+		/* Left of the surface */
+		for (i = 0; (IMG_INT32)i < i32First - i32X && i < ui32Count; i++)
+		{
+			BLCopyPixel(pbyOut + i * ui32BytesPerPixel, pbyRow, ui32BytesPerPixel);
+		}
+
+		if (i32Last > i32First)
+		{
+			memcpy(pbyOut + (IMG_UINT32)(i32First - i32X) * ui32BytesPerPixel,
+				   pbyRow + (IMG_UINT32)i32First * ui32BytesPerPixel,
+				   (IMG_UINT32)(i32Last - i32First) * ui32BytesPerPixel);
+		}
+
+		/* Right of the surface */
+		for (i = (IMG_UINT32)BL_MAX(BL_MAX(i32Last, i32First) - i32X, 0); i < ui32Count; i++)
+		{
+			BLCopyPixel(pbyOut + i * ui32BytesPerPixel, pbyRow + (IMG_UINT32)i32MaxX * ui32BytesPerPixel, ui32BytesPerPixel);
+		}
+
+		return;
+	}
+
+	for (i = 0; i < ui32Count; i++)
+	{
+		IMG_INT32 i32PixelX = i32X + (IMG_INT32)i;
+		IMG_UINT32 ui32X = (IMG_UINT32)((i32PixelX < 0) ? 0 : ((i32PixelX > i32MaxX) ? i32MaxX : i32PixelX));
+		const IMG_BYTE *pbyPixel = pbyFBAddr + BLSurfaceOffset(psSurface, ui32X, ui32Y);
+		IMG_BYTE *pbyOutPixel = pbyOut + i * ui32BytesPerPixel;
+		IMG_UINT32 ui32Chunk;
+
+		for (ui32Chunk = 0; ui32Chunk < psSurface->ui32NumChunks; ui32Chunk++)
+		{
+			BLCopyPixel(pbyOutPixel + ui32Chunk * ui32ChunkBytes,
+						pbyPixel + (IMG_INT32)ui32Chunk * psSurface->i32ChunkStride,
+						ui32ChunkBytes);
+		}
+	}
+}
+
+/*****************************************************************************
+ * Function Name		:	BLSurfaceWriteSpan
+ * Inputs				:	psSurface - The surface.
+ *							i32X, i32Y - First pixel of the span, which must
+ *							lie inside the surface.
+ *							ui32Count - Pixels to write.
+ *							pbyIn - The pixels, packed.
+ * Outputs				:	pbyFBAddr - The surface memory.
+ ******************************************************************************/
+IMG_INTERNAL IMG_VOID BLSurfaceWriteSpan(const BL_SURFACE *psSurface, IMG_PBYTE pbyFBAddr,
+										 IMG_INT32 i32X, IMG_INT32 i32Y, IMG_UINT32 ui32Count,
+										 const IMG_BYTE *pbyIn)
+{
+	IMG_UINT32 ui32BytesPerPixel = psSurface->ui32BytesPerPixel;
+	IMG_UINT32 ui32ChunkBytes = psSurface->ui32ChunkBytes;
+	IMG_UINT32 i;
+
+	if (psSurface->eMemLayout == BL_MEMLAYOUT_LINEAR && psSurface->ui32NumChunks == 1)
+	{
+		memcpy(pbyFBAddr + i32Y * psSurface->i32Stride + i32X * (IMG_INT32)ui32BytesPerPixel,
+			   pbyIn, ui32Count * ui32BytesPerPixel);
+		return;
+	}
+
+	for (i = 0; i < ui32Count; i++)
+	{
+		IMG_BYTE *pbyPixel = pbyFBAddr + BLSurfaceOffset(psSurface, (IMG_UINT32)i32X + i, (IMG_UINT32)i32Y);
+		const IMG_BYTE *pbyInPixel = pbyIn + i * ui32BytesPerPixel;
+		IMG_UINT32 ui32Chunk;
+
+		for (ui32Chunk = 0; ui32Chunk < psSurface->ui32NumChunks; ui32Chunk++)
+		{
+			BLCopyPixel(pbyPixel + (IMG_INT32)ui32Chunk * psSurface->i32ChunkStride,
+						pbyInPixel + ui32Chunk * ui32ChunkBytes,
+						ui32ChunkBytes);
+		}
+	}
+}
+
+/******************************************************************************
+ End of file (blitlib.c)
+******************************************************************************/
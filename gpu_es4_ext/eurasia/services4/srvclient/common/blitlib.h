@@ -0,0 +1,359 @@
+/*!****************************************************************************
+@File           blitlib.h
+
+@Title          Software blit library
+
+@Author         Imagination Technologies
+
+@date           19/10/10
+
+@Copyright      Copyright 2010 by Imagination Technologies Limited.
+                All rights reserved. No part of this software, either
+                material or conceptual may be copied or distributed,
+                transmitted, transcribed, stored in a retrieval system
+                or translated into any human or computer language in any
+                form by any means, electronic, mechanical, manual or
+                other-wise, or disclosed to third parties without the
+                express written permission of Imagination Technologies
+                Limited, Unit 8, HomePark Industrial Estate,
+                King's Langley, Hertfordshire, WD4 8LZ, U.K.
+
+@Platform       Generic
+
+@Description    Pipeline objects, pixel formats and surface access shared by
+                the blitlib sources (blitlib_src.h), operations
+                (blitlib_op.h) and destinations (blitlib_dst.h).
+
+                A blit is a chain of objects ending in a destination. Each
+                object pulls spans of pixels from the object(s) upstream of
+                it, so nothing is buffered beyond one span per object:
+
+                    source -> [scale] -> [flip] -> [blend] -> ... -> destination
+
+                BL_OBJECT_START on the destination walks its clip rectangle
+                a span at a time. Pixels travel either as floating point
+                RGBA (BL_FPIXEL) or, when every object between the source
+                and the destination only moves pixels around (copies,
+                point scaling, flips, rotations, fills), as raw pixels of
+                the destination format, which needs no conversion at all.
+
+                The span loops are plain C written so that the compiler
+                can vectorise them (NEON on the device, SSE on a host).
+
+@DoxygenVer
+
+******************************************************************************/
+
+/******************************************************************************
+Modifications :-
+
+$Log: blitlib.h $
+
+*****************************************************************************/
+
+#ifndef _BLITLIB_H_
+#define _BLITLIB_H_
+
+#include <string.h>
+
+#include "img_types.h"
+#include "img_defs.h"
+#include "servicesext.h"
+
+/*
+	Pixels moved through the pipeline per span. Every object holds up to two
+	span buffers and the transfer queue keeps its objects on the stack, so
+	this is kept small.
+*/
+#define BL_MAX_SPAN					64
+
+/* Largest pixel the raw (unconverted) path can move */
+#define BL_MAX_RAW_PIXEL_BYTES		16
+
+/* Tile size of SGXTQ_MEMLAYOUT_TILED surfaces (EURASIA_TAG_TILE_SIZEX) */
+#define BL_TILE_SIZE				32
+
+/* Largest tile of a hybrid twiddled surface (EURASIA_TAG_NP2TWID_MAXTILEDIM) */
+#define BL_HYBRID_TWIDDLE_MAX_TILE	16
+
+#define BL_MIN(a,b)		(((a) < (b)) ? (a) : (b))
+#define BL_MAX(a,b)		(((a) > (b)) ? (a) : (b))
+
+/* A pixel in the pipeline: linear RGBA, normalised formats in [0, 1] or [-1, 1] */
+typedef struct _BL_FPIXEL_
+{
+	IMG_FLOAT	fR;
+	IMG_FLOAT	fG;
+	IMG_FLOAT	fB;
+	IMG_FLOAT	fA;
+} BL_FPIXEL;
+
+/* How a BL_PIXEL passed to an Init function is to be read */
+typedef enum _BL_INTERNAL_PX_FMT_
+{
+	BL_INTERNAL_PX_FMT_ARGB8888 = 0,	/* ui32ARGB8888 */
+	BL_INTERNAL_PX_FMT_FLOAT			/* sFloat */
+} BL_INTERNAL_PX_FMT;
+
+/*
+	A colour given to an object (fill colour, colour key). Only the member
+	named by the accompanying BL_INTERNAL_PX_FMT is read, so a pointer to an
+	IMG_UINT32 holding an ARGB8888 colour may be passed as a BL_PIXEL *.
+*/
+typedef union _BL_PIXEL_
+{
+	IMG_UINT32	ui32ARGB8888;
+	BL_FPIXEL	sFloat;
+} BL_PIXEL;
+
+/* Surfaces of pixels wider than 32 bits may be stored as planes of 32 bit chunks */
+typedef struct _BL_PLANAR_SURFACE_INFO_
+{
+	IMG_BOOL	bIsPlanar;
+
+	/* Bytes from one plane to the next */
+	IMG_INT32	i32ChunkStride;
+
+	/* Bytes of a pixel held in each plane */
+	IMG_UINT32	uiPixelBytesPerPlane;
+
+	/* Planes */
+	IMG_UINT32	uiNChunks;
+} BL_PLANAR_SURFACE_INFO;
+
+/*
+	Pixel formats
+*/
+typedef enum _BL_CHANNEL_TYPE_
+{
+	BL_CHANNEL_NONE = 0,		/* not converted: the format can only be copied, scaled by point sampling, flipped and rotated */
+	BL_CHANNEL_UNORM,
+	BL_CHANNEL_SNORM,
+	BL_CHANNEL_UINT,
+	BL_CHANNEL_SINT,
+	BL_CHANNEL_FLOAT			/* 32 bit, 16 bit or unsigned 11 and 10 bit floats */
+} BL_CHANNEL_TYPE;
+
+/* R holds luminance, read back into G and B */
+#define BL_PXFMT_FLAG_LUMINANCE		0x00000001U
+
+/* R, G and B are sRGB encoded (8 bit UNORM only) */
+#define BL_PXFMT_FLAG_SRGB			0x00000002U
+
+/* Pixels share chroma with their neighbours (YUV 4:2:2 and 4:2:0): neither converted nor copied */
+#define BL_PXFMT_FLAG_SUBSAMPLED	0x00000004U
+
+#define BL_CHANNEL_R				0
+#define BL_CHANNEL_G				1
+#define BL_CHANNEL_B				2
+#define BL_CHANNEL_A				3
+
+typedef struct _BL_EXTERNAL_PIXEL_FORMAT_
+{
+	/* Bytes per pixel, 0 for formats with no whole pixel per byte (compressed, palettised below 8 bits) */
+	IMG_UINT32		ui32BytesPerPixel;
+
+	BL_CHANNEL_TYPE	eChannelType;
+
+	IMG_UINT32		ui32Flags;
+
+	/*
+		Lowest bit and width of the R, G, B and A channels, counting from
+		the least significant bit of the little endian pixel. A channel
+		with no bits is missing: it reads as 0 (R, G, B) or 1 (A). No
+		channel crosses a 32 bit boundary.
+	*/
+	IMG_UINT8		aui8Shift[4];
+	IMG_UINT8		aui8Bits[4];
+} BL_EXTERNAL_PIXEL_FORMAT;
+
+/* Indexed by PVRSRV_PIXEL_FORMAT */
+extern const BL_EXTERNAL_PIXEL_FORMAT gas_BLExternalPixelTable[PVRSRV_PIXEL_FORMAT_RAW1024 + 1];
+
+/*
+	Pipeline objects
+*/
+typedef struct _BL_OBJECT_ BL_OBJECT;
+
+struct _BL_OBJECT_
+{
+	/*
+		Readies the object to deliver the pixels of psRect, in its own
+		output coordinates; every later span lies inside psRect. When
+		eRawFormat is not PVRSRV_PIXEL_FORMAT_UNKNOWN the caller would
+		like raw pixels of that format through pfnGetRawSpan: the object
+		clears *pbRaw if it can't deliver them, in which case it is asked
+		for BL_FPIXELs through pfnGetSpan. pbRaw may be IMG_NULL when
+		eRawFormat is PVRSRV_PIXEL_FORMAT_UNKNOWN.
+	*/
+	PVRSRV_ERROR	(*pfnPrepare)(BL_OBJECT *psObject, const IMG_RECT *psRect,
+								  PVRSRV_PIXEL_FORMAT eRawFormat, IMG_BOOL *pbRaw);
+
+	/* Delivers ui32Count (at most BL_MAX_SPAN) pixels of row i32Y starting at i32X */
+	IMG_VOID		(*pfnGetSpan)(BL_OBJECT *psObject, IMG_INT32 i32X, IMG_INT32 i32Y,
+								  IMG_UINT32 ui32Count, BL_FPIXEL *psOut);
+
+	IMG_VOID		(*pfnGetRawSpan)(BL_OBJECT *psObject, IMG_INT32 i32X, IMG_INT32 i32Y,
+									 IMG_UINT32 ui32Count, IMG_BYTE *pbyOut);
+
+	/* Runs the blit; destinations only */
+	PVRSRV_ERROR	(*pfnStart)(BL_OBJECT *psObject);
+};
+
+#define BL_OBJECT_START(psObject)	((psObject)->pfnStart(psObject))
+
+/* Room for a span of either kind of pixel */
+typedef union _BL_SPAN_BUFFER_
+{
+	BL_FPIXEL	asPixels[BL_MAX_SPAN];
+	IMG_BYTE	abyRaw[BL_MAX_SPAN * BL_MAX_RAW_PIXEL_BYTES];
+} BL_SPAN_BUFFER;
+
+/*****************************************************************************
+ * Function Name		:	BLCopyPixel
+ * Inputs				:	pbySrc - Pixel (or chunk) to copy.
+ *							ui32Bytes - Its size.
+ * Outputs				:	pbyDst - The copy.
+ * Description			:	Copies a pixel, with a fixed size copy for the
+ *							common sizes.
+ ******************************************************************************/
+static INLINE IMG_VOID BLCopyPixel(IMG_BYTE *pbyDst, const IMG_BYTE *pbySrc, IMG_UINT32 ui32Bytes)
+{
+	switch (ui32Bytes)
+	{
+		case 1:
+		{
+			*pbyDst = *pbySrc;
+			break;
+		}
+		case 2:
+		{
+			memcpy(pbyDst, pbySrc, 2);
+			break;
+		}
+		case 4:
+		{
+			memcpy(pbyDst, pbySrc, 4);
+			break;
+		}
+		case 8:
+		{
+			memcpy(pbyDst, pbySrc, 8);
+			break;
+		}
+		case 16:
+		{
+			memcpy(pbyDst, pbySrc, 16);
+			break;
+		}
+		default:
+		{
+			memcpy(pbyDst, pbySrc, ui32Bytes);
+			break;
+		}
+	}
+}
+
+/*****************************************************************************
+ * Function Name		:	BLObjectGetSpan
+ * Inputs				:	psObject - Object to pull from.
+ *							ui32RawBytes - Bytes per raw pixel, or 0 for
+ *							BL_FPIXELs.
+ *							i32X, i32Y, ui32Count - The span.
+ * Outputs				:	pbyOut - The pixels.
+ * Description			:	Pulls a span of whichever kind of pixel the object
+ *							agreed to deliver in pfnPrepare, for the objects
+ *							which only move pixels around.
+ ******************************************************************************/
+static INLINE IMG_VOID BLObjectGetSpan(BL_OBJECT *psObject, IMG_UINT32 ui32RawBytes,
+									   IMG_INT32 i32X, IMG_INT32 i32Y, IMG_UINT32 ui32Count,
+									   IMG_BYTE *pbyOut)
+{
+	if (ui32RawBytes != 0)
+	{
+		psObject->pfnGetRawSpan(psObject, i32X, i32Y, ui32Count, pbyOut);
+	}
+	else
+	{
+		psObject->pfnGetSpan(psObject, i32X, i32Y, ui32Count, (BL_FPIXEL *)pbyOut);
+	}
+}
+
+/*
+	Surface memory, as seen by the sources and destinations
+*/
+typedef enum _BL_MEMLAYOUT_
+{
+	BL_MEMLAYOUT_LINEAR = 0,
+	BL_MEMLAYOUT_TWIDDLED,
+	BL_MEMLAYOUT_HYBRID_TWIDDLED,
+	BL_MEMLAYOUT_TILED
+} BL_MEMLAYOUT;
+
+typedef struct _BL_SURFACE_
+{
+	BL_MEMLAYOUT		eMemLayout;
+	PVRSRV_PIXEL_FORMAT	ePixelFormat;
+
+	/* Bytes of a whole pixel */
+	IMG_UINT32			ui32BytesPerPixel;
+
+	/* Addressable pixels; pixels read outside them repeat the nearest edge */
+	IMG_UINT32			ui32Width;
+	IMG_UINT32			ui32Height;
+
+	/* Linear and tiled: bytes from one row to the next */
+	IMG_INT32			i32Stride;
+
+	/* Twiddled: log2 of the power of two dimensions */
+	IMG_UINT32			ui32WidthLog2;
+	IMG_UINT32			ui32HeightLog2;
+
+	/* Hybrid twiddled: tile edge and tiles per row */
+	IMG_UINT32			ui32TileSize;
+	IMG_UINT32			ui32TileSizeLog2;
+	IMG_UINT32			ui32TilesPerRow;
+
+	/* A pixel is ui32NumChunks chunks of ui32ChunkBytes, i32ChunkStride bytes apart (1 chunk unless planar) */
+	IMG_UINT32			ui32ChunkBytes;
+	IMG_UINT32			ui32NumChunks;
+	IMG_INT32			i32ChunkStride;
+} BL_SURFACE;
+
+IMG_INTERNAL IMG_BOOL BLFormatIsConvertible(PVRSRV_PIXEL_FORMAT ePixelFormat);
+
+IMG_INTERNAL IMG_BOOL BLFormatIsCopyable(PVRSRV_PIXEL_FORMAT ePixelFormat);
+
+IMG_INTERNAL IMG_VOID BLDecodeSpan(PVRSRV_PIXEL_FORMAT ePixelFormat, const IMG_BYTE *pbyIn,
+								   IMG_UINT32 ui32Count, BL_FPIXEL *psOut);
+
+IMG_INTERNAL IMG_VOID BLEncodeSpan(PVRSRV_PIXEL_FORMAT ePixelFormat, const BL_FPIXEL *psIn,
+								   IMG_UINT32 ui32Count, IMG_BYTE *pbyOut);
+
+IMG_INTERNAL IMG_UINT32 BLFloatToARGB8888(const BL_FPIXEL *psPixel);
+
+IMG_INTERNAL IMG_VOID BLARGB8888ToFloat(IMG_UINT32 ui32ARGB8888, BL_FPIXEL *psPixel);
+
+IMG_INTERNAL IMG_VOID BLPixelToFloat(const BL_PIXEL *psPixel, BL_INTERNAL_PX_FMT eInternalFormat,
+									 BL_FPIXEL *psFloat);
+
+IMG_INTERNAL IMG_VOID BLSurfaceInit(BL_SURFACE *psSurface, BL_MEMLAYOUT eMemLayout,
+									PVRSRV_PIXEL_FORMAT ePixelFormat, IMG_INT32 i32Stride,
+									IMG_UINT32 ui32Width, IMG_UINT32 ui32Height,
+									const BL_PLANAR_SURFACE_INFO *psPlanarInfo);
+
+IMG_INTERNAL IMG_PBYTE BLSurfaceGetRow(const BL_SURFACE *psSurface, IMG_PBYTE pbyFBAddr, IMG_INT32 i32Y);
+
+IMG_INTERNAL IMG_VOID BLSurfaceReadSpan(const BL_SURFACE *psSurface, const IMG_BYTE *pbyFBAddr,
+										IMG_INT32 i32X, IMG_INT32 i32Y, IMG_UINT32 ui32Count,
+										IMG_BYTE *pbyOut);
+
+IMG_INTERNAL IMG_VOID BLSurfaceWriteSpan(const BL_SURFACE *psSurface, IMG_PBYTE pbyFBAddr,
+										 IMG_INT32 i32X, IMG_INT32 i32Y, IMG_UINT32 ui32Count,
+										 const IMG_BYTE *pbyIn);
+
+#endif /* _BLITLIB_H_ */
+
+/******************************************************************************
+ End of file (blitlib.h)
+******************************************************************************/
@@ -0,0 +1,231 @@
+/*!****************************************************************************
+@File           blitlib_dst.c
+
+@Title          Software blit library
+
+@Author         Imagination Technologies
+
+@date           19/10/10
+
+@Copyright      Copyright 2010 by Imagination Technologies Limited.
+                All rights reserved. No part of this software, either
+                material or conceptual may be copied or distributed,
+                transmitted, transcribed, stored in a retrieval system
+                or translated into any human or computer language in any
+                form by any means, electronic, mechanical, manual or
+                other-wise, or disclosed to third parties without the
+                express written permission of Imagination Technologies
+                Limited, Unit 8, HomePark Industrial Estate,
+                King's Langley, Hertfordshire, WD4 8LZ, U.K.
+
+@Platform       Generic
+
+@Description    Blitlib destinations.
+
+@DoxygenVer
+
+******************************************************************************/
+
+/******************************************************************************
+Modifications :-
+
+$Log: blitlib_dst.c $
+
+*****************************************************************************/
+
+#include "blitlib_dst.h"
+
+/*****************************************************************************
+ * Function Name		:	BLDSTSurfaceStart
+ * Inputs				:	psObject - The destination.
+ * Returns				:	PVRSRV_ERROR_NOT_SUPPORTED if the pipeline can't
+ *							produce pixels of the destination format, or an
+ *							error from an upstream object.
+ * Description			:	Writes the part of the clip rectangle inside the
+ *							surface, a span at a time. Raw pixels are asked
+ *							for when the format can be copied; they are pulled
+ *							straight into linear surfaces.
+ ******************************************************************************/
+static PVRSRV_ERROR BLDSTSurfaceStart(BL_OBJECT *psObject)
+{
+	BL_DST_SURFACE *psDst = (BL_DST_SURFACE *)psObject;
+	const BL_SURFACE *psSurface = &psDst->sSurface;
+	PVRSRV_PIXEL_FORMAT ePixelFormat = psSurface->ePixelFormat;
+	IMG_UINT32 ui32BytesPerPixel = psSurface->ui32BytesPerPixel;
+	IMG_RECT sRect = psDst->sClipRect;
+	IMG_RECT sClipped;
+	IMG_BOOL bRaw;
+	IMG_INT32 i32X, i32Y;
+	PVRSRV_ERROR eError;
+
+	if (psDst->pbyFBAddr == IMG_NULL || psDst->psUpstream == IMG_NULL)
+	{
+		return PVRSRV_ERROR_INVALID_PARAMS;
+	}
+
+	sClipped.x0 = (sRect.x0 < 0) ? 0 : sRect.x0;
+	sClipped.y0 = (sRect.y0 < 0) ? 0 : sRect.y0;
+	sClipped.x1 = (sRect.x1 > (IMG_INT32)psSurface->ui32Width) ? (IMG_INT32)psSurface->ui32Width : sRect.x1;
+	sClipped.y1 = (sRect.y1 > (IMG_INT32)psSurface->ui32Height) ? (IMG_INT32)psSurface->ui32Height : sRect.y1;
+
+	if (sClipped.x1 <= sClipped.x0 || sClipped.y1 <= sClipped.y0)
+	{
+		return PVRSRV_OK;
+	}
+
+	bRaw = BLFormatIsCopyable(ePixelFormat);
+
+	eError = psDst->psUpstream->pfnPrepare(psDst->psUpstream, &sRect,
+										   bRaw ? ePixelFormat : PVRSRV_PIXEL_FORMAT_UNKNOWN, &bRaw);
+	if (eError != PVRSRV_OK)
+	{
+		return eError;
+	}
+
+	if (!bRaw && !BLFormatIsConvertible(ePixelFormat))
+	{
+		return PVRSRV_ERROR_NOT_SUPPORTED;
+	}
+
+	for (i32Y = sClipped.y0; i32Y < sClipped.y1; i32Y++)
+	{
+		IMG_PBYTE pbyRow = BLSurfaceGetRow(psSurface, psDst->pbyFBAddr, i32Y);
+
+		for (i32X = sClipped.x0; i32X < sClipped.x1; i32X += BL_MAX_SPAN)
+		{
+			IMG_UINT32 ui32Count = (IMG_UINT32)(sClipped.x1 - i32X);
+			IMG_BYTE *pbyPacked;
+
+			if (ui32Count > BL_MAX_SPAN)
+			{
+				ui32Count = BL_MAX_SPAN;
+			}
+
+			pbyPacked = (pbyRow != IMG_NULL) ? pbyRow + i32X * (IMG_INT32)ui32BytesPerPixel : psDst->abyPacked;
+
+			if (bRaw)
+			{
+				psDst->psUpstream->pfnGetRawSpan(psDst->psUpstream, i32X, i32Y, ui32Count, pbyPacked);
+			}
+			else
+			{
+				psDst->psUpstream->pfnGetSpan(psDst->psUpstream, i32X, i32Y, ui32Count, psDst->sSpan.asPixels);
+				BLEncodeSpan(ePixelFormat, psDst->sSpan.asPixels, ui32Count, pbyPacked);
+			}
+
+			if (pbyRow == IMG_NULL)
+			{
+				BLSurfaceWriteSpan(psSurface, psDst->pbyFBAddr, i32X, i32Y, ui32Count, pbyPacked);
+			}
+		}
+	}
+
+	return PVRSRV_OK;
+}
+
+/*****************************************************************************
+ * Function Name		:	BLDSTSurfaceInit
+ * Inputs				:	See BLSurfaceInit.
+ *							psClipRect - Rectangle to write (copied).
+ *							pbyFBAddr - Surface memory.
+ *							psUpstream - Object to pull pixels from.
+ * Outputs				:	psDst - The destination.
+ ******************************************************************************/
+static IMG_VOID BLDSTSurfaceInit(BL_DST_SURFACE *psDst, BL_MEMLAYOUT eMemLayout,
+								 PVRSRV_PIXEL_FORMAT ePixelFormat, IMG_INT32 i32Stride,
+								 IMG_UINT32 ui32Width, IMG_UINT32 ui32Height,
+								 const IMG_RECT *psClipRect, IMG_PBYTE pbyFBAddr,
+								 BL_OBJECT *psUpstream, const BL_PLANAR_SURFACE_INFO *psPlanarInfo)
+{
+	psDst->sObject.pfnPrepare = IMG_NULL;
+	psDst->sObject.pfnGetSpan = IMG_NULL;
+	psDst->sObject.pfnGetRawSpan = IMG_NULL;
+	psDst->sObject.pfnStart = BLDSTSurfaceStart;
+
+	psDst->psUpstream = psUpstream;
+	psDst->sClipRect = *psClipRect;
+	psDst->pbyFBAddr = pbyFBAddr;
+
+	BLSurfaceInit(&psDst->sSurface, eMemLayout, ePixelFormat, i32Stride, ui32Width, ui32Height, psPlanarInfo);
+}
+
+/*****************************************************************************
+ * Function Name		:	BLDSTLinearInit
+ * Inputs				:	i32Stride - Bytes from one row to the next; the
+ *							surface is as wide as its stride.
+ *							ui32Height - Rows.
+ *							ePixelFormat - Format of the pixels.
+ *							psClipRect - Rectangle to write (copied).
+ *							pbyFBAddr - First row.
+ *							psUpstream - Object to pull pixels from.
+ *							psPlanarInfo - Planes, or IMG_NULL.
+ * Outputs				:	psDst - The destination.
+ ******************************************************************************/
+IMG_INTERNAL IMG_VOID BLDSTLinearInit(BL_DST_LINEAR *psDst,
+									  IMG_INT32 i32Stride,
+									  IMG_UINT32 ui32Height,
+									  PVRSRV_PIXEL_FORMAT ePixelFormat,
+									  const IMG_RECT *psClipRect,
+									  IMG_PBYTE pbyFBAddr,
+									  BL_OBJECT *psUpstream,
+									  const BL_PLANAR_SURFACE_INFO *psPlanarInfo)
+{
+	BLDSTSurfaceInit(psDst, BL_MEMLAYOUT_LINEAR, ePixelFormat, i32Stride, 0, ui32Height,
+					 psClipRect, pbyFBAddr, psUpstream, psPlanarInfo);
+}
+
+/*****************************************************************************
+ * Function Name		:	BLDSTTwiddledInit
+ * Inputs				:	ui32Width, ui32Height - Size in pixels.
+ *							ePixelFormat - Format of the pixels.
+ *							psClipRect - Rectangle to write (copied).
+ *							pbyFBAddr - Surface memory.
+ *							psUpstream - Object to pull pixels from.
+ *							psPlanarInfo - Planes, or IMG_NULL.
+ *							bHybrid - Whether the surface is a row of twiddled
+ *							tiles rather than twiddled as a whole.
+ * Outputs				:	psDst - The destination.
+ ******************************************************************************/
+IMG_INTERNAL IMG_VOID BLDSTTwiddledInit(BL_DST_TWIDDLED *psDst,
+										IMG_UINT32 ui32Width,
+										IMG_UINT32 ui32Height,
+										PVRSRV_PIXEL_FORMAT ePixelFormat,
+										const IMG_RECT *psClipRect,
+										IMG_PBYTE pbyFBAddr,
+										BL_OBJECT *psUpstream,
+										const BL_PLANAR_SURFACE_INFO *psPlanarInfo,
+										IMG_BOOL bHybrid)
+{
+	BLDSTSurfaceInit(psDst, bHybrid ? BL_MEMLAYOUT_HYBRID_TWIDDLED : BL_MEMLAYOUT_TWIDDLED,
+					 ePixelFormat, 0, ui32Width, ui32Height,
+					 psClipRect, pbyFBAddr, psUpstream, psPlanarInfo);
+}
+
+/*****************************************************************************
+ * Function Name		:	BLDSTTiledInit
+ * Inputs				:	i32Stride - Bytes from one row of pixels to the
+ *							next, as for a linear surface.
+ *							ui32Height - Rows.
+ *							ePixelFormat - Format of the pixels.
+ *							psClipRect - Rectangle to write (copied).
+ *							pbyFBAddr - Surface memory.
+ *							psUpstream - Object to pull pixels from.
+ *							psPlanarInfo - Planes, or IMG_NULL.
+ * Outputs				:	psDst - The destination.
+ ******************************************************************************/
+IMG_INTERNAL IMG_VOID BLDSTTiledInit(BL_DST_TILED *psDst,
+									 IMG_INT32 i32Stride,
+									 IMG_UINT32 ui32Height,
+									 PVRSRV_PIXEL_FORMAT ePixelFormat,
+									 const IMG_RECT *psClipRect,
+									 IMG_PBYTE pbyFBAddr,
+									 BL_OBJECT *psUpstream,
+									 const BL_PLANAR_SURFACE_INFO *psPlanarInfo)
+{
+	BLDSTSurfaceInit(psDst, BL_MEMLAYOUT_TILED, ePixelFormat, i32Stride, 0, ui32Height,
+					 psClipRect, pbyFBAddr, psUpstream, psPlanarInfo);
+}
+
+/******************************************************************************
+ End of file (blitlib_dst.c)
+******************************************************************************/
@@ -0,0 +1,106 @@
+/*!****************************************************************************
+@File           blitlib_dst.h
+
+@Title          Software blit library
+
+@Author         Imagination Technologies
+
+@date           19/10/10
+
+@Copyright      Copyright 2010 by Imagination Technologies Limited.
+                All rights reserved. No part of this software, either
+                material or conceptual may be copied or distributed,
+                transmitted, transcribed, stored in a retrieval system
+                or translated into any human or computer language in any
+                form by any means, electronic, mechanical, manual or
+                other-wise, or disclosed to third parties without the
+                express written permission of Imagination Technologies
+                Limited, Unit 8, HomePark Industrial Estate,
+                King's Langley, Hertfordshire, WD4 8LZ, U.K.
+
+@Platform       Generic
+
+@Description    Blitlib destinations: surfaces in memory which, when started,
+                fill their clip rectangle with pixels pulled from upstream.
+
+@DoxygenVer
+
+******************************************************************************/
+
+/******************************************************************************
+Modifications :-
+
+$Log: blitlib_dst.h $
+
+*****************************************************************************/
+
+#ifndef _BLITLIB_DST_H_
+#define _BLITLIB_DST_H_
+
+#include "blitlib.h"
+
+/*
+	sClipRect, in the coordinates of the surface, is prepared upstream
+	as it is and then clipped to the surface, so changing it between starts
+	writes another part of the same blit (as clip blits do).
+*/
+typedef struct _BL_DST_SURFACE_
+{
+	BL_OBJECT		sObject;
+	BL_OBJECT		*psUpstream;
+
+	IMG_RECT		sClipRect;
+
+	IMG_PBYTE		pbyFBAddr;
+
+	BL_SURFACE		sSurface;
+
+	/* Pixels of the span being written, before and after conversion */
+	BL_SPAN_BUFFER	sSpan;
+	IMG_BYTE		abyPacked[BL_MAX_SPAN * BL_MAX_RAW_PIXEL_BYTES];
+} BL_DST_SURFACE;
+
+typedef BL_DST_SURFACE BL_DST_LINEAR;
+typedef BL_DST_SURFACE BL_DST_TWIDDLED;
+typedef BL_DST_SURFACE BL_DST_TILED;
+
+typedef union _BL_DST_
+{
+	BL_DST_LINEAR	linear;
+	BL_DST_TWIDDLED	twiddled;
+	BL_DST_TILED	tiled;
+} BL_DST;
+
+IMG_INTERNAL IMG_VOID BLDSTLinearInit(BL_DST_LINEAR *psDst,
+									  IMG_INT32 i32Stride,
+									  IMG_UINT32 ui32Height,
+									  PVRSRV_PIXEL_FORMAT ePixelFormat,
+									  const IMG_RECT *psClipRect,
+									  IMG_PBYTE pbyFBAddr,
+									  BL_OBJECT *psUpstream,
+									  const BL_PLANAR_SURFACE_INFO *psPlanarInfo);
+
+IMG_INTERNAL IMG_VOID BLDSTTwiddledInit(BL_DST_TWIDDLED *psDst,
+										IMG_UINT32 ui32Width,
+										IMG_UINT32 ui32Height,
+										PVRSRV_PIXEL_FORMAT ePixelFormat,
+										const IMG_RECT *psClipRect,
+										IMG_PBYTE pbyFBAddr,
+										BL_OBJECT *psUpstream,
+										const BL_PLANAR_SURFACE_INFO *psPlanarInfo,
+										IMG_BOOL bHybrid);
+
+IMG_INTERNAL IMG_VOID BLDSTTiledInit(BL_DST_TILED *psDst,
+									 IMG_INT32 i32Stride,
+									 IMG_UINT32 ui32Height,
+									 PVRSRV_PIXEL_FORMAT ePixelFormat,
+									 const IMG_RECT *psClipRect,
+									 IMG_PBYTE pbyFBAddr,
+									 BL_OBJECT *psUpstream,
+									 const BL_PLANAR_SURFACE_INFO *psPlanarInfo);
+
+#endif /* _BLITLIB_DST_H_ */
+
+/******************************************************************************
+ End of file (blitlib_dst.h)
+******************************************************************************/
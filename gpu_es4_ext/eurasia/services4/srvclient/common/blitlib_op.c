@@ -0,0 +1,716 @@
+/*!****************************************************************************
+@File           blitlib_op.c
+
+@Title          Software blit library
+
+@Author         Imagination Technologies
+
+@date           19/10/10
+
+@Copyright      Copyright 2010 by Imagination Technologies Limited.
+                All rights reserved. No part of this software, either
+                material or conceptual may be copied or distributed,
+                transmitted, transcribed, stored in a retrieval system
+                or translated into any human or computer language in any
+                form by any means, electronic, mechanical, manual or
+                other-wise, or disclosed to third parties without the
+                express written permission of Imagination Technologies
+                Limited, Unit 8, HomePark Industrial Estate,
+                King's Langley, Hertfordshire, WD4 8LZ, U.K.
+
+@Platform       Generic
+
+@Description    Blitlib operations.
+
+@DoxygenVer
+
+******************************************************************************/
+
+/******************************************************************************
+Modifications :-
+
+$Log: blitlib_op.c $
+
+*****************************************************************************/
+
+#include <math.h>
+
+#include "blitlib_op.h"
+
+/*****************************************************************************
+ * Function Name		:	BLOPGetRawBytes
+ * Inputs				:	eRawFormat, bRaw - As settled by pfnPrepare.
+ * Returns				:	Bytes per raw pixel passing through an object, or
+ *							0 when BL_FPIXELs pass through it.
+ ******************************************************************************/
+static INLINE IMG_UINT32 BLOPGetRawBytes(PVRSRV_PIXEL_FORMAT eRawFormat, IMG_BOOL bRaw)
+{
+	if (eRawFormat == PVRSRV_PIXEL_FORMAT_UNKNOWN || !bRaw)
+	{
+		return 0;
+	}
+
+	return gas_BLExternalPixelTable[eRawFormat].ui32BytesPerPixel;
+}
+
+/*****************************************************************************
+ * Function Name		:	BLOPPrepareFloat
+ * Inputs				:	psFront, psBack - Upstream objects of an operation
+ *							which works on BL_FPIXELs.
+ *							psRect - Rectangle to prepare them for.
+ *							eRawFormat - Format the caller would like.
+ * Outputs				:	pbRaw - Cleared: raw pixels are never delivered.
+ ******************************************************************************/
+static PVRSRV_ERROR BLOPPrepareFloat(BL_OBJECT *psFront, BL_OBJECT *psBack, const IMG_RECT *psRect,
+									 PVRSRV_PIXEL_FORMAT eRawFormat, IMG_BOOL *pbRaw)
+{
+	PVRSRV_ERROR eError;
+
+	if (eRawFormat != PVRSRV_PIXEL_FORMAT_UNKNOWN)
+	{
+		*pbRaw = IMG_FALSE;
+	}
+
+	if (psFront == IMG_NULL || psBack == IMG_NULL)
+	{
+		return PVRSRV_ERROR_INVALID_PARAMS;
+	}
+
+	eError = psFront->pfnPrepare(psFront, psRect, PVRSRV_PIXEL_FORMAT_UNKNOWN, IMG_NULL);
+	if (eError != PVRSRV_OK)
+	{
+		return eError;
+	}
+
+	return psBack->pfnPrepare(psBack, psRect, PVRSRV_PIXEL_FORMAT_UNKNOWN, IMG_NULL);
+}
+
+/*****************************************************************************
+ * Function Name		:	BLOPScaleCheckRects
+ * Inputs				:	psRect, psUpstreamRect - The rectangles a scale maps
+ *							between.
+ * Returns				:	PVRSRV_ERROR_INVALID_PARAMS if either is empty.
+ ******************************************************************************/
+static PVRSRV_ERROR BLOPScaleCheckRects(const IMG_RECT *psRect, const IMG_RECT *psUpstreamRect)
+{
+	if (psRect->x1 <= psRect->x0 || psRect->y1 <= psRect->y0 ||
+		psUpstreamRect->x1 <= psUpstreamRect->x0 || psUpstreamRect->y1 <= psUpstreamRect->y0)
+	{
+		return PVRSRV_ERROR_INVALID_PARAMS;
+	}
+
+	return PVRSRV_OK;
+}
+
+/*****************************************************************************
+ * Function Name		:	BLOPScaleNearestMap
+ * Inputs				:	i32D - Coordinate in the rectangle prepared.
+ *							i32D0, i32DSize - Its start and size there.
+ *							i32U0, i32USize - Start and size upstream.
+ * Returns				:	The upstream pixel whose centre is nearest to the
+ *							centre of pixel i32D.
+ ******************************************************************************/
+static INLINE IMG_INT32 BLOPScaleNearestMap(IMG_INT32 i32D, IMG_INT32 i32D0, IMG_INT32 i32DSize,
+											IMG_INT32 i32U0, IMG_INT32 i32USize)
+{
+	return i32U0 + (IMG_INT32)(((IMG_INT64)(2 * (i32D - i32D0) + 1) * i32USize) / (2 * (IMG_INT64)i32DSize));
+}
+
+/*****************************************************************************
+ * Function Name		:	BLOPScaleNearestPrepare
+ ******************************************************************************/
+static PVRSRV_ERROR BLOPScaleNearestPrepare(BL_OBJECT *psObject, const IMG_RECT *psRect,
+											PVRSRV_PIXEL_FORMAT eRawFormat, IMG_BOOL *pbRaw)
+{
+	BL_OP_SCALE_NEAREST *psOp = (BL_OP_SCALE_NEAREST *)psObject;
+	PVRSRV_ERROR eError;
+
+	eError = BLOPScaleCheckRects(psRect, &psOp->sUpstreamClipRect);
+	if (eError != PVRSRV_OK)
+	{
+		return eError;
+	}
+
+	psOp->sRect = *psRect;
+
+	eError = psOp->psUpstream->pfnPrepare(psOp->psUpstream, &psOp->sUpstreamClipRect, eRawFormat, pbRaw);
+
+	psOp->ui32RawBytes = BLOPGetRawBytes(eRawFormat, (pbRaw != IMG_NULL) ? *pbRaw : IMG_FALSE);
+
+	return eError;
+}
+
+/*****************************************************************************
+ * Function Name		:	BLOPScaleNearestFetch
+ * Inputs				:	psOp - The scale.
+ *							i32X, i32Y, ui32Count - The span.
+ * Outputs				:	pbyOut - The pixels, raw or BL_FPIXELs.
+ * Description			:	Pulls each run of upstream pixels spanned by the
+ *							output (at most BL_MAX_SPAN wide) and picks the
+ *							nearest pixels out of it.
+ ******************************************************************************/
+static IMG_VOID BLOPScaleNearestFetch(BL_OP_SCALE_NEAREST *psOp, IMG_INT32 i32X, IMG_INT32 i32Y,
+									  IMG_UINT32 ui32Count, IMG_BYTE *pbyOut)
+{
+	const IMG_RECT *psRect = &psOp->sRect;
+	const IMG_RECT *psUpstreamRect = &psOp->sUpstreamClipRect;
+	IMG_UINT32 ui32PixelBytes = psOp->ui32RawBytes ? psOp->ui32RawBytes : sizeof(BL_FPIXEL);
+	IMG_INT32 ai32Map[BL_MAX_SPAN];
+	IMG_INT32 i32UpstreamY;
+	IMG_UINT32 i, j, k;
+
+	i32UpstreamY = BLOPScaleNearestMap(i32Y, psRect->y0, psRect->y1 - psRect->y0,
+									   psUpstreamRect->y0, psUpstreamRect->y1 - psUpstreamRect->y0);
+
+	for (i = 0; i < ui32Count; i++)
+	{
+		ai32Map[i] = BLOPScaleNearestMap(i32X + (IMG_INT32)i, psRect->x0, psRect->x1 - psRect->x0,
+										 psUpstreamRect->x0, psUpstreamRect->x1 - psUpstreamRect->x0);
+	}
+
+	for (i = 0; i < ui32Count; i = j)
+	{
+		IMG_INT32 i32Base = ai32Map[i];
+
+		for (j = i + 1; j < ui32Count && ai32Map[j] - i32Base < BL_MAX_SPAN; j++);
+
+		BLObjectGetSpan(psOp->psUpstream, psOp->ui32RawBytes, i32Base, i32UpstreamY,
+						(IMG_UINT32)(ai32Map[j - 1] - i32Base + 1), psOp->sBuffer.abyRaw);
+
+		for (k = i; k < j; k++)
+		{
+			BLCopyPixel(pbyOut + k * ui32PixelBytes,
+						psOp->sBuffer.abyRaw + (IMG_UINT32)(ai32Map[k] - i32Base) * ui32PixelBytes,
+						ui32PixelBytes);
+		}
+	}
+}
+
+static IMG_VOID BLOPScaleNearestGetSpan(BL_OBJECT *psObject, IMG_INT32 i32X, IMG_INT32 i32Y,
+										IMG_UINT32 ui32Count, BL_FPIXEL *psOut)
+{
+	BLOPScaleNearestFetch((BL_OP_SCALE_NEAREST *)psObject, i32X, i32Y, ui32Count, (IMG_BYTE *)psOut);
+}
+
+static IMG_VOID BLOPScaleNearestGetRawSpan(BL_OBJECT *psObject, IMG_INT32 i32X, IMG_INT32 i32Y,
+										   IMG_UINT32 ui32Count, IMG_BYTE *pbyOut)
+{
+	BLOPScaleNearestFetch((BL_OP_SCALE_NEAREST *)psObject, i32X, i32Y, ui32Count, pbyOut);
+}
+
+/*****************************************************************************
+ * Function Name		:	BLOPScaleNearestInit
+ * Inputs				:	psUpstreamClipRect - Upstream rectangle to scale
+ *							(copied).
+ *							psUpstream - Object to scale.
+ * Outputs				:	psOp - The operation.
+ ******************************************************************************/
+IMG_INTERNAL IMG_VOID BLOPScaleNearestInit(BL_OP_SCALE_NEAREST *psOp,
+										   const IMG_RECT *psUpstreamClipRect,
+										   BL_OBJECT *psUpstream)
+{
+	psOp->sObject.pfnPrepare = BLOPScaleNearestPrepare;
+	psOp->sObject.pfnGetSpan = BLOPScaleNearestGetSpan;
+	psOp->sObject.pfnGetRawSpan = BLOPScaleNearestGetRawSpan;
+	psOp->sObject.pfnStart = IMG_NULL;
+
+	psOp->psUpstream = psUpstream;
+	psOp->sUpstreamClipRect = *psUpstreamClipRect;
+	psOp->ui32RawBytes = 0;
+}
+
+/*****************************************************************************
+ * Function Name		:	BLOPScaleBilinearMap
+ * Inputs				:	i32D - Coordinate in the rectangle prepared.
+ *							i32D0, i32DSize - Its start and size there.
+ *							i32U0, i32USize - Start and size upstream.
+ * Outputs				:	pi32First, pi32Second - The two upstream pixels
+ *							around the centre of pixel i32D, clamped to the
+ *							upstream rectangle.
+ *							pfWeight - Weight of the second.
+ ******************************************************************************/
+static INLINE IMG_VOID BLOPScaleBilinearMap(IMG_INT32 i32D, IMG_INT32 i32D0, IMG_INT32 i32DSize,
+											IMG_INT32 i32U0, IMG_INT32 i32USize,
+											IMG_INT32 *pi32First, IMG_INT32 *pi32Second, IMG_FLOAT *pfWeight)
+{
+	IMG_DOUBLE dfU = ((IMG_DOUBLE)(i32D - i32D0) + 0.5) * (IMG_DOUBLE)i32USize / (IMG_DOUBLE)i32DSize - 0.5;
+	IMG_DOUBLE dfFloor = floor(dfU);
+	IMG_INT32 i32First = (IMG_INT32)dfFloor;
+	IMG_INT32 i32Second = i32First + 1;
+
+	*pfWeight = (IMG_FLOAT)(dfU - dfFloor);
+
+	i32First = (i32First < 0) ? 0 : ((i32First >= i32USize) ? i32USize - 1 : i32First);
+	i32Second = (i32Second >= i32USize) ? i32USize - 1 : i32Second;
+
+	*pi32First = i32U0 + i32First;
+	*pi32Second = i32U0 + i32Second;
+}
+
+/*****************************************************************************
+ * Function Name		:	BLOPScaleBilinearPrepare
+ ******************************************************************************/
+static PVRSRV_ERROR BLOPScaleBilinearPrepare(BL_OBJECT *psObject, const IMG_RECT *psRect,
+											 PVRSRV_PIXEL_FORMAT eRawFormat, IMG_BOOL *pbRaw)
+{
+	BL_OP_SCALE_BILINEAR *psOp = (BL_OP_SCALE_BILINEAR *)psObject;
+	PVRSRV_ERROR eError;
+
+	if (eRawFormat != PVRSRV_PIXEL_FORMAT_UNKNOWN)
+	{
+		*pbRaw = IMG_FALSE;
+	}
+
+	eError = BLOPScaleCheckRects(psRect, &psOp->sUpstreamClipRect);
+	if (eError != PVRSRV_OK)
+	{
+		return eError;
+	}
+
+	psOp->sRect = *psRect;
+
+	return psOp->psUpstream->pfnPrepare(psOp->psUpstream, &psOp->sUpstreamClipRect,
+										PVRSRV_PIXEL_FORMAT_UNKNOWN, IMG_NULL);
+}
+
+/*****************************************************************************
+ * Function Name		:	BLOPScaleBilinearGetSpan
+ * Description			:	Pulls the two upstream rows around the output row,
+ *							a run of at most BL_MAX_SPAN pixels at a time, and
+ *							filters them.
+ ******************************************************************************/
+static IMG_VOID BLOPScaleBilinearGetSpan(BL_OBJECT *psObject, IMG_INT32 i32X, IMG_INT32 i32Y,
+										 IMG_UINT32 ui32Count, BL_FPIXEL *psOut)
+{
+	BL_OP_SCALE_BILINEAR *psOp = (BL_OP_SCALE_BILINEAR *)psObject;
+	const IMG_RECT *psRect = &psOp->sRect;
+	const IMG_RECT *psUpstreamRect = &psOp->sUpstreamClipRect;
+	IMG_INT32 ai32Left[BL_MAX_SPAN], ai32Right[BL_MAX_SPAN];
+	IMG_FLOAT afWeightX[BL_MAX_SPAN];
+	IMG_INT32 i32Top, i32Bottom;
+	IMG_FLOAT fWeightY;
+	IMG_BOOL bTwoRows;
+	IMG_UINT32 i, j, k;
+
+	BLOPScaleBilinearMap(i32Y, psRect->y0, psRect->y1 - psRect->y0,
+						 psUpstreamRect->y0, psUpstreamRect->y1 - psUpstreamRect->y0,
+						 &i32Top, &i32Bottom, &fWeightY);
+
+	bTwoRows = (i32Bottom != i32Top && fWeightY != 0.0f) ? IMG_TRUE : IMG_FALSE;
+
+	for (i = 0; i < ui32Count; i++)
+	{
+		BLOPScaleBilinearMap(i32X + (IMG_INT32)i, psRect->x0, psRect->x1 - psRect->x0,
+							 psUpstreamRect->x0, psUpstreamRect->x1 - psUpstreamRect->x0,
+							 &ai32Left[i], &ai32Right[i], &afWeightX[i]);
+	}
+
+	for (i = 0; i < ui32Count; i = j)
+	{
+		IMG_INT32 i32Base = ai32Left[i];
+		IMG_UINT32 ui32Fetch;
+		const BL_FPIXEL *psTop = psOp->asRows[0].asPixels;
+		const BL_FPIXEL *psBottom = bTwoRows ? psOp->asRows[1].asPixels : psTop;
+
+		for (j = i + 1; j < ui32Count && ai32Right[j] - i32Base < BL_MAX_SPAN; j++);
+
+		ui32Fetch = (IMG_UINT32)(ai32Right[j - 1] - i32Base + 1);
+
+		psOp->psUpstream->pfnGetSpan(psOp->psUpstream, i32Base, i32Top, ui32Fetch, psOp->asRows[0].asPixels);
+
+		if (bTwoRows)
+		{
+			psOp->psUpstream->pfnGetSpan(psOp->psUpstream, i32Base, i32Bottom, ui32Fetch, psOp->asRows[1].asPixels);
+		}
+
+		for (k = i; k < j; k++)
+		{
+			const BL_FPIXEL *psTL = &psTop[ai32Left[k] - i32Base];
+			const BL_FPIXEL *psTR = &psTop[ai32Right[k] - i32Base];
+			const BL_FPIXEL *psBL = &psBottom[ai32Left[k] - i32Base];
+			const BL_FPIXEL *psBR = &psBottom[ai32Right[k] - i32Base];
+			IMG_FLOAT fWX = afWeightX[k];
+			IMG_FLOAT fTopR = psTL->fR + (psTR->fR - psTL->fR) * fWX;
+			IMG_FLOAT fTopG = psTL->fG + (psTR->fG - psTL->fG) * fWX;
+			IMG_FLOAT fTopB = psTL->fB + (psTR->fB - psTL->fB) * fWX;
+			IMG_FLOAT fTopA = psTL->fA + (psTR->fA - psTL->fA) * fWX;
+			IMG_FLOAT fBottomR = psBL->fR + (psBR->fR - psBL->fR) * fWX;
+			IMG_FLOAT fBottomG = psBL->fG + (psBR->fG - psBL->fG) * fWX;
+			IMG_FLOAT fBottomB = psBL->fB + (psBR->fB - psBL->fB) * fWX;
+			IMG_FLOAT fBottomA = psBL->fA + (psBR->fA - psBL->fA) * fWX;
+
+			psOut[k].fR = fTopR + (fBottomR - fTopR) * fWeightY;
+			psOut[k].fG = fTopG + (fBottomG - fTopG) * fWeightY;
+			psOut[k].fB = fTopB + (fBottomB - fTopB) * fWeightY;
+			psOut[k].fA = fTopA + (fBottomA - fTopA) * fWeightY;
+		}
+	}
+}
+
+/*****************************************************************************
+ * Function Name		:	BLOPScaleBilinearInit
+ * Inputs				:	psUpstreamClipRect - Upstream rectangle to scale
+ *							(copied).
+ *							psUpstream - Object to scale.
+ * Outputs				:	psOp - The operation.
+ ******************************************************************************/
+IMG_INTERNAL IMG_VOID BLOPScaleBilinearInit(BL_OP_SCALE_BILINEAR *psOp,
+											const IMG_RECT *psUpstreamClipRect,
+											BL_OBJECT *psUpstream)
+{
+	psOp->sObject.pfnPrepare = BLOPScaleBilinearPrepare;
+	psOp->sObject.pfnGetSpan = BLOPScaleBilinearGetSpan;
+	psOp->sObject.pfnGetRawSpan = IMG_NULL;
+	psOp->sObject.pfnStart = IMG_NULL;
+
+	psOp->psUpstream = psUpstream;
+	psOp->sUpstreamClipRect = *psUpstreamClipRect;
+}
+
+/*****************************************************************************
+ * Function Name		:	BLOPReverse
+ * Inputs				:	pbyIn - ui32Count pixels of ui32PixelBytes.
+ * Outputs				:	pbyOut - The pixels in reverse order.
+ ******************************************************************************/
+static INLINE IMG_VOID BLOPReverse(IMG_BYTE *pbyOut, const IMG_BYTE *pbyIn, IMG_UINT32 ui32Count,
+								   IMG_UINT32 ui32PixelBytes)
+{
+	IMG_UINT32 i;
+
+	for (i = 0; i < ui32Count; i++)
+	{
+		BLCopyPixel(pbyOut + i * ui32PixelBytes, pbyIn + (ui32Count - 1 - i) * ui32PixelBytes, ui32PixelBytes);
+	}
+}
+
+/*****************************************************************************
+ * Function Name		:	BLOPFlipPrepare
+ ******************************************************************************/
+static PVRSRV_ERROR BLOPFlipPrepare(BL_OBJECT *psObject, const IMG_RECT *psRect,
+									PVRSRV_PIXEL_FORMAT eRawFormat, IMG_BOOL *pbRaw)
+{
+	BL_OP_FLIP *psOp = (BL_OP_FLIP *)psObject;
+	PVRSRV_ERROR eError;
+
+	psOp->sRect = *psRect;
+
+	eError = psOp->psUpstream->pfnPrepare(psOp->psUpstream, psRect, eRawFormat, pbRaw);
+
+	psOp->ui32RawBytes = BLOPGetRawBytes(eRawFormat, (pbRaw != IMG_NULL) ? *pbRaw : IMG_FALSE);
+
+	return eError;
+}
+
+/*****************************************************************************
+ * Function Name		:	BLOPFlipFetch
+ * Inputs				:	psOp - The flip.
+ *							i32X, i32Y, ui32Count - The span.
+ * Outputs				:	pbyOut - The pixels, raw or BL_FPIXELs.
+ ******************************************************************************/
+static IMG_VOID BLOPFlipFetch(BL_OP_FLIP *psOp, IMG_INT32 i32X, IMG_INT32 i32Y,
+							  IMG_UINT32 ui32Count, IMG_BYTE *pbyOut)
+{
+	const IMG_RECT *psRect = &psOp->sRect;
+
+	if (psOp->ui32Flags & BL_OP_FLIP_Y)
+	{
+		i32Y = psRect->y0 + psRect->y1 - 1 - i32Y;
+	}
+
+	if (psOp->ui32Flags & BL_OP_FLIP_X)
+	{
+		IMG_UINT32 ui32PixelBytes = psOp->ui32RawBytes ? psOp->ui32RawBytes : sizeof(BL_FPIXEL);
+
+		BLObjectGetSpan(psOp->psUpstream, psOp->ui32RawBytes,
+						psRect->x0 + psRect->x1 - (i32X + (IMG_INT32)ui32Count), i32Y, ui32Count,
+						psOp->sBuffer.abyRaw);
+
+		BLOPReverse(pbyOut, psOp->sBuffer.abyRaw, ui32Count, ui32PixelBytes);
+	}
+	else
+	{
+		BLObjectGetSpan(psOp->psUpstream, psOp->ui32RawBytes, i32X, i32Y, ui32Count, pbyOut);
+	}
+}
+
+static IMG_VOID BLOPFlipGetSpan(BL_OBJECT *psObject, IMG_INT32 i32X, IMG_INT32 i32Y,
+								IMG_UINT32 ui32Count, BL_FPIXEL *psOut)
+{
+	BLOPFlipFetch((BL_OP_FLIP *)psObject, i32X, i32Y, ui32Count, (IMG_BYTE *)psOut);
+}
+
+static IMG_VOID BLOPFlipGetRawSpan(BL_OBJECT *psObject, IMG_INT32 i32X, IMG_INT32 i32Y,
+								   IMG_UINT32 ui32Count, IMG_BYTE *pbyOut)
+{
+	BLOPFlipFetch((BL_OP_FLIP *)psObject, i32X, i32Y, ui32Count, pbyOut);
+}
+
+/*****************************************************************************
+ * Function Name		:	BLOPFlipInit
+ * Inputs				:	ui32Flags - BL_OP_FLIP_X and/or BL_OP_FLIP_Y.
+ *							psUpstream - Object to flip.
+ * Outputs				:	psOp - The operation.
+ ******************************************************************************/
+IMG_INTERNAL IMG_VOID BLOPFlipInit(BL_OP_FLIP *psOp,
+								   IMG_UINT32 ui32Flags,
+								   BL_OBJECT *psUpstream)
+{
+	psOp->sObject.pfnPrepare = BLOPFlipPrepare;
+	psOp->sObject.pfnGetSpan = BLOPFlipGetSpan;
+	psOp->sObject.pfnGetRawSpan = BLOPFlipGetRawSpan;
+	psOp->sObject.pfnStart = IMG_NULL;
+
+	psOp->psUpstream = psUpstream;
+	psOp->ui32Flags = ui32Flags;
+	psOp->ui32RawBytes = 0;
+}
+
+/*****************************************************************************
+ * Function Name		:	BLOPRotatePrepare
+ ******************************************************************************/
+static PVRSRV_ERROR BLOPRotatePrepare(BL_OBJECT *psObject, const IMG_RECT *psRect,
+									  PVRSRV_PIXEL_FORMAT eRawFormat, IMG_BOOL *pbRaw)
+{
+	BL_OP_ROTATE *psOp = (BL_OP_ROTATE *)psObject;
+	IMG_RECT sUpstreamRect = *psRect;
+	PVRSRV_ERROR eError;
+
+	psOp->sRect = *psRect;
+
+	if (psOp->ui32Rotation == BL_OP_ROTATE_90 || psOp->ui32Rotation == BL_OP_ROTATE_270)
+	{
+		sUpstreamRect.x1 = psRect->x0 + (psRect->y1 - psRect->y0);
+		sUpstreamRect.y1 = psRect->y0 + (psRect->x1 - psRect->x0);
+	}
+
+	eError = psOp->psUpstream->pfnPrepare(psOp->psUpstream, &sUpstreamRect, eRawFormat, pbRaw);
+
+	psOp->ui32RawBytes = BLOPGetRawBytes(eRawFormat, (pbRaw != IMG_NULL) ? *pbRaw : IMG_FALSE);
+
+	return eError;
+}
+
+/*****************************************************************************
+ * Function Name		:	BLOPRotateFetch
+ * Inputs				:	psOp - The rotation.
+ *							i32X, i32Y, ui32Count - The span.
+ * Outputs				:	pbyOut - The pixels, raw or BL_FPIXELs.
+ * Description			:	A row of a quarter turn is a column upstream, which
+ *							is pulled a pixel at a time.
+ ******************************************************************************/
+static IMG_VOID BLOPRotateFetch(BL_OP_ROTATE *psOp, IMG_INT32 i32X, IMG_INT32 i32Y,
+								IMG_UINT32 ui32Count, IMG_BYTE *pbyOut)
+{
+	const IMG_RECT *psRect = &psOp->sRect;
+	IMG_UINT32 ui32PixelBytes = psOp->ui32RawBytes ? psOp->ui32RawBytes : sizeof(BL_FPIXEL);
+	IMG_UINT32 i;
+
+	switch (psOp->ui32Rotation)
+	{
+		case BL_OP_ROTATE_90:
+		{
+			/* Upstream column x0 + (y - y0), bottom to top */
+			IMG_INT32 i32UpstreamX = psRect->x0 + (i32Y - psRect->y0);
+			IMG_INT32 i32UpstreamY = psRect->y0 + (psRect->x1 - 1 - i32X);
+
+			for (i = 0; i < ui32Count; i++)
+			{
+				BLObjectGetSpan(psOp->psUpstream, psOp->ui32RawBytes, i32UpstreamX, i32UpstreamY - (IMG_INT32)i, 1,
+								pbyOut + i * ui32PixelBytes);
+			}
+			break;
+		}
+		case BL_OP_ROTATE_270:
+		{
+			/* Upstream column x0 + (y1 - 1 - y), top to bottom */
+			IMG_INT32 i32UpstreamX = psRect->x0 + (psRect->y1 - 1 - i32Y);
+			IMG_INT32 i32UpstreamY = psRect->y0 + (i32X - psRect->x0);
+
+			for (i = 0; i < ui32Count; i++)
+			{
+				BLObjectGetSpan(psOp->psUpstream, psOp->ui32RawBytes, i32UpstreamX, i32UpstreamY + (IMG_INT32)i, 1,
+								pbyOut + i * ui32PixelBytes);
+			}
+			break;
+		}
+		case BL_OP_ROTATE_180:
+		{
+			BLObjectGetSpan(psOp->psUpstream, psOp->ui32RawBytes,
+							psRect->x0 + psRect->x1 - (i32X + (IMG_INT32)ui32Count),
+							psRect->y0 + psRect->y1 - 1 - i32Y,
+							ui32Count, psOp->sBuffer.abyRaw);
+
+			BLOPReverse(pbyOut, psOp->sBuffer.abyRaw, ui32Count, ui32PixelBytes);
+			break;
+		}
+		default:
+		{
+			BLObjectGetSpan(psOp->psUpstream, psOp->ui32RawBytes, i32X, i32Y, ui32Count, pbyOut);
+			break;
+		}
+	}
+}
+
+static IMG_VOID BLOPRotateGetSpan(BL_OBJECT *psObject, IMG_INT32 i32X, IMG_INT32 i32Y,
+								  IMG_UINT32 ui32Count, BL_FPIXEL *psOut)
+{
+	BLOPRotateFetch((BL_OP_ROTATE *)psObject, i32X, i32Y, ui32Count, (IMG_BYTE *)psOut);
+}
+
+static IMG_VOID BLOPRotateGetRawSpan(BL_OBJECT *psObject, IMG_INT32 i32X, IMG_INT32 i32Y,
+									 IMG_UINT32 ui32Count, IMG_BYTE *pbyOut)
+{
+	BLOPRotateFetch((BL_OP_ROTATE *)psObject, i32X, i32Y, ui32Count, pbyOut);
+}
+
+/*****************************************************************************
+ * Function Name		:	BLOPRotateInit
+ * Inputs				:	ui32Rotation - BL_OP_ROTATE_xxx (an SGXTQ_ROTATION).
+ *							psUpstream - Object to rotate.
+ * Outputs				:	psOp - The operation.
+ ******************************************************************************/
+IMG_INTERNAL IMG_VOID BLOPRotateInit(BL_OP_ROTATE *psOp,
+									 IMG_UINT32 ui32Rotation,
+									 BL_OBJECT *psUpstream)
+{
+	psOp->sObject.pfnPrepare = BLOPRotatePrepare;
+	psOp->sObject.pfnGetSpan = BLOPRotateGetSpan;
+	psOp->sObject.pfnGetRawSpan = BLOPRotateGetRawSpan;
+	psOp->sObject.pfnStart = IMG_NULL;
+
+	psOp->psUpstream = psUpstream;
+	psOp->ui32Rotation = ui32Rotation;
+	psOp->ui32RawBytes = 0;
+}
+
+/*****************************************************************************
+ * Function Name		:	BLOPAlphaBlendPrepare
+ ******************************************************************************/
+static PVRSRV_ERROR BLOPAlphaBlendPrepare(BL_OBJECT *psObject, const IMG_RECT *psRect,
+										  PVRSRV_PIXEL_FORMAT eRawFormat, IMG_BOOL *pbRaw)
+{
+	BL_OP_ALPHA_BLEND *psOp = (BL_OP_ALPHA_BLEND *)psObject;
+
+	return BLOPPrepareFloat(psOp->psFront, psOp->psBack, psRect, eRawFormat, pbRaw);
+}
+
+/*****************************************************************************
+ * Function Name		:	BLOPAlphaBlendGetSpan
+ ******************************************************************************/
+static IMG_VOID BLOPAlphaBlendGetSpan(BL_OBJECT *psObject, IMG_INT32 i32X, IMG_INT32 i32Y,
+									  IMG_UINT32 ui32Count, BL_FPIXEL *psOut)
+{
+	BL_OP_ALPHA_BLEND *psOp = (BL_OP_ALPHA_BLEND *)psObject;
+	const BL_FPIXEL *psBack = psOp->sBack.asPixels;
+	IMG_FLOAT fAlpha = psOp->fAlpha;
+	IMG_FLOAT fInvAlpha = 1.0f - psOp->fAlpha;
+	IMG_UINT32 i;
+
+	psOp->psFront->pfnGetSpan(psOp->psFront, i32X, i32Y, ui32Count, psOut);
+	psOp->psBack->pfnGetSpan(psOp->psBack, i32X, i32Y, ui32Count, psOp->sBack.asPixels);
+
+	for (i = 0; i < ui32Count; i++)
+	{
+		psOut[i].fR = psOut[i].fR * fAlpha + psBack[i].fR * fInvAlpha;
+		psOut[i].fG = psOut[i].fG * fAlpha + psBack[i].fG * fInvAlpha;
+		psOut[i].fB = psOut[i].fB * fAlpha + psBack[i].fB * fInvAlpha;
+		psOut[i].fA = psOut[i].fA * fAlpha + psBack[i].fA * fInvAlpha;
+	}
+}
+
+/*****************************************************************************
+ * Function Name		:	BLOPAlphaBlendInit
+ * Inputs				:	dfAlpha - Weight of the front, in [0, 1].
+ *							psFront, psBack - Objects to blend.
+ * Outputs				:	psOp - The operation.
+ ******************************************************************************/
+IMG_INTERNAL IMG_VOID BLOPAlphaBlendInit(BL_OP_ALPHA_BLEND *psOp,
+										 IMG_DOUBLE dfAlpha,
+										 BL_OBJECT *psFront,
+										 BL_OBJECT *psBack)
+{
+	psOp->sObject.pfnPrepare = BLOPAlphaBlendPrepare;
+	psOp->sObject.pfnGetSpan = BLOPAlphaBlendGetSpan;
+	psOp->sObject.pfnGetRawSpan = IMG_NULL;
+	psOp->sObject.pfnStart = IMG_NULL;
+
+	psOp->psFront = psFront;
+	psOp->psBack = psBack;
+	psOp->fAlpha = (IMG_FLOAT)dfAlpha;
+}
+
+/*****************************************************************************
+ * Function Name		:	BLOPColourKeyPrepare
+ ******************************************************************************/
+static PVRSRV_ERROR BLOPColourKeyPrepare(BL_OBJECT *psObject, const IMG_RECT *psRect,
+										 PVRSRV_PIXEL_FORMAT eRawFormat, IMG_BOOL *pbRaw)
+{
+	BL_OP_COLOUR_KEY *psOp = (BL_OP_COLOUR_KEY *)psObject;
+
+	return BLOPPrepareFloat(psOp->psFront, psOp->psBack, psRect, eRawFormat, pbRaw);
+}
+
+/*****************************************************************************
+ * Function Name		:	BLOPColourKeyGetSpan
+ ******************************************************************************/
+static IMG_VOID BLOPColourKeyGetSpan(BL_OBJECT *psObject, IMG_INT32 i32X, IMG_INT32 i32Y,
+									 IMG_UINT32 ui32Count, BL_FPIXEL *psOut)
+{
+	BL_OP_COLOUR_KEY *psOp = (BL_OP_COLOUR_KEY *)psObject;
+	IMG_UINT32 i;
+
+	psOp->psFront->pfnGetSpan(psOp->psFront, i32X, i32Y, ui32Count, psOut);
+	psOp->psBack->pfnGetSpan(psOp->psBack, i32X, i32Y, ui32Count, psOp->sBack.asPixels);
+
+	for (i = 0; i < ui32Count; i++)
+	{
+		if (((BLFloatToARGB8888(&psOut[i]) ^ psOp->ui32Key) & psOp->ui32Mask) == 0)
+		{
+			psOut[i] = psOp->sBack.asPixels[i];
+		}
+	}
+}
+
+/*****************************************************************************
+ * Function Name		:	BLOPColourKeyInit
+ * Inputs				:	psKey, psMask - Key colour and the bits of it to
+ *							compare.
+ *							eInternalFormat - How to read them.
+ *							psFront, psBack - Objects to key.
+ * Outputs				:	psOp - The operation.
+ ******************************************************************************/
+IMG_INTERNAL IMG_VOID BLOPColourKeyInit(BL_OP_COLOUR_KEY *psOp,
+										const BL_PIXEL *psKey,
+										const BL_PIXEL *psMask,
+										BL_INTERNAL_PX_FMT eInternalFormat,
+										BL_OBJECT *psFront,
+										BL_OBJECT *psBack)
+{
+	psOp->sObject.pfnPrepare = BLOPColourKeyPrepare;
+	psOp->sObject.pfnGetSpan = BLOPColourKeyGetSpan;
+	psOp->sObject.pfnGetRawSpan = IMG_NULL;
+	psOp->sObject.pfnStart = IMG_NULL;
+
+	psOp->psFront = psFront;
+	psOp->psBack = psBack;
+
+	if (eInternalFormat == BL_INTERNAL_PX_FMT_ARGB8888)
+	{
+		psOp->ui32Key = psKey->ui32ARGB8888;
+		psOp->ui32Mask = psMask->ui32ARGB8888;
+	}
+	else
+	{
+		psOp->ui32Key = BLFloatToARGB8888(&psKey->sFloat);
+		psOp->ui32Mask = BLFloatToARGB8888(&psMask->sFloat);
+	}
+
+	if (psOp->ui32Mask == 0)
+	{
+		psOp->ui32Mask = 0xFFFFFFFFU;
+	}
+}
+
+/******************************************************************************
+ End of file (blitlib_op.c)
+******************************************************************************/
@@ -0,0 +1,178 @@
+/*!****************************************************************************
+@File           blitlib_op.h
+
+@Title          Software blit library
+
+@Author         Imagination Technologies
+
+@date           19/10/10
+
+@Copyright      Copyright 2010 by Imagination Technologies Limited.
+                All rights reserved. No part of this software, either
+                material or conceptual may be copied or distributed,
+                transmitted, transcribed, stored in a retrieval system
+                or translated into any human or computer language in any
+                form by any means, electronic, mechanical, manual or
+                other-wise, or disclosed to third parties without the
+                express written permission of Imagination Technologies
+                Limited, Unit 8, HomePark Industrial Estate,
+                King's Langley, Hertfordshire, WD4 8LZ, U.K.
+
+@Platform       Generic
+
+@Description    Blitlib operations: objects which sit between the sources and
+                the destination, pulling spans from the object(s) upstream
+                of them.
+
+                Scaling, flips and rotations move pixels of any format
+                around and pass raw pixels through; alpha blending and
+                colour keying look at the pixels, so they work on floating
+                point pixels (and are only possible with convertible
+                formats).
+
+@DoxygenVer
+
+******************************************************************************/
+
+/******************************************************************************
+Modifications :-
+
+$Log: blitlib_op.h $
+
+*****************************************************************************/
+
+#ifndef _BLITLIB_OP_H_
+#define _BLITLIB_OP_H_
+
+#include "blitlib.h"
+
+/*
+	Scaling: the rectangle prepared (the destination rectangle) is mapped
+	onto sUpstreamClipRect, pixel centre to pixel centre.
+*/
+typedef struct _BL_OP_SCALE_NEAREST_
+{
+	BL_OBJECT		sObject;
+	BL_OBJECT		*psUpstream;
+
+	IMG_RECT		sUpstreamClipRect;
+
+	/* Set up by pfnPrepare */
+	IMG_RECT		sRect;
+	IMG_UINT32		ui32RawBytes;
+	BL_SPAN_BUFFER	sBuffer;
+} BL_OP_SCALE_NEAREST;
+
+typedef struct _BL_OP_SCALE_BILINEAR_
+{
+	BL_OBJECT		sObject;
+	BL_OBJECT		*psUpstream;
+
+	IMG_RECT		sUpstreamClipRect;
+
+	/* Set up by pfnPrepare */
+	IMG_RECT		sRect;
+	BL_SPAN_BUFFER	asRows[2];
+} BL_OP_SCALE_BILINEAR;
+
+/* Mirroring within the rectangle prepared */
+#define BL_OP_FLIP_X				0x00000001U
+#define BL_OP_FLIP_Y				0x00000002U
+
+typedef struct _BL_OP_FLIP_
+{
+	BL_OBJECT		sObject;
+	BL_OBJECT		*psUpstream;
+
+	IMG_UINT32		ui32Flags;
+
+	/* Set up by pfnPrepare */
+	IMG_RECT		sRect;
+	IMG_UINT32		ui32RawBytes;
+	BL_SPAN_BUFFER	sBuffer;
+} BL_OP_FLIP;
+
+/* Clockwise rotations, numbered as SGXTQ_ROTATION */
+#define BL_OP_ROTATE_NONE			0
+#define BL_OP_ROTATE_90				1
+#define BL_OP_ROTATE_180			2
+#define BL_OP_ROTATE_270			3
+
+/*
+	Rotation within the rectangle prepared. For 90 and 270 degrees the
+	upstream rectangle has the same origin with its width and height swapped.
+*/
+typedef struct _BL_OP_ROTATE_
+{
+	BL_OBJECT		sObject;
+	BL_OBJECT		*psUpstream;
+
+	IMG_UINT32		ui32Rotation;
+
+	/* Set up by pfnPrepare */
+	IMG_RECT		sRect;
+	IMG_UINT32		ui32RawBytes;
+	BL_SPAN_BUFFER	sBuffer;
+} BL_OP_ROTATE;
+
+/* front * alpha + back * (1 - alpha), on every channel */
+typedef struct _BL_OP_ALPHA_BLEND_
+{
+	BL_OBJECT		sObject;
+	BL_OBJECT		*psFront;
+	BL_OBJECT		*psBack;
+
+	IMG_FLOAT		fAlpha;
+
+	BL_SPAN_BUFFER	sBack;
+} BL_OP_ALPHA_BLEND;
+
+/*
+	Back where the front pixel, as ARGB8888, matches the key in the bits of
+	the mask; front everywhere else. A mask of 0 compares every bit.
+*/
+typedef struct _BL_OP_COLOUR_KEY_
+{
+	BL_OBJECT		sObject;
+	BL_OBJECT		*psFront;
+	BL_OBJECT		*psBack;
+
+	IMG_UINT32		ui32Key;
+	IMG_UINT32		ui32Mask;
+
+	BL_SPAN_BUFFER	sBack;
+} BL_OP_COLOUR_KEY;
+
+IMG_INTERNAL IMG_VOID BLOPScaleNearestInit(BL_OP_SCALE_NEAREST *psOp,
+										   const IMG_RECT *psUpstreamClipRect,
+										   BL_OBJECT *psUpstream);
+
+IMG_INTERNAL IMG_VOID BLOPScaleBilinearInit(BL_OP_SCALE_BILINEAR *psOp,
+											const IMG_RECT *psUpstreamClipRect,
+											BL_OBJECT *psUpstream);
+
+IMG_INTERNAL IMG_VOID BLOPFlipInit(BL_OP_FLIP *psOp,
+								   IMG_UINT32 ui32Flags,
+								   BL_OBJECT *psUpstream);
+
+IMG_INTERNAL IMG_VOID BLOPRotateInit(BL_OP_ROTATE *psOp,
+									 IMG_UINT32 ui32Rotation,
+									 BL_OBJECT *psUpstream);
+
+IMG_INTERNAL IMG_VOID BLOPAlphaBlendInit(BL_OP_ALPHA_BLEND *psOp,
+										 IMG_DOUBLE dfAlpha,
+										 BL_OBJECT *psFront,
+										 BL_OBJECT *psBack);
+
+IMG_INTERNAL IMG_VOID BLOPColourKeyInit(BL_OP_COLOUR_KEY *psOp,
+										const BL_PIXEL *psKey,
+										const BL_PIXEL *psMask,
+										BL_INTERNAL_PX_FMT eInternalFormat,
+										BL_OBJECT *psFront,
+										BL_OBJECT *psBack);
+
+#endif /* _BLITLIB_OP_H_ */
+
+/******************************************************************************
+ End of file (blitlib_op.h)
+******************************************************************************/
@@ -0,0 +1,356 @@
+/*!****************************************************************************
+@File           blitlib_src.c
+
+@Title          Software blit library
+
+@Author         Imagination Technologies
+
+@date           19/10/10
+
+@Copyright      Copyright 2010 by Imagination Technologies Limited.
+                All rights reserved. No part of this software, either
+                material or conceptual may be copied or distributed,
+                transmitted, transcribed, stored in a retrieval system
+                or translated into any human or computer language in any
+                form by any means, electronic, mechanical, manual or
+                other-wise, or disclosed to third parties without the
+                express written permission of Imagination Technologies
+                Limited, Unit 8, HomePark Industrial Estate,
+                King's Langley, Hertfordshire, WD4 8LZ, U.K.
+
+@Platform       Generic
+
+@Description    Blitlib sources.
+
+@DoxygenVer
+
+******************************************************************************/
+
+/******************************************************************************
+Modifications :-
+
+$Log: blitlib_src.c $
+
+*****************************************************************************/
+
+#include "blitlib_src.h"
+
+/*****************************************************************************
+ * Function Name		:	BLSRCSurfacePrepare
+ * Inputs				:	psObject - The source.
+ *							psRect - Unused: every pixel can be read.
+ *							eRawFormat - Format the caller would like.
+ * Outputs				:	pbRaw - Whether raw pixels will be delivered.
+ * Returns				:	PVRSRV_ERROR_NOT_SUPPORTED if the pixels can be
+ *							neither copied nor converted.
+ ******************************************************************************/
+static PVRSRV_ERROR BLSRCSurfacePrepare(BL_OBJECT *psObject, const IMG_RECT *psRect,
+										PVRSRV_PIXEL_FORMAT eRawFormat, IMG_BOOL *pbRaw)
+{
+	BL_SRC_SURFACE *psSrc = (BL_SRC_SURFACE *)psObject;
+	PVRSRV_PIXEL_FORMAT ePixelFormat = psSrc->sSurface.ePixelFormat;
+
+	PVR_UNREFERENCED_PARAMETER(psRect);
+
+	if (psSrc->pbyFBAddr == IMG_NULL)
+	{
+		return PVRSRV_ERROR_INVALID_PARAMS;
+	}
+
+	if (eRawFormat != PVRSRV_PIXEL_FORMAT_UNKNOWN)
+	{
+		*pbRaw = (eRawFormat == ePixelFormat && BLFormatIsCopyable(ePixelFormat)) ? IMG_TRUE : IMG_FALSE;
+
+		if (*pbRaw)
+		{
+			return PVRSRV_OK;
+		}
+	}
+
+	return BLFormatIsConvertible(ePixelFormat) ? PVRSRV_OK : PVRSRV_ERROR_NOT_SUPPORTED;
+}
+
+/*****************************************************************************
+ * Function Name		:	BLSRCSurfaceGetSpan
+ * Inputs				:	psObject - The source.
+ *							i32X, i32Y, ui32Count - The span.
+ * Outputs				:	psOut - The pixels.
+ ******************************************************************************/
+static IMG_VOID BLSRCSurfaceGetSpan(BL_OBJECT *psObject, IMG_INT32 i32X, IMG_INT32 i32Y,
+									IMG_UINT32 ui32Count, BL_FPIXEL *psOut)
+{
+	BL_SRC_SURFACE *psSrc = (BL_SRC_SURFACE *)psObject;
+	const BL_SURFACE *psSurface = &psSrc->sSurface;
+	IMG_PBYTE pbyRow = IMG_NULL;
+
+	/* Convert straight from memory when the span is a run of pixels inside the surface */
+	if (i32X >= 0 && i32X + (IMG_INT32)ui32Count <= (IMG_INT32)psSurface->ui32Width &&
+		i32Y >= 0 && i32Y < (IMG_INT32)psSurface->ui32Height)
+	{
+		pbyRow = BLSurfaceGetRow(psSurface, psSrc->pbyFBAddr, i32Y);
+	}
+
+	if (pbyRow != IMG_NULL)
+	{
+		BLDecodeSpan(psSurface->ePixelFormat, pbyRow + i32X * (IMG_INT32)psSurface->ui32BytesPerPixel, ui32Count, psOut);
+	}
+	else
+	{
+		BLSurfaceReadSpan(psSurface, psSrc->pbyFBAddr, i32X, i32Y, ui32Count, psSrc->sBuffer.abyRaw);
+		BLDecodeSpan(psSurface->ePixelFormat, psSrc->sBuffer.abyRaw, ui32Count, psOut);
+	}
+}
+
+/*****************************************************************************
+ * Function Name		:	BLSRCSurfaceGetRawSpan
+ * Inputs				:	psObject - The source.
+ *							i32X, i32Y, ui32Count - The span.
+ * Outputs				:	pbyOut - The pixels.
+ ******************************************************************************/
+static IMG_VOID BLSRCSurfaceGetRawSpan(BL_OBJECT *psObject, IMG_INT32 i32X, IMG_INT32 i32Y,
+									   IMG_UINT32 ui32Count, IMG_BYTE *pbyOut)
+{
+	BL_SRC_SURFACE *psSrc = (BL_SRC_SURFACE *)psObject;
+
+	BLSurfaceReadSpan(&psSrc->sSurface, psSrc->pbyFBAddr, i32X, i32Y, ui32Count, pbyOut);
+}
+
+/*****************************************************************************
+ * Function Name		:	BLSRCSurfaceInit
+ * Inputs				:	See BLSurfaceInit.
+ *							pbyFBAddr - Surface memory.
+ * Outputs				:	psSrc - The source.
+ ******************************************************************************/
+static IMG_VOID BLSRCSurfaceInit(BL_SRC_SURFACE *psSrc, BL_MEMLAYOUT eMemLayout,
+								 PVRSRV_PIXEL_FORMAT ePixelFormat, IMG_INT32 i32Stride,
+								 IMG_UINT32 ui32Width, IMG_UINT32 ui32Height,
+								 IMG_PBYTE pbyFBAddr, const BL_PLANAR_SURFACE_INFO *psPlanarInfo)
+{
+	psSrc->sObject.pfnPrepare = BLSRCSurfacePrepare;
+	psSrc->sObject.pfnGetSpan = BLSRCSurfaceGetSpan;
+	psSrc->sObject.pfnGetRawSpan = BLSRCSurfaceGetRawSpan;
+	psSrc->sObject.pfnStart = IMG_NULL;
+
+	psSrc->pbyFBAddr = pbyFBAddr;
+
+	BLSurfaceInit(&psSrc->sSurface, eMemLayout, ePixelFormat, i32Stride, ui32Width, ui32Height, psPlanarInfo);
+}
+
+/*****************************************************************************
+ * Function Name		:	BLSRCLinearInit
+ * Inputs				:	i32Stride - Bytes from one row to the next; the
+ *							surface is as wide as its stride.
+ *							ui32Height - Rows.
+ *							ePixelFormat - Format of the pixels.
+ *							pbyFBAddr - First row.
+ *							psPlanarInfo - Planes, or IMG_NULL.
+ * Outputs				:	psSrc - The source.
+ ******************************************************************************/
+IMG_INTERNAL IMG_VOID BLSRCLinearInit(BL_SRC_LINEAR *psSrc,
+									  IMG_INT32 i32Stride,
+									  IMG_UINT32 ui32Height,
+									  PVRSRV_PIXEL_FORMAT ePixelFormat,
+									  IMG_PBYTE pbyFBAddr,
+									  const BL_PLANAR_SURFACE_INFO *psPlanarInfo)
+{
+	BLSRCSurfaceInit(psSrc, BL_MEMLAYOUT_LINEAR, ePixelFormat, i32Stride, 0, ui32Height, pbyFBAddr, psPlanarInfo);
+}
+
+/*****************************************************************************
+ * Function Name		:	BLSRCTwiddledInit
+ * Inputs				:	ui32Width, ui32Height - Size in pixels.
+ *							ePixelFormat - Format of the pixels.
+ *							pbyFBAddr - Surface memory.
+ *							psPlanarInfo - Planes, or IMG_NULL.
+ *							bHybrid - Whether the surface is a row of twiddled
+ *							tiles rather than twiddled as a whole.
+ * Outputs				:	psSrc - The source.
+ ******************************************************************************/
+IMG_INTERNAL IMG_VOID BLSRCTwiddledInit(BL_SRC_TWIDDLED *psSrc,
+										IMG_UINT32 ui32Width,
+										IMG_UINT32 ui32Height,
+										PVRSRV_PIXEL_FORMAT ePixelFormat,
+										IMG_PBYTE pbyFBAddr,
+										const BL_PLANAR_SURFACE_INFO *psPlanarInfo,
+										IMG_BOOL bHybrid)
+{
+	BLSRCSurfaceInit(psSrc, bHybrid ? BL_MEMLAYOUT_HYBRID_TWIDDLED : BL_MEMLAYOUT_TWIDDLED,
+					 ePixelFormat, 0, ui32Width, ui32Height, pbyFBAddr, psPlanarInfo);
+}
+
+/*****************************************************************************
+ * Function Name		:	BLSRCTiledInit
+ * Inputs				:	i32Stride - Bytes from one row of pixels to the
+ *							next, as for a linear surface.
+ *							ui32Height - Rows.
+ *							ePixelFormat - Format of the pixels.
+ *							pbyFBAddr - Surface memory.
+ *							psPlanarInfo - Planes, or IMG_NULL.
+ * Outputs				:	psSrc - The source.
+ ******************************************************************************/
+IMG_INTERNAL IMG_VOID BLSRCTiledInit(BL_SRC_TILED *psSrc,
+									 IMG_INT32 i32Stride,
+									 IMG_UINT32 ui32Height,
+									 PVRSRV_PIXEL_FORMAT ePixelFormat,
+									 IMG_PBYTE pbyFBAddr,
+									 const BL_PLANAR_SURFACE_INFO *psPlanarInfo)
+{
+	BLSRCSurfaceInit(psSrc, BL_MEMLAYOUT_TILED, ePixelFormat, i32Stride, 0, ui32Height, pbyFBAddr, psPlanarInfo);
+}
+
+/*****************************************************************************
+ * Function Name		:	BLSRCSolidPrepare
+ * Inputs				:	psObject - The source.
+ *							psRect - Unused.
+ *							eRawFormat - Format the caller would like.
+ * Outputs				:	pbRaw - Whether raw pixels will be delivered.
+ * Description			:	Packs the colour into the raw format, which is
+ *							possible for any convertible format and, bit for
+ *							bit, for the format the colour was given in.
+ ******************************************************************************/
+static PVRSRV_ERROR BLSRCSolidPrepare(BL_OBJECT *psObject, const IMG_RECT *psRect,
+									  PVRSRV_PIXEL_FORMAT eRawFormat, IMG_BOOL *pbRaw)
+{
+	BL_SRC_SOLID *psSrc = (BL_SRC_SOLID *)psObject;
+
+	PVR_UNREFERENCED_PARAMETER(psRect);
+
+	psSrc->ui32RawBytes = 0;
+
+	if (eRawFormat == PVRSRV_PIXEL_FORMAT_UNKNOWN)
+	{
+		return PVRSRV_OK;
+	}
+
+	if (psSrc->bHasPackedColour && eRawFormat == psSrc->eColourFormat && BLFormatIsCopyable(eRawFormat))
+	{
+		IMG_UINT32 i;
+
+		psSrc->ui32RawBytes = gas_BLExternalPixelTable[eRawFormat].ui32BytesPerPixel;
+
+		for (i = 0; i < psSrc->ui32RawBytes; i++)
+		{
+			psSrc->abyRawColour[i] = (IMG_BYTE)(psSrc->ui32PackedColour >> (i * 8));
+		}
+	}
+	else if (BLFormatIsConvertible(eRawFormat) && BLFormatIsCopyable(eRawFormat))
+	{
+		psSrc->ui32RawBytes = gas_BLExternalPixelTable[eRawFormat].ui32BytesPerPixel;
+
+		BLEncodeSpan(eRawFormat, &psSrc->sColour, 1, psSrc->abyRawColour);
+	}
+
+	*pbRaw = (psSrc->ui32RawBytes != 0) ? IMG_TRUE : IMG_FALSE;
+
+	return PVRSRV_OK;
+}
+
+/*****************************************************************************
+ * Function Name		:	BLSRCSolidGetSpan
+ * Inputs				:	psObject - The source.
+ *							ui32Count - Pixels.
+ * Outputs				:	psOut - The pixels.
+ ******************************************************************************/
+static IMG_VOID BLSRCSolidGetSpan(BL_OBJECT *psObject, IMG_INT32 i32X, IMG_INT32 i32Y,
+								  IMG_UINT32 ui32Count, BL_FPIXEL *psOut)
+{
+	BL_SRC_SOLID *psSrc = (BL_SRC_SOLID *)psObject;
+	IMG_UINT32 i;
+
+	PVR_UNREFERENCED_PARAMETER(i32X);
+	PVR_UNREFERENCED_PARAMETER(i32Y);
+
+	for (i = 0; i < ui32Count; i++)
+	{
+		psOut[i] = psSrc->sColour;
+	}
+}
+
+/*****************************************************************************
+ * Function Name		:	BLSRCSolidGetRawSpan
+ * Inputs				:	psObject - The source.
+ *							ui32Count - Pixels.
+ * Outputs				:	pbyOut - The pixels.
+ ******************************************************************************/
+static IMG_VOID BLSRCSolidGetRawSpan(BL_OBJECT *psObject, IMG_INT32 i32X, IMG_INT32 i32Y,
+									 IMG_UINT32 ui32Count, IMG_BYTE *pbyOut)
+{
+	BL_SRC_SOLID *psSrc = (BL_SRC_SOLID *)psObject;
+	IMG_UINT32 ui32RawBytes = psSrc->ui32RawBytes;
+	IMG_UINT32 ui32Bytes = ui32Count * ui32RawBytes;
+	IMG_UINT32 ui32Filled;
+
+	PVR_UNREFERENCED_PARAMETER(i32X);
+	PVR_UNREFERENCED_PARAMETER(i32Y);
+
+	if (ui32Count == 0)
+	{
+		return;
+	}
+
+	/* One pixel, then double what is written until the span is full */
+	BLCopyPixel(pbyOut, psSrc->abyRawColour, ui32RawBytes);
+
+	for (ui32Filled = ui32RawBytes; ui32Filled < ui32Bytes; ui32Filled *= 2)
+	{
+		memcpy(pbyOut + ui32Filled, pbyOut, BL_MIN(ui32Filled, ui32Bytes - ui32Filled));
+	}
+}
+
+/*****************************************************************************
+ * Function Name		:	BLSRCSolidInit
+ * Inputs				:	psColour - The colour.
+ *							eInternalFormat - How to read psColour.
+ *							eColourFormat - With BL_INTERNAL_PX_FMT_ARGB8888,
+ *							the format of the (up to 32 bit) pixel held in
+ *							ui32ARGB8888; normally PVRSRV_PIXEL_FORMAT_ARGB8888.
+ * Outputs				:	psSrc - The source.
+ ******************************************************************************/
+IMG_INTERNAL IMG_VOID BLSRCSolidInit(BL_SRC_SOLID *psSrc,
+									 const BL_PIXEL *psColour,
+									 BL_INTERNAL_PX_FMT eInternalFormat,
+									 PVRSRV_PIXEL_FORMAT eColourFormat)
+{
+	psSrc->sObject.pfnPrepare = BLSRCSolidPrepare;
+	psSrc->sObject.pfnGetSpan = BLSRCSolidGetSpan;
+	psSrc->sObject.pfnGetRawSpan = BLSRCSolidGetRawSpan;
+	psSrc->sObject.pfnStart = IMG_NULL;
+
+	psSrc->bHasPackedColour = IMG_FALSE;
+	psSrc->ui32PackedColour = 0;
+	psSrc->eColourFormat = eColourFormat;
+	psSrc->ui32RawBytes = 0;
+
+	if (eInternalFormat == BL_INTERNAL_PX_FMT_ARGB8888 &&
+		BLFormatIsCopyable(eColourFormat) &&
+		gas_BLExternalPixelTable[eColourFormat].ui32BytesPerPixel <= sizeof(IMG_UINT32))
+	{
+		IMG_BYTE abyColour[sizeof(IMG_UINT32)];
+		IMG_UINT32 i;
+
+		psSrc->bHasPackedColour = IMG_TRUE;
+		psSrc->ui32PackedColour = psColour->ui32ARGB8888;
+
+		for (i = 0; i < sizeof(abyColour); i++)
+		{
+			abyColour[i] = (IMG_BYTE)(psColour->ui32ARGB8888 >> (i * 8));
+		}
+
+		if (BLFormatIsConvertible(eColourFormat))
+		{
+			BLDecodeSpan(eColourFormat, abyColour, 1, &psSrc->sColour);
+		}
+		else
+		{
+			BLARGB8888ToFloat(psColour->ui32ARGB8888, &psSrc->sColour);
+		}
+	}
+	else
+	{
+		BLPixelToFloat(psColour, eInternalFormat, &psSrc->sColour);
+	}
+}
+
+/******************************************************************************
+ End of file (blitlib_src.c)
+******************************************************************************/
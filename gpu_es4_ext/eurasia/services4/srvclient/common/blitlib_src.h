@@ -0,0 +1,118 @@
+/*!****************************************************************************
+@File           blitlib_src.h
+
+@Title          Software blit library
+
+@Author         Imagination Technologies
+
+@date           19/10/10
+
+@Copyright      Copyright 2010 by Imagination Technologies Limited.
+                All rights reserved. No part of this software, either
+                material or conceptual may be copied or distributed,
+                transmitted, transcribed, stored in a retrieval system
+                or translated into any human or computer language in any
+                form by any means, electronic, mechanical, manual or
+                other-wise, or disclosed to third parties without the
+                express written permission of Imagination Technologies
+                Limited, Unit 8, HomePark Industrial Estate,
+                King's Langley, Hertfordshire, WD4 8LZ, U.K.
+
+@Platform       Generic
+
+@Description    Blitlib sources: surfaces in memory and solid colours. A
+                source delivers any pixel it is asked for; pixels outside
+                a surface repeat its nearest edge.
+
+@DoxygenVer
+
+******************************************************************************/
+
+/******************************************************************************
+Modifications :-
+
+$Log: blitlib_src.h $
+
+*****************************************************************************/
+
+#ifndef _BLITLIB_SRC_H_
+#define _BLITLIB_SRC_H_
+
+#include "blitlib.h"
+
+/*
+	A surface in memory. pbyFBAddr is only read while a blit runs, so it may
+	be changed after the Init function (to read a copy of the surface, say).
+*/
+typedef struct _BL_SRC_SURFACE_
+{
+	BL_OBJECT		sObject;
+
+	IMG_PBYTE		pbyFBAddr;
+
+	BL_SURFACE		sSurface;
+
+	/* Packed pixels of a span being converted */
+	BL_SPAN_BUFFER	sBuffer;
+} BL_SRC_SURFACE;
+
+typedef BL_SRC_SURFACE BL_SRC_LINEAR;
+typedef BL_SRC_SURFACE BL_SRC_TWIDDLED;
+typedef BL_SRC_SURFACE BL_SRC_TILED;
+
+typedef union _BL_SRC_
+{
+	BL_SRC_LINEAR	linear;
+	BL_SRC_TWIDDLED	twiddled;
+	BL_SRC_TILED	tiled;
+} BL_SRC;
+
+/* The same colour everywhere */
+typedef struct _BL_SRC_SOLID_
+{
+	BL_OBJECT			sObject;
+
+	BL_FPIXEL			sColour;
+
+	/* The colour as given, when it was given as a pixel of eColourFormat */
+	IMG_BOOL			bHasPackedColour;
+	IMG_UINT32			ui32PackedColour;
+	PVRSRV_PIXEL_FORMAT	eColourFormat;
+
+	/* The colour as a pixel of the raw format asked for in pfnPrepare */
+	IMG_UINT32			ui32RawBytes;
+	IMG_BYTE			abyRawColour[BL_MAX_RAW_PIXEL_BYTES];
+} BL_SRC_SOLID;
+
+IMG_INTERNAL IMG_VOID BLSRCLinearInit(BL_SRC_LINEAR *psSrc,
+									  IMG_INT32 i32Stride,
+									  IMG_UINT32 ui32Height,
+									  PVRSRV_PIXEL_FORMAT ePixelFormat,
+									  IMG_PBYTE pbyFBAddr,
+									  const BL_PLANAR_SURFACE_INFO *psPlanarInfo);
+
+IMG_INTERNAL IMG_VOID BLSRCTwiddledInit(BL_SRC_TWIDDLED *psSrc,
+										IMG_UINT32 ui32Width,
+										IMG_UINT32 ui32Height,
+										PVRSRV_PIXEL_FORMAT ePixelFormat,
+										IMG_PBYTE pbyFBAddr,
+										const BL_PLANAR_SURFACE_INFO *psPlanarInfo,
+										IMG_BOOL bHybrid);
+
+IMG_INTERNAL IMG_VOID BLSRCTiledInit(BL_SRC_TILED *psSrc,
+									 IMG_INT32 i32Stride,
+									 IMG_UINT32 ui32Height,
+									 PVRSRV_PIXEL_FORMAT ePixelFormat,
+									 IMG_PBYTE pbyFBAddr,
+									 const BL_PLANAR_SURFACE_INFO *psPlanarInfo);
+
+IMG_INTERNAL IMG_VOID BLSRCSolidInit(BL_SRC_SOLID *psSrc,
+									 const BL_PIXEL *psColour,
+									 BL_INTERNAL_PX_FMT eInternalFormat,
+									 PVRSRV_PIXEL_FORMAT eColourFormat);
+
+#endif /* _BLITLIB_SRC_H_ */
+
+/******************************************************************************
+ End of file (blitlib_src.h)
+******************************************************************************/
@@ -2702,6 +2702,7 @@ static PVRSRV_ERROR PrepareFillOp(SGXTQ_CLIENT_TRANSFER_CONTEXT *psTQContext,
 {
 	SGXTQ_SURFACE	* psSurf;
 	IMG_RECT		* psRect;
+	IMG_RECT		sRect;
 	IMG_UINT32		ui32LineStride;
 
 	IMG_UINT32		ui32DevVAddr;
@@ -2767,6 +2768,7 @@ static PVRSRV_ERROR PrepareFillOp(SGXTQ_CLIENT_TRANSFER_CONTEXT *psTQContext,
 	}
 
 	psRect = & SGX_QUEUETRANSFER_DST_RECT(*psQueueTransfer, 0);
+	sRect = *psRect;
 
 	ui32Height = psSurf->ui32Height;
 
@@ -2952,6 +2954,12 @@ static PVRSRV_ERROR PrepareFillOp(SGXTQ_CLIENT_TRANSFER_CONTEXT *psTQContext,
 	{
 		// Subtract neg stride offset, the no. of bytes from pixel 0,0 to the start of the surface
 		ui32DevVAddr -= ((ui32Height - 1) * (IMG_UINT32) (0 - psSurf->i32StrideInBytes));
+
+		// Invert the dest offsets
+		sRect.y0 = (IMG_INT32) ui32Height - psRect->y1;
+		sRect.y1 = (IMG_INT32) ui32Height - psRect->y0;
+		ui32Top = (IMG_UINT32) sRect.y0;
+		ui32Bottom = (IMG_UINT32) sRect.y1;
 	}
 
 	/*
@@ -3121,7 +3129,7 @@ static PVRSRV_ERROR PrepareFillOp(SGXTQ_CLIENT_TRANSFER_CONTEXT *psTQContext,
 	/*
 	 * Set up the PBE
 	 */
-	eError = SGXTQ_SetPBEState(psRect,
+	eError = SGXTQ_SetPBEState(&sRect,
 							psSurf->eMemLayout,
 							ui32Width,
 							ui32Height,
@@ -3292,7 +3300,7 @@ static PVRSRV_ERROR PrepareFillOp(SGXTQ_CLIENT_TRANSFER_CONTEXT *psTQContext,
 	eError = SGXTQ_CreateISPResource(psTQContext,
 									psTQContext->apsPDSPrimResources[ePDSPrim],
 									psTQContext->apsPDSSecResources[ePDSSec],
-									psRect,
+									&sRect,
 									&sTSPCoords,
 									IMG_FALSE,
 									(psQueueTransfer->ui32Flags & SGX_TRANSFER_FLAGS_INVERSE_TRIANGLE) ? IMG_TRUE : IMG_FALSE,
@@ -28,6 +28,11 @@ typedef struct _PVR_APPHINT_STATE_
 
 static PVRSRV_PSP2_APPHINT s_appHint;
 static IMG_BOOL s_appHintCreated = IMG_FALSE;
+static PVRSRV_PSP2_APPHINT_EXT s_appHintExt;
+static IMG_BOOL s_appHintExtCreated = IMG_FALSE;
+
+/* Does an extension struct of ui32Size bytes hold at least its size field */
+#define APPHINT_EXT_SIZE_VALID(ui32Size)	((ui32Size) >= sizeof(IMG_UINT32))
 
 
 /******************************************************************************
@@ -449,6 +454,20 @@ IMG_EXPORT IMG_BOOL PVRSRVGetAppHint(IMG_VOID		*pvHintState,
 		}
 	}
 
+	if (!bFound && s_appHintExtCreated)
+	{
+		if (!sceClibStrncasecmp(pszHintName, "FFTNLCacheFile", 15))
+		{
+			sceClibStrncpy((IMG_CHAR *)pvReturn, s_appHintExt.szFFTNLCacheFile, APPHINT_MAX_STRING_SIZE);
+			bFound = IMG_TRUE;
+		}
+		else if (!sceClibStrncasecmp(pszHintName, "FFTNLStateLog", 14))
+		{
+			sceClibStrncpy((IMG_CHAR *)pvReturn, s_appHintExt.szFFTNLStateLog, APPHINT_MAX_STRING_SIZE);
+			bFound = IMG_TRUE;
+		}
+	}
+
 	if (!bFound)
 	{
 		uDefault.pvData = pvDefault;
@@ -579,4 +598,70 @@ IMG_EXPORT IMG_BOOL PVRSRVInitializeAppHint(PVRSRV_PSP2_APPHINT *psAppHint)
 	psAppHint->ui32GLSLEnabledWarnings = 0x7FFFFFFF;
 
 	return IMG_TRUE;
-}
\ No newline at end of file
+}
+
+/******************************************************************************
+ Function Name      : PVRSRVCreateVirtualAppHintExt
+ Inputs             : *psAppHintExt
+ Outputs            :
+ Returns            : Boolean - True if hint struct created, False if error
+ Description        : Add the extension hints to the virtual app hint file.
+					  Only the first ui32Size bytes are read, so apps built
+					  against an older, shorter struct keep working; fields
+					  they do not have stay at their defaults.
+******************************************************************************/
+IMG_EXPORT IMG_BOOL PVRSRVCreateVirtualAppHintExt(PVRSRV_PSP2_APPHINT_EXT *psAppHintExt)
+{
+	IMG_UINT32 ui32Size;
+
+	if (!psAppHintExt || !APPHINT_EXT_SIZE_VALID(psAppHintExt->ui32Size))
+		return IMG_FALSE;
+
+	ui32Size = psAppHintExt->ui32Size;
+
+	if (ui32Size > sizeof(PVRSRV_PSP2_APPHINT_EXT))
+	{
+		ui32Size = sizeof(PVRSRV_PSP2_APPHINT_EXT);
+	}
+
+	sceClibMemset(&s_appHintExt, 0, sizeof(PVRSRV_PSP2_APPHINT_EXT));
+	sceClibMemcpy(&s_appHintExt, psAppHintExt, ui32Size);
+	s_appHintExt.ui32Size = sizeof(PVRSRV_PSP2_APPHINT_EXT);
+
+	/* Strings cut short by an old struct size must still be terminated */
+	s_appHintExt.szFFTNLCacheFile[sizeof(s_appHintExt.szFFTNLCacheFile) - 1] = '\0';
+	s_appHintExt.szFFTNLStateLog[sizeof(s_appHintExt.szFFTNLStateLog) - 1] = '\0';
+
+	s_appHintExtCreated = IMG_TRUE;
+
+	return IMG_TRUE;
+}
+
+/******************************************************************************
+ Function Name      : PVRSRVInitializeAppHintExt
+ Inputs             : *psAppHintExt
+ Outputs            :
+ Returns            : Boolean - True if hint struct created, False if error
+ Description        : Sets default values for the extension apphint struct.
+					  The caller sets ui32Size first; nothing past it is
+					  written.
+******************************************************************************/
+IMG_EXPORT IMG_BOOL PVRSRVInitializeAppHintExt(PVRSRV_PSP2_APPHINT_EXT *psAppHintExt)
+{
+	IMG_UINT32 ui32Size;
+
+	if (!psAppHintExt || !APPHINT_EXT_SIZE_VALID(psAppHintExt->ui32Size))
+		return IMG_FALSE;
+
+	ui32Size = psAppHintExt->ui32Size;
+
+	if (ui32Size > sizeof(PVRSRV_PSP2_APPHINT_EXT))
+	{
+		ui32Size = sizeof(PVRSRV_PSP2_APPHINT_EXT);
+	}
+
+	/* Every extension hint defaults to zero or an empty string */
+	sceClibMemset((IMG_CHAR *)psAppHintExt + sizeof(IMG_UINT32), 0, ui32Size - sizeof(IMG_UINT32));
+
+	return IMG_TRUE;
+}
@@ -0,0 +1,31 @@
+# Copyright	2010 Imagination Technologies Limited. All rights reserved.
+#
+# No part of this software, either material or conceptual may be
+# copied or distributed, transmitted, transcribed, stored in a
+# retrieval system or translated into any human or computer
+# language in any form by any means, electronic, mechanical,
+# manual or other-wise, or disclosed to third parties without
+# the express written permission of: Imagination Technologies
+# Limited, HomePark Industrial Estate, Kings Langley,
+# Hertfordshire, WD4 8LZ, UK
+#
+# $Log: Linux.mk $
+#
+
+modules := blitlibtest
+
+blitlibtest_type := host_executable
+
+blitlibtest_target := blitlibtest
+
+blitlibtest_src = \
+ main.c \
+ $(TOP)/gpu_es4_ext/eurasia/services4/srvclient/common/blitlib.c \
+ $(TOP)/gpu_es4_ext/eurasia/services4/srvclient/common/blitlib_src.c \
+ $(TOP)/gpu_es4_ext/eurasia/services4/srvclient/common/blitlib_op.c \
+ $(TOP)/gpu_es4_ext/eurasia/services4/srvclient/common/blitlib_dst.c
+
+blitlibtest_includes := include4 gpu_es4_ext/eurasia/services4/srvclient/common \
+ host/include
+
+blitlibtest_extlibs := m
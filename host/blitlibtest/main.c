@@ -0,0 +1,1734 @@
+/******************************************************************************
+ * Name         : main.c
+ * Title        : Software blit library tests and benchmark (blitlibtest)
+ *
+ * Copyright    : 2010 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means,electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Description  : Runs the blitlib (services4/srvclient/common/blitlib*.c)
+ *                on the host and checks it against a reference rasteriser:
+ *                per pixel, double precision code written out separately
+ *                for each check, with its own pixel decoders and surface
+ *                addressing.
+ *
+ *                Without options the tool checks the pixel format table,
+ *                decoding of representative formats, conversion round
+ *                trips of every convertible format, copies with clipping
+ *                (raw and converting), every memory layout and planar
+ *                surfaces, point and bilinear scaling, mipmap generation,
+ *                fills, flips, rotations, alpha blending and colour
+ *                keying. It exits with a non-zero status if a check fails.
+ *
+ *                With -b it times copies, conversions and scales of a
+ *                -s pixel square surface.
+ *
+ * Modifications:-
+ * $Log: main.c $
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#include "img_types.h"
+#include "img_defs.h"
+#include "blitlib.h"
+#include "blitlib_src.h"
+#include "blitlib_dst.h"
+#include "blitlib_op.h"
+#include "hosttest.h"
+
+static IMG_VOID RandomFill(IMG_BYTE *pbyData, IMG_UINT32 ui32Size)
+{
+	IMG_UINT32 i;
+
+	for (i = 0; i < ui32Size; i++)
+	{
+		pbyData[i] = (IMG_BYTE)(Random32() >> 5);
+	}
+}
+
+static IMG_DOUBLE GetTimeMs(IMG_VOID)
+{
+	struct timespec sTime;
+
+	clock_gettime(CLOCK_MONOTONIC, &sTime);
+
+	return (IMG_DOUBLE)sTime.tv_sec * 1000.0 + (IMG_DOUBLE)sTime.tv_nsec / 1000000.0;
+}
+
+static IMG_UINT32 Read32(const IMG_BYTE *pby)
+{
+	return (IMG_UINT32)pby[0] | ((IMG_UINT32)pby[1] << 8) | ((IMG_UINT32)pby[2] << 16) | ((IMG_UINT32)pby[3] << 24);
+}
+
+static IMG_UINT32 Read16(const IMG_BYTE *pby)
+{
+	return (IMG_UINT32)pby[0] | ((IMG_UINT32)pby[1] << 8);
+}
+
+static IMG_VOID Write32(IMG_BYTE *pby, IMG_UINT32 ui32Value)
+{
+	pby[0] = (IMG_BYTE)ui32Value;
+	pby[1] = (IMG_BYTE)(ui32Value >> 8);
+	pby[2] = (IMG_BYTE)(ui32Value >> 16);
+	pby[3] = (IMG_BYTE)(ui32Value >> 24);
+}
+
+/*
+	Reference pixel decoding
+*/
+static IMG_DOUBLE RefUnorm(IMG_UINT32 ui32Value, IMG_UINT32 ui32Bits)
+{
+	return (IMG_DOUBLE)ui32Value / (IMG_DOUBLE)((1U << ui32Bits) - 1);
+}
+
+static IMG_DOUBLE RefSnorm(IMG_UINT32 ui32Value, IMG_UINT32 ui32Bits)
+{
+	IMG_INT32 i32Value = (IMG_INT32)ui32Value - ((ui32Value >> (ui32Bits - 1)) ? (IMG_INT32)(1U << ui32Bits) : 0);
+	IMG_DOUBLE dfValue = (IMG_DOUBLE)i32Value / (IMG_DOUBLE)((1U << (ui32Bits - 1)) - 1);
+
+	return (dfValue < -1.0) ? -1.0 : dfValue;
+}
+
+/* 5 bit exponent floats: halves (with a sign) and the unsigned 11 and 10 bit floats */
+static IMG_DOUBLE RefSmallFloat(IMG_UINT32 ui32Value, IMG_UINT32 ui32MantissaBits, IMG_BOOL bSigned)
+{
+	IMG_UINT32 ui32Exponent = (ui32Value >> ui32MantissaBits) & 31;
+	IMG_UINT32 ui32Mantissa = ui32Value & ((1U << ui32MantissaBits) - 1);
+	IMG_DOUBLE dfSign = (bSigned && (ui32Value >> (ui32MantissaBits + 5)) & 1) ? -1.0 : 1.0;
+
+	if (ui32Exponent == 0)
+	{
+		return dfSign * ldexp((IMG_DOUBLE)ui32Mantissa / (IMG_DOUBLE)(1U << ui32MantissaBits), -14);
+	}
+	if (ui32Exponent == 31)
+	{
+		return ui32Mantissa ? NAN : dfSign * INFINITY;
+	}
+	return dfSign * ldexp(1.0 + (IMG_DOUBLE)ui32Mantissa / (IMG_DOUBLE)(1U << ui32MantissaBits), (IMG_INT32)ui32Exponent - 15);
+}
+
+static IMG_DOUBLE RefSRGB(IMG_UINT32 ui32Value)
+{
+	IMG_DOUBLE dfValue = (IMG_DOUBLE)ui32Value / 255.0;
+
+	return (dfValue <= 0.04045) ? dfValue / 12.92 : pow((dfValue + 0.055) / 1.055, 2.4);
+}
+
+/* Decodes one pixel of the formats RefDecodeFormats lists; returns IMG_FALSE for the others */
+static IMG_BOOL RefDecode(PVRSRV_PIXEL_FORMAT eFormat, const IMG_BYTE *pbyPixel, IMG_DOUBLE adfOut[4])
+{
+	IMG_UINT32 ui32Value = Read32(pbyPixel);
+
+	adfOut[0] = 0.0;
+	adfOut[1] = 0.0;
+	adfOut[2] = 0.0;
+	adfOut[3] = 1.0;
+
+	switch (eFormat)
+	{
+		case PVRSRV_PIXEL_FORMAT_ARGB8888:
+		{
+			adfOut[0] = RefUnorm((ui32Value >> 16) & 0xFF, 8);
+			adfOut[1] = RefUnorm((ui32Value >> 8) & 0xFF, 8);
+			adfOut[2] = RefUnorm(ui32Value & 0xFF, 8);
+			adfOut[3] = RefUnorm(ui32Value >> 24, 8);
+			return IMG_TRUE;
+		}
+		case PVRSRV_PIXEL_FORMAT_ABGR8888:
+		{
+			adfOut[0] = RefUnorm(ui32Value & 0xFF, 8);
+			adfOut[1] = RefUnorm((ui32Value >> 8) & 0xFF, 8);
+			adfOut[2] = RefUnorm((ui32Value >> 16) & 0xFF, 8);
+			adfOut[3] = RefUnorm(ui32Value >> 24, 8);
+			return IMG_TRUE;
+		}
+		case PVRSRV_PIXEL_FORMAT_RGB565:
+		{
+			ui32Value = Read16(pbyPixel);
+			adfOut[0] = RefUnorm(ui32Value >> 11, 5);
+			adfOut[1] = RefUnorm((ui32Value >> 5) & 0x3F, 6);
+			adfOut[2] = RefUnorm(ui32Value & 0x1F, 5);
+			return IMG_TRUE;
+		}
+		case PVRSRV_PIXEL_FORMAT_ARGB1555:
+		{
+			ui32Value = Read16(pbyPixel);
+			adfOut[0] = RefUnorm((ui32Value >> 10) & 0x1F, 5);
+			adfOut[1] = RefUnorm((ui32Value >> 5) & 0x1F, 5);
+			adfOut[2] = RefUnorm(ui32Value & 0x1F, 5);
+			adfOut[3] = (IMG_DOUBLE)(ui32Value >> 15);
+			return IMG_TRUE;
+		}
+		case PVRSRV_PIXEL_FORMAT_ARGB4444:
+		{
+			ui32Value = Read16(pbyPixel);
+			adfOut[0] = RefUnorm((ui32Value >> 8) & 0xF, 4);
+			adfOut[1] = RefUnorm((ui32Value >> 4) & 0xF, 4);
+			adfOut[2] = RefUnorm(ui32Value & 0xF, 4);
+			adfOut[3] = RefUnorm(ui32Value >> 12, 4);
+			return IMG_TRUE;
+		}
+		case PVRSRV_PIXEL_FORMAT_RGB888:
+		{
+			adfOut[0] = RefUnorm(pbyPixel[2], 8);
+			adfOut[1] = RefUnorm(pbyPixel[1], 8);
+			adfOut[2] = RefUnorm(pbyPixel[0], 8);
+			return IMG_TRUE;
+		}
+		case PVRSRV_PIXEL_FORMAT_A2RGB10:
+		{
+			adfOut[0] = RefUnorm((ui32Value >> 20) & 0x3FF, 10);
+			adfOut[1] = RefUnorm((ui32Value >> 10) & 0x3FF, 10);
+			adfOut[2] = RefUnorm(ui32Value & 0x3FF, 10);
+			adfOut[3] = RefUnorm(ui32Value >> 30, 2);
+			return IMG_TRUE;
+		}
+		case PVRSRV_PIXEL_FORMAT_A8L8:
+		{
+			adfOut[0] = adfOut[1] = adfOut[2] = RefUnorm(pbyPixel[0], 8);
+			adfOut[3] = RefUnorm(pbyPixel[1], 8);
+			return IMG_TRUE;
+		}
+		case PVRSRV_PIXEL_FORMAT_A8:
+		{
+			adfOut[3] = RefUnorm(pbyPixel[0], 8);
+			return IMG_TRUE;
+		}
+		case PVRSRV_PIXEL_FORMAT_G8R8_SNORM:
+		{
+			adfOut[0] = RefSnorm(pbyPixel[0], 8);
+			adfOut[1] = RefSnorm(pbyPixel[1], 8);
+			return IMG_TRUE;
+		}
+		case PVRSRV_PIXEL_FORMAT_R16_SINT:
+		{
+			adfOut[0] = (IMG_DOUBLE)(IMG_INT16)Read16(pbyPixel);
+			return IMG_TRUE;
+		}
+		case PVRSRV_PIXEL_FORMAT_A8B8G8R8_UINT:
+		{
+			adfOut[0] = pbyPixel[0];
+			adfOut[1] = pbyPixel[1];
+			adfOut[2] = pbyPixel[2];
+			adfOut[3] = pbyPixel[3];
+			return IMG_TRUE;
+		}
+		case PVRSRV_PIXEL_FORMAT_A16B16G16R16_UNORM:
+		{
+			adfOut[0] = RefUnorm(Read16(pbyPixel), 16);
+			adfOut[1] = RefUnorm(Read16(pbyPixel + 2), 16);
+			adfOut[2] = RefUnorm(Read16(pbyPixel + 4), 16);
+			adfOut[3] = RefUnorm(Read16(pbyPixel + 6), 16);
+			return IMG_TRUE;
+		}
+		case PVRSRV_PIXEL_FORMAT_ABGR16F:
+		{
+			adfOut[0] = RefSmallFloat(Read16(pbyPixel), 10, IMG_TRUE);
+			adfOut[1] = RefSmallFloat(Read16(pbyPixel + 2), 10, IMG_TRUE);
+			adfOut[2] = RefSmallFloat(Read16(pbyPixel + 4), 10, IMG_TRUE);
+			adfOut[3] = RefSmallFloat(Read16(pbyPixel + 6), 10, IMG_TRUE);
+			return IMG_TRUE;
+		}
+		case PVRSRV_PIXEL_FORMAT_B10G11R11F:
+		{
+			adfOut[0] = RefSmallFloat(ui32Value & 0x7FF, 6, IMG_FALSE);
+			adfOut[1] = RefSmallFloat((ui32Value >> 11) & 0x7FF, 6, IMG_FALSE);
+			adfOut[2] = RefSmallFloat(ui32Value >> 22, 5, IMG_FALSE);
+			return IMG_TRUE;
+		}
+		case PVRSRV_PIXEL_FORMAT_A32B32G32R32F:
+		{
+			IMG_FLOAT afValue[4];
+
+			memcpy(afValue, pbyPixel, sizeof(afValue));
+			adfOut[0] = afValue[0];
+			adfOut[1] = afValue[1];
+			adfOut[2] = afValue[2];
+			adfOut[3] = afValue[3];
+			return IMG_TRUE;
+		}
+		case PVRSRV_PIXEL_FORMAT_A8R8G8B8_UNORM_SRGB:
+		{
+			adfOut[0] = RefSRGB((ui32Value >> 16) & 0xFF);
+			adfOut[1] = RefSRGB((ui32Value >> 8) & 0xFF);
+			adfOut[2] = RefSRGB(ui32Value & 0xFF);
+			adfOut[3] = RefUnorm(ui32Value >> 24, 8);
+			return IMG_TRUE;
+		}
+		default:
+		{
+			return IMG_FALSE;
+		}
+	}
+}
+
+static const PVRSRV_PIXEL_FORMAT aeRefDecodeFormats[] =
+{
+	PVRSRV_PIXEL_FORMAT_ARGB8888,
+	PVRSRV_PIXEL_FORMAT_ABGR8888,
+	PVRSRV_PIXEL_FORMAT_RGB565,
+	PVRSRV_PIXEL_FORMAT_ARGB1555,
+	PVRSRV_PIXEL_FORMAT_ARGB4444,
+	PVRSRV_PIXEL_FORMAT_RGB888,
+	PVRSRV_PIXEL_FORMAT_A2RGB10,
+	PVRSRV_PIXEL_FORMAT_A8L8,
+	PVRSRV_PIXEL_FORMAT_A8,
+	PVRSRV_PIXEL_FORMAT_G8R8_SNORM,
+	PVRSRV_PIXEL_FORMAT_R16_SINT,
+	PVRSRV_PIXEL_FORMAT_A8B8G8R8_UINT,
+	PVRSRV_PIXEL_FORMAT_A16B16G16R16_UNORM,
+	PVRSRV_PIXEL_FORMAT_ABGR16F,
+	PVRSRV_PIXEL_FORMAT_B10G11R11F,
+	PVRSRV_PIXEL_FORMAT_A32B32G32R32F,
+	PVRSRV_PIXEL_FORMAT_A8R8G8B8_UNORM_SRGB
+};
+
+#define NUM_REF_DECODE_FORMATS	(sizeof(aeRefDecodeFormats) / sizeof(aeRefDecodeFormats[0]))
+
+static IMG_BOOL Near(IMG_DOUBLE dfValue, IMG_DOUBLE dfExpected, IMG_DOUBLE dfTolerance)
+{
+	if (isnan(dfExpected))
+	{
+		return isnan(dfValue) ? IMG_TRUE : IMG_FALSE;
+	}
+	if (isinf(dfExpected))
+	{
+		return (dfValue == dfExpected) ? IMG_TRUE : IMG_FALSE;
+	}
+	return (fabs(dfValue - dfExpected) <= dfTolerance * (1.0 + fabs(dfExpected))) ? IMG_TRUE : IMG_FALSE;
+}
+
+/*
+	Reference surface addressing
+*/
+typedef struct _REF_SURFACE_
+{
+	BL_MEMLAYOUT		eMemLayout;
+	PVRSRV_PIXEL_FORMAT	eFormat;
+	IMG_UINT32			ui32Width;
+	IMG_UINT32			ui32Height;
+	IMG_UINT32			ui32BytesPerPixel;
+	IMG_INT32			i32Stride;
+	IMG_BYTE			*pbyData;
+	IMG_UINT32			ui32Size;
+} REF_SURFACE;
+
+/* Bit by bit, as TwiddleCoord in eurasiacon/common/twiddle.c (power of two sizes) */
+static IMG_UINT32 RefTwiddle(IMG_UINT32 ui32Width, IMG_UINT32 ui32Height, IMG_UINT32 ui32X, IMG_UINT32 ui32Y)
+{
+	IMG_UINT32 ui32BitsWidth = 0, ui32BitsHeight = 0, ui32Out = 0, ui32OutBit = 0, i;
+
+	while ((1U << ui32BitsWidth) < ui32Width)
+	{
+		ui32BitsWidth++;
+	}
+	while ((1U << ui32BitsHeight) < ui32Height)
+	{
+		ui32BitsHeight++;
+	}
+
+	for (i = 0; i < 32 && (i < ui32BitsWidth || i < ui32BitsHeight); i++)
+	{
+		if (i < ui32BitsHeight)
+		{
+			ui32Out |= ((ui32Y >> i) & 1) << ui32OutBit++;
+		}
+		if (i < ui32BitsWidth)
+		{
+			ui32Out |= ((ui32X >> i) & 1) << ui32OutBit++;
+		}
+	}
+
+	return ui32Out;
+}
+
+static IMG_UINT32 RefHybridTileSize(IMG_UINT32 ui32Width, IMG_UINT32 ui32Height)
+{
+	IMG_UINT32 ui32TileSize = 16;
+
+	while (ui32TileSize > 1 && (ui32TileSize > ui32Width || ui32TileSize > ui32Height))
+	{
+		ui32TileSize /= 2;
+	}
+
+	return ui32TileSize;
+}
+
+static IMG_BYTE *RefPixel(const REF_SURFACE *psSurface, IMG_UINT32 ui32X, IMG_UINT32 ui32Y)
+{
+	IMG_UINT32 ui32Bpp = psSurface->ui32BytesPerPixel;
+	IMG_UINT32 ui32Offset;
+
+	switch (psSurface->eMemLayout)
+	{
+		case BL_MEMLAYOUT_LINEAR:
+		default:
+		{
+			ui32Offset = ui32Y * (IMG_UINT32)psSurface->i32Stride + ui32X * ui32Bpp;
+			break;
+		}
+		case BL_MEMLAYOUT_TILED:
+		{
+			IMG_UINT32 ui32TilesPerRow = (IMG_UINT32)psSurface->i32Stride / (32 * ui32Bpp);
+			IMG_UINT32 ui32Tile = (ui32Y / 32) * ui32TilesPerRow + ui32X / 32;
+
+			ui32Offset = (ui32Tile * 32 * 32 + (ui32Y % 32) * 32 + ui32X % 32) * ui32Bpp;
+			break;
+		}
+		case BL_MEMLAYOUT_TWIDDLED:
+		{
+			ui32Offset = RefTwiddle(psSurface->ui32Width, psSurface->ui32Height, ui32X, ui32Y) * ui32Bpp;
+			break;
+		}
+		case BL_MEMLAYOUT_HYBRID_TWIDDLED:
+		{
+			IMG_UINT32 ui32TileSize = RefHybridTileSize(psSurface->ui32Width, psSurface->ui32Height);
+			IMG_UINT32 ui32TilesPerRow = (psSurface->ui32Width + ui32TileSize - 1) / ui32TileSize;
+			IMG_UINT32 ui32Tile = (ui32Y / ui32TileSize) * ui32TilesPerRow + ui32X / ui32TileSize;
+
+			ui32Offset = (ui32Tile * ui32TileSize * ui32TileSize +
+						  RefTwiddle(ui32TileSize, ui32TileSize, ui32X % ui32TileSize, ui32Y % ui32TileSize)) * ui32Bpp;
+			break;
+		}
+	}
+
+	if (ui32Offset + ui32Bpp > psSurface->ui32Size)
+	{
+		fprintf(stderr, "reference pixel (%u, %u) outside its surface\n", ui32X, ui32Y);
+		abort();
+	}
+
+	return psSurface->pbyData + ui32Offset;
+}
+
+static IMG_VOID RefSurfaceCreate(REF_SURFACE *psSurface, BL_MEMLAYOUT eMemLayout, PVRSRV_PIXEL_FORMAT eFormat,
+								 IMG_UINT32 ui32Width, IMG_UINT32 ui32Height)
+{
+	IMG_UINT32 ui32Bpp = gas_BLExternalPixelTable[eFormat].ui32BytesPerPixel;
+
+	psSurface->eMemLayout = eMemLayout;
+	psSurface->eFormat = eFormat;
+	psSurface->ui32Width = ui32Width;
+	psSurface->ui32Height = ui32Height;
+	psSurface->ui32BytesPerPixel = ui32Bpp;
+	psSurface->i32Stride = (IMG_INT32)(ui32Width * ui32Bpp);
+
+	switch (eMemLayout)
+	{
+		case BL_MEMLAYOUT_TILED:
+		{
+			psSurface->ui32Size = ((ui32Width + 31) & ~31U) * ((ui32Height + 31) & ~31U) * ui32Bpp;
+			break;
+		}
+		case BL_MEMLAYOUT_TWIDDLED:
+		{
+			psSurface->ui32Size = ui32Width * ui32Height * ui32Bpp;
+			break;
+		}
+		case BL_MEMLAYOUT_HYBRID_TWIDDLED:
+		{
+			IMG_UINT32 ui32TileSize = RefHybridTileSize(ui32Width, ui32Height);
+
+			psSurface->ui32Size = ((ui32Width + ui32TileSize - 1) / ui32TileSize) *
+								  ((ui32Height + ui32TileSize - 1) / ui32TileSize) *
+								  ui32TileSize * ui32TileSize * ui32Bpp;
+			break;
+		}
+		default:
+		{
+			psSurface->ui32Size = ui32Height * ui32Width * ui32Bpp;
+			break;
+		}
+	}
+
+	/* RefDecode reads whole words, so leave room past the last pixel */
+	psSurface->pbyData = malloc(psSurface->ui32Size + 16);
+	RandomFill(psSurface->pbyData, psSurface->ui32Size);
+}
+
+static IMG_VOID RefSurfaceDestroy(REF_SURFACE *psSurface)
+{
+	free(psSurface->pbyData);
+}
+
+static BL_OBJECT *MakeSource(BL_SRC *puSrc, const REF_SURFACE *psSurface)
+{
+	switch (psSurface->eMemLayout)
+	{
+		case BL_MEMLAYOUT_TILED:
+		{
+			BLSRCTiledInit(&puSrc->tiled, psSurface->i32Stride, psSurface->ui32Height, psSurface->eFormat,
+						   psSurface->pbyData, IMG_NULL);
+			return &puSrc->tiled.sObject;
+		}
+		case BL_MEMLAYOUT_TWIDDLED:
+		case BL_MEMLAYOUT_HYBRID_TWIDDLED:
+		{
+			BLSRCTwiddledInit(&puSrc->twiddled, psSurface->ui32Width, psSurface->ui32Height, psSurface->eFormat,
+							  psSurface->pbyData, IMG_NULL,
+							  (psSurface->eMemLayout == BL_MEMLAYOUT_HYBRID_TWIDDLED) ? IMG_TRUE : IMG_FALSE);
+			return &puSrc->twiddled.sObject;
+		}
+		default:
+		{
+			BLSRCLinearInit(&puSrc->linear, psSurface->i32Stride, psSurface->ui32Height, psSurface->eFormat,
+							psSurface->pbyData, IMG_NULL);
+			return &puSrc->linear.sObject;
+		}
+	}
+}
+
+static BL_OBJECT *MakeDest(BL_DST *puDst, const REF_SURFACE *psSurface, const IMG_RECT *psRect, BL_OBJECT *psUpstream)
+{
+	switch (psSurface->eMemLayout)
+	{
+		case BL_MEMLAYOUT_TILED:
+		{
+			BLDSTTiledInit(&puDst->tiled, psSurface->i32Stride, psSurface->ui32Height, psSurface->eFormat,
+						   psRect, psSurface->pbyData, psUpstream, IMG_NULL);
+			return &puDst->tiled.sObject;
+		}
+		case BL_MEMLAYOUT_TWIDDLED:
+		case BL_MEMLAYOUT_HYBRID_TWIDDLED:
+		{
+			BLDSTTwiddledInit(&puDst->twiddled, psSurface->ui32Width, psSurface->ui32Height, psSurface->eFormat,
+							  psRect, psSurface->pbyData, psUpstream, IMG_NULL,
+							  (psSurface->eMemLayout == BL_MEMLAYOUT_HYBRID_TWIDDLED) ? IMG_TRUE : IMG_FALSE);
+			return &puDst->twiddled.sObject;
+		}
+		default:
+		{
+			BLDSTLinearInit(&puDst->linear, psSurface->i32Stride, psSurface->ui32Height, psSurface->eFormat,
+							psRect, psSurface->pbyData, psUpstream, IMG_NULL);
+			return &puDst->linear.sObject;
+		}
+	}
+}
+
+static IMG_VOID SetRect(IMG_RECT *psRect, IMG_INT32 i32X0, IMG_INT32 i32Y0, IMG_INT32 i32X1, IMG_INT32 i32Y1)
+{
+	psRect->x0 = i32X0;
+	psRect->y0 = i32Y0;
+	psRect->x1 = i32X1;
+	psRect->y1 = i32Y1;
+}
+
+static IMG_INT32 Clamp(IMG_INT32 i32Value, IMG_INT32 i32Min, IMG_INT32 i32Max)
+{
+	return (i32Value < i32Min) ? i32Min : ((i32Value > i32Max) ? i32Max : i32Value);
+}
+
+/* Reference ARGB8888 encoding of a decoded pixel */
+static IMG_UINT32 RefEncodeARGB8888(const IMG_DOUBLE adfPixel[4])
+{
+	IMG_UINT32 aui32Channel[4], i;
+
+	for (i = 0; i < 4; i++)
+	{
+		IMG_DOUBLE dfValue = (adfPixel[i] < 0.0) ? 0.0 : ((adfPixel[i] > 1.0) ? 1.0 : adfPixel[i]);
+
+		aui32Channel[i] = (IMG_UINT32)floor(dfValue * 255.0 + 0.5);
+	}
+
+	return (aui32Channel[3] << 24) | (aui32Channel[0] << 16) | (aui32Channel[1] << 8) | aui32Channel[2];
+}
+
+static IMG_BOOL ARGB8888Near(IMG_UINT32 ui32Value, IMG_UINT32 ui32Expected, IMG_UINT32 ui32Tolerance)
+{
+	IMG_UINT32 i;
+
+	for (i = 0; i < 32; i += 8)
+	{
+		IMG_INT32 i32Diff = (IMG_INT32)((ui32Value >> i) & 0xFF) - (IMG_INT32)((ui32Expected >> i) & 0xFF);
+
+		if (i32Diff > (IMG_INT32)ui32Tolerance || i32Diff < -(IMG_INT32)ui32Tolerance)
+		{
+			return IMG_FALSE;
+		}
+	}
+
+	return IMG_TRUE;
+}
+
+/*
+	Tests
+*/
+static IMG_VOID TestFormatTable(IMG_VOID)
+{
+	IMG_UINT32 ui32Format;
+
+	for (ui32Format = 0; ui32Format <= PVRSRV_PIXEL_FORMAT_RAW1024; ui32Format++)
+	{
+		const BL_EXTERNAL_PIXEL_FORMAT *psFormat = &gas_BLExternalPixelTable[ui32Format];
+		IMG_UINT32 ui32Channel;
+		IMG_UINT32 ui32Used = 0;
+
+		if (psFormat->eChannelType == BL_CHANNEL_NONE)
+		{
+			Check(!BLFormatIsConvertible((PVRSRV_PIXEL_FORMAT)ui32Format), "format table", "unconverted format is convertible");
+			continue;
+		}
+
+		Check(BLFormatIsConvertible((PVRSRV_PIXEL_FORMAT)ui32Format), "format table", "format with channels isn't convertible");
+		Check(BLFormatIsCopyable((PVRSRV_PIXEL_FORMAT)ui32Format), "format table", "convertible format isn't copyable");
+
+		for (ui32Channel = 0; ui32Channel < 4; ui32Channel++)
+		{
+			IMG_UINT32 ui32Shift = psFormat->aui8Shift[ui32Channel];
+			IMG_UINT32 ui32Bits = psFormat->aui8Bits[ui32Channel];
+
+			if (ui32Bits == 0 || ((psFormat->ui32Flags & BL_PXFMT_FLAG_LUMINANCE) && ui32Channel != BL_CHANNEL_R && ui32Channel != BL_CHANNEL_A))
+			{
+				continue;
+			}
+
+			Check(ui32Shift + ui32Bits <= psFormat->ui32BytesPerPixel * 8, "format table", "channel outside the pixel");
+			Check((ui32Shift / 32) == ((ui32Shift + ui32Bits - 1) / 32), "format table", "channel crosses a 32 bit word");
+
+			if (ui32Shift + ui32Bits <= 64)
+			{
+				IMG_UINT64 ui64Mask = ((ui32Bits == 64) ? ~(IMG_UINT64)0 : (((IMG_UINT64)1 << ui32Bits) - 1)) << ui32Shift;
+
+				Check((ui32Used & (IMG_UINT32)ui64Mask) == 0 || ui32Shift >= 32, "format table", "channels overlap");
+				if (ui32Shift < 32)
+				{
+					ui32Used |= (IMG_UINT32)ui64Mask;
+				}
+			}
+		}
+	}
+
+	Check(!BLFormatIsCopyable(PVRSRV_PIXEL_FORMAT_YUYV), "format table", "YUYV is copyable");
+	Check(!BLFormatIsCopyable(PVRSRV_PIXEL_FORMAT_PVRTC4), "format table", "PVRTC4 is copyable");
+	Check(BLFormatIsCopyable(PVRSRV_PIXEL_FORMAT_D24S8), "format table", "D24S8 isn't copyable");
+}
+
+static IMG_VOID TestDecode(IMG_VOID)
+{
+	IMG_UINT32 i, j, k;
+
+	for (i = 0; i < NUM_REF_DECODE_FORMATS; i++)
+	{
+		PVRSRV_PIXEL_FORMAT eFormat = aeRefDecodeFormats[i];
+		IMG_UINT32 ui32Bpp = gas_BLExternalPixelTable[eFormat].ui32BytesPerPixel;
+		IMG_BYTE abyPixels[BL_MAX_SPAN * 16];
+		BL_FPIXEL asPixels[BL_MAX_SPAN];
+		IMG_BOOL bOK = IMG_TRUE;
+
+		RandomFill(abyPixels, sizeof(abyPixels));
+		BLDecodeSpan(eFormat, abyPixels, BL_MAX_SPAN, asPixels);
+
+		for (j = 0; j < BL_MAX_SPAN; j++)
+		{
+			IMG_DOUBLE adfExpected[4];
+			const IMG_FLOAT *pfValue = &asPixels[j].fR;
+
+			RefDecode(eFormat, abyPixels + j * ui32Bpp, adfExpected);
+
+			for (k = 0; k < 4; k++)
+			{
+				if (!Near(pfValue[k], adfExpected[k], 1e-6))
+				{
+					fprintf(stderr, "format %u pixel %u channel %u: %g, expected %g\n", eFormat, j, k, pfValue[k], adfExpected[k]);
+					bOK = IMG_FALSE;
+				}
+			}
+		}
+
+		Check(bOK, "decode", "decoded pixel differs from the reference");
+	}
+}
+
+static IMG_VOID TestRoundTrip(IMG_VOID)
+{
+	IMG_UINT32 ui32Format;
+
+	for (ui32Format = 0; ui32Format <= PVRSRV_PIXEL_FORMAT_RAW1024; ui32Format++)
+	{
+		PVRSRV_PIXEL_FORMAT eFormat = (PVRSRV_PIXEL_FORMAT)ui32Format;
+		const BL_EXTERNAL_PIXEL_FORMAT *psFormat = &gas_BLExternalPixelTable[ui32Format];
+		IMG_UINT32 ui32Bpp = psFormat->ui32BytesPerPixel;
+		IMG_BYTE abyPixels[BL_MAX_SPAN * 16], abyOnce[BL_MAX_SPAN * 16], abyTwice[BL_MAX_SPAN * 16];
+		BL_FPIXEL asPixels[BL_MAX_SPAN];
+		IMG_BOOL bExact;
+		IMG_UINT32 i, ui32Channel;
+
+		if (!BLFormatIsConvertible(eFormat))
+		{
+			continue;
+		}
+
+		RandomFill(abyPixels, sizeof(abyPixels));
+
+		/* Decoding and encoding again must not change an encoded pixel */
+		BLDecodeSpan(eFormat, abyPixels, BL_MAX_SPAN, asPixels);
+		BLEncodeSpan(eFormat, asPixels, BL_MAX_SPAN, abyOnce);
+		BLDecodeSpan(eFormat, abyOnce, BL_MAX_SPAN, asPixels);
+		BLEncodeSpan(eFormat, asPixels, BL_MAX_SPAN, abyTwice);
+
+		if (memcmp(abyOnce, abyTwice, BL_MAX_SPAN * ui32Bpp) != 0)
+		{
+			fprintf(stderr, "format %u\n", ui32Format);
+			Check(IMG_FALSE, "round trip", "encoding isn't stable");
+		}
+
+		/* Unsigned normalised and integer channels (up to 24 bits) come back exactly */
+		bExact = (psFormat->eChannelType == BL_CHANNEL_UNORM || psFormat->eChannelType == BL_CHANNEL_UINT ||
+				  psFormat->eChannelType == BL_CHANNEL_SINT) ? IMG_TRUE : IMG_FALSE;
+
+		for (ui32Channel = 0; ui32Channel < 4; ui32Channel++)
+		{
+			if (psFormat->aui8Bits[ui32Channel] > 24)
+			{
+				bExact = IMG_FALSE;
+			}
+		}
+
+		if (psFormat->ui32Flags & BL_PXFMT_FLAG_LUMINANCE)
+		{
+			bExact = IMG_FALSE;
+		}
+
+		if (bExact)
+		{
+			for (i = 0; i < BL_MAX_SPAN; i++)
+			{
+				for (ui32Channel = 0; ui32Channel < 4; ui32Channel++)
+				{
+					IMG_UINT32 ui32Bits = psFormat->aui8Bits[ui32Channel];
+					IMG_UINT32 ui32Shift = psFormat->aui8Shift[ui32Channel];
+					IMG_UINT32 ui32Word = (ui32Shift / 32) * 4;
+					IMG_UINT32 ui32Mask, ui32In = 0, ui32Out = 0, j;
+
+					if (ui32Bits == 0)
+					{
+						continue;
+					}
+
+					for (j = 0; j < 4 && ui32Word + j < ui32Bpp; j++)
+					{
+						ui32In |= (IMG_UINT32)abyPixels[i * ui32Bpp + ui32Word + j] << (j * 8);
+						ui32Out |= (IMG_UINT32)abyOnce[i * ui32Bpp + ui32Word + j] << (j * 8);
+					}
+
+					ui32Mask = ((ui32Bits == 32) ? 0xFFFFFFFFU : ((1U << ui32Bits) - 1)) << (ui32Shift % 32);
+
+					if ((ui32In & ui32Mask) != (ui32Out & ui32Mask))
+					{
+						fprintf(stderr, "format %u pixel %u channel %u: %08x, expected %08x\n",
+								ui32Format, i, ui32Channel, ui32Out & ui32Mask, ui32In & ui32Mask);
+						Check(IMG_FALSE, "round trip", "channel changed");
+						i = BL_MAX_SPAN;
+						break;
+					}
+				}
+			}
+		}
+	}
+}
+
+static IMG_VOID TestSmallFloats(IMG_VOID)
+{
+	static const IMG_FLOAT afValues[] = {0.0f, 1.0f, -2.5f, 65504.0f, 70000.0f, 6.1035156e-05f, 5.9604645e-08f, 0.333333f};
+	static const IMG_UINT32 aui32Half[] = {0x0000, 0x3C00, 0xC100, 0x7BFF, 0x7C00, 0x0400, 0x0001, 0x3555};
+	BL_FPIXEL sPixel;
+	IMG_BYTE abyPixel[8];
+	IMG_UINT32 i;
+
+	for (i = 0; i < sizeof(afValues) / sizeof(afValues[0]); i++)
+	{
+		sPixel.fR = afValues[i];
+		sPixel.fG = -afValues[i];
+		sPixel.fB = afValues[i];
+		sPixel.fA = 1.0f;
+
+		BLEncodeSpan(PVRSRV_PIXEL_FORMAT_ABGR16F, &sPixel, 1, abyPixel);
+		Check(Read16(abyPixel) == aui32Half[i], "small floats", "wrong half");
+		Check(Read16(abyPixel + 2) == (aui32Half[i] ^ 0x8000), "small floats", "wrong negative half");
+	}
+
+	/* Unsigned 11 and 10 bit floats clamp negative values to 0 */
+	sPixel.fR = -1.0f;
+	sPixel.fG = 1.0f;
+	sPixel.fB = 0.5f;
+	BLEncodeSpan(PVRSRV_PIXEL_FORMAT_B10G11R11F, &sPixel, 1, abyPixel);
+	Check((Read32(abyPixel) & 0x7FF) == 0, "small floats", "negative unsigned float isn't 0");
+	Check(((Read32(abyPixel) >> 11) & 0x7FF) == (15U << 6), "small floats", "wrong 11 bit float");
+	Check((Read32(abyPixel) >> 22) == (14U << 5), "small floats", "wrong 10 bit float");
+}
+
+/* Copies src to dst through the blitlib and checks every pixel of dst against the reference */
+static IMG_VOID CheckCopy(const IMG_CHAR *pszTest, REF_SURFACE *psSrc, REF_SURFACE *psDst, const IMG_RECT *psRect,
+						  IMG_UINT32 ui32Tolerance)
+{
+	BL_SRC uSrc;
+	BL_DST uDst;
+	BL_OBJECT *psDstObject;
+	IMG_BYTE *pbyBefore = malloc(psDst->ui32Size + 16);
+	IMG_BOOL bOK = IMG_TRUE;
+	IMG_UINT32 ui32X, ui32Y;
+	PVRSRV_ERROR eError;
+
+	memcpy(pbyBefore, psDst->pbyData, psDst->ui32Size);
+
+	psDstObject = MakeDest(&uDst, psDst, psRect, MakeSource(&uSrc, psSrc));
+	eError = BL_OBJECT_START(psDstObject);
+	Check(eError == PVRSRV_OK, pszTest, "blit failed");
+
+	for (ui32Y = 0; ui32Y < psDst->ui32Height && bOK; ui32Y++)
+	{
+		for (ui32X = 0; ui32X < psDst->ui32Width && bOK; ui32X++)
+		{
+			const IMG_BYTE *pbyPixel = RefPixel(psDst, ui32X, ui32Y);
+			IMG_BOOL bInside = ((IMG_INT32)ui32X >= psRect->x0 && (IMG_INT32)ui32X < psRect->x1 &&
+								(IMG_INT32)ui32Y >= psRect->y0 && (IMG_INT32)ui32Y < psRect->y1) ? IMG_TRUE : IMG_FALSE;
+
+			if (!bInside)
+			{
+				REF_SURFACE sBefore = *psDst;
+
+				sBefore.pbyData = pbyBefore;
+				bOK = (memcmp(pbyPixel, RefPixel(&sBefore, ui32X, ui32Y), psDst->ui32BytesPerPixel) == 0) ? IMG_TRUE : IMG_FALSE;
+				if (!bOK)
+				{
+					fprintf(stderr, "(%u, %u) outside the clip rectangle was written\n", ui32X, ui32Y);
+				}
+			}
+			else
+			{
+				/* Pixels beyond the source repeat its edge */
+				const IMG_BYTE *pbySrcPixel = RefPixel(psSrc,
+													   (IMG_UINT32)Clamp((IMG_INT32)ui32X, 0, (IMG_INT32)psSrc->ui32Width - 1),
+													   (IMG_UINT32)Clamp((IMG_INT32)ui32Y, 0, (IMG_INT32)psSrc->ui32Height - 1));
+
+				if (psSrc->eFormat == psDst->eFormat)
+				{
+					bOK = (memcmp(pbyPixel, pbySrcPixel, psDst->ui32BytesPerPixel) == 0) ? IMG_TRUE : IMG_FALSE;
+				}
+				else
+				{
+					IMG_DOUBLE adfPixel[4];
+
+					/* Only ARGB8888 destinations are checked when converting */
+					RefDecode(psSrc->eFormat, pbySrcPixel, adfPixel);
+					bOK = ARGB8888Near(Read32(pbyPixel), RefEncodeARGB8888(adfPixel), ui32Tolerance);
+				}
+
+				if (!bOK)
+				{
+					fprintf(stderr, "(%u, %u) differs from the reference\n", ui32X, ui32Y);
+				}
+			}
+		}
+	}
+
+	Check(bOK, pszTest, "destination differs from the reference");
+
+	free(pbyBefore);
+}
+
+static IMG_VOID TestCopy(IMG_VOID)
+{
+	REF_SURFACE sSrc, sDst;
+	IMG_RECT sRect;
+	BL_SRC uSrc;
+	BL_DST uDst;
+
+	/* Raw copy with a clip rectangle partly outside both surfaces */
+	RefSurfaceCreate(&sSrc, BL_MEMLAYOUT_LINEAR, PVRSRV_PIXEL_FORMAT_ARGB8888, 70, 50);
+	RefSurfaceCreate(&sDst, BL_MEMLAYOUT_LINEAR, PVRSRV_PIXEL_FORMAT_ARGB8888, 200, 60);
+	SetRect(&sRect, -5, -3, 190, 40);
+	CheckCopy("raw copy", &sSrc, &sDst, &sRect, 0);
+	RefSurfaceDestroy(&sDst);
+
+	/* Converting copies */
+	RefSurfaceDestroy(&sSrc);
+	RefSurfaceCreate(&sSrc, BL_MEMLAYOUT_LINEAR, PVRSRV_PIXEL_FORMAT_RGB565, 70, 50);
+	RefSurfaceCreate(&sDst, BL_MEMLAYOUT_LINEAR, PVRSRV_PIXEL_FORMAT_ARGB8888, 80, 60);
+	SetRect(&sRect, 3, 4, 75, 55);
+	CheckCopy("RGB565 to ARGB8888", &sSrc, &sDst, &sRect, 0);
+	RefSurfaceDestroy(&sSrc);
+
+	RefSurfaceCreate(&sSrc, BL_MEMLAYOUT_LINEAR, PVRSRV_PIXEL_FORMAT_A16B16G16R16_UNORM, 70, 50);
+	CheckCopy("A16B16G16R16 to ARGB8888", &sSrc, &sDst, &sRect, 0);
+	RefSurfaceDestroy(&sSrc);
+
+	RefSurfaceCreate(&sSrc, BL_MEMLAYOUT_LINEAR, PVRSRV_PIXEL_FORMAT_A8R8G8B8_UNORM_SRGB, 70, 50);
+	CheckCopy("sRGB to ARGB8888", &sSrc, &sDst, &sRect, 0);
+	RefSurfaceDestroy(&sSrc);
+	RefSurfaceDestroy(&sDst);
+
+	/* Formats without channels are copied but never converted */
+	RefSurfaceCreate(&sSrc, BL_MEMLAYOUT_LINEAR, PVRSRV_PIXEL_FORMAT_D24S8, 40, 30);
+	RefSurfaceCreate(&sDst, BL_MEMLAYOUT_TILED, PVRSRV_PIXEL_FORMAT_D24S8, 64, 40);
+	SetRect(&sRect, 1, 2, 39, 29);
+	CheckCopy("D24S8 copy", &sSrc, &sDst, &sRect, 0);
+	RefSurfaceDestroy(&sDst);
+
+	RefSurfaceCreate(&sDst, BL_MEMLAYOUT_LINEAR, PVRSRV_PIXEL_FORMAT_ARGB8888, 40, 30);
+	Check(BL_OBJECT_START(MakeDest(&uDst, &sDst, &sRect, MakeSource(&uSrc, &sSrc))) == PVRSRV_ERROR_NOT_SUPPORTED,
+		  "D24S8 to ARGB8888", "conversion didn't fail");
+	RefSurfaceDestroy(&sSrc);
+
+	RefSurfaceCreate(&sSrc, BL_MEMLAYOUT_LINEAR, PVRSRV_PIXEL_FORMAT_YUYV, 40, 30);
+	Check(BL_OBJECT_START(MakeDest(&uDst, &sDst, &sRect, MakeSource(&uSrc, &sSrc))) == PVRSRV_ERROR_NOT_SUPPORTED,
+		  "YUYV to ARGB8888", "conversion didn't fail");
+	RefSurfaceDestroy(&sSrc);
+	RefSurfaceDestroy(&sDst);
+}
+
+static IMG_VOID TestLayouts(IMG_VOID)
+{
+	static const struct
+	{
+		BL_MEMLAYOUT	eMemLayout;
+		IMG_UINT32		ui32Width;
+		IMG_UINT32		ui32Height;
+	} asLayouts[] =
+	{
+		{BL_MEMLAYOUT_TWIDDLED, 64, 64},
+		{BL_MEMLAYOUT_TWIDDLED, 128, 16},
+		{BL_MEMLAYOUT_TWIDDLED, 8, 64},
+		{BL_MEMLAYOUT_HYBRID_TWIDDLED, 64, 64},
+		{BL_MEMLAYOUT_HYBRID_TWIDDLED, 40, 24},
+		{BL_MEMLAYOUT_HYBRID_TWIDDLED, 100, 6},
+		{BL_MEMLAYOUT_TILED, 96, 70},
+	};
+	static const PVRSRV_PIXEL_FORMAT aeFormats[] =
+	{
+		PVRSRV_PIXEL_FORMAT_ARGB8888,
+		PVRSRV_PIXEL_FORMAT_RGB565,
+		PVRSRV_PIXEL_FORMAT_A32B32G32R32F,
+	};
+	IMG_UINT32 i, j;
+
+	for (i = 0; i < sizeof(asLayouts) / sizeof(asLayouts[0]); i++)
+	{
+		for (j = 0; j < sizeof(aeFormats) / sizeof(aeFormats[0]); j++)
+		{
+			REF_SURFACE sLinear, sLayout, sBack;
+			IMG_RECT sRect;
+
+			RefSurfaceCreate(&sLinear, BL_MEMLAYOUT_LINEAR, aeFormats[j], asLayouts[i].ui32Width, asLayouts[i].ui32Height);
+			RefSurfaceCreate(&sLayout, asLayouts[i].eMemLayout, aeFormats[j], asLayouts[i].ui32Width, asLayouts[i].ui32Height);
+			RefSurfaceCreate(&sBack, BL_MEMLAYOUT_LINEAR, aeFormats[j], asLayouts[i].ui32Width, asLayouts[i].ui32Height);
+
+			/* Into the layout (a part of it, then all of it) and back out again */
+			SetRect(&sRect, 3, 1, (IMG_INT32)asLayouts[i].ui32Width - 2, (IMG_INT32)asLayouts[i].ui32Height - 1);
+			CheckCopy("write layout", &sLinear, &sLayout, &sRect, 0);
+
+			SetRect(&sRect, 0, 0, (IMG_INT32)asLayouts[i].ui32Width, (IMG_INT32)asLayouts[i].ui32Height);
+			CheckCopy("write layout", &sLinear, &sLayout, &sRect, 0);
+			CheckCopy("read layout", &sLayout, &sBack, &sRect, 0);
+
+			RefSurfaceDestroy(&sLinear);
+			RefSurfaceDestroy(&sLayout);
+			RefSurfaceDestroy(&sBack);
+		}
+	}
+}
+
+static IMG_VOID TestPlanar(IMG_VOID)
+{
+	const IMG_UINT32 ui32Width = 37, ui32Height = 19, ui32Planes = 4;
+	const IMG_UINT32 ui32PlaneSize = ui32Width * ui32Height * 4;
+	IMG_BYTE *pbyPlanar = malloc(ui32PlaneSize * ui32Planes);
+	REF_SURFACE sPacked, sBack;
+	BL_PLANAR_SURFACE_INFO sPlanarInfo;
+	BL_SRC uSrc;
+	BL_DST uDst;
+	IMG_RECT sRect;
+	IMG_UINT32 ui32X, ui32Y, ui32Plane;
+	IMG_BOOL bOK = IMG_TRUE;
+
+	/* A32B32G32R32F as four planes of 32 bit chunks */
+	sPlanarInfo.bIsPlanar = IMG_TRUE;
+	sPlanarInfo.i32ChunkStride = (IMG_INT32)ui32PlaneSize;
+	sPlanarInfo.uiPixelBytesPerPlane = 4;
+	sPlanarInfo.uiNChunks = ui32Planes;
+
+	RandomFill(pbyPlanar, ui32PlaneSize * ui32Planes);
+	RefSurfaceCreate(&sPacked, BL_MEMLAYOUT_LINEAR, PVRSRV_PIXEL_FORMAT_A32B32G32R32F, ui32Width, ui32Height);
+	RefSurfaceCreate(&sBack, BL_MEMLAYOUT_LINEAR, PVRSRV_PIXEL_FORMAT_A32B32G32R32F, ui32Width, ui32Height);
+	SetRect(&sRect, 0, 0, (IMG_INT32)ui32Width, (IMG_INT32)ui32Height);
+
+	BLSRCLinearInit(&uSrc.linear, (IMG_INT32)(ui32Width * 4), ui32Height, PVRSRV_PIXEL_FORMAT_A32B32G32R32F,
+					pbyPlanar, &sPlanarInfo);
+	BLDSTLinearInit(&uDst.linear, sPacked.i32Stride, ui32Height, PVRSRV_PIXEL_FORMAT_A32B32G32R32F,
+					&sRect, sPacked.pbyData, &uSrc.linear.sObject, IMG_NULL);
+	Check(BL_OBJECT_START(&uDst.linear.sObject) == PVRSRV_OK, "planar", "read failed");
+
+	for (ui32Y = 0; ui32Y < ui32Height; ui32Y++)
+	{
+		for (ui32X = 0; ui32X < ui32Width; ui32X++)
+		{
+			for (ui32Plane = 0; ui32Plane < ui32Planes; ui32Plane++)
+			{
+				if (memcmp(RefPixel(&sPacked, ui32X, ui32Y) + ui32Plane * 4,
+						   pbyPlanar + ui32Plane * ui32PlaneSize + (ui32Y * ui32Width + ui32X) * 4, 4) != 0)
+				{
+					bOK = IMG_FALSE;
+				}
+			}
+		}
+	}
+
+	Check(bOK, "planar", "packed pixels differ from the planes");
+
+	/* And back into planes through a twiddled planar destination */
+	memset(pbyPlanar, 0, ui32PlaneSize * ui32Planes);
+
+	{
+		IMG_BYTE *pbyTwiddled = calloc(64 * 32 * 4, ui32Planes);
+		BL_SRC uTwiddledSrc;
+		BL_DST uTwiddledDst;
+
+		sPlanarInfo.i32ChunkStride = 64 * 32 * 4;
+
+		BLSRCLinearInit(&uSrc.linear, sPacked.i32Stride, ui32Height, PVRSRV_PIXEL_FORMAT_A32B32G32R32F,
+						sPacked.pbyData, IMG_NULL);
+		BLDSTTwiddledInit(&uTwiddledDst.twiddled, 64, 32, PVRSRV_PIXEL_FORMAT_A32B32G32R32F, &sRect, pbyTwiddled,
+						  &uSrc.linear.sObject, &sPlanarInfo, IMG_FALSE);
+		Check(BL_OBJECT_START(&uTwiddledDst.twiddled.sObject) == PVRSRV_OK, "planar", "twiddled write failed");
+
+		BLSRCTwiddledInit(&uTwiddledSrc.twiddled, 64, 32, PVRSRV_PIXEL_FORMAT_A32B32G32R32F, pbyTwiddled,
+						  &sPlanarInfo, IMG_FALSE);
+		BLDSTLinearInit(&uDst.linear, sBack.i32Stride, ui32Height, PVRSRV_PIXEL_FORMAT_A32B32G32R32F,
+						&sRect, sBack.pbyData, &uTwiddledSrc.twiddled.sObject, IMG_NULL);
+		Check(BL_OBJECT_START(&uDst.linear.sObject) == PVRSRV_OK, "planar", "twiddled read failed");
+
+		Check(memcmp(sBack.pbyData, sPacked.pbyData, sPacked.ui32Size) == 0, "planar", "twiddled planes differ");
+
+		/* The red plane of pixel (1, 0) is the second twiddled chunk of the first plane (x on the odd bits) */
+		Check(memcmp(pbyTwiddled + 2 * 4, RefPixel(&sPacked, 1, 0), 4) == 0, "planar", "wrong twiddled chunk");
+		Check(memcmp(pbyTwiddled + 64 * 32 * 4 * 3 + 2 * 4, RefPixel(&sPacked, 1, 0) + 12, 4) == 0, "planar", "wrong plane");
+
+		free(pbyTwiddled);
+	}
+
+	RefSurfaceDestroy(&sPacked);
+	RefSurfaceDestroy(&sBack);
+	free(pbyPlanar);
+}
+
+/* Checks a point scale of psSrcRect in psSrc onto psDstRect in psDst */
+static IMG_VOID CheckScaleNearest(const IMG_CHAR *pszTest, REF_SURFACE *psSrc, const IMG_RECT *psSrcRect,
+								  REF_SURFACE *psDst, const IMG_RECT *psDstRect)
+{
+	BL_SRC uSrc;
+	BL_DST uDst;
+	BL_OP_SCALE_NEAREST sScale;
+	IMG_INT32 i32X, i32Y;
+	IMG_BOOL bOK = IMG_TRUE;
+
+	BLOPScaleNearestInit(&sScale, psSrcRect, MakeSource(&uSrc, psSrc));
+	Check(BL_OBJECT_START(MakeDest(&uDst, psDst, psDstRect, &sScale.sObject)) == PVRSRV_OK, pszTest, "blit failed");
+
+	for (i32Y = psDstRect->y0; i32Y < psDstRect->y1 && bOK; i32Y++)
+	{
+		for (i32X = psDstRect->x0; i32X < psDstRect->x1 && bOK; i32X++)
+		{
+			IMG_DOUBLE dfU = (i32X - psDstRect->x0 + 0.5) * (psSrcRect->x1 - psSrcRect->x0) / (psDstRect->x1 - psDstRect->x0);
+			IMG_DOUBLE dfV = (i32Y - psDstRect->y0 + 0.5) * (psSrcRect->y1 - psSrcRect->y0) / (psDstRect->y1 - psDstRect->y0);
+			IMG_UINT32 ui32U = (IMG_UINT32)(psSrcRect->x0 + (IMG_INT32)floor(dfU));
+			IMG_UINT32 ui32V = (IMG_UINT32)(psSrcRect->y0 + (IMG_INT32)floor(dfV));
+			const IMG_BYTE *pbyPixel = RefPixel(psDst, (IMG_UINT32)i32X, (IMG_UINT32)i32Y);
+			const IMG_BYTE *pbySrcPixel = RefPixel(psSrc, ui32U, ui32V);
+
+			if (psSrc->eFormat == psDst->eFormat)
+			{
+				bOK = (memcmp(pbyPixel, pbySrcPixel, psDst->ui32BytesPerPixel) == 0) ? IMG_TRUE : IMG_FALSE;
+			}
+			else
+			{
+				IMG_DOUBLE adfPixel[4];
+
+				RefDecode(psSrc->eFormat, pbySrcPixel, adfPixel);
+				bOK = ARGB8888Near(Read32(pbyPixel), RefEncodeARGB8888(adfPixel), 0);
+			}
+
+			if (!bOK)
+			{
+				fprintf(stderr, "(%d, %d) should be source pixel (%u, %u)\n", i32X, i32Y, ui32U, ui32V);
+			}
+		}
+	}
+
+	Check(bOK, pszTest, "destination differs from the reference");
+}
+
+static IMG_VOID TestScaleNearest(IMG_VOID)
+{
+	REF_SURFACE sSrc, sDst;
+	IMG_RECT sSrcRect, sDstRect;
+
+	RefSurfaceCreate(&sSrc, BL_MEMLAYOUT_LINEAR, PVRSRV_PIXEL_FORMAT_ARGB8888, 37, 23);
+	RefSurfaceCreate(&sDst, BL_MEMLAYOUT_LINEAR, PVRSRV_PIXEL_FORMAT_ARGB8888, 300, 50);
+
+	/* Up */
+	SetRect(&sSrcRect, 2, 1, 35, 23);
+	SetRect(&sDstRect, 3, 2, 290, 47);
+	CheckScaleNearest("point scale up", &sSrc, &sSrcRect, &sDst, &sDstRect);
+	RefSurfaceDestroy(&sSrc);
+
+	/* Down, by more than a span per pixel */
+	RefSurfaceCreate(&sSrc, BL_MEMLAYOUT_TWIDDLED, PVRSRV_PIXEL_FORMAT_ARGB8888, 1024, 256);
+	SetRect(&sSrcRect, 0, 3, 1024, 250);
+	SetRect(&sDstRect, 1, 1, 8, 40);
+	CheckScaleNearest("point scale down", &sSrc, &sSrcRect, &sDst, &sDstRect);
+
+	SetRect(&sDstRect, 0, 0, 300, 50);
+	CheckScaleNearest("point scale down", &sSrc, &sSrcRect, &sDst, &sDstRect);
+	RefSurfaceDestroy(&sSrc);
+
+	/* Converting */
+	RefSurfaceCreate(&sSrc, BL_MEMLAYOUT_LINEAR, PVRSRV_PIXEL_FORMAT_RGB565, 37, 23);
+	SetRect(&sSrcRect, 0, 0, 37, 23);
+	SetRect(&sDstRect, 10, 5, 200, 45);
+	CheckScaleNearest("point scale RGB565", &sSrc, &sSrcRect, &sDst, &sDstRect);
+	RefSurfaceDestroy(&sSrc);
+	RefSurfaceDestroy(&sDst);
+}
+
+static IMG_VOID TestScaleBilinear(IMG_VOID)
+{
+	static const struct
+	{
+		IMG_UINT32	ui32SrcWidth, ui32SrcHeight;
+		IMG_INT32	ai32SrcRect[4];
+		IMG_INT32	ai32DstRect[4];
+	} asCases[] =
+	{
+		{33, 21, {0, 0, 33, 21}, {0, 0, 50, 40}},
+		{33, 21, {4, 2, 30, 20}, {5, 3, 120, 17}},
+		{300, 200, {0, 0, 300, 200}, {0, 0, 41, 23}},
+		{300, 200, {10, 5, 290, 195}, {2, 2, 130, 40}},
+	};
+	IMG_UINT32 i;
+
+	for (i = 0; i < sizeof(asCases) / sizeof(asCases[0]); i++)
+	{
+		REF_SURFACE sSrc, sDst;
+		IMG_RECT sSrcRect, sDstRect;
+		BL_SRC uSrc;
+		BL_DST uDst;
+		BL_OP_SCALE_BILINEAR sScale;
+		IMG_INT32 i32X, i32Y, i32Channel;
+		IMG_UINT32 ui32Pixel;
+		IMG_BOOL bOK = IMG_TRUE;
+
+		RefSurfaceCreate(&sSrc, BL_MEMLAYOUT_LINEAR, PVRSRV_PIXEL_FORMAT_A32B32G32R32F, asCases[i].ui32SrcWidth, asCases[i].ui32SrcHeight);
+		RefSurfaceCreate(&sDst, BL_MEMLAYOUT_LINEAR, PVRSRV_PIXEL_FORMAT_A32B32G32R32F, 140, 50);
+
+		/* Random floats in [0, 1] */
+		for (ui32Pixel = 0; ui32Pixel < sSrc.ui32Size / 4; ui32Pixel++)
+		{
+			IMG_FLOAT fValue = (IMG_FLOAT)(Random32() & 0xFFFF) / 65535.0f;
+
+			memcpy(sSrc.pbyData + ui32Pixel * 4, &fValue, 4);
+		}
+
+		SetRect(&sSrcRect, asCases[i].ai32SrcRect[0], asCases[i].ai32SrcRect[1], asCases[i].ai32SrcRect[2], asCases[i].ai32SrcRect[3]);
+		SetRect(&sDstRect, asCases[i].ai32DstRect[0], asCases[i].ai32DstRect[1], asCases[i].ai32DstRect[2], asCases[i].ai32DstRect[3]);
+
+		BLOPScaleBilinearInit(&sScale, &sSrcRect, MakeSource(&uSrc, &sSrc));
+		Check(BL_OBJECT_START(MakeDest(&uDst, &sDst, &sDstRect, &sScale.sObject)) == PVRSRV_OK, "bilinear scale", "blit failed");
+
+		for (i32Y = sDstRect.y0; i32Y < sDstRect.y1 && bOK; i32Y++)
+		{
+			for (i32X = sDstRect.x0; i32X < sDstRect.x1 && bOK; i32X++)
+			{
+				IMG_INT32 i32SrcW = sSrcRect.x1 - sSrcRect.x0, i32SrcH = sSrcRect.y1 - sSrcRect.y0;
+				IMG_DOUBLE dfU = (i32X - sDstRect.x0 + 0.5) * i32SrcW / (sDstRect.x1 - sDstRect.x0) - 0.5;
+				IMG_DOUBLE dfV = (i32Y - sDstRect.y0 + 0.5) * i32SrcH / (sDstRect.y1 - sDstRect.y0) - 0.5;
+				IMG_INT32 i32U0 = (IMG_INT32)floor(dfU), i32V0 = (IMG_INT32)floor(dfV);
+				IMG_DOUBLE dfFU = dfU - i32U0, dfFV = dfV - i32V0;
+				IMG_INT32 i32UA = sSrcRect.x0 + Clamp(i32U0, 0, i32SrcW - 1), i32UB = sSrcRect.x0 + Clamp(i32U0 + 1, 0, i32SrcW - 1);
+				IMG_INT32 i32VA = sSrcRect.y0 + Clamp(i32V0, 0, i32SrcH - 1), i32VB = sSrcRect.y0 + Clamp(i32V0 + 1, 0, i32SrcH - 1);
+				IMG_FLOAT afTL[4], afTR[4], afBL[4], afBR[4], afOut[4];
+
+				memcpy(afTL, RefPixel(&sSrc, (IMG_UINT32)i32UA, (IMG_UINT32)i32VA), 16);
+				memcpy(afTR, RefPixel(&sSrc, (IMG_UINT32)i32UB, (IMG_UINT32)i32VA), 16);
+				memcpy(afBL, RefPixel(&sSrc, (IMG_UINT32)i32UA, (IMG_UINT32)i32VB), 16);
+				memcpy(afBR, RefPixel(&sSrc, (IMG_UINT32)i32UB, (IMG_UINT32)i32VB), 16);
+				memcpy(afOut, RefPixel(&sDst, (IMG_UINT32)i32X, (IMG_UINT32)i32Y), 16);
+
+				for (i32Channel = 0; i32Channel < 4; i32Channel++)
+				{
+					IMG_DOUBLE dfExpected = (afTL[i32Channel] * (1.0 - dfFU) + afTR[i32Channel] * dfFU) * (1.0 - dfFV) +
+											(afBL[i32Channel] * (1.0 - dfFU) + afBR[i32Channel] * dfFU) * dfFV;
+
+					if (fabs(afOut[i32Channel] - dfExpected) > 1e-5)
+					{
+						fprintf(stderr, "case %u (%d, %d) channel %d: %g, expected %g\n", i, i32X, i32Y, i32Channel, afOut[i32Channel], dfExpected);
+						bOK = IMG_FALSE;
+					}
+				}
+			}
+		}
+
+		Check(bOK, "bilinear scale", "destination differs from the reference");
+
+		RefSurfaceDestroy(&sSrc);
+		RefSurfaceDestroy(&sDst);
+	}
+}
+
+/* The mipmap chain of BlitlibMipgen in sgxtransfer_queue.c: every level is a 2:1 box filter of the one before */
+static IMG_VOID TestMipgen(IMG_VOID)
+{
+	static const BL_MEMLAYOUT aeLayouts[] = {BL_MEMLAYOUT_LINEAR, BL_MEMLAYOUT_TWIDDLED, BL_MEMLAYOUT_HYBRID_TWIDDLED};
+	IMG_UINT32 i;
+
+	for (i = 0; i < sizeof(aeLayouts) / sizeof(aeLayouts[0]); i++)
+	{
+		IMG_UINT32 ui32Width = 64, ui32Height = 32;
+		REF_SURFACE sLevel;
+		IMG_BOOL bOK = IMG_TRUE;
+
+		RefSurfaceCreate(&sLevel, aeLayouts[i], PVRSRV_PIXEL_FORMAT_ARGB8888, ui32Width, ui32Height);
+
+		while (ui32Width > 1 || ui32Height > 1)
+		{
+			IMG_UINT32 ui32NextWidth = (ui32Width > 1) ? ui32Width / 2 : 1;
+			IMG_UINT32 ui32NextHeight = (ui32Height > 1) ? ui32Height / 2 : 1;
+			REF_SURFACE sNext;
+			IMG_RECT sSrcRect, sDstRect;
+			BL_SRC uSrc;
+			BL_DST uDst;
+			BL_OP_SCALE_BILINEAR sScale;
+			IMG_UINT32 ui32X, ui32Y;
+
+			RefSurfaceCreate(&sNext, aeLayouts[i], PVRSRV_PIXEL_FORMAT_ARGB8888, ui32NextWidth, ui32NextHeight);
+
+			SetRect(&sSrcRect, 0, 0, (IMG_INT32)ui32Width, (IMG_INT32)ui32Height);
+			SetRect(&sDstRect, 0, 0, (IMG_INT32)ui32NextWidth, (IMG_INT32)ui32NextHeight);
+
+			BLOPScaleBilinearInit(&sScale, &sSrcRect, MakeSource(&uSrc, &sLevel));
+			Check(BL_OBJECT_START(MakeDest(&uDst, &sNext, &sDstRect, &sScale.sObject)) == PVRSRV_OK, "mipgen", "blit failed");
+
+			for (ui32Y = 0; ui32Y < ui32NextHeight; ui32Y++)
+			{
+				for (ui32X = 0; ui32X < ui32NextWidth; ui32X++)
+				{
+					IMG_UINT32 ui32X0 = (ui32Width > 1) ? ui32X * 2 : 0, ui32X1 = (ui32Width > 1) ? ui32X * 2 + 1 : 0;
+					IMG_UINT32 ui32Y0 = (ui32Height > 1) ? ui32Y * 2 : 0, ui32Y1 = (ui32Height > 1) ? ui32Y * 2 + 1 : 0;
+					IMG_UINT32 aui32Box[4], ui32Expected = 0, ui32Shift, j;
+
+					aui32Box[0] = Read32(RefPixel(&sLevel, ui32X0, ui32Y0));
+					aui32Box[1] = Read32(RefPixel(&sLevel, ui32X1, ui32Y0));
+					aui32Box[2] = Read32(RefPixel(&sLevel, ui32X0, ui32Y1));
+					aui32Box[3] = Read32(RefPixel(&sLevel, ui32X1, ui32Y1));
+
+					for (ui32Shift = 0; ui32Shift < 32; ui32Shift += 8)
+					{
+						IMG_UINT32 ui32Sum = 0;
+
+						for (j = 0; j < 4; j++)
+						{
+							ui32Sum += (aui32Box[j] >> ui32Shift) & 0xFF;
+						}
+						ui32Expected |= ((ui32Sum + 2) / 4) << ui32Shift;
+					}
+
+					if (!ARGB8888Near(Read32(RefPixel(&sNext, ui32X, ui32Y)), ui32Expected, 1))
+					{
+						fprintf(stderr, "layout %u level %ux%u (%u, %u): %08x, expected %08x\n", aeLayouts[i], ui32NextWidth,
+								ui32NextHeight, ui32X, ui32Y, Read32(RefPixel(&sNext, ui32X, ui32Y)), ui32Expected);
+						bOK = IMG_FALSE;
+					}
+				}
+			}
+
+			RefSurfaceDestroy(&sLevel);
+			sLevel = sNext;
+			ui32Width = ui32NextWidth;
+			ui32Height = ui32NextHeight;
+		}
+
+		Check(bOK, "mipgen", "level isn't the box filtered level above");
+
+		RefSurfaceDestroy(&sLevel);
+	}
+}
+
+static IMG_VOID TestFill(IMG_VOID)
+{
+	static const PVRSRV_PIXEL_FORMAT aeFormats[] =
+	{
+		PVRSRV_PIXEL_FORMAT_ARGB8888,
+		PVRSRV_PIXEL_FORMAT_RGB565,
+		PVRSRV_PIXEL_FORMAT_ARGB4444,
+		PVRSRV_PIXEL_FORMAT_A2RGB10,
+		PVRSRV_PIXEL_FORMAT_A8L8,
+		PVRSRV_PIXEL_FORMAT_ABGR16F,
+		PVRSRV_PIXEL_FORMAT_A32B32G32R32F,
+	};
+	IMG_UINT32 ui32Colour = 0x80FF4020;
+	IMG_UINT32 i;
+
+	for (i = 0; i < sizeof(aeFormats) / sizeof(aeFormats[0]); i++)
+	{
+		REF_SURFACE sDst;
+		IMG_RECT sRect;
+		BL_SRC_SOLID sSolid;
+		BL_DST uDst;
+		BL_FPIXEL sColour;
+		IMG_BYTE abyExpected[16];
+		IMG_INT32 i32X, i32Y;
+		IMG_BOOL bOK = IMG_TRUE;
+
+		RefSurfaceCreate(&sDst, BL_MEMLAYOUT_TILED, aeFormats[i], 64, 40);
+		SetRect(&sRect, 5, 7, 60, 39);
+
+		BLSRCSolidInit(&sSolid, (BL_PIXEL *)&ui32Colour, BL_INTERNAL_PX_FMT_ARGB8888, PVRSRV_PIXEL_FORMAT_ARGB8888);
+		Check(BL_OBJECT_START(MakeDest(&uDst, &sDst, &sRect, &sSolid.sObject)) == PVRSRV_OK, "fill", "fill failed");
+
+		/* The colour, rounded to the format */
+		sColour.fR = 255.0f / 255.0f;
+		sColour.fG = 64.0f / 255.0f;
+		sColour.fB = 32.0f / 255.0f;
+		sColour.fA = 128.0f / 255.0f;
+		BLEncodeSpan(aeFormats[i], &sColour, 1, abyExpected);
+
+		for (i32Y = sRect.y0; i32Y < sRect.y1; i32Y++)
+		{
+			for (i32X = sRect.x0; i32X < sRect.x1; i32X++)
+			{
+				if (memcmp(RefPixel(&sDst, (IMG_UINT32)i32X, (IMG_UINT32)i32Y), abyExpected, sDst.ui32BytesPerPixel) != 0)
+				{
+					bOK = IMG_FALSE;
+				}
+			}
+		}
+
+		if (aeFormats[i] == PVRSRV_PIXEL_FORMAT_ARGB8888)
+		{
+			bOK = (bOK && Read32(abyExpected) == ui32Colour) ? IMG_TRUE : IMG_FALSE;
+		}
+		else if (aeFormats[i] == PVRSRV_PIXEL_FORMAT_RGB565)
+		{
+			bOK = (bOK && Read16(abyExpected) == ((31U << 11) | (16U << 5) | 4U)) ? IMG_TRUE : IMG_FALSE;
+		}
+
+		Check(bOK, "fill", "wrong fill colour");
+
+		RefSurfaceDestroy(&sDst);
+	}
+
+	/* A fill can't make pixels of a format without channels */
+	{
+		REF_SURFACE sDst;
+		IMG_RECT sRect;
+		BL_SRC_SOLID sSolid;
+		BL_DST uDst;
+
+		RefSurfaceCreate(&sDst, BL_MEMLAYOUT_LINEAR, PVRSRV_PIXEL_FORMAT_D24S8, 16, 16);
+		SetRect(&sRect, 0, 0, 16, 16);
+		BLSRCSolidInit(&sSolid, (BL_PIXEL *)&ui32Colour, BL_INTERNAL_PX_FMT_ARGB8888, PVRSRV_PIXEL_FORMAT_ARGB8888);
+		Check(BL_OBJECT_START(MakeDest(&uDst, &sDst, &sRect, &sSolid.sObject)) == PVRSRV_ERROR_NOT_SUPPORTED,
+			  "fill", "D24S8 fill didn't fail");
+		RefSurfaceDestroy(&sDst);
+	}
+}
+
+static IMG_VOID TestFlipRotate(IMG_VOID)
+{
+	static const struct
+	{
+		IMG_BOOL	bRotate;
+		IMG_UINT32	ui32Value;
+	} asCases[] =
+	{
+		{IMG_FALSE, BL_OP_FLIP_X},
+		{IMG_FALSE, BL_OP_FLIP_Y},
+		{IMG_FALSE, BL_OP_FLIP_X | BL_OP_FLIP_Y},
+		{IMG_TRUE, BL_OP_ROTATE_90},
+		{IMG_TRUE, BL_OP_ROTATE_180},
+		{IMG_TRUE, BL_OP_ROTATE_270},
+	};
+	static const PVRSRV_PIXEL_FORMAT aeFormats[] = {PVRSRV_PIXEL_FORMAT_ARGB8888, PVRSRV_PIXEL_FORMAT_ARGB4444};
+	IMG_UINT32 i, j;
+
+	for (i = 0; i < sizeof(asCases) / sizeof(asCases[0]); i++)
+	{
+		for (j = 0; j < sizeof(aeFormats) / sizeof(aeFormats[0]); j++)
+		{
+			/* The rectangle at (4, 3); for quarter turns the source is sW x sH at the same origin */
+			const IMG_INT32 i32X0 = 4, i32Y0 = 3, i32SrcW = 150, i32SrcH = 13;
+			IMG_BOOL bQuarter = (asCases[i].bRotate && (asCases[i].ui32Value & 1)) ? IMG_TRUE : IMG_FALSE;
+			IMG_INT32 i32DstW = bQuarter ? i32SrcH : i32SrcW, i32DstH = bQuarter ? i32SrcW : i32SrcH;
+			REF_SURFACE sSrc, sDst;
+			IMG_RECT sRect;
+			BL_SRC uSrc;
+			BL_DST uDst;
+			BL_OP_FLIP sFlip;
+			BL_OP_ROTATE sRotate;
+			BL_OBJECT *psOp;
+			IMG_INT32 i32X, i32Y;
+			IMG_BOOL bOK = IMG_TRUE;
+
+			RefSurfaceCreate(&sSrc, BL_MEMLAYOUT_LINEAR, aeFormats[j], 160, 160);
+			RefSurfaceCreate(&sDst, BL_MEMLAYOUT_LINEAR, PVRSRV_PIXEL_FORMAT_ARGB8888, 160, 160);
+			SetRect(&sRect, i32X0, i32Y0, i32X0 + i32DstW, i32Y0 + i32DstH);
+
+			if (asCases[i].bRotate)
+			{
+				BLOPRotateInit(&sRotate, asCases[i].ui32Value, MakeSource(&uSrc, &sSrc));
+				psOp = &sRotate.sObject;
+			}
+			else
+			{
+				BLOPFlipInit(&sFlip, asCases[i].ui32Value, MakeSource(&uSrc, &sSrc));
+				psOp = &sFlip.sObject;
+			}
+
+			Check(BL_OBJECT_START(MakeDest(&uDst, &sDst, &sRect, psOp)) == PVRSRV_OK, "flip and rotate", "blit failed");
+
+			for (i32Y = 0; i32Y < i32DstH && bOK; i32Y++)
+			{
+				for (i32X = 0; i32X < i32DstW && bOK; i32X++)
+				{
+					IMG_INT32 i32U = i32X, i32V = i32Y;
+					IMG_DOUBLE adfPixel[4];
+
+					if (!asCases[i].bRotate)
+					{
+						i32U = (asCases[i].ui32Value & BL_OP_FLIP_X) ? i32DstW - 1 - i32X : i32X;
+						i32V = (asCases[i].ui32Value & BL_OP_FLIP_Y) ? i32DstH - 1 - i32Y : i32Y;
+					}
+					else if (asCases[i].ui32Value == BL_OP_ROTATE_90)
+					{
+						/* Clockwise: the left column of the source becomes the top row */
+						i32U = i32Y;
+						i32V = i32SrcH - 1 - i32X;
+					}
+					else if (asCases[i].ui32Value == BL_OP_ROTATE_180)
+					{
+						i32U = i32SrcW - 1 - i32X;
+						i32V = i32SrcH - 1 - i32Y;
+					}
+					else
+					{
+						i32U = i32SrcW - 1 - i32Y;
+						i32V = i32X;
+					}
+
+					RefDecode(aeFormats[j], RefPixel(&sSrc, (IMG_UINT32)(i32X0 + i32U), (IMG_UINT32)(i32Y0 + i32V)), adfPixel);
+
+					if (Read32(RefPixel(&sDst, (IMG_UINT32)(i32X0 + i32X), (IMG_UINT32)(i32Y0 + i32Y))) != RefEncodeARGB8888(adfPixel))
+					{
+						fprintf(stderr, "case %u format %u (%d, %d) should be source pixel (%d, %d)\n", i, aeFormats[j], i32X, i32Y, i32U, i32V);
+						bOK = IMG_FALSE;
+					}
+				}
+			}
+
+			Check(bOK, "flip and rotate", "destination differs from the reference");
+
+			RefSurfaceDestroy(&sSrc);
+			RefSurfaceDestroy(&sDst);
+		}
+	}
+}
+
+/* Alpha blending and colour keying, set up as BlitlibBlit sets them up: the back is a copy of the destination */
+static IMG_VOID TestBlendAndKey(IMG_VOID)
+{
+	REF_SURFACE sFront, sBack, sDst;
+	BL_SRC uFront, uBack;
+	BL_DST uDst;
+	BL_OP_ALPHA_BLEND sAlpha;
+	BL_OP_COLOUR_KEY sKey;
+	IMG_RECT sRect;
+	IMG_UINT32 ui32Key = 0x00FF00FF, ui32Mask = 0x00FFFFFF, ui32NoMask = 0;
+	IMG_UINT32 ui32X, ui32Y;
+	IMG_BOOL bOK = IMG_TRUE;
+
+	RefSurfaceCreate(&sFront, BL_MEMLAYOUT_LINEAR, PVRSRV_PIXEL_FORMAT_ARGB8888, 90, 30);
+	RefSurfaceCreate(&sBack, BL_MEMLAYOUT_LINEAR, PVRSRV_PIXEL_FORMAT_ARGB8888, 90, 30);
+	RefSurfaceCreate(&sDst, BL_MEMLAYOUT_LINEAR, PVRSRV_PIXEL_FORMAT_ARGB8888, 90, 30);
+	SetRect(&sRect, 0, 0, 90, 30);
+
+	/* Alpha */
+	BLOPAlphaBlendInit(&sAlpha, 64 / 255.0, MakeSource(&uFront, &sFront), MakeSource(&uBack, &sBack));
+	Check(BL_OBJECT_START(MakeDest(&uDst, &sDst, &sRect, &sAlpha.sObject)) == PVRSRV_OK, "alpha blend", "blit failed");
+
+	for (ui32Y = 0; ui32Y < 30; ui32Y++)
+	{
+		for (ui32X = 0; ui32X < 90; ui32X++)
+		{
+			IMG_DOUBLE adfFront[4], adfBack[4], adfExpected[4];
+			IMG_UINT32 i;
+
+			RefDecode(PVRSRV_PIXEL_FORMAT_ARGB8888, RefPixel(&sFront, ui32X, ui32Y), adfFront);
+			RefDecode(PVRSRV_PIXEL_FORMAT_ARGB8888, RefPixel(&sBack, ui32X, ui32Y), adfBack);
+
+			for (i = 0; i < 4; i++)
+			{
+				adfExpected[i] = adfFront[i] * (64 / 255.0) + adfBack[i] * (1.0 - 64 / 255.0);
+			}
+
+			if (!ARGB8888Near(Read32(RefPixel(&sDst, ui32X, ui32Y)), RefEncodeARGB8888(adfExpected), 1))
+			{
+				bOK = IMG_FALSE;
+			}
+		}
+	}
+
+	Check(bOK, "alpha blend", "destination differs from the reference");
+
+	/* Colour key, ignoring alpha: key a third of the front pixels */
+	for (ui32Y = 0; ui32Y < 30; ui32Y++)
+	{
+		for (ui32X = 0; ui32X < 90; ui32X += 3)
+		{
+			Write32(RefPixel(&sFront, ui32X, ui32Y), (Random32() & 0xFF000000U) | ui32Key);
+		}
+	}
+
+	BLOPColourKeyInit(&sKey, (BL_PIXEL *)&ui32Key, (BL_PIXEL *)&ui32Mask, BL_INTERNAL_PX_FMT_ARGB8888,
+					  MakeSource(&uFront, &sFront), MakeSource(&uBack, &sBack));
+	Check(BL_OBJECT_START(MakeDest(&uDst, &sDst, &sRect, &sKey.sObject)) == PVRSRV_OK, "colour key", "blit failed");
+
+	for (ui32Y = 0, bOK = IMG_TRUE; ui32Y < 30; ui32Y++)
+	{
+		for (ui32X = 0; ui32X < 90; ui32X++)
+		{
+			IMG_UINT32 ui32Front = Read32(RefPixel(&sFront, ui32X, ui32Y));
+			IMG_UINT32 ui32Expected = ((ui32Front & ui32Mask) == ui32Key) ? Read32(RefPixel(&sBack, ui32X, ui32Y)) : ui32Front;
+
+			if (Read32(RefPixel(&sDst, ui32X, ui32Y)) != ui32Expected)
+			{
+				bOK = IMG_FALSE;
+			}
+		}
+	}
+
+	Check(bOK, "colour key", "destination differs from the reference");
+
+	/* No mask compares alpha too, so (almost) nothing matches the key's alpha of 0 */
+	BLOPColourKeyInit(&sKey, (BL_PIXEL *)&ui32Key, (BL_PIXEL *)&ui32NoMask, BL_INTERNAL_PX_FMT_ARGB8888,
+					  MakeSource(&uFront, &sFront), MakeSource(&uBack, &sBack));
+	Check(BL_OBJECT_START(MakeDest(&uDst, &sDst, &sRect, &sKey.sObject)) == PVRSRV_OK, "colour key", "blit failed");
+
+	for (ui32Y = 0, bOK = IMG_TRUE; ui32Y < 30; ui32Y++)
+	{
+		for (ui32X = 0; ui32X < 90; ui32X++)
+		{
+			IMG_UINT32 ui32Front = Read32(RefPixel(&sFront, ui32X, ui32Y));
+			IMG_UINT32 ui32Expected = (ui32Front == ui32Key) ? Read32(RefPixel(&sBack, ui32X, ui32Y)) : ui32Front;
+
+			if (Read32(RefPixel(&sDst, ui32X, ui32Y)) != ui32Expected)
+			{
+				bOK = IMG_FALSE;
+			}
+		}
+	}
+
+	Check(bOK, "colour key", "destination differs from the reference without a mask");
+
+	RefSurfaceDestroy(&sFront);
+	RefSurfaceDestroy(&sBack);
+	RefSurfaceDestroy(&sDst);
+}
+
+/* A clip blit: one pipeline started once per rectangle, as BlitlibClipBlit does */
+static IMG_VOID TestClipBlit(IMG_VOID)
+{
+	REF_SURFACE sSrc, sDst;
+	BL_SRC uSrc;
+	BL_DST uDst;
+	BL_OBJECT *psDst;
+	IMG_RECT sRect, asClip[3];
+	IMG_BYTE *pbyBefore;
+	IMG_UINT32 ui32X, ui32Y, i;
+	IMG_BOOL bOK = IMG_TRUE;
+
+	RefSurfaceCreate(&sSrc, BL_MEMLAYOUT_LINEAR, PVRSRV_PIXEL_FORMAT_RGB565, 100, 60);
+	RefSurfaceCreate(&sDst, BL_MEMLAYOUT_LINEAR, PVRSRV_PIXEL_FORMAT_RGB565, 100, 60);
+	pbyBefore = malloc(sDst.ui32Size);
+	memcpy(pbyBefore, sDst.pbyData, sDst.ui32Size);
+
+	SetRect(&sRect, 0, 0, 100, 60);
+	SetRect(&asClip[0], 0, 0, 10, 10);
+	SetRect(&asClip[1], 50, 20, 100, 30);
+	SetRect(&asClip[2], 95, 55, 120, 70);
+
+	psDst = MakeDest(&uDst, &sDst, &sRect, MakeSource(&uSrc, &sSrc));
+
+	for (i = 0; i < 3; i++)
+	{
+		uDst.linear.sClipRect = asClip[i];
+		Check(BL_OBJECT_START(psDst) == PVRSRV_OK, "clip blit", "blit failed");
+	}
+
+	for (ui32Y = 0; ui32Y < 60; ui32Y++)
+	{
+		for (ui32X = 0; ui32X < 100; ui32X++)
+		{
+			IMG_BOOL bInside = IMG_FALSE;
+
+			for (i = 0; i < 3; i++)
+			{
+				if ((IMG_INT32)ui32X >= asClip[i].x0 && (IMG_INT32)ui32X < asClip[i].x1 &&
+					(IMG_INT32)ui32Y >= asClip[i].y0 && (IMG_INT32)ui32Y < asClip[i].y1)
+				{
+					bInside = IMG_TRUE;
+				}
+			}
+
+			if (Read16(RefPixel(&sDst, ui32X, ui32Y)) != Read16((bInside ? sSrc.pbyData : pbyBefore) + (ui32Y * 100 + ui32X) * 2))
+			{
+				bOK = IMG_FALSE;
+			}
+		}
+	}
+
+	Check(bOK, "clip blit", "destination differs from the reference");
+
+	free(pbyBefore);
+	RefSurfaceDestroy(&sSrc);
+	RefSurfaceDestroy(&sDst);
+}
+
+static IMG_VOID BenchmarkBlit(const IMG_CHAR *pszName, BL_OBJECT *psDst, IMG_UINT32 ui32Pixels)
+{
+	IMG_DOUBLE dfStart, dfTime;
+	IMG_UINT32 ui32Runs = 0;
+
+	dfStart = GetTimeMs();
+
+	do
+	{
+		BL_OBJECT_START(psDst);
+		ui32Runs++;
+		dfTime = GetTimeMs() - dfStart;
+	} while (dfTime < 500.0);
+
+	printf("%-32s %8.1f Mpixel/s\n", pszName, (IMG_DOUBLE)ui32Pixels * ui32Runs / (dfTime * 1000.0));
+}
+
+static IMG_VOID Benchmark(IMG_UINT32 ui32Size)
+{
+	REF_SURFACE sSrc, sSrc565, sDst, sTwiddled;
+	BL_SRC uSrc;
+	BL_DST uDst;
+	BL_SRC_SOLID sSolid;
+	BL_OP_SCALE_NEAREST sNearest;
+	BL_OP_SCALE_BILINEAR sBilinear;
+	IMG_RECT sRect, sHalf;
+	IMG_UINT32 ui32Colour = 0xFF808080;
+	IMG_UINT32 ui32Pixels = ui32Size * ui32Size;
+
+	RefSurfaceCreate(&sSrc, BL_MEMLAYOUT_LINEAR, PVRSRV_PIXEL_FORMAT_ARGB8888, ui32Size, ui32Size);
+	RefSurfaceCreate(&sSrc565, BL_MEMLAYOUT_LINEAR, PVRSRV_PIXEL_FORMAT_RGB565, ui32Size, ui32Size);
+	RefSurfaceCreate(&sDst, BL_MEMLAYOUT_LINEAR, PVRSRV_PIXEL_FORMAT_ARGB8888, ui32Size, ui32Size);
+	RefSurfaceCreate(&sTwiddled, BL_MEMLAYOUT_TWIDDLED, PVRSRV_PIXEL_FORMAT_ARGB8888, ui32Size, ui32Size);
+	SetRect(&sRect, 0, 0, (IMG_INT32)ui32Size, (IMG_INT32)ui32Size);
+	SetRect(&sHalf, 0, 0, (IMG_INT32)ui32Size / 2, (IMG_INT32)ui32Size / 2);
+
+	BenchmarkBlit("ARGB8888 copy", MakeDest(&uDst, &sDst, &sRect, MakeSource(&uSrc, &sSrc)), ui32Pixels);
+	BenchmarkBlit("ARGB8888 to twiddled", MakeDest(&uDst, &sTwiddled, &sRect, MakeSource(&uSrc, &sSrc)), ui32Pixels);
+	BenchmarkBlit("RGB565 to ARGB8888", MakeDest(&uDst, &sDst, &sRect, MakeSource(&uSrc, &sSrc565)), ui32Pixels);
+
+	BLSRCSolidInit(&sSolid, (BL_PIXEL *)&ui32Colour, BL_INTERNAL_PX_FMT_ARGB8888, PVRSRV_PIXEL_FORMAT_ARGB8888);
+	BenchmarkBlit("ARGB8888 fill", MakeDest(&uDst, &sDst, &sRect, &sSolid.sObject), ui32Pixels);
+
+	BLOPScaleNearestInit(&sNearest, &sHalf, MakeSource(&uSrc, &sSrc));
+	BenchmarkBlit("ARGB8888 point scale 2x up", MakeDest(&uDst, &sDst, &sRect, &sNearest.sObject), ui32Pixels);
+
+	BLOPScaleBilinearInit(&sBilinear, &sRect, MakeSource(&uSrc, &sSrc));
+	BenchmarkBlit("ARGB8888 box filter (mipgen)", MakeDest(&uDst, &sDst, &sHalf, &sBilinear.sObject), ui32Pixels / 4);
+
+	RefSurfaceDestroy(&sSrc);
+	RefSurfaceDestroy(&sSrc565);
+	RefSurfaceDestroy(&sDst);
+	RefSurfaceDestroy(&sTwiddled);
+}
+
+static IMG_VOID Usage(IMG_VOID)
+{
+	fprintf(stderr, "usage: blitlibtest [-b [-s size]]\n");
+	fprintf(stderr, "  -b       benchmark instead of testing\n");
+	fprintf(stderr, "  -s size  benchmark surface size (default 1024)\n");
+}
+
+int main(int argc, char **argv)
+{
+	IMG_BOOL bBenchmark = IMG_FALSE;
+	IMG_UINT32 ui32Size = 1024;
+	int i;
+
+	for (i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-b") == 0)
+		{
+			bBenchmark = IMG_TRUE;
+		}
+		else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+		{
+			ui32Size = (IMG_UINT32)strtoul(argv[i + 1], IMG_NULL, 0);
+
+			if (ui32Size < 2 || ui32Size > 8192 || (ui32Size & (ui32Size - 1)))
+			{
+				Usage();
+				return 1;
+			}
+
+			i++;
+		}
+		else
+		{
+			Usage();
+			return 1;
+		}
+	}
+
+	if (bBenchmark)
+	{
+		Benchmark(ui32Size);
+		return 0;
+	}
+
+	TestFormatTable();
+	TestDecode();
+	TestRoundTrip();
+	TestSmallFloats();
+	TestCopy();
+	TestLayouts();
+	TestPlanar();
+	TestScaleNearest();
+	TestScaleBilinear();
+	TestMipgen();
+	TestFill();
+	TestFlipRotate();
+	TestBlendAndKey();
+	TestClipBlit();
+
+	if (ui32Failures)
+	{
+		fprintf(stderr, "%u checks failed\n", ui32Failures);
+		return 1;
+	}
+
+	printf("All blitlib tests passed\n");
+
+	return 0;
+}
+
+/******************************************************************************
+ End of file (main.c)
+******************************************************************************/
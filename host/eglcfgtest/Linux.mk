@@ -0,0 +1,37 @@
+# Copyright	2010 Imagination Technologies Limited. All rights reserved.
+#
+# No part of this software, either material or conceptual may be
+# copied or distributed, transmitted, transcribed, stored in a
+# retrieval system or translated into any human or computer
+# language in any form by any means, electronic, mechanical,
+# manual or other-wise, or disclosed to third parties without
+# the express written permission of: Imagination Technologies
+# Limited, HomePark Industrial Estate, Kings Langley,
+# Hertfordshire, WD4 8LZ, UK
+#
+# $Log: Linux.mk $
+#
+
+modules := eglcfgtest
+
+eglcfgtest_type := host_executable
+
+eglcfgtest_target := eglcfgtest
+
+eglcfgtest_src = \
+ main.c \
+ $(TOP)/eurasiacon/imgegl/imgegl/cfg.c \
+ $(TOP)/eurasiacon/imgegl/imgegl/cfg_core.c \
+ $(TOP)/eurasiacon/imgegl/imgegl/cfg_index.c \
+ $(TOP)/eurasiacon/imgegl/imgegl/qsort_s.c
+
+# The config code is built as for the device with the API modules
+# checked at runtime, as the driver is; main.c stands in for the EGL
+# globals and the services pixel format table, and host/include comes
+# first so the shared stand-in SDK headers are used.
+eglcfgtest_cflags := -D__psp2__ -D'__declspec(x)=' -DIMGEGL_MODULE \
+ -DAPI_MODULES_RUNTIME_CHECKED -DSUPPORT_SGX -DSUPPORT_SGX543
+
+eglcfgtest_includes := host/include include4 include/gpu_es4 hwdefs \
+ include eurasiacon/imgegl/imgegl eurasiacon/include eurasiacon/common \
+ codegen/pds codegen/pixevent common/tls
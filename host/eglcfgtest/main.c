@@ -0,0 +1,748 @@
+/******************************************************************************
+ * Name         : main.c
+ * Title        : EGL config selection tests (eglcfgtest)
+ *
+ * Copyright    : 2011 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means, electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Description  : Checks the config selection index
+ *                (eurasiacon/imgegl/imgegl/cfg_index.c) against the way
+ *                eglChooseConfig selected configs before it: generate every
+ *                config, filter with CFG_Match and sort with CFG_Compare.
+ *
+ *                Displays with several window system config tables are
+ *                set up with every combination of API modules present,
+ *                and queried with every single attribute and value the
+ *                configs take (and their neighbours), every pair of the
+ *                commonly requested ones, and random lists with repeats,
+ *                ignored attributes and config IDs. Each list is queried
+ *                twice, the second answered from the memo, and with its
+ *                pairs reversed; the count, the configs and their order
+ *                must match, whole and truncated.
+ *
+ *                Exits with a non-zero status if a check fails; -v also
+ *                times typical queries both ways.
+ *
+ * Modifications:-
+ * $Log: main.c $
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "egl_internal.h"
+#include "tls.h"
+#include "srv.h"
+#include "cfg.h"
+#include "cfg_index.h"
+#include "qsort.h"
+#include "hosttest.h"
+
+#define TEST_MAX_CONFIGS		512
+#define TEST_MAX_VALUES			48
+#define TEST_MAX_PAIRS			12
+#define TEST_RANDOM_LISTS		400
+#define TEST_BENCH_QUERIES		2000
+
+typedef struct _ATTRIB_VALUES_
+{
+	IMG_UINT32	ui32NumValues;
+	EGLint		aiValues[TEST_MAX_VALUES];
+} ATTRIB_VALUES;
+
+static const EGLint aiAttribs[] =
+{
+#define A(N,D,C) N,
+#include "attrib.h"
+#undef A
+};
+
+static const EGLint aiDefaults[] =
+{
+#define A(N,D,C) D,
+#include "attrib.h"
+#undef A
+};
+
+/* The attributes applications usually ask for, queried in pairs */
+static const EGLint aiPairAttribs[] =
+{
+	EGL_BUFFER_SIZE,
+	EGL_RED_SIZE,
+	EGL_GREEN_SIZE,
+	EGL_ALPHA_SIZE,
+	EGL_DEPTH_SIZE,
+	EGL_STENCIL_SIZE,
+	EGL_SAMPLE_BUFFERS,
+	EGL_SAMPLES,
+	EGL_SURFACE_TYPE,
+	EGL_RENDERABLE_TYPE,
+	EGL_CONFORMANT,
+	EGL_CONFIG_ID,
+	EGL_TRANSPARENT_TYPE,
+	EGL_LEVEL
+};
+
+/* Listable attributes CFG_Match ignores */
+static const EGLint aiIgnoredAttribs[] =
+{
+	EGL_MAX_PBUFFER_WIDTH,
+	EGL_MAX_PBUFFER_HEIGHT,
+	EGL_MAX_PBUFFER_PIXELS,
+	EGL_NATIVE_VISUAL_ID
+};
+
+#define NUM_ATTRIBS			(sizeof(aiAttribs) / sizeof(aiAttribs[0]))
+#define NUM_PAIR_ATTRIBS	(sizeof(aiPairAttribs) / sizeof(aiPairAttribs[0]))
+#define NUM_IGNORED_ATTRIBS	(sizeof(aiIgnoredAttribs) / sizeof(aiIgnoredAttribs[0]))
+
+/* Window system configs */
+static const WSEGLConfig asWSConfigsMixed[] =
+{
+	{ WSEGL_DRAWABLE_WINDOW | WSEGL_DRAWABLE_PIXMAP, WSEGL_PIXELFORMAT_ARGB8888, 0, 0, 0, 0, WSEGL_OPAQUE, 0 },
+	{ WSEGL_DRAWABLE_WINDOW, WSEGL_PIXELFORMAT_RGB565, 0, 0, 1, 0, WSEGL_OPAQUE, 0 },
+	{ WSEGL_DRAWABLE_PIXMAP, WSEGL_PIXELFORMAT_XRGB8888, 1, 0, 2, 0, WSEGL_OPAQUE, 0 },
+	{ WSEGL_DRAWABLE_WINDOW, WSEGL_PIXELFORMAT_ARGB4444, 0, 1, 3, 0, WSEGL_OPAQUE, 0 },
+	{ WSEGL_DRAWABLE_WINDOW, WSEGL_PIXELFORMAT_ARGB1555, 0, 0, 4, 0, WSEGL_COLOR_KEY, 0x102030 },
+	{ WSEGL_DRAWABLE_WINDOW | WSEGL_DRAWABLE_PIXMAP, WSEGL_PIXELFORMAT_ABGR8888, 0, 0, 7, 0, WSEGL_OPAQUE, 0 },
+	{ WSEGL_NO_DRAWABLE, WSEGL_PIXELFORMAT_RGB565, 0, 0, 0, 0, WSEGL_OPAQUE, 0 }
+};
+
+static const WSEGLConfig asWSConfigsSingle[] =
+{
+	{ WSEGL_DRAWABLE_WINDOW, WSEGL_PIXELFORMAT_ARGB8888, 0, 0, 0, 0, WSEGL_OPAQUE, 0 },
+	{ WSEGL_NO_DRAWABLE, WSEGL_PIXELFORMAT_RGB565, 0, 0, 0, 0, WSEGL_OPAQUE, 0 }
+};
+
+#define TEST_RANDOM_WS_CONFIGS	16
+
+static WSEGLConfig asWSConfigsRandom[TEST_RANDOM_WS_CONFIGS + 1];
+
+static EGLGlobal sGlobal;
+static KEGL_DISPLAY sDpy;
+static IMG_BOOL bVerbose = IMG_FALSE;
+static IMG_UINT32 ui32Lists = 0;
+
+/* As eurasiacon/imgegl/imgegl/srv.c */
+IMG_INTERNAL const SRVPixelFormat gasSRVPixelFormat[] =
+{
+	{ 0, 0, 0, 0, 0  }, /* 0  PVRSRV_PIXEL_FORMAT_UNKNOWN */
+	{ 0, 5, 6, 5, 16 }, /* 1  PVRSRV_PIXEL_FORMAT_RGB565 */
+	{ 0, 5, 5, 5, 16 }, /* 2  PVRSRV_PIXEL_FORMAT_RGB555 */
+	{ 0, 8, 8, 8, 24 }, /* 3  PVRSRV_PIXEL_FORMAT_RGB888 */
+	{ 0, 8, 8, 8, 24 }, /* 4  PVRSRV_PIXEL_FORMAT_BGR888 */
+	{ 0, 0, 0, 0, 0  }, /* 5  Unused */
+	{ 0, 0, 0, 0, 0  }, /* 6  Unused */
+	{ 0, 0, 0, 0, 0  }, /* 7  Unused */
+	{ 0, 0, 0, 0, 0  }, /* 8  PVRSRV_PIXEL_FORMAT_GREY_SCALE */
+	{ 0, 0, 0, 0, 0  }, /* 9  Unused */
+	{ 0, 0, 0, 0, 0  }, /* 10 Unused */
+	{ 0, 0, 0, 0, 0  }, /* 11 Unused */
+	{ 0, 0, 0, 0, 0  }, /* 12 Unused */
+	{ 0, 0, 0, 0, 0  }, /* 13 PVRSRV_PIXEL_FORMAT_PAL12 */
+	{ 0, 0, 0, 0, 0  }, /* 14 PVRSRV_PIXEL_FORMAT_PAL8 */
+	{ 0, 0, 0, 0, 0  }, /* 15 PVRSRV_PIXEL_FORMAT_PAL4 */
+	{ 0, 0, 0, 0, 0  }, /* 16 PVRSRV_PIXEL_FORMAT_PAL2 */
+	{ 0, 0, 0, 0, 0  }, /* 17 PVRSRV_PIXEL_FORMAT_PAL1 */
+	{ 1, 5, 5, 5, 16 }, /* 18 PVRSRV_PIXEL_FORMAT_ARGB1555 */
+	{ 4, 4, 4, 4, 16 }, /* 19 PVRSRV_PIXEL_FORMAT_ARGB4444 */
+	{ 8, 8, 8, 8, 32 }, /* 20 PVRSRV_PIXEL_FORMAT_ARGB8888 */
+	{ 8, 8, 8, 8, 32 }, /* 21 PVRSRV_PIXEL_FORMAT_ABGR8888 */
+	{ 0, 0, 0, 0, 0  }, /* 22 PVRSRV_PIXEL_FORMAT_YV12 */
+	{ 0, 0, 0, 0, 0  }, /* 23 PVRSRV_PIXEL_FORMAT_I420 */
+	{ 0, 0, 0, 0, 0  }, /* 24 Unused */
+	{ 0, 0, 0, 0, 0  }, /* 25 PVRSRV_PIXEL_FORMAT_IMC2 */
+	{ 0, 8, 8, 8, 32 }, /* 26 PVRSRV_PIXEL_FORMAT_XRGB8888 */
+	{ 0, 8, 8, 8, 32 }  /* 27 PVRSRV_PIXEL_FORMAT_XBGR8888 */
+};
+
+IMG_INTERNAL IMG_VOID *ENV_GetGlobalData(IMG_VOID)
+{
+	return &sGlobal;
+}
+
+static IMG_UINT64 TimeNs(IMG_VOID)
+{
+	struct timespec sTime;
+
+	clock_gettime(CLOCK_MONOTONIC, &sTime);
+
+	return (IMG_UINT64)sTime.tv_sec * 1000000000 + (IMG_UINT64)sTime.tv_nsec;
+}
+
+/* eglChooseConfig before the index: every config generated, matched and sorted */
+static EGLint ReferenceChooseConfig(const EGLint *piList, EGLint iCount, EGLint *piConfigIDs, EGLint *piNumConfigs)
+{
+	KEGL_CONFIG *apsMatches[TEST_MAX_CONFIGS];
+	KEGL_CONFIG *psRequest;
+	EGLint iVariants = CFG_Variants(&sDpy);
+	EGLint iMatches = 0;
+	EGLint i;
+
+	psRequest = CFG_PrepareConfigFilter(piList, iCount);
+
+	if (!psRequest)
+	{
+		return EGL_BAD_ATTRIBUTE;
+	}
+
+	for (i = 1; i <= iVariants; i++)
+	{
+		KEGL_CONFIG *psCfg;
+
+		if (CFG_GenerateVariant(&sDpy, i, &psCfg) != EGL_SUCCESS)
+		{
+			while (iMatches)
+			{
+				CFGC_Unlink(apsMatches[--iMatches]);
+			}
+
+			CFGC_Unlink(psRequest);
+
+			return EGL_BAD_ALLOC;
+		}
+
+		if (CFG_Match(psRequest, psCfg))
+		{
+			apsMatches[iMatches++] = psCfg;
+		}
+		else
+		{
+			CFGC_Unlink(psCfg);
+		}
+	}
+
+	PVR_qsort_s(apsMatches, iMatches, sizeof(apsMatches[0]), CFG_Compare, psRequest);
+
+	CFGC_Unlink(psRequest);
+
+	for (i = 0; i < iMatches; i++)
+	{
+		piConfigIDs[i] = CFGC_GetAttrib(apsMatches[i], EGL_CONFIG_ID);
+
+		CFGC_Unlink(apsMatches[i]);
+	}
+
+	*piNumConfigs = iMatches;
+
+	return EGL_SUCCESS;
+}
+
+static IMG_VOID DescribeList(const EGLint *piList, EGLint iCount, IMG_CHAR *pszBuf, IMG_UINT32 ui32Size)
+{
+	IMG_UINT32 ui32Used = 0;
+	EGLint i;
+
+	pszBuf[0] = '\0';
+
+	for (i = 0; i < iCount && ui32Used + 24 < ui32Size; i += 2)
+	{
+		ui32Used += (IMG_UINT32)sprintf(pszBuf + ui32Used, "%s0x%x=%d", i ? " " : "", piList[i], piList[i + 1]);
+	}
+}
+
+/* Queries the index with a list, whole, counted and truncated, and checks it against the reference */
+static IMG_VOID CheckQuery(CFGI_INDEX *psIndex, const EGLint *piList, EGLint iCount, const IMG_CHAR *pszTest)
+{
+	EGLint aiExpected[TEST_MAX_CONFIGS];
+	EGLConfig ahConfigs[TEST_MAX_CONFIGS];
+	EGLint iExpected, iGot, iError, iSize;
+	IMG_CHAR szWhat[512];
+	EGLint i;
+
+	ui32Lists++;
+
+	iError = ReferenceChooseConfig(piList, iCount, aiExpected, &iExpected);
+	Check(iError == EGL_SUCCESS, pszTest, "reference query failed");
+
+	DescribeList(piList, iCount, szWhat, sizeof(szWhat) - 64);
+	strcat(szWhat, ": number of configs");
+
+	iError = CFGI_ChooseConfig(psIndex, piList, iCount, IMG_NULL, 0, &iGot);
+	CheckCount((IMG_UINT32)iError, EGL_SUCCESS, pszTest, "count query error");
+	CheckCount((IMG_UINT32)iGot, (IMG_UINT32)iExpected, pszTest, szWhat);
+
+	iError = CFGI_ChooseConfig(psIndex, piList, iCount, ahConfigs, TEST_MAX_CONFIGS, &iGot);
+	CheckCount((IMG_UINT32)iError, EGL_SUCCESS, pszTest, "query error");
+	CheckCount((IMG_UINT32)iGot, (IMG_UINT32)iExpected, pszTest, szWhat);
+
+	for (i = 0; i < iGot && i < iExpected; i++)
+	{
+		if ((EGLint)(IMG_UINTPTR_T)ahConfigs[i] != aiExpected[i])
+		{
+			DescribeList(piList, iCount, szWhat, sizeof(szWhat) - 64);
+			sprintf(szWhat + strlen(szWhat), ": config %d", i);
+			CheckCount((IMG_UINT32)(IMG_UINTPTR_T)ahConfigs[i], (IMG_UINT32)aiExpected[i], pszTest, szWhat);
+			break;
+		}
+	}
+
+	/* Truncated, as by an application asking for the best few */
+	iSize = iExpected ? (EGLint)(Random() % (IMG_UINT32)iExpected) : 0;
+
+	iError = CFGI_ChooseConfig(psIndex, piList, iCount, ahConfigs, iSize, &iGot);
+	CheckCount((IMG_UINT32)iError, EGL_SUCCESS, pszTest, "truncated query error");
+	CheckCount((IMG_UINT32)iGot, (IMG_UINT32)iSize, pszTest, "truncated number of configs");
+
+	for (i = 0; i < iGot; i++)
+	{
+		if ((EGLint)(IMG_UINTPTR_T)ahConfigs[i] != aiExpected[i])
+		{
+			Check(IMG_FALSE, pszTest, "truncated configs differ");
+			break;
+		}
+	}
+}
+
+/* Checks a list, and the list with its pairs reversed */
+static IMG_VOID CheckList(CFGI_INDEX *psIndex, const EGLint *piList, EGLint iCount, const IMG_CHAR *pszTest)
+{
+	EGLint aiReversed[TEST_MAX_PAIRS * 2 + 1];
+	EGLint i;
+
+	CheckQuery(psIndex, piList, iCount, pszTest);
+
+	for (i = 0; i < iCount; i += 2)
+	{
+		aiReversed[iCount - 2 - i] = piList[i];
+		aiReversed[iCount - 1 - i] = piList[i + 1];
+	}
+	aiReversed[iCount] = EGL_NONE;
+
+	CheckQuery(psIndex, aiReversed, iCount, pszTest);
+}
+
+/* The values configs take for each attribute, their neighbours, and don't care */
+static IMG_VOID CollectValues(ATTRIB_VALUES *psValues)
+{
+	EGLint iVariants = CFG_Variants(&sDpy);
+	IMG_UINT32 i, j, k;
+
+	for (i = 0; i < NUM_ATTRIBS; i++)
+	{
+		psValues[i].ui32NumValues = 0;
+	}
+
+	for (k = 0; k <= (IMG_UINT32)iVariants; k++)
+	{
+		KEGL_CONFIG *psCfg = IMG_NULL;
+
+		if (k && CFG_GenerateVariant(&sDpy, (EGLint)k, &psCfg) != EGL_SUCCESS)
+		{
+			Check(IMG_FALSE, "values", "generating a config failed");
+			return;
+		}
+
+		for (i = 0; i < NUM_ATTRIBS; i++)
+		{
+			ATTRIB_VALUES *psAttrib = &psValues[i];
+			EGLint aiCandidates[4];
+
+			if (k)
+			{
+				EGLint iValue = CFGC_GetAttrib(psCfg, aiAttribs[i]);
+
+				aiCandidates[0] = iValue;
+				aiCandidates[1] = iValue - 1;
+				aiCandidates[2] = iValue + 1;
+				aiCandidates[3] = iValue & ~(iValue - 1);
+			}
+			else
+			{
+				aiCandidates[0] = EGL_DONT_CARE;
+				aiCandidates[1] = 0;
+				aiCandidates[2] = aiDefaults[i];
+				aiCandidates[3] = iVariants + 1;
+			}
+
+			for (j = 0; j < 4; j++)
+			{
+				IMG_UINT32 l;
+
+				for (l = 0; l < psAttrib->ui32NumValues && psAttrib->aiValues[l] != aiCandidates[j]; l++);
+
+				if (l == psAttrib->ui32NumValues && l < TEST_MAX_VALUES)
+				{
+					psAttrib->aiValues[psAttrib->ui32NumValues++] = aiCandidates[j];
+				}
+			}
+		}
+
+		if (psCfg)
+		{
+			CFGC_Unlink(psCfg);
+		}
+	}
+}
+
+static IMG_UINT32 AttribNumber(EGLint iAttrib)
+{
+	IMG_UINT32 i;
+
+	for (i = 0; i < NUM_ATTRIBS && aiAttribs[i] != iAttrib; i++);
+
+	return i;
+}
+
+static IMG_VOID TestEmptyLists(CFGI_INDEX *psIndex)
+{
+	static const EGLint aiEmpty[] = { EGL_NONE };
+
+	CheckQuery(psIndex, IMG_NULL, 0, "empty list");
+	CheckQuery(psIndex, aiEmpty, 0, "empty list");
+}
+
+static IMG_VOID TestSingles(CFGI_INDEX *psIndex, const ATTRIB_VALUES *psValues)
+{
+	IMG_UINT32 i, j;
+
+	for (i = 0; i < NUM_ATTRIBS; i++)
+	{
+		for (j = 0; j < psValues[i].ui32NumValues; j++)
+		{
+			EGLint aiList[3];
+
+			aiList[0] = aiAttribs[i];
+			aiList[1] = psValues[i].aiValues[j];
+			aiList[2] = EGL_NONE;
+
+			CheckQuery(psIndex, aiList, 2, "single attribute");
+		}
+	}
+}
+
+static IMG_VOID TestPairs(CFGI_INDEX *psIndex, const ATTRIB_VALUES *psValues)
+{
+	IMG_UINT32 i, j, k, l;
+
+	for (i = 0; i < NUM_PAIR_ATTRIBS; i++)
+	{
+		const ATTRIB_VALUES *psA = &psValues[AttribNumber(aiPairAttribs[i])];
+
+		for (j = i + 1; j < NUM_PAIR_ATTRIBS; j++)
+		{
+			const ATTRIB_VALUES *psB = &psValues[AttribNumber(aiPairAttribs[j])];
+
+			for (k = 0; k < psA->ui32NumValues; k++)
+			{
+				for (l = 0; l < psB->ui32NumValues; l++)
+				{
+					EGLint aiList[5];
+
+					aiList[0] = aiPairAttribs[i];
+					aiList[1] = psA->aiValues[k];
+					aiList[2] = aiPairAttribs[j];
+					aiList[3] = psB->aiValues[l];
+					aiList[4] = EGL_NONE;
+
+					CheckQuery(psIndex, aiList, 4, "attribute pair");
+				}
+			}
+		}
+	}
+}
+
+static IMG_VOID TestRandomLists(CFGI_INDEX *psIndex, const ATTRIB_VALUES *psValues)
+{
+	IMG_UINT32 i, j;
+
+	for (i = 0; i < TEST_RANDOM_LISTS; i++)
+	{
+		EGLint aiList[TEST_MAX_PAIRS * 2 + 1];
+		IMG_UINT32 ui32Pairs = 1 + Random() % TEST_MAX_PAIRS;
+
+		for (j = 0; j < ui32Pairs; j++)
+		{
+			IMG_UINT32 ui32Kind = Random() % 16;
+
+			if (ui32Kind == 0)
+			{
+				/* Ignored by the match */
+				aiList[j * 2] = aiIgnoredAttribs[Random() % NUM_IGNORED_ATTRIBS];
+				aiList[j * 2 + 1] = (EGLint)(Random() % 5) - 1;
+			}
+			else if (ui32Kind == 1 && j)
+			{
+				/* Repeated, with another value */
+				IMG_UINT32 ui32Attrib = AttribNumber(aiList[(Random() % j) * 2]);
+
+				if (ui32Attrib == NUM_ATTRIBS)
+				{
+					ui32Attrib = Random() % NUM_ATTRIBS;
+				}
+
+				aiList[j * 2] = aiAttribs[ui32Attrib];
+				aiList[j * 2 + 1] = psValues[ui32Attrib].aiValues[Random() % psValues[ui32Attrib].ui32NumValues];
+			}
+			else
+			{
+				/* Mostly the attributes applications ask for */
+				IMG_UINT32 ui32Attrib = (ui32Kind < 10) ? AttribNumber(aiPairAttribs[Random() % NUM_PAIR_ATTRIBS]) :
+														  Random() % NUM_ATTRIBS;
+
+				aiList[j * 2] = aiAttribs[ui32Attrib];
+				aiList[j * 2 + 1] = psValues[ui32Attrib].aiValues[Random() % psValues[ui32Attrib].ui32NumValues];
+			}
+		}
+		aiList[ui32Pairs * 2] = EGL_NONE;
+
+		CheckList(psIndex, aiList, (EGLint)ui32Pairs * 2, "random list");
+	}
+}
+
+/* Sets up the display with a window system config table and the API modules present */
+static IMG_VOID SetupDisplay(const WSEGLConfig *psConfigs, IMG_UINT32 ui32Apis, IMG_UINT32 ui32MaxSwapInterval)
+{
+	memset(&sDpy, 0, sizeof(sDpy));
+
+	sDpy.psConfigs = (WSEGLConfig *)psConfigs;
+	while (psConfigs[sDpy.ui32NumConfigs].ui32DrawableType != WSEGL_NO_DRAWABLE)
+	{
+		sDpy.ui32NumConfigs++;
+	}
+	sDpy.ui32MinSwapInterval = 1;
+	sDpy.ui32MaxSwapInterval = ui32MaxSwapInterval;
+
+	memset(sGlobal.bApiModuleDetected, 0, sizeof(sGlobal.bApiModuleDetected));
+	sGlobal.bApiModuleDetected[IMGEGL_CONTEXT_OPENGLES1] = (ui32Apis & 1) ? IMG_TRUE : IMG_FALSE;
+	sGlobal.bApiModuleDetected[IMGEGL_CONTEXT_OPENVG] = (ui32Apis & 2) ? IMG_TRUE : IMG_FALSE;
+	sGlobal.bApiModuleDetected[IMGEGL_CONTEXT_OPENGLES2] = (ui32Apis & 4) ? IMG_TRUE : IMG_FALSE;
+	sGlobal.bApiModuleDetected[IMGEGL_CONTEXT_OPENGL] = (ui32Apis & 8) ? IMG_TRUE : IMG_FALSE;
+
+	CFG_Initialise();
+}
+
+static IMG_VOID RandomWSConfigs(IMG_VOID)
+{
+	static const WSEGLPixelFormat aePixelFormats[] =
+	{
+		WSEGL_PIXELFORMAT_RGB565, WSEGL_PIXELFORMAT_ARGB4444, WSEGL_PIXELFORMAT_ARGB8888,
+		WSEGL_PIXELFORMAT_ARGB1555, WSEGL_PIXELFORMAT_ABGR8888, WSEGL_PIXELFORMAT_XBGR8888,
+		WSEGL_PIXELFORMAT_XRGB8888
+	};
+	IMG_UINT32 i;
+
+	for (i = 0; i < TEST_RANDOM_WS_CONFIGS; i++)
+	{
+		WSEGLConfig *psConfig = &asWSConfigsRandom[i];
+
+		memset(psConfig, 0, sizeof(*psConfig));
+		psConfig->ui32DrawableType = 1 + Random() % 3;
+		psConfig->ePixelFormat = aePixelFormats[Random() % (sizeof(aePixelFormats) / sizeof(aePixelFormats[0]))];
+		psConfig->ulNativeRenderable = Random() & 1;
+		psConfig->ulFrameBufferLevel = (Random() % 4) ? 0 : 1;
+		psConfig->ulNativeVisualID = Random() % 4;
+		if (!(Random() % 4))
+		{
+			psConfig->eTransparentType = WSEGL_COLOR_KEY;
+			psConfig->ulTransparentColor = (Random() % 2) ? 0xFF00FF : 0x000000;
+		}
+	}
+
+	memset(&asWSConfigsRandom[i], 0, sizeof(asWSConfigsRandom[i]));
+	asWSConfigsRandom[i].ui32DrawableType = WSEGL_NO_DRAWABLE;
+}
+
+static IMG_VOID TestDisplays(IMG_VOID)
+{
+	static ATTRIB_VALUES asValues[NUM_ATTRIBS];
+	IMG_UINT32 ui32Table, ui32Apis;
+
+	RandomWSConfigs();
+
+	for (ui32Table = 0; ui32Table < 3; ui32Table++)
+	{
+		const WSEGLConfig *psConfigs = (ui32Table == 0) ? asWSConfigsMixed :
+									   (ui32Table == 1) ? asWSConfigsSingle : asWSConfigsRandom;
+
+		for (ui32Apis = 0; ui32Apis < 16; ui32Apis++)
+		{
+			CFGI_INDEX *psIndex;
+			IMG_UINT32 ui32ListsBefore = ui32Lists;
+
+			SetupDisplay(psConfigs, ui32Apis, 1 + ui32Apis % 3);
+
+			if (CFG_Variants(&sDpy) > TEST_MAX_CONFIGS)
+			{
+				Check(IMG_FALSE, "displays", "too many configs for the test");
+				continue;
+			}
+
+			psIndex = CFGI_Create(&sDpy);
+
+			/*
+				With the OpenGL module present CFG_Initialise counts more configs
+				than cfg.c builds, so eglChooseConfig has always failed with
+				EGL_BAD_ALLOC; it still must.
+			*/
+			if (!psIndex)
+			{
+				EGLint aiConfigIDs[TEST_MAX_CONFIGS];
+				EGLint iNum;
+
+				CheckCount((IMG_UINT32)ReferenceChooseConfig(IMG_NULL, 0, aiConfigIDs, &iNum), EGL_BAD_ALLOC,
+						   "displays", "query without an index");
+				continue;
+			}
+
+			CheckCount(psIndex->ui32NumConfigs, (IMG_UINT32)CFG_Variants(&sDpy), "displays", "indexed configs");
+
+			CollectValues(asValues);
+
+			TestEmptyLists(psIndex);
+			TestSingles(psIndex, asValues);
+			TestRandomLists(psIndex, asValues);
+
+			/* Pairs take a while: only with every API that has configs present */
+			if (ui32Apis == 7)
+			{
+				TestPairs(psIndex, asValues);
+			}
+
+			CFGI_Destroy(psIndex);
+
+			if (bVerbose)
+			{
+				printf("%-28s ws table %u, apis 0x%x: %3d configs, %u lists\n", "displays",
+					   ui32Table, ui32Apis, CFG_Variants(&sDpy), ui32Lists - ui32ListsBefore);
+			}
+		}
+	}
+}
+
+static IMG_VOID Benchmark(IMG_VOID)
+{
+	static const EGLint aiLists[][13] =
+	{
+		{ EGL_NONE },
+		{ EGL_RED_SIZE, 5, EGL_GREEN_SIZE, 6, EGL_BLUE_SIZE, 5, EGL_NONE },
+		{ EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_ALPHA_SIZE, 8, EGL_DEPTH_SIZE, 24, EGL_NONE },
+		{ EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT, EGL_SURFACE_TYPE, EGL_WINDOW_BIT, EGL_DEPTH_SIZE, 16, EGL_NONE },
+		{ EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT, EGL_SAMPLE_BUFFERS, 1, EGL_SAMPLES, 4, EGL_NONE },
+		{ EGL_RENDERABLE_TYPE, EGL_OPENGL_ES_BIT, EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_NONE },
+		{ EGL_RENDERABLE_TYPE, EGL_OPENVG_BIT, EGL_ALPHA_MASK_SIZE, 8, EGL_NONE },
+		{ EGL_SURFACE_TYPE, EGL_PIXMAP_BIT, EGL_NONE },
+		{ EGL_CONFIG_ID, 5, EGL_NONE },
+		{ EGL_STENCIL_SIZE, 8, EGL_ALPHA_SIZE, 1, EGL_NONE },
+		{ EGL_CONFORMANT, EGL_OPENGL_ES2_BIT, EGL_BUFFER_SIZE, 32, EGL_NONE },
+		{ EGL_LEVEL, 1, EGL_NONE }
+	};
+	const IMG_UINT32 ui32NumLists = sizeof(aiLists) / sizeof(aiLists[0]);
+	EGLint aiConfigIDs[TEST_MAX_CONFIGS];
+	EGLConfig ahConfigs[TEST_MAX_CONFIGS];
+	CFGI_INDEX *psIndex;
+	IMG_UINT64 ui64StartNs, ui64BuildNs, ui64ReferenceNs, ui64MissNs, ui64HitNs;
+	EGLint iNum;
+	IMG_UINT32 i;
+
+	SetupDisplay(asWSConfigsMixed, 7, 1);
+
+	ui64StartNs = TimeNs();
+	psIndex = CFGI_Create(&sDpy);
+	ui64BuildNs = TimeNs() - ui64StartNs;
+
+	Check(psIndex != IMG_NULL, "benchmark", "index creation failed");
+
+	if (!psIndex)
+	{
+		return;
+	}
+
+	ui64StartNs = TimeNs();
+	for (i = 0; i < TEST_BENCH_QUERIES; i++)
+	{
+		const EGLint *piList = aiLists[i % ui32NumLists];
+		EGLint iCount;
+
+		for (iCount = 0; piList[iCount] != EGL_NONE; iCount += 2);
+
+		ReferenceChooseConfig(piList, iCount, aiConfigIDs, &iNum);
+	}
+	ui64ReferenceNs = TimeNs() - ui64StartNs;
+
+	/* More lists than memo entries, taken in turn: every query misses */
+	ui64StartNs = TimeNs();
+	for (i = 0; i < TEST_BENCH_QUERIES; i++)
+	{
+		const EGLint *piList = aiLists[i % ui32NumLists];
+		EGLint iCount;
+
+		for (iCount = 0; piList[iCount] != EGL_NONE; iCount += 2);
+
+		CFGI_ChooseConfig(psIndex, piList, iCount, ahConfigs, TEST_MAX_CONFIGS, &iNum);
+	}
+	ui64MissNs = TimeNs() - ui64StartNs;
+
+	/* Each list asked for repeatedly, as applications do */
+	ui64StartNs = TimeNs();
+	for (i = 0; i < TEST_BENCH_QUERIES; i++)
+	{
+		const EGLint *piList = aiLists[(i * ui32NumLists) / TEST_BENCH_QUERIES];
+		EGLint iCount;
+
+		for (iCount = 0; piList[iCount] != EGL_NONE; iCount += 2);
+
+		CFGI_ChooseConfig(psIndex, piList, iCount, ahConfigs, TEST_MAX_CONFIGS, &iNum);
+	}
+	ui64HitNs = TimeNs() - ui64StartNs;
+
+	CFGI_Destroy(psIndex);
+
+	if (bVerbose)
+	{
+		printf("%-28s %d configs: index built in %lluus\n", "benchmark", CFG_Variants(&sDpy),
+			   (unsigned long long)(ui64BuildNs / 1000));
+		printf("%-28s generate, match and sort %7lluns/query\n", "benchmark",
+			   (unsigned long long)(ui64ReferenceNs / TEST_BENCH_QUERIES));
+		printf("%-28s index, not memoised      %7lluns/query (%llux)\n", "benchmark",
+			   (unsigned long long)(ui64MissNs / TEST_BENCH_QUERIES),
+			   (unsigned long long)(ui64MissNs ? ui64ReferenceNs / ui64MissNs : 0));
+		printf("%-28s index, memoised          %7lluns/query (%llux)\n", "benchmark",
+			   (unsigned long long)(ui64HitNs / TEST_BENCH_QUERIES),
+			   (unsigned long long)(ui64HitNs ? ui64ReferenceNs / ui64HitNs : 0));
+	}
+}
+
+int main(int argc, char **argv)
+{
+	if ((argc == 2) && (strcmp(argv[1], "-v") == 0))
+	{
+		bVerbose = IMG_TRUE;
+	}
+	else if (argc != 1)
+	{
+		fprintf(stderr, "Usage: %s [-v]\n", argv[0]);
+		return 2;
+	}
+
+	TestDisplays();
+	Benchmark();
+
+	if (bVerbose)
+	{
+		printf("%-28s %u lists checked\n", "total", ui32Lists);
+	}
+
+	if (ui32Failures)
+	{
+		printf("%u checks failed\n", ui32Failures);
+		return 1;
+	}
+
+	printf("all checks passed\n");
+	return 0;
+}
+
+/******************************************************************************
+ End of file (main.c)
+******************************************************************************/
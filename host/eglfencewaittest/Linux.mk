@@ -0,0 +1,33 @@
+# Copyright	2010 Imagination Technologies Limited. All rights reserved.
+#
+# No part of this software, either material or conceptual may be
+# copied or distributed, transmitted, transcribed, stored in a
+# retrieval system or translated into any human or computer
+# language in any form by any means, electronic, mechanical,
+# manual or other-wise, or disclosed to third parties without
+# the express written permission of: Imagination Technologies
+# Limited, HomePark Industrial Estate, Kings Langley,
+# Hertfordshire, WD4 8LZ, UK
+#
+# $Log: Linux.mk $
+#
+
+modules := eglfencewaittest
+
+eglfencewaittest_type := host_executable
+
+eglfencewaittest_target := eglfencewaittest
+
+eglfencewaittest_src = \
+ main.c \
+ $(TOP)/eurasiacon/imgegl/imgegl/egl_fencewait.c
+
+# egl_fencewait.c is built as for the device, so services.h wraps the
+# kernel semaphores; main.c implements them, and host/include comes
+# first so the shared stand-in SDK headers are used.
+eglfencewaittest_cflags := -D__psp2__
+
+eglfencewaittest_includes := host/include include4 include/gpu_es4 \
+ eurasiacon/imgegl/imgegl
+
+eglfencewaittest_extlibs := pthread
@@ -0,0 +1,848 @@
+/******************************************************************************
+ * Name         : main.c
+ * Title        : EGL fence wait tests (eglfencewaittest)
+ *
+ * Copyright    : 2010 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means, electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Description  : Runs EGL's fence waiter
+ *                (eurasiacon/imgegl/imgegl/egl_fencewait.c) against a mock
+ *                sync object backend: a device thread completes ops at set
+ *                times, raising the op completion event each time, and a
+ *                fence is complete once its op has. Threads wait on fences
+ *                with and without timeouts, alone and together, and the
+ *                tests check that each wait returns the right result, how
+ *                long after the fence completed it woke (wake-up latency),
+ *                that a timed out wait lasted its timeout, the CPU time
+ *                the waiting threads used, and that waiters on one fence
+ *                had only one thread blocked on the event at a time.
+ *
+ *                The services mutex and the kernel semaphores services.h
+ *                wraps are implemented with pthreads. Exits with a
+ *                non-zero status if a check fails; -v prints the measured
+ *                latencies and CPU use, next to a waiter which polls the
+ *                fence as EGL used to.
+ *
+ * Modifications:-
+ * $Log: main.c $
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "img_types.h"
+#include "img_defs.h"
+#include "services.h"
+#include "kernel.h"
+#include "egl_fencewait.h"
+#include "hosttest.h"
+
+/* Most a wait may wake after its fence completes, or overrun its timeout */
+#define TEST_LATENCY_LIMIT_US	10000
+
+/* Most CPU time a blocked waiter may use, in percent of the time it waits */
+#define TEST_CPU_LIMIT_PERCENT	20
+
+#define TEST_MAX_OPS			16
+#define TEST_MAX_WAITERS		8
+#define TEST_MAX_SEMAPHORES		8
+#define TEST_FOREVER			EGL_FENCE_WAIT_FOREVER
+
+typedef struct _MOCK_DEVICE_
+{
+	pthread_mutex_t	sMutex;
+	pthread_cond_t	sEvent;
+
+	/* Ops completed, and op completion events raised */
+	IMG_UINT32		ui32OpsComplete;
+	IMG_UINT32		ui32Signals;
+
+	/* When the ops are to complete, and when they did */
+	IMG_UINT32		ui32NumOps;
+	IMG_UINT64		aui64OpDelayUs[TEST_MAX_OPS];
+	IMG_UINT64		aui64OpCompleteUs[TEST_MAX_OPS];
+
+	/* What the waiters did */
+	IMG_UINT32		ui32Queries;
+	IMG_UINT32		ui32EventWaits;
+	IMG_UINT32		ui32EventWaiters;
+	IMG_UINT32		ui32MaxEventWaiters;
+} MOCK_DEVICE;
+
+/* A fence completes with the device's ui32Op'th op */
+typedef struct _MOCK_FENCE_
+{
+	IMG_UINT32		ui32Op;
+} MOCK_FENCE;
+
+typedef struct _MOCK_SEMAPHORE_
+{
+	IMG_BOOL		bUsed;
+	IMG_INT32		i32Count;
+	pthread_mutex_t	sMutex;
+	pthread_cond_t	sCond;
+} MOCK_SEMAPHORE;
+
+typedef struct _WAITER_
+{
+	EGL_FENCE_WAIT	*psWait;
+	MOCK_FENCE		*psFence;
+	IMG_UINT64		ui64TimeoutNs;
+	IMG_UINT32		ui32StartDelayUs;
+	IMG_BOOL		bPoll;
+
+	IMG_BOOL		bComplete;
+	IMG_UINT64		ui64StartUs;
+	IMG_UINT64		ui64EndUs;
+	IMG_UINT64		ui64CpuUs;
+
+	pthread_t		hThread;
+} WAITER;
+
+static MOCK_DEVICE sDevice;
+static MOCK_SEMAPHORE asSemaphores[TEST_MAX_SEMAPHORES];
+static pthread_mutex_t sSemaphoreTableMutex = PTHREAD_MUTEX_INITIALIZER;
+static IMG_UINT64 ui64RoundStartUs;
+static __thread IMG_UINT32 ui32SeenSignals;
+static IMG_BOOL bVerbose = IMG_FALSE;
+
+static IMG_UINT64 TimeUs(clockid_t eClock)
+{
+	struct timespec sTime;
+
+	clock_gettime(eClock, &sTime);
+
+	return (IMG_UINT64)sTime.tv_sec * 1000000 + (IMG_UINT64)sTime.tv_nsec / 1000;
+}
+
+static IMG_VOID AbsTime(IMG_UINT64 ui64Us, struct timespec *psTime)
+{
+	psTime->tv_sec = (time_t)(ui64Us / 1000000);
+	psTime->tv_nsec = (long)(ui64Us % 1000000) * 1000;
+}
+
+/*****************************************************************************
+ Services and kernel calls egl_fencewait.c links against
+*****************************************************************************/
+
+PVRSRV_ERROR IMG_CALLCONV PVRSRVCreateMutex(PVRSRV_MUTEX_HANDLE *phMutex)
+{
+	pthread_mutex_t *psMutex = malloc(sizeof(*psMutex));
+
+	if (!psMutex)
+	{
+		return PVRSRV_ERROR_OUT_OF_MEMORY;
+	}
+
+	pthread_mutex_init(psMutex, IMG_NULL);
+	*phMutex = (PVRSRV_MUTEX_HANDLE)psMutex;
+
+	return PVRSRV_OK;
+}
+
+PVRSRV_ERROR IMG_CALLCONV PVRSRVDestroyMutex(PVRSRV_MUTEX_HANDLE hMutex)
+{
+	pthread_mutex_destroy((pthread_mutex_t *)hMutex);
+	free(hMutex);
+
+	return PVRSRV_OK;
+}
+
+IMG_VOID IMG_CALLCONV PVRSRVLockMutex(PVRSRV_MUTEX_HANDLE hMutex)
+{
+	pthread_mutex_lock((pthread_mutex_t *)hMutex);
+}
+
+IMG_VOID IMG_CALLCONV PVRSRVUnlockMutex(PVRSRV_MUTEX_HANDLE hMutex)
+{
+	pthread_mutex_unlock((pthread_mutex_t *)hMutex);
+}
+
+SceUID sceKernelCreateSema(const char *pName, SceUInt32 attr, SceInt32 initCount, SceInt32 maxCount, void *pOptParam)
+{
+	SceUID i;
+
+	PVR_UNREFERENCED_PARAMETER(pName);
+	PVR_UNREFERENCED_PARAMETER(attr);
+	PVR_UNREFERENCED_PARAMETER(maxCount);
+	PVR_UNREFERENCED_PARAMETER(pOptParam);
+
+	pthread_mutex_lock(&sSemaphoreTableMutex);
+
+	for (i = 0; i < TEST_MAX_SEMAPHORES; i++)
+	{
+		if (!asSemaphores[i].bUsed)
+		{
+			asSemaphores[i].bUsed = IMG_TRUE;
+			asSemaphores[i].i32Count = initCount;
+			pthread_mutex_init(&asSemaphores[i].sMutex, IMG_NULL);
+			pthread_cond_init(&asSemaphores[i].sCond, IMG_NULL);
+			break;
+		}
+	}
+
+	pthread_mutex_unlock(&sSemaphoreTableMutex);
+
+	/* Ids start at 1 */
+	return (i < TEST_MAX_SEMAPHORES) ? i + 1 : -1;
+}
+
+int sceKernelDeleteSema(SceUID semaId)
+{
+	MOCK_SEMAPHORE *psSemaphore = &asSemaphores[semaId - 1];
+
+	pthread_mutex_lock(&sSemaphoreTableMutex);
+
+	pthread_mutex_destroy(&psSemaphore->sMutex);
+	pthread_cond_destroy(&psSemaphore->sCond);
+	psSemaphore->bUsed = IMG_FALSE;
+
+	pthread_mutex_unlock(&sSemaphoreTableMutex);
+
+	return SCE_OK;
+}
+
+int sceKernelWaitSema(SceUID semaId, SceInt32 needCount, SceUInt32 *pTimeout)
+{
+	MOCK_SEMAPHORE *psSemaphore = &asSemaphores[semaId - 1];
+	struct timespec sDeadline;
+	int iResult = SCE_OK;
+
+	if (pTimeout)
+	{
+		AbsTime(TimeUs(CLOCK_REALTIME) + *pTimeout, &sDeadline);
+	}
+
+	pthread_mutex_lock(&psSemaphore->sMutex);
+
+	while (psSemaphore->i32Count < needCount)
+	{
+		if (!pTimeout)
+		{
+			pthread_cond_wait(&psSemaphore->sCond, &psSemaphore->sMutex);
+		}
+		else if (pthread_cond_timedwait(&psSemaphore->sCond, &psSemaphore->sMutex, &sDeadline) == ETIMEDOUT)
+		{
+			if (psSemaphore->i32Count < needCount)
+			{
+				iResult = (int)SCE_KERNEL_ERROR_WAIT_TIMEOUT;
+			}
+			break;
+		}
+	}
+
+	if (iResult == SCE_OK)
+	{
+		psSemaphore->i32Count -= needCount;
+	}
+
+	pthread_mutex_unlock(&psSemaphore->sMutex);
+
+	return iResult;
+}
+
+int sceKernelSignalSema(SceUID semaId, SceInt32 signalCount)
+{
+	MOCK_SEMAPHORE *psSemaphore = &asSemaphores[semaId - 1];
+
+	pthread_mutex_lock(&psSemaphore->sMutex);
+
+	psSemaphore->i32Count += signalCount;
+	pthread_cond_broadcast(&psSemaphore->sCond);
+
+	pthread_mutex_unlock(&psSemaphore->sMutex);
+
+	return SCE_OK;
+}
+
+static IMG_INT32 SemaphoreCount(PVRSRV_SEMAPHORE_HANDLE hSemaphore)
+{
+	MOCK_SEMAPHORE *psSemaphore = &asSemaphores[(SceUID)(IMG_UINTPTR_T)hSemaphore - 1];
+	IMG_INT32 i32Count;
+
+	pthread_mutex_lock(&psSemaphore->sMutex);
+	i32Count = psSemaphore->i32Count;
+	pthread_mutex_unlock(&psSemaphore->sMutex);
+
+	return i32Count;
+}
+
+/*****************************************************************************
+ Mock sync object backend
+*****************************************************************************/
+
+static IMG_BOOL MockIsComplete(IMG_VOID *pvFence)
+{
+	MOCK_FENCE *psFence = (MOCK_FENCE *)pvFence;
+	IMG_BOOL bComplete;
+
+	pthread_mutex_lock(&sDevice.sMutex);
+
+	sDevice.ui32Queries++;
+	bComplete = (IMG_BOOL)(sDevice.ui32OpsComplete >= psFence->ui32Op);
+
+	pthread_mutex_unlock(&sDevice.sMutex);
+
+	return bComplete;
+}
+
+/* Like the services event, each thread sees every event raised after it starts */
+static IMG_VOID MockWaitEvent(IMG_VOID *pvFence, IMG_UINT32 ui32TimeoutUs)
+{
+	struct timespec sDeadline;
+
+	PVR_UNREFERENCED_PARAMETER(pvFence);
+
+	AbsTime(TimeUs(CLOCK_REALTIME) + ui32TimeoutUs, &sDeadline);
+
+	pthread_mutex_lock(&sDevice.sMutex);
+
+	sDevice.ui32EventWaits++;
+	sDevice.ui32EventWaiters++;
+	if (sDevice.ui32EventWaiters > sDevice.ui32MaxEventWaiters)
+	{
+		sDevice.ui32MaxEventWaiters = sDevice.ui32EventWaiters;
+	}
+
+	while (sDevice.ui32Signals == ui32SeenSignals)
+	{
+		if (pthread_cond_timedwait(&sDevice.sEvent, &sDevice.sMutex, &sDeadline) == ETIMEDOUT)
+		{
+			break;
+		}
+	}
+
+	ui32SeenSignals = sDevice.ui32Signals;
+	sDevice.ui32EventWaiters--;
+
+	pthread_mutex_unlock(&sDevice.sMutex);
+}
+
+static IMG_UINT64 MockClockus(IMG_VOID)
+{
+	return TimeUs(CLOCK_MONOTONIC);
+}
+
+static const EGL_FENCE_WAIT_OPS sMockOps =
+{
+	MockIsComplete,
+	MockWaitEvent,
+	MockClockus
+};
+
+static IMG_VOID MockThreadStart(IMG_VOID)
+{
+	pthread_mutex_lock(&sDevice.sMutex);
+	ui32SeenSignals = sDevice.ui32Signals;
+	pthread_mutex_unlock(&sDevice.sMutex);
+}
+
+static IMG_VOID MockReset(IMG_VOID)
+{
+	sDevice.ui32OpsComplete = 0;
+	sDevice.ui32NumOps = 0;
+	sDevice.ui32Queries = 0;
+	sDevice.ui32EventWaits = 0;
+	sDevice.ui32EventWaiters = 0;
+	sDevice.ui32MaxEventWaiters = 0;
+}
+
+/* Op n completes ui64DelayUs into the round */
+static IMG_VOID MockAddOp(IMG_UINT64 ui64DelayUs)
+{
+	sDevice.aui64OpDelayUs[sDevice.ui32NumOps++] = ui64DelayUs;
+}
+
+static IMG_VOID *DeviceThread(IMG_VOID *pvArg)
+{
+	IMG_UINT32 i;
+
+	PVR_UNREFERENCED_PARAMETER(pvArg);
+
+	for (i = 0; i < sDevice.ui32NumOps; i++)
+	{
+		struct timespec sTime;
+
+		AbsTime(ui64RoundStartUs + sDevice.aui64OpDelayUs[i], &sTime);
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &sTime, IMG_NULL) == EINTR)
+		{
+		}
+
+		pthread_mutex_lock(&sDevice.sMutex);
+
+		sDevice.ui32OpsComplete++;
+		sDevice.aui64OpCompleteUs[i] = MockClockus();
+		sDevice.ui32Signals++;
+		pthread_cond_broadcast(&sDevice.sEvent);
+
+		pthread_mutex_unlock(&sDevice.sMutex);
+	}
+
+	return IMG_NULL;
+}
+
+/*****************************************************************************
+ Waiters
+*****************************************************************************/
+
+/* How EGL waited on a fence before: query it until it completes or time runs out */
+static IMG_BOOL PollFence(MOCK_FENCE *psFence, IMG_UINT64 ui64TimeoutNs)
+{
+	IMG_UINT64 ui64DeadlineUs = MockClockus() + ui64TimeoutNs / 1000;
+
+	for (;;)
+	{
+		if (MockIsComplete(psFence))
+		{
+			return IMG_TRUE;
+		}
+
+		if ((ui64TimeoutNs != TEST_FOREVER) && (MockClockus() >= ui64DeadlineUs))
+		{
+			return IMG_FALSE;
+		}
+	}
+}
+
+static IMG_VOID *WaiterThread(IMG_VOID *pvArg)
+{
+	WAITER *psWaiter = (WAITER *)pvArg;
+	IMG_UINT64 ui64CpuUs;
+
+	MockThreadStart();
+
+	if (psWaiter->ui32StartDelayUs)
+	{
+		struct timespec sTime;
+
+		AbsTime(ui64RoundStartUs + psWaiter->ui32StartDelayUs, &sTime);
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &sTime, IMG_NULL) == EINTR)
+		{
+		}
+	}
+
+	ui64CpuUs = TimeUs(CLOCK_THREAD_CPUTIME_ID);
+	psWaiter->ui64StartUs = MockClockus();
+
+	if (psWaiter->bPoll)
+	{
+		psWaiter->bComplete = PollFence(psWaiter->psFence, psWaiter->ui64TimeoutNs);
+	}
+	else
+	{
+		psWaiter->bComplete = EGLFenceWait(psWaiter->psWait, &sMockOps, psWaiter->psFence, psWaiter->ui64TimeoutNs);
+	}
+
+	psWaiter->ui64EndUs = MockClockus();
+	psWaiter->ui64CpuUs = TimeUs(CLOCK_THREAD_CPUTIME_ID) - ui64CpuUs;
+
+	return IMG_NULL;
+}
+
+static IMG_VOID InitWaiter(WAITER *psWaiter, EGL_FENCE_WAIT *psWait, MOCK_FENCE *psFence,
+						   IMG_UINT64 ui64TimeoutNs, IMG_UINT32 ui32StartDelayUs)
+{
+	memset(psWaiter, 0, sizeof(*psWaiter));
+
+	psWaiter->psWait = psWait;
+	psWaiter->psFence = psFence;
+	psWaiter->ui64TimeoutNs = ui64TimeoutNs;
+	psWaiter->ui32StartDelayUs = ui32StartDelayUs;
+}
+
+/* Runs the device's ops and the waiters to the end */
+static IMG_VOID RunRound(WAITER *psWaiters, IMG_UINT32 ui32NumWaiters)
+{
+	pthread_t hDevice;
+	IMG_UINT32 i;
+
+	ui64RoundStartUs = MockClockus();
+
+	pthread_create(&hDevice, IMG_NULL, DeviceThread, IMG_NULL);
+	for (i = 0; i < ui32NumWaiters; i++)
+	{
+		pthread_create(&psWaiters[i].hThread, IMG_NULL, WaiterThread, &psWaiters[i]);
+	}
+
+	for (i = 0; i < ui32NumWaiters; i++)
+	{
+		pthread_join(psWaiters[i].hThread, IMG_NULL);
+	}
+	pthread_join(hDevice, IMG_NULL);
+}
+
+/* When the fence's op completed, or 0 if it didn't */
+static IMG_UINT64 FenceCompleteUs(const MOCK_FENCE *psFence)
+{
+	return (psFence->ui32Op <= sDevice.ui32OpsComplete) ? sDevice.aui64OpCompleteUs[psFence->ui32Op - 1] : 0;
+}
+
+static IMG_UINT32 CpuPercent(const WAITER *psWaiter)
+{
+	IMG_UINT64 ui64WallUs = psWaiter->ui64EndUs - psWaiter->ui64StartUs;
+
+	return ui64WallUs ? (IMG_UINT32)(psWaiter->ui64CpuUs * 100 / ui64WallUs) : 0;
+}
+
+/* The shared wait is idle, with no sleeper left counted or posted */
+static IMG_VOID CheckIdle(EGL_FENCE_WAIT *psWait, const IMG_CHAR *pszTest)
+{
+	Check((IMG_BOOL)!psWait->bEventWaiter, pszTest, "event waiter left behind");
+	CheckCount(psWait->ui32Sleepers, 0, pszTest, "sleepers left");
+	CheckCount((IMG_UINT32)SemaphoreCount(psWait->hSemaphore), 0, pszTest, "posts left on the semaphore");
+}
+
+/*****************************************************************************
+ Tests
+*****************************************************************************/
+
+static IMG_VOID TestAlreadyComplete(IMG_VOID)
+{
+	const IMG_CHAR *pszTest = "already complete";
+	EGL_FENCE_WAIT sWait;
+	MOCK_FENCE sFence = { 1 };
+
+	MockReset();
+	sDevice.ui32OpsComplete = 1;
+
+	EGLFenceWaitInit(&sWait);
+
+	Check(EGLFenceWaitIsComplete(&sWait, &sMockOps, &sFence), pszTest, "query");
+	Check(EGLFenceWait(&sWait, &sMockOps, &sFence, TEST_FOREVER), pszTest, "wait");
+	Check(EGLFenceWait(&sWait, &sMockOps, &sFence, 0), pszTest, "wait with no timeout");
+	CheckCount(sDevice.ui32EventWaits, 0, pszTest, "event waits");
+
+	/* Once seen complete, the fence isn't queried again */
+	CheckCount(sDevice.ui32Queries, 1, pszTest, "queries");
+
+	CheckIdle(&sWait, pszTest);
+	EGLFenceWaitDeinit(&sWait);
+}
+
+static IMG_VOID TestTimeout(IMG_VOID)
+{
+	static const IMG_UINT64 aui64TimeoutNs[] = { 0, 500, 30000000, 250000001 };
+	const IMG_CHAR *pszTest = "timeout";
+	EGL_FENCE_WAIT sWait;
+	MOCK_FENCE sFence = { 1 };
+	IMG_UINT32 i;
+
+	EGLFenceWaitInit(&sWait);
+
+	for (i = 0; i < sizeof(aui64TimeoutNs) / sizeof(aui64TimeoutNs[0]); i++)
+	{
+		IMG_UINT64 ui64TimeoutUs = (aui64TimeoutNs[i] + 999) / 1000;
+		IMG_UINT64 ui64WaitedUs;
+		WAITER sWaiter;
+
+		MockReset();
+		InitWaiter(&sWaiter, &sWait, &sFence, aui64TimeoutNs[i], 0);
+		RunRound(&sWaiter, 1);
+
+		ui64WaitedUs = sWaiter.ui64EndUs - sWaiter.ui64StartUs;
+
+		if (bVerbose)
+		{
+			printf("%-28s timeout %9lluns: waited %6lluus, %u event waits, cpu %u%%\n", pszTest,
+				   (unsigned long long)aui64TimeoutNs[i], (unsigned long long)ui64WaitedUs,
+				   sDevice.ui32EventWaits, CpuPercent(&sWaiter));
+		}
+
+		Check((IMG_BOOL)!sWaiter.bComplete, pszTest, "incomplete fence waited for");
+		Check((IMG_BOOL)(ui64WaitedUs >= ui64TimeoutUs), pszTest, "wait shorter than its timeout");
+		Check((IMG_BOOL)(ui64WaitedUs < ui64TimeoutUs + TEST_LATENCY_LIMIT_US), pszTest, "wait overran its timeout");
+
+		/* The event is waited on in slices, and never without a timeout left */
+		Check((IMG_BOOL)(sDevice.ui32EventWaits <= ui64TimeoutUs / EGL_FENCE_WAIT_EVENT_US + 2), pszTest, "too many event waits");
+		if (!aui64TimeoutNs[i])
+		{
+			CheckCount(sDevice.ui32EventWaits, 0, pszTest, "event waits with no timeout");
+		}
+
+		if (ui64TimeoutUs >= 10000)
+		{
+			Check((IMG_BOOL)(CpuPercent(&sWaiter) < TEST_CPU_LIMIT_PERCENT), pszTest, "waiter used the CPU");
+		}
+	}
+
+	CheckIdle(&sWait, pszTest);
+	EGLFenceWaitDeinit(&sWait);
+}
+
+static IMG_VOID TestWakeLatency(IMG_VOID)
+{
+	const IMG_CHAR *pszTest = "wake-up latency";
+	IMG_UINT64 ui64TotalUs = 0, ui64MaxUs = 0;
+	IMG_UINT32 ui32Cpu = 0, ui32PollCpu = 0;
+	IMG_UINT32 ui32Round, i;
+
+	for (ui32Round = 0; ui32Round < 10; ui32Round++)
+	{
+		EGL_FENCE_WAIT sWait;
+		MOCK_FENCE sFence = { 10 };
+		IMG_UINT64 ui64LatencyUs;
+		WAITER sWaiter;
+
+		/* Nine other ops complete first, raising the event without completing the fence */
+		MockReset();
+		for (i = 1; i <= sFence.ui32Op; i++)
+		{
+			MockAddOp(i * 2000);
+		}
+
+		EGLFenceWaitInit(&sWait);
+		InitWaiter(&sWaiter, &sWait, &sFence, TEST_FOREVER, 0);
+		RunRound(&sWaiter, 1);
+
+		Check(sWaiter.bComplete, pszTest, "wait failed");
+
+		ui64LatencyUs = sWaiter.ui64EndUs - FenceCompleteUs(&sFence);
+		ui64TotalUs += ui64LatencyUs;
+		if (ui64LatencyUs > ui64MaxUs)
+		{
+			ui64MaxUs = ui64LatencyUs;
+		}
+		ui32Cpu += CpuPercent(&sWaiter);
+
+		/* A query on each event, and one on entry */
+		Check((IMG_BOOL)(sDevice.ui32Queries <= sFence.ui32Op + 2), pszTest, "fence queried more than once per event");
+
+		CheckIdle(&sWait, pszTest);
+		EGLFenceWaitDeinit(&sWait);
+	}
+
+	Check((IMG_BOOL)(ui64MaxUs < TEST_LATENCY_LIMIT_US), pszTest, "woke late");
+	Check((IMG_BOOL)(ui32Cpu / ui32Round < TEST_CPU_LIMIT_PERCENT), pszTest, "waiter used the CPU");
+
+	/* The same waits, polled */
+	for (i = 0; i < 3; i++)
+	{
+		MOCK_FENCE sFence = { 10 };
+		WAITER sWaiter;
+		IMG_UINT32 ui32Op;
+
+		MockReset();
+		for (ui32Op = 1; ui32Op <= sFence.ui32Op; ui32Op++)
+		{
+			MockAddOp(ui32Op * 2000);
+		}
+
+		InitWaiter(&sWaiter, IMG_NULL, &sFence, TEST_FOREVER, 0);
+		sWaiter.bPoll = IMG_TRUE;
+		RunRound(&sWaiter, 1);
+
+		ui32PollCpu += CpuPercent(&sWaiter);
+	}
+
+	if (bVerbose)
+	{
+		printf("%-28s latency avg %4lluus max %4lluus, cpu %u%% (polling: cpu %u%%)\n", pszTest,
+			   (unsigned long long)(ui64TotalUs / ui32Round), (unsigned long long)ui64MaxUs,
+			   ui32Cpu / ui32Round, ui32PollCpu / i);
+	}
+}
+
+static IMG_VOID TestSharedWait(IMG_VOID)
+{
+	const IMG_CHAR *pszTest = "shared wait";
+	WAITER asWaiters[TEST_MAX_WAITERS];
+	EGL_FENCE_WAIT sWait;
+	MOCK_FENCE sFence = { 10 };
+	IMG_UINT64 ui64MaxUs = 0;
+	IMG_UINT32 ui32Cpu = 0;
+	IMG_UINT32 i;
+
+	MockReset();
+	for (i = 1; i <= sFence.ui32Op; i++)
+	{
+		MockAddOp(i * 3000);
+	}
+
+	EGLFenceWaitInit(&sWait);
+	for (i = 0; i < TEST_MAX_WAITERS; i++)
+	{
+		InitWaiter(&asWaiters[i], &sWait, &sFence, TEST_FOREVER, i * 500);
+	}
+	RunRound(asWaiters, TEST_MAX_WAITERS);
+
+	for (i = 0; i < TEST_MAX_WAITERS; i++)
+	{
+		IMG_UINT64 ui64LatencyUs = asWaiters[i].ui64EndUs - FenceCompleteUs(&sFence);
+
+		Check(asWaiters[i].bComplete, pszTest, "wait failed");
+		if (ui64LatencyUs > ui64MaxUs)
+		{
+			ui64MaxUs = ui64LatencyUs;
+		}
+		ui32Cpu += CpuPercent(&asWaiters[i]);
+	}
+
+	if (bVerbose)
+	{
+		printf("%-28s %u waiters: latency max %4lluus, cpu %u%%, %u event waits, %u queries\n", pszTest,
+			   TEST_MAX_WAITERS, (unsigned long long)ui64MaxUs, ui32Cpu / TEST_MAX_WAITERS,
+			   sDevice.ui32EventWaits, sDevice.ui32Queries);
+	}
+
+	CheckCount(sDevice.ui32MaxEventWaiters, 1, pszTest, "threads blocked on the event at once");
+	Check((IMG_BOOL)(ui64MaxUs < TEST_LATENCY_LIMIT_US), pszTest, "a waiter woke late");
+	Check((IMG_BOOL)(ui32Cpu / TEST_MAX_WAITERS < TEST_CPU_LIMIT_PERCENT), pszTest, "waiters used the CPU");
+
+	/* One thread queries on each event; the others once as they arrive and as they wake */
+	Check((IMG_BOOL)(sDevice.ui32Queries <= sFence.ui32Op + 1 + TEST_MAX_WAITERS * 2), pszTest, "fence queried by every waiter");
+
+	CheckIdle(&sWait, pszTest);
+	EGLFenceWaitDeinit(&sWait);
+}
+
+static IMG_VOID TestHandover(IMG_VOID)
+{
+	const IMG_CHAR *pszTest = "handover";
+	WAITER asWaiters[4];
+	EGL_FENCE_WAIT sWait;
+	MOCK_FENCE sFence = { 4 };
+	IMG_UINT32 i;
+
+	/* The first waiter, blocked on the event, gives up before the fence completes */
+	MockReset();
+	for (i = 1; i <= sFence.ui32Op; i++)
+	{
+		MockAddOp(i * 10000);
+	}
+
+	EGLFenceWaitInit(&sWait);
+	InitWaiter(&asWaiters[0], &sWait, &sFence, 10000000, 0);
+	InitWaiter(&asWaiters[1], &sWait, &sFence, TEST_FOREVER, 3000);
+	InitWaiter(&asWaiters[2], &sWait, &sFence, 15000000, 3000);
+	InitWaiter(&asWaiters[3], &sWait, &sFence, 100000000, 4000);
+	RunRound(asWaiters, 4);
+
+	Check((IMG_BOOL)!asWaiters[0].bComplete, pszTest, "first waiter didn't time out");
+	Check((IMG_BOOL)!asWaiters[2].bComplete, pszTest, "third waiter didn't time out");
+	Check((IMG_BOOL)(asWaiters[0].ui64EndUs - asWaiters[0].ui64StartUs >= 10000), pszTest, "first wait too short");
+	Check((IMG_BOOL)(asWaiters[2].ui64EndUs - asWaiters[2].ui64StartUs >= 15000), pszTest, "third wait too short");
+
+	Check(asWaiters[1].bComplete, pszTest, "second wait failed");
+	Check(asWaiters[3].bComplete, pszTest, "fourth wait failed");
+	Check((IMG_BOOL)(asWaiters[1].ui64EndUs - FenceCompleteUs(&sFence) < TEST_LATENCY_LIMIT_US), pszTest, "second waiter woke late");
+	Check((IMG_BOOL)(asWaiters[3].ui64EndUs - FenceCompleteUs(&sFence) < TEST_LATENCY_LIMIT_US), pszTest, "fourth waiter woke late");
+
+	CheckCount(sDevice.ui32MaxEventWaiters, 1, pszTest, "threads blocked on the event at once");
+
+	CheckIdle(&sWait, pszTest);
+	EGLFenceWaitDeinit(&sWait);
+}
+
+static IMG_VOID TestRandom(IMG_VOID)
+{
+	const IMG_CHAR *pszTest = "random waits";
+	IMG_UINT32 ui32Round, ui32Waits = 0, ui32Completed = 0;
+
+	for (ui32Round = 0; ui32Round < 20; ui32Round++)
+	{
+		WAITER asWaiters[6];
+		EGL_FENCE_WAIT sWait;
+		MOCK_FENCE sFence;
+		IMG_UINT64 ui64CompleteUs;
+		IMG_UINT32 i;
+
+		MockReset();
+		sFence.ui32Op = 1 + Random() % 4;
+		for (i = 1; i <= sFence.ui32Op; i++)
+		{
+			MockAddOp(i * (5000 + Random() % 5000));
+		}
+
+		EGLFenceWaitInit(&sWait);
+		for (i = 0; i < 6; i++)
+		{
+			IMG_UINT64 ui64TimeoutNs = ((Random() % 3) == 0) ? TEST_FOREVER : (IMG_UINT64)(Random() % 30000) * 1000 + Random() % 1000;
+
+			InitWaiter(&asWaiters[i], &sWait, &sFence, ui64TimeoutNs, Random() % 5000);
+		}
+		RunRound(asWaiters, 6);
+
+		ui64CompleteUs = FenceCompleteUs(&sFence);
+
+		for (i = 0; i < 6; i++)
+		{
+			const WAITER *psWaiter = &asWaiters[i];
+
+			ui32Waits++;
+
+			if (psWaiter->bComplete)
+			{
+				IMG_UINT64 ui64FromUs = (ui64CompleteUs > psWaiter->ui64StartUs) ? ui64CompleteUs : psWaiter->ui64StartUs;
+
+				ui32Completed++;
+				Check((IMG_BOOL)(psWaiter->ui64EndUs >= ui64CompleteUs), pszTest, "wait returned before the fence completed");
+				Check((IMG_BOOL)(psWaiter->ui64EndUs - ui64FromUs < TEST_LATENCY_LIMIT_US), pszTest, "waiter woke late");
+			}
+			else
+			{
+				IMG_UINT64 ui64TimeoutUs = (psWaiter->ui64TimeoutNs + 999) / 1000;
+
+				Check((IMG_BOOL)(psWaiter->ui64TimeoutNs != TEST_FOREVER), pszTest, "wait with no timeout failed");
+				Check((IMG_BOOL)(psWaiter->ui64EndUs - psWaiter->ui64StartUs >= ui64TimeoutUs), pszTest, "wait shorter than its timeout");
+				Check((IMG_BOOL)(ui64CompleteUs + TEST_LATENCY_LIMIT_US > psWaiter->ui64StartUs + ui64TimeoutUs), pszTest, "timed out long after the fence completed");
+			}
+		}
+
+		CheckCount(sDevice.ui32MaxEventWaiters, 1, pszTest, "threads blocked on the event at once");
+		CheckIdle(&sWait, pszTest);
+		EGLFenceWaitDeinit(&sWait);
+	}
+
+	if (bVerbose)
+	{
+		printf("%-28s %u waits, %u saw the fence complete\n", pszTest, ui32Waits, ui32Completed);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	if ((argc == 2) && (strcmp(argv[1], "-v") == 0))
+	{
+		bVerbose = IMG_TRUE;
+	}
+	else if (argc != 1)
+	{
+		fprintf(stderr, "Usage: %s [-v]\n", argv[0]);
+		return 2;
+	}
+
+	pthread_mutex_init(&sDevice.sMutex, IMG_NULL);
+	pthread_cond_init(&sDevice.sEvent, IMG_NULL);
+
+	TestAlreadyComplete();
+	TestTimeout();
+	TestWakeLatency();
+	TestSharedWait();
+	TestHandover();
+	TestRandom();
+
+	if (ui32Failures)
+	{
+		printf("%u checks failed\n", ui32Failures);
+		return 1;
+	}
+
+	printf("all checks passed\n");
+	return 0;
+}
+
+/******************************************************************************
+ End of file (main.c)
+******************************************************************************/
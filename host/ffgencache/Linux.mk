@@ -0,0 +1,93 @@
+# Copyright	2010 Imagination Technologies Limited. All rights reserved.
+#
+# No part of this software, either material or conceptual may be
+# copied or distributed, transmitted, transcribed, stored in a
+# retrieval system or translated into any human or computer
+# language in any form by any means, electronic, mechanical,
+# manual or other-wise, or disclosed to third parties without
+# the express written permission of: Imagination Technologies
+# Limited, HomePark Industrial Estate, Kings Langley,
+# Hertfordshire, WD4 8LZ, UK
+#
+# $Log: Linux.mk $
+#
+
+modules := ffgencache
+
+ffgencache_type := host_executable
+
+ffgencache_target := ffgencache
+
+ffgencache_src = \
+ main.c \
+ $(TOP)/codegen/ffgen/codegen.c \
+ $(TOP)/codegen/ffgen/ffgen.c \
+ $(TOP)/codegen/ffgen/ffgencache.c \
+ $(TOP)/codegen/ffgen/inst.c \
+ $(TOP)/codegen/ffgen/lighting.c \
+ $(TOP)/codegen/ffgen/reg.c \
+ $(TOP)/codegen/ffgen/source.c \
+ $(TOP)/codegen/ffgen/uscfns.c \
+ $(TOP)/tools/intern/usc2/asm.c \
+ $(TOP)/tools/intern/usc2/cdg.c \
+ $(TOP)/tools/intern/usc2/cfa.c \
+ $(TOP)/tools/intern/usc2/data.c \
+ $(TOP)/tools/intern/usc2/dce.c \
+ $(TOP)/tools/intern/usc2/debug.c \
+ $(TOP)/tools/intern/usc2/dgraph.c \
+ $(TOP)/tools/intern/usc2/domcalc.c \
+ $(TOP)/tools/intern/usc2/dualissue.c \
+ $(TOP)/tools/intern/usc2/efo.c \
+ $(TOP)/tools/intern/usc2/execpred.c \
+ $(TOP)/tools/intern/usc2/f16opt.c \
+ $(TOP)/tools/intern/usc2/finalise.c \
+ $(TOP)/tools/intern/usc2/groupinst.c \
+ $(TOP)/tools/intern/usc2/hw.c \
+ $(TOP)/tools/intern/usc2/icvt_c10.c \
+ $(TOP)/tools/intern/usc2/icvt_core.c \
+ $(TOP)/tools/intern/usc2/icvt_f16.c \
+ $(TOP)/tools/intern/usc2/icvt_f16_vec.c \
+ $(TOP)/tools/intern/usc2/icvt_f32.c \
+ $(TOP)/tools/intern/usc2/icvt_f32_vec.c \
+ $(TOP)/tools/intern/usc2/icvt_i32.c \
+ $(TOP)/tools/intern/usc2/icvt_mem.c \
+ $(TOP)/tools/intern/usc2/indexreg.c \
+ $(TOP)/tools/intern/usc2/inst_usc.c \
+ $(TOP)/tools/intern/usc2/intcvt.c \
+ $(TOP)/tools/intern/usc2/iregalloc.c \
+ $(TOP)/tools/intern/usc2/iselect.c \
+ $(TOP)/tools/intern/usc2/layout.c \
+ $(TOP)/tools/intern/usc2/pconvert.c \
+ $(TOP)/tools/intern/usc2/precovr.c \
+ $(TOP)/tools/intern/usc2/pregalloc.c \
+ $(TOP)/tools/intern/usc2/regalloc.c \
+ $(TOP)/tools/intern/usc2/reggroup.c \
+ $(TOP)/tools/intern/usc2/regpack.c \
+ $(TOP)/tools/intern/usc2/reorder.c \
+ $(TOP)/tools/intern/usc2/ssa.c \
+ $(TOP)/tools/intern/usc2/usc.c \
+ $(TOP)/tools/intern/usc2/usc_utils.c \
+ $(TOP)/tools/intern/usc2/usedef.c \
+ $(TOP)/tools/intern/usc2/vec34.c \
+ $(TOP)/tools/intern/useasm/specialregs.c \
+ $(TOP)/tools/intern/useasm/specialregs_vec.c \
+ $(TOP)/tools/intern/useasm/useasm.c \
+ $(TOP)/tools/intern/useasm/usedisasm.c \
+ $(TOP)/tools/intern/useasm/useopt.c \
+ $(TOP)/tools/intern/useasm/usetab.c \
+ $(TOP)/tools/intern/useasm/utils.c
+
+# Generates and compiles TNL programs exactly as the GLES1 driver does, so
+# build FFGen and the USC with the driver's configuration
+ffgencache_cflags := \
+ -DFFGEN_UNIFLEX -DOUTPUT_USCHW -DSUPPORT_OPENGLES1 -DOGLES1_MODULE \
+ -DUSER -DSUPPORT_SGX -DSUPPORT_SGX543 \
+ -DINCLUDE_SGX_FEATURE_TABLE -DINCLUDE_SGX_BUG_TABLE \
+ -D'IMG_ABORT()=abort()' -include psp2_pvr_desc.h
+
+ffgencache_includes := include4 hwdefs services4/include \
+ services4/system/psp2 eurasiacon/include eurasiacon/common \
+ intermediates/sgxsupport intermediates/errata \
+ codegen/ffgen tools/intern/usc2 tools/intern/useasm
+
+ffgencache_extlibs := m
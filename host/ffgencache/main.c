@@ -0,0 +1,785 @@
+/******************************************************************************
+ * Name         : main.c
+ * Title        : FFGen TNL variant cache tool
+ *
+ * Copyright    : 2006-2010 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means,electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Description  : Builds the FFGen TNL variant cache shipped with a title.
+ *
+ *                Running a title with the FFTNLStateLog apphint set makes the
+ *                GLES1 driver log the key of every fixed function TNL program
+ *                it generates. This tool reads the state logs captured from
+ *                any number of runs (different levels, settings, test passes),
+ *                generates and compiles every variant with the same FFGen and
+ *                USC code as the driver, and writes a single cache that can be
+ *                installed as the title's FFTNLCacheFile so the variants never
+ *                have to be compiled at runtime.
+ *
+ *                Caches recorded by the driver through FFTNLCacheFile can be
+ *                merged in as well, as long as they were written by the driver
+ *                this tool was built with.
+ *
+ * Modifications:-
+ * $Log: main.c $
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "img_types.h"
+#include "sgxdefs.h"
+#include "ffgen.h"
+#include "ffgencache.h"
+
+/*
+	Register layout used by the OpenGL ES 1.1 driver.
+
+	Important! These must match usegles.h and dmscalc.h in the driver, and
+	CompileProgram below must match CompileFFGenUniFlexCode in fftnlgles.c,
+	or the cached programs will not run.
+*/
+#define FFGENCACHE_VERTEX_SECATTR_NUM_RESERVED	0x00000006
+
+#if (EURASIA_USE_NUM_UNIFIED_REGISTERS > 2048)
+#define FFGENCACHE_MAX_VS_SECONDARIES			512
+#else
+#define FFGENCACHE_MAX_VS_SECONDARIES			300
+#endif
+
+typedef struct _CACHE_RECORD_
+{
+	IMG_UINT32				*pui32Record;
+	struct _CACHE_RECORD_	*psNext;
+} CACHE_RECORD, *PCACHE_RECORD;
+
+typedef struct _CACHE_
+{
+	PCACHE_RECORD		psFirst;
+	PCACHE_RECORD		psLast;
+
+	/* Iterator used while writing the cache out */
+	PCACHE_RECORD		psNextToWrite;
+
+	IMG_PVOID			pvFFGenContext;
+	IMG_PVOID			pvUniFlexContext;
+
+	IMG_UINT32			uNumRecords;
+	IMG_UINT32			uNumCompiled;
+	IMG_UINT32			uNumDuplicates;
+	IMG_UINT32			uNumFailed;
+	IMG_UINT32			uNumInstructions;
+} CACHE, *PCACHE;
+
+static IMG_BOOL g_bVerbose = IMG_FALSE;
+
+/*****************************************************************************
+ FUNCTION	: Usage
+
+ PURPOSE	: Prints the command line options.
+
+ PARAMETERS	: None.
+
+ RETURNS	: Nothing.
+*****************************************************************************/
+static IMG_VOID Usage(IMG_VOID)
+{
+	fprintf(stderr, "Usage: ffgencache [-v] [-o <output>] [-l <statelog>] ... [<cache> ...]\n");
+	fprintf(stderr, "\n");
+	fprintf(stderr, "  Builds a FFGen TNL variant cache for the GLES1 driver.\n");
+	fprintf(stderr, "\n");
+	fprintf(stderr, "  -l <statelog> Compile every variant logged through the FFTNLStateLog\n");
+	fprintf(stderr, "                apphint. May be given more than once.\n");
+	fprintf(stderr, "  <cache>       Merge a cache recorded through the FFTNLCacheFile apphint.\n");
+	fprintf(stderr, "  -o <output>   Write the cache to <output>. Without this the inputs\n");
+	fprintf(stderr, "                are only checked and summarised.\n");
+	fprintf(stderr, "  -v            List every variant.\n");
+}
+
+/*****************************************************************************
+ FUNCTION	: ToolMalloc, ToolCalloc, ToolRealloc, ToolFree, ToolPrint
+
+ PURPOSE	: Memory and print callbacks for FFGen.
+*****************************************************************************/
+static IMG_PVOID IMG_CALLCONV ToolMalloc(IMG_HANDLE hHandle, IMG_UINT32 uSize)
+{
+	PVR_UNREFERENCED_PARAMETER(hHandle);
+
+	return malloc(uSize);
+}
+
+static IMG_PVOID IMG_CALLCONV ToolCalloc(IMG_HANDLE hHandle, IMG_UINT32 uSize)
+{
+	PVR_UNREFERENCED_PARAMETER(hHandle);
+
+	return calloc(1, uSize);
+}
+
+static IMG_PVOID IMG_CALLCONV ToolRealloc(IMG_HANDLE hHandle, IMG_VOID *pvData, IMG_UINT32 uSize)
+{
+	PVR_UNREFERENCED_PARAMETER(hHandle);
+
+	return realloc(pvData, uSize);
+}
+
+static IMG_VOID IMG_CALLCONV ToolFree(IMG_HANDLE hHandle, IMG_VOID *pvData)
+{
+	PVR_UNREFERENCED_PARAMETER(hHandle);
+
+	free(pvData);
+}
+
+static IMG_VOID IMG_CALLCONV ToolPrint(const IMG_CHAR *pszFormat, ...) IMG_FORMAT_PRINTF(1, 2);
+
+static IMG_VOID IMG_CALLCONV ToolPrint(const IMG_CHAR *pszFormat, ...)
+{
+	PVR_UNREFERENCED_PARAMETER(pszFormat);
+}
+
+/*****************************************************************************
+ FUNCTION	: UniFlexAlloc, UniFlexFree
+
+ PURPOSE	: Memory callbacks for the USC.
+*****************************************************************************/
+static IMG_PVOID IMG_CALLCONV UniFlexAlloc(IMG_UINT32 uSize)
+{
+	return malloc(uSize);
+}
+
+static IMG_VOID IMG_CALLCONV UniFlexFree(IMG_PVOID pvData)
+{
+	free(pvData);
+}
+
+/*****************************************************************************
+ FUNCTION	: FindRecord
+
+ PURPOSE	: Looks for a record with the given key in the cache.
+
+ PARAMETERS	: psCache		- The cache.
+			  pui32Key		- Key to look for.
+
+ RETURNS	: IMG_TRUE if a record with the same key is already present.
+
+ NOTES		: Records compiled by this tool carry no key hash, the driver
+			  works it out when it loads the cache, so only keys are compared.
+*****************************************************************************/
+static IMG_BOOL FindRecord(PCACHE psCache, const IMG_UINT32 *pui32Key)
+{
+	PCACHE_RECORD psRecord;
+
+	for (psRecord = psCache->psFirst; psRecord != NULL; psRecord = psRecord->psNext)
+	{
+		if (memcmp(&psRecord->pui32Record[FFGEN_CACHE_RECORD_HEADER_DWORDS],
+				   pui32Key,
+				   FFGEN_CACHE_TNL_KEY_DWORDS * sizeof(IMG_UINT32)) == 0)
+		{
+			return IMG_TRUE;
+		}
+	}
+
+	return IMG_FALSE;
+}
+
+/*****************************************************************************
+ FUNCTION	: AddRecord
+
+ PURPOSE	: Appends a record to the cache.
+
+ PARAMETERS	: psCache		- The cache.
+			  pui32Record	- Record to add, owned by the cache from now on.
+
+ RETURNS	: Nothing.
+*****************************************************************************/
+static IMG_VOID AddRecord(PCACHE psCache, IMG_UINT32 *pui32Record)
+{
+	const FFGenCacheProgram	*psProgram =
+		(const FFGenCacheProgram *)&pui32Record[FFGEN_CACHE_RECORD_HEADER_DWORDS + FFGEN_CACHE_TNL_KEY_DWORDS];
+	PCACHE_RECORD			psRecord;
+
+	psRecord = malloc(sizeof(CACHE_RECORD));
+	if (psRecord == NULL)
+	{
+		fprintf(stderr, "Out of memory.\n");
+		exit(1);
+	}
+
+	psRecord->pui32Record = pui32Record;
+	psRecord->psNext = NULL;
+
+	if (psCache->psLast != NULL)
+	{
+		psCache->psLast->psNext = psRecord;
+	}
+	else
+	{
+		psCache->psFirst = psRecord;
+	}
+	psCache->psLast = psRecord;
+
+	psCache->uNumRecords++;
+	psCache->uNumInstructions += psProgram->ui32InstructionCount;
+
+	if (g_bVerbose)
+	{
+		printf("  %4u instructions, %3u primary, %3u secondary, %3u temporaries\n",
+			   psProgram->ui32InstructionCount,
+			   psProgram->ui32PrimaryAttributeCount,
+			   psProgram->ui32SecondaryAttributeCount,
+			   psProgram->ui32TemporaryRegisterCount);
+	}
+}
+
+/*****************************************************************************
+ FUNCTION	: AddConstant
+
+ PURPOSE	: Records a static constant loaded by a compiled program.
+
+ PARAMETERS	: psProgram		- The program.
+			  uValue		- Value of the constant.
+			  uDest			- Secondary attribute it is loaded into.
+
+ RETURNS	: Nothing.
+*****************************************************************************/
+static IMG_VOID AddConstant(FFGenProgram *psProgram, IMG_UINT32 uValue, IMG_UINT32 uDest)
+{
+	if (psProgram->ui32NumUFConstants == psProgram->ui32MaxNumUFConstants)
+	{
+		psProgram->ui32MaxNumUFConstants += 20;
+
+		psProgram->pui32UFConstantData = realloc(psProgram->pui32UFConstantData,
+												 psProgram->ui32MaxNumUFConstants * sizeof(IMG_UINT32));
+		psProgram->pui32UFConstantDest = realloc(psProgram->pui32UFConstantDest,
+												 psProgram->ui32MaxNumUFConstants * sizeof(IMG_UINT32));
+
+		if (psProgram->pui32UFConstantData == NULL || psProgram->pui32UFConstantDest == NULL)
+		{
+			fprintf(stderr, "Out of memory.\n");
+			exit(1);
+		}
+	}
+
+	psProgram->pui32UFConstantData[psProgram->ui32NumUFConstants] = uValue;
+	psProgram->pui32UFConstantDest[psProgram->ui32NumUFConstants++] = uDest;
+}
+
+/*****************************************************************************
+ FUNCTION	: CompileProgram
+
+ PURPOSE	: Compiles a generated TNL program the way the driver does.
+
+ PARAMETERS	: psCache				- The cache.
+			  psProgram				- Program from FFGenGenerateTNLProgram.
+			  puValidShaderOutputs	- Output masks from the key.
+
+ RETURNS	: IMG_TRUE on success.
+
+ NOTES		: A copy of CompileFFGenUniFlexCode in fftnlgles.c.
+*****************************************************************************/
+static IMG_BOOL CompileProgram(PCACHE psCache, FFGenProgram *psProgram, const IMG_UINT32 *puValidShaderOutputs)
+{
+	FFGEN_PROGRAM_DETAILS		*psDetails = psProgram->psFFGENProgramDetails;
+	UNIFLEX_PROGRAM_PARAMETERS	sProgramParameters;
+	UNIFLEX_CONSTBUFFERDESC		*psLegacyBuffer;
+	UNIFLEX_HW					sUniFlexHW;
+	UNIFLEX_CONSTDEF			sConstants;
+	UNIFLEX_RANGE				asConstsRanges[20];
+	UNIFLEX_INST				*psInst;
+	FFGenRegList				*psRegList;
+	IMG_UINT32					uError, uNumSecAttribs, uNumMemConsts, i;
+
+	memset(&sProgramParameters, 0, sizeof(sProgramParameters));
+	memset(&sUniFlexHW, 0, sizeof(sUniFlexHW));
+
+	sProgramParameters.sTarget.eID = SGX_CORE_ID;
+#if defined(SGX_CORE_REV)
+	sProgramParameters.sTarget.uiRev = SGX_CORE_REV;
+#else
+	sProgramParameters.sTarget.uiRev = 0;
+#endif
+
+	sProgramParameters.eShaderType					= USC_SHADERTYPE_VERTEX;
+	sProgramParameters.uInRegisterConstantOffset	= FFGENCACHE_VERTEX_SECATTR_NUM_RESERVED;
+	sProgramParameters.uInRegisterConstantLimit		= FFGENCACHE_MAX_VS_SECONDARIES - FFGENCACHE_VERTEX_SECATTR_NUM_RESERVED;
+	sProgramParameters.uIndexableTempBase			= 1;
+	sProgramParameters.psIndexableTempArraySizes	= IMG_NULL;
+	sProgramParameters.uPackDestType				= USEASM_REGTYPE_OUTPUT;
+	sProgramParameters.uNumAvailableTemporaries		= 96;
+
+	for (i = 0; i < FFGEN_CACHE_NUM_OUTPUT_MASKS; i++)
+	{
+		sProgramParameters.puValidShaderOutputs[i] = puValidShaderOutputs[i];
+	}
+
+	sProgramParameters.uFlags = UF_GLSL | UF_DONTRESETMOEAFTERPROGRAM | UF_VSOUTPUTSALWAYSVALID | UF_QUIET;
+	sProgramParameters.uFlags2 = 0;
+
+	sConstants.uCount = 0;
+	sConstants.puConstStaticFlags = IMG_NULL;
+	sConstants.pfConst = IMG_NULL;
+
+	psLegacyBuffer = &sProgramParameters.asConstBuffDesc[UF_CONSTBUFFERID_LEGACY];
+	psLegacyBuffer->uStartingSAReg = 0;
+	psLegacyBuffer->uBaseAddressSAReg = 0;
+	psLegacyBuffer->uRelativeConstantMax = 0;
+	psLegacyBuffer->eConstBuffLocation = UF_CONSTBUFFERLOCATION_DONTCARE;
+	psLegacyBuffer->sConstsBuffRanges.uRangesCount = 0;
+	psLegacyBuffer->sConstsBuffRanges.psRanges = asConstsRanges;
+
+	for (psRegList = psProgram->psConstantsList; psRegList != NULL; psRegList = psRegList->psNext)
+	{
+		FFGenReg *psReg = psRegList->psReg;
+
+		if (psReg->eBindingRegDesc == FFGEN_STATE_MODELVIEWMATRIXPALETTE ||
+			psReg->eBindingRegDesc == FFGEN_STATE_MODELVIEWMATRIXINVERSETRANSPOSEPALETTE)
+		{
+			UNIFLEX_RANGE *psRange = &asConstsRanges[psLegacyBuffer->sConstsBuffRanges.uRangesCount++];
+
+			psRange->uRangeStart = psReg->uOffset / 4;
+			psRange->uRangeEnd = psReg->uOffset / 4 + (psReg->uSizeInDWords + 3) / 4;
+
+			sProgramParameters.uFlags |= UF_CONSTRANGES;
+		}
+	}
+
+	sProgramParameters.uMaxInstMovement = (sProgramParameters.uFlags & UF_CONSTRANGES) ? 7 : 15;
+	sProgramParameters.sShaderInputRanges.uRangesCount = 0;
+	sProgramParameters.uNumPDSPrimaryConstantsReserved = EURASIA_PDS_DOUTU_NONLOOPBACK_STATE_SIZE;
+
+	uError = PVRUniFlexCompileToHw(psCache->pvUniFlexContext,
+								   psProgram->psUniFlexInst,
+								   &sConstants,
+								   &sProgramParameters,
+								   &sUniFlexHW);
+
+	/* The input isn't needed any more, whatever the outcome */
+	while (psProgram->psUniFlexInst != NULL)
+	{
+		psInst = psProgram->psUniFlexInst;
+		psProgram->psUniFlexInst = psInst->psILink;
+
+		free(psInst);
+	}
+	psProgram->psUniFlexInstructions = IMG_NULL;
+
+	if (uError != UF_OK || sUniFlexHW.uSpillAreaSize != 0)
+	{
+		fprintf(stderr, "USC failed (error %u, spill area %u).\n", uError, sUniFlexHW.uSpillAreaSize);
+		PVRCleanupUniflexHw(psCache->pvUniFlexContext, &sUniFlexHW);
+		return IMG_FALSE;
+	}
+
+	psDetails->bUSEPerInstanceMode = (sUniFlexHW.uFlags & UNIFLEX_HW_FLAGS_PER_INSTANCE_MODE) ? IMG_TRUE : IMG_FALSE;
+	psDetails->ui32InstructionCount = sUniFlexHW.uInstructionCount;
+	psDetails->pui32Instructions = malloc(sUniFlexHW.uInstructionCount * EURASIA_USE_INSTRUCTION_SIZE);
+	if (psDetails->pui32Instructions == NULL)
+	{
+		fprintf(stderr, "Out of memory.\n");
+		exit(1);
+	}
+	memcpy(psDetails->pui32Instructions, sUniFlexHW.puInstructions, sUniFlexHW.uInstructionCount * EURASIA_USE_INSTRUCTION_SIZE);
+
+	psDetails->ui32PrimaryAttributeCount = sUniFlexHW.uPrimaryAttributeCount;
+	psDetails->ui32TemporaryRegisterCount = sUniFlexHW.asPhaseInfo[0].uTemporaryRegisterCount;
+	psDetails->iSAAddressAdjust = (IMG_INT16)sUniFlexHW.iSAAddressAdjust;
+
+	psProgram->pui32UFConstantData = IMG_NULL;
+	psProgram->pui32UFConstantDest = IMG_NULL;
+	psProgram->ui32NumUFConstants = 0;
+	psProgram->ui32MaxNumUFConstants = 0;
+
+	/* Constants loaded into secondary attributes */
+	uNumSecAttribs = 0;
+
+	for (psRegList = psProgram->psConstantsList; psRegList != NULL; psRegList = psRegList->psNext)
+	{
+		FFGenReg	*psReg = psRegList->psReg;
+		IMG_UINT32	uConstantCount = 0;
+
+		for (i = 0; i < sUniFlexHW.uInRegisterConstCount; i++)
+		{
+			UNIFLEX_CONST_LOAD *psConstantLoad = &sUniFlexHW.psInRegisterConstMap[i];
+
+			if (psConstantLoad->eFormat == UNIFLEX_CONST_FORMAT_F32)
+			{
+				if (psConstantLoad->u.s.uSrcIdx >= psReg->uOffset &&
+					psConstantLoad->u.s.uSrcIdx < psReg->uOffset + psReg->uSizeInDWords)
+				{
+					psReg->pui32SrcOffset[uConstantCount] = psConstantLoad->u.s.uSrcIdx - psReg->uOffset;
+					psReg->pui32DstOffset[uConstantCount] = psConstantLoad->uDestIdx + FFGENCACHE_VERTEX_SECATTR_NUM_RESERVED;
+
+					uConstantCount++;
+					uNumSecAttribs++;
+				}
+			}
+			else if (psConstantLoad->eFormat == UNIFLEX_CONST_FORMAT_STATIC && psConstantLoad->uDestIdx != 0xDEAD)
+			{
+				AddConstant(psProgram, psConstantLoad->u.uValue, psConstantLoad->uDestIdx + FFGENCACHE_VERTEX_SECATTR_NUM_RESERVED);
+
+				uNumSecAttribs++;
+
+				/* Prevent the constant being loaded again */
+				psConstantLoad->uDestIdx = 0xDEAD;
+			}
+		}
+
+		psReg->ui32ConstantCount = uConstantCount;
+	}
+
+	/* Constants loaded from memory */
+	uNumMemConsts = 0;
+
+	for (psRegList = psProgram->psConstantsList; psRegList != NULL; psRegList = psRegList->psNext)
+	{
+		FFGenReg	*psReg = psRegList->psReg;
+		IMG_UINT32	uConstantCount = psReg->ui32ConstantCount;
+
+		for (i = 0; i < sUniFlexHW.psMemRemappingForConstsBuff[UF_CONSTBUFFERID_LEGACY].uConstCount; i++)
+		{
+			UNIFLEX_CONST_LOAD *psConstantLoad = &sUniFlexHW.psMemRemappingForConstsBuff[UF_CONSTBUFFERID_LEGACY].psConstMap[i];
+
+			if (psConstantLoad->eFormat == UNIFLEX_CONST_FORMAT_F32)
+			{
+				if (psConstantLoad->u.s.uSrcIdx >= psReg->uOffset &&
+					psConstantLoad->u.s.uSrcIdx < psReg->uOffset + psReg->uSizeInDWords)
+				{
+					psReg->pui32SrcOffset[uConstantCount] = psConstantLoad->u.s.uSrcIdx - psReg->uOffset;
+					psReg->pui32DstOffset[uConstantCount] = psConstantLoad->uDestIdx + FFGENCACHE_VERTEX_SECATTR_NUM_RESERVED + uNumSecAttribs;
+
+					uConstantCount++;
+					uNumMemConsts++;
+				}
+			}
+			else if (psConstantLoad->eFormat == UNIFLEX_CONST_FORMAT_STATIC && psConstantLoad->uDestIdx != 0xDEAD)
+			{
+				AddConstant(psProgram, psConstantLoad->u.uValue, psConstantLoad->uDestIdx + FFGENCACHE_VERTEX_SECATTR_NUM_RESERVED);
+
+				uNumMemConsts++;
+
+				/* Prevent the constant being loaded again */
+				psConstantLoad->uDestIdx = 0xDEAD;
+			}
+		}
+
+		psReg->ui32ConstantCount = uConstantCount;
+	}
+
+	PVRCleanupUniflexHw(psCache->pvUniFlexContext, &sUniFlexHW);
+
+	psDetails->ui32SecondaryAttributeCount = uNumSecAttribs;
+	psDetails->ui32MemoryConstantCount = uNumMemConsts;
+
+	return IMG_TRUE;
+}
+
+/*****************************************************************************
+ FUNCTION	: CompileKey
+
+ PURPOSE	: Adds the variant of a state log key to the cache, generating and
+			  compiling it unless it is already present.
+
+ PARAMETERS	: hClientHandle	- The cache.
+			  pui32Key		- FFTNLGenDesc followed by the output masks.
+
+ RETURNS	: Nothing.
+*****************************************************************************/
+static IMG_VOID IMG_CALLCONV CompileKey(IMG_HANDLE hClientHandle, const IMG_UINT32 *pui32Key)
+{
+	PCACHE			psCache = (PCACHE)hClientHandle;
+	FFTNLGenDesc	sDesc;
+	FFGenProgram	*psProgram;
+	IMG_UINT32		*pui32Record;
+	IMG_UINT32		uSizeInDWords;
+
+	if (FindRecord(psCache, pui32Key))
+	{
+		psCache->uNumDuplicates++;
+		return;
+	}
+
+	memcpy(&sDesc, pui32Key, sizeof(sDesc));
+
+	psProgram = FFGenGenerateTNLProgram(psCache->pvFFGenContext, &sDesc);
+	if (psProgram == NULL)
+	{
+		fprintf(stderr, "FFGen failed to generate a variant.\n");
+		psCache->uNumFailed++;
+		return;
+	}
+
+	if (!CompileProgram(psCache, psProgram, &pui32Key[FFGEN_CACHE_TNL_DESC_DWORDS]))
+	{
+		psCache->uNumFailed++;
+	}
+	else if ((uSizeInDWords = FFGenCacheGetRecordSize(psProgram, FFGEN_CACHE_TNL_KEY_DWORDS)) == 0)
+	{
+		fprintf(stderr, "Variant too large to cache.\n");
+		psCache->uNumFailed++;
+	}
+	else
+	{
+		pui32Record = malloc(uSizeInDWords * sizeof(IMG_UINT32));
+		if (pui32Record == NULL)
+		{
+			fprintf(stderr, "Out of memory.\n");
+			exit(1);
+		}
+
+		FFGenCacheBuildRecord(psProgram, pui32Key, FFGEN_CACHE_TNL_KEY_DWORDS, 0, pui32Record);
+
+		AddRecord(psCache, pui32Record);
+		psCache->uNumCompiled++;
+	}
+
+	free(psProgram->pui32UFConstantData);
+	free(psProgram->pui32UFConstantDest);
+
+	FFGenFreeProgram(psCache->pvFFGenContext, psProgram);
+}
+
+/*****************************************************************************
+ FUNCTION	: MergeRecord
+
+ PURPOSE	: Adds a record read from a cache file, unless it is a duplicate.
+
+ PARAMETERS	: hClientHandle	- The cache.
+			  pui32Record	- The record.
+
+ RETURNS	: IMG_TRUE if the cache kept the record.
+*****************************************************************************/
+static IMG_BOOL IMG_CALLCONV MergeRecord(IMG_HANDLE hClientHandle, IMG_UINT32 *pui32Record)
+{
+	PCACHE psCache = (PCACHE)hClientHandle;
+
+	if (FindRecord(psCache, &pui32Record[FFGEN_CACHE_RECORD_HEADER_DWORDS]))
+	{
+		psCache->uNumDuplicates++;
+		return IMG_FALSE;
+	}
+
+	AddRecord(psCache, pui32Record);
+
+	return IMG_TRUE;
+}
+
+/*****************************************************************************
+ FUNCTION	: NextRecord
+
+ PURPOSE	: Hands the records of the cache to FFGenCacheWriteFile.
+
+ PARAMETERS	: hClientHandle	- The cache.
+
+ RETURNS	: The next record, or IMG_NULL after the last.
+*****************************************************************************/
+static const IMG_UINT32 * IMG_CALLCONV NextRecord(IMG_HANDLE hClientHandle)
+{
+	PCACHE			psCache = (PCACHE)hClientHandle;
+	PCACHE_RECORD	psRecord = psCache->psNextToWrite;
+
+	if (psRecord == NULL)
+	{
+		return IMG_NULL;
+	}
+
+	psCache->psNextToWrite = psRecord->psNext;
+
+	return psRecord->pui32Record;
+}
+
+/*****************************************************************************
+ FUNCTION	: ReportStatus
+
+ PURPOSE	: Reports how reading an input went.
+
+ PARAMETERS	: pszFileName	- The input.
+			  eStatus		- Result of reading it.
+			  uNumBefore	- Number of variants before it was read.
+			  uNumAfter		- Number of variants after it was read.
+
+ RETURNS	: IMG_FALSE if the input could not be used at all.
+*****************************************************************************/
+static IMG_BOOL ReportStatus(const IMG_CHAR *pszFileName, FFGEN_CACHE_STATUS eStatus, IMG_UINT32 uNumBefore, IMG_UINT32 uNumAfter)
+{
+	switch (eStatus)
+	{
+		case FFGEN_CACHE_NOT_FOUND:
+		{
+			fprintf(stderr, "%s: Couldn't open.\n", pszFileName);
+			return IMG_FALSE;
+		}
+		case FFGEN_CACHE_MISMATCH:
+		{
+			/* The driver would throw the whole file away */
+			fprintf(stderr, "%s: Not written by this driver, skipping.\n", pszFileName);
+			return IMG_FALSE;
+		}
+		case FFGEN_CACHE_DAMAGED:
+		{
+			fprintf(stderr, "%s: Damaged, only the records before the damage were used.\n", pszFileName);
+			break;
+		}
+		case FFGEN_CACHE_NO_MEMORY:
+		{
+			fprintf(stderr, "Out of memory.\n");
+			exit(1);
+		}
+		default:
+		{
+			break;
+		}
+	}
+
+	printf("%s: %u new variants\n", pszFileName, uNumAfter - uNumBefore);
+
+	return IMG_TRUE;
+}
+
+int main(int argc, char **argv)
+{
+	CACHE				sCache;
+	const IMG_CHAR		*pszOutput = NULL;
+	IMG_UINT32			uNumInputs = 0, uNumBefore;
+	IMG_BOOL			bFailed = IMG_FALSE;
+	FFGEN_CACHE_STATUS	eStatus;
+	int					i;
+	PCACHE_RECORD		psRecord;
+
+	memset(&sCache, 0, sizeof(sCache));
+
+	for (i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-o") == 0 || strcmp(argv[i], "-l") == 0)
+		{
+			if (++i == argc)
+			{
+				Usage();
+				return 1;
+			}
+			if (argv[i - 1][1] == 'o')
+			{
+				pszOutput = argv[i];
+			}
+			else
+			{
+				uNumInputs++;
+			}
+		}
+		else if (strcmp(argv[i], "-v") == 0)
+		{
+			g_bVerbose = IMG_TRUE;
+		}
+		else if (argv[i][0] == '-')
+		{
+			Usage();
+			return 1;
+		}
+		else
+		{
+			uNumInputs++;
+		}
+	}
+
+	if (uNumInputs == 0)
+	{
+		Usage();
+		return 1;
+	}
+
+	sCache.pvFFGenContext = FFGenCreateContext(IMG_NULL, IMG_NULL, ToolMalloc, ToolCalloc, ToolRealloc, ToolFree, ToolPrint);
+	sCache.pvUniFlexContext = PVRUniFlexCreateContext(UniFlexAlloc, UniFlexFree, ToolPrint,
+													  IMG_NULL, IMG_NULL, IMG_NULL, IMG_NULL, IMG_NULL);
+
+	if (sCache.pvFFGenContext == NULL || sCache.pvUniFlexContext == NULL)
+	{
+		fprintf(stderr, "Couldn't create the FFGen and USC contexts.\n");
+		return 1;
+	}
+
+	/* Caches first, so the variants they already hold aren't compiled again */
+	for (i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-o") == 0 || strcmp(argv[i], "-l") == 0)
+		{
+			i++;
+			continue;
+		}
+		if (argv[i][0] == '-')
+		{
+			continue;
+		}
+
+		uNumBefore = sCache.uNumRecords;
+
+		eStatus = FFGenCacheReadFile(argv[i], FFGEN_CACHE_TNL_KEY_DWORDS, (IMG_HANDLE)&sCache, ToolMalloc, ToolFree, MergeRecord);
+
+		if (!ReportStatus(argv[i], eStatus, uNumBefore, sCache.uNumRecords))
+		{
+			bFailed = IMG_TRUE;
+		}
+	}
+
+	for (i = 1; i < argc - 1; i++)
+	{
+		if (strcmp(argv[i], "-l") != 0)
+		{
+			continue;
+		}
+
+		i++;
+
+		uNumBefore = sCache.uNumRecords;
+
+		eStatus = FFGenStateLogRead(argv[i], FFGEN_CACHE_TNL_KEY_DWORDS, (IMG_HANDLE)&sCache, CompileKey);
+
+		if (!ReportStatus(argv[i], eStatus, uNumBefore, sCache.uNumRecords))
+		{
+			bFailed = IMG_TRUE;
+		}
+	}
+
+	printf("%u variants (%u compiled), %u instructions, %u duplicates, %u failed to compile\n",
+		   sCache.uNumRecords, sCache.uNumCompiled, sCache.uNumInstructions, sCache.uNumDuplicates, sCache.uNumFailed);
+
+	if (sCache.uNumFailed != 0)
+	{
+		bFailed = IMG_TRUE;
+	}
+
+	if (pszOutput != NULL)
+	{
+		sCache.psNextToWrite = sCache.psFirst;
+
+		if (!FFGenCacheWriteFile(pszOutput, IMG_NULL, FFGEN_CACHE_TNL_KEY_DWORDS, (IMG_HANDLE)&sCache, NextRecord))
+		{
+			fprintf(stderr, "%s: Write failed.\n", pszOutput);
+			bFailed = IMG_TRUE;
+		}
+	}
+
+	while (sCache.psFirst != NULL)
+	{
+		psRecord = sCache.psFirst;
+		sCache.psFirst = psRecord->psNext;
+
+		free(psRecord->pui32Record);
+		free(psRecord);
+	}
+
+	PVRUniFlexDestroyContext(sCache.pvUniFlexContext);
+	FFGenDestroyContext(sCache.pvFFGenContext);
+
+	return bFailed ? 1 : 0;
+}
+
+/******************************************************************************
+ End of file (main.c)
+******************************************************************************/
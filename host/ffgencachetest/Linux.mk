@@ -0,0 +1,33 @@
+# Copyright	2010 Imagination Technologies Limited. All rights reserved.
+#
+# No part of this software, either material or conceptual may be
+# copied or distributed, transmitted, transcribed, stored in a
+# retrieval system or translated into any human or computer
+# language in any form by any means, electronic, mechanical,
+# manual or other-wise, or disclosed to third parties without
+# the express written permission of: Imagination Technologies
+# Limited, HomePark Industrial Estate, Kings Langley,
+# Hertfordshire, WD4 8LZ, UK
+#
+# $Log: Linux.mk $
+#
+
+# ffgencache.c is built with the GLES1 driver's configuration so that the
+# key size matches the FFTNLGenDesc the driver writes.
+modules := ffgencachetest
+
+ffgencachetest_type := host_executable
+
+ffgencachetest_target := ffgencachetest
+
+ffgencachetest_src = \
+ main.c \
+ $(TOP)/codegen/ffgen/ffgencache.c
+
+ffgencachetest_cflags := \
+ -DFFGEN_UNIFLEX -DOUTPUT_USCHW -DSUPPORT_OPENGLES1 -DOGLES1_MODULE \
+ -DUSER -DSUPPORT_SGX -DSUPPORT_SGX543 -include psp2_pvr_desc.h
+
+ffgencachetest_includes := include4 hwdefs services4/include \
+ services4/system/psp2 eurasiacon/include eurasiacon/common \
+ codegen/ffgen tools/intern/usc2 tools/intern/useasm host/include
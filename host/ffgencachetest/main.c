@@ -0,0 +1,644 @@
+/******************************************************************************
+ * Name         : main.c
+ * Title        : FFGen TNL variant cache file tests (ffgencachetest)
+ *
+ * Copyright    : 2010 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means,electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Description  : Builds codegen/ffgen/ffgencache.c on the host and checks
+ *                the cache files and state logs shared by the GLES1 driver
+ *                and host/ffgencache.
+ *
+ *                Records are built with FFGenCacheBuildRecord from
+ *                FFGenProgram fixtures of random size, as they would be
+ *                after CompileFFGenUniFlexCode, then:
+ *
+ *                - saved and loaded back unchanged, without leaving the
+ *                  temporary file behind, including over an older cache;
+ *                - rejected as a whole when the header was written by
+ *                  another driver build or for keys of another size;
+ *                - loaded up to, and not including, a truncated or
+ *                  corrupt record.
+ *
+ *                State logs are appended to across reopens and read back
+ *                in order, ignoring a key cut short by a crash, and are
+ *                started again when written for keys of another size.
+ *
+ *                Files are created in the current directory. Exits with a
+ *                non-zero status if a check fails.
+ *
+ * Modifications:-
+ * $Log: main.c $
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "img_types.h"
+#include "ffgencache.h"
+#include "hosttest.h"
+
+#define TEST_CACHE_FILE			"ffgencachetest.bin"
+#define TEST_TEMP_FILE			TEST_CACHE_FILE ".tmp"
+#define TEST_STATELOG_FILE		"ffgencachetest.log"
+
+#define TEST_NUM_RECORDS		64
+#define TEST_MAX_RECORDS		(2 * TEST_NUM_RECORDS)
+#define TEST_KEY_DWORDS			FFGEN_CACHE_TNL_KEY_DWORDS
+#define TEST_MAX_CONSTANT_REGS	6
+#define TEST_MAX_REG_DWORDS		64
+
+typedef struct _TEST_RECORDS_
+{
+	IMG_UINT32	*apui32Record[TEST_MAX_RECORDS];
+	IMG_UINT32	ui32NumRecords;
+
+	/* Next record handed to FFGenCacheWriteFile */
+	IMG_UINT32	ui32NextToWrite;
+} TEST_RECORDS;
+
+typedef struct _TEST_KEYS_
+{
+	IMG_UINT32	aui32Keys[TEST_NUM_RECORDS][TEST_KEY_DWORDS];
+	IMG_UINT32	ui32NumKeys;
+	IMG_UINT32	ui32KeyDWords;
+} TEST_KEYS;
+
+
+static IMG_VOID *Alloc(IMG_UINT32 ui32Size)
+{
+	IMG_VOID *pvData = malloc(ui32Size);
+
+	if (!pvData)
+	{
+		fprintf(stderr, "out of memory\n");
+		exit(2);
+	}
+
+	return pvData;
+}
+
+static IMG_PVOID IMG_CALLCONV TestMalloc(IMG_HANDLE hHandle, IMG_UINT32 ui32Size)
+{
+	PVR_UNREFERENCED_PARAMETER(hHandle);
+
+	return Alloc(ui32Size);
+}
+
+static IMG_VOID IMG_CALLCONV TestFree(IMG_HANDLE hHandle, IMG_VOID *pvData)
+{
+	PVR_UNREFERENCED_PARAMETER(hHandle);
+
+	free(pvData);
+}
+
+static IMG_BOOL FileExists(const IMG_CHAR *pszFileName)
+{
+	FILE *pFile = fopen(pszFileName, "rb");
+
+	if (!pFile)
+	{
+		return IMG_FALSE;
+	}
+
+	fclose(pFile);
+
+	return IMG_TRUE;
+}
+
+static long FileSize(const IMG_CHAR *pszFileName)
+{
+	FILE *pFile = fopen(pszFileName, "rb");
+	long lSize;
+
+	if (!pFile)
+	{
+		return -1;
+	}
+
+	fseek(pFile, 0, SEEK_END);
+	lSize = ftell(pFile);
+	fclose(pFile);
+
+	return lSize;
+}
+
+/* Overwrites one dword of a file */
+static IMG_VOID PokeFile(const IMG_CHAR *pszFileName, long lOffsetInDWords, IMG_UINT32 ui32Value)
+{
+	FILE *pFile = fopen(pszFileName, "r+b");
+
+	if (!pFile)
+	{
+		fprintf(stderr, "can't open %s\n", pszFileName);
+		exit(2);
+	}
+
+	fseek(pFile, lOffsetInDWords * (long)sizeof(IMG_UINT32), SEEK_SET);
+	fwrite(&ui32Value, sizeof(ui32Value), 1, pFile);
+	fclose(pFile);
+}
+
+/* Cuts a file short, as a crash while writing it would */
+static IMG_VOID TruncateFile(const IMG_CHAR *pszFileName, long lSize)
+{
+	FILE *pFile = fopen(pszFileName, "rb");
+	IMG_UINT8 *pui8Data = Alloc((IMG_UINT32)lSize);
+
+	if (!pFile || fread(pui8Data, 1, (size_t)lSize, pFile) != (size_t)lSize)
+	{
+		fprintf(stderr, "can't read %s\n", pszFileName);
+		exit(2);
+	}
+	fclose(pFile);
+
+	pFile = fopen(pszFileName, "wb");
+	fwrite(pui8Data, 1, (size_t)lSize, pFile);
+	fclose(pFile);
+
+	free(pui8Data);
+}
+
+/*
+	A compiled program as left by CompileFFGenUniFlexCode: constant register
+	mappings, static constants and instructions, all filled with random data
+*/
+static IMG_UINT32 *BuildRecord(IMG_UINT32 ui32Seed)
+{
+	FFGenProgram sProgram;
+	FFGEN_PROGRAM_DETAILS sDetails;
+	FFGenRegList asRegList[TEST_MAX_CONSTANT_REGS];
+	FFGenReg asReg[TEST_MAX_CONSTANT_REGS];
+	IMG_UINT32 aui32SrcOffset[TEST_MAX_CONSTANT_REGS][TEST_MAX_REG_DWORDS];
+	IMG_UINT32 aui32DstOffset[TEST_MAX_CONSTANT_REGS][TEST_MAX_REG_DWORDS];
+	IMG_UINT32 aui32UFConstantData[32], aui32UFConstantDest[32];
+	IMG_UINT32 aui32Key[TEST_KEY_DWORDS];
+	IMG_UINT32 *pui32Instructions, *pui32Record;
+	IMG_UINT32 ui32NumRegs, ui32SizeInDWords, i, j;
+
+	memset(&sProgram, 0, sizeof(sProgram));
+	memset(&sDetails, 0, sizeof(sDetails));
+
+	/* The seed makes the key unique */
+	for (i = 0; i < TEST_KEY_DWORDS; i++)
+	{
+		aui32Key[i] = Random();
+	}
+	aui32Key[0] = ui32Seed;
+
+	sDetails.bUSEPerInstanceMode			= Random() & 1;
+	sDetails.ui32InstructionCount			= 1 + Random() % 200;
+	sDetails.ui32PrimaryAttributeCount		= Random() % 16;
+	sDetails.ui32SecondaryAttributeCount	= Random() % 128;
+	sDetails.ui32TemporaryRegisterCount		= Random() % 96;
+	sDetails.ui32MemoryConstantCount		= Random() % 64;
+	sDetails.iSAAddressAdjust				= (IMG_INT16)(Random() % 32) - 16;
+
+	pui32Instructions = Alloc(sDetails.ui32InstructionCount * FFGEN_CACHE_DWORDS_PER_INSTRUCTION * sizeof(IMG_UINT32));
+
+	for (i = 0; i < sDetails.ui32InstructionCount * FFGEN_CACHE_DWORDS_PER_INSTRUCTION; i++)
+	{
+		pui32Instructions[i] = Random() ^ (Random() << 16);
+	}
+
+	sDetails.pui32Instructions = pui32Instructions;
+	sProgram.psFFGENProgramDetails = &sDetails;
+
+	sProgram.ui32NumUFConstants = Random() % 32;
+	sProgram.ui32MaxNumUFConstants = 32;
+	sProgram.pui32UFConstantData = aui32UFConstantData;
+	sProgram.pui32UFConstantDest = aui32UFConstantDest;
+
+	for (i = 0; i < sProgram.ui32NumUFConstants; i++)
+	{
+		aui32UFConstantData[i] = Random();
+		aui32UFConstantDest[i] = Random() % 512;
+	}
+
+	/* Registers with no constants loaded are recorded too */
+	ui32NumRegs = Random() % (TEST_MAX_CONSTANT_REGS + 1);
+
+	for (i = 0; i < ui32NumRegs; i++)
+	{
+		asReg[i].uSizeInDWords = 1 + Random() % TEST_MAX_REG_DWORDS;
+		asReg[i].ui32ConstantCount = Random() % (asReg[i].uSizeInDWords + 1);
+		asReg[i].pui32SrcOffset = aui32SrcOffset[i];
+		asReg[i].pui32DstOffset = aui32DstOffset[i];
+
+		for (j = 0; j < asReg[i].ui32ConstantCount; j++)
+		{
+			aui32SrcOffset[i][j] = Random() % asReg[i].uSizeInDWords;
+			aui32DstOffset[i][j] = Random() % 512;
+		}
+
+		asRegList[i].psReg = &asReg[i];
+		asRegList[i].psNext = (i + 1 < ui32NumRegs) ? &asRegList[i + 1] : IMG_NULL;
+	}
+
+	sProgram.psConstantsList = ui32NumRegs ? &asRegList[0] : IMG_NULL;
+
+	ui32SizeInDWords = FFGenCacheGetRecordSize(&sProgram, TEST_KEY_DWORDS);
+	Check(ui32SizeInDWords != 0, "build", "record size");
+
+	pui32Record = Alloc(ui32SizeInDWords * sizeof(IMG_UINT32));
+
+	FFGenCacheBuildRecord(&sProgram, aui32Key, TEST_KEY_DWORDS, Random(), pui32Record);
+
+	Check(((FFGenCacheRecordHeader *)pui32Record)->ui32SizeInDWords == ui32SizeInDWords, "build", "size in record header");
+	Check(FFGenCacheValidateRecord(pui32Record, TEST_KEY_DWORDS), "build", "built record doesn't validate");
+	Check(memcmp(&pui32Record[ui32SizeInDWords - sDetails.ui32InstructionCount * FFGEN_CACHE_DWORDS_PER_INSTRUCTION],
+				 pui32Instructions,
+				 sDetails.ui32InstructionCount * FFGEN_CACHE_DWORDS_PER_INSTRUCTION * sizeof(IMG_UINT32)) == 0,
+		  "build", "instructions aren't at the end of the record");
+
+	free(pui32Instructions);
+
+	return pui32Record;
+}
+
+static IMG_VOID BuildRecords(TEST_RECORDS *psRecords, IMG_UINT32 ui32NumRecords, IMG_UINT32 ui32FirstSeed)
+{
+	IMG_UINT32 i;
+
+	psRecords->ui32NumRecords = ui32NumRecords;
+	psRecords->ui32NextToWrite = 0;
+
+	for (i = 0; i < ui32NumRecords; i++)
+	{
+		psRecords->apui32Record[i] = BuildRecord(ui32FirstSeed + i);
+	}
+}
+
+static IMG_VOID FreeRecords(TEST_RECORDS *psRecords)
+{
+	IMG_UINT32 i;
+
+	for (i = 0; i < psRecords->ui32NumRecords; i++)
+	{
+		free(psRecords->apui32Record[i]);
+	}
+
+	psRecords->ui32NumRecords = 0;
+}
+
+static const IMG_UINT32 * IMG_CALLCONV NextRecord(IMG_HANDLE hClientHandle)
+{
+	TEST_RECORDS *psRecords = (TEST_RECORDS *)hClientHandle;
+
+	if (psRecords->ui32NextToWrite == psRecords->ui32NumRecords)
+	{
+		return IMG_NULL;
+	}
+
+	return psRecords->apui32Record[psRecords->ui32NextToWrite++];
+}
+
+static IMG_BOOL IMG_CALLCONV KeepRecord(IMG_HANDLE hClientHandle, IMG_UINT32 *pui32Record)
+{
+	TEST_RECORDS *psRecords = (TEST_RECORDS *)hClientHandle;
+
+	if (psRecords->ui32NumRecords == TEST_MAX_RECORDS)
+	{
+		return IMG_FALSE;
+	}
+
+	psRecords->apui32Record[psRecords->ui32NumRecords++] = pui32Record;
+
+	return IMG_TRUE;
+}
+
+static IMG_VOID WriteRecords(TEST_RECORDS *psRecords, const IMG_CHAR *pszTest)
+{
+	psRecords->ui32NextToWrite = 0;
+
+	Check(FFGenCacheWriteFile(TEST_CACHE_FILE, IMG_NULL, TEST_KEY_DWORDS, (IMG_HANDLE)psRecords, NextRecord), pszTest, "write failed");
+	Check(psRecords->ui32NextToWrite == psRecords->ui32NumRecords, pszTest, "not every record was written");
+	Check(!FileExists(TEST_TEMP_FILE), pszTest, "temporary file left behind");
+}
+
+/* Reads the cache and checks it holds the first ui32NumExpected records of psExpected */
+static IMG_VOID CheckCache(IMG_UINT32 ui32KeyDWords, FFGEN_CACHE_STATUS eExpectedStatus,
+						   TEST_RECORDS *psExpected, IMG_UINT32 ui32NumExpected, const IMG_CHAR *pszTest)
+{
+	TEST_RECORDS sRead;
+	FFGEN_CACHE_STATUS eStatus;
+	IMG_UINT32 i;
+
+	sRead.ui32NumRecords = 0;
+
+	eStatus = FFGenCacheReadFile(TEST_CACHE_FILE, ui32KeyDWords, (IMG_HANDLE)&sRead, TestMalloc, TestFree, KeepRecord);
+
+	Check(eStatus == eExpectedStatus, pszTest, "unexpected status");
+	Check(sRead.ui32NumRecords == ui32NumExpected, pszTest, "unexpected number of records");
+
+	for (i = 0; (i < sRead.ui32NumRecords) && (i < ui32NumExpected); i++)
+	{
+		IMG_UINT32 ui32SizeInDWords = ((FFGenCacheRecordHeader *)psExpected->apui32Record[i])->ui32SizeInDWords;
+
+		Check(memcmp(sRead.apui32Record[i], psExpected->apui32Record[i], ui32SizeInDWords * sizeof(IMG_UINT32)) == 0,
+			  pszTest, "record changed");
+	}
+
+	FreeRecords(&sRead);
+}
+
+/* Offset of a record in the cache file, in dwords */
+static long RecordOffset(TEST_RECORDS *psRecords, IMG_UINT32 ui32Record)
+{
+	long lOffset = FFGEN_CACHE_HEADER_DWORDS;
+	IMG_UINT32 i;
+
+	for (i = 0; i < ui32Record; i++)
+	{
+		lOffset += ((FFGenCacheRecordHeader *)psRecords->apui32Record[i])->ui32SizeInDWords;
+	}
+
+	return lOffset;
+}
+
+static IMG_VOID TestSaveLoad(IMG_VOID)
+{
+	TEST_RECORDS sRecords, sNewRecords;
+
+	remove(TEST_CACHE_FILE);
+
+	Check(FFGenCacheReadFile(TEST_CACHE_FILE, TEST_KEY_DWORDS, IMG_NULL, TestMalloc, TestFree, KeepRecord) == FFGEN_CACHE_NOT_FOUND,
+		  "missing", "missing cache not reported");
+
+	/* An empty cache is just a header */
+	sRecords.ui32NumRecords = 0;
+	WriteRecords(&sRecords, "empty");
+	Check(FileSize(TEST_CACHE_FILE) == (long)sizeof(FFGenCacheHeader), "empty", "file size");
+	CheckCache(TEST_KEY_DWORDS, FFGEN_CACHE_OK, &sRecords, 0, "empty");
+
+	BuildRecords(&sRecords, TEST_NUM_RECORDS, 0);
+	WriteRecords(&sRecords, "save");
+	CheckCache(TEST_KEY_DWORDS, FFGEN_CACHE_OK, &sRecords, TEST_NUM_RECORDS, "load");
+
+	/* A smaller cache replaces a larger one completely */
+	BuildRecords(&sNewRecords, TEST_NUM_RECORDS / 4, 1000);
+	WriteRecords(&sNewRecords, "overwrite");
+	CheckCache(TEST_KEY_DWORDS, FFGEN_CACHE_OK, &sNewRecords, TEST_NUM_RECORDS / 4, "overwrite");
+
+	/* A failed write leaves the old cache alone */
+	Check(!FFGenCacheWriteFile("no-such-directory/" TEST_CACHE_FILE, IMG_NULL, TEST_KEY_DWORDS, (IMG_HANDLE)&sRecords, NextRecord),
+		  "failed write", "write into a missing directory succeeded");
+	CheckCache(TEST_KEY_DWORDS, FFGEN_CACHE_OK, &sNewRecords, TEST_NUM_RECORDS / 4, "failed write");
+
+	/* Writers that may run at once each write their own temporary file */
+	sRecords.ui32NextToWrite = 0;
+	Check(FFGenCacheWriteFile(TEST_CACHE_FILE, ".12.abcd", TEST_KEY_DWORDS, (IMG_HANDLE)&sRecords, NextRecord),
+		  "tagged write", "write failed");
+	Check(!FileExists(TEST_CACHE_FILE ".12.abcd" ".tmp"), "tagged write", "temporary file left behind");
+	CheckCache(TEST_KEY_DWORDS, FFGEN_CACHE_OK, &sRecords, TEST_NUM_RECORDS, "tagged write");
+
+	FreeRecords(&sNewRecords);
+	FreeRecords(&sRecords);
+}
+
+static IMG_VOID TestMismatch(IMG_VOID)
+{
+	TEST_RECORDS sRecords;
+	FFGenCacheHeader sHeader;
+
+	BuildRecords(&sRecords, TEST_NUM_RECORDS / 4, 2000);
+
+	/* Keys of another size: the driver's FFTNLGenDesc changed */
+	WriteRecords(&sRecords, "key size");
+	CheckCache(TEST_KEY_DWORDS + 1, FFGEN_CACHE_MISMATCH, &sRecords, 0, "key size");
+
+	/* Every field of the header must match */
+	FFGenCacheSetupHeader(&sHeader, FFGEN_CACHE_MAGIC, TEST_KEY_DWORDS);
+
+	PokeFile(TEST_CACHE_FILE, 2, sHeader.ui32DDKBuild + 1);
+	CheckCache(TEST_KEY_DWORDS, FFGEN_CACHE_MISMATCH, &sRecords, 0, "DDK build");
+
+	WriteRecords(&sRecords, "core");
+	PokeFile(TEST_CACHE_FILE, 3, sHeader.ui32CoreID + 1);
+	CheckCache(TEST_KEY_DWORDS, FFGEN_CACHE_MISMATCH, &sRecords, 0, "core");
+
+	WriteRecords(&sRecords, "core revision");
+	PokeFile(TEST_CACHE_FILE, 4, sHeader.ui32CoreRev + 1);
+	CheckCache(TEST_KEY_DWORDS, FFGEN_CACHE_MISMATCH, &sRecords, 0, "core revision");
+
+	WriteRecords(&sRecords, "format");
+	PokeFile(TEST_CACHE_FILE, 1, FFGEN_CACHE_FORMAT_VERSION + 1);
+	CheckCache(TEST_KEY_DWORDS, FFGEN_CACHE_MISMATCH, &sRecords, 0, "format");
+
+	/* A state log is not a cache */
+	WriteRecords(&sRecords, "magic");
+	PokeFile(TEST_CACHE_FILE, 0, FFGEN_STATELOG_MAGIC);
+	CheckCache(TEST_KEY_DWORDS, FFGEN_CACHE_MISMATCH, &sRecords, 0, "magic");
+
+	/* Short header */
+	TruncateFile(TEST_CACHE_FILE, sizeof(FFGenCacheHeader) - 1);
+	CheckCache(TEST_KEY_DWORDS, FFGEN_CACHE_MISMATCH, &sRecords, 0, "short header");
+
+	FreeRecords(&sRecords);
+}
+
+static IMG_VOID TestDamage(IMG_VOID)
+{
+	TEST_RECORDS sRecords;
+	IMG_UINT32 ui32Record;
+	long lOffset;
+
+	BuildRecords(&sRecords, TEST_NUM_RECORDS, 3000);
+
+	/* Cut short in the middle of the last record, and of its header */
+	WriteRecords(&sRecords, "truncated");
+	TruncateFile(TEST_CACHE_FILE, FileSize(TEST_CACHE_FILE) - sizeof(IMG_UINT32));
+	CheckCache(TEST_KEY_DWORDS, FFGEN_CACHE_DAMAGED, &sRecords, TEST_NUM_RECORDS - 1, "truncated");
+
+	WriteRecords(&sRecords, "truncated header");
+	TruncateFile(TEST_CACHE_FILE, RecordOffset(&sRecords, TEST_NUM_RECORDS - 1) * sizeof(IMG_UINT32) + sizeof(IMG_UINT32));
+	CheckCache(TEST_KEY_DWORDS, FFGEN_CACHE_DAMAGED, &sRecords, TEST_NUM_RECORDS - 1, "truncated header");
+
+	for (ui32Record = 0; ui32Record < TEST_NUM_RECORDS; ui32Record += 7)
+	{
+		const FFGenCacheProgram *psProgram =
+			(const FFGenCacheProgram *)&sRecords.apui32Record[ui32Record][FFGEN_CACHE_RECORD_HEADER_DWORDS + TEST_KEY_DWORDS];
+
+		lOffset = RecordOffset(&sRecords, ui32Record);
+
+		/* Impossible record size */
+		WriteRecords(&sRecords, "record size");
+		PokeFile(TEST_CACHE_FILE, lOffset, FFGEN_CACHE_MAX_RECORD_DWORDS + 1);
+		CheckCache(TEST_KEY_DWORDS, FFGEN_CACHE_DAMAGED, &sRecords, ui32Record, "record size");
+
+		WriteRecords(&sRecords, "empty record");
+		PokeFile(TEST_CACHE_FILE, lOffset, FFGEN_CACHE_RECORD_HEADER_DWORDS);
+		CheckCache(TEST_KEY_DWORDS, FFGEN_CACHE_DAMAGED, &sRecords, ui32Record, "empty record");
+
+		/* Sections that no longer add up to the record size */
+		WriteRecords(&sRecords, "instruction count");
+		PokeFile(TEST_CACHE_FILE, lOffset + FFGEN_CACHE_RECORD_HEADER_DWORDS + TEST_KEY_DWORDS + 1,
+				 psProgram->ui32InstructionCount + 1);
+		CheckCache(TEST_KEY_DWORDS, FFGEN_CACHE_DAMAGED, &sRecords, ui32Record, "instruction count");
+
+		WriteRecords(&sRecords, "constant count");
+		PokeFile(TEST_CACHE_FILE, lOffset + FFGEN_CACHE_RECORD_HEADER_DWORDS + TEST_KEY_DWORDS + 7,
+				 psProgram->ui32NumUFConstants + 1);
+		CheckCache(TEST_KEY_DWORDS, FFGEN_CACHE_DAMAGED, &sRecords, ui32Record, "constant count");
+
+		WriteRecords(&sRecords, "register count");
+		PokeFile(TEST_CACHE_FILE, lOffset + FFGEN_CACHE_RECORD_HEADER_DWORDS + TEST_KEY_DWORDS + 8,
+				 psProgram->ui32NumConstantRegs + 1);
+		CheckCache(TEST_KEY_DWORDS, FFGEN_CACHE_DAMAGED, &sRecords, ui32Record, "register count");
+	}
+
+	/* Garbage after the last record */
+	WriteRecords(&sRecords, "trailing data");
+	{
+		FILE *pFile = fopen(TEST_CACHE_FILE, "ab");
+		IMG_UINT32 ui32Garbage = 0xFFFFFFFF;
+
+		fwrite(&ui32Garbage, sizeof(ui32Garbage), 1, pFile);
+		fclose(pFile);
+	}
+	CheckCache(TEST_KEY_DWORDS, FFGEN_CACHE_DAMAGED, &sRecords, TEST_NUM_RECORDS, "trailing data");
+
+	FreeRecords(&sRecords);
+}
+
+static IMG_VOID IMG_CALLCONV KeepKey(IMG_HANDLE hClientHandle, const IMG_UINT32 *pui32Key)
+{
+	TEST_KEYS *psKeys = (TEST_KEYS *)hClientHandle;
+
+	if (psKeys->ui32NumKeys < TEST_NUM_RECORDS)
+	{
+		memcpy(psKeys->aui32Keys[psKeys->ui32NumKeys], pui32Key, psKeys->ui32KeyDWords * sizeof(IMG_UINT32));
+	}
+
+	psKeys->ui32NumKeys++;
+}
+
+static IMG_VOID CheckStateLog(IMG_UINT32 ui32KeyDWords, FFGEN_CACHE_STATUS eExpectedStatus,
+							  TEST_KEYS *psExpected, IMG_UINT32 ui32NumExpected, const IMG_CHAR *pszTest)
+{
+	TEST_KEYS sRead;
+	IMG_UINT32 i;
+
+	sRead.ui32NumKeys = 0;
+	sRead.ui32KeyDWords = ui32KeyDWords;
+
+	Check(FFGenStateLogRead(TEST_STATELOG_FILE, ui32KeyDWords, (IMG_HANDLE)&sRead, KeepKey) == eExpectedStatus,
+		  pszTest, "unexpected status");
+	Check(sRead.ui32NumKeys == ui32NumExpected, pszTest, "unexpected number of keys");
+
+	for (i = 0; (i < sRead.ui32NumKeys) && (i < ui32NumExpected); i++)
+	{
+		Check(memcmp(sRead.aui32Keys[i], psExpected->aui32Keys[i], ui32KeyDWords * sizeof(IMG_UINT32)) == 0,
+			  pszTest, "key changed");
+	}
+}
+
+static IMG_VOID TestStateLog(IMG_VOID)
+{
+	TEST_KEYS sKeys;
+	IMG_VOID *pvStateLog;
+	IMG_UINT32 i, j;
+
+	remove(TEST_STATELOG_FILE);
+
+	sKeys.ui32KeyDWords = TEST_KEY_DWORDS;
+	sKeys.ui32NumKeys = TEST_NUM_RECORDS;
+
+	for (i = 0; i < TEST_NUM_RECORDS; i++)
+	{
+		for (j = 0; j < TEST_KEY_DWORDS; j++)
+		{
+			sKeys.aui32Keys[i][j] = Random();
+		}
+	}
+
+	Check(FFGenStateLogRead(TEST_STATELOG_FILE, TEST_KEY_DWORDS, IMG_NULL, KeepKey) == FFGEN_CACHE_NOT_FOUND,
+		  "missing log", "missing state log not reported");
+
+	/* Logged over two runs of the driver */
+	pvStateLog = FFGenStateLogOpen(TEST_STATELOG_FILE, TEST_KEY_DWORDS);
+	Check(pvStateLog != IMG_NULL, "log", "open failed");
+
+	for (i = 0; i < TEST_NUM_RECORDS / 2; i++)
+	{
+		Check(FFGenStateLogAppend(pvStateLog, sKeys.aui32Keys[i], TEST_KEY_DWORDS), "log", "append failed");
+	}
+
+	FFGenStateLogClose(pvStateLog);
+
+	pvStateLog = FFGenStateLogOpen(TEST_STATELOG_FILE, TEST_KEY_DWORDS);
+	Check(pvStateLog != IMG_NULL, "log", "reopen failed");
+
+	for (; i < TEST_NUM_RECORDS; i++)
+	{
+		Check(FFGenStateLogAppend(pvStateLog, sKeys.aui32Keys[i], TEST_KEY_DWORDS), "log", "append failed");
+	}
+
+	FFGenStateLogClose(pvStateLog);
+
+	CheckStateLog(TEST_KEY_DWORDS, FFGEN_CACHE_OK, &sKeys, TEST_NUM_RECORDS, "log");
+
+	/* The last key cut short by a crash */
+	TruncateFile(TEST_STATELOG_FILE, FileSize(TEST_STATELOG_FILE) - 3);
+	CheckStateLog(TEST_KEY_DWORDS, FFGEN_CACHE_OK, &sKeys, TEST_NUM_RECORDS - 1, "truncated log");
+
+	/* A state log is independent of the driver build that wrote it */
+	PokeFile(TEST_STATELOG_FILE, 2, 0);
+	CheckStateLog(TEST_KEY_DWORDS, FFGEN_CACHE_OK, &sKeys, TEST_NUM_RECORDS - 1, "log build");
+
+	/* But not of the key size, nor is a cache a state log */
+	CheckStateLog(TEST_KEY_DWORDS - 1, FFGEN_CACHE_MISMATCH, &sKeys, 0, "log key size");
+
+	PokeFile(TEST_STATELOG_FILE, 0, FFGEN_CACHE_MAGIC);
+	CheckStateLog(TEST_KEY_DWORDS, FFGEN_CACHE_MISMATCH, &sKeys, 0, "log magic");
+
+	/* A log that can't be appended to is started again */
+	pvStateLog = FFGenStateLogOpen(TEST_STATELOG_FILE, TEST_KEY_DWORDS);
+	Check(pvStateLog != IMG_NULL, "restarted log", "open failed");
+	Check(FFGenStateLogAppend(pvStateLog, sKeys.aui32Keys[0], TEST_KEY_DWORDS), "restarted log", "append failed");
+	FFGenStateLogClose(pvStateLog);
+
+	CheckStateLog(TEST_KEY_DWORDS, FFGEN_CACHE_OK, &sKeys, 1, "restarted log");
+
+	remove(TEST_STATELOG_FILE);
+}
+
+int main(int argc, char **argv)
+{
+	PVR_UNREFERENCED_PARAMETER(argv);
+
+	if (argc != 1)
+	{
+		fprintf(stderr, "Usage: ffgencachetest\n");
+		return 2;
+	}
+
+	TestSaveLoad();
+	TestMismatch();
+	TestDamage();
+	TestStateLog();
+
+	remove(TEST_CACHE_FILE);
+
+	if (ui32Failures)
+	{
+		printf("%u checks failed\n", ui32Failures);
+		return 1;
+	}
+
+	printf("all checks passed\n");
+	return 0;
+}
+
+/******************************************************************************
+ End of file (main.c)
+******************************************************************************/
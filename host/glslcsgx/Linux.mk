@@ -0,0 +1,125 @@
+# Copyright	2010 Imagination Technologies Limited. All rights reserved.
+#
+# No part of this software, either material or conceptual may be
+# copied or distributed, transmitted, transcribed, stored in a
+# retrieval system or translated into any human or computer
+# language in any form by any means, electronic, mechanical,
+# manual or other-wise, or disclosed to third parties without
+# the express written permission of: Imagination Technologies
+# Limited, HomePark Industrial Estate, Kings Langley,
+# Hertfordshire, WD4 8LZ, UK
+#
+# $Log: Linux.mk $
+#
+
+modules := glslc_sgx
+
+glslc_sgx_type := host_executable
+
+glslc_sgx_target := glslc-sgx
+
+glslc_sgx_src = \
+ main.c \
+ $(TOP)/intermediates/glslparser/glsl_parser.tab.c \
+ $(TOP)/tools/intern/oglcompiler/binshader/esbinshader.c \
+ $(TOP)/tools/intern/oglcompiler/glsl/astbuiltin.c \
+ $(TOP)/tools/intern/oglcompiler/glsl/common.c \
+ $(TOP)/tools/intern/oglcompiler/glsl/error.c \
+ $(TOP)/tools/intern/oglcompiler/glsl/glsl.c \
+ $(TOP)/tools/intern/oglcompiler/glsl/glslfns.c \
+ $(TOP)/tools/intern/oglcompiler/glsl/glsltabs.c \
+ $(TOP)/tools/intern/oglcompiler/glsl/glsltree.c \
+ $(TOP)/tools/intern/oglcompiler/glsl/icbuiltin.c \
+ $(TOP)/tools/intern/oglcompiler/glsl/icemul.c \
+ $(TOP)/tools/intern/oglcompiler/glsl/icgen.c \
+ $(TOP)/tools/intern/oglcompiler/glsl/icode.c \
+ $(TOP)/tools/intern/oglcompiler/glsl/icunroll.c \
+ $(TOP)/tools/intern/oglcompiler/glsl/prepro.c \
+ $(TOP)/tools/intern/oglcompiler/glsl/semantic.c \
+ $(TOP)/tools/intern/oglcompiler/parser/glsldebug.c \
+ $(TOP)/tools/intern/oglcompiler/parser/lex.c \
+ $(TOP)/tools/intern/oglcompiler/parser/memmgr.c \
+ $(TOP)/tools/intern/oglcompiler/parser/parser_metrics.c \
+ $(TOP)/tools/intern/oglcompiler/parser/parser.c \
+ $(TOP)/tools/intern/oglcompiler/parser/symtab.c \
+ $(TOP)/tools/intern/oglcompiler/powervr/bindingsym.c \
+ $(TOP)/tools/intern/oglcompiler/powervr/glsl2uf.c \
+ $(TOP)/tools/intern/oglcompiler/powervr/ic2uf.c \
+ $(TOP)/tools/intern/usc2/asm.c \
+ $(TOP)/tools/intern/usc2/cdg.c \
+ $(TOP)/tools/intern/usc2/cfa.c \
+ $(TOP)/tools/intern/usc2/data.c \
+ $(TOP)/tools/intern/usc2/dce.c \
+ $(TOP)/tools/intern/usc2/debug.c \
+ $(TOP)/tools/intern/usc2/dgraph.c \
+ $(TOP)/tools/intern/usc2/domcalc.c \
+ $(TOP)/tools/intern/usc2/dualissue.c \
+ $(TOP)/tools/intern/usc2/efo.c \
+ $(TOP)/tools/intern/usc2/execpred.c \
+ $(TOP)/tools/intern/usc2/f16opt.c \
+ $(TOP)/tools/intern/usc2/finalise.c \
+ $(TOP)/tools/intern/usc2/groupinst.c \
+ $(TOP)/tools/intern/usc2/hw.c \
+ $(TOP)/tools/intern/usc2/icvt_c10.c \
+ $(TOP)/tools/intern/usc2/icvt_core.c \
+ $(TOP)/tools/intern/usc2/icvt_f16.c \
+ $(TOP)/tools/intern/usc2/icvt_f16_vec.c \
+ $(TOP)/tools/intern/usc2/icvt_f32.c \
+ $(TOP)/tools/intern/usc2/icvt_f32_vec.c \
+ $(TOP)/tools/intern/usc2/icvt_i32.c \
+ $(TOP)/tools/intern/usc2/icvt_mem.c \
+ $(TOP)/tools/intern/usc2/indexreg.c \
+ $(TOP)/tools/intern/usc2/inst_usc.c \
+ $(TOP)/tools/intern/usc2/intcvt.c \
+ $(TOP)/tools/intern/usc2/iregalloc.c \
+ $(TOP)/tools/intern/usc2/iselect.c \
+ $(TOP)/tools/intern/usc2/layout.c \
+ $(TOP)/tools/intern/usc2/pconvert.c \
+ $(TOP)/tools/intern/usc2/precovr.c \
+ $(TOP)/tools/intern/usc2/pregalloc.c \
+ $(TOP)/tools/intern/usc2/regalloc.c \
+ $(TOP)/tools/intern/usc2/reggroup.c \
+ $(TOP)/tools/intern/usc2/regpack.c \
+ $(TOP)/tools/intern/usc2/reorder.c \
+ $(TOP)/tools/intern/usc2/ssa.c \
+ $(TOP)/tools/intern/usc2/usc.c \
+ $(TOP)/tools/intern/usc2/usc_utils.c \
+ $(TOP)/tools/intern/usc2/usedef.c \
+ $(TOP)/tools/intern/usc2/uspbin.c \
+ $(TOP)/tools/intern/usc2/vec34.c \
+ $(TOP)/tools/intern/useasm/specialregs.c \
+ $(TOP)/tools/intern/useasm/specialregs_vec.c \
+ $(TOP)/tools/intern/useasm/useasm.c \
+ $(TOP)/tools/intern/useasm/usedisasm.c \
+ $(TOP)/tools/intern/useasm/useopt.c \
+ $(TOP)/tools/intern/useasm/useperf.c \
+ $(TOP)/tools/intern/useasm/usetab.c \
+ $(TOP)/tools/intern/useasm/utils.c \
+ $(TOP)/tools/intern/usp/usp_finalise.c \
+ $(TOP)/tools/intern/usp/hwinst.c \
+ $(TOP)/tools/intern/usp/usp.c \
+ $(TOP)/tools/intern/usp/uspshader.c \
+ $(TOP)/tools/intern/usp/usp_inputdata.c \
+ $(TOP)/tools/intern/usp/usp_instblock.c \
+ $(TOP)/tools/intern/usp/usp_resultref.c \
+ $(TOP)/tools/intern/usp/usp_sample.c \
+ $(TOP)/tools/intern/usp/usp_texwrite.c \
+ $(TOP)/tools/intern/usp/usp_cache.c
+
+# The compiler only pulls in the SGX core description via sgxerrata.h on the
+# target, so name it explicitly for the host build
+glslc_sgx_cflags := \
+ -DGLSL_ES -DGEN_HW_CODE -DOUTPUT_USPBIN -DSUPPORT_OPENGLES2 \
+ -DSUPPORT_SOURCE_SHADER -DUSER -DSUPPORT_SGX -DSUPPORT_SGX543 \
+ -DINCLUDE_SGX_FEATURE_TABLE -DINCLUDE_SGX_BUG_TABLE \
+ -D'IMG_ABORT()=abort()' -include psp2_pvr_desc.h
+
+glslc_sgx_includes := include4 hwdefs services4/include \
+ services4/system/psp2 eurasiacon/include eurasiacon/common \
+ common/dmscalc intermediates/sgxsupport intermediates/errata \
+ intermediates/glslparser \
+ tools/intern/usp tools/intern/usc2 tools/intern/useasm \
+ tools/intern/oglcompiler/glsl tools/intern/oglcompiler/powervr \
+ tools/intern/oglcompiler/parser tools/intern/oglcompiler/binshader
+
+glslc_sgx_extlibs := m
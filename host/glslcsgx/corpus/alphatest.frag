@@ -0,0 +1,14 @@
+precision mediump float;
+
+uniform sampler2D uTexture;
+uniform float uAlphaRef;
+
+varying vec2 vTexCoord;
+
+void main()
+{
+	vec4 color = texture2D(uTexture, vTexCoord);
+	if (color.a < uAlphaRef)
+		discard;
+	gl_FragColor = color;
+}
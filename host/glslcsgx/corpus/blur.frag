@@ -0,0 +1,18 @@
+precision mediump float;
+
+uniform sampler2D uTexture;
+uniform vec2 uTexelSize;
+uniform float uWeights[9];
+
+varying vec2 vTexCoord;
+
+void main()
+{
+	vec4 sum = vec4(0.0);
+	for (int i = 0; i < 9; i++)
+	{
+		vec2 offset = uTexelSize * float(i - 4);
+		sum += texture2D(uTexture, vTexCoord + offset) * uWeights[i];
+	}
+	gl_FragColor = sum;
+}
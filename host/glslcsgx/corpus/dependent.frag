@@ -0,0 +1,14 @@
+precision mediump float;
+
+uniform sampler2D uTexture;
+uniform sampler2D uOffsets;
+uniform float uTime;
+
+varying vec2 vTexCoord;
+
+void main()
+{
+	vec2 offset = texture2D(uOffsets, vTexCoord + vec2(uTime, 0.0)).xy * 0.05;
+	vec2 coord = vTexCoord + offset;
+	gl_FragColor = texture2D(uTexture, coord) + texture2D(uTexture, coord.yx) * 0.5;
+}
@@ -0,0 +1,15 @@
+precision mediump float;
+
+uniform sampler2D uTexture;
+uniform vec4 uFogColor;
+uniform float uFogDensity;
+
+varying vec2 vTexCoord;
+varying float vEyeDistance;
+
+void main()
+{
+	vec4 color = texture2D(uTexture, vTexCoord);
+	float f = exp2(-uFogDensity * uFogDensity * vEyeDistance * vEyeDistance * 1.442695);
+	gl_FragColor = mix(uFogColor, color, clamp(f, 0.0, 1.0));
+}
@@ -0,0 +1,8 @@
+precision mediump float;
+
+varying vec2 vTexCoord;
+
+void main()
+{
+	gl_FragColor = vTexCoord;
+}
@@ -0,0 +1,32 @@
+uniform mat4 uModelView;
+uniform mat4 uProjection;
+uniform mat3 uNormalMatrix;
+uniform vec3 uLightPos[4];
+uniform vec3 uLightColor[4];
+uniform vec3 uAmbient;
+uniform float uShininess;
+
+attribute vec4 aPosition;
+attribute vec3 aNormal;
+
+varying vec3 vColor;
+
+void main()
+{
+	vec4 eyePos = uModelView * aPosition;
+	vec3 n = normalize(uNormalMatrix * aNormal);
+	vec3 v = normalize(-eyePos.xyz);
+	vec3 color = uAmbient;
+
+	for (int i = 0; i < 4; i++)
+	{
+		vec3 l = normalize(uLightPos[i] - eyePos.xyz);
+		vec3 h = normalize(l + v);
+		float diffuse = max(dot(n, l), 0.0);
+		float specular = pow(max(dot(n, h), 0.0), uShininess);
+		color += uLightColor[i] * (diffuse + specular);
+	}
+
+	vColor = color;
+	gl_Position = uProjection * eyePos;
+}
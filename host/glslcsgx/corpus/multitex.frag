@@ -0,0 +1,17 @@
+precision mediump float;
+
+uniform sampler2D uBase;
+uniform sampler2D uDetail;
+uniform sampler2D uLightmap;
+uniform lowp vec4 uTint;
+
+varying vec2 vTexCoord;
+varying vec2 vLightmapCoord;
+
+void main()
+{
+	lowp vec4 base = texture2D(uBase, vTexCoord);
+	lowp vec4 detail = texture2D(uDetail, vTexCoord * 8.0);
+	lowp vec4 light = texture2D(uLightmap, vLightmapCoord);
+	gl_FragColor = base * detail * 2.0 * light * uTint;
+}
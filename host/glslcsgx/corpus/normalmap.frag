@@ -0,0 +1,21 @@
+precision highp float;
+
+uniform sampler2D uDiffuse;
+uniform sampler2D uNormalMap;
+uniform vec3 uLightColor;
+uniform float uShininess;
+
+varying vec2 vTexCoord;
+varying vec3 vLightDir;
+varying vec3 vHalfVector;
+
+void main()
+{
+	vec3 n = normalize(texture2D(uNormalMap, vTexCoord).xyz * 2.0 - 1.0);
+	vec3 l = normalize(vLightDir);
+	vec3 h = normalize(vHalfVector);
+	vec4 diffuse = texture2D(uDiffuse, vTexCoord);
+	float d = max(dot(n, l), 0.0);
+	float s = pow(max(dot(n, h), 0.0), uShininess);
+	gl_FragColor = vec4(diffuse.rgb * uLightColor * d + uLightColor * s, diffuse.a);
+}
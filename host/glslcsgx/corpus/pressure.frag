@@ -0,0 +1,23 @@
+precision highp float;
+
+uniform vec4 uCoeffs[16];
+
+varying vec4 vInput;
+
+void main()
+{
+	vec4 a[8];
+	for (int i = 0; i < 8; i++)
+	{
+		a[i] = vInput * uCoeffs[i] + uCoeffs[i + 8];
+	}
+	vec4 r = vec4(0.0);
+	for (int i = 0; i < 8; i++)
+	{
+		for (int j = 0; j < 8; j++)
+		{
+			r += a[i] * a[j].wzyx + sin(a[(i + j) - ((i + j) / 8) * 8]);
+		}
+	}
+	gl_FragColor = r;
+}
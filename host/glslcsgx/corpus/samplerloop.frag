@@ -0,0 +1,23 @@
+precision mediump float;
+
+uniform sampler2D uTextures[8];
+uniform vec4 uWeights[8];
+
+varying vec2 vTexCoord;
+
+void main()
+{
+	vec4 sum = vec4(0.0);
+	for (int i = 0; i < 8; i++)
+	{
+		vec4 w = uWeights[i];
+		vec4 c = texture2D(uTextures[i], vTexCoord + w.xy);
+		vec4 d = c * w.z + c.wzyx * w.w;
+		d = max(d, c * 0.25) + min(d.yzwx, c.zwxy * 0.5);
+		d = d * d.wxyz + sqrt(abs(d)) * w;
+		d = mix(d, d.zyxw, w.x) + clamp(d * w.y, 0.0, 1.0);
+		d = d * inversesqrt(dot(d, d) + 1.0) + normalize(d + w);
+		sum += d;
+	}
+	gl_FragColor = sum;
+}
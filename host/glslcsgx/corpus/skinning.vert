@@ -0,0 +1,29 @@
+uniform mat4 uViewProj;
+uniform vec4 uBones[96];
+
+attribute vec4 aPosition;
+attribute vec3 aNormal;
+attribute vec4 aWeights;
+attribute vec4 aIndices;
+attribute vec2 aTexCoord;
+
+varying vec2 vTexCoord;
+varying vec3 vNormal;
+
+vec3 skin(vec4 v, int bone)
+{
+	return vec3(dot(uBones[bone], v), dot(uBones[bone + 1], v), dot(uBones[bone + 2], v));
+}
+
+void main()
+{
+	ivec4 idx = ivec4(aIndices * 3.0);
+	vec3 pos = skin(aPosition, idx.x) * aWeights.x +
+	           skin(aPosition, idx.y) * aWeights.y +
+	           skin(aPosition, idx.z) * aWeights.z +
+	           skin(aPosition, idx.w) * aWeights.w;
+	vec4 n = vec4(aNormal, 0.0);
+	vNormal = normalize(skin(n, idx.x) * aWeights.x + skin(n, idx.y) * aWeights.y);
+	vTexCoord = aTexCoord;
+	gl_Position = uViewProj * vec4(pos, 1.0);
+}
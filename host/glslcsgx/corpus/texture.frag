@@ -0,0 +1,10 @@
+precision mediump float;
+
+uniform sampler2D uTexture;
+
+varying vec2 vTexCoord;
+
+void main()
+{
+	gl_FragColor = texture2D(uTexture, vTexCoord);
+}
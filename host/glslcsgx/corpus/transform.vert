@@ -0,0 +1,12 @@
+uniform mat4 uMVP;
+
+attribute vec4 aPosition;
+attribute vec2 aTexCoord;
+
+varying vec2 vTexCoord;
+
+void main()
+{
+	vTexCoord = aTexCoord;
+	gl_Position = uMVP * aPosition;
+}
@@ -0,0 +1,19 @@
+precision mediump float;
+
+uniform sampler2D uTexture;
+uniform vec4 uKernel[32];
+
+varying vec2 vTexCoord;
+
+void main()
+{
+	vec4 sum = vec4(0.0);
+	for (int i = 0; i < 32; i++)
+	{
+		vec4 k = uKernel[i];
+		vec4 c = texture2D(uTexture, vTexCoord + k.xy);
+		sum += c * k.z + c.wzyx * k.w;
+		sum = max(sum, c * 0.25);
+	}
+	gl_FragColor = sum;
+}
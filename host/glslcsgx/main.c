@@ -0,0 +1,2040 @@
+/******************************************************************************
+ * Name         : main.c
+ * Title        : Offline GLSL ES compiler for SGX (glslc-sgx)
+ *
+ * Copyright    : 2006-2010 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means,electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Description  : Compiles GLSL ES shaders on the host with the same compiler
+ *                settings as glCompileShader, without a devkit.
+ *
+ *                Every <name>.vert or <name>.frag is compiled to UniFlex and
+ *                to USP input (GLSLCompileToUniflex, which runs USC), then
+ *                finalised by the USP with the default patch state. The
+ *                tool writes
+ *
+ *                - <name>.<ext>.bin, the shader binary as accepted by
+ *                  glShaderBinary (GL_SGX_BINARY_IMG) and the blob cache;
+ *                - <name>.<ext>.usp, the USP input (USP_PC_SHADER) as the
+ *                  driver passes it to PVRUniPatchCreateShader, which
+ *                  host/usptest reads;
+ *                - <name>.<ext>.asm, the info log and the disassembly of the
+ *                  finalised code.
+ *
+ *                A directory on the command line stands for all the .vert
+ *                and .frag files in it. With -j the shaders are compiled by
+ *                up to N worker processes; the compiler keeps global state,
+ *                so each worker is a separate instance of this tool.
+ *
+ *                With -r the tool also records per-shader metrics (time
+ *                spent in the front end, each USC phase and the USP, and
+ *                the instruction, register, spill, dual-issue, EFO and
+ *                memory access counts of the finalised code, and the
+ *                useperf estimate of the cycles along its longest path)
+ *                and writes them as CSV or JSON. -b compares the metrics
+ *                with a baseline CSV report and fails if any of them
+ *                regressed by more than the threshold set with -t. Reports
+ *                are always made in a single process, so that the timings
+ *                are comparable.
+ *
+ *                -s N adds a generated fragment shader whose main() is a
+ *                single basic block of N statements. Together with -r it
+ *                measures how the USC scheduling passes scale with the
+ *                block size, without having to keep huge shaders around.
+ *
+ * Modifications:-
+ * $Log: main.c $
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <time.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <process.h>
+#include <direct.h>
+#else
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <dirent.h>
+#include <unistd.h>
+#endif
+
+#include "img_types.h"
+#include "sgxdefs.h"
+#include "glsl2uf.h"
+#include "esbinshader.h"
+#include "usp.h"
+#include "use.h"
+#include "usedisasm.h"
+#include "useperf.h"
+
+/*
+	Limits and register layout used by the OpenGL ES 2.0 driver.
+
+	Important! These must match constants.h, usegles2.h and dmscalc.h in the
+	driver, or the binaries will not load.
+*/
+#define GLSLC_MAX_VERTEX_ATTRIBS				8
+#define GLSLC_MAX_VERTEX_UNIFORM_VECTORS		512
+#define GLSLC_MAX_FRAGMENT_UNIFORM_VECTORS		64
+#define GLSLC_MAX_VARYING_VECTORS				8
+#define GLSLC_MAX_VERTEX_TEXTURE_UNITS			16
+#define GLSLC_MAX_TEXTURE_UNITS					16
+#define GLSLC_MAX_DRAW_BUFFERS					1
+
+#define GLSLC_FRAGMENT_SECATTR_CONSTANTBASE			0x00000000
+#define GLSLC_FRAGMENT_SECATTR_INDEXABLETEMPBASE	0x00000001
+#define GLSLC_FRAGMENT_SECATTR_SCRATCHBASE			0x00000005
+#define GLSLC_FRAGMENT_SECATTR_NUM_RESERVED			0x00000009
+
+#define GLSLC_VERTEX_SECATTR_CONSTANTBASE			0x00000000
+#define GLSLC_VERTEX_SECATTR_INDEXABLETEMPBASE		0x00000001
+#define GLSLC_VERTEX_SECATTR_SCRATCHBASE			0x00000006
+#define GLSLC_VERTEX_SECATTR_NUM_RESERVED			0x0000000A
+
+#if (EURASIA_USE_NUM_UNIFIED_REGISTERS > 2048)
+#define GLSLC_MAX_VS_SECONDARIES			512
+#else
+#define GLSLC_MAX_VS_SECONDARIES			300
+#endif
+#define GLSLC_MAX_PS_SECONDARIES			128
+
+/*
+	The driver takes the temporary register count from the SGX HW info;
+	assume the whole unified store is available, as it is on PSP2.
+*/
+#define GLSLC_NUM_USE_TEMPORARY_REGISTERS	EURASIA_USE_NUM_UNIFIED_REGISTERS
+
+/*
+	Loop unrolling rules set by the driver (shader.c).
+*/
+#define GLSLC_UNROLL_MAX_ITERATIONS			50
+#define GLSLC_UNROLL_MAX_INSTRS				256
+#define GLSLC_UNROLL_MAX_LIVE_COMPONENTS	64
+#define GLSLC_UNROLL_MAX_PARTIAL_FACTOR		4
+
+#define MAX_SHADERS			4096
+#define MAX_WORKERS			64
+#define MAX_PATH_LENGTH		1024
+#define MAX_REPORT_COLUMNS	64
+
+/*
+	Synthetic shaders added with -s are named <prefix><statements>.frag and
+	keep their values in this many vec4 variables.
+*/
+#define SYNTHETIC_SHADER_PREFIX		"synthetic-block-"
+#define SYNTHETIC_SHADER_VARIABLES	8
+#define MAX_SYNTHETIC_STATEMENTS	65536
+
+#if defined(_WIN32)
+typedef HANDLE	WORKER;
+#else
+typedef pid_t	WORKER;
+#endif
+
+/*
+	Metrics recorded for each shader with -r. The USC phase timings must
+	stay in the order of USC_METRICS.
+*/
+typedef enum _SHADER_METRIC_
+{
+	METRIC_FRONTEND_MS = 0,
+	METRIC_USC_BASE,
+	METRIC_USC_MS = METRIC_USC_BASE + USC_METRICS_TOTAL_COMPILE_TIME,
+	METRIC_USP_MS,
+	METRIC_INSTRUCTIONS,
+	METRIC_SA_INSTRUCTIONS,
+	METRIC_TEMPORARIES,
+	METRIC_PRIMARY_ATTRIBUTES,
+	METRIC_SPILL_BYTES,
+	METRIC_DUAL_ISSUED,
+	METRIC_EFOS,
+	METRIC_MEMORY_INSTRUCTIONS,
+	METRIC_PATH_CYCLES,
+	METRIC_BINARY_BYTES,
+	METRIC_COUNT
+} SHADER_METRIC;
+
+typedef struct _SHADER_METRIC_DESC_
+{
+	const IMG_CHAR	*pszName;
+	IMG_BOOL		bTime;				/* Wall clock time in ms, machine dependent */
+	IMG_BOOL		bHigherIsBetter;
+} SHADER_METRIC_DESC;
+
+static const SHADER_METRIC_DESC asMetricDescs[METRIC_COUNT] =
+{
+	{"frontend_ms",				IMG_TRUE,	IMG_FALSE},
+	{"usc_icgen_ms",			IMG_TRUE,	IMG_FALSE},
+	{"usc_valuenum_ms",			IMG_TRUE,	IMG_FALSE},
+	{"usc_indexreg_ms",			IMG_TRUE,	IMG_FALSE},
+	{"usc_flatten_ms",			IMG_TRUE,	IMG_FALSE},
+	{"usc_intopt_ms",			IMG_TRUE,	IMG_FALSE},
+	{"usc_merge_ms",			IMG_TRUE,	IMG_FALSE},
+	{"usc_isel_ms",				IMG_TRUE,	IMG_FALSE},
+	{"usc_regalloc_ms",			IMG_TRUE,	IMG_FALSE},
+	{"usc_c10regalloc_ms",		IMG_TRUE,	IMG_FALSE},
+	{"usc_finalise_ms",			IMG_TRUE,	IMG_FALSE},
+	{"usc_ms",					IMG_TRUE,	IMG_FALSE},
+	{"usp_ms",					IMG_TRUE,	IMG_FALSE},
+	{"instructions",			IMG_FALSE,	IMG_FALSE},
+	{"sa_instructions",			IMG_FALSE,	IMG_FALSE},
+	{"temporaries",				IMG_FALSE,	IMG_FALSE},
+	{"primary_attributes",		IMG_FALSE,	IMG_FALSE},
+	{"spill_bytes",				IMG_FALSE,	IMG_FALSE},
+	{"dual_issued",				IMG_FALSE,	IMG_TRUE},
+	{"efos",					IMG_FALSE,	IMG_TRUE},
+	{"memory_instructions",		IMG_FALSE,	IMG_FALSE},
+	{"path_cycles",				IMG_FALSE,	IMG_FALSE},
+	{"binary_bytes",			IMG_FALSE,	IMG_FALSE},
+};
+
+typedef struct _SHADER_REPORT_
+{
+	const IMG_CHAR	*pszName;
+	IMG_BOOL		bCompiled;
+	IMG_DOUBLE		adMetrics[METRIC_COUNT];
+} SHADER_REPORT, *PSHADER_REPORT;
+
+static const IMG_CHAR	*pszOutputDir		= IMG_NULL;
+static IMG_BOOL			bVerbose			= IMG_FALSE;
+static IMG_UINT32		uPrecisionBitMask	= 0;
+/* Temporary registers USC may allocate, or 0 for the whole unified store */
+static IMG_UINT32		uNumTemporaries		= 0;
+
+/* Loop unrolling rules, as the driver sets them unless changed with -u */
+static GLSLUnrollLoopRules	sUnrollLoopRules	=
+{
+	IMG_TRUE,	/* bEnableUnroll */
+	IMG_TRUE,	/* bUnrollRelativeAddressingOnly */
+	GLSLC_UNROLL_MAX_ITERATIONS,
+	GLSLC_UNROLL_MAX_INSTRS,
+	GLSLC_UNROLL_MAX_LIVE_COMPONENTS,
+	GLSLC_UNROLL_MAX_PARTIAL_FACTOR
+};
+
+/* Rules which can be changed with -u <name>=<value> */
+static const struct
+{
+	const IMG_CHAR	*pszName;
+	IMG_UINT32		*puValue;
+} asUnrollSettings[] =
+{
+	{"iterations",	&sUnrollLoopRules.uMaxNumIterations},
+	{"instrs",		&sUnrollLoopRules.uMaxUnrolledInstrs},
+	{"live",		&sUnrollLoopRules.uMaxLiveComponents},
+	{"factor",		&sUnrollLoopRules.uMaxPartialUnrollFactor},
+};
+
+#define NUM_UNROLL_SETTINGS		(sizeof(asUnrollSettings) / sizeof(asUnrollSettings[0]))
+
+/* Shader being compiled when making a report */
+static PSHADER_REPORT	psCurrentReport		= IMG_NULL;
+static IMG_DOUBLE		adUSCStartTime[USC_METRICS_LAST];
+
+/*
+	Largest allowed regression of each metric against the baseline, in
+	percent, or a negative value to not check it. Timings depend on the
+	machine, so they are only checked when asked for.
+*/
+static IMG_DOUBLE		adThresholds[METRIC_COUNT];
+
+/*****************************************************************************
+ FUNCTION	: Usage
+
+ PURPOSE	: Prints the command line options.
+
+ PARAMETERS	: None.
+
+ RETURNS	: Nothing.
+*****************************************************************************/
+static IMG_VOID Usage(IMG_VOID)
+{
+	fprintf(stderr, "Usage: glslc-sgx [-j <jobs>] [-o <dir>] [-p <mask>] [-T <temps>] [-u <rule>=<value>]...\n");
+	fprintf(stderr, "                 [-v] [-s <statements>]...\n");
+	fprintf(stderr, "                 [-r <report> [-b <baseline.csv>] [-t <metric>=<percent>]...]\n");
+	fprintf(stderr, "                 [<shader|dir> ...]\n");
+	fprintf(stderr, "\n");
+	fprintf(stderr, "  Compiles .vert and .frag shaders to <shader>.bin, <shader>.usp and <shader>.asm.\n");
+	fprintf(stderr, "\n");
+	fprintf(stderr, "  -j <jobs>  Compile up to <jobs> shaders in parallel.\n");
+	fprintf(stderr, "  -o <dir>   Write the output to <dir> instead of next to the shader.\n");
+	fprintf(stderr, "  -p <mask>  Precision adjustment, as the AdjustShaderPrecision apphint.\n");
+	fprintf(stderr, "  -T <temps> Limit USC to <temps> temporary registers (forces spilling).\n");
+	fprintf(stderr, "  -u <rule>=<value>\n");
+	fprintf(stderr, "             Loop unrolling rule, 0 for no limit: iterations (%u), instrs (%u),\n",
+			GLSLC_UNROLL_MAX_ITERATIONS, GLSLC_UNROLL_MAX_INSTRS);
+	fprintf(stderr, "             live components (%u), partial unroll factor (%u).\n",
+			GLSLC_UNROLL_MAX_LIVE_COMPONENTS, GLSLC_UNROLL_MAX_PARTIAL_FACTOR);
+	fprintf(stderr, "  -v         Print the info log of every shader.\n");
+	fprintf(stderr, "  -s <statements>\n");
+	fprintf(stderr, "             Also compile a generated fragment shader made of one basic\n");
+	fprintf(stderr, "             block of <statements> statements (benchmarks USC scheduling).\n");
+	fprintf(stderr, "  -r <report>\n");
+	fprintf(stderr, "             Write the metrics of each shader to <report>, as JSON if the\n");
+	fprintf(stderr, "             name ends in .json and as CSV otherwise.\n");
+	fprintf(stderr, "  -b <baseline.csv>\n");
+	fprintf(stderr, "             Fail if a metric regressed against an earlier CSV report.\n");
+	fprintf(stderr, "  -t <metric>=<percent>\n");
+	fprintf(stderr, "             Allowed regression of <metric> (or 'all'), -1 to ignore it.\n");
+	fprintf(stderr, "             Counts default to 0%%, timings are not checked by default.\n");
+}
+
+/*****************************************************************************
+ FUNCTION	: ReadFile
+
+ PURPOSE	: Reads a whole file into a zero terminated buffer.
+
+ PARAMETERS	: pszFileName	- File to read.
+
+ RETURNS	: The contents, or IMG_NULL.
+*****************************************************************************/
+static IMG_CHAR *ReadFile(const IMG_CHAR *pszFileName)
+{
+	FILE		*psFile = fopen(pszFileName, "rb");
+	IMG_CHAR	*pszBuffer;
+	long		lSize;
+
+	if (!psFile)
+	{
+		return IMG_NULL;
+	}
+
+	fseek(psFile, 0, SEEK_END);
+	lSize = ftell(psFile);
+	fseek(psFile, 0, SEEK_SET);
+
+	pszBuffer = (lSize >= 0) ? malloc((size_t)lSize + 1) : IMG_NULL;
+
+	if (pszBuffer)
+	{
+		if (fread(pszBuffer, 1, (size_t)lSize, psFile) != (size_t)lSize)
+		{
+			free(pszBuffer);
+			pszBuffer = IMG_NULL;
+		}
+		else
+		{
+			pszBuffer[lSize] = '\0';
+		}
+	}
+
+	fclose(psFile);
+
+	return pszBuffer;
+}
+
+/*****************************************************************************
+ FUNCTION	: GetSyntheticStatements
+
+ PURPOSE	: Checks for the name of a synthetic shader added with -s.
+
+ PARAMETERS	: pszFileName		- Shader file name.
+			  puNumStatements	- Returns the number of statements.
+
+ RETURNS	: IMG_TRUE for a synthetic shader.
+*****************************************************************************/
+static IMG_BOOL GetSyntheticStatements(const IMG_CHAR *pszFileName, IMG_UINT32 *puNumStatements)
+{
+	const size_t	uPrefixLength = strlen(SYNTHETIC_SHADER_PREFIX);
+	IMG_CHAR		*pszEnd;
+	unsigned long	ulNumStatements;
+
+	if (strncmp(pszFileName, SYNTHETIC_SHADER_PREFIX, uPrefixLength) != 0)
+	{
+		return IMG_FALSE;
+	}
+
+	ulNumStatements = strtoul(pszFileName + uPrefixLength, &pszEnd, 10);
+	if (pszEnd == pszFileName + uPrefixLength || strcmp(pszEnd, ".frag") != 0 ||
+		ulNumStatements > MAX_SYNTHETIC_STATEMENTS)
+	{
+		return IMG_FALSE;
+	}
+
+	*puNumStatements = (IMG_UINT32)ulNumStatements;
+
+	return IMG_TRUE;
+}
+
+/*****************************************************************************
+ FUNCTION	: GenerateSyntheticShader
+
+ PURPOSE	: Generates a fragment shader whose main() is one basic block.
+
+ PARAMETERS	: uNumStatements	- Number of statements in the block.
+
+ RETURNS	: The source, or IMG_NULL if out of memory.
+
+ NOTES		: The statements update a few variables in turn, each one
+			  reading another, so the block has a mix of long dependency
+			  chains and independent instructions. Every 16th statement is
+			  a dependent texture read.
+*****************************************************************************/
+static IMG_CHAR *GenerateSyntheticShader(IMG_UINT32 uNumStatements)
+{
+	IMG_CHAR	*pszSource = malloc(1024 + (size_t)uNumStatements * 80);
+	IMG_CHAR	*pszPos;
+	IMG_UINT32	i;
+
+	if (!pszSource)
+	{
+		return IMG_NULL;
+	}
+
+	pszPos = pszSource;
+	pszPos += sprintf(pszPos, "precision mediump float;\n"
+							  "uniform sampler2D sTexture;\n"
+							  "uniform vec4 k[16];\n"
+							  "varying vec4 vColour;\n"
+							  "varying vec2 vTexCoord;\n"
+							  "void main()\n"
+							  "{\n");
+
+	for (i = 0; i < SYNTHETIC_SHADER_VARIABLES; i++)
+	{
+		pszPos += sprintf(pszPos, "\tvec4 r%u = vColour * k[%u];\n", i, i);
+	}
+
+	for (i = 0; i < uNumStatements; i++)
+	{
+		IMG_UINT32 uDest = i % SYNTHETIC_SHADER_VARIABLES;
+		IMG_UINT32 uSrc = (i + 3) % SYNTHETIC_SHADER_VARIABLES;
+
+		if ((i % 16) == 15)
+		{
+			pszPos += sprintf(pszPos, "\tr%u += texture2D(sTexture, r%u.xy + vTexCoord);\n", uDest, uSrc);
+		}
+		else
+		{
+			pszPos += sprintf(pszPos, "\tr%u = r%u * k[%u] + r%u.wxyz;\n", uDest, uDest, i % 16, uSrc);
+		}
+	}
+
+	pszPos += sprintf(pszPos, "\tgl_FragColor = r0");
+	for (i = 1; i < SYNTHETIC_SHADER_VARIABLES; i++)
+	{
+		pszPos += sprintf(pszPos, " + r%u", i);
+	}
+	sprintf(pszPos, ";\n}\n");
+
+	return pszSource;
+}
+
+/*****************************************************************************
+ FUNCTION	: GetProgramType
+
+ PURPOSE	: Works out the shader type from the file extension.
+
+ PARAMETERS	: pszFileName	- Shader file name.
+			  peProgramType	- Returns the program type.
+
+ RETURNS	: IMG_FALSE if the file isn't a shader.
+*****************************************************************************/
+static IMG_BOOL GetProgramType(const IMG_CHAR *pszFileName, GLSLProgramType *peProgramType)
+{
+	const IMG_CHAR *pszExt = strrchr(pszFileName, '.');
+
+	if (pszExt && strcmp(pszExt, ".vert") == 0)
+	{
+		*peProgramType = GLSLPT_VERTEX;
+		return IMG_TRUE;
+	}
+	if (pszExt && strcmp(pszExt, ".frag") == 0)
+	{
+		*peProgramType = GLSLPT_FRAGMENT;
+		return IMG_TRUE;
+	}
+
+	return IMG_FALSE;
+}
+
+/*****************************************************************************
+ FUNCTION	: GetBaseName
+
+ PURPOSE	: Strips the directory from a file name.
+
+ PARAMETERS	: pszFileName	- File name.
+
+ RETURNS	: The file name without the directory.
+*****************************************************************************/
+static const IMG_CHAR *GetBaseName(const IMG_CHAR *pszFileName)
+{
+	const IMG_CHAR *pszBase = pszFileName;
+	const IMG_CHAR *psz;
+
+	for (psz = pszFileName; *psz; psz++)
+	{
+		if (*psz == '/' || *psz == '\\')
+		{
+			pszBase = psz + 1;
+		}
+	}
+
+	return pszBase;
+}
+
+/*****************************************************************************
+ FUNCTION	: GetOutputName
+
+ PURPOSE	: Builds the name of an output file for a shader.
+
+ PARAMETERS	: pszFileName	- Shader file name.
+			  pszSuffix		- Suffix of the output file.
+			  pszOutput		- Returns the output file name.
+
+ RETURNS	: IMG_FALSE if the name is too long.
+*****************************************************************************/
+static IMG_BOOL GetOutputName(const IMG_CHAR *pszFileName, const IMG_CHAR *pszSuffix, IMG_CHAR *pszOutput)
+{
+	int iLength;
+
+	if (pszOutputDir)
+	{
+		iLength = snprintf(pszOutput, MAX_PATH_LENGTH, "%s/%s%s", pszOutputDir, GetBaseName(pszFileName), pszSuffix);
+	}
+	else
+	{
+		iLength = snprintf(pszOutput, MAX_PATH_LENGTH, "%s%s", pszFileName, pszSuffix);
+	}
+
+	return (iLength > 0 && iLength < MAX_PATH_LENGTH) ? IMG_TRUE : IMG_FALSE;
+}
+
+/*****************************************************************************
+ FUNCTION	: SetPrecision
+
+ PURPOSE	: Sets up the default GLSL ES precisions, as the driver does.
+
+ PARAMETERS	: psRP					- Precisions to set up.
+			  ui32PrecisionBitMask	- Precision adjustment apphint.
+
+ RETURNS	: Nothing.
+*****************************************************************************/
+static IMG_VOID SetPrecision(GLSLRequestedPrecisions *psRP, IMG_UINT32 ui32PrecisionBitMask)
+{
+	/* Defaults for user defined data */
+	psRP->eDefaultUserVertFloat   = GLSLPRECQ_HIGH;
+	psRP->eDefaultUserVertInt     = GLSLPRECQ_HIGH;
+	psRP->eDefaultUserVertSampler = GLSLPRECQ_LOW;
+	psRP->eDefaultUserFragFloat   = GLSLPRECQ_UNKNOWN;
+	psRP->eDefaultUserFragInt     = GLSLPRECQ_MEDIUM;
+	psRP->eDefaultUserFragSampler = GLSLPRECQ_LOW;
+
+	psRP->eVertBooleanPrecision	  = GLSLPRECQ_HIGH;
+	psRP->eFragBooleanPrecision	  = GLSLPRECQ_HIGH;
+
+	/* Built in data */
+	psRP->eBIStateInt             = GLSLPRECQ_HIGH;
+	psRP->eBIFragFloat            = GLSLPRECQ_MEDIUM;
+
+	/* Specials */
+	psRP->eGLPosition             = GLSLPRECQ_HIGH;
+	psRP->eGLPointSize            = GLSLPRECQ_MEDIUM;
+	psRP->eGLPointCoord           = GLSLPRECQ_MEDIUM;
+	psRP->eDepthRange             = GLSLPRECQ_HIGH;
+
+	/* Disable forcing of precision */
+	psRP->eForceUserVertFloat     = GLSLPRECQ_UNKNOWN;
+	psRP->eForceUserVertInt       = GLSLPRECQ_UNKNOWN;
+	psRP->eForceUserVertSampler   = GLSLPRECQ_UNKNOWN;
+	psRP->eForceUserFragFloat     = GLSLPRECQ_UNKNOWN;
+	psRP->eForceUserFragInt       = GLSLPRECQ_UNKNOWN;
+	psRP->eForceUserFragSampler   = GLSLPRECQ_UNKNOWN;
+
+	/* Not used for ES */
+	psRP->eBIStateFloat           = GLSLPRECQ_UNKNOWN;
+	psRP->eBIVertAttribFloat      = GLSLPRECQ_UNKNOWN;
+	psRP->eBIVaryingFloat         = GLSLPRECQ_UNKNOWN;
+
+	if (ui32PrecisionBitMask)
+	{
+		SET_BITFIELD_REQUESTED_PRECISION(psRP, ui32PrecisionBitMask);
+		if(ui32PrecisionBitMask == 0xFFFFFFFF)
+		{
+			psRP->eDefaultUserVertSampler = GLSLPRECQ_HIGH;
+			psRP->eDefaultUserFragSampler = GLSLPRECQ_HIGH;
+			psRP->eForceUserVertSampler = GLSLPRECQ_HIGH;
+			psRP->eForceUserFragSampler = GLSLPRECQ_HIGH;
+		}
+	}
+}
+
+/*****************************************************************************
+ FUNCTION	: GetTimeMs
+
+ PURPOSE	: Reads a high resolution wall clock.
+
+ PARAMETERS	: None.
+
+ RETURNS	: The time in milliseconds.
+*****************************************************************************/
+static IMG_DOUBLE GetTimeMs(IMG_VOID)
+{
+#if defined(_WIN32)
+	LARGE_INTEGER sCounter;
+	LARGE_INTEGER sFrequency;
+
+	QueryPerformanceCounter(&sCounter);
+	QueryPerformanceFrequency(&sFrequency);
+
+	return (IMG_DOUBLE)sCounter.QuadPart * 1000.0 / (IMG_DOUBLE)sFrequency.QuadPart;
+#else
+	struct timespec sTime;
+
+	clock_gettime(CLOCK_MONOTONIC, &sTime);
+
+	return (IMG_DOUBLE)sTime.tv_sec * 1000.0 + (IMG_DOUBLE)sTime.tv_nsec / 1000000.0;
+#endif
+}
+
+static IMG_VOID IMG_CALLCONV USCStartMetric(IMG_PVOID pvParam, USC_METRICS eCounter)
+{
+	PVR_UNREFERENCED_PARAMETER(pvParam);
+
+	if (eCounter < USC_METRICS_LAST)
+	{
+		adUSCStartTime[eCounter] = GetTimeMs();
+	}
+}
+
+static IMG_VOID IMG_CALLCONV USCFinishMetric(IMG_PVOID pvParam, USC_METRICS eCounter)
+{
+	PVR_UNREFERENCED_PARAMETER(pvParam);
+
+	/* Fragment shaders may go through USC twice, so accumulate */
+	if (psCurrentReport && eCounter <= USC_METRICS_TOTAL_COMPILE_TIME)
+	{
+		psCurrentReport->adMetrics[METRIC_USC_BASE + eCounter] += GetTimeMs() - adUSCStartTime[eCounter];
+	}
+}
+
+/*****************************************************************************
+ FUNCTION	: InitCompiler
+
+ PURPOSE	: Initialises the GLSL compiler, as InitializeGLSLCompiler does.
+
+ PARAMETERS	: psInitCompilerContext	- Compiler context to initialise.
+
+ RETURNS	: IMG_FALSE on failure.
+*****************************************************************************/
+static IMG_BOOL InitCompiler(GLSLInitCompilerContext *psInitCompilerContext)
+{
+	GLSLCompilerResources *psResources = &psInitCompilerContext->sCompilerResources;
+
+	memset(psInitCompilerContext, 0, sizeof(*psInitCompilerContext));
+
+	psInitCompilerContext->eLogFiles = GLSLLF_NOT_LOG;
+
+	psResources->iGLMaxVertexAttribs				= GLSLC_MAX_VERTEX_ATTRIBS;
+	psResources->iGLMaxVertexUniformVectors			= GLSLC_MAX_VERTEX_UNIFORM_VECTORS;
+	psResources->iGLMaxVaryingVectors				= GLSLC_MAX_VARYING_VECTORS;
+	psResources->iGLMaxVertexTextureImageUnits		= GLSLC_MAX_VERTEX_TEXTURE_UNITS;
+	psResources->iGLMaxCombinedTextureImageUnits	= GLSLC_MAX_TEXTURE_UNITS;
+	psResources->iGLMaxTextureImageUnits			= GLSLC_MAX_TEXTURE_UNITS;
+	psResources->iGLMaxFragmentUniformVectors		= GLSLC_MAX_FRAGMENT_UNIFORM_VECTORS;
+	psResources->iGLMaxDrawBuffers					= GLSLC_MAX_DRAW_BUFFERS;
+
+	SetPrecision(&psInitCompilerContext->sRequestedPrecisions, uPrecisionBitMask);
+
+	psInitCompilerContext->sInlineFuncRules.bInlineCalledOnceFunc			= IMG_TRUE;
+	psInitCompilerContext->sInlineFuncRules.bInlineSamplerParamFunc			= IMG_TRUE;
+	psInitCompilerContext->sInlineFuncRules.uNumICInstrsBodyLessThan		= 10;
+	psInitCompilerContext->sInlineFuncRules.uNumParamComponentsGreaterThan	= 32;
+
+	psInitCompilerContext->sUnrollLoopRules = sUnrollLoopRules;
+
+	/* Only record anything while a report is being made */
+	psInitCompilerContext->pfnUSCStartMetric	= USCStartMetric;
+	psInitCompilerContext->pfnUSCFinishMetric	= USCFinishMetric;
+
+	return GLSLInitCompiler(psInitCompilerContext);
+}
+
+static IMG_PVOID IMG_CALLCONV UniPatchAlloc(IMG_UINT32 uSize)
+{
+	return malloc(uSize);
+}
+
+static IMG_VOID IMG_CALLCONV UniPatchFree(IMG_PVOID pvData)
+{
+	free(pvData);
+}
+
+static IMG_VOID IMG_CALLCONV UniPatchPrint(const IMG_CHAR *pszFormat, ...)
+{
+	va_list sArgs;
+
+	if (bVerbose)
+	{
+		va_start(sArgs, pszFormat);
+		vfprintf(stderr, pszFormat, sArgs);
+		va_end(sArgs);
+	}
+}
+
+/*****************************************************************************
+ FUNCTION	: CountInstructions
+
+ PURPOSE	: Counts the dual-issued, EFO and memory instructions in
+			  finalised code and estimates its cycle count.
+
+ PARAMETERS	: psHWShader	- Finalised shader.
+			  psReport		- Report to record the counts in.
+
+ RETURNS	: Nothing.
+*****************************************************************************/
+static IMG_VOID CountInstructions(PUSP_HW_SHADER psHWShader, PSHADER_REPORT psReport)
+{
+	PCSGX_CORE_DESC			psTarget = UseAsmGetCoreDesc(&psHWShader->sTargetDev);
+	USEDIS_RUNTIME_STATE	sRuntimeState;
+	USEPERF_PARAMS			sPerfParams;
+	USEPERF_PROGRAM			sPerfProgram;
+	IMG_PUINT32				puInsts;
+	IMG_UINT32				i;
+
+	sRuntimeState.eColourFormatControl = USEDIS_FORMAT_CONTROL_STATE_ON;
+	sRuntimeState.eEFOFormatControl = USEDIS_FORMAT_CONTROL_STATE_OFF;
+
+	for (i = 0, puInsts = psHWShader->puInsts; i < psHWShader->uInstCount; i++, puInsts += 2)
+	{
+		USE_INST sInst;
+		USE_INST sCoInst;
+
+		sInst.psNext = &sCoInst;
+		if (UseDecodeInstruction(psTarget, puInsts[0], puInsts[1], &sRuntimeState, &sInst) != USEDISASM_OK)
+		{
+			continue;
+		}
+
+		if (sInst.uOpcode == USEASM_OP_EFO)
+		{
+			psReport->adMetrics[METRIC_EFOS] += 1.0;
+		}
+		else if (sInst.uFlags1 & USEASM_OPFLAGS1_MAINISSUE)
+		{
+			psReport->adMetrics[METRIC_DUAL_ISSUED] += 1.0;
+		}
+	}
+
+	UsePerfInitParams(&sPerfParams);
+	if (UsePerfAnalyse(psTarget, &sPerfParams, psHWShader->uInstCount, psHWShader->puInsts, &sPerfProgram))
+	{
+		for (i = 0; i < sPerfProgram.uInstCount; i++)
+		{
+			if (sPerfProgram.psInsts[i].eClass == USEPERF_CLASS_LOAD ||
+				sPerfProgram.psInsts[i].eClass == USEPERF_CLASS_STORE)
+			{
+				psReport->adMetrics[METRIC_MEMORY_INSTRUCTIONS] += 1.0;
+			}
+		}
+		psReport->adMetrics[METRIC_PATH_CYCLES] = (IMG_DOUBLE)sPerfProgram.uPathLatencyCycles;
+
+		UsePerfFree(&sPerfProgram);
+	}
+
+	psReport->adMetrics[METRIC_INSTRUCTIONS]		= (IMG_DOUBLE)psHWShader->uInstCount;
+	psReport->adMetrics[METRIC_SA_INSTRUCTIONS]		= (IMG_DOUBLE)psHWShader->uSAUpdateInstCount;
+	psReport->adMetrics[METRIC_TEMPORARIES]			= (IMG_DOUBLE)psHWShader->uTempRegCount;
+	psReport->adMetrics[METRIC_PRIMARY_ATTRIBUTES]	= (IMG_DOUBLE)psHWShader->uPARegCount;
+	psReport->adMetrics[METRIC_SPILL_BYTES]			= (IMG_DOUBLE)psHWShader->uScratchAreaSize;
+}
+
+/*****************************************************************************
+ FUNCTION	: WriteDisassembly
+
+ PURPOSE	: Finalises a compiled shader with the default USP state and
+			  writes its disassembly.
+
+ PARAMETERS	: psFile		- File to write to.
+			  psPCShader	- USP input of the shader.
+			  psReport		- Report to record the metrics in, or IMG_NULL.
+
+ RETURNS	: IMG_FALSE if the USP failed.
+*****************************************************************************/
+static IMG_BOOL WriteDisassembly(FILE *psFile, PUSP_PC_SHADER psPCShader, PSHADER_REPORT psReport)
+{
+	IMG_PVOID		pvContext;
+	IMG_PVOID		pvShader		= IMG_NULL;
+	PUSP_HW_SHADER	psHWShader		= IMG_NULL;
+	IMG_BOOL		bSuccess		= IMG_FALSE;
+	IMG_DOUBLE		dStartTime		= GetTimeMs();
+	IMG_UINT32		i;
+
+	pvContext = PVRUniPatchCreateContext(UniPatchAlloc, UniPatchFree, UniPatchPrint);
+	if (pvContext)
+	{
+		pvShader = PVRUniPatchCreateShader(pvContext, psPCShader);
+	}
+	if (pvShader)
+	{
+		psHWShader = PVRUniPatchFinaliseShader(pvContext, pvShader);
+	}
+
+	if (psHWShader && psReport)
+	{
+		psReport->adMetrics[METRIC_USP_MS] = GetTimeMs() - dStartTime;
+
+		CountInstructions(psHWShader, psReport);
+	}
+
+	if (psHWShader)
+	{
+		PCSGX_CORE_DESC	psTarget = UseAsmGetCoreDesc(&psHWShader->sTargetDev);
+		IMG_PUINT32		puInsts;
+
+		fprintf(psFile, "Disassembly (%u instructions, %u temporaries, %u primary attributes):\n",
+				psHWShader->uInstCount, psHWShader->uTempRegCount, psHWShader->uPARegCount);
+		fprintf(psFile, "-------------------------------------\n\n");
+
+		for (i = 0, puInsts = psHWShader->puInsts; i < psHWShader->uInstCount; i++, puInsts += 2)
+		{
+			IMG_CHAR pszInst[256];
+
+			if (i == psHWShader->uPTPhase1StartInstIdx && i != 0)
+			{
+				fprintf(psFile, "---------- Phase 1 Start ----------\n");
+			}
+
+			UseDisassembleInstruction(psTarget, puInsts[0], puInsts[1], pszInst);
+			fprintf(psFile, "%4u: 0x%.8X%.8X  %s\n", i, puInsts[1], puInsts[0], pszInst);
+		}
+
+		fprintf(psFile, "-------------------------------------\n\n");
+
+		if (psHWShader->uSAUpdateInstCount)
+		{
+			fprintf(psFile, "Secondary Disassembly:\n");
+			fprintf(psFile, "-------------------------------------\n");
+
+			for (i = 0, puInsts = psHWShader->puSAUpdateInsts; i < psHWShader->uSAUpdateInstCount; i++, puInsts += 2)
+			{
+				IMG_CHAR pszInst[256];
+
+				UseDisassembleInstruction(psTarget, puInsts[0], puInsts[1], pszInst);
+				fprintf(psFile, "%4u: 0x%.8X%.8X  %s\n", i, puInsts[1], puInsts[0], pszInst);
+			}
+
+			fprintf(psFile, "-------------------------------------\n");
+		}
+
+		bSuccess = IMG_TRUE;
+
+		PVRUniPatchDestroyHWShader(pvContext, psHWShader);
+	}
+
+	if (pvShader)
+	{
+		PVRUniPatchDestroyShader(pvContext, pvShader);
+	}
+	if (pvContext)
+	{
+		PVRUniPatchDestroyContext(pvContext);
+	}
+
+	return bSuccess;
+}
+
+/*****************************************************************************
+ FUNCTION	: CompileShader
+
+ PURPOSE	: Compiles one shader and writes the output files.
+
+ PARAMETERS	: psInitCompilerContext	- Initialised compiler.
+			  pszFileName			- Shader to compile.
+			  psReport				- Report to record the metrics in, or
+									  IMG_NULL.
+
+ RETURNS	: IMG_FALSE if the shader failed to compile.
+*****************************************************************************/
+static IMG_BOOL CompileShader(GLSLInitCompilerContext *psInitCompilerContext, const IMG_CHAR *pszFileName, PSHADER_REPORT psReport)
+{
+	GLSLProgramType						eProgramType;
+	GLSLUniFlexHWCodeInfo				sUniFlexInfo;
+	UNIFLEX_PROGRAM_PARAMETERS			sUniFlexParams;
+	GLSLCompileProgramContext			sCompileContext;
+	GLSLCompileUniflexProgramContext	sCompileUniflexContext;
+	GLSLCompiledUniflexProgram			*psCompiledProgram;
+	IMG_CHAR							*pszSource;
+	IMG_CHAR							szOutput[MAX_PATH_LENGTH];
+	IMG_PVOID							pvBinary		= IMG_NULL;
+	IMG_UINT32							uBinarySize		= 0;
+	PUSP_PC_SHADER						psPCShader;
+	IMG_UINT32							uPCShaderSize;
+	IMG_BOOL							bSuccess		= IMG_FALSE;
+	IMG_DOUBLE							dStartTime;
+	IMG_UINT32							uNumStatements;
+	FILE								*psFile;
+
+	if (!GetProgramType(pszFileName, &eProgramType))
+	{
+		fprintf(stderr, "%s: not a .vert or .frag shader\n", pszFileName);
+		return IMG_FALSE;
+	}
+
+	if (GetSyntheticStatements(pszFileName, &uNumStatements))
+	{
+		pszSource = GenerateSyntheticShader(uNumStatements);
+	}
+	else
+	{
+		pszSource = ReadFile(pszFileName);
+	}
+	if (!pszSource)
+	{
+		fprintf(stderr, "%s: can't read shader\n", pszFileName);
+		return IMG_FALSE;
+	}
+
+	memset(&sUniFlexInfo, 0, sizeof(sUniFlexInfo));
+	memset(&sUniFlexParams, 0, sizeof(sUniFlexParams));
+	memset(&sCompileContext, 0, sizeof(sCompileContext));
+	memset(&sCompileUniflexContext, 0, sizeof(sCompileUniflexContext));
+
+	/* Must be able to fit a 2x2 block in */
+	sUniFlexParams.uNumAvailableTemporaries = GLSLC_NUM_USE_TEMPORARY_REGISTERS >> 2;
+	if (uNumTemporaries != 0)
+	{
+		sUniFlexParams.uNumAvailableTemporaries = uNumTemporaries;
+	}
+
+	if (eProgramType == GLSLPT_FRAGMENT)
+	{
+		sUniFlexParams.uConstantBase		= GLSLC_FRAGMENT_SECATTR_CONSTANTBASE;
+		sUniFlexParams.uIndexableTempBase	= GLSLC_FRAGMENT_SECATTR_INDEXABLETEMPBASE;
+		sUniFlexParams.uScratchBase			= GLSLC_FRAGMENT_SECATTR_SCRATCHBASE;
+
+		sUniFlexParams.uInRegisterConstantOffset = GLSLC_FRAGMENT_SECATTR_NUM_RESERVED;
+		sUniFlexParams.uInRegisterConstantLimit = GLSLC_MAX_PS_SECONDARIES - sUniFlexParams.uInRegisterConstantOffset;
+
+		sUniFlexParams.uPackDestType = USEASM_REGTYPE_PRIMATTR;
+		sUniFlexParams.uPackPrecision = 5;
+		sUniFlexParams.uExtraPARegisters = 0;
+	}
+	else
+	{
+		sUniFlexParams.uConstantBase		= GLSLC_VERTEX_SECATTR_CONSTANTBASE;
+		sUniFlexParams.uIndexableTempBase	= GLSLC_VERTEX_SECATTR_INDEXABLETEMPBASE;
+		sUniFlexParams.uScratchBase			= GLSLC_VERTEX_SECATTR_SCRATCHBASE;
+
+		sUniFlexParams.uInRegisterConstantOffset = GLSLC_VERTEX_SECATTR_NUM_RESERVED;
+		sUniFlexParams.uInRegisterConstantLimit = GLSLC_MAX_VS_SECONDARIES - sUniFlexParams.uInRegisterConstantOffset;
+
+		sUniFlexParams.uExtraPARegisters = 0;
+	}
+
+	sUniFlexParams.ePredicationLevel = UF_PREDLVL_AUTO;
+	sUniFlexParams.uMaxALUInstsToFlatten = 0;
+
+	sUniFlexInfo.psUFParams = &sUniFlexParams;
+
+	sCompileUniflexContext.eOutputCodeType = GLSLPF_UNIFLEX_OUTPUT;
+	sCompileUniflexContext.psUniflexHWCodeInfo = &sUniFlexInfo;
+	sCompileUniflexContext.psCompileProgramContext = &sCompileContext;
+
+#if !defined(SGX_FEATURE_USE_UNLIMITED_PHASES)
+	/* The driver always creates the MSAA trans version of fragment shaders */
+	sCompileUniflexContext.bCompileMSAATrans = (eProgramType == GLSLPT_FRAGMENT) ? IMG_TRUE : IMG_FALSE;
+#endif
+
+	sCompileContext.psInitCompilerContext = psInitCompilerContext;
+	sCompileContext.eProgramType = eProgramType;
+	sCompileContext.ppszSourceCodeStrings = &pszSource;
+	sCompileContext.uNumSourceCodeStrings = 1;
+	sCompileContext.bCompleteProgram = IMG_TRUE;
+	sCompileContext.bDisplayMetrics = IMG_FALSE;
+	sCompileContext.bValidateOnly = IMG_FALSE;
+	sCompileContext.eEnabledWarnings = (GLSLCompilerWarnings)0;
+
+	psCurrentReport = psReport;
+	dStartTime = GetTimeMs();
+
+	psCompiledProgram = GLSLCompileToUniflex(&sCompileUniflexContext);
+
+	if (psReport)
+	{
+		psReport->adMetrics[METRIC_FRONTEND_MS] = GetTimeMs() - dStartTime - psReport->adMetrics[METRIC_USC_MS];
+	}
+	psCurrentReport = IMG_NULL;
+
+	free(pszSource);
+
+	if (!psCompiledProgram)
+	{
+		fprintf(stderr, "%s: GLSLCompileToUniflex failed\n", pszFileName);
+		return IMG_FALSE;
+	}
+
+	if (!psCompiledProgram->bSuccessfullyCompiled || bVerbose)
+	{
+		const IMG_CHAR *pszInfoLog = psCompiledProgram->sInfoLog.pszInfoLogString;
+
+		fprintf(stderr, "%s:\n%s", pszFileName, pszInfoLog ? pszInfoLog : "");
+	}
+
+	if (!psCompiledProgram->bSuccessfullyCompiled)
+	{
+		goto CompileShaderCleanUp;
+	}
+
+	if (SGXBS_CreateBinaryShader(psCompiledProgram, UniPatchAlloc, UniPatchFree, &pvBinary, &uBinarySize) != SGXBS_NO_ERROR)
+	{
+		fprintf(stderr, "%s: SGXBS_CreateBinaryShader failed\n", pszFileName);
+		goto CompileShaderCleanUp;
+	}
+
+	if (!GetOutputName(pszFileName, ".bin", szOutput) || (psFile = fopen(szOutput, "wb")) == IMG_NULL)
+	{
+		fprintf(stderr, "%s: can't write binary\n", szOutput);
+		goto CompileShaderCleanUp;
+	}
+	if (psReport)
+	{
+		psReport->adMetrics[METRIC_BINARY_BYTES] = (IMG_DOUBLE)uBinarySize;
+	}
+
+	bSuccess = (fwrite(pvBinary, 1, uBinarySize, psFile) == uBinarySize) ? IMG_TRUE : IMG_FALSE;
+	if (fclose(psFile) != 0 || !bSuccess)
+	{
+		fprintf(stderr, "%s: can't write binary\n", szOutput);
+		bSuccess = IMG_FALSE;
+		goto CompileShaderCleanUp;
+	}
+
+	psPCShader = (PUSP_PC_SHADER)psCompiledProgram->psUniFlexCode->psUniPatchInput;
+	uPCShaderSize = (IMG_UINT32)sizeof(USP_PC_SHADER) + psPCShader->uSize;
+
+	if (!GetOutputName(pszFileName, ".usp", szOutput) || (psFile = fopen(szOutput, "wb")) == IMG_NULL)
+	{
+		fprintf(stderr, "%s: can't write USP input\n", szOutput);
+		bSuccess = IMG_FALSE;
+		goto CompileShaderCleanUp;
+	}
+
+	bSuccess = (fwrite(psPCShader, 1, uPCShaderSize, psFile) == uPCShaderSize) ? IMG_TRUE : IMG_FALSE;
+	if (fclose(psFile) != 0 || !bSuccess)
+	{
+		fprintf(stderr, "%s: can't write USP input\n", szOutput);
+		bSuccess = IMG_FALSE;
+		goto CompileShaderCleanUp;
+	}
+
+	if (!GetOutputName(pszFileName, ".asm", szOutput) || (psFile = fopen(szOutput, "w")) == IMG_NULL)
+	{
+		fprintf(stderr, "%s: can't write disassembly\n", szOutput);
+		bSuccess = IMG_FALSE;
+		goto CompileShaderCleanUp;
+	}
+
+	fprintf(psFile, "%s (%u byte binary)\n\n", pszFileName, uBinarySize);
+	if (psCompiledProgram->sInfoLog.pszInfoLogString && psCompiledProgram->sInfoLog.pszInfoLogString[0])
+	{
+		fprintf(psFile, "%s\n", psCompiledProgram->sInfoLog.pszInfoLogString);
+	}
+
+	if (!WriteDisassembly(psFile, psPCShader, psReport))
+	{
+		fprintf(stderr, "%s: USP finalisation failed\n", pszFileName);
+		bSuccess = IMG_FALSE;
+	}
+
+	if (fclose(psFile) != 0)
+	{
+		fprintf(stderr, "%s: can't write disassembly\n", szOutput);
+		bSuccess = IMG_FALSE;
+	}
+
+CompileShaderCleanUp:
+
+	if (pvBinary)
+	{
+		UniPatchFree(pvBinary);
+	}
+
+	GLSLFreeCompiledUniflexProgram(psInitCompilerContext, psCompiledProgram);
+
+	if (psReport)
+	{
+		psReport->bCompiled = bSuccess;
+	}
+
+	return bSuccess;
+}
+
+/*****************************************************************************
+ FUNCTION	: AddShader
+
+ PURPOSE	: Adds a shader to the list of shaders to compile.
+
+ PARAMETERS	: apszShaders	- List of shaders.
+			  puNumShaders	- Number of shaders in the list.
+			  pszDir		- Directory of the shader, or IMG_NULL.
+			  pszName		- Shader file name.
+
+ RETURNS	: IMG_FALSE if the list is full or out of memory.
+*****************************************************************************/
+static IMG_BOOL AddShader(IMG_CHAR **apszShaders, IMG_UINT32 *puNumShaders, const IMG_CHAR *pszDir, const IMG_CHAR *pszName)
+{
+	size_t		uLength = strlen(pszName) + (pszDir ? strlen(pszDir) + 1 : 0) + 1;
+	IMG_CHAR	*pszPath;
+
+	if (*puNumShaders == MAX_SHADERS || (pszPath = malloc(uLength)) == IMG_NULL)
+	{
+		fprintf(stderr, "Too many shaders\n");
+		return IMG_FALSE;
+	}
+
+	if (pszDir)
+	{
+		sprintf(pszPath, "%s/%s", pszDir, pszName);
+	}
+	else
+	{
+		strcpy(pszPath, pszName);
+	}
+
+	apszShaders[(*puNumShaders)++] = pszPath;
+
+	return IMG_TRUE;
+}
+
+/*****************************************************************************
+ FUNCTION	: AddShaders
+
+ PURPOSE	: Adds a shader, or all the shaders in a directory, to the list of
+			  shaders to compile.
+
+ PARAMETERS	: apszShaders	- List of shaders.
+			  puNumShaders	- Number of shaders in the list.
+			  pszPath		- Shader or directory.
+
+ RETURNS	: IMG_FALSE on failure.
+*****************************************************************************/
+static IMG_BOOL AddShaders(IMG_CHAR **apszShaders, IMG_UINT32 *puNumShaders, const IMG_CHAR *pszPath)
+{
+	GLSLProgramType eProgramType;
+	IMG_BOOL		bSuccess = IMG_TRUE;
+#if defined(_WIN32)
+	WIN32_FIND_DATAA	sFindData;
+	HANDLE				hFind;
+	IMG_CHAR			szPattern[MAX_PATH_LENGTH];
+	DWORD				dwAttributes = GetFileAttributesA(pszPath);
+
+	if (dwAttributes == INVALID_FILE_ATTRIBUTES || !(dwAttributes & FILE_ATTRIBUTE_DIRECTORY))
+	{
+		return AddShader(apszShaders, puNumShaders, IMG_NULL, pszPath);
+	}
+
+	snprintf(szPattern, sizeof(szPattern), "%s/*", pszPath);
+
+	hFind = FindFirstFileA(szPattern, &sFindData);
+	if (hFind == INVALID_HANDLE_VALUE)
+	{
+		return IMG_TRUE;
+	}
+
+	do
+	{
+		if (!(sFindData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) &&
+			GetProgramType(sFindData.cFileName, &eProgramType))
+		{
+			bSuccess = AddShader(apszShaders, puNumShaders, pszPath, sFindData.cFileName);
+		}
+	} while (bSuccess && FindNextFileA(hFind, &sFindData));
+
+	FindClose(hFind);
+#else
+	struct stat		sStat;
+	DIR				*psDir;
+	struct dirent	*psEntry;
+
+	if (stat(pszPath, &sStat) != 0 || !S_ISDIR(sStat.st_mode))
+	{
+		return AddShader(apszShaders, puNumShaders, IMG_NULL, pszPath);
+	}
+
+	psDir = opendir(pszPath);
+	if (!psDir)
+	{
+		fprintf(stderr, "%s: %s\n", pszPath, strerror(errno));
+		return IMG_FALSE;
+	}
+
+	while (bSuccess && (psEntry = readdir(psDir)) != IMG_NULL)
+	{
+		if (psEntry->d_name[0] != '.' && GetProgramType(psEntry->d_name, &eProgramType))
+		{
+			bSuccess = AddShader(apszShaders, puNumShaders, pszPath, psEntry->d_name);
+		}
+	}
+
+	closedir(psDir);
+#endif
+
+	return bSuccess;
+}
+
+static int CompareShaderNames(const void *pvA, const void *pvB)
+{
+	return strcmp(*(IMG_CHAR * const *)pvA, *(IMG_CHAR * const *)pvB);
+}
+
+/*****************************************************************************
+ FUNCTION	: StartWorker
+
+ PURPOSE	: Starts a worker process compiling one shader.
+
+ PARAMETERS	: pszTool		- Path of this tool.
+			  pszFileName	- Shader to compile.
+			  psWorker		- Returns the worker.
+
+ RETURNS	: IMG_FALSE if the process couldn't be started.
+*****************************************************************************/
+static IMG_BOOL StartWorker(const IMG_CHAR *pszTool, const IMG_CHAR *pszFileName, WORKER *psWorker)
+{
+	const IMG_CHAR	*apszArgs[12 + NUM_UNROLL_SETTINGS * 2];
+	IMG_CHAR		szPrecision[16];
+	IMG_CHAR		szTemporaries[16];
+	IMG_CHAR		aszUnrollSettings[NUM_UNROLL_SETTINGS][32];
+	IMG_UINT32		uArg = 0;
+	IMG_UINT32		i;
+
+	sprintf(szPrecision, "%u", uPrecisionBitMask);
+	sprintf(szTemporaries, "%u", uNumTemporaries);
+
+	apszArgs[uArg++] = pszTool;
+	apszArgs[uArg++] = "-p";
+	apszArgs[uArg++] = szPrecision;
+	apszArgs[uArg++] = "-T";
+	apszArgs[uArg++] = szTemporaries;
+	for (i = 0; i < NUM_UNROLL_SETTINGS; i++)
+	{
+		sprintf(aszUnrollSettings[i], "%s=%u", asUnrollSettings[i].pszName, *asUnrollSettings[i].puValue);
+		apszArgs[uArg++] = "-u";
+		apszArgs[uArg++] = aszUnrollSettings[i];
+	}
+	if (pszOutputDir)
+	{
+		apszArgs[uArg++] = "-o";
+		apszArgs[uArg++] = pszOutputDir;
+	}
+	if (bVerbose)
+	{
+		apszArgs[uArg++] = "-v";
+	}
+	apszArgs[uArg++] = "--";
+	apszArgs[uArg++] = pszFileName;
+	apszArgs[uArg] = IMG_NULL;
+
+#if defined(_WIN32)
+	{
+		/* The arguments are joined into one command line, so quote them */
+		IMG_CHAR	*apszQuoted[12 + NUM_UNROLL_SETTINGS * 2];
+		intptr_t	iProcess;
+
+		for (i = 0; i < uArg; i++)
+		{
+			apszQuoted[i] = malloc(strlen(apszArgs[i]) + 3);
+			if (apszQuoted[i])
+			{
+				sprintf(apszQuoted[i], "\"%s\"", apszArgs[i]);
+			}
+		}
+		apszQuoted[uArg] = IMG_NULL;
+
+		iProcess = _spawnv(_P_NOWAIT, pszTool, (const char * const *)apszQuoted);
+
+		for (i = 0; i < uArg; i++)
+		{
+			free(apszQuoted[i]);
+		}
+
+		if (iProcess == -1)
+		{
+			return IMG_FALSE;
+		}
+
+		*psWorker = (HANDLE)iProcess;
+	}
+#else
+	fflush(stdout);
+	fflush(stderr);
+
+	*psWorker = fork();
+	if (*psWorker == 0)
+	{
+		execvp(pszTool, (char * const *)apszArgs);
+		_exit(127);
+	}
+	if (*psWorker < 0)
+	{
+		return IMG_FALSE;
+	}
+#endif
+
+	return IMG_TRUE;
+}
+
+/*****************************************************************************
+ FUNCTION	: WaitWorker
+
+ PURPOSE	: Waits for one of the running worker processes to finish.
+
+ PARAMETERS	: asWorkers		- Running workers.
+			  uNumWorkers	- Number of running workers.
+			  pbSuccess		- Returns whether the worker succeeded.
+
+ RETURNS	: The index of the finished worker.
+*****************************************************************************/
+static IMG_UINT32 WaitWorker(WORKER *asWorkers, IMG_UINT32 uNumWorkers, IMG_BOOL *pbSuccess)
+{
+#if defined(_WIN32)
+	DWORD		dwExitCode = 1;
+	IMG_UINT32	uWorker;
+
+	uWorker = WaitForMultipleObjects((DWORD)uNumWorkers, asWorkers, FALSE, INFINITE) - WAIT_OBJECT_0;
+	if (uWorker >= uNumWorkers)
+	{
+		uWorker = 0;
+		WaitForSingleObject(asWorkers[0], INFINITE);
+	}
+
+	GetExitCodeProcess(asWorkers[uWorker], &dwExitCode);
+	CloseHandle(asWorkers[uWorker]);
+
+	*pbSuccess = (dwExitCode == 0) ? IMG_TRUE : IMG_FALSE;
+
+	return uWorker;
+#else
+	for (;;)
+	{
+		int			iStatus;
+		pid_t		iPid = wait(&iStatus);
+		IMG_UINT32	uWorker;
+
+		if (iPid < 0 && errno != EINTR)
+		{
+			/* No children left, which shouldn't happen */
+			*pbSuccess = IMG_FALSE;
+			return 0;
+		}
+
+		for (uWorker = 0; uWorker < uNumWorkers; uWorker++)
+		{
+			if (asWorkers[uWorker] == iPid)
+			{
+				*pbSuccess = (WIFEXITED(iStatus) && WEXITSTATUS(iStatus) == 0) ? IMG_TRUE : IMG_FALSE;
+				return uWorker;
+			}
+		}
+	}
+#endif
+}
+
+/*****************************************************************************
+ FUNCTION	: CompileInParallel
+
+ PURPOSE	: Compiles a list of shaders with a number of worker processes.
+
+ PARAMETERS	: pszTool		- Path of this tool.
+			  apszShaders	- Shaders to compile.
+			  uNumShaders	- Number of shaders.
+			  uNumJobs		- Maximum number of workers.
+
+ RETURNS	: The number of shaders that failed.
+*****************************************************************************/
+static IMG_UINT32 CompileInParallel(const IMG_CHAR *pszTool, IMG_CHAR **apszShaders, IMG_UINT32 uNumShaders, IMG_UINT32 uNumJobs)
+{
+	WORKER		asWorkers[MAX_WORKERS];
+	IMG_UINT32	uNumWorkers	= 0;
+	IMG_UINT32	uNumFailed	= 0;
+	IMG_UINT32	uNext		= 0;
+
+	while (uNext < uNumShaders || uNumWorkers > 0)
+	{
+		IMG_BOOL	bSuccess;
+		IMG_UINT32	uWorker;
+
+		if (uNext < uNumShaders && uNumWorkers < uNumJobs)
+		{
+			if (StartWorker(pszTool, apszShaders[uNext], &asWorkers[uNumWorkers]))
+			{
+				uNumWorkers++;
+			}
+			else
+			{
+				fprintf(stderr, "%s: can't start a worker process\n", apszShaders[uNext]);
+				uNumFailed++;
+			}
+			uNext++;
+			continue;
+		}
+
+		uWorker = WaitWorker(asWorkers, uNumWorkers, &bSuccess);
+		if (!bSuccess)
+		{
+			uNumFailed++;
+		}
+
+		asWorkers[uWorker] = asWorkers[--uNumWorkers];
+	}
+
+	return uNumFailed;
+}
+
+/*****************************************************************************
+ FUNCTION	: WriteReport
+
+ PURPOSE	: Writes the metrics of all the shaders as CSV or JSON.
+
+ PARAMETERS	: pszReport		- Report file name.
+			  asReports		- Metrics of each shader.
+			  uNumReports	- Number of shaders.
+
+ RETURNS	: IMG_FALSE if the report couldn't be written.
+*****************************************************************************/
+static IMG_BOOL WriteReport(const IMG_CHAR *pszReport, const SHADER_REPORT *asReports, IMG_UINT32 uNumReports)
+{
+	const IMG_CHAR	*pszExt = strrchr(pszReport, '.');
+	IMG_BOOL		bJSON = (pszExt && strcmp(pszExt, ".json") == 0) ? IMG_TRUE : IMG_FALSE;
+	FILE			*psFile = fopen(pszReport, "w");
+	IMG_UINT32		i, j;
+
+	if (!psFile)
+	{
+		return IMG_FALSE;
+	}
+
+	if (bJSON)
+	{
+		fprintf(psFile, "{\n\t\"shaders\": [\n");
+	}
+	else
+	{
+		fprintf(psFile, "shader,compiled");
+		for (j = 0; j < METRIC_COUNT; j++)
+		{
+			fprintf(psFile, ",%s", asMetricDescs[j].pszName);
+		}
+		fprintf(psFile, "\n");
+	}
+
+	for (i = 0; i < uNumReports; i++)
+	{
+		const SHADER_REPORT *psReport = &asReports[i];
+
+		if (bJSON)
+		{
+			const IMG_CHAR *psz;
+
+			fprintf(psFile, "\t\t{\"shader\": \"");
+			for (psz = psReport->pszName; *psz; psz++)
+			{
+				fprintf(psFile, (*psz == '"' || *psz == '\\') ? "\\%c" : "%c", *psz);
+			}
+			fprintf(psFile, "\", \"compiled\": %s", psReport->bCompiled ? "true" : "false");
+		}
+		else
+		{
+			fprintf(psFile, "%s,%u", psReport->pszName, psReport->bCompiled ? 1 : 0);
+		}
+
+		for (j = 0; j < METRIC_COUNT; j++)
+		{
+			if (bJSON)
+			{
+				fprintf(psFile, ", \"%s\": ", asMetricDescs[j].pszName);
+			}
+			else
+			{
+				fprintf(psFile, ",");
+			}
+			fprintf(psFile, asMetricDescs[j].bTime ? "%.3f" : "%.0f", psReport->adMetrics[j]);
+		}
+
+		if (bJSON)
+		{
+			fprintf(psFile, "}%s\n", (i + 1 < uNumReports) ? "," : "");
+		}
+		else
+		{
+			fprintf(psFile, "\n");
+		}
+	}
+
+	if (bJSON)
+	{
+		fprintf(psFile, "\t]\n}\n");
+	}
+
+	return (fclose(psFile) == 0) ? IMG_TRUE : IMG_FALSE;
+}
+
+/*****************************************************************************
+ FUNCTION	: ReadBaseline
+
+ PURPOSE	: Reads a CSV report written by an earlier run. Columns are
+			  matched by name, so reports with other metrics can be read.
+
+ PARAMETERS	: pszBaseline		- Report file name.
+			  pasBaseline		- Returns the metrics of each shader.
+			  puNumBaseline		- Returns the number of shaders.
+			  abHasMetric		- Returns which metrics the report has.
+			  ppszData			- Returns the file contents, which the
+								  shader names point into.
+
+ RETURNS	: IMG_FALSE if the report couldn't be read.
+*****************************************************************************/
+static IMG_BOOL ReadBaseline(const IMG_CHAR		*pszBaseline,
+							 PSHADER_REPORT		*pasBaseline,
+							 IMG_UINT32			*puNumBaseline,
+							 IMG_BOOL			abHasMetric[METRIC_COUNT],
+							 IMG_CHAR			**ppszData)
+{
+	IMG_CHAR		*pszData = ReadFile(pszBaseline);
+	IMG_INT32		aiColumns[MAX_REPORT_COLUMNS];
+	IMG_UINT32		uNumColumns = 0;
+	IMG_UINT32		uNumLines = 0;
+	PSHADER_REPORT	asBaseline;
+	IMG_CHAR		*pszLine;
+	IMG_CHAR		*psz;
+	IMG_UINT32		j;
+
+	*pasBaseline = IMG_NULL;
+	*puNumBaseline = 0;
+	*ppszData = IMG_NULL;
+	memset(abHasMetric, 0, sizeof(IMG_BOOL) * METRIC_COUNT);
+
+	if (!pszData)
+	{
+		return IMG_FALSE;
+	}
+
+	for (psz = pszData; *psz; psz++)
+	{
+		if (*psz == '\n')
+		{
+			uNumLines++;
+		}
+	}
+
+	asBaseline = calloc(uNumLines + 1, sizeof(SHADER_REPORT));
+	if (!asBaseline)
+	{
+		free(pszData);
+		return IMG_FALSE;
+	}
+
+	for (pszLine = pszData; *pszLine; )
+	{
+		IMG_CHAR		*pszEnd = strchr(pszLine, '\n');
+		IMG_CHAR		*pszNext = pszEnd ? pszEnd + 1 : pszLine + strlen(pszLine);
+		PSHADER_REPORT	psReport = IMG_NULL;
+		IMG_UINT32		uColumn = 0;
+		IMG_CHAR		*pszField;
+
+		if (pszEnd)
+		{
+			*pszEnd = '\0';
+			if (pszEnd > pszLine && pszEnd[-1] == '\r')
+			{
+				pszEnd[-1] = '\0';
+			}
+		}
+
+		if (uNumColumns != 0 && *pszLine)
+		{
+			psReport = &asBaseline[(*puNumBaseline)++];
+		}
+
+		for (pszField = pszLine; pszField && uColumn < MAX_REPORT_COLUMNS; uColumn++)
+		{
+			IMG_CHAR *pszComma = strchr(pszField, ',');
+
+			if (pszComma)
+			{
+				*pszComma = '\0';
+			}
+
+			if (uNumColumns == 0)
+			{
+				/* Header: -1 for the shader name, -2 for the status */
+				aiColumns[uColumn] = (IMG_INT32)METRIC_COUNT;
+
+				if (strcmp(pszField, "shader") == 0)
+				{
+					aiColumns[uColumn] = -1;
+				}
+				else if (strcmp(pszField, "compiled") == 0)
+				{
+					aiColumns[uColumn] = -2;
+				}
+				for (j = 0; j < METRIC_COUNT; j++)
+				{
+					if (strcmp(pszField, asMetricDescs[j].pszName) == 0)
+					{
+						aiColumns[uColumn] = (IMG_INT32)j;
+						abHasMetric[j] = IMG_TRUE;
+					}
+				}
+			}
+			else if (psReport && uColumn < uNumColumns)
+			{
+				if (aiColumns[uColumn] == -1)
+				{
+					psReport->pszName = pszField;
+				}
+				else if (aiColumns[uColumn] == -2)
+				{
+					psReport->bCompiled = (atoi(pszField) != 0) ? IMG_TRUE : IMG_FALSE;
+				}
+				else if (aiColumns[uColumn] < (IMG_INT32)METRIC_COUNT)
+				{
+					psReport->adMetrics[aiColumns[uColumn]] = atof(pszField);
+				}
+			}
+
+			pszField = pszComma ? pszComma + 1 : IMG_NULL;
+		}
+
+		if (uNumColumns == 0)
+		{
+			uNumColumns = uColumn;
+		}
+		else if (psReport && !psReport->pszName)
+		{
+			(*puNumBaseline)--;
+		}
+
+		pszLine = pszNext;
+	}
+
+	if (*puNumBaseline == 0)
+	{
+		free(asBaseline);
+		free(pszData);
+		return IMG_FALSE;
+	}
+
+	*pasBaseline = asBaseline;
+	*ppszData = pszData;
+
+	return IMG_TRUE;
+}
+
+/*****************************************************************************
+ FUNCTION	: CompareWithBaseline
+
+ PURPOSE	: Reports the metrics that regressed against a baseline.
+
+ PARAMETERS	: asReports		- Metrics of each shader.
+			  uNumReports	- Number of shaders.
+			  asBaseline	- Metrics of each shader in the baseline.
+			  uNumBaseline	- Number of shaders in the baseline.
+			  abHasMetric	- Which metrics the baseline has.
+
+ RETURNS	: The number of regressions.
+*****************************************************************************/
+static IMG_UINT32 CompareWithBaseline(const SHADER_REPORT	*asReports,
+									  IMG_UINT32			uNumReports,
+									  const SHADER_REPORT	*asBaseline,
+									  IMG_UINT32			uNumBaseline,
+									  const IMG_BOOL		abHasMetric[METRIC_COUNT])
+{
+	IMG_DOUBLE	adTotal[METRIC_COUNT];
+	IMG_DOUBLE	adBaselineTotal[METRIC_COUNT];
+	IMG_UINT32	uNumRegressions = 0;
+	IMG_UINT32	uNumCompared = 0;
+	IMG_UINT32	i, j;
+
+	memset(adTotal, 0, sizeof(adTotal));
+	memset(adBaselineTotal, 0, sizeof(adBaselineTotal));
+
+	for (i = 0; i < uNumReports; i++)
+	{
+		const SHADER_REPORT	*psReport = &asReports[i];
+		const SHADER_REPORT	*psBaseline = IMG_NULL;
+
+		for (j = 0; j < uNumBaseline; j++)
+		{
+			if (strcmp(asBaseline[j].pszName, psReport->pszName) == 0)
+			{
+				psBaseline = &asBaseline[j];
+				break;
+			}
+		}
+
+		if (!psBaseline)
+		{
+			printf("%s: not in the baseline\n", psReport->pszName);
+			continue;
+		}
+
+		if (!psBaseline->bCompiled)
+		{
+			continue;
+		}
+		if (!psReport->bCompiled)
+		{
+			printf("REGRESSION %s: no longer compiles\n", psReport->pszName);
+			uNumRegressions++;
+			continue;
+		}
+
+		uNumCompared++;
+
+		for (j = 0; j < METRIC_COUNT; j++)
+		{
+			IMG_DOUBLE	dOld = psBaseline->adMetrics[j];
+			IMG_DOUBLE	dNew = psReport->adMetrics[j];
+			IMG_DOUBLE	dThreshold = adThresholds[j];
+			IMG_BOOL	bRegressed;
+
+			if (!abHasMetric[j])
+			{
+				continue;
+			}
+
+			adTotal[j] += dNew;
+			adBaselineTotal[j] += dOld;
+
+			if (dThreshold < 0.0)
+			{
+				continue;
+			}
+
+			if (asMetricDescs[j].bHigherIsBetter)
+			{
+				bRegressed = (dNew < dOld * (1.0 - dThreshold / 100.0)) ? IMG_TRUE : IMG_FALSE;
+			}
+			else
+			{
+				bRegressed = (dNew > dOld * (1.0 + dThreshold / 100.0)) ? IMG_TRUE : IMG_FALSE;
+			}
+
+			if (bRegressed)
+			{
+				printf("REGRESSION %s: %s %.*f -> %.*f (allowed %.1f%%)\n",
+					   psReport->pszName, asMetricDescs[j].pszName,
+					   asMetricDescs[j].bTime ? 3 : 0, dOld,
+					   asMetricDescs[j].bTime ? 3 : 0, dNew,
+					   dThreshold);
+				uNumRegressions++;
+			}
+		}
+	}
+
+	printf("\n%u shaders compared with the baseline:\n", uNumCompared);
+	for (j = 0; j < METRIC_COUNT; j++)
+	{
+		if (abHasMetric[j] && (!asMetricDescs[j].bTime || j == METRIC_FRONTEND_MS || j == METRIC_USC_MS || j == METRIC_USP_MS))
+		{
+			printf("  %-20s %12.*f -> %12.*f", asMetricDescs[j].pszName,
+				   asMetricDescs[j].bTime ? 3 : 0, adBaselineTotal[j],
+				   asMetricDescs[j].bTime ? 3 : 0, adTotal[j]);
+			if (adBaselineTotal[j] != 0.0)
+			{
+				printf("  (%+.1f%%)", (adTotal[j] - adBaselineTotal[j]) * 100.0 / adBaselineTotal[j]);
+			}
+			printf("\n");
+		}
+	}
+
+	return uNumRegressions;
+}
+
+/*****************************************************************************
+ FUNCTION	: SetThreshold
+
+ PURPOSE	: Parses a -t <metric>=<percent> option.
+
+ PARAMETERS	: pszOption	- Option value.
+
+ RETURNS	: IMG_FALSE if the option is invalid.
+*****************************************************************************/
+static IMG_BOOL SetThreshold(const IMG_CHAR *pszOption)
+{
+	const IMG_CHAR	*pszValue = strchr(pszOption, '=');
+	size_t			uNameLength;
+	IMG_DOUBLE		dThreshold;
+	IMG_BOOL		bFound = IMG_FALSE;
+	IMG_UINT32		j;
+
+	if (!pszValue)
+	{
+		return IMG_FALSE;
+	}
+
+	uNameLength = (size_t)(pszValue - pszOption);
+	dThreshold = atof(pszValue + 1);
+
+	for (j = 0; j < METRIC_COUNT; j++)
+	{
+		if ((uNameLength == 3 && strncmp(pszOption, "all", 3) == 0) ||
+			(strlen(asMetricDescs[j].pszName) == uNameLength && strncmp(pszOption, asMetricDescs[j].pszName, uNameLength) == 0))
+		{
+			adThresholds[j] = dThreshold;
+			bFound = IMG_TRUE;
+		}
+	}
+
+	return bFound;
+}
+
+/*****************************************************************************
+ FUNCTION	: SetUnrollRule
+
+ PURPOSE	: Parses a -u <rule>=<value> option.
+
+ PARAMETERS	: pszOption	- Option value.
+
+ RETURNS	: IMG_FALSE if the option is invalid.
+*****************************************************************************/
+static IMG_BOOL SetUnrollRule(const IMG_CHAR *pszOption)
+{
+	const IMG_CHAR	*pszValue = strchr(pszOption, '=');
+	size_t			uNameLength;
+	IMG_UINT32		j;
+
+	if (!pszValue)
+	{
+		return IMG_FALSE;
+	}
+
+	uNameLength = (size_t)(pszValue - pszOption);
+
+	for (j = 0; j < NUM_UNROLL_SETTINGS; j++)
+	{
+		if (strlen(asUnrollSettings[j].pszName) == uNameLength && strncmp(pszOption, asUnrollSettings[j].pszName, uNameLength) == 0)
+		{
+			*asUnrollSettings[j].puValue = (IMG_UINT32)strtoul(pszValue + 1, IMG_NULL, 0);
+			return IMG_TRUE;
+		}
+	}
+
+	return IMG_FALSE;
+}
+
+int main(int argc, char **argv)
+{
+	static IMG_CHAR			*apszShaders[MAX_SHADERS];
+	GLSLInitCompilerContext	sInitCompilerContext;
+	const IMG_CHAR			*pszReport		= IMG_NULL;
+	const IMG_CHAR			*pszBaseline	= IMG_NULL;
+	PSHADER_REPORT			asReports		= IMG_NULL;
+	IMG_UINT32				uNumJobs		= 1;
+	IMG_UINT32				uNumShaders		= 0;
+	IMG_UINT32				uNumFailed		= 0;
+	IMG_UINT32				uNumRegressions	= 0;
+	IMG_BOOL				bReportFailed	= IMG_FALSE;
+	IMG_BOOL				bSynthetic		= IMG_FALSE;
+	IMG_UINT32				i;
+	int						iArg;
+
+	for (i = 0; i < METRIC_COUNT; i++)
+	{
+		adThresholds[i] = asMetricDescs[i].bTime ? -1.0 : 0.0;
+	}
+
+	for (iArg = 1; iArg < argc && argv[iArg][0] == '-'; iArg++)
+	{
+		if (strcmp(argv[iArg], "--") == 0)
+		{
+			iArg++;
+			break;
+		}
+		else if (strcmp(argv[iArg], "-v") == 0)
+		{
+			bVerbose = IMG_TRUE;
+		}
+		else if (strcmp(argv[iArg], "-o") == 0 && iArg + 1 < argc)
+		{
+			pszOutputDir = argv[++iArg];
+		}
+		else if (strcmp(argv[iArg], "-j") == 0 && iArg + 1 < argc)
+		{
+			uNumJobs = (IMG_UINT32)strtoul(argv[++iArg], IMG_NULL, 0);
+			if (uNumJobs == 0 || uNumJobs > MAX_WORKERS)
+			{
+				uNumJobs = MAX_WORKERS;
+			}
+		}
+		else if (strcmp(argv[iArg], "-p") == 0 && iArg + 1 < argc)
+		{
+			uPrecisionBitMask = (IMG_UINT32)strtoul(argv[++iArg], IMG_NULL, 0);
+		}
+		else if (strcmp(argv[iArg], "-T") == 0 && iArg + 1 < argc)
+		{
+			uNumTemporaries = (IMG_UINT32)strtoul(argv[++iArg], IMG_NULL, 0);
+		}
+		else if (strcmp(argv[iArg], "-u") == 0 && iArg + 1 < argc)
+		{
+			if (!SetUnrollRule(argv[++iArg]))
+			{
+				fprintf(stderr, "Unknown rule in -u %s\n", argv[iArg]);
+				return 1;
+			}
+		}
+		else if (strcmp(argv[iArg], "-r") == 0 && iArg + 1 < argc)
+		{
+			pszReport = argv[++iArg];
+		}
+		else if (strcmp(argv[iArg], "-b") == 0 && iArg + 1 < argc)
+		{
+			pszBaseline = argv[++iArg];
+		}
+		else if (strcmp(argv[iArg], "-s") == 0 && iArg + 1 < argc)
+		{
+			IMG_CHAR szName[64];
+
+			sprintf(szName, SYNTHETIC_SHADER_PREFIX "%lu.frag", strtoul(argv[++iArg], IMG_NULL, 0));
+			if (!GetSyntheticStatements(szName, &i))
+			{
+				fprintf(stderr, "At most %u statements in -s\n", MAX_SYNTHETIC_STATEMENTS);
+				return 1;
+			}
+			if (!AddShader(apszShaders, &uNumShaders, IMG_NULL, szName))
+			{
+				return 1;
+			}
+			bSynthetic = IMG_TRUE;
+		}
+		else if (strcmp(argv[iArg], "-t") == 0 && iArg + 1 < argc)
+		{
+			if (!SetThreshold(argv[++iArg]))
+			{
+				fprintf(stderr, "Unknown metric in -t %s\n", argv[iArg]);
+				return 1;
+			}
+		}
+		else
+		{
+			Usage();
+			return 1;
+		}
+	}
+
+	if (iArg == argc && !bSynthetic)
+	{
+		Usage();
+		return 1;
+	}
+
+	for (; iArg < argc; iArg++)
+	{
+		if (!AddShaders(apszShaders, &uNumShaders, argv[iArg]))
+		{
+			return 1;
+		}
+	}
+
+	/* Directory order depends on the file system */
+	qsort(apszShaders, uNumShaders, sizeof(apszShaders[0]), CompareShaderNames);
+
+	if (pszReport || pszBaseline)
+	{
+		asReports = calloc(uNumShaders ? uNumShaders : 1, sizeof(SHADER_REPORT));
+		if (!asReports)
+		{
+			return 1;
+		}
+		for (i = 0; i < uNumShaders; i++)
+		{
+			asReports[i].pszName = GetBaseName(apszShaders[i]);
+		}
+	}
+
+	/* The workers only see files, so synthetic shaders are compiled here */
+	if (uNumJobs > 1 && uNumShaders > 1 && !asReports && !bSynthetic)
+	{
+		uNumFailed = CompileInParallel(argv[0], apszShaders, uNumShaders, uNumJobs);
+	}
+	else
+	{
+		if (!InitCompiler(&sInitCompilerContext))
+		{
+			fprintf(stderr, "Failed to initialise the GLSL compiler\n");
+			return 1;
+		}
+
+		for (i = 0; i < uNumShaders; i++)
+		{
+			if (!CompileShader(&sInitCompilerContext, apszShaders[i], asReports ? &asReports[i] : IMG_NULL))
+			{
+				uNumFailed++;
+			}
+		}
+
+		GLSLShutDownCompiler(&sInitCompilerContext);
+	}
+
+	if (uNumShaders > 1)
+	{
+		printf("%u of %u shaders compiled\n", uNumShaders - uNumFailed, uNumShaders);
+	}
+
+	if (pszReport && !WriteReport(pszReport, asReports, uNumShaders))
+	{
+		fprintf(stderr, "%s: can't write report\n", pszReport);
+		bReportFailed = IMG_TRUE;
+	}
+
+	if (pszBaseline)
+	{
+		PSHADER_REPORT	asBaseline;
+		IMG_UINT32		uNumBaseline;
+		IMG_BOOL		abHasMetric[METRIC_COUNT];
+		IMG_CHAR		*pszBaselineData;
+
+		if (ReadBaseline(pszBaseline, &asBaseline, &uNumBaseline, abHasMetric, &pszBaselineData))
+		{
+			uNumRegressions = CompareWithBaseline(asReports, uNumShaders, asBaseline, uNumBaseline, abHasMetric);
+
+			printf("%u regressions\n", uNumRegressions);
+
+			free(asBaseline);
+			free(pszBaselineData);
+		}
+		else
+		{
+			fprintf(stderr, "%s: can't read baseline\n", pszBaseline);
+			bReportFailed = IMG_TRUE;
+		}
+	}
+
+	free(asReports);
+
+	for (i = 0; i < uNumShaders; i++)
+	{
+		free(apszShaders[i]);
+	}
+
+	/*
+		Shaders that fail to compile only count against the baseline if
+		they used to compile, so that the corpus can contain invalid shaders.
+	*/
+	if (bReportFailed)
+	{
+		return 1;
+	}
+	if (pszBaseline)
+	{
+		return uNumRegressions ? 1 : 0;
+	}
+
+	return uNumFailed ? 1 : 0;
+}
@@ -0,0 +1,11 @@
+#version 100
+precision mediump float;
+const int line = __LINE__;
+const int file = __FILE__;
+const int version = __VERSION__;
+#line 100
+const int line2 = __LINE__;
+#line 200 5
+const int line3 = __LINE__;
+const int file2 = __FILE__;
+void main() { gl_FragColor = vec4(float(line + line2 + line3 + file + file2 + version)); }
@@ -0,0 +1,120 @@
+ok=1 in=134
+ext=10 n=118
+0: n=428 sz=0 s=0 l=1 c=1 d='<null>' sol=#100
+1: n=421 sz=10 s=0 l=2 c=0 d='precision' sol=0:13
+2: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+3: n=421 sz=8 s=0 l=2 c=10 d='mediump' sol=0:13
+4: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+5: n=421 sz=6 s=0 l=2 c=18 d='float' sol=0:13
+6: n=385 sz=2 s=0 l=2 c=23 d=';' sol=0:13
+7: n=424 sz=0 s=0 l=2 c=24 d='<null>' sol=0:13
+8: n=421 sz=6 s=0 l=3 c=0 d='const' sol=0:38
+9: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+10: n=421 sz=4 s=0 l=3 c=6 d='int' sol=0:38
+11: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+12: n=421 sz=5 s=0 l=3 c=10 d='line' sol=0:38
+13: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+14: n=373 sz=2 s=0 l=3 c=15 d='=' sol=0:38
+15: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+16: n=419 sz=9 s=0 l=3 c=17 d='3' sol=0:38
+17: n=385 sz=2 s=0 l=3 c=25 d=';' sol=0:38
+18: n=424 sz=0 s=0 l=3 c=26 d='<null>' sol=0:38
+19: n=421 sz=6 s=0 l=4 c=0 d='const' sol=0:65
+20: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+21: n=421 sz=4 s=0 l=4 c=6 d='int' sol=0:65
+22: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+23: n=421 sz=5 s=0 l=4 c=10 d='file' sol=0:65
+24: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+25: n=373 sz=2 s=0 l=4 c=15 d='=' sol=0:65
+26: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+27: n=419 sz=9 s=0 l=4 c=17 d='0' sol=0:65
+28: n=385 sz=2 s=0 l=4 c=25 d=';' sol=0:65
+29: n=424 sz=0 s=0 l=4 c=26 d='<null>' sol=0:65
+30: n=421 sz=6 s=0 l=5 c=0 d='const' sol=0:92
+31: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+32: n=421 sz=4 s=0 l=5 c=6 d='int' sol=0:92
+33: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+34: n=421 sz=8 s=0 l=5 c=10 d='version' sol=0:92
+35: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+36: n=373 sz=2 s=0 l=5 c=18 d='=' sol=0:92
+37: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+38: n=419 sz=12 s=0 l=5 c=20 d='100' sol=0:92
+39: n=385 sz=2 s=0 l=5 c=31 d=';' sol=0:92
+40: n=424 sz=0 s=0 l=5 c=32 d='<null>' sol=0:92
+41: n=421 sz=6 s=0 l=7 c=0 d='const' sol=0:135
+42: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+43: n=421 sz=4 s=0 l=7 c=6 d='int' sol=0:135
+44: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+45: n=421 sz=6 s=0 l=7 c=10 d='line2' sol=0:135
+46: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+47: n=373 sz=2 s=0 l=7 c=16 d='=' sol=0:135
+48: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+49: n=419 sz=9 s=0 l=7 c=18 d='7' sol=0:135
+50: n=385 sz=2 s=0 l=7 c=26 d=';' sol=0:135
+51: n=424 sz=0 s=0 l=7 c=27 d='<null>' sol=0:135
+52: n=421 sz=6 s=5 l=9 c=0 d='const' sol=0:175
+53: n=426 sz=0 s=5 l=0 c=0 d='<null>' sol=null
+54: n=421 sz=4 s=5 l=9 c=6 d='int' sol=0:175
+55: n=426 sz=0 s=5 l=0 c=0 d='<null>' sol=null
+56: n=421 sz=6 s=5 l=9 c=10 d='line3' sol=0:175
+57: n=426 sz=0 s=5 l=0 c=0 d='<null>' sol=null
+58: n=373 sz=2 s=5 l=9 c=16 d='=' sol=0:175
+59: n=426 sz=0 s=5 l=0 c=0 d='<null>' sol=null
+60: n=419 sz=9 s=5 l=9 c=18 d='9' sol=0:175
+61: n=385 sz=2 s=5 l=9 c=26 d=';' sol=0:175
+62: n=424 sz=0 s=5 l=9 c=27 d='<null>' sol=0:175
+63: n=421 sz=6 s=5 l=10 c=0 d='const' sol=0:203
+64: n=426 sz=0 s=5 l=0 c=0 d='<null>' sol=null
+65: n=421 sz=4 s=5 l=10 c=6 d='int' sol=0:203
+66: n=426 sz=0 s=5 l=0 c=0 d='<null>' sol=null
+67: n=421 sz=6 s=5 l=10 c=10 d='file2' sol=0:203
+68: n=426 sz=0 s=5 l=0 c=0 d='<null>' sol=null
+69: n=373 sz=2 s=5 l=10 c=16 d='=' sol=0:203
+70: n=426 sz=0 s=5 l=0 c=0 d='<null>' sol=null
+71: n=419 sz=9 s=5 l=10 c=18 d='5' sol=0:203
+72: n=385 sz=2 s=5 l=10 c=26 d=';' sol=0:203
+73: n=424 sz=0 s=5 l=10 c=27 d='<null>' sol=0:203
+74: n=421 sz=5 s=5 l=11 c=0 d='void' sol=0:231
+75: n=426 sz=0 s=5 l=0 c=0 d='<null>' sol=null
+76: n=421 sz=5 s=5 l=11 c=5 d='main' sol=0:231
+77: n=377 sz=2 s=5 l=11 c=9 d='(' sol=0:231
+78: n=384 sz=2 s=5 l=11 c=10 d=')' sol=0:231
+79: n=426 sz=0 s=5 l=0 c=0 d='<null>' sol=null
+80: n=375 sz=2 s=5 l=11 c=12 d='{' sol=0:231
+81: n=426 sz=0 s=5 l=0 c=0 d='<null>' sol=null
+82: n=421 sz=13 s=5 l=11 c=14 d='gl_FragColor' sol=0:231
+83: n=426 sz=0 s=5 l=0 c=0 d='<null>' sol=null
+84: n=373 sz=2 s=5 l=11 c=27 d='=' sol=0:231
+85: n=426 sz=0 s=5 l=0 c=0 d='<null>' sol=null
+86: n=421 sz=5 s=5 l=11 c=29 d='vec4' sol=0:231
+87: n=377 sz=2 s=5 l=11 c=33 d='(' sol=0:231
+88: n=421 sz=6 s=5 l=11 c=34 d='float' sol=0:231
+89: n=377 sz=2 s=5 l=11 c=39 d='(' sol=0:231
+90: n=421 sz=5 s=5 l=11 c=40 d='line' sol=0:231
+91: n=426 sz=0 s=5 l=0 c=0 d='<null>' sol=null
+92: n=379 sz=2 s=5 l=11 c=45 d='+' sol=0:231
+93: n=426 sz=0 s=5 l=0 c=0 d='<null>' sol=null
+94: n=421 sz=6 s=5 l=11 c=47 d='line2' sol=0:231
+95: n=426 sz=0 s=5 l=0 c=0 d='<null>' sol=null
+96: n=379 sz=2 s=5 l=11 c=53 d='+' sol=0:231
+97: n=426 sz=0 s=5 l=0 c=0 d='<null>' sol=null
+98: n=421 sz=6 s=5 l=11 c=55 d='line3' sol=0:231
+99: n=426 sz=0 s=5 l=0 c=0 d='<null>' sol=null
+100: n=379 sz=2 s=5 l=11 c=61 d='+' sol=0:231
+101: n=426 sz=0 s=5 l=0 c=0 d='<null>' sol=null
+102: n=421 sz=5 s=5 l=11 c=63 d='file' sol=0:231
+103: n=426 sz=0 s=5 l=0 c=0 d='<null>' sol=null
+104: n=379 sz=2 s=5 l=11 c=68 d='+' sol=0:231
+105: n=426 sz=0 s=5 l=0 c=0 d='<null>' sol=null
+106: n=421 sz=6 s=5 l=11 c=70 d='file2' sol=0:231
+107: n=426 sz=0 s=5 l=0 c=0 d='<null>' sol=null
+108: n=379 sz=2 s=5 l=11 c=76 d='+' sol=0:231
+109: n=426 sz=0 s=5 l=0 c=0 d='<null>' sol=null
+110: n=421 sz=8 s=5 l=11 c=78 d='version' sol=0:231
+111: n=384 sz=2 s=5 l=11 c=85 d=')' sol=0:231
+112: n=384 sz=2 s=5 l=11 c=86 d=')' sol=0:231
+113: n=385 sz=2 s=5 l=11 c=87 d=';' sol=0:231
+114: n=426 sz=0 s=5 l=0 c=0 d='<null>' sol=null
+115: n=382 sz=2 s=5 l=11 c=89 d='}' sol=0:231
+116: n=424 sz=0 s=5 l=11 c=90 d='<null>' sol=0:231
+117: n=432 sz=0 s=5 l=0 c=0 d='<null>' sol=null
@@ -0,0 +1,12 @@
+/* Leading comment */
+// Another one
+#version 100 // trailing
+precision mediump float; /* a
+   multi line
+   comment */
+#define X /* in a define */ 2.0 // end
+#  define	Y	X
+void main()
+{
+	gl_FragColor = vec4(X, Y, /* inline */ 1.0, 1.0);
+}
@@ -0,0 +1,45 @@
+ok=1 in=65
+ext=10 n=43
+0: n=424 sz=0 s=0 l=1 c=21 d='<null>' sol=0:0
+1: n=424 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+2: n=428 sz=0 s=0 l=3 c=1 d='<null>' sol=#100
+3: n=421 sz=10 s=0 l=4 c=0 d='precision' sol=0:62
+4: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+5: n=421 sz=8 s=0 l=4 c=10 d='mediump' sol=0:62
+6: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+7: n=421 sz=6 s=0 l=4 c=18 d='float' sol=0:62
+8: n=385 sz=2 s=0 l=4 c=23 d=';' sol=0:62
+9: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+10: n=424 sz=0 s=0 l=6 c=13 d='<null>' sol=0:106
+11: n=421 sz=5 s=0 l=9 c=0 d='void' sol=0:173
+12: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+13: n=421 sz=5 s=0 l=9 c=5 d='main' sol=0:173
+14: n=377 sz=2 s=0 l=9 c=9 d='(' sol=0:173
+15: n=384 sz=2 s=0 l=9 c=10 d=')' sol=0:173
+16: n=424 sz=0 s=0 l=9 c=11 d='<null>' sol=0:173
+17: n=375 sz=2 s=0 l=10 c=0 d='{' sol=0:185
+18: n=424 sz=0 s=0 l=10 c=1 d='<null>' sol=0:185
+19: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+20: n=421 sz=13 s=0 l=11 c=1 d='gl_FragColor' sol=0:187
+21: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+22: n=373 sz=2 s=0 l=11 c=14 d='=' sol=0:187
+23: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+24: n=421 sz=5 s=0 l=11 c=16 d='vec4' sol=0:187
+25: n=377 sz=2 s=0 l=11 c=20 d='(' sol=0:187
+26: n=417 sz=4 s=0 l=11 c=21 d='2.0' sol=0:187
+27: n=368 sz=2 s=0 l=11 c=22 d=',' sol=0:187
+28: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+29: n=417 sz=4 s=0 l=11 c=24 d='2.0' sol=0:187
+30: n=368 sz=2 s=0 l=11 c=25 d=',' sol=0:187
+31: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+32: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+33: n=417 sz=4 s=0 l=11 c=40 d='1.0' sol=0:187
+34: n=368 sz=2 s=0 l=11 c=43 d=',' sol=0:187
+35: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+36: n=417 sz=4 s=0 l=11 c=45 d='1.0' sol=0:187
+37: n=384 sz=2 s=0 l=11 c=48 d=')' sol=0:187
+38: n=385 sz=2 s=0 l=11 c=49 d=';' sol=0:187
+39: n=424 sz=0 s=0 l=11 c=50 d='<null>' sol=0:187
+40: n=382 sz=2 s=0 l=12 c=0 d='}' sol=0:238
+41: n=424 sz=0 s=0 l=12 c=1 d='<null>' sol=0:238
+42: n=432 sz=0 s=0 l=0 c=0 d='<null>' sol=null
@@ -0,0 +1,38 @@
+precision mediump float;
+#define LEVEL 3
+#define FEATURE_A
+#if LEVEL > 2 && defined(FEATURE_A)
+float a = 1.0;
+#elif LEVEL > 1
+float a = 2.0;
+#else
+float a = 3.0;
+#endif
+#ifdef FEATURE_B
+float b = 1.0;
+#elif defined FEATURE_A
+float b = 2.0;
+#endif
+#ifndef FEATURE_B
+	#if (LEVEL * 2 - 1) == 5 || !defined(LEVEL)
+float c = 1.0;
+	#else
+float c = 2.0;
+	#endif
+#else
+float c = 3.0;
+#endif
+#if 0
+#if 1
+float d = 0.0;
+#else
+#error not reached
+#endif
+#endif
+#if GL_ES && GL_FRAGMENT_PRECISION_HIGH
+highp float e;
+#endif
+#if (1 << 3) == 8 && (7 & 3) == 3 && (4 | 1) == 5 && (6 ^ 2) == 4 && ~0 == -1
+float f;
+#endif
+void main() { gl_FragColor = vec4(a, b, c, 1.0); }
@@ -0,0 +1,80 @@
+ok=1 in=343
+ext=10 n=78
+0: n=421 sz=10 s=0 l=1 c=0 d='precision' sol=0:0
+1: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+2: n=421 sz=8 s=0 l=1 c=10 d='mediump' sol=0:0
+3: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+4: n=421 sz=6 s=0 l=1 c=18 d='float' sol=0:0
+5: n=385 sz=2 s=0 l=1 c=23 d=';' sol=0:0
+6: n=424 sz=0 s=0 l=1 c=24 d='<null>' sol=0:0
+7: n=421 sz=6 s=0 l=5 c=0 d='float' sol=0:95
+8: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+9: n=421 sz=2 s=0 l=5 c=6 d='a' sol=0:95
+10: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+11: n=373 sz=2 s=0 l=5 c=8 d='=' sol=0:95
+12: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+13: n=417 sz=4 s=0 l=5 c=10 d='1.0' sol=0:95
+14: n=385 sz=2 s=0 l=5 c=13 d=';' sol=0:95
+15: n=424 sz=0 s=0 l=5 c=14 d='<null>' sol=0:95
+16: n=421 sz=6 s=0 l=14 c=0 d='float' sol=0:225
+17: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+18: n=421 sz=2 s=0 l=14 c=6 d='b' sol=0:225
+19: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+20: n=373 sz=2 s=0 l=14 c=8 d='=' sol=0:225
+21: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+22: n=417 sz=4 s=0 l=14 c=10 d='2.0' sol=0:225
+23: n=385 sz=2 s=0 l=14 c=13 d=';' sol=0:225
+24: n=424 sz=0 s=0 l=14 c=14 d='<null>' sol=0:225
+25: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+26: n=421 sz=6 s=0 l=18 c=0 d='float' sol=0:310
+27: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+28: n=421 sz=2 s=0 l=18 c=6 d='c' sol=0:310
+29: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+30: n=373 sz=2 s=0 l=18 c=8 d='=' sol=0:310
+31: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+32: n=417 sz=4 s=0 l=18 c=10 d='1.0' sol=0:310
+33: n=385 sz=2 s=0 l=18 c=13 d=';' sol=0:310
+34: n=424 sz=0 s=0 l=18 c=14 d='<null>' sol=0:310
+35: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+36: n=421 sz=6 s=0 l=33 c=0 d='highp' sol=0:489
+37: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+38: n=421 sz=6 s=0 l=33 c=6 d='float' sol=0:489
+39: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+40: n=421 sz=2 s=0 l=33 c=12 d='e' sol=0:489
+41: n=385 sz=2 s=0 l=33 c=13 d=';' sol=0:489
+42: n=424 sz=0 s=0 l=33 c=14 d='<null>' sol=0:489
+43: n=421 sz=6 s=0 l=36 c=0 d='float' sol=0:589
+44: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+45: n=421 sz=2 s=0 l=36 c=6 d='f' sol=0:589
+46: n=385 sz=2 s=0 l=36 c=7 d=';' sol=0:589
+47: n=424 sz=0 s=0 l=36 c=8 d='<null>' sol=0:589
+48: n=421 sz=5 s=0 l=38 c=0 d='void' sol=0:605
+49: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+50: n=421 sz=5 s=0 l=38 c=5 d='main' sol=0:605
+51: n=377 sz=2 s=0 l=38 c=9 d='(' sol=0:605
+52: n=384 sz=2 s=0 l=38 c=10 d=')' sol=0:605
+53: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+54: n=375 sz=2 s=0 l=38 c=12 d='{' sol=0:605
+55: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+56: n=421 sz=13 s=0 l=38 c=14 d='gl_FragColor' sol=0:605
+57: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+58: n=373 sz=2 s=0 l=38 c=27 d='=' sol=0:605
+59: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+60: n=421 sz=5 s=0 l=38 c=29 d='vec4' sol=0:605
+61: n=377 sz=2 s=0 l=38 c=33 d='(' sol=0:605
+62: n=421 sz=2 s=0 l=38 c=34 d='a' sol=0:605
+63: n=368 sz=2 s=0 l=38 c=35 d=',' sol=0:605
+64: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+65: n=421 sz=2 s=0 l=38 c=37 d='b' sol=0:605
+66: n=368 sz=2 s=0 l=38 c=38 d=',' sol=0:605
+67: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+68: n=421 sz=2 s=0 l=38 c=40 d='c' sol=0:605
+69: n=368 sz=2 s=0 l=38 c=41 d=',' sol=0:605
+70: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+71: n=417 sz=4 s=0 l=38 c=43 d='1.0' sol=0:605
+72: n=384 sz=2 s=0 l=38 c=46 d=')' sol=0:605
+73: n=385 sz=2 s=0 l=38 c=47 d=';' sol=0:605
+74: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+75: n=382 sz=2 s=0 l=38 c=49 d='}' sol=0:605
+76: n=424 sz=0 s=0 l=38 c=50 d='<null>' sol=0:605
+77: n=432 sz=0 s=0 l=0 c=0 d='<null>' sol=null
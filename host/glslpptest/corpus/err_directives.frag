@@ -0,0 +1,16 @@
+precision mediump float;
+#define GL_FOO 1
+#define __BAR 1
+#define M(a, b) a
+#define M 2
+#if
+#endif
+#ifdef
+#endif
+#undef
+#bogus
+#
+float f = M(1);
+float g = M(1, 2, 3);
+float h = M(1 2);
+void main() {}
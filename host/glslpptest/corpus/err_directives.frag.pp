@@ -0,0 +1,13 @@
+ok=0 in=115
+E0 t=2 c=8: ERROR: 0:2: Syntax error, cannot #define GL_FOO, as GL_ is reserved for predefined macros
+E1 t=2 c=8: ERROR: 0:3: Syntax error, cannot #define __BAR, as __ is reserved for predefined macros
+E2 t=2 c=8: ERROR: 0:5: Syntax error, 'M' macro redefinition
+E3 t=2 c=1: ERROR: 0:6: invalid integer constant expression
+E4 t=2 c=1: ERROR: 0:7: Syntax error, #endif mismatch
+E5 t=2 c=0: ERROR: Syntax error, #if[n]def expected an identifier
+E6 t=2 c=1: ERROR: 0:9: Syntax error, #endif mismatch
+E7 t=2 c=0: ERROR: Syntax error, no parameter specified for #undef
+E8 t=2 c=1: ERROR: 0:11: '' :   Invalid directive bogus
+E9 t=2 c=13: ERROR: 0:13: 'M' : Too few args for macro
+E10 t=2 c=18: ERROR: 0:14: 'M' : Too many args for macro
+E11 t=2 c=15: ERROR: 0:15: 'M' : Too few args for macro
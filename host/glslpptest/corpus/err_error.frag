@@ -0,0 +1,6 @@
+#version 100
+precision mediump float;
+#ifdef GL_ES
+#error GL_ES is defined
+#endif
+void main() {}
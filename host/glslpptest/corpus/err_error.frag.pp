@@ -0,0 +1,21 @@
+ok=1 in=39
+ext=10 n=18
+0: n=428 sz=0 s=0 l=1 c=1 d='<null>' sol=#100
+1: n=421 sz=10 s=0 l=2 c=0 d='precision' sol=0:13
+2: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+3: n=421 sz=8 s=0 l=2 c=10 d='mediump' sol=0:13
+4: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+5: n=421 sz=6 s=0 l=2 c=18 d='float' sol=0:13
+6: n=385 sz=2 s=0 l=2 c=23 d=';' sol=0:13
+7: n=424 sz=0 s=0 l=2 c=24 d='<null>' sol=0:13
+8: n=421 sz=5 s=0 l=6 c=0 d='void' sol=0:82
+9: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+10: n=421 sz=5 s=0 l=6 c=5 d='main' sol=0:82
+11: n=377 sz=2 s=0 l=6 c=9 d='(' sol=0:82
+12: n=384 sz=2 s=0 l=6 c=10 d=')' sol=0:82
+13: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+14: n=375 sz=2 s=0 l=6 c=12 d='{' sol=0:82
+15: n=382 sz=2 s=0 l=6 c=13 d='}' sol=0:82
+16: n=424 sz=0 s=0 l=6 c=14 d='<null>' sol=0:82
+17: n=432 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+E0 t=2 c=7: ERROR: 0:4: GL_ES is defined
@@ -0,0 +1,8 @@
+precision mediump float;
+#define F(a) (a)
+#define EMPTY()
+void main()
+{
+	float x = F(1.0;
+	gl_FragColor = vec4(x) EMPTY();
+}
@@ -0,0 +1,2 @@
+ok=0 in=64
+E0 t=2 c=11: ERROR: 0:6: 'F' : Missing right bracket
@@ -0,0 +1,9 @@
+precision mediump float;
+#if 1
+#else
+#else
+#endif
+#endif
+#elif 1
+#if 1
+void main() {}
@@ -0,0 +1,5 @@
+ok=0 in=44
+E0 t=2 c=1: ERROR: 0:4: '' : syntax error #else after a #else
+E1 t=2 c=1: ERROR: 0:6: Syntax error, #endif mismatch
+E2 t=2 c=1: ERROR: 0:7: '' : syntax error #elif mismatch
+E3 t=2 c=0: ERROR: Premature end of source; preprocessor expected #endif
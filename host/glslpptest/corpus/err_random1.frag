@@ -0,0 +1,45 @@
+
+# define B(p, q) q p x q x q
+B gl_FragColor { /* c */ B(1,
+ (y)) ; __LINE__
+) B(, 1 f(a, b)) B( , \
+ A x) gl_FragColor x } x
+{ x float __FILE__ B(vec2(1.0, 2.0), 1) 1.0 B(vec2(1.0, 2.0), x )
+x B
+B((y) ,
+ ) float // d B(x (y), \
+ x ) B B(vec2(1.0, 2.0),
+ x x) /* c */ __LINE__ B B(A, \
+ (y))
+float B B B((y), 1) __VERSION__ B B(1 ,
+ (y)) B B
+#	extension GL_OES_standard_derivatives : disable
+#ifndef Z
+__FILE__ } =
+) B { B(1,
+ f(a, b) A) = __VERSION__ __VERSION__ B(f(a, b), \
+ vec2(1.0, 2.0) x)
+# define F(p, q, r) 2.0 2.0 )
+B(x 1, f(a, b) 1) F __LINE__ F(vec2(1.0, 2.0) x, \
+ f(a, b), \
+ (y))
+; F((y),
+ vec2(1.0, 2.0) f(a, b),
+ 1 ) F(vec2(1.0, 2.0), \
+ vec2(1.0, 2.0), \
+ x ) = B ) __FILE__ {
+B(vec2(1.0, 2.0), \
+ f(a, b))
+1.0 __LINE__ F(x, \
+ (y) , \
+ ) ; B(A,
+  (y)) ; __VERSION__ __VERSION__ /* c */ F
+F F( 1,
+ f(a, b) vec2(1.0, 2.0),
+ A (y)) B(f(a, b), \
+ x x) __VERSION__ = 1.0 F((y) vec2(1.0, 2.0), (y),  x) F((y) f(a, b), \
+ f(a, b) (y), \
+ (y)) B(A f(a, b),
+ ) B((y) ,
+ A (y))
+#endif
@@ -0,0 +1,12 @@
+ok=0 in=668
+E0 t=2 c=0: ERROR: 0:3: 'B' : Expected macro parameter
+E1 t=2 c=2: ERROR: 0:8: 'B' : Expected macro parameter
+E2 t=2 c=5: ERROR: 0:11: 'B' : Expected macro parameter
+E3 t=2 c=23: ERROR: 0:12: 'B' : Expected macro parameter
+E4 t=2 c=6: ERROR: 0:14: 'B' : Expected macro parameter
+E5 t=2 c=6: ERROR: 0:15: 'B' : Expected macro parameter
+E6 t=2 c=2: ERROR: 0:19: 'B' : Expected macro parameter
+E7 t=2 c=18: ERROR: 0:23: 'F' : Expected macro parameter
+E8 t=2 c=7: ERROR: 0:30: 'B' : Expected macro parameter
+E9 t=2 c=41: ERROR: 0:36: 'F' : Expected macro parameter
+E10 t=2 c=0: ERROR: 0:37: 'F' : Expected macro parameter
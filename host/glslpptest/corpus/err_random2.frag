@@ -0,0 +1,21 @@
+#version 100
+__VERSION__ 1.0
+# ifdef GL_ES
+  #define D(p, q) ) * p
+} D = D = ( D ( ;
+D
+#	undef D
+  #define C 2 __LINE__
+  #define E 2
+# define B 1 0.5 1
+
+# undef B
+#line 12 1
+#	if 0
+#	else
+  #define A() ) * x 2.0 2.0 (
+#	extension GL_OES_standard_derivatives : require
+A() A() gl_FragColor A A() E {
+A() A A() __FILE__ A() 1.0
+#endif
+#endif
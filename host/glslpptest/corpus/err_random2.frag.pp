@@ -0,0 +1,5 @@
+ok=0 in=187
+E0 t=2 c=2: ERROR: 1:5: 'D' : Expected macro parameter
+E1 t=2 c=0: ERROR: 1:6: 'D' : Expected macro parameter
+E2 t=2 c=2: ERROR: 1:18: 'A' : Too many args for macro
+E3 t=2 c=2: ERROR: 1:19: 'A' : Too many args for macro
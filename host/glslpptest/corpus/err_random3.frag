@@ -0,0 +1,62 @@
+#ifndef Z
+#	define D 2 0.5
+D D D D 1.0 D D D x =
+# define C(p, q) D
+// d ; D
+# ifndef D
+1.0 C(1,
+ (y)) C(1, 1) C(f(a, b),
+  ) = D C
+  #undef C
+__FILE__ __LINE__
+# define F(p, q) + D 2.0 q (
+# endif
+# undef D
+F(A, 1 ) F(f(a, b) A, \
+ A (y)) ;
+# line 36 3
+/* c */ // d F(, \
+ x) F( f(a, b),
+  1) F __LINE__ F((y) x,
+ f(a, b))
+  #elif 0
+# endif
+#	if 1
+#if __VERSION__ >= 100
+F( x,
+ A) ) F float } __LINE__ )
+  #define G y +
+#undef G
+  #line 7 3
+gl_FragColor F __LINE__ F((y), \
+ 1 f(a, b)) F(f(a, b),
+ f(a, b)) 1.0 __LINE__ F F (
+F(vec2(1.0, 2.0),
+ A) =
+  #if 1
+/* c */
+# pragma STDGL invariant(all)
+F(x , \
+ A vec2(1.0, 2.0)) __VERSION__ F(x,
+ vec2(1.0, 2.0) vec2(1.0, 2.0)) __VERSION__ F float
+#if __VERSION__ >= 100
+F(vec2(1.0, 2.0), vec2(1.0, 2.0) 1) F(x x,
+ (y)) gl_FragColor { __LINE__ __FILE__ F F
+
+F(vec2(1.0, 2.0), \
+ vec2(1.0, 2.0) (y)) gl_FragColor __VERSION__
+#define A y
+( F(x x,
+ f(a, b) vec2(1.0, 2.0)) F(A A, \
+ 1 x) ( 1.0 F(1 vec2(1.0, 2.0), \
+ vec2(1.0, 2.0)) __VERSION__ =
+# \
+ define D(p) + +
+  #if A
+#	ifdef Z
+#endif
+#endif
+#endif
+#endif
+#endif
+#endif
\ No newline at end of file
@@ -0,0 +1,3 @@
+ok=0 in=655
+E0 t=2 c=8: ERROR: 0:9: 'C' : Expected macro parameter
+E1 t=2 c=6: ERROR: 3:55: Syntax error, unexpected 'y'
@@ -0,0 +1,3 @@
+precision mediump float;
+#version 100
+void main() {}
@@ -0,0 +1,2 @@
+ok=0 in=22
+E0 t=2 c=1: ERROR: 0:2: #version must occur before any other statement in the program
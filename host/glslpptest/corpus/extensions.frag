@@ -0,0 +1,12 @@
+#version 100
+#extension GL_OES_standard_derivatives : enable
+#extension GL_EXT_shader_texture_lod : require
+#extension GL_OES_standard_derivatives : disable
+#extension GL_IMG_unknown_extension : warn
+#extension all : disable
+#pragma optimize(on)
+#pragma debug(off)
+#pragma STDGL invariant(all)
+#pragma vendor_specific
+precision mediump float;
+void main() { gl_FragColor = vec4(1.0); }
@@ -0,0 +1,40 @@
+ok=1 in=109
+ext=58 n=37
+0: n=428 sz=0 s=0 l=1 c=1 d='<null>' sol=#100
+1: n=429 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+2: n=419 sz=0 s=0 l=0 c=0 d='<null>' sol=#20
+3: n=429 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+4: n=419 sz=0 s=0 l=0 c=0 d='<null>' sol=#84
+5: n=429 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+6: n=419 sz=0 s=0 l=0 c=0 d='<null>' sol=#80
+7: n=429 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+8: n=419 sz=0 s=0 l=0 c=0 d='<null>' sol=#80
+9: n=421 sz=10 s=0 l=11 c=0 d='precision' sol=0:318
+10: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+11: n=421 sz=8 s=0 l=11 c=10 d='mediump' sol=0:318
+12: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+13: n=421 sz=6 s=0 l=11 c=18 d='float' sol=0:318
+14: n=385 sz=2 s=0 l=11 c=23 d=';' sol=0:318
+15: n=424 sz=0 s=0 l=11 c=24 d='<null>' sol=0:318
+16: n=421 sz=5 s=0 l=12 c=0 d='void' sol=0:343
+17: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+18: n=421 sz=5 s=0 l=12 c=5 d='main' sol=0:343
+19: n=377 sz=2 s=0 l=12 c=9 d='(' sol=0:343
+20: n=384 sz=2 s=0 l=12 c=10 d=')' sol=0:343
+21: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+22: n=375 sz=2 s=0 l=12 c=12 d='{' sol=0:343
+23: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+24: n=421 sz=13 s=0 l=12 c=14 d='gl_FragColor' sol=0:343
+25: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+26: n=373 sz=2 s=0 l=12 c=27 d='=' sol=0:343
+27: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+28: n=421 sz=5 s=0 l=12 c=29 d='vec4' sol=0:343
+29: n=377 sz=2 s=0 l=12 c=33 d='(' sol=0:343
+30: n=417 sz=4 s=0 l=12 c=34 d='1.0' sol=0:343
+31: n=384 sz=2 s=0 l=12 c=37 d=')' sol=0:343
+32: n=385 sz=2 s=0 l=12 c=38 d=';' sol=0:343
+33: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+34: n=382 sz=2 s=0 l=12 c=40 d='}' sol=0:343
+35: n=424 sz=0 s=0 l=12 c=41 d='<null>' sol=0:343
+36: n=432 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+E0 t=4 c=38: WARNING: 0:5: Extension GL_IMG_unknown_extension not supported
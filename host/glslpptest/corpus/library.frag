@@ -0,0 +1,95 @@
+#version 100
+#ifdef GL_ES
+precision mediump float;
+#endif
+#define TERM0(a, b) ((a) * 0.0 + (b) * C0)
+#define TERM1(a, b) ((a) * 1.0 + (b) * C1)
+#define TERM2(a, b) ((a) * 2.0 + (b) * C2)
+#define TERM3(a, b) ((a) * 3.0 + (b) * C3)
+#define TERM4(a, b) ((a) * 4.0 + (b) * C4)
+#define TERM5(a, b) ((a) * 5.0 + (b) * C5)
+#define TERM6(a, b) ((a) * 6.0 + (b) * C6)
+#define TERM7(a, b) ((a) * 7.0 + (b) * C7)
+#define TERM8(a, b) ((a) * 8.0 + (b) * C0)
+#define TERM9(a, b) ((a) * 9.0 + (b) * C1)
+#define TERM10(a, b) ((a) * 10.0 + (b) * C2)
+#define TERM11(a, b) ((a) * 11.0 + (b) * C3)
+#define TERM12(a, b) ((a) * 12.0 + (b) * C4)
+#define TERM13(a, b) ((a) * 13.0 + (b) * C5)
+#define TERM14(a, b) ((a) * 14.0 + (b) * C6)
+#define TERM15(a, b) ((a) * 15.0 + (b) * C7)
+#define TERM16(a, b) ((a) * 16.0 + (b) * C0)
+#define TERM17(a, b) ((a) * 17.0 + (b) * C1)
+#define TERM18(a, b) ((a) * 18.0 + (b) * C2)
+#define TERM19(a, b) ((a) * 19.0 + (b) * C3)
+#define TERM20(a, b) ((a) * 20.0 + (b) * C4)
+#define TERM21(a, b) ((a) * 21.0 + (b) * C5)
+#define TERM22(a, b) ((a) * 22.0 + (b) * C6)
+#define TERM23(a, b) ((a) * 23.0 + (b) * C7)
+#define C0 0.0
+#define C1 1.1
+#define C2 2.2
+#define C3 3.3
+#define C4 4.4
+#define C5 5.5
+#define C6 6.6
+#define C7 7.7
+#define LEVEL 4
+#define SAT(x) clamp(x, 0.0, 1.0)
+#define LUMA(c) dot(c.rgb, vec3(0.299, 0.587, 0.114))
+uniform sampler2D uTex;
+uniform vec4 uParams[8];
+varying vec2 vUV;
+void main()
+{
+	vec4 acc = vec4(0.0);
+#ifdef TERM17
+	acc += SAT(TERM17(texture2D(uTex, vUV + uParams[0].xy), uParams[4])) * LUMA(uParams[3]);
+	acc += SAT(TERM19(texture2D(uTex, vUV + uParams[1].xy), uParams[3])) * LUMA(uParams[4]);
+	acc += SAT(TERM8(texture2D(uTex, vUV + uParams[2].xy), uParams[0])) * LUMA(uParams[5]);
+	acc += SAT(TERM12(texture2D(uTex, vUV + uParams[3].xy), uParams[6])) * LUMA(uParams[6]);
+	acc += SAT(TERM20(texture2D(uTex, vUV + uParams[4].xy), uParams[2])) * LUMA(uParams[7]);
+	acc += SAT(TERM2(texture2D(uTex, vUV + uParams[5].xy), uParams[7])) * LUMA(uParams[0]);
+	acc += SAT(TERM0(texture2D(uTex, vUV + uParams[6].xy), uParams[3])) * LUMA(uParams[1]);
+	acc += SAT(TERM0(texture2D(uTex, vUV + uParams[7].xy), uParams[1])) * LUMA(uParams[2]);
+	acc += SAT(TERM5(texture2D(uTex, vUV + uParams[0].xy), uParams[6])) * LUMA(uParams[3]);
+	acc += SAT(TERM20(texture2D(uTex, vUV + uParams[1].xy), uParams[5])) * LUMA(uParams[4]);
+#endif
+#if defined(TERM17) && LEVEL > 1
+	acc += SAT(TERM17(texture2D(uTex, vUV + uParams[2].xy), uParams[1])) * LUMA(uParams[5]);
+	acc += SAT(TERM7(texture2D(uTex, vUV + uParams[3].xy), uParams[4])) * LUMA(uParams[6]);
+	acc += SAT(TERM13(texture2D(uTex, vUV + uParams[4].xy), uParams[1])) * LUMA(uParams[7]);
+	acc += SAT(TERM21(texture2D(uTex, vUV + uParams[5].xy), uParams[4])) * LUMA(uParams[0]);
+	acc += SAT(TERM20(texture2D(uTex, vUV + uParams[6].xy), uParams[1])) * LUMA(uParams[1]);
+	acc += SAT(TERM19(texture2D(uTex, vUV + uParams[7].xy), uParams[7])) * LUMA(uParams[2]);
+	acc += SAT(TERM9(texture2D(uTex, vUV + uParams[0].xy), uParams[2])) * LUMA(uParams[3]);
+	acc += SAT(TERM9(texture2D(uTex, vUV + uParams[1].xy), uParams[4])) * LUMA(uParams[4]);
+	acc += SAT(TERM8(texture2D(uTex, vUV + uParams[2].xy), uParams[1])) * LUMA(uParams[5]);
+	acc += SAT(TERM4(texture2D(uTex, vUV + uParams[3].xy), uParams[3])) * LUMA(uParams[6]);
+#endif
+#if defined(TERM22) && LEVEL > 5
+	acc += SAT(TERM22(texture2D(uTex, vUV + uParams[4].xy), uParams[5])) * LUMA(uParams[7]);
+	acc += SAT(TERM0(texture2D(uTex, vUV + uParams[5].xy), uParams[6])) * LUMA(uParams[0]);
+	acc += SAT(TERM23(texture2D(uTex, vUV + uParams[6].xy), uParams[4])) * LUMA(uParams[1]);
+	acc += SAT(TERM5(texture2D(uTex, vUV + uParams[7].xy), uParams[2])) * LUMA(uParams[2]);
+	acc += SAT(TERM15(texture2D(uTex, vUV + uParams[0].xy), uParams[5])) * LUMA(uParams[3]);
+	acc += SAT(TERM16(texture2D(uTex, vUV + uParams[1].xy), uParams[7])) * LUMA(uParams[4]);
+	acc += SAT(TERM21(texture2D(uTex, vUV + uParams[2].xy), uParams[5])) * LUMA(uParams[5]);
+	acc += SAT(TERM16(texture2D(uTex, vUV + uParams[3].xy), uParams[5])) * LUMA(uParams[6]);
+	acc += SAT(TERM2(texture2D(uTex, vUV + uParams[4].xy), uParams[0])) * LUMA(uParams[7]);
+	acc += SAT(TERM20(texture2D(uTex, vUV + uParams[5].xy), uParams[1])) * LUMA(uParams[0]);
+#endif
+#if defined(TERM15) && LEVEL > 7
+	acc += SAT(TERM15(texture2D(uTex, vUV + uParams[6].xy), uParams[7])) * LUMA(uParams[1]);
+	acc += SAT(TERM15(texture2D(uTex, vUV + uParams[7].xy), uParams[4])) * LUMA(uParams[2]);
+	acc += SAT(TERM18(texture2D(uTex, vUV + uParams[0].xy), uParams[4])) * LUMA(uParams[3]);
+	acc += SAT(TERM22(texture2D(uTex, vUV + uParams[1].xy), uParams[2])) * LUMA(uParams[4]);
+	acc += SAT(TERM21(texture2D(uTex, vUV + uParams[2].xy), uParams[2])) * LUMA(uParams[5]);
+	acc += SAT(TERM5(texture2D(uTex, vUV + uParams[3].xy), uParams[4])) * LUMA(uParams[6]);
+	acc += SAT(TERM13(texture2D(uTex, vUV + uParams[4].xy), uParams[3])) * LUMA(uParams[7]);
+	acc += SAT(TERM6(texture2D(uTex, vUV + uParams[5].xy), uParams[7])) * LUMA(uParams[0]);
+	acc += SAT(TERM11(texture2D(uTex, vUV + uParams[6].xy), uParams[6])) * LUMA(uParams[1]);
+	acc += SAT(TERM23(texture2D(uTex, vUV + uParams[7].xy), uParams[4])) * LUMA(uParams[2]);
+#endif
+	gl_FragColor = acc;
+}
@@ -0,0 +1,1326 @@
+ok=1 in=2794
+ext=10 n=1324
+0: n=428 sz=0 s=0 l=1 c=1 d='<null>' sol=#100
+1: n=421 sz=10 s=0 l=3 c=0 d='precision' sol=0:26
+2: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+3: n=421 sz=8 s=0 l=3 c=10 d='mediump' sol=0:26
+4: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+5: n=421 sz=6 s=0 l=3 c=18 d='float' sol=0:26
+6: n=385 sz=2 s=0 l=3 c=23 d=';' sol=0:26
+7: n=424 sz=0 s=0 l=3 c=24 d='<null>' sol=0:26
+8: n=421 sz=8 s=0 l=40 c=0 d='uniform' sol=0:1342
+9: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+10: n=421 sz=10 s=0 l=40 c=8 d='sampler2D' sol=0:1342
+11: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+12: n=421 sz=5 s=0 l=40 c=18 d='uTex' sol=0:1342
+13: n=385 sz=2 s=0 l=40 c=22 d=';' sol=0:1342
+14: n=424 sz=0 s=0 l=40 c=23 d='<null>' sol=0:1342
+15: n=421 sz=8 s=0 l=41 c=0 d='uniform' sol=0:1366
+16: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+17: n=421 sz=5 s=0 l=41 c=8 d='vec4' sol=0:1366
+18: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+19: n=421 sz=8 s=0 l=41 c=13 d='uParams' sol=0:1366
+20: n=376 sz=2 s=0 l=41 c=20 d='[' sol=0:1366
+21: n=419 sz=2 s=0 l=41 c=21 d='8' sol=0:1366
+22: n=383 sz=2 s=0 l=41 c=22 d=']' sol=0:1366
+23: n=385 sz=2 s=0 l=41 c=23 d=';' sol=0:1366
+24: n=424 sz=0 s=0 l=41 c=24 d='<null>' sol=0:1366
+25: n=421 sz=8 s=0 l=42 c=0 d='varying' sol=0:1391
+26: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+27: n=421 sz=5 s=0 l=42 c=8 d='vec2' sol=0:1391
+28: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+29: n=421 sz=4 s=0 l=42 c=13 d='vUV' sol=0:1391
+30: n=385 sz=2 s=0 l=42 c=16 d=';' sol=0:1391
+31: n=424 sz=0 s=0 l=42 c=17 d='<null>' sol=0:1391
+32: n=421 sz=5 s=0 l=43 c=0 d='void' sol=0:1409
+33: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+34: n=421 sz=5 s=0 l=43 c=5 d='main' sol=0:1409
+35: n=377 sz=2 s=0 l=43 c=9 d='(' sol=0:1409
+36: n=384 sz=2 s=0 l=43 c=10 d=')' sol=0:1409
+37: n=424 sz=0 s=0 l=43 c=11 d='<null>' sol=0:1409
+38: n=375 sz=2 s=0 l=44 c=0 d='{' sol=0:1421
+39: n=424 sz=0 s=0 l=44 c=1 d='<null>' sol=0:1421
+40: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+41: n=421 sz=5 s=0 l=45 c=1 d='vec4' sol=0:1423
+42: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+43: n=421 sz=4 s=0 l=45 c=6 d='acc' sol=0:1423
+44: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+45: n=373 sz=2 s=0 l=45 c=10 d='=' sol=0:1423
+46: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+47: n=421 sz=5 s=0 l=45 c=12 d='vec4' sol=0:1423
+48: n=377 sz=2 s=0 l=45 c=16 d='(' sol=0:1423
+49: n=417 sz=4 s=0 l=45 c=17 d='0.0' sol=0:1423
+50: n=384 sz=2 s=0 l=45 c=20 d=')' sol=0:1423
+51: n=385 sz=2 s=0 l=45 c=21 d=';' sol=0:1423
+52: n=424 sz=0 s=0 l=45 c=22 d='<null>' sol=0:1423
+53: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+54: n=421 sz=4 s=0 l=47 c=1 d='acc' sol=0:1460
+55: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+56: n=396 sz=3 s=0 l=47 c=5 d='+=' sol=0:1460
+57: n=426 sz=0 s=0 l=47 c=6 d='<null>' sol=0:1460
+58: n=421 sz=6 s=0 l=47 c=8 d='clamp' sol=0:1460
+59: n=377 sz=2 s=0 l=47 c=8 d='(' sol=0:1460
+60: n=377 sz=2 s=0 l=47 c=12 d='(' sol=0:1460
+61: n=377 sz=2 s=0 l=47 c=12 d='(' sol=0:1460
+62: n=421 sz=10 s=0 l=47 c=19 d='texture2D' sol=0:1460
+63: n=377 sz=2 s=0 l=47 c=28 d='(' sol=0:1460
+64: n=421 sz=5 s=0 l=47 c=29 d='uTex' sol=0:1460
+65: n=368 sz=2 s=0 l=47 c=33 d=',' sol=0:1460
+66: n=421 sz=4 s=0 l=47 c=35 d='vUV' sol=0:1460
+67: n=379 sz=2 s=0 l=47 c=39 d='+' sol=0:1460
+68: n=421 sz=8 s=0 l=47 c=41 d='uParams' sol=0:1460
+69: n=376 sz=2 s=0 l=47 c=48 d='[' sol=0:1460
+70: n=419 sz=2 s=0 l=47 c=49 d='0' sol=0:1460
+71: n=383 sz=2 s=0 l=47 c=50 d=']' sol=0:1460
+72: n=371 sz=2 s=0 l=47 c=51 d='.' sol=0:1460
+73: n=421 sz=3 s=0 l=47 c=52 d='xy' sol=0:1460
+74: n=384 sz=2 s=0 l=47 c=54 d=')' sol=0:1460
+75: n=384 sz=2 s=0 l=47 c=12 d=')' sol=0:1460
+76: n=387 sz=2 s=0 l=47 c=12 d='*' sol=0:1460
+77: n=417 sz=5 s=0 l=47 c=12 d='17.0' sol=0:1460
+78: n=379 sz=2 s=0 l=47 c=12 d='+' sol=0:1460
+79: n=377 sz=2 s=0 l=47 c=12 d='(' sol=0:1460
+80: n=421 sz=8 s=0 l=47 c=57 d='uParams' sol=0:1460
+81: n=376 sz=2 s=0 l=47 c=64 d='[' sol=0:1460
+82: n=419 sz=2 s=0 l=47 c=65 d='4' sol=0:1460
+83: n=383 sz=2 s=0 l=47 c=66 d=']' sol=0:1460
+84: n=384 sz=2 s=0 l=47 c=12 d=')' sol=0:1460
+85: n=387 sz=2 s=0 l=47 c=12 d='*' sol=0:1460
+86: n=417 sz=4 s=0 l=47 c=12 d='1.1' sol=0:1460
+87: n=384 sz=2 s=0 l=47 c=12 d=')' sol=0:1460
+88: n=368 sz=2 s=0 l=47 c=8 d=',' sol=0:1460
+89: n=417 sz=4 s=0 l=47 c=8 d='0.0' sol=0:1460
+90: n=368 sz=2 s=0 l=47 c=8 d=',' sol=0:1460
+91: n=417 sz=4 s=0 l=47 c=8 d='1.0' sol=0:1460
+92: n=384 sz=2 s=0 l=47 c=8 d=')' sol=0:1460
+93: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+94: n=387 sz=2 s=0 l=47 c=70 d='*' sol=0:1460
+95: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+96: n=421 sz=4 s=0 l=47 c=72 d='dot' sol=0:1460
+97: n=377 sz=2 s=0 l=47 c=72 d='(' sol=0:1460
+98: n=421 sz=8 s=0 l=47 c=77 d='uParams' sol=0:1460
+99: n=376 sz=2 s=0 l=47 c=84 d='[' sol=0:1460
+100: n=419 sz=2 s=0 l=47 c=85 d='3' sol=0:1460
+101: n=383 sz=2 s=0 l=47 c=86 d=']' sol=0:1460
+102: n=371 sz=2 s=0 l=47 c=72 d='.' sol=0:1460
+103: n=421 sz=4 s=0 l=47 c=72 d='rgb' sol=0:1460
+104: n=368 sz=2 s=0 l=47 c=72 d=',' sol=0:1460
+105: n=421 sz=5 s=0 l=47 c=72 d='vec3' sol=0:1460
+106: n=377 sz=2 s=0 l=47 c=72 d='(' sol=0:1460
+107: n=417 sz=6 s=0 l=47 c=72 d='0.299' sol=0:1460
+108: n=368 sz=2 s=0 l=47 c=72 d=',' sol=0:1460
+109: n=417 sz=6 s=0 l=47 c=72 d='0.587' sol=0:1460
+110: n=368 sz=2 s=0 l=47 c=72 d=',' sol=0:1460
+111: n=417 sz=6 s=0 l=47 c=72 d='0.114' sol=0:1460
+112: n=384 sz=2 s=0 l=47 c=72 d=')' sol=0:1460
+113: n=384 sz=2 s=0 l=47 c=72 d=')' sol=0:1460
+114: n=385 sz=2 s=0 l=47 c=88 d=';' sol=0:1460
+115: n=424 sz=0 s=0 l=47 c=89 d='<null>' sol=0:1460
+116: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+117: n=421 sz=4 s=0 l=48 c=1 d='acc' sol=0:1550
+118: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+119: n=396 sz=3 s=0 l=48 c=5 d='+=' sol=0:1550
+120: n=426 sz=0 s=0 l=48 c=6 d='<null>' sol=0:1550
+121: n=421 sz=6 s=0 l=48 c=8 d='clamp' sol=0:1550
+122: n=377 sz=2 s=0 l=48 c=8 d='(' sol=0:1550
+123: n=377 sz=2 s=0 l=48 c=12 d='(' sol=0:1550
+124: n=377 sz=2 s=0 l=48 c=12 d='(' sol=0:1550
+125: n=421 sz=10 s=0 l=48 c=19 d='texture2D' sol=0:1550
+126: n=377 sz=2 s=0 l=48 c=28 d='(' sol=0:1550
+127: n=421 sz=5 s=0 l=48 c=29 d='uTex' sol=0:1550
+128: n=368 sz=2 s=0 l=48 c=33 d=',' sol=0:1550
+129: n=421 sz=4 s=0 l=48 c=35 d='vUV' sol=0:1550
+130: n=379 sz=2 s=0 l=48 c=39 d='+' sol=0:1550
+131: n=421 sz=8 s=0 l=48 c=41 d='uParams' sol=0:1550
+132: n=376 sz=2 s=0 l=48 c=48 d='[' sol=0:1550
+133: n=419 sz=2 s=0 l=48 c=49 d='1' sol=0:1550
+134: n=383 sz=2 s=0 l=48 c=50 d=']' sol=0:1550
+135: n=371 sz=2 s=0 l=48 c=51 d='.' sol=0:1550
+136: n=421 sz=3 s=0 l=48 c=52 d='xy' sol=0:1550
+137: n=384 sz=2 s=0 l=48 c=54 d=')' sol=0:1550
+138: n=384 sz=2 s=0 l=48 c=12 d=')' sol=0:1550
+139: n=387 sz=2 s=0 l=48 c=12 d='*' sol=0:1550
+140: n=417 sz=5 s=0 l=48 c=12 d='19.0' sol=0:1550
+141: n=379 sz=2 s=0 l=48 c=12 d='+' sol=0:1550
+142: n=377 sz=2 s=0 l=48 c=12 d='(' sol=0:1550
+143: n=421 sz=8 s=0 l=48 c=57 d='uParams' sol=0:1550
+144: n=376 sz=2 s=0 l=48 c=64 d='[' sol=0:1550
+145: n=419 sz=2 s=0 l=48 c=65 d='3' sol=0:1550
+146: n=383 sz=2 s=0 l=48 c=66 d=']' sol=0:1550
+147: n=384 sz=2 s=0 l=48 c=12 d=')' sol=0:1550
+148: n=387 sz=2 s=0 l=48 c=12 d='*' sol=0:1550
+149: n=417 sz=4 s=0 l=48 c=12 d='3.3' sol=0:1550
+150: n=384 sz=2 s=0 l=48 c=12 d=')' sol=0:1550
+151: n=368 sz=2 s=0 l=48 c=8 d=',' sol=0:1550
+152: n=417 sz=4 s=0 l=48 c=8 d='0.0' sol=0:1550
+153: n=368 sz=2 s=0 l=48 c=8 d=',' sol=0:1550
+154: n=417 sz=4 s=0 l=48 c=8 d='1.0' sol=0:1550
+155: n=384 sz=2 s=0 l=48 c=8 d=')' sol=0:1550
+156: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+157: n=387 sz=2 s=0 l=48 c=70 d='*' sol=0:1550
+158: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+159: n=421 sz=4 s=0 l=48 c=72 d='dot' sol=0:1550
+160: n=377 sz=2 s=0 l=48 c=72 d='(' sol=0:1550
+161: n=421 sz=8 s=0 l=48 c=77 d='uParams' sol=0:1550
+162: n=376 sz=2 s=0 l=48 c=84 d='[' sol=0:1550
+163: n=419 sz=2 s=0 l=48 c=85 d='4' sol=0:1550
+164: n=383 sz=2 s=0 l=48 c=86 d=']' sol=0:1550
+165: n=371 sz=2 s=0 l=48 c=72 d='.' sol=0:1550
+166: n=421 sz=4 s=0 l=48 c=72 d='rgb' sol=0:1550
+167: n=368 sz=2 s=0 l=48 c=72 d=',' sol=0:1550
+168: n=421 sz=5 s=0 l=48 c=72 d='vec3' sol=0:1550
+169: n=377 sz=2 s=0 l=48 c=72 d='(' sol=0:1550
+170: n=417 sz=6 s=0 l=48 c=72 d='0.299' sol=0:1550
+171: n=368 sz=2 s=0 l=48 c=72 d=',' sol=0:1550
+172: n=417 sz=6 s=0 l=48 c=72 d='0.587' sol=0:1550
+173: n=368 sz=2 s=0 l=48 c=72 d=',' sol=0:1550
+174: n=417 sz=6 s=0 l=48 c=72 d='0.114' sol=0:1550
+175: n=384 sz=2 s=0 l=48 c=72 d=')' sol=0:1550
+176: n=384 sz=2 s=0 l=48 c=72 d=')' sol=0:1550
+177: n=385 sz=2 s=0 l=48 c=88 d=';' sol=0:1550
+178: n=424 sz=0 s=0 l=48 c=89 d='<null>' sol=0:1550
+179: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+180: n=421 sz=4 s=0 l=49 c=1 d='acc' sol=0:1640
+181: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+182: n=396 sz=3 s=0 l=49 c=5 d='+=' sol=0:1640
+183: n=426 sz=0 s=0 l=49 c=6 d='<null>' sol=0:1640
+184: n=421 sz=6 s=0 l=49 c=8 d='clamp' sol=0:1640
+185: n=377 sz=2 s=0 l=49 c=8 d='(' sol=0:1640
+186: n=377 sz=2 s=0 l=49 c=12 d='(' sol=0:1640
+187: n=377 sz=2 s=0 l=49 c=12 d='(' sol=0:1640
+188: n=421 sz=10 s=0 l=49 c=18 d='texture2D' sol=0:1640
+189: n=377 sz=2 s=0 l=49 c=27 d='(' sol=0:1640
+190: n=421 sz=5 s=0 l=49 c=28 d='uTex' sol=0:1640
+191: n=368 sz=2 s=0 l=49 c=32 d=',' sol=0:1640
+192: n=421 sz=4 s=0 l=49 c=34 d='vUV' sol=0:1640
+193: n=379 sz=2 s=0 l=49 c=38 d='+' sol=0:1640
+194: n=421 sz=8 s=0 l=49 c=40 d='uParams' sol=0:1640
+195: n=376 sz=2 s=0 l=49 c=47 d='[' sol=0:1640
+196: n=419 sz=2 s=0 l=49 c=48 d='2' sol=0:1640
+197: n=383 sz=2 s=0 l=49 c=49 d=']' sol=0:1640
+198: n=371 sz=2 s=0 l=49 c=50 d='.' sol=0:1640
+199: n=421 sz=3 s=0 l=49 c=51 d='xy' sol=0:1640
+200: n=384 sz=2 s=0 l=49 c=53 d=')' sol=0:1640
+201: n=384 sz=2 s=0 l=49 c=12 d=')' sol=0:1640
+202: n=387 sz=2 s=0 l=49 c=12 d='*' sol=0:1640
+203: n=417 sz=4 s=0 l=49 c=12 d='8.0' sol=0:1640
+204: n=379 sz=2 s=0 l=49 c=12 d='+' sol=0:1640
+205: n=377 sz=2 s=0 l=49 c=12 d='(' sol=0:1640
+206: n=421 sz=8 s=0 l=49 c=56 d='uParams' sol=0:1640
+207: n=376 sz=2 s=0 l=49 c=63 d='[' sol=0:1640
+208: n=419 sz=2 s=0 l=49 c=64 d='0' sol=0:1640
+209: n=383 sz=2 s=0 l=49 c=65 d=']' sol=0:1640
+210: n=384 sz=2 s=0 l=49 c=12 d=')' sol=0:1640
+211: n=387 sz=2 s=0 l=49 c=12 d='*' sol=0:1640
+212: n=417 sz=4 s=0 l=49 c=12 d='0.0' sol=0:1640
+213: n=384 sz=2 s=0 l=49 c=12 d=')' sol=0:1640
+214: n=368 sz=2 s=0 l=49 c=8 d=',' sol=0:1640
+215: n=417 sz=4 s=0 l=49 c=8 d='0.0' sol=0:1640
+216: n=368 sz=2 s=0 l=49 c=8 d=',' sol=0:1640
+217: n=417 sz=4 s=0 l=49 c=8 d='1.0' sol=0:1640
+218: n=384 sz=2 s=0 l=49 c=8 d=')' sol=0:1640
+219: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+220: n=387 sz=2 s=0 l=49 c=69 d='*' sol=0:1640
+221: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+222: n=421 sz=4 s=0 l=49 c=71 d='dot' sol=0:1640
+223: n=377 sz=2 s=0 l=49 c=71 d='(' sol=0:1640
+224: n=421 sz=8 s=0 l=49 c=76 d='uParams' sol=0:1640
+225: n=376 sz=2 s=0 l=49 c=83 d='[' sol=0:1640
+226: n=419 sz=2 s=0 l=49 c=84 d='5' sol=0:1640
+227: n=383 sz=2 s=0 l=49 c=85 d=']' sol=0:1640
+228: n=371 sz=2 s=0 l=49 c=71 d='.' sol=0:1640
+229: n=421 sz=4 s=0 l=49 c=71 d='rgb' sol=0:1640
+230: n=368 sz=2 s=0 l=49 c=71 d=',' sol=0:1640
+231: n=421 sz=5 s=0 l=49 c=71 d='vec3' sol=0:1640
+232: n=377 sz=2 s=0 l=49 c=71 d='(' sol=0:1640
+233: n=417 sz=6 s=0 l=49 c=71 d='0.299' sol=0:1640
+234: n=368 sz=2 s=0 l=49 c=71 d=',' sol=0:1640
+235: n=417 sz=6 s=0 l=49 c=71 d='0.587' sol=0:1640
+236: n=368 sz=2 s=0 l=49 c=71 d=',' sol=0:1640
+237: n=417 sz=6 s=0 l=49 c=71 d='0.114' sol=0:1640
+238: n=384 sz=2 s=0 l=49 c=71 d=')' sol=0:1640
+239: n=384 sz=2 s=0 l=49 c=71 d=')' sol=0:1640
+240: n=385 sz=2 s=0 l=49 c=87 d=';' sol=0:1640
+241: n=424 sz=0 s=0 l=49 c=88 d='<null>' sol=0:1640
+242: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+243: n=421 sz=4 s=0 l=50 c=1 d='acc' sol=0:1729
+244: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+245: n=396 sz=3 s=0 l=50 c=5 d='+=' sol=0:1729
+246: n=426 sz=0 s=0 l=50 c=6 d='<null>' sol=0:1729
+247: n=421 sz=6 s=0 l=50 c=8 d='clamp' sol=0:1729
+248: n=377 sz=2 s=0 l=50 c=8 d='(' sol=0:1729
+249: n=377 sz=2 s=0 l=50 c=12 d='(' sol=0:1729
+250: n=377 sz=2 s=0 l=50 c=12 d='(' sol=0:1729
+251: n=421 sz=10 s=0 l=50 c=19 d='texture2D' sol=0:1729
+252: n=377 sz=2 s=0 l=50 c=28 d='(' sol=0:1729
+253: n=421 sz=5 s=0 l=50 c=29 d='uTex' sol=0:1729
+254: n=368 sz=2 s=0 l=50 c=33 d=',' sol=0:1729
+255: n=421 sz=4 s=0 l=50 c=35 d='vUV' sol=0:1729
+256: n=379 sz=2 s=0 l=50 c=39 d='+' sol=0:1729
+257: n=421 sz=8 s=0 l=50 c=41 d='uParams' sol=0:1729
+258: n=376 sz=2 s=0 l=50 c=48 d='[' sol=0:1729
+259: n=419 sz=2 s=0 l=50 c=49 d='3' sol=0:1729
+260: n=383 sz=2 s=0 l=50 c=50 d=']' sol=0:1729
+261: n=371 sz=2 s=0 l=50 c=51 d='.' sol=0:1729
+262: n=421 sz=3 s=0 l=50 c=52 d='xy' sol=0:1729
+263: n=384 sz=2 s=0 l=50 c=54 d=')' sol=0:1729
+264: n=384 sz=2 s=0 l=50 c=12 d=')' sol=0:1729
+265: n=387 sz=2 s=0 l=50 c=12 d='*' sol=0:1729
+266: n=417 sz=5 s=0 l=50 c=12 d='12.0' sol=0:1729
+267: n=379 sz=2 s=0 l=50 c=12 d='+' sol=0:1729
+268: n=377 sz=2 s=0 l=50 c=12 d='(' sol=0:1729
+269: n=421 sz=8 s=0 l=50 c=57 d='uParams' sol=0:1729
+270: n=376 sz=2 s=0 l=50 c=64 d='[' sol=0:1729
+271: n=419 sz=2 s=0 l=50 c=65 d='6' sol=0:1729
+272: n=383 sz=2 s=0 l=50 c=66 d=']' sol=0:1729
+273: n=384 sz=2 s=0 l=50 c=12 d=')' sol=0:1729
+274: n=387 sz=2 s=0 l=50 c=12 d='*' sol=0:1729
+275: n=417 sz=4 s=0 l=50 c=12 d='4.4' sol=0:1729
+276: n=384 sz=2 s=0 l=50 c=12 d=')' sol=0:1729
+277: n=368 sz=2 s=0 l=50 c=8 d=',' sol=0:1729
+278: n=417 sz=4 s=0 l=50 c=8 d='0.0' sol=0:1729
+279: n=368 sz=2 s=0 l=50 c=8 d=',' sol=0:1729
+280: n=417 sz=4 s=0 l=50 c=8 d='1.0' sol=0:1729
+281: n=384 sz=2 s=0 l=50 c=8 d=')' sol=0:1729
+282: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+283: n=387 sz=2 s=0 l=50 c=70 d='*' sol=0:1729
+284: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+285: n=421 sz=4 s=0 l=50 c=72 d='dot' sol=0:1729
+286: n=377 sz=2 s=0 l=50 c=72 d='(' sol=0:1729
+287: n=421 sz=8 s=0 l=50 c=77 d='uParams' sol=0:1729
+288: n=376 sz=2 s=0 l=50 c=84 d='[' sol=0:1729
+289: n=419 sz=2 s=0 l=50 c=85 d='6' sol=0:1729
+290: n=383 sz=2 s=0 l=50 c=86 d=']' sol=0:1729
+291: n=371 sz=2 s=0 l=50 c=72 d='.' sol=0:1729
+292: n=421 sz=4 s=0 l=50 c=72 d='rgb' sol=0:1729
+293: n=368 sz=2 s=0 l=50 c=72 d=',' sol=0:1729
+294: n=421 sz=5 s=0 l=50 c=72 d='vec3' sol=0:1729
+295: n=377 sz=2 s=0 l=50 c=72 d='(' sol=0:1729
+296: n=417 sz=6 s=0 l=50 c=72 d='0.299' sol=0:1729
+297: n=368 sz=2 s=0 l=50 c=72 d=',' sol=0:1729
+298: n=417 sz=6 s=0 l=50 c=72 d='0.587' sol=0:1729
+299: n=368 sz=2 s=0 l=50 c=72 d=',' sol=0:1729
+300: n=417 sz=6 s=0 l=50 c=72 d='0.114' sol=0:1729
+301: n=384 sz=2 s=0 l=50 c=72 d=')' sol=0:1729
+302: n=384 sz=2 s=0 l=50 c=72 d=')' sol=0:1729
+303: n=385 sz=2 s=0 l=50 c=88 d=';' sol=0:1729
+304: n=424 sz=0 s=0 l=50 c=89 d='<null>' sol=0:1729
+305: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+306: n=421 sz=4 s=0 l=51 c=1 d='acc' sol=0:1819
+307: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+308: n=396 sz=3 s=0 l=51 c=5 d='+=' sol=0:1819
+309: n=426 sz=0 s=0 l=51 c=6 d='<null>' sol=0:1819
+310: n=421 sz=6 s=0 l=51 c=8 d='clamp' sol=0:1819
+311: n=377 sz=2 s=0 l=51 c=8 d='(' sol=0:1819
+312: n=377 sz=2 s=0 l=51 c=12 d='(' sol=0:1819
+313: n=377 sz=2 s=0 l=51 c=12 d='(' sol=0:1819
+314: n=421 sz=10 s=0 l=51 c=19 d='texture2D' sol=0:1819
+315: n=377 sz=2 s=0 l=51 c=28 d='(' sol=0:1819
+316: n=421 sz=5 s=0 l=51 c=29 d='uTex' sol=0:1819
+317: n=368 sz=2 s=0 l=51 c=33 d=',' sol=0:1819
+318: n=421 sz=4 s=0 l=51 c=35 d='vUV' sol=0:1819
+319: n=379 sz=2 s=0 l=51 c=39 d='+' sol=0:1819
+320: n=421 sz=8 s=0 l=51 c=41 d='uParams' sol=0:1819
+321: n=376 sz=2 s=0 l=51 c=48 d='[' sol=0:1819
+322: n=419 sz=2 s=0 l=51 c=49 d='4' sol=0:1819
+323: n=383 sz=2 s=0 l=51 c=50 d=']' sol=0:1819
+324: n=371 sz=2 s=0 l=51 c=51 d='.' sol=0:1819
+325: n=421 sz=3 s=0 l=51 c=52 d='xy' sol=0:1819
+326: n=384 sz=2 s=0 l=51 c=54 d=')' sol=0:1819
+327: n=384 sz=2 s=0 l=51 c=12 d=')' sol=0:1819
+328: n=387 sz=2 s=0 l=51 c=12 d='*' sol=0:1819
+329: n=417 sz=5 s=0 l=51 c=12 d='20.0' sol=0:1819
+330: n=379 sz=2 s=0 l=51 c=12 d='+' sol=0:1819
+331: n=377 sz=2 s=0 l=51 c=12 d='(' sol=0:1819
+332: n=421 sz=8 s=0 l=51 c=57 d='uParams' sol=0:1819
+333: n=376 sz=2 s=0 l=51 c=64 d='[' sol=0:1819
+334: n=419 sz=2 s=0 l=51 c=65 d='2' sol=0:1819
+335: n=383 sz=2 s=0 l=51 c=66 d=']' sol=0:1819
+336: n=384 sz=2 s=0 l=51 c=12 d=')' sol=0:1819
+337: n=387 sz=2 s=0 l=51 c=12 d='*' sol=0:1819
+338: n=417 sz=4 s=0 l=51 c=12 d='4.4' sol=0:1819
+339: n=384 sz=2 s=0 l=51 c=12 d=')' sol=0:1819
+340: n=368 sz=2 s=0 l=51 c=8 d=',' sol=0:1819
+341: n=417 sz=4 s=0 l=51 c=8 d='0.0' sol=0:1819
+342: n=368 sz=2 s=0 l=51 c=8 d=',' sol=0:1819
+343: n=417 sz=4 s=0 l=51 c=8 d='1.0' sol=0:1819
+344: n=384 sz=2 s=0 l=51 c=8 d=')' sol=0:1819
+345: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+346: n=387 sz=2 s=0 l=51 c=70 d='*' sol=0:1819
+347: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+348: n=421 sz=4 s=0 l=51 c=72 d='dot' sol=0:1819
+349: n=377 sz=2 s=0 l=51 c=72 d='(' sol=0:1819
+350: n=421 sz=8 s=0 l=51 c=77 d='uParams' sol=0:1819
+351: n=376 sz=2 s=0 l=51 c=84 d='[' sol=0:1819
+352: n=419 sz=2 s=0 l=51 c=85 d='7' sol=0:1819
+353: n=383 sz=2 s=0 l=51 c=86 d=']' sol=0:1819
+354: n=371 sz=2 s=0 l=51 c=72 d='.' sol=0:1819
+355: n=421 sz=4 s=0 l=51 c=72 d='rgb' sol=0:1819
+356: n=368 sz=2 s=0 l=51 c=72 d=',' sol=0:1819
+357: n=421 sz=5 s=0 l=51 c=72 d='vec3' sol=0:1819
+358: n=377 sz=2 s=0 l=51 c=72 d='(' sol=0:1819
+359: n=417 sz=6 s=0 l=51 c=72 d='0.299' sol=0:1819
+360: n=368 sz=2 s=0 l=51 c=72 d=',' sol=0:1819
+361: n=417 sz=6 s=0 l=51 c=72 d='0.587' sol=0:1819
+362: n=368 sz=2 s=0 l=51 c=72 d=',' sol=0:1819
+363: n=417 sz=6 s=0 l=51 c=72 d='0.114' sol=0:1819
+364: n=384 sz=2 s=0 l=51 c=72 d=')' sol=0:1819
+365: n=384 sz=2 s=0 l=51 c=72 d=')' sol=0:1819
+366: n=385 sz=2 s=0 l=51 c=88 d=';' sol=0:1819
+367: n=424 sz=0 s=0 l=51 c=89 d='<null>' sol=0:1819
+368: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+369: n=421 sz=4 s=0 l=52 c=1 d='acc' sol=0:1909
+370: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+371: n=396 sz=3 s=0 l=52 c=5 d='+=' sol=0:1909
+372: n=426 sz=0 s=0 l=52 c=6 d='<null>' sol=0:1909
+373: n=421 sz=6 s=0 l=52 c=8 d='clamp' sol=0:1909
+374: n=377 sz=2 s=0 l=52 c=8 d='(' sol=0:1909
+375: n=377 sz=2 s=0 l=52 c=12 d='(' sol=0:1909
+376: n=377 sz=2 s=0 l=52 c=12 d='(' sol=0:1909
+377: n=421 sz=10 s=0 l=52 c=18 d='texture2D' sol=0:1909
+378: n=377 sz=2 s=0 l=52 c=27 d='(' sol=0:1909
+379: n=421 sz=5 s=0 l=52 c=28 d='uTex' sol=0:1909
+380: n=368 sz=2 s=0 l=52 c=32 d=',' sol=0:1909
+381: n=421 sz=4 s=0 l=52 c=34 d='vUV' sol=0:1909
+382: n=379 sz=2 s=0 l=52 c=38 d='+' sol=0:1909
+383: n=421 sz=8 s=0 l=52 c=40 d='uParams' sol=0:1909
+384: n=376 sz=2 s=0 l=52 c=47 d='[' sol=0:1909
+385: n=419 sz=2 s=0 l=52 c=48 d='5' sol=0:1909
+386: n=383 sz=2 s=0 l=52 c=49 d=']' sol=0:1909
+387: n=371 sz=2 s=0 l=52 c=50 d='.' sol=0:1909
+388: n=421 sz=3 s=0 l=52 c=51 d='xy' sol=0:1909
+389: n=384 sz=2 s=0 l=52 c=53 d=')' sol=0:1909
+390: n=384 sz=2 s=0 l=52 c=12 d=')' sol=0:1909
+391: n=387 sz=2 s=0 l=52 c=12 d='*' sol=0:1909
+392: n=417 sz=4 s=0 l=52 c=12 d='2.0' sol=0:1909
+393: n=379 sz=2 s=0 l=52 c=12 d='+' sol=0:1909
+394: n=377 sz=2 s=0 l=52 c=12 d='(' sol=0:1909
+395: n=421 sz=8 s=0 l=52 c=56 d='uParams' sol=0:1909
+396: n=376 sz=2 s=0 l=52 c=63 d='[' sol=0:1909
+397: n=419 sz=2 s=0 l=52 c=64 d='7' sol=0:1909
+398: n=383 sz=2 s=0 l=52 c=65 d=']' sol=0:1909
+399: n=384 sz=2 s=0 l=52 c=12 d=')' sol=0:1909
+400: n=387 sz=2 s=0 l=52 c=12 d='*' sol=0:1909
+401: n=417 sz=4 s=0 l=52 c=12 d='2.2' sol=0:1909
+402: n=384 sz=2 s=0 l=52 c=12 d=')' sol=0:1909
+403: n=368 sz=2 s=0 l=52 c=8 d=',' sol=0:1909
+404: n=417 sz=4 s=0 l=52 c=8 d='0.0' sol=0:1909
+405: n=368 sz=2 s=0 l=52 c=8 d=',' sol=0:1909
+406: n=417 sz=4 s=0 l=52 c=8 d='1.0' sol=0:1909
+407: n=384 sz=2 s=0 l=52 c=8 d=')' sol=0:1909
+408: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+409: n=387 sz=2 s=0 l=52 c=69 d='*' sol=0:1909
+410: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+411: n=421 sz=4 s=0 l=52 c=71 d='dot' sol=0:1909
+412: n=377 sz=2 s=0 l=52 c=71 d='(' sol=0:1909
+413: n=421 sz=8 s=0 l=52 c=76 d='uParams' sol=0:1909
+414: n=376 sz=2 s=0 l=52 c=83 d='[' sol=0:1909
+415: n=419 sz=2 s=0 l=52 c=84 d='0' sol=0:1909
+416: n=383 sz=2 s=0 l=52 c=85 d=']' sol=0:1909
+417: n=371 sz=2 s=0 l=52 c=71 d='.' sol=0:1909
+418: n=421 sz=4 s=0 l=52 c=71 d='rgb' sol=0:1909
+419: n=368 sz=2 s=0 l=52 c=71 d=',' sol=0:1909
+420: n=421 sz=5 s=0 l=52 c=71 d='vec3' sol=0:1909
+421: n=377 sz=2 s=0 l=52 c=71 d='(' sol=0:1909
+422: n=417 sz=6 s=0 l=52 c=71 d='0.299' sol=0:1909
+423: n=368 sz=2 s=0 l=52 c=71 d=',' sol=0:1909
+424: n=417 sz=6 s=0 l=52 c=71 d='0.587' sol=0:1909
+425: n=368 sz=2 s=0 l=52 c=71 d=',' sol=0:1909
+426: n=417 sz=6 s=0 l=52 c=71 d='0.114' sol=0:1909
+427: n=384 sz=2 s=0 l=52 c=71 d=')' sol=0:1909
+428: n=384 sz=2 s=0 l=52 c=71 d=')' sol=0:1909
+429: n=385 sz=2 s=0 l=52 c=87 d=';' sol=0:1909
+430: n=424 sz=0 s=0 l=52 c=88 d='<null>' sol=0:1909
+431: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+432: n=421 sz=4 s=0 l=53 c=1 d='acc' sol=0:1998
+433: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+434: n=396 sz=3 s=0 l=53 c=5 d='+=' sol=0:1998
+435: n=426 sz=0 s=0 l=53 c=6 d='<null>' sol=0:1998
+436: n=421 sz=6 s=0 l=53 c=8 d='clamp' sol=0:1998
+437: n=377 sz=2 s=0 l=53 c=8 d='(' sol=0:1998
+438: n=377 sz=2 s=0 l=53 c=12 d='(' sol=0:1998
+439: n=377 sz=2 s=0 l=53 c=12 d='(' sol=0:1998
+440: n=421 sz=10 s=0 l=53 c=18 d='texture2D' sol=0:1998
+441: n=377 sz=2 s=0 l=53 c=27 d='(' sol=0:1998
+442: n=421 sz=5 s=0 l=53 c=28 d='uTex' sol=0:1998
+443: n=368 sz=2 s=0 l=53 c=32 d=',' sol=0:1998
+444: n=421 sz=4 s=0 l=53 c=34 d='vUV' sol=0:1998
+445: n=379 sz=2 s=0 l=53 c=38 d='+' sol=0:1998
+446: n=421 sz=8 s=0 l=53 c=40 d='uParams' sol=0:1998
+447: n=376 sz=2 s=0 l=53 c=47 d='[' sol=0:1998
+448: n=419 sz=2 s=0 l=53 c=48 d='6' sol=0:1998
+449: n=383 sz=2 s=0 l=53 c=49 d=']' sol=0:1998
+450: n=371 sz=2 s=0 l=53 c=50 d='.' sol=0:1998
+451: n=421 sz=3 s=0 l=53 c=51 d='xy' sol=0:1998
+452: n=384 sz=2 s=0 l=53 c=53 d=')' sol=0:1998
+453: n=384 sz=2 s=0 l=53 c=12 d=')' sol=0:1998
+454: n=387 sz=2 s=0 l=53 c=12 d='*' sol=0:1998
+455: n=417 sz=4 s=0 l=53 c=12 d='0.0' sol=0:1998
+456: n=379 sz=2 s=0 l=53 c=12 d='+' sol=0:1998
+457: n=377 sz=2 s=0 l=53 c=12 d='(' sol=0:1998
+458: n=421 sz=8 s=0 l=53 c=56 d='uParams' sol=0:1998
+459: n=376 sz=2 s=0 l=53 c=63 d='[' sol=0:1998
+460: n=419 sz=2 s=0 l=53 c=64 d='3' sol=0:1998
+461: n=383 sz=2 s=0 l=53 c=65 d=']' sol=0:1998
+462: n=384 sz=2 s=0 l=53 c=12 d=')' sol=0:1998
+463: n=387 sz=2 s=0 l=53 c=12 d='*' sol=0:1998
+464: n=417 sz=4 s=0 l=53 c=12 d='0.0' sol=0:1998
+465: n=384 sz=2 s=0 l=53 c=12 d=')' sol=0:1998
+466: n=368 sz=2 s=0 l=53 c=8 d=',' sol=0:1998
+467: n=417 sz=4 s=0 l=53 c=8 d='0.0' sol=0:1998
+468: n=368 sz=2 s=0 l=53 c=8 d=',' sol=0:1998
+469: n=417 sz=4 s=0 l=53 c=8 d='1.0' sol=0:1998
+470: n=384 sz=2 s=0 l=53 c=8 d=')' sol=0:1998
+471: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+472: n=387 sz=2 s=0 l=53 c=69 d='*' sol=0:1998
+473: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+474: n=421 sz=4 s=0 l=53 c=71 d='dot' sol=0:1998
+475: n=377 sz=2 s=0 l=53 c=71 d='(' sol=0:1998
+476: n=421 sz=8 s=0 l=53 c=76 d='uParams' sol=0:1998
+477: n=376 sz=2 s=0 l=53 c=83 d='[' sol=0:1998
+478: n=419 sz=2 s=0 l=53 c=84 d='1' sol=0:1998
+479: n=383 sz=2 s=0 l=53 c=85 d=']' sol=0:1998
+480: n=371 sz=2 s=0 l=53 c=71 d='.' sol=0:1998
+481: n=421 sz=4 s=0 l=53 c=71 d='rgb' sol=0:1998
+482: n=368 sz=2 s=0 l=53 c=71 d=',' sol=0:1998
+483: n=421 sz=5 s=0 l=53 c=71 d='vec3' sol=0:1998
+484: n=377 sz=2 s=0 l=53 c=71 d='(' sol=0:1998
+485: n=417 sz=6 s=0 l=53 c=71 d='0.299' sol=0:1998
+486: n=368 sz=2 s=0 l=53 c=71 d=',' sol=0:1998
+487: n=417 sz=6 s=0 l=53 c=71 d='0.587' sol=0:1998
+488: n=368 sz=2 s=0 l=53 c=71 d=',' sol=0:1998
+489: n=417 sz=6 s=0 l=53 c=71 d='0.114' sol=0:1998
+490: n=384 sz=2 s=0 l=53 c=71 d=')' sol=0:1998
+491: n=384 sz=2 s=0 l=53 c=71 d=')' sol=0:1998
+492: n=385 sz=2 s=0 l=53 c=87 d=';' sol=0:1998
+493: n=424 sz=0 s=0 l=53 c=88 d='<null>' sol=0:1998
+494: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+495: n=421 sz=4 s=0 l=54 c=1 d='acc' sol=0:2087
+496: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+497: n=396 sz=3 s=0 l=54 c=5 d='+=' sol=0:2087
+498: n=426 sz=0 s=0 l=54 c=6 d='<null>' sol=0:2087
+499: n=421 sz=6 s=0 l=54 c=8 d='clamp' sol=0:2087
+500: n=377 sz=2 s=0 l=54 c=8 d='(' sol=0:2087
+501: n=377 sz=2 s=0 l=54 c=12 d='(' sol=0:2087
+502: n=377 sz=2 s=0 l=54 c=12 d='(' sol=0:2087
+503: n=421 sz=10 s=0 l=54 c=18 d='texture2D' sol=0:2087
+504: n=377 sz=2 s=0 l=54 c=27 d='(' sol=0:2087
+505: n=421 sz=5 s=0 l=54 c=28 d='uTex' sol=0:2087
+506: n=368 sz=2 s=0 l=54 c=32 d=',' sol=0:2087
+507: n=421 sz=4 s=0 l=54 c=34 d='vUV' sol=0:2087
+508: n=379 sz=2 s=0 l=54 c=38 d='+' sol=0:2087
+509: n=421 sz=8 s=0 l=54 c=40 d='uParams' sol=0:2087
+510: n=376 sz=2 s=0 l=54 c=47 d='[' sol=0:2087
+511: n=419 sz=2 s=0 l=54 c=48 d='7' sol=0:2087
+512: n=383 sz=2 s=0 l=54 c=49 d=']' sol=0:2087
+513: n=371 sz=2 s=0 l=54 c=50 d='.' sol=0:2087
+514: n=421 sz=3 s=0 l=54 c=51 d='xy' sol=0:2087
+515: n=384 sz=2 s=0 l=54 c=53 d=')' sol=0:2087
+516: n=384 sz=2 s=0 l=54 c=12 d=')' sol=0:2087
+517: n=387 sz=2 s=0 l=54 c=12 d='*' sol=0:2087
+518: n=417 sz=4 s=0 l=54 c=12 d='0.0' sol=0:2087
+519: n=379 sz=2 s=0 l=54 c=12 d='+' sol=0:2087
+520: n=377 sz=2 s=0 l=54 c=12 d='(' sol=0:2087
+521: n=421 sz=8 s=0 l=54 c=56 d='uParams' sol=0:2087
+522: n=376 sz=2 s=0 l=54 c=63 d='[' sol=0:2087
+523: n=419 sz=2 s=0 l=54 c=64 d='1' sol=0:2087
+524: n=383 sz=2 s=0 l=54 c=65 d=']' sol=0:2087
+525: n=384 sz=2 s=0 l=54 c=12 d=')' sol=0:2087
+526: n=387 sz=2 s=0 l=54 c=12 d='*' sol=0:2087
+527: n=417 sz=4 s=0 l=54 c=12 d='0.0' sol=0:2087
+528: n=384 sz=2 s=0 l=54 c=12 d=')' sol=0:2087
+529: n=368 sz=2 s=0 l=54 c=8 d=',' sol=0:2087
+530: n=417 sz=4 s=0 l=54 c=8 d='0.0' sol=0:2087
+531: n=368 sz=2 s=0 l=54 c=8 d=',' sol=0:2087
+532: n=417 sz=4 s=0 l=54 c=8 d='1.0' sol=0:2087
+533: n=384 sz=2 s=0 l=54 c=8 d=')' sol=0:2087
+534: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+535: n=387 sz=2 s=0 l=54 c=69 d='*' sol=0:2087
+536: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+537: n=421 sz=4 s=0 l=54 c=71 d='dot' sol=0:2087
+538: n=377 sz=2 s=0 l=54 c=71 d='(' sol=0:2087
+539: n=421 sz=8 s=0 l=54 c=76 d='uParams' sol=0:2087
+540: n=376 sz=2 s=0 l=54 c=83 d='[' sol=0:2087
+541: n=419 sz=2 s=0 l=54 c=84 d='2' sol=0:2087
+542: n=383 sz=2 s=0 l=54 c=85 d=']' sol=0:2087
+543: n=371 sz=2 s=0 l=54 c=71 d='.' sol=0:2087
+544: n=421 sz=4 s=0 l=54 c=71 d='rgb' sol=0:2087
+545: n=368 sz=2 s=0 l=54 c=71 d=',' sol=0:2087
+546: n=421 sz=5 s=0 l=54 c=71 d='vec3' sol=0:2087
+547: n=377 sz=2 s=0 l=54 c=71 d='(' sol=0:2087
+548: n=417 sz=6 s=0 l=54 c=71 d='0.299' sol=0:2087
+549: n=368 sz=2 s=0 l=54 c=71 d=',' sol=0:2087
+550: n=417 sz=6 s=0 l=54 c=71 d='0.587' sol=0:2087
+551: n=368 sz=2 s=0 l=54 c=71 d=',' sol=0:2087
+552: n=417 sz=6 s=0 l=54 c=71 d='0.114' sol=0:2087
+553: n=384 sz=2 s=0 l=54 c=71 d=')' sol=0:2087
+554: n=384 sz=2 s=0 l=54 c=71 d=')' sol=0:2087
+555: n=385 sz=2 s=0 l=54 c=87 d=';' sol=0:2087
+556: n=424 sz=0 s=0 l=54 c=88 d='<null>' sol=0:2087
+557: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+558: n=421 sz=4 s=0 l=55 c=1 d='acc' sol=0:2176
+559: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+560: n=396 sz=3 s=0 l=55 c=5 d='+=' sol=0:2176
+561: n=426 sz=0 s=0 l=55 c=6 d='<null>' sol=0:2176
+562: n=421 sz=6 s=0 l=55 c=8 d='clamp' sol=0:2176
+563: n=377 sz=2 s=0 l=55 c=8 d='(' sol=0:2176
+564: n=377 sz=2 s=0 l=55 c=12 d='(' sol=0:2176
+565: n=377 sz=2 s=0 l=55 c=12 d='(' sol=0:2176
+566: n=421 sz=10 s=0 l=55 c=18 d='texture2D' sol=0:2176
+567: n=377 sz=2 s=0 l=55 c=27 d='(' sol=0:2176
+568: n=421 sz=5 s=0 l=55 c=28 d='uTex' sol=0:2176
+569: n=368 sz=2 s=0 l=55 c=32 d=',' sol=0:2176
+570: n=421 sz=4 s=0 l=55 c=34 d='vUV' sol=0:2176
+571: n=379 sz=2 s=0 l=55 c=38 d='+' sol=0:2176
+572: n=421 sz=8 s=0 l=55 c=40 d='uParams' sol=0:2176
+573: n=376 sz=2 s=0 l=55 c=47 d='[' sol=0:2176
+574: n=419 sz=2 s=0 l=55 c=48 d='0' sol=0:2176
+575: n=383 sz=2 s=0 l=55 c=49 d=']' sol=0:2176
+576: n=371 sz=2 s=0 l=55 c=50 d='.' sol=0:2176
+577: n=421 sz=3 s=0 l=55 c=51 d='xy' sol=0:2176
+578: n=384 sz=2 s=0 l=55 c=53 d=')' sol=0:2176
+579: n=384 sz=2 s=0 l=55 c=12 d=')' sol=0:2176
+580: n=387 sz=2 s=0 l=55 c=12 d='*' sol=0:2176
+581: n=417 sz=4 s=0 l=55 c=12 d='5.0' sol=0:2176
+582: n=379 sz=2 s=0 l=55 c=12 d='+' sol=0:2176
+583: n=377 sz=2 s=0 l=55 c=12 d='(' sol=0:2176
+584: n=421 sz=8 s=0 l=55 c=56 d='uParams' sol=0:2176
+585: n=376 sz=2 s=0 l=55 c=63 d='[' sol=0:2176
+586: n=419 sz=2 s=0 l=55 c=64 d='6' sol=0:2176
+587: n=383 sz=2 s=0 l=55 c=65 d=']' sol=0:2176
+588: n=384 sz=2 s=0 l=55 c=12 d=')' sol=0:2176
+589: n=387 sz=2 s=0 l=55 c=12 d='*' sol=0:2176
+590: n=417 sz=4 s=0 l=55 c=12 d='5.5' sol=0:2176
+591: n=384 sz=2 s=0 l=55 c=12 d=')' sol=0:2176
+592: n=368 sz=2 s=0 l=55 c=8 d=',' sol=0:2176
+593: n=417 sz=4 s=0 l=55 c=8 d='0.0' sol=0:2176
+594: n=368 sz=2 s=0 l=55 c=8 d=',' sol=0:2176
+595: n=417 sz=4 s=0 l=55 c=8 d='1.0' sol=0:2176
+596: n=384 sz=2 s=0 l=55 c=8 d=')' sol=0:2176
+597: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+598: n=387 sz=2 s=0 l=55 c=69 d='*' sol=0:2176
+599: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+600: n=421 sz=4 s=0 l=55 c=71 d='dot' sol=0:2176
+601: n=377 sz=2 s=0 l=55 c=71 d='(' sol=0:2176
+602: n=421 sz=8 s=0 l=55 c=76 d='uParams' sol=0:2176
+603: n=376 sz=2 s=0 l=55 c=83 d='[' sol=0:2176
+604: n=419 sz=2 s=0 l=55 c=84 d='3' sol=0:2176
+605: n=383 sz=2 s=0 l=55 c=85 d=']' sol=0:2176
+606: n=371 sz=2 s=0 l=55 c=71 d='.' sol=0:2176
+607: n=421 sz=4 s=0 l=55 c=71 d='rgb' sol=0:2176
+608: n=368 sz=2 s=0 l=55 c=71 d=',' sol=0:2176
+609: n=421 sz=5 s=0 l=55 c=71 d='vec3' sol=0:2176
+610: n=377 sz=2 s=0 l=55 c=71 d='(' sol=0:2176
+611: n=417 sz=6 s=0 l=55 c=71 d='0.299' sol=0:2176
+612: n=368 sz=2 s=0 l=55 c=71 d=',' sol=0:2176
+613: n=417 sz=6 s=0 l=55 c=71 d='0.587' sol=0:2176
+614: n=368 sz=2 s=0 l=55 c=71 d=',' sol=0:2176
+615: n=417 sz=6 s=0 l=55 c=71 d='0.114' sol=0:2176
+616: n=384 sz=2 s=0 l=55 c=71 d=')' sol=0:2176
+617: n=384 sz=2 s=0 l=55 c=71 d=')' sol=0:2176
+618: n=385 sz=2 s=0 l=55 c=87 d=';' sol=0:2176
+619: n=424 sz=0 s=0 l=55 c=88 d='<null>' sol=0:2176
+620: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+621: n=421 sz=4 s=0 l=56 c=1 d='acc' sol=0:2265
+622: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+623: n=396 sz=3 s=0 l=56 c=5 d='+=' sol=0:2265
+624: n=426 sz=0 s=0 l=56 c=6 d='<null>' sol=0:2265
+625: n=421 sz=6 s=0 l=56 c=8 d='clamp' sol=0:2265
+626: n=377 sz=2 s=0 l=56 c=8 d='(' sol=0:2265
+627: n=377 sz=2 s=0 l=56 c=12 d='(' sol=0:2265
+628: n=377 sz=2 s=0 l=56 c=12 d='(' sol=0:2265
+629: n=421 sz=10 s=0 l=56 c=19 d='texture2D' sol=0:2265
+630: n=377 sz=2 s=0 l=56 c=28 d='(' sol=0:2265
+631: n=421 sz=5 s=0 l=56 c=29 d='uTex' sol=0:2265
+632: n=368 sz=2 s=0 l=56 c=33 d=',' sol=0:2265
+633: n=421 sz=4 s=0 l=56 c=35 d='vUV' sol=0:2265
+634: n=379 sz=2 s=0 l=56 c=39 d='+' sol=0:2265
+635: n=421 sz=8 s=0 l=56 c=41 d='uParams' sol=0:2265
+636: n=376 sz=2 s=0 l=56 c=48 d='[' sol=0:2265
+637: n=419 sz=2 s=0 l=56 c=49 d='1' sol=0:2265
+638: n=383 sz=2 s=0 l=56 c=50 d=']' sol=0:2265
+639: n=371 sz=2 s=0 l=56 c=51 d='.' sol=0:2265
+640: n=421 sz=3 s=0 l=56 c=52 d='xy' sol=0:2265
+641: n=384 sz=2 s=0 l=56 c=54 d=')' sol=0:2265
+642: n=384 sz=2 s=0 l=56 c=12 d=')' sol=0:2265
+643: n=387 sz=2 s=0 l=56 c=12 d='*' sol=0:2265
+644: n=417 sz=5 s=0 l=56 c=12 d='20.0' sol=0:2265
+645: n=379 sz=2 s=0 l=56 c=12 d='+' sol=0:2265
+646: n=377 sz=2 s=0 l=56 c=12 d='(' sol=0:2265
+647: n=421 sz=8 s=0 l=56 c=57 d='uParams' sol=0:2265
+648: n=376 sz=2 s=0 l=56 c=64 d='[' sol=0:2265
+649: n=419 sz=2 s=0 l=56 c=65 d='5' sol=0:2265
+650: n=383 sz=2 s=0 l=56 c=66 d=']' sol=0:2265
+651: n=384 sz=2 s=0 l=56 c=12 d=')' sol=0:2265
+652: n=387 sz=2 s=0 l=56 c=12 d='*' sol=0:2265
+653: n=417 sz=4 s=0 l=56 c=12 d='4.4' sol=0:2265
+654: n=384 sz=2 s=0 l=56 c=12 d=')' sol=0:2265
+655: n=368 sz=2 s=0 l=56 c=8 d=',' sol=0:2265
+656: n=417 sz=4 s=0 l=56 c=8 d='0.0' sol=0:2265
+657: n=368 sz=2 s=0 l=56 c=8 d=',' sol=0:2265
+658: n=417 sz=4 s=0 l=56 c=8 d='1.0' sol=0:2265
+659: n=384 sz=2 s=0 l=56 c=8 d=')' sol=0:2265
+660: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+661: n=387 sz=2 s=0 l=56 c=70 d='*' sol=0:2265
+662: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+663: n=421 sz=4 s=0 l=56 c=72 d='dot' sol=0:2265
+664: n=377 sz=2 s=0 l=56 c=72 d='(' sol=0:2265
+665: n=421 sz=8 s=0 l=56 c=77 d='uParams' sol=0:2265
+666: n=376 sz=2 s=0 l=56 c=84 d='[' sol=0:2265
+667: n=419 sz=2 s=0 l=56 c=85 d='4' sol=0:2265
+668: n=383 sz=2 s=0 l=56 c=86 d=']' sol=0:2265
+669: n=371 sz=2 s=0 l=56 c=72 d='.' sol=0:2265
+670: n=421 sz=4 s=0 l=56 c=72 d='rgb' sol=0:2265
+671: n=368 sz=2 s=0 l=56 c=72 d=',' sol=0:2265
+672: n=421 sz=5 s=0 l=56 c=72 d='vec3' sol=0:2265
+673: n=377 sz=2 s=0 l=56 c=72 d='(' sol=0:2265
+674: n=417 sz=6 s=0 l=56 c=72 d='0.299' sol=0:2265
+675: n=368 sz=2 s=0 l=56 c=72 d=',' sol=0:2265
+676: n=417 sz=6 s=0 l=56 c=72 d='0.587' sol=0:2265
+677: n=368 sz=2 s=0 l=56 c=72 d=',' sol=0:2265
+678: n=417 sz=6 s=0 l=56 c=72 d='0.114' sol=0:2265
+679: n=384 sz=2 s=0 l=56 c=72 d=')' sol=0:2265
+680: n=384 sz=2 s=0 l=56 c=72 d=')' sol=0:2265
+681: n=385 sz=2 s=0 l=56 c=88 d=';' sol=0:2265
+682: n=424 sz=0 s=0 l=56 c=89 d='<null>' sol=0:2265
+683: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+684: n=421 sz=4 s=0 l=59 c=1 d='acc' sol=0:2395
+685: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+686: n=396 sz=3 s=0 l=59 c=5 d='+=' sol=0:2395
+687: n=426 sz=0 s=0 l=59 c=6 d='<null>' sol=0:2395
+688: n=421 sz=6 s=0 l=59 c=8 d='clamp' sol=0:2395
+689: n=377 sz=2 s=0 l=59 c=8 d='(' sol=0:2395
+690: n=377 sz=2 s=0 l=59 c=12 d='(' sol=0:2395
+691: n=377 sz=2 s=0 l=59 c=12 d='(' sol=0:2395
+692: n=421 sz=10 s=0 l=59 c=19 d='texture2D' sol=0:2395
+693: n=377 sz=2 s=0 l=59 c=28 d='(' sol=0:2395
+694: n=421 sz=5 s=0 l=59 c=29 d='uTex' sol=0:2395
+695: n=368 sz=2 s=0 l=59 c=33 d=',' sol=0:2395
+696: n=421 sz=4 s=0 l=59 c=35 d='vUV' sol=0:2395
+697: n=379 sz=2 s=0 l=59 c=39 d='+' sol=0:2395
+698: n=421 sz=8 s=0 l=59 c=41 d='uParams' sol=0:2395
+699: n=376 sz=2 s=0 l=59 c=48 d='[' sol=0:2395
+700: n=419 sz=2 s=0 l=59 c=49 d='2' sol=0:2395
+701: n=383 sz=2 s=0 l=59 c=50 d=']' sol=0:2395
+702: n=371 sz=2 s=0 l=59 c=51 d='.' sol=0:2395
+703: n=421 sz=3 s=0 l=59 c=52 d='xy' sol=0:2395
+704: n=384 sz=2 s=0 l=59 c=54 d=')' sol=0:2395
+705: n=384 sz=2 s=0 l=59 c=12 d=')' sol=0:2395
+706: n=387 sz=2 s=0 l=59 c=12 d='*' sol=0:2395
+707: n=417 sz=5 s=0 l=59 c=12 d='17.0' sol=0:2395
+708: n=379 sz=2 s=0 l=59 c=12 d='+' sol=0:2395
+709: n=377 sz=2 s=0 l=59 c=12 d='(' sol=0:2395
+710: n=421 sz=8 s=0 l=59 c=57 d='uParams' sol=0:2395
+711: n=376 sz=2 s=0 l=59 c=64 d='[' sol=0:2395
+712: n=419 sz=2 s=0 l=59 c=65 d='1' sol=0:2395
+713: n=383 sz=2 s=0 l=59 c=66 d=']' sol=0:2395
+714: n=384 sz=2 s=0 l=59 c=12 d=')' sol=0:2395
+715: n=387 sz=2 s=0 l=59 c=12 d='*' sol=0:2395
+716: n=417 sz=4 s=0 l=59 c=12 d='1.1' sol=0:2395
+717: n=384 sz=2 s=0 l=59 c=12 d=')' sol=0:2395
+718: n=368 sz=2 s=0 l=59 c=8 d=',' sol=0:2395
+719: n=417 sz=4 s=0 l=59 c=8 d='0.0' sol=0:2395
+720: n=368 sz=2 s=0 l=59 c=8 d=',' sol=0:2395
+721: n=417 sz=4 s=0 l=59 c=8 d='1.0' sol=0:2395
+722: n=384 sz=2 s=0 l=59 c=8 d=')' sol=0:2395
+723: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+724: n=387 sz=2 s=0 l=59 c=70 d='*' sol=0:2395
+725: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+726: n=421 sz=4 s=0 l=59 c=72 d='dot' sol=0:2395
+727: n=377 sz=2 s=0 l=59 c=72 d='(' sol=0:2395
+728: n=421 sz=8 s=0 l=59 c=77 d='uParams' sol=0:2395
+729: n=376 sz=2 s=0 l=59 c=84 d='[' sol=0:2395
+730: n=419 sz=2 s=0 l=59 c=85 d='5' sol=0:2395
+731: n=383 sz=2 s=0 l=59 c=86 d=']' sol=0:2395
+732: n=371 sz=2 s=0 l=59 c=72 d='.' sol=0:2395
+733: n=421 sz=4 s=0 l=59 c=72 d='rgb' sol=0:2395
+734: n=368 sz=2 s=0 l=59 c=72 d=',' sol=0:2395
+735: n=421 sz=5 s=0 l=59 c=72 d='vec3' sol=0:2395
+736: n=377 sz=2 s=0 l=59 c=72 d='(' sol=0:2395
+737: n=417 sz=6 s=0 l=59 c=72 d='0.299' sol=0:2395
+738: n=368 sz=2 s=0 l=59 c=72 d=',' sol=0:2395
+739: n=417 sz=6 s=0 l=59 c=72 d='0.587' sol=0:2395
+740: n=368 sz=2 s=0 l=59 c=72 d=',' sol=0:2395
+741: n=417 sz=6 s=0 l=59 c=72 d='0.114' sol=0:2395
+742: n=384 sz=2 s=0 l=59 c=72 d=')' sol=0:2395
+743: n=384 sz=2 s=0 l=59 c=72 d=')' sol=0:2395
+744: n=385 sz=2 s=0 l=59 c=88 d=';' sol=0:2395
+745: n=424 sz=0 s=0 l=59 c=89 d='<null>' sol=0:2395
+746: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+747: n=421 sz=4 s=0 l=60 c=1 d='acc' sol=0:2485
+748: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+749: n=396 sz=3 s=0 l=60 c=5 d='+=' sol=0:2485
+750: n=426 sz=0 s=0 l=60 c=6 d='<null>' sol=0:2485
+751: n=421 sz=6 s=0 l=60 c=8 d='clamp' sol=0:2485
+752: n=377 sz=2 s=0 l=60 c=8 d='(' sol=0:2485
+753: n=377 sz=2 s=0 l=60 c=12 d='(' sol=0:2485
+754: n=377 sz=2 s=0 l=60 c=12 d='(' sol=0:2485
+755: n=421 sz=10 s=0 l=60 c=18 d='texture2D' sol=0:2485
+756: n=377 sz=2 s=0 l=60 c=27 d='(' sol=0:2485
+757: n=421 sz=5 s=0 l=60 c=28 d='uTex' sol=0:2485
+758: n=368 sz=2 s=0 l=60 c=32 d=',' sol=0:2485
+759: n=421 sz=4 s=0 l=60 c=34 d='vUV' sol=0:2485
+760: n=379 sz=2 s=0 l=60 c=38 d='+' sol=0:2485
+761: n=421 sz=8 s=0 l=60 c=40 d='uParams' sol=0:2485
+762: n=376 sz=2 s=0 l=60 c=47 d='[' sol=0:2485
+763: n=419 sz=2 s=0 l=60 c=48 d='3' sol=0:2485
+764: n=383 sz=2 s=0 l=60 c=49 d=']' sol=0:2485
+765: n=371 sz=2 s=0 l=60 c=50 d='.' sol=0:2485
+766: n=421 sz=3 s=0 l=60 c=51 d='xy' sol=0:2485
+767: n=384 sz=2 s=0 l=60 c=53 d=')' sol=0:2485
+768: n=384 sz=2 s=0 l=60 c=12 d=')' sol=0:2485
+769: n=387 sz=2 s=0 l=60 c=12 d='*' sol=0:2485
+770: n=417 sz=4 s=0 l=60 c=12 d='7.0' sol=0:2485
+771: n=379 sz=2 s=0 l=60 c=12 d='+' sol=0:2485
+772: n=377 sz=2 s=0 l=60 c=12 d='(' sol=0:2485
+773: n=421 sz=8 s=0 l=60 c=56 d='uParams' sol=0:2485
+774: n=376 sz=2 s=0 l=60 c=63 d='[' sol=0:2485
+775: n=419 sz=2 s=0 l=60 c=64 d='4' sol=0:2485
+776: n=383 sz=2 s=0 l=60 c=65 d=']' sol=0:2485
+777: n=384 sz=2 s=0 l=60 c=12 d=')' sol=0:2485
+778: n=387 sz=2 s=0 l=60 c=12 d='*' sol=0:2485
+779: n=417 sz=4 s=0 l=60 c=12 d='7.7' sol=0:2485
+780: n=384 sz=2 s=0 l=60 c=12 d=')' sol=0:2485
+781: n=368 sz=2 s=0 l=60 c=8 d=',' sol=0:2485
+782: n=417 sz=4 s=0 l=60 c=8 d='0.0' sol=0:2485
+783: n=368 sz=2 s=0 l=60 c=8 d=',' sol=0:2485
+784: n=417 sz=4 s=0 l=60 c=8 d='1.0' sol=0:2485
+785: n=384 sz=2 s=0 l=60 c=8 d=')' sol=0:2485
+786: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+787: n=387 sz=2 s=0 l=60 c=69 d='*' sol=0:2485
+788: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+789: n=421 sz=4 s=0 l=60 c=71 d='dot' sol=0:2485
+790: n=377 sz=2 s=0 l=60 c=71 d='(' sol=0:2485
+791: n=421 sz=8 s=0 l=60 c=76 d='uParams' sol=0:2485
+792: n=376 sz=2 s=0 l=60 c=83 d='[' sol=0:2485
+793: n=419 sz=2 s=0 l=60 c=84 d='6' sol=0:2485
+794: n=383 sz=2 s=0 l=60 c=85 d=']' sol=0:2485
+795: n=371 sz=2 s=0 l=60 c=71 d='.' sol=0:2485
+796: n=421 sz=4 s=0 l=60 c=71 d='rgb' sol=0:2485
+797: n=368 sz=2 s=0 l=60 c=71 d=',' sol=0:2485
+798: n=421 sz=5 s=0 l=60 c=71 d='vec3' sol=0:2485
+799: n=377 sz=2 s=0 l=60 c=71 d='(' sol=0:2485
+800: n=417 sz=6 s=0 l=60 c=71 d='0.299' sol=0:2485
+801: n=368 sz=2 s=0 l=60 c=71 d=',' sol=0:2485
+802: n=417 sz=6 s=0 l=60 c=71 d='0.587' sol=0:2485
+803: n=368 sz=2 s=0 l=60 c=71 d=',' sol=0:2485
+804: n=417 sz=6 s=0 l=60 c=71 d='0.114' sol=0:2485
+805: n=384 sz=2 s=0 l=60 c=71 d=')' sol=0:2485
+806: n=384 sz=2 s=0 l=60 c=71 d=')' sol=0:2485
+807: n=385 sz=2 s=0 l=60 c=87 d=';' sol=0:2485
+808: n=424 sz=0 s=0 l=60 c=88 d='<null>' sol=0:2485
+809: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+810: n=421 sz=4 s=0 l=61 c=1 d='acc' sol=0:2574
+811: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+812: n=396 sz=3 s=0 l=61 c=5 d='+=' sol=0:2574
+813: n=426 sz=0 s=0 l=61 c=6 d='<null>' sol=0:2574
+814: n=421 sz=6 s=0 l=61 c=8 d='clamp' sol=0:2574
+815: n=377 sz=2 s=0 l=61 c=8 d='(' sol=0:2574
+816: n=377 sz=2 s=0 l=61 c=12 d='(' sol=0:2574
+817: n=377 sz=2 s=0 l=61 c=12 d='(' sol=0:2574
+818: n=421 sz=10 s=0 l=61 c=19 d='texture2D' sol=0:2574
+819: n=377 sz=2 s=0 l=61 c=28 d='(' sol=0:2574
+820: n=421 sz=5 s=0 l=61 c=29 d='uTex' sol=0:2574
+821: n=368 sz=2 s=0 l=61 c=33 d=',' sol=0:2574
+822: n=421 sz=4 s=0 l=61 c=35 d='vUV' sol=0:2574
+823: n=379 sz=2 s=0 l=61 c=39 d='+' sol=0:2574
+824: n=421 sz=8 s=0 l=61 c=41 d='uParams' sol=0:2574
+825: n=376 sz=2 s=0 l=61 c=48 d='[' sol=0:2574
+826: n=419 sz=2 s=0 l=61 c=49 d='4' sol=0:2574
+827: n=383 sz=2 s=0 l=61 c=50 d=']' sol=0:2574
+828: n=371 sz=2 s=0 l=61 c=51 d='.' sol=0:2574
+829: n=421 sz=3 s=0 l=61 c=52 d='xy' sol=0:2574
+830: n=384 sz=2 s=0 l=61 c=54 d=')' sol=0:2574
+831: n=384 sz=2 s=0 l=61 c=12 d=')' sol=0:2574
+832: n=387 sz=2 s=0 l=61 c=12 d='*' sol=0:2574
+833: n=417 sz=5 s=0 l=61 c=12 d='13.0' sol=0:2574
+834: n=379 sz=2 s=0 l=61 c=12 d='+' sol=0:2574
+835: n=377 sz=2 s=0 l=61 c=12 d='(' sol=0:2574
+836: n=421 sz=8 s=0 l=61 c=57 d='uParams' sol=0:2574
+837: n=376 sz=2 s=0 l=61 c=64 d='[' sol=0:2574
+838: n=419 sz=2 s=0 l=61 c=65 d='1' sol=0:2574
+839: n=383 sz=2 s=0 l=61 c=66 d=']' sol=0:2574
+840: n=384 sz=2 s=0 l=61 c=12 d=')' sol=0:2574
+841: n=387 sz=2 s=0 l=61 c=12 d='*' sol=0:2574
+842: n=417 sz=4 s=0 l=61 c=12 d='5.5' sol=0:2574
+843: n=384 sz=2 s=0 l=61 c=12 d=')' sol=0:2574
+844: n=368 sz=2 s=0 l=61 c=8 d=',' sol=0:2574
+845: n=417 sz=4 s=0 l=61 c=8 d='0.0' sol=0:2574
+846: n=368 sz=2 s=0 l=61 c=8 d=',' sol=0:2574
+847: n=417 sz=4 s=0 l=61 c=8 d='1.0' sol=0:2574
+848: n=384 sz=2 s=0 l=61 c=8 d=')' sol=0:2574
+849: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+850: n=387 sz=2 s=0 l=61 c=70 d='*' sol=0:2574
+851: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+852: n=421 sz=4 s=0 l=61 c=72 d='dot' sol=0:2574
+853: n=377 sz=2 s=0 l=61 c=72 d='(' sol=0:2574
+854: n=421 sz=8 s=0 l=61 c=77 d='uParams' sol=0:2574
+855: n=376 sz=2 s=0 l=61 c=84 d='[' sol=0:2574
+856: n=419 sz=2 s=0 l=61 c=85 d='7' sol=0:2574
+857: n=383 sz=2 s=0 l=61 c=86 d=']' sol=0:2574
+858: n=371 sz=2 s=0 l=61 c=72 d='.' sol=0:2574
+859: n=421 sz=4 s=0 l=61 c=72 d='rgb' sol=0:2574
+860: n=368 sz=2 s=0 l=61 c=72 d=',' sol=0:2574
+861: n=421 sz=5 s=0 l=61 c=72 d='vec3' sol=0:2574
+862: n=377 sz=2 s=0 l=61 c=72 d='(' sol=0:2574
+863: n=417 sz=6 s=0 l=61 c=72 d='0.299' sol=0:2574
+864: n=368 sz=2 s=0 l=61 c=72 d=',' sol=0:2574
+865: n=417 sz=6 s=0 l=61 c=72 d='0.587' sol=0:2574
+866: n=368 sz=2 s=0 l=61 c=72 d=',' sol=0:2574
+867: n=417 sz=6 s=0 l=61 c=72 d='0.114' sol=0:2574
+868: n=384 sz=2 s=0 l=61 c=72 d=')' sol=0:2574
+869: n=384 sz=2 s=0 l=61 c=72 d=')' sol=0:2574
+870: n=385 sz=2 s=0 l=61 c=88 d=';' sol=0:2574
+871: n=424 sz=0 s=0 l=61 c=89 d='<null>' sol=0:2574
+872: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+873: n=421 sz=4 s=0 l=62 c=1 d='acc' sol=0:2664
+874: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+875: n=396 sz=3 s=0 l=62 c=5 d='+=' sol=0:2664
+876: n=426 sz=0 s=0 l=62 c=6 d='<null>' sol=0:2664
+877: n=421 sz=6 s=0 l=62 c=8 d='clamp' sol=0:2664
+878: n=377 sz=2 s=0 l=62 c=8 d='(' sol=0:2664
+879: n=377 sz=2 s=0 l=62 c=12 d='(' sol=0:2664
+880: n=377 sz=2 s=0 l=62 c=12 d='(' sol=0:2664
+881: n=421 sz=10 s=0 l=62 c=19 d='texture2D' sol=0:2664
+882: n=377 sz=2 s=0 l=62 c=28 d='(' sol=0:2664
+883: n=421 sz=5 s=0 l=62 c=29 d='uTex' sol=0:2664
+884: n=368 sz=2 s=0 l=62 c=33 d=',' sol=0:2664
+885: n=421 sz=4 s=0 l=62 c=35 d='vUV' sol=0:2664
+886: n=379 sz=2 s=0 l=62 c=39 d='+' sol=0:2664
+887: n=421 sz=8 s=0 l=62 c=41 d='uParams' sol=0:2664
+888: n=376 sz=2 s=0 l=62 c=48 d='[' sol=0:2664
+889: n=419 sz=2 s=0 l=62 c=49 d='5' sol=0:2664
+890: n=383 sz=2 s=0 l=62 c=50 d=']' sol=0:2664
+891: n=371 sz=2 s=0 l=62 c=51 d='.' sol=0:2664
+892: n=421 sz=3 s=0 l=62 c=52 d='xy' sol=0:2664
+893: n=384 sz=2 s=0 l=62 c=54 d=')' sol=0:2664
+894: n=384 sz=2 s=0 l=62 c=12 d=')' sol=0:2664
+895: n=387 sz=2 s=0 l=62 c=12 d='*' sol=0:2664
+896: n=417 sz=5 s=0 l=62 c=12 d='21.0' sol=0:2664
+897: n=379 sz=2 s=0 l=62 c=12 d='+' sol=0:2664
+898: n=377 sz=2 s=0 l=62 c=12 d='(' sol=0:2664
+899: n=421 sz=8 s=0 l=62 c=57 d='uParams' sol=0:2664
+900: n=376 sz=2 s=0 l=62 c=64 d='[' sol=0:2664
+901: n=419 sz=2 s=0 l=62 c=65 d='4' sol=0:2664
+902: n=383 sz=2 s=0 l=62 c=66 d=']' sol=0:2664
+903: n=384 sz=2 s=0 l=62 c=12 d=')' sol=0:2664
+904: n=387 sz=2 s=0 l=62 c=12 d='*' sol=0:2664
+905: n=417 sz=4 s=0 l=62 c=12 d='5.5' sol=0:2664
+906: n=384 sz=2 s=0 l=62 c=12 d=')' sol=0:2664
+907: n=368 sz=2 s=0 l=62 c=8 d=',' sol=0:2664
+908: n=417 sz=4 s=0 l=62 c=8 d='0.0' sol=0:2664
+909: n=368 sz=2 s=0 l=62 c=8 d=',' sol=0:2664
+910: n=417 sz=4 s=0 l=62 c=8 d='1.0' sol=0:2664
+911: n=384 sz=2 s=0 l=62 c=8 d=')' sol=0:2664
+912: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+913: n=387 sz=2 s=0 l=62 c=70 d='*' sol=0:2664
+914: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+915: n=421 sz=4 s=0 l=62 c=72 d='dot' sol=0:2664
+916: n=377 sz=2 s=0 l=62 c=72 d='(' sol=0:2664
+917: n=421 sz=8 s=0 l=62 c=77 d='uParams' sol=0:2664
+918: n=376 sz=2 s=0 l=62 c=84 d='[' sol=0:2664
+919: n=419 sz=2 s=0 l=62 c=85 d='0' sol=0:2664
+920: n=383 sz=2 s=0 l=62 c=86 d=']' sol=0:2664
+921: n=371 sz=2 s=0 l=62 c=72 d='.' sol=0:2664
+922: n=421 sz=4 s=0 l=62 c=72 d='rgb' sol=0:2664
+923: n=368 sz=2 s=0 l=62 c=72 d=',' sol=0:2664
+924: n=421 sz=5 s=0 l=62 c=72 d='vec3' sol=0:2664
+925: n=377 sz=2 s=0 l=62 c=72 d='(' sol=0:2664
+926: n=417 sz=6 s=0 l=62 c=72 d='0.299' sol=0:2664
+927: n=368 sz=2 s=0 l=62 c=72 d=',' sol=0:2664
+928: n=417 sz=6 s=0 l=62 c=72 d='0.587' sol=0:2664
+929: n=368 sz=2 s=0 l=62 c=72 d=',' sol=0:2664
+930: n=417 sz=6 s=0 l=62 c=72 d='0.114' sol=0:2664
+931: n=384 sz=2 s=0 l=62 c=72 d=')' sol=0:2664
+932: n=384 sz=2 s=0 l=62 c=72 d=')' sol=0:2664
+933: n=385 sz=2 s=0 l=62 c=88 d=';' sol=0:2664
+934: n=424 sz=0 s=0 l=62 c=89 d='<null>' sol=0:2664
+935: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+936: n=421 sz=4 s=0 l=63 c=1 d='acc' sol=0:2754
+937: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+938: n=396 sz=3 s=0 l=63 c=5 d='+=' sol=0:2754
+939: n=426 sz=0 s=0 l=63 c=6 d='<null>' sol=0:2754
+940: n=421 sz=6 s=0 l=63 c=8 d='clamp' sol=0:2754
+941: n=377 sz=2 s=0 l=63 c=8 d='(' sol=0:2754
+942: n=377 sz=2 s=0 l=63 c=12 d='(' sol=0:2754
+943: n=377 sz=2 s=0 l=63 c=12 d='(' sol=0:2754
+944: n=421 sz=10 s=0 l=63 c=19 d='texture2D' sol=0:2754
+945: n=377 sz=2 s=0 l=63 c=28 d='(' sol=0:2754
+946: n=421 sz=5 s=0 l=63 c=29 d='uTex' sol=0:2754
+947: n=368 sz=2 s=0 l=63 c=33 d=',' sol=0:2754
+948: n=421 sz=4 s=0 l=63 c=35 d='vUV' sol=0:2754
+949: n=379 sz=2 s=0 l=63 c=39 d='+' sol=0:2754
+950: n=421 sz=8 s=0 l=63 c=41 d='uParams' sol=0:2754
+951: n=376 sz=2 s=0 l=63 c=48 d='[' sol=0:2754
+952: n=419 sz=2 s=0 l=63 c=49 d='6' sol=0:2754
+953: n=383 sz=2 s=0 l=63 c=50 d=']' sol=0:2754
+954: n=371 sz=2 s=0 l=63 c=51 d='.' sol=0:2754
+955: n=421 sz=3 s=0 l=63 c=52 d='xy' sol=0:2754
+956: n=384 sz=2 s=0 l=63 c=54 d=')' sol=0:2754
+957: n=384 sz=2 s=0 l=63 c=12 d=')' sol=0:2754
+958: n=387 sz=2 s=0 l=63 c=12 d='*' sol=0:2754
+959: n=417 sz=5 s=0 l=63 c=12 d='20.0' sol=0:2754
+960: n=379 sz=2 s=0 l=63 c=12 d='+' sol=0:2754
+961: n=377 sz=2 s=0 l=63 c=12 d='(' sol=0:2754
+962: n=421 sz=8 s=0 l=63 c=57 d='uParams' sol=0:2754
+963: n=376 sz=2 s=0 l=63 c=64 d='[' sol=0:2754
+964: n=419 sz=2 s=0 l=63 c=65 d='1' sol=0:2754
+965: n=383 sz=2 s=0 l=63 c=66 d=']' sol=0:2754
+966: n=384 sz=2 s=0 l=63 c=12 d=')' sol=0:2754
+967: n=387 sz=2 s=0 l=63 c=12 d='*' sol=0:2754
+968: n=417 sz=4 s=0 l=63 c=12 d='4.4' sol=0:2754
+969: n=384 sz=2 s=0 l=63 c=12 d=')' sol=0:2754
+970: n=368 sz=2 s=0 l=63 c=8 d=',' sol=0:2754
+971: n=417 sz=4 s=0 l=63 c=8 d='0.0' sol=0:2754
+972: n=368 sz=2 s=0 l=63 c=8 d=',' sol=0:2754
+973: n=417 sz=4 s=0 l=63 c=8 d='1.0' sol=0:2754
+974: n=384 sz=2 s=0 l=63 c=8 d=')' sol=0:2754
+975: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+976: n=387 sz=2 s=0 l=63 c=70 d='*' sol=0:2754
+977: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+978: n=421 sz=4 s=0 l=63 c=72 d='dot' sol=0:2754
+979: n=377 sz=2 s=0 l=63 c=72 d='(' sol=0:2754
+980: n=421 sz=8 s=0 l=63 c=77 d='uParams' sol=0:2754
+981: n=376 sz=2 s=0 l=63 c=84 d='[' sol=0:2754
+982: n=419 sz=2 s=0 l=63 c=85 d='1' sol=0:2754
+983: n=383 sz=2 s=0 l=63 c=86 d=']' sol=0:2754
+984: n=371 sz=2 s=0 l=63 c=72 d='.' sol=0:2754
+985: n=421 sz=4 s=0 l=63 c=72 d='rgb' sol=0:2754
+986: n=368 sz=2 s=0 l=63 c=72 d=',' sol=0:2754
+987: n=421 sz=5 s=0 l=63 c=72 d='vec3' sol=0:2754
+988: n=377 sz=2 s=0 l=63 c=72 d='(' sol=0:2754
+989: n=417 sz=6 s=0 l=63 c=72 d='0.299' sol=0:2754
+990: n=368 sz=2 s=0 l=63 c=72 d=',' sol=0:2754
+991: n=417 sz=6 s=0 l=63 c=72 d='0.587' sol=0:2754
+992: n=368 sz=2 s=0 l=63 c=72 d=',' sol=0:2754
+993: n=417 sz=6 s=0 l=63 c=72 d='0.114' sol=0:2754
+994: n=384 sz=2 s=0 l=63 c=72 d=')' sol=0:2754
+995: n=384 sz=2 s=0 l=63 c=72 d=')' sol=0:2754
+996: n=385 sz=2 s=0 l=63 c=88 d=';' sol=0:2754
+997: n=424 sz=0 s=0 l=63 c=89 d='<null>' sol=0:2754
+998: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+999: n=421 sz=4 s=0 l=64 c=1 d='acc' sol=0:2844
+1000: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+1001: n=396 sz=3 s=0 l=64 c=5 d='+=' sol=0:2844
+1002: n=426 sz=0 s=0 l=64 c=6 d='<null>' sol=0:2844
+1003: n=421 sz=6 s=0 l=64 c=8 d='clamp' sol=0:2844
+1004: n=377 sz=2 s=0 l=64 c=8 d='(' sol=0:2844
+1005: n=377 sz=2 s=0 l=64 c=12 d='(' sol=0:2844
+1006: n=377 sz=2 s=0 l=64 c=12 d='(' sol=0:2844
+1007: n=421 sz=10 s=0 l=64 c=19 d='texture2D' sol=0:2844
+1008: n=377 sz=2 s=0 l=64 c=28 d='(' sol=0:2844
+1009: n=421 sz=5 s=0 l=64 c=29 d='uTex' sol=0:2844
+1010: n=368 sz=2 s=0 l=64 c=33 d=',' sol=0:2844
+1011: n=421 sz=4 s=0 l=64 c=35 d='vUV' sol=0:2844
+1012: n=379 sz=2 s=0 l=64 c=39 d='+' sol=0:2844
+1013: n=421 sz=8 s=0 l=64 c=41 d='uParams' sol=0:2844
+1014: n=376 sz=2 s=0 l=64 c=48 d='[' sol=0:2844
+1015: n=419 sz=2 s=0 l=64 c=49 d='7' sol=0:2844
+1016: n=383 sz=2 s=0 l=64 c=50 d=']' sol=0:2844
+1017: n=371 sz=2 s=0 l=64 c=51 d='.' sol=0:2844
+1018: n=421 sz=3 s=0 l=64 c=52 d='xy' sol=0:2844
+1019: n=384 sz=2 s=0 l=64 c=54 d=')' sol=0:2844
+1020: n=384 sz=2 s=0 l=64 c=12 d=')' sol=0:2844
+1021: n=387 sz=2 s=0 l=64 c=12 d='*' sol=0:2844
+1022: n=417 sz=5 s=0 l=64 c=12 d='19.0' sol=0:2844
+1023: n=379 sz=2 s=0 l=64 c=12 d='+' sol=0:2844
+1024: n=377 sz=2 s=0 l=64 c=12 d='(' sol=0:2844
+1025: n=421 sz=8 s=0 l=64 c=57 d='uParams' sol=0:2844
+1026: n=376 sz=2 s=0 l=64 c=64 d='[' sol=0:2844
+1027: n=419 sz=2 s=0 l=64 c=65 d='7' sol=0:2844
+1028: n=383 sz=2 s=0 l=64 c=66 d=']' sol=0:2844
+1029: n=384 sz=2 s=0 l=64 c=12 d=')' sol=0:2844
+1030: n=387 sz=2 s=0 l=64 c=12 d='*' sol=0:2844
+1031: n=417 sz=4 s=0 l=64 c=12 d='3.3' sol=0:2844
+1032: n=384 sz=2 s=0 l=64 c=12 d=')' sol=0:2844
+1033: n=368 sz=2 s=0 l=64 c=8 d=',' sol=0:2844
+1034: n=417 sz=4 s=0 l=64 c=8 d='0.0' sol=0:2844
+1035: n=368 sz=2 s=0 l=64 c=8 d=',' sol=0:2844
+1036: n=417 sz=4 s=0 l=64 c=8 d='1.0' sol=0:2844
+1037: n=384 sz=2 s=0 l=64 c=8 d=')' sol=0:2844
+1038: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+1039: n=387 sz=2 s=0 l=64 c=70 d='*' sol=0:2844
+1040: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+1041: n=421 sz=4 s=0 l=64 c=72 d='dot' sol=0:2844
+1042: n=377 sz=2 s=0 l=64 c=72 d='(' sol=0:2844
+1043: n=421 sz=8 s=0 l=64 c=77 d='uParams' sol=0:2844
+1044: n=376 sz=2 s=0 l=64 c=84 d='[' sol=0:2844
+1045: n=419 sz=2 s=0 l=64 c=85 d='2' sol=0:2844
+1046: n=383 sz=2 s=0 l=64 c=86 d=']' sol=0:2844
+1047: n=371 sz=2 s=0 l=64 c=72 d='.' sol=0:2844
+1048: n=421 sz=4 s=0 l=64 c=72 d='rgb' sol=0:2844
+1049: n=368 sz=2 s=0 l=64 c=72 d=',' sol=0:2844
+1050: n=421 sz=5 s=0 l=64 c=72 d='vec3' sol=0:2844
+1051: n=377 sz=2 s=0 l=64 c=72 d='(' sol=0:2844
+1052: n=417 sz=6 s=0 l=64 c=72 d='0.299' sol=0:2844
+1053: n=368 sz=2 s=0 l=64 c=72 d=',' sol=0:2844
+1054: n=417 sz=6 s=0 l=64 c=72 d='0.587' sol=0:2844
+1055: n=368 sz=2 s=0 l=64 c=72 d=',' sol=0:2844
+1056: n=417 sz=6 s=0 l=64 c=72 d='0.114' sol=0:2844
+1057: n=384 sz=2 s=0 l=64 c=72 d=')' sol=0:2844
+1058: n=384 sz=2 s=0 l=64 c=72 d=')' sol=0:2844
+1059: n=385 sz=2 s=0 l=64 c=88 d=';' sol=0:2844
+1060: n=424 sz=0 s=0 l=64 c=89 d='<null>' sol=0:2844
+1061: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+1062: n=421 sz=4 s=0 l=65 c=1 d='acc' sol=0:2934
+1063: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+1064: n=396 sz=3 s=0 l=65 c=5 d='+=' sol=0:2934
+1065: n=426 sz=0 s=0 l=65 c=6 d='<null>' sol=0:2934
+1066: n=421 sz=6 s=0 l=65 c=8 d='clamp' sol=0:2934
+1067: n=377 sz=2 s=0 l=65 c=8 d='(' sol=0:2934
+1068: n=377 sz=2 s=0 l=65 c=12 d='(' sol=0:2934
+1069: n=377 sz=2 s=0 l=65 c=12 d='(' sol=0:2934
+1070: n=421 sz=10 s=0 l=65 c=18 d='texture2D' sol=0:2934
+1071: n=377 sz=2 s=0 l=65 c=27 d='(' sol=0:2934
+1072: n=421 sz=5 s=0 l=65 c=28 d='uTex' sol=0:2934
+1073: n=368 sz=2 s=0 l=65 c=32 d=',' sol=0:2934
+1074: n=421 sz=4 s=0 l=65 c=34 d='vUV' sol=0:2934
+1075: n=379 sz=2 s=0 l=65 c=38 d='+' sol=0:2934
+1076: n=421 sz=8 s=0 l=65 c=40 d='uParams' sol=0:2934
+1077: n=376 sz=2 s=0 l=65 c=47 d='[' sol=0:2934
+1078: n=419 sz=2 s=0 l=65 c=48 d='0' sol=0:2934
+1079: n=383 sz=2 s=0 l=65 c=49 d=']' sol=0:2934
+1080: n=371 sz=2 s=0 l=65 c=50 d='.' sol=0:2934
+1081: n=421 sz=3 s=0 l=65 c=51 d='xy' sol=0:2934
+1082: n=384 sz=2 s=0 l=65 c=53 d=')' sol=0:2934
+1083: n=384 sz=2 s=0 l=65 c=12 d=')' sol=0:2934
+1084: n=387 sz=2 s=0 l=65 c=12 d='*' sol=0:2934
+1085: n=417 sz=4 s=0 l=65 c=12 d='9.0' sol=0:2934
+1086: n=379 sz=2 s=0 l=65 c=12 d='+' sol=0:2934
+1087: n=377 sz=2 s=0 l=65 c=12 d='(' sol=0:2934
+1088: n=421 sz=8 s=0 l=65 c=56 d='uParams' sol=0:2934
+1089: n=376 sz=2 s=0 l=65 c=63 d='[' sol=0:2934
+1090: n=419 sz=2 s=0 l=65 c=64 d='2' sol=0:2934
+1091: n=383 sz=2 s=0 l=65 c=65 d=']' sol=0:2934
+1092: n=384 sz=2 s=0 l=65 c=12 d=')' sol=0:2934
+1093: n=387 sz=2 s=0 l=65 c=12 d='*' sol=0:2934
+1094: n=417 sz=4 s=0 l=65 c=12 d='1.1' sol=0:2934
+1095: n=384 sz=2 s=0 l=65 c=12 d=')' sol=0:2934
+1096: n=368 sz=2 s=0 l=65 c=8 d=',' sol=0:2934
+1097: n=417 sz=4 s=0 l=65 c=8 d='0.0' sol=0:2934
+1098: n=368 sz=2 s=0 l=65 c=8 d=',' sol=0:2934
+1099: n=417 sz=4 s=0 l=65 c=8 d='1.0' sol=0:2934
+1100: n=384 sz=2 s=0 l=65 c=8 d=')' sol=0:2934
+1101: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+1102: n=387 sz=2 s=0 l=65 c=69 d='*' sol=0:2934
+1103: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+1104: n=421 sz=4 s=0 l=65 c=71 d='dot' sol=0:2934
+1105: n=377 sz=2 s=0 l=65 c=71 d='(' sol=0:2934
+1106: n=421 sz=8 s=0 l=65 c=76 d='uParams' sol=0:2934
+1107: n=376 sz=2 s=0 l=65 c=83 d='[' sol=0:2934
+1108: n=419 sz=2 s=0 l=65 c=84 d='3' sol=0:2934
+1109: n=383 sz=2 s=0 l=65 c=85 d=']' sol=0:2934
+1110: n=371 sz=2 s=0 l=65 c=71 d='.' sol=0:2934
+1111: n=421 sz=4 s=0 l=65 c=71 d='rgb' sol=0:2934
+1112: n=368 sz=2 s=0 l=65 c=71 d=',' sol=0:2934
+1113: n=421 sz=5 s=0 l=65 c=71 d='vec3' sol=0:2934
+1114: n=377 sz=2 s=0 l=65 c=71 d='(' sol=0:2934
+1115: n=417 sz=6 s=0 l=65 c=71 d='0.299' sol=0:2934
+1116: n=368 sz=2 s=0 l=65 c=71 d=',' sol=0:2934
+1117: n=417 sz=6 s=0 l=65 c=71 d='0.587' sol=0:2934
+1118: n=368 sz=2 s=0 l=65 c=71 d=',' sol=0:2934
+1119: n=417 sz=6 s=0 l=65 c=71 d='0.114' sol=0:2934
+1120: n=384 sz=2 s=0 l=65 c=71 d=')' sol=0:2934
+1121: n=384 sz=2 s=0 l=65 c=71 d=')' sol=0:2934
+1122: n=385 sz=2 s=0 l=65 c=87 d=';' sol=0:2934
+1123: n=424 sz=0 s=0 l=65 c=88 d='<null>' sol=0:2934
+1124: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+1125: n=421 sz=4 s=0 l=66 c=1 d='acc' sol=0:3023
+1126: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+1127: n=396 sz=3 s=0 l=66 c=5 d='+=' sol=0:3023
+1128: n=426 sz=0 s=0 l=66 c=6 d='<null>' sol=0:3023
+1129: n=421 sz=6 s=0 l=66 c=8 d='clamp' sol=0:3023
+1130: n=377 sz=2 s=0 l=66 c=8 d='(' sol=0:3023
+1131: n=377 sz=2 s=0 l=66 c=12 d='(' sol=0:3023
+1132: n=377 sz=2 s=0 l=66 c=12 d='(' sol=0:3023
+1133: n=421 sz=10 s=0 l=66 c=18 d='texture2D' sol=0:3023
+1134: n=377 sz=2 s=0 l=66 c=27 d='(' sol=0:3023
+1135: n=421 sz=5 s=0 l=66 c=28 d='uTex' sol=0:3023
+1136: n=368 sz=2 s=0 l=66 c=32 d=',' sol=0:3023
+1137: n=421 sz=4 s=0 l=66 c=34 d='vUV' sol=0:3023
+1138: n=379 sz=2 s=0 l=66 c=38 d='+' sol=0:3023
+1139: n=421 sz=8 s=0 l=66 c=40 d='uParams' sol=0:3023
+1140: n=376 sz=2 s=0 l=66 c=47 d='[' sol=0:3023
+1141: n=419 sz=2 s=0 l=66 c=48 d='1' sol=0:3023
+1142: n=383 sz=2 s=0 l=66 c=49 d=']' sol=0:3023
+1143: n=371 sz=2 s=0 l=66 c=50 d='.' sol=0:3023
+1144: n=421 sz=3 s=0 l=66 c=51 d='xy' sol=0:3023
+1145: n=384 sz=2 s=0 l=66 c=53 d=')' sol=0:3023
+1146: n=384 sz=2 s=0 l=66 c=12 d=')' sol=0:3023
+1147: n=387 sz=2 s=0 l=66 c=12 d='*' sol=0:3023
+1148: n=417 sz=4 s=0 l=66 c=12 d='9.0' sol=0:3023
+1149: n=379 sz=2 s=0 l=66 c=12 d='+' sol=0:3023
+1150: n=377 sz=2 s=0 l=66 c=12 d='(' sol=0:3023
+1151: n=421 sz=8 s=0 l=66 c=56 d='uParams' sol=0:3023
+1152: n=376 sz=2 s=0 l=66 c=63 d='[' sol=0:3023
+1153: n=419 sz=2 s=0 l=66 c=64 d='4' sol=0:3023
+1154: n=383 sz=2 s=0 l=66 c=65 d=']' sol=0:3023
+1155: n=384 sz=2 s=0 l=66 c=12 d=')' sol=0:3023
+1156: n=387 sz=2 s=0 l=66 c=12 d='*' sol=0:3023
+1157: n=417 sz=4 s=0 l=66 c=12 d='1.1' sol=0:3023
+1158: n=384 sz=2 s=0 l=66 c=12 d=')' sol=0:3023
+1159: n=368 sz=2 s=0 l=66 c=8 d=',' sol=0:3023
+1160: n=417 sz=4 s=0 l=66 c=8 d='0.0' sol=0:3023
+1161: n=368 sz=2 s=0 l=66 c=8 d=',' sol=0:3023
+1162: n=417 sz=4 s=0 l=66 c=8 d='1.0' sol=0:3023
+1163: n=384 sz=2 s=0 l=66 c=8 d=')' sol=0:3023
+1164: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+1165: n=387 sz=2 s=0 l=66 c=69 d='*' sol=0:3023
+1166: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+1167: n=421 sz=4 s=0 l=66 c=71 d='dot' sol=0:3023
+1168: n=377 sz=2 s=0 l=66 c=71 d='(' sol=0:3023
+1169: n=421 sz=8 s=0 l=66 c=76 d='uParams' sol=0:3023
+1170: n=376 sz=2 s=0 l=66 c=83 d='[' sol=0:3023
+1171: n=419 sz=2 s=0 l=66 c=84 d='4' sol=0:3023
+1172: n=383 sz=2 s=0 l=66 c=85 d=']' sol=0:3023
+1173: n=371 sz=2 s=0 l=66 c=71 d='.' sol=0:3023
+1174: n=421 sz=4 s=0 l=66 c=71 d='rgb' sol=0:3023
+1175: n=368 sz=2 s=0 l=66 c=71 d=',' sol=0:3023
+1176: n=421 sz=5 s=0 l=66 c=71 d='vec3' sol=0:3023
+1177: n=377 sz=2 s=0 l=66 c=71 d='(' sol=0:3023
+1178: n=417 sz=6 s=0 l=66 c=71 d='0.299' sol=0:3023
+1179: n=368 sz=2 s=0 l=66 c=71 d=',' sol=0:3023
+1180: n=417 sz=6 s=0 l=66 c=71 d='0.587' sol=0:3023
+1181: n=368 sz=2 s=0 l=66 c=71 d=',' sol=0:3023
+1182: n=417 sz=6 s=0 l=66 c=71 d='0.114' sol=0:3023
+1183: n=384 sz=2 s=0 l=66 c=71 d=')' sol=0:3023
+1184: n=384 sz=2 s=0 l=66 c=71 d=')' sol=0:3023
+1185: n=385 sz=2 s=0 l=66 c=87 d=';' sol=0:3023
+1186: n=424 sz=0 s=0 l=66 c=88 d='<null>' sol=0:3023
+1187: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+1188: n=421 sz=4 s=0 l=67 c=1 d='acc' sol=0:3112
+1189: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+1190: n=396 sz=3 s=0 l=67 c=5 d='+=' sol=0:3112
+1191: n=426 sz=0 s=0 l=67 c=6 d='<null>' sol=0:3112
+1192: n=421 sz=6 s=0 l=67 c=8 d='clamp' sol=0:3112
+1193: n=377 sz=2 s=0 l=67 c=8 d='(' sol=0:3112
+1194: n=377 sz=2 s=0 l=67 c=12 d='(' sol=0:3112
+1195: n=377 sz=2 s=0 l=67 c=12 d='(' sol=0:3112
+1196: n=421 sz=10 s=0 l=67 c=18 d='texture2D' sol=0:3112
+1197: n=377 sz=2 s=0 l=67 c=27 d='(' sol=0:3112
+1198: n=421 sz=5 s=0 l=67 c=28 d='uTex' sol=0:3112
+1199: n=368 sz=2 s=0 l=67 c=32 d=',' sol=0:3112
+1200: n=421 sz=4 s=0 l=67 c=34 d='vUV' sol=0:3112
+1201: n=379 sz=2 s=0 l=67 c=38 d='+' sol=0:3112
+1202: n=421 sz=8 s=0 l=67 c=40 d='uParams' sol=0:3112
+1203: n=376 sz=2 s=0 l=67 c=47 d='[' sol=0:3112
+1204: n=419 sz=2 s=0 l=67 c=48 d='2' sol=0:3112
+1205: n=383 sz=2 s=0 l=67 c=49 d=']' sol=0:3112
+1206: n=371 sz=2 s=0 l=67 c=50 d='.' sol=0:3112
+1207: n=421 sz=3 s=0 l=67 c=51 d='xy' sol=0:3112
+1208: n=384 sz=2 s=0 l=67 c=53 d=')' sol=0:3112
+1209: n=384 sz=2 s=0 l=67 c=12 d=')' sol=0:3112
+1210: n=387 sz=2 s=0 l=67 c=12 d='*' sol=0:3112
+1211: n=417 sz=4 s=0 l=67 c=12 d='8.0' sol=0:3112
+1212: n=379 sz=2 s=0 l=67 c=12 d='+' sol=0:3112
+1213: n=377 sz=2 s=0 l=67 c=12 d='(' sol=0:3112
+1214: n=421 sz=8 s=0 l=67 c=56 d='uParams' sol=0:3112
+1215: n=376 sz=2 s=0 l=67 c=63 d='[' sol=0:3112
+1216: n=419 sz=2 s=0 l=67 c=64 d='1' sol=0:3112
+1217: n=383 sz=2 s=0 l=67 c=65 d=']' sol=0:3112
+1218: n=384 sz=2 s=0 l=67 c=12 d=')' sol=0:3112
+1219: n=387 sz=2 s=0 l=67 c=12 d='*' sol=0:3112
+1220: n=417 sz=4 s=0 l=67 c=12 d='0.0' sol=0:3112
+1221: n=384 sz=2 s=0 l=67 c=12 d=')' sol=0:3112
+1222: n=368 sz=2 s=0 l=67 c=8 d=',' sol=0:3112
+1223: n=417 sz=4 s=0 l=67 c=8 d='0.0' sol=0:3112
+1224: n=368 sz=2 s=0 l=67 c=8 d=',' sol=0:3112
+1225: n=417 sz=4 s=0 l=67 c=8 d='1.0' sol=0:3112
+1226: n=384 sz=2 s=0 l=67 c=8 d=')' sol=0:3112
+1227: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+1228: n=387 sz=2 s=0 l=67 c=69 d='*' sol=0:3112
+1229: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+1230: n=421 sz=4 s=0 l=67 c=71 d='dot' sol=0:3112
+1231: n=377 sz=2 s=0 l=67 c=71 d='(' sol=0:3112
+1232: n=421 sz=8 s=0 l=67 c=76 d='uParams' sol=0:3112
+1233: n=376 sz=2 s=0 l=67 c=83 d='[' sol=0:3112
+1234: n=419 sz=2 s=0 l=67 c=84 d='5' sol=0:3112
+1235: n=383 sz=2 s=0 l=67 c=85 d=']' sol=0:3112
+1236: n=371 sz=2 s=0 l=67 c=71 d='.' sol=0:3112
+1237: n=421 sz=4 s=0 l=67 c=71 d='rgb' sol=0:3112
+1238: n=368 sz=2 s=0 l=67 c=71 d=',' sol=0:3112
+1239: n=421 sz=5 s=0 l=67 c=71 d='vec3' sol=0:3112
+1240: n=377 sz=2 s=0 l=67 c=71 d='(' sol=0:3112
+1241: n=417 sz=6 s=0 l=67 c=71 d='0.299' sol=0:3112
+1242: n=368 sz=2 s=0 l=67 c=71 d=',' sol=0:3112
+1243: n=417 sz=6 s=0 l=67 c=71 d='0.587' sol=0:3112
+1244: n=368 sz=2 s=0 l=67 c=71 d=',' sol=0:3112
+1245: n=417 sz=6 s=0 l=67 c=71 d='0.114' sol=0:3112
+1246: n=384 sz=2 s=0 l=67 c=71 d=')' sol=0:3112
+1247: n=384 sz=2 s=0 l=67 c=71 d=')' sol=0:3112
+1248: n=385 sz=2 s=0 l=67 c=87 d=';' sol=0:3112
+1249: n=424 sz=0 s=0 l=67 c=88 d='<null>' sol=0:3112
+1250: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+1251: n=421 sz=4 s=0 l=68 c=1 d='acc' sol=0:3201
+1252: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+1253: n=396 sz=3 s=0 l=68 c=5 d='+=' sol=0:3201
+1254: n=426 sz=0 s=0 l=68 c=6 d='<null>' sol=0:3201
+1255: n=421 sz=6 s=0 l=68 c=8 d='clamp' sol=0:3201
+1256: n=377 sz=2 s=0 l=68 c=8 d='(' sol=0:3201
+1257: n=377 sz=2 s=0 l=68 c=12 d='(' sol=0:3201
+1258: n=377 sz=2 s=0 l=68 c=12 d='(' sol=0:3201
+1259: n=421 sz=10 s=0 l=68 c=18 d='texture2D' sol=0:3201
+1260: n=377 sz=2 s=0 l=68 c=27 d='(' sol=0:3201
+1261: n=421 sz=5 s=0 l=68 c=28 d='uTex' sol=0:3201
+1262: n=368 sz=2 s=0 l=68 c=32 d=',' sol=0:3201
+1263: n=421 sz=4 s=0 l=68 c=34 d='vUV' sol=0:3201
+1264: n=379 sz=2 s=0 l=68 c=38 d='+' sol=0:3201
+1265: n=421 sz=8 s=0 l=68 c=40 d='uParams' sol=0:3201
+1266: n=376 sz=2 s=0 l=68 c=47 d='[' sol=0:3201
+1267: n=419 sz=2 s=0 l=68 c=48 d='3' sol=0:3201
+1268: n=383 sz=2 s=0 l=68 c=49 d=']' sol=0:3201
+1269: n=371 sz=2 s=0 l=68 c=50 d='.' sol=0:3201
+1270: n=421 sz=3 s=0 l=68 c=51 d='xy' sol=0:3201
+1271: n=384 sz=2 s=0 l=68 c=53 d=')' sol=0:3201
+1272: n=384 sz=2 s=0 l=68 c=12 d=')' sol=0:3201
+1273: n=387 sz=2 s=0 l=68 c=12 d='*' sol=0:3201
+1274: n=417 sz=4 s=0 l=68 c=12 d='4.0' sol=0:3201
+1275: n=379 sz=2 s=0 l=68 c=12 d='+' sol=0:3201
+1276: n=377 sz=2 s=0 l=68 c=12 d='(' sol=0:3201
+1277: n=421 sz=8 s=0 l=68 c=56 d='uParams' sol=0:3201
+1278: n=376 sz=2 s=0 l=68 c=63 d='[' sol=0:3201
+1279: n=419 sz=2 s=0 l=68 c=64 d='3' sol=0:3201
+1280: n=383 sz=2 s=0 l=68 c=65 d=']' sol=0:3201
+1281: n=384 sz=2 s=0 l=68 c=12 d=')' sol=0:3201
+1282: n=387 sz=2 s=0 l=68 c=12 d='*' sol=0:3201
+1283: n=417 sz=4 s=0 l=68 c=12 d='4.4' sol=0:3201
+1284: n=384 sz=2 s=0 l=68 c=12 d=')' sol=0:3201
+1285: n=368 sz=2 s=0 l=68 c=8 d=',' sol=0:3201
+1286: n=417 sz=4 s=0 l=68 c=8 d='0.0' sol=0:3201
+1287: n=368 sz=2 s=0 l=68 c=8 d=',' sol=0:3201
+1288: n=417 sz=4 s=0 l=68 c=8 d='1.0' sol=0:3201
+1289: n=384 sz=2 s=0 l=68 c=8 d=')' sol=0:3201
+1290: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+1291: n=387 sz=2 s=0 l=68 c=69 d='*' sol=0:3201
+1292: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+1293: n=421 sz=4 s=0 l=68 c=71 d='dot' sol=0:3201
+1294: n=377 sz=2 s=0 l=68 c=71 d='(' sol=0:3201
+1295: n=421 sz=8 s=0 l=68 c=76 d='uParams' sol=0:3201
+1296: n=376 sz=2 s=0 l=68 c=83 d='[' sol=0:3201
+1297: n=419 sz=2 s=0 l=68 c=84 d='6' sol=0:3201
+1298: n=383 sz=2 s=0 l=68 c=85 d=']' sol=0:3201
+1299: n=371 sz=2 s=0 l=68 c=71 d='.' sol=0:3201
+1300: n=421 sz=4 s=0 l=68 c=71 d='rgb' sol=0:3201
+1301: n=368 sz=2 s=0 l=68 c=71 d=',' sol=0:3201
+1302: n=421 sz=5 s=0 l=68 c=71 d='vec3' sol=0:3201
+1303: n=377 sz=2 s=0 l=68 c=71 d='(' sol=0:3201
+1304: n=417 sz=6 s=0 l=68 c=71 d='0.299' sol=0:3201
+1305: n=368 sz=2 s=0 l=68 c=71 d=',' sol=0:3201
+1306: n=417 sz=6 s=0 l=68 c=71 d='0.587' sol=0:3201
+1307: n=368 sz=2 s=0 l=68 c=71 d=',' sol=0:3201
+1308: n=417 sz=6 s=0 l=68 c=71 d='0.114' sol=0:3201
+1309: n=384 sz=2 s=0 l=68 c=71 d=')' sol=0:3201
+1310: n=384 sz=2 s=0 l=68 c=71 d=')' sol=0:3201
+1311: n=385 sz=2 s=0 l=68 c=87 d=';' sol=0:3201
+1312: n=424 sz=0 s=0 l=68 c=88 d='<null>' sol=0:3201
+1313: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+1314: n=421 sz=13 s=0 l=94 c=1 d='gl_FragColor' sol=0:5172
+1315: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+1316: n=373 sz=2 s=0 l=94 c=14 d='=' sol=0:5172
+1317: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+1318: n=421 sz=4 s=0 l=94 c=16 d='acc' sol=0:5172
+1319: n=385 sz=2 s=0 l=94 c=19 d=';' sol=0:5172
+1320: n=424 sz=0 s=0 l=94 c=20 d='<null>' sol=0:5172
+1321: n=382 sz=2 s=0 l=95 c=0 d='}' sol=0:5193
+1322: n=424 sz=0 s=0 l=95 c=1 d='<null>' sol=0:5193
+1323: n=432 sz=0 s=0 l=0 c=0 d='<null>' sol=null
@@ -0,0 +1,19 @@
+precision mediump float;
+#define ONE 1.0
+#define TWO (ONE + ONE)
+#define MUL(a, b) ((a) * (b))
+#define MAD(a,b,c) (MUL(a, b) + (c))
+#define EMPTY()
+#define NOARGS ()
+#define SWAP(x) x.yx
+uniform vec2 u;
+void main()
+{
+	float f = MAD(TWO, ONE, MUL(u.x, u.y));
+	vec2 v = SWAP(u) + vec2 NOARGS;
+	float g = MUL((u.x + 1.0), (u.y, 2.0));
+	float h = MUL(MUL(1.0, 2.0), MUL(3.0, MUL(4.0, 5.0)));
+#undef ONE
+#define ONE 2.0
+	gl_FragColor = vec4(f, g, h, ONE) + v.xyxy;
+}
@@ -0,0 +1,184 @@
+ok=1 in=274
+ext=10 n=182
+0: n=421 sz=10 s=0 l=1 c=0 d='precision' sol=0:0
+1: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+2: n=421 sz=8 s=0 l=1 c=10 d='mediump' sol=0:0
+3: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+4: n=421 sz=6 s=0 l=1 c=18 d='float' sol=0:0
+5: n=385 sz=2 s=0 l=1 c=23 d=';' sol=0:0
+6: n=424 sz=0 s=0 l=1 c=24 d='<null>' sol=0:0
+7: n=421 sz=8 s=0 l=9 c=0 d='uniform' sol=0:187
+8: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+9: n=421 sz=5 s=0 l=9 c=8 d='vec2' sol=0:187
+10: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+11: n=421 sz=2 s=0 l=9 c=13 d='u' sol=0:187
+12: n=385 sz=2 s=0 l=9 c=14 d=';' sol=0:187
+13: n=424 sz=0 s=0 l=9 c=15 d='<null>' sol=0:187
+14: n=421 sz=5 s=0 l=10 c=0 d='void' sol=0:203
+15: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+16: n=421 sz=5 s=0 l=10 c=5 d='main' sol=0:203
+17: n=377 sz=2 s=0 l=10 c=9 d='(' sol=0:203
+18: n=384 sz=2 s=0 l=10 c=10 d=')' sol=0:203
+19: n=424 sz=0 s=0 l=10 c=11 d='<null>' sol=0:203
+20: n=375 sz=2 s=0 l=11 c=0 d='{' sol=0:215
+21: n=424 sz=0 s=0 l=11 c=1 d='<null>' sol=0:215
+22: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+23: n=421 sz=6 s=0 l=12 c=1 d='float' sol=0:217
+24: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+25: n=421 sz=2 s=0 l=12 c=7 d='f' sol=0:217
+26: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+27: n=373 sz=2 s=0 l=12 c=9 d='=' sol=0:217
+28: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+29: n=377 sz=2 s=0 l=12 c=11 d='(' sol=0:217
+30: n=377 sz=2 s=0 l=12 c=11 d='(' sol=0:217
+31: n=377 sz=2 s=0 l=12 c=11 d='(' sol=0:217
+32: n=377 sz=2 s=0 l=12 c=15 d='(' sol=0:217
+33: n=417 sz=4 s=0 l=12 c=15 d='1.0' sol=0:217
+34: n=379 sz=2 s=0 l=12 c=15 d='+' sol=0:217
+35: n=417 sz=4 s=0 l=12 c=15 d='1.0' sol=0:217
+36: n=384 sz=2 s=0 l=12 c=15 d=')' sol=0:217
+37: n=384 sz=2 s=0 l=12 c=11 d=')' sol=0:217
+38: n=387 sz=2 s=0 l=12 c=11 d='*' sol=0:217
+39: n=377 sz=2 s=0 l=12 c=11 d='(' sol=0:217
+40: n=417 sz=4 s=0 l=12 c=20 d='1.0' sol=0:217
+41: n=384 sz=2 s=0 l=12 c=11 d=')' sol=0:217
+42: n=384 sz=2 s=0 l=12 c=11 d=')' sol=0:217
+43: n=379 sz=2 s=0 l=12 c=11 d='+' sol=0:217
+44: n=377 sz=2 s=0 l=12 c=11 d='(' sol=0:217
+45: n=377 sz=2 s=0 l=12 c=25 d='(' sol=0:217
+46: n=377 sz=2 s=0 l=12 c=25 d='(' sol=0:217
+47: n=421 sz=2 s=0 l=12 c=29 d='u' sol=0:217
+48: n=371 sz=2 s=0 l=12 c=30 d='.' sol=0:217
+49: n=421 sz=2 s=0 l=12 c=31 d='x' sol=0:217
+50: n=384 sz=2 s=0 l=12 c=25 d=')' sol=0:217
+51: n=387 sz=2 s=0 l=12 c=25 d='*' sol=0:217
+52: n=377 sz=2 s=0 l=12 c=25 d='(' sol=0:217
+53: n=421 sz=2 s=0 l=12 c=34 d='u' sol=0:217
+54: n=371 sz=2 s=0 l=12 c=35 d='.' sol=0:217
+55: n=421 sz=2 s=0 l=12 c=36 d='y' sol=0:217
+56: n=384 sz=2 s=0 l=12 c=25 d=')' sol=0:217
+57: n=384 sz=2 s=0 l=12 c=25 d=')' sol=0:217
+58: n=384 sz=2 s=0 l=12 c=11 d=')' sol=0:217
+59: n=384 sz=2 s=0 l=12 c=11 d=')' sol=0:217
+60: n=385 sz=2 s=0 l=12 c=39 d=';' sol=0:217
+61: n=424 sz=0 s=0 l=12 c=40 d='<null>' sol=0:217
+62: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+63: n=421 sz=5 s=0 l=13 c=1 d='vec2' sol=0:258
+64: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+65: n=421 sz=2 s=0 l=13 c=6 d='v' sol=0:258
+66: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+67: n=373 sz=2 s=0 l=13 c=8 d='=' sol=0:258
+68: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+69: n=421 sz=2 s=0 l=13 c=15 d='u' sol=0:258
+70: n=371 sz=2 s=0 l=13 c=10 d='.' sol=0:258
+71: n=421 sz=3 s=0 l=13 c=10 d='yx' sol=0:258
+72: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+73: n=379 sz=2 s=0 l=13 c=18 d='+' sol=0:258
+74: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+75: n=421 sz=5 s=0 l=13 c=20 d='vec2' sol=0:258
+76: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+77: n=377 sz=2 s=0 l=13 c=25 d='(' sol=0:258
+78: n=384 sz=2 s=0 l=13 c=25 d=')' sol=0:258
+79: n=385 sz=2 s=0 l=13 c=31 d=';' sol=0:258
+80: n=424 sz=0 s=0 l=13 c=32 d='<null>' sol=0:258
+81: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+82: n=421 sz=6 s=0 l=14 c=1 d='float' sol=0:291
+83: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+84: n=421 sz=2 s=0 l=14 c=7 d='g' sol=0:291
+85: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+86: n=373 sz=2 s=0 l=14 c=9 d='=' sol=0:291
+87: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+88: n=377 sz=2 s=0 l=14 c=11 d='(' sol=0:291
+89: n=377 sz=2 s=0 l=14 c=11 d='(' sol=0:291
+90: n=377 sz=2 s=0 l=14 c=15 d='(' sol=0:291
+91: n=421 sz=2 s=0 l=14 c=16 d='u' sol=0:291
+92: n=371 sz=2 s=0 l=14 c=17 d='.' sol=0:291
+93: n=421 sz=2 s=0 l=14 c=18 d='x' sol=0:291
+94: n=379 sz=2 s=0 l=14 c=20 d='+' sol=0:291
+95: n=417 sz=4 s=0 l=14 c=22 d='1.0' sol=0:291
+96: n=384 sz=2 s=0 l=14 c=25 d=')' sol=0:291
+97: n=384 sz=2 s=0 l=14 c=11 d=')' sol=0:291
+98: n=387 sz=2 s=0 l=14 c=11 d='*' sol=0:291
+99: n=377 sz=2 s=0 l=14 c=11 d='(' sol=0:291
+100: n=377 sz=2 s=0 l=14 c=28 d='(' sol=0:291
+101: n=421 sz=2 s=0 l=14 c=29 d='u' sol=0:291
+102: n=371 sz=2 s=0 l=14 c=30 d='.' sol=0:291
+103: n=421 sz=2 s=0 l=14 c=31 d='y' sol=0:291
+104: n=368 sz=2 s=0 l=14 c=32 d=',' sol=0:291
+105: n=417 sz=4 s=0 l=14 c=34 d='2.0' sol=0:291
+106: n=384 sz=2 s=0 l=14 c=37 d=')' sol=0:291
+107: n=384 sz=2 s=0 l=14 c=11 d=')' sol=0:291
+108: n=384 sz=2 s=0 l=14 c=11 d=')' sol=0:291
+109: n=385 sz=2 s=0 l=14 c=39 d=';' sol=0:291
+110: n=424 sz=0 s=0 l=14 c=40 d='<null>' sol=0:291
+111: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+112: n=421 sz=6 s=0 l=15 c=1 d='float' sol=0:332
+113: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+114: n=421 sz=2 s=0 l=15 c=7 d='h' sol=0:332
+115: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+116: n=373 sz=2 s=0 l=15 c=9 d='=' sol=0:332
+117: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+118: n=377 sz=2 s=0 l=15 c=11 d='(' sol=0:332
+119: n=377 sz=2 s=0 l=15 c=11 d='(' sol=0:332
+120: n=377 sz=2 s=0 l=15 c=15 d='(' sol=0:332
+121: n=377 sz=2 s=0 l=15 c=15 d='(' sol=0:332
+122: n=417 sz=4 s=0 l=15 c=19 d='1.0' sol=0:332
+123: n=384 sz=2 s=0 l=15 c=15 d=')' sol=0:332
+124: n=387 sz=2 s=0 l=15 c=15 d='*' sol=0:332
+125: n=377 sz=2 s=0 l=15 c=15 d='(' sol=0:332
+126: n=417 sz=4 s=0 l=15 c=24 d='2.0' sol=0:332
+127: n=384 sz=2 s=0 l=15 c=15 d=')' sol=0:332
+128: n=384 sz=2 s=0 l=15 c=15 d=')' sol=0:332
+129: n=384 sz=2 s=0 l=15 c=11 d=')' sol=0:332
+130: n=387 sz=2 s=0 l=15 c=11 d='*' sol=0:332
+131: n=377 sz=2 s=0 l=15 c=11 d='(' sol=0:332
+132: n=377 sz=2 s=0 l=15 c=30 d='(' sol=0:332
+133: n=377 sz=2 s=0 l=15 c=30 d='(' sol=0:332
+134: n=417 sz=4 s=0 l=15 c=34 d='3.0' sol=0:332
+135: n=384 sz=2 s=0 l=15 c=30 d=')' sol=0:332
+136: n=387 sz=2 s=0 l=15 c=30 d='*' sol=0:332
+137: n=377 sz=2 s=0 l=15 c=30 d='(' sol=0:332
+138: n=377 sz=2 s=0 l=15 c=39 d='(' sol=0:332
+139: n=377 sz=2 s=0 l=15 c=39 d='(' sol=0:332
+140: n=417 sz=4 s=0 l=15 c=43 d='4.0' sol=0:332
+141: n=384 sz=2 s=0 l=15 c=39 d=')' sol=0:332
+142: n=387 sz=2 s=0 l=15 c=39 d='*' sol=0:332
+143: n=377 sz=2 s=0 l=15 c=39 d='(' sol=0:332
+144: n=417 sz=4 s=0 l=15 c=48 d='5.0' sol=0:332
+145: n=384 sz=2 s=0 l=15 c=39 d=')' sol=0:332
+146: n=384 sz=2 s=0 l=15 c=39 d=')' sol=0:332
+147: n=384 sz=2 s=0 l=15 c=30 d=')' sol=0:332
+148: n=384 sz=2 s=0 l=15 c=30 d=')' sol=0:332
+149: n=384 sz=2 s=0 l=15 c=11 d=')' sol=0:332
+150: n=384 sz=2 s=0 l=15 c=11 d=')' sol=0:332
+151: n=385 sz=2 s=0 l=15 c=54 d=';' sol=0:332
+152: n=424 sz=0 s=0 l=15 c=55 d='<null>' sol=0:332
+153: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+154: n=421 sz=13 s=0 l=18 c=1 d='gl_FragColor' sol=0:415
+155: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+156: n=373 sz=2 s=0 l=18 c=14 d='=' sol=0:415
+157: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+158: n=421 sz=5 s=0 l=18 c=16 d='vec4' sol=0:415
+159: n=377 sz=2 s=0 l=18 c=20 d='(' sol=0:415
+160: n=421 sz=2 s=0 l=18 c=21 d='f' sol=0:415
+161: n=368 sz=2 s=0 l=18 c=22 d=',' sol=0:415
+162: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+163: n=421 sz=2 s=0 l=18 c=24 d='g' sol=0:415
+164: n=368 sz=2 s=0 l=18 c=25 d=',' sol=0:415
+165: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+166: n=421 sz=2 s=0 l=18 c=27 d='h' sol=0:415
+167: n=368 sz=2 s=0 l=18 c=28 d=',' sol=0:415
+168: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+169: n=417 sz=4 s=0 l=18 c=30 d='2.0' sol=0:415
+170: n=384 sz=2 s=0 l=18 c=33 d=')' sol=0:415
+171: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+172: n=379 sz=2 s=0 l=18 c=35 d='+' sol=0:415
+173: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+174: n=421 sz=2 s=0 l=18 c=37 d='v' sol=0:415
+175: n=371 sz=2 s=0 l=18 c=38 d='.' sol=0:415
+176: n=421 sz=5 s=0 l=18 c=39 d='xyxy' sol=0:415
+177: n=385 sz=2 s=0 l=18 c=43 d=';' sol=0:415
+178: n=424 sz=0 s=0 l=18 c=44 d='<null>' sol=0:415
+179: n=382 sz=2 s=0 l=19 c=0 d='}' sol=0:460
+180: n=424 sz=0 s=0 l=19 c=1 d='<null>' sol=0:460
+181: n=432 sz=0 s=0 l=0 c=0 d='<null>' sol=null
@@ -0,0 +1,18 @@
+precision mediump float;
+#define LONG_MACRO(a, b) \
+	((a) + \
+	 (b))
+#define SPLIT \
+	3.0
+uniform vec4 u;
+void main()
+{
+	float f = LONG_MACRO(u.x,
+	                     u.y);
+	float g = LONG_MACRO(
+		u.z,
+		u.w) * SPLIT;
+	float h = LONG_MACRO(u.x, \
+		u.y);
+	gl_FragColor = vec4(f, g, h, 1.0);
+}
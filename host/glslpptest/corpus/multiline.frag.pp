@@ -0,0 +1,117 @@
+ok=1 in=155
+ext=10 n=115
+0: n=421 sz=10 s=0 l=1 c=0 d='precision' sol=0:0
+1: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+2: n=421 sz=8 s=0 l=1 c=10 d='mediump' sol=0:0
+3: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+4: n=421 sz=6 s=0 l=1 c=18 d='float' sol=0:0
+5: n=385 sz=2 s=0 l=1 c=23 d=';' sol=0:0
+6: n=424 sz=0 s=0 l=1 c=24 d='<null>' sol=0:0
+7: n=421 sz=8 s=0 l=7 c=0 d='uniform' sol=0:90
+8: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+9: n=421 sz=5 s=0 l=7 c=8 d='vec4' sol=0:90
+10: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+11: n=421 sz=2 s=0 l=7 c=13 d='u' sol=0:90
+12: n=385 sz=2 s=0 l=7 c=14 d=';' sol=0:90
+13: n=424 sz=0 s=0 l=7 c=15 d='<null>' sol=0:90
+14: n=421 sz=5 s=0 l=8 c=0 d='void' sol=0:106
+15: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+16: n=421 sz=5 s=0 l=8 c=5 d='main' sol=0:106
+17: n=377 sz=2 s=0 l=8 c=9 d='(' sol=0:106
+18: n=384 sz=2 s=0 l=8 c=10 d=')' sol=0:106
+19: n=424 sz=0 s=0 l=8 c=11 d='<null>' sol=0:106
+20: n=375 sz=2 s=0 l=9 c=0 d='{' sol=0:118
+21: n=424 sz=0 s=0 l=9 c=1 d='<null>' sol=0:118
+22: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+23: n=421 sz=6 s=0 l=10 c=1 d='float' sol=0:120
+24: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+25: n=421 sz=2 s=0 l=10 c=7 d='f' sol=0:120
+26: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+27: n=373 sz=2 s=0 l=10 c=9 d='=' sol=0:120
+28: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+29: n=377 sz=2 s=0 l=10 c=11 d='(' sol=0:120
+30: n=377 sz=2 s=0 l=10 c=11 d='(' sol=0:120
+31: n=421 sz=2 s=0 l=10 c=22 d='u' sol=0:120
+32: n=371 sz=2 s=0 l=10 c=23 d='.' sol=0:120
+33: n=421 sz=2 s=0 l=10 c=24 d='x' sol=0:120
+34: n=384 sz=2 s=0 l=10 c=11 d=')' sol=0:120
+35: n=379 sz=2 s=0 l=10 c=11 d='+' sol=0:120
+36: n=377 sz=2 s=0 l=10 c=11 d='(' sol=0:120
+37: n=421 sz=2 s=0 l=11 c=22 d='u' sol=0:147
+38: n=371 sz=2 s=0 l=11 c=23 d='.' sol=0:147
+39: n=421 sz=2 s=0 l=11 c=24 d='y' sol=0:147
+40: n=384 sz=2 s=0 l=10 c=11 d=')' sol=0:120
+41: n=384 sz=2 s=0 l=10 c=11 d=')' sol=0:120
+42: n=385 sz=2 s=0 l=11 c=26 d=';' sol=0:147
+43: n=424 sz=0 s=0 l=11 c=27 d='<null>' sol=0:147
+44: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+45: n=421 sz=6 s=0 l=12 c=1 d='float' sol=0:175
+46: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+47: n=421 sz=2 s=0 l=12 c=7 d='g' sol=0:175
+48: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+49: n=373 sz=2 s=0 l=12 c=9 d='=' sol=0:175
+50: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+51: n=377 sz=2 s=0 l=12 c=11 d='(' sol=0:175
+52: n=377 sz=2 s=0 l=12 c=11 d='(' sol=0:175
+53: n=421 sz=2 s=0 l=13 c=2 d='u' sol=0:198
+54: n=371 sz=2 s=0 l=13 c=3 d='.' sol=0:198
+55: n=421 sz=2 s=0 l=13 c=4 d='z' sol=0:198
+56: n=384 sz=2 s=0 l=12 c=11 d=')' sol=0:175
+57: n=379 sz=2 s=0 l=12 c=11 d='+' sol=0:175
+58: n=377 sz=2 s=0 l=12 c=11 d='(' sol=0:175
+59: n=421 sz=2 s=0 l=14 c=2 d='u' sol=0:205
+60: n=371 sz=2 s=0 l=14 c=3 d='.' sol=0:205
+61: n=421 sz=2 s=0 l=14 c=4 d='w' sol=0:205
+62: n=384 sz=2 s=0 l=12 c=11 d=')' sol=0:175
+63: n=384 sz=2 s=0 l=12 c=11 d=')' sol=0:175
+64: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+65: n=387 sz=2 s=0 l=14 c=7 d='*' sol=0:205
+66: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+67: n=417 sz=4 s=0 l=14 c=9 d='3.0' sol=0:205
+68: n=385 sz=2 s=0 l=14 c=14 d=';' sol=0:205
+69: n=424 sz=0 s=0 l=14 c=15 d='<null>' sol=0:205
+70: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+71: n=421 sz=6 s=0 l=15 c=1 d='float' sol=0:221
+72: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+73: n=421 sz=2 s=0 l=15 c=7 d='h' sol=0:221
+74: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+75: n=373 sz=2 s=0 l=15 c=9 d='=' sol=0:221
+76: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+77: n=377 sz=2 s=0 l=15 c=11 d='(' sol=0:221
+78: n=377 sz=2 s=0 l=15 c=11 d='(' sol=0:221
+79: n=421 sz=2 s=0 l=15 c=22 d='u' sol=0:221
+80: n=371 sz=2 s=0 l=15 c=23 d='.' sol=0:221
+81: n=421 sz=2 s=0 l=15 c=24 d='x' sol=0:221
+82: n=384 sz=2 s=0 l=15 c=11 d=')' sol=0:221
+83: n=379 sz=2 s=0 l=15 c=11 d='+' sol=0:221
+84: n=377 sz=2 s=0 l=15 c=11 d='(' sol=0:221
+85: n=421 sz=2 s=0 l=16 c=2 d='u' sol=0:250
+86: n=371 sz=2 s=0 l=16 c=3 d='.' sol=0:250
+87: n=421 sz=2 s=0 l=16 c=4 d='y' sol=0:250
+88: n=384 sz=2 s=0 l=15 c=11 d=')' sol=0:221
+89: n=384 sz=2 s=0 l=15 c=11 d=')' sol=0:221
+90: n=385 sz=2 s=0 l=16 c=6 d=';' sol=0:250
+91: n=424 sz=0 s=0 l=16 c=7 d='<null>' sol=0:250
+92: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+93: n=421 sz=13 s=0 l=17 c=1 d='gl_FragColor' sol=0:258
+94: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+95: n=373 sz=2 s=0 l=17 c=14 d='=' sol=0:258
+96: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+97: n=421 sz=5 s=0 l=17 c=16 d='vec4' sol=0:258
+98: n=377 sz=2 s=0 l=17 c=20 d='(' sol=0:258
+99: n=421 sz=2 s=0 l=17 c=21 d='f' sol=0:258
+100: n=368 sz=2 s=0 l=17 c=22 d=',' sol=0:258
+101: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+102: n=421 sz=2 s=0 l=17 c=24 d='g' sol=0:258
+103: n=368 sz=2 s=0 l=17 c=25 d=',' sol=0:258
+104: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+105: n=421 sz=2 s=0 l=17 c=27 d='h' sol=0:258
+106: n=368 sz=2 s=0 l=17 c=28 d=',' sol=0:258
+107: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+108: n=417 sz=4 s=0 l=17 c=30 d='1.0' sol=0:258
+109: n=384 sz=2 s=0 l=17 c=33 d=')' sol=0:258
+110: n=385 sz=2 s=0 l=17 c=34 d=';' sol=0:258
+111: n=424 sz=0 s=0 l=17 c=35 d='<null>' sol=0:258
+112: n=382 sz=2 s=0 l=18 c=0 d='}' sol=0:294
+113: n=424 sz=0 s=0 l=18 c=1 d='<null>' sol=0:294
+114: n=432 sz=0 s=0 l=0 c=0 d='<null>' sol=null
@@ -0,0 +1,9 @@
+precision mediump float;
+#define A 1.0
+const int s = __FILE__;
+#define B (A + 1.0)
+uniform float u;
+void main()
+{
+	gl_FragColor = vec4(A, B, u, float(__FILE__));
+}
@@ -0,0 +1,65 @@
+ok=1 in=79
+ext=10 n=63
+0: n=421 sz=10 s=0 l=1 c=0 d='precision' sol=0:0
+1: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+2: n=421 sz=8 s=0 l=1 c=10 d='mediump' sol=0:0
+3: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+4: n=421 sz=6 s=0 l=1 c=18 d='float' sol=0:0
+5: n=385 sz=2 s=0 l=1 c=23 d=';' sol=0:0
+6: n=424 sz=0 s=0 l=1 c=24 d='<null>' sol=0:0
+7: n=421 sz=6 s=0 l=3 c=0 d='const' sol=0:39
+8: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+9: n=421 sz=4 s=0 l=3 c=6 d='int' sol=0:39
+10: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+11: n=421 sz=2 s=0 l=3 c=10 d='s' sol=0:39
+12: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+13: n=373 sz=2 s=0 l=3 c=12 d='=' sol=0:39
+14: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+15: n=419 sz=9 s=0 l=3 c=14 d='0' sol=0:39
+16: n=385 sz=2 s=0 l=3 c=22 d=';' sol=0:39
+17: n=424 sz=0 s=0 l=3 c=23 d='<null>' sol=0:39
+18: n=421 sz=8 s=1 l=5 c=0 d='uniform' sol=1:20
+19: n=426 sz=0 s=1 l=0 c=0 d='<null>' sol=null
+20: n=421 sz=6 s=1 l=5 c=8 d='float' sol=1:20
+21: n=426 sz=0 s=1 l=0 c=0 d='<null>' sol=null
+22: n=421 sz=2 s=1 l=5 c=14 d='u' sol=1:20
+23: n=385 sz=2 s=1 l=5 c=15 d=';' sol=1:20
+24: n=424 sz=0 s=1 l=5 c=16 d='<null>' sol=1:20
+25: n=421 sz=5 s=2 l=6 c=0 d='void' sol=2:0
+26: n=426 sz=0 s=2 l=0 c=0 d='<null>' sol=null
+27: n=421 sz=5 s=2 l=6 c=5 d='main' sol=2:0
+28: n=377 sz=2 s=2 l=6 c=9 d='(' sol=2:0
+29: n=384 sz=2 s=2 l=6 c=10 d=')' sol=2:0
+30: n=424 sz=0 s=2 l=6 c=11 d='<null>' sol=2:0
+31: n=375 sz=2 s=2 l=7 c=0 d='{' sol=2:12
+32: n=424 sz=0 s=2 l=7 c=1 d='<null>' sol=2:12
+33: n=426 sz=0 s=2 l=0 c=0 d='<null>' sol=null
+34: n=421 sz=13 s=2 l=8 c=1 d='gl_FragColor' sol=2:14
+35: n=426 sz=0 s=2 l=0 c=0 d='<null>' sol=null
+36: n=373 sz=2 s=2 l=8 c=14 d='=' sol=2:14
+37: n=426 sz=0 s=2 l=0 c=0 d='<null>' sol=null
+38: n=421 sz=5 s=2 l=8 c=16 d='vec4' sol=2:14
+39: n=377 sz=2 s=2 l=8 c=20 d='(' sol=2:14
+40: n=417 sz=4 s=2 l=8 c=21 d='1.0' sol=2:14
+41: n=368 sz=2 s=2 l=8 c=22 d=',' sol=2:14
+42: n=426 sz=0 s=2 l=0 c=0 d='<null>' sol=null
+43: n=377 sz=2 s=2 l=8 c=24 d='(' sol=2:14
+44: n=417 sz=4 s=2 l=8 c=24 d='1.0' sol=2:14
+45: n=379 sz=2 s=2 l=8 c=24 d='+' sol=2:14
+46: n=417 sz=4 s=2 l=8 c=24 d='1.0' sol=2:14
+47: n=384 sz=2 s=2 l=8 c=24 d=')' sol=2:14
+48: n=368 sz=2 s=2 l=8 c=25 d=',' sol=2:14
+49: n=426 sz=0 s=2 l=0 c=0 d='<null>' sol=null
+50: n=421 sz=2 s=2 l=8 c=27 d='u' sol=2:14
+51: n=368 sz=2 s=2 l=8 c=28 d=',' sol=2:14
+52: n=426 sz=0 s=2 l=0 c=0 d='<null>' sol=null
+53: n=421 sz=6 s=2 l=8 c=30 d='float' sol=2:14
+54: n=377 sz=2 s=2 l=8 c=35 d='(' sol=2:14
+55: n=419 sz=9 s=2 l=8 c=36 d='2' sol=2:14
+56: n=384 sz=2 s=2 l=8 c=44 d=')' sol=2:14
+57: n=384 sz=2 s=2 l=8 c=45 d=')' sol=2:14
+58: n=385 sz=2 s=2 l=8 c=46 d=';' sol=2:14
+59: n=424 sz=0 s=2 l=8 c=47 d='<null>' sol=2:14
+60: n=382 sz=2 s=2 l=9 c=0 d='}' sol=2:62
+61: n=424 sz=0 s=2 l=9 c=1 d='<null>' sol=2:62
+62: n=432 sz=0 s=0 l=0 c=0 d='<null>' sol=null
@@ -0,0 +1,34 @@
+#version 100
+#	ifdef Z
+gl_FragColor } } // d ; __FILE__ __LINE__
+gl_FragColor float __VERSION__
+# if __LINE__ > 5
+/* c */ 1.0 // d } ) float __FILE__ = /* c */ 1.0
+  #if __VERSION__ >= 100
+x x float
+#	endif
+// d } ;
+# extension GL_OES_standard_derivatives : disable
+__VERSION__ ; ( gl_FragColor = gl_FragColor
+x ( x ( __FILE__ __LINE__ ; __LINE__ ; __LINE__
+
+# define E __LINE__ x
+  #define B E
+#	define F(p) E + x E 1 1
+F((y)) F( 1) } F(x) ) float F(A) __LINE__
+// d F((y) (y))
+  #define A(p) p
+A(1) A(f(a, b) (y)) F )
+#define G __LINE__ __LINE__ B
+float A()
+#undef E
+= float
+} F(vec2(1.0, 2.0) 1)
+F(A x) ( F(A x) F() F(x) A(A A)
+#	if defined(A) || defined(B)
+# else
+F(f(a, b)) A(A) A(x) A 1.0 B
+# endif
+
+#endif
+#endif
\ No newline at end of file
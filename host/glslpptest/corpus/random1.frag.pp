@@ -0,0 +1,4 @@
+ok=1 in=337
+ext=10 n=2
+0: n=428 sz=0 s=0 l=1 c=1 d='<null>' sol=#100
+1: n=432 sz=0 s=0 l=0 c=0 d='<null>' sol=null
@@ -0,0 +1,21 @@
+# pragma STDGL invariant(all)
+  #ifdef GL_ES
+
+gl_FragColor ; 1.0 gl_FragColor float __VERSION__ 1.0 __VERSION__ ( )
+#extension GL_OES_standard_derivatives : disable
+1.0
+// d { ( 1.0 } ( x
+#if !defined(GL_ES)
+# define C __LINE__ 1 +
+# define B(p, q) C x 1
+__FILE__ /* c */ B(, \
+  vec2(1.0, 2.0)) // d
+
+B(,
+ vec2(1.0, 2.0) x) C B(A vec2(1.0, 2.0), x ) B B( x, (y) vec2(1.0, 2.0)) =
+#	define G __LINE__ 2
+B(x ,
+ A (y)) B(vec2(1.0, 2.0), ) __FILE__ B(x 1,
+ 1) B(f(a, b) , 1)
+#endif
+#endif
\ No newline at end of file
@@ -0,0 +1,29 @@
+ok=1 in=238
+ext=18 n=27
+0: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+1: n=421 sz=13 s=0 l=4 c=0 d='gl_FragColor' sol=0:46
+2: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+3: n=385 sz=2 s=0 l=4 c=13 d=';' sol=0:46
+4: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+5: n=417 sz=4 s=0 l=4 c=15 d='1.0' sol=0:46
+6: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+7: n=421 sz=13 s=0 l=4 c=19 d='gl_FragColor' sol=0:46
+8: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+9: n=421 sz=6 s=0 l=4 c=32 d='float' sol=0:46
+10: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+11: n=419 sz=12 s=0 l=4 c=38 d='100' sol=0:46
+12: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+13: n=417 sz=4 s=0 l=4 c=50 d='1.0' sol=0:46
+14: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+15: n=419 sz=12 s=0 l=4 c=54 d='100' sol=0:46
+16: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+17: n=377 sz=2 s=0 l=4 c=66 d='(' sol=0:46
+18: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+19: n=384 sz=2 s=0 l=4 c=68 d=')' sol=0:46
+20: n=424 sz=0 s=0 l=4 c=69 d='<null>' sol=0:46
+21: n=429 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+22: n=419 sz=0 s=0 l=0 c=0 d='<null>' sol=#24
+23: n=417 sz=4 s=0 l=6 c=0 d='1.0' sol=0:165
+24: n=424 sz=0 s=0 l=6 c=3 d='<null>' sol=0:165
+25: n=424 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+26: n=432 sz=0 s=0 l=0 c=0 d='<null>' sol=null
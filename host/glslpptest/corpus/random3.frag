@@ -0,0 +1,14 @@
+/* c */ x // d __VERSION__
+#define G 1 +
+G G G G G G // d // d G float
+# if !defined(G)
+float __FILE__ G gl_FragColor 1.0 G __VERSION__ G
+#	line 6 1
+G __FILE__ __FILE__ = G __FILE__ G }
+{ G G __FILE__
+G G G
+# define D(p) * G ) x 2.0
+1.0 // d // d ) G
+#extension GL_OES_standard_derivatives : disable
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,26 @@
+ok=1 in=126
+ext=10 n=24
+0: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+1: n=421 sz=2 s=0 l=1 c=8 d='x' sol=0:0
+2: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+3: n=424 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+4: n=419 sz=2 s=0 l=3 c=0 d='1' sol=0:41
+5: n=379 sz=2 s=0 l=3 c=0 d='+' sol=0:41
+6: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+7: n=419 sz=2 s=0 l=3 c=2 d='1' sol=0:41
+8: n=379 sz=2 s=0 l=3 c=2 d='+' sol=0:41
+9: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+10: n=419 sz=2 s=0 l=3 c=4 d='1' sol=0:41
+11: n=379 sz=2 s=0 l=3 c=4 d='+' sol=0:41
+12: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+13: n=419 sz=2 s=0 l=3 c=6 d='1' sol=0:41
+14: n=379 sz=2 s=0 l=3 c=6 d='+' sol=0:41
+15: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+16: n=419 sz=2 s=0 l=3 c=8 d='1' sol=0:41
+17: n=379 sz=2 s=0 l=3 c=8 d='+' sol=0:41
+18: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+19: n=419 sz=2 s=0 l=3 c=10 d='1' sol=0:41
+20: n=379 sz=2 s=0 l=3 c=10 d='+' sol=0:41
+21: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+22: n=424 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+23: n=432 sz=0 s=0 l=0 c=0 d='<null>' sol=null
@@ -0,0 +1,54 @@
+=
+# if 0
+__FILE__ __VERSION__ 1.0
+__LINE__ = x /* c */ {
+#if GL_ES
+#else
+#	define B 2 1 x
+B
+#define D(p, q, r) + 2.0 + 2.0
+D D( A,
+ x,
+ (y)) ( __VERSION__ ; D((y) 1, \
+ x 1, \
+  1)
+1.0 D float ( D(1, \
+ x, \
+ f(a, b) (y)) float
+#	pragma debug(off)
+# extension GL_OES_standard_derivatives : require
+D( 1, f(a, b) A, f(a, b)) D(A x, \
+ 1 vec2(1.0, 2.0), \
+ ) D(, , ) B D x D(vec2(1.0, 2.0),
+ (y) vec2(1.0, 2.0),
+  (y)) __FILE__ (
+#else
+B __FILE__ ) 1.0 ) __LINE__ D(A 1, \
+ (y) (y), \
+ 1 ) D(, \
+ , \
+ 1 ) __FILE__ D
+# endif
+#extension GL_OES_standard_derivatives : require
+#if __LINE__ > 5
+# define G 1 2 y __LINE__
+#pragma STDGL invariant(all)
+#if defined G
+B D( f(a, b), \
+ f(a, b) x, \
+ x A) __VERSION__
+#ifdef GL_ES
+D 1.0 D(1 vec2(1.0, 2.0), 1, ) ) D(1, \
+  A, \
+ vec2(1.0, 2.0))
+  #undef B
+#if defined G
+gl_FragColor
+  #extension GL_OES_standard_derivatives : disable
+# elif defined(A)
+D
+#endif
+#endif
+#endif
+#endif
+#endif
@@ -0,0 +1,5 @@
+ok=1 in=527
+ext=10 n=3
+0: n=373 sz=2 s=0 l=1 c=0 d='=' sol=0:0
+1: n=424 sz=0 s=0 l=1 c=1 d='<null>' sol=0:0
+2: n=432 sz=0 s=0 l=0 c=0 d='<null>' sol=null
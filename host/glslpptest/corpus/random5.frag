@@ -0,0 +1,27 @@
+__LINE__ __FILE__ // d x
+) ( float
+__FILE__ /* c */ gl_FragColor __LINE__ float __VERSION__ /* c */ __LINE__ (
+# if 1
+#	define B __LINE__
+B gl_FragColor B B B B B (
+) 1.0 B
+#define E 2 2 +
+B ) E B // d E // d {
+__VERSION__ /* c */ B float )
+#	if defined B
+  #define A E
+__FILE__ A
+float ; 1.0 /* c */ { B
+/* c */ E A
+__LINE__ A ( { float gl_FragColor E A float __VERSION__
+A // d B {
+#	if GL_ES
+#	endif
+A E E E E
+E E { E __LINE__ B
+
+# undef B
+( A E ( E gl_FragColor
+E 1.0
+#endif
+#endif
\ No newline at end of file
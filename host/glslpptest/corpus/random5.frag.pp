@@ -0,0 +1,192 @@
+ok=1 in=211
+ext=10 n=190
+0: n=419 sz=9 s=0 l=1 c=0 d='1' sol=0:0
+1: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+2: n=419 sz=9 s=0 l=1 c=9 d='0' sol=0:0
+3: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+4: n=424 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+5: n=384 sz=2 s=0 l=2 c=0 d=')' sol=0:25
+6: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+7: n=377 sz=2 s=0 l=2 c=2 d='(' sol=0:25
+8: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+9: n=421 sz=6 s=0 l=2 c=4 d='float' sol=0:25
+10: n=424 sz=0 s=0 l=2 c=9 d='<null>' sol=0:25
+11: n=419 sz=9 s=0 l=3 c=0 d='0' sol=0:35
+12: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+13: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+14: n=421 sz=13 s=0 l=3 c=17 d='gl_FragColor' sol=0:35
+15: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+16: n=419 sz=9 s=0 l=3 c=30 d='3' sol=0:35
+17: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+18: n=421 sz=6 s=0 l=3 c=39 d='float' sol=0:35
+19: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+20: n=419 sz=12 s=0 l=3 c=45 d='100' sol=0:35
+21: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+22: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+23: n=419 sz=9 s=0 l=3 c=65 d='3' sol=0:35
+24: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+25: n=377 sz=2 s=0 l=3 c=74 d='(' sol=0:35
+26: n=424 sz=0 s=0 l=3 c=75 d='<null>' sol=0:35
+27: n=419 sz=9 s=0 l=6 c=0 d='5' sol=0:138
+28: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+29: n=421 sz=13 s=0 l=6 c=2 d='gl_FragColor' sol=0:138
+30: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+31: n=419 sz=9 s=0 l=6 c=15 d='5' sol=0:138
+32: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+33: n=419 sz=9 s=0 l=6 c=17 d='5' sol=0:138
+34: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+35: n=419 sz=9 s=0 l=6 c=19 d='5' sol=0:138
+36: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+37: n=419 sz=9 s=0 l=6 c=21 d='5' sol=0:138
+38: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+39: n=419 sz=9 s=0 l=6 c=23 d='5' sol=0:138
+40: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+41: n=377 sz=2 s=0 l=6 c=25 d='(' sol=0:138
+42: n=424 sz=0 s=0 l=6 c=26 d='<null>' sol=0:138
+43: n=384 sz=2 s=0 l=7 c=0 d=')' sol=0:165
+44: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+45: n=417 sz=4 s=0 l=7 c=2 d='1.0' sol=0:165
+46: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+47: n=419 sz=9 s=0 l=7 c=6 d='5' sol=0:165
+48: n=424 sz=0 s=0 l=7 c=7 d='<null>' sol=0:165
+49: n=419 sz=9 s=0 l=9 c=0 d='5' sol=0:189
+50: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+51: n=384 sz=2 s=0 l=9 c=2 d=')' sol=0:189
+52: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+53: n=419 sz=2 s=0 l=9 c=4 d='2' sol=0:189
+54: n=419 sz=2 s=0 l=9 c=4 d='2' sol=0:189
+55: n=379 sz=2 s=0 l=9 c=4 d='+' sol=0:189
+56: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+57: n=419 sz=9 s=0 l=9 c=6 d='5' sol=0:189
+58: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+59: n=424 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+60: n=419 sz=12 s=0 l=10 c=0 d='100' sol=0:211
+61: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+62: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+63: n=419 sz=9 s=0 l=10 c=20 d='5' sol=0:211
+64: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+65: n=421 sz=6 s=0 l=10 c=22 d='float' sol=0:211
+66: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+67: n=384 sz=2 s=0 l=10 c=28 d=')' sol=0:211
+68: n=424 sz=0 s=0 l=10 c=29 d='<null>' sol=0:211
+69: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+70: n=419 sz=9 s=0 l=13 c=0 d='0' sol=0:270
+71: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+72: n=419 sz=2 s=0 l=13 c=9 d='2' sol=0:270
+73: n=419 sz=2 s=0 l=13 c=9 d='2' sol=0:270
+74: n=379 sz=2 s=0 l=13 c=9 d='+' sol=0:270
+75: n=424 sz=0 s=0 l=13 c=10 d='<null>' sol=0:270
+76: n=421 sz=6 s=0 l=14 c=0 d='float' sol=0:281
+77: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+78: n=385 sz=2 s=0 l=14 c=6 d=';' sol=0:281
+79: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+80: n=417 sz=4 s=0 l=14 c=8 d='1.0' sol=0:281
+81: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+82: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+83: n=375 sz=2 s=0 l=14 c=20 d='{' sol=0:281
+84: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+85: n=419 sz=9 s=0 l=14 c=22 d='5' sol=0:281
+86: n=424 sz=0 s=0 l=14 c=23 d='<null>' sol=0:281
+87: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+88: n=419 sz=2 s=0 l=15 c=8 d='2' sol=0:305
+89: n=419 sz=2 s=0 l=15 c=8 d='2' sol=0:305
+90: n=379 sz=2 s=0 l=15 c=8 d='+' sol=0:305
+91: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+92: n=419 sz=2 s=0 l=15 c=10 d='2' sol=0:305
+93: n=419 sz=2 s=0 l=15 c=10 d='2' sol=0:305
+94: n=379 sz=2 s=0 l=15 c=10 d='+' sol=0:305
+95: n=424 sz=0 s=0 l=15 c=11 d='<null>' sol=0:305
+96: n=419 sz=9 s=0 l=16 c=0 d='16' sol=0:317
+97: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+98: n=419 sz=2 s=0 l=16 c=9 d='2' sol=0:317
+99: n=419 sz=2 s=0 l=16 c=9 d='2' sol=0:317
+100: n=379 sz=2 s=0 l=16 c=9 d='+' sol=0:317
+101: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+102: n=377 sz=2 s=0 l=16 c=11 d='(' sol=0:317
+103: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+104: n=375 sz=2 s=0 l=16 c=13 d='{' sol=0:317
+105: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+106: n=421 sz=6 s=0 l=16 c=15 d='float' sol=0:317
+107: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+108: n=421 sz=13 s=0 l=16 c=21 d='gl_FragColor' sol=0:317
+109: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+110: n=419 sz=2 s=0 l=16 c=34 d='2' sol=0:317
+111: n=419 sz=2 s=0 l=16 c=34 d='2' sol=0:317
+112: n=379 sz=2 s=0 l=16 c=34 d='+' sol=0:317
+113: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+114: n=419 sz=2 s=0 l=16 c=36 d='2' sol=0:317
+115: n=419 sz=2 s=0 l=16 c=36 d='2' sol=0:317
+116: n=379 sz=2 s=0 l=16 c=36 d='+' sol=0:317
+117: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+118: n=421 sz=6 s=0 l=16 c=38 d='float' sol=0:317
+119: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+120: n=419 sz=12 s=0 l=16 c=44 d='100' sol=0:317
+121: n=424 sz=0 s=0 l=16 c=55 d='<null>' sol=0:317
+122: n=419 sz=2 s=0 l=17 c=0 d='2' sol=0:373
+123: n=419 sz=2 s=0 l=17 c=0 d='2' sol=0:373
+124: n=379 sz=2 s=0 l=17 c=0 d='+' sol=0:373
+125: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+126: n=424 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+127: n=419 sz=2 s=0 l=20 c=0 d='2' sol=0:403
+128: n=419 sz=2 s=0 l=20 c=0 d='2' sol=0:403
+129: n=379 sz=2 s=0 l=20 c=0 d='+' sol=0:403
+130: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+131: n=419 sz=2 s=0 l=20 c=2 d='2' sol=0:403
+132: n=419 sz=2 s=0 l=20 c=2 d='2' sol=0:403
+133: n=379 sz=2 s=0 l=20 c=2 d='+' sol=0:403
+134: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+135: n=419 sz=2 s=0 l=20 c=4 d='2' sol=0:403
+136: n=419 sz=2 s=0 l=20 c=4 d='2' sol=0:403
+137: n=379 sz=2 s=0 l=20 c=4 d='+' sol=0:403
+138: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+139: n=419 sz=2 s=0 l=20 c=6 d='2' sol=0:403
+140: n=419 sz=2 s=0 l=20 c=6 d='2' sol=0:403
+141: n=379 sz=2 s=0 l=20 c=6 d='+' sol=0:403
+142: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+143: n=419 sz=2 s=0 l=20 c=8 d='2' sol=0:403
+144: n=419 sz=2 s=0 l=20 c=8 d='2' sol=0:403
+145: n=379 sz=2 s=0 l=20 c=8 d='+' sol=0:403
+146: n=424 sz=0 s=0 l=20 c=9 d='<null>' sol=0:403
+147: n=419 sz=2 s=0 l=21 c=0 d='2' sol=0:413
+148: n=419 sz=2 s=0 l=21 c=0 d='2' sol=0:413
+149: n=379 sz=2 s=0 l=21 c=0 d='+' sol=0:413
+150: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+151: n=419 sz=2 s=0 l=21 c=2 d='2' sol=0:413
+152: n=419 sz=2 s=0 l=21 c=2 d='2' sol=0:413
+153: n=379 sz=2 s=0 l=21 c=2 d='+' sol=0:413
+154: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+155: n=375 sz=2 s=0 l=21 c=4 d='{' sol=0:413
+156: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+157: n=419 sz=2 s=0 l=21 c=6 d='2' sol=0:413
+158: n=419 sz=2 s=0 l=21 c=6 d='2' sol=0:413
+159: n=379 sz=2 s=0 l=21 c=6 d='+' sol=0:413
+160: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+161: n=419 sz=9 s=0 l=21 c=8 d='21' sol=0:413
+162: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+163: n=419 sz=9 s=0 l=21 c=17 d='5' sol=0:413
+164: n=424 sz=0 s=0 l=21 c=18 d='<null>' sol=0:413
+165: n=377 sz=2 s=0 l=24 c=0 d='(' sol=0:443
+166: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+167: n=419 sz=2 s=0 l=24 c=2 d='2' sol=0:443
+168: n=419 sz=2 s=0 l=24 c=2 d='2' sol=0:443
+169: n=379 sz=2 s=0 l=24 c=2 d='+' sol=0:443
+170: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+171: n=419 sz=2 s=0 l=24 c=4 d='2' sol=0:443
+172: n=419 sz=2 s=0 l=24 c=4 d='2' sol=0:443
+173: n=379 sz=2 s=0 l=24 c=4 d='+' sol=0:443
+174: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+175: n=377 sz=2 s=0 l=24 c=6 d='(' sol=0:443
+176: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+177: n=419 sz=2 s=0 l=24 c=8 d='2' sol=0:443
+178: n=419 sz=2 s=0 l=24 c=8 d='2' sol=0:443
+179: n=379 sz=2 s=0 l=24 c=8 d='+' sol=0:443
+180: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+181: n=421 sz=13 s=0 l=24 c=10 d='gl_FragColor' sol=0:443
+182: n=424 sz=0 s=0 l=24 c=22 d='<null>' sol=0:443
+183: n=419 sz=2 s=0 l=25 c=0 d='2' sol=0:466
+184: n=419 sz=2 s=0 l=25 c=0 d='2' sol=0:466
+185: n=379 sz=2 s=0 l=25 c=0 d='+' sol=0:466
+186: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+187: n=417 sz=4 s=0 l=25 c=2 d='1.0' sol=0:466
+188: n=424 sz=0 s=0 l=25 c=5 d='<null>' sol=0:466
+189: n=432 sz=0 s=0 l=0 c=0 d='<null>' sol=null
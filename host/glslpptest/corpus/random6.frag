@@ -0,0 +1,30 @@
+= 1.0 ;
+#	if GL_ES
+  #pragma debug(off)
+( = ( 1.0 } 1.0 = float x ;
+# define D 2 1 __LINE__ y
+} D
+gl_FragColor D D ; ) D D D
+#extension GL_OES_standard_derivatives : require
+# if __LINE__ > 5
+  #define G __LINE__ + x
+
+D float =
+{ ; G G {
+# endif
+#ifndef Z
+#	line 35 1
+#	if __VERSION__ >= 100
+#	endif
+G D G D G __FILE__
+# if defined(A) || defined(B)
+D = D D G /* c */ x G
+D G
+#pragma debug(off)
+__VERSION__ ( // d G G D /* c */
+G float D D ) 1.0 D /* c */ G )
+#if !defined(D)
+#endif
+#endif
+#endif
+#endif
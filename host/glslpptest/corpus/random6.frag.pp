@@ -0,0 +1,118 @@
+ok=1 in=254
+ext=14 n=116
+0: n=373 sz=2 s=0 l=1 c=0 d='=' sol=0:0
+1: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+2: n=417 sz=4 s=0 l=1 c=2 d='1.0' sol=0:0
+3: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+4: n=385 sz=2 s=0 l=1 c=6 d=';' sol=0:0
+5: n=424 sz=0 s=0 l=1 c=7 d='<null>' sol=0:0
+6: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+7: n=377 sz=2 s=0 l=4 c=0 d='(' sol=0:40
+8: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+9: n=373 sz=2 s=0 l=4 c=2 d='=' sol=0:40
+10: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+11: n=377 sz=2 s=0 l=4 c=4 d='(' sol=0:40
+12: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+13: n=417 sz=4 s=0 l=4 c=6 d='1.0' sol=0:40
+14: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+15: n=382 sz=2 s=0 l=4 c=10 d='}' sol=0:40
+16: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+17: n=417 sz=4 s=0 l=4 c=12 d='1.0' sol=0:40
+18: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+19: n=373 sz=2 s=0 l=4 c=16 d='=' sol=0:40
+20: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+21: n=421 sz=6 s=0 l=4 c=18 d='float' sol=0:40
+22: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+23: n=421 sz=2 s=0 l=4 c=24 d='x' sol=0:40
+24: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+25: n=385 sz=2 s=0 l=4 c=26 d=';' sol=0:40
+26: n=424 sz=0 s=0 l=4 c=27 d='<null>' sol=0:40
+27: n=382 sz=2 s=0 l=6 c=0 d='}' sol=0:94
+28: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+29: n=419 sz=2 s=0 l=6 c=2 d='2' sol=0:94
+30: n=419 sz=2 s=0 l=6 c=2 d='1' sol=0:94
+31: n=419 sz=9 s=0 l=6 c=2 d='5' sol=0:94
+32: n=421 sz=2 s=0 l=6 c=2 d='y' sol=0:94
+33: n=424 sz=0 s=0 l=6 c=3 d='<null>' sol=0:94
+34: n=421 sz=13 s=0 l=7 c=0 d='gl_FragColor' sol=0:98
+35: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+36: n=419 sz=2 s=0 l=7 c=13 d='2' sol=0:98
+37: n=419 sz=2 s=0 l=7 c=13 d='1' sol=0:98
+38: n=419 sz=9 s=0 l=7 c=13 d='5' sol=0:98
+39: n=421 sz=2 s=0 l=7 c=13 d='y' sol=0:98
+40: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+41: n=419 sz=2 s=0 l=7 c=15 d='2' sol=0:98
+42: n=419 sz=2 s=0 l=7 c=15 d='1' sol=0:98
+43: n=419 sz=9 s=0 l=7 c=15 d='5' sol=0:98
+44: n=421 sz=2 s=0 l=7 c=15 d='y' sol=0:98
+45: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+46: n=385 sz=2 s=0 l=7 c=17 d=';' sol=0:98
+47: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+48: n=384 sz=2 s=0 l=7 c=19 d=')' sol=0:98
+49: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+50: n=419 sz=2 s=0 l=7 c=21 d='2' sol=0:98
+51: n=419 sz=2 s=0 l=7 c=21 d='1' sol=0:98
+52: n=419 sz=9 s=0 l=7 c=21 d='5' sol=0:98
+53: n=421 sz=2 s=0 l=7 c=21 d='y' sol=0:98
+54: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+55: n=419 sz=2 s=0 l=7 c=23 d='2' sol=0:98
+56: n=419 sz=2 s=0 l=7 c=23 d='1' sol=0:98
+57: n=419 sz=9 s=0 l=7 c=23 d='5' sol=0:98
+58: n=421 sz=2 s=0 l=7 c=23 d='y' sol=0:98
+59: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+60: n=419 sz=2 s=0 l=7 c=25 d='2' sol=0:98
+61: n=419 sz=2 s=0 l=7 c=25 d='1' sol=0:98
+62: n=419 sz=9 s=0 l=7 c=25 d='5' sol=0:98
+63: n=421 sz=2 s=0 l=7 c=25 d='y' sol=0:98
+64: n=424 sz=0 s=0 l=7 c=26 d='<null>' sol=0:98
+65: n=429 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+66: n=419 sz=0 s=0 l=0 c=0 d='<null>' sol=#20
+67: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+68: n=419 sz=2 s=0 l=12 c=0 d='2' sol=0:218
+69: n=419 sz=2 s=0 l=12 c=0 d='1' sol=0:218
+70: n=419 sz=9 s=0 l=12 c=0 d='5' sol=0:218
+71: n=421 sz=2 s=0 l=12 c=0 d='y' sol=0:218
+72: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+73: n=421 sz=6 s=0 l=12 c=2 d='float' sol=0:218
+74: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+75: n=373 sz=2 s=0 l=12 c=8 d='=' sol=0:218
+76: n=424 sz=0 s=0 l=12 c=9 d='<null>' sol=0:218
+77: n=375 sz=2 s=0 l=13 c=0 d='{' sol=0:228
+78: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+79: n=385 sz=2 s=0 l=13 c=2 d=';' sol=0:228
+80: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+81: n=419 sz=9 s=0 l=13 c=4 d='10' sol=0:228
+82: n=379 sz=2 s=0 l=13 c=4 d='+' sol=0:228
+83: n=421 sz=2 s=0 l=13 c=4 d='x' sol=0:228
+84: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+85: n=419 sz=9 s=0 l=13 c=6 d='10' sol=0:228
+86: n=379 sz=2 s=0 l=13 c=6 d='+' sol=0:228
+87: n=421 sz=2 s=0 l=13 c=6 d='x' sol=0:228
+88: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+89: n=375 sz=2 s=0 l=13 c=8 d='{' sol=0:228
+90: n=424 sz=0 s=0 l=13 c=9 d='<null>' sol=0:228
+91: n=419 sz=9 s=1 l=19 c=0 d='10' sol=0:300
+92: n=379 sz=2 s=1 l=19 c=0 d='+' sol=0:300
+93: n=421 sz=2 s=1 l=19 c=0 d='x' sol=0:300
+94: n=426 sz=0 s=1 l=0 c=0 d='<null>' sol=null
+95: n=419 sz=2 s=1 l=19 c=2 d='2' sol=0:300
+96: n=419 sz=2 s=1 l=19 c=2 d='1' sol=0:300
+97: n=419 sz=9 s=1 l=19 c=2 d='5' sol=0:300
+98: n=421 sz=2 s=1 l=19 c=2 d='y' sol=0:300
+99: n=426 sz=0 s=1 l=0 c=0 d='<null>' sol=null
+100: n=419 sz=9 s=1 l=19 c=4 d='10' sol=0:300
+101: n=379 sz=2 s=1 l=19 c=4 d='+' sol=0:300
+102: n=421 sz=2 s=1 l=19 c=4 d='x' sol=0:300
+103: n=426 sz=0 s=1 l=0 c=0 d='<null>' sol=null
+104: n=419 sz=2 s=1 l=19 c=6 d='2' sol=0:300
+105: n=419 sz=2 s=1 l=19 c=6 d='1' sol=0:300
+106: n=419 sz=9 s=1 l=19 c=6 d='5' sol=0:300
+107: n=421 sz=2 s=1 l=19 c=6 d='y' sol=0:300
+108: n=426 sz=0 s=1 l=0 c=0 d='<null>' sol=null
+109: n=419 sz=9 s=1 l=19 c=8 d='10' sol=0:300
+110: n=379 sz=2 s=1 l=19 c=8 d='+' sol=0:300
+111: n=421 sz=2 s=1 l=19 c=8 d='x' sol=0:300
+112: n=426 sz=0 s=1 l=0 c=0 d='<null>' sol=null
+113: n=419 sz=9 s=1 l=19 c=10 d='1' sol=0:300
+114: n=424 sz=0 s=1 l=19 c=18 d='<null>' sol=0:300
+115: n=432 sz=0 s=1 l=0 c=0 d='<null>' sol=null
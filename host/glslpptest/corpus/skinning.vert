@@ -0,0 +1,23 @@
+#version 100
+#define MAX_BONES 32
+#define BONE(i) uBones[int(aIndices[i])]
+#define WEIGHT(i) aWeights[i]
+#define SKIN(v, i) (BONE(i) * (v) * WEIGHT(i))
+#define SKIN4(v) (SKIN(v, 0) + SKIN(v, 1) + SKIN(v, 2) + SKIN(v, 3))
+#ifdef GL_ES
+precision highp float;
+#endif
+attribute vec4 aPosition;
+attribute vec3 aNormal;
+attribute vec4 aIndices;
+attribute vec4 aWeights;
+uniform mat4 uBones[MAX_BONES];
+uniform mat4 uViewProj;
+varying vec3 vNormal;
+void main()
+{
+	vec4 p = SKIN4(aPosition);
+	vec4 n = SKIN4(vec4(aNormal, 0.0));
+	vNormal = normalize(n.xyz);
+	gl_Position = uViewProj * p;
+}
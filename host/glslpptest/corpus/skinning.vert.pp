@@ -0,0 +1,314 @@
+ok=1 in=258
+ext=10 n=312
+0: n=428 sz=0 s=0 l=1 c=1 d='<null>' sol=#100
+1: n=421 sz=10 s=0 l=8 c=0 d='precision' sol=0:234
+2: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+3: n=421 sz=6 s=0 l=8 c=10 d='highp' sol=0:234
+4: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+5: n=421 sz=6 s=0 l=8 c=16 d='float' sol=0:234
+6: n=385 sz=2 s=0 l=8 c=21 d=';' sol=0:234
+7: n=424 sz=0 s=0 l=8 c=22 d='<null>' sol=0:234
+8: n=421 sz=10 s=0 l=10 c=0 d='attribute' sol=0:264
+9: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+10: n=421 sz=5 s=0 l=10 c=10 d='vec4' sol=0:264
+11: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+12: n=421 sz=10 s=0 l=10 c=15 d='aPosition' sol=0:264
+13: n=385 sz=2 s=0 l=10 c=24 d=';' sol=0:264
+14: n=424 sz=0 s=0 l=10 c=25 d='<null>' sol=0:264
+15: n=421 sz=10 s=0 l=11 c=0 d='attribute' sol=0:290
+16: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+17: n=421 sz=5 s=0 l=11 c=10 d='vec3' sol=0:290
+18: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+19: n=421 sz=8 s=0 l=11 c=15 d='aNormal' sol=0:290
+20: n=385 sz=2 s=0 l=11 c=22 d=';' sol=0:290
+21: n=424 sz=0 s=0 l=11 c=23 d='<null>' sol=0:290
+22: n=421 sz=10 s=0 l=12 c=0 d='attribute' sol=0:314
+23: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+24: n=421 sz=5 s=0 l=12 c=10 d='vec4' sol=0:314
+25: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+26: n=421 sz=9 s=0 l=12 c=15 d='aIndices' sol=0:314
+27: n=385 sz=2 s=0 l=12 c=23 d=';' sol=0:314
+28: n=424 sz=0 s=0 l=12 c=24 d='<null>' sol=0:314
+29: n=421 sz=10 s=0 l=13 c=0 d='attribute' sol=0:339
+30: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+31: n=421 sz=5 s=0 l=13 c=10 d='vec4' sol=0:339
+32: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+33: n=421 sz=9 s=0 l=13 c=15 d='aWeights' sol=0:339
+34: n=385 sz=2 s=0 l=13 c=23 d=';' sol=0:339
+35: n=424 sz=0 s=0 l=13 c=24 d='<null>' sol=0:339
+36: n=421 sz=8 s=0 l=14 c=0 d='uniform' sol=0:364
+37: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+38: n=421 sz=5 s=0 l=14 c=8 d='mat4' sol=0:364
+39: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+40: n=421 sz=7 s=0 l=14 c=13 d='uBones' sol=0:364
+41: n=376 sz=2 s=0 l=14 c=19 d='[' sol=0:364
+42: n=419 sz=3 s=0 l=14 c=20 d='32' sol=0:364
+43: n=383 sz=2 s=0 l=14 c=29 d=']' sol=0:364
+44: n=385 sz=2 s=0 l=14 c=30 d=';' sol=0:364
+45: n=424 sz=0 s=0 l=14 c=31 d='<null>' sol=0:364
+46: n=421 sz=8 s=0 l=15 c=0 d='uniform' sol=0:396
+47: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+48: n=421 sz=5 s=0 l=15 c=8 d='mat4' sol=0:396
+49: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+50: n=421 sz=10 s=0 l=15 c=13 d='uViewProj' sol=0:396
+51: n=385 sz=2 s=0 l=15 c=22 d=';' sol=0:396
+52: n=424 sz=0 s=0 l=15 c=23 d='<null>' sol=0:396
+53: n=421 sz=8 s=0 l=16 c=0 d='varying' sol=0:420
+54: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+55: n=421 sz=5 s=0 l=16 c=8 d='vec3' sol=0:420
+56: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+57: n=421 sz=8 s=0 l=16 c=13 d='vNormal' sol=0:420
+58: n=385 sz=2 s=0 l=16 c=20 d=';' sol=0:420
+59: n=424 sz=0 s=0 l=16 c=21 d='<null>' sol=0:420
+60: n=421 sz=5 s=0 l=17 c=0 d='void' sol=0:442
+61: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+62: n=421 sz=5 s=0 l=17 c=5 d='main' sol=0:442
+63: n=377 sz=2 s=0 l=17 c=9 d='(' sol=0:442
+64: n=384 sz=2 s=0 l=17 c=10 d=')' sol=0:442
+65: n=424 sz=0 s=0 l=17 c=11 d='<null>' sol=0:442
+66: n=375 sz=2 s=0 l=18 c=0 d='{' sol=0:454
+67: n=424 sz=0 s=0 l=18 c=1 d='<null>' sol=0:454
+68: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+69: n=421 sz=5 s=0 l=19 c=1 d='vec4' sol=0:456
+70: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+71: n=421 sz=2 s=0 l=19 c=6 d='p' sol=0:456
+72: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+73: n=373 sz=2 s=0 l=19 c=8 d='=' sol=0:456
+74: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+75: n=377 sz=2 s=0 l=19 c=10 d='(' sol=0:456
+76: n=377 sz=2 s=0 l=19 c=10 d='(' sol=0:456
+77: n=421 sz=7 s=0 l=19 c=10 d='uBones' sol=0:456
+78: n=376 sz=2 s=0 l=19 c=10 d='[' sol=0:456
+79: n=421 sz=4 s=0 l=19 c=10 d='int' sol=0:456
+80: n=377 sz=2 s=0 l=19 c=10 d='(' sol=0:456
+81: n=421 sz=9 s=0 l=19 c=10 d='aIndices' sol=0:456
+82: n=376 sz=2 s=0 l=19 c=10 d='[' sol=0:456
+83: n=419 sz=2 s=0 l=19 c=10 d='0' sol=0:456
+84: n=383 sz=2 s=0 l=19 c=10 d=']' sol=0:456
+85: n=384 sz=2 s=0 l=19 c=10 d=')' sol=0:456
+86: n=383 sz=2 s=0 l=19 c=10 d=']' sol=0:456
+87: n=387 sz=2 s=0 l=19 c=10 d='*' sol=0:456
+88: n=377 sz=2 s=0 l=19 c=10 d='(' sol=0:456
+89: n=421 sz=10 s=0 l=19 c=16 d='aPosition' sol=0:456
+90: n=384 sz=2 s=0 l=19 c=10 d=')' sol=0:456
+91: n=387 sz=2 s=0 l=19 c=10 d='*' sol=0:456
+92: n=421 sz=9 s=0 l=19 c=10 d='aWeights' sol=0:456
+93: n=376 sz=2 s=0 l=19 c=10 d='[' sol=0:456
+94: n=419 sz=2 s=0 l=19 c=10 d='0' sol=0:456
+95: n=383 sz=2 s=0 l=19 c=10 d=']' sol=0:456
+96: n=384 sz=2 s=0 l=19 c=10 d=')' sol=0:456
+97: n=379 sz=2 s=0 l=19 c=10 d='+' sol=0:456
+98: n=377 sz=2 s=0 l=19 c=10 d='(' sol=0:456
+99: n=421 sz=7 s=0 l=19 c=10 d='uBones' sol=0:456
+100: n=376 sz=2 s=0 l=19 c=10 d='[' sol=0:456
+101: n=421 sz=4 s=0 l=19 c=10 d='int' sol=0:456
+102: n=377 sz=2 s=0 l=19 c=10 d='(' sol=0:456
+103: n=421 sz=9 s=0 l=19 c=10 d='aIndices' sol=0:456
+104: n=376 sz=2 s=0 l=19 c=10 d='[' sol=0:456
+105: n=419 sz=2 s=0 l=19 c=10 d='1' sol=0:456
+106: n=383 sz=2 s=0 l=19 c=10 d=']' sol=0:456
+107: n=384 sz=2 s=0 l=19 c=10 d=')' sol=0:456
+108: n=383 sz=2 s=0 l=19 c=10 d=']' sol=0:456
+109: n=387 sz=2 s=0 l=19 c=10 d='*' sol=0:456
+110: n=377 sz=2 s=0 l=19 c=10 d='(' sol=0:456
+111: n=421 sz=10 s=0 l=19 c=16 d='aPosition' sol=0:456
+112: n=384 sz=2 s=0 l=19 c=10 d=')' sol=0:456
+113: n=387 sz=2 s=0 l=19 c=10 d='*' sol=0:456
+114: n=421 sz=9 s=0 l=19 c=10 d='aWeights' sol=0:456
+115: n=376 sz=2 s=0 l=19 c=10 d='[' sol=0:456
+116: n=419 sz=2 s=0 l=19 c=10 d='1' sol=0:456
+117: n=383 sz=2 s=0 l=19 c=10 d=']' sol=0:456
+118: n=384 sz=2 s=0 l=19 c=10 d=')' sol=0:456
+119: n=379 sz=2 s=0 l=19 c=10 d='+' sol=0:456
+120: n=377 sz=2 s=0 l=19 c=10 d='(' sol=0:456
+121: n=421 sz=7 s=0 l=19 c=10 d='uBones' sol=0:456
+122: n=376 sz=2 s=0 l=19 c=10 d='[' sol=0:456
+123: n=421 sz=4 s=0 l=19 c=10 d='int' sol=0:456
+124: n=377 sz=2 s=0 l=19 c=10 d='(' sol=0:456
+125: n=421 sz=9 s=0 l=19 c=10 d='aIndices' sol=0:456
+126: n=376 sz=2 s=0 l=19 c=10 d='[' sol=0:456
+127: n=419 sz=2 s=0 l=19 c=10 d='2' sol=0:456
+128: n=383 sz=2 s=0 l=19 c=10 d=']' sol=0:456
+129: n=384 sz=2 s=0 l=19 c=10 d=')' sol=0:456
+130: n=383 sz=2 s=0 l=19 c=10 d=']' sol=0:456
+131: n=387 sz=2 s=0 l=19 c=10 d='*' sol=0:456
+132: n=377 sz=2 s=0 l=19 c=10 d='(' sol=0:456
+133: n=421 sz=10 s=0 l=19 c=16 d='aPosition' sol=0:456
+134: n=384 sz=2 s=0 l=19 c=10 d=')' sol=0:456
+135: n=387 sz=2 s=0 l=19 c=10 d='*' sol=0:456
+136: n=421 sz=9 s=0 l=19 c=10 d='aWeights' sol=0:456
+137: n=376 sz=2 s=0 l=19 c=10 d='[' sol=0:456
+138: n=419 sz=2 s=0 l=19 c=10 d='2' sol=0:456
+139: n=383 sz=2 s=0 l=19 c=10 d=']' sol=0:456
+140: n=384 sz=2 s=0 l=19 c=10 d=')' sol=0:456
+141: n=379 sz=2 s=0 l=19 c=10 d='+' sol=0:456
+142: n=377 sz=2 s=0 l=19 c=10 d='(' sol=0:456
+143: n=421 sz=7 s=0 l=19 c=10 d='uBones' sol=0:456
+144: n=376 sz=2 s=0 l=19 c=10 d='[' sol=0:456
+145: n=421 sz=4 s=0 l=19 c=10 d='int' sol=0:456
+146: n=377 sz=2 s=0 l=19 c=10 d='(' sol=0:456
+147: n=421 sz=9 s=0 l=19 c=10 d='aIndices' sol=0:456
+148: n=376 sz=2 s=0 l=19 c=10 d='[' sol=0:456
+149: n=419 sz=2 s=0 l=19 c=10 d='3' sol=0:456
+150: n=383 sz=2 s=0 l=19 c=10 d=']' sol=0:456
+151: n=384 sz=2 s=0 l=19 c=10 d=')' sol=0:456
+152: n=383 sz=2 s=0 l=19 c=10 d=']' sol=0:456
+153: n=387 sz=2 s=0 l=19 c=10 d='*' sol=0:456
+154: n=377 sz=2 s=0 l=19 c=10 d='(' sol=0:456
+155: n=421 sz=10 s=0 l=19 c=16 d='aPosition' sol=0:456
+156: n=384 sz=2 s=0 l=19 c=10 d=')' sol=0:456
+157: n=387 sz=2 s=0 l=19 c=10 d='*' sol=0:456
+158: n=421 sz=9 s=0 l=19 c=10 d='aWeights' sol=0:456
+159: n=376 sz=2 s=0 l=19 c=10 d='[' sol=0:456
+160: n=419 sz=2 s=0 l=19 c=10 d='3' sol=0:456
+161: n=383 sz=2 s=0 l=19 c=10 d=']' sol=0:456
+162: n=384 sz=2 s=0 l=19 c=10 d=')' sol=0:456
+163: n=384 sz=2 s=0 l=19 c=10 d=')' sol=0:456
+164: n=385 sz=2 s=0 l=19 c=26 d=';' sol=0:456
+165: n=424 sz=0 s=0 l=19 c=27 d='<null>' sol=0:456
+166: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+167: n=421 sz=5 s=0 l=20 c=1 d='vec4' sol=0:484
+168: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+169: n=421 sz=2 s=0 l=20 c=6 d='n' sol=0:484
+170: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+171: n=373 sz=2 s=0 l=20 c=8 d='=' sol=0:484
+172: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+173: n=377 sz=2 s=0 l=20 c=10 d='(' sol=0:484
+174: n=377 sz=2 s=0 l=20 c=10 d='(' sol=0:484
+175: n=421 sz=7 s=0 l=20 c=10 d='uBones' sol=0:484
+176: n=376 sz=2 s=0 l=20 c=10 d='[' sol=0:484
+177: n=421 sz=4 s=0 l=20 c=10 d='int' sol=0:484
+178: n=377 sz=2 s=0 l=20 c=10 d='(' sol=0:484
+179: n=421 sz=9 s=0 l=20 c=10 d='aIndices' sol=0:484
+180: n=376 sz=2 s=0 l=20 c=10 d='[' sol=0:484
+181: n=419 sz=2 s=0 l=20 c=10 d='0' sol=0:484
+182: n=383 sz=2 s=0 l=20 c=10 d=']' sol=0:484
+183: n=384 sz=2 s=0 l=20 c=10 d=')' sol=0:484
+184: n=383 sz=2 s=0 l=20 c=10 d=']' sol=0:484
+185: n=387 sz=2 s=0 l=20 c=10 d='*' sol=0:484
+186: n=377 sz=2 s=0 l=20 c=10 d='(' sol=0:484
+187: n=421 sz=5 s=0 l=20 c=16 d='vec4' sol=0:484
+188: n=377 sz=2 s=0 l=20 c=20 d='(' sol=0:484
+189: n=421 sz=8 s=0 l=20 c=21 d='aNormal' sol=0:484
+190: n=368 sz=2 s=0 l=20 c=28 d=',' sol=0:484
+191: n=417 sz=4 s=0 l=20 c=30 d='0.0' sol=0:484
+192: n=384 sz=2 s=0 l=20 c=33 d=')' sol=0:484
+193: n=384 sz=2 s=0 l=20 c=10 d=')' sol=0:484
+194: n=387 sz=2 s=0 l=20 c=10 d='*' sol=0:484
+195: n=421 sz=9 s=0 l=20 c=10 d='aWeights' sol=0:484
+196: n=376 sz=2 s=0 l=20 c=10 d='[' sol=0:484
+197: n=419 sz=2 s=0 l=20 c=10 d='0' sol=0:484
+198: n=383 sz=2 s=0 l=20 c=10 d=']' sol=0:484
+199: n=384 sz=2 s=0 l=20 c=10 d=')' sol=0:484
+200: n=379 sz=2 s=0 l=20 c=10 d='+' sol=0:484
+201: n=377 sz=2 s=0 l=20 c=10 d='(' sol=0:484
+202: n=421 sz=7 s=0 l=20 c=10 d='uBones' sol=0:484
+203: n=376 sz=2 s=0 l=20 c=10 d='[' sol=0:484
+204: n=421 sz=4 s=0 l=20 c=10 d='int' sol=0:484
+205: n=377 sz=2 s=0 l=20 c=10 d='(' sol=0:484
+206: n=421 sz=9 s=0 l=20 c=10 d='aIndices' sol=0:484
+207: n=376 sz=2 s=0 l=20 c=10 d='[' sol=0:484
+208: n=419 sz=2 s=0 l=20 c=10 d='1' sol=0:484
+209: n=383 sz=2 s=0 l=20 c=10 d=']' sol=0:484
+210: n=384 sz=2 s=0 l=20 c=10 d=')' sol=0:484
+211: n=383 sz=2 s=0 l=20 c=10 d=']' sol=0:484
+212: n=387 sz=2 s=0 l=20 c=10 d='*' sol=0:484
+213: n=377 sz=2 s=0 l=20 c=10 d='(' sol=0:484
+214: n=421 sz=5 s=0 l=20 c=16 d='vec4' sol=0:484
+215: n=377 sz=2 s=0 l=20 c=20 d='(' sol=0:484
+216: n=421 sz=8 s=0 l=20 c=21 d='aNormal' sol=0:484
+217: n=368 sz=2 s=0 l=20 c=28 d=',' sol=0:484
+218: n=417 sz=4 s=0 l=20 c=30 d='0.0' sol=0:484
+219: n=384 sz=2 s=0 l=20 c=33 d=')' sol=0:484
+220: n=384 sz=2 s=0 l=20 c=10 d=')' sol=0:484
+221: n=387 sz=2 s=0 l=20 c=10 d='*' sol=0:484
+222: n=421 sz=9 s=0 l=20 c=10 d='aWeights' sol=0:484
+223: n=376 sz=2 s=0 l=20 c=10 d='[' sol=0:484
+224: n=419 sz=2 s=0 l=20 c=10 d='1' sol=0:484
+225: n=383 sz=2 s=0 l=20 c=10 d=']' sol=0:484
+226: n=384 sz=2 s=0 l=20 c=10 d=')' sol=0:484
+227: n=379 sz=2 s=0 l=20 c=10 d='+' sol=0:484
+228: n=377 sz=2 s=0 l=20 c=10 d='(' sol=0:484
+229: n=421 sz=7 s=0 l=20 c=10 d='uBones' sol=0:484
+230: n=376 sz=2 s=0 l=20 c=10 d='[' sol=0:484
+231: n=421 sz=4 s=0 l=20 c=10 d='int' sol=0:484
+232: n=377 sz=2 s=0 l=20 c=10 d='(' sol=0:484
+233: n=421 sz=9 s=0 l=20 c=10 d='aIndices' sol=0:484
+234: n=376 sz=2 s=0 l=20 c=10 d='[' sol=0:484
+235: n=419 sz=2 s=0 l=20 c=10 d='2' sol=0:484
+236: n=383 sz=2 s=0 l=20 c=10 d=']' sol=0:484
+237: n=384 sz=2 s=0 l=20 c=10 d=')' sol=0:484
+238: n=383 sz=2 s=0 l=20 c=10 d=']' sol=0:484
+239: n=387 sz=2 s=0 l=20 c=10 d='*' sol=0:484
+240: n=377 sz=2 s=0 l=20 c=10 d='(' sol=0:484
+241: n=421 sz=5 s=0 l=20 c=16 d='vec4' sol=0:484
+242: n=377 sz=2 s=0 l=20 c=20 d='(' sol=0:484
+243: n=421 sz=8 s=0 l=20 c=21 d='aNormal' sol=0:484
+244: n=368 sz=2 s=0 l=20 c=28 d=',' sol=0:484
+245: n=417 sz=4 s=0 l=20 c=30 d='0.0' sol=0:484
+246: n=384 sz=2 s=0 l=20 c=33 d=')' sol=0:484
+247: n=384 sz=2 s=0 l=20 c=10 d=')' sol=0:484
+248: n=387 sz=2 s=0 l=20 c=10 d='*' sol=0:484
+249: n=421 sz=9 s=0 l=20 c=10 d='aWeights' sol=0:484
+250: n=376 sz=2 s=0 l=20 c=10 d='[' sol=0:484
+251: n=419 sz=2 s=0 l=20 c=10 d='2' sol=0:484
+252: n=383 sz=2 s=0 l=20 c=10 d=']' sol=0:484
+253: n=384 sz=2 s=0 l=20 c=10 d=')' sol=0:484
+254: n=379 sz=2 s=0 l=20 c=10 d='+' sol=0:484
+255: n=377 sz=2 s=0 l=20 c=10 d='(' sol=0:484
+256: n=421 sz=7 s=0 l=20 c=10 d='uBones' sol=0:484
+257: n=376 sz=2 s=0 l=20 c=10 d='[' sol=0:484
+258: n=421 sz=4 s=0 l=20 c=10 d='int' sol=0:484
+259: n=377 sz=2 s=0 l=20 c=10 d='(' sol=0:484
+260: n=421 sz=9 s=0 l=20 c=10 d='aIndices' sol=0:484
+261: n=376 sz=2 s=0 l=20 c=10 d='[' sol=0:484
+262: n=419 sz=2 s=0 l=20 c=10 d='3' sol=0:484
+263: n=383 sz=2 s=0 l=20 c=10 d=']' sol=0:484
+264: n=384 sz=2 s=0 l=20 c=10 d=')' sol=0:484
+265: n=383 sz=2 s=0 l=20 c=10 d=']' sol=0:484
+266: n=387 sz=2 s=0 l=20 c=10 d='*' sol=0:484
+267: n=377 sz=2 s=0 l=20 c=10 d='(' sol=0:484
+268: n=421 sz=5 s=0 l=20 c=16 d='vec4' sol=0:484
+269: n=377 sz=2 s=0 l=20 c=20 d='(' sol=0:484
+270: n=421 sz=8 s=0 l=20 c=21 d='aNormal' sol=0:484
+271: n=368 sz=2 s=0 l=20 c=28 d=',' sol=0:484
+272: n=417 sz=4 s=0 l=20 c=30 d='0.0' sol=0:484
+273: n=384 sz=2 s=0 l=20 c=33 d=')' sol=0:484
+274: n=384 sz=2 s=0 l=20 c=10 d=')' sol=0:484
+275: n=387 sz=2 s=0 l=20 c=10 d='*' sol=0:484
+276: n=421 sz=9 s=0 l=20 c=10 d='aWeights' sol=0:484
+277: n=376 sz=2 s=0 l=20 c=10 d='[' sol=0:484
+278: n=419 sz=2 s=0 l=20 c=10 d='3' sol=0:484
+279: n=383 sz=2 s=0 l=20 c=10 d=']' sol=0:484
+280: n=384 sz=2 s=0 l=20 c=10 d=')' sol=0:484
+281: n=384 sz=2 s=0 l=20 c=10 d=')' sol=0:484
+282: n=385 sz=2 s=0 l=20 c=35 d=';' sol=0:484
+283: n=424 sz=0 s=0 l=20 c=36 d='<null>' sol=0:484
+284: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+285: n=421 sz=8 s=0 l=21 c=1 d='vNormal' sol=0:521
+286: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+287: n=373 sz=2 s=0 l=21 c=9 d='=' sol=0:521
+288: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+289: n=421 sz=10 s=0 l=21 c=11 d='normalize' sol=0:521
+290: n=377 sz=2 s=0 l=21 c=20 d='(' sol=0:521
+291: n=421 sz=2 s=0 l=21 c=21 d='n' sol=0:521
+292: n=371 sz=2 s=0 l=21 c=22 d='.' sol=0:521
+293: n=421 sz=4 s=0 l=21 c=23 d='xyz' sol=0:521
+294: n=384 sz=2 s=0 l=21 c=26 d=')' sol=0:521
+295: n=385 sz=2 s=0 l=21 c=27 d=';' sol=0:521
+296: n=424 sz=0 s=0 l=21 c=28 d='<null>' sol=0:521
+297: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+298: n=421 sz=12 s=0 l=22 c=1 d='gl_Position' sol=0:550
+299: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+300: n=373 sz=2 s=0 l=22 c=13 d='=' sol=0:550
+301: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+302: n=421 sz=10 s=0 l=22 c=15 d='uViewProj' sol=0:550
+303: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+304: n=387 sz=2 s=0 l=22 c=25 d='*' sol=0:550
+305: n=426 sz=0 s=0 l=0 c=0 d='<null>' sol=null
+306: n=421 sz=2 s=0 l=22 c=27 d='p' sol=0:550
+307: n=385 sz=2 s=0 l=22 c=28 d=';' sol=0:550
+308: n=424 sz=0 s=0 l=22 c=29 d='<null>' sol=0:550
+309: n=382 sz=2 s=0 l=23 c=0 d='}' sol=0:580
+310: n=424 sz=0 s=0 l=23 c=1 d='<null>' sol=0:580
+311: n=432 sz=0 s=0 l=0 c=0 d='<null>' sol=null
@@ -0,0 +1,520 @@
+/******************************************************************************
+ * Name         : main.c
+ * Title        : GLSL preprocessor conformance and benchmark tool
+ *
+ * Copyright    : 2006-2010 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means,electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Description  : Runs shaders through the GLSL lexer and preprocessor on the
+ *                host and checks the result against a recorded reference.
+ *
+ *                For every shader <name> the tool dumps the preprocessed
+ *                token list and the error log, and compares the dump with
+ *                <name>.pp. The references in the corpus directory were
+ *                recorded with the linked list preprocessor, so any change
+ *                to prepro.c has to keep the output token for token
+ *                identical. A form feed character in a shader splits it
+ *                into separate source strings, as if they were passed to
+ *                glShaderSource together.
+ *
+ *                With -b the preprocessor is also timed over a number of
+ *                iterations (lexing is not included in the time).
+ *
+ * Modifications:-
+ * $Log: main.c $
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <time.h>
+
+/* The lexer entry point is local to lex.c */
+#include "../../tools/intern/oglcompiler/parser/lex.c"
+
+#include "error.h"
+#include "prepro.h"
+
+#define MAX_SOURCE_STRINGS	64
+
+typedef struct _DUMP_
+{
+	IMG_CHAR	*pszData;
+	IMG_UINT32	uSize;
+	IMG_UINT32	uAllocated;
+} DUMP, *PDUMP;
+
+typedef struct _SHADER_
+{
+	IMG_CHAR	*pszBuffer;
+	IMG_CHAR	*apszStrings[MAX_SOURCE_STRINGS];
+	IMG_UINT32	uNumStrings;
+} SHADER, *PSHADER;
+
+/*****************************************************************************
+ FUNCTION	: Usage
+
+ PURPOSE	: Prints the command line options.
+
+ PARAMETERS	: None.
+
+ RETURNS	: Nothing.
+*****************************************************************************/
+static IMG_VOID Usage(IMG_VOID)
+{
+	fprintf(stderr, "Usage: glslpptest [-u] [-v] [-b <iterations>] <shader> [<shader> ...]\n");
+	fprintf(stderr, "\n");
+	fprintf(stderr, "  Preprocesses each shader and compares the result with <shader>.pp.\n");
+	fprintf(stderr, "\n");
+	fprintf(stderr, "  -u               Write <shader>.pp instead of comparing against it.\n");
+	fprintf(stderr, "  -v               Print the dump of every shader.\n");
+	fprintf(stderr, "  -b <iterations>  Also time the preprocessor over <iterations> runs.\n");
+}
+
+/*****************************************************************************
+ FUNCTION	: DumpPrintf
+
+ PURPOSE	: Appends formatted text to a dump.
+
+ PARAMETERS	: psDump		- Dump to append to.
+			  pszFormat		- printf style format.
+
+ RETURNS	: IMG_FALSE if out of memory.
+*****************************************************************************/
+static IMG_BOOL DumpPrintf(PDUMP psDump, const IMG_CHAR *pszFormat, ...)
+{
+	IMG_CHAR	acLine[512];
+	va_list		vaArgs;
+	IMG_INT32	iLength;
+
+	va_start(vaArgs, pszFormat);
+	iLength = vsnprintf(acLine, sizeof(acLine), pszFormat, vaArgs);
+	va_end(vaArgs);
+
+	if (iLength < 0)
+	{
+		return IMG_FALSE;
+	}
+	if ((IMG_UINT32)iLength >= sizeof(acLine))
+	{
+		iLength = sizeof(acLine) - 1;
+	}
+
+	if (psDump->uSize + (IMG_UINT32)iLength + 1 > psDump->uAllocated)
+	{
+		IMG_UINT32	uNewSize = (psDump->uAllocated * 2) + (IMG_UINT32)iLength + 1;
+		IMG_CHAR	*pszNewData = realloc(psDump->pszData, uNewSize);
+
+		if (!pszNewData)
+		{
+			return IMG_FALSE;
+		}
+
+		psDump->pszData		= pszNewData;
+		psDump->uAllocated	= uNewSize;
+	}
+
+	memcpy(psDump->pszData + psDump->uSize, acLine, (IMG_UINT32)iLength + 1);
+	psDump->uSize += (IMG_UINT32)iLength;
+
+	return IMG_TRUE;
+}
+
+/*****************************************************************************
+ FUNCTION	: ReadFile
+
+ PURPOSE	: Reads a whole file into memory.
+
+ PARAMETERS	: pszFileName	- File to read.
+			  puSize		- Returns the size of the file.
+
+ RETURNS	: The NULL terminated contents, or IMG_NULL.
+*****************************************************************************/
+static IMG_CHAR *ReadFile(const IMG_CHAR *pszFileName, IMG_UINT32 *puSize)
+{
+	FILE		*psFile = fopen(pszFileName, "rb");
+	IMG_CHAR	*pszBuffer;
+	long		lSize;
+
+	if (!psFile)
+	{
+		return IMG_NULL;
+	}
+
+	fseek(psFile, 0, SEEK_END);
+	lSize = ftell(psFile);
+	fseek(psFile, 0, SEEK_SET);
+
+	pszBuffer = (lSize >= 0) ? malloc((size_t)lSize + 1) : IMG_NULL;
+
+	if (pszBuffer && fread(pszBuffer, 1, (size_t)lSize, psFile) != (size_t)lSize)
+	{
+		free(pszBuffer);
+		pszBuffer = IMG_NULL;
+	}
+
+	fclose(psFile);
+
+	if (pszBuffer)
+	{
+		pszBuffer[lSize] = '\0';
+		*puSize = (IMG_UINT32)lSize;
+	}
+
+	return pszBuffer;
+}
+
+/*****************************************************************************
+ FUNCTION	: LoadShader
+
+ PURPOSE	: Reads a shader and splits it into source strings.
+
+ PARAMETERS	: pszFileName	- Shader to read.
+			  psShader		- Returns the source strings.
+
+ RETURNS	: IMG_FALSE if the shader couldn't be read.
+*****************************************************************************/
+static IMG_BOOL LoadShader(const IMG_CHAR *pszFileName, PSHADER psShader)
+{
+	IMG_CHAR	*pszString;
+	IMG_UINT32	uSize;
+
+	psShader->pszBuffer = ReadFile(pszFileName, &uSize);
+
+	if (!psShader->pszBuffer)
+	{
+		return IMG_FALSE;
+	}
+
+	pszString = psShader->pszBuffer;
+
+	psShader->apszStrings[0]	= pszString;
+	psShader->uNumStrings		= 1;
+
+	while ((pszString = strchr(pszString, '\f')) != IMG_NULL && psShader->uNumStrings < MAX_SOURCE_STRINGS)
+	{
+		*pszString++ = '\0';
+
+		psShader->apszStrings[psShader->uNumStrings++] = pszString;
+	}
+
+	return IMG_TRUE;
+}
+
+/*****************************************************************************
+ FUNCTION	: DumpStartOfLine
+
+ PURPOSE	: Describes where a token's pszStartOfLine points, without
+			  using the address itself.
+
+ PARAMETERS	: psDump		- Dump to append to.
+			  psShader		- Source strings of the shader.
+			  psToken		- Token to describe.
+
+ RETURNS	: IMG_FALSE if out of memory.
+*****************************************************************************/
+static IMG_BOOL DumpStartOfLine(PDUMP psDump, PSHADER psShader, Token *psToken)
+{
+	IMG_UINT32 i;
+
+	/* Version and extension changes store a value in pszStartOfLine */
+	if (psToken->eTokenName == TOK_LANGUAGE_VERSION ||
+		(psToken->eTokenName == TOK_INTCONSTANT && !psToken->pvData))
+	{
+		return DumpPrintf(psDump, " sol=#%lu", (unsigned long)(IMG_UINTPTR_T)psToken->pszStartOfLine);
+	}
+
+	if (!psToken->pszStartOfLine)
+	{
+		return DumpPrintf(psDump, " sol=null");
+	}
+
+	for (i = 0; i < psShader->uNumStrings; i++)
+	{
+		IMG_CHAR *pszString = psShader->apszStrings[i];
+
+		if (psToken->pszStartOfLine >= pszString && psToken->pszStartOfLine <= pszString + strlen(pszString))
+		{
+			return DumpPrintf(psDump, " sol=%u:%ld", i, (long)(psToken->pszStartOfLine - pszString));
+		}
+	}
+
+	return DumpPrintf(psDump, " sol=other");
+}
+
+/*****************************************************************************
+ FUNCTION	: PreprocessShader
+
+ PURPOSE	: Lexes and preprocesses a shader and dumps the result.
+
+ PARAMETERS	: psShader		- Shader to preprocess.
+			  uIterations	- Number of times to run the preprocessor.
+			  psDump		- Dump to append to.
+			  pdSeconds		- Returns the time spent preprocessing.
+
+ RETURNS	: IMG_FALSE if the lexer failed or the tool ran out of memory.
+*****************************************************************************/
+static IMG_BOOL PreprocessShader(PSHADER psShader, IMG_UINT32 uIterations, PDUMP psDump, double *pdSeconds)
+{
+	GLSLCompilerPrivateData	sCPD;
+	ErrorLog				sErrorLog;
+	GLSLPreProcessorData	*psPPData		= IMG_NULL;
+	Token					*psTokens		= IMG_NULL;
+	Token					*psNewTokens	= IMG_NULL;
+	IMG_UINT32				uNumTokens		= 0;
+	IMG_UINT32				uNumNewTokens	= 0;
+	IMG_UINT32				i;
+	IMG_BOOL				bSuccess		= IMG_FALSE;
+	IMG_BOOL				bOK				= IMG_TRUE;
+	clock_t					sTime			= 0;
+
+	memset(&sCPD, 0, sizeof(sCPD));
+	sCPD.psErrorLog = &sErrorLog;
+
+	for (i = 0; i < uIterations; i++)
+	{
+		clock_t sStart;
+
+		SetErrorLog(&sErrorLog, IMG_FALSE);
+
+		if (!LexGeneratePreprocessorTokens(&sCPD, (const IMG_CHAR **)psShader->apszStrings, psShader->uNumStrings, &psTokens, &uNumTokens))
+		{
+			FreeErrorLogMessages(&sErrorLog);
+			return IMG_FALSE;
+		}
+
+		psPPData		= IMG_NULL;
+		psNewTokens		= IMG_NULL;
+		uNumNewTokens	= 0;
+
+		sStart = clock();
+		bSuccess = PPPreProcessTokenList(&sCPD, &psPPData, psTokens, uNumTokens, &psNewTokens, &uNumNewTokens);
+		sTime += clock() - sStart;
+
+		/* Keep the results of the last run for the dump */
+		if (i + 1 < uIterations)
+		{
+			if (bSuccess)
+			{
+				LexDestroyTokenList(psNewTokens, uNumNewTokens);
+				PPDestroyPreProcessorData(psPPData);
+			}
+			LexDestroyTokenList(psTokens, uNumTokens);
+			FreeErrorLogMessages(&sErrorLog);
+		}
+	}
+
+	*pdSeconds = (double)sTime / CLOCKS_PER_SEC;
+
+	bOK &= DumpPrintf(psDump, "ok=%d in=%u\n", bSuccess ? 1 : 0, uNumTokens);
+
+	if (bSuccess)
+	{
+		bOK &= DumpPrintf(psDump, "ext=%x n=%u\n", psPPData ? (IMG_UINT32)psPPData->eEnabledExtensions : 0xFFFFFFFFU, uNumNewTokens);
+
+		for (i = 0; i < uNumNewTokens; i++)
+		{
+			Token		*psToken = &psNewTokens[i];
+			IMG_CHAR	acData[256];
+			IMG_UINT32	uLength = 0;
+
+			if (psToken->pvData)
+			{
+				while (uLength < psToken->uSizeOfDataInBytes && uLength < sizeof(acData) - 1 && ((IMG_CHAR *)psToken->pvData)[uLength])
+				{
+					acData[uLength] = ((IMG_CHAR *)psToken->pvData)[uLength];
+					uLength++;
+				}
+				acData[uLength] = '\0';
+			}
+			else
+			{
+				strcpy(acData, "<null>");
+			}
+
+			bOK &= DumpPrintf(psDump, "%u: n=%d sz=%u s=%u l=%u c=%u d='%s'",
+							  i,
+							  psToken->eTokenName,
+							  psToken->uSizeOfDataInBytes,
+							  psToken->uStringNumber,
+							  psToken->uLineNumber,
+							  psToken->uCharNumber,
+							  acData);
+			bOK &= DumpStartOfLine(psDump, psShader, psToken);
+			bOK &= DumpPrintf(psDump, "\n");
+		}
+
+		LexDestroyTokenList(psNewTokens, uNumNewTokens);
+		PPDestroyPreProcessorData(psPPData);
+	}
+
+	for (i = 0; i < sErrorLog.uTotalNumErrorMessages && i < MAX_ERROR_MESSAGES; i++)
+	{
+		ErrorMessage *psMessage = &sErrorLog.sErrorMessages[i];
+
+		bOK &= DumpPrintf(psDump, "E%u t=%d c=%u: %s", i, psMessage->eErrorType, psMessage->uCharNumber, psMessage->pszErrorMessageString);
+	}
+
+	LexDestroyTokenList(psTokens, uNumTokens);
+	FreeErrorLogMessages(&sErrorLog);
+
+	return bOK;
+}
+
+/*****************************************************************************
+ FUNCTION	: main
+
+ PURPOSE	: Entry point.
+
+ PARAMETERS	: argc, argv	- Command line.
+
+ RETURNS	: 0 if every shader matched its reference.
+*****************************************************************************/
+int main(int argc, char **argv)
+{
+	IMG_BOOL	bUpdate			= IMG_FALSE;
+	IMG_BOOL	bVerbose		= IMG_FALSE;
+	IMG_UINT32	uIterations		= 1;
+	IMG_UINT32	uNumShaders		= 0;
+	IMG_UINT32	uNumFailed		= 0;
+	double		dTotalSeconds	= 0.0;
+	int			i;
+
+	for (i = 1; i < argc && argv[i][0] == '-'; i++)
+	{
+		if (strcmp(argv[i], "-u") == 0)
+		{
+			bUpdate = IMG_TRUE;
+		}
+		else if (strcmp(argv[i], "-v") == 0)
+		{
+			bVerbose = IMG_TRUE;
+		}
+		else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc)
+		{
+			uIterations = (IMG_UINT32)strtoul(argv[++i], IMG_NULL, 0);
+			if (!uIterations)
+			{
+				uIterations = 1;
+			}
+		}
+		else
+		{
+			Usage();
+			return 1;
+		}
+	}
+
+	if (i == argc)
+	{
+		Usage();
+		return 1;
+	}
+
+	for (; i < argc; i++)
+	{
+		SHADER		sShader;
+		DUMP		sDump = {IMG_NULL, 0, 0};
+		IMG_CHAR	acReference[1024];
+		double		dSeconds = 0.0;
+
+		memset(&sShader, 0, sizeof(sShader));
+
+		uNumShaders++;
+
+		if (!LoadShader(argv[i], &sShader))
+		{
+			fprintf(stderr, "%s: can't read shader\n", argv[i]);
+			uNumFailed++;
+			continue;
+		}
+
+		if (!PreprocessShader(&sShader, uIterations, &sDump, &dSeconds))
+		{
+			fprintf(stderr, "%s: lexer failed or out of memory\n", argv[i]);
+			uNumFailed++;
+		}
+		else
+		{
+			IMG_CHAR	*pszReference;
+			IMG_UINT32	uReferenceSize = 0;
+
+			dTotalSeconds += dSeconds;
+
+			if (bVerbose)
+			{
+				fwrite(sDump.pszData, 1, sDump.uSize, stdout);
+			}
+
+			sprintf(acReference, "%.1000s.pp", argv[i]);
+
+			if (bUpdate)
+			{
+				FILE *psFile = fopen(acReference, "wb");
+
+				if (!psFile || fwrite(sDump.pszData, 1, sDump.uSize, psFile) != sDump.uSize)
+				{
+					fprintf(stderr, "%s: can't write reference\n", acReference);
+					uNumFailed++;
+				}
+
+				if (psFile)
+				{
+					fclose(psFile);
+				}
+			}
+			else if ((pszReference = ReadFile(acReference, &uReferenceSize)) == IMG_NULL)
+			{
+				fprintf(stderr, "%s: no reference\n", acReference);
+				uNumFailed++;
+			}
+			else
+			{
+				if (uReferenceSize != sDump.uSize || memcmp(pszReference, sDump.pszData, sDump.uSize) != 0)
+				{
+					IMG_UINT32 uOffset = 0, uLine = 1;
+
+					while (uOffset < uReferenceSize && uOffset < sDump.uSize && pszReference[uOffset] == sDump.pszData[uOffset])
+					{
+						if (pszReference[uOffset] == '\n')
+						{
+							uLine++;
+						}
+						uOffset++;
+					}
+
+					fprintf(stderr, "%s: output differs from reference at line %u\n", argv[i], uLine);
+					uNumFailed++;
+				}
+
+				free(pszReference);
+			}
+
+			if (uIterations > 1)
+			{
+				printf("%s: %.3f ms per run\n", argv[i], dSeconds * 1000.0 / uIterations);
+			}
+		}
+
+		free(sDump.pszData);
+		free(sShader.pszBuffer);
+	}
+
+	if (uIterations > 1)
+	{
+		printf("Total: %.3f ms per run\n", dTotalSeconds * 1000.0 / uIterations);
+	}
+
+	printf("%u of %u shaders %s\n", uNumShaders - uNumFailed, uNumShaders, bUpdate ? "recorded" : "matched");
+
+	return uNumFailed ? 1 : 0;
+}
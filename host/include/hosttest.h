@@ -0,0 +1,72 @@
+/******************************************************************************
+ * Name         : hosttest.h
+ * Title        : Host test helpers
+ *
+ * Copyright    : 2010 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means,electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Description  : The checks and pseudo-random numbers the host tests share.
+ *                Each test is a single main.c, so the state is static and
+ *                main reports ui32Failures itself.
+ *
+ * Modifications:-
+ * $Log: hosttest.h $
+ *****************************************************************************/
+
+#ifndef _HOSTTEST_H_
+#define _HOSTTEST_H_
+
+#include <stdio.h>
+
+#include "img_types.h"
+#include "img_defs.h"
+
+static IMG_UINT32 ui32Failures = 0;
+
+/* Tests may reseed this for a repeatable sequence per case */
+static IMG_UINT32 ui32Random = 12345;
+
+static INLINE IMG_VOID Check(IMG_BOOL bCondition, const IMG_CHAR *pszTest, const IMG_CHAR *pszWhat)
+{
+	if (!bCondition)
+	{
+		fprintf(stderr, "FAIL %s: %s\n", pszTest, pszWhat);
+		ui32Failures++;
+	}
+}
+
+static INLINE IMG_VOID CheckCount(IMG_UINT32 ui32Got, IMG_UINT32 ui32Expected, const IMG_CHAR *pszTest, const IMG_CHAR *pszWhat)
+{
+	if (ui32Got != ui32Expected)
+	{
+		fprintf(stderr, "FAIL %s: %s is %u, expected %u\n", pszTest, pszWhat, ui32Got, ui32Expected);
+		ui32Failures++;
+	}
+}
+
+/* 24 random bits */
+static INLINE IMG_UINT32 Random(IMG_VOID)
+{
+	ui32Random = ui32Random * 1103515245U + 12345U;
+
+	return ui32Random >> 8;
+}
+
+static INLINE IMG_UINT32 Random32(IMG_VOID)
+{
+	return (Random() << 16) ^ Random();
+}
+
+#endif /* _HOSTTEST_H_ */
+
+/******************************************************************************
+ End of file (hosttest.h)
+******************************************************************************/
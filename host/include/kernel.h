@@ -0,0 +1,41 @@
+/******************************************************************************
+ * Name         : kernel.h
+ * Title        : Host test stand-in
+ *
+ * Copyright    : 2010 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means,electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Description  : The SDK kernel semaphore calls services.h wraps, for
+ *                host tests that build driver code as for the device.
+ *                Tests that reach them implement them, eglfencewaittest
+ *                with pthreads; the others never call them.
+ *
+ * Modifications:-
+ * $Log: kernel.h $
+ *****************************************************************************/
+
+#ifndef _KERNEL_H_
+#define _KERNEL_H_
+
+#include "scetypes.h"
+
+#define SCE_KERNEL_ERROR_WAIT_TIMEOUT	0x80028005
+
+SceUID sceKernelCreateSema(const char *pName, SceUInt32 attr, SceInt32 initCount, SceInt32 maxCount, void *pOptParam);
+int sceKernelDeleteSema(SceUID semaId);
+int sceKernelWaitSema(SceUID semaId, SceInt32 needCount, SceUInt32 *pTimeout);
+int sceKernelSignalSema(SceUID semaId, SceInt32 signalCount);
+
+#endif /* _KERNEL_H_ */
+
+/******************************************************************************
+ End of file (kernel.h)
+******************************************************************************/
@@ -0,0 +1,39 @@
+/******************************************************************************
+ * Name         : scetypes.h
+ * Title        : Host test stand-in
+ *
+ * Copyright    : 2010 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means,electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Description  : The SDK types pvr2d.h and the PSP2 services headers use.
+ *
+ * Modifications:-
+ * $Log: scetypes.h $
+ *****************************************************************************/
+
+#ifndef _SCETYPES_H_
+#define _SCETYPES_H_
+
+#include <stdint.h>
+
+typedef int32_t		SceInt32;
+typedef uint32_t	SceUInt32;
+typedef int32_t		SceUID;
+typedef uint32_t	SceSize;
+
+#define SCE_NULL	((void *)0)
+#define SCE_OK		0
+
+#endif /* _SCETYPES_H_ */
+
+/******************************************************************************
+ End of file (scetypes.h)
+******************************************************************************/
@@ -0,0 +1,34 @@
+# Copyright	2010 Imagination Technologies Limited. All rights reserved.
+#
+# No part of this software, either material or conceptual may be
+# copied or distributed, transmitted, transcribed, stored in a
+# retrieval system or translated into any human or computer
+# language in any form by any means, electronic, mechanical,
+# manual or other-wise, or disclosed to third parties without
+# the express written permission of: Imagination Technologies
+# Limited, HomePark Industrial Estate, Kings Langley,
+# Hertfordshire, WD4 8LZ, UK
+#
+# $Log: Linux.mk $
+#
+
+# pds.c is built for the SGX543 MP4 of the device, the core the pixel event
+# programs in intermediates/ are generated for. It is a DEBUG build so that
+# PDS_ASSERT failures are counted by the test.
+modules := pdspatchtest
+
+pdspatchtest_type := host_executable
+
+pdspatchtest_target := pdspatchtest
+
+pdspatchtest_src = \
+ main.c \
+ $(TOP)/codegen/pds/pds.c
+
+pdspatchtest_cflags := -DDEBUG -DPDS_BUILD_OPENGLES \
+ -DLINUX -DSGX543 -DSGX_CORE_REV=216 -DSGX_FEATURE_MP \
+ -DSGX_FEATURE_MP_CORE_COUNT=4 -DSGX_FEATURE_SYSTEM_CACHE
+
+pdspatchtest_includes := include4 include/gpu_es4 hwdefs include \
+ eurasiacon/include eurasiacon/common codegen/pds \
+ intermediates/pixelevent intermediates/pixelevent_tilexy host/include
@@ -0,0 +1,879 @@
+/******************************************************************************
+ * Name         : main.c
+ * Title        : PDS program patching tests (pdspatchtest)
+ *
+ * Copyright    : 2010 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means,electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Description  : Builds codegen/pds/pds.c on the host and checks that a
+ *                program made by patching a previously generated one is
+ *                identical to generating it from scratch.
+ *
+ *                Vertex programs are reused the way the GLES2 driver's
+ *                cache does: a program is generated for a random stream
+ *                layout, then copied and retargeted with
+ *                PDSRetargetVertexShaderProgram for other stream addresses
+ *                and USE task control words with the same
+ *                PDSGetVertexShaderProgramKey key. Changing any layout
+ *                field must change the key.
+ *
+ *                Pixel and secondary attribute programs are reused the way
+ *                the GLES drivers' per USE variant templates are: a copy of
+ *                a program generated with PDSGeneratePixelShaderProgram or
+ *                PDSGeneratePixelShaderSAProgram is patched for new texture,
+ *                USE task and DMA control words. Patching a program of a
+ *                different layout must fail.
+ *
+ *                Built for the SGX543 MP4 of the device; the pixel event
+ *                programs in intermediates/ are only generated for that
+ *                core, so the FIX_HW_BRN_25339 cores do not link here.
+ *
+ *                Exits with a non-zero status if a check fails; -v also
+ *                times patching against generating.
+ *
+ * Modifications:-
+ * $Log: main.c $
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <time.h>
+
+#include "img_types.h"
+#include "img_defs.h"
+#include "sgxdefs.h"
+#include "pvr_debug.h"
+#include "pds.h"
+#include "hosttest.h"
+
+#define TEST_PROGRAMS			2000
+#define TEST_BENCH_PROGRAMS		100000
+
+/* Large enough for any program generated here, data and code */
+#define TEST_PROGRAM_DWORDS		1024
+
+/* Words generation is expected to overwrite are filled with these first */
+#define TEST_FILL_TEMPLATE		0xA5A5A5A5U
+#define TEST_FILL_REFERENCE		0x5A5A5A5AU
+
+/* GLES2 feeds at most this many attributes; a stream may carry several */
+#define TEST_MAX_VERTEX_ELEMENTS	16
+
+/* Pixel programs of this many iterators keep within the PDS data store constants */
+#define TEST_MAX_FPU_ITERATORS		16
+#define TEST_TEXTURE_IMAGE_UNITS	16
+
+#define TEST_VERTEX_KEY_DWORDS	PDS_VERTEX_SHADER_PROGRAM_KEY_DWORDS(PDS_NUM_VERTEX_STREAMS, TEST_MAX_VERTEX_ELEMENTS)
+
+static IMG_BOOL bVerbose = IMG_FALSE;
+static IMG_UINT32 ui32Asserts = 0;
+
+/* pds.c is built with DEBUG, so PDS_ASSERT lands here */
+IMG_VOID IMG_CALLCONV PVRSRVDebugAssertFail(const IMG_CHAR *pszFile, IMG_UINT32 ui32Line)
+{
+	fprintf(stderr, "FAIL assertion at %s:%u\n", pszFile, ui32Line);
+	ui32Asserts++;
+}
+
+IMG_VOID IMG_CALLCONV PVRSRVDebugPrintf(IMG_UINT32 ui32DebugLevel,
+										const IMG_CHAR *pszFileName,
+										IMG_UINT32 ui32Line,
+										const IMG_CHAR *pszFormat,
+										...)
+{
+	PVR_UNREFERENCED_PARAMETER(ui32DebugLevel);
+	PVR_UNREFERENCED_PARAMETER(pszFileName);
+	PVR_UNREFERENCED_PARAMETER(ui32Line);
+	PVR_UNREFERENCED_PARAMETER(pszFormat);
+}
+
+static IMG_UINT64 TimeNs(IMG_VOID)
+{
+	struct timespec sTime;
+
+	clock_gettime(CLOCK_MONOTONIC, &sTime);
+
+	return (IMG_UINT64)sTime.tv_sec * 1000000000 + (IMG_UINT64)sTime.tv_nsec;
+}
+
+static IMG_UINT32 *AllocProgram(IMG_VOID)
+{
+	/* malloc alignment covers EURASIA_PDS_BASEADD_ALIGNSHIFT */
+	IMG_UINT32 *pui32Program = malloc(TEST_PROGRAM_DWORDS * sizeof(IMG_UINT32));
+
+	if (!pui32Program)
+	{
+		fprintf(stderr, "out of memory\n");
+		exit(2);
+	}
+
+	return pui32Program;
+}
+
+static IMG_VOID FillProgram(IMG_UINT32 *pui32Program, IMG_UINT32 ui32Value)
+{
+	IMG_UINT32 i;
+
+	for (i = 0; i < TEST_PROGRAM_DWORDS; i++)
+	{
+		pui32Program[i] = ui32Value;
+	}
+}
+
+/*
+	Compares a patched program with two generated from scratch into buffers
+	filled with TEST_FILL_REFERENCE and TEST_FILL_TEMPLATE. Words that differ
+	between the two generated programs are alignment padding the generator
+	never writes, so they are not compared.
+*/
+static IMG_VOID CheckProgram(const IMG_CHAR *pszTest, const IMG_UINT32 *pui32Expected,
+							 const IMG_UINT32 *pui32Unwritten, const IMG_UINT32 *pui32Result)
+{
+	IMG_CHAR szWhat[96];
+	IMG_UINT32 i;
+
+	for (i = 0; i < TEST_PROGRAM_DWORDS; i++)
+	{
+		if ((pui32Expected[i] == pui32Unwritten[i]) && (pui32Expected[i] != pui32Result[i]))
+		{
+			snprintf(szWhat, sizeof(szWhat), "dword %u is 0x%08x, generated 0x%08x",
+					 i, pui32Result[i], pui32Expected[i]);
+			Check(IMG_FALSE, pszTest, szWhat);
+			return;
+		}
+	}
+}
+
+/*
+	A random stream layout of the sort the GLES drivers set up, with the stream
+	addresses and USE task control words left to RandomVertexTargets
+*/
+static IMG_VOID RandomVertexLayout(PDS_VERTEX_SHADER_PROGRAM *psProgram)
+{
+	IMG_UINT32 ui32Elements = 0, ui32Register = 0, i, j;
+
+	memset(psProgram, 0, sizeof(*psProgram));
+
+	psProgram->b32BitIndices = (Random() & 1) ? IMG_TRUE : IMG_FALSE;
+	psProgram->ui32NumStreams = 1 + Random() % PDS_NUM_VERTEX_STREAMS;
+
+	for (i = 0; i < psProgram->ui32NumStreams; i++)
+	{
+		PDS_VERTEX_STREAM *psStream = &psProgram->asStreams[i];
+
+		/* A few streams merge attributes the way GLES2 does */
+		psStream->ui32NumElements = ((Random() % 4) == 0) ? 2 : 1;
+
+		if (ui32Elements + psStream->ui32NumElements > TEST_MAX_VERTEX_ELEMENTS)
+		{
+			psProgram->ui32NumStreams = i;
+			break;
+		}
+
+		/* Current attribute state is one vertex for all */
+		if ((Random() % 8) == 0)
+		{
+			psStream->ui32Stride = 0;
+			psStream->ui32Shift = 31;
+		}
+		else
+		{
+			psStream->ui32Stride = 4 * (1 + Random() % 16);
+		}
+
+		for (j = 0; j < psStream->ui32NumElements; j++)
+		{
+			PDS_VERTEX_ELEMENT *psElement = &psStream->asElements[j];
+
+			psElement->ui32Offset = 4 * (Random() % 8);
+			psElement->ui32Size = 1 + Random() % 16;
+			psElement->ui32Register = ui32Register;
+
+			ui32Register += 4;
+		}
+
+		ui32Elements += psStream->ui32NumElements;
+	}
+
+	if ((Random() % 4) == 0)
+	{
+		psProgram->bIterateVtxID = IMG_TRUE;
+		psProgram->ui32VtxIDRegister = ui32Register;
+		psProgram->ui32VtxIDOffset = (Random() & 1) ? (Random() % 1000) : 0;
+
+		ui32Register += 4;
+	}
+
+	if ((Random() % 4) == 0)
+	{
+		psProgram->bIterateInstanceID = IMG_TRUE;
+		psProgram->ui32InstanceIDRegister = ui32Register;
+		psProgram->ui32InstanceIDOffset = (Random() & 1) ? (Random() % 1000) : 0;
+	}
+}
+
+static IMG_VOID RandomVertexTargets(PDS_VERTEX_SHADER_PROGRAM *psProgram)
+{
+	IMG_UINT32 i;
+
+	for (i = 0; i < psProgram->ui32NumStreams; i++)
+	{
+		psProgram->asStreams[i].ui32Address = Random32() & ~3U;
+	}
+
+	for (i = 0; i < PDS_NUM_USE_TASK_CONTROL_WORDS; i++)
+	{
+		psProgram->aui32USETaskControl[i] = Random32();
+	}
+}
+
+static IMG_UINT32 GenerateVertexProgram(PDS_VERTEX_SHADER_PROGRAM *psProgram, IMG_UINT32 *pui32Program,
+										PDS_VERTEX_SHADER_PROGRAM_INFO *psInfo)
+{
+	IMG_UINT32 *pui32End = PDSGenerateVertexShaderProgram(psProgram, pui32Program, psInfo);
+
+	return (IMG_UINT32)(pui32End - pui32Program);
+}
+
+static IMG_BOOL SameKey(const IMG_UINT32 *pui32KeyA, IMG_UINT32 ui32SizeA,
+						const IMG_UINT32 *pui32KeyB, IMG_UINT32 ui32SizeB)
+{
+	return ((ui32SizeA == ui32SizeB) && (memcmp(pui32KeyA, pui32KeyB, ui32SizeA * sizeof(IMG_UINT32)) == 0)) ? IMG_TRUE : IMG_FALSE;
+}
+
+/*
+	Changes one field of the layout that affects the generated code; returns
+	IMG_FALSE if the chosen field cannot be changed in this layout
+*/
+static IMG_BOOL MutateVertexLayout(PDS_VERTEX_SHADER_PROGRAM *psProgram, IMG_UINT32 ui32Field)
+{
+	PDS_VERTEX_STREAM *psStream = &psProgram->asStreams[Random() % psProgram->ui32NumStreams];
+	PDS_VERTEX_ELEMENT *psElement = &psStream->asElements[Random() % psStream->ui32NumElements];
+
+	switch (ui32Field)
+	{
+		case 0:
+			psProgram->b32BitIndices = !psProgram->b32BitIndices;
+			return IMG_TRUE;
+		case 1:
+			psProgram->ui32NumInstances++;
+			return IMG_TRUE;
+		case 2:
+			psStream->ui32Stride += 4;
+			return IMG_TRUE;
+		case 3:
+			psStream->ui32Shift ^= 1;
+			return IMG_TRUE;
+		case 4:
+			psStream->ui32Multiplier++;
+			return IMG_TRUE;
+		case 5:
+			psStream->bInstanceData = !psStream->bInstanceData;
+			return IMG_TRUE;
+		case 6:
+			psElement->ui32Offset += 4;
+			return IMG_TRUE;
+		case 7:
+			psElement->ui32Size = (psElement->ui32Size % 16) + 1;
+			return IMG_TRUE;
+		case 8:
+			psElement->ui32Register += 4;
+			return IMG_TRUE;
+		case 9:
+			if (psStream->ui32NumElements == PDS_NUM_VERTEX_ELEMENTS)
+			{
+				return IMG_FALSE;
+			}
+			psStream->asElements[psStream->ui32NumElements].ui32Offset = 0;
+			psStream->asElements[psStream->ui32NumElements].ui32Size = 4;
+			psStream->asElements[psStream->ui32NumElements].ui32Register = 0;
+			psStream->ui32NumElements++;
+			return IMG_TRUE;
+		case 10:
+			if (psProgram->ui32NumStreams == 1)
+			{
+				return IMG_FALSE;
+			}
+			psProgram->ui32NumStreams--;
+			return IMG_TRUE;
+		case 11:
+			psProgram->bIterateVtxID = !psProgram->bIterateVtxID;
+			return IMG_TRUE;
+		case 12:
+			if (!psProgram->bIterateVtxID)
+			{
+				return IMG_FALSE;
+			}
+			psProgram->ui32VtxIDOffset++;
+			return IMG_TRUE;
+		case 13:
+			psProgram->bIterateInstanceID = !psProgram->bIterateInstanceID;
+			return IMG_TRUE;
+		case 14:
+			if (!psProgram->bIterateInstanceID)
+			{
+				return IMG_FALSE;
+			}
+			psProgram->ui32InstanceIDRegister += 4;
+			return IMG_TRUE;
+		default:
+			return IMG_FALSE;
+	}
+}
+
+#define VERTEX_LAYOUT_FIELDS	15
+
+static IMG_VOID TestVertexPrograms(IMG_VOID)
+{
+	IMG_UINT32 *pui32Template = AllocProgram();
+	IMG_UINT32 *pui32Patched = AllocProgram();
+	IMG_UINT32 *pui32Reference = AllocProgram();
+	IMG_UINT32 *pui32Unwritten = AllocProgram();
+	IMG_UINT32 aui32KeyA[TEST_VERTEX_KEY_DWORDS], aui32KeyB[TEST_VERTEX_KEY_DWORDS];
+	IMG_UINT32 ui32Programs = 0, ui32Mutations = 0, n;
+	IMG_CHAR szTest[64];
+
+	for (n = 0; n < TEST_PROGRAMS; n++)
+	{
+		static PDS_VERTEX_SHADER_PROGRAM sProgramA, sProgramB;
+		PDS_VERTEX_SHADER_PROGRAM_INFO sTemplateInfo, sInfo, sReferenceInfo;
+		IMG_UINT32 ui32TemplateSize, ui32ReferenceSize, ui32KeySizeA, ui32KeySizeB, ui32Field;
+
+		snprintf(szTest, sizeof(szTest), "vertex program %u", n);
+
+		RandomVertexLayout(&sProgramA);
+		RandomVertexTargets(&sProgramA);
+
+		sProgramB = sProgramA;
+		RandomVertexTargets(&sProgramB);
+
+		ui32KeySizeA = PDSGetVertexShaderProgramKey(&sProgramA, aui32KeyA, TEST_VERTEX_KEY_DWORDS);
+		ui32KeySizeB = PDSGetVertexShaderProgramKey(&sProgramB, aui32KeyB, TEST_VERTEX_KEY_DWORDS);
+
+		Check(SameKey(aui32KeyA, ui32KeySizeA, aui32KeyB, ui32KeySizeB), szTest, "key depends on the stream addresses or task control");
+
+		/* The cached program, generated for A */
+		FillProgram(pui32Template, TEST_FILL_TEMPLATE);
+		ui32TemplateSize = GenerateVertexProgram(&sProgramA, pui32Template, &sTemplateInfo);
+
+		/* A cache hit for B */
+		FillProgram(pui32Patched, TEST_FILL_REFERENCE);
+		memcpy(pui32Patched, pui32Template, ui32TemplateSize * sizeof(IMG_UINT32));
+		sInfo = sTemplateInfo;
+
+		PDSRetargetVertexShaderProgram(&sProgramB, &sInfo, pui32Patched);
+
+		FillProgram(pui32Reference, TEST_FILL_REFERENCE);
+		ui32ReferenceSize = GenerateVertexProgram(&sProgramB, pui32Reference, &sReferenceInfo);
+
+		FillProgram(pui32Unwritten, TEST_FILL_TEMPLATE);
+		GenerateVertexProgram(&sProgramB, pui32Unwritten, &sReferenceInfo);
+
+		Check((ui32ReferenceSize == ui32TemplateSize) ? IMG_TRUE : IMG_FALSE, szTest, "generated size differs");
+		CheckProgram(szTest, pui32Reference, pui32Unwritten, pui32Patched);
+
+		ui32Programs++;
+
+		/* Any change to the layout must miss the cache */
+		ui32Field = Random() % VERTEX_LAYOUT_FIELDS;
+
+		if (MutateVertexLayout(&sProgramB, ui32Field))
+		{
+			IMG_CHAR szWhat[64];
+
+			ui32KeySizeB = PDSGetVertexShaderProgramKey(&sProgramB, aui32KeyB, TEST_VERTEX_KEY_DWORDS);
+
+			snprintf(szWhat, sizeof(szWhat), "key ignores layout field %u", ui32Field);
+			Check(!SameKey(aui32KeyA, ui32KeySizeA, aui32KeyB, ui32KeySizeB), szTest, szWhat);
+
+			ui32Mutations++;
+		}
+	}
+
+	if (bVerbose)
+	{
+		printf("vertex: %u programs retargeted, %u layout changes checked\n", ui32Programs, ui32Mutations);
+	}
+
+	free(pui32Template);
+	free(pui32Patched);
+	free(pui32Reference);
+	free(pui32Unwritten);
+}
+
+/* Generating a vertex program from scratch against retargeting a cached copy */
+static IMG_VOID BenchmarkVertexPrograms(IMG_VOID)
+{
+	static PDS_VERTEX_SHADER_PROGRAM sProgram;
+	PDS_VERTEX_SHADER_PROGRAM_INFO sTemplateInfo, sInfo;
+	IMG_UINT32 *pui32Template = AllocProgram();
+	IMG_UINT32 *pui32Program = AllocProgram();
+	IMG_UINT32 aui32Key[TEST_VERTEX_KEY_DWORDS];
+	IMG_UINT32 ui32Size, ui32KeySize = 0, i;
+	IMG_UINT64 ui64Start, ui64GenerateNs, ui64RetargetNs;
+
+	/* Eight attributes in their own streams, as a typical GLES2 vertex shader */
+	RandomVertexLayout(&sProgram);
+
+	sProgram.ui32NumStreams = 8;
+	sProgram.bIterateVtxID = IMG_FALSE;
+	sProgram.bIterateInstanceID = IMG_FALSE;
+
+	for (i = 0; i < sProgram.ui32NumStreams; i++)
+	{
+		sProgram.asStreams[i].ui32NumElements = 1;
+		sProgram.asStreams[i].asElements[0].ui32Register = i * 4;
+	}
+
+	RandomVertexTargets(&sProgram);
+
+	ui32Size = GenerateVertexProgram(&sProgram, pui32Template, &sTemplateInfo);
+
+	ui64Start = TimeNs();
+
+	for (i = 0; i < TEST_BENCH_PROGRAMS; i++)
+	{
+		sProgram.asStreams[0].ui32Address = i << 4;
+
+		GenerateVertexProgram(&sProgram, pui32Program, &sInfo);
+	}
+
+	ui64GenerateNs = TimeNs() - ui64Start;
+
+	ui64Start = TimeNs();
+
+	for (i = 0; i < TEST_BENCH_PROGRAMS; i++)
+	{
+		sProgram.asStreams[0].ui32Address = i << 4;
+
+		/* The key is built for the cache lookup as well */
+		ui32KeySize += PDSGetVertexShaderProgramKey(&sProgram, aui32Key, TEST_VERTEX_KEY_DWORDS);
+
+		memcpy(pui32Program, pui32Template, ui32Size * sizeof(IMG_UINT32));
+		sInfo = sTemplateInfo;
+
+		PDSRetargetVertexShaderProgram(&sProgram, &sInfo, pui32Program);
+	}
+
+	ui64RetargetNs = TimeNs() - ui64Start;
+
+	printf("vertex program of %u streams (%u dwords, %u dword key): generate %llu ns, retarget %llu ns\n",
+		   sProgram.ui32NumStreams, ui32Size, ui32KeySize / TEST_BENCH_PROGRAMS,
+		   (unsigned long long)(ui64GenerateNs / TEST_BENCH_PROGRAMS),
+		   (unsigned long long)(ui64RetargetNs / TEST_BENCH_PROGRAMS));
+
+	free(pui32Template);
+	free(pui32Program);
+}
+
+static IMG_VOID RandomTextureImageUnits(PDS_TEXTURE_IMAGE_UNIT *psUnits)
+{
+	IMG_UINT32 i;
+
+	for (i = 0; i < TEST_TEXTURE_IMAGE_UNITS; i++)
+	{
+		psUnits[i].ui32TAGControlWord0 = Random32();
+		psUnits[i].ui32TAGControlWord1 = Random32();
+		psUnits[i].ui32TAGControlWord2 = Random32();
+#if (EURASIA_TAG_TEXTURE_STATE_SIZE == 4)
+		psUnits[i].ui32TAGControlWord3 = Random32();
+#endif
+	}
+}
+
+/*
+	FPU iterators of the sort a fragment USE variant fixes, with the USE task
+	control words left to RandomPixelTargets
+*/
+static IMG_VOID RandomPixelLayout(PDS_PIXEL_SHADER_PROGRAM *psProgram)
+{
+	IMG_UINT32 ui32Reads = 0, i;
+
+	memset(psProgram, 0, sizeof(*psProgram));
+
+	psProgram->ui32NumFPUIterators = Random() % (TEST_MAX_FPU_ITERATORS + 1);
+
+	for (i = 0; i < psProgram->ui32NumFPUIterators; i++)
+	{
+		/* Some iterations issue no texture read and may be combined with the next */
+		IMG_UINT32 ui32TexIssue = ((Random() % 4) == 0) ? EURASIA_PDS_DOUTI_TEXISSUE_NONE : 0;
+
+#if (EURASIA_PDS_DOUTI_STATE_SIZE == 1)
+		psProgram->aui32FPUIterators[i] = (Random32() & EURASIA_PDS_DOUTI_TEXISSUE_CLRMSK) | ui32TexIssue;
+#else
+		psProgram->aui32FPUIterators0[i] = (Random32() & EURASIA_PDS_DOUTI_TEXISSUE_CLRMSK) | ui32TexIssue;
+		psProgram->aui32FPUIterators1[i] = Random32();
+#endif
+
+		if ((ui32Reads < PDS_MAX_TEXTURE_READS) && (Random() & 1))
+		{
+			psProgram->aui32TAGLayers[i] = Random() % TEST_TEXTURE_IMAGE_UNITS;
+			ui32Reads++;
+		}
+		else
+		{
+			psProgram->aui32TAGLayers[i] = 0xFFFFFFFF;
+		}
+
+#if defined(SGX_FEATURE_PDS_EXTENDED_SOURCES)
+		psProgram->aui8LayerSize[i] = (IMG_UINT8)(Random() % 4);
+		psProgram->aui8FormatConv[i] = (IMG_UINT8)((Random() & 1) ? EURASIA_PDS_MOVS_DOUTT_FCONV_F16 : EURASIA_PDS_MOVS_DOUTT_FCONV_UNCHANGED);
+		psProgram->abMinPack[i] = (Random() & 1) ? IMG_TRUE : IMG_FALSE;
+#endif
+	}
+}
+
+static IMG_VOID RandomPixelTargets(PDS_PIXEL_SHADER_PROGRAM *psProgram)
+{
+	IMG_UINT32 i;
+
+	for (i = 0; i < PDS_NUM_USE_TASK_CONTROL_WORDS; i++)
+	{
+		psProgram->aui32USETaskControl[i] = Random32();
+	}
+}
+
+static IMG_UINT32 GeneratePixelProgram(PDS_TEXTURE_IMAGE_UNIT *psUnits, PDS_PIXEL_SHADER_PROGRAM *psProgram,
+									   IMG_UINT32 *pui32Program, PDS_PIXEL_SHADER_PROGRAM_INFO *psInfo)
+{
+	IMG_UINT32 *pui32End = PDSGeneratePixelShaderProgram(psUnits, psProgram, pui32Program, psInfo);
+
+	return (IMG_UINT32)(pui32End - pui32Program);
+}
+
+static IMG_VOID TestPixelPrograms(IMG_VOID)
+{
+	static PDS_TEXTURE_IMAGE_UNIT asUnitsA[TEST_TEXTURE_IMAGE_UNITS], asUnitsB[TEST_TEXTURE_IMAGE_UNITS];
+	IMG_UINT32 *pui32Template = AllocProgram();
+	IMG_UINT32 *pui32Patched = AllocProgram();
+	IMG_UINT32 *pui32Reference = AllocProgram();
+	IMG_UINT32 *pui32Unwritten = AllocProgram();
+	IMG_UINT32 ui32Programs = 0, ui32Rejected = 0, n;
+	IMG_CHAR szTest[64];
+
+	for (n = 0; n < TEST_PROGRAMS; n++)
+	{
+		static PDS_PIXEL_SHADER_PROGRAM sProgramA, sProgramB, sReferenceProgram;
+		PDS_PIXEL_SHADER_PROGRAM_INFO sTemplateInfo, sInfo;
+		IMG_UINT32 ui32TemplateSize, ui32ReferenceSize, i;
+		IMG_BOOL bPatched;
+
+		snprintf(szTest, sizeof(szTest), "pixel program %u", n);
+
+		RandomPixelLayout(&sProgramA);
+		RandomPixelTargets(&sProgramA);
+		RandomTextureImageUnits(asUnitsA);
+
+		sProgramB = sProgramA;
+		RandomPixelTargets(&sProgramB);
+		RandomTextureImageUnits(asUnitsB);
+
+		/* The USE variant's template, generated for A */
+		FillProgram(pui32Template, TEST_FILL_TEMPLATE);
+		ui32TemplateSize = GeneratePixelProgram(asUnitsA, &sProgramA, pui32Template, &sTemplateInfo);
+
+		Check((sTemplateInfo.ui32DataSize == sProgramA.ui32DataSize) ? IMG_TRUE : IMG_FALSE, szTest, "info data size differs");
+
+		/* A PDS variant miss for B */
+		FillProgram(pui32Patched, TEST_FILL_REFERENCE);
+		memcpy(pui32Patched, pui32Template, ui32TemplateSize * sizeof(IMG_UINT32));
+		sInfo = sTemplateInfo;
+
+		bPatched = PDSPatchPixelShaderProgram(&sInfo, asUnitsB, &sProgramB, pui32Patched);
+
+		Check(bPatched, szTest, "patching a program of the same layout failed");
+
+		sReferenceProgram = sProgramB;
+
+		FillProgram(pui32Reference, TEST_FILL_REFERENCE);
+		ui32ReferenceSize = GeneratePixelProgram(asUnitsB, &sReferenceProgram, pui32Reference, IMG_NULL);
+
+		FillProgram(pui32Unwritten, TEST_FILL_TEMPLATE);
+		GeneratePixelProgram(asUnitsB, &sReferenceProgram, pui32Unwritten, IMG_NULL);
+
+		Check((ui32ReferenceSize == ui32TemplateSize) ? IMG_TRUE : IMG_FALSE, szTest, "generated size differs");
+		Check((sProgramB.ui32DataSize == sReferenceProgram.ui32DataSize) ? IMG_TRUE : IMG_FALSE, szTest, "patched data size differs");
+		Check((sProgramB.pui32DataSegment == pui32Patched) ? IMG_TRUE : IMG_FALSE, szTest, "patched data segment differs");
+		CheckProgram(szTest, pui32Reference, pui32Unwritten, pui32Patched);
+
+		ui32Programs++;
+
+		/* A program reading other units, or with other iterators, must not be patched */
+		for (i = 0; i < sProgramB.ui32NumFPUIterators; i++)
+		{
+			if (sProgramB.aui32TAGLayers[i] != 0xFFFFFFFF)
+			{
+				break;
+			}
+		}
+
+		if ((Random() & 1) && (i < sProgramB.ui32NumFPUIterators))
+		{
+			sProgramB.aui32TAGLayers[i] = (sProgramB.aui32TAGLayers[i] + 1) % TEST_TEXTURE_IMAGE_UNITS;
+		}
+		else if (sProgramB.ui32NumFPUIterators < TEST_MAX_FPU_ITERATORS)
+		{
+			sProgramB.aui32TAGLayers[sProgramB.ui32NumFPUIterators++] = 0xFFFFFFFF;
+		}
+		else
+		{
+			continue;
+		}
+
+		Check(!PDSPatchPixelShaderProgram(&sTemplateInfo, asUnitsB, &sProgramB, pui32Patched), szTest, "patched a program of another layout");
+
+		ui32Rejected++;
+	}
+
+	if (bVerbose)
+	{
+		printf("pixel: %u programs patched, %u other layouts rejected\n", ui32Programs, ui32Rejected);
+	}
+
+	free(pui32Template);
+	free(pui32Patched);
+	free(pui32Reference);
+	free(pui32Unwritten);
+}
+
+static IMG_VOID RandomSALayout(PDS_PIXEL_SHADER_SA_PROGRAM *psProgram)
+{
+	memset(psProgram, 0, sizeof(*psProgram));
+
+	psProgram->ui32NumDMAKicks = Random() % (PDS_NUM_DMA_KICKS + 1);
+
+	/* The dummy program is kicked when the shader has no secondary update of its own */
+	switch (Random() % 3)
+	{
+		case 0:
+			psProgram->bKickUSE = IMG_TRUE;
+			break;
+		case 1:
+			psProgram->bKickUSEDummyProgram = IMG_TRUE;
+			break;
+		default:
+			break;
+	}
+
+	psProgram->bWriteTilePosition = (Random() & 1) ? IMG_TRUE : IMG_FALSE;
+
+#if defined(SGX_FEATURE_ALPHATEST_SECONDARY)
+	psProgram->bIterateZAbs = (Random() & 1) ? IMG_TRUE : IMG_FALSE;
+#endif
+}
+
+static IMG_VOID RandomSATargets(PDS_PIXEL_SHADER_SA_PROGRAM *psProgram)
+{
+	IMG_UINT32 i;
+
+	for (i = 0; i < PDS_NUM_DMA_KICKS * PDS_NUM_DMA_CONTROL_WORDS; i++)
+	{
+		psProgram->aui32DMAControl[i] = Random32();
+	}
+
+	for (i = 0; i < PDS_NUM_USE_TASK_CONTROL_WORDS; i++)
+	{
+		psProgram->aui32USETaskControl[i] = Random32();
+	}
+
+	psProgram->uTilePositionAttrDest = Random() % 64;
+}
+
+static IMG_UINT32 GenerateSAProgram(PDS_PIXEL_SHADER_SA_PROGRAM *psProgram, IMG_UINT32 *pui32Program,
+									PDS_PIXEL_SHADER_SA_PROGRAM_INFO *psInfo)
+{
+	IMG_UINT32 *pui32End = PDSGeneratePixelShaderSAProgram(psProgram, pui32Program, psInfo);
+
+	return (IMG_UINT32)(pui32End - pui32Program);
+}
+
+static IMG_VOID TestSAPrograms(IMG_VOID)
+{
+	IMG_UINT32 *pui32Template = AllocProgram();
+	IMG_UINT32 *pui32Patched = AllocProgram();
+	IMG_UINT32 *pui32Reference = AllocProgram();
+	IMG_UINT32 *pui32Unwritten = AllocProgram();
+	IMG_UINT32 ui32Programs = 0, ui32Dummy = 0, n;
+	IMG_CHAR szTest[64];
+
+	for (n = 0; n < TEST_PROGRAMS; n++)
+	{
+		PDS_PIXEL_SHADER_SA_PROGRAM sProgramA, sProgramB, sReferenceProgram;
+		PDS_PIXEL_SHADER_SA_PROGRAM_INFO sTemplateInfo;
+		IMG_UINT32 ui32TemplateSize, ui32ReferenceSize;
+
+		snprintf(szTest, sizeof(szTest), "secondary attribute program %u", n);
+
+		RandomSALayout(&sProgramA);
+		RandomSATargets(&sProgramA);
+
+		sProgramB = sProgramA;
+		RandomSATargets(&sProgramB);
+
+		FillProgram(pui32Template, TEST_FILL_TEMPLATE);
+		ui32TemplateSize = GenerateSAProgram(&sProgramA, pui32Template, &sTemplateInfo);
+
+		FillProgram(pui32Patched, TEST_FILL_REFERENCE);
+		memcpy(pui32Patched, pui32Template, ui32TemplateSize * sizeof(IMG_UINT32));
+
+		Check(PDSPatchPixelShaderSAProgram(&sTemplateInfo, &sProgramB, pui32Patched), szTest, "patching a program of the same layout failed");
+
+		sReferenceProgram = sProgramB;
+
+		FillProgram(pui32Reference, TEST_FILL_REFERENCE);
+		ui32ReferenceSize = GenerateSAProgram(&sReferenceProgram, pui32Reference, IMG_NULL);
+
+		FillProgram(pui32Unwritten, TEST_FILL_TEMPLATE);
+		GenerateSAProgram(&sReferenceProgram, pui32Unwritten, IMG_NULL);
+
+		Check((ui32ReferenceSize == ui32TemplateSize) ? IMG_TRUE : IMG_FALSE, szTest, "generated size differs");
+		Check((sProgramB.ui32DataSize == sReferenceProgram.ui32DataSize) ? IMG_TRUE : IMG_FALSE, szTest, "patched data size differs");
+		CheckProgram(szTest, pui32Reference, pui32Unwritten, pui32Patched);
+
+		ui32Programs++;
+
+		if (sProgramA.bKickUSEDummyProgram)
+		{
+			ui32Dummy++;
+		}
+
+		/* Any layout flag or DMA kick count that differs must be rejected */
+		switch (Random() % 3)
+		{
+			case 0:
+				sProgramB.ui32NumDMAKicks = (sProgramB.ui32NumDMAKicks + 1) % (PDS_NUM_DMA_KICKS + 1);
+				break;
+			case 1:
+				sProgramB.bWriteTilePosition = !sProgramB.bWriteTilePosition;
+				break;
+			default:
+				if (sProgramB.bKickUSE || sProgramB.bKickUSEDummyProgram)
+				{
+					sProgramB.bKickUSE = IMG_FALSE;
+					sProgramB.bKickUSEDummyProgram = IMG_FALSE;
+				}
+				else
+				{
+					sProgramB.bKickUSEDummyProgram = IMG_TRUE;
+				}
+				break;
+		}
+
+		Check(!PDSPatchPixelShaderSAProgram(&sTemplateInfo, &sProgramB, pui32Patched), szTest, "patched a program of another layout");
+	}
+
+	if (bVerbose)
+	{
+		printf("secondary attributes: %u programs patched, %u of them kicking the dummy program\n", ui32Programs, ui32Dummy);
+	}
+
+	free(pui32Template);
+	free(pui32Patched);
+	free(pui32Reference);
+	free(pui32Unwritten);
+}
+
+/* Generating a pixel program from scratch against patching the USE variant's template */
+static IMG_VOID BenchmarkPixelPrograms(IMG_VOID)
+{
+	static PDS_TEXTURE_IMAGE_UNIT asUnits[TEST_TEXTURE_IMAGE_UNITS];
+	static PDS_PIXEL_SHADER_PROGRAM sProgram;
+	PDS_PIXEL_SHADER_PROGRAM_INFO sInfo;
+	IMG_UINT32 *pui32Template = AllocProgram();
+	IMG_UINT32 *pui32Program = AllocProgram();
+	IMG_UINT32 ui32Size, i;
+	IMG_UINT64 ui64Start, ui64GenerateNs, ui64PatchNs;
+
+	/* Four texture reads and four iterated varyings */
+	RandomPixelLayout(&sProgram);
+
+	sProgram.ui32NumFPUIterators = 8;
+
+	for (i = 0; i < sProgram.ui32NumFPUIterators; i++)
+	{
+		sProgram.aui32TAGLayers[i] = (i < 4) ? i : 0xFFFFFFFF;
+	}
+
+	RandomPixelTargets(&sProgram);
+	RandomTextureImageUnits(asUnits);
+
+	ui32Size = GeneratePixelProgram(asUnits, &sProgram, pui32Template, &sInfo);
+
+	ui64Start = TimeNs();
+
+	for (i = 0; i < TEST_BENCH_PROGRAMS; i++)
+	{
+		asUnits[0].ui32TAGControlWord2 = i << 4;
+
+		GeneratePixelProgram(asUnits, &sProgram, pui32Program, IMG_NULL);
+	}
+
+	ui64GenerateNs = TimeNs() - ui64Start;
+
+	ui64Start = TimeNs();
+
+	for (i = 0; i < TEST_BENCH_PROGRAMS; i++)
+	{
+		asUnits[0].ui32TAGControlWord2 = i << 4;
+
+		memcpy(pui32Program, pui32Template, ui32Size * sizeof(IMG_UINT32));
+
+		PDSPatchPixelShaderProgram(&sInfo, asUnits, &sProgram, pui32Program);
+	}
+
+	ui64PatchNs = TimeNs() - ui64Start;
+
+	printf("pixel program of %u iterators (%u dwords): generate %llu ns, copy + patch %llu ns\n",
+		   sProgram.ui32NumFPUIterators, ui32Size,
+		   (unsigned long long)(ui64GenerateNs / TEST_BENCH_PROGRAMS),
+		   (unsigned long long)(ui64PatchNs / TEST_BENCH_PROGRAMS));
+
+	free(pui32Template);
+	free(pui32Program);
+}
+
+int main(int argc, char **argv)
+{
+	if ((argc == 2) && (strcmp(argv[1], "-v") == 0))
+	{
+		bVerbose = IMG_TRUE;
+	}
+	else if (argc != 1)
+	{
+		fprintf(stderr, "Usage: %s [-v]\n", argv[0]);
+		return 2;
+	}
+
+	TestVertexPrograms();
+	TestPixelPrograms();
+	TestSAPrograms();
+
+	if (bVerbose)
+	{
+		BenchmarkVertexPrograms();
+		BenchmarkPixelPrograms();
+	}
+
+	if (ui32Failures || ui32Asserts)
+	{
+		printf("%u checks and %u assertions failed\n", ui32Failures, ui32Asserts);
+		return 1;
+	}
+
+	printf("all checks passed\n");
+	return 0;
+}
+
+/******************************************************************************
+ End of file (main.c)
+******************************************************************************/
@@ -0,0 +1,38 @@
+# Copyright	2010 Imagination Technologies Limited. All rights reserved.
+#
+# No part of this software, either material or conceptual may be
+# copied or distributed, transmitted, transcribed, stored in a
+# retrieval system or translated into any human or computer
+# language in any form by any means, electronic, mechanical,
+# manual or other-wise, or disclosed to third parties without
+# the express written permission of: Imagination Technologies
+# Limited, HomePark Industrial Estate, Kings Langley,
+# Hertfordshire, WD4 8LZ, UK
+#
+# $Log: Linux.mk $
+#
+
+# binshader.c is the OpenGL ES 2 driver's reader. gles2context.h is
+# force-included ahead of it and stands in for the driver's context.h.
+modules := progbintest
+
+progbintest_type := host_executable
+
+progbintest_target := progbintest
+
+progbintest_src = \
+ main.c \
+ $(TOP)/eurasiacon/opengles2/binshader.c \
+ $(TOP)/tools/intern/oglcompiler/binshader/esbinshader.c
+
+progbintest_cflags := \
+ -DGLSL_ES -DOUTPUT_USPBIN -DSUPPORT_OPENGLES2 \
+ -DGLES2_EXTENSION_GET_PROGRAM_BINARY -DSUPPORT_BINARY_SHADER \
+ -DUSER -DSUPPORT_SGX -DSUPPORT_SGX543 -include psp2_pvr_desc.h \
+ -include gles2context.h
+
+progbintest_includes := host/progbintest include4 include/gpu_es4 hwdefs \
+ services4/include services4/system/psp2 eurasiacon/include \
+ eurasiacon/common eurasiacon/opengles2 tools/intern/oglcompiler/glsl \
+ tools/intern/oglcompiler/powervr tools/intern/oglcompiler/binshader \
+ tools/intern/usp tools/intern/usc2 host/include
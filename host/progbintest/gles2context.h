@@ -0,0 +1,86 @@
+/******************************************************************************
+ * Name         : gles2context.h
+ * Title        : Program binary test stand-in
+ *
+ * Copyright    : 2010 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means,electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Description  : The parts of eurasiacon/opengles2/context.h binshader.c
+ *                uses. It is force-included, and defines _CONTEXT_ so the
+ *                driver's own context.h, which binshader.c finds next to
+ *                itself, is skipped. Allocations go through main.c, which
+ *                counts them.
+ *
+ * Modifications:-
+ * $Log: gles2context.h $
+ *****************************************************************************/
+
+#ifndef _CONTEXT_
+#define _CONTEXT_
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "img_types.h"
+#include "img_defs.h"
+#include "pvr_debug.h"
+#include "glsl2uf.h"
+#include "esbinshader.h"
+
+#define GLES_ASSERT(expr) PVR_ASSERT(expr)
+
+typedef struct GLES2ContextRec GLES2Context;
+
+typedef struct GLES2USESecondaryUploadTaskRec GLES2USESecondaryUploadTask;
+
+/* As in eurasiacon/opengles2/shader.h */
+typedef struct GLES2SharedShaderStateRec
+{
+	GLSLBindingSymbolList	 sBindingSymbolList;
+	GLSLProgramFlags		 eProgramFlags;
+
+	/* Active varying mask */
+	GLSLVaryingMask			eActiveVaryingMask;
+
+	/* Texture coordinate dimensions */
+	IMG_UINT32				aui32TexCoordDims[NUM_TC_REGISTERS];
+
+	/* Texture coordinate precisions */
+	GLSLPrecisionQualifier	aeTexCoordPrecisions[NUM_TC_REGISTERS];
+
+	IMG_VOID			*pvUniPatchShader;
+	IMG_VOID			*pvUniPatchShaderMSAATrans;
+
+	IMG_VOID			*pvBinaryData;
+	IMG_VOID			*pvUniPatchInputMSAATrans;
+
+	/* Secondary attributes upload task */
+	GLES2USESecondaryUploadTask *psSecondaryUploadTask;
+
+	IMG_UINT32 ui32RefCount;
+
+} GLES2SharedShaderState;
+
+IMG_VOID *TestMalloc(IMG_UINT32 ui32Size);
+IMG_VOID *TestCalloc(IMG_UINT32 ui32Size);
+IMG_VOID *TestRealloc(IMG_VOID *pvData, IMG_UINT32 ui32Size);
+IMG_VOID TestFree(IMG_VOID *pvData);
+
+#define GLES2Malloc(X,Y)	TestMalloc(Y)
+#define GLES2Calloc(X,Y)	TestCalloc(Y)
+#define GLES2Realloc(X,Y,Z)	TestRealloc(Y, Z)
+#define GLES2Free(X,Y)		TestFree(Y)
+
+#endif /* _CONTEXT_ */
+
+/******************************************************************************
+ End of file (gles2context.h)
+******************************************************************************/
@@ -0,0 +1,1174 @@
+/******************************************************************************
+ * Name         : main.c
+ * Title        : Program binary tests and benchmark (progbintest)
+ *
+ * Copyright    : 2010 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means,electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Description  : Runs the program binary writer (esbinshader.c) and the
+ *                OpenGL ES 2 driver's reader (binshader.c) on the host,
+ *                with UniPatch replaced by a stand-in that keeps a copy of
+ *                the input it is given.
+ *
+ *                Without options the tool checks that a program written
+ *                with SGXBS_CreateBinaryProgram loads back unchanged, both
+ *                as written (format 2) and rewritten as format 1, that
+ *                every byte of a format 2 binary covered by a hash is
+ *                checked, that truncated binaries and binaries for another
+ *                driver are rejected, and that a load which fails part way
+ *                frees everything it allocated. It exits with a non-zero
+ *                status if a check fails.
+ *
+ *                With -b it times SGXBS_CreateProgramState, the work done
+ *                by glProgramBinaryOES, on the same program in both
+ *                formats.
+ *
+ * Modifications:-
+ * $Log: main.c $
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <time.h>
+
+#include "gles2context.h"
+#include "binshader.h"
+#include "esbinshaderinternal.h"
+#include "pvrversion.h"
+#include "hosttest.h"
+
+#define TEST_MAX_SYMBOLS		64
+#define TEST_MAX_MEMBERS		4
+#define TEST_MAX_NAMES			(TEST_MAX_SYMBOLS * (TEST_MAX_MEMBERS + 1))
+#define TEST_MAX_NAME_LENGTH	16
+#define TEST_MAX_CONSTANTS		512
+#define TEST_MAX_CODE_SIZE		8192
+#define TEST_NUM_USER_BINDINGS	3
+
+/* The format 1 revision header, up to and including the revision size */
+#define TEST_V1_HEADER_SIZE		(SGXBS_MINIMUM_VALID_BINARY_SIZE + 4)
+
+typedef struct _TEST_SHADER_
+{
+	GLSLCompiledUniflexProgram	sProgram;
+	GLSLUniFlexCode				sCode;
+	GLSLBindingSymbolList		sSymbolList;
+	GLSLBindingSymbol			asSymbols[TEST_MAX_SYMBOLS];
+	GLSLBindingSymbol			asMembers[TEST_MAX_SYMBOLS][TEST_MAX_MEMBERS];
+	IMG_CHAR					aszNames[TEST_MAX_NAMES][TEST_MAX_NAME_LENGTH];
+	IMG_FLOAT					afConstants[TEST_MAX_CONSTANTS];
+	IMG_UINT32					aui32UniPatchInput[(sizeof(USP_PC_SHADER) + TEST_MAX_CODE_SIZE) / sizeof(IMG_UINT32)];
+	IMG_UINT32					aui32UniPatchInputMSAATrans[(sizeof(USP_PC_SHADER) + TEST_MAX_CODE_SIZE) / sizeof(IMG_UINT32)];
+} TEST_SHADER;
+
+typedef struct _TEST_PROGRAM_
+{
+	TEST_SHADER					sVertex;
+	TEST_SHADER					sFragment;
+	GLSLAttribUserBinding		asUserBindings[TEST_NUM_USER_BINDINGS];
+	IMG_CHAR					aszUserBindingNames[TEST_NUM_USER_BINDINGS][TEST_MAX_NAME_LENGTH];
+} TEST_PROGRAM;
+
+typedef struct _TEST_STATE_
+{
+	GLES2SharedShaderState		*psVertex;
+	GLES2SharedShaderState		*psFragment;
+	GLSLAttribUserBinding		*psUserBinding;
+} TEST_STATE;
+
+/* What the UniPatch stand-in makes of its input */
+typedef struct _TEST_UNIPATCH_SHADER_
+{
+	IMG_UINT32					ui32Size;
+	IMG_UINT8					aui8Input[1];
+} TEST_UNIPATCH_SHADER;
+
+static IMG_UINT32 ui32LiveAllocations = 0;
+static IMG_UINT32 ui32TotalAllocations = 0;
+static IMG_INT32 i32FailAllocation = -1;
+
+static IMG_UINT32 ui32LiveUniPatchShaders = 0;
+static IMG_UINT32 ui32UnalignedUniPatchInputs = 0;
+static IMG_BOOL bFailUniPatch = IMG_FALSE;
+
+static IMG_UINT32 ui32UniPatchContext;
+
+static IMG_DOUBLE GetTimeMs(IMG_VOID)
+{
+	struct timespec sTime;
+
+	clock_gettime(CLOCK_MONOTONIC, &sTime);
+
+	return (IMG_DOUBLE)sTime.tv_sec * 1000.0 + (IMG_DOUBLE)sTime.tv_nsec / 1000000.0;
+}
+
+/*
+	The driver's allocator, as seen by binshader.c. Allocation number
+	i32FailAllocation (counting from 0) fails.
+*/
+static IMG_BOOL AllocationFails(IMG_VOID)
+{
+	if (i32FailAllocation == 0)
+	{
+		i32FailAllocation = -1;
+		return IMG_TRUE;
+	}
+
+	if (i32FailAllocation > 0)
+	{
+		i32FailAllocation--;
+	}
+
+	return IMG_FALSE;
+}
+
+IMG_VOID *TestMalloc(IMG_UINT32 ui32Size)
+{
+	IMG_VOID *pvData;
+
+	if (AllocationFails())
+	{
+		return IMG_NULL;
+	}
+
+	pvData = malloc(ui32Size);
+
+	if (pvData)
+	{
+		ui32LiveAllocations++;
+		ui32TotalAllocations++;
+	}
+
+	return pvData;
+}
+
+IMG_VOID *TestCalloc(IMG_UINT32 ui32Size)
+{
+	IMG_VOID *pvData;
+
+	if (AllocationFails())
+	{
+		return IMG_NULL;
+	}
+
+	pvData = calloc(1, ui32Size);
+
+	if (pvData)
+	{
+		ui32LiveAllocations++;
+		ui32TotalAllocations++;
+	}
+
+	return pvData;
+}
+
+IMG_VOID *TestRealloc(IMG_VOID *pvData, IMG_UINT32 ui32Size)
+{
+	IMG_VOID *pvNewData;
+
+	if (AllocationFails())
+	{
+		return IMG_NULL;
+	}
+
+	pvNewData = realloc(pvData, ui32Size);
+
+	if (pvNewData && !pvData)
+	{
+		ui32LiveAllocations++;
+		ui32TotalAllocations++;
+	}
+
+	return pvNewData;
+}
+
+IMG_VOID TestFree(IMG_VOID *pvData)
+{
+	if (pvData)
+	{
+		ui32LiveAllocations--;
+		free(pvData);
+	}
+}
+
+/*
+	UniPatch stand-in. The shader keeps a copy of the whole input so that it
+	can be compared with what was written.
+*/
+IMG_PVOID IMG_CALLCONV PVRUniPatchCreateShader(IMG_PVOID pvContext, PUSP_PC_SHADER psPCShader)
+{
+	TEST_UNIPATCH_SHADER *psShader;
+	IMG_UINT32 ui32Size;
+
+	if (bFailUniPatch || pvContext != &ui32UniPatchContext || psPCShader->uId != USP_PC_SHADER_ID)
+	{
+		return IMG_NULL;
+	}
+
+	/* UniPatch reads the input as words */
+	if ((IMG_UINTPTR_T)psPCShader & 3)
+	{
+		ui32UnalignedUniPatchInputs++;
+	}
+
+	ui32Size = sizeof(USP_PC_SHADER) + psPCShader->uSize;
+
+	psShader = malloc(offsetof(TEST_UNIPATCH_SHADER, aui8Input) + ui32Size);
+
+	if (!psShader)
+	{
+		return IMG_NULL;
+	}
+
+	psShader->ui32Size = ui32Size;
+	memcpy(psShader->aui8Input, psPCShader, ui32Size);
+
+	ui32LiveUniPatchShaders++;
+
+	return psShader;
+}
+
+IMG_VOID IMG_CALLCONV PVRUniPatchDestroyShader(IMG_PVOID pvContext, IMG_PVOID pvShader)
+{
+	PVR_UNREFERENCED_PARAMETER(pvContext);
+
+	ui32LiveUniPatchShaders--;
+	free(pvShader);
+}
+
+static IMG_VOID *WriterMalloc(IMG_UINT32 ui32Size)
+{
+	return malloc(ui32Size);
+}
+
+static IMG_VOID WriterFree(IMG_VOID *pvData)
+{
+	free(pvData);
+}
+
+/*
+	Fills in a compiled shader. Every fifth symbol is a struct with up to
+	TEST_MAX_MEMBERS members; ui32CodeSize need not be a multiple of four.
+*/
+static IMG_VOID SetupShader(TEST_SHADER *psShader, GLSLProgramType eProgramType, IMG_UINT32 ui32NumSymbols,
+							IMG_UINT32 ui32NumConstants, IMG_UINT32 ui32CodeSize, IMG_BOOL bMSAATrans)
+{
+	USP_PC_SHADER *psInput;
+	IMG_UINT32 ui32Name = 0, i, j;
+
+	memset(psShader, 0, sizeof(*psShader));
+
+	psShader->sProgram.eProgramType = eProgramType;
+	psShader->sProgram.eProgramFlags = (eProgramType == GLSLPT_FRAGMENT) ? GLSLPF_DISCARD_EXECUTED : (GLSLProgramFlags)0;
+	psShader->sProgram.bSuccessfullyCompiled = IMG_TRUE;
+	psShader->sProgram.psUniFlexCode = &psShader->sCode;
+	psShader->sProgram.psBindingSymbolList = &psShader->sSymbolList;
+
+	psShader->sCode.eActiveVaryingMask = (GLSLVaryingMask)(GLSLVM_COLOR0 | GLSLVM_TEXCOORD0);
+
+	for (i = 0; i < NUM_TC_REGISTERS; i++)
+	{
+		psShader->sCode.auTexCoordDims[i] = (i < 2) ? 4 : 0;
+		psShader->sCode.aeTexCoordPrecisions[i] = (i < 2) ? GLSLPRECQ_HIGH : (GLSLPrecisionQualifier)0;
+	}
+
+	/* UniPatch inputs: a header and some code */
+	psInput = (USP_PC_SHADER *)psShader->aui32UniPatchInput;
+	psInput->uId = USP_PC_SHADER_ID;
+	psInput->uVersion = USP_PC_SHADER_VER;
+	psInput->uSize = ui32CodeSize;
+
+	for (i = 0; i < ui32CodeSize; i++)
+	{
+		((IMG_UINT8 *)(psInput + 1))[i] = (IMG_UINT8)Random();
+	}
+
+	psShader->sCode.psUniPatchInput = psInput;
+
+	if (bMSAATrans)
+	{
+		psInput = (USP_PC_SHADER *)psShader->aui32UniPatchInputMSAATrans;
+		psInput->uId = USP_PC_SHADER_ID;
+		psInput->uVersion = USP_PC_SHADER_VER;
+		psInput->uSize = ui32CodeSize / 2 + 1;
+
+		for (i = 0; i < psInput->uSize; i++)
+		{
+			((IMG_UINT8 *)(psInput + 1))[i] = (IMG_UINT8)Random();
+		}
+
+		psShader->sCode.psUniPatchInputMSAATrans = psInput;
+	}
+
+	/* Constants */
+	for (i = 0; i < ui32NumConstants; i++)
+	{
+		psShader->afConstants[i] = (IMG_FLOAT)Random() / 1024.0f;
+	}
+
+	psShader->sSymbolList.uNumCompsUsed = ui32NumConstants;
+	psShader->sSymbolList.pfConstantData = ui32NumConstants ? psShader->afConstants : IMG_NULL;
+
+	/* Symbols */
+	for (i = 0; i < ui32NumSymbols; i++)
+	{
+		GLSLBindingSymbol *psSymbol = &psShader->asSymbols[i];
+
+		sprintf(psShader->aszNames[ui32Name], "sym%u", i);
+		psSymbol->pszName = psShader->aszNames[ui32Name++];
+		psSymbol->eTypeQualifier = (eProgramType == GLSLPT_VERTEX && (i & 1)) ? GLSLTQ_VERTEX_IN : GLSLTQ_UNIFORM;
+		psSymbol->ePrecisionQualifier = (i & 2) ? GLSLPRECQ_MEDIUM : GLSLPRECQ_HIGH;
+		psSymbol->eBIVariableID = GLSLBV_NOT_BTIN;
+		psSymbol->iActiveArraySize = 1 + (IMG_INT32)(i % 3);
+		psSymbol->iDeclaredArraySize = (i % 3) ? 4 : 0;
+		psSymbol->sRegisterInfo.u.uBaseComp = Random() & 0x3FF;
+
+		if ((i % 5) == 4)
+		{
+			psSymbol->eTypeSpecifier = GLSLTS_STRUCT;
+			psSymbol->uNumBaseTypeMembers = 1 + i % TEST_MAX_MEMBERS;
+			psSymbol->psBaseTypeMembers = psShader->asMembers[i];
+
+			for (j = 0; j < psSymbol->uNumBaseTypeMembers; j++)
+			{
+				GLSLBindingSymbol *psMember = &psShader->asMembers[i][j];
+
+				sprintf(psShader->aszNames[ui32Name], "sym%u.m%u", i, j);
+				psMember->pszName = psShader->aszNames[ui32Name++];
+				psMember->eTypeSpecifier = (j & 1) ? GLSLTS_FLOAT : GLSLTS_VEC4;
+				psMember->eTypeQualifier = GLSLTQ_UNIFORM;
+				psMember->ePrecisionQualifier = GLSLPRECQ_HIGH;
+				psMember->eBIVariableID = GLSLBV_NOT_BTIN;
+				psMember->iActiveArraySize = 1;
+				psMember->sRegisterInfo.eRegType = HWREG_FLOAT;
+				psMember->sRegisterInfo.u.uBaseComp = Random() & 0x3FF;
+				psMember->sRegisterInfo.uCompAllocCount = (j & 1) ? 1 : 4;
+				psMember->sRegisterInfo.ui32CompUseMask = (j & 1) ? 0x1 : 0xF;
+			}
+		}
+		else if ((i % 5) == 3)
+		{
+			psSymbol->eTypeSpecifier = GLSLTS_SAMPLER2D;
+			psSymbol->sRegisterInfo.eRegType = HWREG_TEX;
+			psSymbol->sRegisterInfo.uCompAllocCount = 1;
+			psSymbol->sRegisterInfo.ui32CompUseMask = 0x1;
+		}
+		else
+		{
+			psSymbol->eTypeSpecifier = (i & 1) ? GLSLTS_MAT4X4 : GLSLTS_VEC4;
+			psSymbol->sRegisterInfo.eRegType = HWREG_FLOAT;
+			psSymbol->sRegisterInfo.uCompAllocCount = (i & 1) ? 16 : 4;
+			psSymbol->sRegisterInfo.ui32CompUseMask = (i & 1) ? 0xFFFF : 0x7;
+		}
+	}
+
+	psShader->sSymbolList.uNumBindings = ui32NumSymbols;
+	psShader->sSymbolList.uMaxBindingEntries = ui32NumSymbols;
+	psShader->sSymbolList.psBindingSymbolEntries = ui32NumSymbols ? psShader->asSymbols : IMG_NULL;
+}
+
+static IMG_VOID SetupProgram(TEST_PROGRAM *psProgram, IMG_UINT32 ui32NumSymbols, IMG_UINT32 ui32NumConstants,
+							 IMG_UINT32 ui32CodeSize, IMG_BOOL bMSAATrans)
+{
+	IMG_UINT32 i;
+
+	SetupShader(&psProgram->sVertex, GLSLPT_VERTEX, ui32NumSymbols, ui32NumConstants, ui32CodeSize, IMG_FALSE);
+	SetupShader(&psProgram->sFragment, GLSLPT_FRAGMENT, ui32NumSymbols / 2, ui32NumConstants / 2, ui32CodeSize / 2 + 3, bMSAATrans);
+
+	for (i = 0; i < TEST_NUM_USER_BINDINGS; i++)
+	{
+		sprintf(psProgram->aszUserBindingNames[i], "attrib%u", i);
+
+		psProgram->asUserBindings[i].pszName = psProgram->aszUserBindingNames[i];
+		psProgram->asUserBindings[i].i32Index = (IMG_INT32)(TEST_NUM_USER_BINDINGS - i);
+		psProgram->asUserBindings[i].psNext = (i + 1 < TEST_NUM_USER_BINDINGS) ? &psProgram->asUserBindings[i + 1] : IMG_NULL;
+	}
+}
+
+/*
+	Writes a program binary the way glGetProgramBinaryOES does: asks for the
+	size first, then writes into a buffer of that size.
+*/
+static IMG_UINT8 *WriteProgramBinary(const TEST_PROGRAM *psProgram, IMG_UINT32 *pui32Length)
+{
+	IMG_UINT32 ui32Size = 0, ui32Length = 0;
+	IMG_UINT8 *pui8Binary, ui8Dummy;
+	SGXBS_Error eError;
+
+	eError = SGXBS_CreateBinaryProgram(&psProgram->sVertex.sProgram, &psProgram->sFragment.sProgram, psProgram->asUserBindings,
+									   1, &ui32Size, &ui8Dummy, IMG_FALSE);
+
+	if (eError != SGXBS_NO_ERROR || !ui32Size)
+	{
+		return IMG_NULL;
+	}
+
+	pui8Binary = malloc(ui32Size);
+
+	if (!pui8Binary)
+	{
+		return IMG_NULL;
+	}
+
+	eError = SGXBS_CreateBinaryProgram(&psProgram->sVertex.sProgram, &psProgram->sFragment.sProgram, psProgram->asUserBindings,
+									   ui32Size, &ui32Length, pui8Binary, IMG_TRUE);
+
+	if (eError != SGXBS_NO_ERROR || ui32Length != ui32Size)
+	{
+		free(pui8Binary);
+		return IMG_NULL;
+	}
+
+	*pui32Length = ui32Length;
+
+	return pui8Binary;
+}
+
+static IMG_VOID WriteBigEndian(IMG_UINT8 *pui8Data, IMG_UINT32 ui32Value, IMG_UINT32 ui32Size)
+{
+	IMG_UINT32 i;
+
+	for (i = 0; i < ui32Size; i++)
+	{
+		pui8Data[i] = (IMG_UINT8)(ui32Value >> ((ui32Size - 1 - i) * 8));
+	}
+}
+
+/*
+	Writes a program in format 1, which SGXBS_CreateBinaryProgram no longer
+	writes. A format 1 program binary is the revision header of a format 1
+	shader binary followed by the bodies of the vertex and fragment shader
+	binaries and the user bindings, so it is put together from the output of
+	SGXBS_CreateBinaryShader.
+*/
+static IMG_UINT8 *WriteProgramBinaryV1(const TEST_PROGRAM *psProgram, IMG_UINT32 *pui32Length)
+{
+	const GLSLAttribUserBinding *psBinding;
+	IMG_VOID *pvVertex = IMG_NULL, *pvFragment = IMG_NULL;
+	IMG_UINT32 ui32VertexLength, ui32FragmentLength, ui32Length, ui32Position;
+	IMG_UINT8 *pui8Binary = IMG_NULL;
+	SGXBS_Hash sHash;
+
+	if (SGXBS_CreateBinaryShader(&psProgram->sVertex.sProgram, WriterMalloc, WriterFree, &pvVertex, &ui32VertexLength) != SGXBS_NO_ERROR ||
+		SGXBS_CreateBinaryShader(&psProgram->sFragment.sProgram, WriterMalloc, WriterFree, &pvFragment, &ui32FragmentLength) != SGXBS_NO_ERROR)
+	{
+		goto Exit;
+	}
+
+	ui32Length = ui32VertexLength + ui32FragmentLength - TEST_V1_HEADER_SIZE + 2;
+
+	for (psBinding = psProgram->asUserBindings; psBinding; psBinding = psBinding->psNext)
+	{
+		ui32Length += strlen(psBinding->pszName) + 1 + 4;
+	}
+
+	pui8Binary = malloc(ui32Length);
+
+	if (!pui8Binary)
+	{
+		goto Exit;
+	}
+
+	memcpy(pui8Binary, pvVertex, ui32VertexLength);
+	memcpy(&pui8Binary[ui32VertexLength], (IMG_UINT8 *)pvFragment + TEST_V1_HEADER_SIZE, ui32FragmentLength - TEST_V1_HEADER_SIZE);
+
+	ui32Position = ui32VertexLength + ui32FragmentLength - TEST_V1_HEADER_SIZE;
+
+	WriteBigEndian(&pui8Binary[ui32Position], TEST_NUM_USER_BINDINGS, 2);
+	ui32Position += 2;
+
+	for (psBinding = psProgram->asUserBindings; psBinding; psBinding = psBinding->psNext)
+	{
+		strcpy((IMG_CHAR *)&pui8Binary[ui32Position], psBinding->pszName);
+		ui32Position += strlen(psBinding->pszName) + 1;
+
+		WriteBigEndian(&pui8Binary[ui32Position], (IMG_UINT32)psBinding->i32Index, 4);
+		ui32Position += 4;
+	}
+
+	/* Program binaries store zero where shader binaries store the DDK build */
+	WriteBigEndian(&pui8Binary[SGXBS_BinaryHeader_size + 8], 0, 4);
+
+	/* Revision size and hash */
+	WriteBigEndian(&pui8Binary[TEST_V1_HEADER_SIZE - 4], ui32Length - TEST_V1_HEADER_SIZE, 4);
+
+	sHash = SGXBS_ComputeHash(&pui8Binary[SGXBS_BinaryHeader_size], ui32Length - SGXBS_BinaryHeader_size);
+
+	WriteBigEndian(&pui8Binary[4], sHash.u32Hash, 4);
+
+	*pui32Length = ui32Length;
+
+Exit:
+	free(pvVertex);
+	free(pvFragment);
+
+	return pui8Binary;
+}
+
+/* Frees a shared state as SharedShaderStateDelRef in shader.c does */
+static IMG_VOID FreeSharedState(GLES2SharedShaderState *psSharedState)
+{
+	IMG_UINT32 i, j;
+
+	if (!psSharedState)
+	{
+		return;
+	}
+
+	if (psSharedState->pvBinaryData)
+	{
+		TestFree(psSharedState->pvBinaryData);
+	}
+	else
+	{
+		for (i = 0; i < psSharedState->sBindingSymbolList.uNumBindings; i++)
+		{
+			GLSLBindingSymbol *psSymbol = &psSharedState->sBindingSymbolList.psBindingSymbolEntries[i];
+
+			TestFree(psSymbol->pszName);
+
+			for (j = 0; j < psSymbol->uNumBaseTypeMembers; j++)
+			{
+				TestFree(psSymbol->psBaseTypeMembers[j].pszName);
+			}
+
+			TestFree(psSymbol->psBaseTypeMembers);
+		}
+
+		TestFree(psSharedState->sBindingSymbolList.psBindingSymbolEntries);
+		TestFree(psSharedState->sBindingSymbolList.pfConstantData);
+	}
+
+	if (psSharedState->pvUniPatchShader)
+	{
+		PVRUniPatchDestroyShader(&ui32UniPatchContext, psSharedState->pvUniPatchShader);
+	}
+
+	if (psSharedState->pvUniPatchShaderMSAATrans)
+	{
+		PVRUniPatchDestroyShader(&ui32UniPatchContext, psSharedState->pvUniPatchShaderMSAATrans);
+	}
+
+	TestFree(psSharedState);
+}
+
+static IMG_VOID FreeState(TEST_STATE *psState)
+{
+	GLSLAttribUserBinding *psBinding, *psNext;
+
+	FreeSharedState(psState->psVertex);
+	FreeSharedState(psState->psFragment);
+
+	for (psBinding = psState->psUserBinding; psBinding; psBinding = psNext)
+	{
+		psNext = psBinding->psNext;
+
+		TestFree(psBinding->pszName);
+		TestFree(psBinding);
+	}
+
+	memset(psState, 0, sizeof(*psState));
+}
+
+static SGXBS_Error LoadProgramBinary(const IMG_UINT8 *pui8Binary, IMG_UINT32 ui32Length, TEST_STATE *psState)
+{
+	/* So a failure that leaves an output untouched is noticed */
+	memset(psState, 0xCD, sizeof(*psState));
+
+	return SGXBS_CreateProgramState(IMG_NULL, pui8Binary, (IMG_INT32)ui32Length, &ui32UniPatchContext,
+									&psState->psVertex, &psState->psFragment, &psState->psUserBinding);
+}
+
+static IMG_VOID CheckNoLeaks(const IMG_CHAR *pszTest)
+{
+	Check(ui32LiveAllocations == 0, pszTest, "allocations left behind");
+	Check(ui32LiveUniPatchShaders == 0, pszTest, "UniPatch shaders left behind");
+}
+
+static IMG_BOOL SameUniPatchInput(const IMG_VOID *pvUniPatchInput, const IMG_VOID *pvInput)
+{
+	IMG_UINT32 ui32Size = sizeof(USP_PC_SHADER) + ((const USP_PC_SHADER *)pvUniPatchInput)->uSize;
+
+	return (IMG_BOOL)(((const USP_PC_SHADER *)pvInput)->uSize == ((const USP_PC_SHADER *)pvUniPatchInput)->uSize &&
+					  memcmp(pvInput, pvUniPatchInput, ui32Size) == 0);
+}
+
+static IMG_BOOL SameUniPatchShader(const IMG_VOID *pvUniPatchInput, const IMG_VOID *pvShader)
+{
+	const TEST_UNIPATCH_SHADER *psShader = pvShader;
+
+	return (IMG_BOOL)(psShader && psShader->ui32Size == sizeof(USP_PC_SHADER) + ((const USP_PC_SHADER *)pvUniPatchInput)->uSize &&
+					  SameUniPatchInput(pvUniPatchInput, psShader->aui8Input));
+}
+
+static IMG_BOOL SameSymbols(const GLSLBindingSymbol *psExpected, const GLSLBindingSymbol *psSymbols, IMG_UINT32 ui32NumSymbols)
+{
+	IMG_UINT32 i;
+
+	for (i = 0; i < ui32NumSymbols; i++)
+	{
+		const GLSLBindingSymbol *psA = &psExpected[i], *psB = &psSymbols[i];
+
+		if (strcmp(psA->pszName, psB->pszName) != 0 ||
+			psA->eTypeSpecifier != psB->eTypeSpecifier ||
+			psA->eTypeQualifier != psB->eTypeQualifier ||
+			psA->ePrecisionQualifier != psB->ePrecisionQualifier ||
+			psA->eVaryingModifierFlags != psB->eVaryingModifierFlags ||
+			psA->iActiveArraySize != psB->iActiveArraySize ||
+			psA->iDeclaredArraySize != psB->iDeclaredArraySize ||
+			psA->sRegisterInfo.eRegType != psB->sRegisterInfo.eRegType ||
+			psA->sRegisterInfo.u.uBaseComp != psB->sRegisterInfo.u.uBaseComp ||
+			psA->sRegisterInfo.uCompAllocCount != psB->sRegisterInfo.uCompAllocCount ||
+			psA->sRegisterInfo.ui32CompUseMask != psB->sRegisterInfo.ui32CompUseMask ||
+			psA->eBIVariableID != psB->eBIVariableID ||
+			psA->uNumBaseTypeMembers != psB->uNumBaseTypeMembers)
+		{
+			return IMG_FALSE;
+		}
+
+		if (psA->uNumBaseTypeMembers &&
+			!SameSymbols(psA->psBaseTypeMembers, psB->psBaseTypeMembers, psA->uNumBaseTypeMembers))
+		{
+			return IMG_FALSE;
+		}
+	}
+
+	return IMG_TRUE;
+}
+
+/*
+	Compares a loaded shader with the one that was written. A format 2 load
+	only keeps the MSAA translucent UniPatch input; the driver makes the
+	shader from it when it is first needed.
+*/
+static IMG_VOID CheckSharedState(const TEST_SHADER *psShader, const GLES2SharedShaderState *psSharedState, const IMG_CHAR *pszTest)
+{
+	const GLSLBindingSymbolList *psSymbolList = &psSharedState->sBindingSymbolList;
+	IMG_UINT32 i;
+
+	if (!psSharedState)
+	{
+		Check(IMG_FALSE, pszTest, "no shared state");
+		return;
+	}
+
+	Check(psSharedState->ui32RefCount == 1, pszTest, "reference count");
+	Check(psSharedState->eProgramFlags == psShader->sProgram.eProgramFlags, pszTest, "program flags");
+	Check(psSharedState->eActiveVaryingMask == psShader->sCode.eActiveVaryingMask, pszTest, "varying mask");
+
+	for (i = 0; i < NUM_TC_REGISTERS; i++)
+	{
+		Check(psSharedState->aui32TexCoordDims[i] == psShader->sCode.auTexCoordDims[i], pszTest, "texture coordinate dimensions");
+		Check(psSharedState->aeTexCoordPrecisions[i] == psShader->sCode.aeTexCoordPrecisions[i], pszTest, "texture coordinate precisions");
+	}
+
+	Check(psSymbolList->uNumCompsUsed == psShader->sSymbolList.uNumCompsUsed &&
+		  (!psSymbolList->uNumCompsUsed ||
+		   memcmp(psSymbolList->pfConstantData, psShader->afConstants, psSymbolList->uNumCompsUsed * sizeof(IMG_FLOAT)) == 0),
+		  pszTest, "constants");
+
+	Check(psSymbolList->uNumBindings == psShader->sSymbolList.uNumBindings &&
+		  SameSymbols(psShader->asSymbols, psSymbolList->psBindingSymbolEntries, psSymbolList->uNumBindings),
+		  pszTest, "symbols");
+
+	Check(SameUniPatchShader(psShader->sCode.psUniPatchInput, psSharedState->pvUniPatchShader), pszTest, "UniPatch input");
+
+	if (psShader->sCode.psUniPatchInputMSAATrans)
+	{
+		if (psSharedState->pvUniPatchInputMSAATrans)
+		{
+			Check(!psSharedState->pvUniPatchShaderMSAATrans, pszTest, "MSAA translucent UniPatch shader made up front");
+			Check(((IMG_UINTPTR_T)psSharedState->pvUniPatchInputMSAATrans & 3) == 0, pszTest, "MSAA translucent UniPatch input unaligned");
+			Check(SameUniPatchInput(psShader->sCode.psUniPatchInputMSAATrans, psSharedState->pvUniPatchInputMSAATrans),
+				  pszTest, "MSAA translucent UniPatch input");
+		}
+		else
+		{
+			Check(SameUniPatchShader(psShader->sCode.psUniPatchInputMSAATrans, psSharedState->pvUniPatchShaderMSAATrans),
+				  pszTest, "MSAA translucent UniPatch input");
+		}
+	}
+	else
+	{
+		Check(!psSharedState->pvUniPatchShaderMSAATrans && !psSharedState->pvUniPatchInputMSAATrans,
+			  pszTest, "unexpected MSAA translucent UniPatch input");
+	}
+}
+
+/* Format 1 builds the user binding list backwards, format 2 keeps its order */
+static IMG_VOID CheckState(const TEST_PROGRAM *psProgram, const TEST_STATE *psState, IMG_BOOL bVersion1, const IMG_CHAR *pszTest)
+{
+	const GLSLAttribUserBinding *psBinding;
+	IMG_UINT32 i = 0;
+
+	CheckSharedState(&psProgram->sVertex, psState->psVertex, pszTest);
+	CheckSharedState(&psProgram->sFragment, psState->psFragment, pszTest);
+
+	for (psBinding = psState->psUserBinding; psBinding && i < TEST_NUM_USER_BINDINGS; psBinding = psBinding->psNext, i++)
+	{
+		const GLSLAttribUserBinding *psExpected = &psProgram->asUserBindings[bVersion1 ? TEST_NUM_USER_BINDINGS - 1 - i : i];
+
+		Check(strcmp(psExpected->pszName, psBinding->pszName) == 0 && psExpected->i32Index == psBinding->i32Index,
+			  pszTest, "user binding");
+	}
+
+	Check(!psBinding && i == TEST_NUM_USER_BINDINGS, pszTest, "number of user bindings");
+}
+
+/*
+	SGXBS_CreateProgramState frees everything itself when it fails, so there
+	is only a state to free after a successful load.
+*/
+static IMG_VOID CheckFailedLoad(const TEST_STATE *psState, const IMG_CHAR *pszTest)
+{
+	Check(!psState->psVertex && !psState->psFragment && !psState->psUserBinding, pszTest, "outputs left pointing at freed memory");
+	CheckNoLeaks(pszTest);
+}
+
+/*
+	Writes a program, loads it back and compares. The binary is scribbled
+	over before the comparison, as glProgramBinaryOES's caller may free it
+	once the call returns.
+*/
+static IMG_VOID TestRoundTrip(const IMG_CHAR *pszTest, IMG_UINT32 ui32NumSymbols, IMG_UINT32 ui32NumConstants,
+							  IMG_UINT32 ui32CodeSize, IMG_BOOL bMSAATrans, IMG_BOOL bVersion1)
+{
+	static TEST_PROGRAM sProgram;
+	TEST_STATE sState;
+	IMG_UINT8 *pui8Binary;
+	IMG_UINT32 ui32Length = 0;
+	SGXBS_Error eError;
+
+	SetupProgram(&sProgram, ui32NumSymbols, ui32NumConstants, ui32CodeSize, bMSAATrans);
+
+	pui8Binary = bVersion1 ? WriteProgramBinaryV1(&sProgram, &ui32Length) : WriteProgramBinary(&sProgram, &ui32Length);
+
+	if (!pui8Binary)
+	{
+		Check(IMG_FALSE, pszTest, "couldn't write the program binary");
+		return;
+	}
+
+	if (!bVersion1)
+	{
+		IMG_UINT32 ui32Magic;
+
+		memcpy(&ui32Magic, pui8Binary, sizeof(ui32Magic));
+
+		Check(ui32Magic == SGXBS_HEADER_MAGIC_NUMBER_V2, pszTest, "not written in format 2");
+	}
+
+	eError = LoadProgramBinary(pui8Binary, ui32Length, &sState);
+
+	Check(eError == SGXBS_NO_ERROR, pszTest, "load failed");
+
+	memset(pui8Binary, 0xCD, ui32Length);
+	free(pui8Binary);
+
+	if (eError == SGXBS_NO_ERROR)
+	{
+		CheckState(&sProgram, &sState, bVersion1, pszTest);
+		FreeState(&sState);
+	}
+	else
+	{
+		CheckFailedLoad(&sState, pszTest);
+	}
+
+	/* Format 1 hands UniPatch its input wherever it lies in the stream */
+	if (!bVersion1)
+	{
+		Check(ui32UnalignedUniPatchInputs == 0, pszTest, "unaligned UniPatch input");
+	}
+
+	ui32UnalignedUniPatchInputs = 0;
+
+	CheckNoLeaks(pszTest);
+}
+
+static IMG_VOID TestRoundTrips(IMG_VOID)
+{
+	TestRoundTrip("round trip", 40, 200, 4093, IMG_TRUE, IMG_FALSE);
+	TestRoundTrip("round trip without MSAA", 40, 200, 4096, IMG_FALSE, IMG_FALSE);
+	TestRoundTrip("round trip of an empty program", 0, 0, 1, IMG_FALSE, IMG_FALSE);
+	TestRoundTrip("round trip at the limits", TEST_MAX_SYMBOLS, TEST_MAX_CONSTANTS, TEST_MAX_CODE_SIZE, IMG_TRUE, IMG_FALSE);
+
+	TestRoundTrip("format 1", 40, 200, 4093, IMG_TRUE, IMG_TRUE);
+	TestRoundTrip("format 1 without MSAA", 40, 200, 4096, IMG_FALSE, IMG_TRUE);
+}
+
+/* Whether changing the byte at ui32Offset must be noticed */
+static IMG_BOOL IsHashed(const IMG_UINT8 *pui8Binary, IMG_UINT32 ui32Offset)
+{
+	SGXBS_V2Header sHeader;
+	SGXBS_V2Section sSection;
+	IMG_UINT32 i;
+
+	memcpy(&sHeader, pui8Binary, SGXBS_V2Header_size);
+
+	if (ui32Offset < SGXBS_V2Header_size + sHeader.u32NumSections * SGXBS_V2Section_size)
+	{
+		return IMG_TRUE;
+	}
+
+	for (i = 0; i < sHeader.u32NumSections; i++)
+	{
+		memcpy(&sSection, &pui8Binary[SGXBS_V2Header_size + i * SGXBS_V2Section_size], SGXBS_V2Section_size);
+
+		if (ui32Offset >= sSection.u32Offset && ui32Offset - sSection.u32Offset < sSection.u32LengthInBytes)
+		{
+			return IMG_TRUE;
+		}
+	}
+
+	/* Padding between sections */
+	return IMG_FALSE;
+}
+
+static IMG_VOID TestCorruption(IMG_VOID)
+{
+	static TEST_PROGRAM sProgram;
+	TEST_STATE sState;
+	SGXBS_V2Header sHeader;
+	SGXBS_Hash sHash;
+	IMG_UINT8 *pui8Binary, *pui8Copy;
+	IMG_UINT32 ui32Length = 0, ui32Offset, ui32Missed = 0, ui32Rejected = 0;
+	SGXBS_Error eError;
+
+	SetupProgram(&sProgram, 12, 40, 301, IMG_TRUE);
+
+	pui8Binary = WriteProgramBinary(&sProgram, &ui32Length);
+	pui8Copy = malloc(ui32Length + 64);
+
+	if (!pui8Binary || !pui8Copy)
+	{
+		Check(IMG_FALSE, "corruption", "couldn't write the program binary");
+		free(pui8Binary);
+		free(pui8Copy);
+		return;
+	}
+
+	/* Every byte the hashes cover is checked; the padding between sections isn't read */
+	for (ui32Offset = 0; ui32Offset < ui32Length; ui32Offset++)
+	{
+		memcpy(pui8Copy, pui8Binary, ui32Length);
+		pui8Copy[ui32Offset] ^= 0xA5;
+
+		eError = LoadProgramBinary(pui8Copy, ui32Length, &sState);
+
+		if (IsHashed(pui8Binary, ui32Offset))
+		{
+			ui32Missed += (eError == SGXBS_NO_ERROR) ? 1 : 0;
+		}
+		else
+		{
+			ui32Rejected += (eError != SGXBS_NO_ERROR) ? 1 : 0;
+		}
+
+		if (eError == SGXBS_NO_ERROR)
+		{
+			CheckState(&sProgram, &sState, IMG_FALSE, "corrupt padding");
+			FreeState(&sState);
+		}
+		else
+		{
+			CheckFailedLoad(&sState, "corruption");
+		}
+	}
+
+	Check(ui32Missed == 0, "corruption", "a changed byte was not noticed");
+	Check(ui32Rejected == 0, "corruption", "a change to the padding was noticed");
+	CheckNoLeaks("corruption");
+
+	/* Truncated binaries */
+	for (ui32Offset = 0; ui32Offset < ui32Length; ui32Offset++)
+	{
+		eError = LoadProgramBinary(pui8Binary, ui32Offset, &sState);
+
+		if (eError == SGXBS_NO_ERROR)
+		{
+			Check(IMG_FALSE, "truncated", "a truncated binary loaded");
+			FreeState(&sState);
+		}
+		else
+		{
+			CheckFailedLoad(&sState, "truncated");
+		}
+	}
+
+	CheckNoLeaks("truncated");
+
+	/* Anything after the end of the binary, such as blob cache padding, is ignored */
+	memcpy(pui8Copy, pui8Binary, ui32Length);
+	memset(&pui8Copy[ui32Length], 0xEE, 64);
+
+	eError = LoadProgramBinary(pui8Copy, ui32Length + 64, &sState);
+
+	Check(eError == SGXBS_NO_ERROR, "trailing data", "load failed");
+
+	if (eError == SGXBS_NO_ERROR)
+	{
+		CheckState(&sProgram, &sState, IMG_FALSE, "trailing data");
+		FreeState(&sState);
+	}
+	else
+	{
+		CheckFailedLoad(&sState, "trailing data");
+	}
+
+	CheckNoLeaks("trailing data");
+
+	/* A binary for another driver is intact but has no revision for this one */
+	for (ui32Offset = 0; ui32Offset < 3; ui32Offset++)
+	{
+		memcpy(pui8Copy, pui8Binary, ui32Length);
+		memcpy(&sHeader, pui8Copy, SGXBS_V2Header_size);
+
+		switch (ui32Offset)
+		{
+			case 0:  sHeader.u16SoftwareVersion++; break;
+			case 1:  sHeader.u32CompiledGLSLVersion++; break;
+			default: sHeader.u32USPPCShaderVersion++; break;
+		}
+
+		memcpy(pui8Copy, &sHeader, SGXBS_V2Header_size);
+
+		sHash = SGXBS_ComputeHash(&pui8Copy[2 * sizeof(IMG_UINT32)],
+								  SGXBS_V2Header_size + sHeader.u32NumSections * SGXBS_V2Section_size - 2 * sizeof(IMG_UINT32));
+
+		memcpy(&pui8Copy[sizeof(IMG_UINT32)], &sHash.u32Hash, sizeof(IMG_UINT32));
+
+		eError = LoadProgramBinary(pui8Copy, ui32Length, &sState);
+
+		Check(eError == SGXBS_MISSING_REVISION_ERROR, "other driver", "unexpected error");
+
+		if (eError == SGXBS_NO_ERROR)
+		{
+			FreeState(&sState);
+		}
+		else
+		{
+			CheckFailedLoad(&sState, "other driver");
+		}
+	}
+
+	CheckNoLeaks("other driver");
+
+	free(pui8Copy);
+	free(pui8Binary);
+}
+
+/*
+	Fails each allocation of a load in turn, then UniPatch. A load that fails
+	must free everything it allocated.
+*/
+static IMG_VOID TestFailures(const IMG_CHAR *pszTest, IMG_BOOL bVersion1)
+{
+	static TEST_PROGRAM sProgram;
+	TEST_STATE sState;
+	IMG_UINT8 *pui8Binary;
+	IMG_UINT32 ui32Length = 0;
+	IMG_INT32 i32Allocation;
+	SGXBS_Error eError = SGXBS_OUT_OF_MEMORY_ERROR;
+
+	SetupProgram(&sProgram, 10, 20, 100, IMG_TRUE);
+
+	pui8Binary = bVersion1 ? WriteProgramBinaryV1(&sProgram, &ui32Length) : WriteProgramBinary(&sProgram, &ui32Length);
+
+	if (!pui8Binary)
+	{
+		Check(IMG_FALSE, pszTest, "couldn't write the program binary");
+		return;
+	}
+
+	for (i32Allocation = 0; eError != SGXBS_NO_ERROR && i32Allocation < 10000; i32Allocation++)
+	{
+		i32FailAllocation = i32Allocation;
+
+		eError = LoadProgramBinary(pui8Binary, ui32Length, &sState);
+
+		if (eError == SGXBS_NO_ERROR)
+		{
+			CheckState(&sProgram, &sState, bVersion1, pszTest);
+			FreeState(&sState);
+		}
+		else
+		{
+			Check(eError == SGXBS_OUT_OF_MEMORY_ERROR, pszTest, "unexpected error");
+			CheckFailedLoad(&sState, pszTest);
+		}
+
+		CheckNoLeaks(pszTest);
+	}
+
+	i32FailAllocation = -1;
+
+	Check(eError == SGXBS_NO_ERROR, pszTest, "load never succeeded");
+
+	bFailUniPatch = IMG_TRUE;
+
+	eError = LoadProgramBinary(pui8Binary, ui32Length, &sState);
+
+	bFailUniPatch = IMG_FALSE;
+
+	if (eError == SGXBS_NO_ERROR)
+	{
+		Check(IMG_FALSE, pszTest, "UniPatch failure ignored");
+		FreeState(&sState);
+	}
+	else
+	{
+		CheckFailedLoad(&sState, pszTest);
+	}
+
+	ui32UnalignedUniPatchInputs = 0;
+
+	CheckNoLeaks(pszTest);
+
+	free(pui8Binary);
+}
+
+/*
+	Times ui32NumLoads loads of the same program in each format.
+*/
+static IMG_VOID Benchmark(IMG_UINT32 ui32NumSymbols, IMG_UINT32 ui32NumConstants, IMG_UINT32 ui32CodeSize, IMG_UINT32 ui32NumLoads)
+{
+	static TEST_PROGRAM sProgram;
+	const IMG_CHAR *apszFormats[2] = {"format 1", "format 2"};
+	IMG_UINT32 ui32Format;
+
+	SetupProgram(&sProgram, ui32NumSymbols, ui32NumConstants, ui32CodeSize, IMG_TRUE);
+
+	printf("%u loads, vertex shader of %u symbols, %u constants and %u bytes of code\n",
+		   ui32NumLoads, ui32NumSymbols, ui32NumConstants, ui32CodeSize);
+
+	for (ui32Format = 0; ui32Format < 2; ui32Format++)
+	{
+		TEST_STATE sState;
+		IMG_UINT8 *pui8Binary;
+		IMG_UINT32 ui32Length = 0, ui32Allocations, i;
+		IMG_DOUBLE dStart, dMs;
+
+		pui8Binary = ui32Format ? WriteProgramBinary(&sProgram, &ui32Length) : WriteProgramBinaryV1(&sProgram, &ui32Length);
+
+		if (!pui8Binary)
+		{
+			fprintf(stderr, "progbintest: couldn't write the program binary\n");
+			exit(1);
+		}
+
+		ui32Allocations = ui32TotalAllocations;
+		dStart = GetTimeMs();
+
+		for (i = 0; i < ui32NumLoads; i++)
+		{
+			if (LoadProgramBinary(pui8Binary, ui32Length, &sState) != SGXBS_NO_ERROR)
+			{
+				fprintf(stderr, "progbintest: load failed\n");
+				exit(1);
+			}
+
+			FreeState(&sState);
+		}
+
+		dMs = GetTimeMs() - dStart;
+		ui32Allocations = ui32TotalAllocations - ui32Allocations;
+
+		printf("  %s: %6u bytes  %9.2f us per load  %5u allocations per load\n",
+			   apszFormats[ui32Format], ui32Length, dMs * 1000.0 / ui32NumLoads, ui32Allocations / ui32NumLoads);
+
+		free(pui8Binary);
+	}
+}
+
+static IMG_VOID Usage(IMG_VOID)
+{
+	fprintf(stderr, "Usage: progbintest [-b] [-n <loads>] [-s <symbols>] [-c <constants>] [-u <bytes>]\n\n");
+	fprintf(stderr, "  Runs the program binary tests, or with -b times <loads> loads (10000)\n");
+	fprintf(stderr, "  of a program in each format. The vertex shader has <symbols> symbols\n");
+	fprintf(stderr, "  (40), <constants> constants (200) and <bytes> of code (4096); the\n");
+	fprintf(stderr, "  fragment shader has half as many.\n");
+}
+
+int main(int argc, char **argv)
+{
+	IMG_BOOL bBenchmark = IMG_FALSE;
+	IMG_UINT32 ui32NumLoads = 10000;
+	IMG_UINT32 ui32NumSymbols = 40;
+	IMG_UINT32 ui32NumConstants = 200;
+	IMG_UINT32 ui32CodeSize = 4096;
+	int i;
+
+	for (i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-b") == 0)
+		{
+			bBenchmark = IMG_TRUE;
+		}
+		else if ((strcmp(argv[i], "-n") == 0 || strcmp(argv[i], "-s") == 0 ||
+				  strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "-u") == 0) && i + 1 < argc)
+		{
+			IMG_UINT32 ui32Value = (IMG_UINT32)strtoul(argv[i + 1], IMG_NULL, 0);
+
+			switch (argv[i][1])
+			{
+				case 'n': ui32NumLoads = ui32Value; break;
+				case 's': ui32NumSymbols = ui32Value; break;
+				case 'c': ui32NumConstants = ui32Value; break;
+				default:  ui32CodeSize = ui32Value; break;
+			}
+
+			i++;
+		}
+		else
+		{
+			Usage();
+			return 1;
+		}
+	}
+
+	if (!ui32NumLoads || ui32NumSymbols > TEST_MAX_SYMBOLS || ui32NumConstants > TEST_MAX_CONSTANTS ||
+		!ui32CodeSize || ui32CodeSize > TEST_MAX_CODE_SIZE)
+	{
+		Usage();
+		return 1;
+	}
+
+	if (bBenchmark)
+	{
+		Benchmark(ui32NumSymbols, ui32NumConstants, ui32CodeSize, ui32NumLoads);
+		return 0;
+	}
+
+	/* The format 2 structures are read in place, so they must not be padded */
+	Check(SGXBS_TestBinaryShaderInterface(), "interface", "a structure is padded");
+
+	TestRoundTrips();
+	TestCorruption();
+	TestFailures("out of memory", IMG_FALSE);
+	TestFailures("format 1 out of memory", IMG_TRUE);
+
+	if (ui32Failures)
+	{
+		fprintf(stderr, "%u checks failed\n", ui32Failures);
+		return 1;
+	}
+
+	printf("All program binary tests passed\n");
+
+	return 0;
+}
+
+/******************************************************************************
+ End of file (main.c)
+******************************************************************************/
@@ -0,0 +1,27 @@
+# Copyright	2010 Imagination Technologies Limited. All rights reserved.
+#
+# No part of this software, either material or conceptual may be
+# copied or distributed, transmitted, transcribed, stored in a
+# retrieval system or translated into any human or computer
+# language in any form by any means, electronic, mechanical,
+# manual or other-wise, or disclosed to third parties without
+# the express written permission of: Imagination Technologies
+# Limited, HomePark Industrial Estate, Kings Langley,
+# Hertfordshire, WD4 8LZ, UK
+#
+# $Log: Linux.mk $
+#
+
+modules := psp2pacingtest
+
+psp2pacingtest_type := host_executable
+
+psp2pacingtest_target := psp2pacingtest
+
+# psp2_pacing.c reads no clock of its own, so it is built unchanged and
+# driven by the simulated display controller in main.c.
+psp2pacingtest_src = \
+ main.c \
+ $(TOP)/eurasiacon/wsegl/psp2_pacing.c
+
+psp2pacingtest_includes := include4 eurasiacon/wsegl host/include
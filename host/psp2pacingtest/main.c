@@ -0,0 +1,508 @@
+/******************************************************************************
+ * Name         : main.c
+ * Title        : PSP2 swap pacing tests (psp2pacingtest)
+ *
+ * Copyright    : 2010 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means, electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Description  : Runs the window system's swap pacer
+ *                (eurasiacon/wsegl/psp2_pacing.c) against a simulated
+ *                display controller: a vblank clock, and a flip queue that
+ *                shows each flip swap interval vblanks after the last one
+ *                (at once for interval 0) and blocks the swapping thread
+ *                while too many flips are pending. Applications with
+ *                fixed and varying frame times are played through it, and
+ *                every swap's predicted display vblank, queue depth,
+ *                lateness and latency is checked against what the
+ *                simulated display did, along with the totals the pacer
+ *                reports. Nothing depends on the host's clock, so the
+ *                results are the same on every run.
+ *
+ *                Exits with a non-zero status if a check fails; -v prints
+ *                each scenario's totals.
+ *
+ * Modifications:-
+ * $Log: main.c $
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "img_types.h"
+#include "img_defs.h"
+#include "psp2_pacing.h"
+#include "hosttest.h"
+
+#define SIM_REFRESH_US		16683
+#define SIM_MAX_FLIPS		PSP2_PACING_MAX_FLIPS
+
+typedef struct _SIM_DISPLAY_
+{
+	/* Vblank 0 starts at ui64PhaseUs; ui32VcountBase is added to the count */
+	IMG_UINT64	ui64PhaseUs;
+	IMG_UINT32	ui32VcountBase;
+
+	IMG_UINT64	ui64TimeUs;
+
+	/* Flips pending at once before a swap blocks */
+	IMG_UINT32	ui32MaxPending;
+
+	/* Vblanks the queued flips are shown at, newest last */
+	IMG_UINT32	ui32NumFlips;
+	IMG_UINT32	aui32FlipVcount[SIM_MAX_FLIPS];
+} SIM_DISPLAY;
+
+typedef struct _SCENARIO_
+{
+	const IMG_CHAR	*pszName;
+	IMG_UINT32		ui32Frames;
+	IMG_UINT32		ui32SwapInterval;
+	IMG_BOOL		bAdaptive;
+	IMG_UINT32		ui32MaxPending;
+
+	/* Frame time: ui32WorkUs plus up to ui32JitterUs, and every
+	   ui32SpikeEvery frames ui32SpikeUs more */
+	IMG_UINT32		ui32WorkUs;
+	IMG_UINT32		ui32JitterUs;
+	IMG_UINT32		ui32SpikeEvery;
+	IMG_UINT32		ui32SpikeUs;
+
+	IMG_UINT32		ui32VcountBase;
+} SCENARIO;
+
+typedef struct _SCENARIO_RESULT_
+{
+	IMG_UINT32	ui32Late;
+	IMG_UINT32	ui32Torn;
+	IMG_UINT32	ui32Missed;
+	IMG_UINT32	ui32MaxDepth;
+	IMG_UINT32	ui32LastVcount;
+	IMG_UINT32	ui32FirstVcount;
+	IMG_UINT64	ui64TotalLatencyUs;
+	IMG_UINT32	ui32MaxLatencyUs;
+	PSP2_PACING_STATS	sStats;
+} SCENARIO_RESULT;
+
+static IMG_BOOL bVerbose = IMG_FALSE;
+
+/*****************************************************************************
+ Simulated display controller
+*****************************************************************************/
+
+static IMG_UINT32 SimVblank(const SIM_DISPLAY *psDisplay, IMG_UINT64 ui64TimeUs)
+{
+	return (IMG_UINT32)((ui64TimeUs - psDisplay->ui64PhaseUs) / SIM_REFRESH_US);
+}
+
+static IMG_UINT32 SimVcount(const SIM_DISPLAY *psDisplay)
+{
+	return psDisplay->ui32VcountBase + SimVblank(psDisplay, psDisplay->ui64TimeUs);
+}
+
+static IMG_UINT64 SimVblankStart(const SIM_DISPLAY *psDisplay, IMG_UINT32 ui32Vcount)
+{
+	return psDisplay->ui64PhaseUs + (IMG_UINT64)(ui32Vcount - psDisplay->ui32VcountBase) * SIM_REFRESH_US;
+}
+
+static IMG_UINT32 SimPending(const SIM_DISPLAY *psDisplay)
+{
+	IMG_UINT32 ui32Vcount = SimVcount(psDisplay);
+	IMG_UINT32 ui32Pending = 0;
+	IMG_UINT32 i;
+
+	for (i = 0; i < psDisplay->ui32NumFlips; i++)
+	{
+		if ((IMG_INT32)(psDisplay->aui32FlipVcount[i] - ui32Vcount) > 0)
+		{
+			ui32Pending++;
+		}
+	}
+
+	return ui32Pending;
+}
+
+/* Queues a flip, blocking while too many are pending; returns the vblank it is shown at */
+static IMG_UINT32 SimQueueFlip(SIM_DISPLAY *psDisplay, IMG_UINT32 ui32Interval)
+{
+	IMG_UINT32 ui32Vcount, ui32Shown;
+
+	while (SimPending(psDisplay) >= psDisplay->ui32MaxPending)
+	{
+		/* Wake 50us into the next vblank */
+		psDisplay->ui64TimeUs = SimVblankStart(psDisplay, SimVcount(psDisplay) + 1) + 50;
+	}
+
+	ui32Vcount = SimVcount(psDisplay);
+
+	if (!psDisplay->ui32NumFlips)
+	{
+		ui32Shown = ui32Interval ? ui32Vcount + 1 : ui32Vcount;
+	}
+	else
+	{
+		IMG_UINT32 ui32Last = psDisplay->aui32FlipVcount[psDisplay->ui32NumFlips - 1];
+
+		if (ui32Interval == 0)
+		{
+			ui32Shown = ((IMG_INT32)(ui32Last - ui32Vcount) > 0) ? ui32Last : ui32Vcount;
+		}
+		else
+		{
+			ui32Shown = ui32Last + ui32Interval;
+			if ((IMG_INT32)(ui32Vcount + 1 - ui32Shown) > 0)
+			{
+				ui32Shown = ui32Vcount + 1;
+			}
+		}
+	}
+
+	if (psDisplay->ui32NumFlips == SIM_MAX_FLIPS)
+	{
+		memmove(&psDisplay->aui32FlipVcount[0], &psDisplay->aui32FlipVcount[1], (SIM_MAX_FLIPS - 1) * sizeof(IMG_UINT32));
+		psDisplay->ui32NumFlips--;
+	}
+	psDisplay->aui32FlipVcount[psDisplay->ui32NumFlips++] = ui32Shown;
+
+	return ui32Shown;
+}
+
+/*****************************************************************************
+ Scenarios
+*****************************************************************************/
+
+static IMG_VOID RunScenario(const SCENARIO *psScenario, SCENARIO_RESULT *psResult)
+{
+	const IMG_CHAR *pszTest = psScenario->pszName;
+	SIM_DISPLAY sDisplay;
+	PSP2_PACING sPacing;
+	IMG_UINT64 ui64LastSwapUs = 0;
+	IMG_UINT32 ui32Frame;
+
+	memset(&sDisplay, 0, sizeof(sDisplay));
+	memset(psResult, 0, sizeof(*psResult));
+
+	ui32Random = 0x5EED0000U ^ psScenario->ui32Frames;
+
+	sDisplay.ui64PhaseUs = 1000000 + 3210;
+	sDisplay.ui32VcountBase = psScenario->ui32VcountBase;
+	sDisplay.ui64TimeUs = sDisplay.ui64PhaseUs + 5000;
+	sDisplay.ui32MaxPending = psScenario->ui32MaxPending;
+
+	Psp2PacingInit(&sPacing, SIM_REFRESH_US, psScenario->ui32SwapInterval);
+	Psp2PacingSetAdaptive(&sPacing, psScenario->bAdaptive);
+
+	for (ui32Frame = 0; ui32Frame < psScenario->ui32Frames; ui32Frame++)
+	{
+		IMG_UINT32 ui32Vcount, ui32Interval, ui32Shown, ui32Pending;
+		IMG_UINT32 ui32LatencyUs, ui32Target;
+		IMG_UINT64 ui64SwapUs, ui64ShownUs;
+		IMG_BOOL bLate = IMG_FALSE;
+
+		/* Render */
+		sDisplay.ui64TimeUs += psScenario->ui32WorkUs;
+		if (psScenario->ui32JitterUs)
+		{
+			sDisplay.ui64TimeUs += Random() % psScenario->ui32JitterUs;
+		}
+		if (psScenario->ui32SpikeEvery && ((ui32Frame % psScenario->ui32SpikeEvery) == psScenario->ui32SpikeEvery - 1))
+		{
+			sDisplay.ui64TimeUs += psScenario->ui32SpikeUs;
+		}
+
+		/* Swap */
+		ui32Vcount = SimVcount(&sDisplay);
+		ui64SwapUs = sDisplay.ui64TimeUs;
+		ui32Pending = SimPending(&sDisplay);
+
+		if (ui32Frame && psScenario->ui32SwapInterval)
+		{
+			ui32Target = sDisplay.aui32FlipVcount[sDisplay.ui32NumFlips - 1] + psScenario->ui32SwapInterval;
+			if ((IMG_INT32)(ui32Vcount + 1 - ui32Target) > 0)
+			{
+				bLate = IMG_TRUE;
+				psResult->ui32Late++;
+				psResult->ui32Missed += ui32Vcount + 1 - ui32Target;
+			}
+		}
+
+		ui32Interval = Psp2PacingBeginSwap(&sPacing, ui32Vcount, ui64SwapUs);
+		ui32Shown = SimQueueFlip(&sDisplay, ui32Interval);
+		Psp2PacingEndSwap(&sPacing, IMG_TRUE);
+
+		if (ui32Frame == 0)
+		{
+			psResult->ui32FirstVcount = ui32Shown;
+		}
+		psResult->ui32LastVcount = ui32Shown;
+
+		/* Per swap checks against the simulated display */
+		if (ui32Interval != psScenario->ui32SwapInterval)
+		{
+			Check((IMG_BOOL)(ui32Interval == 0), pszTest, "interval neither the swap interval nor 0");
+			Check(psScenario->bAdaptive, pszTest, "interval changed without adaptive swap interval");
+			Check(bLate, pszTest, "swap on time flipped at once");
+			psResult->ui32Torn++;
+		}
+		else if (psScenario->bAdaptive && psScenario->ui32SwapInterval)
+		{
+			Check((IMG_BOOL)!bLate, pszTest, "late swap not flipped at once");
+		}
+
+		if (sPacing.ui32SwapDisplayVcount != ui32Shown)
+		{
+			fprintf(stderr, "FAIL %s: frame %u predicted at vblank %u, shown at %u\n",
+					pszTest, ui32Frame, sPacing.ui32SwapDisplayVcount, ui32Shown);
+			ui32Failures++;
+		}
+		CheckCount(sPacing.sStats.ui32QueueDepth, ui32Pending, pszTest, "queue depth");
+
+		if (ui32Pending > psResult->ui32MaxDepth)
+		{
+			psResult->ui32MaxDepth = ui32Pending;
+		}
+
+		/* The estimate can only be late, by less than a vblank period */
+		ui64ShownUs = SimVblankStart(&sDisplay, ui32Shown);
+		ui32LatencyUs = (ui64ShownUs > ui64SwapUs) ? (IMG_UINT32)(ui64ShownUs - ui64SwapUs) : 0;
+		Check((IMG_BOOL)((sPacing.sStats.ui32LastLatencyUs >= ui32LatencyUs) &&
+						 (sPacing.sStats.ui32LastLatencyUs < ui32LatencyUs + SIM_REFRESH_US)),
+			  pszTest, "latency estimate out of range");
+		psResult->ui64TotalLatencyUs += ui32LatencyUs;
+		if (ui32LatencyUs > psResult->ui32MaxLatencyUs)
+		{
+			psResult->ui32MaxLatencyUs = ui32LatencyUs;
+		}
+
+		if (ui32Frame)
+		{
+			CheckCount(sPacing.sStats.ui32LastFrameUs, (IMG_UINT32)(ui64SwapUs - ui64LastSwapUs), pszTest, "frame time");
+		}
+		ui64LastSwapUs = ui64SwapUs;
+	}
+
+	Psp2PacingGetStats(&sPacing, &psResult->sStats);
+
+	CheckCount(psResult->sStats.ui32Presents, psScenario->ui32Frames, pszTest, "presents");
+	CheckCount(psResult->sStats.ui32LatePresents, psResult->ui32Late, pszTest, "late presents");
+	CheckCount(psResult->sStats.ui32TornPresents, psResult->ui32Torn, pszTest, "torn presents");
+	CheckCount(psResult->sStats.ui32MissedIntervals, psResult->ui32Missed, pszTest, "missed intervals");
+
+	/* By the end the vblank estimate has locked on */
+	Check((IMG_BOOL)(sPacing.sStats.ui32AverageLatencyUs <=
+					 (IMG_UINT32)(psResult->ui64TotalLatencyUs / psScenario->ui32Frames) + SIM_REFRESH_US / 2),
+		  pszTest, "average latency estimate too high");
+
+	if (bVerbose)
+	{
+		printf("%-28s presents %u, late %u, torn %u, missed %u, max depth %u, "
+			   "vblanks %u, latency avg %uus max %uus (actual avg %uus max %uus)\n",
+			   pszTest,
+			   psResult->sStats.ui32Presents,
+			   psResult->sStats.ui32LatePresents,
+			   psResult->sStats.ui32TornPresents,
+			   psResult->sStats.ui32MissedIntervals,
+			   psResult->ui32MaxDepth,
+			   psResult->ui32LastVcount - psResult->ui32FirstVcount,
+			   psResult->sStats.ui32AverageLatencyUs,
+			   psResult->sStats.ui32MaxLatencyUs,
+			   (IMG_UINT32)(psResult->ui64TotalLatencyUs / psScenario->ui32Frames),
+			   psResult->ui32MaxLatencyUs);
+	}
+}
+
+/* Frames that fit in a vblank: nothing late, a flip every vblank */
+static IMG_VOID TestOnTime(IMG_VOID)
+{
+	static const SCENARIO sScenario = { "on time", 300, 1, IMG_TRUE, 1, 9000, 4000, 0, 0, 0 };
+	SCENARIO_RESULT sResult;
+
+	RunScenario(&sScenario, &sResult);
+
+	CheckCount(sResult.sStats.ui32LatePresents, 0, sScenario.pszName, "late presents");
+	CheckCount(sResult.sStats.ui32TornPresents, 0, sScenario.pszName, "torn presents");
+	CheckCount(sResult.ui32LastVcount - sResult.ui32FirstVcount, sScenario.ui32Frames - 1, sScenario.pszName, "vblanks");
+	Check((IMG_BOOL)(sResult.sStats.ui32MaxLatencyUs < 2 * SIM_REFRESH_US), sScenario.pszName, "latency over two vblanks");
+}
+
+/* Frames a little over a vblank: vsync halves the rate, adaptive tears instead */
+static IMG_VOID TestSlowFrames(IMG_VOID)
+{
+	static const SCENARIO sVsync = { "slow frames", 300, 1, IMG_FALSE, 1, 18000, 3000, 0, 0, 0 };
+	static const SCENARIO sAdaptive = { "slow frames, adaptive", 300, 1, IMG_TRUE, 1, 18000, 3000, 0, 0, 0 };
+	SCENARIO_RESULT sVsyncResult, sAdaptiveResult;
+
+	RunScenario(&sVsync, &sVsyncResult);
+	RunScenario(&sAdaptive, &sAdaptiveResult);
+
+	/* Each missed vblank shows a frame again */
+	Check((IMG_BOOL)(sVsyncResult.sStats.ui32LatePresents > 0), sVsync.pszName, "no late presents");
+	CheckCount(sVsyncResult.sStats.ui32MissedIntervals,
+			   sVsyncResult.ui32LastVcount - sVsyncResult.ui32FirstVcount - (sVsync.ui32Frames - 1),
+			   sVsync.pszName, "missed intervals");
+	CheckCount(sVsyncResult.sStats.ui32TornPresents, 0, sVsync.pszName, "torn presents");
+
+	Check((IMG_BOOL)(sAdaptiveResult.sStats.ui32TornPresents > 0), sAdaptive.pszName, "no torn presents");
+	CheckCount(sAdaptiveResult.sStats.ui32TornPresents, sAdaptiveResult.sStats.ui32LatePresents, sAdaptive.pszName, "torn presents");
+
+	/* The same frames take less display time when late ones tear */
+	Check((IMG_BOOL)(sAdaptiveResult.ui32LastVcount - sAdaptiveResult.ui32FirstVcount <
+					 sVsyncResult.ui32LastVcount - sVsyncResult.ui32FirstVcount),
+		  sAdaptive.pszName, "adaptive swap interval no faster than vsync");
+	Check((IMG_BOOL)(sAdaptiveResult.sStats.ui32AverageLatencyUs < sVsyncResult.sStats.ui32AverageLatencyUs),
+		  sAdaptive.pszName, "adaptive swap interval latency no lower than vsync");
+}
+
+/* Occasional long frames: only those are late, and only those tear */
+static IMG_VOID TestSpikes(IMG_VOID)
+{
+	static const SCENARIO sScenario = { "spikes, adaptive", 300, 1, IMG_TRUE, 1, 8000, 2000, 10, 30000, 0 };
+	SCENARIO_RESULT sResult;
+
+	RunScenario(&sScenario, &sResult);
+
+	CheckCount(sResult.sStats.ui32LatePresents, sScenario.ui32Frames / sScenario.ui32SpikeEvery, sScenario.pszName, "late presents");
+	CheckCount(sResult.sStats.ui32TornPresents, sResult.sStats.ui32LatePresents, sScenario.pszName, "torn presents");
+	Check((IMG_BOOL)(sResult.sStats.ui32MissedIntervals >= sResult.sStats.ui32LatePresents), sScenario.pszName, "too few missed intervals");
+}
+
+/* Swap interval 2 with frames between one and two vblanks */
+static IMG_VOID TestInterval2(IMG_VOID)
+{
+	static const SCENARIO sScenario = { "interval 2", 200, 2, IMG_TRUE, 1, 20000, 8000, 0, 0, 0 };
+	SCENARIO_RESULT sResult;
+
+	RunScenario(&sScenario, &sResult);
+
+	CheckCount(sResult.sStats.ui32LatePresents, 0, sScenario.pszName, "late presents");
+	CheckCount(sResult.ui32LastVcount - sResult.ui32FirstVcount, 2 * (sScenario.ui32Frames - 1), sScenario.pszName, "vblanks");
+}
+
+/* A fast producer fills the queue; latency grows with the depth */
+static IMG_VOID TestQueueDepth(IMG_VOID)
+{
+	static const SCENARIO sDouble = { "queue depth 1", 200, 1, IMG_FALSE, 1, 2000, 500, 0, 0, 0 };
+	static const SCENARIO sTriple = { "queue depth 2", 200, 1, IMG_FALSE, 2, 2000, 500, 0, 0, 0 };
+	SCENARIO_RESULT sDoubleResult, sTripleResult;
+
+	RunScenario(&sDouble, &sDoubleResult);
+	RunScenario(&sTriple, &sTripleResult);
+
+	CheckCount(sDoubleResult.ui32MaxDepth, 1, sDouble.pszName, "max queue depth");
+	CheckCount(sTripleResult.ui32MaxDepth, 2, sTriple.pszName, "max queue depth");
+	CheckCount(sTripleResult.sStats.ui32QueueDepth, 2, sTriple.pszName, "last queue depth");
+	CheckCount(sTripleResult.sStats.ui32LatePresents, 0, sTriple.pszName, "late presents");
+	Check((IMG_BOOL)(sTripleResult.sStats.ui32AverageLatencyUs > sDoubleResult.sStats.ui32AverageLatencyUs + SIM_REFRESH_US / 2),
+		  sTriple.pszName, "deeper queue without more latency");
+}
+
+/* Swap interval 0: flipped at once, never late */
+static IMG_VOID TestInterval0(IMG_VOID)
+{
+	static const SCENARIO sScenario = { "interval 0", 200, 0, IMG_TRUE, 1, 7000, 9000, 0, 0, 0 };
+	SCENARIO_RESULT sResult;
+
+	RunScenario(&sScenario, &sResult);
+
+	CheckCount(sResult.sStats.ui32LatePresents, 0, sScenario.pszName, "late presents");
+	CheckCount(sResult.sStats.ui32TornPresents, 0, sScenario.pszName, "torn presents");
+	CheckCount(sResult.sStats.ui32MaxLatencyUs, 0, sScenario.pszName, "max latency");
+}
+
+/* The vblank count wrapping mid run */
+static IMG_VOID TestVcountWrap(IMG_VOID)
+{
+	static const SCENARIO sScenario = { "vblank count wrap", 300, 1, IMG_TRUE, 2, 12000, 9000, 0, 0, 0xFFFFFF00U };
+	SCENARIO_RESULT sResult;
+
+	RunScenario(&sScenario, &sResult);
+
+	Check((IMG_BOOL)(sResult.ui32LastVcount < sResult.ui32FirstVcount), sScenario.pszName, "count didn't wrap");
+}
+
+/* Swap interval and mode changes, and failed swaps */
+static IMG_VOID TestControl(IMG_VOID)
+{
+	const IMG_CHAR *pszTest = "control";
+	PSP2_PACING sPacing;
+	PSP2_PACING_STATS sStats;
+	IMG_UINT64 ui64TimeUs = 1000;
+	IMG_UINT32 ui32Vcount = 10;
+
+	Psp2PacingInit(&sPacing, SIM_REFRESH_US, 1);
+
+	CheckCount(Psp2PacingBeginSwap(&sPacing, ui32Vcount, ui64TimeUs), 1, pszTest, "first interval");
+	Psp2PacingEndSwap(&sPacing, IMG_TRUE);
+
+	/* Three vblanks later: late, but waits without adaptive */
+	ui32Vcount += 3;
+	ui64TimeUs += 3 * SIM_REFRESH_US;
+	CheckCount(Psp2PacingBeginSwap(&sPacing, ui32Vcount, ui64TimeUs), 1, pszTest, "late interval");
+	Psp2PacingEndSwap(&sPacing, IMG_TRUE);
+
+	Psp2PacingGetStats(&sPacing, &sStats);
+	CheckCount(sStats.ui32LatePresents, 1, pszTest, "late presents");
+	CheckCount(sStats.ui32MissedIntervals, 2, pszTest, "missed intervals");
+
+	/* Interval 3: on time until the third vblank after the last flip (14) */
+	Psp2PacingSetSwapInterval(&sPacing, 3);
+	ui32Vcount += 2;
+	ui64TimeUs += 2 * SIM_REFRESH_US;
+	CheckCount(Psp2PacingBeginSwap(&sPacing, ui32Vcount, ui64TimeUs), 3, pszTest, "interval 3");
+	Psp2PacingEndSwap(&sPacing, IMG_TRUE);
+	CheckCount(sPacing.aui32FlipVcount[sPacing.ui32LastFlip], 17, pszTest, "interval 3 vblank");
+
+	/* A swap the display refused leaves nothing behind */
+	Psp2PacingSetAdaptive(&sPacing, IMG_TRUE);
+	ui32Vcount += 8;
+	ui64TimeUs += 8 * SIM_REFRESH_US;
+	CheckCount(Psp2PacingBeginSwap(&sPacing, ui32Vcount, ui64TimeUs), 0, pszTest, "late adaptive interval");
+	Psp2PacingEndSwap(&sPacing, IMG_FALSE);
+
+	Psp2PacingGetStats(&sPacing, &sStats);
+	CheckCount(sStats.ui32Presents, 3, pszTest, "presents after a failed swap");
+	CheckCount(sStats.ui32TornPresents, 0, pszTest, "torn presents after a failed swap");
+	CheckCount(sPacing.aui32FlipVcount[sPacing.ui32LastFlip], 17, pszTest, "last flip after a failed swap");
+}
+
+int main(int argc, char **argv)
+{
+	if ((argc == 2) && (strcmp(argv[1], "-v") == 0))
+	{
+		bVerbose = IMG_TRUE;
+	}
+	else if (argc != 1)
+	{
+		fprintf(stderr, "Usage: %s [-v]\n", argv[0]);
+		return 2;
+	}
+
+	TestOnTime();
+	TestSlowFrames();
+	TestSpikes();
+	TestInterval2();
+	TestQueueDepth();
+	TestInterval0();
+	TestVcountWrap();
+	TestControl();
+
+	if (ui32Failures)
+	{
+		printf("%u checks failed\n", ui32Failures);
+		return 1;
+	}
+
+	printf("all checks passed\n");
+	return 0;
+}
+
+/******************************************************************************
+ End of file (main.c)
+******************************************************************************/
@@ -0,0 +1,31 @@
+# Copyright	2010 Imagination Technologies Limited. All rights reserved.
+#
+# No part of this software, either material or conceptual may be
+# copied or distributed, transmitted, transcribed, stored in a
+# retrieval system or translated into any human or computer
+# language in any form by any means, electronic, mechanical,
+# manual or other-wise, or disclosed to third parties without
+# the express written permission of: Imagination Technologies
+# Limited, HomePark Industrial Estate, Kings Langley,
+# Hertfordshire, WD4 8LZ, UK
+#
+# $Log: Linux.mk $
+#
+
+modules := pvr2dbatchtest
+
+pvr2dbatchtest_type := host_executable
+
+pvr2dbatchtest_target := pvr2dbatchtest
+
+pvr2dbatchtest_src = \
+ main.c \
+ $(TOP)/pvr2d/devices/sgx/pvr2dblt.c
+
+# pvr2dblt.c is built as for the device, on the transfer queue; the queue
+# and services calls it makes are mocked in main.c, and host/include comes
+# first so the shared stand-in SDK headers are used.
+pvr2dbatchtest_cflags := -D__psp2__ -DPVR2D_ALT_2DHW -DSUPPORT_SGX
+
+pvr2dbatchtest_includes := host/include include4 include/gpu_es4 \
+ pvr2d pvr2d/devices/sgx
@@ -0,0 +1,939 @@
+/******************************************************************************
+ * Name         : main.c
+ * Title        : PVR2D batched blit tests (pvr2dbatchtest)
+ *
+ * Copyright    : 2010 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means,electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Description  : Builds pvr2d/devices/sgx/pvr2dblt.c on the host against a
+ *                mock transfer queue and checks PVR2DBltBatch: which blits
+ *                it merges, how many transfers and sync updates it
+ *                submits, that a bad entry fails the batch with nothing
+ *                queued, and that the surfaces it writes match the same
+ *                blits submitted one by one with PVR2DBlt.
+ *
+ *                The mock SGXQueueTransfer records each transfer and runs
+ *                it on host memory: unscaled 16 and 32 bit copies with
+ *                rop3 and global alpha, 32 bit fills and clip blits. It
+ *                exits with a non-zero status if a check fails; -v lists
+ *                every transfer.
+ *
+ * Modifications:-
+ * $Log: main.c $
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "img_types.h"
+#include "img_defs.h"
+#include "services.h"
+#include "sgxapi.h"
+#include "pvr2d.h"
+#include "pvr2dint.h"
+#include "hosttest.h"
+
+#define TEST_SURFACE_WIDTH		96
+#define TEST_SURFACE_HEIGHT		64
+#define TEST_MAX_SURFACES		8
+#define TEST_MAX_BLTS			64
+#define TEST_DEVVADDR_BASE		0x10000000U
+#define TEST_DEVVADDR_STEP		0x00100000U
+
+typedef struct _TEST_SURFACE_
+{
+	PVR2DMEMINFO			sMemInfo;
+	PVRSRV_CLIENT_MEM_INFO	sClientMemInfo;
+	PVRSRV_CLIENT_SYNC_INFO	sSyncInfo;
+	IMG_BYTE				*pbyData;
+	IMG_UINT32				ui32Size;
+
+	/* Transfers that wrote the surface, ie. write op updates on its sync */
+	IMG_UINT32				ui32WriteOps;
+} TEST_SURFACE;
+
+typedef struct _MOCK_QUEUE_
+{
+	IMG_UINT32	ui32Transfers;
+	IMG_UINT32	ui32Blits;
+	IMG_UINT32	ui32Fills;
+	IMG_UINT32	ui32ClipBlits;
+	IMG_UINT32	ui32ClipRects;
+	IMG_UINT32	ui32Errors;
+
+	/* Refuse clip blits, as a path without them would */
+	IMG_BOOL	bRejectClipBlits;
+} MOCK_QUEUE;
+
+static TEST_SURFACE asSurfaces[TEST_MAX_SURFACES];
+static IMG_UINT32 ui32NumSurfaces = 0;
+static MOCK_QUEUE sQueue;
+static IMG_BOOL bVerbose = IMG_FALSE;
+
+/*****************************************************************************
+ Services and PVR2D functions pvr2dblt.c links against
+*****************************************************************************/
+
+IMG_PVOID PVRSRVAllocUserModeMem(IMG_SIZE_T ui32Size)
+{
+	return malloc(ui32Size);
+}
+
+IMG_PVOID PVRSRVReallocUserModeMem(IMG_PVOID pvBase, IMG_SIZE_T uNewSize)
+{
+	return realloc(pvBase, uNewSize);
+}
+
+IMG_VOID PVRSRVFreeUserModeMem(IMG_PVOID pvMem)
+{
+	free(pvMem);
+}
+
+IMG_VOID PVRSRVMemSet(IMG_VOID *pvDest, IMG_UINT8 ui8Value, IMG_SIZE_T ui32Size)
+{
+	memset(pvDest, ui8Value, ui32Size);
+}
+
+PVRSRV_ERROR IMG_CALLCONV SGX2DQueryBlitsComplete(PVRSRV_DEV_DATA *psDevData,
+												  PVRSRV_CLIENT_SYNC_INFO *psSyncInfo,
+												  IMG_BOOL bWaitForComplete)
+{
+	PVR_UNREFERENCED_PARAMETER(psDevData);
+	PVR_UNREFERENCED_PARAMETER(psSyncInfo);
+	PVR_UNREFERENCED_PARAMETER(bWaitForComplete);
+
+	/* The mock runs every transfer as it is queued */
+	return PVRSRV_OK;
+}
+
+PVR2DERROR ValidateTransferContext(PVR2DCONTEXT *psContext)
+{
+	psContext->hTransferContext = (IMG_HANDLE)&sQueue;
+
+	return PVR2D_OK;
+}
+
+/*****************************************************************************
+ Mock transfer queue
+*****************************************************************************/
+
+static TEST_SURFACE *FindSurface(IMG_UINT32 ui32DevVAddr)
+{
+	IMG_UINT32 i;
+
+	for (i = 0; i < ui32NumSurfaces; i++)
+	{
+		IMG_UINT32 ui32Base = asSurfaces[i].sClientMemInfo.sDevVAddr.uiAddr;
+
+		if ((ui32DevVAddr >= ui32Base) && (ui32DevVAddr < ui32Base + asSurfaces[i].ui32Size))
+		{
+			return &asSurfaces[i];
+		}
+	}
+
+	return IMG_NULL;
+}
+
+static IMG_UINT32 BytesPerPixel(PVRSRV_PIXEL_FORMAT eFormat)
+{
+	switch (eFormat)
+	{
+		case PVRSRV_PIXEL_FORMAT_ARGB8888:
+		case PVRSRV_PIXEL_FORMAT_ABGR8888:
+			return 4;
+		case PVRSRV_PIXEL_FORMAT_RGB565:
+		case PVRSRV_PIXEL_FORMAT_ARGB4444:
+		case PVRSRV_PIXEL_FORMAT_ARGB1555:
+			return 2;
+		default:
+			return 0;
+	}
+}
+
+static IMG_BYTE *PixelAddress(const SGXTQ_SURFACE *psSurf, IMG_INT32 x, IMG_INT32 y)
+{
+	IMG_UINT32 ui32DevVAddr = SGX_TQSURFACE_GET_DEV_VADDR(*psSurf);
+	TEST_SURFACE *psTestSurf = FindSurface(ui32DevVAddr);
+	IMG_UINT32 ui32Bpp = BytesPerPixel(psSurf->eFormat);
+	IMG_INT32 i32Offset;
+
+	if (!psTestSurf || !ui32Bpp)
+	{
+		return IMG_NULL;
+	}
+
+	i32Offset = (IMG_INT32)(ui32DevVAddr - psTestSurf->sClientMemInfo.sDevVAddr.uiAddr) +
+				y * psSurf->i32StrideInBytes + x * (IMG_INT32)ui32Bpp;
+
+	if ((i32Offset < 0) || ((IMG_UINT32)i32Offset + ui32Bpp > psTestSurf->ui32Size))
+	{
+		return IMG_NULL;
+	}
+
+	return psTestSurf->pbyData + i32Offset;
+}
+
+static IMG_UINT32 ReadPixel(const IMG_BYTE *pbyPixel, IMG_UINT32 ui32Bpp)
+{
+	return (ui32Bpp == 4) ? *(const IMG_UINT32 *)pbyPixel : *(const IMG_UINT16 *)pbyPixel;
+}
+
+static IMG_VOID WritePixel(IMG_BYTE *pbyPixel, IMG_UINT32 ui32Bpp, IMG_UINT32 ui32Value)
+{
+	if (ui32Bpp == 4)
+	{
+		*(IMG_UINT32 *)pbyPixel = ui32Value;
+	}
+	else
+	{
+		*(IMG_UINT16 *)pbyPixel = (IMG_UINT16)ui32Value;
+	}
+}
+
+/* Bitwise rop3: bit (P << 2 | S << 1 | D) of the code gives the result */
+static IMG_UINT32 Rop3(IMG_BYTE byRop, IMG_UINT32 ui32Pat, IMG_UINT32 ui32Src, IMG_UINT32 ui32Dst)
+{
+	IMG_UINT32 ui32Result = 0;
+	IMG_UINT32 i;
+
+	for (i = 0; i < 8; i++)
+	{
+		if (byRop & (1U << i))
+		{
+			ui32Result |= ((i & 4) ? ui32Pat : ~ui32Pat) &
+						  ((i & 2) ? ui32Src : ~ui32Src) &
+						  ((i & 1) ? ui32Dst : ~ui32Dst);
+		}
+	}
+
+	return ui32Result;
+}
+
+static IMG_UINT32 GlobalAlpha(IMG_UINT32 ui32Src, IMG_UINT32 ui32Dst, IMG_UINT32 ui32Alpha)
+{
+	IMG_UINT32 ui32Result = 0;
+	IMG_UINT32 ui32Shift;
+
+	for (ui32Shift = 0; ui32Shift < 32; ui32Shift += 8)
+	{
+		IMG_UINT32 s = (ui32Src >> ui32Shift) & 0xFF;
+		IMG_UINT32 d = (ui32Dst >> ui32Shift) & 0xFF;
+
+		ui32Result |= (((s * ui32Alpha) + (d * (255 - ui32Alpha)) + 127) / 255) << ui32Shift;
+	}
+
+	return ui32Result;
+}
+
+static PVRSRV_ERROR MockCopyRect(SGX_QUEUETRANSFER *psQueueTransfer,
+								 const IMG_RECT *psDstRect,
+								 IMG_INT32 i32SrcX0,
+								 IMG_INT32 i32SrcY0)
+{
+	SGXTQ_SURFACE *psDst = &psQueueTransfer->asDests[0];
+	SGXTQ_SURFACE *psSrc = &psQueueTransfer->asSources[0];
+	IMG_UINT32 ui32Bpp = BytesPerPixel(psDst->eFormat);
+	IMG_INT32 x, y;
+
+	if ((psSrc->eFormat != psDst->eFormat) || !ui32Bpp)
+	{
+		return PVRSRV_ERROR_NOT_SUPPORTED;
+	}
+
+	for (y = psDstRect->y0; y < psDstRect->y1; y++)
+	{
+		for (x = psDstRect->x0; x < psDstRect->x1; x++)
+		{
+			IMG_BYTE *pbyDst = PixelAddress(psDst, x, y);
+			IMG_BYTE *pbySrc = PixelAddress(psSrc, i32SrcX0 + (x - psDstRect->x0), i32SrcY0 + (y - psDstRect->y0));
+			IMG_UINT32 ui32Src, ui32Dst, ui32Result;
+
+			if (!pbyDst || !pbySrc)
+			{
+				return PVRSRV_ERROR_INVALID_PARAMS;
+			}
+
+			ui32Src = ReadPixel(pbySrc, ui32Bpp);
+			ui32Dst = ReadPixel(pbyDst, ui32Bpp);
+			ui32Result = ui32Src;
+
+			if (psQueueTransfer->eType == SGXTQ_BLIT)
+			{
+				if (psQueueTransfer->Details.sBlit.byCustomRop3)
+				{
+					ui32Result = Rop3(psQueueTransfer->Details.sBlit.byCustomRop3, 0, ui32Src, ui32Dst);
+				}
+				if (psQueueTransfer->Details.sBlit.eAlpha == SGXTQ_ALPHA_GLOBAL)
+				{
+					ui32Result = GlobalAlpha(ui32Result, ui32Dst, psQueueTransfer->Details.sBlit.byGlobalAlpha);
+				}
+			}
+
+			WritePixel(pbyDst, ui32Bpp, ui32Result);
+		}
+	}
+
+	return PVRSRV_OK;
+}
+
+static PVRSRV_ERROR MockRunTransfer(SGX_QUEUETRANSFER *psQueueTransfer)
+{
+	IMG_RECT *psDstRect = &SGX_QUEUETRANSFER_DST_RECT(*psQueueTransfer, 0);
+	IMG_INT32 x, y;
+	IMG_UINT32 i;
+
+	switch (psQueueTransfer->eType)
+	{
+		case SGXTQ_BLIT:
+		{
+			IMG_RECT *psSrcRect = &SGX_QUEUETRANSFER_SRC_RECT(*psQueueTransfer, 0);
+
+			if ((psQueueTransfer->Details.sBlit.eAlpha != SGXTQ_ALPHA_NONE) &&
+				(psQueueTransfer->Details.sBlit.eAlpha != SGXTQ_ALPHA_GLOBAL))
+			{
+				return PVRSRV_ERROR_NOT_SUPPORTED;
+			}
+			if (((psSrcRect->x1 - psSrcRect->x0) != (psDstRect->x1 - psDstRect->x0)) ||
+				((psSrcRect->y1 - psSrcRect->y0) != (psDstRect->y1 - psDstRect->y0)))
+			{
+				return PVRSRV_ERROR_NOT_SUPPORTED;
+			}
+
+			sQueue.ui32Blits++;
+			return MockCopyRect(psQueueTransfer, psDstRect, psSrcRect->x0, psSrcRect->y0);
+		}
+		case SGXTQ_FILL:
+		{
+			SGXTQ_SURFACE *psDst = &psQueueTransfer->asDests[0];
+			IMG_BYTE byRop = psQueueTransfer->Details.sFill.byCustomRop3;
+
+			if (BytesPerPixel(psDst->eFormat) != 4)
+			{
+				return PVRSRV_ERROR_NOT_SUPPORTED;
+			}
+
+			for (y = psDstRect->y0; y < psDstRect->y1; y++)
+			{
+				for (x = psDstRect->x0; x < psDstRect->x1; x++)
+				{
+					IMG_BYTE *pbyDst = PixelAddress(psDst, x, y);
+					IMG_UINT32 ui32Colour = psQueueTransfer->Details.sFill.ui32Colour;
+
+					if (!pbyDst)
+					{
+						return PVRSRV_ERROR_INVALID_PARAMS;
+					}
+					if (byRop)
+					{
+						ui32Colour = Rop3(byRop, ui32Colour, 0, ReadPixel(pbyDst, 4));
+					}
+					WritePixel(pbyDst, 4, ui32Colour);
+				}
+			}
+
+			sQueue.ui32Fills++;
+			return PVRSRV_OK;
+		}
+		case SGXTQ_CLIP_BLIT:
+		{
+			SGXTQ_CLIPBLITOP *psClipBlit = &psQueueTransfer->Details.sClipBlit;
+
+			if (sQueue.bRejectClipBlits)
+			{
+				return PVRSRV_ERROR_NOT_SUPPORTED;
+			}
+			if (psClipBlit->bUseSrcRectsForTexCoords ||
+				(psQueueTransfer->asSources[0].ui32Width != psQueueTransfer->asDests[0].ui32Width) ||
+				(psQueueTransfer->asSources[0].ui32Height != psQueueTransfer->asDests[0].ui32Height))
+			{
+				return PVRSRV_ERROR_NOT_SUPPORTED;
+			}
+
+			/* Each rect is clipped to the dest rect and sampled in place */
+			for (i = 0; i < psClipBlit->ui32RectNum; i++)
+			{
+				IMG_RECT sRect = psClipBlit->psRects[i];
+				PVRSRV_ERROR eError;
+
+				sRect.x0 = (sRect.x0 > psDstRect->x0) ? sRect.x0 : psDstRect->x0;
+				sRect.y0 = (sRect.y0 > psDstRect->y0) ? sRect.y0 : psDstRect->y0;
+				sRect.x1 = (sRect.x1 < psDstRect->x1) ? sRect.x1 : psDstRect->x1;
+				sRect.y1 = (sRect.y1 < psDstRect->y1) ? sRect.y1 : psDstRect->y1;
+
+				if ((sRect.x1 > sRect.x0) && (sRect.y1 > sRect.y0))
+				{
+					eError = MockCopyRect(psQueueTransfer, &sRect, sRect.x0, sRect.y0);
+					if (eError != PVRSRV_OK)
+					{
+						return eError;
+					}
+				}
+			}
+
+			sQueue.ui32ClipBlits++;
+			sQueue.ui32ClipRects += psClipBlit->ui32RectNum;
+			return PVRSRV_OK;
+		}
+		default:
+		{
+			return PVRSRV_ERROR_NOT_SUPPORTED;
+		}
+	}
+}
+
+PVRSRV_ERROR IMG_CALLCONV SGXQueueTransfer(PVRSRV_DEV_DATA *psDevData,
+										   IMG_HANDLE hTransferContext,
+										   SGX_QUEUETRANSFER *psQueueTransfer)
+{
+	TEST_SURFACE *psDstSurf;
+	PVRSRV_ERROR eError;
+
+	PVR_UNREFERENCED_PARAMETER(psDevData);
+
+	if ((hTransferContext != (IMG_HANDLE)&sQueue) || (psQueueTransfer->ui32NumDest != 1))
+	{
+		sQueue.ui32Errors++;
+		return PVRSRV_ERROR_INVALID_PARAMS;
+	}
+
+	if (bVerbose)
+	{
+		printf("  transfer type %d, %u sources, dest (%d,%d)-(%d,%d)",
+			   (IMG_INT)psQueueTransfer->eType,
+			   psQueueTransfer->ui32NumSources,
+			   SGX_QUEUETRANSFER_DST_RECT(*psQueueTransfer, 0).x0,
+			   SGX_QUEUETRANSFER_DST_RECT(*psQueueTransfer, 0).y0,
+			   SGX_QUEUETRANSFER_DST_RECT(*psQueueTransfer, 0).x1,
+			   SGX_QUEUETRANSFER_DST_RECT(*psQueueTransfer, 0).y1);
+		if (psQueueTransfer->eType == SGXTQ_CLIP_BLIT)
+		{
+			printf(", %u clip rects", psQueueTransfer->Details.sClipBlit.ui32RectNum);
+		}
+		printf("\n");
+	}
+
+	eError = MockRunTransfer(psQueueTransfer);
+	if (eError != PVRSRV_OK)
+	{
+		return eError;
+	}
+
+	/* One write op update on the dest sync per transfer */
+	psDstSurf = FindSurface(SGX_TQSURFACE_GET_DEV_VADDR(psQueueTransfer->asDests[0]));
+	if (!psDstSurf || (psQueueTransfer->asDests[0].psSyncInfo != &psDstSurf->sSyncInfo))
+	{
+		sQueue.ui32Errors++;
+		return PVRSRV_ERROR_INVALID_PARAMS;
+	}
+	psDstSurf->ui32WriteOps++;
+
+	sQueue.ui32Transfers++;
+
+	return PVRSRV_OK;
+}
+
+/*****************************************************************************
+ Test helpers
+*****************************************************************************/
+
+static TEST_SURFACE *CreateSurface(IMG_UINT32 ui32Bpp)
+{
+	TEST_SURFACE *psSurf = &asSurfaces[ui32NumSurfaces];
+	IMG_UINT32 i;
+
+	if (ui32NumSurfaces == TEST_MAX_SURFACES)
+	{
+		fprintf(stderr, "Out of test surfaces\n");
+		exit(1);
+	}
+
+	memset(psSurf, 0, sizeof(*psSurf));
+	psSurf->ui32Size = TEST_SURFACE_WIDTH * TEST_SURFACE_HEIGHT * ui32Bpp;
+	psSurf->pbyData = malloc(psSurf->ui32Size);
+	if (!psSurf->pbyData)
+	{
+		fprintf(stderr, "Out of memory\n");
+		exit(1);
+	}
+	for (i = 0; i < psSurf->ui32Size; i++)
+	{
+		psSurf->pbyData[i] = (IMG_BYTE)(Random32() >> 5);
+	}
+
+	psSurf->sClientMemInfo.pvLinAddr = psSurf->pbyData;
+	psSurf->sClientMemInfo.sDevVAddr.uiAddr = TEST_DEVVADDR_BASE + ui32NumSurfaces * TEST_DEVVADDR_STEP;
+	psSurf->sClientMemInfo.uAllocSize = psSurf->ui32Size;
+	psSurf->sClientMemInfo.psClientSyncInfo = &psSurf->sSyncInfo;
+
+	PVR2DMEMINFO_INITIALISE(&psSurf->sMemInfo, (&psSurf->sClientMemInfo));
+
+	ui32NumSurfaces++;
+
+	return psSurf;
+}
+
+static IMG_VOID DestroySurfaces(IMG_VOID)
+{
+	IMG_UINT32 i;
+
+	for (i = 0; i < ui32NumSurfaces; i++)
+	{
+		free(asSurfaces[i].pbyData);
+	}
+	ui32NumSurfaces = 0;
+}
+
+static IMG_VOID CopySurface(TEST_SURFACE *psDst, const TEST_SURFACE *psSrc)
+{
+	memcpy(psDst->pbyData, psSrc->pbyData, psSrc->ui32Size);
+}
+
+static IMG_VOID SetDest(PVR2DBLTINFO *psBlt, TEST_SURFACE *psDst, PVR2DFORMAT eFormat, IMG_UINT32 ui32Bpp)
+{
+	psBlt->pDstMemInfo = &psDst->sMemInfo;
+	psBlt->DstStride = TEST_SURFACE_WIDTH * ui32Bpp;
+	psBlt->DstFormat = eFormat;
+	psBlt->DstSurfWidth = TEST_SURFACE_WIDTH;
+	psBlt->DstSurfHeight = TEST_SURFACE_HEIGHT;
+}
+
+static IMG_VOID MakeCopy(PVR2DBLTINFO *psBlt, TEST_SURFACE *psSrc, TEST_SURFACE *psDst,
+						 IMG_INT32 i32SrcX, IMG_INT32 i32SrcY,
+						 IMG_INT32 i32DstX, IMG_INT32 i32DstY,
+						 IMG_INT32 i32Width, IMG_INT32 i32Height)
+{
+	memset(psBlt, 0, sizeof(*psBlt));
+	psBlt->CopyCode = PVR2DROPcopy;
+	SetDest(psBlt, psDst, PVR2D_ARGB8888, 4);
+	psBlt->DstX = i32DstX;
+	psBlt->DstY = i32DstY;
+	psBlt->DSizeX = i32Width;
+	psBlt->DSizeY = i32Height;
+
+	psBlt->pSrcMemInfo = &psSrc->sMemInfo;
+	psBlt->SrcStride = TEST_SURFACE_WIDTH * 4;
+	psBlt->SrcFormat = PVR2D_ARGB8888;
+	psBlt->SrcSurfWidth = TEST_SURFACE_WIDTH;
+	psBlt->SrcSurfHeight = TEST_SURFACE_HEIGHT;
+	psBlt->SrcX = i32SrcX;
+	psBlt->SrcY = i32SrcY;
+	psBlt->SizeX = i32Width;
+	psBlt->SizeY = i32Height;
+}
+
+static IMG_VOID MakeFill(PVR2DBLTINFO *psBlt, TEST_SURFACE *psDst, IMG_UINT32 ui32Colour,
+						 IMG_INT32 i32DstX, IMG_INT32 i32DstY,
+						 IMG_INT32 i32Width, IMG_INT32 i32Height)
+{
+	memset(psBlt, 0, sizeof(*psBlt));
+	psBlt->CopyCode = PVR2DPATROPcopy;
+	psBlt->Colour = ui32Colour;
+	SetDest(psBlt, psDst, PVR2D_ARGB8888, 4);
+	psBlt->DstX = i32DstX;
+	psBlt->DstY = i32DstY;
+	psBlt->DSizeX = i32Width;
+	psBlt->DSizeY = i32Height;
+}
+
+/*
+	Submits the blits with PVR2DBltBatch to the surfaces they name and one
+	by one with PVR2DBlt to the same blits retargeted from psDst to psRef
+	(which must start equal), then compares psDst and psRef.
+*/
+static PVR2DERROR RunBatch(PVR2DCONTEXTHANDLE hContext, const IMG_CHAR *pszTest,
+						   PVR2DBLTINFO *psBlts, IMG_UINT32 ui32NumBlts,
+						   TEST_SURFACE *psDst, TEST_SURFACE *psRef,
+						   PVR2DBATCHSTATS *psStats)
+{
+	PVR2DBLTINFO asRefBlts[TEST_MAX_BLTS];
+	PVR2DERROR eBatchResult;
+	IMG_UINT32 ui32Transfers;
+	IMG_UINT32 i;
+
+	if (bVerbose)
+	{
+		printf("%s\n", pszTest);
+	}
+
+	memcpy(asRefBlts, psBlts, ui32NumBlts * sizeof(PVR2DBLTINFO));
+
+	eBatchResult = PVR2DBltBatch(hContext, psBlts, ui32NumBlts, psStats);
+
+	if (!psRef)
+	{
+		return eBatchResult;
+	}
+
+	/* Reference: the same blits, queued one at a time */
+	ui32Transfers = sQueue.ui32Transfers;
+	for (i = 0; i < ui32NumBlts; i++)
+	{
+		if (asRefBlts[i].pDstMemInfo == &psDst->sMemInfo)
+		{
+			asRefBlts[i].pDstMemInfo = &psRef->sMemInfo;
+		}
+		if (asRefBlts[i].pSrcMemInfo == &psDst->sMemInfo)
+		{
+			asRefBlts[i].pSrcMemInfo = &psRef->sMemInfo;
+		}
+		Check((IMG_BOOL)(PVR2DBlt(hContext, &asRefBlts[i]) == PVR2D_OK), pszTest, "reference blit failed");
+	}
+	CheckCount(sQueue.ui32Transfers - ui32Transfers, ui32NumBlts, pszTest, "reference transfers");
+
+	Check((IMG_BOOL)(memcmp(psDst->pbyData, psRef->pbyData, psDst->ui32Size) == 0), pszTest,
+		  "batched result differs from the blits queued one by one");
+
+	return eBatchResult;
+}
+
+/*****************************************************************************
+ Tests
+*****************************************************************************/
+
+/* Disjoint damage rects copied in place: one clip blit, one sync update */
+static IMG_VOID TestDamageCopy(PVR2DCONTEXTHANDLE hContext)
+{
+	const IMG_CHAR *pszTest = "damage copy";
+	TEST_SURFACE *psSrc = CreateSurface(4);
+	TEST_SURFACE *psDst = CreateSurface(4);
+	TEST_SURFACE *psRef = CreateSurface(4);
+	PVR2DBLTINFO asBlts[6];
+	PVR2DBATCHSTATS sStats;
+	PVR2DERROR eResult;
+
+	CopySurface(psRef, psDst);
+
+	MakeCopy(&asBlts[0], psSrc, psDst, 2, 3, 2, 3, 10, 5);
+	MakeCopy(&asBlts[1], psSrc, psDst, 40, 1, 40, 1, 8, 8);
+	MakeCopy(&asBlts[2], psSrc, psDst, 70, 20, 70, 20, 26, 4);
+	MakeCopy(&asBlts[3], psSrc, psDst, 0, 50, 0, 50, 30, 14);
+	MakeCopy(&asBlts[4], psSrc, psDst, 5, 6, 5, 6, 20, 20);		/* overlaps the first */
+	MakeCopy(&asBlts[5], psSrc, psDst, 60, 40, 60, 40, 1, 1);
+
+	eResult = RunBatch(hContext, pszTest, asBlts, 6, psDst, psRef, &sStats);
+
+	Check((IMG_BOOL)(eResult == PVR2D_OK), pszTest, "PVR2DBltBatch failed");
+	CheckCount(sStats.ulNumBlts, 6, pszTest, "ulNumBlts");
+	CheckCount(sStats.ulNumMerged, 5, pszTest, "ulNumMerged");
+	CheckCount(sStats.ulNumSubmitted, 1, pszTest, "ulNumSubmitted");
+	CheckCount(psDst->ui32WriteOps, 1, pszTest, "dest sync updates");
+	CheckCount(psRef->ui32WriteOps, 6, pszTest, "reference dest sync updates");
+	CheckCount(sQueue.ui32ClipBlits, 1, pszTest, "clip blits");
+	CheckCount(sQueue.ui32ClipRects, 6, pszTest, "clip rects");
+}
+
+/* Strips that tile a rectangle become a single rectangle */
+static IMG_VOID TestAdjacentStrips(PVR2DCONTEXTHANDLE hContext)
+{
+	const IMG_CHAR *pszTest = "adjacent strips";
+	TEST_SURFACE *psSrc = CreateSurface(4);
+	TEST_SURFACE *psDst = CreateSurface(4);
+	TEST_SURFACE *psRef = CreateSurface(4);
+	PVR2DBLTINFO asBlts[8];
+	PVR2DBATCHSTATS sStats;
+	PVR2DERROR eResult;
+	IMG_UINT32 i;
+
+	CopySurface(psRef, psDst);
+
+	/* Fills stacked downwards, then a translated copy built right to left */
+	for (i = 0; i < 4; i++)
+	{
+		MakeFill(&asBlts[i], psDst, 0xFF204080, 8, 4 + 6 * i, 30, 6);
+	}
+	for (i = 0; i < 4; i++)
+	{
+		MakeCopy(&asBlts[4 + i], psSrc, psDst, 10 + 9 * (3 - i), 33, 50 + 9 * (3 - i), 40, 9, 12);
+	}
+
+	eResult = RunBatch(hContext, pszTest, asBlts, 8, psDst, psRef, &sStats);
+
+	Check((IMG_BOOL)(eResult == PVR2D_OK), pszTest, "PVR2DBltBatch failed");
+	CheckCount(sStats.ulNumMerged, 6, pszTest, "ulNumMerged");
+	CheckCount(sStats.ulNumSubmitted, 2, pszTest, "ulNumSubmitted");
+	CheckCount(sQueue.ui32Fills, 1 + 4, pszTest, "fills (batch + reference)");
+	CheckCount(sQueue.ui32ClipBlits, 0, pszTest, "clip blits");
+	CheckCount(psDst->ui32WriteOps, 2, pszTest, "dest sync updates");
+}
+
+/* Blits that must stay apart: different state, rops, or reading the dest */
+static IMG_VOID TestNoMerge(PVR2DCONTEXTHANDLE hContext)
+{
+	const IMG_CHAR *pszTest = "no merge";
+	TEST_SURFACE *psSrc = CreateSurface(4);
+	TEST_SURFACE *psDst = CreateSurface(4);
+	TEST_SURFACE *psRef = CreateSurface(4);
+	PVR2DBLTINFO asBlts[8];
+	PVR2DBATCHSTATS sStats;
+	PVR2DERROR eResult;
+
+	CopySurface(psRef, psDst);
+
+	/* Adjacent fills of different colours */
+	MakeFill(&asBlts[0], psDst, 0xFF0000FF, 0, 0, 10, 10);
+	MakeFill(&asBlts[1], psDst, 0xFF00FF00, 10, 0, 10, 10);
+
+	/* Adjacent, but not the same source to dest offset */
+	MakeCopy(&asBlts[2], psSrc, psDst, 0, 20, 0, 20, 10, 10);
+	MakeCopy(&asBlts[3], psSrc, psDst, 11, 20, 10, 20, 10, 10);
+
+	/* Scrolls within the dest: the second reads what the first wrote */
+	MakeCopy(&asBlts[4], psDst, psDst, 40, 1, 40, 0, 20, 10);
+	MakeCopy(&asBlts[5], psDst, psDst, 40, 11, 40, 10, 20, 10);
+
+	/* Disjoint rop and alpha blits can't be drawn as clip blits */
+	MakeCopy(&asBlts[6], psSrc, psDst, 70, 0, 70, 0, 8, 8);
+	asBlts[6].CopyCode = PVR2DROPxor;
+	MakeCopy(&asBlts[7], psSrc, psDst, 70, 30, 70, 30, 8, 8);
+	asBlts[7].CopyCode = PVR2DROPxor;
+
+	eResult = RunBatch(hContext, pszTest, asBlts, 8, psDst, psRef, &sStats);
+
+	Check((IMG_BOOL)(eResult == PVR2D_OK), pszTest, "PVR2DBltBatch failed");
+	CheckCount(sStats.ulNumMerged, 0, pszTest, "ulNumMerged");
+	CheckCount(sStats.ulNumSubmitted, 8, pszTest, "ulNumSubmitted");
+	CheckCount(sQueue.ui32ClipBlits, 0, pszTest, "clip blits");
+}
+
+/* Rop and alpha blits still merge when their rects share edges */
+static IMG_VOID TestStateMerge(PVR2DCONTEXTHANDLE hContext)
+{
+	const IMG_CHAR *pszTest = "rop and alpha merge";
+	TEST_SURFACE *psSrc = CreateSurface(4);
+	TEST_SURFACE *psDst = CreateSurface(4);
+	TEST_SURFACE *psRef = CreateSurface(4);
+	PVR2DBLTINFO asBlts[6];
+	PVR2DBATCHSTATS sStats;
+	PVR2DERROR eResult;
+	IMG_UINT32 i;
+
+	CopySurface(psRef, psDst);
+
+	for (i = 0; i < 3; i++)
+	{
+		MakeCopy(&asBlts[i], psSrc, psDst, 4 + 8 * i, 4, 20 + 8 * i, 30, 8, 16);
+		asBlts[i].CopyCode = PVR2DROPxor;
+	}
+	for (i = 0; i < 3; i++)
+	{
+		MakeCopy(&asBlts[3 + i], psSrc, psDst, 50, 2 + 5 * i, 60, 2 + 5 * i, 20, 5);
+		asBlts[3 + i].BlitFlags = PVR2D_BLIT_GLOBAL_ALPHA_ENABLE;
+		asBlts[3 + i].GlobalAlphaValue = 0x60;
+	}
+
+	eResult = RunBatch(hContext, pszTest, asBlts, 6, psDst, psRef, &sStats);
+
+	Check((IMG_BOOL)(eResult == PVR2D_OK), pszTest, "PVR2DBltBatch failed");
+	CheckCount(sStats.ulNumMerged, 4, pszTest, "ulNumMerged");
+	CheckCount(sStats.ulNumSubmitted, 2, pszTest, "ulNumSubmitted");
+}
+
+/* A bad entry anywhere fails the batch before anything is queued */
+static IMG_VOID TestValidation(PVR2DCONTEXTHANDLE hContext)
+{
+	const IMG_CHAR *pszTest = "validation";
+	TEST_SURFACE *psSrc = CreateSurface(4);
+	TEST_SURFACE *psDst = CreateSurface(4);
+	PVR2DBLTINFO asBlts[3];
+	PVR2DBATCHSTATS sStats;
+	PVR2DERROR eResult;
+	IMG_BYTE *pbyBefore = malloc(psDst->ui32Size);
+
+	if (!pbyBefore)
+	{
+		fprintf(stderr, "Out of memory\n");
+		exit(1);
+	}
+	memcpy(pbyBefore, psDst->pbyData, psDst->ui32Size);
+
+	MakeCopy(&asBlts[0], psSrc, psDst, 0, 0, 0, 0, 10, 10);
+	MakeCopy(&asBlts[1], psSrc, psDst, 10, 0, 10, 0, 10, 10);
+	MakeCopy(&asBlts[2], psSrc, psDst, 20, 0, 20, 0, 10, 10);
+	asBlts[2].DstFormat = PVR2D_1BPP;
+
+	eResult = RunBatch(hContext, pszTest, asBlts, 3, psDst, IMG_NULL, &sStats);
+
+	Check((IMG_BOOL)(eResult == PVR2DERROR_INVALID_PARAMETER), pszTest, "bad dest format accepted");
+	CheckCount(sQueue.ui32Transfers, 0, pszTest, "transfers");
+	CheckCount(sStats.ulNumSubmitted, 0, pszTest, "ulNumSubmitted");
+	Check((IMG_BOOL)(memcmp(pbyBefore, psDst->pbyData, psDst->ui32Size) == 0), pszTest, "dest written");
+
+	/* Missing source */
+	MakeCopy(&asBlts[2], psSrc, psDst, 20, 0, 20, 0, 10, 10);
+	asBlts[1].pSrcMemInfo = IMG_NULL;
+	eResult = RunBatch(hContext, pszTest, asBlts, 3, psDst, IMG_NULL, IMG_NULL);
+	Check((IMG_BOOL)(eResult == PVR2DERROR_INVALID_PARAMETER), pszTest, "missing source accepted");
+	CheckCount(sQueue.ui32Transfers, 0, pszTest, "transfers");
+
+	/* Argument checks */
+	Check((IMG_BOOL)(PVR2DBltBatch(IMG_NULL, asBlts, 3, &sStats) == PVR2DERROR_INVALID_CONTEXT), pszTest, "null context accepted");
+	Check((IMG_BOOL)(PVR2DBltBatch(hContext, IMG_NULL, 3, &sStats) == PVR2DERROR_INVALID_PARAMETER), pszTest, "null array accepted");
+	Check((IMG_BOOL)(PVR2DBltBatch(hContext, IMG_NULL, 0, &sStats) == PVR2D_OK), pszTest, "empty batch rejected");
+	CheckCount(sStats.ulNumBlts, 0, pszTest, "empty batch ulNumBlts");
+	CheckCount(sQueue.ui32Transfers, 0, pszTest, "transfers");
+
+	free(pbyBefore);
+}
+
+/* A path that refuses clip blits gets the run one blit at a time */
+static IMG_VOID TestClipBlitFallback(PVR2DCONTEXTHANDLE hContext)
+{
+	const IMG_CHAR *pszTest = "clip blit fallback";
+	TEST_SURFACE *psSrc = CreateSurface(4);
+	TEST_SURFACE *psDst = CreateSurface(4);
+	TEST_SURFACE *psRef = CreateSurface(4);
+	PVR2DBLTINFO asBlts[4];
+	PVR2DBATCHSTATS sStats;
+	PVR2DERROR eResult;
+
+	CopySurface(psRef, psDst);
+	sQueue.bRejectClipBlits = IMG_TRUE;
+
+	MakeCopy(&asBlts[0], psSrc, psDst, 0, 0, 0, 0, 10, 10);
+	MakeCopy(&asBlts[1], psSrc, psDst, 30, 30, 30, 30, 10, 10);
+	MakeCopy(&asBlts[2], psSrc, psDst, 60, 5, 60, 5, 10, 10);
+	MakeCopy(&asBlts[3], psSrc, psDst, 60, 15, 60, 15, 10, 10);
+
+	eResult = RunBatch(hContext, pszTest, asBlts, 4, psDst, psRef, &sStats);
+
+	Check((IMG_BOOL)(eResult == PVR2D_OK), pszTest, "PVR2DBltBatch failed");
+	CheckCount(sStats.ulNumMerged, 0, pszTest, "ulNumMerged");
+	CheckCount(sStats.ulNumSubmitted, 4, pszTest, "ulNumSubmitted");
+
+	sQueue.bRejectClipBlits = IMG_FALSE;
+}
+
+/* More rects than one clip blit takes */
+static IMG_VOID TestManyRects(PVR2DCONTEXTHANDLE hContext)
+{
+	const IMG_CHAR *pszTest = "many rects";
+	TEST_SURFACE *psSrc = CreateSurface(4);
+	TEST_SURFACE *psDst = CreateSurface(4);
+	TEST_SURFACE *psRef = CreateSurface(4);
+	PVR2DBLTINFO asBlts[60];
+	PVR2DBATCHSTATS sStats;
+	PVR2DERROR eResult;
+	IMG_UINT32 i;
+
+	CopySurface(psRef, psDst);
+
+	/* A checkerboard: no two rects share an edge */
+	for (i = 0; i < 60; i++)
+	{
+		IMG_INT32 x = (IMG_INT32)(i % 10) * 8;
+		IMG_INT32 y = (IMG_INT32)(i / 10) * 8 + ((i % 2) ? 4 : 0);
+
+		MakeCopy(&asBlts[i], psSrc, psDst, x, y, x, y, 4, 4);
+	}
+
+	eResult = RunBatch(hContext, pszTest, asBlts, 60, psDst, psRef, &sStats);
+
+	Check((IMG_BOOL)(eResult == PVR2D_OK), pszTest, "PVR2DBltBatch failed");
+	CheckCount(sStats.ulNumMerged, 58, pszTest, "ulNumMerged");
+	CheckCount(sStats.ulNumSubmitted, 2, pszTest, "ulNumSubmitted");
+	CheckCount(sQueue.ui32ClipBlits, 2, pszTest, "clip blits");
+	CheckCount(sQueue.ui32ClipRects, 60, pszTest, "clip rects");
+}
+
+/* 16 bit surfaces, a change of dest, and the stats pointer left out */
+static IMG_VOID TestMixed(PVR2DCONTEXTHANDLE hContext)
+{
+	const IMG_CHAR *pszTest = "mixed";
+	TEST_SURFACE *psSrc = CreateSurface(2);
+	TEST_SURFACE *psDst = CreateSurface(2);
+	TEST_SURFACE *psRef = CreateSurface(2);
+	TEST_SURFACE *psOther = CreateSurface(2);
+	PVR2DBLTINFO asBlts[5];
+	PVR2DBATCHSTATS sStats;
+	PVR2DERROR eResult;
+	IMG_UINT32 i;
+
+	CopySurface(psRef, psDst);
+
+	for (i = 0; i < 5; i++)
+	{
+		MakeCopy(&asBlts[i], psSrc, (i == 2) ? psOther : psDst, 10 * i, 10 * i, 10 * i, 10 * i, 6, 6);
+		asBlts[i].SrcFormat = PVR2D_RGB565;
+		asBlts[i].SrcStride = TEST_SURFACE_WIDTH * 2;
+		SetDest(&asBlts[i], (i == 2) ? psOther : psDst, PVR2D_RGB565, 2);
+	}
+
+	eResult = RunBatch(hContext, pszTest, asBlts, 5, psDst, psRef, &sStats);
+	Check((IMG_BOOL)(eResult == PVR2D_OK), pszTest, "PVR2DBltBatch failed");
+	CheckCount(sStats.ulNumMerged, 2, pszTest, "ulNumMerged");
+	CheckCount(sStats.ulNumSubmitted, 3, pszTest, "ulNumSubmitted");
+	CheckCount(psOther->ui32WriteOps, 2, pszTest, "other dest sync updates");
+
+	Check((IMG_BOOL)(PVR2DBltBatch(hContext, asBlts, 5, IMG_NULL) == PVR2D_OK), pszTest, "batch without stats failed");
+}
+
+typedef IMG_VOID (*PFN_TEST)(PVR2DCONTEXTHANDLE hContext);
+
+int main(int argc, char **argv)
+{
+	static const PFN_TEST apfnTests[] =
+	{
+		TestDamageCopy,
+		TestAdjacentStrips,
+		TestNoMerge,
+		TestStateMerge,
+		TestValidation,
+		TestClipBlitFallback,
+		TestManyRects,
+		TestMixed,
+	};
+	PVR2DCONTEXT *psContext;
+	IMG_UINT32 i;
+
+	for (i = 1; i < (IMG_UINT32)argc; i++)
+	{
+		if (strcmp(argv[i], "-v") == 0)
+		{
+			bVerbose = IMG_TRUE;
+		}
+		else
+		{
+			fprintf(stderr, "Usage: %s [-v]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	psContext = calloc(1, sizeof(PVR2DCONTEXT));
+	if (!psContext)
+	{
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+
+	for (i = 0; i < sizeof(apfnTests) / sizeof(apfnTests[0]); i++)
+	{
+		memset(&sQueue, 0, sizeof(sQueue));
+		apfnTests[i]((PVR2DCONTEXTHANDLE)psContext);
+		CheckCount(sQueue.ui32Errors, 0, "mock queue", "bad transfers");
+		DestroySurfaces();
+	}
+
+	free(psContext);
+
+	if (ui32Failures)
+	{
+		printf("%u checks failed\n", ui32Failures);
+		return 1;
+	}
+
+	printf("all checks passed\n");
+	return 0;
+}
+
+/******************************************************************************
+ End of file (main.c)
+******************************************************************************/
@@ -0,0 +1,45 @@
+# Copyright	2010 Imagination Technologies Limited. All rights reserved.
+#
+# No part of this software, either material or conceptual may be
+# copied or distributed, transmitted, transcribed, stored in a
+# retrieval system or translated into any human or computer
+# language in any form by any means, electronic, mechanical,
+# manual or other-wise, or disclosed to third parties without
+# the express written permission of: Imagination Technologies
+# Limited, HomePark Industrial Estate, Kings Langley,
+# Hertfordshire, WD4 8LZ, UK
+#
+# $Log: Linux.mk $
+#
+
+# twiddle.c is built once for the SGX543 MP4 of the device, which twiddles
+# in squares, and once for an SGX545, which has hybrid twiddling.
+modules := subtwiddletest_sgx543 subtwiddletest_sgx545
+
+subtwiddletest_sgx543_type := host_executable
+
+subtwiddletest_sgx543_target := subtwiddletest_sgx543
+
+subtwiddletest_sgx543_src = \
+ main.c \
+ $(TOP)/eurasiacon/common/twiddle.c
+
+subtwiddletest_sgx543_cflags := \
+ -DLINUX -DSGX543 -DSGX_CORE_REV=216 -DSGX_FEATURE_MP \
+ -DSGX_FEATURE_MP_CORE_COUNT=4 -DSGX_FEATURE_SYSTEM_CACHE
+
+subtwiddletest_sgx543_includes := include4 include/gpu_es4 hwdefs include \
+ eurasiacon/include eurasiacon/common host/include
+
+subtwiddletest_sgx545_type := host_executable
+
+subtwiddletest_sgx545_target := subtwiddletest_sgx545
+
+subtwiddletest_sgx545_src = \
+ main.c \
+ $(TOP)/eurasiacon/common/twiddle.c
+
+subtwiddletest_sgx545_cflags := -DLINUX -DSGX545 -DSGX_CORE_REV=1014
+
+subtwiddletest_sgx545_includes := include4 include/gpu_es4 hwdefs include \
+ eurasiacon/include eurasiacon/common host/include
@@ -0,0 +1,381 @@
+/******************************************************************************
+ * Name         : main.c
+ * Title        : Sub-rectangle twiddling tests (subtwiddletest)
+ *
+ * Copyright    : 2010 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means,electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Description  : Builds eurasiacon/common/twiddle.c on the host and checks
+ *                that DeTwiddleSubRect8bpp, 16bpp and 32bpp, writing a
+ *                rectangle into a twiddled level, leave it bit for bit as
+ *                DeTwiddleAddress leaves the whole level with the
+ *                rectangle replaced.
+ *
+ *                Every rectangle of the small levels is tried, and random
+ *                ones of the larger levels. subtwiddletest_sgx543 checks
+ *                the square twiddling of the SGX543, power of two levels
+ *                only; subtwiddletest_sgx545 checks hybrid twiddling, with
+ *                levels of any size.
+ *
+ *                Exits with a non-zero status if a check fails; -v also
+ *                times glyph sized updates to a texture atlas against
+ *                reading back and twiddling the whole level.
+ *
+ * Modifications:-
+ * $Log: main.c $
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "img_types.h"
+#include "img_defs.h"
+#include "sgxdefs.h"
+#include "twiddle.h"
+#include "hosttest.h"
+
+/* Levels up to this size have every rectangle checked */
+#define TEST_EXHAUSTIVE_SIZE	8
+#define TEST_RANDOM_RECTS		200
+
+/* Largest side of the small rectangles tried, as glyphs and tiles are */
+#define TEST_SMALL_RECT			40
+
+/* Slack either side of the source rows, so reads outside the rectangle show up */
+#define TEST_SRC_PAD			3
+
+#define TEST_BENCH_ATLAS		1024
+#define TEST_BENCH_GLYPH		16
+#define TEST_BENCH_UPDATES		4096
+
+typedef IMG_VOID (*PFN_TWIDDLE)(IMG_VOID *pvDestAddress, const IMG_VOID *pvSrcPixels,
+								IMG_UINT32 ui32Width, IMG_UINT32 ui32Height, IMG_UINT32 ui32StrideIn);
+
+typedef IMG_VOID (*PFN_SUB_TWIDDLE)(IMG_VOID *pvDestAddress, const IMG_VOID *pvSrcPixels,
+									IMG_UINT32 ui32Width, IMG_UINT32 ui32Height,
+									IMG_UINT32 ui32XOffset, IMG_UINT32 ui32YOffset,
+									IMG_UINT32 ui32SubWidth, IMG_UINT32 ui32SubHeight,
+									IMG_UINT32 ui32StrideIn);
+
+typedef struct _TWIDDLE_FNS_
+{
+	IMG_UINT32		ui32BytesPerTexel;
+	PFN_TWIDDLE		pfnTwiddle;
+	PFN_SUB_TWIDDLE	pfnSubTwiddle;
+} TWIDDLE_FNS;
+
+static const TWIDDLE_FNS asFns[] =
+{
+	{1, DeTwiddleAddress8bpp,  DeTwiddleSubRect8bpp},
+	{2, DeTwiddleAddress16bpp, DeTwiddleSubRect16bpp},
+	{4, DeTwiddleAddress32bpp, DeTwiddleSubRect32bpp},
+};
+
+#define NUM_FNS		(sizeof(asFns) / sizeof(asFns[0]))
+
+static IMG_BOOL bVerbose = IMG_FALSE;
+static IMG_UINT32 ui32Rects = 0;
+
+static IMG_UINT64 TimeNs(IMG_VOID)
+{
+	struct timespec sTime;
+
+	clock_gettime(CLOCK_MONOTONIC, &sTime);
+
+	return (IMG_UINT64)sTime.tv_sec * 1000000000 + (IMG_UINT64)sTime.tv_nsec;
+}
+
+static IMG_VOID FillRandom(IMG_BYTE *pbyData, IMG_UINT32 ui32Size)
+{
+	IMG_UINT32 i;
+
+	for (i = 0; i < ui32Size; i++)
+	{
+		pbyData[i] = (IMG_BYTE)Random();
+	}
+}
+
+/* Texels a twiddled level takes, padding included */
+static IMG_UINT32 TwiddledTexels(IMG_UINT32 ui32Width, IMG_UINT32 ui32Height)
+{
+#if defined(SGX_FEATURE_HYBRID_TWIDDLING)
+	IMG_UINT32 ui32TileSize = GetTileSize(ui32Width, ui32Height);
+
+	return ((ui32Width + ui32TileSize - 1) / ui32TileSize) * ((ui32Height + ui32TileSize - 1) / ui32TileSize) *
+		   ui32TileSize * ui32TileSize;
+#else
+	return ui32Width * ui32Height;
+#endif
+}
+
+#if !defined(SGX_FEATURE_HYBRID_TWIDDLING)
+static IMG_BOOL IsPow2(IMG_UINT32 ui32Value)
+{
+	return ((ui32Value & (ui32Value - 1)) == 0) ? IMG_TRUE : IMG_FALSE;
+}
+#endif
+
+/*
+	Twiddles image A, writes a rectangle of new texels over it, and compares the
+	result with twiddling image A with the rectangle replaced.
+*/
+static IMG_VOID CheckRect(const TWIDDLE_FNS *psFns, IMG_UINT32 ui32Width, IMG_UINT32 ui32Height,
+						  IMG_UINT32 ui32XOffset, IMG_UINT32 ui32YOffset,
+						  IMG_UINT32 ui32SubWidth, IMG_UINT32 ui32SubHeight)
+{
+	IMG_UINT32 ui32Bpp = psFns->ui32BytesPerTexel;
+	IMG_UINT32 ui32TwiddledSize = TwiddledTexels(ui32Width, ui32Height) * ui32Bpp;
+	IMG_UINT32 ui32SrcStride = ui32SubWidth + 2 * TEST_SRC_PAD;
+	IMG_UINT32 ui32SrcSize = ui32SrcStride * (ui32SubHeight + 2) * ui32Bpp;
+	IMG_BYTE *pbyImage, *pbySrc, *pbyExpected, *pbyResult;
+	IMG_CHAR szTest[96];
+	IMG_UINT32 y;
+
+	pbyImage = malloc(ui32Width * ui32Height * ui32Bpp);
+	pbySrc = malloc(ui32SrcSize);
+	pbyExpected = malloc(ui32TwiddledSize);
+	pbyResult = malloc(ui32TwiddledSize);
+
+	if (!pbyImage || !pbySrc || !pbyExpected || !pbyResult)
+	{
+		fprintf(stderr, "out of memory\n");
+		exit(2);
+	}
+
+	snprintf(szTest, sizeof(szTest), "%ubpp %ux%u rect %u,%u %ux%u",
+			 ui32Bpp * 8, ui32Width, ui32Height, ui32XOffset, ui32YOffset, ui32SubWidth, ui32SubHeight);
+
+	FillRandom(pbyImage, ui32Width * ui32Height * ui32Bpp);
+	FillRandom(pbySrc, ui32SrcSize);
+
+	/* Padding the twiddlers skip must match too */
+	memset(pbyExpected, 0xA5, ui32TwiddledSize);
+	memset(pbyResult, 0xA5, ui32TwiddledSize);
+
+	psFns->pfnTwiddle(pbyResult, pbyImage, ui32Width, ui32Height, ui32Width);
+
+	/* The rectangle starts a row and some texels into the source */
+	psFns->pfnSubTwiddle(pbyResult, pbySrc + (ui32SrcStride + TEST_SRC_PAD) * ui32Bpp,
+						 ui32Width, ui32Height, ui32XOffset, ui32YOffset, ui32SubWidth, ui32SubHeight, ui32SrcStride);
+
+	for (y = 0; y < ui32SubHeight; y++)
+	{
+		memcpy(pbyImage + ((ui32YOffset + y) * ui32Width + ui32XOffset) * ui32Bpp,
+			   pbySrc + ((y + 1) * ui32SrcStride + TEST_SRC_PAD) * ui32Bpp,
+			   ui32SubWidth * ui32Bpp);
+	}
+
+	psFns->pfnTwiddle(pbyExpected, pbyImage, ui32Width, ui32Height, ui32Width);
+
+	Check((memcmp(pbyExpected, pbyResult, ui32TwiddledSize) == 0) ? IMG_TRUE : IMG_FALSE, szTest, "level differs from a full twiddle");
+
+	ui32Rects++;
+
+	free(pbyImage);
+	free(pbySrc);
+	free(pbyExpected);
+	free(pbyResult);
+}
+
+static IMG_VOID TestLevel(const TWIDDLE_FNS *psFns, IMG_UINT32 ui32Width, IMG_UINT32 ui32Height)
+{
+	IMG_UINT32 x, y, w, h, i;
+
+	if ((ui32Width <= TEST_EXHAUSTIVE_SIZE) && (ui32Height <= TEST_EXHAUSTIVE_SIZE))
+	{
+		for (y = 0; y < ui32Height; y++)
+		{
+			for (x = 0; x < ui32Width; x++)
+			{
+				for (h = 0; h <= ui32Height - y; h++)
+				{
+					for (w = 0; w <= ui32Width - x; w++)
+					{
+						CheckRect(psFns, ui32Width, ui32Height, x, y, w, h);
+					}
+				}
+			}
+		}
+
+		return;
+	}
+
+	/* The whole level, a texel in each corner, and random rectangles */
+	CheckRect(psFns, ui32Width, ui32Height, 0, 0, ui32Width, ui32Height);
+	CheckRect(psFns, ui32Width, ui32Height, 0, 0, 1, 1);
+	CheckRect(psFns, ui32Width, ui32Height, ui32Width - 1, 0, 1, 1);
+	CheckRect(psFns, ui32Width, ui32Height, 0, ui32Height - 1, 1, 1);
+	CheckRect(psFns, ui32Width, ui32Height, ui32Width - 1, ui32Height - 1, 1, 1);
+
+	for (i = 0; i < TEST_RANDOM_RECTS; i++)
+	{
+		x = Random() % ui32Width;
+		y = Random() % ui32Height;
+
+		w = 1 + Random() % (ui32Width - x);
+		h = 1 + Random() % (ui32Height - y);
+
+		if (Random() & 1)
+		{
+			w = 1 + (w - 1) % TEST_SMALL_RECT;
+			h = 1 + (h - 1) % TEST_SMALL_RECT;
+		}
+
+		CheckRect(psFns, ui32Width, ui32Height, x, y, w, h);
+	}
+}
+
+static IMG_VOID TestLevels(IMG_VOID)
+{
+	static const IMG_UINT32 aui32Sizes[] = {1, 2, 3, 4, 5, 7, 8, 16, 17, 32, 33, 64, 100, 128, 256};
+	IMG_UINT32 ui32NumSizes = sizeof(aui32Sizes) / sizeof(aui32Sizes[0]);
+	IMG_UINT32 f, i, j;
+
+	for (f = 0; f < NUM_FNS; f++)
+	{
+		IMG_UINT32 ui32Before = ui32Rects;
+
+		for (i = 0; i < ui32NumSizes; i++)
+		{
+			for (j = 0; j < ui32NumSizes; j++)
+			{
+				IMG_UINT32 ui32Width = aui32Sizes[i];
+				IMG_UINT32 ui32Height = aui32Sizes[j];
+
+#if !defined(SGX_FEATURE_HYBRID_TWIDDLING)
+				/* Only power of two levels are twiddled */
+				if (!IsPow2(ui32Width) || !IsPow2(ui32Height))
+				{
+					continue;
+				}
+#endif
+				TestLevel(&asFns[f], ui32Width, ui32Height);
+			}
+		}
+
+		if (bVerbose)
+		{
+			printf("%ubpp: %u rectangles checked\n", asFns[f].ui32BytesPerTexel * 8, ui32Rects - ui32Before);
+		}
+	}
+}
+
+/* Glyph sized updates to an atlas: read back and twiddle the level, or twiddle the glyph alone */
+static IMG_VOID Benchmark(IMG_VOID)
+{
+	IMG_UINT32 ui32Texels = TEST_BENCH_ATLAS * TEST_BENCH_ATLAS;
+	IMG_UINT32 ui32Log2 = 0, ui32FullUpdates = 16, i;
+	IMG_UINT32 *pui32Level, *pui32Linear, *pui32Glyph;
+	IMG_UINT64 ui64Start, ui64FullNs, ui64SubNs;
+
+	if (!bVerbose)
+	{
+		return;
+	}
+
+	while ((1U << ui32Log2) < TEST_BENCH_ATLAS)
+	{
+		ui32Log2++;
+	}
+
+	pui32Level = malloc(TwiddledTexels(TEST_BENCH_ATLAS, TEST_BENCH_ATLAS) * sizeof(IMG_UINT32));
+	pui32Linear = malloc(ui32Texels * sizeof(IMG_UINT32));
+	pui32Glyph = malloc(TEST_BENCH_GLYPH * TEST_BENCH_GLYPH * sizeof(IMG_UINT32));
+
+	if (!pui32Level || !pui32Linear || !pui32Glyph)
+	{
+		fprintf(stderr, "out of memory\n");
+		exit(2);
+	}
+
+	FillRandom((IMG_BYTE *)pui32Linear, ui32Texels * sizeof(IMG_UINT32));
+	FillRandom((IMG_BYTE *)pui32Glyph, TEST_BENCH_GLYPH * TEST_BENCH_GLYPH * sizeof(IMG_UINT32));
+
+	DeTwiddleAddress32bpp(pui32Level, pui32Linear, TEST_BENCH_ATLAS, TEST_BENCH_ATLAS, TEST_BENCH_ATLAS);
+
+	ui64Start = TimeNs();
+
+	for (i = 0; i < ui32FullUpdates; i++)
+	{
+		IMG_UINT32 x = (Random() % (TEST_BENCH_ATLAS / TEST_BENCH_GLYPH)) * TEST_BENCH_GLYPH;
+		IMG_UINT32 y = (Random() % (TEST_BENCH_ATLAS / TEST_BENCH_GLYPH)) * TEST_BENCH_GLYPH;
+		IMG_UINT32 r;
+
+		ReadBackTwiddle32bpp(pui32Linear, pui32Level, ui32Log2, ui32Log2, TEST_BENCH_ATLAS, TEST_BENCH_ATLAS, TEST_BENCH_ATLAS);
+
+		for (r = 0; r < TEST_BENCH_GLYPH; r++)
+		{
+			memcpy(&pui32Linear[(y + r) * TEST_BENCH_ATLAS + x], &pui32Glyph[r * TEST_BENCH_GLYPH], TEST_BENCH_GLYPH * sizeof(IMG_UINT32));
+		}
+
+		DeTwiddleAddress32bpp(pui32Level, pui32Linear, TEST_BENCH_ATLAS, TEST_BENCH_ATLAS, TEST_BENCH_ATLAS);
+	}
+
+	ui64FullNs = (TimeNs() - ui64Start) / ui32FullUpdates;
+
+	ui64Start = TimeNs();
+
+	for (i = 0; i < TEST_BENCH_UPDATES; i++)
+	{
+		/* Glyphs are not aligned to tiles, so the edge strips are timed too */
+		IMG_UINT32 x = Random() % (TEST_BENCH_ATLAS - TEST_BENCH_GLYPH);
+		IMG_UINT32 y = Random() % (TEST_BENCH_ATLAS - TEST_BENCH_GLYPH);
+
+		DeTwiddleSubRect32bpp(pui32Level, pui32Glyph, TEST_BENCH_ATLAS, TEST_BENCH_ATLAS,
+							  x, y, TEST_BENCH_GLYPH, TEST_BENCH_GLYPH, TEST_BENCH_GLYPH);
+	}
+
+	ui64SubNs = (TimeNs() - ui64Start) / TEST_BENCH_UPDATES;
+
+	printf("%ux%u glyph into a %ux%u 32bpp level: full readback and twiddle %llu ns, sub-rectangle %llu ns\n",
+		   TEST_BENCH_GLYPH, TEST_BENCH_GLYPH, TEST_BENCH_ATLAS, TEST_BENCH_ATLAS,
+		   (unsigned long long)ui64FullNs, (unsigned long long)ui64SubNs);
+
+	free(pui32Level);
+	free(pui32Linear);
+	free(pui32Glyph);
+}
+
+int main(int argc, char **argv)
+{
+	if ((argc == 2) && (strcmp(argv[1], "-v") == 0))
+	{
+		bVerbose = IMG_TRUE;
+	}
+	else if (argc != 1)
+	{
+		fprintf(stderr, "Usage: %s [-v]\n", argv[0]);
+		return 2;
+	}
+
+	TestLevels();
+	Benchmark();
+
+	if (bVerbose)
+	{
+		printf("total: %u rectangles checked\n", ui32Rects);
+	}
+
+	if (ui32Failures)
+	{
+		printf("%u checks failed\n", ui32Failures);
+		return 1;
+	}
+
+	printf("all checks passed\n");
+	return 0;
+}
+
+/******************************************************************************
+ End of file (main.c)
+******************************************************************************/
@@ -0,0 +1,42 @@
+# Copyright	2010 Imagination Technologies Limited. All rights reserved.
+#
+# No part of this software, either material or conceptual may be
+# copied or distributed, transmitted, transcribed, stored in a
+# retrieval system or translated into any human or computer
+# language in any form by any means, electronic, mechanical,
+# manual or other-wise, or disclosed to third parties without
+# the express written permission of: Imagination Technologies
+# Limited, HomePark Industrial Estate, Kings Langley,
+# Hertfordshire, WD4 8LZ, UK
+#
+# $Log: Linux.mk $
+#
+
+modules := tqvalidate
+
+tqvalidate_type := host_executable
+
+tqvalidate_target := tqvalidate
+
+tqvalidate_src = \
+ main.c \
+ tqmock.c \
+ tqinterp.c \
+ $(TOP)/gpu_es4_ext/eurasia/services4/srvclient/devices/sgx/sgxtransfer_queue.c \
+ $(TOP)/gpu_es4_ext/eurasia/services4/srvclient/common/blitlib.c \
+ $(TOP)/gpu_es4_ext/eurasia/services4/srvclient/common/blitlib_src.c \
+ $(TOP)/gpu_es4_ext/eurasia/services4/srvclient/common/blitlib_op.c \
+ $(TOP)/gpu_es4_ext/eurasia/services4/srvclient/common/blitlib_dst.c
+
+# The queue is built for an SGX543 MP4 with the blitlib fallback, as on the
+# device; host/tqvalidate comes first so its stand-in headers are used.
+tqvalidate_cflags := \
+ -DLINUX -DSGX543 -DSGX_CORE_REV=216 -DSGX_FEATURE_MP \
+ -DSGX_FEATURE_MP_CORE_COUNT=4 -DSGX_FEATURE_SYSTEM_CACHE \
+ -DSUPPORT_SGX_NEW_STATUS_VALS -DTRANSFER_QUEUE -DBLITLIB
+
+tqvalidate_includes := host/tqvalidate include4 hwdefs services4/include \
+ services4/srvclient/devices/sgx services4/system/psp2 codegen/pixevent \
+ gpu_es4_ext/eurasia/services4/srvclient/common host/include
+
+tqvalidate_extlibs := m
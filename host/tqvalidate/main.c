@@ -0,0 +1,903 @@
+/******************************************************************************
+ * Name         : main.c
+ * Title        : Transfer queue golden-image validator (tqvalidate)
+ *
+ * Copyright    : 2010 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means,electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Description  : Runs SGXQueueTransfer on the host against the mock services
+ *                layer in tqmock.c. Each case is queued twice: once down the
+ *                3D path only, where every transfer command the queue
+ *                prepares is run by the interpreter in tqinterp.c, and once
+ *                down the blitlib path only. The two destination images
+ *                are compared per channel. Where blitlib has no equivalent
+ *                (rops, per pixel alpha, overlapping copies) the expected
+ *                image comes from a reference written out here instead.
+ *
+ *                After every run the sync objects of the surfaces involved
+ *                must have no operations outstanding. For each case the
+ *                tool prints the number of passes (transfer commands
+ *                kicked), the pixels and bytes the commands moved and the
+ *                circular buffer space they took. It exits with a non-zero
+ *                status if a check fails.
+ *
+ *                -v traces every kick and the records it was built from.
+ *
+ * Modifications:-
+ * $Log: main.c $
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "tqmock.h"
+#include "blitlib.h"
+#include "hosttest.h"
+
+#define TQV_ARENA_SIZE			(32 * 1024 * 1024)
+#define TQV_SURFACE_ALIGN		64
+#define TQV_MAX_CHECKS			8
+
+/* Staging buffers: the default, and one small enough to force block splitting */
+#define TQV_STAGING_SIZE		(64 * 1024)
+#define TQV_SMALL_STAGING_SIZE	(8 * 1024)
+
+#if defined(SGX_FEATURE_HYBRID_TWIDDLING)
+#define TQV_TWIDDLED			BL_MEMLAYOUT_HYBRID_TWIDDLED
+#else
+#define TQV_TWIDDLED			BL_MEMLAYOUT_TWIDDLED
+#endif
+
+typedef struct _TQV_SURFACE_
+{
+	PVRSRV_CLIENT_MEM_INFO	*psMemInfo;
+	PVRSRV_CLIENT_SYNC_INFO	*psSyncInfo;
+
+	/* Offset of row 0, which is the last row in memory for negative strides */
+	IMG_UINT32				ui32Offset;
+
+	IMG_UINT32				ui32Width;
+	IMG_UINT32				ui32Height;
+	IMG_INT32				i32Stride;
+	PVRSRV_PIXEL_FORMAT		eFormat;
+	SGXTQ_MEMLAYOUT			eMemLayout;
+
+	BL_SURFACE				sBL;
+} TQV_SURFACE;
+
+/* A surface decoded to ARGB8888 */
+typedef struct _TQV_IMAGE_
+{
+	IMG_UINT32	ui32Width;
+	IMG_UINT32	ui32Height;
+	IMG_UINT32	*pui32Pixels;
+} TQV_IMAGE;
+
+struct _TQV_CASE_;
+
+/* Writes the expected destination into psDst, which holds its starting contents */
+typedef IMG_VOID (*PFN_TQV_REFERENCE)(const struct _TQV_CASE_ *psCase, const TQV_IMAGE *psSrc, TQV_IMAGE *psDst);
+
+typedef struct _TQV_CASE_
+{
+	const IMG_CHAR		*pszName;
+	SGX_QUEUETRANSFER	sQueueTransfer;
+	IMG_HANDLE			hTransferContext;
+
+	TQV_SURFACE			*psSrc;
+
+	/* Destination views compared; all share one allocation */
+	IMG_UINT32			ui32NumChecks;
+	TQV_SURFACE			*apsChecks[TQV_MAX_CHECKS];
+
+	/* IMG_NULL compares against the blitlib path */
+	PFN_TQV_REFERENCE	pfnReference;
+	IMG_UINT32			ui32Tolerance;
+
+	/* A mismatch that is already understood: reported, not failed */
+	const IMG_CHAR		*pszKnownIssue;
+} TQV_CASE;
+
+static IMG_UINT32 Pow2(IMG_UINT32 ui32Value)
+{
+	IMG_UINT32 ui32Pow2 = 1;
+
+	while (ui32Pow2 < ui32Value)
+	{
+		ui32Pow2 <<= 1;
+	}
+	return ui32Pow2;
+}
+
+static BL_MEMLAYOUT BLLayout(SGXTQ_MEMLAYOUT eMemLayout)
+{
+	return (eMemLayout == SGXTQ_MEMLAYOUT_2D || eMemLayout == SGXTQ_MEMLAYOUT_OUT_TWIDDLED) ?
+		TQV_TWIDDLED : BL_MEMLAYOUT_LINEAR;
+}
+
+static IMG_BYTE *SurfaceBase(const TQV_SURFACE *psSurface)
+{
+	return (IMG_BYTE *)psSurface->psMemInfo->pvLinAddr + psSurface->ui32Offset;
+}
+
+/*****************************************************************************
+ * Function Name		:	SurfaceView
+ * Inputs				:	psMemInfo, psSyncInfo, ui32Offset - where row 0 is
+ *							eFormat, eMemLayout, ui32Width, ui32Height,
+ *							i32Stride - bytes, may be negative
+ * Outputs				:	psSurface
+ * Description			:	Describes a surface inside an existing allocation.
+ ******************************************************************************/
+static IMG_VOID SurfaceView(TQV_SURFACE				*psSurface,
+							PVRSRV_CLIENT_MEM_INFO	*psMemInfo,
+							PVRSRV_CLIENT_SYNC_INFO	*psSyncInfo,
+							IMG_UINT32				ui32Offset,
+							PVRSRV_PIXEL_FORMAT		eFormat,
+							SGXTQ_MEMLAYOUT			eMemLayout,
+							IMG_UINT32				ui32Width,
+							IMG_UINT32				ui32Height,
+							IMG_INT32				i32Stride)
+{
+	psSurface->psMemInfo = psMemInfo;
+	psSurface->psSyncInfo = psSyncInfo;
+	psSurface->ui32Offset = ui32Offset;
+	psSurface->eFormat = eFormat;
+	psSurface->eMemLayout = eMemLayout;
+	psSurface->ui32Width = ui32Width;
+	psSurface->ui32Height = ui32Height;
+	psSurface->i32Stride = i32Stride;
+
+	BLSurfaceInit(&psSurface->sBL, BLLayout(eMemLayout), eFormat, i32Stride, ui32Width, ui32Height, IMG_NULL);
+}
+
+/*****************************************************************************
+ * Function Name		:	SurfaceCreate
+ * Inputs				:	eFormat, eMemLayout, ui32Width, ui32Height
+ *							bNegativeStride - address the rows bottom up
+ *							ui32Extra - bytes to allocate after the surface
+ * Outputs				:	psSurface - filled with random data
+ ******************************************************************************/
+static IMG_VOID SurfaceCreate(TQV_SURFACE			*psSurface,
+							  PVRSRV_PIXEL_FORMAT	eFormat,
+							  SGXTQ_MEMLAYOUT		eMemLayout,
+							  IMG_UINT32			ui32Width,
+							  IMG_UINT32			ui32Height,
+							  IMG_BOOL				bNegativeStride,
+							  IMG_UINT32			ui32Extra)
+{
+	IMG_UINT32				ui32Bpp = gas_BLExternalPixelTable[eFormat].ui32BytesPerPixel;
+	IMG_UINT32				ui32Stride;
+	IMG_UINT32				ui32Size;
+	PVRSRV_CLIENT_MEM_INFO	*psMemInfo;
+	IMG_BYTE				*pbyData;
+	IMG_UINT32				i;
+
+	if (BLLayout(eMemLayout) == BL_MEMLAYOUT_LINEAR)
+	{
+		ui32Stride = ((ui32Width + TQMOCK_STRIDE_GRAN - 1) & ~(TQMOCK_STRIDE_GRAN - 1)) * ui32Bpp;
+		ui32Size = ui32Stride * ui32Height;
+	}
+	else
+	{
+		ui32Stride = ui32Width * ui32Bpp;
+		ui32Size = Pow2(ui32Width) * Pow2(ui32Height) * ui32Bpp;
+	}
+
+	psMemInfo = TQMockAllocDeviceMem(ui32Size + ui32Extra, TQV_SURFACE_ALIGN);
+
+	pbyData = psMemInfo->pvLinAddr;
+	for (i = 0; i < ui32Size + ui32Extra; i++)
+	{
+		pbyData[i] = (IMG_BYTE)(Random32() >> 5);
+	}
+
+	SurfaceView(psSurface, psMemInfo, TQMockAllocSyncInfo(),
+				bNegativeStride ? ui32Stride * (ui32Height - 1) : 0,
+				eFormat, eMemLayout, ui32Width, ui32Height,
+				bNegativeStride ? -(IMG_INT32)ui32Stride : (IMG_INT32)ui32Stride);
+}
+
+static IMG_UINT32 SurfaceGetPixel(const TQV_SURFACE *psSurface, IMG_INT32 i32X, IMG_INT32 i32Y)
+{
+	IMG_BYTE	abyPixel[BL_MAX_RAW_PIXEL_BYTES];
+	BL_FPIXEL	sPixel;
+
+	BLSurfaceReadSpan(&psSurface->sBL, SurfaceBase(psSurface), i32X, i32Y, 1, abyPixel);
+	BLDecodeSpan(psSurface->eFormat, abyPixel, 1, &sPixel);
+
+	return BLFloatToARGB8888(&sPixel);
+}
+
+static IMG_VOID SurfacePutPixel(const TQV_SURFACE *psSurface, IMG_INT32 i32X, IMG_INT32 i32Y, IMG_UINT32 ui32ARGB)
+{
+	IMG_BYTE	abyPixel[BL_MAX_RAW_PIXEL_BYTES];
+	BL_FPIXEL	sPixel;
+
+	BLARGB8888ToFloat(ui32ARGB, &sPixel);
+	BLEncodeSpan(psSurface->eFormat, &sPixel, 1, abyPixel);
+	BLSurfaceWriteSpan(&psSurface->sBL, SurfaceBase(psSurface), i32X, i32Y, 1, abyPixel);
+}
+
+/* Paints the surface with a few colours so colour keys have something to match */
+static IMG_VOID SurfacePalette(const TQV_SURFACE *psSurface, const IMG_UINT32 *pui32Palette, IMG_UINT32 ui32Colours)
+{
+	IMG_UINT32 x, y;
+
+	for (y = 0; y < psSurface->ui32Height; y++)
+	{
+		for (x = 0; x < psSurface->ui32Width; x++)
+		{
+			SurfacePutPixel(psSurface, (IMG_INT32)x, (IMG_INT32)y, pui32Palette[Random32() % ui32Colours]);
+		}
+	}
+}
+
+static IMG_VOID ImageCapture(const TQV_SURFACE *psSurface, TQV_IMAGE *psImage)
+{
+	IMG_UINT32 x, y;
+
+	psImage->ui32Width = psSurface->ui32Width;
+	psImage->ui32Height = psSurface->ui32Height;
+	psImage->pui32Pixels = malloc(psImage->ui32Width * psImage->ui32Height * sizeof(IMG_UINT32));
+	if (psImage->pui32Pixels == IMG_NULL)
+	{
+		fprintf(stderr, "tqvalidate: out of host memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	for (y = 0; y < psImage->ui32Height; y++)
+	{
+		for (x = 0; x < psImage->ui32Width; x++)
+		{
+			psImage->pui32Pixels[y * psImage->ui32Width + x] = SurfaceGetPixel(psSurface, (IMG_INT32)x, (IMG_INT32)y);
+		}
+	}
+}
+
+static IMG_VOID ImageFree(TQV_IMAGE *psImage)
+{
+	free(psImage->pui32Pixels);
+	psImage->pui32Pixels = IMG_NULL;
+}
+
+/* Number of pixels differing by more than ui32Tolerance in any channel; the first is described */
+static IMG_UINT32 ImageCompare(const TQV_IMAGE *psGot, const TQV_IMAGE *psExpected, IMG_UINT32 ui32Tolerance,
+							   IMG_CHAR *pszFirst, IMG_UINT32 ui32FirstSize)
+{
+	IMG_UINT32 ui32Mismatches = 0;
+	IMG_UINT32 i, c;
+
+	for (i = 0; i < psGot->ui32Width * psGot->ui32Height; i++)
+	{
+		IMG_UINT32 ui32Got = psGot->pui32Pixels[i];
+		IMG_UINT32 ui32Expected = psExpected->pui32Pixels[i];
+
+		for (c = 0; c < 32; c += 8)
+		{
+			IMG_INT32 i32Diff = (IMG_INT32)((ui32Got >> c) & 0xFF) - (IMG_INT32)((ui32Expected >> c) & 0xFF);
+
+			if ((IMG_UINT32)abs(i32Diff) > ui32Tolerance)
+			{
+				if (ui32Mismatches == 0)
+				{
+					snprintf(pszFirst, ui32FirstSize, "(%u,%u) got %08x expected %08x",
+							 i % psGot->ui32Width, i / psGot->ui32Width, ui32Got, ui32Expected);
+				}
+				ui32Mismatches++;
+				break;
+			}
+		}
+	}
+	return ui32Mismatches;
+}
+
+static IMG_VOID SetupSurface(SGXTQ_SURFACE *psTQSurface, const TQV_SURFACE *psSurface, IMG_INT32 x0, IMG_INT32 y0, IMG_INT32 x1, IMG_INT32 y1)
+{
+	memset(psTQSurface, 0, sizeof(*psTQSurface));
+
+	SGX_TQSURFACE_SET_ADDR(*psTQSurface, psSurface->psMemInfo, psSurface->ui32Offset);
+	psTQSurface->ui32Width = psSurface->ui32Width;
+	psTQSurface->ui32Height = psSurface->ui32Height;
+	psTQSurface->i32StrideInBytes = psSurface->i32Stride;
+	psTQSurface->eFormat = psSurface->eFormat;
+	psTQSurface->eMemLayout = psSurface->eMemLayout;
+	psTQSurface->psSyncInfo = psSurface->psSyncInfo;
+	psTQSurface->sRect.x0 = x0;
+	psTQSurface->sRect.y0 = y0;
+	psTQSurface->sRect.x1 = x1;
+	psTQSurface->sRect.y1 = y1;
+}
+
+static IMG_VOID CheckSyncIdle(const TQV_CASE *psCase, const TQV_SURFACE *psSurface)
+{
+	const PVRSRV_SYNC_DATA *psSyncData;
+
+	if (psSurface == IMG_NULL)
+	{
+		return;
+	}
+	psSyncData = psSurface->psSyncInfo->psSyncData;
+
+	Check(psSyncData->ui32ReadOpsPending == psSyncData->ui32ReadOpsComplete &&
+		  psSyncData->ui32WriteOpsPending == psSyncData->ui32WriteOpsComplete,
+		  psCase->pszName, "sync operations left outstanding");
+}
+
+/*****************************************************************************
+ * Function Name		:	Queue
+ * Inputs				:	psCase, ui32DispatchFlags - the paths to disable
+ * Returns				:	SGXQueueTransfer's result
+ ******************************************************************************/
+static PVRSRV_ERROR Queue(TQV_CASE *psCase, IMG_UINT32 ui32DispatchFlags)
+{
+	SGX_QUEUETRANSFER	sQueueTransfer = psCase->sQueueTransfer;
+	PVRSRV_ERROR		eError;
+
+	sQueueTransfer.ui32Flags |= ui32DispatchFlags;
+	eError = SGXQueueTransfer(psCase->hTransferContext, &sQueueTransfer);
+
+	CheckSyncIdle(psCase, psCase->psSrc);
+	CheckSyncIdle(psCase, psCase->apsChecks[0]);
+
+	return eError;
+}
+
+/*****************************************************************************
+ * Function Name		:	RunCase
+ * Inputs				:	psCase
+ * Description			:	Queues the case down the 3D path and compares
+ *							every destination view with the blitlib path's
+ *							or the reference's. The destination allocation
+ *							is put back as it was afterwards.
+ ******************************************************************************/
+static IMG_VOID RunCase(TQV_CASE *psCase)
+{
+	PVRSRV_CLIENT_MEM_INFO	*psDstMemInfo = psCase->apsChecks[0]->psMemInfo;
+	IMG_UINT32				ui32DstSize = (IMG_UINT32)psDstMemInfo->uAllocSize;
+	IMG_BYTE				*pbySaved;
+	TQV_IMAGE				sSrc;
+	TQV_IMAGE				asGot[TQV_MAX_CHECKS];
+	TQV_IMAGE				asExpected[TQV_MAX_CHECKS];
+	TQMOCK_STATS			sStats;
+	PVRSRV_ERROR			eError;
+	IMG_UINT32				ui32Mismatches = 0;
+	IMG_CHAR				szFirst[96] = "";
+	IMG_UINT32				i;
+
+	pbySaved = malloc(ui32DstSize);
+	if (pbySaved == IMG_NULL)
+	{
+		fprintf(stderr, "tqvalidate: out of host memory\n");
+		exit(EXIT_FAILURE);
+	}
+	memcpy(pbySaved, psDstMemInfo->pvLinAddr, ui32DstSize);
+
+	if (psCase->psSrc != IMG_NULL)
+	{
+		ImageCapture(psCase->psSrc, &sSrc);
+	}
+	else
+	{
+		memset(&sSrc, 0, sizeof(sSrc));
+	}
+
+	if (TQMockVerbose())
+	{
+		printf("%s\n", psCase->pszName);
+	}
+
+	/* 3D path, every pass run by the interpreter */
+	TQMockResetStats();
+	eError = Queue(psCase, SGX_TRANSFER_DISPATCH_DISABLE_PTLA | SGX_TRANSFER_DISPATCH_DISABLE_SW);
+	TQMockGetStats(&sStats);
+
+	Check(eError == PVRSRV_OK, psCase->pszName, "3D path rejected the transfer");
+	Check(sStats.ui32Errors == 0, psCase->pszName, "interpreter could not run a transfer command");
+
+	for (i = 0; i < psCase->ui32NumChecks; i++)
+	{
+		ImageCapture(psCase->apsChecks[i], &asGot[i]);
+	}
+	memcpy(psDstMemInfo->pvLinAddr, pbySaved, ui32DstSize);
+
+	/* Expected images */
+	if (psCase->pfnReference != IMG_NULL)
+	{
+		ImageCapture(psCase->apsChecks[0], &asExpected[0]);
+		psCase->pfnReference(psCase, &sSrc, &asExpected[0]);
+	}
+	else
+	{
+		eError = Queue(psCase, SGX_TRANSFER_DISPATCH_DISABLE_PTLA | SGX_TRANSFER_DISPATCH_DISABLE_3D);
+		Check(eError == PVRSRV_OK, psCase->pszName, "blitlib path rejected the transfer");
+
+		for (i = 0; i < psCase->ui32NumChecks; i++)
+		{
+			ImageCapture(psCase->apsChecks[i], &asExpected[i]);
+		}
+		memcpy(psDstMemInfo->pvLinAddr, pbySaved, ui32DstSize);
+	}
+
+	for (i = 0; i < psCase->ui32NumChecks; i++)
+	{
+		ui32Mismatches += ImageCompare(&asGot[i], &asExpected[i], psCase->ui32Tolerance,
+									   szFirst + strlen(szFirst), sizeof(szFirst) - strlen(szFirst));
+		ImageFree(&asGot[i]);
+		ImageFree(&asExpected[i]);
+	}
+
+	printf("%-30s passes %2u (%u dummy)  pixels %6u  read %7u  written %7u  cb %6u  staging %6u  ",
+		   psCase->pszName, sStats.ui32Kicks, sStats.ui32DummyKicks, sStats.ui32PixelsWritten,
+		   sStats.ui32BytesRead, sStats.ui32BytesWritten, sStats.ui32ResourceBytes, sStats.ui32StagingBytes);
+
+	if (ui32Mismatches == 0)
+	{
+		printf(psCase->pszKnownIssue ? "ok (known issue no longer seen)\n" : "ok\n");
+	}
+	else if (psCase->pszKnownIssue != IMG_NULL)
+	{
+		printf("known issue: %s, %u pixels\n", psCase->pszKnownIssue, ui32Mismatches);
+	}
+	else
+	{
+		printf("%u pixels differ\n", ui32Mismatches);
+		fprintf(stderr, "FAIL %s: first difference %s\n", psCase->pszName, szFirst);
+		ui32Failures++;
+	}
+
+	ImageFree(&sSrc);
+	free(pbySaved);
+}
+
+/*****************************************************************************
+ References
+******************************************************************************/
+
+/* ROP3 on ARGB8888: bit (P << 2 | S << 1 | D) of the code gives each result bit */
+static IMG_UINT32 Rop3(IMG_BYTE byRop, IMG_UINT32 ui32P, IMG_UINT32 ui32S, IMG_UINT32 ui32D)
+{
+	IMG_UINT32 ui32Result = 0;
+	IMG_UINT32 i;
+
+	for (i = 0; i < 8; i++)
+	{
+		if (byRop & (1U << i))
+		{
+			ui32Result |= ((i & 4) ? ui32P : ~ui32P) &
+						  ((i & 2) ? ui32S : ~ui32S) &
+						  ((i & 1) ? ui32D : ~ui32D);
+		}
+	}
+	return ui32Result;
+}
+
+/* Unscaled blits with a rop; 0xCC gives a copy with memmove semantics */
+static IMG_VOID ReferenceRop(const TQV_CASE *psCase, const TQV_IMAGE *psSrc, TQV_IMAGE *psDst)
+{
+	const IMG_RECT	*psSrcRect = &psCase->sQueueTransfer.asSources[0].sRect;
+	const IMG_RECT	*psDstRect = &psCase->sQueueTransfer.asDests[0].sRect;
+	IMG_BYTE		byRop = psCase->sQueueTransfer.Details.sBlit.byCustomRop3;
+	IMG_INT32		x, y;
+
+	for (y = psDstRect->y0; y < psDstRect->y1; y++)
+	{
+		for (x = psDstRect->x0; x < psDstRect->x1; x++)
+		{
+			IMG_UINT32 ui32S = psSrc->pui32Pixels[(y - psDstRect->y0 + psSrcRect->y0) * psSrc->ui32Width +
+												  (x - psDstRect->x0 + psSrcRect->x0)];
+			IMG_UINT32 *pui32D = &psDst->pui32Pixels[y * psDst->ui32Width + x];
+
+			*pui32D = Rop3(byRop, 0, ui32S, *pui32D);
+		}
+	}
+}
+
+/* Unscaled blits blending by source alpha */
+static IMG_VOID ReferenceSourceAlpha(const TQV_CASE *psCase, const TQV_IMAGE *psSrc, TQV_IMAGE *psDst)
+{
+	const IMG_RECT	*psSrcRect = &psCase->sQueueTransfer.asSources[0].sRect;
+	const IMG_RECT	*psDstRect = &psCase->sQueueTransfer.asDests[0].sRect;
+	IMG_INT32		x, y;
+	IMG_UINT32		c;
+
+	for (y = psDstRect->y0; y < psDstRect->y1; y++)
+	{
+		for (x = psDstRect->x0; x < psDstRect->x1; x++)
+		{
+			IMG_UINT32 ui32S = psSrc->pui32Pixels[(y - psDstRect->y0 + psSrcRect->y0) * psSrc->ui32Width +
+												  (x - psDstRect->x0 + psSrcRect->x0)];
+			IMG_UINT32 *pui32D = &psDst->pui32Pixels[y * psDst->ui32Width + x];
+			IMG_DOUBLE dfAlpha = (IMG_DOUBLE)(ui32S >> 24) / 255.0;
+			IMG_UINT32 ui32Result = 0;
+
+			for (c = 0; c < 32; c += 8)
+			{
+				IMG_DOUBLE dfValue = (IMG_DOUBLE)((ui32S >> c) & 0xFF) * dfAlpha +
+									 (IMG_DOUBLE)((*pui32D >> c) & 0xFF) * (1.0 - dfAlpha);
+
+				ui32Result |= (IMG_UINT32)floor(dfValue + 0.5) << c;
+			}
+			*pui32D = ui32Result;
+		}
+	}
+}
+
+/* Fills with a rop against the destination */
+static IMG_VOID ReferenceFillRop(const TQV_CASE *psCase, const TQV_IMAGE *psSrc, TQV_IMAGE *psDst)
+{
+	const IMG_RECT	*psDstRect = &psCase->sQueueTransfer.asDests[0].sRect;
+	IMG_BYTE		byRop = psCase->sQueueTransfer.Details.sFill.byCustomRop3;
+	IMG_UINT32		ui32Colour = psCase->sQueueTransfer.Details.sFill.ui32Colour;
+	IMG_INT32		x, y;
+
+	PVR_UNREFERENCED_PARAMETER(psSrc);
+
+	for (y = psDstRect->y0; y < psDstRect->y1; y++)
+	{
+		for (x = psDstRect->x0; x < psDstRect->x1; x++)
+		{
+			IMG_UINT32 *pui32D = &psDst->pui32Pixels[y * psDst->ui32Width + x];
+
+			*pui32D = Rop3(byRop, ui32Colour, 0, *pui32D);
+		}
+	}
+}
+
+/*****************************************************************************
+ Cases
+******************************************************************************/
+
+static IMG_VOID BlitCase(TQV_CASE *psCase, const IMG_CHAR *pszName, IMG_HANDLE hTransferContext,
+						 TQV_SURFACE *psSrc, IMG_INT32 sx0, IMG_INT32 sy0, IMG_INT32 sx1, IMG_INT32 sy1,
+						 TQV_SURFACE *psDst, IMG_INT32 dx0, IMG_INT32 dy0, IMG_INT32 dx1, IMG_INT32 dy1)
+{
+	memset(psCase, 0, sizeof(*psCase));
+
+	psCase->pszName = pszName;
+	psCase->hTransferContext = hTransferContext;
+	psCase->psSrc = psSrc;
+	psCase->ui32NumChecks = 1;
+	psCase->apsChecks[0] = psDst;
+
+	psCase->sQueueTransfer.eType = SGXTQ_BLIT;
+	psCase->sQueueTransfer.Details.sBlit.eFilter = SGXTQ_FILTERTYPE_POINT;
+	psCase->sQueueTransfer.Details.sBlit.byCustomRop3 = 0xCC;
+	psCase->sQueueTransfer.ui32NumSources = 1;
+	SetupSurface(&psCase->sQueueTransfer.asSources[0], psSrc, sx0, sy0, sx1, sy1);
+	psCase->sQueueTransfer.ui32NumDest = 1;
+	SetupSurface(&psCase->sQueueTransfer.asDests[0], psDst, dx0, dy0, dx1, dy1);
+}
+
+static IMG_VOID FillCase(TQV_CASE *psCase, const IMG_CHAR *pszName, IMG_HANDLE hTransferContext,
+						 TQV_SURFACE *psDst, IMG_INT32 dx0, IMG_INT32 dy0, IMG_INT32 dx1, IMG_INT32 dy1,
+						 IMG_UINT32 ui32Colour, IMG_BYTE byRop)
+{
+	memset(psCase, 0, sizeof(*psCase));
+
+	psCase->pszName = pszName;
+	psCase->hTransferContext = hTransferContext;
+	psCase->ui32NumChecks = 1;
+	psCase->apsChecks[0] = psDst;
+
+	psCase->sQueueTransfer.eType = SGXTQ_FILL;
+	psCase->sQueueTransfer.Details.sFill.ui32Colour = ui32Colour;
+	psCase->sQueueTransfer.Details.sFill.byCustomRop3 = byRop;
+	psCase->sQueueTransfer.ui32NumDest = 1;
+	SetupSurface(&psCase->sQueueTransfer.asDests[0], psDst, dx0, dy0, dx1, dy1);
+}
+
+static IMG_VOID BlitCases(IMG_HANDLE hTransferContext)
+{
+	static const IMG_UINT32 aui32Palette[] = {0xFF000000U, 0xFF00FF00U, 0x80FF0000U, 0xFF0000FFU};
+	static const struct
+	{
+		const IMG_CHAR	*pszName;
+		IMG_BYTE		byRop;
+	} asRops[] =
+	{
+		{"rop 0x66 (S xor D)",	0x66},
+		{"rop 0x88 (S and D)",	0x88},
+		{"rop 0x33 (not S)",	0x33},
+		{"rop 0x55 (not D)",	0x55},
+		{"rop 0xEE (S or D)",	0xEE},
+	};
+	IMG_UINT32	ui32Mark = TQMockArenaMark();
+	TQV_SURFACE	sSrc, sSrc565, sSmall, sTwiddled, sNegative, sKeyed, sDst, sDst565;
+	TQV_CASE	sCase;
+	IMG_UINT32	i;
+
+	SurfaceCreate(&sSrc, PVRSRV_PIXEL_FORMAT_ARGB8888, SGXTQ_MEMLAYOUT_STRIDE, 64, 48, IMG_FALSE, 0);
+	SurfaceCreate(&sSrc565, PVRSRV_PIXEL_FORMAT_RGB565, SGXTQ_MEMLAYOUT_STRIDE, 64, 48, IMG_FALSE, 0);
+	SurfaceCreate(&sSmall, PVRSRV_PIXEL_FORMAT_ARGB8888, SGXTQ_MEMLAYOUT_STRIDE, 24, 16, IMG_FALSE, 0);
+	SurfaceCreate(&sTwiddled, PVRSRV_PIXEL_FORMAT_ARGB8888, SGXTQ_MEMLAYOUT_2D, 64, 64, IMG_FALSE, 0);
+	SurfaceCreate(&sNegative, PVRSRV_PIXEL_FORMAT_ARGB8888, SGXTQ_MEMLAYOUT_STRIDE, 64, 48, IMG_TRUE, 0);
+	SurfaceCreate(&sKeyed, PVRSRV_PIXEL_FORMAT_ARGB8888, SGXTQ_MEMLAYOUT_STRIDE, 64, 48, IMG_FALSE, 0);
+	SurfaceCreate(&sDst, PVRSRV_PIXEL_FORMAT_ARGB8888, SGXTQ_MEMLAYOUT_STRIDE, 72, 56, IMG_FALSE, 0);
+	SurfaceCreate(&sDst565, PVRSRV_PIXEL_FORMAT_RGB565, SGXTQ_MEMLAYOUT_STRIDE, 72, 56, IMG_FALSE, 0);
+	SurfacePalette(&sKeyed, aui32Palette, sizeof(aui32Palette) / sizeof(aui32Palette[0]));
+
+	BlitCase(&sCase, "copy 8888", hTransferContext, &sSrc, 5, 3, 45, 35, &sDst, 10, 7, 50, 39);
+	RunCase(&sCase);
+
+	BlitCase(&sCase, "copy 8888 to 565", hTransferContext, &sSrc, 5, 3, 45, 35, &sDst565, 10, 7, 50, 39);
+	RunCase(&sCase);
+
+	BlitCase(&sCase, "copy 565 to 8888", hTransferContext, &sSrc565, 0, 0, 64, 48, &sDst, 3, 2, 67, 50);
+	RunCase(&sCase);
+
+	BlitCase(&sCase, "copy twiddled to linear", hTransferContext, &sTwiddled, 8, 4, 56, 52, &sDst, 0, 0, 48, 48);
+	RunCase(&sCase);
+
+	BlitCase(&sCase, "copy negative source stride", hTransferContext, &sNegative, 2, 1, 62, 47, &sDst, 4, 4, 64, 50);
+	RunCase(&sCase);
+
+	BlitCase(&sCase, "stretch point", hTransferContext, &sSmall, 0, 0, 24, 16, &sDst, 0, 0, 57, 41);
+	RunCase(&sCase);
+
+	BlitCase(&sCase, "stretch bilinear", hTransferContext, &sSmall, 0, 0, 24, 16, &sDst, 0, 0, 57, 41);
+	sCase.sQueueTransfer.Details.sBlit.eFilter = SGXTQ_FILTERTYPE_LINEAR;
+	sCase.ui32Tolerance = 1;
+	RunCase(&sCase);
+
+	BlitCase(&sCase, "shrink bilinear", hTransferContext, &sSrc, 0, 0, 64, 48, &sDst, 6, 6, 26, 21);
+	sCase.sQueueTransfer.Details.sBlit.eFilter = SGXTQ_FILTERTYPE_LINEAR;
+	sCase.ui32Tolerance = 1;
+	RunCase(&sCase);
+
+	BlitCase(&sCase, "flip x", hTransferContext, &sSrc, 5, 3, 45, 35, &sDst, 10, 7, 50, 39);
+	sCase.sQueueTransfer.ui32Flags = SGX_TRANSFER_FLAGS_INVERTX;
+	RunCase(&sCase);
+
+	BlitCase(&sCase, "flip y", hTransferContext, &sSrc, 5, 3, 45, 35, &sDst, 10, 7, 50, 39);
+	sCase.sQueueTransfer.ui32Flags = SGX_TRANSFER_FLAGS_INVERTY;
+	RunCase(&sCase);
+
+	BlitCase(&sCase, "global alpha", hTransferContext, &sSrc, 5, 3, 45, 35, &sDst, 10, 7, 50, 39);
+	sCase.sQueueTransfer.Details.sBlit.eAlpha = SGXTQ_ALPHA_GLOBAL;
+	sCase.sQueueTransfer.Details.sBlit.byGlobalAlpha = 0x60;
+	sCase.ui32Tolerance = 1;
+	RunCase(&sCase);
+
+	BlitCase(&sCase, "source alpha", hTransferContext, &sSrc, 5, 3, 45, 35, &sDst, 10, 7, 50, 39);
+	sCase.sQueueTransfer.Details.sBlit.eAlpha = SGXTQ_ALPHA_SOURCE;
+	sCase.pfnReference = ReferenceSourceAlpha;
+	sCase.ui32Tolerance = 1;
+	RunCase(&sCase);
+
+	BlitCase(&sCase, "source colour key", hTransferContext, &sKeyed, 0, 0, 64, 48, &sDst, 4, 4, 68, 52);
+	sCase.sQueueTransfer.Details.sBlit.eColourKey = SGXTQ_COLOURKEY_SOURCE;
+	sCase.sQueueTransfer.Details.sBlit.ui32ColourKey = aui32Palette[1];
+	sCase.sQueueTransfer.Details.sBlit.ui32ColourKeyMask = 0x00FFFFFFU;
+	RunCase(&sCase);
+
+	BlitCase(&sCase, "destination colour key", hTransferContext, &sSrc, 0, 0, 64, 48, &sKeyed, 0, 0, 64, 48);
+	sCase.sQueueTransfer.Details.sBlit.eColourKey = SGXTQ_COLOURKEY_DEST;
+	sCase.sQueueTransfer.Details.sBlit.ui32ColourKey = aui32Palette[3];
+	sCase.sQueueTransfer.Details.sBlit.ui32ColourKeyMask = 0x00FFFFFFU;
+	RunCase(&sCase);
+
+	for (i = 0; i < sizeof(asRops) / sizeof(asRops[0]); i++)
+	{
+		BlitCase(&sCase, asRops[i].pszName, hTransferContext, &sSrc, 5, 3, 45, 35, &sDst, 10, 7, 50, 39);
+		sCase.sQueueTransfer.Details.sBlit.byCustomRop3 = asRops[i].byRop;
+		sCase.pfnReference = ReferenceRop;
+		RunCase(&sCase);
+	}
+
+	TQMockArenaRelease(ui32Mark);
+}
+
+/*
+	Copies within one surface where the destination overlaps the source
+	below it: the queue has to go through the staging buffer, in blocks the
+	buffer can hold.
+*/
+static IMG_VOID OverlapCases(IMG_HANDLE hTransferContext, IMG_HANDLE hSmallStagingContext)
+{
+	IMG_UINT32	ui32Mark = TQMockArenaMark();
+	TQV_SURFACE	sSurface;
+	TQV_CASE	sCase;
+
+	SurfaceCreate(&sSurface, PVRSRV_PIXEL_FORMAT_ARGB8888, SGXTQ_MEMLAYOUT_STRIDE, 64, 96, IMG_FALSE, 0);
+
+	BlitCase(&sCase, "overlap forward", hTransferContext, &sSurface, 8, 6, 56, 86, &sSurface, 0, 0, 48, 80);
+	sCase.pfnReference = ReferenceRop;
+	RunCase(&sCase);
+
+	BlitCase(&sCase, "overlap backward", hTransferContext, &sSurface, 0, 0, 48, 80, &sSurface, 8, 6, 56, 86);
+	sCase.pfnReference = ReferenceRop;
+	RunCase(&sCase);
+
+	BlitCase(&sCase, "overlap backward, small staging", hSmallStagingContext,
+			 &sSurface, 0, 0, 48, 80, &sSurface, 8, 6, 56, 86);
+	sCase.pfnReference = ReferenceRop;
+	RunCase(&sCase);
+
+	TQMockArenaRelease(ui32Mark);
+}
+
+static IMG_VOID FillCases(IMG_HANDLE hTransferContext)
+{
+	IMG_UINT32	ui32Mark = TQMockArenaMark();
+	TQV_SURFACE	sDst, sDst565, sNegative;
+	TQV_CASE	sCase;
+
+	SurfaceCreate(&sDst, PVRSRV_PIXEL_FORMAT_ARGB8888, SGXTQ_MEMLAYOUT_STRIDE, 72, 56, IMG_FALSE, 0);
+	SurfaceCreate(&sDst565, PVRSRV_PIXEL_FORMAT_RGB565, SGXTQ_MEMLAYOUT_STRIDE, 72, 56, IMG_FALSE, 0);
+	SurfaceCreate(&sNegative, PVRSRV_PIXEL_FORMAT_ARGB8888, SGXTQ_MEMLAYOUT_STRIDE, 72, 56, IMG_TRUE, 0);
+
+	FillCase(&sCase, "fill 8888", hTransferContext, &sDst, 3, 5, 61, 40, 0x80C04020U, 0);
+	RunCase(&sCase);
+
+	FillCase(&sCase, "fill 565", hTransferContext, &sDst565, 3, 5, 61, 40, 0xFF20C0E0U, 0);
+	RunCase(&sCase);
+
+	FillCase(&sCase, "fill rop 0x5A (P xor D)", hTransferContext, &sDst, 3, 5, 61, 40, 0x00FF00FFU, 0x5A);
+	sCase.pfnReference = ReferenceFillRop;
+	RunCase(&sCase);
+
+	FillCase(&sCase, "fill rop 0x55 (not D)", hTransferContext, &sDst, 3, 5, 61, 40, 0, 0x55);
+	sCase.pfnReference = ReferenceFillRop;
+	RunCase(&sCase);
+
+	FillCase(&sCase, "fill rop 0xA0 (P and D)", hTransferContext, &sDst, 3, 5, 61, 40, 0xF0F00F0FU, 0xA0);
+	sCase.pfnReference = ReferenceFillRop;
+	RunCase(&sCase);
+
+	FillCase(&sCase, "fill negative stride", hTransferContext, &sNegative, 3, 5, 61, 40, 0x80C04020U, 0);
+	RunCase(&sCase);
+
+	TQMockArenaRelease(ui32Mark);
+}
+
+/* Mipmap chains: each level follows the one above it, as blitlib lays them out */
+static IMG_VOID MipGenCase(IMG_HANDLE hTransferContext, const IMG_CHAR *pszName,
+						   SGXTQ_MEMLAYOUT eMemLayout, SGXTQ_FILTERTYPE eFilter)
+{
+	IMG_UINT32	ui32Mark = TQMockArenaMark();
+	IMG_UINT32	ui32Size = 32;
+	IMG_UINT32	ui32Levels = 5;
+	TQV_SURFACE	asLevels[TQV_MAX_CHECKS + 1];
+	TQV_CASE	sCase;
+	IMG_UINT32	ui32Offset;
+	IMG_UINT32	i;
+
+	SurfaceCreate(&asLevels[0], PVRSRV_PIXEL_FORMAT_ARGB8888, eMemLayout, ui32Size, ui32Size, IMG_FALSE,
+				  ui32Size * ui32Size * 4);
+
+	ui32Offset = ui32Size * ui32Size * 4;
+	for (i = 1; i <= ui32Levels; i++)
+	{
+		IMG_UINT32 ui32LevelSize = ui32Size >> i;
+
+		SurfaceView(&asLevels[i], asLevels[0].psMemInfo, asLevels[0].psSyncInfo, ui32Offset,
+					PVRSRV_PIXEL_FORMAT_ARGB8888, eMemLayout, ui32LevelSize, ui32LevelSize,
+					(IMG_INT32)(ui32LevelSize * 4));
+		ui32Offset += ui32LevelSize * ui32LevelSize * 4;
+	}
+
+	memset(&sCase, 0, sizeof(sCase));
+	sCase.pszName = pszName;
+	sCase.hTransferContext = hTransferContext;
+	sCase.psSrc = &asLevels[0];
+	sCase.ui32NumChecks = ui32Levels;
+	for (i = 0; i < ui32Levels; i++)
+	{
+		sCase.apsChecks[i] = &asLevels[i + 1];
+	}
+	sCase.ui32Tolerance = (eFilter == SGXTQ_FILTERTYPE_LINEAR) ? 1 : 0;
+
+	sCase.sQueueTransfer.eType = SGXTQ_MIPGEN;
+	sCase.sQueueTransfer.Details.sMipGen.eFilter = eFilter;
+	sCase.sQueueTransfer.Details.sMipGen.ui32Levels = ui32Levels;
+	sCase.sQueueTransfer.ui32NumSources = 1;
+	SetupSurface(&sCase.sQueueTransfer.asSources[0], &asLevels[0], 0, 0, (IMG_INT32)ui32Size, (IMG_INT32)ui32Size);
+	sCase.sQueueTransfer.ui32NumDest = 1;
+	SetupSurface(&sCase.sQueueTransfer.asDests[0], &asLevels[0], 0, 0, (IMG_INT32)ui32Size, (IMG_INT32)ui32Size);
+
+	RunCase(&sCase);
+
+	TQMockArenaRelease(ui32Mark);
+}
+
+/*****************************************************************************
+ * Function Name		:	ErrorCases
+ * Description			:	Transfers the queue must turn down. Nothing may be
+ *							kicked and no sync operation left outstanding.
+ ******************************************************************************/
+static IMG_VOID ErrorCases(IMG_HANDLE hTransferContext)
+{
+	IMG_UINT32		ui32Mark = TQMockArenaMark();
+	TQV_SURFACE		sSrc, sDst;
+	TQV_CASE		sCase;
+	TQMOCK_STATS	sStats;
+	PVRSRV_ERROR	eError;
+
+	SurfaceCreate(&sSrc, PVRSRV_PIXEL_FORMAT_ARGB8888, SGXTQ_MEMLAYOUT_STRIDE, 64, 48, IMG_FALSE, 64);
+	SurfaceCreate(&sDst, PVRSRV_PIXEL_FORMAT_ARGB8888, SGXTQ_MEMLAYOUT_STRIDE, 64, 48, IMG_FALSE, 64);
+
+	TQMockResetStats();
+
+	BlitCase(&sCase, "every path disabled", hTransferContext, &sSrc, 0, 0, 32, 32, &sDst, 0, 0, 32, 32);
+	eError = Queue(&sCase, SGX_TRANSFER_DISPATCH_MASK);
+	Check(eError == PVRSRV_ERROR_INVALID_FLAGS, sCase.pszName, "not rejected as PVRSRV_ERROR_INVALID_FLAGS");
+
+	BlitCase(&sCase, "misaligned destination", hTransferContext, &sSrc, 0, 0, 32, 32, &sDst, 0, 0, 32, 32);
+	SGX_TQSURFACE_SET_ADDR(sCase.sQueueTransfer.asDests[0], sDst.psMemInfo, 2);
+	eError = Queue(&sCase, SGX_TRANSFER_DISPATCH_DISABLE_PTLA | SGX_TRANSFER_DISPATCH_DISABLE_SW);
+	Check(eError != PVRSRV_OK, sCase.pszName, "accepted by the 3D path");
+
+	BlitCase(&sCase, "custom without a shader", hTransferContext, &sSrc, 0, 0, 32, 32, &sDst, 0, 0, 32, 32);
+	sCase.sQueueTransfer.eType = SGXTQ_CUSTOM;
+	eError = Queue(&sCase, SGX_TRANSFER_DISPATCH_DISABLE_PTLA | SGX_TRANSFER_DISPATCH_DISABLE_3D);
+	Check(eError != PVRSRV_OK, sCase.pszName, "accepted by the blitlib path");
+
+	TQMockGetStats(&sStats);
+	Check(sStats.ui32Kicks == 0, "error cases", "a rejected transfer was kicked");
+
+	printf("%-30s %s\n", "error paths", (sStats.ui32Kicks == 0) ? "ok" : "kicked");
+
+	TQMockArenaRelease(ui32Mark);
+}
+
+static IMG_VOID Usage(const IMG_CHAR *pszProgram)
+{
+	fprintf(stderr, "usage: %s [-v]\n", pszProgram);
+	exit(EXIT_FAILURE);
+}
+
+int main(int argc, char **argv)
+{
+	SGXTQ_CLIENT_TRANSFER_CONTEXT	*psTQContext;
+	SGXTQ_CLIENT_TRANSFER_CONTEXT	*psSmallStagingContext;
+	int								i;
+
+	for (i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-v") == 0)
+		{
+			TQMockSetVerbose(IMG_TRUE);
+		}
+		else
+		{
+			Usage(argv[0]);
+		}
+	}
+
+	TQMockInit(TQV_ARENA_SIZE);
+	psTQContext = TQMockCreateContext(TQV_STAGING_SIZE);
+	psSmallStagingContext = TQMockCreateContext(TQV_SMALL_STAGING_SIZE);
+
+	BlitCases(psTQContext);
+	OverlapCases(psTQContext, psSmallStagingContext);
+	FillCases(psTQContext);
+	MipGenCase(psTQContext, "mipgen twiddled point", SGXTQ_MEMLAYOUT_2D, SGXTQ_FILTERTYPE_POINT);
+	MipGenCase(psTQContext, "mipgen twiddled bilinear", SGXTQ_MEMLAYOUT_2D, SGXTQ_FILTERTYPE_LINEAR);
+	ErrorCases(psTQContext);
+
+	TQMockDestroyContext(psSmallStagingContext);
+	TQMockDestroyContext(psTQContext);
+	TQMockDeinit();
+
+	if (ui32Failures)
+	{
+		fprintf(stderr, "%u check(s) failed\n", ui32Failures);
+		return EXIT_FAILURE;
+	}
+	printf("all checks passed\n");
+	return EXIT_SUCCESS;
+}
+
+/******************************************************************************
+ End of file (main.c)
+******************************************************************************/
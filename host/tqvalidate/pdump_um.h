@@ -0,0 +1,25 @@
+/******************************************************************************
+ * Name         : pdump_um.h
+ * Title        : Transfer queue validator stand-in
+ *
+ * Copyright    : 2010 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means,electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Description  : User mode pdump interface. The validator builds without
+ *                PDUMP, so the queue needs none of its declarations.
+ *
+ * Modifications:-
+ * $Log: pdump_um.h $
+ *****************************************************************************/
+
+/******************************************************************************
+ End of file (pdump_um.h)
+******************************************************************************/
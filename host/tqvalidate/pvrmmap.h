@@ -0,0 +1,25 @@
+/******************************************************************************
+ * Name         : pvrmmap.h
+ * Title        : Transfer queue validator stand-in
+ *
+ * Copyright    : 2010 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means,electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Description  : Services mmap interface. Nothing in the transfer queue
+ *                uses it on the host.
+ *
+ * Modifications:-
+ * $Log: pvrmmap.h $
+ *****************************************************************************/
+
+/******************************************************************************
+ End of file (pvrmmap.h)
+******************************************************************************/
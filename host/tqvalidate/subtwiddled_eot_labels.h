@@ -0,0 +1,26 @@
+/******************************************************************************
+ * Name         : subtwiddled_eot_labels.h
+ * Title        : Transfer queue validator stand-in
+ *
+ * Copyright    : 2010 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means,electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Description  : Generated by the USE assembler in a device build. The validator never
+ *                assembles USE code, so sgxtransfer_queue.c needs none of
+ *                its labels.
+ *
+ * Modifications:-
+ * $Log: subtwiddled_eot_labels.h $
+ *****************************************************************************/
+
+/******************************************************************************
+ End of file (subtwiddled_eot_labels.h)
+******************************************************************************/
@@ -0,0 +1,833 @@
+/******************************************************************************
+ * Name         : tqinterp.c
+ * Title        : Transfer command interpreter for the transfer queue validator
+ *
+ * Copyright    : 2010 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means,electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Description  : Runs a submitted transfer command in software. The command
+ *                is followed the way the hardware would follow it: the
+ *                background object register leads to the ISP record (the
+ *                rectangle and texture coordinates) and through it to the
+ *                primary and secondary PDS records (TAG state, USE program,
+ *                attributes); the pixel event register leads to the EOT
+ *                handler and its PBE state. Each covered pixel then samples
+ *                its layers, runs the program and is packed to the
+ *                destination. Sampling and format conversion go through
+ *                blitlib so the results can be compared with the blitlib
+ *                fallback.
+ *
+ * Modifications:-
+ * $Log: tqinterp.c $
+ *****************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "tqmock.h"
+#include "servicesint.h"
+#include "blitlib.h"
+
+#if defined(SGX_FEATURE_HYBRID_TWIDDLING)
+#define TQINTERP_TWIDDLED	BL_MEMLAYOUT_HYBRID_TWIDDLED
+#else
+#define TQINTERP_TWIDDLED	BL_MEMLAYOUT_TWIDDLED
+#endif
+
+#define TQINTERP_MAX_LAYERS	(SGXTQ_NUM_HWBGOBJS - 1)
+
+typedef struct _TQINTERP_LAYER_
+{
+	BL_SURFACE			sSurface;
+	const IMG_BYTE		*pbyBase;
+	IMG_BOOL			bLinear;
+
+	/* texel coordinates of the rectangle's edges, swapped when flipped */
+	IMG_INT32			i32U0;
+	IMG_INT32			i32U1;
+	IMG_INT32			i32V0;
+	IMG_INT32			i32V1;
+} TQINTERP_LAYER;
+
+typedef struct _TQINTERP_DRAW_
+{
+	/* destination */
+	BL_SURFACE			sDst;
+	IMG_BYTE			*pbyDst;
+	IMG_RECT			sClip;
+
+	/* the rectangle the coordinates are given for */
+	IMG_RECT			sRect;
+
+	IMG_UINT32			ui32NumLayers;
+	TQINTERP_LAYER		asLayers[TQINTERP_MAX_LAYERS];
+
+	SGXTQ_USEFRAGS		eProgram;
+	IMG_UINT32			ui32NumLimms;
+	IMG_UINT32			aui32Limms[6];
+	IMG_UINT32			aui32A[SGXTQ_MAX_DIRECT_ATTRIBUTES];
+} TQINTERP_DRAW;
+
+
+/*****************************************************************************
+ * Function Name		:	TQInterpError
+ * Description			:	Counts a command the interpreter could not run.
+ ******************************************************************************/
+static IMG_VOID TQInterpError(const IMG_CHAR *pszWhat, IMG_UINT32 ui32Value)
+{
+	TQMockStats()->ui32Errors++;
+	if (TQMockVerbose())
+	{
+		printf("    interp: %s (0x%08x)\n", pszWhat, ui32Value);
+	}
+}
+
+/* Follows a device address to a record that starts with ui32Magic */
+static const IMG_UINT32 *TQInterpRecord(IMG_UINT32 ui32DevVAddr, IMG_UINT32 ui32Words, IMG_UINT32 ui32Magic)
+{
+	const IMG_UINT32 *pui32Record = TQMockDevVAddrToLin(ui32DevVAddr, ui32Words * sizeof(IMG_UINT32));
+
+	if (pui32Record == IMG_NULL || pui32Record[0] != ui32Magic)
+	{
+		TQInterpError("bad record", ui32DevVAddr);
+		return IMG_NULL;
+	}
+	return pui32Record;
+}
+
+static IMG_BOOL TQInterpLayout(SGXTQ_MEMLAYOUT eMemLayout, BL_MEMLAYOUT *peBLLayout)
+{
+	switch (eMemLayout)
+	{
+		case SGXTQ_MEMLAYOUT_STRIDE:
+		case SGXTQ_MEMLAYOUT_OUT_LINEAR:
+		{
+			*peBLLayout = BL_MEMLAYOUT_LINEAR;
+			return IMG_TRUE;
+		}
+		case SGXTQ_MEMLAYOUT_2D:
+		case SGXTQ_MEMLAYOUT_OUT_TWIDDLED:
+		{
+			*peBLLayout = TQINTERP_TWIDDLED;
+			return IMG_TRUE;
+		}
+		case SGXTQ_MEMLAYOUT_TILED:
+		case SGXTQ_MEMLAYOUT_OUT_TILED:
+		{
+			*peBLLayout = BL_MEMLAYOUT_TILED;
+			return IMG_TRUE;
+		}
+		default:
+		{
+			return IMG_FALSE;
+		}
+	}
+}
+
+static IMG_UINT32 TQInterpPow2(IMG_UINT32 ui32Value)
+{
+	IMG_UINT32 ui32Pow2 = 1;
+
+	while (ui32Pow2 < ui32Value)
+	{
+		ui32Pow2 <<= 1;
+	}
+	return ui32Pow2;
+}
+
+/*****************************************************************************
+ * Function Name		:	TQInterpSurface
+ * Inputs				:	eFormat, eMemLayout, ui32DevVAddr, ui32Stride
+ *							(pixels), ui32Width, ui32Height
+ * Outputs				:	psSurface, ppbyBase
+ * Returns				:	IMG_FALSE if the surface can't be described or
+ *							does not lie inside device memory.
+ ******************************************************************************/
+static IMG_BOOL TQInterpSurface(PVRSRV_PIXEL_FORMAT	eFormat,
+								SGXTQ_MEMLAYOUT		eMemLayout,
+								IMG_UINT32			ui32DevVAddr,
+								IMG_UINT32			ui32Stride,
+								IMG_UINT32			ui32Width,
+								IMG_UINT32			ui32Height,
+								BL_SURFACE			*psSurface,
+								IMG_BYTE			**ppbyBase)
+{
+	BL_MEMLAYOUT	eBLLayout;
+	IMG_UINT32		ui32Bpp;
+	IMG_UINT32		ui32Size;
+
+	if ((IMG_UINT32)eFormat > PVRSRV_PIXEL_FORMAT_RAW1024 ||
+		(ui32Bpp = gas_BLExternalPixelTable[eFormat].ui32BytesPerPixel) == 0)
+	{
+		TQInterpError("unsupported format", eFormat);
+		return IMG_FALSE;
+	}
+	if (!TQInterpLayout(eMemLayout, &eBLLayout))
+	{
+		TQInterpError("unsupported memory layout", eMemLayout);
+		return IMG_FALSE;
+	}
+	if (ui32Width == 0 || ui32Height == 0)
+	{
+		TQInterpError("empty surface", ui32DevVAddr);
+		return IMG_FALSE;
+	}
+
+	if (eBLLayout == BL_MEMLAYOUT_LINEAR || eBLLayout == BL_MEMLAYOUT_TILED)
+	{
+		ui32Size = ui32Stride * ui32Bpp * ui32Height;
+	}
+	else
+	{
+		ui32Size = TQInterpPow2(ui32Width) * TQInterpPow2(ui32Height) * ui32Bpp;
+	}
+
+	*ppbyBase = TQMockDevVAddrToLin(ui32DevVAddr, ui32Size);
+	if (*ppbyBase == IMG_NULL)
+	{
+		TQInterpError("surface outside device memory", ui32DevVAddr);
+		return IMG_FALSE;
+	}
+
+	BLSurfaceInit(psSurface, eBLLayout, eFormat, (IMG_INT32)(ui32Stride * ui32Bpp),
+				  ui32Width, ui32Height, IMG_NULL);
+	return IMG_TRUE;
+}
+
+static IMG_FLOAT TQInterpFloat(IMG_UINT32 ui32Bits)
+{
+	union
+	{
+		IMG_FLOAT	f;
+		IMG_UINT32	ui32;
+	} uValue;
+
+	uValue.ui32 = ui32Bits;
+	return uValue.f;
+}
+
+/* Texel edge a normalised coordinate stands for */
+static IMG_INT32 TQInterpTexelEdge(IMG_UINT32 ui32Coord, IMG_UINT32 ui32Size)
+{
+	return (IMG_INT32)floor((IMG_DOUBLE)TQInterpFloat(ui32Coord) * (IMG_DOUBLE)ui32Size + 0.5);
+}
+
+/*****************************************************************************
+ * Function Name		:	TQInterpLayer
+ * Inputs				:	pui32TAGState - the layer's TAG state
+ *							pui32TSP - its U0, U1, V0, V1
+ * Outputs				:	psLayer
+ * Description			:	Sets up a layer for sampling.
+ ******************************************************************************/
+static IMG_BOOL TQInterpLayer(const IMG_UINT32 *pui32TAGState, const IMG_UINT32 *pui32TSP, TQINTERP_LAYER *psLayer)
+{
+	IMG_UINT32	ui32Width = pui32TAGState[1] & 0xFFFFU;
+	IMG_UINT32	ui32Height = pui32TAGState[1] >> 16;
+	IMG_BYTE	*pbyBase;
+
+	if (pui32TAGState[0] & TQMOCK_TAG_RAW)
+	{
+		TQInterpError("raw texture state", pui32TAGState[0]);
+		return IMG_FALSE;
+	}
+
+	if (!TQInterpSurface((PVRSRV_PIXEL_FORMAT)(pui32TAGState[0] & TQMOCK_TAG_FORMAT_MASK),
+						 (SGXTQ_MEMLAYOUT)((pui32TAGState[0] & TQMOCK_TAG_LAYOUT_MASK) >> TQMOCK_TAG_LAYOUT_SHIFT),
+						 pui32TAGState[3], pui32TAGState[2], ui32Width, ui32Height,
+						 &psLayer->sSurface, &pbyBase))
+	{
+		return IMG_FALSE;
+	}
+	psLayer->pbyBase = pbyBase;
+
+	switch ((pui32TAGState[0] & TQMOCK_TAG_FILTER_MASK) >> TQMOCK_TAG_FILTER_SHIFT)
+	{
+		case SGXTQ_FILTERTYPE_POINT:
+		{
+			psLayer->bLinear = IMG_FALSE;
+			break;
+		}
+		case SGXTQ_FILTERTYPE_LINEAR:
+		{
+			psLayer->bLinear = IMG_TRUE;
+			break;
+		}
+		default:
+		{
+			TQInterpError("unsupported filter", pui32TAGState[0]);
+			return IMG_FALSE;
+		}
+	}
+
+	psLayer->i32U0 = TQInterpTexelEdge(pui32TSP[0], ui32Width);
+	psLayer->i32U1 = TQInterpTexelEdge(pui32TSP[1], ui32Width);
+	psLayer->i32V0 = TQInterpTexelEdge(pui32TSP[2], ui32Height);
+	psLayer->i32V1 = TQInterpTexelEdge(pui32TSP[3], ui32Height);
+
+	return IMG_TRUE;
+}
+
+/*
+	Nearest texel to the centre of pixel k of n across a span of texels from
+	i32T0 to i32T1 (either way round): floor(T0 + (k + 1/2) * (T1 - T0) / n),
+	kept in integers so that it matches blitlib's nearest scaler exactly.
+*/
+static IMG_INT32 TQInterpNearest(IMG_INT32 k, IMG_INT32 n, IMG_INT32 i32T0, IMG_INT32 i32T1)
+{
+	IMG_INT32 i32Num = i32T0 * 2 * n + (2 * k + 1) * (i32T1 - i32T0);
+	IMG_INT32 i32Den = 2 * n;
+
+	return (i32Num >= 0) ? i32Num / i32Den : -((-i32Num + i32Den - 1) / i32Den);
+}
+
+/* As blitlib's bilinear scaler: the two texels around the centre and the weight of the second */
+static IMG_VOID TQInterpBilinear(IMG_INT32 k, IMG_INT32 n, IMG_INT32 i32T0, IMG_INT32 i32T1, IMG_INT32 i32Size,
+								 IMG_INT32 *pi32First, IMG_INT32 *pi32Second, IMG_FLOAT *pfWeight)
+{
+	IMG_DOUBLE dfU = (IMG_DOUBLE)i32T0 + ((IMG_DOUBLE)k + 0.5) * (IMG_DOUBLE)(i32T1 - i32T0) / (IMG_DOUBLE)n - 0.5;
+	IMG_DOUBLE dfFloor = floor(dfU);
+	IMG_INT32 i32First = (IMG_INT32)dfFloor;
+	IMG_INT32 i32Second = i32First + 1;
+
+	*pfWeight = (IMG_FLOAT)(dfU - dfFloor);
+
+	*pi32First = (i32First < 0) ? 0 : ((i32First >= i32Size) ? i32Size - 1 : i32First);
+	*pi32Second = (i32Second < 0) ? 0 : ((i32Second >= i32Size) ? i32Size - 1 : i32Second);
+}
+
+static IMG_VOID TQInterpFetch(const TQINTERP_LAYER *psLayer, IMG_INT32 i32X, IMG_INT32 i32Y, BL_FPIXEL *psOut)
+{
+	IMG_BYTE abyTexel[BL_MAX_RAW_PIXEL_BYTES];
+
+	BLSurfaceReadSpan(&psLayer->sSurface, psLayer->pbyBase, i32X, i32Y, 1, abyTexel);
+	BLDecodeSpan(psLayer->sSurface.ePixelFormat, abyTexel, 1, psOut);
+	TQMockStats()->ui32BytesRead += psLayer->sSurface.ui32BytesPerPixel;
+}
+
+static IMG_VOID TQInterpLerp(const BL_FPIXEL *psA, const BL_FPIXEL *psB, IMG_FLOAT fWeight, BL_FPIXEL *psOut)
+{
+	psOut->fR = psA->fR + (psB->fR - psA->fR) * fWeight;
+	psOut->fG = psA->fG + (psB->fG - psA->fG) * fWeight;
+	psOut->fB = psA->fB + (psB->fB - psA->fB) * fWeight;
+	psOut->fA = psA->fA + (psB->fA - psA->fA) * fWeight;
+}
+
+/*****************************************************************************
+ * Function Name		:	TQInterpSample
+ * Inputs				:	psDraw, psLayer, i32X, i32Y - destination pixel
+ * Outputs				:	psOut - the filtered texel
+ ******************************************************************************/
+static IMG_VOID TQInterpSample(const TQINTERP_DRAW *psDraw, const TQINTERP_LAYER *psLayer,
+							   IMG_INT32 i32X, IMG_INT32 i32Y, BL_FPIXEL *psOut)
+{
+	IMG_INT32 i32W = psDraw->sRect.x1 - psDraw->sRect.x0;
+	IMG_INT32 i32H = psDraw->sRect.y1 - psDraw->sRect.y0;
+	IMG_INT32 kx = i32X - psDraw->sRect.x0;
+	IMG_INT32 ky = i32Y - psDraw->sRect.y0;
+
+	if (!psLayer->bLinear)
+	{
+		TQInterpFetch(psLayer,
+					  TQInterpNearest(kx, i32W, psLayer->i32U0, psLayer->i32U1),
+					  TQInterpNearest(ky, i32H, psLayer->i32V0, psLayer->i32V1),
+					  psOut);
+	}
+	else
+	{
+		IMG_INT32 i32Left, i32Right, i32Top, i32Bottom;
+		IMG_FLOAT fWX, fWY;
+		BL_FPIXEL sTL, sTR, sBL, sBR, sTop, sBottom;
+
+		TQInterpBilinear(kx, i32W, psLayer->i32U0, psLayer->i32U1, (IMG_INT32)psLayer->sSurface.ui32Width,
+						 &i32Left, &i32Right, &fWX);
+		TQInterpBilinear(ky, i32H, psLayer->i32V0, psLayer->i32V1, (IMG_INT32)psLayer->sSurface.ui32Height,
+						 &i32Top, &i32Bottom, &fWY);
+
+		TQInterpFetch(psLayer, i32Left, i32Top, &sTL);
+		TQInterpFetch(psLayer, i32Right, i32Top, &sTR);
+		TQInterpFetch(psLayer, i32Left, i32Bottom, &sBL);
+		TQInterpFetch(psLayer, i32Right, i32Bottom, &sBR);
+
+		TQInterpLerp(&sTL, &sTR, fWX, &sTop);
+		TQInterpLerp(&sBL, &sBR, fWX, &sBottom);
+		TQInterpLerp(&sTop, &sBottom, fWY, psOut);
+	}
+}
+
+/* ROP3 on ARGB8888, for the 4 bit function of (S, D) the ROP programs are numbered by */
+static IMG_UINT32 TQInterpRop(IMG_UINT32 ui32Function, IMG_UINT32 ui32S, IMG_UINT32 ui32D)
+{
+	IMG_UINT32 ui32Result = 0;
+
+	if (ui32Function & 1)
+	{
+		ui32Result |= ~ui32S & ~ui32D;
+	}
+	if (ui32Function & 2)
+	{
+		ui32Result |= ~ui32S & ui32D;
+	}
+	if (ui32Function & 4)
+	{
+		ui32Result |= ui32S & ~ui32D;
+	}
+	if (ui32Function & 8)
+	{
+		ui32Result |= ui32S & ui32D;
+	}
+	return ui32Result;
+}
+
+/* The fill rops, pattern P against destination D */
+static IMG_BOOL TQInterpRopFill(SGXTQ_USEFRAGS eProgram, IMG_UINT32 P, IMG_UINT32 D, IMG_UINT32 *pui32Result)
+{
+	switch (eProgram)
+	{
+		case SGXTQ_USEBLIT_ROPFILL_AND:			*pui32Result = P & D;		break;
+		case SGXTQ_USEBLIT_ROPFILL_ANDNOT:		*pui32Result = P & ~D;		break;
+		case SGXTQ_USEBLIT_ROPFILL_NOTAND:		*pui32Result = ~P & D;		break;
+		case SGXTQ_USEBLIT_ROPFILL_XOR:			*pui32Result = P ^ D;		break;
+		case SGXTQ_USEBLIT_ROPFILL_OR:			*pui32Result = P | D;		break;
+		case SGXTQ_USEBLIT_ROPFILL_NOTANDNOT:	*pui32Result = ~P & ~D;		break;
+		case SGXTQ_USEBLIT_ROPFILL_NOTXOR:		*pui32Result = ~(P ^ D);	break;
+		case SGXTQ_USEBLIT_ROPFILL_ORNOT:		*pui32Result = P | ~D;		break;
+		case SGXTQ_USEBLIT_ROPFILL_NOT:			*pui32Result = ~P;			break;
+		case SGXTQ_USEBLIT_ROPFILL_NOTOR:		*pui32Result = ~P | D;		break;
+		case SGXTQ_USEBLIT_ROPFILL_NOTORNOT:	*pui32Result = ~P | ~D;		break;
+		case SGXTQ_USEBLIT_ROPFILL_NOTD:		*pui32Result = ~D;			break;
+		default:
+		{
+			return IMG_FALSE;
+		}
+	}
+	return IMG_TRUE;
+}
+
+static IMG_VOID TQInterpBlend(const BL_FPIXEL *psS, IMG_FLOAT fS, const BL_FPIXEL *psD, IMG_FLOAT fD, BL_FPIXEL *psOut)
+{
+	psOut->fR = psS->fR * fS + psD->fR * fD;
+	psOut->fG = psS->fG * fS + psD->fG * fD;
+	psOut->fB = psS->fB * fS + psD->fB * fD;
+	psOut->fA = psS->fA * fS + psD->fA * fD;
+}
+
+/*****************************************************************************
+ * Function Name		:	TQInterpShade
+ * Inputs				:	psDraw, psLayers - the sampled layers (0 is the
+ *							source, 1 the destination where there is one)
+ * Outputs				:	psOut
+ * Returns				:	IMG_FALSE for programs the interpreter does not
+ *							know.
+ * Description			:	What each USE program computes, in the terms of
+ *							the SGXTQ_ALPHA, rop and colour key definitions.
+ ******************************************************************************/
+static IMG_BOOL TQInterpShade(const TQINTERP_DRAW *psDraw, const BL_FPIXEL *psLayers, BL_FPIXEL *psOut)
+{
+	const BL_FPIXEL	*psS = &psLayers[0];
+	const BL_FPIXEL	*psD = &psLayers[1];
+	SGXTQ_USEFRAGS	eProgram = psDraw->eProgram;
+	IMG_UINT32		ui32Result;
+
+	switch (eProgram)
+	{
+		case SGXTQ_USEBLIT_NORMAL:
+		case SGXTQ_USEBLIT_A2R10G10B10:
+		case SGXTQ_USEBLIT_A2B10G10R10:
+		{
+			if (psDraw->ui32NumLayers < 1)
+			{
+				return IMG_FALSE;
+			}
+			*psOut = *psS;
+			return IMG_TRUE;
+		}
+		case SGXTQ_USEBLIT_FILL:
+		{
+			if (psDraw->ui32NumLimms < 1)
+			{
+				return IMG_FALSE;
+			}
+			BLARGB8888ToFloat(psDraw->aui32Limms[0], psOut);
+			return IMG_TRUE;
+		}
+		case SGXTQ_USEBLIT_SRC_BLEND:
+		case SGXTQ_USEBLIT_PREMULSRC_BLEND:
+		case SGXTQ_USEBLIT_GLOBAL_BLEND:
+		case SGXTQ_USEBLIT_PREMULSRCWITHGLOBAL_BLEND:
+		case SGXTQ_USEBLIT_SOURCE_COLOUR_KEY:
+		case SGXTQ_USEBLIT_DEST_COLOUR_KEY:
+		{
+			if (psDraw->ui32NumLayers < 2)
+			{
+				return IMG_FALSE;
+			}
+			break;
+		}
+		default:
+		{
+			if (eProgram >= SGXTQ_USEBLIT_ROP_NOTSANDNOTD && eProgram <= SGXTQ_USEBLIT_ROP_SORD)
+			{
+				IMG_UINT32 ui32S = BLFloatToARGB8888(psS);
+				IMG_UINT32 ui32D = (psDraw->ui32NumLayers > 1) ? BLFloatToARGB8888(psD) : 0;
+
+				ui32Result = TQInterpRop(eProgram - SGXTQ_USEBLIT_ROP_NOTSANDNOTD + 1, ui32S, ui32D);
+				BLARGB8888ToFloat(ui32Result, psOut);
+				return IMG_TRUE;
+			}
+			if (psDraw->ui32NumLayers >= 1 &&
+				TQInterpRopFill(eProgram, psDraw->aui32A[0], BLFloatToARGB8888(psS), &ui32Result))
+			{
+				BLARGB8888ToFloat(ui32Result, psOut);
+				return IMG_TRUE;
+			}
+			return IMG_FALSE;
+		}
+	}
+
+	switch (eProgram)
+	{
+		case SGXTQ_USEBLIT_SRC_BLEND:
+		{
+			TQInterpBlend(psS, psS->fA, psD, 1.0f - psS->fA, psOut);
+			break;
+		}
+		case SGXTQ_USEBLIT_PREMULSRC_BLEND:
+		{
+			TQInterpBlend(psS, 1.0f, psD, 1.0f - psS->fA, psOut);
+			break;
+		}
+		case SGXTQ_USEBLIT_GLOBAL_BLEND:
+		{
+			IMG_FLOAT fGlobal = (IMG_FLOAT)(psDraw->aui32A[0] & 0xFFU) / 255.0f;
+
+			TQInterpBlend(psS, fGlobal, psD, 1.0f - fGlobal, psOut);
+			break;
+		}
+		case SGXTQ_USEBLIT_PREMULSRCWITHGLOBAL_BLEND:
+		{
+			IMG_FLOAT fGlobal = (IMG_FLOAT)(psDraw->aui32A[0] & 0xFFU) / 255.0f;
+
+			TQInterpBlend(psS, fGlobal, psD, (1.0f - psS->fA) * (1.0f - fGlobal), psOut);
+			break;
+		}
+		case SGXTQ_USEBLIT_SOURCE_COLOUR_KEY:
+		{
+			/* source pixels matching the key let the destination through */
+			*psOut = (((BLFloatToARGB8888(psS) ^ psDraw->aui32A[0]) & psDraw->aui32A[1]) == 0) ? *psD : *psS;
+			break;
+		}
+		default:
+		{
+			/* destination pixels matching the key take the source */
+			*psOut = (((BLFloatToARGB8888(psD) ^ psDraw->aui32A[0]) & psDraw->aui32A[1]) == 0) ? *psS : *psD;
+			break;
+		}
+	}
+	return IMG_TRUE;
+}
+
+/*****************************************************************************
+ * Function Name		:	TQInterpDraw
+ * Inputs				:	psDraw - a rectangle set up for drawing
+ * Description			:	Shades every pixel of the rectangle inside the
+ *							clip. A plain copy between identical formats
+ *							with point sampling moves the texel bytes as they
+ *							are, as the hardware would.
+ ******************************************************************************/
+static IMG_VOID TQInterpDraw(const TQINTERP_DRAW *psDraw)
+{
+	IMG_RECT	sArea;
+	IMG_BOOL	bRaw;
+	IMG_UINT32	ui32DstBpp = psDraw->sDst.ui32BytesPerPixel;
+	IMG_INT32	x, y;
+	IMG_UINT32	i;
+
+	sArea.x0 = MAX(psDraw->sRect.x0, psDraw->sClip.x0);
+	sArea.y0 = MAX(psDraw->sRect.y0, psDraw->sClip.y0);
+	sArea.x1 = MIN(psDraw->sRect.x1, psDraw->sClip.x1);
+	sArea.y1 = MIN(psDraw->sRect.y1, psDraw->sClip.y1);
+
+	bRaw = (psDraw->eProgram == SGXTQ_USEBLIT_NORMAL &&
+			psDraw->ui32NumLayers == 1 &&
+			!psDraw->asLayers[0].bLinear &&
+			psDraw->asLayers[0].sSurface.ePixelFormat == psDraw->sDst.ePixelFormat) ? IMG_TRUE : IMG_FALSE;
+
+	for (y = sArea.y0; y < sArea.y1; y++)
+	{
+		for (x = sArea.x0; x < sArea.x1; x++)
+		{
+			IMG_BYTE abyPixel[BL_MAX_RAW_PIXEL_BYTES];
+
+			if (bRaw)
+			{
+				const TQINTERP_LAYER *psLayer = &psDraw->asLayers[0];
+
+				BLSurfaceReadSpan(&psLayer->sSurface, psLayer->pbyBase,
+								  TQInterpNearest(x - psDraw->sRect.x0, psDraw->sRect.x1 - psDraw->sRect.x0,
+												  psLayer->i32U0, psLayer->i32U1),
+								  TQInterpNearest(y - psDraw->sRect.y0, psDraw->sRect.y1 - psDraw->sRect.y0,
+												  psLayer->i32V0, psLayer->i32V1),
+								  1, abyPixel);
+				TQMockStats()->ui32BytesRead += ui32DstBpp;
+			}
+			else
+			{
+				BL_FPIXEL asLayers[TQINTERP_MAX_LAYERS];
+				BL_FPIXEL sOut;
+
+				memset(asLayers, 0, sizeof(asLayers));
+				for (i = 0; i < psDraw->ui32NumLayers; i++)
+				{
+					TQInterpSample(psDraw, &psDraw->asLayers[i], x, y, &asLayers[i]);
+				}
+
+				if (!TQInterpShade(psDraw, asLayers, &sOut))
+				{
+					TQInterpError("unsupported USE program", psDraw->eProgram);
+					return;
+				}
+				BLEncodeSpan(psDraw->sDst.ePixelFormat, &sOut, 1, abyPixel);
+			}
+
+			BLSurfaceWriteSpan(&psDraw->sDst, psDraw->pbyDst, x, y, 1, abyPixel);
+			TQMockStats()->ui32PixelsWritten++;
+			TQMockStats()->ui32BytesWritten += ui32DstBpp;
+		}
+	}
+}
+
+/*****************************************************************************
+ * Function Name		:	TQInterpPrograms
+ * Inputs				:	ui32Primary, ui32Secondary - PDS record addresses
+ *							ui32NumLayers
+ *							pui32TSP - U0, U1, V0, V1 for each layer
+ * Outputs				:	psDraw - layers, program and attributes
+ ******************************************************************************/
+static IMG_BOOL TQInterpPrograms(IMG_UINT32		ui32Primary,
+								 IMG_UINT32		ui32Secondary,
+								 IMG_UINT32		ui32NumLayers,
+								 const IMG_UINT32 *pui32TSP,
+								 TQINTERP_DRAW	*psDraw)
+{
+	const IMG_UINT32		*pui32Prim;
+	const IMG_UINT32		*pui32Sec;
+	const IMG_UINT32		*pui32USE;
+	SGXTQ_PDS_UPDATE		sPrim;
+	SGXTQ_PDS_UPDATE		sSec;
+	IMG_UINT32				i;
+
+	pui32Prim = TQInterpRecord(ui32Primary, 2 + sizeof(sPrim) / sizeof(IMG_UINT32), TQMOCK_RECORD_PDSPRIM);
+	pui32Sec = TQInterpRecord(ui32Secondary, 2 + sizeof(sSec) / sizeof(IMG_UINT32), TQMOCK_RECORD_PDSSEC);
+	if (pui32Prim == IMG_NULL || pui32Sec == IMG_NULL)
+	{
+		return IMG_FALSE;
+	}
+	memcpy(&sPrim, &pui32Prim[2], sizeof(sPrim));
+	memcpy(&sSec, &pui32Sec[2], sizeof(sSec));
+
+	pui32USE = TQInterpRecord(sPrim.ui32U2, 3, TQMOCK_RECORD_USE);
+	if (pui32USE == IMG_NULL)
+	{
+		return IMG_FALSE;
+	}
+	psDraw->eProgram = (SGXTQ_USEFRAGS)pui32USE[1];
+	psDraw->ui32NumLimms = pui32USE[2];
+	if (psDraw->ui32NumLimms > 6 ||
+		(pui32USE = TQInterpRecord(sPrim.ui32U2, 3 + psDraw->ui32NumLimms, TQMOCK_RECORD_USE)) == IMG_NULL)
+	{
+		TQInterpError("bad USE record", sPrim.ui32U2);
+		return IMG_FALSE;
+	}
+	memcpy(psDraw->aui32Limms, &pui32USE[3], psDraw->ui32NumLimms * sizeof(IMG_UINT32));
+	memcpy(psDraw->aui32A, sSec.aui32A, sizeof(psDraw->aui32A));
+
+	if (ui32NumLayers > TQINTERP_MAX_LAYERS)
+	{
+		TQInterpError("too many layers", ui32NumLayers);
+		return IMG_FALSE;
+	}
+	psDraw->ui32NumLayers = ui32NumLayers;
+	for (i = 0; i < ui32NumLayers; i++)
+	{
+		if (!TQInterpLayer(sPrim.asLayers[i].aui32TAGState, &pui32TSP[i * 4], &psDraw->asLayers[i]))
+		{
+			return IMG_FALSE;
+		}
+	}
+
+	return IMG_TRUE;
+}
+
+/*****************************************************************************
+ * Function Name		:	TQInterpDestination
+ * Inputs				:	psCmd
+ * Outputs				:	psDraw - destination surface and clip
+ * Description			:	Follows the pixel event handler to the EOT
+ *							handler's PBE state and clips the render box to
+ *							the surface it describes.
+ ******************************************************************************/
+static IMG_BOOL TQInterpDestination(const SGXMKIF_TRANSFERCMD *psCmd, TQINTERP_DRAW *psDraw)
+{
+	const IMG_UINT32	*pui32Pixevent;
+	const IMG_UINT32	*pui32EOT;
+	const IMG_UINT32	*pui32PBE;
+	IMG_UINT32			ui32Width;
+	IMG_UINT32			ui32Height;
+
+	pui32Pixevent = TQInterpRecord(psCmd->sHWRegs.ui32EDMPixelPDSExec, 4, TQMOCK_RECORD_PIXEVENT);
+	if (pui32Pixevent == IMG_NULL)
+	{
+		return IMG_FALSE;
+	}
+	pui32EOT = TQInterpRecord(pui32Pixevent[3], 11, TQMOCK_RECORD_EOT);
+	if (pui32EOT == IMG_NULL)
+	{
+		return IMG_FALSE;
+	}
+	pui32PBE = &pui32EOT[4];
+
+	if (pui32PBE[0] & TQMOCK_PBE_ROTATION_MASK)
+	{
+		TQInterpError("rotated destination", pui32PBE[0]);
+		return IMG_FALSE;
+	}
+
+	ui32Width = pui32PBE[3] & 0xFFFFU;
+	ui32Height = pui32PBE[3] >> 16;
+
+	if (!TQInterpSurface((PVRSRV_PIXEL_FORMAT)(pui32PBE[0] & TQMOCK_PBE_FORMAT_MASK),
+						 (SGXTQ_MEMLAYOUT)((pui32PBE[0] & TQMOCK_PBE_LAYOUT_MASK) >> TQMOCK_PBE_LAYOUT_SHIFT),
+						 pui32PBE[1], pui32PBE[2], ui32Width, ui32Height,
+						 &psDraw->sDst, &psDraw->pbyDst))
+	{
+		return IMG_FALSE;
+	}
+
+	psDraw->sClip.x0 = (IMG_INT32)(psCmd->sHWRegs.ui32ISPRenderBox1 & 0xFFFFU);
+	psDraw->sClip.y0 = (IMG_INT32)(psCmd->sHWRegs.ui32ISPRenderBox1 >> 16);
+	psDraw->sClip.x1 = MIN((IMG_INT32)(psCmd->sHWRegs.ui32ISPRenderBox2 & 0xFFFFU), (IMG_INT32)ui32Width);
+	psDraw->sClip.y1 = MIN((IMG_INT32)(psCmd->sHWRegs.ui32ISPRenderBox2 >> 16), (IMG_INT32)ui32Height);
+
+	return IMG_TRUE;
+}
+
+/* Layers a primary fetches, for the fast 2D stream which doesn't say */
+static IMG_UINT32 TQInterpPrimaryLayers(IMG_UINT32 ui32Primary)
+{
+	const IMG_UINT32 *pui32Prim = TQInterpRecord(ui32Primary, 2, TQMOCK_RECORD_PDSPRIM);
+
+	if (pui32Prim == IMG_NULL)
+	{
+		return 0;
+	}
+	switch (pui32Prim[1])
+	{
+		case SGXTQ_PDSPRIMFRAG_SINGLESOURCE:	return 1;
+		case SGXTQ_PDSPRIMFRAG_TWOSOURCE:		return 2;
+		case SGXTQ_PDSPRIMFRAG_THREESOURCE:		return 3;
+		default:								return 0;
+	}
+}
+
+/*****************************************************************************
+ * Function Name		:	TQInterpTransferCmd
+ * Inputs				:	psCmd - a transfer command as it sits in the CCB
+ * Outputs				:	-
+ * Description			:	Runs the command. Anything the interpreter can't
+ *							follow is counted in TQMOCK_STATS.ui32Errors and
+ *							the command is abandoned.
+ ******************************************************************************/
+IMG_VOID TQInterpTransferCmd(const SGXMKIF_TRANSFERCMD *psCmd)
+{
+	TQINTERP_DRAW		sDraw;
+	const IMG_UINT32	*pui32ISP;
+	IMG_UINT32			ui32Magic;
+
+	memset(&sDraw, 0, sizeof(sDraw));
+
+	pui32ISP = TQMockDevVAddrToLin(psCmd->sHWRegs.ui32ISPBgObj, sizeof(IMG_UINT32));
+	if (pui32ISP == IMG_NULL)
+	{
+		TQInterpError("no background object", psCmd->sHWRegs.ui32ISPBgObj);
+		return;
+	}
+	ui32Magic = pui32ISP[0];
+
+	if (!TQInterpDestination(psCmd, &sDraw))
+	{
+		return;
+	}
+
+	if (ui32Magic == TQMOCK_RECORD_ISP)
+	{
+		pui32ISP = TQInterpRecord(psCmd->sHWRegs.ui32ISPBgObj, 22, TQMOCK_RECORD_ISP);
+		if (pui32ISP == IMG_NULL ||
+			!TQInterpPrograms(pui32ISP[1], pui32ISP[2], pui32ISP[7], &pui32ISP[10], &sDraw))
+		{
+			return;
+		}
+
+		sDraw.sRect.x0 = (IMG_INT32)pui32ISP[3];
+		sDraw.sRect.y0 = (IMG_INT32)pui32ISP[4];
+		sDraw.sRect.x1 = (IMG_INT32)pui32ISP[5];
+		sDraw.sRect.y1 = (IMG_INT32)pui32ISP[6];
+
+		if (TQMockVerbose())
+		{
+			printf("    interp: (%d,%d)-(%d,%d) program %u, %u layer(s)\n",
+				   sDraw.sRect.x0, sDraw.sRect.y0, sDraw.sRect.x1, sDraw.sRect.y1,
+				   sDraw.eProgram, sDraw.ui32NumLayers);
+		}
+		TQInterpDraw(&sDraw);
+	}
+	else if (ui32Magic == TQMOCK_RECORD_ISPF2D)
+	{
+		IMG_UINT32 ui32NumRects;
+		IMG_UINT32 i;
+
+		pui32ISP = TQInterpRecord(psCmd->sHWRegs.ui32ISPBgObj, 5, TQMOCK_RECORD_ISPF2D);
+		if (pui32ISP == IMG_NULL)
+		{
+			return;
+		}
+		ui32NumRects = pui32ISP[3];
+		pui32ISP = TQInterpRecord(psCmd->sHWRegs.ui32ISPBgObj, 5 + ui32NumRects * 8, TQMOCK_RECORD_ISPF2D);
+		if (pui32ISP == IMG_NULL)
+		{
+			return;
+		}
+
+		for (i = 0; i < ui32NumRects; i++)
+		{
+			const IMG_UINT32 *pui32Rect = &pui32ISP[5 + i * 8];
+
+			if (!TQInterpPrograms(pui32ISP[1], pui32ISP[2], TQInterpPrimaryLayers(pui32ISP[1]),
+								  &pui32Rect[4], &sDraw))
+			{
+				return;
+			}
+			sDraw.sRect.x0 = (IMG_INT32)pui32Rect[0];
+			sDraw.sRect.y0 = (IMG_INT32)pui32Rect[1];
+			sDraw.sRect.x1 = (IMG_INT32)pui32Rect[2];
+			sDraw.sRect.y1 = (IMG_INT32)pui32Rect[3];
+			TQInterpDraw(&sDraw);
+		}
+	}
+	else
+	{
+		TQInterpError("unknown background object", ui32Magic);
+	}
+}
+
+/******************************************************************************
+ End of file (tqinterp.c)
+******************************************************************************/
@@ -0,0 +1,1847 @@
+/******************************************************************************
+ * Name         : tqmock.c
+ * Title        : Mock services layer for the transfer queue validator
+ *
+ * Copyright    : 2010 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means,electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Description  : Services, SGX bridge, resource circular buffer and SGXTQ_
+ *                utility entry points for sgxtransfer_queue.c on the host.
+ *                Submission is synchronous: the bridge runs the command
+ *                through the interpreter, writes the status values and
+ *                retires the command before returning, so every circular
+ *                buffer fence has passed by the time the next blit is
+ *                prepared.
+ *
+ * Modifications:-
+ * $Log: tqmock.c $
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tqmock.h"
+#include "servicesint.h"
+#include "sgxutils_client.h"
+#include "sgx_bridge_um.h"
+#include "blitlib.h"
+
+/* Command CCB size; SGXAcquireCCB relies on it being a power of two */
+#define TQMOCK_CCB_SIZE				(16 * 1024)
+
+#define TQMOCK_ALIGN(V, A)			(((V) + (A) - 1) & ~((A) - 1))
+
+#define TQMOCK_PDS_RECORD_WORDS		(2 + sizeof(SGXTQ_PDS_UPDATE) / sizeof(IMG_UINT32))
+#define TQMOCK_EOT_RECORD_WORDS		(4 + TQMOCK_PBE_STATE_WORDS)
+#define TQMOCK_PBE_STATE_WORDS		7
+#define TQMOCK_ISP_RECORD_WORDS		22
+#define TQMOCK_F2D_RECT_WORDS		8
+
+typedef struct _TQMOCK_MODOBJ_
+{
+	PVRSRV_CLIENT_SYNC_INFO	*psSyncInfo;
+	IMG_BOOL				bInUse;
+	IMG_UINT32				ui32ModifyFlags;
+	IMG_UINT32				ui32ReadOpsPending;
+	IMG_UINT32				ui32WriteOpsPending;
+} TQMOCK_MODOBJ;
+
+typedef struct _TQMOCK_CONTEXT_
+{
+	/* Must stay first: the queue only ever sees this member */
+	SGXTQ_CLIENT_TRANSFER_CONTEXT	sTQContext;
+
+	PVRSRV_CONNECTION				sConnection;
+	PVRSRV_DEV_DATA					sDevData;
+	SGX_CLIENT_CCB					sTransferCCB;
+	IMG_UINT32						ui32CCBWriteOffset;
+	volatile IMG_UINT32				ui32CCBReadOffset;
+
+	SGXTQ_CB						asCB[6];
+
+	SGXTQ_RESOURCE					asResources[SGXTQ_NUM_PDSPRIMFRAGS +
+												SGXTQ_NUM_PDSSECFRAGS +
+												SGXTQ_NUM_PDSPIXEVENTHANDLERS +
+												SGXTQ_NUM_USEFRAGS +
+												SGXTQ_NUM_USEEOTHANDLERS +
+												SGXTQ_NUM_HWBGOBJS + 2];
+	SGXTQ_RESOURCE					sUSESecondary;
+	TQMOCK_MODOBJ					asModObj[SGXTQ_MAX_SURFACES + 1];
+} TQMOCK_CONTEXT;
+
+typedef struct _TQMOCK_SYNC_
+{
+	PVRSRV_CLIENT_SYNC_INFO	sSyncInfo;
+	PVRSRV_SYNC_DATA		sSyncData;
+	struct _TQMOCK_SYNC_	*psNext;
+} TQMOCK_SYNC;
+
+typedef struct _TQMOCK_MEMINFO_
+{
+	/* Must stay first: meminfos handed out are cast back to this */
+	PVRSRV_CLIENT_MEM_INFO	sMemInfo;
+	/* The CCB a command buffer allocation belongs to */
+	SGX_CLIENT_CCB			*psOwnerCCB;
+	struct _TQMOCK_MEMINFO_	*psNext;
+} TQMOCK_MEMINFO;
+
+static IMG_BYTE			*gpbyArena;
+static IMG_UINT32		gui32ArenaSize;
+static IMG_UINT32		gui32ArenaTop;
+static TQMOCK_MEMINFO	*gpsMemInfos;
+static TQMOCK_SYNC		*gpsSyncs;
+static TQMOCK_STATS		gsStats;
+static IMG_BOOL			gbVerbose;
+
+static IMG_CHAR			gszStagingLabel[] = "staging";
+
+
+/*****************************************************************************
+ * Function Name		:	TQMockInit
+ * Inputs				:	ui32ArenaSize - bytes of device memory to back
+ * Outputs				:	-
+ * Description			:	Creates the device memory arena. Everything the
+ *							validator allocates, surfaces included, comes
+ *							from it so that device virtual addresses in
+ *							transfer commands can be followed.
+ ******************************************************************************/
+IMG_VOID TQMockInit(IMG_UINT32 ui32ArenaSize)
+{
+	gpbyArena = calloc(1, ui32ArenaSize);
+	if (gpbyArena == IMG_NULL)
+	{
+		fprintf(stderr, "tqvalidate: cannot allocate a %u byte arena\n", ui32ArenaSize);
+		exit(EXIT_FAILURE);
+	}
+	gui32ArenaSize = ui32ArenaSize;
+	gui32ArenaTop = 0;
+	TQMockResetStats();
+}
+
+IMG_VOID TQMockDeinit(IMG_VOID)
+{
+	while (gpsMemInfos != IMG_NULL)
+	{
+		TQMOCK_MEMINFO *psNext = gpsMemInfos->psNext;
+		free(gpsMemInfos);
+		gpsMemInfos = psNext;
+	}
+	while (gpsSyncs != IMG_NULL)
+	{
+		TQMOCK_SYNC *psNext = gpsSyncs->psNext;
+		free(gpsSyncs);
+		gpsSyncs = psNext;
+	}
+	free(gpbyArena);
+	gpbyArena = IMG_NULL;
+	gui32ArenaSize = 0;
+	gui32ArenaTop = 0;
+}
+
+/*****************************************************************************
+ * Function Name		:	TQMockAllocDeviceMem
+ * Inputs				:	ui32Size, ui32Alignment (power of two)
+ * Outputs				:	-
+ * Returns				:	A meminfo for the allocation; exits when the
+ *							arena is exhausted.
+ * Description			:	Bump allocates from the arena. The meminfo is
+ *							its own kernel handle.
+ ******************************************************************************/
+PVRSRV_CLIENT_MEM_INFO *TQMockAllocDeviceMem(IMG_UINT32 ui32Size, IMG_UINT32 ui32Alignment)
+{
+	TQMOCK_MEMINFO	*psMock;
+	IMG_UINT32		ui32Offset;
+
+	if (ui32Alignment == 0)
+	{
+		ui32Alignment = 1;
+	}
+	ui32Offset = TQMOCK_ALIGN(gui32ArenaTop, ui32Alignment);
+
+	if (ui32Offset + ui32Size > gui32ArenaSize || ui32Offset + ui32Size < ui32Offset)
+	{
+		fprintf(stderr, "tqvalidate: arena exhausted allocating %u bytes\n", ui32Size);
+		exit(EXIT_FAILURE);
+	}
+
+	psMock = calloc(1, sizeof(*psMock));
+	if (psMock == IMG_NULL)
+	{
+		fprintf(stderr, "tqvalidate: out of host memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	memset(gpbyArena + ui32Offset, 0, ui32Size);
+	gui32ArenaTop = ui32Offset + ui32Size;
+
+	psMock->sMemInfo.pvLinAddr = gpbyArena + ui32Offset;
+	psMock->sMemInfo.pvLinAddrKM = psMock->sMemInfo.pvLinAddr;
+	psMock->sMemInfo.sDevVAddr.uiAddr = TQMOCK_DEVMEM_BASE + ui32Offset;
+	psMock->sMemInfo.uAllocSize = ui32Size;
+	psMock->sMemInfo.hKernelMemInfo = (IMG_HANDLE)&psMock->sMemInfo;
+
+	psMock->psNext = gpsMemInfos;
+	gpsMemInfos = psMock;
+
+	return &psMock->sMemInfo;
+}
+
+/*****************************************************************************
+ * Function Name		:	TQMockArenaMark / TQMockArenaRelease
+ * Description			:	Lets a test case give back everything it
+ *							allocated. The meminfos stay valid host memory
+ *							until TQMockDeinit but must not be used again.
+ ******************************************************************************/
+IMG_UINT32 TQMockArenaMark(IMG_VOID)
+{
+	return gui32ArenaTop;
+}
+
+IMG_VOID TQMockArenaRelease(IMG_UINT32 ui32Mark)
+{
+	if (ui32Mark <= gui32ArenaTop)
+	{
+		gui32ArenaTop = ui32Mark;
+	}
+}
+
+/*****************************************************************************
+ * Function Name		:	TQMockDevVAddrToLin
+ * Inputs				:	ui32DevVAddr, ui32Size - range to access
+ * Returns				:	The host address of the range, or IMG_NULL if
+ *							any of it lies outside the allocated arena.
+ ******************************************************************************/
+IMG_VOID *TQMockDevVAddrToLin(IMG_UINT32 ui32DevVAddr, IMG_UINT32 ui32Size)
+{
+	IMG_UINT32 ui32Offset;
+
+	if (ui32DevVAddr < TQMOCK_DEVMEM_BASE)
+	{
+		return IMG_NULL;
+	}
+	ui32Offset = ui32DevVAddr - TQMOCK_DEVMEM_BASE;
+	if (ui32Offset > gui32ArenaTop || ui32Size > gui32ArenaTop - ui32Offset)
+	{
+		return IMG_NULL;
+	}
+	return gpbyArena + ui32Offset;
+}
+
+PVRSRV_CLIENT_SYNC_INFO *TQMockAllocSyncInfo(IMG_VOID)
+{
+	TQMOCK_SYNC *psSync = calloc(1, sizeof(*psSync));
+
+	if (psSync == IMG_NULL)
+	{
+		fprintf(stderr, "tqvalidate: out of host memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	psSync->sSyncInfo.psSyncData = &psSync->sSyncData;
+	psSync->sSyncInfo.hKernelSyncInfo = (IMG_HANDLE)&psSync->sSyncInfo;
+	psSync->psNext = gpsSyncs;
+	gpsSyncs = psSync;
+
+	return &psSync->sSyncInfo;
+}
+
+IMG_VOID TQMockResetStats(IMG_VOID)
+{
+	memset(&gsStats, 0, sizeof(gsStats));
+}
+
+IMG_VOID TQMockGetStats(TQMOCK_STATS *psStats)
+{
+	*psStats = gsStats;
+}
+
+TQMOCK_STATS *TQMockStats(IMG_VOID)
+{
+	return &gsStats;
+}
+
+IMG_VOID TQMockSetVerbose(IMG_BOOL bVerbose)
+{
+	gbVerbose = bVerbose;
+}
+
+IMG_BOOL TQMockVerbose(IMG_VOID)
+{
+	return gbVerbose;
+}
+
+
+/*****************************************************************************
+ Transfer contexts
+ *****************************************************************************/
+
+static SGXTQ_CB *TQMockInitCB(TQMOCK_CONTEXT	*psContext,
+							  IMG_UINT32		ui32Index,
+							  IMG_UINT32		ui32Size,
+							  IMG_UINT32		ui32Alignment,
+							  IMG_CHAR			*pbyLabel)
+{
+	SGXTQ_CB *psCB = &psContext->asCB[ui32Index];
+
+	psCB->ui32BufferSize = TQMOCK_ALIGN(ui32Size, ui32Alignment);
+	psCB->ui32Alignment = ui32Alignment;
+	psCB->bAllowPageBr = IMG_TRUE;
+	psCB->psBufferMemInfo = TQMockAllocDeviceMem(psCB->ui32BufferSize, ui32Alignment);
+	psCB->pbyLabel = pbyLabel;
+	psCB->psDevData = &psContext->sDevData;
+
+	return psCB;
+}
+
+/*****************************************************************************
+ * Function Name		:	TQMockCreateContext
+ * Inputs				:	ui32StagingSize - staging buffer bytes, or 0
+ * Outputs				:	-
+ * Returns				:	A transfer context for SGXQueueTransfer.
+ * Description			:	Builds what SGXCreateTransferContext would: the
+ *							command CCB, the fence, the resource circular
+ *							buffers at their device sizes, the static EOR
+ *							handler, the resource slots and the blitlib
+ *							sync modification objects.
+ ******************************************************************************/
+SGXTQ_CLIENT_TRANSFER_CONTEXT *TQMockCreateContext(IMG_UINT32 ui32StagingSize)
+{
+	TQMOCK_CONTEXT					*psContext;
+	SGXTQ_CLIENT_TRANSFER_CONTEXT	*psTQContext;
+	PVRSRV_CLIENT_MEM_INFO			*psMemInfo;
+	SGXTQ_RESOURCE					*psResource;
+	IMG_UINT32						ui32PDSRecordSize;
+	IMG_UINT32						i;
+
+	psContext = calloc(1, sizeof(*psContext));
+	if (psContext == IMG_NULL)
+	{
+		fprintf(stderr, "tqvalidate: out of host memory\n");
+		exit(EXIT_FAILURE);
+	}
+	psTQContext = &psContext->sTQContext;
+
+	psContext->sDevData.psConnection = &psContext->sConnection;
+	psTQContext->psDevData = &psContext->sDevData;
+
+	/* the CCB carries an overrun so a command never has to wrap */
+	psMemInfo = TQMockAllocDeviceMem(TQMOCK_CCB_SIZE + sizeof(SGXMKIF_TRANSFERCMD), SGX_CCB_ALLOCGRAN);
+	((TQMOCK_MEMINFO *)psMemInfo)->psOwnerCCB = &psContext->sTransferCCB;
+	psContext->sTransferCCB.psCCBClientMemInfo = psMemInfo;
+	psContext->sTransferCCB.pui32CCBLinAddr = psMemInfo->pvLinAddr;
+	psContext->sTransferCCB.sCCBDevAddr = psMemInfo->sDevVAddr;
+	psContext->sTransferCCB.pui32WriteOffset = &psContext->ui32CCBWriteOffset;
+	psContext->sTransferCCB.pui32ReadOffset = &psContext->ui32CCBReadOffset;
+	psContext->sTransferCCB.ui32Size = TQMOCK_CCB_SIZE;
+	psContext->sTransferCCB.ui32AllocGran = SGX_CCB_ALLOCGRAN;
+	psTQContext->psTransferCCB = &psContext->sTransferCCB;
+
+	psTQContext->psFenceIDMemInfo = TQMockAllocDeviceMem(sizeof(IMG_UINT32), sizeof(IMG_UINT32));
+	psTQContext->ui32FenceID = 0;
+
+	psTQContext->sUSEExecBase.uiAddr = TQMOCK_DEVMEM_BASE;
+#if ! defined(SGX_FEATURE_PIXEL_PDSADDR_FULL_RANGE)
+	psTQContext->sPDSExecBase.uiAddr = TQMOCK_DEVMEM_BASE;
+#endif
+	psTQContext->sISPStreamBase.uiAddr = TQMOCK_DEVMEM_BASE;
+
+	ui32PDSRecordSize = TQMOCK_ALIGN(TQMOCK_PDS_RECORD_WORDS * sizeof(IMG_UINT32),
+									 SGXTQ_PDS_CODE_GRANULARITY);
+
+	psTQContext->psPDSCodeCB = TQMockInitCB(psContext, 0, SGXTQ_PDS_CODE_CBSIZE,
+											SGXTQ_PDS_CODE_GRANULARITY, "PDS code");
+	psTQContext->psUSECodeCB = TQMockInitCB(psContext, 1, SGXTQ_USSE_CODE_CBSIZE,
+											SGXTQ_USSE_CODE_GRANULARITY, "USE code");
+	psTQContext->psStreamCB = TQMockInitCB(psContext, 2, SGXTQ_ISP_STREAM_CBSIZE,
+										   SGXTQ_ISP_STREAM_GRANULARITY, "ISP stream");
+	psTQContext->psPDSPrimFragSingleSNB = TQMockInitCB(psContext, 3,
+													   ui32PDSRecordSize * SGXTQ_PDSPRIMFRAG_SINGLESOURCE_INSTANCENUM,
+													   SGXTQ_PDS_CODE_GRANULARITY, "PDS single source");
+#if defined(SGXTQ_SUBTILE_TWIDDLING)
+	psTQContext->psUSEEOTSubTwiddledSNB = TQMockInitCB(psContext, 4,
+													   TQMOCK_ALIGN(TQMOCK_EOT_RECORD_WORDS * sizeof(IMG_UINT32),
+																	SGXTQ_USSE_CODE_GRANULARITY) *
+													   SGXTQ_USEEOTHANDLER_SUBTWIDDLED_INSTANCENUM,
+													   SGXTQ_USSE_CODE_GRANULARITY, "USE subtwiddled EOT");
+#endif
+	if (ui32StagingSize != 0)
+	{
+		psTQContext->psStagingBuffer = TQMockInitCB(psContext, 5, ui32StagingSize,
+													SGXTQ_STAGINGBUFFER_ALLOC_GRAN, gszStagingLabel);
+	}
+
+	/* hand every resource slot its own descriptor */
+	psResource = psContext->asResources;
+	for (i = 0; i < SGXTQ_NUM_PDSPRIMFRAGS; i++)
+	{
+		psTQContext->apsPDSPrimResources[i] = psResource++;
+	}
+	for (i = 0; i < SGXTQ_NUM_PDSSECFRAGS; i++)
+	{
+		psTQContext->apsPDSSecResources[i] = psResource++;
+	}
+	for (i = 0; i < SGXTQ_NUM_PDSPIXEVENTHANDLERS; i++)
+	{
+		psTQContext->apsPDSPixeventHandlers[i] = psResource++;
+	}
+	for (i = 0; i < SGXTQ_NUM_USEFRAGS; i++)
+	{
+		psTQContext->apsUSEResources[i] = psResource++;
+	}
+	for (i = 0; i < SGXTQ_NUM_USEEOTHANDLERS; i++)
+	{
+		psTQContext->apsUSEEOTHandlers[i] = psResource++;
+	}
+	for (i = 0; i < SGXTQ_NUM_HWBGOBJS; i++)
+	{
+		psTQContext->apsISPResources[i] = psResource++;
+	}
+	psTQContext->psFast2DISPControlStream = psResource++;
+
+	/* the EOR handler is static, as on the device */
+	psTQContext->psUSEEORHandler = psResource++;
+	psMemInfo = TQMockAllocDeviceMem(sizeof(IMG_UINT32), SGXTQ_USSE_CODE_GRANULARITY);
+	*(IMG_UINT32 *)psMemInfo->pvLinAddr = TQMOCK_RECORD_EOR;
+	psTQContext->psUSEEORHandler->eStorage = SGXTQ_STORAGE_STATIC;
+	psTQContext->psUSEEORHandler->uStorage.sStatic.psMemInfo = psMemInfo;
+	psTQContext->psUSEEORHandler->sDevVAddr = psMemInfo->sDevVAddr;
+	psTQContext->psUSEEORHandler->eResource = SGXTQ_USE;
+	psTQContext->psUSEEOPHandler = psTQContext->psUSEEORHandler;
+
+#if defined(BLITLIB)
+	for (i = 0; i < SGXTQ_MAX_SURFACES + 1; i++)
+	{
+		psTQContext->ahSyncModObjPool[i] = (IMG_HANDLE)&psContext->asModObj[i];
+	}
+#endif
+
+	return psTQContext;
+}
+
+IMG_VOID TQMockDestroyContext(SGXTQ_CLIENT_TRANSFER_CONTEXT *psTQContext)
+{
+	free(psTQContext);
+}
+
+
+/*****************************************************************************
+ Services
+ *****************************************************************************/
+
+IMG_PVOID IMG_CALLCONV PVRSRVAllocUserModeMem(IMG_SIZE_T ui32Size)
+{
+	return malloc(ui32Size);
+}
+
+IMG_VOID IMG_CALLCONV PVRSRVFreeUserModeMem(IMG_PVOID pvMem)
+{
+	free(pvMem);
+}
+
+IMG_VOID PVRSRVMemCopy(IMG_VOID *pvDst, const IMG_VOID *pvSrc, IMG_SIZE_T ui32Size)
+{
+	memmove(pvDst, pvSrc, ui32Size);
+}
+
+IMG_VOID PVRSRVMemSet(IMG_VOID *pvDest, IMG_UINT8 ui8Value, IMG_SIZE_T ui32Size)
+{
+	memset(pvDest, ui8Value, ui32Size);
+}
+
+/* The validator is single threaded; contexts carry no mutex */
+IMG_VOID IMG_CALLCONV PVRSRVLockMutex(PVRSRV_MUTEX_HANDLE hMutex)
+{
+	PVR_UNREFERENCED_PARAMETER(hMutex);
+}
+
+IMG_VOID IMG_CALLCONV PVRSRVUnlockMutex(PVRSRV_MUTEX_HANDLE hMutex)
+{
+	PVR_UNREFERENCED_PARAMETER(hMutex);
+}
+
+PVRSRV_ERROR PVRSRVEventObjectWait(const PVRSRV_CONNECTION *psConnection, IMG_HANDLE hOSEvent)
+{
+	PVR_UNREFERENCED_PARAMETER(psConnection);
+	PVR_UNREFERENCED_PARAMETER(hOSEvent);
+	return PVRSRV_OK;
+}
+
+IMG_VOID PVRSRVWaitus(IMG_UINT32 ui32Timeus)
+{
+	PVR_UNREFERENCED_PARAMETER(ui32Timeus);
+}
+
+/*****************************************************************************
+ * Function Name		:	PVRSRVModifyPendingSyncOps
+ * Description			:	Takes a modification object, snapshots the sync
+ *							object's pending counts and takes the requested
+ *							operations on it. A NULL sync object is taken as
+ *							a surface nobody is synchronising on.
+ ******************************************************************************/
+PVRSRV_ERROR IMG_CALLCONV PVRSRVModifyPendingSyncOps(const PVRSRV_CONNECTION	*psConnection,
+													  IMG_HANDLE				hKernelSyncInfoModObj,
+													  PVRSRV_CLIENT_SYNC_INFO	*psSyncInfo,
+													  IMG_UINT32				ui32ModifyFlags,
+													  IMG_UINT32				*pui32ReadOpsPending,
+													  IMG_UINT32				*pui32WriteOpsPending)
+{
+	TQMOCK_MODOBJ		*psModObj = (TQMOCK_MODOBJ *)hKernelSyncInfoModObj;
+	PVRSRV_SYNC_DATA	*psSyncData;
+
+	PVR_UNREFERENCED_PARAMETER(psConnection);
+
+	if (psModObj->bInUse)
+	{
+		return PVRSRV_ERROR_RETRY;
+	}
+
+	psModObj->bInUse = IMG_TRUE;
+	psModObj->psSyncInfo = psSyncInfo;
+	psModObj->ui32ModifyFlags = ui32ModifyFlags;
+
+	if (psSyncInfo == IMG_NULL)
+	{
+		return PVRSRV_OK;
+	}
+
+	psSyncData = psSyncInfo->psSyncData;
+	psModObj->ui32ReadOpsPending = psSyncData->ui32ReadOpsPending;
+	psModObj->ui32WriteOpsPending = psSyncData->ui32WriteOpsPending;
+
+	if (pui32ReadOpsPending != IMG_NULL)
+	{
+		*pui32ReadOpsPending = psSyncData->ui32ReadOpsPending;
+	}
+	if (pui32WriteOpsPending != IMG_NULL)
+	{
+		*pui32WriteOpsPending = psSyncData->ui32WriteOpsPending;
+	}
+
+	if (ui32ModifyFlags & PVRSRV_MODIFYSYNCOPS_FLAGS_WO_INC)
+	{
+		psSyncData->ui32WriteOpsPending++;
+	}
+	if (ui32ModifyFlags & PVRSRV_MODIFYSYNCOPS_FLAGS_RO_INC)
+	{
+		psSyncData->ui32ReadOpsPending++;
+	}
+
+	return PVRSRV_OK;
+}
+
+/*****************************************************************************
+ * Function Name		:	PVRSRVModifyCompleteSyncOps
+ * Description			:	Completes the operations the modification object
+ *							took. Completing an object with nothing pending
+ *							is reported as an error so double completions
+ *							show up in the results.
+ ******************************************************************************/
+PVRSRV_ERROR IMG_CALLCONV PVRSRVModifyCompleteSyncOps(const PVRSRV_CONNECTION	*psConnection,
+													   IMG_HANDLE				hKernelSyncInfoModObj)
+{
+	TQMOCK_MODOBJ		*psModObj = (TQMOCK_MODOBJ *)hKernelSyncInfoModObj;
+	PVRSRV_SYNC_DATA	*psSyncData;
+
+	PVR_UNREFERENCED_PARAMETER(psConnection);
+
+	if (!psModObj->bInUse)
+	{
+		return PVRSRV_ERROR_INVALID_PARAMS;
+	}
+	psModObj->bInUse = IMG_FALSE;
+
+	if (psModObj->psSyncInfo == IMG_NULL)
+	{
+		return PVRSRV_OK;
+	}
+
+	psSyncData = psModObj->psSyncInfo->psSyncData;
+	if (psModObj->ui32ModifyFlags & PVRSRV_MODIFYSYNCOPS_FLAGS_WO_INC)
+	{
+		psSyncData->ui32WriteOpsComplete++;
+	}
+	if (psModObj->ui32ModifyFlags & PVRSRV_MODIFYSYNCOPS_FLAGS_RO_INC)
+	{
+		psSyncData->ui32ReadOpsComplete++;
+	}
+	psModObj->psSyncInfo = IMG_NULL;
+
+	return PVRSRV_OK;
+}
+
+/*****************************************************************************
+ * Function Name		:	PVRSRVSyncOpsFlushToModObj
+ * Description			:	Succeeds once every operation that was pending on
+ *							the sync object when the modification object was
+ *							taken has completed.
+ ******************************************************************************/
+PVRSRV_ERROR IMG_CALLCONV PVRSRVSyncOpsFlushToModObj(const PVRSRV_CONNECTION	*psConnection,
+													  IMG_HANDLE				hKernelSyncInfoModObj,
+													  IMG_BOOL					bWait)
+{
+	TQMOCK_MODOBJ		*psModObj = (TQMOCK_MODOBJ *)hKernelSyncInfoModObj;
+	PVRSRV_SYNC_DATA	*psSyncData;
+
+	PVR_UNREFERENCED_PARAMETER(psConnection);
+	PVR_UNREFERENCED_PARAMETER(bWait);
+
+	if (!psModObj->bInUse)
+	{
+		return PVRSRV_ERROR_INVALID_PARAMS;
+	}
+	if (psModObj->psSyncInfo == IMG_NULL)
+	{
+		return PVRSRV_OK;
+	}
+
+	psSyncData = psModObj->psSyncInfo->psSyncData;
+	if ((IMG_INT32)(psSyncData->ui32ReadOpsComplete - psModObj->ui32ReadOpsPending) < 0 ||
+		(IMG_INT32)(psSyncData->ui32WriteOpsComplete - psModObj->ui32WriteOpsPending) < 0)
+	{
+		return PVRSRV_ERROR_RETRY;
+	}
+
+	return PVRSRV_OK;
+}
+
+
+/*****************************************************************************
+ SGX bridge
+ *****************************************************************************/
+
+/*****************************************************************************
+ * Function Name		:	SGXAcquireCCB
+ * Description			:	Returns space for ui32CmdSize bytes at the write
+ *							offset. The mock retires commands as they are
+ *							submitted, so a full CCB is never waited on.
+ ******************************************************************************/
+IMG_PVOID SGXAcquireCCB(PVRSRV_DEV_DATA *psDevData, SGX_CLIENT_CCB *psCCB, IMG_UINT32 ui32CmdSize, IMG_HANDLE hOSEvent)
+{
+	PVR_UNREFERENCED_PARAMETER(psDevData);
+	PVR_UNREFERENCED_PARAMETER(hOSEvent);
+
+	if (GET_CCB_SPACE(*psCCB->pui32WriteOffset, *psCCB->pui32ReadOffset, psCCB->ui32Size) < ui32CmdSize)
+	{
+		return IMG_NULL;
+	}
+
+	return (IMG_BYTE *)psCCB->pui32CCBLinAddr + *psCCB->pui32WriteOffset;
+}
+
+static IMG_VOID TQMockTakeSyncOps(IMG_HANDLE hKernelSyncInfo, IMG_BOOL bWrite, IMG_BOOL bComplete)
+{
+	PVRSRV_CLIENT_SYNC_INFO *psSyncInfo = (PVRSRV_CLIENT_SYNC_INFO *)hKernelSyncInfo;
+
+	if (psSyncInfo == IMG_NULL)
+	{
+		return;
+	}
+
+	if (bWrite)
+	{
+		if (bComplete)
+		{
+			psSyncInfo->psSyncData->ui32WriteOpsComplete++;
+		}
+		else
+		{
+			psSyncInfo->psSyncData->ui32WriteOpsPending++;
+		}
+	}
+	else
+	{
+		if (bComplete)
+		{
+			psSyncInfo->psSyncData->ui32ReadOpsComplete++;
+		}
+		else
+		{
+			psSyncInfo->psSyncData->ui32ReadOpsPending++;
+		}
+	}
+}
+
+/*****************************************************************************
+ * Function Name		:	SGXSubmitTransferBridge
+ * Inputs				:	psKick - the kick SGXSubmitTransfer built
+ * Outputs				:	-
+ * Returns				:	PVRSRV_OK
+ * Description			:	Plays the kernel and the microkernel: takes the
+ *							sync operations the command needs, applies its
+ *							memory updates, runs it (unless it is a dummy),
+ *							writes its status values and completes the sync
+ *							operations, honouring the KEEPPENDING and
+ *							NOSYNCUPDATE flags multi pass blits use.
+ ******************************************************************************/
+IMG_INTERNAL PVRSRV_ERROR SGXSubmitTransferBridge(const PVRSRV_DEV_DATA *psDevData, PVRSRV_TRANSFER_SGX_KICK *psKick)
+{
+	PVRSRV_CLIENT_MEM_INFO	*psCCBMemInfo = (PVRSRV_CLIENT_MEM_INFO *)psKick->hCCBMemInfo;
+	SGX_CLIENT_CCB			*psCCB;
+	SGXMKIF_TRANSFERCMD		*psCmd;
+	IMG_UINT32				i;
+
+	PVR_UNREFERENCED_PARAMETER(psDevData);
+
+	psCmd = (SGXMKIF_TRANSFERCMD *)((IMG_BYTE *)psCCBMemInfo->pvLinAddr +
+									psKick->ui32SharedCmdCCBOffset -
+									offsetof(SGXMKIF_TRANSFERCMD, sShared));
+
+	if ((psKick->ui32Flags & SGXMKIF_TQFLAGS_KEEPPENDING) == 0)
+	{
+		for (i = 0; i < psKick->ui32NumSrcSync; i++)
+		{
+			TQMockTakeSyncOps(psKick->ahSrcSyncInfo[i], IMG_FALSE, IMG_FALSE);
+		}
+		for (i = 0; i < psKick->ui32NumDstSync; i++)
+		{
+			TQMockTakeSyncOps(psKick->ahDstSyncInfo[i], IMG_TRUE, IMG_FALSE);
+		}
+	}
+
+	for (i = 0; i < psCmd->ui32NumUpdates; i++)
+	{
+		IMG_UINT32 *pui32Update = TQMockDevVAddrToLin(psCmd->sUpdates[i].sUpdateAddr.uiAddr,
+													  sizeof(IMG_UINT32));
+		if (pui32Update == IMG_NULL)
+		{
+			gsStats.ui32Errors++;
+			continue;
+		}
+		*pui32Update = psCmd->sUpdates[i].ui32UpdateVal;
+	}
+
+	if (psKick->ui32Flags & SGXMKIF_TQFLAGS_DUMMYTRANSFER)
+	{
+		gsStats.ui32DummyKicks++;
+	}
+	else
+	{
+		TQInterpTransferCmd(psCmd);
+	}
+
+	for (i = 0; i < psCmd->sShared.ui32NumStatusVals; i++)
+	{
+		IMG_UINT32 *pui32Status = TQMockDevVAddrToLin(psCmd->sShared.sCtlStatusInfo[i].sStatusDevAddr.uiAddr,
+													  sizeof(IMG_UINT32));
+		if (pui32Status == IMG_NULL)
+		{
+			gsStats.ui32Errors++;
+			continue;
+		}
+		*pui32Status = psCmd->sShared.sCtlStatusInfo[i].ui32StatusValue;
+	}
+
+	if ((psKick->ui32Flags & SGXMKIF_TQFLAGS_NOSYNCUPDATE) == 0)
+	{
+		for (i = 0; i < psKick->ui32NumSrcSync; i++)
+		{
+			TQMockTakeSyncOps(psKick->ahSrcSyncInfo[i], IMG_FALSE, IMG_TRUE);
+		}
+		for (i = 0; i < psKick->ui32NumDstSync; i++)
+		{
+			TQMockTakeSyncOps(psKick->ahDstSyncInfo[i], IMG_TRUE, IMG_TRUE);
+		}
+	}
+
+	/* the command has been consumed */
+	psCCB = ((TQMOCK_MEMINFO *)psCCBMemInfo)->psOwnerCCB;
+	if (psCCB != IMG_NULL)
+	{
+		*psCCB->pui32ReadOffset = *psCCB->pui32WriteOffset;
+	}
+
+	gsStats.ui32Kicks++;
+	return PVRSRV_OK;
+}
+
+IMG_INTERNAL PVRSRV_ERROR SGXSubmit2D(const PVRSRV_DEV_DATA *psDevData, PVRSRV_2D_SGX_KICK *psKick)
+{
+	PVR_UNREFERENCED_PARAMETER(psDevData);
+	PVR_UNREFERENCED_PARAMETER(psKick);
+	return PVRSRV_ERROR_NOT_SUPPORTED;
+}
+
+/* There is no PTLA on the host: the queue falls back to the 3D core */
+PVRSRV_ERROR IMG_CALLCONV SGXQueue2DTransfer(IMG_HANDLE hTransferContext, SGX_QUEUETRANSFER *psQueueTransfer)
+{
+	PVR_UNREFERENCED_PARAMETER(hTransferContext);
+	PVR_UNREFERENCED_PARAMETER(psQueueTransfer);
+	return PVRSRV_ERROR_NOT_SUPPORTED;
+}
+
+
+/*****************************************************************************
+ Resource circular buffers
+ *****************************************************************************/
+
+/*****************************************************************************
+ * Function Name		:	SGXTQ_AcquireCB
+ * Inputs				:	psFenceIDMemInfo - the context fence
+ *							ui32CurrentFence - fence of the blit that will
+ *							use the space
+ *							psCB, ui32Size
+ * Outputs				:	ppvLinAddr, pui32DevVAddr - the space
+ * Returns				:	IMG_FALSE when the space (or a packet slot) is
+ *							not free.
+ * Description			:	Retires the packets whose fence has passed and
+ *							allocates ui32Size bytes, aligned, as a new
+ *							uncommitted packet. An allocation never wraps:
+ *							the tail of the buffer is skipped instead. Since
+ *							every kick has completed by the time the mock
+ *							returns from the bridge, waiting could never
+ *							free space, so bPreparedForWait is ignored.
+ ******************************************************************************/
+IMG_BOOL SGXTQ_AcquireCB(PVRSRV_CLIENT_MEM_INFO	*psFenceIDMemInfo,
+						 IMG_UINT32				ui32CurrentFence,
+						 IMG_HANDLE				hOSevent,
+						 SGXTQ_CB				*psCB,
+						 IMG_UINT32				ui32Size,
+						 IMG_BOOL				bPreparedForWait,
+						 IMG_VOID				**ppvLinAddr,
+						 IMG_PUINT32			pui32DevVAddr,
+						 IMG_BOOL				bPDumpContinuous)
+{
+	IMG_UINT32	ui32Fence = *(IMG_UINT32 *)psFenceIDMemInfo->pvLinAddr;
+	IMG_UINT32	ui32Start;
+
+	PVR_UNREFERENCED_PARAMETER(hOSevent);
+	PVR_UNREFERENCED_PARAMETER(bPreparedForWait);
+	PVR_UNREFERENCED_PARAMETER(bPDumpContinuous);
+
+	while (psCB->ui32PacketRoff != psCB->ui32PacketWoff &&
+		   (IMG_INT32)(ui32Fence - psCB->asCBPackets[psCB->ui32PacketRoff].ui32FenceID) >= 0)
+	{
+		psCB->ui32Roff = psCB->asCBPackets[psCB->ui32PacketRoff].ui32Roff;
+		psCB->ui32PacketRoff = (psCB->ui32PacketRoff + 1) % SGXTQ_MAX_QUEUED_BLITS;
+	}
+
+	/* nothing outstanding: start again from the beginning */
+	if (psCB->ui32PacketRoff == psCB->ui32PacketNCWoff)
+	{
+		psCB->ui32Roff = 0;
+		psCB->ui32Woff = 0;
+		psCB->ui32NCWoff = 0;
+	}
+
+	if ((psCB->ui32PacketNCWoff + 1) % SGXTQ_MAX_QUEUED_BLITS == psCB->ui32PacketRoff)
+	{
+		return IMG_FALSE;
+	}
+
+	ui32Size = TQMOCK_ALIGN(ui32Size, psCB->ui32Alignment);
+
+	/* the used space is [Roff, NCWoff); it may never become the whole buffer */
+	if (psCB->ui32NCWoff >= psCB->ui32Roff)
+	{
+		if (psCB->ui32NCWoff + ui32Size < psCB->ui32BufferSize ||
+			(psCB->ui32NCWoff + ui32Size == psCB->ui32BufferSize && psCB->ui32Roff != 0))
+		{
+			ui32Start = psCB->ui32NCWoff;
+		}
+		else if (ui32Size < psCB->ui32Roff)
+		{
+			ui32Start = 0;
+		}
+		else
+		{
+			return IMG_FALSE;
+		}
+	}
+	else if (psCB->ui32NCWoff + ui32Size < psCB->ui32Roff)
+	{
+		ui32Start = psCB->ui32NCWoff;
+	}
+	else
+	{
+		return IMG_FALSE;
+	}
+
+	psCB->ui32NCWoff = (ui32Start + ui32Size) % psCB->ui32BufferSize;
+	psCB->asCBPackets[psCB->ui32PacketNCWoff].ui32FenceID = ui32CurrentFence;
+	psCB->asCBPackets[psCB->ui32PacketNCWoff].ui32Roff = psCB->ui32NCWoff;
+	psCB->ui32PacketNCWoff = (psCB->ui32PacketNCWoff + 1) % SGXTQ_MAX_QUEUED_BLITS;
+
+	/* the staging buffer is only ever written by the device */
+	if (ppvLinAddr != IMG_NULL)
+	{
+		*ppvLinAddr = (IMG_BYTE *)psCB->psBufferMemInfo->pvLinAddr + ui32Start;
+	}
+	*pui32DevVAddr = psCB->psBufferMemInfo->sDevVAddr.uiAddr + ui32Start;
+
+	if (psCB->pbyLabel == gszStagingLabel)
+	{
+		gsStats.ui32StagingBytes += ui32Size;
+	}
+	else
+	{
+		gsStats.ui32ResourceBytes += ui32Size;
+	}
+
+	return IMG_TRUE;
+}
+
+/* Drops everything acquired since the last flush */
+IMG_VOID SGXTQ_BeginCB(SGXTQ_CB *psCB)
+{
+	psCB->ui32NCWoff = psCB->ui32Woff;
+	psCB->ui32PacketNCWoff = psCB->ui32PacketWoff;
+}
+
+/* Commits everything acquired since the last flush */
+IMG_VOID SGXTQ_FlushCB(SGXTQ_CB *psCB, IMG_BOOL bPDumpContinuous)
+{
+	PVR_UNREFERENCED_PARAMETER(bPDumpContinuous);
+
+	psCB->ui32Woff = psCB->ui32NCWoff;
+	psCB->ui32PacketWoff = psCB->ui32PacketNCWoff;
+}
+
+/*****************************************************************************
+ * Function Name		:	TQMockEmitRecord
+ * Inputs				:	psTQContext, psCB - where to allocate from
+ *							eStorage - how the resource is described
+ *							eResource - what kind of resource it stands for
+ *							pui32Record, ui32Words - the record
+ * Outputs				:	psResource - describes the copy
+ * Returns				:	PVRSRV_ERROR_TIMEOUT if the buffer is full, as a
+ *							device resource would after its wait.
+ * Description			:	Copies a record into a resource circular buffer
+ *							for the blit being prepared.
+ ******************************************************************************/
+static PVRSRV_ERROR TQMockEmitRecord(SGXTQ_CLIENT_TRANSFER_CONTEXT	*psTQContext,
+									 SGXTQ_CB						*psCB,
+									 SGXTQ_RESOURCE_STORAGE			eStorage,
+									 SGXTQ_DEV_RESOURCE				eResource,
+									 const IMG_UINT32				*pui32Record,
+									 IMG_UINT32						ui32Words,
+									 SGXTQ_RESOURCE					*psResource)
+{
+	IMG_VOID	*pvLinAddr;
+	IMG_UINT32	ui32DevVAddr;
+
+	if (!SGXTQ_AcquireCB(psTQContext->psFenceIDMemInfo,
+						 psTQContext->ui32FenceID + 1,
+						 psTQContext->hOSEvent,
+						 psCB,
+						 ui32Words * sizeof(IMG_UINT32),
+						 IMG_TRUE,
+						 &pvLinAddr,
+						 &ui32DevVAddr,
+						 IMG_FALSE))
+	{
+		return PVRSRV_ERROR_TIMEOUT;
+	}
+
+	memcpy(pvLinAddr, pui32Record, ui32Words * sizeof(IMG_UINT32));
+
+	psResource->eStorage = eStorage;
+	psResource->uStorage.sCB.psCB = psCB;
+	psResource->uStorage.sCB.pui32SrcAddr = pvLinAddr;
+	psResource->uStorage.sCB.ui32Size = ui32Words * sizeof(IMG_UINT32);
+	psResource->sDevVAddr.uiAddr = ui32DevVAddr;
+	psResource->eResource = eResource;
+
+	return PVRSRV_OK;
+}
+
+
+/*****************************************************************************
+ Resources
+ *****************************************************************************/
+
+static PVRSRV_ERROR TQMockEmitPDS(SGXTQ_CLIENT_TRANSFER_CONTEXT	*psTQContext,
+								  SGXTQ_CB						*psCB,
+								  SGXTQ_RESOURCE_STORAGE		eStorage,
+								  IMG_UINT32					ui32Magic,
+								  IMG_UINT32					ui32Frag,
+								  const SGXTQ_PDS_UPDATE		*psPDSValues,
+								  SGXTQ_RESOURCE				*psResource)
+{
+	IMG_UINT32		aui32Record[TQMOCK_PDS_RECORD_WORDS];
+	PVRSRV_ERROR	eError;
+
+	aui32Record[0] = ui32Magic;
+	aui32Record[1] = ui32Frag;
+	memcpy(&aui32Record[2], psPDSValues, sizeof(*psPDSValues));
+
+	eError = TQMockEmitRecord(psTQContext, psCB, eStorage, SGXTQ_PDS,
+							  aui32Record, TQMOCK_PDS_RECORD_WORDS, psResource);
+	if (eError == PVRSRV_OK)
+	{
+		psResource->uResource.sPDS.ui32DataLen = sizeof(*psPDSValues);
+		psResource->uResource.sPDS.ui32Attributes = SGXTQ_MAX_DIRECT_ATTRIBUTES;
+#if defined(SGX_FEATURE_UNIFIED_TEMPS_AND_PAS)
+		psResource->uResource.sPDS.ui32TempRegs = TQMOCK_USE_TEMPS;
+#endif
+	}
+	return eError;
+}
+
+PVRSRV_ERROR SGXTQ_CreatePDSPrimResource(SGXTQ_CLIENT_TRANSFER_CONTEXT	*psTQContext,
+										 SGXTQ_PDSPRIMFRAGS				ePDSPrim,
+										 SGXTQ_PDS_UPDATE				*psPDSValues,
+										 IMG_BOOL						bPDumpContinuous)
+{
+	PVR_UNREFERENCED_PARAMETER(bPDumpContinuous);
+
+	if ((IMG_UINT32)ePDSPrim >= SGXTQ_NUM_PDSPRIMFRAGS)
+	{
+		return PVRSRV_ERROR_INVALID_PARAMS;
+	}
+
+	/* single source primaries come from their skeleton buffer */
+	if (ePDSPrim == SGXTQ_PDSPRIMFRAG_SINGLESOURCE)
+	{
+		return TQMockEmitPDS(psTQContext, psTQContext->psPDSPrimFragSingleSNB, SGXTQ_STORAGE_NBUFFER,
+							 TQMOCK_RECORD_PDSPRIM, ePDSPrim, psPDSValues,
+							 psTQContext->apsPDSPrimResources[ePDSPrim]);
+	}
+
+	return TQMockEmitPDS(psTQContext, psTQContext->psPDSCodeCB, SGXTQ_STORAGE_CB,
+						 TQMOCK_RECORD_PDSPRIM, ePDSPrim, psPDSValues,
+						 psTQContext->apsPDSPrimResources[ePDSPrim]);
+}
+
+PVRSRV_ERROR SGXTQ_CreatePDSSecResource(SGXTQ_CLIENT_TRANSFER_CONTEXT	*psTQContext,
+										SGXTQ_PDSSECFRAGS				ePDSSec,
+										SGXTQ_PDS_UPDATE				*psPDSValues,
+										IMG_BOOL						bPDumpContinuous)
+{
+	PVR_UNREFERENCED_PARAMETER(bPDumpContinuous);
+
+	if ((IMG_UINT32)ePDSSec >= SGXTQ_NUM_PDSSECFRAGS)
+	{
+		return PVRSRV_ERROR_INVALID_PARAMS;
+	}
+
+	return TQMockEmitPDS(psTQContext, psTQContext->psPDSCodeCB, SGXTQ_STORAGE_CB,
+						 TQMOCK_RECORD_PDSSEC, ePDSSec, psPDSValues,
+						 psTQContext->apsPDSSecResources[ePDSSec]);
+}
+
+/*****************************************************************************
+ * Function Name		:	SGXTQ_CreateUSESecondaryResource
+ * Description			:	Emits the secondary update program record and
+ *							points the secondary's USSE kick (ui32U2) at it.
+ ******************************************************************************/
+PVRSRV_ERROR SGXTQ_CreateUSESecondaryResource(SGXTQ_CLIENT_TRANSFER_CONTEXT	*psTQContext,
+											  SGXTQ_PDSSECFRAGS				ePDSSec,
+											  SGXTQ_PDS_UPDATE				*psPDSValues,
+											  IMG_BOOL						bPDumpContinuous)
+{
+	TQMOCK_CONTEXT	*psContext = (TQMOCK_CONTEXT *)psTQContext;
+	IMG_UINT32		aui32Record[2];
+	PVRSRV_ERROR	eError;
+
+	PVR_UNREFERENCED_PARAMETER(bPDumpContinuous);
+
+	aui32Record[0] = TQMOCK_RECORD_USESEC;
+	aui32Record[1] = ePDSSec;
+
+	eError = TQMockEmitRecord(psTQContext, psTQContext->psUSECodeCB, SGXTQ_STORAGE_CB, SGXTQ_USE,
+							  aui32Record, 2, &psContext->sUSESecondary);
+	if (eError != PVRSRV_OK)
+	{
+		return eError;
+	}
+
+	psPDSValues->ui32U0 = 0;
+	psPDSValues->ui32U1 = 0;
+	psPDSValues->ui32U2 = psContext->sUSESecondary.sDevVAddr.uiAddr;
+
+	return PVRSRV_OK;
+}
+
+/*****************************************************************************
+ * Function Name		:	SGXTQ_CreateUSEResource
+ * Description			:	Emits the record of a USE program together with
+ *							the limms it is patched with: the colour of a
+ *							fill, the gamma of a cleartype blend.
+ ******************************************************************************/
+PVRSRV_ERROR SGXTQ_CreateUSEResource(SGXTQ_CLIENT_TRANSFER_CONTEXT	*psTQContext,
+									 SGXTQ_USEFRAGS					eUSEId,
+									 IMG_UINT32						*aui32USELimm,
+									 IMG_BOOL						bPDumpContinuous)
+{
+	IMG_UINT32		aui32Record[3 + 6];
+	IMG_UINT32		ui32Limms = 0;
+	IMG_UINT32		i;
+	PVRSRV_ERROR	eError;
+
+	PVR_UNREFERENCED_PARAMETER(bPDumpContinuous);
+
+	if ((IMG_UINT32)eUSEId >= SGXTQ_NUM_USEFRAGS)
+	{
+		return PVRSRV_ERROR_INVALID_PARAMS;
+	}
+
+	if (aui32USELimm != IMG_NULL)
+	{
+		switch (eUSEId)
+		{
+			case SGXTQ_USEBLIT_FILL:
+			{
+				ui32Limms = 1;
+				break;
+			}
+			case SGXTQ_USEBLIT_CLEARTYPEBLEND_GAMMA:
+			case SGXTQ_USEBLIT_CLEARTYPEBLEND_INVALIDGAMMA:
+			{
+				ui32Limms = 6;
+				break;
+			}
+			default:
+			{
+				break;
+			}
+		}
+	}
+
+	aui32Record[0] = TQMOCK_RECORD_USE;
+	aui32Record[1] = eUSEId;
+	aui32Record[2] = ui32Limms;
+	for (i = 0; i < ui32Limms; i++)
+	{
+		aui32Record[3 + i] = aui32USELimm[i];
+	}
+
+	eError = TQMockEmitRecord(psTQContext, psTQContext->psUSECodeCB, SGXTQ_STORAGE_CB, SGXTQ_USE,
+							  aui32Record, 3 + ui32Limms, psTQContext->apsUSEResources[eUSEId]);
+	if (eError == PVRSRV_OK)
+	{
+		psTQContext->apsUSEResources[eUSEId]->uResource.sUSE.ui32NumTempRegs = TQMOCK_USE_TEMPS;
+	}
+	return eError;
+}
+
+PVRSRV_ERROR SGXTQ_CreateUSEEOTHandler(SGXTQ_CLIENT_TRANSFER_CONTEXT	*psTQContext,
+									   IMG_UINT32						*aui32PBEState,
+									   SGXTQ_USEEOTHANDLER				eEot,
+									   IMG_UINT32						ui32UV,
+									   IMG_UINT32						ui32DstBytesPP,
+									   IMG_BOOL							bPDumpContinuous)
+{
+	IMG_UINT32		aui32Record[TQMOCK_EOT_RECORD_WORDS];
+	SGXTQ_CB		*psCB = psTQContext->psUSECodeCB;
+	SGXTQ_RESOURCE_STORAGE eStorage = SGXTQ_STORAGE_CB;
+
+	PVR_UNREFERENCED_PARAMETER(bPDumpContinuous);
+
+	if ((IMG_UINT32)eEot >= SGXTQ_NUM_USEEOTHANDLERS)
+	{
+		return PVRSRV_ERROR_INVALID_PARAMS;
+	}
+
+#if defined(SGXTQ_SUBTILE_TWIDDLING)
+	if (eEot == SGXTQ_USEEOTHANDLER_SUBTWIDDLED)
+	{
+		psCB = psTQContext->psUSEEOTSubTwiddledSNB;
+		eStorage = SGXTQ_STORAGE_NBUFFER;
+	}
+#endif
+
+	aui32Record[0] = TQMOCK_RECORD_EOT;
+	aui32Record[1] = eEot;
+	aui32Record[2] = ui32UV;
+	aui32Record[3] = ui32DstBytesPP;
+	memcpy(&aui32Record[4], aui32PBEState, TQMOCK_PBE_STATE_WORDS * sizeof(IMG_UINT32));
+
+	return TQMockEmitRecord(psTQContext, psCB, eStorage, SGXTQ_USE,
+							aui32Record, TQMOCK_EOT_RECORD_WORDS, psTQContext->apsUSEEOTHandlers[eEot]);
+}
+
+PVRSRV_ERROR SGXTQ_CreatePDSPixeventHandler(SGXTQ_CLIENT_TRANSFER_CONTEXT	*psTQContext,
+											SGXTQ_RESOURCE					*psEORHandler,
+											SGXTQ_RESOURCE					*psEOTHandler,
+											SGXTQ_PDSPIXEVENTHANDLER		ePixev,
+											IMG_BOOL						bPDumpContinuous)
+{
+	IMG_UINT32 aui32Record[4];
+
+	PVR_UNREFERENCED_PARAMETER(bPDumpContinuous);
+
+	if ((IMG_UINT32)ePixev >= SGXTQ_NUM_PDSPIXEVENTHANDLERS)
+	{
+		return PVRSRV_ERROR_INVALID_PARAMS;
+	}
+
+	aui32Record[0] = TQMOCK_RECORD_PIXEVENT;
+	aui32Record[1] = ePixev;
+	aui32Record[2] = psEORHandler->sDevVAddr.uiAddr;
+	aui32Record[3] = psEOTHandler->sDevVAddr.uiAddr;
+
+	return TQMockEmitRecord(psTQContext, psTQContext->psPDSCodeCB, SGXTQ_STORAGE_CB, SGXTQ_PDS,
+							aui32Record, 4, psTQContext->apsPDSPixeventHandlers[ePixev]);
+}
+
+/*****************************************************************************
+ * Function Name		:	SGXTQ_CreateISPResource
+ * Description			:	Emits the background object for ui32NumLayers
+ *							layers: the primary and secondary it runs, the
+ *							destination rectangle and the texture coordinates
+ *							of each layer at its corners.
+ *
+ *							[magic, primary, secondary, x0, y0, x1, y1,
+ *							 layers, invert, flags, TSP coordinates (12)]
+ ******************************************************************************/
+PVRSRV_ERROR SGXTQ_CreateISPResource(SGXTQ_CLIENT_TRANSFER_CONTEXT	*psTQContext,
+									 SGXTQ_RESOURCE					*psPrimary,
+									 SGXTQ_RESOURCE					*psSecondary,
+									 IMG_RECT						*psDstRect,
+									 SGXTQ_TSP_COORDS				*psTSPCoords,
+									 IMG_BOOL						bConservativeResUsage,
+									 IMG_BOOL						bInvertTriangle,
+									 IMG_UINT32						ui32NumLayers,
+									 IMG_BOOL						bPDumpContinuous,
+									 IMG_UINT32						ui32Flags)
+{
+	IMG_UINT32 aui32Record[TQMOCK_ISP_RECORD_WORDS];
+
+	PVR_UNREFERENCED_PARAMETER(bConservativeResUsage);
+	PVR_UNREFERENCED_PARAMETER(bPDumpContinuous);
+
+	if (ui32NumLayers >= SGXTQ_NUM_HWBGOBJS)
+	{
+		return PVRSRV_ERROR_INVALID_PARAMS;
+	}
+
+	aui32Record[0] = TQMOCK_RECORD_ISP;
+	aui32Record[1] = psPrimary->sDevVAddr.uiAddr;
+	aui32Record[2] = psSecondary->sDevVAddr.uiAddr;
+	aui32Record[3] = (IMG_UINT32)psDstRect->x0;
+	aui32Record[4] = (IMG_UINT32)psDstRect->y0;
+	aui32Record[5] = (IMG_UINT32)psDstRect->x1;
+	aui32Record[6] = (IMG_UINT32)psDstRect->y1;
+	aui32Record[7] = ui32NumLayers;
+	aui32Record[8] = bInvertTriangle;
+	aui32Record[9] = ui32Flags;
+	if (psTSPCoords != IMG_NULL)
+	{
+		memcpy(&aui32Record[10], psTSPCoords, sizeof(*psTSPCoords));
+	}
+	else
+	{
+		memset(&aui32Record[10], 0, sizeof(*psTSPCoords));
+	}
+
+	return TQMockEmitRecord(psTQContext, psTQContext->psStreamCB, SGXTQ_STORAGE_CB, SGXTQ_STREAM,
+							aui32Record, TQMOCK_ISP_RECORD_WORDS,
+							psTQContext->apsISPResources[ui32NumLayers]);
+}
+
+/*****************************************************************************
+ * Function Name		:	SGXTQ_CreateISPF2DResource
+ * Description			:	Emits the fast 2D control stream:
+ *
+ *							[magic, primary, secondary, rects, translucent,
+ *							 per rect x0, y0, x1, y1, U0, U1, V0, V1]
+ ******************************************************************************/
+PVRSRV_ERROR SGXTQ_CreateISPF2DResource(SGXTQ_CLIENT_TRANSFER_CONTEXT	*psTQContext,
+										SGXTQ_RESOURCE					*psPrimary,
+										SGXTQ_RESOURCE					*psSecondary,
+										IMG_RECT						*psDstRect,
+										SGXTQ_TSP_SINGLE				*psTSPCoords,
+										IMG_UINT32						ui32NumRects,
+										IMG_BOOL						bTranslucent,
+										IMG_BOOL						bPDumpContinuous)
+{
+	IMG_UINT32		*pui32Record;
+	IMG_UINT32		ui32Words = 5 + ui32NumRects * TQMOCK_F2D_RECT_WORDS;
+	IMG_UINT32		i;
+	PVRSRV_ERROR	eError;
+
+	PVR_UNREFERENCED_PARAMETER(bPDumpContinuous);
+
+	pui32Record = malloc(ui32Words * sizeof(IMG_UINT32));
+	if (pui32Record == IMG_NULL)
+	{
+		return PVRSRV_ERROR_OUT_OF_MEMORY;
+	}
+
+	pui32Record[0] = TQMOCK_RECORD_ISPF2D;
+	pui32Record[1] = psPrimary->sDevVAddr.uiAddr;
+	pui32Record[2] = psSecondary->sDevVAddr.uiAddr;
+	pui32Record[3] = ui32NumRects;
+	pui32Record[4] = bTranslucent;
+	for (i = 0; i < ui32NumRects; i++)
+	{
+		IMG_UINT32 *pui32Rect = &pui32Record[5 + i * TQMOCK_F2D_RECT_WORDS];
+
+		pui32Rect[0] = (IMG_UINT32)psDstRect[i].x0;
+		pui32Rect[1] = (IMG_UINT32)psDstRect[i].y0;
+		pui32Rect[2] = (IMG_UINT32)psDstRect[i].x1;
+		pui32Rect[3] = (IMG_UINT32)psDstRect[i].y1;
+		pui32Rect[4] = psTSPCoords[i].ui32Src0U0;
+		pui32Rect[5] = psTSPCoords[i].ui32Src0U1;
+		pui32Rect[6] = psTSPCoords[i].ui32Src0V0;
+		pui32Rect[7] = psTSPCoords[i].ui32Src0V1;
+	}
+
+	eError = TQMockEmitRecord(psTQContext, psTQContext->psStreamCB, SGXTQ_STORAGE_CB, SGXTQ_STREAM,
+							  pui32Record, ui32Words, psTQContext->psFast2DISPControlStream);
+	free(pui32Record);
+
+	return eError;
+}
+
+
+/*****************************************************************************
+ Register setup
+ *****************************************************************************/
+
+IMG_VOID SGXTQ_SetupTransferRenderBox(SGXMKIF_TRANSFERCMD	*psSubmit,
+									  IMG_UINT32			x0,
+									  IMG_UINT32			y0,
+									  IMG_UINT32			x1,
+									  IMG_UINT32			y1)
+{
+	psSubmit->sHWRegs.ui32ISPRenderBox1 = TQMOCK_RENDERBOX(x0, y0);
+	psSubmit->sHWRegs.ui32ISPRenderBox2 = TQMOCK_RENDERBOX(x1, y1);
+}
+
+/*****************************************************************************
+ * Function Name		:	SGXTQ_SetupTransferClipRenderBox
+ * Description			:	Clips the render box to the destination surface;
+ *							a box with nothing left in it is an error.
+ ******************************************************************************/
+PVRSRV_ERROR SGXTQ_SetupTransferClipRenderBox(SGXMKIF_TRANSFERCMD	*psSubmit,
+											  IMG_UINT32			x0,
+											  IMG_UINT32			y0,
+											  IMG_UINT32			x1,
+											  IMG_UINT32			y1,
+											  IMG_UINT32			ui32DstWidth,
+											  IMG_UINT32			ui32DstHeight)
+{
+	IMG_INT32 i32X0 = (IMG_INT32)x0;
+	IMG_INT32 i32Y0 = (IMG_INT32)y0;
+	IMG_INT32 i32X1 = (IMG_INT32)x1;
+	IMG_INT32 i32Y1 = (IMG_INT32)y1;
+
+	i32X0 = MAX(i32X0, 0);
+	i32Y0 = MAX(i32Y0, 0);
+	i32X1 = MIN(i32X1, (IMG_INT32)ui32DstWidth);
+	i32Y1 = MIN(i32Y1, (IMG_INT32)ui32DstHeight);
+
+	if (i32X0 >= i32X1 || i32Y0 >= i32Y1)
+	{
+		return PVRSRV_ERROR_INVALID_PARAMS;
+	}
+
+	SGXTQ_SetupTransferRenderBox(psSubmit, (IMG_UINT32)i32X0, (IMG_UINT32)i32Y0,
+								 (IMG_UINT32)i32X1, (IMG_UINT32)i32Y1);
+	return PVRSRV_OK;
+}
+
+IMG_VOID SGXTQ_SetupPixeventRegs(SGXTQ_CLIENT_TRANSFER_CONTEXT	*psTQContext,
+								 SGXMKIF_TRANSFERCMD			*psSubmit,
+								 SGXTQ_RESOURCE					*psPixEvent)
+{
+	PVR_UNREFERENCED_PARAMETER(psTQContext);
+
+	psSubmit->sHWRegs.ui32EDMPixelPDSExec = psPixEvent->sDevVAddr.uiAddr;
+}
+
+/*****************************************************************************
+ * Function Name		:	SGXTQ_SetupTransferRegs
+ * Description			:	Points the background object register at the ISP
+ *							stream for ui32NumLayers (the fast 2D stream for
+ *							a fast 2D render) and the pixel event register at
+ *							the pixel event handler.
+ ******************************************************************************/
+IMG_VOID SGXTQ_SetupTransferRegs(SGXTQ_CLIENT_TRANSFER_CONTEXT	*psTQContext,
+								 IMG_UINT32						ui32BIFTile0Config,
+								 SGXMKIF_TRANSFERCMD			*psSubmit,
+								 SGXTQ_RESOURCE					*psPixEvent,
+								 IMG_UINT32						ui32NumLayers,
+								 IMG_UINT32						ui32ScanDirection,
+								 IMG_UINT32						ui32ISPRenderType)
+{
+	PVR_UNREFERENCED_PARAMETER(ui32BIFTile0Config);
+	PVR_UNREFERENCED_PARAMETER(ui32ScanDirection);
+
+	if (ui32ISPRenderType == EUR_CR_ISP_RENDER_TYPE_FAST2D)
+	{
+		psSubmit->sHWRegs.ui32ISPBgObj = psTQContext->psFast2DISPControlStream->sDevVAddr.uiAddr;
+	}
+	else if (ui32NumLayers < SGXTQ_NUM_HWBGOBJS)
+	{
+		psSubmit->sHWRegs.ui32ISPBgObj = psTQContext->apsISPResources[ui32NumLayers]->sDevVAddr.uiAddr;
+	}
+	psSubmit->sHWRegs.ui32ISPRender = ui32ISPRenderType;
+
+	SGXTQ_SetupPixeventRegs(psTQContext, psSubmit, psPixEvent);
+}
+
+
+/*****************************************************************************
+ State words
+ *****************************************************************************/
+
+/*****************************************************************************
+ * Function Name		:	SGXTQ_GetPixelFormats
+ * Description			:	Puts the source format in the TAG state and the
+ *							destination format in the PBE state, both as
+ *							PVRSRV_PIXEL_FORMATs. Any pair blitlib can convert
+ *							is accepted, as is a pair of identical formats,
+ *							and takes one pass. An UNKNOWN source stands for
+ *							no source at all (a fill).
+ ******************************************************************************/
+PVRSRV_ERROR SGXTQ_GetPixelFormats(PVRSRV_PIXEL_FORMAT	eSrcPix,
+								   IMG_BOOL				bSrcPacked,
+								   PVRSRV_PIXEL_FORMAT	eDstPix,
+								   IMG_BOOL				bDstPacked,
+								   SGXTQ_FILTERTYPE		eFilter,
+								   IMG_UINT32			*pui32TagState,
+								   IMG_BOOL				*pbTagPlanarizerNeeded,
+								   IMG_UINT32			*pui32TAGBpp,
+								   IMG_UINT32			*pui32PBEState,
+								   IMG_UINT32			*pui32PBEBpp,
+								   IMG_UINT32			ui32Pass,
+								   IMG_UINT32			*pui32PassesRequired)
+{
+	IMG_UINT32 ui32SrcBpp = 0;
+	IMG_UINT32 ui32DstBpp;
+
+	PVR_UNREFERENCED_PARAMETER(bSrcPacked);
+	PVR_UNREFERENCED_PARAMETER(bDstPacked);
+	PVR_UNREFERENCED_PARAMETER(eFilter);
+	PVR_UNREFERENCED_PARAMETER(ui32Pass);
+
+	if ((IMG_UINT32)eSrcPix > PVRSRV_PIXEL_FORMAT_RAW1024 ||
+		(IMG_UINT32)eDstPix > PVRSRV_PIXEL_FORMAT_RAW1024)
+	{
+		return PVRSRV_ERROR_NOT_SUPPORTED;
+	}
+
+	ui32DstBpp = gas_BLExternalPixelTable[eDstPix].ui32BytesPerPixel;
+	if (ui32DstBpp == 0)
+	{
+		return PVRSRV_ERROR_NOT_SUPPORTED;
+	}
+
+	if (eSrcPix != PVRSRV_PIXEL_FORMAT_UNKNOWN)
+	{
+		ui32SrcBpp = gas_BLExternalPixelTable[eSrcPix].ui32BytesPerPixel;
+		if (ui32SrcBpp == 0)
+		{
+			return PVRSRV_ERROR_NOT_SUPPORTED;
+		}
+		if (eSrcPix != eDstPix &&
+			(!BLFormatIsConvertible(eSrcPix) || !BLFormatIsConvertible(eDstPix)))
+		{
+			return PVRSRV_ERROR_NOT_SUPPORTED;
+		}
+	}
+
+	if (pui32TagState != IMG_NULL)
+	{
+		pui32TagState[0] = (pui32TagState[0] & ~TQMOCK_TAG_FORMAT_MASK) | (IMG_UINT32)eSrcPix;
+	}
+	if (pbTagPlanarizerNeeded != IMG_NULL)
+	{
+		*pbTagPlanarizerNeeded = IMG_FALSE;
+	}
+	if (pui32TAGBpp != IMG_NULL)
+	{
+		*pui32TAGBpp = ui32SrcBpp;
+	}
+	if (pui32PBEState != IMG_NULL)
+	{
+		pui32PBEState[0] = (pui32PBEState[0] & ~TQMOCK_PBE_FORMAT_MASK) | (IMG_UINT32)eDstPix;
+	}
+	if (pui32PBEBpp != IMG_NULL)
+	{
+		*pui32PBEBpp = ui32DstBpp;
+	}
+	if (pui32PassesRequired != IMG_NULL)
+	{
+		*pui32PassesRequired = 1;
+	}
+
+	return PVRSRV_OK;
+}
+
+IMG_UINT32 SGXTQ_FilterFromEnum(SGXTQ_FILTERTYPE eFilter)
+{
+	return ((IMG_UINT32)eFilter << TQMOCK_TAG_FILTER_SHIFT) & TQMOCK_TAG_FILTER_MASK;
+}
+
+/*****************************************************************************
+ * Function Name		:	SGXTQ_ShaderFromRop
+ * Description			:	Maps a rop whose high and low nibbles match to
+ *							its ROP program. Rops that ignore the destination
+ *							(S, NOTS) read one layer, the rest two.
+ ******************************************************************************/
+PVRSRV_ERROR SGXTQ_ShaderFromRop(IMG_BYTE				byCustomRop3,
+								 SGXTQ_USEFRAGS			*peUSEProg,
+								 SGXTQ_PDSPRIMFRAGS		*pePDSPrim,
+								 IMG_UINT32				*pui32NumLayers)
+{
+	IMG_UINT32 ui32Nibble = byCustomRop3 & 0xF;
+
+	if (ui32Nibble == 0 || ui32Nibble == 0xF || (IMG_UINT32)(byCustomRop3 >> 4) != ui32Nibble)
+	{
+		return PVRSRV_ERROR_INVALID_PARAMS;
+	}
+
+	*peUSEProg = (SGXTQ_USEFRAGS)(SGXTQ_USEBLIT_ROP_NOTSANDNOTD + ui32Nibble - 1);
+
+	if (ui32Nibble == 0x3 || ui32Nibble == 0xC)
+	{
+		*pePDSPrim = SGXTQ_PDSPRIMFRAG_SINGLESOURCE;
+		*pui32NumLayers = 1;
+	}
+	else
+	{
+		*pePDSPrim = SGXTQ_PDSPRIMFRAG_TWOSOURCE;
+		*pui32NumLayers = 2;
+	}
+
+	return PVRSRV_OK;
+}
+
+IMG_VOID SGXTQ_ShaderFromAlpha(SGXTQ_ALPHA			eAlpha,
+							   SGXTQ_USEFRAGS		*peUSEProgram,
+							   SGXTQ_PDSSECFRAGS	*pePDSSec)
+{
+	switch (eAlpha)
+	{
+		case SGXTQ_ALPHA_SOURCE:
+		{
+			*peUSEProgram = SGXTQ_USEBLIT_SRC_BLEND;
+			*pePDSSec = SGXTQ_PDSSECFRAG_BASIC;
+			break;
+		}
+		case SGXTQ_ALPHA_PREMUL_SOURCE:
+		{
+			*peUSEProgram = SGXTQ_USEBLIT_PREMULSRC_BLEND;
+			*pePDSSec = SGXTQ_PDSSECFRAG_BASIC;
+			break;
+		}
+		case SGXTQ_ALPHA_GLOBAL:
+		{
+			*peUSEProgram = SGXTQ_USEBLIT_GLOBAL_BLEND;
+			*pePDSSec = SGXTQ_PDSSECFRAG_1ATTR;
+			break;
+		}
+		case SGXTQ_ALPHA_PREMUL_SOURCE_WITH_GLOBAL:
+		{
+			*peUSEProgram = SGXTQ_USEBLIT_PREMULSRCWITHGLOBAL_BLEND;
+			*pePDSSec = SGXTQ_PDSSECFRAG_1ATTR;
+			break;
+		}
+		default:
+		{
+			break;
+		}
+	}
+}
+
+IMG_UINT32 SGXTQ_GetStrideGran(IMG_UINT32 ui32LineStride, IMG_UINT32 ui32BytesPerPixel)
+{
+	PVR_UNREFERENCED_PARAMETER(ui32LineStride);
+	PVR_UNREFERENCED_PARAMETER(ui32BytesPerPixel);
+	return TQMOCK_STRIDE_GRAN;
+}
+
+static IMG_BOOL TQMockIsStrided(SGXTQ_MEMLAYOUT eMemLayout)
+{
+	switch (eMemLayout)
+	{
+		case SGXTQ_MEMLAYOUT_STRIDE:
+		case SGXTQ_MEMLAYOUT_OUT_LINEAR:
+		case SGXTQ_MEMLAYOUT_TILED:
+		case SGXTQ_MEMLAYOUT_OUT_TILED:
+		{
+			return IMG_TRUE;
+		}
+		default:
+		{
+			return IMG_FALSE;
+		}
+	}
+}
+
+/*****************************************************************************
+ * Function Name		:	SGXTQ_GetSurfaceStride
+ * Outputs				:	pi32LineStride - the line stride in pixels
+ * Description			:	Strided surfaces give their byte stride, which
+ *							must be a whole number of pixels; twiddled ones
+ *							their width.
+ ******************************************************************************/
+PVRSRV_ERROR SGXTQ_GetSurfaceStride(SGXTQ_SURFACE	*psSurf,
+									IMG_UINT32		ui32BytesPP,
+									IMG_BOOL		bIsInput,
+									IMG_BOOL		bStridedBlitEnabled,
+									IMG_UINT32		*pi32LineStride)
+{
+	IMG_UINT32 ui32Stride;
+
+	PVR_UNREFERENCED_PARAMETER(bIsInput);
+	PVR_UNREFERENCED_PARAMETER(bStridedBlitEnabled);
+
+	if (ui32BytesPP == 0)
+	{
+		return PVRSRV_ERROR_INVALID_PARAMS;
+	}
+
+	if (!TQMockIsStrided(psSurf->eMemLayout))
+	{
+		*pi32LineStride = psSurf->ui32Width;
+		return PVRSRV_OK;
+	}
+
+	ui32Stride = (IMG_UINT32)(psSurf->i32StrideInBytes < 0 ? -psSurf->i32StrideInBytes
+															: psSurf->i32StrideInBytes);
+	if (ui32Stride % ui32BytesPP != 0)
+	{
+		return PVRSRV_ERROR_INVALID_PARAMS;
+	}
+
+	*pi32LineStride = ui32Stride / ui32BytesPP;
+	return PVRSRV_OK;
+}
+
+/*****************************************************************************
+ * Function Name		:	SGXTQ_GetSurfaceWidth
+ * Outputs				:	pui32RightEdge - width the TAG or PBE sees
+ * Description			:	A strided source is textured as wide as its
+ *							stride; everything else has its own width.
+ ******************************************************************************/
+PVRSRV_ERROR SGXTQ_GetSurfaceWidth(SGXTQ_SURFACE	*psSurf,
+								   IMG_UINT32		ui32BytesPP,
+								   IMG_BOOL			bIsInput,
+								   IMG_BOOL			bStridedBlitEnabled,
+								   IMG_UINT32		*pui32RightEdge)
+{
+	if (bIsInput && TQMockIsStrided(psSurf->eMemLayout))
+	{
+		return SGXTQ_GetSurfaceStride(psSurf, ui32BytesPP, bIsInput, bStridedBlitEnabled, pui32RightEdge);
+	}
+
+	*pui32RightEdge = psSurf->ui32Width;
+	return PVRSRV_OK;
+}
+
+IMG_VOID SGXTQ_SetTAGState(SGXTQ_PDS_UPDATE	*psPDSUpdate,
+						   IMG_UINT32		ui32LayerNo,
+						   IMG_UINT32		ui32SrcDevVAddr,
+						   SGXTQ_FILTERTYPE	eFilter,
+						   IMG_UINT32		ui32Width,
+						   IMG_UINT32		ui32Height,
+						   IMG_UINT32		ui32Stride,
+						   IMG_UINT32		ui32TAGFormat,
+						   IMG_UINT32		ui32BytesPP,
+						   IMG_BOOL			bNewPixelHandling,
+						   SGXTQ_MEMLAYOUT	eMemLayout)
+{
+	IMG_UINT32 *pui32TAGState = psPDSUpdate->asLayers[ui32LayerNo].aui32TAGState;
+
+	/* a TAG format of 0 keeps what SGXTQ_GetPixelFormats put there */
+	if (ui32TAGFormat != 0)
+	{
+		pui32TAGState[0] = (pui32TAGState[0] & ~TQMOCK_TAG_FORMAT_MASK) | (ui32TAGFormat & TQMOCK_TAG_FORMAT_MASK);
+	}
+	pui32TAGState[0] &= TQMOCK_TAG_FORMAT_MASK;
+	pui32TAGState[0] |= SGXTQ_FilterFromEnum(eFilter);
+	pui32TAGState[0] |= ((IMG_UINT32)eMemLayout << TQMOCK_TAG_LAYOUT_SHIFT) & TQMOCK_TAG_LAYOUT_MASK;
+	pui32TAGState[0] |= (ui32BytesPP << TQMOCK_TAG_BPP_SHIFT) & TQMOCK_TAG_BPP_MASK;
+	if (!bNewPixelHandling)
+	{
+		pui32TAGState[0] |= TQMOCK_TAG_RAW;
+	}
+	pui32TAGState[1] = (ui32Width & 0xFFFFU) | (ui32Height << 16);
+	pui32TAGState[2] = ui32Stride;
+	pui32TAGState[3] = ui32SrcDevVAddr;
+}
+
+IMG_VOID SGXTQ_SetUSSEKick(SGXTQ_PDS_UPDATE	*psPDSUpdate,
+						   IMG_DEV_VIRTADDR	sUSEExecAddr,
+						   IMG_DEV_VIRTADDR	sUSEExecBase,
+						   IMG_UINT32		ui32NumTempsRegs)
+{
+	PVR_UNREFERENCED_PARAMETER(sUSEExecBase);
+
+	psPDSUpdate->ui32U0 = 0;
+	psPDSUpdate->ui32U1 = 0;
+	psPDSUpdate->ui32U2 = sUSEExecAddr.uiAddr;
+#if defined(SGX_FEATURE_UNIFIED_TEMPS_AND_PAS)
+	psPDSUpdate->ui32TempRegs = ui32NumTempsRegs;
+#else
+	PVR_UNREFERENCED_PARAMETER(ui32NumTempsRegs);
+#endif
+}
+
+IMG_VOID SGXTQ_SetDMAState(SGXTQ_PDS_UPDATE	*psPDSUpdate,
+						   IMG_DEV_VIRTADDR	sDevVaddr,
+						   IMG_UINT32		ui32LineLen,
+						   IMG_UINT32		ui32LineNo,
+						   IMG_UINT32		ui32Offset)
+{
+	psPDSUpdate->ui32D0 = sDevVaddr.uiAddr + ui32Offset;
+	psPDSUpdate->ui32D1 = (ui32LineLen & 0xFFFFU) | (ui32LineNo << 16);
+	psPDSUpdate->ui32DMASize = ui32LineLen * ui32LineNo;
+}
+
+PVRSRV_ERROR SGXTQ_SetPBEState(IMG_RECT			*psDstRect,
+							   SGXTQ_MEMLAYOUT	eMemLayout,
+							   IMG_UINT32		ui32DstWidth,
+							   IMG_UINT32		ui32DstHeight,
+							   IMG_UINT32		ui32DstLineStride,
+							   IMG_UINT32		ui32DstPBEPackMode,
+							   IMG_UINT32		ui32DstDevVAddr,
+							   IMG_UINT32		ui32SrcSel,
+							   SGXTQ_ROTATION	eRotation,
+							   IMG_BOOL			bEnableDithering,
+							   IMG_BOOL			bNewPixelHandling,
+							   IMG_UINT32		*aui32PBEState)
+{
+	PVR_UNREFERENCED_PARAMETER(bNewPixelHandling);
+
+	if (psDstRect->x0 < 0 || psDstRect->y0 < 0 ||
+		psDstRect->x1 <= psDstRect->x0 || psDstRect->y1 <= psDstRect->y0)
+	{
+		return PVRSRV_ERROR_INVALID_PARAMS;
+	}
+
+	aui32PBEState[0] &= TQMOCK_PBE_FORMAT_MASK;
+	aui32PBEState[0] |= ((IMG_UINT32)eMemLayout << TQMOCK_PBE_LAYOUT_SHIFT) & TQMOCK_PBE_LAYOUT_MASK;
+	aui32PBEState[0] |= ((IMG_UINT32)eRotation << TQMOCK_PBE_ROTATION_SHIFT) & TQMOCK_PBE_ROTATION_MASK;
+	aui32PBEState[0] |= bEnableDithering ? TQMOCK_PBE_DITHER : 0;
+	aui32PBEState[0] |= ui32SrcSel << TQMOCK_PBE_SRCSEL_SHIFT;
+	aui32PBEState[1] = ui32DstDevVAddr;
+	aui32PBEState[2] = ui32DstLineStride;
+	aui32PBEState[3] = (ui32DstWidth & 0xFFFFU) | (ui32DstHeight << 16);
+	aui32PBEState[4] = ((IMG_UINT32)psDstRect->x0 & 0xFFFFU) | ((IMG_UINT32)psDstRect->y0 << 16);
+	aui32PBEState[5] = ((IMG_UINT32)psDstRect->x1 & 0xFFFFU) | ((IMG_UINT32)psDstRect->y1 << 16);
+	aui32PBEState[6] = ui32DstPBEPackMode;
+
+	return PVRSRV_OK;
+}
+
+
+/*****************************************************************************
+ Arithmetic and copies
+ *****************************************************************************/
+
+IMG_UFIXED SGXTQ_FixedIntDiv(IMG_UINT16 ui16A, IMG_UINT16 ui16B)
+{
+	return (IMG_UFIXED)(((IMG_UINT32)ui16A << FIXEDPT_FRAC) / ui16B);
+}
+
+/* Float bits of ui32A / uiB */
+IMG_UINT32 SGXTQ_FloatIntDiv(IMG_UINT32 ui32A, IMG_UINT32 uiB)
+{
+	union
+	{
+		IMG_FLOAT	f;
+		IMG_UINT32	ui32;
+	} uResult;
+
+	uResult.f = (IMG_FLOAT)ui32A / (IMG_FLOAT)uiB;
+	return uResult.ui32;
+}
+
+static IMG_UINT32 TQMockFloatToF16(IMG_FLOAT fValue)
+{
+	IMG_UINT32 ui32Exp = 15;
+
+	if (fValue <= 0.0f)
+	{
+		return 0;
+	}
+	while (fValue >= 2.0f && ui32Exp < 30)
+	{
+		fValue *= 0.5f;
+		ui32Exp++;
+	}
+	while (fValue < 1.0f && ui32Exp > 1)
+	{
+		fValue *= 2.0f;
+		ui32Exp--;
+	}
+	if (fValue < 1.0f)
+	{
+		/* denormal */
+		return (IMG_UINT32)(fValue * 1024.0f + 0.5f);
+	}
+	return (ui32Exp << 10) | ((IMG_UINT32)((fValue - 1.0f) * 1024.0f + 0.5f) & 0x3FFU);
+}
+
+IMG_UINT32 SGXTQ_FixedToF16(IMG_UFIXED ufxVal)
+{
+	return TQMockFloatToF16((IMG_FLOAT)ufxVal / (IMG_FLOAT)(1UL << FIXEDPT_FRAC));
+}
+
+IMG_UINT32 SGXTQ_ByteToF16(IMG_UINT32 byte)
+{
+	return TQMockFloatToF16((IMG_FLOAT)(byte & 0xFF) / 255.0f);
+}
+
+/*****************************************************************************
+ * Function Name		:	SGXTQ_ClampInputRects
+ * Description			:	Trims a pair of same sized rectangles so both
+ *							lie inside their surfaces, keeping them the same
+ *							size.
+ ******************************************************************************/
+IMG_VOID SGXTQ_ClampInputRects(IMG_RECT		*psSrcRect,
+							   IMG_UINT32	ui32SrcWidth,
+							   IMG_UINT32	ui32SrcHeight,
+							   IMG_RECT		*psDstRect,
+							   IMG_UINT32	ui32DstWidth,
+							   IMG_UINT32	ui32DstHeight)
+{
+	IMG_INT32 i32Trim;
+
+	i32Trim = MAX(MAX(-psSrcRect->x0, -psDstRect->x0), 0);
+	psSrcRect->x0 += i32Trim;
+	psDstRect->x0 += i32Trim;
+
+	i32Trim = MAX(MAX(-psSrcRect->y0, -psDstRect->y0), 0);
+	psSrcRect->y0 += i32Trim;
+	psDstRect->y0 += i32Trim;
+
+	i32Trim = MAX(MAX(psSrcRect->x1 - (IMG_INT32)ui32SrcWidth, psDstRect->x1 - (IMG_INT32)ui32DstWidth), 0);
+	psSrcRect->x1 -= i32Trim;
+	psDstRect->x1 -= i32Trim;
+
+	i32Trim = MAX(MAX(psSrcRect->y1 - (IMG_INT32)ui32SrcHeight, psDstRect->y1 - (IMG_INT32)ui32DstHeight), 0);
+	psSrcRect->y1 -= i32Trim;
+	psDstRect->y1 -= i32Trim;
+}
+
+IMG_VOID SGXTQ_CopyToStagingBuffer(IMG_VOID		*pvSBLinAddr,
+								   IMG_UINT32	ui32SBStrideInBytes,
+								   IMG_PBYTE	pbySrcLinAddr,
+								   IMG_UINT32	ui32SrcStrideInBytes,
+								   IMG_UINT32	ui32BytesPP,
+								   IMG_UINT32	ui32PixelByteStride,
+								   IMG_UINT32	ui32HeightToCopy,
+								   IMG_UINT32	ui32WidthToCopy)
+{
+	IMG_PBYTE	pbyDst = pvSBLinAddr;
+	IMG_UINT32	x, y;
+
+	for (y = 0; y < ui32HeightToCopy; y++)
+	{
+		for (x = 0; x < ui32WidthToCopy; x++)
+		{
+			memcpy(pbyDst + x * ui32BytesPP, pbySrcLinAddr + x * ui32PixelByteStride, ui32BytesPP);
+		}
+		pbyDst += ui32SBStrideInBytes;
+		pbySrcLinAddr += ui32SrcStrideInBytes;
+	}
+}
+
+/******************************************************************************
+ End of file (tqmock.c)
+******************************************************************************/
@@ -0,0 +1,165 @@
+/******************************************************************************
+ * Name         : tqmock.h
+ * Title        : Mock services layer for the transfer queue validator
+ *
+ * Copyright    : 2010 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means,electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Description  : sgxtransfer_queue.c is linked against this layer instead
+ *                of services and the SGXTQ_ utilities. Device memory is a
+ *                host arena, the transfer command CCB and the resource
+ *                circular buffers behave like their device counterparts,
+ *                and every submitted transfer command is run by the
+ *                interpreter in tqinterp.c before its status values are
+ *                written back.
+ *
+ *                The resources the SGXTQ_Create* functions build are not
+ *                PDS or USE code: each is a small record, in the circular
+ *                buffer it would have been allocated from, naming the
+ *                fragment and holding the values it was given (see the
+ *                TQMOCK_RECORD_ words below). TAG and PBE state words use
+ *                the layout described at TQMOCK_TAG_ and TQMOCK_PBE_. The
+ *                interpreter understands exactly these encodings; nothing
+ *                here describes the hardware.
+ *
+ * Modifications:-
+ * $Log: tqmock.h $
+ *****************************************************************************/
+
+#ifndef _TQMOCK_H_
+#define _TQMOCK_H_
+
+#include <stddef.h>
+
+#include "img_types.h"
+#include "services.h"
+#include "servicesext.h"
+#include "sgxapi.h"
+#include "sgxinfo.h"
+#include "sgxinfo_client.h"
+#include "sgxtransfer_client.h"
+
+/* Device virtual address of the first byte of the arena */
+#define TQMOCK_DEVMEM_BASE				0x10000000U
+
+/* Resource records: the first word of each is one of these */
+#define TQMOCK_RECORD_PDSPRIM			0x50445350U	/* ePrim, SGXTQ_PDS_UPDATE */
+#define TQMOCK_RECORD_PDSSEC			0x50445353U	/* eSec, SGXTQ_PDS_UPDATE */
+#define TQMOCK_RECORD_USE				0x55534550U	/* eProg, limm present, limm */
+#define TQMOCK_RECORD_USESEC			0x55534553U	/* eSec */
+#define TQMOCK_RECORD_EOT				0x454F5448U	/* eEot, UV, bpp, PBE state */
+#define TQMOCK_RECORD_EOR				0x454F5248U	/* - */
+#define TQMOCK_RECORD_PIXEVENT			0x50495845U	/* ePixev, EOR, EOT */
+#define TQMOCK_RECORD_ISP				0x49535042U	/* see CreateISPResource */
+#define TQMOCK_RECORD_ISPF2D			0x49535046U	/* see CreateISPF2DResource */
+
+/*
+	TAG state, SGXTQ_LAYER.aui32TAGState:
+		word 0: PVRSRV_PIXEL_FORMAT (from GetPixelFormats), filter, memory
+				layout, raw flag (no format: texels are read as bytes),
+				bytes per pixel
+		word 1: width | height << 16
+		word 2: stride in pixels
+		word 3: device virtual address
+*/
+#define TQMOCK_TAG_FORMAT_MASK			0x0000FFFFU
+#define TQMOCK_TAG_FILTER_SHIFT			16
+#define TQMOCK_TAG_FILTER_MASK			0x00030000U
+#define TQMOCK_TAG_LAYOUT_SHIFT			18
+#define TQMOCK_TAG_LAYOUT_MASK			0x001C0000U
+#define TQMOCK_TAG_RAW					0x00200000U
+#define TQMOCK_TAG_BPP_SHIFT			24
+#define TQMOCK_TAG_BPP_MASK				0x1F000000U
+
+/*
+	PBE state, SGXTQ_PREP_INTERNAL.aui32PBEState:
+		word 0: PVRSRV_PIXEL_FORMAT (from GetPixelFormats), memory layout,
+				rotation, dither, source select
+		word 1: device virtual address
+		word 2: stride in pixels
+		word 3: width | height << 16
+		word 4: destination rectangle x0 | y0 << 16
+		word 5: destination rectangle x1 | y1 << 16
+		word 6: pack mode
+*/
+#define TQMOCK_PBE_FORMAT_MASK			0x0000FFFFU
+#define TQMOCK_PBE_LAYOUT_SHIFT			16
+#define TQMOCK_PBE_LAYOUT_MASK			0x00070000U
+#define TQMOCK_PBE_ROTATION_SHIFT		19
+#define TQMOCK_PBE_ROTATION_MASK		0x00180000U
+#define TQMOCK_PBE_DITHER				0x00200000U
+#define TQMOCK_PBE_SRCSEL_SHIFT			22
+
+/* ISPRenderBox1/2: x | y << 16 of the first and one past the last pixel */
+#define TQMOCK_RENDERBOX(x, y)			(((IMG_UINT32)(x) & 0xFFFFU) | ((IMG_UINT32)(y) << 16))
+
+/*
+	USSE kick, SGXTQ_PDS_UPDATE: SGXTQ_SetUSSEKick puts the device virtual
+	address of the USE record in ui32U2 and clears ui32U0/ui32U1, which the
+	queue ORs its texture dependency bits into.
+*/
+
+/* Stride granularity (pixels) reported by SGXTQ_GetStrideGran */
+#define TQMOCK_STRIDE_GRAN				8
+
+/* Temporary registers every mock USE program claims */
+#define TQMOCK_USE_TEMPS				4
+
+typedef struct _TQMOCK_STATS_
+{
+	/* Transfer commands submitted, and those of them flagged as dummies */
+	IMG_UINT32	ui32Kicks;
+	IMG_UINT32	ui32DummyKicks;
+
+	/* Pixels the interpreter wrote, and the texel and PBE bytes that took */
+	IMG_UINT32	ui32PixelsWritten;
+	IMG_UINT32	ui32BytesRead;
+	IMG_UINT32	ui32BytesWritten;
+
+	/* Circular buffer space acquired for resources and for staging */
+	IMG_UINT32	ui32ResourceBytes;
+	IMG_UINT32	ui32StagingBytes;
+
+	/* Records or states the interpreter could not run */
+	IMG_UINT32	ui32Errors;
+} TQMOCK_STATS;
+
+/* Arena */
+IMG_VOID TQMockInit(IMG_UINT32 ui32ArenaSize);
+IMG_VOID TQMockDeinit(IMG_VOID);
+PVRSRV_CLIENT_MEM_INFO *TQMockAllocDeviceMem(IMG_UINT32 ui32Size, IMG_UINT32 ui32Alignment);
+IMG_UINT32 TQMockArenaMark(IMG_VOID);
+IMG_VOID TQMockArenaRelease(IMG_UINT32 ui32Mark);
+IMG_VOID *TQMockDevVAddrToLin(IMG_UINT32 ui32DevVAddr, IMG_UINT32 ui32Size);
+
+/* Sync objects; freed by TQMockDeinit */
+PVRSRV_CLIENT_SYNC_INFO *TQMockAllocSyncInfo(IMG_VOID);
+
+/* Transfer contexts; ui32StagingSize of 0 leaves the staging buffer out */
+SGXTQ_CLIENT_TRANSFER_CONTEXT *TQMockCreateContext(IMG_UINT32 ui32StagingSize);
+IMG_VOID TQMockDestroyContext(SGXTQ_CLIENT_TRANSFER_CONTEXT *psTQContext);
+
+/* Statistics, summed over every context since the last reset */
+IMG_VOID TQMockResetStats(IMG_VOID);
+IMG_VOID TQMockGetStats(TQMOCK_STATS *psStats);
+TQMOCK_STATS *TQMockStats(IMG_VOID);
+
+IMG_VOID TQMockSetVerbose(IMG_BOOL bVerbose);
+IMG_BOOL TQMockVerbose(IMG_VOID);
+
+/* tqinterp.c: runs one transfer command */
+IMG_VOID TQInterpTransferCmd(const SGXMKIF_TRANSFERCMD *psCmd);
+
+#endif /* _TQMOCK_H_ */
+
+/******************************************************************************
+ End of file (tqmock.h)
+******************************************************************************/
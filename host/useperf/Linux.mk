@@ -0,0 +1,38 @@
+# Copyright	2010 Imagination Technologies Limited. All rights reserved.
+#
+# No part of this software, either material or conceptual may be
+# copied or distributed, transmitted, transcribed, stored in a
+# retrieval system or translated into any human or computer
+# language in any form by any means, electronic, mechanical,
+# manual or other-wise, or disclosed to third parties without
+# the express written permission of: Imagination Technologies
+# Limited, HomePark Industrial Estate, Kings Langley,
+# Hertfordshire, WD4 8LZ, UK
+#
+# $Log: Linux.mk $
+#
+
+modules := useperf
+
+useperf_type := host_executable
+
+useperf_target := useperf
+
+useperf_src = \
+ main.c \
+ $(TOP)/tools/intern/useasm/specialregs.c \
+ $(TOP)/tools/intern/useasm/specialregs_vec.c \
+ $(TOP)/tools/intern/useasm/useasm.c \
+ $(TOP)/tools/intern/useasm/usedisasm.c \
+ $(TOP)/tools/intern/useasm/useperf.c \
+ $(TOP)/tools/intern/useasm/usetab.c \
+ $(TOP)/tools/intern/useasm/utils.c
+
+useperf_cflags := \
+ -DUSER -DSUPPORT_SGX -DSUPPORT_SGX543 \
+ -DINCLUDE_SGX_FEATURE_TABLE -DINCLUDE_SGX_BUG_TABLE \
+ -D'IMG_ABORT()=abort()' -include psp2_pvr_desc.h
+
+useperf_includes := include4 hwdefs services4/include \
+ services4/system/psp2 intermediates/sgxsupport intermediates/errata \
+ tools/intern/useasm
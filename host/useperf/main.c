@@ -0,0 +1,694 @@
+/******************************************************************************
+ * Name         : main.c
+ * Title        : Static USE cycle estimator (useperf)
+ *
+ * Copyright    : 2006-2010 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means,electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Description  : Estimates the cost of USE programs without running them.
+ *
+ *                The input is either a raw binary (pairs of little endian
+ *                dwords, as in memory) or a text listing with one
+ *                instruction per line, as written by DumpVertexShader and
+ *                DumpFragmentShader into the shader analysis file or by
+ *                glslc-sgx into its .asm files:
+ *
+ *                  <index>: [0x<address> ]0x<inst1><inst0>  <disassembly>
+ *
+ *                In a listing every line containing "Disassembly" starts a
+ *                new program, so a whole analysis file can be given at
+ *                once.
+ *
+ *                For each program the tool prints its basic blocks with the
+ *                issue slots they use (the cost when other tasks hide all
+ *                latencies), the cycles a single task takes to run them in
+ *                order, the longest dependency chain and the register bank
+ *                conflicts. The totals along the most expensive path from
+ *                the start of the program, with loop bodies counted once,
+ *                are the cost per pixel (or vertex).
+ *
+ * Modifications:-
+ * $Log: main.c $
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+
+#include "img_types.h"
+#include "sgxdefs.h"
+#include "use.h"
+#include "usedisasm.h"
+#include "useperf.h"
+
+/*
+	Longest program name kept from a listing header.
+*/
+#define MAX_PROGRAM_NAME	(256)
+
+/*
+	A program read from the input.
+*/
+typedef struct _INPUT_PROGRAM_
+{
+	IMG_CHAR	szName[MAX_PROGRAM_NAME];
+	IMG_UINT32	uInstCount;
+	IMG_UINT32	uMaxInstCount;
+	IMG_PUINT32	puInsts;
+} INPUT_PROGRAM, *PINPUT_PROGRAM;
+
+static PCSGX_CORE_DESC	psTarget	= IMG_NULL;
+static USEPERF_PARAMS	sParams;
+static IMG_BOOL			bVerbose	= IMG_FALSE;
+
+/*****************************************************************************
+ FUNCTION	: Usage
+
+ PURPOSE	: Prints the command line options.
+
+ PARAMETERS	: None.
+
+ RETURNS	: Nothing.
+*****************************************************************************/
+static IMG_VOID Usage(IMG_VOID)
+{
+	fprintf(stderr, "Usage: useperf [-t <cycles>] [-m <cycles>] [-o <offset>] [-v] <file> ...\n");
+	fprintf(stderr, "\n");
+	fprintf(stderr, "  Estimates the cycles taken by USE programs, from a raw binary or from a\n");
+	fprintf(stderr, "  listing written by the shader analysis dump or glslc-sgx.\n");
+	fprintf(stderr, "\n");
+	fprintf(stderr, "  -t <cycles>  Texture sample latency (default %u).\n", USEPERF_DEFAULT_TEXTURE_LATENCY);
+	fprintf(stderr, "  -m <cycles>  Memory load latency (default %u).\n", USEPERF_DEFAULT_MEMORY_LATENCY);
+	fprintf(stderr, "  -o <offset>  Code offset (in instructions) of the program, for BA targets.\n");
+	fprintf(stderr, "  -v           Also print the timing of each instruction.\n");
+}
+
+/*****************************************************************************
+ FUNCTION	: ReadFile
+
+ PURPOSE	: Reads a whole file into a zero terminated buffer.
+
+ PARAMETERS	: pszFileName	- File to read.
+			  puSize		- Returns the size of the file.
+
+ RETURNS	: The contents, or IMG_NULL.
+*****************************************************************************/
+static IMG_CHAR *ReadFile(const IMG_CHAR *pszFileName, IMG_UINT32 *puSize)
+{
+	FILE		*psFile = fopen(pszFileName, "rb");
+	IMG_CHAR	*pszBuffer;
+	long		lSize;
+
+	if (!psFile)
+	{
+		return IMG_NULL;
+	}
+
+	fseek(psFile, 0, SEEK_END);
+	lSize = ftell(psFile);
+	fseek(psFile, 0, SEEK_SET);
+
+	pszBuffer = (lSize >= 0) ? malloc((size_t)lSize + 1) : IMG_NULL;
+
+	if (pszBuffer)
+	{
+		if (fread(pszBuffer, 1, (size_t)lSize, psFile) != (size_t)lSize)
+		{
+			free(pszBuffer);
+			pszBuffer = IMG_NULL;
+		}
+		else
+		{
+			pszBuffer[lSize] = '\0';
+			*puSize = (IMG_UINT32)lSize;
+		}
+	}
+
+	fclose(psFile);
+
+	return pszBuffer;
+}
+
+/*****************************************************************************
+ FUNCTION	: AddInstruction
+
+ PURPOSE	: Appends an instruction to a program.
+
+ PARAMETERS	: psProgram		- Program to add to.
+			  uInst0, uInst1	- Instruction.
+
+ RETURNS	: IMG_FALSE if out of memory.
+*****************************************************************************/
+static IMG_BOOL AddInstruction(PINPUT_PROGRAM psProgram, IMG_UINT32 uInst0, IMG_UINT32 uInst1)
+{
+	if (psProgram->uInstCount == psProgram->uMaxInstCount)
+	{
+		IMG_UINT32	uNewMax = (psProgram->uMaxInstCount == 0) ? 256 : psProgram->uMaxInstCount * 2;
+		IMG_PUINT32	puNewInsts = realloc(psProgram->puInsts, uNewMax * 2 * sizeof(IMG_UINT32));
+
+		if (!puNewInsts)
+		{
+			return IMG_FALSE;
+		}
+		psProgram->puInsts = puNewInsts;
+		psProgram->uMaxInstCount = uNewMax;
+	}
+
+	psProgram->puInsts[psProgram->uInstCount * 2 + 0] = uInst0;
+	psProgram->puInsts[psProgram->uInstCount * 2 + 1] = uInst1;
+	psProgram->uInstCount++;
+
+	return IMG_TRUE;
+}
+
+/*****************************************************************************
+ FUNCTION	: ParseHex
+
+ PURPOSE	: Parses a 0x prefixed hexadecimal number.
+
+ PARAMETERS	: ppszPos		- Position in the line; advanced past the number.
+			  puDigits		- Returns the number of digits.
+			  pui64Value	- Returns the value.
+
+ RETURNS	: IMG_FALSE if there is no number at the position.
+*****************************************************************************/
+static IMG_BOOL ParseHex(const IMG_CHAR **ppszPos, IMG_UINT32 *puDigits, IMG_UINT64 *pui64Value)
+{
+	const IMG_CHAR	*pszPos = *ppszPos;
+	IMG_UINT64		ui64Value = 0;
+	IMG_UINT32		uDigits = 0;
+
+	if (pszPos[0] != '0' || (pszPos[1] != 'x' && pszPos[1] != 'X'))
+	{
+		return IMG_FALSE;
+	}
+	pszPos += 2;
+
+	while (isxdigit((unsigned char)*pszPos))
+	{
+		IMG_CHAR	cDigit = *pszPos++;
+
+		ui64Value <<= 4;
+		if (cDigit >= '0' && cDigit <= '9')
+		{
+			ui64Value |= (IMG_UINT64)(cDigit - '0');
+		}
+		else
+		{
+			ui64Value |= (IMG_UINT64)(tolower((unsigned char)cDigit) - 'a' + 10);
+		}
+		uDigits++;
+	}
+
+	if (uDigits == 0)
+	{
+		return IMG_FALSE;
+	}
+
+	*ppszPos = pszPos;
+	*puDigits = uDigits;
+	*pui64Value = ui64Value;
+	return IMG_TRUE;
+}
+
+/*****************************************************************************
+ FUNCTION	: ParseListingLine
+
+ PURPOSE	: Gets the instruction from a line of a listing.
+
+ PARAMETERS	: pszLine		- Line to parse.
+			  puInst0, puInst1	- Returns the instruction.
+
+ RETURNS	: IMG_FALSE if the line isn't an instruction.
+*****************************************************************************/
+static IMG_BOOL ParseListingLine(const IMG_CHAR *pszLine, IMG_UINT32 *puInst0, IMG_UINT32 *puInst1)
+{
+	IMG_UINT64	ui64Value;
+	IMG_UINT32	uDigits;
+
+	while (*pszLine == ' ' || *pszLine == '\t')
+	{
+		pszLine++;
+	}
+	if (!isdigit((unsigned char)*pszLine))
+	{
+		return IMG_FALSE;
+	}
+	while (isdigit((unsigned char)*pszLine))
+	{
+		pszLine++;
+	}
+	if (*pszLine++ != ':')
+	{
+		return IMG_FALSE;
+	}
+	while (*pszLine == ' ')
+	{
+		pszLine++;
+	}
+
+	if (!ParseHex(&pszLine, &uDigits, &ui64Value))
+	{
+		return IMG_FALSE;
+	}
+	if (uDigits <= 8)
+	{
+		/*
+			Skip the device virtual address in an analysis dump.
+		*/
+		while (*pszLine == ' ')
+		{
+			pszLine++;
+		}
+		if (!ParseHex(&pszLine, &uDigits, &ui64Value))
+		{
+			return IMG_FALSE;
+		}
+	}
+	if (uDigits != 16)
+	{
+		return IMG_FALSE;
+	}
+
+	*puInst1 = (IMG_UINT32)(ui64Value >> 32);
+	*puInst0 = (IMG_UINT32)(ui64Value & 0xFFFFFFFFU);
+	return IMG_TRUE;
+}
+
+/*****************************************************************************
+ FUNCTION	: PrintInstructions
+
+ PURPOSE	: Prints the timing of each instruction in a program.
+
+ PARAMETERS	: psInput		- Program.
+			  psProgram		- Estimate for the program.
+
+ RETURNS	: Nothing.
+*****************************************************************************/
+static IMG_VOID PrintInstructions(PINPUT_PROGRAM psInput, PUSEPERF_PROGRAM psProgram)
+{
+	IMG_UINT32	uBlock;
+
+	printf("  inst  class    issue  ready  conflicts\n");
+	for (uBlock = 0; uBlock < psProgram->uBlockCount; uBlock++)
+	{
+		PUSEPERF_BLOCK	psBlock = &psProgram->psBlocks[uBlock];
+		IMG_PBOOL		abCritical = calloc(psBlock->uInstCount, sizeof(IMG_BOOL));
+		IMG_UINT32		uInst;
+
+		/*
+			Flag the instructions on the longest dependency chain of the block.
+		*/
+		if (abCritical)
+		{
+			for (uInst = psBlock->uCriticalPathEnd; uInst != USEPERF_UNDEF; uInst = psProgram->psInsts[uInst].uCriticalPred)
+			{
+				abCritical[uInst - psBlock->uFirstInst] = IMG_TRUE;
+			}
+		}
+
+		printf("  block %u:\n", uBlock);
+		for (uInst = psBlock->uFirstInst; uInst < psBlock->uFirstInst + psBlock->uInstCount; uInst++)
+		{
+			PUSEPERF_INST	psInst = &psProgram->psInsts[uInst];
+			IMG_CHAR		szInst[256];
+
+			if (psInst->bInvalid)
+			{
+				strcpy(szInst, "<invalid>");
+			}
+			else
+			{
+				UseDisassembleInstruction(psTarget, psInput->puInsts[uInst * 2 + 0], psInput->puInsts[uInst * 2 + 1], szInst);
+			}
+
+			printf("  %4u%c %-8s %5u  %5u  %9u  %s\n",
+				   uInst,
+				   (abCritical && abCritical[uInst - psBlock->uFirstInst]) ? '*' : ' ',
+				   UsePerfClassName(psInst->eClass),
+				   psInst->uIssueTime,
+				   psInst->uReadyTime,
+				   psInst->uBankConflicts,
+				   szInst);
+		}
+
+		free(abCritical);
+	}
+	printf("\n");
+}
+
+/*****************************************************************************
+ FUNCTION	: PrintCriticalPath
+
+ PURPOSE	: Prints the longest dependency chain of a block.
+
+ PARAMETERS	: psProgram		- Estimate for the program.
+			  uBlock		- Block.
+
+ RETURNS	: Nothing.
+*****************************************************************************/
+static IMG_VOID PrintCriticalPath(PUSEPERF_PROGRAM psProgram, IMG_UINT32 uBlock)
+{
+	PUSEPERF_BLOCK	psBlock = &psProgram->psBlocks[uBlock];
+	IMG_UINT32		auChain[32];
+	IMG_UINT32		uChainLength = 0;
+	IMG_UINT32		uTotal = 0;
+	IMG_UINT32		uInst;
+
+	for (uInst = psBlock->uCriticalPathEnd; uInst != USEPERF_UNDEF; uInst = psProgram->psInsts[uInst].uCriticalPred)
+	{
+		if (uChainLength < sizeof(auChain) / sizeof(auChain[0]))
+		{
+			auChain[uChainLength++] = uInst;
+		}
+		uTotal++;
+	}
+
+	printf("Critical path (block %u, %u cycles, %u instructions):", uBlock, psBlock->uCriticalPath, uTotal);
+	while (uChainLength > 0)
+	{
+		uInst = auChain[--uChainLength];
+		printf(" %u(%s)", uInst, UsePerfClassName(psProgram->psInsts[uInst].eClass));
+	}
+	if (uTotal > sizeof(auChain) / sizeof(auChain[0]))
+	{
+		printf(" ...");
+	}
+	printf("\n");
+}
+
+/*****************************************************************************
+ FUNCTION	: ReportProgram
+
+ PURPOSE	: Estimates a program and prints the result.
+
+ PARAMETERS	: psInput		- Program.
+
+ RETURNS	: IMG_FALSE if the estimate couldn't be made.
+*****************************************************************************/
+static IMG_BOOL ReportProgram(PINPUT_PROGRAM psInput)
+{
+	USEPERF_PROGRAM	sProgram;
+	IMG_UINT32		uBlock;
+	IMG_UINT32		uWorstBlock = USEPERF_UNDEF;
+
+	if (!UsePerfAnalyse(psTarget, &sParams, psInput->uInstCount, psInput->puInsts, &sProgram))
+	{
+		fprintf(stderr, "useperf: out of memory\n");
+		return IMG_FALSE;
+	}
+
+	printf("%s\n", psInput->szName);
+	printf("%u instructions, %u blocks, %u loops", sProgram.uInstCount, sProgram.uBlockCount, sProgram.uLoops);
+	if (sProgram.uInvalidInsts > 0)
+	{
+		printf(", %u invalid", sProgram.uInvalidInsts);
+	}
+	printf("\n\n");
+
+	if (bVerbose)
+	{
+		PrintInstructions(psInput, &sProgram);
+	}
+
+	printf("  block  first  insts  succ      issue  latency  critical  conflicts  dual  efo  smp  desched\n");
+	for (uBlock = 0; uBlock < sProgram.uBlockCount; uBlock++)
+	{
+		PUSEPERF_BLOCK	psBlock = &sProgram.psBlocks[uBlock];
+		IMG_CHAR		szSucc[32];
+
+		switch (psBlock->uSuccCount)
+		{
+			case 0:		strcpy(szSucc, "-"); break;
+			case 1:		sprintf(szSucc, "%u", psBlock->auSucc[0]); break;
+			default:	sprintf(szSucc, "%u,%u", psBlock->auSucc[0], psBlock->auSucc[1]); break;
+		}
+
+		printf("%c %5u  %5u  %5u  %-8s %5u  %7u  %8u  %9u  %4u  %3u  %3u  %7u\n",
+			   psBlock->bOnLongestPath ? '*' : ' ',
+			   uBlock,
+			   psBlock->uFirstInst,
+			   psBlock->uInstCount,
+			   szSucc,
+			   psBlock->uIssueCycles,
+			   psBlock->uLatencyCycles,
+			   psBlock->uCriticalPath,
+			   psBlock->uBankConflicts,
+			   psBlock->uDualIssued,
+			   psBlock->uEfos,
+			   psBlock->uTextureSamples,
+			   psBlock->uDeschedPoints);
+
+		if (
+				psBlock->bOnLongestPath &&
+				psBlock->uCriticalPathEnd != USEPERF_UNDEF &&
+				(uWorstBlock == USEPERF_UNDEF || psBlock->uCriticalPath > sProgram.psBlocks[uWorstBlock].uCriticalPath)
+		   )
+		{
+			uWorstBlock = uBlock;
+		}
+	}
+	printf("\n");
+
+	if (uWorstBlock != USEPERF_UNDEF)
+	{
+		PrintCriticalPath(&sProgram, uWorstBlock);
+	}
+	printf("Longest path (*): %u instructions per pixel/vertex, %u issue cycles, "
+		   "%u cycles for a single task, %u bank conflicts\n\n",
+		   sProgram.uPathInsts,
+		   sProgram.uPathIssueCycles,
+		   sProgram.uPathLatencyCycles,
+		   sProgram.uPathBankConflicts);
+
+	UsePerfFree(&sProgram);
+
+	return IMG_TRUE;
+}
+
+/*****************************************************************************
+ FUNCTION	: ProcessFile
+
+ PURPOSE	: Estimates every program in a file.
+
+ PARAMETERS	: pszFileName	- Binary or listing.
+
+ RETURNS	: IMG_FALSE on an error.
+*****************************************************************************/
+static IMG_BOOL ProcessFile(const IMG_CHAR *pszFileName)
+{
+	IMG_UINT32		uSize = 0;
+	IMG_CHAR		*pszData = ReadFile(pszFileName, &uSize);
+	INPUT_PROGRAM	sProgram;
+	IMG_BOOL		bSuccess = IMG_TRUE;
+
+	if (!pszData)
+	{
+		fprintf(stderr, "useperf: can't read %s\n", pszFileName);
+		return IMG_FALSE;
+	}
+
+	memset(&sProgram, 0, sizeof(sProgram));
+	snprintf(sProgram.szName, sizeof(sProgram.szName), "%s", pszFileName);
+
+	if (memchr(pszData, '\0', uSize) != IMG_NULL)
+	{
+		const IMG_UINT8	*pui8Data = (const IMG_UINT8 *)pszData;
+		IMG_UINT32		uOffset;
+
+		/*
+			A raw binary: little endian whatever the host.
+		*/
+		for (uOffset = 0; uOffset + 8 <= uSize && bSuccess; uOffset += 8)
+		{
+			IMG_UINT32	uInst0, uInst1;
+
+			uInst0 = (IMG_UINT32)pui8Data[uOffset + 0] |
+					 ((IMG_UINT32)pui8Data[uOffset + 1] << 8) |
+					 ((IMG_UINT32)pui8Data[uOffset + 2] << 16) |
+					 ((IMG_UINT32)pui8Data[uOffset + 3] << 24);
+			uInst1 = (IMG_UINT32)pui8Data[uOffset + 4] |
+					 ((IMG_UINT32)pui8Data[uOffset + 5] << 8) |
+					 ((IMG_UINT32)pui8Data[uOffset + 6] << 16) |
+					 ((IMG_UINT32)pui8Data[uOffset + 7] << 24);
+
+			bSuccess = AddInstruction(&sProgram, uInst0, uInst1);
+		}
+		if (bSuccess)
+		{
+			bSuccess = ReportProgram(&sProgram);
+		}
+	}
+	else
+	{
+		IMG_CHAR	*pszLine = pszData;
+
+		while (pszLine != IMG_NULL && *pszLine != '\0' && bSuccess)
+		{
+			IMG_CHAR	*pszNext = strchr(pszLine, '\n');
+			IMG_UINT32	uInst0, uInst1;
+
+			if (pszNext)
+			{
+				*pszNext++ = '\0';
+			}
+
+			if (strstr(pszLine, "Disassembly") != IMG_NULL)
+			{
+				IMG_UINT32	uLength;
+
+				if (sProgram.uInstCount > 0)
+				{
+					bSuccess = ReportProgram(&sProgram);
+				}
+				sProgram.uInstCount = 0;
+
+				snprintf(sProgram.szName, sizeof(sProgram.szName), "%s: %s", pszFileName, pszLine);
+				uLength = (IMG_UINT32)strlen(sProgram.szName);
+				while (uLength > 0 && isspace((unsigned char)sProgram.szName[uLength - 1]))
+				{
+					sProgram.szName[--uLength] = '\0';
+				}
+			}
+			else if (ParseListingLine(pszLine, &uInst0, &uInst1))
+			{
+				bSuccess = AddInstruction(&sProgram, uInst0, uInst1);
+			}
+
+			pszLine = pszNext;
+		}
+		if (bSuccess && sProgram.uInstCount > 0)
+		{
+			bSuccess = ReportProgram(&sProgram);
+		}
+	}
+
+	free(sProgram.puInsts);
+	free(pszData);
+
+	return bSuccess;
+}
+
+/*****************************************************************************
+ FUNCTION	: ParseNumber
+
+ PURPOSE	: Parses the numeric argument of an option.
+
+ PARAMETERS	: pszArg		- Argument.
+			  puValue		- Returns the value.
+
+ RETURNS	: IMG_FALSE if the argument isn't a number.
+*****************************************************************************/
+static IMG_BOOL ParseNumber(const IMG_CHAR *pszArg, IMG_UINT32 *puValue)
+{
+	IMG_CHAR		*pszEnd;
+	unsigned long	ulValue;
+
+	if (!pszArg)
+	{
+		return IMG_FALSE;
+	}
+	ulValue = strtoul(pszArg, &pszEnd, 0);
+	if (*pszArg == '\0' || *pszEnd != '\0')
+	{
+		return IMG_FALSE;
+	}
+	*puValue = (IMG_UINT32)ulValue;
+	return IMG_TRUE;
+}
+
+int main(int argc, char **argv)
+{
+	SGX_CORE_INFO	sTargetCoreInfo;
+	IMG_UINT32		uNumFiles = 0;
+	IMG_BOOL		bSuccess = IMG_TRUE;
+	int				i;
+
+	sTargetCoreInfo.eID = SGX_CORE_ID_543;
+	sTargetCoreInfo.uiRev = SGX_CORE_REV;
+	psTarget = UseAsmGetCoreDesc(&sTargetCoreInfo);
+	if (!psTarget)
+	{
+		fprintf(stderr, "useperf: no description of the target core\n");
+		return 1;
+	}
+
+	UsePerfInitParams(&sParams);
+
+	for (i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-t") == 0)
+		{
+			if (!ParseNumber(argv[++i], &sParams.uTextureLatency))
+			{
+				Usage();
+				return 1;
+			}
+		}
+		else if (strcmp(argv[i], "-m") == 0)
+		{
+			if (!ParseNumber(argv[++i], &sParams.uMemoryLatency))
+			{
+				Usage();
+				return 1;
+			}
+		}
+		else if (strcmp(argv[i], "-o") == 0)
+		{
+			if (!ParseNumber(argv[++i], &sParams.uCodeOffset))
+			{
+				Usage();
+				return 1;
+			}
+		}
+		else if (strcmp(argv[i], "-v") == 0)
+		{
+			bVerbose = IMG_TRUE;
+		}
+		else if (argv[i][0] == '-')
+		{
+			Usage();
+			return 1;
+		}
+		else
+		{
+			uNumFiles++;
+		}
+	}
+
+	if (uNumFiles == 0)
+	{
+		Usage();
+		return 1;
+	}
+
+	/*
+		The options apply to every file, wherever they are on the command line.
+	*/
+	for (i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-t") == 0 || strcmp(argv[i], "-m") == 0 || strcmp(argv[i], "-o") == 0)
+		{
+			i++;
+		}
+		else if (argv[i][0] != '-' && !ProcessFile(argv[i]))
+		{
+			bSuccess = IMG_FALSE;
+		}
+	}
+
+	return bSuccess ? 0 : 1;
+}
+
+/******************************************************************************
+ End of file (main.c)
+******************************************************************************/
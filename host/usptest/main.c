@@ -0,0 +1,737 @@
+/******************************************************************************
+ * Name         : main.c
+ * Title        : USP finalised-shader cache test
+ *
+ * Copyright    : 2006-2010 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means,electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Description  : Drives the USP directly with recorded precompiled shaders
+ *                (USP_PC_SHADER blobs, as passed to PVRUniPatchCreateShader
+ *                by the driver) and checks the finalised-shader cache.
+ *
+ *                Every shader is finalised with a set of patch settings in
+ *                three USP contexts:
+ *
+ *                - twice in the first context, where the second finalisation
+ *                  must return the shared HW shader from the first;
+ *                - in a second context, whose (independently finalised)
+ *                  HW shaders must serialise to exactly the same data;
+ *                - in a third context preloaded with the serialised cache of
+ *                  the first, where every finalisation must be a cache hit.
+ *
+ *                With -o the serialised cache is also written to a file, and
+ *                with -b finalisation is timed with and without the cache.
+ *
+ *                A directory on the command line stands for all the .usp
+ *                files in it. Without shaders the tool reads the corpus
+ *                directory (USPTEST_CORPUS), which holds the USP input of
+ *                every shader in host/glslcsgx/corpus as written by
+ *                glslc-sgx for SGX543. Regenerate it with
+ *
+ *                  glslc-sgx -o <dir> host/glslcsgx/corpus
+ *
+ *                and copy the .usp files from <dir> when USP_PC_SHADER_VER
+ *                or the compiler's output changes.
+ *
+ * Modifications:-
+ * $Log: main.c $
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <time.h>
+#include <errno.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#endif
+
+#include "img_types.h"
+#include "sgxdefs.h"
+#include "usp.h"
+
+#define MAX_SHADERS		256
+
+/* Relative to the working directory, which is host/usptest when run from Visual Studio */
+#if !defined(USPTEST_CORPUS)
+#define USPTEST_CORPUS	"corpus"
+#endif
+
+typedef struct _PATCH_CONFIG_
+{
+	USP_OUTPUT_REGTYPE	eOutputRegType;
+	IMG_UINT32			uPreambleInstCount;
+	USP_TEXTURE_FORMAT	eTexFmt;
+	IMG_BOOL			bNormCoords;
+} PATCH_CONFIG, *PPATCH_CONFIG;
+
+static const PATCH_CONFIG asPatchConfigs[] =
+{
+	{USP_OUTPUT_REGTYPE_DEFAULT,	0,	USP_TEXTURE_FORMAT_R8G8B8A8,	IMG_TRUE},
+	{USP_OUTPUT_REGTYPE_DEFAULT,	1,	USP_TEXTURE_FORMAT_R8G8B8A8,	IMG_TRUE},
+	{USP_OUTPUT_REGTYPE_OUTPUT,		0,	USP_TEXTURE_FORMAT_R8G8B8A8,	IMG_TRUE},
+	{USP_OUTPUT_REGTYPE_DEFAULT,	0,	USP_TEXTURE_FORMAT_R5G6B5,		IMG_TRUE},
+	{USP_OUTPUT_REGTYPE_DEFAULT,	0,	USP_TEXTURE_FORMAT_R8G8B8A8,	IMG_FALSE},
+};
+
+#define PATCH_CONFIG_COUNT	(sizeof(asPatchConfigs) / sizeof(asPatchConfigs[0]))
+
+typedef struct _SHADER_
+{
+	const IMG_CHAR	*pszFileName;
+	PUSP_PC_SHADER	psPCShader;
+	PUSP_HW_SHADER	apsHWShaders[PATCH_CONFIG_COUNT];
+} SHADER, *PSHADER;
+
+static SHADER asShaders[MAX_SHADERS];
+
+/*****************************************************************************
+ FUNCTION	: Usage
+
+ PURPOSE	: Prints the command line options.
+
+ PARAMETERS	: None.
+
+ RETURNS	: Nothing.
+*****************************************************************************/
+static IMG_VOID Usage(IMG_VOID)
+{
+	fprintf(stderr, "Usage: usptest [-v] [-o <cache>] [-b <iterations>] [<shader|dir> ...]\n");
+	fprintf(stderr, "\n");
+	fprintf(stderr, "  Finalises each recorded USP_PC shader and checks the HW shader cache.\n");
+	fprintf(stderr, "  Without shaders the .usp files in %s are used.\n", USPTEST_CORPUS);
+	fprintf(stderr, "\n");
+	fprintf(stderr, "  -v               Print USP debug output.\n");
+	fprintf(stderr, "  -o <cache>       Write the serialised cache to <cache>.\n");
+	fprintf(stderr, "  -b <iterations>  Also time finalisation over <iterations> runs.\n");
+}
+
+static IMG_BOOL bVerbose = IMG_FALSE;
+
+static IMG_PVOID IMG_CALLCONV TestAlloc(IMG_UINT32 uSize)
+{
+	return malloc(uSize);
+}
+
+static IMG_VOID IMG_CALLCONV TestFree(IMG_PVOID pvData)
+{
+	free(pvData);
+}
+
+static IMG_VOID IMG_CALLCONV TestPrint(const IMG_CHAR *pszFormat, ...)
+{
+	va_list sArgs;
+
+	if (bVerbose)
+	{
+		va_start(sArgs, pszFormat);
+		vfprintf(stderr, pszFormat, sArgs);
+		va_end(sArgs);
+	}
+}
+
+/*****************************************************************************
+ FUNCTION	: ReadFile
+
+ PURPOSE	: Reads a whole file into memory.
+
+ PARAMETERS	: pszFileName	- File to read.
+			  puSize		- Returns the size of the file.
+
+ RETURNS	: The contents, or IMG_NULL.
+*****************************************************************************/
+static IMG_PVOID ReadFile(const IMG_CHAR *pszFileName, IMG_UINT32 *puSize)
+{
+	FILE		*psFile = fopen(pszFileName, "rb");
+	IMG_PVOID	pvBuffer;
+	long		lSize;
+
+	if (!psFile)
+	{
+		return IMG_NULL;
+	}
+
+	fseek(psFile, 0, SEEK_END);
+	lSize = ftell(psFile);
+	fseek(psFile, 0, SEEK_SET);
+
+	pvBuffer = (lSize > 0) ? malloc((size_t)lSize) : IMG_NULL;
+
+	if (pvBuffer && fread(pvBuffer, 1, (size_t)lSize, psFile) != (size_t)lSize)
+	{
+		free(pvBuffer);
+		pvBuffer = IMG_NULL;
+	}
+
+	fclose(psFile);
+
+	if (pvBuffer)
+	{
+		*puSize = (IMG_UINT32)lSize;
+	}
+
+	return pvBuffer;
+}
+
+/*****************************************************************************
+ FUNCTION	: LoadPCShader
+
+ PURPOSE	: Reads a recorded precompiled shader and checks its header.
+
+ PARAMETERS	: pszFileName	- File to read.
+
+ RETURNS	: The precompiled shader, or IMG_NULL.
+*****************************************************************************/
+static PUSP_PC_SHADER LoadPCShader(const IMG_CHAR *pszFileName)
+{
+	PUSP_PC_SHADER	psPCShader;
+	IMG_UINT32		uSize = 0;
+
+	psPCShader = (PUSP_PC_SHADER)ReadFile(pszFileName, &uSize);
+	if (!psPCShader)
+	{
+		fprintf(stderr, "%s: can't read shader\n", pszFileName);
+		return IMG_NULL;
+	}
+
+	if (uSize < sizeof(USP_PC_SHADER) ||
+		psPCShader->uId != USP_PC_SHADER_ID ||
+		psPCShader->uVersion != USP_PC_SHADER_VER ||
+		psPCShader->uSize > uSize - sizeof(USP_PC_SHADER))
+	{
+		fprintf(stderr, "%s: not a version %08X USP_PC shader\n", pszFileName, USP_PC_SHADER_VER);
+		free(psPCShader);
+		return IMG_NULL;
+	}
+
+	return psPCShader;
+}
+
+/*****************************************************************************
+ FUNCTION	: AddShader
+
+ PURPOSE	: Loads a recorded precompiled shader into asShaders.
+
+ PARAMETERS	: pszDir		- Directory of the shader, or IMG_NULL.
+			  pszName		- Shader file name.
+			  puNumShaders	- Number of shaders loaded so far.
+
+ RETURNS	: IMG_FALSE if the shader couldn't be loaded.
+*****************************************************************************/
+static IMG_BOOL AddShader(const IMG_CHAR *pszDir, const IMG_CHAR *pszName, IMG_UINT32 *puNumShaders)
+{
+	size_t			uLength = strlen(pszName) + (pszDir ? strlen(pszDir) + 1 : 0) + 1;
+	IMG_CHAR		*pszPath;
+	PUSP_PC_SHADER	psPCShader;
+
+	if (*puNumShaders == MAX_SHADERS || (pszPath = malloc(uLength)) == IMG_NULL)
+	{
+		fprintf(stderr, "Too many shaders\n");
+		return IMG_FALSE;
+	}
+
+	if (pszDir)
+	{
+		sprintf(pszPath, "%s/%s", pszDir, pszName);
+	}
+	else
+	{
+		strcpy(pszPath, pszName);
+	}
+
+	psPCShader = LoadPCShader(pszPath);
+	if (!psPCShader)
+	{
+		free(pszPath);
+		return IMG_FALSE;
+	}
+
+	asShaders[*puNumShaders].pszFileName	= pszPath;
+	asShaders[*puNumShaders].psPCShader		= psPCShader;
+	(*puNumShaders)++;
+
+	return IMG_TRUE;
+}
+
+static IMG_BOOL IsShaderName(const IMG_CHAR *pszName)
+{
+	size_t uLength = strlen(pszName);
+
+	return (uLength > 4 && strcmp(&pszName[uLength - 4], ".usp") == 0) ? IMG_TRUE : IMG_FALSE;
+}
+
+static int CompareNames(const void *pvA, const void *pvB)
+{
+	return strcmp(*(IMG_CHAR * const *)pvA, *(IMG_CHAR * const *)pvB);
+}
+
+/*****************************************************************************
+ FUNCTION	: AddShaders
+
+ PURPOSE	: Loads a recorded precompiled shader, or all the .usp files in a
+			  directory in name order, into asShaders.
+
+ PARAMETERS	: pszPath		- Shader or directory.
+			  puNumShaders	- Number of shaders loaded so far.
+			  puNumFailed	- Incremented for each shader that couldn't be
+							  loaded.
+
+ RETURNS	: IMG_FALSE if the directory couldn't be read.
+*****************************************************************************/
+static IMG_BOOL AddShaders(const IMG_CHAR *pszPath, IMG_UINT32 *puNumShaders, IMG_UINT32 *puNumFailed)
+{
+	IMG_CHAR	*apszNames[MAX_SHADERS];
+	IMG_UINT32	uNumNames = 0;
+	IMG_UINT32	i;
+#if defined(_WIN32)
+	WIN32_FIND_DATAA	sFindData;
+	HANDLE				hFind;
+	IMG_CHAR			szPattern[MAX_PATH];
+	DWORD				dwAttributes = GetFileAttributesA(pszPath);
+
+	if (dwAttributes == INVALID_FILE_ATTRIBUTES || !(dwAttributes & FILE_ATTRIBUTE_DIRECTORY))
+	{
+		*puNumFailed += AddShader(IMG_NULL, pszPath, puNumShaders) ? 0 : 1;
+		return IMG_TRUE;
+	}
+
+	_snprintf(szPattern, sizeof(szPattern), "%s/*.usp", pszPath);
+
+	hFind = FindFirstFileA(szPattern, &sFindData);
+	if (hFind != INVALID_HANDLE_VALUE)
+	{
+		do
+		{
+			if (!(sFindData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) &&
+				IsShaderName(sFindData.cFileName) && uNumNames < MAX_SHADERS)
+			{
+				apszNames[uNumNames] = _strdup(sFindData.cFileName);
+				uNumNames += apszNames[uNumNames] ? 1 : 0;
+			}
+		} while (FindNextFileA(hFind, &sFindData));
+
+		FindClose(hFind);
+	}
+#else
+	struct stat		sStat;
+	DIR				*psDir;
+	struct dirent	*psEntry;
+
+	if (stat(pszPath, &sStat) != 0 || !S_ISDIR(sStat.st_mode))
+	{
+		*puNumFailed += AddShader(IMG_NULL, pszPath, puNumShaders) ? 0 : 1;
+		return IMG_TRUE;
+	}
+
+	psDir = opendir(pszPath);
+	if (!psDir)
+	{
+		fprintf(stderr, "%s: %s\n", pszPath, strerror(errno));
+		return IMG_FALSE;
+	}
+
+	while ((psEntry = readdir(psDir)) != IMG_NULL)
+	{
+		if (psEntry->d_name[0] != '.' && IsShaderName(psEntry->d_name) && uNumNames < MAX_SHADERS)
+		{
+			apszNames[uNumNames] = strdup(psEntry->d_name);
+			uNumNames += apszNames[uNumNames] ? 1 : 0;
+		}
+	}
+
+	closedir(psDir);
+#endif
+
+	/* Directory order differs between hosts; the serialised cache must not */
+	qsort(apszNames, uNumNames, sizeof(apszNames[0]), CompareNames);
+
+	for (i = 0; i < uNumNames; i++)
+	{
+		*puNumFailed += AddShader(pszPath, apszNames[i], puNumShaders) ? 0 : 1;
+		free(apszNames[i]);
+	}
+
+	if (!uNumNames)
+	{
+		fprintf(stderr, "%s: no .usp files\n", pszPath);
+		return IMG_FALSE;
+	}
+
+	return IMG_TRUE;
+}
+
+/*****************************************************************************
+ FUNCTION	: ApplyPatchConfig
+
+ PURPOSE	: Sets up the patch state of a USP context.
+
+ PARAMETERS	: pvContext	- USP context.
+			  psConfig	- Patch settings to apply.
+
+ RETURNS	: Nothing.
+*****************************************************************************/
+static IMG_VOID ApplyPatchConfig(IMG_PVOID pvContext, const PATCH_CONFIG *psConfig)
+{
+	USP_TEX_FORMAT	sFormat;
+	IMG_UINT16		uSampler;
+
+	sFormat.eTexFmt				= psConfig->eTexFmt;
+	sFormat.aeChanSwizzle[0]	= USP_CHAN_SWIZZLE_CHAN_0;
+	sFormat.aeChanSwizzle[1]	= USP_CHAN_SWIZZLE_CHAN_1;
+	sFormat.aeChanSwizzle[2]	= USP_CHAN_SWIZZLE_CHAN_2;
+	sFormat.aeChanSwizzle[3]	= USP_CHAN_SWIZZLE_CHAN_3;
+
+	for (uSampler = 0; uSampler < USP_MAX_SAMPLER_IDX; uSampler++)
+	{
+		PVRUniPatchSetTextureFormat(pvContext, uSampler, &sFormat, IMG_FALSE, IMG_FALSE);
+		PVRUniPatchSetNormalizedCoords(pvContext, uSampler, psConfig->bNormCoords, IMG_TRUE, 64, 64);
+	}
+
+	PVRUniPatchSetOutputLocation(pvContext, psConfig->eOutputRegType);
+	PVRUniPatchSetPreambleInstCount(pvContext, psConfig->uPreambleInstCount);
+}
+
+/*****************************************************************************
+ FUNCTION	: FinaliseShaders
+
+ PURPOSE	: Finalises every shader with every patch configuration.
+
+ PARAMETERS	: pvContext		- USP context to use.
+			  uNumShaders	- Number of shaders.
+			  apsHWShaders	- Returns the HW shaders, indexed by
+							  shader * PATCH_CONFIG_COUNT + configuration.
+
+ RETURNS	: IMG_FALSE if a shader couldn't be created.
+*****************************************************************************/
+static IMG_BOOL FinaliseShaders(IMG_PVOID		pvContext,
+								IMG_UINT32		uNumShaders,
+								PUSP_HW_SHADER	*apsHWShaders)
+{
+	IMG_UINT32 i, j;
+
+	for (i = 0; i < uNumShaders; i++)
+	{
+		IMG_PVOID pvShader = PVRUniPatchCreateShader(pvContext, asShaders[i].psPCShader);
+
+		if (!pvShader)
+		{
+			fprintf(stderr, "%s: PVRUniPatchCreateShader failed\n", asShaders[i].pszFileName);
+			return IMG_FALSE;
+		}
+
+		for (j = 0; j < PATCH_CONFIG_COUNT; j++)
+		{
+			ApplyPatchConfig(pvContext, &asPatchConfigs[j]);
+
+			apsHWShaders[i * PATCH_CONFIG_COUNT + j] = PVRUniPatchFinaliseShader(pvContext, pvShader);
+		}
+
+		PVRUniPatchDestroyShader(pvContext, pvShader);
+	}
+
+	return IMG_TRUE;
+}
+
+/*****************************************************************************
+ FUNCTION	: ReleaseShaders
+
+ PURPOSE	: Releases HW shaders returned by FinaliseShaders.
+
+ PARAMETERS	: pvContext		- USP context to use.
+			  uNumShaders	- Number of shaders.
+			  apsHWShaders	- The HW shaders.
+
+ RETURNS	: Nothing.
+*****************************************************************************/
+static IMG_VOID ReleaseShaders(IMG_PVOID		pvContext,
+							   IMG_UINT32		uNumShaders,
+							   PUSP_HW_SHADER	*apsHWShaders)
+{
+	IMG_UINT32 i;
+
+	for (i = 0; i < uNumShaders * PATCH_CONFIG_COUNT; i++)
+	{
+		PVRUniPatchDestroyHWShader(pvContext, apsHWShaders[i]);
+		apsHWShaders[i] = IMG_NULL;
+	}
+}
+
+/*****************************************************************************
+ FUNCTION	: SerialiseCache
+
+ PURPOSE	: Serialises the cache of a USP context.
+
+ PARAMETERS	: pvContext	- USP context.
+			  puSize	- Returns the size of the data.
+
+ RETURNS	: The serialised data, or IMG_NULL.
+*****************************************************************************/
+static IMG_PVOID SerialiseCache(IMG_PVOID pvContext, IMG_UINT32 *puSize)
+{
+	IMG_UINT32	uSize;
+	IMG_PVOID	pvData;
+
+	uSize = PVRUniPatchSerialiseCache(pvContext, IMG_NULL, 0);
+	if (!uSize)
+	{
+		return IMG_NULL;
+	}
+
+	pvData = malloc(uSize);
+	if (pvData && PVRUniPatchSerialiseCache(pvContext, pvData, uSize) != uSize)
+	{
+		free(pvData);
+		pvData = IMG_NULL;
+	}
+
+	*puSize = uSize;
+	return pvData;
+}
+
+/*****************************************************************************
+ FUNCTION	: TimeFinalise
+
+ PURPOSE	: Times finalising every shader with every configuration.
+
+ PARAMETERS	: uNumShaders	- Number of shaders.
+			  uIterations	- Number of runs.
+			  pvCacheData	- Serialised cache to preload, or IMG_NULL.
+			  uCacheSize	- Size of the serialised cache.
+
+ RETURNS	: The time taken in seconds.
+*****************************************************************************/
+static double TimeFinalise(IMG_UINT32 uNumShaders, IMG_UINT32 uIterations, IMG_PVOID pvCacheData, IMG_UINT32 uCacheSize)
+{
+	static PUSP_HW_SHADER	apsHWShaders[MAX_SHADERS * PATCH_CONFIG_COUNT];
+	clock_t					sStart;
+	IMG_UINT32				i;
+
+	sStart = clock();
+
+	for (i = 0; i < uIterations; i++)
+	{
+		IMG_PVOID pvContext = PVRUniPatchCreateContext(TestAlloc, TestFree, TestPrint);
+
+		if (!pvContext)
+		{
+			break;
+		}
+
+		if (pvCacheData)
+		{
+			PVRUniPatchLoadCache(pvContext, pvCacheData, uCacheSize);
+		}
+
+		FinaliseShaders(pvContext, uNumShaders, apsHWShaders);
+		ReleaseShaders(pvContext, uNumShaders, apsHWShaders);
+
+		PVRUniPatchDestroyContext(pvContext);
+	}
+
+	return (double)(clock() - sStart) / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char **argv)
+{
+	static PUSP_HW_SHADER	apsFirst[MAX_SHADERS * PATCH_CONFIG_COUNT];
+	static PUSP_HW_SHADER	apsSecond[MAX_SHADERS * PATCH_CONFIG_COUNT];
+	static PUSP_HW_SHADER	apsOther[MAX_SHADERS * PATCH_CONFIG_COUNT];
+	const IMG_CHAR			*pszCacheFile	= IMG_NULL;
+	IMG_UINT32				uIterations		= 0;
+	IMG_UINT32				uNumShaders		= 0;
+	IMG_UINT32				uNumFailed		= 0;
+	IMG_UINT32				uNumFinalised	= 0;
+	IMG_PVOID				pvContext, pvOtherContext;
+	IMG_PVOID				pvCache = IMG_NULL, pvOtherCache = IMG_NULL;
+	IMG_UINT32				uCacheSize = 0, uOtherCacheSize = 0;
+	IMG_UINT32				i, j;
+	int						iArg;
+
+	for (iArg = 1; iArg < argc && argv[iArg][0] == '-'; iArg++)
+	{
+		if (strcmp(argv[iArg], "-v") == 0)
+		{
+			bVerbose = IMG_TRUE;
+		}
+		else if (strcmp(argv[iArg], "-o") == 0 && iArg + 1 < argc)
+		{
+			pszCacheFile = argv[++iArg];
+		}
+		else if (strcmp(argv[iArg], "-b") == 0 && iArg + 1 < argc)
+		{
+			uIterations = (IMG_UINT32)strtoul(argv[++iArg], IMG_NULL, 0);
+		}
+		else
+		{
+			Usage();
+			return 1;
+		}
+	}
+
+	if (iArg == argc)
+	{
+		if (!AddShaders(USPTEST_CORPUS, &uNumShaders, &uNumFailed))
+		{
+			Usage();
+			return 1;
+		}
+	}
+
+	for (; iArg < argc; iArg++)
+	{
+		if (!AddShaders(argv[iArg], &uNumShaders, &uNumFailed))
+		{
+			return 1;
+		}
+	}
+
+	if (!uNumShaders)
+	{
+		return 1;
+	}
+
+	/*
+		Finalise everything twice in one context: the second pass must share
+		the HW shaders of the first.
+	*/
+	pvContext = PVRUniPatchCreateContext(TestAlloc, TestFree, TestPrint);
+	if (!pvContext ||
+		!FinaliseShaders(pvContext, uNumShaders, apsFirst) ||
+		!FinaliseShaders(pvContext, uNumShaders, apsSecond))
+	{
+		fprintf(stderr, "USP context setup failed\n");
+		return 1;
+	}
+
+	for (i = 0; i < uNumShaders; i++)
+	{
+		IMG_BOOL bFailed = IMG_FALSE;
+
+		for (j = 0; j < PATCH_CONFIG_COUNT; j++)
+		{
+			IMG_UINT32 uIdx = i * PATCH_CONFIG_COUNT + j;
+
+			if (apsFirst[uIdx])
+			{
+				uNumFinalised++;
+			}
+
+			if (apsFirst[uIdx] != apsSecond[uIdx])
+			{
+				fprintf(stderr, "%s: configuration %u was not shared on the second finalisation\n", asShaders[i].pszFileName, j);
+				bFailed = IMG_TRUE;
+			}
+		}
+
+		if (bFailed)
+		{
+			uNumFailed++;
+		}
+	}
+	ReleaseShaders(pvContext, uNumShaders, apsSecond);
+
+	/*
+		Finalising in a fresh context must give the same HW shaders, down to
+		the serialised bytes.
+	*/
+	pvCache = SerialiseCache(pvContext, &uCacheSize);
+
+	pvOtherContext = PVRUniPatchCreateContext(TestAlloc, TestFree, TestPrint);
+	if (!pvCache || !pvOtherContext || !FinaliseShaders(pvOtherContext, uNumShaders, apsOther))
+	{
+		fprintf(stderr, "Cache serialisation failed\n");
+		return 1;
+	}
+
+	pvOtherCache = SerialiseCache(pvOtherContext, &uOtherCacheSize);
+	if (!pvOtherCache || uOtherCacheSize != uCacheSize || memcmp(pvOtherCache, pvCache, uCacheSize) != 0)
+	{
+		fprintf(stderr, "HW shaders differ between USP contexts\n");
+		uNumFailed++;
+	}
+	free(pvOtherCache);
+
+	/*
+		Destroying a context must leave its referenced HW shaders usable
+		through another context.
+	*/
+	ReleaseShaders(pvOtherContext, uNumShaders, apsOther);
+	PVRUniPatchDestroyContext(pvContext);
+	ReleaseShaders(pvOtherContext, uNumShaders, apsFirst);
+	PVRUniPatchDestroyContext(pvOtherContext);
+
+	/*
+		A context preloaded with the serialised cache must not finalise
+		anything again.
+	*/
+	pvContext = PVRUniPatchCreateContext(TestAlloc, TestFree, TestPrint);
+	if (!pvContext || !PVRUniPatchLoadCache(pvContext, pvCache, uCacheSize))
+	{
+		fprintf(stderr, "Serialised cache was rejected\n");
+		return 1;
+	}
+
+	FinaliseShaders(pvContext, uNumShaders, apsOther);
+
+	pvOtherCache = SerialiseCache(pvContext, &uOtherCacheSize);
+	if (!pvOtherCache || uOtherCacheSize != uCacheSize || memcmp(pvOtherCache, pvCache, uCacheSize) != 0)
+	{
+		fprintf(stderr, "Preloaded cache was not used\n");
+		uNumFailed++;
+	}
+	free(pvOtherCache);
+
+	ReleaseShaders(pvContext, uNumShaders, apsOther);
+	PVRUniPatchDestroyContext(pvContext);
+
+	if (pszCacheFile)
+	{
+		FILE *psFile = fopen(pszCacheFile, "wb");
+
+		if (!psFile || fwrite(pvCache, 1, uCacheSize, psFile) != uCacheSize)
+		{
+			fprintf(stderr, "%s: can't write cache\n", pszCacheFile);
+			uNumFailed++;
+		}
+
+		if (psFile)
+		{
+			fclose(psFile);
+		}
+	}
+
+	if (uIterations)
+	{
+		double dCold = TimeFinalise(uNumShaders, uIterations, IMG_NULL, 0);
+		double dWarm = TimeFinalise(uNumShaders, uIterations, pvCache, uCacheSize);
+
+		printf("Finalise: %.3f ms per run, %.3f ms per run with a preloaded cache\n",
+			   dCold * 1000.0 / uIterations, dWarm * 1000.0 / uIterations);
+	}
+
+	free(pvCache);
+
+	for (i = 0; i < uNumShaders; i++)
+	{
+		free(asShaders[i].psPCShader);
+		free((IMG_PVOID)asShaders[i].pszFileName);
+	}
+
+	printf("%u HW shaders finalised from %u shaders, %u failures\n", uNumFinalised, uNumShaders, uNumFailed);
+
+	return uNumFailed ? 1 : 0;
+}
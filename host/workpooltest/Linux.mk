@@ -0,0 +1,27 @@
+# Copyright	2010 Imagination Technologies Limited. All rights reserved.
+#
+# No part of this software, either material or conceptual may be
+# copied or distributed, transmitted, transcribed, stored in a
+# retrieval system or translated into any human or computer
+# language in any form by any means, electronic, mechanical,
+# manual or other-wise, or disclosed to third parties without
+# the express written permission of: Imagination Technologies
+# Limited, HomePark Industrial Estate, Kings Langley,
+# Hertfordshire, WD4 8LZ, UK
+#
+# $Log: Linux.mk $
+#
+
+modules := workpooltest
+
+workpooltest_type := host_executable
+
+workpooltest_target := workpooltest
+
+workpooltest_src = \
+ main.c \
+ $(TOP)/eurasiacon/common/workpool.c
+
+workpooltest_includes := include4 eurasiacon/common host/include
+
+workpooltest_extlibs := pthread
@@ -0,0 +1,559 @@
+/******************************************************************************
+ * Name         : main.c
+ * Title        : Work pool tests and benchmark (workpooltest)
+ *
+ * Copyright    : 2010 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means,electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Description  : Runs eurasiacon/common/workpool.c on the host with its
+ *                POSIX threads backend.
+ *
+ *                Without options the tool checks that every job runs once,
+ *                that WorkPoolWait covers the jobs submitted before the
+ *                token, that a full pool makes WorkPoolSubmit run or wait
+ *                for jobs instead of failing, that idle workers steal from
+ *                busy ones, that WorkPoolInJob tells jobs apart from their
+ *                submitter and that WorkPoolDestroy runs the jobs still
+ *                queued. It exits with a non-zero status if a check fails.
+ *
+ *                With -b it times a stream of software texture upload
+ *                sized jobs (a copy of -s bytes each) run by the pool
+ *                against the same jobs run by a new thread each, the way
+ *                the OpenGL ES driver used to start one ULT per operation.
+ *
+ * Modifications:-
+ * $Log: main.c $
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "img_types.h"
+#include "img_defs.h"
+#include "workpool.h"
+#include "hosttest.h"
+
+typedef struct _TEST_JOB_
+{
+	IMG_UINT32			ui32Index;
+	IMG_UINT32			ui32SleepUs;
+	volatile IMG_UINT32	*pui32RunCount;
+} TEST_JOB;
+
+typedef struct _IN_JOB_JOB_
+{
+	WORKPOOL			*psPool;
+	volatile IMG_UINT32	*pui32Ran;
+	volatile IMG_UINT32	*pui32NotInJob;
+} IN_JOB_JOB;
+
+typedef struct _COPY_JOB_
+{
+	IMG_UINT8			*pui8Dst;
+	const IMG_UINT8		*pui8Src;
+	IMG_UINT32			ui32Size;
+} COPY_JOB;
+
+
+static IMG_DOUBLE GetTimeMs(IMG_VOID)
+{
+	struct timespec sTime;
+
+	clock_gettime(CLOCK_MONOTONIC, &sTime);
+
+	return (IMG_DOUBLE)sTime.tv_sec * 1000.0 + (IMG_DOUBLE)sTime.tv_nsec / 1000000.0;
+}
+
+static IMG_VOID SleepUs(IMG_UINT32 ui32Us)
+{
+	struct timespec sTime;
+
+	sTime.tv_sec = ui32Us / 1000000;
+	sTime.tv_nsec = (long)(ui32Us % 1000000) * 1000;
+
+	nanosleep(&sTime, IMG_NULL);
+}
+
+static IMG_VOID TestJob(IMG_VOID *pvData)
+{
+	TEST_JOB *psJob = (TEST_JOB *)pvData;
+
+	if (psJob->ui32SleepUs)
+	{
+		SleepUs(psJob->ui32SleepUs);
+	}
+
+	__sync_fetch_and_add(&psJob->pui32RunCount[psJob->ui32Index], 1);
+}
+
+static IMG_VOID InJobJob(IMG_VOID *pvData)
+{
+	IN_JOB_JOB *psJob = (IN_JOB_JOB *)pvData;
+
+	SleepUs(200);
+
+	if (!WorkPoolInJob(psJob->psPool))
+	{
+		__sync_fetch_and_add(psJob->pui32NotInJob, 1);
+	}
+
+	__sync_fetch_and_add(psJob->pui32Ran, 1);
+}
+
+static IMG_VOID CopyJob(IMG_VOID *pvData)
+{
+	COPY_JOB *psJob = (COPY_JOB *)pvData;
+
+	memcpy(psJob->pui8Dst, psJob->pui8Src, psJob->ui32Size);
+}
+
+static WORKPOOL *CreatePool(IMG_UINT32 ui32NumWorkers, IMG_UINT32 ui32MaxJobs, IMG_UINT32 ui32DataSize)
+{
+	WORKPOOL_CONFIG sConfig;
+
+	memset(&sConfig, 0, sizeof(sConfig));
+	sConfig.pszName = "workpooltest";
+	sConfig.ui32NumWorkers = ui32NumWorkers;
+	sConfig.ui32MaxJobs = ui32MaxJobs;
+	sConfig.ui32MaxJobDataSize = ui32DataSize;
+
+	return WorkPoolCreate(&sConfig);
+}
+
+static WORKPOOL_TOKEN SubmitTestJob(WORKPOOL *psPool, volatile IMG_UINT32 *pui32RunCount, IMG_UINT32 ui32Index, IMG_UINT32 ui32SleepUs)
+{
+	TEST_JOB sJob;
+
+	sJob.ui32Index = ui32Index;
+	sJob.ui32SleepUs = ui32SleepUs;
+	sJob.pui32RunCount = pui32RunCount;
+
+	return WorkPoolSubmit(psPool, TestJob, &sJob, sizeof(sJob));
+}
+
+/*
+	Every job runs exactly once whatever the pool size.
+*/
+static IMG_VOID TestRunOnce(IMG_VOID)
+{
+	static const IMG_UINT32 aui32Workers[] = {1, 2, 4, 8};
+	const IMG_UINT32 ui32NumJobs = 20000;
+	volatile IMG_UINT32 *pui32RunCount = calloc(ui32NumJobs, sizeof(IMG_UINT32));
+	IMG_UINT32 i, j;
+
+	for (j = 0; j < sizeof(aui32Workers) / sizeof(aui32Workers[0]); j++)
+	{
+		WORKPOOL *psPool = CreatePool(aui32Workers[j], 64, sizeof(TEST_JOB));
+		WORKPOOL_TOKEN hLast = WORKPOOL_NO_TOKEN;
+		IMG_BOOL bOnce = IMG_TRUE;
+
+		Check(psPool != IMG_NULL, "run-once", "WorkPoolCreate failed");
+		if (!psPool)
+		{
+			continue;
+		}
+
+		memset((IMG_VOID *)pui32RunCount, 0, ui32NumJobs * sizeof(IMG_UINT32));
+
+		for (i = 0; i < ui32NumJobs; i++)
+		{
+			hLast = SubmitTestJob(psPool, pui32RunCount, i, 0);
+		}
+
+		WorkPoolWait(psPool, hLast, IMG_TRUE);
+
+		for (i = 0; i < ui32NumJobs; i++)
+		{
+			bOnce &= (pui32RunCount[i] == 1) ? IMG_TRUE : IMG_FALSE;
+		}
+
+		Check(bOnce, "run-once", "a job didn't run exactly once");
+		Check(WorkPoolIsComplete(psPool, hLast), "run-once", "last token not complete after waiting for it");
+
+		WorkPoolDestroy(psPool);
+	}
+
+	free((IMG_VOID *)pui32RunCount);
+}
+
+/*
+	Waiting for a token waits for it and for every job submitted before it,
+	but not for later ones.
+*/
+static IMG_VOID TestWaitOrder(IMG_VOID)
+{
+	volatile IMG_UINT32 aui32RunCount[3] = {0, 0, 0};
+	WORKPOOL *psPool = CreatePool(2, 8, sizeof(TEST_JOB));
+	WORKPOOL_TOKEN hSlow, hFast, hLater;
+
+	if (!psPool)
+	{
+		Check(IMG_FALSE, "wait-order", "WorkPoolCreate failed");
+		return;
+	}
+
+	hSlow = SubmitTestJob(psPool, aui32RunCount, 0, 50000);
+	hFast = SubmitTestJob(psPool, aui32RunCount, 1, 0);
+
+	Check(WorkPoolLaterToken(hSlow, hFast) == hFast, "wait-order", "WorkPoolLaterToken picked the earlier token");
+	Check(WorkPoolLaterToken(WORKPOOL_NO_TOKEN, hSlow) == hSlow, "wait-order", "WorkPoolLaterToken with no token");
+
+	WorkPoolWait(psPool, hFast, IMG_FALSE);
+
+	Check(aui32RunCount[0] == 1 && aui32RunCount[1] == 1, "wait-order", "earlier job not finished after waiting for a later token");
+
+	hLater = SubmitTestJob(psPool, aui32RunCount, 2, 50000);
+
+	Check(WorkPoolIsComplete(psPool, hFast), "wait-order", "finished token reported as pending");
+	Check(!WorkPoolIsComplete(psPool, hLater), "wait-order", "pending token reported as complete");
+	Check(WorkPoolLastToken(psPool) == hLater, "wait-order", "WorkPoolLastToken isn't the last submission");
+	Check(WorkPoolIsComplete(psPool, WORKPOOL_NO_TOKEN), "wait-order", "WORKPOOL_NO_TOKEN not complete");
+
+	WorkPoolWait(psPool, hLater, IMG_TRUE);
+
+	Check(aui32RunCount[2] == 1, "wait-order", "job not finished after waiting for its token");
+
+	WorkPoolDestroy(psPool);
+}
+
+/*
+	With every slot taken by a slow job, submitting more stalls (running jobs
+	on the caller) instead of failing.
+*/
+static IMG_VOID TestBackPressure(IMG_VOID)
+{
+	const IMG_UINT32 ui32NumJobs = 200;
+	volatile IMG_UINT32 *pui32RunCount = calloc(ui32NumJobs, sizeof(IMG_UINT32));
+	WORKPOOL *psPool = CreatePool(1, 4, sizeof(TEST_JOB));
+	WORKPOOL_STATS sStats;
+	WORKPOOL_TOKEN hLast = WORKPOOL_NO_TOKEN;
+	IMG_UINT32 i, ui32Ran = 0;
+
+	if (!psPool)
+	{
+		Check(IMG_FALSE, "back-pressure", "WorkPoolCreate failed");
+		free((IMG_VOID *)pui32RunCount);
+		return;
+	}
+
+	for (i = 0; i < ui32NumJobs; i++)
+	{
+		hLast = SubmitTestJob(psPool, pui32RunCount, i, 200);
+	}
+
+	WorkPoolWait(psPool, hLast, IMG_FALSE);
+
+	for (i = 0; i < ui32NumJobs; i++)
+	{
+		ui32Ran += pui32RunCount[i];
+	}
+
+	WorkPoolGetStats(psPool, &sStats);
+
+	Check(ui32Ran == ui32NumJobs, "back-pressure", "jobs lost with a full pool");
+	Check(sStats.ui32Submitted == ui32NumJobs, "back-pressure", "wrong submission count");
+	Check(sStats.ui32SubmitStalls > 0, "back-pressure", "a 4 slot pool never filled up");
+	Check(sStats.ui32Helped > 0, "back-pressure", "the submitter never ran a job while stalled");
+
+	WorkPoolDestroy(psPool);
+
+	free((IMG_VOID *)pui32RunCount);
+}
+
+/*
+	A worker stuck on a long job has its queued jobs stolen by the other one.
+*/
+static IMG_VOID TestStealing(IMG_VOID)
+{
+	const IMG_UINT32 ui32NumJobs = 20;
+	volatile IMG_UINT32 aui32RunCount[21];
+	WORKPOOL *psPool = CreatePool(2, 32, sizeof(TEST_JOB));
+	WORKPOOL_STATS sStats;
+	WORKPOOL_TOKEN hLast = WORKPOOL_NO_TOKEN;
+	IMG_DOUBLE dStart;
+	IMG_UINT32 i;
+
+	if (!psPool)
+	{
+		Check(IMG_FALSE, "stealing", "WorkPoolCreate failed");
+		return;
+	}
+
+	memset((IMG_VOID *)aui32RunCount, 0, sizeof(aui32RunCount));
+
+	/* The first job keeps one worker busy; half the short ones are queued behind it */
+	SubmitTestJob(psPool, aui32RunCount, ui32NumJobs, 200000);
+
+	dStart = GetTimeMs();
+
+	for (i = 0; i < ui32NumJobs; i++)
+	{
+		SubmitTestJob(psPool, aui32RunCount, i, 100);
+	}
+
+	/* Wait for the short jobs only: they must not wait for the long one */
+	for (i = 0; i < ui32NumJobs; i++)
+	{
+		while (!__sync_fetch_and_add(&aui32RunCount[i], 0) && GetTimeMs() - dStart < 150.0)
+		{
+			SleepUs(100);
+		}
+	}
+
+	Check(GetTimeMs() - dStart < 150.0, "stealing", "short jobs waited for the busy worker");
+
+	hLast = WorkPoolLastToken(psPool);
+	WorkPoolWait(psPool, hLast, IMG_FALSE);
+
+	WorkPoolGetStats(psPool, &sStats);
+
+	Check(sStats.ui32Stolen >= ui32NumJobs / 2, "stealing", "idle worker didn't steal");
+
+	WorkPoolDestroy(psPool);
+}
+
+/*
+	WorkPoolInJob is true in jobs run by a worker or by a stalled submitter,
+	and false otherwise.
+*/
+static IMG_VOID TestInJob(IMG_VOID)
+{
+	const IMG_UINT32 ui32NumJobs = 50;
+	volatile IMG_UINT32 ui32Ran = 0, ui32NotInJob = 0;
+	WORKPOOL *psPool = CreatePool(1, 2, sizeof(IN_JOB_JOB));
+	WORKPOOL_STATS sStats;
+	WORKPOOL_TOKEN hLast = WORKPOOL_NO_TOKEN;
+	IN_JOB_JOB sJob;
+	IMG_UINT32 i;
+
+	if (!psPool)
+	{
+		Check(IMG_FALSE, "in job", "WorkPoolCreate failed");
+		return;
+	}
+
+	sJob.psPool = psPool;
+	sJob.pui32Ran = &ui32Ran;
+	sJob.pui32NotInJob = &ui32NotInJob;
+
+	for (i = 0; i < ui32NumJobs; i++)
+	{
+		hLast = WorkPoolSubmit(psPool, InJobJob, &sJob, sizeof(sJob));
+	}
+
+	WorkPoolWait(psPool, hLast, IMG_FALSE);
+
+	WorkPoolGetStats(psPool, &sStats);
+
+	Check(ui32Ran == ui32NumJobs, "in job", "jobs lost");
+	Check(ui32NotInJob == 0, "in job", "a job wasn't seen as one");
+	Check(sStats.ui32Helped > 0, "in job", "the submitter never ran a job");
+	Check(!WorkPoolInJob(psPool), "in job", "the submitter is seen as in a job");
+
+	WorkPoolDestroy(psPool);
+}
+
+/*
+	WorkPoolDestroy runs what is still queued.
+*/
+static IMG_VOID TestDestroyDrains(IMG_VOID)
+{
+	const IMG_UINT32 ui32NumJobs = 16;
+	volatile IMG_UINT32 aui32RunCount[16];
+	WORKPOOL *psPool = CreatePool(1, 16, sizeof(TEST_JOB));
+	IMG_UINT32 i, ui32Ran = 0;
+
+	if (!psPool)
+	{
+		Check(IMG_FALSE, "destroy", "WorkPoolCreate failed");
+		return;
+	}
+
+	memset((IMG_VOID *)aui32RunCount, 0, sizeof(aui32RunCount));
+
+	for (i = 0; i < ui32NumJobs; i++)
+	{
+		SubmitTestJob(psPool, aui32RunCount, i, 1000);
+	}
+
+	WorkPoolDestroy(psPool);
+
+	for (i = 0; i < ui32NumJobs; i++)
+	{
+		ui32Ran += aui32RunCount[i];
+	}
+
+	Check(ui32Ran == ui32NumJobs, "destroy", "queued jobs dropped by WorkPoolDestroy");
+}
+
+static IMG_VOID *CopyThread(IMG_VOID *pvData)
+{
+	CopyJob(pvData);
+
+	return IMG_NULL;
+}
+
+/*
+	Times ui32NumJobs copies of ui32Size bytes through the pool and with a
+	thread each.
+*/
+static IMG_VOID Benchmark(IMG_UINT32 ui32NumWorkers, IMG_UINT32 ui32NumJobs, IMG_UINT32 ui32Size)
+{
+	const IMG_UINT32 ui32NumBuffers = 16;
+	IMG_UINT8 *pui8Src = malloc(ui32Size);
+	IMG_UINT8 *pui8Dst = malloc((size_t)ui32Size * ui32NumBuffers);
+	pthread_t *phThreads = malloc(ui32NumWorkers * sizeof(pthread_t));
+	COPY_JOB *psJobs = malloc(ui32NumWorkers * sizeof(COPY_JOB));
+	WORKPOOL *psPool = CreatePool(ui32NumWorkers, 64, sizeof(COPY_JOB));
+	WORKPOOL_STATS sStats;
+	IMG_DOUBLE dStart, dPoolMs, dThreadMs;
+	IMG_UINT32 i, j;
+
+	if (!pui8Src || !pui8Dst || !phThreads || !psJobs || !psPool)
+	{
+		fprintf(stderr, "workpooltest: out of memory\n");
+		exit(1);
+	}
+
+	memset(pui8Src, 0x5A, ui32Size);
+
+	dStart = GetTimeMs();
+
+	for (i = 0; i < ui32NumJobs; i++)
+	{
+		COPY_JOB sJob;
+
+		sJob.pui8Dst = pui8Dst + (size_t)(i % ui32NumBuffers) * ui32Size;
+		sJob.pui8Src = pui8Src;
+		sJob.ui32Size = ui32Size;
+
+		WorkPoolSubmit(psPool, CopyJob, &sJob, sizeof(sJob));
+	}
+
+	WorkPoolWait(psPool, WorkPoolLastToken(psPool), IMG_FALSE);
+
+	dPoolMs = GetTimeMs() - dStart;
+
+	WorkPoolGetStats(psPool, &sStats);
+	WorkPoolDestroy(psPool);
+
+	/* The same number of copies in flight at once, a thread each */
+	dStart = GetTimeMs();
+
+	for (i = 0; i < ui32NumJobs; i += ui32NumWorkers)
+	{
+		IMG_UINT32 ui32Batch = (ui32NumJobs - i < ui32NumWorkers) ? (ui32NumJobs - i) : ui32NumWorkers;
+
+		for (j = 0; j < ui32Batch; j++)
+		{
+			psJobs[j].pui8Dst = pui8Dst + (size_t)((i + j) % ui32NumBuffers) * ui32Size;
+			psJobs[j].pui8Src = pui8Src;
+			psJobs[j].ui32Size = ui32Size;
+
+			pthread_create(&phThreads[j], IMG_NULL, CopyThread, &psJobs[j]);
+		}
+		for (j = 0; j < ui32Batch; j++)
+		{
+			pthread_join(phThreads[j], IMG_NULL);
+		}
+	}
+
+	dThreadMs = GetTimeMs() - dStart;
+
+	printf("%u jobs of %u bytes, %u workers\n", ui32NumJobs, ui32Size, ui32NumWorkers);
+	printf("  pool:              %9.2f ms  %9.0f jobs/s  (stolen %u, helped %u, submit stalls %u)\n",
+		   dPoolMs, ui32NumJobs * 1000.0 / dPoolMs, sStats.ui32Stolen, sStats.ui32Helped, sStats.ui32SubmitStalls);
+	printf("  thread per job:    %9.2f ms  %9.0f jobs/s\n", dThreadMs, ui32NumJobs * 1000.0 / dThreadMs);
+
+	free(psJobs);
+	free(phThreads);
+	free(pui8Dst);
+	free(pui8Src);
+}
+
+static IMG_VOID Usage(IMG_VOID)
+{
+	fprintf(stderr, "Usage: workpooltest [-b] [-j <workers>] [-n <jobs>] [-s <bytes>]\n\n");
+	fprintf(stderr, "  Runs the work pool tests, or with -b times the pool against a\n");
+	fprintf(stderr, "  thread per job: <jobs> copies (10000) of <bytes> each (65536) run\n");
+	fprintf(stderr, "  by <workers> threads (4).\n");
+}
+
+int main(int argc, char **argv)
+{
+	IMG_BOOL bBenchmark = IMG_FALSE;
+	IMG_UINT32 ui32NumWorkers = 4;
+	IMG_UINT32 ui32NumJobs = 10000;
+	IMG_UINT32 ui32Size = 65536;
+	int i;
+
+	for (i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-b") == 0)
+		{
+			bBenchmark = IMG_TRUE;
+		}
+		else if ((strcmp(argv[i], "-j") == 0 || strcmp(argv[i], "-n") == 0 || strcmp(argv[i], "-s") == 0) && i + 1 < argc)
+		{
+			IMG_UINT32 ui32Value = (IMG_UINT32)strtoul(argv[i + 1], IMG_NULL, 0);
+
+			if (!ui32Value)
+			{
+				Usage();
+				return 1;
+			}
+
+			switch (argv[i][1])
+			{
+				case 'j': ui32NumWorkers = ui32Value; break;
+				case 'n': ui32NumJobs = ui32Value; break;
+				default:  ui32Size = ui32Value; break;
+			}
+
+			i++;
+		}
+		else
+		{
+			Usage();
+			return 1;
+		}
+	}
+
+	if (bBenchmark)
+	{
+		Benchmark(ui32NumWorkers, ui32NumJobs, ui32Size);
+		return 0;
+	}
+
+	TestRunOnce();
+	TestWaitOrder();
+	TestBackPressure();
+	TestStealing();
+	TestInJob();
+	TestDestroyDrains();
+
+	if (ui32Failures)
+	{
+		fprintf(stderr, "%u checks failed\n", ui32Failures);
+		return 1;
+	}
+
+	printf("All work pool tests passed\n");
+
+	return 0;
+}
+
+/******************************************************************************
+ End of file (main.c)
+******************************************************************************/
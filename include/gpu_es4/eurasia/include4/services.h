@@ -120,6 +120,18 @@ extern "C" {
 		IMG_UINT32 ui32GLSLEnabledWarnings;
 
 	} PVRSRV_PSP2_APPHINT;
+
+	/* Hints added after PVRSRV_PSP2_APPHINT was fixed, see psp2_pvr_hint.h */
+	typedef struct _PVRSRV_PSP2_APPHINT_EXT_
+	{
+		IMG_UINT32 ui32Size;
+
+		/* OGLES1 hints */
+
+		IMG_CHAR szFFTNLCacheFile[256];
+		IMG_CHAR szFFTNLStateLog[256];
+
+	} PVRSRV_PSP2_APPHINT_EXT;
 #endif
 
 
@@ -1691,6 +1703,8 @@ IMG_IMPORT IMG_BOOL IMG_CALLCONV PVRSRVGetAppHint(IMG_VOID			*pvHintState,
 #if defined(__psp2__)
 IMG_IMPORT IMG_BOOL IMG_CALLCONV PVRSRVInitializeAppHint(PVRSRV_PSP2_APPHINT *psAppHint);
 IMG_IMPORT IMG_BOOL IMG_CALLCONV PVRSRVCreateVirtualAppHint(PVRSRV_PSP2_APPHINT *psAppHint);
+IMG_IMPORT IMG_BOOL IMG_CALLCONV PVRSRVInitializeAppHintExt(PVRSRV_PSP2_APPHINT_EXT *psAppHintExt);
+IMG_IMPORT IMG_BOOL IMG_CALLCONV PVRSRVCreateVirtualAppHintExt(PVRSRV_PSP2_APPHINT_EXT *psAppHintExt);
 #endif
 
 /******************************************************************************
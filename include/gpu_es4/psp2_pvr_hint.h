@@ -87,8 +87,24 @@ typedef struct _PVRSRV_PSP2_APPHINT_
 
 } PVRSRV_PSP2_APPHINT;
 
+// Hints added after PVRSRV_PSP2_APPHINT was fixed. New fields only ever go
+// on the end; set ui32Size to sizeof(PVRSRV_PSP2_APPHINT_EXT) before
+// PVRSRVInitializeAppHintExt and fields past it are left at their defaults.
+typedef struct _PVRSRV_PSP2_APPHINT_EXT_
+{
+	IMG_UINT32 ui32Size;
+
+	/* OGLES1 hints */
+
+	IMG_CHAR szFFTNLCacheFile[256]; //FFTNL program cache, empty for none
+	IMG_CHAR szFFTNLStateLog[256]; //FFTNL state log for host/ffgencache, empty for none
+
+} PVRSRV_PSP2_APPHINT_EXT;
+
 unsigned int PVRSRVInitializeAppHint(PVRSRV_PSP2_APPHINT *psAppHint);
 unsigned int PVRSRVCreateVirtualAppHint(PVRSRV_PSP2_APPHINT *psAppHint);
+unsigned int PVRSRVInitializeAppHintExt(PVRSRV_PSP2_APPHINT_EXT *psAppHintExt);
+unsigned int PVRSRVCreateVirtualAppHintExt(PVRSRV_PSP2_APPHINT_EXT *psAppHintExt);
 
 #ifdef __cplusplus
 }
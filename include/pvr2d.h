@@ -51,7 +51,7 @@ extern "C" {
 
 /* PVR2D header revision */
 #define PVR2D_REV_MAJOR		3
-#define PVR2D_REV_MINOR		6
+#define PVR2D_REV_MINOR		7
 
 #include <scetypes.h>
 
@@ -370,6 +370,16 @@ typedef struct _PVR2DRECT
 } PVR2DRECT, *PPVR2DRECT;
 
 
+/* PVR2DBltBatch results */
+typedef struct _PVR2DBATCHSTATS
+{
+	PVR2D_ULONG		ulNumBlts;			/* blits in the batch */
+	PVR2D_ULONG		ulNumMerged;		/* blits drawn by a neighbour's transfer */
+	PVR2D_ULONG		ulNumSubmitted;		/* transfers queued */
+
+} PVR2DBATCHSTATS, *PPVR2DBATCHSTATS;
+
+
 typedef struct
 {
 	PVR2D_ULONG		uChromaPlane1;		/* YUV multiplane - byte offset from start of alloc to chroma plane 1 */
@@ -616,6 +626,12 @@ PVR2DERROR PVR2DBltClipped(PVR2DCONTEXTHANDLE hContext,
 						   PVR2D_ULONG ulNumClipRects,
 						   PVR2DRECT *pClipRects);
 
+PVR2D_IMPORT
+PVR2DERROR PVR2DBltBatch(PVR2DCONTEXTHANDLE hContext,
+						 PVR2DBLTINFO *pBltInfo,
+						 PVR2D_ULONG ulNumBlts,
+						 PVR2DBATCHSTATS *psStats);
+
 PVR2D_EXPORT
 PVR2DERROR PVR2DSet1555Alpha (PVR2DCONTEXTHANDLE hContext,
 							  PVR2D_UCHAR Alpha0, PVR2D_UCHAR Alpha1);
@@ -326,6 +326,11 @@ static PVR2DERROR AltBltClipped(PVR2DCONTEXTHANDLE hContext,
 								PVR2DBLTINFO *pBltInfo,
 								PVR2D_ULONG ulNumClipRects,
 								PVR2DRECT *pClipRect);
+
+static PVR2DERROR AltBltBatch(PVR2DCONTEXTHANDLE hContext,
+							  PVR2DBLTINFO *pBltInfo,
+							  PVR2D_ULONG ulNumBlts,
+							  PVR2DBATCHSTATS *psStats);
 #endif /* PVR2D_ALT_2DHW */
 
 #if defined(PVR2D_ALT_2DHW) || defined(PVR2D_VALIDATE_INPUT_PARAMS)
@@ -1857,6 +1862,68 @@ PVR2DERROR PVR2DBlt (PVR2DCONTEXTHANDLE hContext, PVR2DBLTINFO *pBltInfo)
 }
 
 
+/******************************************************************************
+ @Function	PVR2DBltBatch
+
+ @Input		hContext : PVR2D context handle
+
+ @Input		pBltInfo : array of PVR2D blit info structures
+
+ @Input		ulNumBlts : number of blits in the array
+
+ @Output	psStats : merge and submission counts (optional)
+
+ @Return	error : PVR2D error code
+
+ @Description : submit an array of blits in order, merging neighbouring
+				blits into shared transfers where the result is unchanged
+******************************************************************************/
+PVR2D_EXPORT
+PVR2DERROR PVR2DBltBatch (PVR2DCONTEXTHANDLE hContext,
+						  PVR2DBLTINFO *pBltInfo,
+						  PVR2D_ULONG ulNumBlts,
+						  PVR2DBATCHSTATS *psStats)
+{
+#if defined(PVR2D_ALT_2DHW)
+
+	return AltBltBatch(hContext, pBltInfo, ulNumBlts, psStats);
+
+#else /* PVR2D_ALT_2DHW */
+
+	// No merging, each blit is queued on its own
+	PVR2DERROR Ret = PVR2D_OK;
+	PVR2D_ULONG i;
+
+	if (psStats)
+	{
+		PVRSRVMemSet(psStats, 0, sizeof(*psStats));
+	}
+	if (ulNumBlts && !pBltInfo)
+	{
+		return PVR2DERROR_INVALID_PARAMETER;
+	}
+
+	for (i = 0; i < ulNumBlts; i++)
+	{
+		Ret = PVR2DBltClipped(hContext, &pBltInfo[i], 0, IMG_NULL);
+		if (Ret != PVR2D_OK)
+		{
+			break;
+		}
+	}
+
+	if (psStats)
+	{
+		psStats->ulNumBlts = ulNumBlts;
+		psStats->ulNumSubmitted = i;
+	}
+
+	return Ret;
+
+#endif /* PVR2D_ALT_2DHW */
+}
+
+
 
 /******************************************************************************
  @Function	LocalAbsDiff
@@ -2697,7 +2764,7 @@ static PVR2DERROR AltPresentBlt (const PVR2DCONTEXTHANDLE hContext, const PPVR2D
 
 
 /*****************************************************************************
- @Function	AltBltClipped
+ @Function	AltBltPrepare
 
  @Input		hContext : PVR2D context handle
 
@@ -2707,23 +2774,27 @@ static PVR2DERROR AltPresentBlt (const PVR2DCONTEXTHANDLE hContext, const PPVR2D
 
  @Input		pClipRects : array of clip rectangles
 
+ @Output	psBlitInfo : transfer queue blit built from pBltInfo
+
+ @Output	pbVisible : IMG_FALSE if the clip rect removes every pixel
+
  @Return	error : PVR2D error code
 
- @Description : submit clipped blit to TQ when 2D hardware is not available
+ @Description : validate a blit and build its TQ transfer without queueing it
 ******************************************************************************/
 
-static PVR2DERROR AltBltClipped (	PVR2DCONTEXTHANDLE hContext,
+static PVR2DERROR AltBltPrepare (	PVR2DCONTEXTHANDLE hContext,
 									PVR2DBLTINFO *pBltInfo,
 									PVR2D_ULONG ulNumClipRects,
-									PVR2DRECT *pClipRect)
+									PVR2DRECT *pClipRect,
+									SGX_QUEUETRANSFER *psBlitInfo,
+									IMG_BOOL *pbVisible)
 {
 	// Use alternative option for 2d if needed
 	PVR2DCONTEXT *psContext = (PVR2DCONTEXT *)hContext;
 	PVRSRV_CLIENT_MEM_INFO *pSrcMemInfo;
 	PVRSRV_CLIENT_MEM_INFO *pDstMemInfo;
-	SGX_QUEUETRANSFER sBlitInfo;
 	PVR2DERROR ePVR2DResult;
-	PVRSRV_ERROR eResult;
 	IMG_UINT32 ui32BltFlags;
 	IMG_BOOL bExtendedDstFormat;
 	IMG_BOOL bExtendedSrcFormat=IMG_FALSE;
@@ -2735,6 +2806,8 @@ static PVR2DERROR AltBltClipped (	PVR2DCONTEXTHANDLE hContext,
 	PVR2DRECT rcDestClipped;
 	PVR2D_ULONG DstFormat,SrcFormat=0;
 	SGXTQ_MEMLAYOUT eMemLayoutDst;
+
+	*pbVisible = IMG_FALSE;
 	
 	if (!hContext)
 	{
@@ -2781,7 +2854,7 @@ static PVR2DERROR AltBltClipped (	PVR2DCONTEXTHANDLE hContext,
 		return ePVR2DResult;
 	}
 
-	PVRSRVMemSet(&sBlitInfo,0,sizeof(sBlitInfo));
+	PVRSRVMemSet(psBlitInfo,0,sizeof(*psBlitInfo));
 	
 	bExtendedDstFormat = (pBltInfo->DstFormat&PVR2D_FORMAT_PVRSRV)?IMG_TRUE:IMG_FALSE;
 	
@@ -2812,43 +2885,43 @@ static PVR2DERROR AltBltClipped (	PVR2DCONTEXTHANDLE hContext,
 
 	// Default blt type
 #if defined(PDUMP)
-	sBlitInfo.bPDumpContinuous = IMG_FALSE;
+	psBlitInfo->bPDumpContinuous = IMG_FALSE;
 #endif
 	
 	// Use 2D core or PTLA or 3D core or software to do the blt as required depending on what is available.
 	if (pBltInfo->BlitFlags & (PVR2D_BLIT_PATH_2DCORE|PVR2D_BLIT_PATH_3DCORE|PVR2D_BLIT_PATH_SWBLT))
 	{
 		// Caller is controlling the path
-		sBlitInfo.ui32Flags = SGX_TRANSFER_DISPATCH_DISABLE_PTLA | SGX_TRANSFER_DISPATCH_DISABLE_3D | SGX_TRANSFER_DISPATCH_DISABLE_SW;
+		psBlitInfo->ui32Flags = SGX_TRANSFER_DISPATCH_DISABLE_PTLA | SGX_TRANSFER_DISPATCH_DISABLE_3D | SGX_TRANSFER_DISPATCH_DISABLE_SW;
 
 		if (pBltInfo->BlitFlags & PVR2D_BLIT_PATH_2DCORE)
 		{
 			// Enable 2D/PTLA option
-			sBlitInfo.ui32Flags &= ~SGX_TRANSFER_DISPATCH_DISABLE_PTLA;
+			psBlitInfo->ui32Flags &= ~SGX_TRANSFER_DISPATCH_DISABLE_PTLA;
 		}
 		if (pBltInfo->BlitFlags & PVR2D_BLIT_PATH_3DCORE)
 		{
 			// Enable 3D option
-			sBlitInfo.ui32Flags &= ~SGX_TRANSFER_DISPATCH_DISABLE_3D;
+			psBlitInfo->ui32Flags &= ~SGX_TRANSFER_DISPATCH_DISABLE_3D;
 		}
 		if (pBltInfo->BlitFlags & PVR2D_BLIT_PATH_SWBLT)
 		{
 			// Enable software blt option
-			sBlitInfo.ui32Flags &= ~SGX_TRANSFER_DISPATCH_DISABLE_SW;
+			psBlitInfo->ui32Flags &= ~SGX_TRANSFER_DISPATCH_DISABLE_SW;
 		}
 	}
 	else
 	{
 		// Specify the default path (use lowest power core if it's capable else fail)
 #if defined(SGX_FEATURE_PTLA)
-		sBlitInfo.ui32Flags |= SGX_TRANSFER_DISPATCH_DISABLE_SW | SGX_TRANSFER_DISPATCH_DISABLE_3D;
+		psBlitInfo->ui32Flags |= SGX_TRANSFER_DISPATCH_DISABLE_SW | SGX_TRANSFER_DISPATCH_DISABLE_3D;
 #else
-		sBlitInfo.ui32Flags |= SGX_TRANSFER_DISPATCH_DISABLE_SW;
+		psBlitInfo->ui32Flags |= SGX_TRANSFER_DISPATCH_DISABLE_SW;
 #endif
 	}
 
 	// Via TQ API
-	sBlitInfo.eType = SGXTQ_BLIT;
+	psBlitInfo->eType = SGXTQ_BLIT;
 
 	// Source and dest rects
 	rcDstRect.top = pBltInfo->DstY;
@@ -2910,11 +2983,11 @@ static PVR2DERROR AltBltClipped (	PVR2DCONTEXTHANDLE hContext,
 		// Rop is supported as a custom rop
 		if( ui32BltFlags & BLT_FLAG_COLOURFILL)
 		{
-			sBlitInfo.Details.sFill.byCustomRop3 = (IMG_BYTE)pBltInfo->CopyCode; // Rop code support
+			psBlitInfo->Details.sFill.byCustomRop3 = (IMG_BYTE)pBltInfo->CopyCode; // Rop code support
 		}
 		else
 		{
-			sBlitInfo.Details.sBlit.byCustomRop3 = (IMG_BYTE)pBltInfo->CopyCode; // Rop code support
+			psBlitInfo->Details.sBlit.byCustomRop3 = (IMG_BYTE)pBltInfo->CopyCode; // Rop code support
 		}
 	}
 	else if ((ui32BltFlags & BLT_FLAG_COMMONBLT) == 0)
@@ -3025,24 +3098,24 @@ static PVR2DERROR AltBltClipped (	PVR2DCONTEXTHANDLE hContext,
 		}
 
 		// Source copy
-		sBlitInfo.ui32NumSources = 1;
-		sBlitInfo.asSources[0].eFormat = GetPvrSrvPixelFormat(SrcFormat);
+		psBlitInfo->ui32NumSources = 1;
+		psBlitInfo->asSources[0].eFormat = GetPvrSrvPixelFormat(SrcFormat);
 
 		if (pBltInfo->SrcFormat & PVR2D_FORMAT_LAYOUT_TWIDDLED)
 		{
-			sBlitInfo.asSources[0].eMemLayout = SGXTQ_MEMLAYOUT_OUT_TWIDDLED;
+			psBlitInfo->asSources[0].eMemLayout = SGXTQ_MEMLAYOUT_OUT_TWIDDLED;
 		}
 		else if (pBltInfo->SrcFormat & PVR2D_FORMAT_LAYOUT_TILED)
 		{
-			sBlitInfo.asSources[0].eMemLayout = SGXTQ_MEMLAYOUT_OUT_TILED;
+			psBlitInfo->asSources[0].eMemLayout = SGXTQ_MEMLAYOUT_OUT_TILED;
 		}
 		else
 		{
-			sBlitInfo.asSources[0].eMemLayout = SGXTQ_MEMLAYOUT_STRIDE;
+			psBlitInfo->asSources[0].eMemLayout = SGXTQ_MEMLAYOUT_STRIDE;
 		}
 
-		sBlitInfo.asSources[0].i32StrideInBytes = pBltInfo->SrcStride;
-		sBlitInfo.asSources[0].psSyncInfo = pSrcMemInfo->psClientSyncInfo;
+		psBlitInfo->asSources[0].i32StrideInBytes = pBltInfo->SrcStride;
+		psBlitInfo->asSources[0].psSyncInfo = pSrcMemInfo->psClientSyncInfo;
 
 		if((pBltInfo->BlitFlags & PVR2D_BLIT_NO_SRC_SYNC_INFO) != 0)
 		{
@@ -3050,7 +3123,7 @@ static PVR2DERROR AltBltClipped (	PVR2DCONTEXTHANDLE hContext,
 				The PVR2D_BLIT_NO_SRC_SYNC_INFO flag prevents SGX from waiting for pending read operations to
 				complete before issuing the blit, and also prevents any source SyncInfo members being updated after the blit.
 			*/
-			sBlitInfo.asSources[0].psSyncInfo = IMG_NULL;
+			psBlitInfo->asSources[0].psSyncInfo = IMG_NULL;
 		}
 
 		if (pBltInfo->SrcOffset >= pBltInfo->pSrcMemInfo->ui32MemSize)
@@ -3059,50 +3132,50 @@ static PVR2DERROR AltBltClipped (	PVR2DCONTEXTHANDLE hContext,
 			return PVR2DERROR_INVALID_PARAMETER;
 		}
 
-		SGX_TQSURFACE_SET_ADDR(sBlitInfo.asSources[0], pSrcMemInfo, pBltInfo->SrcOffset);
+		SGX_TQSURFACE_SET_ADDR(psBlitInfo->asSources[0], pSrcMemInfo, pBltInfo->SrcOffset);
 
 		if (pBltInfo->uSrcChromaPlane1 >= pBltInfo->pSrcMemInfo->ui32MemSize)
 		{
 			PVR2D_DPF((PVR_DBG_ERROR, "PVR2DBltClipped: uSrcChromaPlane1 offset is larger than the source memory size"));
 			return PVR2DERROR_INVALID_PARAMETER;
 		}
-		sBlitInfo.asSources[0].ui32ChromaPlaneOffset[0] = pBltInfo->uSrcChromaPlane1;
+		psBlitInfo->asSources[0].ui32ChromaPlaneOffset[0] = pBltInfo->uSrcChromaPlane1;
 
 		if (pBltInfo->uSrcChromaPlane2 >= pBltInfo->pSrcMemInfo->ui32MemSize)
 		{
 			PVR2D_DPF((PVR_DBG_ERROR, "PVR2DBltClipped: uSrcChromaPlane2 offset is larger than the source memory size"));
 			return PVR2DERROR_INVALID_PARAMETER;
 		}
-		sBlitInfo.asSources[0].ui32ChromaPlaneOffset[1] = pBltInfo->uSrcChromaPlane2;
-		sBlitInfo.asSources[0].ui32ChunkStride = 0;
+		psBlitInfo->asSources[0].ui32ChromaPlaneOffset[1] = pBltInfo->uSrcChromaPlane2;
+		psBlitInfo->asSources[0].ui32ChunkStride = 0;
 
 		// Source surface size
 		if (pBltInfo->SrcSurfHeight)
 		{
-			sBlitInfo.asSources[0].ui32Height = pBltInfo->SrcSurfHeight;
+			psBlitInfo->asSources[0].ui32Height = pBltInfo->SrcSurfHeight;
 		}
 		else
 		{
 			// Legacy support
 			// Old PVR2D apps wont set the surface sizes, but they also won't be using new features such as rotation,
 			// so we can set the size of the surface to be the extent used for the blt.
-			sBlitInfo.asSources[0].ui32Height = (IMG_UINT32)(pBltInfo->SrcY + pBltInfo->SizeY);
+			psBlitInfo->asSources[0].ui32Height = (IMG_UINT32)(pBltInfo->SrcY + pBltInfo->SizeY);
 		}
 		if (pBltInfo->SrcSurfWidth)
 		{
-			sBlitInfo.asSources[0].ui32Width = pBltInfo->SrcSurfWidth;
+			psBlitInfo->asSources[0].ui32Width = pBltInfo->SrcSurfWidth;
 		}
 		else
 		{
 			// Legacy support
-			sBlitInfo.asSources[0].ui32Width = (IMG_UINT32)(pBltInfo->SrcX + pBltInfo->SizeX);
+			psBlitInfo->asSources[0].ui32Width = (IMG_UINT32)(pBltInfo->SrcX + pBltInfo->SizeX);
 		}
 
-		SGX_QUEUETRANSFER_NUM_SRC_RECTS(sBlitInfo) = 1;
-		SGX_QUEUETRANSFER_SRC_RECT(sBlitInfo, 0).x0 = rcSrcRect.left;
-		SGX_QUEUETRANSFER_SRC_RECT(sBlitInfo, 0).x1 = rcSrcRect.right;
-		SGX_QUEUETRANSFER_SRC_RECT(sBlitInfo, 0).y0 = rcSrcRect.top;
-		SGX_QUEUETRANSFER_SRC_RECT(sBlitInfo, 0).y1 = rcSrcRect.bottom;
+		SGX_QUEUETRANSFER_NUM_SRC_RECTS(*psBlitInfo) = 1;
+		SGX_QUEUETRANSFER_SRC_RECT(*psBlitInfo, 0).x0 = rcSrcRect.left;
+		SGX_QUEUETRANSFER_SRC_RECT(*psBlitInfo, 0).x1 = rcSrcRect.right;
+		SGX_QUEUETRANSFER_SRC_RECT(*psBlitInfo, 0).y0 = rcSrcRect.top;
+		SGX_QUEUETRANSFER_SRC_RECT(*psBlitInfo, 0).y1 = rcSrcRect.bottom;
 
 		// Palette support
 		if (!bExtendedSrcFormat)
@@ -3112,10 +3185,10 @@ static PVR2DERROR AltBltClipped (	PVR2DCONTEXTHANDLE hContext,
 				// Support for palletised source copy blt
 				if (pBltInfo->pPalMemInfo && (pBltInfo->BlitFlags==0) && (pBltInfo->CopyCode==PVR2DROPcopy))
 				{
-					sBlitInfo.eType = SGXTQ_COLOURLUT_BLIT;
-					sBlitInfo.Details.sColourLUT.ui32KeySizeInBits = ui32PaletteSizeInBits[SrcFormat];
-					sBlitInfo.Details.sColourLUT.eLUTPxFmt = PVRSRV_PIXEL_FORMAT_ARGB8888;
-					sBlitInfo.Details.sColourLUT.sLUTDevVAddr.uiAddr = pBltInfo->pPalMemInfo->ui32DevAddr + pBltInfo->PalOffset;
+					psBlitInfo->eType = SGXTQ_COLOURLUT_BLIT;
+					psBlitInfo->Details.sColourLUT.ui32KeySizeInBits = ui32PaletteSizeInBits[SrcFormat];
+					psBlitInfo->Details.sColourLUT.eLUTPxFmt = PVRSRV_PIXEL_FORMAT_ARGB8888;
+					psBlitInfo->Details.sColourLUT.sLUTDevVAddr.uiAddr = pBltInfo->pPalMemInfo->ui32DevAddr + pBltInfo->PalOffset;
 				}
 				else
 				{
@@ -3125,7 +3198,7 @@ static PVR2DERROR AltBltClipped (	PVR2DCONTEXTHANDLE hContext,
 			// Pattern support
 			else if (ui32BltFlags & BLT_FLAG_PATTERN)
 			{
-				sBlitInfo.Details.sBlit.bEnablePattern = IMG_TRUE;
+				psBlitInfo->Details.sBlit.bEnablePattern = IMG_TRUE;
 			}
 		}
 
@@ -3143,9 +3216,9 @@ static PVR2DERROR AltBltClipped (	PVR2DCONTEXTHANDLE hContext,
 	else if (ui32BltFlags & BLT_FLAG_COLOURFILL) // Solid fill blts
 	{
 		// Solid colour fill
-		sBlitInfo.eType = SGXTQ_FILL;
-		sBlitInfo.ui32NumSources = 0;
-		sBlitInfo.Details.sFill.ui32Colour = pBltInfo->Colour;
+		psBlitInfo->eType = SGXTQ_FILL;
+		psBlitInfo->ui32NumSources = 0;
+		psBlitInfo->Details.sFill.ui32Colour = pBltInfo->Colour;
 	}
 	else if (ui32BltFlags == DX)
 	{
@@ -3154,10 +3227,10 @@ static PVR2DERROR AltBltClipped (	PVR2DCONTEXTHANDLE hContext,
 		{
 			// Rop 0x55 is DEST INVERT
 			// This can be done with SGXTQ_FILL with pattern fill colour=0 and the PAT OR NOT DEST rop
-			sBlitInfo.eType = SGXTQ_FILL;
-			sBlitInfo.ui32NumSources = 0;
-			sBlitInfo.Details.sFill.ui32Colour = 0;
-			sBlitInfo.Details.sFill.byCustomRop3 = 0xF5; /* The 0xF5 case with zero fill does the same thing */
+			psBlitInfo->eType = SGXTQ_FILL;
+			psBlitInfo->ui32NumSources = 0;
+			psBlitInfo->Details.sFill.ui32Colour = 0;
+			psBlitInfo->Details.sFill.byCustomRop3 = 0xF5; /* The 0xF5 case with zero fill does the same thing */
 		}
 		// Allow all the other dest fill rops to continue through here, ie./ colour fills with a destination rop.
 	}
@@ -3168,32 +3241,32 @@ static PVR2DERROR AltBltClipped (	PVR2DCONTEXTHANDLE hContext,
 	}
 
 	// SGXTQ_BLIT Alpha and Colour Key for source copy
-	if (sBlitInfo.eType == SGXTQ_BLIT)
+	if (psBlitInfo->eType == SGXTQ_BLIT)
 	{
 		if (((pBltInfo->BlitFlags & PVR2D_BLIT_GLOBAL_ALPHA_ENABLE) != 0) &&
 		    ((pBltInfo->BlitFlags & PVR2D_BLIT_PERPIXEL_ALPHABLEND_ENABLE) != 0))
 		{
 			// Premultiplied Source Alpha with Global Alpha
-			sBlitInfo.Details.sBlit.byGlobalAlpha = pBltInfo->GlobalAlphaValue;
-			sBlitInfo.Details.sBlit.eAlpha = SGXTQ_ALPHA_PREMUL_SOURCE_WITH_GLOBAL;
+			psBlitInfo->Details.sBlit.byGlobalAlpha = pBltInfo->GlobalAlphaValue;
+			psBlitInfo->Details.sBlit.eAlpha = SGXTQ_ALPHA_PREMUL_SOURCE_WITH_GLOBAL;
 		}
 		else if (pBltInfo->BlitFlags & PVR2D_BLIT_GLOBAL_ALPHA_ENABLE)
 		{
 			// Global Alpha
-			sBlitInfo.Details.sBlit.byGlobalAlpha = pBltInfo->GlobalAlphaValue;
-			sBlitInfo.Details.sBlit.eAlpha = SGXTQ_ALPHA_GLOBAL;
+			psBlitInfo->Details.sBlit.byGlobalAlpha = pBltInfo->GlobalAlphaValue;
+			psBlitInfo->Details.sBlit.eAlpha = SGXTQ_ALPHA_GLOBAL;
 		}
 		else if (pBltInfo->BlitFlags & PVR2D_BLIT_PERPIXEL_ALPHABLEND_ENABLE)
 		{
 			if (pBltInfo->AlphaBlendingFunc == PVR2D_ALPHA_OP_SRC_DSTINV)
 			{
 				// Non premultiplied Source Alpha
-				sBlitInfo.Details.sBlit.eAlpha = SGXTQ_ALPHA_SOURCE;
+				psBlitInfo->Details.sBlit.eAlpha = SGXTQ_ALPHA_SOURCE;
 			}
 			else if (pBltInfo->AlphaBlendingFunc == PVR2D_ALPHA_OP_SRCP_DSTINV)
 			{
 				// Premultiplied Source Alpha
-				sBlitInfo.Details.sBlit.eAlpha = SGXTQ_ALPHA_PREMUL_SOURCE;
+				psBlitInfo->Details.sBlit.eAlpha = SGXTQ_ALPHA_PREMUL_SOURCE;
 			}
 		}
 
@@ -3206,84 +3279,84 @@ static PVR2DERROR AltBltClipped (	PVR2DCONTEXTHANDLE hContext,
 			    ((pBltInfo->BlitFlags & PVR2D_BLIT_COLKEY_DEST) == 0))
 			{
 				// Key colour is on the source surface
-				sBlitInfo.Details.sBlit.eColourKey = SGXTQ_COLOURKEY_SOURCE;
+				psBlitInfo->Details.sBlit.eColourKey = SGXTQ_COLOURKEY_SOURCE;
 				Format = SrcFormat;
 			}
 			else
 			{
 				// Key colour is on the dest surface
-				sBlitInfo.Details.sBlit.eColourKey = SGXTQ_COLOURKEY_DEST;
+				psBlitInfo->Details.sBlit.eColourKey = SGXTQ_COLOURKEY_DEST;
 				Format = DstFormat;
 			}
-			sBlitInfo.Details.sBlit.ui32ColourKey = pBltInfo->ColourKey;
+			psBlitInfo->Details.sBlit.ui32ColourKey = pBltInfo->ColourKey;
 
 			if (((pBltInfo->BlitFlags & PVR2D_BLIT_COLKEY_MASKED) != 0) && pBltInfo->ColourKeyMask)
 			{
-				sBlitInfo.Details.sBlit.ui32ColourKeyMask = pBltInfo->ColourKeyMask; // Caller's mask
+				psBlitInfo->Details.sBlit.ui32ColourKeyMask = pBltInfo->ColourKeyMask; // Caller's mask
 			}
 			else
 			{
-				sBlitInfo.Details.sBlit.ui32ColourKeyMask = uiColorKeyMask[Format]; // Default mask for that format
+				psBlitInfo->Details.sBlit.ui32ColourKeyMask = uiColorKeyMask[Format]; // Default mask for that format
 			}
 		}
 
 	}// SGXTQ_BLIT Alpha and colour key
 
 	// Transfer Queue dest surface
-	sBlitInfo.ui32NumDest = 1;
-	sBlitInfo.asDests[0].eFormat =  GetPvrSrvPixelFormat(DstFormat);
-	sBlitInfo.asDests[0].eMemLayout =  eMemLayoutDst;
-	sBlitInfo.asDests[0].i32StrideInBytes = pBltInfo->DstStride;
-	sBlitInfo.asDests[0].psSyncInfo = pDstMemInfo->psClientSyncInfo;
+	psBlitInfo->ui32NumDest = 1;
+	psBlitInfo->asDests[0].eFormat =  GetPvrSrvPixelFormat(DstFormat);
+	psBlitInfo->asDests[0].eMemLayout =  eMemLayoutDst;
+	psBlitInfo->asDests[0].i32StrideInBytes = pBltInfo->DstStride;
+	psBlitInfo->asDests[0].psSyncInfo = pDstMemInfo->psClientSyncInfo;
 
 	if (pBltInfo->DstOffset >= pBltInfo->pDstMemInfo->ui32MemSize)
 	{
 		PVR2D_DPF((PVR_DBG_ERROR, "PVR2DBltClipped: destination memory offset specified is larger than the destination memory size"));
 		return PVR2DERROR_INVALID_PARAMETER;
 	}
-	SGX_TQSURFACE_SET_ADDR(sBlitInfo.asDests[0], pDstMemInfo, pBltInfo->DstOffset);
+	SGX_TQSURFACE_SET_ADDR(psBlitInfo->asDests[0], pDstMemInfo, pBltInfo->DstOffset);
 
 	if (pBltInfo->uDstChromaPlane1 >= pBltInfo->pDstMemInfo->ui32MemSize)
 	{
 		PVR2D_DPF((PVR_DBG_ERROR, "PVR2DBltClipped: uDstChromaPlane1 offset is larger than the memory size"));
 		return PVR2DERROR_INVALID_PARAMETER;
 	}
-	sBlitInfo.asDests[0].ui32ChromaPlaneOffset[0] = pBltInfo->uDstChromaPlane1;
+	psBlitInfo->asDests[0].ui32ChromaPlaneOffset[0] = pBltInfo->uDstChromaPlane1;
 
 	if (pBltInfo->uDstChromaPlane2 >= pBltInfo->pDstMemInfo->ui32MemSize)
 	{
 		PVR2D_DPF((PVR_DBG_ERROR, "PVR2DBltClipped: uDstChromaPlane2 offset is larger than the memory size"));
 		return PVR2DERROR_INVALID_PARAMETER;
 	}
-	sBlitInfo.asDests[0].ui32ChromaPlaneOffset[1] = pBltInfo->uDstChromaPlane2;
-	sBlitInfo.asDests[0].ui32ChunkStride = 0;
+	psBlitInfo->asDests[0].ui32ChromaPlaneOffset[1] = pBltInfo->uDstChromaPlane2;
+	psBlitInfo->asDests[0].ui32ChunkStride = 0;
 
 	// Dest surface size
 	if (pBltInfo->DstSurfHeight)
 	{
-		sBlitInfo.asDests[0].ui32Height = pBltInfo->DstSurfHeight;
+		psBlitInfo->asDests[0].ui32Height = pBltInfo->DstSurfHeight;
 	}
 	else
 	{
 		// Legacy support
-		sBlitInfo.asDests[0].ui32Height = (IMG_UINT32)(pBltInfo->DstY + pBltInfo->DSizeY);
+		psBlitInfo->asDests[0].ui32Height = (IMG_UINT32)(pBltInfo->DstY + pBltInfo->DSizeY);
 	}
 	if (pBltInfo->DstSurfWidth)
 	{
-		sBlitInfo.asDests[0].ui32Width = pBltInfo->DstSurfWidth;
+		psBlitInfo->asDests[0].ui32Width = pBltInfo->DstSurfWidth;
 	}
 	else
 	{
 		// Legacy support
-		sBlitInfo.asDests[0].ui32Width = (IMG_UINT32)(pBltInfo->DstX + pBltInfo->DSizeX);
+		psBlitInfo->asDests[0].ui32Width = (IMG_UINT32)(pBltInfo->DstX + pBltInfo->DSizeX);
 	}
 	
 	// Destination rectangle
-	SGX_QUEUETRANSFER_NUM_DST_RECTS(sBlitInfo) = 1;
-	SGX_QUEUETRANSFER_DST_RECT(sBlitInfo, 0).x0 = rcDstRect.left;
-	SGX_QUEUETRANSFER_DST_RECT(sBlitInfo, 0).x1 = rcDstRect.right;
-	SGX_QUEUETRANSFER_DST_RECT(sBlitInfo, 0).y0 = rcDstRect.top;
-	SGX_QUEUETRANSFER_DST_RECT(sBlitInfo, 0).y1 = rcDstRect.bottom;
+	SGX_QUEUETRANSFER_NUM_DST_RECTS(*psBlitInfo) = 1;
+	SGX_QUEUETRANSFER_DST_RECT(*psBlitInfo, 0).x0 = rcDstRect.left;
+	SGX_QUEUETRANSFER_DST_RECT(*psBlitInfo, 0).x1 = rcDstRect.right;
+	SGX_QUEUETRANSFER_DST_RECT(*psBlitInfo, 0).y0 = rcDstRect.top;
+	SGX_QUEUETRANSFER_DST_RECT(*psBlitInfo, 0).y1 = rcDstRect.bottom;
 
 	// TQ blt rotation
 	if (pBltInfo->BlitFlags & (PVR2D_BLIT_ROT_90|PVR2D_BLIT_ROT_180|PVR2D_BLIT_ROT_270))
@@ -3292,29 +3365,29 @@ static PVR2DERROR AltBltClipped (	PVR2DCONTEXTHANDLE hContext,
 		// PTLA 2D core
 		if (pBltInfo->BlitFlags & PVR2D_BLIT_ROT_90)
 		{
-			sBlitInfo.Details.sBlit.eRotation = SGXTQ_ROTATION_90;
+			psBlitInfo->Details.sBlit.eRotation = SGXTQ_ROTATION_90;
 		}
 		else if (pBltInfo->BlitFlags & PVR2D_BLIT_ROT_180)
 		{
-			sBlitInfo.Details.sBlit.eRotation = SGXTQ_ROTATION_180;
+			psBlitInfo->Details.sBlit.eRotation = SGXTQ_ROTATION_180;
 		}
 		else if (pBltInfo->BlitFlags & PVR2D_BLIT_ROT_270)
 		{
-			sBlitInfo.Details.sBlit.eRotation = SGXTQ_ROTATION_270;
+			psBlitInfo->Details.sBlit.eRotation = SGXTQ_ROTATION_270;
 		}
 #else
 		// 3D Core - apply rotation to layer 0 (source)
 		if (pBltInfo->BlitFlags & PVR2D_BLIT_ROT_90)
 		{
-			sBlitInfo.ui32Flags |= SGX_TRANSFER_LAYER_0_ROT_90;
+			psBlitInfo->ui32Flags |= SGX_TRANSFER_LAYER_0_ROT_90;
 		}
 		else if (pBltInfo->BlitFlags & PVR2D_BLIT_ROT_180)
 		{
-			sBlitInfo.ui32Flags |= SGX_TRANSFER_LAYER_0_ROT_180;
+			psBlitInfo->ui32Flags |= SGX_TRANSFER_LAYER_0_ROT_180;
 		}
 		else if (pBltInfo->BlitFlags & PVR2D_BLIT_ROT_270)
 		{
-			sBlitInfo.ui32Flags |= SGX_TRANSFER_LAYER_0_ROT_270;
+			psBlitInfo->ui32Flags |= SGX_TRANSFER_LAYER_0_ROT_270;
 		}
 #endif
 	}
@@ -3323,26 +3396,58 @@ static PVR2DERROR AltBltClipped (	PVR2DCONTEXTHANDLE hContext,
 	{
 		if ((pBltInfo->BlitFlags & PVR2D_BLIT_COPYORDER_BR2TL)!=0)
 		{
-			sBlitInfo.Details.sBlit.eCopyOrder = SGXTQ_COPYORDER_BR2TL;
+			psBlitInfo->Details.sBlit.eCopyOrder = SGXTQ_COPYORDER_BR2TL;
 		}
 		else if ((pBltInfo->BlitFlags & PVR2D_BLIT_COPYORDER_TR2BL)!=0)
 		{
-			sBlitInfo.Details.sBlit.eCopyOrder = SGXTQ_COPYORDER_TR2BL;
+			psBlitInfo->Details.sBlit.eCopyOrder = SGXTQ_COPYORDER_TR2BL;
 		}
 		else
 		{
-			sBlitInfo.Details.sBlit.eCopyOrder = SGXTQ_COPYORDER_BL2TR;
+			psBlitInfo->Details.sBlit.eCopyOrder = SGXTQ_COPYORDER_BL2TR;
 		}
 	}
 
+	*pbVisible = IMG_TRUE;
+
+	return PVR2D_OK;
+
+}// AltBltPrepare
+
+
+/*****************************************************************************
+ @Function	AltBltSubmit
+
+ @Input		psContext : PVR2D context
+
+ @Input		pBltInfo : PVR2D blit info the transfer was built from
+
+ @Input		psBlitInfo : transfer queue blit
+
+ @Return	error : PVR2D error code
+
+ @Description : queue a transfer built by AltBltPrepare
+******************************************************************************/
+
+static PVR2DERROR AltBltSubmit (	PVR2DCONTEXT *psContext,
+									PVR2DBLTINFO *pBltInfo,
+									SGX_QUEUETRANSFER *psBlitInfo)
+{
+	PVRSRV_ERROR eResult;
+#if defined(PDUMP)
+	PVRSRV_CLIENT_MEM_INFO *pDstMemInfo = (PVRSRV_CLIENT_MEM_INFO*)pBltInfo->pDstMemInfo->hPrivateData;
+#endif
+
+	PVR_UNREFERENCED_PARAMETER(pBltInfo);
+
 #if defined(PDUMP) // Capture input surfaces
-	PdumpInputSurfaces(psContext, (ui32BltFlags&(BLT_FLAG_SOURCE|BLT_FLAG_PATTERN))?IMG_TRUE:IMG_FALSE, pBltInfo);
+	PdumpInputSurfaces(psContext, (psBlitInfo->ui32NumSources != 0) ? IMG_TRUE : IMG_FALSE, pBltInfo);
 
 	PVRSRVPDumpComment(psContext->psServices, "PVR2D:SGXQueueTransfer", IMG_FALSE);
 #endif//#if defined(PDUMP)
-	
+
 	// Transfer queue blt (PTLA BltClipped)
-	eResult = SGXQueueTransfer(&psContext->sDevData, psContext->hTransferContext, &sBlitInfo);
+	eResult = SGXQueueTransfer(&psContext->sDevData, psContext->hTransferContext, psBlitInfo);
 
 	if (eResult != PVRSRV_OK)
 	{
@@ -3359,7 +3464,7 @@ static PVR2DERROR AltBltClipped (	PVR2DCONTEXTHANDLE hContext,
 
 #ifdef SYNC_DEBUG
 	// Debug with synchronous blts
-	PVR2DQueryBlitsComplete(hContext, pBltInfo->pDstMemInfo, 1);
+	PVR2DQueryBlitsComplete((PVR2DCONTEXTHANDLE)psContext, pBltInfo->pDstMemInfo, 1);
 #endif
 
 #if defined(PDUMP) // Output surface
@@ -3381,9 +3486,433 @@ static PVR2DERROR AltBltClipped (	PVR2DCONTEXTHANDLE hContext,
 
 	return PVR2D_OK;
 
+}// AltBltSubmit
+
+
+/*****************************************************************************
+ @Function	AltBltClipped
+
+ @Input		hContext : PVR2D context handle
+
+ @Input		pBltInfo : PVR2D blit info structure
+
+ @Input		ulNumClipRects : number of clip rectangles
+
+ @Input		pClipRects : array of clip rectangles
+
+ @Return	error : PVR2D error code
+
+ @Description : submit clipped blit to TQ when 2D hardware is not available
+******************************************************************************/
+
+static PVR2DERROR AltBltClipped (	PVR2DCONTEXTHANDLE hContext,
+									PVR2DBLTINFO *pBltInfo,
+									PVR2D_ULONG ulNumClipRects,
+									PVR2DRECT *pClipRect)
+{
+	SGX_QUEUETRANSFER sBlitInfo;
+	IMG_BOOL bVisible;
+	PVR2DERROR ePVR2DResult;
+
+	ePVR2DResult = AltBltPrepare(hContext, pBltInfo, ulNumClipRects, pClipRect, &sBlitInfo, &bVisible);
+	if ((ePVR2DResult != PVR2D_OK) || !bVisible)
+	{
+		// Rejected, or clipped away with no pixels written
+		return ePVR2DResult;
+	}
+
+	return AltBltSubmit((PVR2DCONTEXT *)hContext, pBltInfo, &sBlitInfo);
+
 }// AltBltClipped
 
 
+/* Most rectangles one SGXTQ_CLIP_BLIT can draw (SGXTQ_MAX_F2DRECTS) */
+#define PVR2D_BATCH_MAX_CLIP_RECTS	51
+
+/*****************************************************************************
+ @Function	AltBltSameSurface
+
+ @Input		psA, psB : transfer queue surfaces
+
+ @Return	IMG_TRUE if both describe the same memory in the same way
+
+ @Description : surface comparison used when merging batched blits
+******************************************************************************/
+static IMG_BOOL AltBltSameSurface(const SGXTQ_SURFACE *psA, const SGXTQ_SURFACE *psB)
+{
+	return (IMG_BOOL)((SGX_TQSURFACE_GET_DEV_VADDR(*psA) == SGX_TQSURFACE_GET_DEV_VADDR(*psB)) &&
+					  (psA->ui32Width == psB->ui32Width) &&
+					  (psA->ui32Height == psB->ui32Height) &&
+					  (psA->i32StrideInBytes == psB->i32StrideInBytes) &&
+					  (psA->eFormat == psB->eFormat) &&
+					  (psA->eMemLayout == psB->eMemLayout) &&
+					  (psA->ui32ChunkStride == psB->ui32ChunkStride) &&
+					  (psA->psSyncInfo == psB->psSyncInfo) &&
+					  (psA->ui32ChromaPlaneOffset[0] == psB->ui32ChromaPlaneOffset[0]) &&
+					  (psA->ui32ChromaPlaneOffset[1] == psB->ui32ChromaPlaneOffset[1]));
+}
+
+/*****************************************************************************
+ @Function	AltBltCanMerge
+
+ @Input		pFirstInfo, psFirst : first blit of a batch group and its transfer
+
+ @Input		pNextInfo, psNext : candidate blit and its transfer
+
+ @Return	IMG_TRUE if psNext may be drawn by the same transfer as psFirst
+
+ @Description : Blits merge when everything but their rectangles matches and
+				each pixel of the result depends only on the pixel under it,
+				so drawing them in one transfer cannot change the output:
+				fills, and unscaled, unrotated blits from a surface that is
+				not the destination.
+******************************************************************************/
+static IMG_BOOL AltBltCanMerge(const PVR2DBLTINFO *pFirstInfo, const SGX_QUEUETRANSFER *psFirst,
+							   const PVR2DBLTINFO *pNextInfo, const SGX_QUEUETRANSFER *psNext)
+{
+	if ((psFirst->eType != psNext->eType) ||
+		(psFirst->ui32Flags != psNext->ui32Flags) ||
+		(psFirst->ui32NumSources != psNext->ui32NumSources) ||
+		(psFirst->ui32NumDest != psNext->ui32NumDest) ||
+		!AltBltSameSurface(&psFirst->asDests[0], &psNext->asDests[0]))
+	{
+		return IMG_FALSE;
+	}
+
+	if (psFirst->eType == SGXTQ_FILL)
+	{
+		return (IMG_BOOL)((psFirst->Details.sFill.ui32Colour == psNext->Details.sFill.ui32Colour) &&
+						  (psFirst->Details.sFill.byCustomRop3 == psNext->Details.sFill.byCustomRop3));
+	}
+
+	if (psFirst->eType != SGXTQ_BLIT)
+	{
+		// Palette blits and anything else are queued one by one
+		return IMG_FALSE;
+	}
+
+	// Rotation, copy order and patterns all depend on where the rect is
+	if ((psFirst->ui32Flags & (SGX_TRANSFER_LAYER_0_ROT_90|SGX_TRANSFER_LAYER_0_ROT_180|SGX_TRANSFER_LAYER_0_ROT_270)) ||
+		(psFirst->Details.sBlit.eRotation != SGXTQ_ROTATION_NONE) ||
+		(psFirst->Details.sBlit.eCopyOrder != SGXTQ_COPYORDER_AUTO) ||
+		psFirst->Details.sBlit.bEnablePattern)
+	{
+		return IMG_FALSE;
+	}
+
+	// A later blit could read what an earlier one wrote
+	if ((pFirstInfo->pSrcMemInfo == pFirstInfo->pDstMemInfo) ||
+		(pNextInfo->pSrcMemInfo == pNextInfo->pDstMemInfo))
+	{
+		return IMG_FALSE;
+	}
+
+	if (!AltBltSameSurface(&psFirst->asSources[0], &psNext->asSources[0]))
+	{
+		return IMG_FALSE;
+	}
+
+	// No scaling
+	if (((SGX_QUEUETRANSFER_SRC_RECT(*psNext, 0).x1 - SGX_QUEUETRANSFER_SRC_RECT(*psNext, 0).x0) !=
+		 (SGX_QUEUETRANSFER_DST_RECT(*psNext, 0).x1 - SGX_QUEUETRANSFER_DST_RECT(*psNext, 0).x0)) ||
+		((SGX_QUEUETRANSFER_SRC_RECT(*psNext, 0).y1 - SGX_QUEUETRANSFER_SRC_RECT(*psNext, 0).y0) !=
+		 (SGX_QUEUETRANSFER_DST_RECT(*psNext, 0).y1 - SGX_QUEUETRANSFER_DST_RECT(*psNext, 0).y0)) ||
+		((SGX_QUEUETRANSFER_SRC_RECT(*psFirst, 0).x1 - SGX_QUEUETRANSFER_SRC_RECT(*psFirst, 0).x0) !=
+		 (SGX_QUEUETRANSFER_DST_RECT(*psFirst, 0).x1 - SGX_QUEUETRANSFER_DST_RECT(*psFirst, 0).x0)) ||
+		((SGX_QUEUETRANSFER_SRC_RECT(*psFirst, 0).y1 - SGX_QUEUETRANSFER_SRC_RECT(*psFirst, 0).y0) !=
+		 (SGX_QUEUETRANSFER_DST_RECT(*psFirst, 0).y1 - SGX_QUEUETRANSFER_DST_RECT(*psFirst, 0).y0)))
+	{
+		return IMG_FALSE;
+	}
+
+	// The same source to dest offset
+	if (((SGX_QUEUETRANSFER_SRC_RECT(*psNext, 0).x0 - SGX_QUEUETRANSFER_DST_RECT(*psNext, 0).x0) !=
+		 (SGX_QUEUETRANSFER_SRC_RECT(*psFirst, 0).x0 - SGX_QUEUETRANSFER_DST_RECT(*psFirst, 0).x0)) ||
+		((SGX_QUEUETRANSFER_SRC_RECT(*psNext, 0).y0 - SGX_QUEUETRANSFER_DST_RECT(*psNext, 0).y0) !=
+		 (SGX_QUEUETRANSFER_SRC_RECT(*psFirst, 0).y0 - SGX_QUEUETRANSFER_DST_RECT(*psFirst, 0).y0)))
+	{
+		return IMG_FALSE;
+	}
+
+	return (IMG_BOOL)((psFirst->Details.sBlit.eAlpha == psNext->Details.sBlit.eAlpha) &&
+					  (psFirst->Details.sBlit.byGlobalAlpha == psNext->Details.sBlit.byGlobalAlpha) &&
+					  (psFirst->Details.sBlit.eColourKey == psNext->Details.sBlit.eColourKey) &&
+					  (psFirst->Details.sBlit.ui32ColourKey == psNext->Details.sBlit.ui32ColourKey) &&
+					  (psFirst->Details.sBlit.ui32ColourKeyMask == psNext->Details.sBlit.ui32ColourKeyMask) &&
+					  (psFirst->Details.sBlit.byCustomRop3 == psNext->Details.sBlit.byCustomRop3));
+}
+
+/*****************************************************************************
+ @Function	AltBltIsClipCopy
+
+ @Input		psBlitInfo : transfer queue blit
+
+ @Return	IMG_TRUE if the blit can be one rectangle of an SGXTQ_CLIP_BLIT
+
+ @Description : A clip blit is a plain copy that samples the source at the
+				destination coordinates, so only straight copies between
+				surfaces of the same size, to the same position, qualify.
+******************************************************************************/
+static IMG_BOOL AltBltIsClipCopy(const SGX_QUEUETRANSFER *psBlitInfo)
+{
+	const IMG_RECT *psSrcRect = &SGX_QUEUETRANSFER_SRC_RECT(*psBlitInfo, 0);
+	const IMG_RECT *psDstRect = &SGX_QUEUETRANSFER_DST_RECT(*psBlitInfo, 0);
+
+	return (IMG_BOOL)((psBlitInfo->eType == SGXTQ_BLIT) &&
+					  (psBlitInfo->ui32NumSources == 1) &&
+					  (psBlitInfo->Details.sBlit.eAlpha == SGXTQ_ALPHA_NONE) &&
+					  (psBlitInfo->Details.sBlit.eColourKey == SGXTQ_COLOURKEY_NONE) &&
+					  (psBlitInfo->Details.sBlit.byCustomRop3 == 0) &&
+					  (psBlitInfo->asSources[0].ui32Width == psBlitInfo->asDests[0].ui32Width) &&
+					  (psBlitInfo->asSources[0].ui32Height == psBlitInfo->asDests[0].ui32Height) &&
+					  (psSrcRect->x0 == psDstRect->x0) && (psSrcRect->y0 == psDstRect->y0) &&
+					  (psSrcRect->x1 == psDstRect->x1) && (psSrcRect->y1 == psDstRect->y1));
+}
+
+/*****************************************************************************
+ @Function	AltBltJoinRect
+
+ @Modified	psRect : rectangle to grow
+
+ @Input		psNext : rectangle to add
+
+ @Return	IMG_TRUE if psNext shared a whole edge with psRect and was added
+
+ @Description : grow a rectangle by a neighbour when the union is a rectangle
+******************************************************************************/
+static IMG_BOOL AltBltJoinRect(IMG_RECT *psRect, const IMG_RECT *psNext)
+{
+	if ((psRect->y0 == psNext->y0) && (psRect->y1 == psNext->y1))
+	{
+		if (psRect->x1 == psNext->x0)
+		{
+			psRect->x1 = psNext->x1;
+			return IMG_TRUE;
+		}
+		if (psNext->x1 == psRect->x0)
+		{
+			psRect->x0 = psNext->x0;
+			return IMG_TRUE;
+		}
+	}
+	else if ((psRect->x0 == psNext->x0) && (psRect->x1 == psNext->x1))
+	{
+		if (psRect->y1 == psNext->y0)
+		{
+			psRect->y1 = psNext->y1;
+			return IMG_TRUE;
+		}
+		if (psNext->y1 == psRect->y0)
+		{
+			psRect->y0 = psNext->y0;
+			return IMG_TRUE;
+		}
+	}
+
+	return IMG_FALSE;
+}
+
+/*****************************************************************************
+ @Function	AltBltBatch
+
+ @Input		hContext : PVR2D context handle
+
+ @Input		pBltInfo : array of PVR2D blit info structures
+
+ @Input		ulNumBlts : number of blits
+
+ @Output	psStats : optional merge and submission counts
+
+ @Return	error : PVR2D error code
+
+ @Description : Every blit is validated and built before anything is queued,
+				so a bad entry fails the whole batch with nothing submitted.
+				Runs of neighbouring blits that AltBltCanMerge accepts are
+				then queued as one transfer: rectangles that share an edge
+				become one rectangle, and the disjoint rectangles of a run of
+				same-position copies are drawn by one SGXTQ_CLIP_BLIT, with
+				one sync update for the whole run.
+******************************************************************************/
+static PVR2DERROR AltBltBatch (	PVR2DCONTEXTHANDLE hContext,
+								PVR2DBLTINFO *pBltInfo,
+								PVR2D_ULONG ulNumBlts,
+								PVR2DBATCHSTATS *psStats)
+{
+	PVR2DCONTEXT *psContext = (PVR2DCONTEXT *)hContext;
+	SGX_QUEUETRANSFER *psBlits;
+	IMG_BOOL *pbVisible;
+	IMG_RECT asRects[PVR2D_BATCH_MAX_CLIP_RECTS];
+	PVR2DERROR ePVR2DResult = PVR2D_OK;
+	PVR2D_ULONG ulMerged = 0;
+	PVR2D_ULONG ulSubmitted = 0;
+	PVR2D_ULONG i, j, k;
+
+	if (psStats)
+	{
+		PVRSRVMemSet(psStats, 0, sizeof(*psStats));
+	}
+
+	if (!hContext)
+	{
+		PVR2D_DPF((PVR_DBG_ERROR, "PVR2DBltBatch: invalid context"));
+		return PVR2DERROR_INVALID_CONTEXT;
+	}
+	if (!ulNumBlts)
+	{
+		return PVR2D_OK;
+	}
+	if (!pBltInfo)
+	{
+		PVR2D_DPF((PVR_DBG_ERROR, "PVR2DBltBatch: invalid param"));
+		return PVR2DERROR_INVALID_PARAMETER;
+	}
+
+	psBlits = (SGX_QUEUETRANSFER *)PVR2DMalloc(psContext, ulNumBlts * (sizeof(SGX_QUEUETRANSFER) + sizeof(IMG_BOOL)));
+	if (!psBlits)
+	{
+		return PVR2DERROR_MEMORY_UNAVAILABLE;
+	}
+	pbVisible = (IMG_BOOL *)&psBlits[ulNumBlts];
+
+	// Validate and build every blit first
+	for (i = 0; i < ulNumBlts; i++)
+	{
+		ePVR2DResult = AltBltPrepare(hContext, &pBltInfo[i], 0, IMG_NULL, &psBlits[i], &pbVisible[i]);
+		if (ePVR2DResult != PVR2D_OK)
+		{
+			PVR2D_DPF((PVR_DBG_ERROR, "PVR2DBltBatch: blit %lu rejected (%d)", i, ePVR2DResult));
+			PVR2DFree(psContext, psBlits);
+			return ePVR2DResult;
+		}
+	}
+
+	for (i = 0; i < ulNumBlts; i = j)
+	{
+		SGX_QUEUETRANSFER sBatch;
+		IMG_UINT32 ui32NumRects = 1;
+		IMG_BOOL bClipCopy;
+
+		if (!pbVisible[i])
+		{
+			j = i + 1;
+			continue;
+		}
+
+		bClipCopy = AltBltIsClipCopy(&psBlits[i]);
+		asRects[0] = SGX_QUEUETRANSFER_DST_RECT(psBlits[i], 0);
+
+		// Gather the run of blits that can share a transfer
+		for (j = i + 1; j < ulNumBlts; j++)
+		{
+			if (!pbVisible[j] ||
+				!AltBltCanMerge(&pBltInfo[i], &psBlits[i], &pBltInfo[j], &psBlits[j]))
+			{
+				break;
+			}
+			if (AltBltJoinRect(&asRects[ui32NumRects - 1], &SGX_QUEUETRANSFER_DST_RECT(psBlits[j], 0)))
+			{
+				continue;
+			}
+			if (!bClipCopy || !AltBltIsClipCopy(&psBlits[j]) || (ui32NumRects == PVR2D_BATCH_MAX_CLIP_RECTS))
+			{
+				break;
+			}
+			asRects[ui32NumRects++] = SGX_QUEUETRANSFER_DST_RECT(psBlits[j], 0);
+		}
+
+		if (j == i + 1)
+		{
+			ePVR2DResult = AltBltSubmit(psContext, &pBltInfo[i], &psBlits[i]);
+			if (ePVR2DResult != PVR2D_OK)
+			{
+				break;
+			}
+			ulSubmitted++;
+			continue;
+		}
+
+		sBatch = psBlits[i];
+
+		if (ui32NumRects == 1)
+		{
+			// One rectangle covers the run; the source moves with it
+			IMG_INT32 i32OffsetX = SGX_QUEUETRANSFER_SRC_RECT(sBatch, 0).x0 - SGX_QUEUETRANSFER_DST_RECT(sBatch, 0).x0;
+			IMG_INT32 i32OffsetY = SGX_QUEUETRANSFER_SRC_RECT(sBatch, 0).y0 - SGX_QUEUETRANSFER_DST_RECT(sBatch, 0).y0;
+
+			SGX_QUEUETRANSFER_DST_RECT(sBatch, 0) = asRects[0];
+			if (sBatch.ui32NumSources)
+			{
+				SGX_QUEUETRANSFER_SRC_RECT(sBatch, 0).x0 = asRects[0].x0 + i32OffsetX;
+				SGX_QUEUETRANSFER_SRC_RECT(sBatch, 0).x1 = asRects[0].x1 + i32OffsetX;
+				SGX_QUEUETRANSFER_SRC_RECT(sBatch, 0).y0 = asRects[0].y0 + i32OffsetY;
+				SGX_QUEUETRANSFER_SRC_RECT(sBatch, 0).y1 = asRects[0].y1 + i32OffsetY;
+			}
+		}
+		else
+		{
+			IMG_RECT *psBounds = &SGX_QUEUETRANSFER_DST_RECT(sBatch, 0);
+
+			// The dest rect bounds the clip rects, which are drawn in one pass
+			*psBounds = asRects[0];
+			for (k = 1; k < ui32NumRects; k++)
+			{
+				psBounds->x0 = PVR2D_MIN(psBounds->x0, asRects[k].x0);
+				psBounds->y0 = PVR2D_MIN(psBounds->y0, asRects[k].y0);
+				psBounds->x1 = PVR2D_MAX(psBounds->x1, asRects[k].x1);
+				psBounds->y1 = PVR2D_MAX(psBounds->y1, asRects[k].y1);
+			}
+			SGX_QUEUETRANSFER_SRC_RECT(sBatch, 0) = *psBounds;
+
+			sBatch.eType = SGXTQ_CLIP_BLIT;
+			PVRSRVMemSet(&sBatch.Details, 0, sizeof(sBatch.Details));
+			sBatch.Details.sClipBlit.psRects = asRects;
+			sBatch.Details.sClipBlit.ui32RectNum = ui32NumRects;
+			sBatch.Details.sClipBlit.bUseSrcRectsForTexCoords = IMG_FALSE;
+		}
+
+		ePVR2DResult = AltBltSubmit(psContext, &pBltInfo[i], &sBatch);
+
+		if ((ePVR2DResult != PVR2D_OK) && (ePVR2DResult != PVR2DERROR_DEVICE_UNAVAILABLE))
+		{
+			// Not every path takes a clip blit; queue the run as it came
+			PVR2D_DPF((PVR_DBG_WARNING, "PVR2DBltBatch: merged blit failed, queueing %lu blits separately", j - i));
+
+			for (k = i; k < j; k++)
+			{
+				ePVR2DResult = AltBltSubmit(psContext, &pBltInfo[k], &psBlits[k]);
+				if (ePVR2DResult != PVR2D_OK)
+				{
+					break;
+				}
+				ulSubmitted++;
+			}
+		}
+		else if (ePVR2DResult == PVR2D_OK)
+		{
+			ulMerged += j - i - 1;
+			ulSubmitted++;
+		}
+
+		if (ePVR2DResult != PVR2D_OK)
+		{
+			break;
+		}
+	}
+
+	PVR2DFree(psContext, psBlits);
+
+	if (psStats)
+	{
+		psStats->ulNumBlts = ulNumBlts;
+		psStats->ulNumMerged = ulMerged;
+		psStats->ulNumSubmitted = ulSubmitted;
+	}
+
+	return ePVR2DResult;
+
+}// AltBltBatch
+
+
 #endif // #if defined(PVR2D_ALT_2DHW)
 
 #if defined(PVR2D_VALIDATE_INPUT_PARAMS)
@@ -232,59 +232,6 @@ static IMG_VOID GetCoreAndRevisionNumber(IMG_UINT16 * u16Core, IMG_UINT16 * u16R
 	*u16Revision = SGXBS_CORE_REVISION;
 }
 
-static IMG_UINT32 GetNumOfBytesForWritingArrayHeader(IMG_VOID)
-{
-	/* An array header is just a 16-bit unsigned integer.  See WriteArrayHeader. */
-	return 2;
-}
-
-static IMG_UINT32 GetNumOfBytesForWritingBindings(const GLSLBindingSymbol * psBindingSymbols, IMG_UINT32 ui32NumSymbols)
-{
-	IMG_UINT32 i;
-	const GLSLBindingSymbol * psSymbols;
-	IMG_UINT32 ui32Count = GetNumOfBytesForWritingArrayHeader(); /* array header */
-
-	psSymbols = psBindingSymbols;
-
-	for(i = 0; i < ui32NumSymbols; i++)
-	{
-		ui32Count += (strlen(psSymbols->pszName) +1); 
-		ui32Count += 2; /* ID */
-		ui32Count += 1; /* specifier */
-		ui32Count += 1; /* qualifier */
-		ui32Count += 1; /* precision */
-		ui32Count += 1; /* varying flags */
-		ui32Count += 2; /* active array size */
-		ui32Count += 2; /* declared array size */
-		ui32Count += 1; /* reg type */
-		ui32Count += 2; /* union */
-		ui32Count += 1; /* alloc count */
-		ui32Count += 2; /* CompUseMask */
-		
-		ui32Count += GetNumOfBytesForWritingBindings(psSymbols->psBaseTypeMembers, psSymbols->uNumBaseTypeMembers);
-
-		psSymbols++;
-	}
-
-	return ui32Count;
-}
-
-static IMG_UINT32 GetNumOfBytesForWritingUserBindings(const GLSLAttribUserBinding* psUserBinding)
-{
-	IMG_UINT32 ui32Count = GetNumOfBytesForWritingArrayHeader(); /* array header */
-	const GLSLAttribUserBinding* psBinding = psUserBinding;
-
-	while(psBinding)
-	{
-		ui32Count += (strlen(psBinding->pszName) +1); /* name */
-		ui32Count += 4; /*index */
-
-		psBinding = psBinding->psNext;
-	}
-
-	return ui32Count;
-}
-
 static IMG_VOID WriteString(SGXBS_Buffer *psBuffer, IMG_CHAR *pszString)
 {
 	IMG_UINT32 ui32Length = strlen(pszString) + 1;
@@ -613,32 +560,6 @@ static SGXBS_Error PackUniflexProgram(const GLSLCompiledUniflexProgram *psShader
 	return SGXBS_NO_ERROR;
 }
 
-static SGXBS_Error PackUserBindings(const GLSLAttribUserBinding* psUserBinding, SGXBS_Buffer* psBuffer)
-{
-	IMG_UINT32 u32Bindings =0, u32ArraysPosition, u32LastPosition;
-	const GLSLAttribUserBinding* psBinding = psUserBinding;
-
-	u32ArraysPosition = psBuffer->u32CurrentPosition;
-	/* Write bogus array header */
-	WriteArrayHeader(psBuffer, 0xBEEF);
-
-	while(psBinding)
-	{
-		WriteString(psBuffer, psBinding->pszName);
-		WriteU32(psBuffer, psBinding->i32Index);
-
-		u32Bindings++;
-		psBinding = psBinding->psNext;
-	}
-
-	u32LastPosition = psBuffer->u32CurrentPosition;
-	psBuffer->u32CurrentPosition = u32ArraysPosition;
-	WriteArrayHeader(psBuffer, u32Bindings);
-	psBuffer->u32CurrentPosition = u32LastPosition;
-
-	return SGXBS_NO_ERROR;
-}
-
 static SGXBS_Error PackRevision(const GLSLCompiledUniflexProgram* psShader, SGXBS_Buffer* psBuffer)
 {
 	IMG_UINT32   u32MainRevisionBodyPosition, u32MainRevisionSizePosition, u32LastPosition;
@@ -766,113 +687,364 @@ static SGXBS_Error PackBinary(const GLSLCompiledUniflexProgram* psShader, SGXBS_
 	return SGXBS_NO_ERROR;
 }
 
-static SGXBS_Error PackProgramBinary(const GLSLCompiledUniflexProgram* psVertex, const GLSLCompiledUniflexProgram* psFragment, const GLSLAttribUserBinding* psUserBinding, SGXBS_Buffer* psBuffer)
+/*
+** Used to keep track of a program binary written in the Program Binary Format version 2.
+*/
+typedef struct SGXBS_V2WriterTAG
 {
-	SGXBS_Error  eError = SGXBS_NO_ERROR; 
-	SGXBS_Hash   sHash;
-	IMG_UINT16 u16Core = 0, u16CoreRevision = 0;
-	IMG_UINT32 u32HashPosition, u32FirstRevisionHeaderPosition, u32MainRevisionSizePosition, u32MainRevisionBodyPosition, u32LastPosition;	
+	/* IMG_NULL while the binary is only being measured */
+	IMG_UINT8                       *pu8Buffer;
+
+	SGXBS_V2Section                 asSections[SGXBS_V2_NUM_SECTION_TYPES];
+	IMG_UINT32                      u32LengthInBytes;
 
-	if(!psVertex || !psFragment ||  !psBuffer)
+	/* Current write positions in the sections */
+	IMG_UINT32                      u32UseCodePosition;
+	IMG_UINT32                      u32ConstantPosition;
+	IMG_UINT32                      u32SymbolPosition;
+	IMG_UINT32                      u32StringPosition;
+
+	IMG_BOOL                        bInvalidArgument;
+
+} SGXBS_V2Writer;
+
+static IMG_UINT32 CountSymbolRecordsV2(const GLSLBindingSymbol *psSymbols, IMG_UINT32 u32NumSymbols)
+{
+	IMG_UINT32 i, u32Count = u32NumSymbols;
+
+	for(i = 0; i < u32NumSymbols; i++)
 	{
-		return SGXBS_INVALID_ARGUMENTS_ERROR;
+		u32Count += CountSymbolRecordsV2(psSymbols[i].psBaseTypeMembers, psSymbols[i].uNumBaseTypeMembers);
 	}
 
-	GetCoreAndRevisionNumber(&u16Core, &u16CoreRevision);
+	return u32Count;
+}
 
-	/************************************************
-		Write the meta data 1 (magic number and hash) 
-	*************************************************/
+static IMG_UINT32 GetSymbolNamesLengthV2(const GLSLBindingSymbol *psSymbols, IMG_UINT32 u32NumSymbols)
+{
+	IMG_UINT32 i, u32Length = 0;
 
-	/* 1- Write the magic header number */
-	WriteU32(psBuffer, SGXBS_HEADER_MAGIC_NUMBER);
+	for(i = 0; i < u32NumSymbols; i++)
+	{
+		u32Length += strlen(psSymbols[i].pszName) + 1;
+		u32Length += GetSymbolNamesLengthV2(psSymbols[i].psBaseTypeMembers, psSymbols[i].uNumBaseTypeMembers);
+	}
 
-	/* 2- Get the current position. Write a bogus hash that will be overwritten later */
-	u32HashPosition = psBuffer->u32CurrentPosition;
-	WriteU32(psBuffer, 0xDEADBEEF);
+	return u32Length;
+}
 
-	/************************************************
-		Write the meta data 2 (revision data) 
-	*************************************************/
-	u32FirstRevisionHeaderPosition = psBuffer->u32CurrentPosition;
-	
-	/* Fill in the main revision header. */
+static IMG_UINT32 GetUniPatchInputLengthV2(const IMG_VOID *pvUniPatchInput)
+{
+	if(!pvUniPatchInput)
+	{
+		return 0;
+	}
 
-	/* 3  - Software version */
-	WriteU16(psBuffer, SGXBS_SOFTWARE_VERSION_1);
+	return SGXBS_UNIPATCH_HEADER_SIZE + ((const struct _USP_PC_SHADER_ *)pvUniPatchInput)->uSize;
+}
 
-	/* 4- Major hardware version */
-	WriteU16(psBuffer, u16Core);
+/*
+** Works out the size of every section and places them one after the other.
+*/
+static IMG_VOID LayoutProgramBinaryV2(const GLSLCompiledUniflexProgram* psVertex, const GLSLCompiledUniflexProgram* psFragment,
+									  const GLSLAttribUserBinding* psUserBinding, SGXBS_V2Writer *psWriter)
+{
+	const GLSLCompiledUniflexProgram *apsShaders[2];
+	const GLSLAttribUserBinding      *psBinding;
+	IMG_UINT32                        i, u32Position, u32NumUserBindings = 0;
 
-	/* 5- Hardware core revision */
-	WriteU16(psBuffer, u16CoreRevision);
+	apsShaders[0] = psVertex;
+	apsShaders[1] = psFragment;
 
-	/* 6- Write a zeroed 16-bit reserved word */
-	WriteU16(psBuffer, 0);
+	memset(psWriter->asSections, 0, sizeof(psWriter->asSections));
 
-	/* 7- Used to be a 32-bit hash of the project version string. Not used any more in favour of
-	 * items 8 and 9 below
-	 */
-	WriteU32(psBuffer, 0);
+	for(i = 0; i < SGXBS_V2_NUM_SECTION_TYPES; i++)
+	{
+		psWriter->asSections[i].u32Type = i;
+	}
 
-	/* 8- GLSL compiled Uniflex program interface version */
-	WriteU32(psBuffer, GLSL_COMPILED_UNIFLEX_INTERFACE_VER);
+	psWriter->asSections[SGXBS_V2_SECTION_VERTEX_INFO].u32LengthInBytes   = SGXBS_V2ShaderInfo_size;
+	psWriter->asSections[SGXBS_V2_SECTION_FRAGMENT_INFO].u32LengthInBytes = SGXBS_V2ShaderInfo_size;
 
-	/* 9- USP_PC_SHADER version */
-	WriteU32(psBuffer, USP_PC_SHADER_VER);
+	for(i = 0; i < 2; i++)
+	{
+		const GLSLUniFlexCode       *psCode = apsShaders[i]->psUniFlexCode;
+		const GLSLBindingSymbolList *psSymbolList = apsShaders[i]->psBindingSymbolList;
+		IMG_UINT32                   u32NumRecords;
 
-	/* 10- Write a bogus revision size to be overwritten later */
-	u32MainRevisionSizePosition =  psBuffer->u32CurrentPosition;
-	WriteU32(psBuffer, 0xDEADBEEF);
-	u32MainRevisionBodyPosition = psBuffer->u32CurrentPosition;
+		psWriter->asSections[SGXBS_V2_SECTION_USE_CODE].u32LengthInBytes +=
+			SGXBS_V2_ALIGN(GetUniPatchInputLengthV2(psCode->psUniPatchInput), 4);
+
+		if(apsShaders[i]->eProgramType == GLSLPT_FRAGMENT)
+		{
+			psWriter->asSections[SGXBS_V2_SECTION_USE_CODE].u32LengthInBytes +=
+				SGXBS_V2_ALIGN(GetUniPatchInputLengthV2(psCode->psUniPatchInputMSAATrans), 4);
+		}
 
-	/************************************************
-		Write the data 
-	*************************************************/
+		if(psSymbolList->uNumCompsUsed > SGXBS_V2_MAX_ELEMENTS)
+		{
+			psWriter->bInvalidArgument = IMG_TRUE;
+		}
 
-	/* 11- pack vertex shader info */
-	eError = PackUniflexProgram(psVertex, psBuffer);
+		psWriter->asSections[SGXBS_V2_SECTION_CONSTANTS].u32LengthInBytes += psSymbolList->uNumCompsUsed * sizeof(IMG_FLOAT);
 
-	/* 12- pack fragment shader info */
-	eError = PackUniflexProgram(psFragment, psBuffer);
+		u32NumRecords = CountSymbolRecordsV2(psSymbolList->psBindingSymbolEntries, psSymbolList->uNumBindings);
 
-	/* 13- pack user bindings info */
-	eError = PackUserBindings(psUserBinding, psBuffer);
+		if(u32NumRecords > SGXBS_V2_MAX_ELEMENTS)
+		{
+			psWriter->bInvalidArgument = IMG_TRUE;
+		}
 
-	/************************************************
-		Write revision size and hash 
-	*************************************************/
+		psWriter->asSections[SGXBS_V2_SECTION_SYMBOLS].u32LengthInBytes += u32NumRecords * SGXBS_V2Symbol_size;
 
-	/* Rewrite the revision size now that we know it. */
-	u32LastPosition = psBuffer->u32CurrentPosition;
-	psBuffer->u32CurrentPosition = u32MainRevisionSizePosition;
-	WriteU32(psBuffer, u32LastPosition - u32MainRevisionBodyPosition);
-	psBuffer->u32CurrentPosition = u32LastPosition;
-	
-	/* Compute the hash of all the binary except for the binary header */
-	sHash = SGXBS_ComputeHash(&psBuffer->pu8Buffer[u32FirstRevisionHeaderPosition], 
-	                          psBuffer->u32CurrentPosition - u32FirstRevisionHeaderPosition);
+		psWriter->asSections[SGXBS_V2_SECTION_STRINGS].u32LengthInBytes +=
+			GetSymbolNamesLengthV2(psSymbolList->psBindingSymbolEntries, psSymbolList->uNumBindings);
+	}
 
-	/* Rewind to the place where we'll overwrite the bogus hash */
-	u32LastPosition = psBuffer->u32CurrentPosition;
-	psBuffer->u32CurrentPosition = u32HashPosition;
+	for(psBinding = psUserBinding; psBinding; psBinding = psBinding->psNext)
+	{
+		psWriter->asSections[SGXBS_V2_SECTION_STRINGS].u32LengthInBytes += strlen(psBinding->pszName) + 1;
+		u32NumUserBindings++;
+	}
 
-	WriteU32(psBuffer, sHash.u32Hash);
+	if(u32NumUserBindings > SGXBS_V2_MAX_ELEMENTS)
+	{
+		psWriter->bInvalidArgument = IMG_TRUE;
+	}
 
-	/* Go back to the end of the written data */
-	psBuffer->u32CurrentPosition = u32LastPosition;
+	psWriter->asSections[SGXBS_V2_SECTION_USER_BINDINGS].u32LengthInBytes = u32NumUserBindings * SGXBS_V2UserBinding_size;
 
-	if(psBuffer->bOverflow)
+	/* Place the sections after the header and the section table */
+	u32Position = SGXBS_V2Header_size + SGXBS_V2_NUM_SECTION_TYPES * SGXBS_V2Section_size;
+
+	for(i = 0; i < SGXBS_V2_NUM_SECTION_TYPES; i++)
 	{
-		return SGXBS_OUT_OF_MEMORY_ERROR;
+		u32Position = SGXBS_V2_ALIGN(u32Position, SGXBS_V2_SECTION_ALIGNMENT);
+
+		psWriter->asSections[i].u32Offset = u32Position;
+
+		u32Position += psWriter->asSections[i].u32LengthInBytes;
 	}
 
-	if(psBuffer->bInvalidArgument)
+	psWriter->u32LengthInBytes = u32Position;
+}
+
+static IMG_UINT32 WriteStringV2(SGXBS_V2Writer *psWriter, const IMG_CHAR *pszString)
+{
+	IMG_UINT32 u32Offset = psWriter->u32StringPosition;
+	IMG_UINT32 u32Length = strlen(pszString) + 1;
+
+	memcpy(&psWriter->pu8Buffer[psWriter->asSections[SGXBS_V2_SECTION_STRINGS].u32Offset + u32Offset], pszString, u32Length);
+
+	psWriter->u32StringPosition += u32Length;
+
+	return u32Offset;
+}
+
+/*
+** Writes an array of symbols at record u32Index (relative to psWriter->u32SymbolPosition)
+** and their members at the records reserved from *pu32NextFreeRecord onwards.
+*/
+static IMG_VOID PackSymbolsV2(SGXBS_V2Writer *psWriter, const GLSLBindingSymbol *psSymbols, IMG_UINT32 u32NumSymbols,
+							  IMG_UINT32 u32Index, IMG_UINT32 *pu32NextFreeRecord)
+{
+	SGXBS_V2Symbol sRecord;
+	IMG_UINT32     i, u32RecordOffset;
+
+	for(i = 0; i < u32NumSymbols; i++, psSymbols++)
+	{
+		if(((IMG_UINT32)psSymbols->eBIVariableID > 0xFFFF)                  ||
+		   ((IMG_UINT32)psSymbols->eTypeSpecifier > 0xFF)                   ||
+		   ((IMG_UINT32)psSymbols->eTypeQualifier > 0xFF)                   ||
+		   ((IMG_UINT32)psSymbols->ePrecisionQualifier > 0xFF)              ||
+		   ((IMG_UINT32)psSymbols->eVaryingModifierFlags > 0xFF)            ||
+		   ((IMG_UINT32)psSymbols->iActiveArraySize > 0xFFFF)               ||
+		   ((IMG_UINT32)psSymbols->iDeclaredArraySize > 0xFFFF)             ||
+		   ((IMG_UINT32)psSymbols->sRegisterInfo.eRegType > 0xFF)           ||
+		   (psSymbols->sRegisterInfo.u.uBaseComp > 0xFFFF)                  ||
+		   (psSymbols->sRegisterInfo.uCompAllocCount > 0xFF)                ||
+		   (psSymbols->sRegisterInfo.ui32CompUseMask > 0xFFFF)              ||
+		   (psSymbols->uNumBaseTypeMembers && psSymbols->eTypeSpecifier != GLSLTS_STRUCT))
+		{
+			psWriter->bInvalidArgument = IMG_TRUE;
+			return;
+		}
+
+		sRecord.u32NameOffset          = WriteStringV2(psWriter, psSymbols->pszName);
+		sRecord.u16BIVariableID        = (IMG_UINT16)psSymbols->eBIVariableID;
+		sRecord.u8TypeSpecifier        = (IMG_UINT8)psSymbols->eTypeSpecifier;
+		sRecord.u8TypeQualifier        = (IMG_UINT8)psSymbols->eTypeQualifier;
+		sRecord.u8PrecisionQualifier   = (IMG_UINT8)psSymbols->ePrecisionQualifier;
+		sRecord.u8VaryingModifierFlags = (IMG_UINT8)psSymbols->eVaryingModifierFlags;
+		sRecord.u8RegType              = (IMG_UINT8)psSymbols->sRegisterInfo.eRegType;
+		sRecord.u8CompAllocCount       = (IMG_UINT8)psSymbols->sRegisterInfo.uCompAllocCount;
+		sRecord.u16ActiveArraySize     = (IMG_UINT16)psSymbols->iActiveArraySize;
+		sRecord.u16DeclaredArraySize   = (IMG_UINT16)psSymbols->iDeclaredArraySize;
+		sRecord.u16BaseComp            = (IMG_UINT16)psSymbols->sRegisterInfo.u.uBaseComp;
+		sRecord.u16CompUseMask         = (IMG_UINT16)psSymbols->sRegisterInfo.ui32CompUseMask;
+
+		/* Reserve the records of the members before any deeper member gets its own */
+		sRecord.u32FirstMember         = *pu32NextFreeRecord;
+		sRecord.u32NumMembers          = psSymbols->uNumBaseTypeMembers;
+
+		*pu32NextFreeRecord += psSymbols->uNumBaseTypeMembers;
+
+		u32RecordOffset = psWriter->asSections[SGXBS_V2_SECTION_SYMBOLS].u32Offset +
+						  (psWriter->u32SymbolPosition + u32Index + i) * SGXBS_V2Symbol_size;
+
+		memcpy(&psWriter->pu8Buffer[u32RecordOffset], &sRecord, SGXBS_V2Symbol_size);
+
+		PackSymbolsV2(psWriter, psSymbols->psBaseTypeMembers, psSymbols->uNumBaseTypeMembers, sRecord.u32FirstMember, pu32NextFreeRecord);
+	}
+}
+
+static IMG_VOID PackUniPatchInputV2(SGXBS_V2Writer *psWriter, const IMG_VOID *pvUniPatchInput, IMG_UINT32 *pu32Offset, IMG_UINT32 *pu32Length)
+{
+	IMG_UINT32 u32Length = GetUniPatchInputLengthV2(pvUniPatchInput);
+
+	*pu32Offset = psWriter->u32UseCodePosition;
+	*pu32Length = u32Length;
+
+	if(u32Length)
+	{
+		memcpy(&psWriter->pu8Buffer[psWriter->asSections[SGXBS_V2_SECTION_USE_CODE].u32Offset + psWriter->u32UseCodePosition],
+			   pvUniPatchInput, u32Length);
+
+		psWriter->u32UseCodePosition += SGXBS_V2_ALIGN(u32Length, 4);
+	}
+}
+
+static IMG_VOID PackShaderV2(SGXBS_V2Writer *psWriter, const GLSLCompiledUniflexProgram *psShader, IMG_UINT32 u32InfoSection)
+{
+	const GLSLUniFlexCode       *psCode = psShader->psUniFlexCode;
+	const GLSLBindingSymbolList *psSymbolList = psShader->psBindingSymbolList;
+	SGXBS_V2ShaderInfo           sInfo;
+	IMG_UINT32                   i, u32NextFreeRecord;
+
+	memset(&sInfo, 0, sizeof(sInfo));
+
+	if(!psShader->bSuccessfullyCompiled || !psCode->psUniPatchInput ||
+	   (psSymbolList->uNumCompsUsed && !psSymbolList->pfConstantData) ||
+	   (psSymbolList->uNumBindings && !psSymbolList->psBindingSymbolEntries))
+	{
+		psWriter->bInvalidArgument = IMG_TRUE;
+		return;
+	}
+
+	sInfo.u32ProgramType       = psShader->eProgramType;
+	sInfo.u32ProgramFlags      = psShader->eProgramFlags;
+	sInfo.u32ActiveVaryingMask = psCode->eActiveVaryingMask;
+
+	for(i = 0; i < SGXBS_NUM_TC_REGISTERS; ++i)
+	{
+		/* As in format 1, uninitialised entries are written as zero */
+		sInfo.au8TexCoordDims[i]       = (psCode->auTexCoordDims[i] > 0xFF) ? 0 : (IMG_UINT8)psCode->auTexCoordDims[i];
+		sInfo.au8TexCoordPrecisions[i] = ((IMG_UINT32)psCode->aeTexCoordPrecisions[i] > 0xFF) ? 0 : (IMG_UINT8)psCode->aeTexCoordPrecisions[i];
+	}
+
+	PackUniPatchInputV2(psWriter, psCode->psUniPatchInput, &sInfo.u32UniPatchOffset, &sInfo.u32UniPatchLength);
+
+	if(psShader->eProgramType == GLSLPT_FRAGMENT)
+	{
+		PackUniPatchInputV2(psWriter, psCode->psUniPatchInputMSAATrans, &sInfo.u32UniPatchMSAATransOffset, &sInfo.u32UniPatchMSAATransLength);
+	}
+
+	/* Constants */
+	sInfo.u32FirstConstant = psWriter->u32ConstantPosition;
+	sInfo.u32NumConstants  = psSymbolList->uNumCompsUsed;
+
+	if(psSymbolList->uNumCompsUsed)
+	{
+		memcpy(&psWriter->pu8Buffer[psWriter->asSections[SGXBS_V2_SECTION_CONSTANTS].u32Offset + psWriter->u32ConstantPosition * sizeof(IMG_FLOAT)],
+			   psSymbolList->pfConstantData, psSymbolList->uNumCompsUsed * sizeof(IMG_FLOAT));
+	}
+
+	psWriter->u32ConstantPosition += psSymbolList->uNumCompsUsed;
+
+	/* Symbols: the top-level array first, the members after it */
+	u32NextFreeRecord = psSymbolList->uNumBindings;
+
+	PackSymbolsV2(psWriter, psSymbolList->psBindingSymbolEntries, psSymbolList->uNumBindings, 0, &u32NextFreeRecord);
+
+	sInfo.u32FirstSymbol      = psWriter->u32SymbolPosition;
+	sInfo.u32NumSymbols       = psSymbolList->uNumBindings;
+	sInfo.u32NumSymbolRecords = u32NextFreeRecord;
+
+	psWriter->u32SymbolPosition += u32NextFreeRecord;
+
+	memcpy(&psWriter->pu8Buffer[psWriter->asSections[u32InfoSection].u32Offset], &sInfo, SGXBS_V2ShaderInfo_size);
+}
+
+static SGXBS_Error PackProgramBinaryV2(const GLSLCompiledUniflexProgram* psVertex, const GLSLCompiledUniflexProgram* psFragment,
+									   const GLSLAttribUserBinding* psUserBinding, SGXBS_V2Writer *psWriter)
+{
+	const GLSLAttribUserBinding *psBinding;
+	SGXBS_V2Header               sHeader;
+	SGXBS_V2UserBinding          sUserBinding;
+	SGXBS_Hash                   sHash;
+	IMG_UINT32                   i, u32BindingOffset;
+
+	psWriter->u32UseCodePosition  = 0;
+	psWriter->u32ConstantPosition = 0;
+	psWriter->u32SymbolPosition   = 0;
+	psWriter->u32StringPosition   = 0;
+
+	/* Shaders */
+	PackShaderV2(psWriter, psVertex, SGXBS_V2_SECTION_VERTEX_INFO);
+	PackShaderV2(psWriter, psFragment, SGXBS_V2_SECTION_FRAGMENT_INFO);
+
+	if(psWriter->bInvalidArgument)
 	{
 		return SGXBS_INVALID_ARGUMENTS_ERROR;
 	}
 
-	return eError;
+	/* User bindings, in list order */
+	u32BindingOffset = psWriter->asSections[SGXBS_V2_SECTION_USER_BINDINGS].u32Offset;
+
+	for(psBinding = psUserBinding; psBinding; psBinding = psBinding->psNext)
+	{
+		sUserBinding.u32NameOffset = WriteStringV2(psWriter, psBinding->pszName);
+		sUserBinding.i32Index      = psBinding->i32Index;
+
+		memcpy(&psWriter->pu8Buffer[u32BindingOffset], &sUserBinding, SGXBS_V2UserBinding_size);
+
+		u32BindingOffset += SGXBS_V2UserBinding_size;
+	}
+
+	/* Hash every section */
+	for(i = 0; i < SGXBS_V2_NUM_SECTION_TYPES; i++)
+	{
+		sHash = SGXBS_ComputeHash(&psWriter->pu8Buffer[psWriter->asSections[i].u32Offset], psWriter->asSections[i].u32LengthInBytes);
+
+		psWriter->asSections[i].u32Hash = sHash.u32Hash;
+	}
+
+	memcpy(&psWriter->pu8Buffer[SGXBS_V2Header_size], psWriter->asSections, SGXBS_V2_NUM_SECTION_TYPES * SGXBS_V2Section_size);
+
+	/* Header */
+	sHeader.u32Magic               = SGXBS_HEADER_MAGIC_NUMBER_V2;
+	sHeader.u32HeaderHash          = 0;
+	sHeader.u16SoftwareVersion     = SGXBS_SOFTWARE_VERSION_2;
+	sHeader.u16Core                = 0;
+	sHeader.u16CoreRevision        = 0;
+	sHeader.u16Reserved            = 0;
+	sHeader.u32DDKBuild            = PVRVERSION_BUILD;
+	sHeader.u32CompiledGLSLVersion = GLSL_COMPILED_UNIFLEX_INTERFACE_VER;
+	sHeader.u32USPPCShaderVersion  = USP_PC_SHADER_VER;
+	sHeader.u32LengthInBytes       = psWriter->u32LengthInBytes;
+	sHeader.u32NumSections         = SGXBS_V2_NUM_SECTION_TYPES;
+
+	GetCoreAndRevisionNumber(&sHeader.u16Core, &sHeader.u16CoreRevision);
+
+	memcpy(psWriter->pu8Buffer, &sHeader, SGXBS_V2Header_size);
+
+	/* The header hash covers everything after itself up to the end of the section table */
+	sHash = SGXBS_ComputeHash(&psWriter->pu8Buffer[2 * sizeof(IMG_UINT32)],
+							  SGXBS_V2Header_size + SGXBS_V2_NUM_SECTION_TYPES * SGXBS_V2Section_size - 2 * sizeof(IMG_UINT32));
+
+	memcpy(&psWriter->pu8Buffer[sizeof(IMG_UINT32)], &sHash.u32Hash, sizeof(IMG_UINT32));
+
+	return SGXBS_NO_ERROR;
 }
 
 
@@ -960,7 +1132,7 @@ IMG_EXPORT
 SGXBS_Error SGXBS_CreateBinaryProgram(const GLSLCompiledUniflexProgram* psVertex, const GLSLCompiledUniflexProgram* psFragment, const GLSLAttribUserBinding* psUserBinding,
 										IMG_UINT32 u32BinarySizeInBytes, IMG_UINT32 * ui32Length, IMG_VOID* pvBinaryShader, IMG_BOOL bCreateBinary)
 {
-	SGXBS_Buffer          sBuffer;
+	SGXBS_V2Writer        sWriter;
 	SGXBS_Error           eError = SGXBS_NO_ERROR;
 
 	if(!psVertex || !psFragment || !pvBinaryShader || (u32BinarySizeInBytes <= 0))
@@ -978,76 +1150,42 @@ SGXBS_Error SGXBS_CreateBinaryProgram(const GLSLCompiledUniflexProgram* psVertex
 		return SGXBS_INTERNAL_ERROR;
 	}
 
+	/* Program binaries are written in the Program Binary Format version 2 */
+	memset(&sWriter, 0, sizeof(sWriter));
+
+	LayoutProgramBinaryV2(psVertex, psFragment, psUserBinding, &sWriter);
+
+	if(sWriter.bInvalidArgument)
+	{
+		return SGXBS_INVALID_ARGUMENTS_ERROR;
+	}
+
 	/* create the binary if boolean is true... */
 	if(bCreateBinary)
 	{
-		/* Fill the buffer with zeroes to minimize the damage caused by potential bugs */
-		memset(pvBinaryShader, 0, u32BinarySizeInBytes);
+		if(sWriter.u32LengthInBytes > u32BinarySizeInBytes)
+		{
+			return SGXBS_OUT_OF_MEMORY_ERROR;
+		}
 
-		sBuffer.pu8Buffer            = pvBinaryShader;
-		sBuffer.u32CurrentPosition   = 0;
-		sBuffer.u32BufferSizeInBytes = u32BinarySizeInBytes;
-		sBuffer.bOverflow            = IMG_FALSE;
-		sBuffer.bInvalidArgument     = IMG_FALSE;
+		/* Fill the buffer with zeroes so that the padding between sections is zero */
+		memset(pvBinaryShader, 0, sWriter.u32LengthInBytes);
+
+		sWriter.pu8Buffer = pvBinaryShader;
 
-		eError = PackProgramBinary(psVertex, psFragment, psUserBinding, &sBuffer);
+		eError = PackProgramBinaryV2(psVertex, psFragment, psUserBinding, &sWriter);
 
 		if(eError == SGXBS_NO_ERROR)
 		{
 			if(ui32Length)
 			{
-				*ui32Length = sBuffer.u32CurrentPosition;
+				*ui32Length = sWriter.u32LengthInBytes;
 			}
 		}
 	}
 	else /* ... otherwise just return what would be the binary size */
 	{	
-		IMG_UINT32 ui32MetaData1, ui32MetaData2, ui32DataVertex, ui32DataFragment, ui32DataUserBindings;
-		struct _USP_PC_SHADER_  *psUniPatchInput, *psUniPatchInputMSAATrans;
-		GLSLBindingSymbolList    *psSymbolList; 
-
-		/* FIXME! use asserts and defines */
-		ui32MetaData1 = SGXBS_METADATA_1*sizeof(IMG_UINT32);
-		ui32MetaData2 = SGXBS_METADATA_2*sizeof(IMG_UINT32);
-
-		psUniPatchInput = psVertex->psUniFlexCode->psUniPatchInput; 
-		psSymbolList	= psVertex->psBindingSymbolList;
-
-		/* vertex data size */
-		ui32DataVertex = 3 *sizeof(IMG_UINT32)/* type/flag and reserved */
-						+ 1 *sizeof(IMG_UINT32)/* varying mask */
-						+ (2*SGXBS_NUM_TC_REGISTERS) /* tex dimensions and precisions */;
-
-		ui32DataVertex += 1*sizeof(IMG_UINT32) + SGXBS_UNIPATCH_HEADER_SIZE + psUniPatchInput->uSize;
-		ui32DataVertex += 2/*array header*/ + (psSymbolList->uNumCompsUsed)*sizeof(IMG_FLOAT);
-		ui32DataVertex += GetNumOfBytesForWritingBindings(psSymbolList->psBindingSymbolEntries, psSymbolList->uNumBindings);
-		
-		/* fragment data size */
-		psUniPatchInput				= psFragment->psUniFlexCode->psUniPatchInput;
-		psUniPatchInputMSAATrans	= psFragment->psUniFlexCode->psUniPatchInputMSAATrans;
-		psSymbolList				= psFragment->psBindingSymbolList;
-
-		ui32DataFragment = 3 *sizeof(IMG_UINT32)/* type/flag and reserved */
-						+ 1 *sizeof(IMG_UINT32)/* varying mask */
-						+ (2*SGXBS_NUM_TC_REGISTERS) /* tex dimensions and precisions */
-						+ 1*sizeof(IMG_UINT32) + SGXBS_UNIPATCH_HEADER_SIZE + psUniPatchInput->uSize;
-		
-
-		ui32DataFragment += 2/*array header*/ + (psSymbolList->uNumCompsUsed)*sizeof(IMG_FLOAT);
-		ui32DataFragment += GetNumOfBytesForWritingBindings(psSymbolList->psBindingSymbolEntries, psSymbolList->uNumBindings);
-
-		if(psUniPatchInputMSAATrans)
-		{
-			ui32DataFragment += 1*sizeof(IMG_UINT32) + SGXBS_UNIPATCH_HEADER_SIZE + psUniPatchInputMSAATrans->uSize;
-		}
-		else
-		{
-			ui32DataFragment += 1*sizeof(IMG_UINT32);
-		}
-
-		ui32DataUserBindings = GetNumOfBytesForWritingUserBindings(psUserBinding);
-
-		*ui32Length = ui32MetaData1 + ui32MetaData2 + ui32DataVertex + ui32DataFragment + ui32DataUserBindings; 
+		*ui32Length = sWriter.u32LengthInBytes;
 	}
 
 	return eError;
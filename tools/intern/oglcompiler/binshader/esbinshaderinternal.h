@@ -409,6 +409,182 @@ typedef struct SGXBS_HashTAG
 #endif
 
 
+/* ------------------------------------------------------------------------- */
+/*                   PROGRAM BINARY FORMAT 2 DEFINITIONS                     */
+/* ------------------------------------------------------------------------- */
+
+/*
+ *   Explanation of the Program Binary Format version 2:
+ *
+ *   Format 1 is a byte stream that can only be decoded field by field. Format 2
+ *   is used for program binaries (glGetProgramBinaryOES/glProgramBinaryOES) and
+ *   is laid out so that it can be used straight from the buffer it lives in
+ *   (a file mapped into memory, a blob cache entry, etc.):
+ *
+ *       - Every structure is stored in the native byte order of the driver
+ *         (little-endian on every supported target) and is naturally aligned.
+ *         A binary written with the other byte order is rejected by its magic.
+ *       - Nothing in the binary is a pointer. Structures refer to each other
+ *         with offsets into a section or indices into an array, so the binary
+ *         is relocatable and pointers are fixed up when it is loaded.
+ *       - The data is split into sections, each with its own hash, so the
+ *         driver only touches and checks the sections it needs. Section types
+ *         unknown to a driver are skipped, which allows new sections to be
+ *         added without breaking older drivers.
+ *
+ *   Informal diagram of a Binary in the Program Binary Format version 2:
+ *
+ *   +-------------------------------------------------------------+
+ *   |  struct SGXBS_V2Header                                      |
+ *   +-------------------------------------------------------------+
+ *   |  struct SGXBS_V2Section asSections[u32NumSections]          |
+ *   +-------------------------------------------------------------+
+ *   |  Section data. Each section starts on a                     |
+ *   |  SGXBS_V2_SECTION_ALIGNMENT boundary, the padding is zero.  |
+ *   +-------------------------------------------------------------+
+ *
+ *   u32HeaderHash covers everything after itself up to the end of the section
+ *   table. The hash of every section covers the data of that section only.
+ *
+ *   Sections:
+ *
+ *      SGXBS_V2_SECTION_VERTEX_INFO / SGXBS_V2_SECTION_FRAGMENT_INFO
+ *         One SGXBS_V2ShaderInfo each. Everything the driver needs to know about
+ *         a shader, plus the location of its data in the other sections.
+ *
+ *      SGXBS_V2_SECTION_USE_CODE
+ *         The UniPatch inputs (struct _USP_PC_SHADER_) of both shaders, each
+ *         one aligned to 4 bytes.
+ *
+ *      SGXBS_V2_SECTION_CONSTANTS
+ *         The IEEE 754 constant data of both shaders.
+ *
+ *      SGXBS_V2_SECTION_SYMBOLS
+ *         An array of SGXBS_V2Symbol. The binding symbols of a shader are
+ *         stored contiguously: first the top-level symbols and then, after
+ *         them, the base type members of structs. A member list always comes
+ *         after the symbol that owns it, so a binary can't describe a cycle.
+ *
+ *      SGXBS_V2_SECTION_STRINGS
+ *         Pool of NULL-terminated names, addressed by byte offset. The last
+ *         byte of the pool must be zero.
+ *
+ *      SGXBS_V2_SECTION_USER_BINDINGS
+ *         An array of SGXBS_V2UserBinding (glBindAttribLocation state).
+ *
+ *   Counts of symbols, constants and bindings are limited to 16 bits, as they
+ *   are in format 1.
+ */
+#define SGXBS_HEADER_MAGIC_NUMBER_V2                   ((IMG_UINT32) 0x38B4FA20)
+
+#define SGXBS_SOFTWARE_VERSION_2                       ((IMG_UINT16) 0x0002U)
+
+#define SGXBS_V2_SECTION_ALIGNMENT                     16
+#define SGXBS_V2_MAX_SECTIONS                          16
+#define SGXBS_V2_MAX_ELEMENTS                          0xFFFF
+
+#define SGXBS_V2_SECTION_VERTEX_INFO                   0
+#define SGXBS_V2_SECTION_FRAGMENT_INFO                 1
+#define SGXBS_V2_SECTION_USE_CODE                      2
+#define SGXBS_V2_SECTION_CONSTANTS                     3
+#define SGXBS_V2_SECTION_SYMBOLS                       4
+#define SGXBS_V2_SECTION_STRINGS                       5
+#define SGXBS_V2_SECTION_USER_BINDINGS                 6
+#define SGXBS_V2_NUM_SECTION_TYPES                     7
+
+#define SGXBS_V2_ALIGN(x, a)                           (((x) + ((a) - 1)) & ~((a) - 1))
+
+typedef struct SGXBS_V2HeaderTAG
+{
+	IMG_UINT32                      u32Magic;
+	IMG_UINT32                      u32HeaderHash;
+	IMG_UINT16                      u16SoftwareVersion;
+	IMG_UINT16                      u16Core;
+	IMG_UINT16                      u16CoreRevision;
+	IMG_UINT16                      u16Reserved;
+	IMG_UINT32                      u32DDKBuild;
+	IMG_UINT32                      u32CompiledGLSLVersion;
+	IMG_UINT32                      u32USPPCShaderVersion;
+
+	/* Length of the whole binary, including this header */
+	IMG_UINT32                      u32LengthInBytes;
+	IMG_UINT32                      u32NumSections;
+
+} SGXBS_V2Header;
+
+typedef struct SGXBS_V2SectionTAG
+{
+	IMG_UINT32                      u32Type;
+
+	/* Offset from the start of the binary */
+	IMG_UINT32                      u32Offset;
+	IMG_UINT32                      u32LengthInBytes;
+	IMG_UINT32                      u32Hash;
+
+} SGXBS_V2Section;
+
+typedef struct SGXBS_V2ShaderInfoTAG
+{
+	IMG_UINT32                      u32ProgramType;
+	IMG_UINT32                      u32ProgramFlags;
+	IMG_UINT32                      u32ActiveVaryingMask;
+	IMG_UINT8                       au8TexCoordDims[SGXBS_NUM_TC_REGISTERS];
+	IMG_UINT8                       au8TexCoordPrecisions[SGXBS_NUM_TC_REGISTERS];
+
+	/* Byte offsets and lengths in SGXBS_V2_SECTION_USE_CODE. The MSAA length is zero if there is none. */
+	IMG_UINT32                      u32UniPatchOffset;
+	IMG_UINT32                      u32UniPatchLength;
+	IMG_UINT32                      u32UniPatchMSAATransOffset;
+	IMG_UINT32                      u32UniPatchMSAATransLength;
+
+	/* Float index in SGXBS_V2_SECTION_CONSTANTS */
+	IMG_UINT32                      u32FirstConstant;
+	IMG_UINT32                      u32NumConstants;
+
+	/* Record index in SGXBS_V2_SECTION_SYMBOLS. u32NumSymbolRecords includes the struct members. */
+	IMG_UINT32                      u32FirstSymbol;
+	IMG_UINT32                      u32NumSymbols;
+	IMG_UINT32                      u32NumSymbolRecords;
+
+} SGXBS_V2ShaderInfo;
+
+typedef struct SGXBS_V2SymbolTAG
+{
+	/* Byte offset in SGXBS_V2_SECTION_STRINGS */
+	IMG_UINT32                      u32NameOffset;
+	IMG_UINT16                      u16BIVariableID;
+	IMG_UINT8                       u8TypeSpecifier;
+	IMG_UINT8                       u8TypeQualifier;
+	IMG_UINT8                       u8PrecisionQualifier;
+	IMG_UINT8                       u8VaryingModifierFlags;
+	IMG_UINT8                       u8RegType;
+	IMG_UINT8                       u8CompAllocCount;
+	IMG_UINT16                      u16ActiveArraySize;
+	IMG_UINT16                      u16DeclaredArraySize;
+	IMG_UINT16                      u16BaseComp;
+	IMG_UINT16                      u16CompUseMask;
+
+	/* Index of the first member, relative to the first symbol of the shader */
+	IMG_UINT32                      u32FirstMember;
+	IMG_UINT32                      u32NumMembers;
+
+} SGXBS_V2Symbol;
+
+typedef struct SGXBS_V2UserBindingTAG
+{
+	/* Byte offset in SGXBS_V2_SECTION_STRINGS */
+	IMG_UINT32                      u32NameOffset;
+	IMG_INT32                       i32Index;
+
+} SGXBS_V2UserBinding;
+
+#define SGXBS_V2Header_size            36
+#define SGXBS_V2Section_size           16
+#define SGXBS_V2ShaderInfo_size        68
+#define SGXBS_V2Symbol_size            28
+#define SGXBS_V2UserBinding_size       8
+
+
 /* ------------------------------------------------------------------ */
 /*        Functions shared in the coder and the decoder               */
 /* ------------------------------------------------------------------ */
@@ -505,6 +681,13 @@ static IMG_BOOL SGXBS_TestBinaryShaderInterface(IMG_VOID)
 	SGXBS_CHECK_SIZEOF(IMG_UINT32, 4)
 	SGXBS_CHECK_SIZEOF(IMG_FLOAT,  4)
 
+	/* The format 2 structures are used in place, so they must not contain any padding */
+	SGXBS_CHECK_SIZEOF(SGXBS_V2Header,      SGXBS_V2Header_size)
+	SGXBS_CHECK_SIZEOF(SGXBS_V2Section,     SGXBS_V2Section_size)
+	SGXBS_CHECK_SIZEOF(SGXBS_V2ShaderInfo,  SGXBS_V2ShaderInfo_size)
+	SGXBS_CHECK_SIZEOF(SGXBS_V2Symbol,      SGXBS_V2Symbol_size)
+	SGXBS_CHECK_SIZEOF(SGXBS_V2UserBinding, SGXBS_V2UserBinding_size)
+
 #undef SGXBS_CHECK_SIZEOF
 /* PRQA S 3201 -- */
 
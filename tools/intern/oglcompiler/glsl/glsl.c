@@ -359,7 +359,9 @@ GLSL_EXPORT IMG_BOOL IMG_CALLCONV GLSLInitCompiler(GLSLInitCompilerContext *psIn
 #ifdef METRICS
 													  GLSLUFStartMetric, GLSLUFFinishMetric, (IMG_VOID*)psCPD
 #else
-													  IMG_NULL, IMG_NULL, IMG_NULL
+													  psInitCompilerContext->pfnUSCStartMetric,
+													  psInitCompilerContext->pfnUSCFinishMetric,
+													  psInitCompilerContext->pvUSCMetricsParam
 #endif
 													  );
 #endif
@@ -1248,6 +1248,15 @@ typedef struct GLSLUnrollLoopRulesTAG
 	IMG_BOOL	bUnrollRelativeAddressingOnly;	/* Enable unroll if the loop has dynamic indexing and number of iterations is less than uMaxNumIterations*/
 
 	IMG_UINT32  uMaxNumIterations;				/* The max number of iteration for unrolling, this condition should always applies */
+
+	/*
+		Cost model, read at each compile. A limit of 0 means no limit. A loop which would be 
+		too large or keep too many values live if fully unrolled is unrolled by the largest 
+		factor within the limits instead, with the remaining iterations unrolled after the loop.
+	*/
+	IMG_UINT32	uMaxUnrolledInstrs;				/* The max number of intermediate instructions an unrolled loop can expand to */
+	IMG_UINT32	uMaxLiveComponents;				/* The max number of components (texture results and other values) the unrolled copies of a loop body can have live at once */
+	IMG_UINT32	uMaxPartialUnrollFactor;		/* The max number of copies of the body in a partially unrolled loop, 0 or 1 to disable partial unrolling */
 } GLSLUnrollLoopRules;
 
 /* Init struct to 0 to be safe from new changes */
@@ -1274,6 +1283,11 @@ typedef struct GLSLInitCompilerContextTAG
 	
 	IMG_BOOL					bEnableUSCMemoryTracking;
 
+	/* Optional, called at the start and end of each USC phase (ignored in METRICS builds) */
+	USC_STARTFN					pfnUSCStartMetric;
+	USC_FINISHFN				pfnUSCFinishMetric;
+	IMG_VOID					*pvUSCMetricsParam;
+
 } GLSLInitCompilerContext;
 
 
@@ -1223,6 +1223,26 @@ IMG_INTERNAL IMG_VOID ICRemoveInstruction(GLSLICProgram     *psICProgram, GLSLIC
 	FreeICInstruction(psICProgram, psICInstr);
 }
 
+/******************************************************************************
+ * Function Name: ICMoveInstructionRange
+ *
+ * Inputs       : 
+ * Outputs      : 
+ * Returns      : 
+ * Globals Used : -
+ *
+ * Description  : Move instructions from psStart to psEnd to after psAfter
+ *****************************************************************************/
+IMG_INTERNAL IMG_VOID ICMoveInstructionRange(GLSLICProgram     *psICProgram,
+											  GLSLICInstruction *psAfter,
+											  GLSLICInstruction *psStart,
+											  GLSLICInstruction *psEnd)
+{
+	UnhookInstructions(psICProgram, psStart, psEnd);
+
+	InsertInstructionsAfter(psICProgram, psAfter, psStart, psEnd);
+}
+
 /******************************************************************************
  * Function Name: ICRemoveInstructionRange
  *
@@ -329,6 +329,11 @@ IMG_VOID ICRemoveInstructionRange(GLSLICProgram		*psICProgram,
 								  GLSLICInstruction	*psStart,
 								  GLSLICInstruction	*psEnd);
 
+IMG_VOID ICMoveInstructionRange(GLSLICProgram		*psICProgram,
+								GLSLICInstruction	*psAfter,
+								GLSLICInstruction	*psStart,
+								GLSLICInstruction	*psEnd);
+
 IMG_VOID CloneICodeInstructions(GLSLCompilerPrivateData *psCPD, 
 								GLSLICProgram		*psICProgram,
 								GLSLICInstruction	*psStart,
@@ -46,6 +46,12 @@
 
 #define IS_LOOP_OP(op)		(op == GLSLIC_OP_LOOP)
 
+#define IS_TEXTURE_OP(op)	( op == GLSLIC_OP_TEXLD || \
+							  op == GLSLIC_OP_TEXLDP || \
+							  op == GLSLIC_OP_TEXLDB || \
+							  op == GLSLIC_OP_TEXLDL || \
+							  op == GLSLIC_OP_TEXLDD )
+
 
 typedef struct GLSLICInvariantTAG
 {
@@ -74,6 +80,15 @@ typedef struct
 	IMG_BOOL		bRelativeAddressing;
 	IMG_UINT32		uNumIterations;
 
+	/* Components written by texture samples in the body */
+	IMG_UINT32		uNumTextureComponents;
+
+	/* The most components of other values the body has live at once */
+	IMG_UINT32		uNumLiveComponents;
+
+	/* The body indexes an array of samplers with a variable */
+	IMG_BOOL		bSamplerIndexing;
+
 	IMG_BOOL		bLoopInside;
 
 } GLSLICLoopInfo;
@@ -331,6 +346,150 @@ static IMG_BOOL ExamineLoopUpdateCode(GLSLCompilerPrivateData *psCPD,
 }
 
 
+/******************************************************************************
+ * Function Name: GetNumDestComponents
+ *
+ * Inputs       : 
+ * Outputs      : 
+ * Returns      : The number of components an instruction writes.
+ * Globals Used : -
+ *
+ * Description  : 
+ *****************************************************************************/
+static IMG_UINT32 GetNumDestComponents(GLSLCompilerPrivateData	*psCPD,
+									   GLSLICProgram			*psICProgram,
+									   GLSLICInstruction		*psInstr)
+{
+	IMG_UINT32 uNumComponents = psInstr->asOperand[DEST].sSwizWMask.uNumComponents;
+
+	if(!uNumComponents)
+	{
+		uNumComponents = TYPESPECIFIER_NUM_COMPONENTS(ICGetSymbolTypeSpecifier(psCPD, psICProgram->psSymbolTable, psInstr->asOperand[DEST].uSymbolID));
+	}
+
+	return uNumComponents;
+}
+
+/******************************************************************************
+ * Function Name: InstrReadsSymbol
+ *
+ * Inputs       : 
+ * Outputs      : 
+ * Returns      : IMG_TRUE if an instruction reads a symbol, as a source or an index.
+ * Globals Used : -
+ *
+ * Description  : 
+ *****************************************************************************/
+static IMG_BOOL InstrReadsSymbol(GLSLICInstruction *psInstr, IMG_UINT32 uSymID)
+{
+	IMG_UINT32 j, k;
+
+	for(j = 0; j < ICOP_NUM_SRCS(psInstr->eOpCode) + 1; j++)
+	{
+		if(j == DEST && !ICOP_HAS_DEST(psInstr->eOpCode)) continue;
+
+		if(j != DEST && psInstr->asOperand[j].uSymbolID == uSymID)
+		{
+			return IMG_TRUE;
+		}
+
+		for(k = 0; k < psInstr->asOperand[j].uNumOffsets; k++)
+		{
+			if(psInstr->asOperand[j].psOffsets[k].uOffsetSymbolID == uSymID)
+			{
+				return IMG_TRUE;
+			}
+		}
+	}
+
+	return IMG_FALSE;
+}
+
+/******************************************************************************
+ * Function Name: EstimateLiveComponents
+ *
+ * Inputs       : 
+ * Outputs      : 
+ * Returns      : 
+ * Globals Used : -
+ *
+ * Description  : Find the most components of values other than texture results 
+ *				  one copy of the loop body has live at once. A value is live from 
+ *				  the instruction which writes it to its last read before it is 
+ *				  written again.
+ *****************************************************************************/
+static IMG_BOOL EstimateLiveComponents(GLSLCompilerPrivateData	*psCPD,
+									   GLSLICProgram			*psICProgram,
+									   GLSLICInstruction		*psStart,
+									   GLSLICLoopInfo			*psLoopInfo)
+{
+	GLSLICInstruction *psInstr, *psRead;
+	IMG_INT32 *aiLiveChange;
+	IMG_INT32 iNumLive = 0;
+	IMG_UINT32 i, j;
+
+	psLoopInfo->uNumLiveComponents = 0;
+
+	if(!psLoopInfo->uNumBodyInstrs)
+	{
+		return IMG_TRUE;
+	}
+
+	aiLiveChange = DebugMemCalloc((psLoopInfo->uNumBodyInstrs + 1) * sizeof(IMG_INT32));
+	if(aiLiveChange == IMG_NULL)
+	{
+		LOG_INTERNAL_ERROR(("EstimateLiveComponents: Failed to allocate memory\n"));
+		return IMG_FALSE;
+	}
+
+	for(i = 0, psInstr = psStart; i < psLoopInfo->uNumBodyInstrs; i++, psInstr = psInstr->psNext)
+	{
+		IMG_UINT32 uSymID = psInstr->asOperand[DEST].uSymbolID;
+		IMG_UINT32 uLastRead = 0;
+
+		/* Texture results are counted for every copy of the body */
+		if(!ICOP_HAS_DEST(psInstr->eOpCode) || IS_TEXTURE_OP(psInstr->eOpCode))
+		{
+			continue;
+		}
+
+		for(j = i + 1, psRead = psInstr->psNext; j < psLoopInfo->uNumBodyInstrs; j++, psRead = psRead->psNext)
+		{
+			if(InstrReadsSymbol(psRead, uSymID))
+			{
+				uLastRead = j;
+			}
+
+			if(ICOP_HAS_DEST(psRead->eOpCode) && psRead->asOperand[DEST].uSymbolID == uSymID)
+			{
+				break;
+			}
+		}
+
+		if(uLastRead)
+		{
+			IMG_INT32 iNumComponents = (IMG_INT32)GetNumDestComponents(psCPD, psICProgram, psInstr);
+
+			aiLiveChange[i + 1] += iNumComponents;
+			aiLiveChange[uLastRead] -= iNumComponents;
+		}
+	}
+
+	for(i = 0; i < psLoopInfo->uNumBodyInstrs; i++)
+	{
+		iNumLive += aiLiveChange[i];
+
+		if(iNumLive > (IMG_INT32)psLoopInfo->uNumLiveComponents)
+		{
+			psLoopInfo->uNumLiveComponents = (IMG_UINT32)iNumLive;
+		}
+	}
+
+	DebugMemFree(aiLiveChange);
+
+	return IMG_TRUE;
+}
+
 /******************************************************************************
  * Function Name: ExamineLoopBodyCode
  *
@@ -397,6 +556,12 @@ static IMG_BOOL ExamineLoopBodyCode(GLSLCompilerPrivateData *psCPD,
 				if(psInstr->asOperand[j].psOffsets[k].uOffsetSymbolID)
 				{
 					psLoopInfo->bRelativeAddressing = IMG_TRUE;
+
+					/* Arrays of samplers can only be indexed by constants, so the loop must be fully unrolled */
+					if(GLSL_IS_SAMPLER(ICGetSymbolTypeSpecifier(psCPD, psICProgram->psSymbolTable, psInstr->asOperand[j].uSymbolID)))
+					{
+						psLoopInfo->bSamplerIndexing = IMG_TRUE;
+					}
 				}
 			}
 		}
@@ -407,6 +572,15 @@ static IMG_BOOL ExamineLoopBodyCode(GLSLCompilerPrivateData *psCPD,
 			bStaticLoop = IMG_FALSE;
 		}
 
+		/* 
+			Count the texture results, the USC issues samples ahead of their uses 
+			to hide the latency so the results of unrolled copies tend to be live together 
+		*/
+		if(IS_TEXTURE_OP(psInstr->eOpCode))
+		{
+			psLoopInfo->uNumTextureComponents += GetNumDestComponents(psCPD, psICProgram, psInstr);
+		}
+
 		uNumInstrs++;
 
 		if(psInstr == psEnd) break;
@@ -930,6 +1104,178 @@ static IMG_VOID UnrollLoopFORCode(GLSLCompilerPrivateData *psCPD,
 }
 
 
+/******************************************************************************
+ * Function Name: UnrolledLoopFitsRules
+ *
+ * Inputs       : 
+ * Outputs      : 
+ * Returns      : 
+ * Globals Used : -
+ *
+ * Description  : Check the estimated cost of uNumCopies copies of a loop body,
+ *				  uNumLiveCopies of which may be scheduled together, against the 
+ *				  limits of the unrolling rules.
+ *****************************************************************************/
+static IMG_BOOL UnrolledLoopFitsRules(GLSLUnrollLoopRules	*psUnrollLoopRules,
+									  GLSLICLoopInfo		*psLoopInfo,
+									  IMG_UINT32			uNumCopies,
+									  IMG_UINT32			uNumLiveCopies)
+{
+	if(psUnrollLoopRules->uMaxUnrolledInstrs &&
+	   psLoopInfo->uNumBodyInstrs * uNumCopies > psUnrollLoopRules->uMaxUnrolledInstrs)
+	{
+		return IMG_FALSE;
+	}
+
+	if(psUnrollLoopRules->uMaxLiveComponents &&
+	   (psLoopInfo->uNumTextureComponents + psLoopInfo->uNumLiveComponents) * uNumLiveCopies > psUnrollLoopRules->uMaxLiveComponents)
+	{
+		return IMG_FALSE;
+	}
+
+	return IMG_TRUE;
+}
+
+/******************************************************************************
+ * Function Name: ChooseUnrollFactor
+ *
+ * Inputs       : 
+ * Outputs      : 
+ * Returns      : The number of copies of the body in the unrolled loop:
+ *				  uNumIterations to unroll it fully, 0 not to unroll it.
+ * Globals Used : -
+ *
+ * Description  : Decide how far to unroll a loop which can be unrolled.
+ *****************************************************************************/
+static IMG_UINT32 ChooseUnrollFactor(GLSLUnrollLoopRules	*psUnrollLoopRules,
+									 GLSLICLoopInfo			*psLoopInfo)
+{
+	IMG_UINT32 uNumIterations = psLoopInfo->uNumIterations;
+	IMG_UINT32 uFactor;
+
+	/* Fully unroll if the whole loop is within the limits */
+	if(uNumIterations <= psUnrollLoopRules->uMaxNumIterations &&
+	   UnrolledLoopFitsRules(psUnrollLoopRules, psLoopInfo, uNumIterations, uNumIterations))
+	{
+		return uNumIterations;
+	}
+
+	/* 
+		Otherwise unroll by the largest factor within the limits, counting the copies of 
+		the body for the remaining iterations after the loop. The loop has to run at least twice.
+	*/
+	if(psUnrollLoopRules->uMaxPartialUnrollFactor < 2)
+	{
+		return 0;
+	}
+
+	uFactor = uNumIterations / 2;
+	if(uFactor > psUnrollLoopRules->uMaxPartialUnrollFactor)
+	{
+		uFactor = psUnrollLoopRules->uMaxPartialUnrollFactor;
+	}
+
+	for(; uFactor >= 2; uFactor--)
+	{
+		if(UnrolledLoopFitsRules(psUnrollLoopRules, psLoopInfo, uFactor + (uNumIterations % uFactor), uFactor))
+		{
+			return uFactor;
+		}
+	}
+
+	return 0;
+}
+
+/******************************************************************************
+ * Function Name: PartialUnrollLoopFORCode
+ *
+ * Inputs       : 
+ * Outputs      : 
+ * Returns      : 
+ * Globals Used : -
+ *
+ * Description  : Unroll loop 'for' by uFactor copies of the body, the iterations 
+ *				  left over are unrolled after the loop.
+ *****************************************************************************/
+static IMG_VOID PartialUnrollLoopFORCode(GLSLCompilerPrivateData *psCPD,
+										 GLSLICProgram		*psICProgram,
+										 GLSLICInstruction	*psCondInstr,
+										 GLSLICInstruction	*psStart,
+										 GLSLICInstruction	*psEnd,
+										 GLSLICInstruction	*psUpdateStart,
+										 GLSLICInstruction	*psUpdateEnd,
+										 GLSLICLoopInfo		*psLoopInfo,
+										 IMG_UINT32			uFactor)
+{
+	IMG_UINT32 uNumLoopIterations = psLoopInfo->uNumIterations / uFactor;
+	IMG_UINT32 uNumRemainder = psLoopInfo->uNumIterations - uNumLoopIterations * uFactor;
+	IMG_INT32 iStep, iLoopValue;
+	IMG_UINT32 uLoopValueID = 0;
+	IMG_UINT32 i;
+	GLSLICInstruction *psInsertAfter = psEnd;
+	GLSLICInstruction *psClonedStart, *psCloneEnd;
+	GLSLICInstruction *apsCompare[2];
+	GLSLPrecisionQualifier eLoopVarPrecision;
+
+	if(!psLoopInfo->uNumBodyInstrs)
+		return;
+
+	eLoopVarPrecision = ICGetSymbolPrecision(psCPD, psICProgram->psSymbolTable, psLoopInfo->uLoopVarID);
+	iStep = (psLoopInfo->eUpdateOp == GLSLIC_OP_ADD) ? psLoopInfo->iUpdateValue : -psLoopInfo->iUpdateValue;
+
+	/* 
+		Repeat the update code and the body inside the loop, each copy of the body 
+		sees the loop variable of the next iteration 
+	*/
+	for(i = 1; i < uFactor; i++)
+	{
+		CloneICodeInstructions(psCPD, psICProgram, psUpdateStart, psUpdateEnd, &psClonedStart, &psCloneEnd);
+		ICMoveInstructionRange(psICProgram, psInsertAfter, psClonedStart, psCloneEnd);
+		psInsertAfter = psCloneEnd;
+
+		CloneICodeInstructions(psCPD, psICProgram, psStart, psEnd, &psClonedStart, &psCloneEnd);
+		ICMoveInstructionRange(psICProgram, psInsertAfter, psClonedStart, psCloneEnd);
+		psInsertAfter = psCloneEnd;
+	}
+
+	/* Leave the loop once the loop variable reaches its value after uNumLoopIterations passes */
+	iLoopValue = psLoopInfo->iInitValue + (IMG_INT32)(uNumLoopIterations * uFactor) * iStep;
+	if(!AddIntConstant(psCPD, psICProgram->psSymbolTable, iLoopValue, eLoopVarPrecision, IMG_TRUE, &uLoopValueID))
+	{
+		LOG_INTERNAL_ERROR(("PartialUnrollLoopFORCode: Failed to add constant %d", iLoopValue));
+		return;
+	}
+
+	apsCompare[0] = psCondInstr;
+	apsCompare[1] = psUpdateEnd->psNext;
+	for(i = 0; i < 2; i++)
+	{
+		DebugAssert(IS_COMPARE_OP(apsCompare[i]->eOpCode));
+
+		apsCompare[i]->eOpCode = GLSLIC_OP_SNE;
+		apsCompare[i]->asOperand[SRCB].uSymbolID = uLoopValueID;
+	}
+
+	/* Unroll the remaining iterations after the loop */
+	for(i = 0; i < uNumRemainder; i++)
+	{
+		CloneICodeInstructions(psCPD, psICProgram, psStart, psEnd, &psClonedStart, &psCloneEnd);
+		RewriteLoopCode(psCPD, psICProgram, psClonedStart, psCloneEnd, psLoopInfo, iLoopValue, eLoopVarPrecision);
+
+		iLoopValue += iStep;
+	}
+
+	if(uNumRemainder)
+	{
+		/* At the end of loop, the loop variable is always assigned to its final value */
+		if(!AddIntConstant(psCPD, psICProgram->psSymbolTable, iLoopValue, eLoopVarPrecision, IMG_TRUE, &uLoopValueID))
+		{
+			LOG_INTERNAL_ERROR(("PartialUnrollLoopFORCode: Failed to add constant %d", iLoopValue));
+		}
+		ICAddICInstruction2b(psCPD, psICProgram, GLSLIC_OP_MOV, IMG_NULL, psLoopInfo->uLoopVarID, uLoopValueID);
+	}
+}
+
 /******************************************************************************
  * Function Name: ProcessNodeFOR
  *
@@ -955,6 +1301,7 @@ IMG_INTERNAL IMG_VOID ICUnrollLoopFOR(GLSLCompilerPrivateData *psCPD,
 	GLSLICContext *psICContext = GET_IC_CONTEXTDATA(psICProgram);
 	GLSLUnrollLoopRules *psUnrollLoopRules = &psICContext->psInitCompilerContext->sUnrollLoopRules;
 	IMG_BOOL bStaticLoop;
+	IMG_UINT32 uUnrollFactor = 0;
 
 	/* Initialise the loop information, initially assume the body does not contain relative addressing  */
 	memset(&sLoopInfo, 0, sizeof(GLSLICLoopInfo));
@@ -988,6 +1335,11 @@ IMG_INTERNAL IMG_VOID ICUnrollLoopFOR(GLSLCompilerPrivateData *psCPD,
 
 		At the end of loops, the loop variable is always assigned to its final value. 
 
+		Loops which would be too large or keep too many values live if fully 
+		unrolled are unrolled partially: the body is repeated uUnrollFactor times inside 
+		the loop, the loop exits when the loop variable equals its value after the last 
+		whole pass, and the remaining iterations are unrolled after the loop.
+
 	*/
 
 
@@ -1059,21 +1411,42 @@ IMG_INTERNAL IMG_VOID ICUnrollLoopFOR(GLSLCompilerPrivateData *psCPD,
 			/* Pre calculate number of iterations */
 			sLoopInfo.uNumIterations = CalculateLoopNumIterations(psCPD, &sLoopInfo);
 
-			/* Check for maximum of iterations allowed for unrolling */
-			if(sLoopInfo.uNumIterations > psUnrollLoopRules->uMaxNumIterations)
+			/* Check for relative addressing unrolling only */
+			if(psUnrollLoopRules->bUnrollRelativeAddressingOnly && !sLoopInfo.bRelativeAddressing)
 			{
 				bUnrollLoop = IMG_FALSE;
 			}
-			/* Check for relative addressing unrolling only */
-			else if(psUnrollLoopRules->bUnrollRelativeAddressingOnly && !sLoopInfo.bRelativeAddressing)
+			else if(sLoopInfo.bSamplerIndexing)
+			{
+				/* The body can only be compiled with constant indices, so skip the cost model */
+				if(sLoopInfo.uNumIterations <= psUnrollLoopRules->uMaxNumIterations)
+				{
+					uUnrollFactor = sLoopInfo.uNumIterations;
+				}
+				else
+				{
+					bUnrollLoop = IMG_FALSE;
+				}
+			}
+			else if(psUnrollLoopRules->uMaxLiveComponents &&
+					!EstimateLiveComponents(psCPD, psICProgram, psLoopStart, &sLoopInfo))
 			{
 				bUnrollLoop = IMG_FALSE;
 			}
+			else
+			{
+				/* Check the iterations and the cost against the rules */
+				uUnrollFactor = ChooseUnrollFactor(psUnrollLoopRules, &sLoopInfo);
+				if(!uUnrollFactor && sLoopInfo.uNumIterations)
+				{
+					bUnrollLoop = IMG_FALSE;
+				}
+			}
 		}
 	}
 
 	/* If finally we decide we still want to go ahead */
-	if(bUnrollLoop)
+	if(bUnrollLoop && uUnrollFactor == sLoopInfo.uNumIterations)
 	{	
 		/* Remove LOOP instr */
 		ICRemoveInstruction(psICProgram, psCondEnd->psNext);
@@ -1098,6 +1471,11 @@ IMG_INTERNAL IMG_VOID ICUnrollLoopFOR(GLSLCompilerPrivateData *psCPD,
 	}
 	else
 	{
+		if(bUnrollLoop)
+		{
+			PartialUnrollLoopFORCode(psCPD, psICProgram, psCondStart, psLoopStart, psLoopEnd, psUpdateStart, psUpdateEnd, &sLoopInfo, uUnrollFactor);
+		}
+
 		/* Static loop: replace it with static */
 
 		if(bStaticLoop)
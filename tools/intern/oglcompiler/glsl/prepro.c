@@ -42,11 +42,14 @@ IMG_INTERNAL const IMG_UINT32 guSupportedGLSLVersions[GLSL_NUM_VERSIONS_SUPPORTE
 
 #define MAX_NESTED_IF_LEVELS 255
 
-typedef struct GLSLPreProcessorContextTAG
-{
-	GLSLExtension eEnabledExtensions;
-	IMG_UINT32    uSupportedVersion;  
-}GLSLPreProcessorContext;
+/* Marks an invalid index into a token array */
+#define PP_NO_TOKEN 0xFFFFFFFFU
+
+/* Size of each block of the identifier string store */
+#define PP_STRING_BLOCK_SIZE 4096
+
+/* Initial number of buckets in the identifier hash table (must be a power of 2) */
+#define PP_MIN_IDENTIFIER_HASH_SIZE 256
 
 typedef struct ExpressionNodeTAG
 {
@@ -57,32 +60,87 @@ typedef struct ExpressionNodeTAG
 	IMG_UINT32                uNumChildren;
 } ExpressionNode;
 
-typedef struct TokenLLTAG
+struct DefineMacroTAG;
+
+/*
+   Every distinct name that could be a macro name is stored once in the identifier table.
+   Tokens that refer to the same name share the same PPIdentifier (and the same string),
+   so macro lookups are a pointer dereference rather than a string search.
+*/
+typedef struct PPIdentifierTAG
+{
+	IMG_CHAR                *pszName;
+	IMG_UINT32               uHash;
+	struct DefineMacroTAG   *psDefineMacro;
+	struct PPIdentifierTAG  *psNext;
+} PPIdentifier;
+
+typedef struct PPStringBlockTAG
+{
+	struct PPStringBlockTAG *psNext;
+	IMG_UINT32               uSize;
+	IMG_UINT32               uUsed;
+	IMG_CHAR                 acData[1];
+} PPStringBlock;
+
+typedef struct PPTokenTAG
 {
 	Token                   sToken;
-	struct TokenLLTAG      *psNext;
-	struct TokenLLTAG      *psPrev;
+	PPIdentifier           *psIdentifier;
 	IMG_BOOL                bRemove;
-} TokenLL;
+} PPToken;
 
-typedef enum PPSymbolTypeTAG
+/*
+   A run of tokens stored contiguously. Valid entries are psTokens[uStart] to psTokens[uEnd - 1];
+   the space in front of uStart is kept so that macro expansions can be spliced in without
+   moving the rest of the line.
+*/
+typedef struct PPTokenArrayTAG
 {
-	PPST_DEFINEMACRO,
-} PPSymbolType;
+	PPToken                *psTokens;
+	IMG_UINT32              uStart;
+	IMG_UINT32              uEnd;
+	IMG_UINT32              uAllocated;
+} PPTokenArray;
 
 typedef struct DefineMacroTAG
 {
-	PPSymbolType     ePPSymbolType;
 	IMG_BOOL         bTakesArgs;
 	IMG_UINT32       uNumArgs;
 	IMG_UINT32       uNumArgUsages;
 	IMG_UINT32      *puArgumentToUse;
 	IMG_UINT32      *puArgumentPositions;
-	Token           *psTokenList;
+	PPToken         *psTokenList;
 	IMG_UINT32       uNumTokens;
 } DefineMacro;
 
-
+typedef struct GLSLPreProcessorContextTAG
+{
+	GLSLExtension   eEnabledExtensions;
+	IMG_UINT32      uSupportedVersion;
+
+	/* Source tokens, and the next one to be read by the main loop */
+	Token          *psInputTokens;
+	IMG_UINT32      uNumInputTokens;
+	IMG_UINT32      uNextInputToken;
+
+	/* Identifier table */
+	PPIdentifier  **ppsIdentifierHash;
+	IMG_UINT32      uIdentifierHashSize;
+	IMG_UINT32      uNumIdentifiers;
+	PPStringBlock  *psStringBlocks;
+
+	/* Names checked for on every identifier */
+	PPIdentifier   *psDefinedIdentifier;
+	PPIdentifier   *psLineIdentifier;
+	PPIdentifier   *psFileIdentifier;
+	PPIdentifier   *psVersionIdentifier;
+
+	/* Scratch space used while expanding a macro */
+	PPTokenArray    sExpansion;
+	IMG_UINT32     *puParameterEntries;
+	IMG_UINT32      uMaxParameterEntries;
+}GLSLPreProcessorContext;
 
 typedef enum IfBlockStateTAG
 {
@@ -107,32 +165,23 @@ typedef struct IfStatusTAG
 #define POSSIBLE_DEFINE_NAME(a) \
 (((a)->eTokenName == TOK_IDENTIFIER) || ((a)->pvData && ((((IMG_CHAR *)((a)->pvData))[0] >= 'a' &&  ((IMG_CHAR *)((a)->pvData))[0] <= 'z') || (((IMG_CHAR *)((a)->pvData))[0] >= 'A' &&  ((IMG_CHAR *)((a)->pvData))[0] <= 'Z'))))
 
+#define PP_TOKEN(psArray, uIndex) (&(psArray)->psTokens[uIndex].sToken)
+
 /******************************************************************************
- * Function Name: 
+ * Function Name: PPFreeDefineMacro
  *
- * Inputs       : 
+ * Inputs       : psDefineMacro - Macro to free
  * Outputs      : -
- * Returns      : 
+ * Returns      : -
  * Globals Used : -
  *
- * Description  : 
+ * Description  : Frees a macro definition. The token data is owned by the
+ *                input tokens or the string store and is not freed here.
  *****************************************************************************/
-static IMG_VOID PPFreeDefineMacro(IMG_VOID *pvDefineMacro)
+static IMG_VOID PPFreeDefineMacro(DefineMacro *psDefineMacro)
 {
-	DefineMacro *psDefineMacro = (DefineMacro *)pvDefineMacro;
-
 	if (psDefineMacro->psTokenList)
 	{
-		IMG_UINT32 i;
-
-		for (i = 0; i <  psDefineMacro->uNumTokens; i++)
-		{
-			if (psDefineMacro->psTokenList[i].pvData)
-			{
-				DebugMemFree(psDefineMacro->psTokenList[i].pvData);
-			}
-		}
-
 		DebugMemFree(psDefineMacro->psTokenList);
 	}
 
@@ -146,617 +195,953 @@ static IMG_VOID PPFreeDefineMacro(IMG_VOID *pvDefineMacro)
 		DebugMemFree(psDefineMacro->puArgumentPositions);
 	}
 
-
 	DebugMemFree(psDefineMacro);
 }
 
 /******************************************************************************
- * Function Name: 
+ * Function Name: PPAllocString
  *
- * Inputs       : 
+ * Inputs       : psContext - Preprocessor context
+ *                uSize     - Number of bytes required
  * Outputs      : -
- * Returns      : 
+ * Returns      : Zeroed memory that lives until the end of preprocessing
  * Globals Used : -
  *
- * Description  : 
+ * Description  : Allocates space for token data from the context's string store.
  *****************************************************************************/
-static TokenLL *PPGetNextDirectiveTokenEntry(TokenLL *psTokenEntry,
-											TokenLL *psLastEntry)
+static IMG_CHAR *PPAllocString(GLSLPreProcessorContext *psContext, IMG_UINT32 uSize)
 {
-	Token *psToken;
+	PPStringBlock *psBlock = psContext->psStringBlocks;
+	IMG_CHAR      *pszString;
 
-	do
+	/* Keep allocations pointer aligned, identifier table entries are allocated from here too */
+	uSize = (uSize + sizeof(IMG_VOID *) - 1) & ~(IMG_UINT32)(sizeof(IMG_VOID *) - 1);
+
+	if (!psBlock || (psBlock->uSize - psBlock->uUsed) < uSize)
 	{
-		/* Check if we've run out of tokens */
-		if (!psTokenEntry || (psTokenEntry == psLastEntry) || !psTokenEntry->psNext)
+		IMG_UINT32 uBlockSize = (uSize > PP_STRING_BLOCK_SIZE) ? uSize : PP_STRING_BLOCK_SIZE;
+
+		psBlock = DebugMemAlloc(sizeof(PPStringBlock) + uBlockSize);
+
+		if (!psBlock)
 		{
 			return IMG_NULL;
 		}
 
-		psTokenEntry = psTokenEntry->psNext;
+		psBlock->uSize = uBlockSize;
+		psBlock->uUsed = 0;
 
-		psToken = &psTokenEntry->sToken;
+		/* An oversized block is placed behind the current one so the remaining space can still be used */
+		if (psContext->psStringBlocks && uBlockSize > PP_STRING_BLOCK_SIZE)
+		{
+			psBlock->psNext = psContext->psStringBlocks->psNext;
+			psContext->psStringBlocks->psNext = psBlock;
+		}
+		else
+		{
+			psBlock->psNext = psContext->psStringBlocks;
+			psContext->psStringBlocks = psBlock;
+		}
+	}
 
-		/* Ignore certain tokens */
-	} while ((psToken->eTokenName == TOK_BACK_SLASH)     ||
-			 (psToken->eTokenName == TOK_NEWLINE)        ||
-			 (psToken->eTokenName == TOK_CARRIGE_RETURN) ||
-			 (psToken->eTokenName == TOK_TAB)            ||
-			 (psToken->eTokenName == TOK_VTAB)           ||
-			 (psToken->eTokenName == TOK_COMMENT)        ||
-			 (psToken->eTokenName == TOK_INCOMMENT)      ||
-			 (psToken->eTokenName == TOK_ENDOFSTRING)    ||
-			 (psToken->eTokenName == TOK_TERMINATEPARSING));
+	pszString = &psBlock->acData[psBlock->uUsed];
+	psBlock->uUsed += uSize;
+
+	memset(pszString, 0, uSize);
 
-	return psTokenEntry;
+	return pszString;
 }
 
 /******************************************************************************
- * Function Name: PPCreateTokenList
+ * Function Name: PPSetTokenNumber
  *
- * Inputs       : psTokenLL     - First token to copy
- *                psLastEntry   - Last token to copy
+ * Inputs       : psContext - Preprocessor context
+ *                psToken   - Token whose data is being replaced
+ *                uValue    - Value to store
+ * Outputs      : -
+ * Returns      : IMG_TRUE if successful
+ * Globals Used : -
  *
- * Outputs      : puNumTokens   - Number of tokens copied
- * Returns      : An array with the tokens that are in a linked list between psTokenLL and psLastEntry
+ * Description  : Replaces the data of a token with the decimal representation of
+ *                uValue, keeping the token's data size.
+ *****************************************************************************/
+static IMG_BOOL PPSetTokenNumber(GLSLPreProcessorContext *psContext, Token *psToken, IMG_UINT32 uValue)
+{
+	/* Big enough for any 32 bit number */
+	IMG_UINT32 uSize = (psToken->uSizeOfDataInBytes > 12) ? psToken->uSizeOfDataInBytes : 12;
+	IMG_CHAR  *pszData = PPAllocString(psContext, uSize);
+
+	if (!pszData)
+	{
+		return IMG_FALSE;
+	}
+
+	sprintf(pszData, "%u", uValue);
+
+	psToken->pvData     = pszData;
+	psToken->eTokenName = TOK_INTCONSTANT;
+
+	return IMG_TRUE;
+}
+
+/******************************************************************************
+ * Function Name: PPHashString
+ *
+ * Inputs       : pszString - NULL terminated string
+ * Outputs      : -
+ * Returns      : FNV-1a hash of the string
  * Globals Used : -
  *
- * Description  : Copies a linked list of tokens and returns an array with the same contents.
- *                Note: it skips all tokens marked with bRemove.
+ * Description  :
  *****************************************************************************/
-static Token *PPCreateTokenList(TokenLL *psTokenLL, TokenLL *psLastEntry, IMG_UINT32 *puNumTokens)
+static IMG_UINT32 PPHashString(const IMG_CHAR *pszString)
 {
-	IMG_UINT32 uNumTokens = 0;
+	IMG_UINT32 uHash = 2166136261U;
+
+	while (*pszString)
+	{
+		uHash ^= (IMG_UINT8)*pszString++;
+		uHash *= 16777619U;
+	}
 
-	TokenLL *psCurrentEntry = psTokenLL;
+	return uHash;
+}
 
-	Token *psTokenList;
+/******************************************************************************
+ * Function Name: PPFindIdentifier
+ *
+ * Inputs       : psContext - Preprocessor context
+ *                pszName   - Name to look up
+ *                bCreate   - Add the name to the table if it is not there
+ * Outputs      : -
+ * Returns      : The table entry for the name, or IMG_NULL
+ * Globals Used : -
+ *
+ * Description  : Looks a name up in the identifier table.
+ *****************************************************************************/
+static PPIdentifier *PPFindIdentifier(GLSLPreProcessorContext *psContext, const IMG_CHAR *pszName, IMG_BOOL bCreate)
+{
+	IMG_UINT32    uHash = PPHashString(pszName);
+	PPIdentifier *psIdentifier;
+	IMG_UINT32    uLength;
 
-	/* Count number of tokens */
-	while (psCurrentEntry && (psCurrentEntry != psLastEntry))
+	for (psIdentifier = psContext->ppsIdentifierHash[uHash & (psContext->uIdentifierHashSize - 1)];
+		 psIdentifier;
+		 psIdentifier = psIdentifier->psNext)
 	{
-		if (!psCurrentEntry->bRemove)
+		if (psIdentifier->uHash == uHash && strcmp(psIdentifier->pszName, pszName) == 0)
 		{
-			uNumTokens++;
+			return psIdentifier;
 		}
-
-		psCurrentEntry = psCurrentEntry->psNext;
 	}
 
-	/* Alloc memory for token list */
-	psTokenList = DebugMemAlloc(sizeof(Token) * uNumTokens);
-
-	if(uNumTokens && !psTokenList)
+	if (!bCreate)
 	{
 		return IMG_NULL;
 	}
 
-	uNumTokens = 0;
-
-	psCurrentEntry = psTokenLL;
-
-	/* Copy the tokens to the list */
-	while (psCurrentEntry && (psCurrentEntry != psLastEntry))
+	/* Grow the table once it is fully loaded */
+	if (psContext->uNumIdentifiers >= psContext->uIdentifierHashSize)
 	{
-		if (!psCurrentEntry->bRemove)
-		{
-			psTokenList[uNumTokens] = psCurrentEntry->sToken;
+		IMG_UINT32     uNewSize = psContext->uIdentifierHashSize * 2;
+		PPIdentifier **ppsNewHash = DebugMemCalloc(uNewSize * sizeof(PPIdentifier *));
+		IMG_UINT32     i;
 
-			/* Copy the data */
-			if (psCurrentEntry->sToken.uSizeOfDataInBytes)
+		if (ppsNewHash)
+		{
+			for (i = 0; i < psContext->uIdentifierHashSize; i++)
 			{
-				psTokenList[uNumTokens].pvData = DebugMemAlloc(psCurrentEntry->sToken.uSizeOfDataInBytes);
-				if(psCurrentEntry->sToken.uSizeOfDataInBytes && !psTokenList[uNumTokens].pvData)
+				while (psContext->ppsIdentifierHash[i])
 				{
-					return IMG_NULL;
+					PPIdentifier *psEntry = psContext->ppsIdentifierHash[i];
+
+					psContext->ppsIdentifierHash[i] = psEntry->psNext;
+
+					psEntry->psNext = ppsNewHash[psEntry->uHash & (uNewSize - 1)];
+					ppsNewHash[psEntry->uHash & (uNewSize - 1)] = psEntry;
 				}
-				memcpy(psTokenList[uNumTokens].pvData, psCurrentEntry->sToken.pvData, psCurrentEntry->sToken.uSizeOfDataInBytes);
 			}
 
-			uNumTokens++;
+			DebugMemFree(psContext->ppsIdentifierHash);
+
+			psContext->ppsIdentifierHash   = ppsNewHash;
+			psContext->uIdentifierHashSize = uNewSize;
 		}
+	}
 
-		psCurrentEntry = psCurrentEntry->psNext;
+	uLength = (IMG_UINT32)strlen(pszName);
+
+	psIdentifier = (PPIdentifier *)PPAllocString(psContext, sizeof(PPIdentifier) + uLength + 1);
+
+	if (!psIdentifier)
+	{
+		return IMG_NULL;
 	}
 
-	*puNumTokens = uNumTokens;
+	psIdentifier->pszName = (IMG_CHAR *)(psIdentifier + 1);
+	psIdentifier->uHash   = uHash;
 
-	return psTokenList;
-}
+	memcpy(psIdentifier->pszName, pszName, uLength + 1);
+
+	psIdentifier->psNext = psContext->ppsIdentifierHash[uHash & (psContext->uIdentifierHashSize - 1)];
+	psContext->ppsIdentifierHash[uHash & (psContext->uIdentifierHashSize - 1)] = psIdentifier;
 
+	psContext->uNumIdentifiers++;
+
+	return psIdentifier;
+}
 
 /******************************************************************************
- * Function Name: PPCreateTokenLinkedList
+ * Function Name: PPGetTokenIdentifier
  *
- * Inputs       : psTokMemHeap       - Memory heap used to allocate the tokens in the linked list
- *                psTokenList        - Array of tokens to copy
- *                uNumTokens         - Length of the array of tokens to copy
- *                psInheritedTokenEntry - NFI
- *
- * Outputs      : TokenLL            - A linked list of tokens with the same contents as psTokenList
- * Returns      : 
+ * Inputs       : psContext - Preprocessor context
+ *                psPPToken - Token that is a possible define name
+ *                bCreate   - Add the name to the table if it is not there
+ * Outputs      : -
+ * Returns      : The identifier table entry for the token's name, or IMG_NULL
  * Globals Used : -
  *
- * Description  : Copies an array of tokens and returns the generated linked list of tokens.
+ * Description  :
  *****************************************************************************/
-static TokenLL *PPCreateTokenLinkedList(MemHeap     *psTokMemHeap,
-										Token       *psTokenList,
-										IMG_UINT32   uNumTokens,
-										TokenLL     *psInheritedTokenEntry)
+static PPIdentifier *PPGetTokenIdentifier(GLSLPreProcessorContext *psContext, PPToken *psPPToken, IMG_BOOL bCreate)
 {
-	IMG_UINT32 i;
+	if (!psPPToken->psIdentifier && psPPToken->sToken.pvData)
+	{
+		psPPToken->psIdentifier = PPFindIdentifier(psContext, psPPToken->sToken.pvData, bCreate);
+	}
 
-	TokenLL *psPrev = IMG_NULL, *psFirstEntry = IMG_NULL;
+	return psPPToken->psIdentifier;
+}
 
-	/* Copy all the tokens into a linked list structure */
-	for (i = 0; i < uNumTokens; i++)
-	{
-		TokenLL *psNewEntry = DebugAllocHeapItem(psTokMemHeap);
+/******************************************************************************
+ * Function Name: PPReserveTokens
+ *
+ * Inputs       : psArray - Token array
+ *                uFront  - Number of free entries required in front of uStart
+ *                uBack   - Number of free entries required after uEnd
+ * Outputs      : puShift - Amount every index into the array has moved by (optional)
+ * Returns      : IMG_TRUE if successful
+ * Globals Used : -
+ *
+ * Description  : Makes room in a token array.
+ *****************************************************************************/
+static IMG_BOOL PPReserveTokens(PPTokenArray *psArray, IMG_UINT32 uFront, IMG_UINT32 uBack, IMG_UINT32 *puShift)
+{
+	IMG_UINT32 uShift = 0;
 
-		/* Copy the token */
-		psNewEntry->sToken = psTokenList[i];
+	if (psArray->uStart < uFront)
+	{
+		/* Leave plenty of room so that repeated expansions on a line don't keep moving it */
+		IMG_UINT32 uCount = psArray->uEnd - psArray->uStart;
+		IMG_UINT32 uNewStart = uFront + uCount + 32;
+		IMG_UINT32 uNewSize = uNewStart + uCount + ((psArray->uAllocated > psArray->uEnd) ? (psArray->uAllocated - psArray->uEnd) : 0) + uBack;
+		PPToken   *psNewTokens = DebugMemAlloc(uNewSize * sizeof(PPToken));
 
-		/* Copy the data */
-		if (psTokenList[i].uSizeOfDataInBytes)
+		if (!psNewTokens)
 		{
-			psNewEntry->sToken.pvData = DebugMemAlloc(psTokenList[i].uSizeOfDataInBytes);
-			if(psTokenList[i].uSizeOfDataInBytes && !psNewEntry->sToken.pvData)
-			{
-				return IMG_NULL;
-			}
-			memcpy(psNewEntry->sToken.pvData, psTokenList[i].pvData, psTokenList[i].uSizeOfDataInBytes);
+			return IMG_FALSE;
 		}
 
-		if (psInheritedTokenEntry)
+		if (uCount)
 		{
-			psNewEntry->sToken.pszStartOfLine = psInheritedTokenEntry->sToken.pszStartOfLine;
-			psNewEntry->sToken.uStringNumber  = psInheritedTokenEntry->sToken.uStringNumber;	
-			psNewEntry->sToken.uLineNumber    = psInheritedTokenEntry->sToken.uLineNumber;
-			psNewEntry->sToken.uCharNumber    = psInheritedTokenEntry->sToken.uCharNumber;
-			psNewEntry->bRemove               = psInheritedTokenEntry->bRemove;
+			memcpy(&psNewTokens[uNewStart], &psArray->psTokens[psArray->uStart], uCount * sizeof(PPToken));
 		}
-		else
+
+		if (psArray->psTokens)
 		{
-			psNewEntry->bRemove = IMG_FALSE;
+			DebugMemFree(psArray->psTokens);
 		}
 
-		psNewEntry->psPrev = psPrev;
+		uShift = uNewStart - psArray->uStart;
 
-		psNewEntry->psNext = IMG_NULL;
+		psArray->psTokens   = psNewTokens;
+		psArray->uStart     = uNewStart;
+		psArray->uEnd       = uNewStart + uCount;
+		psArray->uAllocated = uNewSize;
+	}
+
+	if (psArray->uAllocated - psArray->uEnd < uBack)
+	{
+		IMG_UINT32 uNewSize = psArray->uEnd + uBack;
+		PPToken   *psNewTokens;
 
-		if (psPrev)
+		if (uNewSize < psArray->uAllocated * 2)
 		{
-			psPrev->psNext = psNewEntry;
+			uNewSize = psArray->uAllocated * 2;
 		}
 
-		psPrev = psNewEntry;
+		if (psArray->psTokens)
+		{
+			psNewTokens = DebugMemRealloc(psArray->psTokens, uNewSize * sizeof(PPToken));
+		}
+		else
+		{
+			psNewTokens = DebugMemAlloc(uNewSize * sizeof(PPToken));
+		}
 
-		if (i == 0)
+		if (!psNewTokens)
 		{
-			psFirstEntry = psNewEntry;
+			return IMG_FALSE;
 		}
+
+		psArray->psTokens   = psNewTokens;
+		psArray->uAllocated = uNewSize;
+	}
+
+	if (puShift)
+	{
+		*puShift = uShift;
 	}
-	return psFirstEntry;
+
+	return IMG_TRUE;
 }
 
 /******************************************************************************
- * Function Name: PPRemoveTokenLLEntry
+ * Function Name: PPAppendTokens
  *
- * Inputs       : psTokMemHeap - Memory heap where the token was allocated from
- *                psLLEntry    - Token to remove from a linked list.
+ * Inputs       : psArray    - Array to append to
+ *                psTokens   - Tokens to append
+ *                uNumTokens - Number of tokens to append
  * Outputs      : -
- * Returns      : 
+ * Returns      : IMG_TRUE if successful
  * Globals Used : -
  *
- * Description  : Remove a token from a linked list.
+ * Description  :
  *****************************************************************************/
-static TokenLL *PPRemoveTokenLLEntry(MemHeap	*psTokMemHeap, TokenLL	*psLLEntry)
+static IMG_BOOL PPAppendTokens(PPTokenArray *psArray, const PPToken *psTokens, IMG_UINT32 uNumTokens)
 {
-	TokenLL *psNextEntry = psLLEntry->psNext;
-	TokenLL *psPrevEntry = psLLEntry->psPrev;
-
-	if (psNextEntry)
+	if (!uNumTokens)
 	{
-		psNextEntry->psPrev = psPrevEntry;
+		return IMG_TRUE;
 	}
 
-	if (psPrevEntry)
+	if (!PPReserveTokens(psArray, 0, uNumTokens, IMG_NULL))
 	{
-		psPrevEntry->psNext = psNextEntry;
+		return IMG_FALSE;
 	}
 
-#ifdef DUMP_LOGFILES
-	DumpLogMessage(LOGFILE_PREPROCESSOR, 0,"Removing '%s'\n", psLLEntry->sToken.pvData);
-#endif
+	memcpy(&psArray->psTokens[psArray->uEnd], psTokens, uNumTokens * sizeof(PPToken));
+
+	psArray->uEnd += uNumTokens;
 
+	return IMG_TRUE;
+}
+
+/******************************************************************************
+ * Function Name: PPAppendInputTokens
+ *
+ * Inputs       : psContext   - Preprocessor context
+ *                psArray     - Array to append to
+ *                uFirstInput - Index of the first source token to append
+ *                uNumTokens  - Number of source tokens to append
+ * Outputs      : -
+ * Returns      : IMG_TRUE if successful
+ * Globals Used : -
+ *
+ * Description  : Appends source tokens to an array, looking up the names of
+ *                any tokens that could be macros.
+ *****************************************************************************/
+static IMG_BOOL PPAppendInputTokens(GLSLPreProcessorContext *psContext,
+									PPTokenArray            *psArray,
+									IMG_UINT32               uFirstInput,
+									IMG_UINT32               uNumTokens)
+{
+	IMG_UINT32 i;
 
-	if (psLLEntry->sToken.pvData)
+	if (!PPReserveTokens(psArray, 0, uNumTokens, IMG_NULL))
 	{
-		DebugMemFree(psLLEntry->sToken.pvData);
+		return IMG_FALSE;
 	}
-	
-	DebugFreeHeapItem(psTokMemHeap, psLLEntry);
 
-	if (psPrevEntry)
+	for (i = 0; i < uNumTokens; i++)
 	{
-#ifdef DUMP_LOGFILES
-		//DumpLogMessage(LOGFILE_PREPROCESSOR, 0," returning '%s'\n", psPrevEntry->sToken.pvData);
-#endif
-		return psPrevEntry;
+		PPToken *psPPToken = &psArray->psTokens[psArray->uEnd++];
+
+		psPPToken->sToken       = psContext->psInputTokens[uFirstInput + i];
+		psPPToken->psIdentifier = IMG_NULL;
+		psPPToken->bRemove      = IMG_FALSE;
+
+		if (POSSIBLE_DEFINE_NAME(&psPPToken->sToken))
+		{
+			psPPToken->psIdentifier = PPFindIdentifier(psContext, psPPToken->sToken.pvData, IMG_TRUE);
+
+			if (!psPPToken->psIdentifier)
+			{
+				return IMG_FALSE;
+			}
+
+			/* Identifiers share the stored copy of their name */
+			if (psPPToken->sToken.eTokenName == TOK_IDENTIFIER)
+			{
+				psPPToken->sToken.pvData = psPPToken->psIdentifier->pszName;
+			}
+		}
 	}
-	else
+
+	return IMG_TRUE;
+}
+
+/******************************************************************************
+ * Function Name: PPFlushTokens
+ *
+ * Inputs       : psArray - Array to take tokens from
+ *                uEnd    - Index after the last token to take
+ *                psOut   - Array to append the tokens to
+ * Outputs      : -
+ * Returns      : IMG_TRUE if successful
+ * Globals Used : -
+ *
+ * Description  : Moves the tokens from the start of psArray up to uEnd to psOut.
+ *****************************************************************************/
+static IMG_BOOL PPFlushTokens(PPTokenArray *psArray, IMG_UINT32 uEnd, PPTokenArray *psOut)
+{
+	if (uEnd > psArray->uStart)
 	{
-#ifdef DUMP_LOGFILES
-		//DumpLogMessage(LOGFILE_PREPROCESSOR, 0," returning '%s'\n", psNextEntry->sToken.pvData);
-#endif
+		if (!PPAppendTokens(psOut, &psArray->psTokens[psArray->uStart], uEnd - psArray->uStart))
+		{
+			return IMG_FALSE;
+		}
+
+		psArray->uStart = uEnd;
+	}
 
-		return psNextEntry;
+	if (psArray->uStart == psArray->uEnd)
+	{
+		psArray->uStart = 0;
+		psArray->uEnd   = 0;
 	}
+
+	return IMG_TRUE;
 }
 
 /******************************************************************************
- * Function Name: PPInsertList
+ * Function Name: PPInsertTokens
  *
- * Inputs       : psLLEntry         - Place in the destination list where the list of tokens must be inserted
- *                psFirstListEntry  - First element to insert in the destination list
- *                psLastListEntry   - Last element to insert in the destination list
- * Outputs      : -
- * Returns      : psLastListentry
+ * Inputs       : psArray    - Array to insert into
+ *                uIndex     - Index the new tokens are placed in front of
+ *                psTokens   - Tokens to insert
+ *                uNumTokens - Number of tokens to insert
+ * Outputs      : puShift    - Amount that all existing indices moved by
+ * Returns      : IMG_TRUE if successful
  * Globals Used : -
  *
- * Description  : Inserts a list of tokens into another list of tokens.
+ * Description  : Inserts tokens into an array. Entries in front of uIndex are
+ *                moved towards the start of the array (so their indices also
+ *                decrease by uNumTokens), entries from uIndex onwards stay put.
+ *                Insertions are always near the start of the array so this
+ *                is the cheap direction.
  *****************************************************************************/
-static TokenLL *PPInsertList(TokenLL  *psLLEntry,
-							TokenLL  *psFirstListEntry,
-							TokenLL  *psLastListEntry)
+static IMG_BOOL PPInsertTokens(PPTokenArray  *psArray,
+							   IMG_UINT32     uIndex,
+							   const PPToken *psTokens,
+							   IMG_UINT32     uNumTokens,
+							   IMG_UINT32    *puShift)
 {
-	TokenLL *psOldNext = psLLEntry->psNext;
+	IMG_UINT32 uShift;
+
+	if (!PPReserveTokens(psArray, uNumTokens, 0, &uShift))
+	{
+		return IMG_FALSE;
+	}
+
+	uIndex += uShift;
+
+	memmove(&psArray->psTokens[psArray->uStart - uNumTokens],
+			&psArray->psTokens[psArray->uStart],
+			(uIndex - psArray->uStart) * sizeof(PPToken));
 
-	/* Insert this list into the existing one */
-	psLLEntry->psNext        = psFirstListEntry;
-	psFirstListEntry->psPrev = psLLEntry;
-	psOldNext->psPrev        = psLastListEntry;
-	psLastListEntry->psNext  = psOldNext;
+	memcpy(&psArray->psTokens[uIndex - uNumTokens], psTokens, uNumTokens * sizeof(PPToken));
 
-	return psLastListEntry;
+	psArray->uStart -= uNumTokens;
+
+	*puShift = uShift;
+
+	return IMG_TRUE;
 }
 
+/******************************************************************************
+ * Function Name: PPGetNextDirectiveToken
+ *
+ * Inputs       : psArray     - Token array
+ *                uIndex      - Current token
+ *                uLastIndex  - Last token that may be returned
+ * Outputs      : -
+ * Returns      : Index of the next significant token, or PP_NO_TOKEN
+ * Globals Used : -
+ *
+ * Description  :
+ *****************************************************************************/
+static IMG_UINT32 PPGetNextDirectiveToken(PPTokenArray *psArray,
+										  IMG_UINT32    uIndex,
+										  IMG_UINT32    uLastIndex)
+{
+	Token *psToken;
+
+	do
+	{
+		/* Check if we've run out of tokens */
+		if ((uIndex == PP_NO_TOKEN) || (uIndex == uLastIndex) || (uIndex + 1 >= psArray->uEnd))
+		{
+			return PP_NO_TOKEN;
+		}
+
+		uIndex++;
+
+		psToken = PP_TOKEN(psArray, uIndex);
+
+		/* Ignore certain tokens */
+	} while ((psToken->eTokenName == TOK_BACK_SLASH)     ||
+			 (psToken->eTokenName == TOK_NEWLINE)        ||
+			 (psToken->eTokenName == TOK_CARRIGE_RETURN) ||
+			 (psToken->eTokenName == TOK_TAB)            ||
+			 (psToken->eTokenName == TOK_VTAB)           ||
+			 (psToken->eTokenName == TOK_COMMENT)        ||
+			 (psToken->eTokenName == TOK_INCOMMENT)      ||
+			 (psToken->eTokenName == TOK_ENDOFSTRING)    ||
+			 (psToken->eTokenName == TOK_TERMINATEPARSING));
+
+	return uIndex;
+}
 
 /******************************************************************************
- * Function Name: PPInsertTokensIntoLinkedList
+ * Function Name: PPPeekToken
  *
- * Inputs       : psTokMemHeap           - Memory heap where the tokens will be allocated from
- *                psLLEntry              - Place where the tokens will be inserted
- *                psTokenList            - Array of tokens to be inserted
- *                uNumTokens             - Number of tokens to be inserted
- *                psInheritedTokenEntry  - NFI
+ * Inputs       : psContext - Preprocessor context
+ *                psArray   - Token array
+ *                uIndex    - Index of the token
  * Outputs      : -
- * Returns      : The last element that has been inserted
+ * Returns      : The token, or IMG_NULL if there are no more tokens
+ * Globals Used : -
+ *
+ * Description  : Returns a token from an array. Indices past the end of the
+ *                array refer to the source tokens that have not yet been read.
+ *****************************************************************************/
+static const Token *PPPeekToken(GLSLPreProcessorContext *psContext, PPTokenArray *psArray, IMG_UINT32 uIndex)
+{
+	if (uIndex < psArray->uEnd)
+	{
+		return PP_TOKEN(psArray, uIndex);
+	}
+
+	uIndex = psContext->uNextInputToken + (uIndex - psArray->uEnd);
+
+	if (uIndex < psContext->uNumInputTokens)
+	{
+		return &psContext->psInputTokens[uIndex];
+	}
+
+	return IMG_NULL;
+}
+
+/******************************************************************************
+ * Function Name: PPCreateTokenList
+ *
+ * Inputs       : psArray       - Tokens to copy
+ * Outputs      : puNumTokens   - Number of tokens copied
+ * Returns      : An array with the tokens that are not marked with bRemove
  * Globals Used : -
  *
- * Description  : Inserts the tokens in the given array into a linked list.
+ * Description  : Creates the output token list. Each token gets its own copy
+ *                of its data.
  *****************************************************************************/
-static TokenLL *PPInsertTokensIntoLinkedList(MemHeap     *psTokMemHeap,
-											TokenLL     *psLLEntry,
-											Token       *psTokenList,
-											IMG_UINT32   uNumTokens,
-											TokenLL     *psInheritedTokenEntry)
+static Token *PPCreateTokenList(PPTokenArray *psArray, IMG_UINT32 *puNumTokens)
 {
-	if (uNumTokens)
+	IMG_UINT32 uNumTokens = 0;
+	IMG_UINT32 i;
+
+	Token *psTokenList;
+
+	/* Count number of tokens */
+	for (i = psArray->uStart; i < psArray->uEnd; i++)
 	{
-		TokenLL *psFirstEntry, *psLastEntry;
+		if (!psArray->psTokens[i].bRemove)
+		{
+			uNumTokens++;
+		}
+	}
+
+	/* Alloc memory for token list */
+	psTokenList = DebugMemAlloc(sizeof(Token) * uNumTokens);
+
+	if(uNumTokens && !psTokenList)
+	{
+		return IMG_NULL;
+	}
+
+	uNumTokens = 0;
+
+	/* Copy the tokens to the list */
+	for (i = psArray->uStart; i < psArray->uEnd; i++)
+	{
+		PPToken *psPPToken = &psArray->psTokens[i];
+
+		if (!psPPToken->bRemove)
+		{
+			psTokenList[uNumTokens] = psPPToken->sToken;
+
+			/* Copy the data */
+			if (psPPToken->sToken.uSizeOfDataInBytes)
+			{
+				psTokenList[uNumTokens].pvData = DebugMemAlloc(psPPToken->sToken.uSizeOfDataInBytes);
+				if(!psTokenList[uNumTokens].pvData)
+				{
+					return IMG_NULL;
+				}
+				memcpy(psTokenList[uNumTokens].pvData, psPPToken->sToken.pvData, psPPToken->sToken.uSizeOfDataInBytes);
+			}
+
+			uNumTokens++;
+		}
+	}
+
+	*puNumTokens = uNumTokens;
+
+	return psTokenList;
+}
+
+/******************************************************************************
+ * Function Name: PPAppendMacroTokens
+ *
+ * Inputs       : psArray        - Array to append to
+ *                psTokenList    - Tokens from the macro definition
+ *                uNumTokens     - Number of tokens
+ *                psMacroToken   - The token naming the macro being expanded
+ * Outputs      : -
+ * Returns      : IMG_TRUE if successful
+ * Globals Used : -
+ *
+ * Description  : Appends tokens from a macro body. They take their position
+ *                from the macro's name so errors are reported at the usage.
+ *****************************************************************************/
+static IMG_BOOL PPAppendMacroTokens(PPTokenArray  *psArray,
+									const PPToken *psTokenList,
+									IMG_UINT32     uNumTokens,
+									const PPToken *psMacroToken)
+{
+	IMG_UINT32 i;
 
-		/* Create a new linked list containing these tokens */
-		psFirstEntry = PPCreateTokenLinkedList(psTokMemHeap, psTokenList, uNumTokens, psInheritedTokenEntry);
+	if (!PPReserveTokens(psArray, 0, uNumTokens, IMG_NULL))
+	{
+		return IMG_FALSE;
+	}
 
-		psLastEntry = psFirstEntry;
+	for (i = 0; i < uNumTokens; i++)
+	{
+		PPToken *psNewToken = &psArray->psTokens[psArray->uEnd++];
 
-		/* Find last entry of new list */
-		while (psLastEntry->psNext)
-		{
-			psLastEntry = psLastEntry->psNext;
-		}
+		*psNewToken = psTokenList[i];
 
+		psNewToken->sToken.pszStartOfLine = psMacroToken->sToken.pszStartOfLine;
+		psNewToken->sToken.uStringNumber  = psMacroToken->sToken.uStringNumber;
+		psNewToken->sToken.uLineNumber    = psMacroToken->sToken.uLineNumber;
+		psNewToken->sToken.uCharNumber    = psMacroToken->sToken.uCharNumber;
+		psNewToken->bRemove               = psMacroToken->bRemove;
 
 #ifdef DUMP_LOGFILES
-		{
-			TokenLL *psNewList = psFirstEntry;
-			while (psNewList)
-			{
-				DumpLogMessage(LOGFILE_PREPROCESSOR,
-							   0,
-							   "Inserting token '%s'\n",
-							   psNewList->sToken.pvData ? psNewList->sToken.pvData : "no token data");
-				psNewList = psNewList->psNext;
-			}
-		}
+		DumpLogMessage(LOGFILE_PREPROCESSOR,
+					   0,
+					   "Inserting token '%s'\n",
+					   psNewToken->sToken.pvData ? psNewToken->sToken.pvData : "no token data");
 #endif
-
-		/* Insert this list into the existing one */
-		return PPInsertList(psLLEntry, psFirstEntry, psLastEntry);
-	}
-	else
-	{
-		return psLLEntry;
 	}
+
+	return IMG_TRUE;
 }
 
 /******************************************************************************
- * Function Name: PPReplicateAndInsertIntoLinkedList
+ * Function Name: PPAppendParameterTokens
  *
- * Inputs       : psTokMemHeap      - Memory heap where the tokens will be tokens will be allocated from.
- *                psInsertionPoint  - Place where the tokens will be inserted.
- *                psFirstListEntry  - First token to insert
- *                psLastListEntry   - Last token to insert
+ * Inputs       : psArray      - Array to append to
+ *                psSource     - Array holding the macro parameter
+ *                uFirstEntry  - First token of the parameter
+ *                uLastEntry   - Last token of the parameter
  * Outputs      : -
- * Returns      : 
+ * Returns      : IMG_TRUE if successful
  * Globals Used : -
  *
- * Description  : Duplicates and inserts a list of tokens into another list.
+ * Description  : Appends a copy of the significant tokens of a macro parameter.
  *****************************************************************************/
-static TokenLL *PPReplicateAndInsertIntoLinkedList(MemHeap     *psTokMemHeap,
-												TokenLL     *psInsertionPoint,
-												TokenLL     *psFirstListEntry,
-												TokenLL     *psLastListEntry)
+static IMG_BOOL PPAppendParameterTokens(PPTokenArray *psArray,
+										PPTokenArray *psSource,
+										IMG_UINT32    uFirstEntry,
+										IMG_UINT32    uLastEntry)
 {
-	TokenLL *psCurrentEntry = psFirstListEntry; 
-	TokenLL *psNewList = IMG_NULL, *psFirstNewListEntry = IMG_NULL;
+	IMG_UINT32 uCurrentEntry = uFirstEntry;
 
 	do
 	{
-		TokenLL *psLastNewEntry = psNewList;
-
-		/* Alloc memory for the copy */
-		psNewList = DebugAllocHeapItem(psTokMemHeap);
-
-		/* Copy the entry */
-		*psNewList = *psCurrentEntry;
-
-		/* Copy the data */
-		psNewList->sToken.pvData = DebugMemAlloc(psCurrentEntry->sToken.uSizeOfDataInBytes);
-		if(psCurrentEntry->sToken.uSizeOfDataInBytes && !psNewList->sToken.pvData)
-		{
-			return IMG_NULL;
-		}
-		memcpy(psNewList->sToken.pvData, psCurrentEntry->sToken.pvData, psCurrentEntry->sToken.uSizeOfDataInBytes);
-
-		/* link the new list */
-		psNewList->psPrev = psLastNewEntry;
-
-		if (psLastNewEntry)
-		{
-			psLastNewEntry->psNext = psNewList;
-		}
-		else
+		if (!PPAppendTokens(psArray, &psSource->psTokens[uCurrentEntry], 1))
 		{
-			psFirstNewListEntry = psNewList;
+			return IMG_FALSE;
 		}
 
-		/* Get the next entry */
-		psCurrentEntry = PPGetNextDirectiveTokenEntry(psCurrentEntry, psLastListEntry);
-	} while (psCurrentEntry);
+		uCurrentEntry = PPGetNextDirectiveToken(psSource, uCurrentEntry, uLastEntry);
+	} while (uCurrentEntry != PP_NO_TOKEN);
 
-	return PPInsertList(psInsertionPoint, psFirstNewListEntry, psNewList);
+	return IMG_TRUE;
 }
 
-
 /******************************************************************************
  * Function Name: PPCheckForMacroReplacement
  *
- * Inputs       : psTokMemHeap     - Memory heap where any tokens will be allocated from
- *                psFirstEntry     - Beginning of the list to check for macro replacement
- *                psLastEntry      - End of the list to check for macro replacement
- *                psSymbolTable    - Macro symbol table.
+ * Inputs       : psContext      - Preprocessor context
+ *                psTokens       - Tokens to check, from psTokens->uStart
+ *                uLastEntry     - Last token to check (must be the last in the array)
+ *                psOut          - Array that receives the tokens once checked
  *
- * Outputs      : ppsReturnEntry   - List of tokens after aplying macro preprocessing? NFI.
- * Returns      : NFI.
+ * Outputs      : puReturnEntry  - Index in psOut of the first token after replacement
+ * Returns      : IMG_TRUE if successful
  * Globals Used : -
  *
- * Description  : Scans a list of tokens and if any of them matches a macro identifier, it is replaced accordingly.
+ * Description  : Scans a line of tokens and if any of them matches a macro identifier, it is replaced accordingly.
+ *                The expansion replaces the macro usage in psTokens and is scanned again. All tokens are moved to
+ *                psOut, including on failure.
  *****************************************************************************/
 static IMG_BOOL PPCheckForMacroReplacement(GLSLCompilerPrivateData *psCPD,
-										   MemHeap     *psTokMemHeap,
-										TokenLL     *psFirstEntry, 
-										TokenLL     *psLastEntry,
-										SymTable    *psSymbolTable,
-										TokenLL    **ppsReturnEntry, 
-										TokenLL		**psNewLastEntry)
+										   GLSLPreProcessorContext *psContext,
+										   PPTokenArray            *psTokens,
+										   IMG_UINT32               uLastEntry,
+										   PPTokenArray            *psOut,
+										   IMG_UINT32              *puReturnEntry)
 {
-	/* psLastEntry may not be the real last entry for this a macro replacement if this replacement happens 
+	/* uLastEntry may not be the real last entry for this a macro replacement if this replacement happens
 	   in multiple lines.
 
-	   In this case, such macro must have parameters, and we need to look over psLastEntry to try to match the brackets 
-	   in order to find the real end of the replace statement.  Which means that psLastEntry will change too.
+	   In this case, such macro must have parameters, and we need to look over uLastEntry to try to match the brackets
+	   in order to find the real end of the replace statement. The tokens of the following lines are then read
+	   from the source and added to psTokens, which means that uLastEntry will change too.
 	 */
 
-	IMG_UINT32 uSymbolID, i = 0;
-
-	TokenLL  *psCurrentEntry  = psFirstEntry, *psFirstEntryOfMacro;
-
-	TokenLL **ppsParameterEntries;
-
-	IMG_CHAR *pszDefineMacroName;
+	IMG_UINT32 uCurrentEntry = psTokens->uStart, uFirstEntryOfMacro, i;
 
 	IMG_BOOL bSearchOverLastEntry = IMG_TRUE;
 
-	if (psNewLastEntry != IMG_NULL)
+	IMG_BOOL bSuccess = IMG_TRUE;
+
+	/* Tokens in front of the first one are never removed so it will stay at this position in the output */
+	if (puReturnEntry)
 	{
-		(*psNewLastEntry) = IMG_NULL;
+		*puReturnEntry = psOut->uEnd;
 	}
 
-	while (psCurrentEntry)
+	if (psTokens->uStart == psTokens->uEnd)
 	{
-		Token     *psToken        = &(psCurrentEntry->sToken);
+		return IMG_TRUE;
+	}
 
-		IMG_UINT32 uNumParameters   = 0;
+	while (uCurrentEntry != PP_NO_TOKEN)
+	{
+		PPToken   *psPPToken      = &psTokens->psTokens[uCurrentEntry];
+		Token     *psToken        = &psPPToken->sToken;
 
-		psFirstEntryOfMacro = IMG_NULL;
+		IMG_UINT32 uNumParameters = 0;
 
-		ppsParameterEntries = IMG_NULL;
+		uFirstEntryOfMacro = PP_NO_TOKEN;
 
 		if (POSSIBLE_DEFINE_NAME(psToken))
 		{
-			if (FindSymbol(psSymbolTable,
-						   psToken->pvData,
-						   &uSymbolID,
-						   IMG_TRUE))
+			PPIdentifier *psIdentifier  = PPGetTokenIdentifier(psContext, psPPToken, IMG_FALSE);
+			DefineMacro  *psDefineMacro = psIdentifier ? psIdentifier->psDefineMacro : IMG_NULL;
+
+			if (psDefineMacro)
 			{
-				/* Get the data about this define */
-				DefineMacro *psDefineMacro = (DefineMacro *)GetSymbolData(psSymbolTable, uSymbolID);
-			
-				if (!psDefineMacro || psDefineMacro->ePPSymbolType != PPST_DEFINEMACRO)
-				{
-					LOG_INTERNAL_TOKEN_ERROR((psToken,"PPCheckForMacroReplacement: Could not fetch data / data was of wrong type\n"));
-					if (ppsReturnEntry) *ppsReturnEntry = psCurrentEntry;
-					return IMG_FALSE;
-				}
+				PPToken     sMacroToken        = *psPPToken;
+				IMG_CHAR   *pszDefineMacroName = psIdentifier->pszName;
+				IMG_UINT32 *puParameterEntries = psContext->puParameterEntries;
+				IMG_UINT32  uShift;
 
 				/* Store the first entry of the macro */
-				psFirstEntryOfMacro = psCurrentEntry;
-
-				pszDefineMacroName = psToken->pvData;
+				uFirstEntryOfMacro = uCurrentEntry;
 
 #ifdef DUMP_LOGFILES
 				DumpLogMessage(LOGFILE_PREPROCESSOR, 0, "Found usage of macro '%s'\n",  pszDefineMacroName);
 #endif
-				
+
 				/* Does this macro take arguments? */
 				if (psDefineMacro->bTakesArgs)
 				{
 					/* Get next entry */
-					psCurrentEntry = PPGetNextDirectiveTokenEntry(psCurrentEntry, psLastEntry);
+					uCurrentEntry = PPGetNextDirectiveToken(psTokens, uCurrentEntry, uLastEntry);
 
 					/* Check for left bracket */
-					if (psCurrentEntry && (psCurrentEntry->sToken.eTokenName == TOK_LEFT_PAREN))
+					if ((uCurrentEntry != PP_NO_TOKEN) && (PP_TOKEN(psTokens, uCurrentEntry)->eTokenName == TOK_LEFT_PAREN))
 					{
 						/* Check for right bracket token which marks the end of the macro */
-						IMG_UINT32 uNumLeftBrackets = 1;
-						TokenLL * psRightBracket = psCurrentEntry->psNext;
-						if (psRightBracket == IMG_NULL)
+						IMG_UINT32   uNumLeftBrackets = 1;
+						IMG_UINT32   uRightBracket    = uCurrentEntry + 1;
+						const Token *psRightBracket   = PPPeekToken(psContext, psTokens, uRightBracket);
+
+						if (!psRightBracket)
 						{
 							LogProgramTokenError(psCPD->psErrorLog, psToken, "'%s' : Expected macro parameter\n", pszDefineMacroName);
-							if (ppsReturnEntry) 
-								*ppsReturnEntry = psCurrentEntry;
-							return IMG_FALSE;
+							bSuccess = IMG_FALSE;
+							break;
 						}
 
-						while(psRightBracket)
+						while (psRightBracket)
 						{
-							if (psRightBracket->sToken.eTokenName == TOK_RIGHT_PAREN)
+							if (psRightBracket->eTokenName == TOK_RIGHT_PAREN)
 							{
 								uNumLeftBrackets -= 1;
 								if (uNumLeftBrackets == 0)
 								{
 									/* we have found a matched right bracket for this parameterised macro.
-									   
+
 									 */
 									break;
 								}
 							}
-							else if (psRightBracket->sToken.eTokenName == TOK_LEFT_PAREN)
+							else if (psRightBracket->eTokenName == TOK_LEFT_PAREN)
 							{
 								uNumLeftBrackets += 1;
 							}
 
 							/* If we are at the end of this line and a matched right paren is still not found, we need to make sure
-							   psLastEntry marks the real statement end.  This is done by searching over psLastEntry line by line.  
-							   If the line containing ";", the search must be stopped, as ";" indicates the end of a statement.  
+							   uLastEntry marks the real statement end.  This is done by searching over uLastEntry line by line.
+							   If the line containing ";", the search must be stopped, as ";" indicates the end of a statement.
 							 */
-							if (psRightBracket == psLastEntry)
+							if (uRightBracket == uLastEntry)
 							{
+								const Token *psNext = PPPeekToken(psContext, psTokens, uLastEntry + 1);
+
 								/* Alreay the end of the string, definitly forget right bracket for macro replacement */
-								if ((psLastEntry->psNext == IMG_NULL) || 
-									(psLastEntry->psNext->sToken.eTokenName == TOK_ENDOFSTRING) || 
-									(psLastEntry->psNext->sToken.eTokenName == TOK_TERMINATEPARSING))
+								if (!psNext ||
+									(psNext->eTokenName == TOK_ENDOFSTRING) ||
+									(psNext->eTokenName == TOK_TERMINATEPARSING))
 								{
 									LogProgramTokenError(psCPD->psErrorLog, psToken, "'%s' : Missing right bracket\n", pszDefineMacroName);
-									if (ppsReturnEntry) 
-										*ppsReturnEntry = psCurrentEntry;
-									return IMG_FALSE;
+									bSuccess = IMG_FALSE;
+									break;
 								}
-								
-								/* This line by line increatment of the psLastEntry should be stopped after encouter a line contain ";" */
+
+								/* This line by line increatment of the uLastEntry should be stopped after encouter a line contain ";" */
 								if (bSearchOverLastEntry)
 								{
-									TokenLL * psSavedLastEntry = psLastEntry;
+									IMG_UINT32 uSavedLastEntry = uLastEntry;
+									IMG_UINT32 uFirstInput     = psContext->uNextInputToken;
+									IMG_UINT32 uLastInput;
+									TokenName  eSavedTokenName = PP_TOKEN(psTokens, uSavedLastEntry)->eTokenName;
 
-									while((psLastEntry = psLastEntry->psNext) != IMG_NULL)
+									for (uLastInput = uFirstInput; uLastInput < psContext->uNumInputTokens; uLastInput++)
 									{
-										if (psLastEntry->sToken.eTokenName == TOK_SEMICOLON)
+										TokenName eTokenName = psContext->psInputTokens[uLastInput].eTokenName;
+
+										if (eTokenName == TOK_SEMICOLON)
 										{
 											bSearchOverLastEntry = IMG_FALSE;
 										}
 
-										if ((psLastEntry->sToken.eTokenName == TOK_NEWLINE) || 
-											(psLastEntry->sToken.eTokenName == TOK_CARRIGE_RETURN))
+										if ((eTokenName == TOK_NEWLINE) ||
+											(eTokenName == TOK_CARRIGE_RETURN))
 										{
-											break; 
+											break;
 										}
 									}
 
-									if (psLastEntry != psSavedLastEntry)
+									/* Read the tokens up to the end of the next line */
+									if (!PPAppendInputTokens(psContext,
+															 psTokens,
+															 uFirstInput,
+															 ((uLastInput < psContext->uNumInputTokens) ? uLastInput + 1 : uLastInput) - uFirstInput))
 									{
-										/* we have proper search over a new line, the old new line token should be removed from the list */
-										psRightBracket = psRightBracket->psNext;
-										if ((psSavedLastEntry->sToken.eTokenName == TOK_NEWLINE) || 
-											(psSavedLastEntry->sToken.eTokenName == TOK_CARRIGE_RETURN) || 
-											(psSavedLastEntry->sToken.eTokenName == TOK_BACK_SLASH))
-										{
-											PPRemoveTokenLLEntry(psTokMemHeap, psSavedLastEntry);
-										}
+										bSuccess = IMG_FALSE;
+										break;
+									}
+
+									psContext->uNextInputToken += psTokens->uEnd - (uSavedLastEntry + 1);
 
-										if (psNewLastEntry != IMG_NULL)
+									/* The array may have moved */
+									psToken = PP_TOKEN(psTokens, uFirstEntryOfMacro);
+
+									uLastEntry = (uLastInput < psContext->uNumInputTokens) ? (psTokens->uEnd - 1) : PP_NO_TOKEN;
+
+									/* we have proper search over a new line, the old new line token should be removed from the list */
+									uRightBracket++;
+									if ((eSavedTokenName == TOK_NEWLINE) ||
+										(eSavedTokenName == TOK_CARRIGE_RETURN) ||
+										(eSavedTokenName == TOK_BACK_SLASH))
+									{
+										memmove(&psTokens->psTokens[uSavedLastEntry],
+												&psTokens->psTokens[uSavedLastEntry + 1],
+												(psTokens->uEnd - (uSavedLastEntry + 1)) * sizeof(PPToken));
+
+										psTokens->uEnd--;
+										uRightBracket--;
+
+										if (uLastEntry != PP_NO_TOKEN)
 										{
-											(*psNewLastEntry) = psLastEntry;
+											uLastEntry--;
 										}
-										continue;
 									}
+
+									psRightBracket = PPPeekToken(psContext, psTokens, uRightBracket);
+									continue;
 								}
 							}
-							
-							psRightBracket = psRightBracket->psNext;
+
+							uRightBracket++;
+							psRightBracket = PPPeekToken(psContext, psTokens, uRightBracket);
+						}
+
+						if (!bSuccess)
+						{
+							break;
 						}
-						
-						if (psRightBracket == IMG_NULL)
+
+						if (!psRightBracket)
 						{
 							LogProgramTokenError(psCPD->psErrorLog, psToken, "'%s' : Missing right bracket\n", pszDefineMacroName);
-							if (ppsReturnEntry) 
-								*ppsReturnEntry = psCurrentEntry;
-							return IMG_FALSE;
+							bSuccess = IMG_FALSE;
+							break;
 						}
 
-						/* Allocate space start and end point of parameter lists */
-						ppsParameterEntries  = DebugMemAlloc((psDefineMacro->uNumArgs + 1) * sizeof(TokenLL*) * 2);
-						if(!ppsParameterEntries)
+						/* Make sure there is space for the start and end point of parameter lists */
+						if (psContext->uMaxParameterEntries < (psDefineMacro->uNumArgs + 1) * 2)
 						{
-							return IMG_FALSE;
+							if (puParameterEntries)
+							{
+								DebugMemFree(puParameterEntries);
+							}
+
+							psContext->uMaxParameterEntries = (psDefineMacro->uNumArgs + 1) * 2;
+							psContext->puParameterEntries   = DebugMemAlloc(psContext->uMaxParameterEntries * sizeof(IMG_UINT32));
+
+							puParameterEntries = psContext->puParameterEntries;
+
+							if (!puParameterEntries)
+							{
+								psContext->uMaxParameterEntries = 0;
+								bSuccess = IMG_FALSE;
+								break;
+							}
 						}
-				
-						while (psCurrentEntry)
+
+						while (uCurrentEntry != PP_NO_TOKEN)
 						{
 							IMG_UINT32 uBracketCount = 0;
 							IMG_UINT32 uNumberOfParameterTokens = 0;
 
-							psCurrentEntry = PPGetNextDirectiveTokenEntry(psCurrentEntry, psLastEntry);
+							uCurrentEntry = PPGetNextDirectiveToken(psTokens, uCurrentEntry, uLastEntry);
 
 							/* Check next token */
-							if (!psCurrentEntry)
+							if (uCurrentEntry == PP_NO_TOKEN)
 							{
 								LogProgramTokenError(psCPD->psErrorLog, psToken, "'%s' : Expected macro parameter\n", pszDefineMacroName);
-								DebugMemFree(ppsParameterEntries);
-								if (ppsReturnEntry) *ppsReturnEntry = psCurrentEntry;
-								return IMG_FALSE;
+								bSuccess = IMG_FALSE;
+								break;
 							}
 
-							psToken = &(psCurrentEntry->sToken);
+							psToken = PP_TOKEN(psTokens, uCurrentEntry);
 
-							/* Initialise the first entry to null in case an empty parameter was supplied to the macro */
-							ppsParameterEntries[(uNumParameters * 2) + 0] = IMG_NULL;
+							/* Initialise the first entry in case an empty parameter was supplied to the macro */
+							puParameterEntries[(uNumParameters * 2) + 0] = PP_NO_TOKEN;
 
 							/* Search for last token of this parameter */
-							while (psCurrentEntry)
+							while (uCurrentEntry != PP_NO_TOKEN)
 							{
-								if (psCurrentEntry->sToken.eTokenName == TOK_RIGHT_PAREN)
+								TokenName eTokenName = PP_TOKEN(psTokens, uCurrentEntry)->eTokenName;
+
+								if (eTokenName == TOK_RIGHT_PAREN)
 								{
 									if (!uBracketCount)
 									{
@@ -767,71 +1152,57 @@ static IMG_BOOL PPCheckForMacroReplacement(GLSLCompilerPrivateData *psCPD,
 										uBracketCount--;
 									}
 								}
-								else if (psCurrentEntry->sToken.eTokenName == TOK_LEFT_PAREN)
+								else if (eTokenName == TOK_LEFT_PAREN)
 								{
 									uBracketCount++;
 								}
-								else if ((psCurrentEntry->sToken.eTokenName == TOK_COMMA) && !uBracketCount)
+								else if ((eTokenName == TOK_COMMA) && !uBracketCount)
 								{
 									break;
 								}
 
 								/* Store this as current last token of parameter */
-								ppsParameterEntries[(uNumParameters * 2) + 1] = psCurrentEntry;
+								puParameterEntries[(uNumParameters * 2) + 1] = uCurrentEntry;
 								if(!uNumberOfParameterTokens)
 								{
 									/* This is also the first token of the parameter */
-									ppsParameterEntries[(uNumParameters * 2) + 0] = psCurrentEntry;
+									puParameterEntries[(uNumParameters * 2) + 0] = uCurrentEntry;
 								}
 
 								uNumberOfParameterTokens++;
 
-								psCurrentEntry = PPGetNextDirectiveTokenEntry(psCurrentEntry, psLastEntry);
+								uCurrentEntry = PPGetNextDirectiveToken(psTokens, uCurrentEntry, uLastEntry);
 							}
 
 #ifdef DUMP_LOGFILES
-							if(ppsParameterEntries[(uNumParameters * 2) + 0])
-							{
-								DumpLogMessage(LOGFILE_PREPROCESSOR,
+							DumpLogMessage(LOGFILE_PREPROCESSOR,
 										   0,
-										   "Parameter %d is %d tokens '%s' to '%s'\n",
+										   "Parameter %d is %d tokens\n",
 										   uNumParameters,
-										   uNumberOfParameterTokens,
-										   ppsParameterEntries[(uNumParameters * 2) + 0]->sToken.pvData, 
-										   ppsParameterEntries[(uNumParameters * 2) + 1]->sToken.pvData);
-							}
-							else
-							{
-								DumpLogMessage(LOGFILE_PREPROCESSOR,
-										   0,
-										   "Parameter %d is 0 tokens\n",
-										   uNumParameters);
-							}
+										   uNumberOfParameterTokens);
 #endif
 
 							/* Increase number of parameters */
 							uNumParameters++;
-							
+
 							/* Check for too many parameters */
 							if (uNumParameters >  psDefineMacro->uNumArgs)
 							{
 								LogProgramTokenError(psCPD->psErrorLog, psToken, "'%s' : Too many args for macro\n", pszDefineMacroName);
-								DebugMemFree(ppsParameterEntries);
-								if (ppsReturnEntry) *ppsReturnEntry = psCurrentEntry;
-								return IMG_FALSE;
+								bSuccess = IMG_FALSE;
+								break;
 							}
 
 							/* Check next token */
-							if (!psCurrentEntry)
+							if (uCurrentEntry == PP_NO_TOKEN)
 							{
 								LogProgramTokenError(psCPD->psErrorLog, psToken, "'%s' : Expected comma or bracket\n", pszDefineMacroName);
-								DebugMemFree(ppsParameterEntries);
-								if (ppsReturnEntry) *ppsReturnEntry = psCurrentEntry;
-								return IMG_FALSE;
+								bSuccess = IMG_FALSE;
+								break;
 							}
 
-							psToken = &(psCurrentEntry->sToken);
-				
+							psToken = PP_TOKEN(psTokens, uCurrentEntry);
+
 							/* Check for comma or bracket */
 							if (psToken->eTokenName == TOK_RIGHT_PAREN)
 							{
@@ -840,18 +1211,21 @@ static IMG_BOOL PPCheckForMacroReplacement(GLSLCompilerPrivateData *psCPD,
 							else if (psToken->eTokenName != TOK_COMMA)
 							{
 								LogProgramTokenError(psCPD->psErrorLog, psToken, "'%s' : Expected comma or bracket\n", pszDefineMacroName);
-								DebugMemFree(ppsParameterEntries);
-								if (ppsReturnEntry) *ppsReturnEntry = psCurrentEntry;
-								return IMG_FALSE;
+								bSuccess = IMG_FALSE;
+								break;
 							}
 						}
+
+						if (!bSuccess)
+						{
+							break;
+						}
 					}
 					else
 					{
 						LogProgramTokenError(psCPD->psErrorLog, psToken, "'%s' : Expected macro parameter\n", pszDefineMacroName);
-						DebugMemFree(ppsParameterEntries);
-						if (ppsReturnEntry) *ppsReturnEntry = psCurrentEntry;
-						return IMG_FALSE;
+						bSuccess = IMG_FALSE;
+						break;
 					}
 
 				} /* if (psDefineMacro->bTakesArgs) */
@@ -860,51 +1234,45 @@ static IMG_BOOL PPCheckForMacroReplacement(GLSLCompilerPrivateData *psCPD,
 				if (uNumParameters < psDefineMacro->uNumArgs)
 				{
 					LogProgramTokenError(psCPD->psErrorLog, psToken, "'%s' : Too few args for macro\n", pszDefineMacroName);
-
-					if (ppsParameterEntries)
-					{
-						DebugMemFree(ppsParameterEntries);
-					}
-					if (ppsReturnEntry) *ppsReturnEntry = psCurrentEntry;
-					return IMG_FALSE;
+					bSuccess = IMG_FALSE;
+					break;
 				}
-			
+
+				/* Build the replacement */
+				psContext->sExpansion.uStart = 0;
+				psContext->sExpansion.uEnd   = 0;
+
 				if (!psDefineMacro->uNumArgUsages)
 				{
-					/* Replace the current token with the defined list */
-					PPInsertTokensIntoLinkedList(psTokMemHeap,
-											   psCurrentEntry,
-											   psDefineMacro->psTokenList,
-											   psDefineMacro->uNumTokens,
-											   psFirstEntryOfMacro);
+					bSuccess = PPAppendMacroTokens(&psContext->sExpansion,
+												   psDefineMacro->psTokenList,
+												   psDefineMacro->uNumTokens,
+												   &sMacroToken);
 				}
 				else
 				{
 					IMG_UINT32 uStartOfTokenList = 0;
 					IMG_UINT32 uNumArgsUsed      = 0;
-					TokenLL   *psInsertionPoint  = psCurrentEntry;
 
-					for (i = 0; (i < psDefineMacro->uNumTokens) && (uNumArgsUsed < psDefineMacro->uNumArgUsages); i++)
+					for (i = 0; bSuccess && (i < psDefineMacro->uNumTokens) && (uNumArgsUsed < psDefineMacro->uNumArgUsages); i++)
 					{
 						if (psDefineMacro->puArgumentPositions[uNumArgsUsed] == i)
 						{
-							TokenLL *psFirstParamterEntry = ppsParameterEntries[(psDefineMacro->puArgumentToUse[uNumArgsUsed] * 2) + 0];
+							IMG_UINT32 uFirstParameterEntry = puParameterEntries[(psDefineMacro->puArgumentToUse[uNumArgsUsed] * 2) + 0];
 
 							/* Copy all tokens up until this point in */
-							psInsertionPoint = PPInsertTokensIntoLinkedList(psTokMemHeap,
-																		  psInsertionPoint, 
-																		  &psDefineMacro->psTokenList[uStartOfTokenList], 
-																		  i - uStartOfTokenList,
-																		  psFirstEntryOfMacro);
+							bSuccess = PPAppendMacroTokens(&psContext->sExpansion,
+														   &psDefineMacro->psTokenList[uStartOfTokenList],
+														   i - uStartOfTokenList,
+														   &sMacroToken);
 
-							if(psFirstParamterEntry)/* Check for empty parameter */
+							if(bSuccess && uFirstParameterEntry != PP_NO_TOKEN)/* Check for empty parameter */
 							{
 								/* Copy the parameter tokens in */
-								TokenLL *psLastParamterEntry = ppsParameterEntries[(psDefineMacro->puArgumentToUse[uNumArgsUsed] * 2) + 1];							
-								psInsertionPoint = PPReplicateAndInsertIntoLinkedList(psTokMemHeap,
-																		 psInsertionPoint, 
-																		 psFirstParamterEntry, 
-																		 psLastParamterEntry);
+								bSuccess = PPAppendParameterTokens(&psContext->sExpansion,
+																   psTokens,
+																   uFirstParameterEntry,
+																   puParameterEntries[(psDefineMacro->puArgumentToUse[uNumArgsUsed] * 2) + 1]);
 							}
 
 							uNumArgsUsed++;
@@ -914,11 +1282,13 @@ static IMG_BOOL PPCheckForMacroReplacement(GLSLCompilerPrivateData *psCPD,
 					}
 
 					/* Copy any remaining tokens in */
-					psInsertionPoint = PPInsertTokensIntoLinkedList(psTokMemHeap,
-																  psInsertionPoint,
-																  &psDefineMacro->psTokenList[uStartOfTokenList],
-																  psDefineMacro->uNumTokens - uStartOfTokenList,
-																  psFirstEntryOfMacro);
+					if (bSuccess)
+					{
+						bSuccess = PPAppendMacroTokens(&psContext->sExpansion,
+													   &psDefineMacro->psTokenList[uStartOfTokenList],
+													   psDefineMacro->uNumTokens - uStartOfTokenList,
+													   &sMacroToken);
+					}
 
 					if (uNumArgsUsed != psDefineMacro->uNumArgUsages)
 					{
@@ -926,80 +1296,87 @@ static IMG_BOOL PPCheckForMacroReplacement(GLSLCompilerPrivateData *psCPD,
 					}
 				}
 
+				if (!bSuccess)
+				{
+					break;
+				}
+
 #ifdef DUMP_LOGFILES
 				DumpLogMessage(LOGFILE_PREPROCESSOR,
 							   5,
-							   "Replacing '%s' (%d:%d:%d) with '",
-							   psToken->pvData,
-							   psToken->uStringNumber,
-							   psToken->uLineNumber,
-							   psToken->uCharNumber);
+							   "Replacing '%s' (%d:%d:%d) with %d token(s)\n",
+							   pszDefineMacroName,
+							   sMacroToken.sToken.uStringNumber,
+							   sMacroToken.sToken.uLineNumber,
+							   sMacroToken.sToken.uCharNumber,
+							   psDefineMacro->uNumTokens);
+#endif
 
-				for (i = 0; i <  psDefineMacro->uNumTokens; i++)
+				/* Everything in front of the macro has been checked */
+				if (!PPFlushTokens(psTokens, uFirstEntryOfMacro, psOut))
 				{
-					DumpLogMessage(LOGFILE_PREPROCESSOR, 0, "%s", psDefineMacro->psTokenList[i].pvData);
-
-					if (i < psDefineMacro->uNumTokens - 1)
-					{
-						DumpLogMessage(LOGFILE_PREPROCESSOR, 0, " ");
-					}
+					bSuccess = IMG_FALSE;
+					break;
 				}
 
-				DumpLogMessage(LOGFILE_PREPROCESSOR, 0, "'\n");
-#endif
-
-				if (ppsParameterEntries)
+				/* Place the replacement after the last token of the macro usage, the usage is removed below */
+				if (!PPInsertTokens(psTokens,
+									uCurrentEntry + 1,
+									&psContext->sExpansion.psTokens[0],
+									psContext->sExpansion.uEnd,
+									&uShift))
 				{
-					DebugMemFree(ppsParameterEntries);
-					ppsParameterEntries = IMG_NULL;
+					bSuccess = IMG_FALSE;
+					break;
 				}
 
+				uFirstEntryOfMacro += uShift - psContext->sExpansion.uEnd;
+				uCurrentEntry      += uShift - psContext->sExpansion.uEnd;
 
-				if (psCurrentEntry == psFirstEntry)
+				if (uLastEntry != PP_NO_TOKEN)
 				{
-					/* This is now the first entry */
-					psFirstEntry = psCurrentEntry->psNext;
+					uLastEntry += uShift;
 				}
 			}
 			/* Handle defined situations */
-			else if (strcmp(psToken->pvData, "defined") == 0)
+			else if (psIdentifier && psIdentifier == psContext->psDefinedIdentifier)
 			{
 				IMG_BOOL bBracketed = IMG_FALSE;
 
-				IMG_CHAR *pszDefineName;
+				PPIdentifier *psDefineIdentifier;
 
-				psFirstEntryOfMacro = psCurrentEntry;
+				uFirstEntryOfMacro = uCurrentEntry;
 
-				psCurrentEntry = PPGetNextDirectiveTokenEntry(psCurrentEntry, psLastEntry);
+				uCurrentEntry = PPGetNextDirectiveToken(psTokens, uCurrentEntry, uLastEntry);
 
 				/* Check for left bracket */
-				if (psCurrentEntry && psCurrentEntry->sToken.eTokenName == TOK_LEFT_PAREN)
+				if (uCurrentEntry != PP_NO_TOKEN && PP_TOKEN(psTokens, uCurrentEntry)->eTokenName == TOK_LEFT_PAREN)
 				{
 					bBracketed = IMG_TRUE;
-					
-					psCurrentEntry = PPGetNextDirectiveTokenEntry(psCurrentEntry, psLastEntry);
+
+					uCurrentEntry = PPGetNextDirectiveToken(psTokens, uCurrentEntry, uLastEntry);
 				}
 
 				/* Check for name of define we're checking */
-				if (!psCurrentEntry || !POSSIBLE_DEFINE_NAME(&(psCurrentEntry->sToken)))
+				if (uCurrentEntry == PP_NO_TOKEN || !POSSIBLE_DEFINE_NAME(PP_TOKEN(psTokens, uCurrentEntry)))
 				{
 					LogProgramTokenError(psCPD->psErrorLog, psToken, "'defined' : expected define name\n");
-					if (ppsReturnEntry) *ppsReturnEntry = psCurrentEntry;
-					return IMG_FALSE;
+					bSuccess = IMG_FALSE;
+					break;
 				}
 
-				pszDefineName = psCurrentEntry->sToken.pvData;
+				psDefineIdentifier = PPGetTokenIdentifier(psContext, &psTokens->psTokens[uCurrentEntry], IMG_FALSE);
 
 				/* If there was a left bracket the check for a right one */
 				if (bBracketed)
 				{
-					psCurrentEntry = PPGetNextDirectiveTokenEntry(psCurrentEntry, psLastEntry);
+					uCurrentEntry = PPGetNextDirectiveToken(psTokens, uCurrentEntry, uLastEntry);
 
-					if (!psCurrentEntry || psCurrentEntry->sToken.eTokenName != TOK_RIGHT_PAREN)
+					if (uCurrentEntry == PP_NO_TOKEN || PP_TOKEN(psTokens, uCurrentEntry)->eTokenName != TOK_RIGHT_PAREN)
 					{
 						LogProgramTokenError(psCPD->psErrorLog, psToken, "'defined' : expected right bracket\n");
-						if (ppsReturnEntry) *ppsReturnEntry = psCurrentEntry;
-						return IMG_FALSE;
+						bSuccess = IMG_FALSE;
+						break;
 					}
 				}
 
@@ -1007,116 +1384,66 @@ static IMG_BOOL PPCheckForMacroReplacement(GLSLCompilerPrivateData *psCPD,
 				   Don't need to replace these tokens, simply change the identifer/right bracket token to be
 				   an int constant with a value of 1 if the define exists or 0 if it doesn't
 				*/
-				psCurrentEntry->sToken.eTokenName = TOK_INTCONSTANT;
+				psPPToken = &psTokens->psTokens[uCurrentEntry];
 
+				if (!PPSetTokenNumber(psContext,
+									  &psPPToken->sToken,
+									  (psDefineIdentifier && psDefineIdentifier->psDefineMacro) ? 1 : 0))
+				{
+					bSuccess = IMG_FALSE;
+					break;
+				}
 
-#ifdef DUMP_LOGFILES
-				DumpLogMessage(LOGFILE_PREPROCESSOR, 0, "Found usage of 'defined'\n");
+				psPPToken->psIdentifier = IMG_NULL;
 
+#ifdef DUMP_LOGFILES
 				DumpLogMessage(LOGFILE_PREPROCESSOR,
 							   5,
-							   "Replacing '%s' (%d:%d:%d) with '",
-							   psCurrentEntry->sToken.pvData,
-							   psCurrentEntry->sToken.uStringNumber,
-							   psCurrentEntry->sToken.uLineNumber,
-							   psCurrentEntry->sToken.uCharNumber);
+							   "Replacing usage of 'defined' (%d:%d:%d) with '%s'\n",
+							   psPPToken->sToken.uStringNumber,
+							   psPPToken->sToken.uLineNumber,
+							   psPPToken->sToken.uCharNumber,
+							   psPPToken->sToken.pvData);
 #endif
 
-
-				if (FindSymbol(psSymbolTable,
-							   pszDefineName,
-							   &uSymbolID,
-							   IMG_TRUE))
-				{
-					strcpy(psCurrentEntry->sToken.pvData, "1");
-				}
-				else
+				/* Everything in front of 'defined' has been checked */
+				if (!PPFlushTokens(psTokens, uFirstEntryOfMacro, psOut))
 				{
-					strcpy(psCurrentEntry->sToken.pvData, "0");
+					bSuccess = IMG_FALSE;
+					break;
 				}
 
-#ifdef DUMP_LOGFILES
-				DumpLogMessage(LOGFILE_PREPROCESSOR, 0, "%s'\n",  psCurrentEntry->sToken.pvData);
-#endif
-				/* Wind the pointer back one since we don't want to remove the entry we've replaced */
-				psCurrentEntry = psCurrentEntry->psPrev;
-
+				/* Wind the index back one since we don't want to remove the entry we've replaced */
+				uCurrentEntry--;
 			}
 		}
-		
 
-		psCurrentEntry = PPGetNextDirectiveTokenEntry(psCurrentEntry, psLastEntry);
+		uCurrentEntry = PPGetNextDirectiveToken(psTokens, uCurrentEntry, uLastEntry);
 
-
-		/* Remove all tokens that made up the macro */
-		if (psCurrentEntry == IMG_NULL)
+		/*
+		   Remove all tokens that made up the macro. Any tokens in front of it have been
+		   moved to the output so it is at the start of the array.
+		*/
+		if (uFirstEntryOfMacro != PP_NO_TOKEN)
 		{
-			if (psFirstEntryOfMacro != IMG_NULL)
+			if (uCurrentEntry == PP_NO_TOKEN)
 			{
-				PPRemoveTokenLLEntry(psTokMemHeap, psFirstEntryOfMacro);
+				psTokens->uStart = uFirstEntryOfMacro + 1;
 			}
-		}
-		else
-		{
-			while (psFirstEntryOfMacro && (psFirstEntryOfMacro != psCurrentEntry))
+			else
 			{
-				TokenLL *psNextEntry = psFirstEntryOfMacro->psNext;
-
-				PPRemoveTokenLLEntry(psTokMemHeap, psFirstEntryOfMacro);
-
-				psFirstEntryOfMacro = psNextEntry;
+				psTokens->uStart = uCurrentEntry;
 			}
 		}
 	}
 
-#ifdef DUMP_LOGFILES
-
-	//DumpLogMessage(LOGFILE_PREPROCESSOR, 0, "Returning with a pointer to '%s'\n", psFirstEntry->sToken.pvData);
-#endif
-
-	if (ppsReturnEntry) *ppsReturnEntry = psFirstEntry;
-	return IMG_TRUE;
-}
-
-
-
-/******************************************************************************
- * Function Name: PPDestroyTokenLinkedList
- *
- * Inputs       : psTokMemHeap   - Memory heap where the tokens were allocated from.
- *                psEntry        - First element of the linked list.
- * Outputs      : -
- * Returns      : 
- * Globals Used : -
- *
- * Description  : Destroys a linked list of tokens.
- *****************************************************************************/
-static IMG_BOOL PPDestroyTokenLinkedList(MemHeap     *psTokMemHeap, TokenLL *psEntry)
-{
-	TokenLL *psCurrentEntry = psEntry;
-
-	/* Go to start of list */
-	while (psCurrentEntry->psPrev)
-	{
-		psCurrentEntry = psCurrentEntry->psPrev;
-	}
-	
-	/* Go through all of list deleting members */
-	while (psCurrentEntry)
+	/* Move whatever is left to the output */
+	if (!PPFlushTokens(psTokens, psTokens->uEnd, psOut))
 	{
-		TokenLL *psNext = psCurrentEntry->psNext;
-
-		if (psCurrentEntry->sToken.pvData)
-		{
-			DebugMemFree(psCurrentEntry->sToken.pvData);
-		}
-
-		DebugFreeHeapItem(psTokMemHeap, psCurrentEntry);
-
-		psCurrentEntry = psNext;
+		bSuccess = IMG_FALSE;
 	}
 
-	return IMG_TRUE;
+	return bSuccess;
 }
 
 
@@ -1361,35 +1688,38 @@ static IMG_VOID PPFreeExpressionTree(ExpressionNode *psExpressionTree)
 /******************************************************************************
  * Function Name: PPCreateExpressionTree
  *
- * Inputs       : psTokenEntry     - First token in the expression
- *                psLastTokenEntry - Last token in the expression
+ * Inputs       : psTokens         - Token array
+ *                uTokenEntry      - Token in front of the expression
+ *                uLastTokenEntry  - Last token in the expression
  * Outputs      : -
  * Returns      : An expression tree formed by the token list.
  * Globals Used : -
  *
  * Description  : Given a list of tokens it builds an expression tree with them.
  *****************************************************************************/
-static ExpressionNode *PPCreateExpressionTree(GLSLCompilerPrivateData *psCPD, TokenLL  *psTokenEntry,
-										 TokenLL  *psLastTokenEntry)
+static ExpressionNode *PPCreateExpressionTree(GLSLCompilerPrivateData *psCPD,
+											  PPTokenArray *psTokens,
+											  IMG_UINT32    uTokenEntry,
+											  IMG_UINT32    uLastTokenEntry)
 {
 	Token *psLastToken = IMG_NULL;
 	ExpressionNode *psCurrentNode = IMG_NULL;
 	IMG_INT32 nPrecedenceAdjuster = 0;
 
 	/* Get 1st token */
-	psTokenEntry = PPGetNextDirectiveTokenEntry(psTokenEntry, psLastTokenEntry);
+	uTokenEntry = PPGetNextDirectiveToken(psTokens, uTokenEntry, uLastTokenEntry);
 
-	if (!psTokenEntry)
+	if (uTokenEntry == PP_NO_TOKEN)
 	{
 		LOG_INTERNAL_ERROR(("PPCreateExpressionTree: No tokens!\n"));
 		return IMG_NULL;
 	}
 
-	while (psTokenEntry)
+	while (uTokenEntry != PP_NO_TOKEN)
 	{
 		IMG_UINT32 uTokenPrecedence;
 
-		Token *psToken = &psTokenEntry->sToken;
+		Token *psToken = PP_TOKEN(psTokens, uTokenEntry);
 
 		/* Brackets adjust tokens precedence */
 		if (psToken->eTokenName == TOK_LEFT_PAREN)
@@ -1486,7 +1816,7 @@ static ExpressionNode *PPCreateExpressionTree(GLSLCompilerPrivateData *psCPD, To
 		psLastToken = psToken;
 
 		/* Get the next token */
-		psTokenEntry = PPGetNextDirectiveTokenEntry(psTokenEntry, psLastTokenEntry);
+		uTokenEntry = PPGetNextDirectiveToken(psTokens, uTokenEntry, uLastTokenEntry);
 	}
 
 	/* Were all brackets closed? */
@@ -1514,14 +1844,13 @@ static ExpressionNode *PPCreateExpressionTree(GLSLCompilerPrivateData *psCPD, To
  * Function Name: PPCalculateResultOfExpressionTree
  *
  * Inputs       : psExpressionTree  - Expression tree to evaluate.
- *                psSymbolTable     - Symbol table of macros.
  * Outputs      : -
  * Returns      : 
  * Globals Used : -
  *
- * Description  : Evaluates an expression tree given a symbol table with the values of all defined macros.
+ * Description  : Evaluates an expression tree. Macros have already been replaced by their values.
  *****************************************************************************/
-static IMG_INT32 PPCalculateResultOfExpressionTree(GLSLCompilerPrivateData *psCPD, ExpressionNode *psExpressionTree, SymTable *psSymbolTable)
+static IMG_INT32 PPCalculateResultOfExpressionTree(GLSLCompilerPrivateData *psCPD, ExpressionNode *psExpressionTree)
 {
 	ExpressionNode *psCurrentNode = psExpressionTree;
 
@@ -1601,7 +1930,7 @@ static IMG_INT32 PPCalculateResultOfExpressionTree(GLSLCompilerPrivateData *psCP
 	/* recursively pick up values of children */
 	for (i = 0; i < psCurrentNode->uNumChildren; i++)
 	{
-		nSrcs[i] = PPCalculateResultOfExpressionTree(psCPD, psCurrentNode->psChildNode[i], psSymbolTable);
+		nSrcs[i] = PPCalculateResultOfExpressionTree(psCPD, psCurrentNode->psChildNode[i]);
 	}
 
 	switch (psToken->eTokenName)
@@ -1669,77 +1998,118 @@ static IMG_INT32 PPCalculateResultOfExpressionTree(GLSLCompilerPrivateData *psCP
 	}
 }
 
+/******************************************************************************
+ * Function Name: PPEvaluateExpression
+ *
+ * Inputs       : psContext         - Preprocessor context
+ *                psTokens          - Tokens of the directive
+ *                uTokenEntry       - Directive name token, the expression follows it
+ *                uLastTokenEntry   - Last token of the directive
+ *                psOut             - Array that receives the tokens of the directive
+ *
+ * Outputs      : pbResult          - Result of the expression
+ * Returns      : IMG_FALSE if macro replacement failed
+ * Globals Used : -
+ *
+ * Description  : Replaces macros in the expression of a #if or #elif and evaluates it.
+ *****************************************************************************/
+static IMG_BOOL PPEvaluateExpression(GLSLCompilerPrivateData *psCPD,
+									 GLSLPreProcessorContext *psContext,
+									 PPTokenArray            *psTokens,
+									 IMG_UINT32               uTokenEntry,
+									 IMG_UINT32               uLastTokenEntry,
+									 PPTokenArray            *psOut,
+									 IMG_BOOL                *pbResult)
+{
+	ExpressionNode *psExpressionTree;
+
+	*pbResult = IMG_FALSE;
+
+	/* The expression is evaluated from the output, so move the tokens in front of it there first */
+	if (!PPFlushTokens(psTokens, uTokenEntry, psOut))
+	{
+		return IMG_FALSE;
+	}
+
+	/* Check for macro usage within */
+	if (!PPCheckForMacroReplacement(psCPD, psContext, psTokens, uLastTokenEntry, psOut, &uTokenEntry))
+	{
+		return IMG_FALSE;
+	}
+
+	/* Create expression tree */
+	psExpressionTree = PPCreateExpressionTree(psCPD, psOut, uTokenEntry, psOut->uEnd - 1);
+
+	if (psExpressionTree)
+	{
+		/* Calculate result of expression */
+		*pbResult = PPCalculateResultOfExpressionTree(psCPD, psExpressionTree) > 0 ? IMG_TRUE : IMG_FALSE;
+
+		/* Free the expression tree */
+		PPFreeExpressionTree(psExpressionTree);
+	}
+
+#ifdef DUMP_LOGFILES
+	DumpLogMessage(LOGFILE_PREPROCESSOR,
+				   0,
+				   "#%s  %s (%d:%d:%d)\n",
+				   PP_TOKEN(psOut, uTokenEntry)->pvData,
+				   *pbResult ? "TRUE" : "FALSE",
+				   PP_TOKEN(psOut, uTokenEntry)->uStringNumber,
+				   PP_TOKEN(psOut, uTokenEntry)->uLineNumber,
+				   PP_TOKEN(psOut, uTokenEntry)->uCharNumber);
+#endif
+
+	return IMG_TRUE;
+}
+
 /******************************************************************************
  * Function Name: PPProcessIf
  *
- * Inputs       : psTokMemHeap      - Memory heap where the tokens will be allocated from.
- *                psTokenEntry      - First token to process
- *                psLastTokenEntry  - Last token to process
- *                psSymbolTable     - Symbol table with macro definitions.
+ * Inputs       : psContext         - Preprocessor context
+ *                psTokens          - Tokens of the directive
+ *                uTokenEntry       - First token to process
+ *                uLastTokenEntry   - Last token to process
+ *                psOut             - Array that receives the tokens of the directive
  *                psIfStatus        - NFI.
  *
  * Outputs      : NFI.
- * Returns      : 
+ * Returns      :
  * Globals Used : -
  *
  * Description  : NFI.
  *****************************************************************************/
 static IMG_BOOL PPProcessIf(GLSLCompilerPrivateData *psCPD,
-							MemHeap     *psTokMemHeap,
-							TokenLL     *psTokenEntry,
-							TokenLL     *psLastTokenEntry,
-							SymTable    *psSymbolTable,
-							IfStatus    *psIfStatus)
+							GLSLPreProcessorContext *psContext,
+							PPTokenArray *psTokens,
+							IMG_UINT32    uTokenEntry,
+							IMG_UINT32    uLastTokenEntry,
+							PPTokenArray *psOut,
+							IfStatus     *psIfStatus)
 {
 	/* Only evaluate the expression if we're inside an enabled block */
 	if (BLOCK_ENABLED(psIfStatus->aeIfBlockStates[psIfStatus->uCurrentActiveLevel]))
 	{
-		ExpressionNode *psExpressionTree; 
-
-		IMG_BOOL bIfResult = IMG_FALSE;
+		IMG_BOOL bIfResult;
 
 		/* Check for enough tokens */
-		if (!PPGetNextDirectiveTokenEntry(psTokenEntry, psLastTokenEntry))
+		if (PPGetNextDirectiveToken(psTokens, uTokenEntry, uLastTokenEntry) == PP_NO_TOKEN)
 		{
-			LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "invalid integer constant expression\n");
+			LogProgramTokenError(psCPD->psErrorLog, PP_TOKEN(psTokens, uTokenEntry), "invalid integer constant expression\n");
 			return IMG_FALSE;
 		}
 
-		/* Check for macro usage within */
-		if (!PPCheckForMacroReplacement(psCPD, psTokMemHeap, psTokenEntry, psLastTokenEntry, psSymbolTable, &psTokenEntry, IMG_NULL))
+		if (!PPEvaluateExpression(psCPD, psContext, psTokens, uTokenEntry, uLastTokenEntry, psOut, &bIfResult))
 		{
 			return IMG_FALSE;
 		}
 
-		/* Create expression tree */
-		psExpressionTree = PPCreateExpressionTree(psCPD, psTokenEntry, psLastTokenEntry);
-
-		if (psExpressionTree)
-		{
-			/* Calculate result of expression */
-			bIfResult = PPCalculateResultOfExpressionTree(psCPD, psExpressionTree, psSymbolTable) > 0 ? IMG_TRUE : IMG_FALSE;
-
-			/* Free the expression tree */
-			PPFreeExpressionTree(psExpressionTree);
-		}
-
-
-#ifdef DUMP_LOGFILES
-	DumpLogMessage(LOGFILE_PREPROCESSOR,
-				   0,
-				   "#if  %s (%d:%d:%d)\n",
-				   bIfResult ? "TRUE" : "FALSE",
-				   psTokenEntry->sToken.uStringNumber,
-				   psTokenEntry->sToken.uLineNumber,
-				   psTokenEntry->sToken.uCharNumber);
-#endif
-
 		psIfStatus->uNestedIfLevel++;
 
 		/* Check we haven't exceeded maximum nesting level */
 		if (psIfStatus->uNestedIfLevel >= MAX_NESTED_IF_LEVELS)
 		{
-			LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "Max number of nested #if's is 255\n");
+			LogProgramTokenError(psCPD->psErrorLog, PP_TOKEN(psOut, psOut->uEnd - 1), "Max number of nested #if's is 255\n");
 			return IMG_FALSE;
 		}
 
@@ -1765,9 +2135,9 @@ static IMG_BOOL PPProcessIf(GLSLCompilerPrivateData *psCPD,
 	DumpLogMessage(LOGFILE_PREPROCESSOR,
 				   0,
 				   "#if  not processed (inside disabled block) (%d:%d:%d)\n",
-				   psTokenEntry->sToken.uStringNumber,
-				   psTokenEntry->sToken.uLineNumber,
-				   psTokenEntry->sToken.uCharNumber);
+				   PP_TOKEN(psTokens, uTokenEntry)->uStringNumber,
+				   PP_TOKEN(psTokens, uTokenEntry)->uLineNumber,
+				   PP_TOKEN(psTokens, uTokenEntry)->uCharNumber);
 #endif
 
 		/* Just keep a count so we can match the endifs */
@@ -1780,43 +2150,44 @@ static IMG_BOOL PPProcessIf(GLSLCompilerPrivateData *psCPD,
 /******************************************************************************
  * Function Name: PPProcessElif
  *
- * Inputs       : psTokMemHeap      - Memory heap where the tokens will be allocated from.
- *                psTokenEntry      - First token to process
- *                psLastTokenEntry  - Last token to process
- *                psSymbolTable     - Symbol table with macro definitions.
+ * Inputs       : psContext         - Preprocessor context
+ *                psTokens          - Tokens of the directive
+ *                uTokenEntry       - First token to process
+ *                uLastTokenEntry   - Last token to process
+ *                psOut             - Array that receives the tokens of the directive
  *                psIfStatus        - NFI.
  *
  * Outputs      : NFI.
- * Returns      : 
+ * Returns      :
  * Globals Used : -
  *
  * Description  : NFI.
  *****************************************************************************/
-static IMG_BOOL PPProcessElif(GLSLCompilerPrivateData *psCPD, MemHeap     *psTokMemHeap,
-							TokenLL     *psTokenEntry,
-							TokenLL     *psLastTokenEntry,
-							SymTable    *psSymbolTable,
-							IfStatus    *psIfStatus)
+static IMG_BOOL PPProcessElif(GLSLCompilerPrivateData *psCPD,
+							  GLSLPreProcessorContext *psContext,
+							  PPTokenArray *psTokens,
+							  IMG_UINT32    uTokenEntry,
+							  IMG_UINT32    uLastTokenEntry,
+							  PPTokenArray *psOut,
+							  IfStatus     *psIfStatus)
 {
 	/* Only evaluate the expression if we're inside an enabled block */
-	if (BLOCK_ENABLED(psIfStatus->aeIfBlockStates[psIfStatus->uCurrentActiveLevel]) || 
+	if (BLOCK_ENABLED(psIfStatus->aeIfBlockStates[psIfStatus->uCurrentActiveLevel]) ||
 		(psIfStatus->uCurrentActiveLevel == psIfStatus->uNestedIfLevel))
 	{
-		ExpressionNode *psExpressionTree; 
-
 		IfBlockState *peIfBlockState = &(psIfStatus->aeIfBlockStates[psIfStatus->uNestedIfLevel]);
 
-		IMG_BOOL bElifResult = IMG_FALSE;
+		IMG_BOOL bElifResult;
 
 		/* Check we're not at the base level */
 		if (!psIfStatus->uNestedIfLevel)
 		{
-			LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "'' : syntax error #elif mismatch\n");
+			LogProgramTokenError(psCPD->psErrorLog, PP_TOKEN(psTokens, uTokenEntry), "'' : syntax error #elif mismatch\n");
 			return IMG_FALSE;
 		}
 
-		/* If we have already found an enabled #if block and are now ignoring 
-		   all further #ifs until the matching #endif, skip processing this 
+		/* If we have already found an enabled #if block and are now ignoring
+		   all further #ifs until the matching #endif, skip processing this
 		   #elif - we know it is disabled  */
 		if(*peIfBlockState == IFSTATE_BLOCK_IGNORE_ALL_FURTHER_IFS)
 		{
@@ -1829,51 +2200,28 @@ static IMG_BOOL PPProcessElif(GLSLCompilerPrivateData *psCPD, MemHeap     *psTok
 			/* Yes - then this and all further #else and #elif's should be ignored until we reach an #endif */
 			*peIfBlockState = IFSTATE_BLOCK_IGNORE_ALL_FURTHER_IFS;
 
-			return IMG_TRUE; 
+			return IMG_TRUE;
 		}
 
 
 		/* Check for enough tokens */
-		if (!PPGetNextDirectiveTokenEntry(psTokenEntry, psLastTokenEntry))
+		if (PPGetNextDirectiveToken(psTokens, uTokenEntry, uLastTokenEntry) == PP_NO_TOKEN)
 		{
-			LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "invalid integer constant expression\n");
+			LogProgramTokenError(psCPD->psErrorLog, PP_TOKEN(psTokens, uTokenEntry), "invalid integer constant expression\n");
 			return IMG_FALSE;
 		}
 
-		/* Check for macro usage within */
-		if (!PPCheckForMacroReplacement(psCPD, psTokMemHeap, psTokenEntry, psLastTokenEntry, psSymbolTable, &psTokenEntry, IMG_NULL))
+		if (!PPEvaluateExpression(psCPD, psContext, psTokens, uTokenEntry, uLastTokenEntry, psOut, &bElifResult))
 		{
 			return IMG_FALSE;
 		}
 
-		/* Create expression tree */
-		psExpressionTree = PPCreateExpressionTree(psCPD, psTokenEntry, psLastTokenEntry);
-
-		if (psExpressionTree)
-		{
-			/* Calculate result of expression */
-			bElifResult = PPCalculateResultOfExpressionTree(psCPD, psExpressionTree, psSymbolTable) > 0 ? IMG_TRUE : IMG_FALSE;
-
-			/* Free the expression tree */
-			PPFreeExpressionTree(psExpressionTree);
-		}
-
-#ifdef DUMP_LOGFILES
-	DumpLogMessage(LOGFILE_PREPROCESSOR,
-				   0,
-				   "#elif  %s (%d:%d:%d)\n",
-				   bElifResult ? "TRUE" : "FALSE",
-				   psTokenEntry->sToken.uStringNumber,
-				   psTokenEntry->sToken.uLineNumber,
-				   psTokenEntry->sToken.uCharNumber);
-#endif
-
 		/* Update the current status */
 		if (bElifResult)
 		{
 			/* Mark this block as enabled */
 			*peIfBlockState  = IFSTATE_BLOCK_ELIF_ENABLED;
-		}	
+		}
 		else
 		{
 			/* Mark this block as disabled */
@@ -1886,9 +2234,9 @@ static IMG_BOOL PPProcessElif(GLSLCompilerPrivateData *psCPD, MemHeap     *psTok
 		DumpLogMessage(LOGFILE_PREPROCESSOR,
 					   0,
 					   "#elif  not processed (inside disabled block) (%d:%d:%d)\n",
-					   psTokenEntry->sToken.uStringNumber,
-					   psTokenEntry->sToken.uLineNumber,
-					   psTokenEntry->sToken.uCharNumber);
+					   PP_TOKEN(psTokens, uTokenEntry)->uStringNumber,
+					   PP_TOKEN(psTokens, uTokenEntry)->uLineNumber,
+					   PP_TOKEN(psTokens, uTokenEntry)->uCharNumber);
 #endif
 	}
 
@@ -1898,33 +2246,36 @@ static IMG_BOOL PPProcessElif(GLSLCompilerPrivateData *psCPD, MemHeap     *psTok
 /******************************************************************************
  * Function Name: PPProcessElse
  *
- * Inputs       : psTokenEntry      - First token to process
- *                psLastTokenEntry  - Last token to process
+ * Inputs       : psTokens          - Tokens of the directive
+ *                uTokenEntry       - First token to process
+ *                uLastTokenEntry   - Last token to process
  *                psIfStatus        - NFI.
  *
  * Outputs      : NFI.
- * Returns      : 
+ * Returns      :
  * Globals Used : -
  *
  * Description  : NFI.
  *****************************************************************************/
-static IMG_BOOL PPProcessElse(GLSLCompilerPrivateData *psCPD, TokenLL  *psTokenEntry,
-							TokenLL  *psLastTokenEntry,
-							IfStatus *psIfStatus)
+static IMG_BOOL PPProcessElse(GLSLCompilerPrivateData *psCPD,
+							  PPTokenArray *psTokens,
+							  IMG_UINT32    uTokenEntry,
+							  IMG_UINT32    uLastTokenEntry,
+							  IfStatus     *psIfStatus)
 {
 	/* Only evaluate the expression if we're inside an enabled block */
-	if (BLOCK_ENABLED(psIfStatus->aeIfBlockStates[psIfStatus->uCurrentActiveLevel]) || 
+	if (BLOCK_ENABLED(psIfStatus->aeIfBlockStates[psIfStatus->uCurrentActiveLevel]) ||
 		(psIfStatus->uCurrentActiveLevel == psIfStatus->uNestedIfLevel))
 	{
 
 		IfBlockState *peIfBlockState = &(psIfStatus->aeIfBlockStates[psIfStatus->uNestedIfLevel]);
 
-		PVR_UNREFERENCED_PARAMETER(psLastTokenEntry);
+		PVR_UNREFERENCED_PARAMETER(uLastTokenEntry);
 
 		/* Check we're not at the base level */
 		if (!psIfStatus->uNestedIfLevel)
 		{
-			LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "'' : syntax error #else mismatch\n");
+			LogProgramTokenError(psCPD->psErrorLog, PP_TOKEN(psTokens, uTokenEntry), "'' : syntax error #else mismatch\n");
 			return IMG_FALSE;
 		}
 
@@ -1932,7 +2283,7 @@ static IMG_BOOL PPProcessElse(GLSLCompilerPrivateData *psCPD, TokenLL  *psTokenE
 		if (*peIfBlockState == IFSTATE_BLOCK_ELSE_ENABLED ||
 			*peIfBlockState == IFSTATE_BLOCK_ELSE_DISABLED)
 		{
-			LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "'' : syntax error #else after a #else\n");
+			LogProgramTokenError(psCPD->psErrorLog, PP_TOKEN(psTokens, uTokenEntry), "'' : syntax error #else after a #else\n");
 			return IMG_FALSE;
 		}
 
@@ -1947,9 +2298,9 @@ static IMG_BOOL PPProcessElse(GLSLCompilerPrivateData *psCPD, TokenLL  *psTokenE
 	DumpLogMessage(LOGFILE_PREPROCESSOR,
 				   0,
 				   "#else  TRUE (%d:%d:%d)\n",
-				   psTokenEntry->sToken.uStringNumber,
-				   psTokenEntry->sToken.uLineNumber,
-				   psTokenEntry->sToken.uCharNumber);
+				   PP_TOKEN(psTokens, uTokenEntry)->uStringNumber,
+				   PP_TOKEN(psTokens, uTokenEntry)->uLineNumber,
+				   PP_TOKEN(psTokens, uTokenEntry)->uCharNumber);
 #endif
 			}
 			else
@@ -1960,9 +2311,9 @@ static IMG_BOOL PPProcessElse(GLSLCompilerPrivateData *psCPD, TokenLL  *psTokenE
 	DumpLogMessage(LOGFILE_PREPROCESSOR,
 				   0,
 				   "#else  FALSE (%d:%d:%d)\n",
-				   psTokenEntry->sToken.uStringNumber,
-				   psTokenEntry->sToken.uLineNumber,
-				   psTokenEntry->sToken.uCharNumber);
+				   PP_TOKEN(psTokens, uTokenEntry)->uStringNumber,
+				   PP_TOKEN(psTokens, uTokenEntry)->uLineNumber,
+				   PP_TOKEN(psTokens, uTokenEntry)->uCharNumber);
 #endif
 			}
 		}
@@ -1974,59 +2325,65 @@ static IMG_BOOL PPProcessElse(GLSLCompilerPrivateData *psCPD, TokenLL  *psTokenE
 /******************************************************************************
  * Function Name: PPProcessIfdef
  *
- * Inputs       : psTokenEntry      - First token to process
- *                psLastTokenEntry  - Last token to process
- *                psSymbolTable     - Symbol table with macro definitions.
+ * Inputs       : psContext         - Preprocessor context
+ *                psTokens          - Tokens of the directive
+ *                uTokenEntry       - First token to process
+ *                uLastTokenEntry   - Last token to process
  *                psIfStatus        - NFI.
  *                bInvertResult     - NFI.
  *
  * Outputs      : NFI.
- * Returns      : 
+ * Returns      :
  * Globals Used : -
  *
  * Description  : NFI.
  *****************************************************************************/
-static IMG_BOOL PPProcessIfdef(GLSLCompilerPrivateData *psCPD, TokenLL  *psTokenEntry,
-							TokenLL  *psLastTokenEntry,
-							SymTable *psSymbolTable,
-							IfStatus *psIfStatus,
-							IMG_BOOL  bInvertResult)
+static IMG_BOOL PPProcessIfdef(GLSLCompilerPrivateData *psCPD,
+							   GLSLPreProcessorContext *psContext,
+							   PPTokenArray *psTokens,
+							   IMG_UINT32    uTokenEntry,
+							   IMG_UINT32    uLastTokenEntry,
+							   IfStatus     *psIfStatus,
+							   IMG_BOOL      bInvertResult)
 {
 	IMG_BOOL bIfResult = IMG_FALSE;
 
 	/* Only evaluate the expression if we're inside an enabled block */
 	if (BLOCK_ENABLED(psIfStatus->aeIfBlockStates[psIfStatus->uCurrentActiveLevel]))
 	{
-		psTokenEntry = PPGetNextDirectiveTokenEntry(psTokenEntry, psLastTokenEntry);
+		IMG_UINT32    uNameEntry = PPGetNextDirectiveToken(psTokens, uTokenEntry, uLastTokenEntry);
+		PPIdentifier *psIdentifier;
+		Token        *psToken;
 
 		/* Check for enough tokens */
-		if (!psTokenEntry)
+		if (uNameEntry == PP_NO_TOKEN)
 		{
-			LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "Syntax error, #if[n]def expected an identifier\n");
+			LogProgramTokenError(psCPD->psErrorLog, IMG_NULL, "Syntax error, #if[n]def expected an identifier\n");
 			return IMG_FALSE;
 		}
 
-		if (!POSSIBLE_DEFINE_NAME(&psTokenEntry->sToken))
+		psToken = PP_TOKEN(psTokens, uNameEntry);
+
+		if (!POSSIBLE_DEFINE_NAME(psToken))
 		{
-			LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "Syntax error, #if[n]def expected an identifier\n");
+			LogProgramTokenError(psCPD->psErrorLog, psToken, "Syntax error, #if[n]def expected an identifier\n");
 			return IMG_FALSE;
 		}
 
 		/* After the identifier, we must have either a newline or tab followed by newline - tab token is used for concatenated whitespace. */
-		if(!(psTokenEntry->psNext && (psTokenEntry->psNext->sToken.eTokenName == TOK_NEWLINE || 
-			(psTokenEntry->psNext->psNext && 
-			psTokenEntry->psNext->sToken.eTokenName == TOK_TAB && 
-			psTokenEntry->psNext->psNext->sToken.eTokenName == TOK_NEWLINE))))
+		if(!((uNameEntry + 1 < psTokens->uEnd) && (PP_TOKEN(psTokens, uNameEntry + 1)->eTokenName == TOK_NEWLINE ||
+			((uNameEntry + 2 < psTokens->uEnd) &&
+			PP_TOKEN(psTokens, uNameEntry + 1)->eTokenName == TOK_TAB &&
+			PP_TOKEN(psTokens, uNameEntry + 2)->eTokenName == TOK_NEWLINE))))
 		{
-			LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "Syntax error, #if[n]def expected newline after identifier\n");
+			LogProgramTokenError(psCPD->psErrorLog, psToken, "Syntax error, #if[n]def expected newline after identifier\n");
 			return IMG_FALSE;
 		}
 
 		/* Check it has been defined */
-		bIfResult = FindSymbol(psSymbolTable,
-							   psTokenEntry->sToken.pvData,
-							   IMG_NULL,
-							   IMG_TRUE);
+		psIdentifier = PPGetTokenIdentifier(psContext, &psTokens->psTokens[uNameEntry], IMG_FALSE);
+
+		bIfResult = (psIdentifier && psIdentifier->psDefineMacro) ? IMG_TRUE : IMG_FALSE;
 
 		if (bInvertResult)
 		{
@@ -2040,16 +2397,16 @@ static IMG_BOOL PPProcessIfdef(GLSLCompilerPrivateData *psCPD, TokenLL  *psToken
 				   0,
 				   "#if[n]def  %s (%d:%d:%d)\n",
 				   bIfResult ? "TRUE" : "FALSE",
-				   psTokenEntry->sToken.uStringNumber,
-				   psTokenEntry->sToken.uLineNumber,
-				   psTokenEntry->sToken.uCharNumber);
+				   psToken->uStringNumber,
+				   psToken->uLineNumber,
+				   psToken->uCharNumber);
 #endif
 
 
 		/* Check we haven't exceeded maximum nesting level */
 		if (psIfStatus->uNestedIfLevel >= MAX_NESTED_IF_LEVELS)
 		{
-			LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "Max number of nested #if's is 255\n");
+			LogProgramTokenError(psCPD->psErrorLog, psToken, "Max number of nested #if's is 255\n");
 			return IMG_FALSE;
 		}
 
@@ -2077,9 +2434,9 @@ static IMG_BOOL PPProcessIfdef(GLSLCompilerPrivateData *psCPD, TokenLL  *psToken
 	DumpLogMessage(LOGFILE_PREPROCESSOR,
 				   0,
 				   "#if[n]def  not processed (inside disabled block) (%d:%d:%d)\n",
-				   psTokenEntry->sToken.uStringNumber,
-				   psTokenEntry->sToken.uLineNumber,
-				   psTokenEntry->sToken.uCharNumber);
+				   PP_TOKEN(psTokens, uTokenEntry)->uStringNumber,
+				   PP_TOKEN(psTokens, uTokenEntry)->uLineNumber,
+				   PP_TOKEN(psTokens, uTokenEntry)->uCharNumber);
 #endif
 
 	}
@@ -2090,35 +2447,38 @@ static IMG_BOOL PPProcessIfdef(GLSLCompilerPrivateData *psCPD, TokenLL  *psToken
 /******************************************************************************
  * Function Name: PPProcessEndif
  *
- * Inputs       : psTokenEntry      - First token to process
- *                psLastTokenEntry  - Last token to process
+ * Inputs       : psTokens          - Tokens of the directive
+ *                uTokenEntry       - First token to process
+ *                uLastTokenEntry   - Last token to process
  *                psIfStatus        - NFI.
  *
  * Outputs      : NFI.
- * Returns      : 
+ * Returns      :
  * Globals Used : -
  *
  * Description  : NFI.
  *****************************************************************************/
-static IMG_BOOL PPProcessEndif(GLSLCompilerPrivateData *psCPD, TokenLL  *psTokenEntry,
-							TokenLL  *psLastTokenEntry,
-							IfStatus *psIfStatus)
+static IMG_BOOL PPProcessEndif(GLSLCompilerPrivateData *psCPD,
+							   PPTokenArray *psTokens,
+							   IMG_UINT32    uTokenEntry,
+							   IMG_UINT32    uLastTokenEntry,
+							   IfStatus     *psIfStatus)
 {
-	PVR_UNREFERENCED_PARAMETER(psLastTokenEntry);
+	PVR_UNREFERENCED_PARAMETER(uLastTokenEntry);
 
 #ifdef DUMP_LOGFILES
 	DumpLogMessage(LOGFILE_PREPROCESSOR,
 				   0,
 				   "#endif (%d:%d:%d)\n",
-				   psTokenEntry->sToken.uStringNumber,
-				   psTokenEntry->sToken.uLineNumber,
-				   psTokenEntry->sToken.uCharNumber);
+				   PP_TOKEN(psTokens, uTokenEntry)->uStringNumber,
+				   PP_TOKEN(psTokens, uTokenEntry)->uLineNumber,
+				   PP_TOKEN(psTokens, uTokenEntry)->uCharNumber);
 #endif
 
 
 	if (!psIfStatus->uNestedIfLevel)
 	{
-		LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "Syntax error, #endif mismatch\n");
+		LogProgramTokenError(psCPD->psErrorLog, PP_TOKEN(psTokens, uTokenEntry), "Syntax error, #endif mismatch\n");
 		return IMG_FALSE;
 	}
 
@@ -2137,26 +2497,29 @@ static IMG_BOOL PPProcessEndif(GLSLCompilerPrivateData *psCPD, TokenLL  *psToken
 /******************************************************************************
  * Function Name: PPProcessError
  *
- * Inputs       : psTokenEntry     - 
- *                psLastTokenEntry - 
+ * Inputs       : psTokens         - Tokens of the directive
+ *                uTokenEntry      -
+ *                uLastTokenEntry  -
  * Outputs      : -
- * Returns      : 
+ * Returns      :
  * Globals Used : -
  *
  * Description  : NFI.
  *****************************************************************************/
-static IMG_BOOL PPProcessError(GLSLCompilerPrivateData *psCPD, TokenLL *psTokenEntry,
-							TokenLL *psLastTokenEntry)
+static IMG_BOOL PPProcessError(GLSLCompilerPrivateData *psCPD,
+							   PPTokenArray *psTokens,
+							   IMG_UINT32    uTokenEntry,
+							   IMG_UINT32    uLastTokenEntry)
 {
 	IMG_CHAR *pszErrorMessage = IMG_NULL;
 
-	TokenLL *psCurrentEntry = PPGetNextDirectiveTokenEntry(psTokenEntry, psLastTokenEntry);
+	IMG_UINT32 uCurrentEntry = PPGetNextDirectiveToken(psTokens, uTokenEntry, uLastTokenEntry);
 
 	/* Get a pointer to the first char of the message */
-	if (psCurrentEntry)
+	if (uCurrentEntry != PP_NO_TOKEN)
 	{
-		Token *psFirstToken = &(psCurrentEntry->sToken);
-		Token *psLastToken  = &(psLastTokenEntry->sToken);
+		Token *psFirstToken = PP_TOKEN(psTokens, uCurrentEntry);
+		Token *psLastToken  = PP_TOKEN(psTokens, uLastTokenEntry);
 
 		IMG_CHAR *pszStartOfErrorMessage = &(psFirstToken->pszStartOfLine[psFirstToken->uCharNumber]);
 		IMG_CHAR *pszEndOfErrorMessage   = &(psLastToken->pszStartOfLine[psLastToken->uCharNumber]);
@@ -2176,25 +2539,26 @@ static IMG_BOOL PPProcessError(GLSLCompilerPrivateData *psCPD, TokenLL *psTokenE
 		memcpy(pszErrorMessage, pszStartOfErrorMessage, uErrorMessageSize);
 		pszErrorMessage[uErrorMessageSize] = '\0';
 
-		LogProgramTokenError(psCPD->psErrorLog, &(psCurrentEntry->sToken), "%s\n", pszErrorMessage);
+		LogProgramTokenError(psCPD->psErrorLog, psFirstToken, "%s\n", pszErrorMessage);
 
 		DebugMemFree(pszErrorMessage);
 	}
 	else
 	{
-		LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "\n");
+		LogProgramTokenError(psCPD->psErrorLog, PP_TOKEN(psTokens, uTokenEntry), "\n");
 	}
-	
+
 	return IMG_TRUE;
 }
 
 /******************************************************************************
  * Function Name: PPProcessLine
  *
- * Inputs       : psTokMemHeap              - Memory heap where any tokens will be allocated from.
- *                psTokenEntry              - First token in the line
- *                psLastTokenEntry          - Last token in the line
- *                psSymbolTable             - Symbol table of macros
+ * Inputs       : psContext                 - Preprocessor context
+ *                psTokens                  - Tokens of the directive
+ *                uTokenEntry               - First token in the line
+ *                uLastTokenEntry           - Last token in the line
+ *                psOut                     - Array that receives the tokens of the directive
  *                pnLineNumberAdjustment    - Offset to apply to the line number
  *                pnStringNumberAdjustment  - Offset to apply to the string number
  *
@@ -2204,51 +2568,65 @@ static IMG_BOOL PPProcessError(GLSLCompilerPrivateData *psCPD, TokenLL *psTokenE
  *
  * Description  : Processes a #line directive.
  *****************************************************************************/
-static IMG_BOOL PPProcessLine(GLSLCompilerPrivateData *psCPD, 
-							  MemHeap     *psTokMemHeap,
-							TokenLL     *psTokenEntry,
-							TokenLL     *psLastTokenEntry,
-							SymTable    *psSymbolTable,
-							IMG_INT32   *pnLineNumberAdjustment,
-							IMG_INT32   *pnStringNumberAdjustment)
+static IMG_BOOL PPProcessLine(GLSLCompilerPrivateData *psCPD,
+							  GLSLPreProcessorContext *psContext,
+							  PPTokenArray *psTokens,
+							  IMG_UINT32    uTokenEntry,
+							  IMG_UINT32    uLastTokenEntry,
+							  PPTokenArray *psOut,
+							  IMG_INT32    *pnLineNumberAdjustment,
+							  IMG_INT32    *pnStringNumberAdjustment)
 {
-	TokenLL  *psCurrentEntry = PPGetNextDirectiveTokenEntry(psTokenEntry, psLastTokenEntry);
+	IMG_UINT32 uCurrentEntry = PPGetNextDirectiveToken(psTokens, uTokenEntry, uLastTokenEntry);
+	Token     *psToken;
 
 	/* Check for enough tokens */
-	if (!psCurrentEntry)
+	if (uCurrentEntry == PP_NO_TOKEN)
+	{
+		LogProgramTokenError(psCPD->psErrorLog, PP_TOKEN(psTokens, uTokenEntry), "'' : syntax error (0) #line\n");
+		return IMG_FALSE;
+	}
+
+	/* The line number is read from the output, so move the tokens in front of it there first */
+	if (!PPFlushTokens(psTokens, uCurrentEntry, psOut))
 	{
-		LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "'' : syntax error (0) #line\n");
 		return IMG_FALSE;
 	}
 
 	/* Check for macro usage within */
-	if (!PPCheckForMacroReplacement(psCPD, psTokMemHeap, psCurrentEntry, psLastTokenEntry, psSymbolTable, &psCurrentEntry, IMG_NULL))
+	if (!PPCheckForMacroReplacement(psCPD, psContext, psTokens, uLastTokenEntry, psOut, &uCurrentEntry))
 	{
 		return IMG_FALSE;
 	}
 
-	if (psCurrentEntry->sToken.eTokenName != TOK_INTCONSTANT)
+	uLastTokenEntry = psOut->uEnd - 1;
+
+	psToken = PP_TOKEN(psOut, uCurrentEntry);
+
+	if (psToken->eTokenName != TOK_INTCONSTANT)
 	{
-		LogProgramTokenError(psCPD->psErrorLog, &(psCurrentEntry->sToken), "'' : syntax error (1) #line\n");
+		LogProgramTokenError(psCPD->psErrorLog, psToken, "'' : syntax error (1) #line\n");
 		return IMG_FALSE;
 	}
 	else
 	{
-		*pnLineNumberAdjustment = (strtol(psCurrentEntry->sToken.pvData,0,0) - (psCurrentEntry->sToken.uLineNumber - *pnLineNumberAdjustment)) - 1;
+		*pnLineNumberAdjustment = (strtol(psToken->pvData,0,0) - (psToken->uLineNumber - *pnLineNumberAdjustment)) - 1;
 	}
-	
-	psCurrentEntry = PPGetNextDirectiveTokenEntry(psCurrentEntry, psLastTokenEntry);
-	
-	if (psCurrentEntry)
+
+	uCurrentEntry = PPGetNextDirectiveToken(psOut, uCurrentEntry, uLastTokenEntry);
+
+	if (uCurrentEntry != PP_NO_TOKEN)
 	{
-		if (psCurrentEntry->sToken.eTokenName != TOK_INTCONSTANT)
+		psToken = PP_TOKEN(psOut, uCurrentEntry);
+
+		if (psToken->eTokenName != TOK_INTCONSTANT)
 		{
-			LogProgramTokenError(psCPD->psErrorLog, &(psCurrentEntry->sToken), "'' : syntax error (2) #line\n");
+			LogProgramTokenError(psCPD->psErrorLog, psToken, "'' : syntax error (2) #line\n");
 			return IMG_FALSE;
 		}
 		else
 		{
-			*pnStringNumberAdjustment = (strtol(psCurrentEntry->sToken.pvData,0,0) - (psCurrentEntry->sToken.uStringNumber - *pnStringNumberAdjustment));
+			*pnStringNumberAdjustment = (strtol(psToken->pvData,0,0) - (psToken->uStringNumber - *pnStringNumberAdjustment));
 		}
 	}
 
@@ -2260,58 +2638,62 @@ static IMG_BOOL PPProcessLine(GLSLCompilerPrivateData *psCPD,
  * Function Name: PPProcessPragma
  *
  * Inputs       : psContext
- *                psTokenEntry
- *                psLastTokenEntry
+ *                psTokens
+ *                uTokenEntry
+ *                uLastTokenEntry
  * Outputs      : -
  * Returns      : Success
  * Globals Used : -
  *
  * Description  : Processes a #pragma statement. NFI.
  *****************************************************************************/
-static IMG_BOOL PPProcessPragma(GLSLCompilerPrivateData *psCPD, 
+static IMG_BOOL PPProcessPragma(GLSLCompilerPrivateData *psCPD,
 								GLSLPreProcessorContext *psContext,
-								TokenLL *psTokenEntry,
-								TokenLL *psLastTokenEntry)
+								PPTokenArray *psTokens,
+								IMG_UINT32    uTokenEntry,
+								IMG_UINT32    uLastTokenEntry)
 {
 	IMG_CHAR *pszPragmaName;
 
-	TokenLL *psCurrentEntry = PPGetNextDirectiveTokenEntry(psTokenEntry, psLastTokenEntry);
+	Token *psDirectiveToken = PP_TOKEN(psTokens, uTokenEntry);
+
+	IMG_UINT32 uCurrentEntry = PPGetNextDirectiveToken(psTokens, uTokenEntry, uLastTokenEntry);
 
 	PVR_UNREFERENCED_PARAMETER(psContext);
 
 	/* Check for enough tokens */
-	if (!psCurrentEntry || !POSSIBLE_DEFINE_NAME(&psCurrentEntry->sToken))
+	if (uCurrentEntry == PP_NO_TOKEN || !POSSIBLE_DEFINE_NAME(PP_TOKEN(psTokens, uCurrentEntry)))
 	{
-		LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "'' : syntax error #pragma (1)\n");
+		LogProgramTokenError(psCPD->psErrorLog, psDirectiveToken, "'' : syntax error #pragma (1)\n");
 		return IMG_FALSE;
 	}
 
 	/* Store the name of the pragma */
-	pszPragmaName = psCurrentEntry->sToken.pvData;
+	pszPragmaName = PP_TOKEN(psTokens, uCurrentEntry)->pvData;
 
-	psCurrentEntry = PPGetNextDirectiveTokenEntry(psCurrentEntry, psLastTokenEntry);
+	uCurrentEntry = PPGetNextDirectiveToken(psTokens, uCurrentEntry, uLastTokenEntry);
 
 	if ((strcmp(pszPragmaName, "optimize") == 0) ||
 		(strcmp(pszPragmaName, "debug") == 0))
 	{
 		IMG_CHAR *pszOnOffStatus;
 
-		if (!psCurrentEntry || psCurrentEntry->sToken.eTokenName != TOK_LEFT_PAREN)
+		if (uCurrentEntry == PP_NO_TOKEN || PP_TOKEN(psTokens, uCurrentEntry)->eTokenName != TOK_LEFT_PAREN)
 		{
-			LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "'' : syntax error #pragma (2)\n");
+			LogProgramTokenError(psCPD->psErrorLog, psDirectiveToken, "'' : syntax error #pragma (2)\n");
 			return IMG_FALSE;
 		}
 
-		psCurrentEntry = PPGetNextDirectiveTokenEntry(psCurrentEntry, psLastTokenEntry);
+		uCurrentEntry = PPGetNextDirectiveToken(psTokens, uCurrentEntry, uLastTokenEntry);
 
-		if (!psCurrentEntry || !POSSIBLE_DEFINE_NAME(&psCurrentEntry->sToken))
+		if (uCurrentEntry == PP_NO_TOKEN || !POSSIBLE_DEFINE_NAME(PP_TOKEN(psTokens, uCurrentEntry)))
 		{
-			LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "'' : syntax error #pragma (3)\n");
+			LogProgramTokenError(psCPD->psErrorLog, psDirectiveToken, "'' : syntax error #pragma (3)\n");
 			return IMG_FALSE;
 		}
 
-		pszOnOffStatus = psCurrentEntry->sToken.pvData;
-		
+		pszOnOffStatus = PP_TOKEN(psTokens, uCurrentEntry)->pvData;
+
 		if (strcmp(pszOnOffStatus, "on") == 0)
 		{
 			/* XXX: do something */
@@ -2322,15 +2704,15 @@ static IMG_BOOL PPProcessPragma(GLSLCompilerPrivateData *psCPD,
 		}
 		else
 		{
-			LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "'' : syntax error #pragma (4)\n");
+			LogProgramTokenError(psCPD->psErrorLog, psDirectiveToken, "'' : syntax error #pragma (4)\n");
 			return IMG_FALSE;
 		}
 
-		psCurrentEntry = PPGetNextDirectiveTokenEntry(psCurrentEntry, psLastTokenEntry);
+		uCurrentEntry = PPGetNextDirectiveToken(psTokens, uCurrentEntry, uLastTokenEntry);
 
-		if (!psCurrentEntry || psCurrentEntry->sToken.eTokenName != TOK_RIGHT_PAREN)
+		if (uCurrentEntry == PP_NO_TOKEN || PP_TOKEN(psTokens, uCurrentEntry)->eTokenName != TOK_RIGHT_PAREN)
 		{
-			LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "'' : syntax error #pragma (5)\n");
+			LogProgramTokenError(psCPD->psErrorLog, psDirectiveToken, "'' : syntax error #pragma (5)\n");
 			return IMG_FALSE;
 		}
 	}
@@ -2339,30 +2721,30 @@ static IMG_BOOL PPProcessPragma(GLSLCompilerPrivateData *psCPD,
 	{
 		IMG_CHAR *pszInvariantStatus;
 
-		if (!psCurrentEntry || !psCurrentEntry->sToken.pvData ||
-		    strcmp((IMG_CHAR*)psCurrentEntry->sToken.pvData, "invariant"))
+		if (uCurrentEntry == PP_NO_TOKEN || !PP_TOKEN(psTokens, uCurrentEntry)->pvData ||
+		    strcmp((IMG_CHAR*)PP_TOKEN(psTokens, uCurrentEntry)->pvData, "invariant"))
 		{
-			LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "'' : syntax error #pragma (3)\n");
+			LogProgramTokenError(psCPD->psErrorLog, psDirectiveToken, "'' : syntax error #pragma (3)\n");
 			return IMG_FALSE;
 		}
 
-		psCurrentEntry = PPGetNextDirectiveTokenEntry(psCurrentEntry, psLastTokenEntry);
+		uCurrentEntry = PPGetNextDirectiveToken(psTokens, uCurrentEntry, uLastTokenEntry);
 
-		if (!psCurrentEntry || psCurrentEntry->sToken.eTokenName != TOK_LEFT_PAREN)
+		if (uCurrentEntry == PP_NO_TOKEN || PP_TOKEN(psTokens, uCurrentEntry)->eTokenName != TOK_LEFT_PAREN)
 		{
-			LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "'' : syntax error #pragma (2)\n");
+			LogProgramTokenError(psCPD->psErrorLog, psDirectiveToken, "'' : syntax error #pragma (2)\n");
 			return IMG_FALSE;
 		}
-	
-		psCurrentEntry = PPGetNextDirectiveTokenEntry(psCurrentEntry, psLastTokenEntry);
 
-		if (!psCurrentEntry || !POSSIBLE_DEFINE_NAME(&(psCurrentEntry->sToken)))
+		uCurrentEntry = PPGetNextDirectiveToken(psTokens, uCurrentEntry, uLastTokenEntry);
+
+		if (uCurrentEntry == PP_NO_TOKEN || !POSSIBLE_DEFINE_NAME(PP_TOKEN(psTokens, uCurrentEntry)))
 		{
-			LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "'' : syntax error #pragma (3)\n");
+			LogProgramTokenError(psCPD->psErrorLog, psDirectiveToken, "'' : syntax error #pragma (3)\n");
 			return IMG_FALSE;
 		}
-		
-		pszInvariantStatus = psCurrentEntry->sToken.pvData;
+
+		pszInvariantStatus = PP_TOKEN(psTokens, uCurrentEntry)->pvData;
 
 		if (strcmp(pszInvariantStatus, "all") == 0)
 		{
@@ -2370,7 +2752,7 @@ static IMG_BOOL PPProcessPragma(GLSLCompilerPrivateData *psCPD,
 		}
 		else
 		{
-			LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "'' : syntax error #pragma (4)\n");
+			LogProgramTokenError(psCPD->psErrorLog, psDirectiveToken, "'' : syntax error #pragma (4)\n");
 			return IMG_FALSE;
 		}
 	}
@@ -2383,28 +2765,30 @@ static IMG_BOOL PPProcessPragma(GLSLCompilerPrivateData *psCPD,
 /******************************************************************************
  * Function Name: CountTokens
  *
- * Inputs       : psFirstEntry     - First token in the list
- *                psLastTokenEntry - Last token in the list
+ * Inputs       : psTokens         - Token array
+ *                uFirstEntry      - First token in the list
+ *                uLastTokenEntry  - Last token in the list
  * Outputs      : -
- * Returns      : 
+ * Returns      :
  * Globals Used : -
  *
  * Description  : NFI.
  *****************************************************************************/
-static IMG_UINT32 CountTokens(TokenLL  *psFirstEntry,
-							TokenLL  *psLastTokenEntry)
+static IMG_UINT32 CountTokens(PPTokenArray *psTokens,
+							  IMG_UINT32    uFirstEntry,
+							  IMG_UINT32    uLastTokenEntry)
 {
 	IMG_UINT32 uNumTokens = 0;
 
 	/* Get first token of directive */
-	TokenLL *psTokenEntry = psFirstEntry;
+	IMG_UINT32 uTokenEntry = uFirstEntry;
 
 	/* Copy all tokens */
-	while (psTokenEntry)
+	while (uTokenEntry != PP_NO_TOKEN)
 	{
 		uNumTokens++;
 
-		psTokenEntry = PPGetNextDirectiveTokenEntry(psTokenEntry, psLastTokenEntry);
+		uTokenEntry = PPGetNextDirectiveToken(psTokens, uTokenEntry, uLastTokenEntry);
 	}
 
 	return uNumTokens;
@@ -2413,21 +2797,23 @@ static IMG_UINT32 CountTokens(TokenLL  *psFirstEntry,
 /******************************************************************************
  * Function Name: ProcessDefineMacro
  *
- * Inputs       : psTokenEntry     - First token in the list
- *                psLastTokenEntry - Last token in the list
- *                psSymbolTable    - Symbol table for macros.
+ * Inputs       : psContext        - Preprocessor context
+ *                psTokens         - Tokens of the directive
+ *                uTokenEntry      - First token in the list
+ *                uLastTokenEntry  - Last token in the list
  *                bIsPredefined    - NFI.
  * Outputs      : -
- * Returns      : 
+ * Returns      :
  * Globals Used : -
  *
  * Description  : Processes a #define statement. NFI.
  *****************************************************************************/
-static IMG_BOOL ProcessDefineMacro(GLSLCompilerPrivateData *psCPD, 
-								   TokenLL  *psTokenEntry,
-									TokenLL  *psLastTokenEntry,
-									SymTable *psSymbolTable,
-									IMG_BOOL bIsPredefined)
+static IMG_BOOL ProcessDefineMacro(GLSLCompilerPrivateData *psCPD,
+								   GLSLPreProcessorContext *psContext,
+								   PPTokenArray *psTokens,
+								   IMG_UINT32    uTokenEntry,
+								   IMG_UINT32    uLastTokenEntry,
+								   IMG_BOOL      bIsPredefined)
 {
 	IMG_UINT32    uNumArgs      = 0;
 	IMG_UINT32    uNumArgUsages = 0;
@@ -2435,85 +2821,87 @@ static IMG_BOOL ProcessDefineMacro(GLSLCompilerPrivateData *psCPD,
 	IMG_UINT32    uTokenNum     = 0;
 	IMG_UINT32    uNumTokens    = 0;
 	IMG_UINT32   *puArgumentsToUse, *puArgumentPositions;
-	TokenLL      *psCurrentEntry = psTokenEntry;
-	Token        *psToken = &(psCurrentEntry->sToken);
-	Token        *psTokenList;
+	IMG_UINT32    uCurrentEntry;
+	Token        *psToken = PP_TOKEN(psTokens, uTokenEntry);
+	PPToken      *psTokenList;
 	DefineMacro  *psDefineMacro;
-	IMG_CHAR    **ppszArgumentNames = IMG_NULL; 
+	PPIdentifier *psDefineIdentifier;
+	IMG_CHAR    **ppszArgumentNames = IMG_NULL;
 	IMG_CHAR     *pszDefineName;
 	IMG_BOOL      bTakesArgs = IMG_FALSE;
 
-	PVR_UNREFERENCED_PARAMETER(psSymbolTable);
-
 	/* Get first entry */
-	psCurrentEntry = PPGetNextDirectiveTokenEntry(psTokenEntry, psLastTokenEntry);
+	uCurrentEntry = PPGetNextDirectiveToken(psTokens, uTokenEntry, uLastTokenEntry);
 
 	/* Check for enough tokens */
-	if (!psCurrentEntry)
+	if (uCurrentEntry == PP_NO_TOKEN)
 	{
-		LogProgramTokenError(psCPD->psErrorLog, &(psCurrentEntry->sToken), "Syntax error, no parameter specified for #define\n");
+		LogProgramTokenError(psCPD->psErrorLog, IMG_NULL, "Syntax error, no parameter specified for #define\n");
 		return IMG_FALSE;
 	}
 
 	/* Check for valid token */
-	if (!POSSIBLE_DEFINE_NAME(&(psCurrentEntry->sToken)))
+	if (!POSSIBLE_DEFINE_NAME(PP_TOKEN(psTokens, uCurrentEntry)))
 	{
-		LogProgramTokenError(psCPD->psErrorLog, &(psCurrentEntry->sToken), "Syntax error, invalid name for #define\n");
+		LogProgramTokenError(psCPD->psErrorLog, PP_TOKEN(psTokens, uCurrentEntry), "Syntax error, invalid name for #define\n");
 		return IMG_FALSE;
 	}
 
 	/* Store name of define */
-	pszDefineName = (IMG_CHAR *)psCurrentEntry->sToken.pvData;
+	pszDefineName = PP_TOKEN(psTokens, uCurrentEntry)->pvData;
 
 	if(!bIsPredefined)
 	{
 		if(strncmp(pszDefineName, "GL_", 3) == 0)
 		{
-			LogProgramTokenError(psCPD->psErrorLog, &(psCurrentEntry->sToken), "Syntax error, cannot #define %s, as GL_ is reserved for predefined macros\n",pszDefineName);
+			LogProgramTokenError(psCPD->psErrorLog, PP_TOKEN(psTokens, uCurrentEntry), "Syntax error, cannot #define %s, as GL_ is reserved for predefined macros\n",pszDefineName);
 			return IMG_FALSE;
 		}
 		else if(strstr(pszDefineName, "__") != 0)
 		{
-			LogProgramTokenError(psCPD->psErrorLog, &(psCurrentEntry->sToken), "Syntax error, cannot #define %s, as __ is reserved for predefined macros\n",pszDefineName);
+			LogProgramTokenError(psCPD->psErrorLog, PP_TOKEN(psTokens, uCurrentEntry), "Syntax error, cannot #define %s, as __ is reserved for predefined macros\n",pszDefineName);
 			return IMG_FALSE;
 		}
 	}
 
+	psDefineIdentifier = PPGetTokenIdentifier(psContext, &psTokens->psTokens[uCurrentEntry], IMG_TRUE);
+
+	if (!psDefineIdentifier)
+	{
+		return IMG_FALSE;
+	}
 
 	/* Check it hasn't been defined already */
-	if (FindSymbol(psSymbolTable,
-				   pszDefineName,
-				   IMG_NULL,
-				   IMG_TRUE))
+	if (psDefineIdentifier->psDefineMacro)
 	{
-		LogProgramTokenError(psCPD->psErrorLog, &(psCurrentEntry->sToken), "Syntax error, '%s' macro redefinition\n", pszDefineName);
+		LogProgramTokenError(psCPD->psErrorLog, PP_TOKEN(psTokens, uCurrentEntry), "Syntax error, '%s' macro redefinition\n", pszDefineName);
 		return IMG_FALSE;
 	}
 
 	/* get first entry */
-	psCurrentEntry = PPGetNextDirectiveTokenEntry(psCurrentEntry, psLastTokenEntry);
+	uCurrentEntry = PPGetNextDirectiveToken(psTokens, uCurrentEntry, uLastTokenEntry);
 
 	/* Is is a macro with arguments? */
-	if (psCurrentEntry && (psCurrentEntry->sToken.eTokenName == TOK_LEFT_PAREN))
+	if ((uCurrentEntry != PP_NO_TOKEN) && (PP_TOKEN(psTokens, uCurrentEntry)->eTokenName == TOK_LEFT_PAREN))
 	{
-		/* 
+		/*
 		   This is a bit messy:
 		   If there is a space betwen the name of the define and the left parenthesis then this is a simple substitution
-		   (i.e. one that doesn't take arguments). 
-		   
-		   #define helloworld1(a) a  
+		   (i.e. one that doesn't take arguments).
+
+		   #define helloworld1(a) a
 		   #define helloworld2 (a) a
 
 		   helloworld1(1); // this would produce the code: "1;"
 		   helloworld2(1); // this is an error, macro does not take any arguments.
-		   helloworld2;    // this would produce the code: "(a) a;" 
+		   helloworld2;    // this would produce the code: "(a) a;"
 
 		   However, all spaces are lost at the token generation stage (they are ignored at every other stage) so the only
 		   way we can detect the space is by looking at the character positions of the tokens - like I said, a bit messy!
 		*/
 
 		/* Check for a gap between the left paren and identifier */
-		if (psCurrentEntry->sToken.uCharNumber - (psCurrentEntry->psPrev->sToken.uCharNumber + (psCurrentEntry->psPrev->sToken.uSizeOfDataInBytes - 1)) == 0)
+		if (PP_TOKEN(psTokens, uCurrentEntry)->uCharNumber - (PP_TOKEN(psTokens, uCurrentEntry - 1)->uCharNumber + (PP_TOKEN(psTokens, uCurrentEntry - 1)->uSizeOfDataInBytes - 1)) == 0)
 		{
 
 #ifdef DUMP_LOGFILES
@@ -2522,23 +2910,23 @@ static IMG_BOOL ProcessDefineMacro(GLSLCompilerPrivateData *psCPD,
 			bTakesArgs = IMG_TRUE;
 
 			/* Get next entry */
-			psCurrentEntry = PPGetNextDirectiveTokenEntry(psCurrentEntry, psLastTokenEntry);
+			uCurrentEntry = PPGetNextDirectiveToken(psTokens, uCurrentEntry, uLastTokenEntry);
 
 			/* Check for first argument */
-			if (!psCurrentEntry)
+			if (uCurrentEntry == PP_NO_TOKEN)
 			{
 				LogProgramTokenError(psCPD->psErrorLog, psToken, "'%s' : Expected macro argument\n", pszDefineName);
-				return IMG_FALSE;	
+				return IMG_FALSE;
 			}
 
 			/* If it's not an empty argument list then process the arguments */
-			if (psCurrentEntry->sToken.eTokenName != TOK_RIGHT_PAREN)
+			if (PP_TOKEN(psTokens, uCurrentEntry)->eTokenName != TOK_RIGHT_PAREN)
 			{
 				/* Do a rough calc to see how much space to allocate for the argument names */
-				uNumTokens = CountTokens(psCurrentEntry, psLastTokenEntry);
+				uNumTokens = CountTokens(psTokens, uCurrentEntry, uLastTokenEntry);
 
 				/* Allocate space for the arguments */
-				ppszArgumentNames = DebugMemAlloc(uNumTokens * sizeof (IMG_CHAR*)); 
+				ppszArgumentNames = DebugMemAlloc(uNumTokens * sizeof (IMG_CHAR*));
 
 				if(uNumTokens && !ppszArgumentNames)
 				{
@@ -2546,17 +2934,17 @@ static IMG_BOOL ProcessDefineMacro(GLSLCompilerPrivateData *psCPD,
 				}
 
 				/* Search through and extract all the arguments */
-				while (psCurrentEntry)
+				while (uCurrentEntry != PP_NO_TOKEN)
 				{
 					/* Check next token */
-					if (!POSSIBLE_DEFINE_NAME(&psCurrentEntry->sToken))
+					if (!POSSIBLE_DEFINE_NAME(PP_TOKEN(psTokens, uCurrentEntry)))
 					{
 						LogProgramTokenError(psCPD->psErrorLog, psToken, "'%s' : Expected macro argument\n", pszDefineName);
 						DebugMemFree(ppszArgumentNames);
 						return IMG_FALSE;
 					}
 
-					psToken = &psCurrentEntry->sToken;
+					psToken = PP_TOKEN(psTokens, uCurrentEntry);
 
 					/* Copy the argument name */
 					ppszArgumentNames[uNumArgs] = psToken->pvData;
@@ -2564,17 +2952,17 @@ static IMG_BOOL ProcessDefineMacro(GLSLCompilerPrivateData *psCPD,
 					uNumArgs++;
 
 					/* Get next entry */
-					psCurrentEntry = PPGetNextDirectiveTokenEntry(psCurrentEntry, psLastTokenEntry);
+					uCurrentEntry = PPGetNextDirectiveToken(psTokens, uCurrentEntry, uLastTokenEntry);
 
 					/* Check next token */
-					if (!psCurrentEntry)
+					if (uCurrentEntry == PP_NO_TOKEN)
 					{
 						LogProgramTokenError(psCPD->psErrorLog, psToken, "'%s' : Expected comma or bracket\n", pszDefineName);
 						DebugMemFree(ppszArgumentNames);
 						return IMG_FALSE;
 					}
 
-					psToken = &psCurrentEntry->sToken;
+					psToken = PP_TOKEN(psTokens, uCurrentEntry);
 
 					/* Check for comma or bracket */
 					if (psToken->eTokenName == TOK_RIGHT_PAREN)
@@ -2584,7 +2972,7 @@ static IMG_BOOL ProcessDefineMacro(GLSLCompilerPrivateData *psCPD,
 					else if (psToken->eTokenName == TOK_COMMA)
 					{
 						/* Get next entry */
-						psCurrentEntry = PPGetNextDirectiveTokenEntry(psCurrentEntry, psLastTokenEntry);
+						uCurrentEntry = PPGetNextDirectiveToken(psTokens, uCurrentEntry, uLastTokenEntry);
 					}
 					else
 					{
@@ -2605,14 +2993,14 @@ static IMG_BOOL ProcessDefineMacro(GLSLCompilerPrivateData *psCPD,
 			}
 
 			/* Get first token of the macro */
-			psCurrentEntry = PPGetNextDirectiveTokenEntry(psCurrentEntry, psLastTokenEntry);
+			uCurrentEntry = PPGetNextDirectiveToken(psTokens, uCurrentEntry, uLastTokenEntry);
 		}
 	}
 
 	/* Count the rest of the tokens left */
-	uNumTokens = CountTokens(psCurrentEntry, psLastTokenEntry);
+	uNumTokens = CountTokens(psTokens, uCurrentEntry, uLastTokenEntry);
 
-	/* Allocate memory for the aguments to use index (allocates max possible size - a little bit wasteful) */ 
+	/* Allocate memory for the aguments to use index (allocates max possible size - a little bit wasteful) */
 	puArgumentsToUse    = DebugMemAlloc(uNumTokens * sizeof(IMG_UINT32));
 
 	if(uNumTokens && !puArgumentsToUse)
@@ -2630,7 +3018,7 @@ static IMG_BOOL ProcessDefineMacro(GLSLCompilerPrivateData *psCPD,
 	}
 
 	/* Allocate memory for the tokens */
-	psTokenList         = DebugMemAlloc(uNumTokens * sizeof(Token));
+	psTokenList         = DebugMemAlloc(uNumTokens * sizeof(PPToken));
 
 	if(uNumTokens && !psTokenList)
 	{
@@ -2652,11 +3040,9 @@ static IMG_BOOL ProcessDefineMacro(GLSLCompilerPrivateData *psCPD,
 #endif
 
 	/* Scan the rest of the tokens looking for usages of these arguments */
-	while (psCurrentEntry)
+	while (uCurrentEntry != PP_NO_TOKEN)
 	{
-		Token *psNewToken = &psTokenList[uTokenNum];
-	
-		psToken = &psCurrentEntry->sToken;
+		psToken = PP_TOKEN(psTokens, uCurrentEntry);
 
 		/* Is this an identifier */
 		if (POSSIBLE_DEFINE_NAME(psToken))
@@ -2680,24 +3066,15 @@ static IMG_BOOL ProcessDefineMacro(GLSLCompilerPrivateData *psCPD,
 			}
 		}
 
-		/* Copy the token */
-		*psNewToken = *psToken;
-
-		/* Copy the data */
-		psNewToken->pvData = DebugMemAlloc(psToken->uSizeOfDataInBytes);
-
-		if(psToken->uSizeOfDataInBytes && !psNewToken->pvData)
-		{
-			return IMG_FALSE;
-		}
-		memcpy(psNewToken->pvData, psToken->pvData, psToken->uSizeOfDataInBytes);
+		/* Copy the token, its data stays valid until preprocessing has finished */
+		psTokenList[uTokenNum] = psTokens->psTokens[uCurrentEntry];
 
 #ifdef DUMP_LOGFILES
-		DumpLogMessage(LOGFILE_PREPROCESSOR, 5, "Storing %d - '%s'\n", uTokenNum, psNewToken->pvData);
+		DumpLogMessage(LOGFILE_PREPROCESSOR, 5, "Storing %d - '%s'\n", uTokenNum, psToken->pvData);
 #endif
 
 		/* Get the next token */
-		psCurrentEntry = PPGetNextDirectiveTokenEntry(psCurrentEntry, psLastTokenEntry);
+		uCurrentEntry = PPGetNextDirectiveToken(psTokens, uCurrentEntry, uLastTokenEntry);
 
 		uTokenNum++;
 	}
@@ -2723,7 +3100,6 @@ static IMG_BOOL ProcessDefineMacro(GLSLCompilerPrivateData *psCPD,
 		return IMG_FALSE;
 	}
 
-	psDefineMacro->ePPSymbolType       = PPST_DEFINEMACRO;
 	psDefineMacro->bTakesArgs          = bTakesArgs;
 	psDefineMacro->uNumArgs            = uNumArgs;
 	psDefineMacro->uNumArgUsages       = uNumArgUsages;
@@ -2734,95 +3110,89 @@ static IMG_BOOL ProcessDefineMacro(GLSLCompilerPrivateData *psCPD,
 
 
 	/* Free mem */
-	DebugMemFree(ppszArgumentNames);
-
-	/* Add this to the symbol table */
-	if (!AddSymbol(psSymbolTable,
-				   pszDefineName,
-				   psDefineMacro,
-				   sizeof(DefineMacro),
-				   IMG_FALSE,
-				   IMG_NULL,
-				   PPFreeDefineMacro))
+	if (ppszArgumentNames)
 	{
-		LOG_INTERNAL_TOKEN_ERROR((&(psCurrentEntry->sToken),"ProcessDefine: Failed to add '%s' to symbol table", pszDefineName));
-		return IMG_FALSE;
+		DebugMemFree(ppszArgumentNames);
 	}
 
+	/* Attach the definition to the name */
+	psDefineIdentifier->psDefineMacro = psDefineMacro;
+
 	return IMG_TRUE;
 }
 
 /******************************************************************************
  * Function Name: ProcessUndef
  *
- * Inputs       : psTokenEntry     - First token in the list
- *                psLastTokenEntry - Last token in the list.
- *                psSymbolTable    - Symbol table for macros
+ * Inputs       : psContext        - Preprocessor context
+ *                psTokens         - Tokens of the directive
+ *                uTokenEntry      - First token in the list
+ *                uLastTokenEntry  - Last token in the list.
  * Outputs      : -
- * Returns      : 
+ * Returns      :
  * Globals Used : -
  *
- * Description  : 
+ * Description  :
  *****************************************************************************/
-static IMG_BOOL ProcessUndef(GLSLCompilerPrivateData *psCPD, 
-							 TokenLL  *psTokenEntry,
-							TokenLL  *psLastTokenEntry,
-							SymTable *psSymbolTable)
+static IMG_BOOL ProcessUndef(GLSLCompilerPrivateData *psCPD,
+							 GLSLPreProcessorContext *psContext,
+							 PPTokenArray *psTokens,
+							 IMG_UINT32    uTokenEntry,
+							 IMG_UINT32    uLastTokenEntry)
 {
-	IMG_UINT32 uSymbolID;
-	IMG_CHAR *pszDefineName;
-
-	psTokenEntry = PPGetNextDirectiveTokenEntry(psTokenEntry, psLastTokenEntry);
+	PPIdentifier *psIdentifier;
+	IMG_CHAR     *pszDefineName;
+	Token        *psToken;
+	IMG_UINT32    uNameEntry = PPGetNextDirectiveToken(psTokens, uTokenEntry, uLastTokenEntry);
 
 	/* Check for enough tokens */
-	if (!psTokenEntry)
+	if (uNameEntry == PP_NO_TOKEN)
 	{
-		LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "Syntax error, no parameter specified for #undef\n");
+		LogProgramTokenError(psCPD->psErrorLog, IMG_NULL, "Syntax error, no parameter specified for #undef\n");
 		return IMG_FALSE;
 	}
 
-	if (!POSSIBLE_DEFINE_NAME(&psTokenEntry->sToken))
+	psToken = PP_TOKEN(psTokens, uNameEntry);
+
+	if (!POSSIBLE_DEFINE_NAME(psToken))
 	{
-		LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "Syntax error, invalid name for #undef\n");
+		LogProgramTokenError(psCPD->psErrorLog, psToken, "Syntax error, invalid name for #undef\n");
 		return IMG_FALSE;
 	}
 
 	/* Store name of define */
-	pszDefineName = (IMG_CHAR *)psTokenEntry->sToken.pvData;
+	pszDefineName = psToken->pvData;
 
 	if(strncmp(pszDefineName, "GL_", 3) == 0)
 	{
-		LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "Syntax error, cannot #undef %s, as GL_ is reserved for predefined macros\n",pszDefineName);
+		LogProgramTokenError(psCPD->psErrorLog, psToken, "Syntax error, cannot #undef %s, as GL_ is reserved for predefined macros\n",pszDefineName);
 		return IMG_FALSE;
 	}
 	else if(strstr(pszDefineName, "__") != 0)
 	{
-		LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "Syntax error, cannot #undef %s, as __ is reserved for predefined macros\n",pszDefineName);
+		LogProgramTokenError(psCPD->psErrorLog, psToken, "Syntax error, cannot #undef %s, as __ is reserved for predefined macros\n",pszDefineName);
 		return IMG_FALSE;
 	}
 
 
 	/* Check it has been defined already */
-	if (!FindSymbol(psSymbolTable,
-					psTokenEntry->sToken.pvData,
-					&uSymbolID,
-					IMG_TRUE))
+	psIdentifier = PPGetTokenIdentifier(psContext, &psTokens->psTokens[uNameEntry], IMG_FALSE);
+
+	if (!psIdentifier || !psIdentifier->psDefineMacro)
 	{
-		/* GLSL allows a shader to #undef an undefined identifier, but in this 
-		   case there is nothing to remove from the symbol table */
+		/* GLSL allows a shader to #undef an undefined identifier, but in this
+		   case there is nothing to remove */
 		return IMG_TRUE;
 	}
 
 #ifdef DUMP_LOGFILES
-	DumpLogMessage(LOGFILE_PREPROCESSOR, 0, "Removing #define of '%s'\n", psTokenEntry->sToken.pvData);
+	DumpLogMessage(LOGFILE_PREPROCESSOR, 0, "Removing #define of '%s'\n", pszDefineName);
 #endif
 
-	/* Remove the symbol */
-	if (!RemoveSymbol(psSymbolTable, uSymbolID))
-	{
-		LOG_INTERNAL_TOKEN_ERROR((&psTokenEntry->sToken,"ProcessUndef: Failed to removed symbol '%s'\n", psTokenEntry->sToken.pvData));
-		return IMG_FALSE;
-	}
+	/* Remove the definition */
+	PPFreeDefineMacro(psIdentifier->psDefineMacro);
+
+	psIdentifier->psDefineMacro = IMG_NULL;
 
 	return IMG_TRUE;
 }
@@ -2832,65 +3202,76 @@ static IMG_BOOL ProcessUndef(GLSLCompilerPrivateData *psCPD,
  * Function Name: PPProcessVersion
  *
  * Inputs       : psContext
- *                psTokMemHeap
- *                psTokenEntry
- *                psLastTokenEntry
+ *                psTokens
+ *                uTokenEntry
+ *                uLastTokenEntry
+ *                psOut
  * Outputs      : -
  * Returns      : Success.
  * Globals Used : -
  *
  * Description  : Change the language version of the source code.
  *****************************************************************************/
-static IMG_BOOL PPProcessVersion(GLSLCompilerPrivateData *psCPD, 
+static IMG_BOOL PPProcessVersion(GLSLCompilerPrivateData *psCPD,
 								 GLSLPreProcessorContext *psContext,
-								MemHeap                 *psTokMemHeap,
-								TokenLL                 *psTokenEntry,
-								TokenLL                 *psLastTokenEntry)
+								 PPTokenArray            *psTokens,
+								 IMG_UINT32               uTokenEntry,
+								 IMG_UINT32               uLastTokenEntry,
+								 PPTokenArray            *psOut)
 {
 	IMG_UINT32 uVersion, i;
 	IMG_BOOL   bMatchedVersion = IMG_FALSE;
 
-	/* Back track beyond '#version' */
-	TokenLL *psFirstEntry   = psTokenEntry;
+	Token     *psVersionToken = PP_TOKEN(psTokens, uTokenEntry);
 
-	TokenLL *psCurrentEntry = psTokenEntry->psPrev->psPrev;
+	IMG_UINT32 uCurrentEntry;
 
-	/* Check this is the first thing to appear */
-	while (psCurrentEntry)
+	/* Check this is the first thing to appear, back tracking beyond '#version' - through this line then the output */
+	for (i = uTokenEntry - psTokens->uStart + psOut->uEnd - psOut->uStart; i >= 2; i--)
 	{
-		if ((psCurrentEntry->sToken.eTokenName != TOK_NEWLINE) &&
-			(psCurrentEntry->sToken.eTokenName != TOK_CARRIGE_RETURN) &&
-			(psCurrentEntry->sToken.eTokenName != TOK_COMMENT) &&
-			(psCurrentEntry->sToken.eTokenName != TOK_TAB) &&
-			(psCurrentEntry->sToken.eTokenName != TOK_VTAB) &&
-			(psCurrentEntry->sToken.eTokenName != TOK_INCOMMENT) &&
-			(psCurrentEntry->sToken.eTokenName != TOK_OUTCOMMENT) &&
-			(psCurrentEntry->sToken.eTokenName != TOK_ENDOFSTRING) &&
-			(psCurrentEntry->sToken.eTokenName != TOK_TERMINATEPARSING))
+		IMG_UINT32 uPrevEntry = i - 2;
+		Token     *psToken;
+
+		if (uPrevEntry < psOut->uEnd - psOut->uStart)
 		{
-			LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "#version must occur before any other statement in the program\n");
-			return IMG_FALSE;
+			psToken = PP_TOKEN(psOut, psOut->uStart + uPrevEntry);
+		}
+		else
+		{
+			psToken = PP_TOKEN(psTokens, psTokens->uStart + (uPrevEntry - (psOut->uEnd - psOut->uStart)));
 		}
 
-		psCurrentEntry = psCurrentEntry->psPrev;
+		if ((psToken->eTokenName != TOK_NEWLINE) &&
+			(psToken->eTokenName != TOK_CARRIGE_RETURN) &&
+			(psToken->eTokenName != TOK_COMMENT) &&
+			(psToken->eTokenName != TOK_TAB) &&
+			(psToken->eTokenName != TOK_VTAB) &&
+			(psToken->eTokenName != TOK_INCOMMENT) &&
+			(psToken->eTokenName != TOK_OUTCOMMENT) &&
+			(psToken->eTokenName != TOK_ENDOFSTRING) &&
+			(psToken->eTokenName != TOK_TERMINATEPARSING))
+		{
+			LogProgramTokenError(psCPD->psErrorLog, psVersionToken, "#version must occur before any other statement in the program\n");
+			return IMG_FALSE;
+		}
 	}
 
-	psTokenEntry = PPGetNextDirectiveTokenEntry(psTokenEntry, psLastTokenEntry);
+	uCurrentEntry = PPGetNextDirectiveToken(psTokens, uTokenEntry, uLastTokenEntry);
 
 	/* Check for enough tokens */
-	if (!psTokenEntry)
+	if (uCurrentEntry == PP_NO_TOKEN)
 	{
-		LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "Syntax error, no parameter specified for #version\n");
+		LogProgramTokenError(psCPD->psErrorLog, IMG_NULL, "Syntax error, no parameter specified for #version\n");
 		return IMG_FALSE;
 	}
 
-	if (psTokenEntry->sToken.eTokenName != TOK_INTCONSTANT)
+	if (PP_TOKEN(psTokens, uCurrentEntry)->eTokenName != TOK_INTCONSTANT)
 	{
-		LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "Syntax error, invalid parameter supplied for #version\n");
+		LogProgramTokenError(psCPD->psErrorLog, PP_TOKEN(psTokens, uCurrentEntry), "Syntax error, invalid parameter supplied for #version\n");
 		return IMG_FALSE;
 	}
 
-	uVersion = strtol(psTokenEntry->sToken.pvData,0,0);
+	uVersion = strtol(PP_TOKEN(psTokens, uCurrentEntry)->pvData,0,0);
 
 	for (i = 0; i < GLSL_NUM_VERSIONS_SUPPORTED; i++)
 	{
@@ -2905,23 +3286,29 @@ static IMG_BOOL PPProcessVersion(GLSLCompilerPrivateData *psCPD,
 	/* Insert tokens to indicate a language version change has taken place */
 	if (bMatchedVersion)
 	{
-		Token     asToken;
+		PPToken    asToken;
+		IMG_UINT32 uShift;
 
 		/* Inherit most of the info */
-		asToken = psFirstEntry->sToken;
-		asToken.eTokenName         = TOK_LANGUAGE_VERSION;
-		asToken.pvData             = IMG_NULL;
-		asToken.uSizeOfDataInBytes = 0;
+		asToken.sToken                    = *psVersionToken;
+		asToken.sToken.eTokenName         = TOK_LANGUAGE_VERSION;
+		asToken.sToken.pvData             = IMG_NULL;
+		asToken.sToken.uSizeOfDataInBytes = 0;
+		asToken.psIdentifier              = IMG_NULL;
+		asToken.bRemove                   = IMG_FALSE;
 
 		/* Hack: piggyback on pszStartOfLine to store the language version */
 		/**
 		 * OGL64 Review.
 		 * ...?
 		 */
-		asToken.pszStartOfLine = (IMG_CHAR*)(IMG_SIZE_T)(uVersion);
+		asToken.sToken.pszStartOfLine = (IMG_CHAR*)(IMG_SIZE_T)(uVersion);
 
 		/* Insert a version change token into the list */
-		PPInsertTokensIntoLinkedList(psTokMemHeap, psTokenEntry, &asToken, 1, IMG_NULL);
+		if (!PPInsertTokens(psTokens, uCurrentEntry + 1, &asToken, 1, &uShift))
+		{
+			return IMG_FALSE;
+		}
 
 #ifdef DUMP_LOGFILES
 		DumpLogMessage(LOGFILE_PREPROCESSOR, 0, "Inserting language version change tokens (new version = %d)\n", uVersion);
@@ -2930,12 +3317,13 @@ static IMG_BOOL PPProcessVersion(GLSLCompilerPrivateData *psCPD,
 	}
 	else
 	{
-		LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "Syntax error, GLSL Version %u not supported\n", uVersion);
+		LogProgramTokenError(psCPD->psErrorLog, PP_TOKEN(psTokens, uCurrentEntry), "Syntax error, GLSL Version %u not supported\n", uVersion);
 	}
 
 	return bMatchedVersion;
 }
 
+
 /******************************************************************************
  * Function Name: 
  *
@@ -3032,53 +3420,61 @@ static IMG_BOOL PPIsExtensionCombinationSupported(GLSLExtension eCurrentEnables,
  * Function Name: PPProcessExtension
  *
  * Inputs       : psContext
- *                psTokMemHeap
- *                psTokenEntry
- *                psLastTokenEntry
+ *                psTokens
+ *                uTokenEntry
+ *                uLastTokenEntry
  * Outputs      : -
  * Returns      : Success
  * Globals Used : -
  *
- * Description  : 
+ * Description  :
  *****************************************************************************/
-static IMG_BOOL PPProcessExtension(GLSLCompilerPrivateData *psCPD, 
+static IMG_BOOL PPProcessExtension(GLSLCompilerPrivateData *psCPD,
 								   GLSLPreProcessorContext *psContext,
-								MemHeap                 *psTokMemHeap,
-								TokenLL *psTokenEntry,
-								TokenLL *psLastTokenEntry)
+								   PPTokenArray            *psTokens,
+								   IMG_UINT32               uTokenEntry,
+								   IMG_UINT32               uLastTokenEntry)
 {
-	Token     acTokens[2];
-	IMG_CHAR *pszExtensionName, *pszBehaviourName;
+	PPToken    asTokens[2];
+	IMG_CHAR  *pszExtensionName, *pszBehaviourName;
+	Token     *psToken;
+	IMG_UINT32 uShift;
 
-	psTokenEntry = PPGetNextDirectiveTokenEntry(psTokenEntry, psLastTokenEntry);
+	uTokenEntry = PPGetNextDirectiveToken(psTokens, uTokenEntry, uLastTokenEntry);
 
 	/* Check for enough tokens */
-	if (!psTokenEntry || !psTokenEntry->sToken.pvData)
+	if (uTokenEntry == PP_NO_TOKEN || !PP_TOKEN(psTokens, uTokenEntry)->pvData)
 	{
-		LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "'' :  extension name not specified\n");
+		LogProgramTokenError(psCPD->psErrorLog, (uTokenEntry == PP_NO_TOKEN) ? IMG_NULL : PP_TOKEN(psTokens, uTokenEntry), "'' :  extension name not specified\n");
 		return IMG_FALSE;
 	}
 
-	pszExtensionName = psTokenEntry->sToken.pvData;
+	psToken = PP_TOKEN(psTokens, uTokenEntry);
+
+	pszExtensionName = psToken->pvData;
 
-	psTokenEntry = PPGetNextDirectiveTokenEntry(psTokenEntry, psLastTokenEntry);
+	uTokenEntry = PPGetNextDirectiveToken(psTokens, uTokenEntry, uLastTokenEntry);
 
 	/* Check for enough tokens */
-	if (!psTokenEntry || psTokenEntry->sToken.eTokenName != TOK_COLON)
+	if (uTokenEntry == PP_NO_TOKEN || PP_TOKEN(psTokens, uTokenEntry)->eTokenName != TOK_COLON)
 	{
-		LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "'' :  ':' missing after extension name\n");
+		LogProgramTokenError(psCPD->psErrorLog, (uTokenEntry == PP_NO_TOKEN) ? IMG_NULL : PP_TOKEN(psTokens, uTokenEntry), "'' :  ':' missing after extension name\n");
 		return IMG_FALSE;
 	}
 
-	psTokenEntry = PPGetNextDirectiveTokenEntry(psTokenEntry, psLastTokenEntry);
+	psToken = PP_TOKEN(psTokens, uTokenEntry);
 
-	if (!psTokenEntry || !psTokenEntry->sToken.pvData)
+	uTokenEntry = PPGetNextDirectiveToken(psTokens, uTokenEntry, uLastTokenEntry);
+
+	if (uTokenEntry == PP_NO_TOKEN || !PP_TOKEN(psTokens, uTokenEntry)->pvData)
 	{
-		LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "'' :  behaviour for extension not specified\n");
+		LogProgramTokenError(psCPD->psErrorLog, (uTokenEntry == PP_NO_TOKEN) ? IMG_NULL : PP_TOKEN(psTokens, uTokenEntry), "'' :  behaviour for extension not specified\n");
 		return IMG_FALSE;
 	}
 
-	pszBehaviourName = psTokenEntry->sToken.pvData;
+	psToken = PP_TOKEN(psTokens, uTokenEntry);
+
+	pszBehaviourName = psToken->pvData;
 
 	if (strcmp(pszBehaviourName, "require") == 0)
 	{
@@ -3087,7 +3483,7 @@ static IMG_BOOL PPProcessExtension(GLSLCompilerPrivateData *psCPD,
 		if (strcmp(pszExtensionName, "all") == 0)
 		{
 ExtensionAllError:
-			LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "'' : extension 'all' cannot have 'require' or 'enable' behaviour\n");
+			LogProgramTokenError(psCPD->psErrorLog, psToken, "'' : extension 'all' cannot have 'require' or 'enable' behaviour\n");
 			return IMG_FALSE;
 		}
 
@@ -3095,7 +3491,7 @@ ExtensionAllError:
 
 		if (eExtensionEnable == GLSLEXT_NONE)
 		{
-			LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "Extension %s not supported\n", pszExtensionName);
+			LogProgramTokenError(psCPD->psErrorLog, psToken, "Extension %s not supported\n", pszExtensionName);
 			return IMG_FALSE;
 		}
 		else
@@ -3108,7 +3504,7 @@ ExtensionAllError:
 			}
 			else
 			{
-				LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "Extension %s not supported in combination with %s\n", 
+				LogProgramTokenError(psCPD->psErrorLog, psToken, "Extension %s not supported in combination with %s\n",
 					pszExtensionName, pszBadCombo);
 			}
 		}
@@ -3127,7 +3523,7 @@ ExtensionAllError:
 		if(eExtensionEnable == GLSLEXT_NONE)
 		{
 ExtensionNotSupportedWarning:
-			LogProgramTokenWarning(psCPD->psErrorLog, &psTokenEntry->sToken, "Extension %s not supported\n", pszExtensionName);
+			LogProgramTokenWarning(psCPD->psErrorLog, psToken, "Extension %s not supported\n", pszExtensionName);
 			return IMG_TRUE;
 		}
 		else
@@ -3140,7 +3536,7 @@ ExtensionNotSupportedWarning:
 			}
 			else
 			{
-				LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "Extension %s not supported in combination with %s\n", 
+				LogProgramTokenError(psCPD->psErrorLog, psToken, "Extension %s not supported in combination with %s\n",
 					pszExtensionName, pszBadCombo);
 			}
 		}
@@ -3178,15 +3574,15 @@ ExtensionNotSupportedWarning:
 	}
 	else
 	{
-		LogProgramTokenError(psCPD->psErrorLog, &psTokenEntry->sToken, "'' :  behaviour '%s' is not supported\n", pszBehaviourName);
+		LogProgramTokenError(psCPD->psErrorLog, psToken, "'' :  behaviour '%s' is not supported\n", pszBehaviourName);
 		return IMG_FALSE;
 	}
 
 	/* !!! Inserting tokens? Questionable design decision */
 	/* Insert tokens to indicate that an extension change has taken place */
-	memset(acTokens, 0, 2*sizeof(Token));
-	acTokens[0].eTokenName = TOK_EXTENSION_CHANGE;
-	acTokens[1].eTokenName = TOK_INTCONSTANT;
+	memset(asTokens, 0, 2*sizeof(PPToken));
+	asTokens[0].sToken.eTokenName = TOK_EXTENSION_CHANGE;
+	asTokens[1].sToken.eTokenName = TOK_INTCONSTANT;
 	/*
 	   Hack: piggyback on pszStartOfLine to store a bitmask.
 	*/
@@ -3194,10 +3590,13 @@ ExtensionNotSupportedWarning:
 	 * OGL64 Review.
 	 * ...what is going on here?
 	 */
-	acTokens[1].pszStartOfLine = (IMG_CHAR*)(IMG_SIZE_T)psContext->eEnabledExtensions;
+	asTokens[1].sToken.pszStartOfLine = (IMG_CHAR*)(IMG_SIZE_T)psContext->eEnabledExtensions;
 
 	/* Insert some version change tokens into the list */
-	PPInsertTokensIntoLinkedList(psTokMemHeap, psTokenEntry, acTokens, 2, IMG_NULL);
+	if (!PPInsertTokens(psTokens, uTokenEntry + 1, asTokens, 2, &uShift))
+	{
+		return IMG_FALSE;
+	}
 
 #ifdef DUMP_LOGFILES
 	DumpLogMessage(LOGFILE_PREPROCESSOR, 0, "Inserting extension change tokens (new extensions = 0x%X)\n", psContext->eEnabledExtensions);
@@ -3210,10 +3609,10 @@ ExtensionNotSupportedWarning:
  * Function Name: PPProcessDirective
  *
  * Inputs       : psContext
- *                psTokMemHeap
- *                psFirstTokenEntry
- *                psLastTokenEntry
- *                psSymbolTable
+ *                psTokens
+ *                uFirstTokenEntry
+ *                uLastTokenEntry
+ *                psOut
  *                psIfStatus
  *                pnLineNumberAdjustment
  *                pnStringNumberAdjustment
@@ -3221,115 +3620,130 @@ ExtensionNotSupportedWarning:
  * Returns      : Success
  * Globals Used : -
  *
- * Description  : ???
+ * Description  : Processes the directive from the '#' at uFirstTokenEntry up to
+ *                uLastTokenEntry, the last token in psTokens. All of psTokens
+ *                is moved to psOut.
  *****************************************************************************/
-static IMG_BOOL PPProcessDirective(GLSLCompilerPrivateData *psCPD, 
+static IMG_BOOL PPProcessDirective(GLSLCompilerPrivateData *psCPD,
 								   GLSLPreProcessorContext *psContext,
-								MemHeap     *psTokMemHeap,
-								TokenLL     *psFirstTokenEntry,
-								TokenLL     *psLastTokenEntry,
-								SymTable    *psSymbolTable,
-								IfStatus    *psIfStatus,
-								IMG_INT32   *pnLineNumberAdjustment,
-								IMG_INT32   *pnStringNumberAdjustment)
+								   PPTokenArray *psTokens,
+								   IMG_UINT32    uFirstTokenEntry,
+								   IMG_UINT32    uLastTokenEntry,
+								   PPTokenArray *psOut,
+								   IfStatus     *psIfStatus,
+								   IMG_INT32    *pnLineNumberAdjustment,
+								   IMG_INT32    *pnStringNumberAdjustment)
 {
-	IMG_BOOL bSuccess = IMG_TRUE;
+	IMG_BOOL   bSuccess = IMG_TRUE;
 
-	Token   *psToken;
+	Token     *psToken;
 
-	/* Get the next token from the directive */
-	TokenLL *psTokenEntry = PPGetNextDirectiveTokenEntry(psFirstTokenEntry, psLastTokenEntry);
+	IMG_UINT32 uTokenEntry;
 
-	/* Check for no preprocessor commands */
-	if (!psTokenEntry)
+	/* Anything in front of the '#' is not part of the directive */
+	if (!PPFlushTokens(psTokens, uFirstTokenEntry, psOut))
 	{
-		return IMG_TRUE;
+		return IMG_FALSE;
 	}
 
-	/* Get the token */
-	psToken = &psTokenEntry->sToken;
+	/* Get the next token from the directive */
+	uTokenEntry = PPGetNextDirectiveToken(psTokens, uFirstTokenEntry, uLastTokenEntry);
 
-	switch (psToken->eTokenName)
+	/* Check for no preprocessor commands */
+	if (uTokenEntry != PP_NO_TOKEN)
 	{
-		case TOK_IDENTIFIER:
+		/* Get the token */
+		psToken = PP_TOKEN(psTokens, uTokenEntry);
+
+		switch (psToken->eTokenName)
 		{
-			if(!strcmp(psToken->pvData, "if"))
-			{
-				bSuccess = PPProcessIf(psCPD, psTokMemHeap, psTokenEntry, psLastTokenEntry, psSymbolTable, psIfStatus);
-			}
-			else if(!strcmp(psToken->pvData, "else"))
-			{
-				bSuccess = PPProcessElse(psCPD, psTokenEntry, psLastTokenEntry, psIfStatus);
-			}
-			else if (strcmp(psToken->pvData, "ifdef") == 0)
-			{
-				bSuccess = PPProcessIfdef(psCPD, psTokenEntry, psLastTokenEntry, psSymbolTable, psIfStatus, IMG_FALSE);
-			}
-			else if (strcmp(psToken->pvData, "ifndef") == 0)
-			{
-				bSuccess = PPProcessIfdef(psCPD, psTokenEntry, psLastTokenEntry, psSymbolTable, psIfStatus, IMG_TRUE);
-			}
-			else if (strcmp(psToken->pvData, "elif") == 0)
-			{
-				bSuccess = PPProcessElif(psCPD, psTokMemHeap, psTokenEntry, psLastTokenEntry, psSymbolTable, psIfStatus);
-			}
-			else if (strcmp(psToken->pvData, "endif") == 0)
-			{
-				bSuccess = PPProcessEndif(psCPD, psTokenEntry, psLastTokenEntry, psIfStatus);
-			}
-			else if (BLOCK_ENABLED(psIfStatus->aeIfBlockStates[psIfStatus->uCurrentActiveLevel]))
+			case TOK_IDENTIFIER:
 			{
-				if (strcmp(psToken->pvData, "define") == 0)
-				{
-					bSuccess = ProcessDefineMacro(psCPD, psTokenEntry, psLastTokenEntry, psSymbolTable, IMG_FALSE);
-				}
-				else if (strcmp(psToken->pvData, "undef") == 0)
+				if(!strcmp(psToken->pvData, "if"))
 				{
-					bSuccess = ProcessUndef(psCPD, psTokenEntry, psLastTokenEntry, psSymbolTable);
+					bSuccess = PPProcessIf(psCPD, psContext, psTokens, uTokenEntry, uLastTokenEntry, psOut, psIfStatus);
 				}
-				else if (strcmp(psToken->pvData, "error") == 0)
+				else if(!strcmp(psToken->pvData, "else"))
 				{
-					bSuccess = PPProcessError(psCPD, psTokenEntry, psLastTokenEntry);
+					bSuccess = PPProcessElse(psCPD, psTokens, uTokenEntry, uLastTokenEntry, psIfStatus);
 				}
-				else if (strcmp(psToken->pvData, "line") == 0)
+				else if (strcmp(psToken->pvData, "ifdef") == 0)
 				{
-					bSuccess = PPProcessLine(psCPD, psTokMemHeap, psTokenEntry, psLastTokenEntry, psSymbolTable, pnLineNumberAdjustment, pnStringNumberAdjustment);
+					bSuccess = PPProcessIfdef(psCPD, psContext, psTokens, uTokenEntry, uLastTokenEntry, psIfStatus, IMG_FALSE);
 				}
-				else if (strcmp(psToken->pvData, "pragma") == 0)
+				else if (strcmp(psToken->pvData, "ifndef") == 0)
 				{
-					bSuccess = PPProcessPragma(psCPD, psContext, psTokenEntry, psLastTokenEntry);
+					bSuccess = PPProcessIfdef(psCPD, psContext, psTokens, uTokenEntry, uLastTokenEntry, psIfStatus, IMG_TRUE);
 				}
-				else if (strcmp(psToken->pvData, "extension") == 0)
+				else if (strcmp(psToken->pvData, "elif") == 0)
 				{
-					bSuccess = PPProcessExtension(psCPD, psContext, psTokMemHeap, psTokenEntry, psLastTokenEntry);
+					bSuccess = PPProcessElif(psCPD, psContext, psTokens, uTokenEntry, uLastTokenEntry, psOut, psIfStatus);
 				}
-				else if (strcmp(psToken->pvData, "version") == 0)
+				else if (strcmp(psToken->pvData, "endif") == 0)
 				{
-					bSuccess = PPProcessVersion(psCPD, psContext, psTokMemHeap, psTokenEntry, psLastTokenEntry);
+					bSuccess = PPProcessEndif(psCPD, psTokens, uTokenEntry, uLastTokenEntry, psIfStatus);
 				}
-				else
+				else if (BLOCK_ENABLED(psIfStatus->aeIfBlockStates[psIfStatus->uCurrentActiveLevel]))
 				{
-					LogProgramTokenError(psCPD->psErrorLog, psToken, "'' :   Invalid directive %s\n", psToken->pvData);
-					return IMG_FALSE;
+					if (strcmp(psToken->pvData, "define") == 0)
+					{
+						bSuccess = ProcessDefineMacro(psCPD, psContext, psTokens, uTokenEntry, uLastTokenEntry, IMG_FALSE);
+					}
+					else if (strcmp(psToken->pvData, "undef") == 0)
+					{
+						bSuccess = ProcessUndef(psCPD, psContext, psTokens, uTokenEntry, uLastTokenEntry);
+					}
+					else if (strcmp(psToken->pvData, "error") == 0)
+					{
+						bSuccess = PPProcessError(psCPD, psTokens, uTokenEntry, uLastTokenEntry);
+					}
+					else if (strcmp(psToken->pvData, "line") == 0)
+					{
+						bSuccess = PPProcessLine(psCPD, psContext, psTokens, uTokenEntry, uLastTokenEntry, psOut, pnLineNumberAdjustment, pnStringNumberAdjustment);
+					}
+					else if (strcmp(psToken->pvData, "pragma") == 0)
+					{
+						bSuccess = PPProcessPragma(psCPD, psContext, psTokens, uTokenEntry, uLastTokenEntry);
+					}
+					else if (strcmp(psToken->pvData, "extension") == 0)
+					{
+						bSuccess = PPProcessExtension(psCPD, psContext, psTokens, uTokenEntry, uLastTokenEntry);
+					}
+					else if (strcmp(psToken->pvData, "version") == 0)
+					{
+						bSuccess = PPProcessVersion(psCPD, psContext, psTokens, uTokenEntry, uLastTokenEntry, psOut);
+					}
+					else
+					{
+						LogProgramTokenError(psCPD->psErrorLog, psToken, "'' :   Invalid directive %s\n", psToken->pvData);
+						bSuccess = IMG_FALSE;
+					}
 				}
-			}
 
-			break;
-		}
-		default:
-		{
-			if (psToken->pvData)
-			{
-				LogProgramTokenError(psCPD->psErrorLog, psToken, "'' :   Invalid directive %s\n", psToken->pvData);
+				break;
 			}
-			else
+			default:
 			{
-				LogProgramTokenError(psCPD->psErrorLog, psToken, "'' :   Invalid directive\n");
+				if (psToken->pvData)
+				{
+					LogProgramTokenError(psCPD->psErrorLog, psToken, "'' :   Invalid directive %s\n", psToken->pvData);
+				}
+				else
+				{
+					LogProgramTokenError(psCPD->psErrorLog, psToken, "'' :   Invalid directive\n");
+				}
+				bSuccess = IMG_FALSE;
+				break;
 			}
-			return IMG_FALSE;
 		}
 	}
 
+	/* The directive has been dealt with */
+	if (!PPFlushTokens(psTokens, psTokens->uEnd, psOut))
+	{
+		bSuccess = IMG_FALSE;
+	}
+
 	return bSuccess;
 }
 
@@ -3338,75 +3752,101 @@ static IMG_BOOL PPProcessDirective(GLSLCompilerPrivateData *psCPD,
 /******************************************************************************
  * Function Name: PPSetDefaultDefine
  *
- * Inputs       : 
+ * Inputs       :
  * Outputs      : -
- * Returns      : 
+ * Returns      :
  * Globals Used : -
  *
  * Description  : Used to set some default defines
  *****************************************************************************/
 static IMG_BOOL PPSetDefaultDefine(GLSLCompilerPrivateData *psCPD,
+								   GLSLPreProcessorContext *psContext,
 								   IMG_CHAR *pszDefineName,
-											IMG_CHAR *pszDefineValue,
-											SymTable *psSymbolTable)
+								   IMG_CHAR *pszDefineValue)
 {
-	IMG_UINT32 uLineLength = strlen(pszDefineName) + strlen(pszDefineValue) + 20;
-
-	IMG_CHAR *pszLine = DebugMemAlloc(uLineLength);
-
-	IMG_BOOL bSuccess;
-
-	TokenLL asTokenLL[3] = {{{0}}};
-	Token   *psToken;
-
-	/* Construct a line */
-	if(!pszLine)
-	{
-		return IMG_FALSE;
-	}
-	sprintf(pszLine, "#define %s %s\n", pszDefineName, pszDefineValue);
-
-	asTokenLL[0].psPrev  = IMG_NULL; 
-	asTokenLL[0].psNext  = &asTokenLL[1];
-	asTokenLL[0].bRemove = IMG_TRUE;
+	PPToken      asTokens[3];
+	PPTokenArray sTokens;
+	Token       *psToken;
 
-	asTokenLL[1].psPrev  = &asTokenLL[0];
-	asTokenLL[1].psNext  = &asTokenLL[2];
-	asTokenLL[1].bRemove = IMG_TRUE;
+	memset(asTokens, 0, sizeof(asTokens));
 
-	asTokenLL[2].psPrev  = &asTokenLL[0];
-	asTokenLL[2].psNext  = IMG_NULL;
-	asTokenLL[2].bRemove = IMG_TRUE;
+	sTokens.psTokens   = asTokens;
+	sTokens.uStart     = 0;
+	sTokens.uEnd       = 3;
+	sTokens.uAllocated = 3;
 
-	/* Build the token list */
-	psToken = &asTokenLL[1].sToken;
+	/* Build the token list as if it came from "#define <name> <value>" */
+	psToken = PP_TOKEN(&sTokens, 1);
 
 	psToken->eTokenName         = TOK_IDENTIFIER;
-	psToken->pszStartOfLine     = pszLine;
-	psToken->uStringNumber      = 0;
-	psToken->uLineNumber        = 0;
 	psToken->uCharNumber        = 8;
-	psToken->uSizeOfDataInBytes = strlen(pszDefineName);
+	psToken->uSizeOfDataInBytes = (IMG_UINT32)strlen(pszDefineName);
 	psToken->pvData             = (IMG_VOID *)pszDefineName;
 
-	psToken = &(asTokenLL[2].sToken);
+	psToken = PP_TOKEN(&sTokens, 2);
 
 	psToken->eTokenName         = TOK_INTCONSTANT;
-	psToken->pszStartOfLine     = pszLine;
-	psToken->uStringNumber      = 0;
-	psToken->uLineNumber        = 0;
 	psToken->uCharNumber        = 14;
-	psToken->uSizeOfDataInBytes = strlen(pszDefineValue);
+	psToken->uSizeOfDataInBytes = (IMG_UINT32)strlen(pszDefineValue);
 	psToken->pvData             = (IMG_VOID *)pszDefineValue;
 
 	/* Add the define */
-	bSuccess = ProcessDefineMacro(psCPD, &asTokenLL[0], &asTokenLL[2], psSymbolTable, IMG_TRUE);
+	return ProcessDefineMacro(psCPD, psContext, &sTokens, 0, 2, IMG_TRUE);
+}
+#endif
 
-	DebugMemFree(pszLine);
+/******************************************************************************
+ * Function Name: PPDestroyContext
+ *
+ * Inputs       : psContext - Preprocessor context
+ * Outputs      : -
+ * Returns      : -
+ * Globals Used : -
+ *
+ * Description  : Frees everything allocated by the preprocessor context.
+ *****************************************************************************/
+static IMG_VOID PPDestroyContext(GLSLPreProcessorContext *psContext)
+{
+	IMG_UINT32 i;
 
-	return bSuccess;
+	if (psContext->ppsIdentifierHash)
+	{
+		/* The identifiers themselves live in the string store */
+		for (i = 0; i < psContext->uIdentifierHashSize; i++)
+		{
+			PPIdentifier *psIdentifier;
+
+			for (psIdentifier = psContext->ppsIdentifierHash[i]; psIdentifier; psIdentifier = psIdentifier->psNext)
+			{
+				if (psIdentifier->psDefineMacro)
+				{
+					PPFreeDefineMacro(psIdentifier->psDefineMacro);
+				}
+			}
+		}
+
+		DebugMemFree(psContext->ppsIdentifierHash);
+	}
+
+	while (psContext->psStringBlocks)
+	{
+		PPStringBlock *psNext = psContext->psStringBlocks->psNext;
+
+		DebugMemFree(psContext->psStringBlocks);
+
+		psContext->psStringBlocks = psNext;
+	}
+
+	if (psContext->sExpansion.psTokens)
+	{
+		DebugMemFree(psContext->sExpansion.psTokens);
+	}
+
+	if (psContext->puParameterEntries)
+	{
+		DebugMemFree(psContext->puParameterEntries);
+	}
 }
-#endif
 
 /******************************************************************************
  * Function Name: PPPreProcessTokenList
@@ -3414,7 +3854,7 @@ static IMG_BOOL PPSetDefaultDefine(GLSLCompilerPrivateData *psCPD,
  * Inputs       : pvData          - PreProcessor data (see GLSLPreProcessorData)
  *                psTokenList     - Array of tokens to preprocess
  *                uNumTokens      - Length of the array of tokens
- *                
+ *
  * Outputs      : ppsNewTokenList - Array of tokens after preprocessing
  *                puNewNumTokens  - Length of the array of tokens after preprocessing
  *
@@ -3423,6 +3863,10 @@ static IMG_BOOL PPSetDefaultDefine(GLSLCompilerPrivateData *psCPD,
  *
  * Description  : Aplies the GLSL preprocessor to an array of tokens. Generates
  *                an array of preprocessed tokens.
+ *
+ *                Source tokens are read into psLine until the end of a line (or
+ *                of a directive) is reached. The line is then checked for macros
+ *                or the directive is processed, and the result is moved to sOut.
  *****************************************************************************/
 IMG_INTERNAL IMG_BOOL PPPreProcessTokenList(GLSLCompilerPrivateData *psCPD,
 											IMG_VOID			   *pvData,
@@ -3438,14 +3882,11 @@ IMG_INTERNAL IMG_BOOL PPPreProcessTokenList(GLSLCompilerPrivateData *psCPD,
 	IMG_BOOL            bProcessingDirective    = IMG_FALSE;
 	IMG_INT32           nLineNumberAdjustment   = 0;
 	IMG_INT32           nStringNumberAdjustment = 0;
-	SymbolTableContext *psSymbolTableContext;
-	SymTable           *psSymbolTable;  
 	GLSLPreProcessorContext sContext = {0};
 
-	TokenLL            *psTokenLL;
-	TokenLL            *psCurrentEntry;
-	TokenLL            *psFirstTokenOfDirective = IMG_NULL, *psLastBackSlashEntry = IMG_NULL, *psFirstCodeBlockEntry = IMG_NULL;
-	MemHeap            *psTokMemHeap;
+	PPTokenArray        sLine = {0};
+	PPTokenArray        sOut  = {0};
+	IMG_UINT32          uFirstTokenOfDirective = PP_NO_TOKEN, uLastBackSlash = PP_NO_TOKEN;
 
 	IMG_BOOL            bSuccess = IMG_TRUE;
 
@@ -3455,72 +3896,91 @@ IMG_INTERNAL IMG_BOOL PPPreProcessTokenList(GLSLCompilerPrivateData *psCPD,
 
 	/* Setup the context */
 	sContext.uSupportedVersion  = GLSL_DEFAULT_VERSION_SUPPORT;
-	sContext.eEnabledExtensions = GLSLEXT_DEFAULT_EXTENSIONS; 
+	sContext.eEnabledExtensions = GLSLEXT_DEFAULT_EXTENSIONS;
+	sContext.psInputTokens      = psTokenList;
+	sContext.uNumInputTokens    = uNumTokens;
+	sContext.uNextInputToken    = 0;
+
 	/* Reset the if status */
 	sIfStatus.uNestedIfLevel      = 0;
 	sIfStatus.uCurrentActiveLevel = 0;
 	sIfStatus.aeIfBlockStates[0]  = IFSTATE_BLOCK_IF_ENABLED;
 
-	/* Create symbol table for managing preprocesser definitions */
-	psSymbolTableContext = InitSymbolTableManager();
-	psSymbolTable        = CreateSymTable(psSymbolTableContext,
-										  "Preprocessor state",
-										  100, 
-										  GLSL_NUM_BITS_FOR_SYMBOL_IDS, 
-										  IMG_NULL);
-	if(!psSymbolTable)
+	/* Create the identifier table for managing preprocessor definitions */
+	sContext.uIdentifierHashSize = PP_MIN_IDENTIFIER_HASH_SIZE;
+	sContext.ppsIdentifierHash   = DebugMemCalloc(sContext.uIdentifierHashSize * sizeof(PPIdentifier *));
+
+	if(!sContext.ppsIdentifierHash)
+	{
 		return IMG_FALSE;
+	}
+
+	sContext.psDefinedIdentifier = PPFindIdentifier(&sContext, "defined", IMG_TRUE);
+	sContext.psLineIdentifier    = PPFindIdentifier(&sContext, "__LINE__", IMG_TRUE);
+	sContext.psFileIdentifier    = PPFindIdentifier(&sContext, "__FILE__", IMG_TRUE);
+	sContext.psVersionIdentifier = PPFindIdentifier(&sContext, "__VERSION__", IMG_TRUE);
 
 	/* 1.2 seems to be a fairly consistant ratio */
 	/* Using 1.25 to avoid floating point multiply */
-	psTokMemHeap = DebugCreateHeap(sizeof(TokenLL), uNumTokens + (uNumTokens >> 2));
+	if (!sContext.psDefinedIdentifier || !sContext.psLineIdentifier ||
+		!sContext.psFileIdentifier || !sContext.psVersionIdentifier ||
+		!PPReserveTokens(&sOut, 0, uNumTokens + (uNumTokens >> 2), IMG_NULL))
+	{
+		PPDestroyContext(&sContext);
+		return IMG_FALSE;
+	}
 
 #if defined(GLSL_ES)
 	// FIXME: this should be organized with #ifdef ENABLE_EXT_BLAH blocks
 	/* Set default preprocessor defines */
-	PPSetDefaultDefine(psCPD, "GL_ES", "1", psSymbolTable);
-	PPSetDefaultDefine(psCPD, "GL_FRAGMENT_PRECISION_HIGH", "1", psSymbolTable);
-	//PPSetDefaultDefine(psCPD, "GL_OES_standard_noise", "1", psSymbolTable);
-	PPSetDefaultDefine(psCPD, "GL_OES_standard_derivatives", "1", psSymbolTable);
-	PPSetDefaultDefine(psCPD, "GL_EXT_shader_texture_lod", "1", psSymbolTable);
-	PPSetDefaultDefine(psCPD, "GL_IMG_texture_stream2", "1", psSymbolTable);
-
-	PPSetDefaultDefine(psCPD, "GL_OES_EGL_image_external", "1", psSymbolTable);
+	PPSetDefaultDefine(psCPD, &sContext, "GL_ES", "1");
+	PPSetDefaultDefine(psCPD, &sContext, "GL_FRAGMENT_PRECISION_HIGH", "1");
+	//PPSetDefaultDefine(psCPD, &sContext, "GL_OES_standard_noise", "1");
+	PPSetDefaultDefine(psCPD, &sContext, "GL_OES_standard_derivatives", "1");
+	PPSetDefaultDefine(psCPD, &sContext, "GL_EXT_shader_texture_lod", "1");
+	PPSetDefaultDefine(psCPD, &sContext, "GL_IMG_texture_stream2", "1");
+
+	PPSetDefaultDefine(psCPD, &sContext, "GL_OES_EGL_image_external", "1");
 #endif
 
-	/* Create a token linked list from the input array */
-	psTokenLL = PPCreateTokenLinkedList(psTokMemHeap, psTokenList, uNumTokens, IMG_NULL);
-
-	/* Get the first entry */
-	psCurrentEntry = psTokenLL;
-
-	psFirstCodeBlockEntry = psCurrentEntry;
-
 	/* Search through all tokens */
-	while (psCurrentEntry)
+	while (sContext.uNextInputToken < uNumTokens)
 	{
-		IMG_BOOL bRemoveCurrentToken = IMG_FALSE;
+		IMG_BOOL   bRemoveCurrentToken = IMG_FALSE;
 
-		Token *psToken = &psCurrentEntry->sToken;
+		IMG_UINT32 uInputToken = sContext.uNextInputToken++;
+
+		PPToken   *psPPToken;
+		Token     *psToken;
 
 		if (bProcessingDirective)
 		{
 			bRemoveCurrentToken = IMG_TRUE;
 		}
 
-		/* Adjust the line number */
-		// Commented temporarily: psToken->uLineNumber += nLineNumberAdjustment;
-		
 		/* Check for string changes before we carry out any line, string number adjustments */
-		if (psCurrentEntry->psNext)
+		if (uInputToken + 1 < uNumTokens)
 		{
 			/* If the string has changed then we need to reset any line number adjustments */
-			if (psToken->uStringNumber != psCurrentEntry->psNext->sToken.uStringNumber)
+			if (psTokenList[uInputToken].uStringNumber != psTokenList[uInputToken + 1].uStringNumber)
 			{
 				nLineNumberAdjustment = 0;
 			}
 		}
 
+		/* Add the token to the current line */
+		if (!PPAppendInputTokens(&sContext, &sLine, uInputToken, 1))
+		{
+			bSuccess = IMG_FALSE;
+			break;
+		}
+
+		psPPToken = &sLine.psTokens[sLine.uEnd - 1];
+		psToken   = &psPPToken->sToken;
+
+		/* Adjust the line number */
+		// Commented temporarily: psToken->uLineNumber += nLineNumberAdjustment;
+
 		/* Adjust the string number */
 		psToken->uStringNumber += nStringNumberAdjustment;
 
@@ -3528,7 +3988,7 @@ IMG_INTERNAL IMG_BOOL PPPreProcessTokenList(GLSLCompilerPrivateData *psCPD,
 		{
 			case TOK_HASH:
 			{
-				psFirstTokenOfDirective = psCurrentEntry;
+				uFirstTokenOfDirective = sLine.uEnd - 1;
 
 				bProcessingDirective = IMG_TRUE;
 
@@ -3536,8 +3996,8 @@ IMG_INTERNAL IMG_BOOL PPPreProcessTokenList(GLSLCompilerPrivateData *psCPD,
 			}
 			case TOK_BACK_SLASH:
 			{
-				psLastBackSlashEntry = psCurrentEntry;
-				
+				uLastBackSlash = uInputToken;
+
 				break;
 			}
 			case TOK_NEWLINE:
@@ -3546,14 +4006,15 @@ IMG_INTERNAL IMG_BOOL PPPreProcessTokenList(GLSLCompilerPrivateData *psCPD,
 			case TOK_TERMINATEPARSING:
 			{
 				IMG_BOOL bMultiLineStatement = IMG_FALSE;
+				IMG_BOOL bLineProcessed      = IMG_FALSE;
 
-				/* If the last token was a back slash then we're dealing with a multi line statement (probably) 
+				/* If the last token was a back slash then we're dealing with a multi line statement (probably)
 
-				   However, this is not the only case, during the macro replacement, the call of macro may still happen in multiple lines.  
-				   This case cannot be detected by this simple token link list traverse.  This means bMultiLineStatement may give wrong 
+				   However, this is not the only case, during the macro replacement, the call of macro may still happen in multiple lines.
+				   This case cannot be detected by this simple token traverse.  This means bMultiLineStatement may give wrong
 				   information for macro replacement.  This error should be corrected during the PPCheckForMacroReplacement.
 				 */
-				if (psLastBackSlashEntry && (psLastBackSlashEntry == psCurrentEntry->psPrev))
+				if ((uLastBackSlash != PP_NO_TOKEN) && (uLastBackSlash + 1 == uInputToken))
 				{
 					bMultiLineStatement = IMG_TRUE;
 				}
@@ -3562,81 +4023,90 @@ IMG_INTERNAL IMG_BOOL PPPreProcessTokenList(GLSLCompilerPrivateData *psCPD,
 				{
 					bRemoveCurrentToken = IMG_FALSE;
 				}
-				
+
 				if (bProcessingDirective)
 				{
 					if (!bMultiLineStatement)
 					{
 						/* Process this directive */
 						if (!PPProcessDirective(psCPD, &sContext,
-											  psTokMemHeap,
-											  psFirstTokenOfDirective,
-											  psCurrentEntry,
-											  psSymbolTable,
+											  &sLine,
+											  uFirstTokenOfDirective,
+											  sLine.uEnd - 1,
+											  &sOut,
 											  &sIfStatus,
 											  &nLineNumberAdjustment,
 											  &nStringNumberAdjustment))
 						{
 							bSuccess = IMG_FALSE;
 						}
-						
+
 						bProcessingDirective = IMG_FALSE;
 
-						/* Start a new code block */
-						psFirstCodeBlockEntry = psCurrentEntry;
+						bLineProcessed = IMG_TRUE;
 					}
 				}
-				else 
+				else
 				{
 					if (!bMultiLineStatement)
 					{
-						/* Check for any usage of defines on this line 
+						/* Check for any usage of defines on this line
 
-						   This multiline statement information is may wrong, PPCheckForMacroReplacement will correct this wrong judgement 
-						   and return the adjustment of psCurrentEntry.
+						   This multiline statement information is may wrong, PPCheckForMacroReplacement will correct this wrong judgement
+						   by reading the rest of the statement from the source.
 						 */
-						TokenLL *psNewLastEntry;
-						if (!PPCheckForMacroReplacement(psCPD, psTokMemHeap, psFirstCodeBlockEntry, psCurrentEntry, psSymbolTable, IMG_NULL, &psNewLastEntry))
+						if (!PPCheckForMacroReplacement(psCPD, &sContext, &sLine, sLine.uEnd - 1, &sOut, IMG_NULL))
 						{
 							bSuccess = IMG_FALSE;
 						}
-						
-						if (psNewLastEntry != IMG_NULL)
-						{
-							psCurrentEntry = psNewLastEntry;
-						}
 
-						/* Start a new code block */
-						psFirstCodeBlockEntry = psCurrentEntry;
+						bLineProcessed = IMG_TRUE;
 					}
 				}
-				
+
+				/* Start a new code block with the last token that was processed */
+				if (bLineProcessed)
+				{
+					if (!PPAppendTokens(&sLine, &sOut.psTokens[sOut.uEnd - 1], 1))
+					{
+						bSuccess = IMG_FALSE;
+						break;
+					}
+
+					sOut.uEnd--;
+				}
+
 				break;
 			}
 			case TOK_IDENTIFIER:
 			{
-				/* Could make this faster by introducing tokens for each of these */
-				if (strcmp(psToken->pvData, "__LINE__") == 0)
-				{
-					/* Don't need to free and reallocate since there should already be enough space */
-					sprintf(psToken->pvData, "%u", psToken->uLineNumber);
+				IMG_UINT32 uValue;
 
-					psToken->eTokenName = TOK_INTCONSTANT;
+				if (psPPToken->psIdentifier == sContext.psLineIdentifier)
+				{
+					uValue = psToken->uLineNumber;
 				}
-				else if (strcmp(psToken->pvData, "__FILE__") == 0)
+				else if (psPPToken->psIdentifier == sContext.psFileIdentifier)
 				{
-					/* Don't need to free and reallocate since there should already be enough space */
-					sprintf(psToken->pvData, "%u", psToken->uStringNumber);
-
-					psToken->eTokenName = TOK_INTCONSTANT;
+					uValue = psToken->uStringNumber;
+				}
+				else if (psPPToken->psIdentifier == sContext.psVersionIdentifier)
+				{
+					uValue = sContext.uSupportedVersion;
 				}
-				else if (strcmp(psToken->pvData, "__VERSION__") == 0)
+				else
 				{
-					/* Don't need to free and reallocate since there should already be enough space */
-					sprintf(psToken->pvData, "%u", sContext.uSupportedVersion);
+					break;
+				}
 
-					psToken->eTokenName = TOK_INTCONSTANT;
+				if (!PPSetTokenNumber(&sContext, psToken, uValue))
+				{
+					bSuccess = IMG_FALSE;
 				}
+
+				psPPToken->psIdentifier = IMG_NULL;
+
+				break;
 			}
 			default:
 				break;
@@ -3649,19 +4119,22 @@ IMG_INTERNAL IMG_BOOL PPPreProcessTokenList(GLSLCompilerPrivateData *psCPD,
 		}
 
 		/* Indicate if token should be removed or not */
-		psCurrentEntry->bRemove = bRemoveCurrentToken;
+		if (sLine.uEnd > sLine.uStart)
+		{
+			sLine.psTokens[sLine.uEnd - 1].bRemove = bRemoveCurrentToken;
+		}
 
 		/* Are there any more tokens to process? */
-		if (!psCurrentEntry->psNext)
+		if (sContext.uNextInputToken == uNumTokens)
 		{
 			if (bProcessingDirective)
 			{
 				/* Process this directive */
 				if (!PPProcessDirective(psCPD, &sContext,
-									  psTokMemHeap,
-									  psFirstTokenOfDirective,
-									  psCurrentEntry,
-									  psSymbolTable,
+									  &sLine,
+									  uFirstTokenOfDirective,
+									  sLine.uEnd - 1,
+									  &sOut,
 									  &sIfStatus,
 									  &nLineNumberAdjustment,
 									  &nStringNumberAdjustment))
@@ -3672,22 +4145,18 @@ IMG_INTERNAL IMG_BOOL PPPreProcessTokenList(GLSLCompilerPrivateData *psCPD,
 			else
 			{
 				/* Check for macro replacements withany of the remaining tokens */
-				TokenLL *psNewLastEntry;
-				if (!PPCheckForMacroReplacement(psCPD, psTokMemHeap, psFirstCodeBlockEntry, psCurrentEntry, psSymbolTable, IMG_NULL, &psNewLastEntry))
+				if (!PPCheckForMacroReplacement(psCPD, &sContext, &sLine, sLine.uEnd - 1, &sOut, IMG_NULL))
 				{
 					bSuccess = IMG_FALSE;
 				}
-
-				if (psNewLastEntry != IMG_NULL)
-				{
-					psCurrentEntry = psNewLastEntry;
-				}
 			}
 		}
+	}
 
-		/* Get next entry */
-		psCurrentEntry = psCurrentEntry->psNext;
-
+	/* Anything left over has already been checked */
+	if (!PPFlushTokens(&sLine, sLine.uEnd, &sOut))
+	{
+		bSuccess = IMG_FALSE;
 	}
 
 	if (sIfStatus.uNestedIfLevel)
@@ -3699,21 +4168,24 @@ IMG_INTERNAL IMG_BOOL PPPreProcessTokenList(GLSLCompilerPrivateData *psCPD,
 	/* Create the new token list */
 	if(bSuccess)
 	{
-		*ppsNewTokenList = PPCreateTokenList(psTokenLL, IMG_NULL, puNewNumTokens); 
-		if(!*ppsNewTokenList) 
-			return IMG_FALSE;
+		*ppsNewTokenList = PPCreateTokenList(&sOut, puNewNumTokens);
+		if(!*ppsNewTokenList)
+		{
+			bSuccess = IMG_FALSE;
+		}
 	}
 
-	/* Destroy the linked list */
-	PPDestroyTokenLinkedList(psTokMemHeap, psTokenLL);
-
-	/* Destroy the heap */
-	DebugDestroyHeap(psTokMemHeap);
+	if (sLine.psTokens)
+	{
+		DebugMemFree(sLine.psTokens);
+	}
 
-	RemoveSymbolTableFromManager(psSymbolTableContext, psSymbolTable);
-	DestroySymTable(psSymbolTable);
+	if (sOut.psTokens)
+	{
+		DebugMemFree(sOut.psTokens);
+	}
 
-	DestroySymbolTableManager(psSymbolTableContext);
+	PPDestroyContext(&sContext);
 
 	if(bSuccess)
 	{
@@ -3734,6 +4206,7 @@ IMG_INTERNAL IMG_BOOL PPPreProcessTokenList(GLSLCompilerPrivateData *psCPD,
 	return bSuccess;
 }
 
+
 /******************************************************************************
  * Function Name: PPDestroyPreProcessorData
  *
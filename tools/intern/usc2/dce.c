@@ -97,6 +97,557 @@ PUSC_LIVE_CALLBACK SetBlockCallData(PUSC_LIVE_CALLBACK psCallback,
 	return psCallback;
 }
 
+/*
+	Number of temporary registers at or above which DoLiveness keeps the live temporary
+	channels and predicates of its working sets in packed bit vectors. Below this a
+	USC_VECTOR holds all the temporaries in one chunk and is as cheap to merge and compare.
+*/
+#define USC_DENSE_LIVESET_MIN_TEMPS		(USC_BITS_PER_VCHUNK / CHANS_PER_REGISTER)
+
+static IMG_BOOL GetDenseLiveSetBits(PINTERMEDIATE_STATE	psState,
+									PREGISTER_LIVESET	psLiveSet,
+									IMG_UINT32			uType,
+									IMG_PUINT32**		ppauBits,
+									IMG_PUINT32*		ppuWordCount,
+									USC_PVECTOR*		ppsVector)
+/*********************************************************************************
+ Function			: GetDenseLiveSetBits
+
+ Description		: Get the storage for the live channels of a register type
+					  which can be held in packed form.
+
+ Parameters			: psState		- Compiler state
+					  psLiveSet		- Liveness set
+					  uType			- USEASM_REGTYPE_TEMP or USEASM_REGTYPE_PREDICATE
+					  ppauBits		- Returns the packed bit vector
+					  ppuWordCount	- Returns the length of the packed bit vector in dwords
+					  ppsVector		- Returns the sparse vector
+
+ Globals Effected	: None
+
+ Return				: TRUE if the packed bit vector is in use for this type.
+*********************************************************************************/
+{
+	if (uType == USEASM_REGTYPE_TEMP)
+	{
+		*ppauBits = &psLiveSet->auDenseTemp;
+		*ppuWordCount = &psLiveSet->uDenseTempWords;
+		*ppsVector = &psLiveSet->sTemp;
+	}
+	else
+	{
+		ASSERT(uType == USEASM_REGTYPE_PREDICATE);
+		*ppauBits = &psLiveSet->auDensePredicate;
+		*ppuWordCount = &psLiveSet->uDensePredicateWords;
+		*ppsVector = &psLiveSet->sPredicate;
+	}
+	return (**ppauBits != NULL) ? IMG_TRUE : IMG_FALSE;
+}
+
+static IMG_VOID GrowDenseLiveSetBits(PINTERMEDIATE_STATE	psState,
+									 IMG_PUINT32*			pauBits,
+									 IMG_PUINT32			puWordCount,
+									 IMG_UINT32				uMinWordCount)
+/*********************************************************************************
+ Function			: GrowDenseLiveSetBits
+
+ Description		: Make sure a packed bit vector is at least a given length; new
+					  dwords are cleared.
+
+ Parameters			: psState		- Compiler state
+					  pauBits		- Bit vector to grow
+					  puWordCount	- Length of the bit vector in dwords
+					  uMinWordCount	- Length required
+
+ Globals Effected	: None
+
+ Return				: Nothing
+*********************************************************************************/
+{
+	IMG_PUINT32	auNewBits;
+
+	if (*puWordCount >= uMinWordCount)
+	{
+		return;
+	}
+
+	auNewBits = UscAlloc(psState, uMinWordCount * sizeof(IMG_UINT32));
+	memcpy(auNewBits, *pauBits, *puWordCount * sizeof(IMG_UINT32));
+	memset(auNewBits + *puWordCount, 0, (uMinWordCount - *puWordCount) * sizeof(IMG_UINT32));
+	UscFree(psState, *pauBits);
+
+	*pauBits = auNewBits;
+	*puWordCount = uMinWordCount;
+}
+
+static IMG_VOID MakeRegLiveSetDense(PINTERMEDIATE_STATE psState, PREGISTER_LIVESET psLiveSet)
+/*********************************************************************************
+ Function			: MakeRegLiveSetDense
+
+ Description		: Switch an empty liveness set to holding the live temporary
+					  channels and predicates in packed bit vectors sized for the
+					  current number of registers.
+
+ Parameters			: psState		- Compiler state
+					  psLiveSet		- Liveness set to switch
+
+ Globals Effected	: None
+
+ Return				: Nothing
+*********************************************************************************/
+{
+	ASSERT(psLiveSet->auDenseTemp == NULL && psLiveSet->auDensePredicate == NULL);
+	ASSERT(psLiveSet->sTemp.psFirst == NULL && psLiveSet->sPredicate.psFirst == NULL);
+
+	/*
+		Always allocate at least one dword: a non-NULL pointer marks the packed form.
+	*/
+	psLiveSet->uDenseTempWords = max(UINTS_TO_SPAN_BITS(psState->uNumRegisters * CHANS_PER_REGISTER), 1U);
+	psLiveSet->auDenseTemp = UscAlloc(psState, psLiveSet->uDenseTempWords * sizeof(IMG_UINT32));
+	memset(psLiveSet->auDenseTemp, 0, psLiveSet->uDenseTempWords * sizeof(IMG_UINT32));
+
+	psLiveSet->uDensePredicateWords = max(UINTS_TO_SPAN_BITS(psState->uNumPredicates), 1U);
+	psLiveSet->auDensePredicate = UscAlloc(psState, psLiveSet->uDensePredicateWords * sizeof(IMG_UINT32));
+	memset(psLiveSet->auDensePredicate, 0, psLiveSet->uDensePredicateWords * sizeof(IMG_UINT32));
+}
+
+static IMG_VOID FreeDenseLiveSet(PINTERMEDIATE_STATE psState, PREGISTER_LIVESET psLiveSet)
+/*********************************************************************************
+ Function			: FreeDenseLiveSet
+
+ Description		: Free the packed bit vectors in a liveness set (if any). The set
+					  goes back to using the sparse vectors.
+
+ Parameters			: psState		- Compiler state
+					  psLiveSet		- Liveness set
+
+ Globals Effected	: None
+
+ Return				: Nothing
+*********************************************************************************/
+{
+	if (psLiveSet->auDenseTemp != NULL)
+	{
+		UscFree(psState, psLiveSet->auDenseTemp);
+	}
+	if (psLiveSet->auDensePredicate != NULL)
+	{
+		UscFree(psState, psLiveSet->auDensePredicate);
+	}
+	psLiveSet->uDenseTempWords = 0;
+	psLiveSet->uDensePredicateWords = 0;
+}
+
+static IMG_VOID OrVectorIntoDenseBits(PINTERMEDIATE_STATE	psState,
+									  USC_PVECTOR			psVector,
+									  IMG_PUINT32*			pauBits,
+									  IMG_PUINT32			puWordCount)
+/*********************************************************************************
+ Function			: OrVectorIntoDenseBits
+
+ Description		: Set the bits set in a sparse vector in a packed bit vector.
+
+ Parameters			: psState		- Compiler state
+					  psVector		- Sparse vector to read
+					  pauBits		- Packed bit vector to update
+					  puWordCount	- Length of the packed bit vector in dwords
+
+ Globals Effected	: None
+
+ Return				: Nothing
+*********************************************************************************/
+{
+	VECTOR_ITERATOR	sIter;
+
+	for (VectorIteratorInitialize(psState, psVector, BITS_PER_UINT, &sIter);
+		 VectorIteratorContinue(&sIter);
+		 VectorIteratorNext(&sIter))
+	{
+		IMG_UINT32	uWord = VectorIteratorCurrentPosition(&sIter) / BITS_PER_UINT;
+
+		GrowDenseLiveSetBits(psState, pauBits, puWordCount, uWord + 1);
+		(*pauBits)[uWord] |= VectorIteratorCurrentMask(&sIter);
+	}
+}
+
+static IMG_VOID OrDenseBitsIntoVector(PINTERMEDIATE_STATE	psState,
+									  IMG_PUINT32			auBits,
+									  IMG_UINT32			uWordCount,
+									  USC_PVECTOR			psVector)
+/*********************************************************************************
+ Function			: OrDenseBitsIntoVector
+
+ Description		: Set the bits set in a packed bit vector in a sparse vector.
+
+ Parameters			: psState		- Compiler state
+					  auBits		- Packed bit vector to read
+					  uWordCount	- Length of the packed bit vector in dwords
+					  psVector		- Sparse vector to update
+
+ Globals Effected	: None
+
+ Return				: Nothing
+*********************************************************************************/
+{
+	IMG_UINT32	uWord;
+
+	for (uWord = 0; uWord < uWordCount; uWord++)
+	{
+		if (auBits[uWord] != 0)
+		{
+			VectorOrRange(psState,
+						  psVector,
+						  (uWord + 1) * BITS_PER_UINT - 1,
+						  uWord * BITS_PER_UINT,
+						  auBits[uWord]);
+		}
+	}
+}
+
+static IMG_VOID CopyLiveSetRegType(PINTERMEDIATE_STATE	psState,
+								   PREGISTER_LIVESET	psSrc,
+								   PREGISTER_LIVESET	psDst,
+								   IMG_UINT32			uType)
+/*********************************************************************************
+ Function			: CopyLiveSetRegType
+
+ Description		: Copy the live channels for a register type which can be held
+					  in packed form, keeping the form of the destination.
+
+ Parameters			: psState		- Compiler state
+					  psSrc			- Source
+					  psDst			- Destination
+					  uType			- USEASM_REGTYPE_TEMP or USEASM_REGTYPE_PREDICATE
+
+ Globals Effected	: None
+
+ Return				: Nothing
+*********************************************************************************/
+{
+	IMG_PUINT32*	pauSrcBits;
+	IMG_PUINT32		puSrcWordCount;
+	USC_PVECTOR		psSrcVector;
+	IMG_PUINT32*	pauDstBits;
+	IMG_PUINT32		puDstWordCount;
+	USC_PVECTOR		psDstVector;
+	IMG_BOOL		bSrcDense, bDstDense;
+
+	bSrcDense = GetDenseLiveSetBits(psState, psSrc, uType, &pauSrcBits, &puSrcWordCount, &psSrcVector);
+	bDstDense = GetDenseLiveSetBits(psState, psDst, uType, &pauDstBits, &puDstWordCount, &psDstVector);
+
+	if (bDstDense)
+	{
+		if (bSrcDense)
+		{
+			GrowDenseLiveSetBits(psState, pauDstBits, puDstWordCount, *puSrcWordCount);
+			memcpy(*pauDstBits, *pauSrcBits, *puSrcWordCount * sizeof(IMG_UINT32));
+			memset(*pauDstBits + *puSrcWordCount, 0, (*puDstWordCount - *puSrcWordCount) * sizeof(IMG_UINT32));
+		}
+		else
+		{
+			memset(*pauDstBits, 0, *puDstWordCount * sizeof(IMG_UINT32));
+			OrVectorIntoDenseBits(psState, psSrcVector, pauDstBits, puDstWordCount);
+		}
+	}
+	else
+	{
+		if (bSrcDense)
+		{
+			ClearVector(psState, psDstVector);
+			OrDenseBitsIntoVector(psState, *pauSrcBits, *puSrcWordCount, psDstVector);
+		}
+		else
+		{
+			VectorCopy(psState, psSrcVector, psDstVector);
+		}
+	}
+}
+
+static IMG_VOID MergeLiveSetRegType(PINTERMEDIATE_STATE	psState,
+									PREGISTER_LIVESET	psDest,
+									PREGISTER_LIVESET	psSrc,
+									IMG_UINT32			uType)
+/*********************************************************************************
+ Function			: MergeLiveSetRegType
+
+ Description		: Merge the live channels for a register type which can be held
+					  in packed form.
+
+ Parameters			: psState		- Compiler state
+					  psDest		- Destination for the merge
+					  psSrc			- Source for the merge
+					  uType			- USEASM_REGTYPE_TEMP or USEASM_REGTYPE_PREDICATE
+
+ Globals Effected	: None
+
+ Return				: Nothing
+*********************************************************************************/
+{
+	IMG_PUINT32*	pauSrcBits;
+	IMG_PUINT32		puSrcWordCount;
+	USC_PVECTOR		psSrcVector;
+	IMG_PUINT32*	pauDestBits;
+	IMG_PUINT32		puDestWordCount;
+	USC_PVECTOR		psDestVector;
+	IMG_BOOL		bSrcDense, bDestDense;
+
+	bSrcDense = GetDenseLiveSetBits(psState, psSrc, uType, &pauSrcBits, &puSrcWordCount, &psSrcVector);
+	bDestDense = GetDenseLiveSetBits(psState, psDest, uType, &pauDestBits, &puDestWordCount, &psDestVector);
+
+	if (bDestDense)
+	{
+		if (bSrcDense)
+		{
+			IMG_PUINT32	auSrcBits;
+			IMG_PUINT32	auDestBits;
+			IMG_UINT32	uWord;
+
+			GrowDenseLiveSetBits(psState, pauDestBits, puDestWordCount, *puSrcWordCount);
+			auSrcBits = *pauSrcBits;
+			auDestBits = *pauDestBits;
+			for (uWord = 0; uWord < *puSrcWordCount; uWord++)
+			{
+				auDestBits[uWord] |= auSrcBits[uWord];
+			}
+		}
+		else
+		{
+			OrVectorIntoDenseBits(psState, psSrcVector, pauDestBits, puDestWordCount);
+		}
+	}
+	else
+	{
+		if (bSrcDense)
+		{
+			OrDenseBitsIntoVector(psState, *pauSrcBits, *puSrcWordCount, psDestVector);
+		}
+		else
+		{
+			VectorOp(psState, USC_VEC_OR, psDestVector, psDestVector, psSrcVector);
+		}
+	}
+}
+
+static IMG_BOOL CompareLiveSetRegType(PINTERMEDIATE_STATE	psState,
+									  PREGISTER_LIVESET		psDest,
+									  PREGISTER_LIVESET		psSrc,
+									  IMG_UINT32			uType)
+/*********************************************************************************
+ Function			: CompareLiveSetRegType
+
+ Description		: Compare the live channels for a register type which can be held
+					  in packed form. Both sets must use the same form.
+
+ Parameters			: psState		- Compiler state
+					  psDest		- Sets to compare.
+					  psSrc
+					  uType			- USEASM_REGTYPE_TEMP or USEASM_REGTYPE_PREDICATE
+
+ Globals Effected	: None
+
+ Return				: TRUE if the live channels are the same.
+*********************************************************************************/
+{
+	IMG_PUINT32*	pauSrcBits;
+	IMG_PUINT32		puSrcWordCount;
+	USC_PVECTOR		psSrcVector;
+	IMG_PUINT32*	pauDestBits;
+	IMG_PUINT32		puDestWordCount;
+	USC_PVECTOR		psDestVector;
+	IMG_BOOL		bSrcDense, bDestDense;
+
+	bSrcDense = GetDenseLiveSetBits(psState, psSrc, uType, &pauSrcBits, &puSrcWordCount, &psSrcVector);
+	bDestDense = GetDenseLiveSetBits(psState, psDest, uType, &pauDestBits, &puDestWordCount, &psDestVector);
+	ASSERT(bSrcDense == bDestDense);
+
+	if (bDestDense)
+	{
+		IMG_UINT32	uCommonWordCount = min(*puSrcWordCount, *puDestWordCount);
+		IMG_UINT32	uWord;
+
+		if (memcmp(*pauSrcBits, *pauDestBits, uCommonWordCount * sizeof(IMG_UINT32)) != 0)
+		{
+			return IMG_FALSE;
+		}
+		/*
+			Dwords past the end of the shorter vector are implicitly zero.
+		*/
+		for (uWord = uCommonWordCount; uWord < *puSrcWordCount; uWord++)
+		{
+			if ((*pauSrcBits)[uWord] != 0)
+			{
+				return IMG_FALSE;
+			}
+		}
+		for (uWord = uCommonWordCount; uWord < *puDestWordCount; uWord++)
+		{
+			if ((*pauDestBits)[uWord] != 0)
+			{
+				return IMG_FALSE;
+			}
+		}
+		return IMG_TRUE;
+	}
+	else
+	{
+		USC_VECTOR	sTemp;
+
+		InitVector(&sTemp, USC_MIN_VECTOR_CHUNK, IMG_FALSE);
+		return (VectorOp(psState, USC_VEC_EQ, &sTemp, psDestVector, psSrcVector) != NULL) ? IMG_TRUE : IMG_FALSE;
+	}
+}
+
+static IMG_UINT32 GetLiveSetRange(PINTERMEDIATE_STATE	psState,
+								  PREGISTER_LIVESET		psLiveSet,
+								  IMG_UINT32			uType,
+								  IMG_UINT32			uEnd,
+								  IMG_UINT32			uStart)
+/*********************************************************************************
+ Function			: GetLiveSetRange
+
+ Description		: Get a range of (at most 32) bits from the live channels of a
+					  register type.
+
+ Parameters			: psState		- Compiler state
+					  psLiveSet		- Liveness set
+					  uType			- Register type: temporary, primary attribute,
+									output, internal register or predicate.
+					  uEnd			- Last bit in the range
+					  uStart		- First bit in the range
+
+ Globals Effected	: None
+
+ Return				: The bits in the range.
+*********************************************************************************/
+{
+	IMG_PUINT32*	pauBits;
+	IMG_PUINT32		puWordCount;
+	USC_PVECTOR		psVector;
+
+	switch (uType)
+	{
+		case USEASM_REGTYPE_TEMP:
+		case USEASM_REGTYPE_PREDICATE:
+		{
+			if (GetDenseLiveSetBits(psState, psLiveSet, uType, &pauBits, &puWordCount, &psVector))
+			{
+				if (uEnd >= *puWordCount * BITS_PER_UINT)
+				{
+					/*
+						Bits past the end of the vector are zero.
+					*/
+					if (uStart >= *puWordCount * BITS_PER_UINT)
+					{
+						return 0;
+					}
+					return GetRange(*pauBits, *puWordCount * BITS_PER_UINT - 1, uStart);
+				}
+				return GetRange(*pauBits, uEnd, uStart);
+			}
+			break;
+		}
+		case USEASM_REGTYPE_PRIMATTR: psVector = &psLiveSet->sPrimAttr; break;
+		case USEASM_REGTYPE_OUTPUT: psVector = &psLiveSet->sOutput; break;
+		case USEASM_REGTYPE_FPINTERNAL: psVector = &psLiveSet->sFpInternal; break;
+		default: imgabort();
+	}
+	return VectorGetRange(psState, psVector, uEnd, uStart);
+}
+
+/*
+	Ways of updating a range of bits in a liveness set.
+*/
+typedef enum _LIVESET_RANGE_OP_
+{
+	LIVESET_RANGE_SET,
+	LIVESET_RANGE_OR,
+	LIVESET_RANGE_AND
+} LIVESET_RANGE_OP;
+
+static IMG_VOID UpdateLiveSetRange(PINTERMEDIATE_STATE	psState,
+								   PREGISTER_LIVESET	psLiveSet,
+								   IMG_UINT32			uType,
+								   IMG_UINT32			uEnd,
+								   IMG_UINT32			uStart,
+								   LIVESET_RANGE_OP		eOp,
+								   IMG_UINT32			uData)
+/*********************************************************************************
+ Function			: UpdateLiveSetRange
+
+ Description		: Set, OR or AND a range of (at most 32) bits in the live channels
+					  of a register type.
+
+ Parameters			: psState		- Compiler state
+					  psLiveSet		- Liveness set
+					  uType			- Register type: temporary, primary attribute,
+									output, internal register or predicate.
+					  uEnd			- Last bit in the range
+					  uStart		- First bit in the range
+					  eOp			- Operation
+					  uData			- Data for the operation
+
+ Globals Effected	: None
+
+ Return				: Nothing.
+*********************************************************************************/
+{
+	IMG_PUINT32*	pauBits;
+	IMG_PUINT32		puWordCount;
+	USC_PVECTOR		psVector;
+
+	switch (uType)
+	{
+		case USEASM_REGTYPE_TEMP:
+		case USEASM_REGTYPE_PREDICATE:
+		{
+			if (GetDenseLiveSetBits(psState, psLiveSet, uType, &pauBits, &puWordCount, &psVector))
+			{
+				IMG_UINT32	uOld;
+				IMG_UINT32	uNew;
+
+				if (uEnd >= *puWordCount * BITS_PER_UINT)
+				{
+					/*
+						Clearing bits past the end of the vector does nothing.
+					*/
+					if (eOp == LIVESET_RANGE_AND || uData == 0)
+					{
+						if (uStart >= *puWordCount * BITS_PER_UINT)
+						{
+							return;
+						}
+					}
+					GrowDenseLiveSetBits(psState, pauBits, puWordCount, uEnd / BITS_PER_UINT + 1);
+				}
+
+				uOld = GetRange(*pauBits, uEnd, uStart);
+				switch (eOp)
+				{
+					case LIVESET_RANGE_SET: uNew = uData; break;
+					case LIVESET_RANGE_OR: uNew = uOld | uData; break;
+					case LIVESET_RANGE_AND: uNew = uOld & uData; break;
+					default: imgabort();
+				}
+				SetRange(*pauBits, uEnd, uStart, uNew);
+				return;
+			}
+			break;
+		}
+		case USEASM_REGTYPE_PRIMATTR: psVector = &psLiveSet->sPrimAttr; break;
+		case USEASM_REGTYPE_OUTPUT: psVector = &psLiveSet->sOutput; break;
+		case USEASM_REGTYPE_FPINTERNAL: psVector = &psLiveSet->sFpInternal; break;
+		default: imgabort();
+	}
+
+	switch (eOp)
+	{
+		case LIVESET_RANGE_SET: VectorSetRange(psState, psVector, uEnd, uStart, uData); break;
+		case LIVESET_RANGE_OR: VectorOrRange(psState, psVector, uEnd, uStart, uData); break;
+		case LIVESET_RANGE_AND: VectorAndRange(psState, psVector, uEnd, uStart, uData); break;
+		default: imgabort();
+	}
+}
+
 IMG_INTERNAL
 IMG_VOID ClearRegLiveSet(PINTERMEDIATE_STATE psState,
 						 PREGISTER_LIVESET psLiveSet)
@@ -123,6 +674,7 @@ IMG_VOID ClearRegLiveSet(PINTERMEDIATE_STATE psState,
 	ClearVector(psState, &psLiveSet->sPrimAttr);
 	ClearVector(psState, &psLiveSet->sTemp);
 	ClearVector(psState, &psLiveSet->sOutput);
+	FreeDenseLiveSet(psState, psLiveSet);
 }
 
 IMG_INTERNAL
@@ -150,6 +702,11 @@ IMG_VOID InitRegLiveSet(PREGISTER_LIVESET psLiveSet)
 	InitVector(&psLiveSet->sPrimAttr, USC_MIN_VECTOR_CHUNK, IMG_FALSE);
 	InitVector(&psLiveSet->sTemp, USC_MIN_VECTOR_CHUNK, IMG_FALSE);
 	InitVector(&psLiveSet->sOutput, USC_MIN_VECTOR_CHUNK, IMG_FALSE);
+
+	psLiveSet->auDenseTemp = NULL;
+	psLiveSet->uDenseTempWords = 0;
+	psLiveSet->auDensePredicate = NULL;
+	psLiveSet->uDensePredicateWords = 0;
 }
 
 IMG_INTERNAL
@@ -173,6 +730,7 @@ IMG_VOID FreeRegLiveSet(PINTERMEDIATE_STATE psState, PREGISTER_LIVESET psLiveSet
 	ClearVector(psState, &psLiveSet->sPrimAttr);
 	ClearVector(psState, &psLiveSet->sTemp);
 	ClearVector(psState, &psLiveSet->sOutput);
+	FreeDenseLiveSet(psState, psLiveSet);
 	UscFree(psState, psLiveSet);
 }
 
@@ -223,10 +781,10 @@ IMG_VOID CopyRegLiveSet(PINTERMEDIATE_STATE psState,
 	memcpy(psDst->puIndexReg, psSrc->puIndexReg, sizeof(psDst->puIndexReg));
 
 	VectorCopy(psState, &psSrc->sFpInternal, &psDst->sFpInternal);
-	VectorCopy(psState, &psSrc->sPredicate, &psDst->sPredicate);
 	VectorCopy(psState, &psSrc->sPrimAttr, &psDst->sPrimAttr);
-	VectorCopy(psState, &psSrc->sTemp, &psDst->sTemp);
 	VectorCopy(psState, &psSrc->sOutput, &psDst->sOutput);
+	CopyLiveSetRegType(psState, psSrc, psDst, USEASM_REGTYPE_PREDICATE);
+	CopyLiveSetRegType(psState, psSrc, psDst, USEASM_REGTYPE_TEMP);
 
 	psDst->bLinkReg = psSrc->bLinkReg;
 }
@@ -3526,9 +4084,7 @@ static IMG_VOID MergeLivesets(PINTERMEDIATE_STATE psState,
 *********************************************************************************/
 {
 	IMG_UINT32 i;
-	VectorOp(psState, USC_VEC_OR, 
-			 &psDest->sPredicate, 
-			 &psDest->sPredicate, &psSrc->sPredicate);
+	MergeLiveSetRegType(psState, psDest, psSrc, USEASM_REGTYPE_PREDICATE);
 	VectorOp(psState, USC_VEC_OR, 
 			 &psDest->sFpInternal, 
 			 &psDest->sFpInternal, &psSrc->sFpInternal);
@@ -3536,9 +4092,7 @@ static IMG_VOID MergeLivesets(PINTERMEDIATE_STATE psState,
 			 &psDest->sPrimAttr, 
 			 &psDest->sPrimAttr, &psSrc->sPrimAttr);
 
-	VectorOp(psState, USC_VEC_OR, 
-			 &psDest->sTemp, 
-			 &psDest->sTemp, &psSrc->sTemp);
+	MergeLiveSetRegType(psState, psDest, psSrc, USEASM_REGTYPE_TEMP);
 
 	VectorOp(psState, USC_VEC_OR, 
 			 &psDest->sOutput, 
@@ -3574,7 +4128,7 @@ static IMG_BOOL CompareLivesets(PINTERMEDIATE_STATE psState,
 
 	InitVector(&sTemp, USC_MIN_VECTOR_CHUNK, IMG_FALSE);
 
-	if (VectorOp(psState, USC_VEC_EQ, &sTemp, &psDest->sPredicate, &psSrc->sPredicate) == NULL)
+	if (!CompareLiveSetRegType(psState, psDest, psSrc, USEASM_REGTYPE_PREDICATE))
 	{	
 		return IMG_FALSE;
 	}
@@ -3586,7 +4140,7 @@ static IMG_BOOL CompareLivesets(PINTERMEDIATE_STATE psState,
 	{	
 		return IMG_FALSE;
 	}
-	if (VectorOp(psState, USC_VEC_EQ, &sTemp, &psDest->sTemp, &psSrc->sTemp) == NULL)
+	if (!CompareLiveSetRegType(psState, psDest, psSrc, USEASM_REGTYPE_TEMP))
 	{	
 		return IMG_FALSE;
 	}
@@ -3712,10 +4266,9 @@ static IMG_VOID SPrintLiveset(PINTERMEDIATE_STATE psState, PREGISTER_LIVESET psL
 
 static
 IMG_VOID TranslateArrayElement(PINTERMEDIATE_STATE	psState,
-							   PREGISTER_LIVESET	psLiveset,
 							   IMG_UINT32			uArrayNumber,
 							   IMG_UINT32			uArrayOffset,
-							   USC_PVECTOR*			ppsVector,
+							   IMG_PUINT32			puRegType,
 							   IMG_PUINT32			puStart)
 /*********************************************************************************
  Function			: TranslateArrayElement
@@ -3723,13 +4276,13 @@ IMG_VOID TranslateArrayElement(PINTERMEDIATE_STATE	psState,
  Description		: Gets the mask of live channels for a register.
  
  Parameters			: psState		- Internal compiler state
-					  psLiveset		- Register liveset.
 					  uArrayNumber	- Number of the array.
 					  uArrayOffset	- Offset within the array.
-					  ppsVector		- Returns the vector holding the mask
-									of channels live in this element.
-					  puStart		- Returns the start within the vector of the
-									mask of channels live in this element.
+					  puRegType		- Returns the type of the registers holding
+									the array.
+					  puStart		- Returns the start within the live channels
+									for that type of the mask of channels live in
+									this element.
 
  Globals Effected	: None
 
@@ -3755,9 +4308,13 @@ IMG_VOID TranslateArrayElement(PINTERMEDIATE_STATE	psState,
 	*/
 	switch (psArray->uRegType)
 	{
-		case USEASM_REGTYPE_TEMP: *ppsVector = &psLiveset->sTemp; break;
-		case USEASM_REGTYPE_PRIMATTR: *ppsVector = &psLiveset->sPrimAttr; break;
-		case USEASM_REGTYPE_OUTPUT: *ppsVector = &psLiveset->sOutput; break;
+		case USEASM_REGTYPE_TEMP:
+		case USEASM_REGTYPE_PRIMATTR:
+		case USEASM_REGTYPE_OUTPUT:
+		{
+			*puRegType = psArray->uRegType;
+			break;
+		}
 		default: imgabort();
 	}
 }
@@ -3787,32 +4344,15 @@ IMG_INTERNAL IMG_UINT32 GetRegisterLiveMask(PINTERMEDIATE_STATE psState,
 	switch (uType)
 	{
 		case USEASM_REGTYPE_TEMP: 
-		{
-			return VectorGetRange(psState, 
-								  &psLiveset->sTemp, 
-								  uStart + CHANS_PER_REGISTER - 1, 
-								  uStart);
-		}
 		case USEASM_REGTYPE_FPINTERNAL:
-		{
-			return VectorGetRange(psState, 
-								  &psLiveset->sFpInternal, 
-								  uStart + CHANS_PER_REGISTER - 1, 
-								  uStart);
-		}
 		case USEASM_REGTYPE_PRIMATTR:
-		{
-			return VectorGetRange(psState, 
-								  &psLiveset->sPrimAttr, 
-								  uStart + CHANS_PER_REGISTER - 1, 
-								  uStart);
-		}
 		case USEASM_REGTYPE_OUTPUT: 
 		{
-			return VectorGetRange(psState, 
-								  &psLiveset->sOutput, 
-								  uStart + CHANS_PER_REGISTER - 1, 
-								  uStart);
+			return GetLiveSetRange(psState, 
+								   psLiveset,
+								   uType,
+								   uStart + CHANS_PER_REGISTER - 1, 
+								   uStart);
 		}
 		case USEASM_REGTYPE_INDEX: 
 		{
@@ -3822,10 +4362,11 @@ IMG_INTERNAL IMG_UINT32 GetRegisterLiveMask(PINTERMEDIATE_STATE psState,
 		}
 		case USEASM_REGTYPE_PREDICATE:
 		{
-			if (VectorGetRange(psState, 
-							   &psLiveset->sPredicate, 
-							   uNumber, 
-							   uNumber) != 0)
+			if (GetLiveSetRange(psState, 
+								psLiveset,
+								USEASM_REGTYPE_PREDICATE,
+								uNumber, 
+								uNumber) != 0)
 			{
 				return USC_DESTMASK_FULL;
 			}
@@ -3836,13 +4377,14 @@ IMG_INTERNAL IMG_UINT32 GetRegisterLiveMask(PINTERMEDIATE_STATE psState,
 		}
 		case USC_REGTYPE_REGARRAY: 
 		{
-			USC_PVECTOR	psVector;
+			IMG_UINT32	uRegType;
 			IMG_UINT32	uStart_RegArray;
-			TranslateArrayElement(psState, psLiveset, uNumber, uArrayOffset, &psVector, &uStart_RegArray);
-			return VectorGetRange(psState,
-								  psVector,
-								  uStart_RegArray + CHANS_PER_REGISTER - 1,
-								  uStart_RegArray);
+			TranslateArrayElement(psState, uNumber, uArrayOffset, &uRegType, &uStart_RegArray);
+			return GetLiveSetRange(psState,
+								   psLiveset,
+								   uRegType,
+								   uStart_RegArray + CHANS_PER_REGISTER - 1,
+								   uStart_RegArray);
 		}
 		case USC_REGTYPE_UNUSEDDEST:
 		{
@@ -3892,50 +4434,28 @@ IMG_INTERNAL IMG_VOID SetRegisterLiveMask(PINTERMEDIATE_STATE psState,
 	switch (uType)
 	{
 		case USEASM_REGTYPE_TEMP: 
-		{
-			VectorSetRange(psState, &psLiveset->sTemp, 
-						   uStart + CHANS_PER_REGISTER - 1, uStart, uMask);
-			break;
-		}
 		case USEASM_REGTYPE_FPINTERNAL:
-		{
-			VectorSetRange(psState, &psLiveset->sFpInternal, 
-						   uStart + CHANS_PER_REGISTER - 1, uStart, uMask);
-			break;
-		}
 		case USEASM_REGTYPE_PRIMATTR:
-		{
-			VectorSetRange(psState, &psLiveset->sPrimAttr,
-						   uStart + CHANS_PER_REGISTER - 1, uStart, uMask);
-			break;
-		}
 		case USEASM_REGTYPE_OUTPUT:
 		{
-			VectorSetRange(psState, &psLiveset->sOutput,
-						   uStart + CHANS_PER_REGISTER - 1, uStart, uMask);
+			UpdateLiveSetRange(psState, psLiveset, uType, 
+							   uStart + CHANS_PER_REGISTER - 1, uStart, LIVESET_RANGE_SET, uMask);
 			break;
 		}
 		case USEASM_REGTYPE_PREDICATE:
 		{
-			if (uMask == 0)
-			{
-				VectorSetRange(psState, &psLiveset->sPredicate, 
-							   uNumber, uNumber, 0);
-			}
-			else
-			{
-				VectorSetRange(psState, &psLiveset->sPredicate,
-							   uNumber, uNumber, 1);
-			}
+			UpdateLiveSetRange(psState, psLiveset, USEASM_REGTYPE_PREDICATE, 
+							   uNumber, uNumber, LIVESET_RANGE_SET, (uMask == 0) ? 0 : 1);
 			break;
 		}
 		case USC_REGTYPE_REGARRAY: 
 		{
-			USC_PVECTOR		psVector;
+			IMG_UINT32		uRegType;
 			IMG_UINT32		uStart_RegArray;
 
-			TranslateArrayElement(psState, psLiveset, uNumber, uArrayOffset, &psVector, &uStart_RegArray);
-			VectorSetRange(psState, psVector, uStart_RegArray + CHANS_PER_REGISTER - 1, uStart_RegArray, uMask);
+			TranslateArrayElement(psState, uNumber, uArrayOffset, &uRegType, &uStart_RegArray);
+			UpdateLiveSetRange(psState, psLiveset, uRegType, 
+							   uStart_RegArray + CHANS_PER_REGISTER - 1, uStart_RegArray, LIVESET_RANGE_SET, uMask);
 			break;
 		}
 		case USEASM_REGTYPE_INDEX: 
@@ -3987,46 +4507,25 @@ static IMG_VOID ChangeRegisterLiveMask(PINTERMEDIATE_STATE psState,
 	IMG_UINT32 uStart = uNumber * CHANS_PER_REGISTER;
 	IMG_UINT32 uOldMask, uNewMask;
 	IMG_PUINT32 puArray = NULL;
-	USC_PVECTOR psVector = NULL;
+	IMG_UINT32 uLiveSetType = USC_UNDEF;
 
 	switch (uType)
 	{
 		case USEASM_REGTYPE_TEMP: 
-		{
-			psVector = &psLiveset->sTemp;
-			break;
-		}
 		case USEASM_REGTYPE_FPINTERNAL:
-		{
-			psVector = &psLiveset->sFpInternal;
-			break;
-		}
 		case USEASM_REGTYPE_PRIMATTR:
-		{
-			psVector = &psLiveset->sPrimAttr;
-			break;
-		}
 		case USEASM_REGTYPE_OUTPUT: 
 		{
-			psVector = &psLiveset->sOutput;
+			uLiveSetType = uType;
 			break;
 		}
 		case USEASM_REGTYPE_PREDICATE: 
 		{
 			ASSERT(uWrittenMask == 0 || uWrittenMask == USC_ALL_CHAN_MASK);
-			if (bSet)
+			if (uWrittenMask == USC_ALL_CHAN_MASK)
 			{
-				if (uWrittenMask == USC_ALL_CHAN_MASK)
-				{
-					VectorSetRange(psState, &psLiveset->sPredicate, uNumber, uNumber, 1);
-				}
-			}
-			else
-			{
-				if (uWrittenMask == USC_ALL_CHAN_MASK)
-				{
-					VectorSetRange(psState, &psLiveset->sPredicate, uNumber, uNumber, 0);
-				}
+				UpdateLiveSetRange(psState, psLiveset, USEASM_REGTYPE_PREDICATE, 
+								   uNumber, uNumber, LIVESET_RANGE_SET, bSet ? 1 : 0);
 			}
 			return;
 		}
@@ -4037,7 +4536,7 @@ static IMG_VOID ChangeRegisterLiveMask(PINTERMEDIATE_STATE psState,
 		}
 		case USC_REGTYPE_REGARRAY: 
 		{
-			TranslateArrayElement(psState, psLiveset, uNumber, uArrayOffset, &psVector, &uStart);
+			TranslateArrayElement(psState, uNumber, uArrayOffset, &uLiveSetType, &uStart);
 			break;
 		}
 		default:
@@ -4054,15 +4553,17 @@ static IMG_VOID ChangeRegisterLiveMask(PINTERMEDIATE_STATE psState,
 		SetRange(puArray, uStart + CHANS_PER_REGISTER - 1, uStart, uNewMask); 
 	}
 
-	if (psVector != NULL)
+	if (uLiveSetType != USC_UNDEF)
 	{
 		if (bSet)
 		{
-			VectorOrRange(psState, psVector, uStart + CHANS_PER_REGISTER - 1, uStart, uWrittenMask);
+			UpdateLiveSetRange(psState, psLiveset, uLiveSetType, 
+							   uStart + CHANS_PER_REGISTER - 1, uStart, LIVESET_RANGE_OR, uWrittenMask);
 		}
 		else
 		{
-			VectorAndRange(psState, psVector, uStart + CHANS_PER_REGISTER - 1, uStart, ~uWrittenMask);
+			UpdateLiveSetRange(psState, psLiveset, uLiveSetType, 
+							   uStart + CHANS_PER_REGISTER - 1, uStart, LIVESET_RANGE_AND, ~uWrittenMask);
 		}
 	}
 }
@@ -4203,7 +4704,6 @@ IMG_UINT32 GetIndexedRegisterLiveMask(PINTERMEDIATE_STATE	psState,
 									  PREGISTER_LIVESET		psLiveset,
 								      PARG					psDest)
 {
-	USC_PVECTOR	psVector;
 	IMG_UINT32	uBaseReg;
 	IMG_UINT32	uNumRegs;
 	IMG_UINT32	uIdx;
@@ -4215,12 +4715,7 @@ IMG_UINT32 GetIndexedRegisterLiveMask(PINTERMEDIATE_STATE	psState,
 	*/
 	GetIndexRangeForDest(psState, psDest, &uRealType, &uBaseReg, &uNumRegs);
 
-	switch (uRealType)
-	{
-		case USEASM_REGTYPE_TEMP:	psVector = &psLiveset->sTemp; break;
-		case USEASM_REGTYPE_OUTPUT:	psVector = &psLiveset->sOutput; break;
-		default: imgabort();
-	}
+	ASSERT(uRealType == USEASM_REGTYPE_TEMP || uRealType == USEASM_REGTYPE_OUTPUT);
 
 	/*
 		Take the union of the live channels in all the registers
@@ -4232,10 +4727,11 @@ IMG_UINT32 GetIndexedRegisterLiveMask(PINTERMEDIATE_STATE	psState,
 		IMG_UINT32		uChanIdx;
 
 		uChanIdx = (uBaseReg + uIdx) * CHANS_PER_REGISTER;
-		uLiveChansInDest |= VectorGetRange(psState, 
-										   psVector, 
-										   uChanIdx + CHANS_PER_REGISTER - 1, 
-										   uChanIdx);
+		uLiveChansInDest |= GetLiveSetRange(psState, 
+											psLiveset,
+											uRealType,
+											uChanIdx + CHANS_PER_REGISTER - 1, 
+											uChanIdx);
 		/*
 			Stop once we can't increase the mask anymore.
 		*/
@@ -5475,6 +5971,12 @@ typedef struct _LIVENESS_STATE_ {
 	IMG_BOOL bFuncEntirelyDead;
 	/* Array of register livesets to accumulate liveness at end of function */
 	PREGISTER_LIVESET asFuncEndRegs;
+	/*
+		If non-NULL, the working livesets are in packed form and this array (indexed by
+		block index) holds the registers live at the end of each block while the dataflow
+		runs; they are copied to sRegistersLiveOut once it has converged.
+	*/
+	PREGISTER_LIVESET asBlockLiveOut;
 } LIVENESS_STATE, *PLIVENESS_STATE;
 
 IMG_INTERNAL
@@ -5534,10 +6036,20 @@ Return	: whether the dataflow value (in pvLiveset) has changed.
 	PREGISTER_LIVESET* apSuccLiveIn = (PREGISTER_LIVESET*)pArgs;
 	PREGISTER_LIVESET psLiveset = (PREGISTER_LIVESET)pvLiveset;
 	PREGISTER_LIVESET psBackup = AllocRegLiveSet(psState);
+	PREGISTER_LIVESET psLiveOut;
 	IMG_UINT32 i;
 	PLIVENESS_STATE psLiveState = (PLIVENESS_STATE)pvLiveState;
 	IMG_BOOL bResult;
 	
+	if (psLiveState != NULL && psLiveState->asBlockLiveOut != NULL)
+	{
+		psLiveOut = &psLiveState->asBlockLiveOut[psBlock->uIdx];
+		MakeRegLiveSetDense(psState, psBackup);
+	}
+	else
+	{
+		psLiveOut = &psBlock->sRegistersLiveOut;
+	}
 	CopyRegLiveSet(psState, psLiveset, psBackup);
 #ifdef PRINT_LIVESETS
 {
@@ -5555,10 +6067,10 @@ Return	: whether the dataflow value (in pvLiveset) has changed.
 	//1. merge successor live-on-entry's into this block's live-on-exit
 	if (psBlock->uNumSuccs)
 	{
-		CopyRegLiveSet(psState, apSuccLiveIn[0], &psBlock->sRegistersLiveOut);
+		CopyRegLiveSet(psState, apSuccLiveIn[0], psLiveOut);
 		for (i=1; i < psBlock->uNumSuccs; i++)
 		{
-			MergeLivesets(psState, &psBlock->sRegistersLiveOut, apSuccLiveIn[i]);
+			MergeLivesets(psState, psLiveOut, apSuccLiveIn[i]);
 		}
 	}
 	else
@@ -5569,6 +6081,7 @@ Return	: whether the dataflow value (in pvLiveset) has changed.
 			Initial value starts off in sRegistersLiveOut (already),
 			and is never changed.
 		*/
+		psLiveOut = &psBlock->sRegistersLiveOut;
 	}
 	
 	//2. Copy the array of registers so we can work on them.
@@ -5576,7 +6089,7 @@ Return	: whether the dataflow value (in pvLiveset) has changed.
 		We'll use our result space as temporary storage,
 		into which the result is gradually computed
 	*/
-	CopyRegLiveSet(psState, &psBlock->sRegistersLiveOut, psLiveset);
+	CopyRegLiveSet(psState, psLiveOut, psLiveset);
 #ifdef PRINT_LIVESETS
 {
 	printf("Computed merge at bottom of block %i as ", psBlock->uIdx);
@@ -5638,6 +6151,10 @@ Return	: whether the dataflow value (in pvLiveset) has changed.
 
 		//backup the state at the end of the call...
 		psBackupCall = AllocRegLiveSet(psState);
+		if (psLiveState->asBlockLiveOut != NULL)
+		{
+			MakeRegLiveSetDense(psState, psBackupCall);
+		}
 		CopyRegLiveSet(psState, psLiveset, psBackupCall);
 
 		bNoUsedInsts = 
@@ -5766,10 +6283,26 @@ static IMG_BOOL DoLiveness(PINTERMEDIATE_STATE psState, PREGISTER_LIVESET asFunc
 
 	sLiveState.bFuncEntirelyDead = IMG_TRUE; //unless we find a live instr somewhere
 	sLiveState.asFuncEndRegs = asFuncEndRegs;
+	sLiveState.asBlockLiveOut = NULL;
 
 	for (i = 0; i < psFunc->sCfg.uNumBlocks; i++)
 		InitRegLiveSet(&asLivesets[i]);
 
+	/*
+		With many registers the sparse vectors are slow to merge and compare on every
+		visit to a block, so iterate on packed bit vectors instead.
+	*/
+	if (psState->uNumRegisters >= USC_DENSE_LIVESET_MIN_TEMPS)
+	{
+		sLiveState.asBlockLiveOut = UscAlloc(psState, sizeof(sLiveState.asBlockLiveOut[0]) * psFunc->sCfg.uNumBlocks);
+		for (i = 0; i < psFunc->sCfg.uNumBlocks; i++)
+		{
+			MakeRegLiveSetDense(psState, &asLivesets[i]);
+			InitRegLiveSet(&sLiveState.asBlockLiveOut[i]);
+			MakeRegLiveSetDense(psState, &sLiveState.asBlockLiveOut[i]);
+		}
+	}
+
 	//setup "initial" value for live out of exit (never overwritten)
 	CopyRegLiveSet(psState, psLiveset, &psFunc->sCfg.psExit->sRegistersLiveOut);
 
@@ -5779,6 +6312,21 @@ static IMG_BOOL DoLiveness(PINTERMEDIATE_STATE psState, PREGISTER_LIVESET asFunc
 	//update psLiveset with liveness at entry to CFG
 	CopyRegLiveSet(psState, &asLivesets[psFunc->sCfg.psEntry->uIdx], psLiveset);
 
+	if (sLiveState.asBlockLiveOut != NULL)
+	{
+		for (i = 0; i < psFunc->sCfg.uNumBlocks; i++)
+		{
+			PCODEBLOCK psBlock = psFunc->sCfg.apsAllBlocks[i];
+
+			if (psBlock->uNumSuccs > 0)
+			{
+				CopyRegLiveSet(psState, &sLiveState.asBlockLiveOut[i], &psBlock->sRegistersLiveOut);
+			}
+			ClearRegLiveSet(psState, &sLiveState.asBlockLiveOut[i]);
+		}
+		UscFree(psState, sLiveState.asBlockLiveOut);
+	}
+
 	for (i = 0; i < psFunc->sCfg.uNumBlocks; i++)
 		ClearRegLiveSet(psState, &asLivesets[i]);
 	UscFree(psState, asLivesets);
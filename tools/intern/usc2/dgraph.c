@@ -25,38 +25,72 @@
 /*
 	The type of ELEMENTS of the USC_PARRAYs "psRUsers" in a DGRAPH_STATE
 	(for R = Temp, PA, Output, Pred, IReg). That is, for reg #x of that type,
-	psRUsers[x] is a PINT_LIST, where
-		the first element is the index of the last instr to write the register
-			(-1, or the entire list null, for no write seen so far);
-		any subsequent elements are indices of instructions reading the register
-			(usually _since_ the last write, except for alpha-splitting on PAs).
+	psRUsers[x] is a PREG_USERS, where
+		uWriter is the index of the last instr to write the register
+			(UINT_MAX, or the entire structure null, for no write seen so far);
+		auReaders[0..uReaderCount-1] are the indices of instructions reading
+			the register (usually _since_ the last write, except for
+			alpha-splitting on PAs) in the order the reads were recorded.
+	The reader array is kept when the readers are cleared so a register which
+	is repeatedly written and read doesn't go back to the allocator.
 */
-typedef struct _INT_LIST_
+typedef struct _REG_USERS_
 {
-	IMG_UINT32 uInst;
-	struct _INT_LIST_ *psNext;
-} INT_LIST, *PINT_LIST;
+	IMG_UINT32	uWriter;
+	IMG_UINT32	uReaderCount;
+	IMG_UINT32	uMaxReaderCount;
+	IMG_PUINT32	auReaders;
+} REG_USERS, *PREG_USERS;
 
-static IMG_VOID FreeIntList(PINTERMEDIATE_STATE psState, PINT_LIST *ppsIntList)
+static IMG_VOID FreeRegUsers(PINTERMEDIATE_STATE psState, PREG_USERS *ppsUsers)
 /******************************************************************************
- FUNCTION	: FreeIntList
+ FUNCTION	: FreeRegUsers
  
- PURPOSE	: Frees up an INT_LIST structure; castable to USC_STATE_FREEFN
+ PURPOSE	: Frees up a REG_USERS structure; castable to USC_STATE_FREEFN
 			  so can be passed to ClearArray
 
  PARAMETERS	: psState		- Compiler intermediate state
-			  ppsIntList	- identifies pointer to structure to free
+			  ppsUsers		- identifies pointer to structure to free
 
- RETURNS	: Nothing, but sets (*ppsIntList) to NULL.
+ RETURNS	: Nothing, but sets (*ppsUsers) to NULL.
 ******************************************************************************/
 {
-	PINT_LIST psElem, psNext;
-	for (psElem = *ppsIntList; psElem; psElem = psNext)
+	PREG_USERS psUsers = *ppsUsers;
+
+	if (psUsers != NULL)
 	{
-		psNext = psElem->psNext;
-		UscFree(psState, psElem);
+		if (psUsers->auReaders != NULL)
+		{
+			UscFree(psState, psUsers->auReaders);
+		}
+		UscFree(psState, psUsers);
 	}
-	*ppsIntList = NULL;
+	*ppsUsers = NULL;
+}
+
+static PREG_USERS NewRegUsers(PINTERMEDIATE_STATE psState, USC_PARRAY psUserArray, IMG_UINT32 uReg)
+/******************************************************************************
+ FUNCTION	: NewRegUsers
+ 
+ PURPOSE	: Creates the (empty) usage info for a register seen for the first
+			  time in the block.
+
+ PARAMETERS	: psState		- Compiler intermediate state
+			  psUserArray	- Array storing usage info for all regs of type
+			  uReg			- Number of register (of that type)
+
+ RETURNS	: The new usage info.
+******************************************************************************/
+{
+	PREG_USERS psUsers = UscAlloc(psState, sizeof(REG_USERS));
+
+	psUsers->uWriter = UINT_MAX;
+	psUsers->uReaderCount = 0;
+	psUsers->uMaxReaderCount = 0;
+	psUsers->auReaders = NULL;
+	ArraySet(psState, psUserArray, uReg, psUsers);
+
+	return psUsers;
 }
 
 IMG_INTERNAL
@@ -180,17 +214,17 @@ IMG_VOID FreeDGraphState(PINTERMEDIATE_STATE psState,
 	FreeArray(psState, &psDGraph->psSatDepCount);
 
 	/* Register writers */
-	ClearArray(psState, psDGraph->psTempUsers, (USC_STATE_FREEFN)FreeIntList);
+	ClearArray(psState, psDGraph->psTempUsers, (USC_STATE_FREEFN)FreeRegUsers);
 	FreeArray(psState, &psDGraph->psTempUsers);
-	ClearArray(psState, psDGraph->psPAUsers, (USC_STATE_FREEFN)FreeIntList);
+	ClearArray(psState, psDGraph->psPAUsers, (USC_STATE_FREEFN)FreeRegUsers);
 	FreeArray(psState, &psDGraph->psPAUsers);
-	ClearArray(psState, psDGraph->psOutputUsers, (USC_STATE_FREEFN)FreeIntList);
+	ClearArray(psState, psDGraph->psOutputUsers, (USC_STATE_FREEFN)FreeRegUsers);
 	FreeArray(psState, &psDGraph->psOutputUsers);
-	ClearArray(psState, psDGraph->psIRegUsers, (USC_STATE_FREEFN)FreeIntList);
+	ClearArray(psState, psDGraph->psIRegUsers, (USC_STATE_FREEFN)FreeRegUsers);
 	FreeArray(psState, &psDGraph->psIRegUsers);
-	ClearArray(psState, psDGraph->psIndexUsers, (USC_STATE_FREEFN)FreeIntList);
+	ClearArray(psState, psDGraph->psIndexUsers, (USC_STATE_FREEFN)FreeRegUsers);
 	FreeArray(psState, &psDGraph->psIndexUsers);
-	ClearArray(psState, psDGraph->psPredUsers, (USC_STATE_FREEFN)FreeIntList);
+	ClearArray(psState, psDGraph->psPredUsers, (USC_STATE_FREEFN)FreeRegUsers);
 	FreeArray(psState, &psDGraph->psPredUsers);
 	if (psDGraph->apsRegArrayLastWriter != NULL)
 	{
@@ -440,13 +474,13 @@ IMG_VOID AddClosedDependency(PINTERMEDIATE_STATE psState, PDGRAPH_STATE	psDepSta
 }
 
 static IMG_VOID FindReaders(PDGRAPH_STATE	psDepState, 
-							PINT_LIST		psUsers,
+							PREG_USERS		psUsers,
 							IMG_UINT32		uInst,
 							IMG_BOOL		bClearReaders)
 /******************************************************************************
  FUNCTION		: FindReaders
 
- DESCRIPTION	: Adds dependencies from all readers in an INT_LIST to an inst
+ DESCRIPTION	: Adds dependencies from all readers of a register to an inst
 
  PARAMETERS		: psDepState	- Dependency graph state
 				  psUsers		- Instructions reading/writing some register
@@ -458,16 +492,19 @@ static IMG_VOID FindReaders(PDGRAPH_STATE	psDepState,
 ******************************************************************************/
 {
 	PINTERMEDIATE_STATE psState = psDepState->psState;
-	PINT_LIST psReaders;
+	IMG_UINT32 uReader;
 
 	ASSERT(psUsers);
 
-	//first element of psUsers is prev writer, so skip. Later elems are readers
-	for (psReaders = psUsers->psNext; psReaders; psReaders = psReaders->psNext)
+	//most recent reader first, to add the dependencies in the same order as
+	//they have always been added
+	for (uReader = psUsers->uReaderCount; uReader-- > 0; )
 	{
-		if (psReaders->uInst != uInst) //instruction might have read reg itself
+		IMG_UINT32 uReaderInst = psUsers->auReaders[uReader];
+
+		if (uReaderInst != uInst) //instruction might have read reg itself
 		{
-			AddDependency(psDepState, psReaders->uInst, uInst);
+			AddDependency(psDepState, uReaderInst, uInst);
 		}
 	}
 	
@@ -477,12 +514,12 @@ static IMG_VOID FindReaders(PDGRAPH_STATE	psDepState,
 			Instruction writes (entire) reg;
 			so ensure we won't make deps from earlier readers to any later writers
 		*/
-		if (psUsers->uInst != UINT_MAX)
+		if (psUsers->uWriter != UINT_MAX)
 		{
 			/* add dependency on previous writer */
-			AddDependency(psDepState, psUsers->uInst, uInst);
+			AddDependency(psDepState, psUsers->uWriter, uInst);
 		}
-		FreeIntList(psState, &psUsers->psNext);
+		psUsers->uReaderCount = 0;
 	}
 }
 
@@ -645,7 +682,10 @@ IMG_VOID InsertInAvailableList(PDGRAPH_STATE	psDepState,
 	PINTERMEDIATE_STATE psState = psDepState->psState;
 
 	/*
-		Sort the list by instruction index.
+		Sort the list by instruction index. GetNextAvailable's callers walk
+		the list in this order, so it can't become a heap; the list only
+		holds the instructions ready at this point, which is a handful even
+		for very large blocks, so the walk is short.
 	*/
 	for (psEntry = psDepState->sAvailableList.psHead; psEntry != NULL; psEntry = psEntry->psNext)
 	{
@@ -957,15 +997,26 @@ IMG_VOID MergeInstructions(PDGRAPH_STATE psDepState,
 				GraphSet(psState, psDepState->psClosedDepGraph, uInst, uSrcInst, IMG_FALSE);	
 			}
 		}
+	}
 
-		/*
-			If the source instruction is dependent on this instruction then
-			make the destination instruction dependent on this instruction.
-		*/
-		if (GraphGet(psState, psDepState->psDepGraph, uSrcInst, uInst))
+	/*
+		For each instruction the source instruction is dependent on make the
+		destination instruction dependent on it. Only the set bits in the source
+		instruction's row of the dependency graph need to be visited.
+	*/
+	psSrcVec = NULL;
+	GraphColRef(psState, psDepState->psDepGraph, uSrcInst, &psSrcVec);
+	if (psSrcVec != NULL)
+	{
+		VECTOR_ITERATOR	sVecIter;
+
+		for (VectorIteratorInitialize(psState, psSrcVec, 1, &sVecIter);
+			 VectorIteratorContinue(&sVecIter);
+			 VectorIteratorNext(&sVecIter))
 		{
 			PADJACENCY_LIST	psList;
 
+			uInst = VectorIteratorCurrentPosition(&sVecIter);
 			psList = (PADJACENCY_LIST)ArrayGet(psState, psDepState->psDepList, uInst);
 	
 			if (uInst != uDestInst && !GraphGet(psState, psDepState->psDepGraph, uDestInst, uInst))
@@ -1208,35 +1259,71 @@ IMG_VOID ComputeClosedDependencyGraph(PDGRAPH_STATE psDepState, IMG_BOOL bUnorde
  Globals Effected	: None
 
  Return				: Nothing.
+
+ Notes				: The closure is built in a flat array of bitvector rows,
+					  one per instruction, so each step combines a whole row a
+					  word at a time rather than one GraphGet/GraphSet per bit.
+					  The rows are copied into the closed graph at the end.
 *********************************************************************************/
 {
 	PINTERMEDIATE_STATE psState = psDepState->psState;
-
-	IMG_UINT32	uInst, uDepInst;
-	USC_PVECTOR	psSrcVec;
+	const IMG_UINT32	uInstCount = psDepState->uBlockInstructionCount;
+	const IMG_UINT32	uRowSize = UINTS_TO_SPAN_BITS(uInstCount);
+	IMG_PUINT32			auClosed;
+	IMG_UINT32			uInst, uDepInst, uWord;
 
 	ClearGraph(psState, psDepState->psClosedDepGraph);
 
+	if (uInstCount == 0)
+	{
+		return;
+	}
+
 	/* Start with the non-transitive dependencies. */
-	GraphCopy(psState, psDepState->psDepGraph, psDepState->psClosedDepGraph);
+	auClosed = UscAlloc(psState, uInstCount * uRowSize * sizeof(IMG_UINT32));
+	memset(auClosed, 0, uInstCount * uRowSize * sizeof(IMG_UINT32));
+	for (uInst = 0; uInst < uInstCount; uInst++)
+	{
+		USC_PVECTOR		psRow = NULL;
+		VECTOR_ITERATOR	sIter;
+
+		GraphColRef(psState, psDepState->psDepGraph, uInst, &psRow);
+		if (psRow == NULL)
+		{
+			continue;
+		}
+		for (VectorIteratorInitialize(psState, psRow, BITS_PER_UINT, &sIter);
+			 VectorIteratorContinue(&sIter);
+			 VectorIteratorNext(&sIter))
+		{
+			uWord = VectorIteratorCurrentPosition(&sIter) / BITS_PER_UINT;
+
+			ASSERT(uWord < uRowSize);
+			auClosed[uInst * uRowSize + uWord] = VectorIteratorCurrentMask(&sIter);
+		}
+	}
 
 	if (bUnorderedDeps)
 	{
-		IMG_UINT32	uInst1, uInst2, uInst3;
+		IMG_UINT32	uInst1, uInst2;
 
-		for (uInst1 = 0; uInst1 < psDepState->uBlockInstructionCount; uInst1++)
+		/*
+			Anything depending on uInst1 also depends on everything uInst1
+			depends on.
+		*/
+		for (uInst1 = 0; uInst1 < uInstCount; uInst1++)
 		{
-			for (uInst2 = 0; uInst2 < psDepState->uBlockInstructionCount; uInst2++)
+			const IMG_UINT32 *auRow1 = auClosed + uInst1 * uRowSize;
+
+			for (uInst2 = 0; uInst2 < uInstCount; uInst2++)
 			{
-				for (uInst3 = 0; uInst3 < psDepState->uBlockInstructionCount; uInst3++)
+				IMG_PUINT32 auRow2 = auClosed + uInst2 * uRowSize;
+
+				if (uInst2 != uInst1 && GetBit(auRow2, uInst1))
 				{
-					if (!GraphGet(psState, psDepState->psClosedDepGraph, uInst2, uInst3))
+					for (uWord = 0; uWord < uRowSize; uWord++)
 					{
-						if (GraphGet(psState, psDepState->psClosedDepGraph, uInst2, uInst1) &&
-							GraphGet(psState, psDepState->psClosedDepGraph, uInst1, uInst3))
-						{
-							GraphSet(psState, psDepState->psClosedDepGraph, uInst2, uInst3, IMG_TRUE);
-						}
+						auRow2[uWord] |= auRow1[uWord];
 					}
 				}
 			}
@@ -1244,23 +1331,51 @@ IMG_VOID ComputeClosedDependencyGraph(PDGRAPH_STATE psDepState, IMG_BOOL bUnorde
 	}
 	else
 	{
-		for (uInst = 0; uInst < psDepState->uBlockInstructionCount; uInst++)
+		for (uInst = 0; uInst < uInstCount; uInst++)
 		{
+			const IMG_UINT32		*auSrcRow = auClosed + uInst * uRowSize;
 			PADJACENCY_LIST			psList;
 			ADJACENCY_LIST_ITERATOR	sIterState;
 
-			psSrcVec = NULL;
-			GraphColRef(psState, psDepState->psClosedDepGraph, uInst, &psSrcVec);
-
 			psList = (PADJACENCY_LIST)ArrayGet(psState, psDepState->psDepList, uInst);
 			for (uDepInst = FirstAdjacent(psList, &sIterState); 
 				!IsLastAdjacent(&sIterState); 
 				uDepInst = NextAdjacent(&sIterState))
 			{
-				GraphOrCol(psState, psDepState->psClosedDepGraph, uDepInst, psSrcVec);
+				IMG_PUINT32 auDestRow = auClosed + uDepInst * uRowSize;
+
+				for (uWord = 0; uWord < uRowSize; uWord++)
+				{
+					auDestRow[uWord] |= auSrcRow[uWord];
+				}
+			}
+		}
+	}
+
+	/*
+		Copy the non-empty rows into the closed graph.
+	*/
+	for (uInst = 0; uInst < uInstCount; uInst++)
+	{
+		const IMG_UINT32	*auRow = auClosed + uInst * uRowSize;
+		USC_PVECTOR			psRow = NULL;
+
+		for (uWord = 0; uWord < uRowSize; uWord++)
+		{
+			if (auRow[uWord] == 0)
+			{
+				continue;
+			}
+			if (psRow == NULL)
+			{
+				GraphSet(psState, psDepState->psClosedDepGraph, uInst, uWord * BITS_PER_UINT, IMG_TRUE);
+				GraphColRef(psState, psDepState->psClosedDepGraph, uInst, &psRow);
 			}
+			VectorSetRange(psState, psRow, uWord * BITS_PER_UINT + BITS_PER_UINT - 1, uWord * BITS_PER_UINT, auRow[uWord]);
 		}
 	}
+
+	UscFree(psState, auClosed);
 }
 
 IMG_INTERNAL 
@@ -1311,8 +1426,8 @@ static IMG_VOID RecordWrite(PDGRAPH_STATE psDepState,
 /******************************************************************************
  FUNCTION	: RecordWrite
 
- PURPOSE	: Records a write to a register whose usage info is stored (as an
-			  INT_LIST) in an element of a USC_PARRAY (i.e. a <psRUsers> in an
+ PURPOSE	: Records a write to a register whose usage info is stored (as a
+			  REG_USERS) in an element of a USC_PARRAY (i.e. a <psRUsers> in an
 			  PCOMPUTE_DGRAPH_STATE). 
 
  PARAMETERS	: psDepState	- Dependency Graph state
@@ -1325,7 +1440,7 @@ static IMG_VOID RecordWrite(PDGRAPH_STATE psDepState,
 ******************************************************************************/
 {
 	const PINTERMEDIATE_STATE psState = psDepState->psState;
-	PINT_LIST psUsers = (PINT_LIST)ArrayGet(psState, psUserArray, uReg);
+	PREG_USERS psUsers = (PREG_USERS)ArrayGet(psState, psUserArray, uReg);
 	if (psUsers)
 	{
 		FindReaders(psDepState, psUsers, uInst, IMG_TRUE /* bClearReaders */);
@@ -1333,11 +1448,9 @@ static IMG_VOID RecordWrite(PDGRAPH_STATE psDepState,
 	else
 	{
 		//no previous reads or writes in block
-		psUsers = UscAlloc(psState, sizeof(INT_LIST));
-		psUsers->psNext = NULL;
-		ArraySet(psState, psUserArray, uReg, psUsers);
+		psUsers = NewRegUsers(psState, psUserArray, uReg);
 	}
-	psUsers->uInst = uInst;
+	psUsers->uWriter = uInst;
 }
 
 static IMG_VOID AddDestDependencies(PDGRAPH_STATE psDepState, 
@@ -1459,7 +1572,7 @@ static IMG_VOID RecordRead(PDGRAPH_STATE	psDepState,
  FUNCTION		: RecordRead
 
  DESCRIPTION	: Records a read of a register whose usage info is stored (as
-				  an INT_LIST) in an element of a USC_PARRAY.
+				  a REG_USERS) in an element of a USC_PARRAY.
 
  PARAMETERS		: psDepState	- Dependency Graph state
 				  uInst			- Index of reading instruction
@@ -1472,28 +1585,29 @@ static IMG_VOID RecordRead(PDGRAPH_STATE	psDepState,
 ******************************************************************************/
 {
 	const PINTERMEDIATE_STATE psState = psDepState->psState;
-	PINT_LIST	psUsers		= (PINT_LIST)ArrayGet(psState, psUserArray, uReg),
-				psThisRead	= UscAlloc(psState, sizeof(INT_LIST));
-	psThisRead->uInst = uInst;
+	PREG_USERS	psUsers = (PREG_USERS)ArrayGet(psState, psUserArray, uReg);
 
 	if (psUsers)
 	{
-		//first element is the write, if any (might have been in earlier block)
-		if (psUsers->uInst != UINT_MAX)
+		//the write, if any (might have been in earlier block)
+		if (psUsers->uWriter != UINT_MAX)
 		{
-			AddDependency(psDepState, psUsers->uInst, uInst);
+			AddDependency(psDepState, psUsers->uWriter, uInst);
 		}
 	}
 	else
 	{
-		psUsers = UscAlloc(psState, sizeof(INT_LIST));
-		psUsers->uInst = UINT_MAX;
-		psUsers->psNext = NULL;
-		ArraySet(psState, psUserArray, uReg, psUsers);
+		psUsers = NewRegUsers(psState, psUserArray, uReg);
+	}
+
+	if (psUsers->uReaderCount == psUsers->uMaxReaderCount)
+	{
+		IMG_UINT32 uNewMaxReaderCount = max(psUsers->uMaxReaderCount * 2, 4U);
+
+		ResizeTypedArray(psState, psUsers->auReaders, psUsers->uMaxReaderCount, uNewMaxReaderCount);
+		psUsers->uMaxReaderCount = uNewMaxReaderCount;
 	}
-	//insert after write and before other readers
-	psThisRead->psNext = psUsers->psNext;
-	psUsers->psNext = psThisRead;
+	psUsers->auReaders[psUsers->uReaderCount++] = uInst;
 }
 
 static IMG_VOID RecordReadsByArg(PDGRAPH_STATE	psDepState,
@@ -1898,12 +2012,12 @@ PDGRAPH_STATE ComputeDependencyGraph(PINTERMEDIATE_STATE psState,
 	psDepState->uAvailInstCount = psDepState->uBlockInstructionCount;
 	psDepState->uRemovedInstCount = 0;
 	
-	ClearArray(psState, psDepState->psTempUsers, (USC_STATE_FREEFN)FreeIntList);
-	ClearArray(psState, psDepState->psOutputUsers, (USC_STATE_FREEFN)FreeIntList);
-	ClearArray(psState, psDepState->psPAUsers, (USC_STATE_FREEFN)FreeIntList);
-	ClearArray(psState, psDepState->psPredUsers, (USC_STATE_FREEFN)FreeIntList);
-	ClearArray(psState, psDepState->psIRegUsers, (USC_STATE_FREEFN)FreeIntList);
-	ClearArray(psState, psDepState->psIndexUsers, (USC_STATE_FREEFN)FreeIntList);
+	ClearArray(psState, psDepState->psTempUsers, (USC_STATE_FREEFN)FreeRegUsers);
+	ClearArray(psState, psDepState->psOutputUsers, (USC_STATE_FREEFN)FreeRegUsers);
+	ClearArray(psState, psDepState->psPAUsers, (USC_STATE_FREEFN)FreeRegUsers);
+	ClearArray(psState, psDepState->psPredUsers, (USC_STATE_FREEFN)FreeRegUsers);
+	ClearArray(psState, psDepState->psIRegUsers, (USC_STATE_FREEFN)FreeRegUsers);
+	ClearArray(psState, psDepState->psIndexUsers, (USC_STATE_FREEFN)FreeRegUsers);
 	if (psDepState->apsRegArrayLastWriter != NULL)
 	{
 		for (uIdx = 0; uIdx < psState->uNumVecArrayRegs; uIdx++)
@@ -1964,15 +2078,15 @@ PDGRAPH_STATE ComputeDependencyGraph(PINTERMEDIATE_STATE psState,
 
 			for (uIRegNum = 0; uIRegNum < psState->uGPISizeInScalarRegs; uIRegNum++)
 			{
-				PINT_LIST psUsers = (PINT_LIST)ArrayGet(psState,
-														psDepState->psIRegUsers,
-														uIRegNum);
+				PREG_USERS psUsers = (PREG_USERS)ArrayGet(psState,
+														  psDepState->psIRegUsers,
+														  uIRegNum);
 				if (psUsers)
 				{
 					//make dependent on previous writer also
-					if (psUsers->uInst != UINT_MAX)
+					if (psUsers->uWriter != UINT_MAX)
 					{
-						AddDependency(psDepState, psUsers->uInst, uInst);
+						AddDependency(psDepState, psUsers->uWriter, uInst);
 					}
 					FindReaders(psDepState,
 								psUsers,
@@ -2071,38 +2185,151 @@ PDGRAPH_STATE ComputeDependencyGraph(PINTERMEDIATE_STATE psState,
 	return psDepState;
 }
 
+/*
+	Last writer of each register while GenerateInstructionDAG scans a block
+	forwards. Elements are 1 + the index in the block of the last instruction
+	to write any channel of the register, or 0 if no earlier instruction in
+	the block writes it.
+*/
+typedef struct _DAG_LAST_WRITERS_
+{
+	USC_PARRAY	psTemp;
+	USC_PARRAY	psOutput;
+	USC_PARRAY	psPrimAttr;
+	USC_PARRAY	psIndex;
+	USC_PARRAY	psInternal;
+	USC_PARRAY	psPredicate;
+} DAG_LAST_WRITERS, *PDAG_LAST_WRITERS;
+
 static
-PINST FindLastWriterInstOfArgument(PINTERMEDIATE_STATE psState, PINST psPoint, PARG psArgToFind)
+USC_PARRAY GetLastWriterArray(PDAG_LAST_WRITERS psWriters, IMG_UINT32 uRegType)
 /*********************************************************************************
- Function			: FindLastWriterInstOfArgument
+ Function			: GetLastWriterArray
 
- Description		: Finds last writer instruction for given argument
+ Description		: Gets the array of last writers for a register type.
  
- Parameters			: psDepState	- Dependency graph state
-					  psPoint		- Search start from.
+ Parameters			: psWriters		- Last writers.
+					  uRegType		- Register type.
 
-  Return			: Instruction
+  Return			: The array, or NULL for register types which are not
+					  recorded in a use/def record.
 *********************************************************************************/
 {
-	PINST			psFindDefInst;
-	USEDEF_RECORD	sLocalUseDefRec;
-	PUSEDEF_RECORD	psLocalUseDefRec = &sLocalUseDefRec;
-	
-	InitUseDef(psLocalUseDefRec);
-	ClearUseDef(psState, psLocalUseDefRec);
-	for(psFindDefInst = psPoint->psPrev; psFindDefInst; psFindDefInst = psFindDefInst->psPrev)
+	switch (uRegType)
 	{
-		/* Calculate register def */
-		InstDef(psState, psFindDefInst, &psLocalUseDefRec->sDef);
-		
-		if(GetRegUseDef(psState, &psLocalUseDefRec->sDef, psArgToFind->uType, psArgToFind->uNumber))
+		case USEASM_REGTYPE_TEMP:		return psWriters->psTemp;
+		case USEASM_REGTYPE_OUTPUT:		return psWriters->psOutput;
+		case USEASM_REGTYPE_PRIMATTR:	return psWriters->psPrimAttr;
+		case USEASM_REGTYPE_INDEX:		return psWriters->psIndex;
+		case USEASM_REGTYPE_FPINTERNAL:	return psWriters->psInternal;
+		case USEASM_REGTYPE_PREDICATE:	return psWriters->psPredicate;
+		default:						return NULL;
+	}
+}
+
+static
+IMG_UINT32 GetLastWriter(PINTERMEDIATE_STATE	psState,
+						 PDAG_LAST_WRITERS		psWriters,
+						 IMG_UINT32				uRegType,
+						 IMG_UINT32				uRegNum)
+/*********************************************************************************
+ Function			: GetLastWriter
+
+ Description		: Finds the last instruction so far to write a register,
+					  matching what GetRegUseDef would find in the definitions
+					  of the instructions scanned so far.
+ 
+ Parameters			: psState		- Compiler state.
+					  psWriters		- Last writers.
+					  uRegType		- Register type.
+					  uRegNum		- Register number (array number for
+									  USC_REGTYPE_REGARRAY).
+
+  Return			: 1 + the index of the writer, or 0 if there isn't one.
+*********************************************************************************/
+{
+	USC_PARRAY	psWriterArray;
+
+	if (uRegType == USC_REGTYPE_REGARRAY)
+	{
+		PUSC_VEC_ARRAY_REG	psArray;
+		IMG_UINT32			uIdx;
+		IMG_UINT32			uLastWriter = 0;
+
+		/* A write to any register in the array counts */
+		ASSERT(uRegNum < psState->uNumVecArrayRegs);
+		psArray = psState->apsVecArrayReg[uRegNum];
+		for (uIdx = 0; uIdx < psArray->uRegs; uIdx++)
 		{
-			ClearUseDef(psState, psLocalUseDefRec);
-			return psFindDefInst;
+			uLastWriter = max(uLastWriter, 
+							  GetLastWriter(psState, psWriters, psArray->uRegType, psArray->uBaseReg + uIdx));
 		}
+		return uLastWriter;
 	}
-	ClearUseDef(psState, psLocalUseDefRec);
-	return IMG_NULL;
+
+	psWriterArray = GetLastWriterArray(psWriters, uRegType);
+	if (psWriterArray == NULL)
+	{
+		return 0;
+	}
+	return (IMG_UINT32)(IMG_UINTPTR_T)ArrayGet(psState, psWriterArray, uRegNum);
+}
+
+static
+IMG_VOID SetLastWriters(PINTERMEDIATE_STATE	psState,
+						USC_PARRAY			psWriterArray,
+						USC_PVECTOR			psDef,
+						IMG_UINT32			uBitsPerReg,
+						IMG_UINT32			uWriter)
+/*********************************************************************************
+ Function			: SetLastWriters
+
+ Description		: Records an instruction as the last writer of every register
+					  set in a definition bit vector.
+ 
+ Parameters			: psState		- Compiler state.
+					  psWriterArray	- Last writers of the register type.
+					  psDef			- Registers (or channels) defined.
+					  uBitsPerReg	- Bits in psDef for each register.
+					  uWriter		- 1 + the index of the instruction.
+
+  Return			: Nothing.
+*********************************************************************************/
+{
+	VECTOR_ITERATOR	sIter;
+
+	for (VectorIteratorInitialize(psState, psDef, uBitsPerReg, &sIter);
+		 VectorIteratorContinue(&sIter);
+		 VectorIteratorNext(&sIter))
+	{
+		ArraySet(psState, 
+				 psWriterArray, 
+				 VectorIteratorCurrentPosition(&sIter) / uBitsPerReg, 
+				 (IMG_PVOID)(IMG_UINTPTR_T)uWriter);
+	}
+}
+
+static
+IMG_UINT32 GetDAGLookupCount(PINST psInst, IMG_UINT32 uFlags)
+/*********************************************************************************
+ Function			: GetDAGLookupCount
+
+ Description		: Gets the number of registers GenerateInstructionDAG looks up
+					  the writer of for an instruction.
+ 
+ Parameters			: psInst		- Instruction.
+					  uFlags		- DEP_GRAPH_COMPUTE_xxx flags.
+
+  Return			: The number of registers.
+*********************************************************************************/
+{
+	IMG_UINT32	uCount = psInst->uArgumentCount;
+
+	if (psInst->apsOldDest && (uFlags & DEP_GRAPH_COMPUTE_COLLECT_OLD_DEST) != 0)
+	{
+		uCount += psInst->uDestCount;
+	}
+	return uCount;
 }
 
 //#define ICODE_DEP_DUMP
@@ -2196,26 +2423,115 @@ IMG_VOID GenerateInstructionDAG(PINTERMEDIATE_STATE psState, PCODEBLOCK psBlock,
 					  psBlock		- Block to be freed DAG data
 
   Return			: Nothing
+
+ Notes				: The writers of the registers each instruction reads are
+					  found in one forward scan, keeping the last writer of each
+					  register, and stored in compressed rows (auLookupStart[x] is
+					  the first entry for instruction x). The relations are then
+					  added from the last instruction backwards, in the order the
+					  DAG users expect.
 *********************************************************************************/
 {
 	IMG_UINT32			uArgInd;
-	PINST				psCurrent, psEndInst, psFindDefInst;
+	IMG_UINT32			uInst, uInstCount, uLookup, uLookupCount, uWriter;
+	PINST				psCurrent;
+	PINST*				apsInsts;
+	PINST*				apsWriters;
+	IMG_PUINT32			auLookupStart;
 	PARG				psArgToFind;
+	DAG_LAST_WRITERS	sWriters;
 	
 	USEDEF_RECORD	sLocalUseDefRec;
 	PUSEDEF_RECORD	psLocalUseDefRec = &sLocalUseDefRec;
+
+	uInstCount = uLookupCount = 0;
+	for (psCurrent = psBlock->psBody; psCurrent != NULL; psCurrent = psCurrent->psNext)
+	{
+		uInstCount++;
+		uLookupCount += GetDAGLookupCount(psCurrent, uFlags);
+	}
+	if (uInstCount == 0)
+	{
+		return;
+	}
+
+	apsInsts = UscAlloc(psState, uInstCount * sizeof(apsInsts[0]));
+	auLookupStart = UscAlloc(psState, (uInstCount + 1) * sizeof(auLookupStart[0]));
+	apsWriters = UscAlloc(psState, max(uLookupCount, 1U) * sizeof(apsWriters[0]));
+
+	sWriters.psTemp = NewArray(psState, USC_MIN_ARRAY_CHUNK, (IMG_PVOID)0, sizeof(IMG_UINT32));
+	sWriters.psOutput = NewArray(psState, USC_MIN_ARRAY_CHUNK, (IMG_PVOID)0, sizeof(IMG_UINT32));
+	sWriters.psPrimAttr = NewArray(psState, USC_MIN_ARRAY_CHUNK, (IMG_PVOID)0, sizeof(IMG_UINT32));
+	sWriters.psIndex = NewArray(psState, USC_MIN_ARRAY_CHUNK, (IMG_PVOID)0, sizeof(IMG_UINT32));
+	sWriters.psInternal = NewArray(psState, USC_MIN_ARRAY_CHUNK, (IMG_PVOID)0, sizeof(IMG_UINT32));
+	sWriters.psPredicate = NewArray(psState, USC_MIN_ARRAY_CHUNK, (IMG_PVOID)0, sizeof(IMG_UINT32));
 	
 	InitUseDef(psLocalUseDefRec);
-	
-	psEndInst = psBlock->psBodyTail;
+
+	/* Find the last writer of each register read, before the reading instruction */
+	for (psCurrent = psBlock->psBody, uInst = 0, uLookup = 0; 
+		 psCurrent != NULL; 
+		 psCurrent = psCurrent->psNext, uInst++)
+	{
+		const IMG_UINT32	uLookupEnd = uLookup + GetDAGLookupCount(psCurrent, uFlags);
+
+		apsInsts[uInst] = psCurrent;
+		auLookupStart[uInst] = uLookup;
+
+		if (psCurrent->apsOldDest && (uFlags & DEP_GRAPH_COMPUTE_COLLECT_OLD_DEST) != 0)
+		{
+			IMG_UINT32 uDstIdx;
+
+			/* instructions writing to partially writen destination */
+			for (uDstIdx = 0; uDstIdx < psCurrent->uDestCount; uDstIdx++, uLookup++)
+			{
+				uWriter = 0;
+				if (psCurrent->apsOldDest[uDstIdx])
+				{
+					psArgToFind = psCurrent->apsOldDest[uDstIdx];
+					uWriter = GetLastWriter(psState, &sWriters, psArgToFind->uType, psArgToFind->uNumber);
+				}
+				apsWriters[uLookup] = (uWriter != 0) ? apsInsts[uWriter - 1] : NULL;
+			}
+		}
+		for (uArgInd = 0; uArgInd < psCurrent->uArgumentCount; uArgInd++, uLookup++)
+		{
+			psArgToFind = &psCurrent->asArg[uArgInd];
+			uWriter = GetLastWriter(psState, &sWriters, psArgToFind->uType, psArgToFind->uNumber);
+			apsWriters[uLookup] = (uWriter != 0) ? apsInsts[uWriter - 1] : NULL;
+		}
+		ASSERT(uLookup == uLookupEnd);
+
+		/* Calculate register def */
+		ClearUseDef(psState, psLocalUseDefRec);
+		InstDef(psState, psCurrent, &psLocalUseDefRec->sDef);
+
+		SetLastWriters(psState, sWriters.psTemp, &psLocalUseDefRec->sDef.sTemp.sChans, CHANS_PER_REGISTER, uInst + 1);
+		SetLastWriters(psState, sWriters.psOutput, &psLocalUseDefRec->sDef.sOutput.sChans, CHANS_PER_REGISTER, uInst + 1);
+		SetLastWriters(psState, sWriters.psPrimAttr, &psLocalUseDefRec->sDef.sPrimAttr.sChans, CHANS_PER_REGISTER, uInst + 1);
+		SetLastWriters(psState, sWriters.psIndex, &psLocalUseDefRec->sDef.sIndex.sChans, CHANS_PER_REGISTER, uInst + 1);
+		SetLastWriters(psState, sWriters.psInternal, &psLocalUseDefRec->sDef.sInternal.sChans, CHANS_PER_REGISTER, uInst + 1);
+		SetLastWriters(psState, sWriters.psPredicate, &psLocalUseDefRec->sDef.sPredicate, 1, uInst + 1);
+	}
+	auLookupStart[uInstCount] = uLookup;
+	ClearUseDef(psState, psLocalUseDefRec);
+
+	FreeArray(psState, &sWriters.psTemp);
+	FreeArray(psState, &sWriters.psOutput);
+	FreeArray(psState, &sWriters.psPrimAttr);
+	FreeArray(psState, &sWriters.psIndex);
+	FreeArray(psState, &sWriters.psInternal);
+	FreeArray(psState, &sWriters.psPredicate);
 	
 #if defined(ICODE_DEP_DUMP)
 	fprintf(stderr, "\n");
 #endif
 	
 	/* Scan for usages by past instructions */
-	for(psCurrent = psEndInst; psCurrent != NULL; psCurrent = psCurrent->psPrev)
+	for (uInst = uInstCount; uInst-- > 0; )
 	{
+		psCurrent = apsInsts[uInst];
+		uLookup = auLookupStart[uInst];
 #if defined(ICODE_DEP_DUMP)
 		fprintf(stderr, "DEP(%02d) %02d %s -> ", psBlock->uGlobalIdx, 
 							psCurrent->uBlockIndex, g_psInstDesc[psCurrent->eOpcode].pszName);
@@ -2224,36 +2540,32 @@ IMG_VOID GenerateInstructionDAG(PINTERMEDIATE_STATE psState, PCODEBLOCK psBlock,
 		{
 			IMG_UINT32 uDstIdx;
 			
-			/* instructions writing to partially writen destination */
-			for(uDstIdx = 0; uDstIdx < psCurrent->uDestCount; uDstIdx++)
+			for(uDstIdx = 0; uDstIdx < psCurrent->uDestCount; uDstIdx++, uLookup++)
 			{
-				if(psCurrent->apsOldDest[uDstIdx])
+				if(apsWriters[uLookup])
 				{
-					psArgToFind = psCurrent->apsOldDest[uDstIdx];
-					psFindDefInst = FindLastWriterInstOfArgument(psState, psCurrent, psArgToFind);
-					if(psFindDefInst)
-					{
-						AddRelationDAG(psState, psFindDefInst, psCurrent, psArgToFind, uFlags);
-					}
+					AddRelationDAG(psState, apsWriters[uLookup], psCurrent, psCurrent->apsOldDest[uDstIdx], uFlags);
 				}
 			}
 		}
 		
-		/* See if any argument of psCurrent is defined/written by psFindDefInst */
-		for(uArgInd = 0; uArgInd < psCurrent->uArgumentCount; uArgInd++)
+		/* See if any argument of psCurrent is defined/written by an earlier instruction */
+		for(uArgInd = 0; uArgInd < psCurrent->uArgumentCount; uArgInd++, uLookup++)
 		{
-			psArgToFind = &psCurrent->asArg[uArgInd];
-			psFindDefInst = FindLastWriterInstOfArgument(psState, psCurrent, psArgToFind);
-			if(psFindDefInst)
+			if(apsWriters[uLookup])
 			{
-				AddRelationDAG(psState, psFindDefInst, psCurrent, psArgToFind, uFlags);
+				AddRelationDAG(psState, apsWriters[uLookup], psCurrent, &psCurrent->asArg[uArgInd], uFlags);
 			}
 		}
+		ASSERT(uLookup == auLookupStart[uInst + 1]);
 #if defined(ICODE_DEP_DUMP)
 		fprintf(stderr, "\n");
 #endif
 	}
-	ClearUseDef(psState, psLocalUseDefRec);
+
+	UscFree(psState, apsInsts);
+	UscFree(psState, auLookupStart);
+	UscFree(psState, apsWriters);
 	
 	TESTONLY(VerifyDAG(psState, psBlock));
 }
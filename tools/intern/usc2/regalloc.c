@@ -334,6 +334,26 @@ typedef struct _RAGCOL_STATE_
 	*/
     USC_VECTOR				sNodesUsedInSpills;
 
+	/*
+	  Bit vector. The bit corresponding to a node is set if the node
+	  holds a spilled register reloaded once for a loop or a run of
+	  nearby uses. Such nodes are spilled at every reference if they
+	  can't be coloured.
+	*/
+	USC_VECTOR				sRegionReloads;
+
+	/*
+		TRUE if the loop nesting of the blocks being spilled is known, so
+		spill reloads can be moved out of loops.
+	*/
+	IMG_BOOL				bSpillLoopInfo;
+
+	/*
+		For each block (indexed by uGlobalIdx) the maximum number of registers
+		live at once, found while constructing the interference graph.
+	*/
+	IMG_PUINT32				auBlockMaxLive;
+
 	/*
 		List of nodes which couldn't be coloured.
 	*/
@@ -1815,6 +1835,11 @@ static IMG_VOID FreeRAGColState(PINTERMEDIATE_STATE psState,
 	if (bFreeState)
     {
         ClearVector(psState, &psRegState->sNodesUsedInSpills);
+        ClearVector(psState, &psRegState->sRegionReloads);
+		if (psRegState->auBlockMaxLive != NULL)
+		{
+			UscFree(psState, psRegState->auBlockMaxLive);
+		}
         UscFree(psState, *ppsRegState);
     }
 }
@@ -1843,6 +1868,8 @@ static IMG_VOID AllocateRAGColState(PINTERMEDIATE_STATE psState,
 		psRegState = *ppsRegState;
 
 		InitVector(&psRegState->sNodesUsedInSpills, USC_MIN_VECTOR_CHUNK, IMG_FALSE);
+		InitVector(&psRegState->sRegionReloads, USC_MIN_VECTOR_CHUNK, IMG_FALSE);
+		psRegState->auBlockMaxLive = NULL;
 	}
 	else
 	{
@@ -5473,6 +5500,7 @@ static IMG_VOID ConstructInterferenceGraphBP(PINTERMEDIATE_STATE	psState,
 	PINTFGRAPH_CONTEXT psContext = (PINTFGRAPH_CONTEXT)pvContext;
 	PRAGCOL_STATE psRegState = psContext->psRegState;
 	PLIVE_SET psLiveSet = &psContext->sLiveSet;
+	IMG_UINT32 uMaxLive;
 
 	/*
 		Clear the set of currently live registers.
@@ -5522,6 +5550,7 @@ static IMG_VOID ConstructInterferenceGraphBP(PINTERMEDIATE_STATE	psState,
 		/*
 		   Move backwards through the block constructing an interference graph.
 		*/
+		uMaxLive = psLiveSet->psLiveList->uMemberCount;
 		for (psInst = psCodeBlock->psBodyTail; psInst; psInst = psInst->psPrev)
 		{
 			ConstructInterferenceGraphForInst(psState,
@@ -5529,8 +5558,13 @@ static IMG_VOID ConstructInterferenceGraphBP(PINTERMEDIATE_STATE	psState,
 											  psInst,
 											  psLiveSet,
 											  bPostSplitBlock);
+			uMaxLive = max(uMaxLive, psLiveSet->psLiveList->uMemberCount);
 		}
 	}
+
+	/* Record the register pressure in the block for choosing how to spill. */
+	ASSERT(psCodeBlock->uGlobalIdx < psState->uGlobalBlockCount);
+	psRegState->auBlockMaxLive[psCodeBlock->uGlobalIdx] = uMaxLive;
 }
 
 static IMG_VOID ClearConflictingReservations(PRAGCOL_STATE	psRegState,
@@ -7604,6 +7638,797 @@ IMG_VOID SpillRegisterGroup(PINTERMEDIATE_STATE	psState,
 	}
 }
 
+/*
+	Largest distance (in instructions) between two uses of a spilled register
+	in the same block which can share one reload from memory.
+*/
+#define SPILL_REGION_MAX_USE_DISTANCE		(4)
+
+/*
+	Estimated executions of a block for each execution of the program are
+	SPILL_LOOP_FREQUENCY raised to the loop nesting depth of the block.
+*/
+#define SPILL_LOOP_FREQUENCY				(8)
+#define SPILL_MAX_LOOP_DEPTH				(4)
+
+static
+IMG_VOID ComputeSpillLoopInfo(PINTERMEDIATE_STATE	psState,
+							  PRAGCOL_STATE			psRegState)
+/*****************************************************************************
+ FUNCTION     : ComputeSpillLoopInfo
+
+ PURPOSE      : Find the loop nesting of the blocks in the function group being
+				allocated, if the dominator information is still up to date.
+
+ PARAMETERS	  : psState			- Compiler state.
+                psRegState		- Register allocator state.
+
+ RETURNS	  : Nothing.
+*****************************************************************************/
+{
+	PFUNC	psFunc;
+
+	psRegState->bSpillLoopInfo = IMG_FALSE;
+
+	if (psRegState->sRAData.eFuncGroup == FUNCGROUP_SECONDARY)
+	{
+		return;
+	}
+
+	for (psFunc = psState->psFnInnermost; psFunc; psFunc = psFunc->psFnNestOuter)
+	{
+		if (psFunc != psState->psSecAttrProg && psFunc->sCfg.bBlockStructureChanged)
+		{
+			return;
+		}
+	}
+	for (psFunc = psState->psFnInnermost; psFunc; psFunc = psFunc->psFnNestOuter)
+	{
+		if (psFunc != psState->psSecAttrProg)
+		{
+			ComputeLoopNestingTree(psState, psFunc->sCfg.psEntry);
+		}
+	}
+
+	psRegState->bSpillLoopInfo = IMG_TRUE;
+}
+
+static
+IMG_UINT32 GetSpillBlockFrequency(PRAGCOL_STATE psRegState, PCODEBLOCK psBlock)
+/*****************************************************************************
+ FUNCTION     : GetSpillBlockFrequency
+
+ PURPOSE      : Estimate how often a block is executed relative to the
+				program entry.
+
+ PARAMETERS	  : psRegState		- Register allocator state.
+				psBlock			- Block to estimate for.
+
+ RETURNS	  : The estimated frequency.
+*****************************************************************************/
+{
+	IMG_UINT32	uDepth;
+	IMG_UINT32	uFrequency;
+
+	if (!psRegState->bSpillLoopInfo)
+	{
+		return 1;
+	}
+
+	uDepth = min(LoopDepth(psBlock), SPILL_MAX_LOOP_DEPTH);
+	for (uFrequency = 1; uDepth > 0; uDepth--)
+	{
+		uFrequency *= SPILL_LOOP_FREQUENCY;
+	}
+	return uFrequency;
+}
+
+static
+IMG_BOOL IsBlockInSpillLoop(PCODEBLOCK psBlock, PCODEBLOCK psHeader)
+/*****************************************************************************
+ FUNCTION     : IsBlockInSpillLoop
+
+ PURPOSE      : Check if a block is part of a loop or of a loop nested in it.
+
+ PARAMETERS	  : psBlock			- Block to check.
+				psHeader		- Header of the loop.
+
+ RETURNS	  : TRUE if the block is in the loop.
+*****************************************************************************/
+{
+	for (; psBlock != NULL; psBlock = psBlock->psLoopHeader)
+	{
+		if (psBlock == psHeader)
+		{
+			return IMG_TRUE;
+		}
+	}
+	return IMG_FALSE;
+}
+
+static
+IMG_BOOL IsRegionReloadBlock(PINTERMEDIATE_STATE psState, PCODEBLOCK psBlock)
+/*****************************************************************************
+ FUNCTION     : IsRegionReloadBlock
+
+ PURPOSE      : Check if a reloaded register can be live across a block.
+
+ PARAMETERS	  : psState			- Compiler state.
+				psBlock			- Block to check.
+
+ RETURNS	  : TRUE if the block can be part of a reload region.
+*****************************************************************************/
+{
+	if (IsCall(psState, psBlock) || IsNonMergable(psState, psBlock))
+	{
+		return IMG_FALSE;
+	}
+	if (psBlock == psState->psPreSplitBlock || psBlock == psState->psPreFeedbackBlock)
+	{
+		return IMG_FALSE;
+	}
+	return IMG_TRUE;
+}
+
+static
+IMG_BOOL IsRegionLowPressure(PINTERMEDIATE_STATE	psState,
+							 PRAGCOL_STATE			psRegState,
+							 PCODEBLOCK				psBlock,
+							 IMG_UINT32				uExtraRegs)
+/*****************************************************************************
+ FUNCTION     : IsRegionLowPressure
+
+ PURPOSE      : Check if a spilled register reloaded for a region including a
+				block is likely to be coloured there.
+
+ PARAMETERS	  : psState			- Compiler state.
+				psRegState		- Register allocator state.
+				psBlock			- Block to check.
+				uExtraRegs		- Registers which will be live across all of
+								the block in addition.
+
+ RETURNS	  : TRUE if every register live in the block could be given a
+				temporary or primary attribute.
+*****************************************************************************/
+{
+	IMG_UINT32	uAvailRegs;
+
+	PVR_UNREFERENCED_PARAMETER(psState);
+	ASSERT(psBlock->uGlobalIdx < psState->uGlobalBlockCount);
+
+	uAvailRegs = psRegState->sRAData.auAvailRegsPerType[COLOUR_TYPE_TEMP] +
+				 psRegState->sRAData.auAvailRegsPerType[COLOUR_TYPE_PRIMATTR];
+	return ((psRegState->auBlockMaxLive[psBlock->uGlobalIdx] + uExtraRegs) <= uAvailRegs) ? IMG_TRUE : IMG_FALSE;
+}
+
+/*
+	A reference to a register in a group being spilled.
+*/
+typedef struct _REGION_SPILL_REF
+{
+	PUSEDEF			psUseDef;
+	PINST			psInst;
+	/* Index of the referenced register in the group. */
+	IMG_UINT32		uMember;
+	/* TRUE if the instruction only reads the group and can read a reloaded copy. */
+	IMG_BOOL		bCanReload;
+	/* TRUE if the reference has been replaced by a reloaded copy. */
+	IMG_BOOL		bReloaded;
+} REGION_SPILL_REF, *PREGION_SPILL_REF;
+
+static
+IMG_VOID CheckRegionReloadInst(PINTERMEDIATE_STATE	psState,
+							   PREGION_SPILL_REF	asRefs,
+							   IMG_UINT32			uFirstRef,
+							   IMG_UINT32			uRefCount)
+/*****************************************************************************
+ FUNCTION     : CheckRegionReloadInst
+
+ PURPOSE      : Check if an instruction can read copies of the registers in a
+				spilled group reloaded before an earlier instruction.
+
+ PARAMETERS	  : psState			- Compiler state.
+				asRefs			- References to the group.
+				uFirstRef		- First reference in the instruction.
+				uRefCount		- Count of references in the instruction.
+
+ RETURNS	  : Nothing.
+*****************************************************************************/
+{
+	PINST					psInst = asRefs[uFirstRef].psInst;
+	REGISTER_GROUPS_DESC	sGroups;
+	IMG_UINT32				uSrcMask;
+	IMG_UINT32				uGroup;
+	IMG_UINT32				uRef;
+	IMG_BOOL				bCanReload;
+
+	/*
+		Only instructions which just read the registers can share a reload.
+	*/
+	bCanReload = IMG_TRUE;
+	uSrcMask = 0;
+	for (uRef = uFirstRef; uRef < (uFirstRef + uRefCount); uRef++)
+	{
+		PUSEDEF	psUseDef = asRefs[uRef].psUseDef;
+
+		if (psUseDef->eType != USE_TYPE_SRC || psUseDef->uLocation >= 32)
+		{
+			bCanReload = IMG_FALSE;
+			break;
+		}
+		uSrcMask |= (1U << psUseDef->uLocation);
+	}
+
+	/*
+		The reloaded registers are given the same restrictions on their hardware
+		register numbers as the sources they replace so each set of sources which
+		needs consecutive register numbers must be entirely replaced.
+	*/
+	if (bCanReload)
+	{
+		GetSourceRegisterGroups(psState, psInst, &sGroups);
+		for (uGroup = 0; uGroup < sGroups.uCount; uGroup++)
+		{
+			PREGISTER_GROUP_DESC	psGroupDesc = &sGroups.asGroups[uGroup];
+			IMG_UINT32				uGroupArgMask;
+
+			uGroupArgMask = ((1U << psGroupDesc->uCount) - 1U) << psGroupDesc->uStart;
+			if ((uSrcMask & uGroupArgMask) != 0 && (uSrcMask & uGroupArgMask) != uGroupArgMask)
+			{
+				bCanReload = IMG_FALSE;
+				break;
+			}
+		}
+	}
+
+	for (uRef = uFirstRef; uRef < (uFirstRef + uRefCount); uRef++)
+	{
+		asRefs[uRef].bCanReload = bCanReload;
+	}
+}
+
+static
+IMG_BOOL IsRegionReloadRef(PREGION_SPILL_REF psRef, UF_REGFORMAT eFmt)
+/*****************************************************************************
+ FUNCTION     : IsRegionReloadRef
+
+ PURPOSE      : Check if a reference can read a reloaded copy of the same
+				format as the rest of a region.
+
+ PARAMETERS	  : psRef			- Reference to check.
+				eFmt			- Format of the reloaded copies.
+
+ RETURNS	  : TRUE if the reference can share the reload.
+*****************************************************************************/
+{
+	if (!psRef->bCanReload || psRef->bReloaded)
+	{
+		return IMG_FALSE;
+	}
+	return (psRef->psInst->asArg[psRef->psUseDef->uLocation].eFmt == eFmt) ? IMG_TRUE : IMG_FALSE;
+}
+
+static
+PCODEBLOCK GetSpillLoopPreheader(PINTERMEDIATE_STATE	psState,
+								 PRAGCOL_STATE			psRegState,
+								 PCODEBLOCK				psHeader,
+								 IMG_UINT32				uMemberCount,
+								 PREGION_SPILL_REF		asRefs,
+								 IMG_UINT32				uRefCount,
+								 UF_REGFORMAT			eFmt)
+/*****************************************************************************
+ FUNCTION     : GetSpillLoopPreheader
+
+ PURPOSE      : Check if a spilled group can be reloaded once before a loop and
+				kept in registers for all of the loop.
+
+ PARAMETERS	  : psState			- Compiler state.
+				psRegState		- Register allocator state.
+				psHeader		- Header of the loop.
+				uMemberCount	- Count of registers in the spilled group.
+				asRefs			- References to the spilled group.
+				uRefCount		- Count of references.
+				eFmt			- Format of the reloaded registers.
+
+ RETURNS	  : The block before the loop to reload in, or NULL if the loop
+				isn't suitable.
+*****************************************************************************/
+{
+	PCFG		psCfg = psHeader->psOwner;
+	PCODEBLOCK	psPreheader;
+	IMG_UINT32	uIdx;
+
+	/*
+		Only reload in a block which always runs just before the loop.
+	*/
+	psPreheader = NULL;
+	for (uIdx = 0; uIdx < psHeader->uNumPreds; uIdx++)
+	{
+		PCODEBLOCK	psPred = psHeader->asPreds[uIdx].psDest;
+
+		if (!IsBlockInSpillLoop(psPred, psHeader))
+		{
+			if (psPreheader != NULL)
+			{
+				return NULL;
+			}
+			psPreheader = psPred;
+		}
+	}
+	if (psPreheader == NULL || psPreheader->uNumSuccs != 1 || !IsRegionReloadBlock(psState, psPreheader))
+	{
+		return NULL;
+	}
+
+	for (uIdx = 0; uIdx < psCfg->uNumBlocks; uIdx++)
+	{
+		PCODEBLOCK	psBlock = psCfg->apsAllBlocks[uIdx];
+
+		if (IsBlockInSpillLoop(psBlock, psHeader) &&
+			(!IsRegionReloadBlock(psState, psBlock) || !IsRegionLowPressure(psState, psRegState, psBlock, uMemberCount)))
+		{
+			return NULL;
+		}
+	}
+
+	/*
+		The group mustn't be written inside the loop.
+	*/
+	for (uIdx = 0; uIdx < uRefCount; uIdx++)
+	{
+		if (IsBlockInSpillLoop(asRefs[uIdx].psInst->psBlock, psHeader) &&
+			!IsRegionReloadRef(&asRefs[uIdx], eFmt))
+		{
+			return NULL;
+		}
+	}
+	return psPreheader;
+}
+
+static
+IMG_VOID ReloadSpilledGroupForRegion(PINTERMEDIATE_STATE	psState,
+									 PRAGCOL_STATE			psRegState,
+									 PUSEDEF_CHAIN*			apsMembers,
+									 IMG_UINT32				uMemberCount,
+									 PREGION_SPILL_REF		asRefs,
+									 IMG_UINT32				uFirstRef,
+									 IMG_UINT32				uLastRef,
+									 PCODEBLOCK				psHeader,
+									 PCODEBLOCK				psLoadBlock,
+									 PINST					psInsertBeforeInst,
+									 UF_REGFORMAT			eFmt)
+/*****************************************************************************
+ FUNCTION     : ReloadSpilledGroupForRegion
+
+ PURPOSE      : Replace the uses of a spilled group in a region of the program
+				by new registers loaded from memory once before the region.
+
+ PARAMETERS	  : psState			- Compiler state.
+                psRegState		- Register allocator state.
+				apsMembers		- Registers in the group.
+				uMemberCount	- Count of registers in the group.
+				asRefs			- References to the group.
+				uFirstRef, uLastRef
+								- Range of references to replace.
+				psHeader		- If not NULL only replace references inside
+								the loop with this header.
+				psLoadBlock		- Block to insert the loads in.
+				psInsertBeforeInst
+								- Instruction to insert the loads before or
+								NULL to insert at the end of the block.
+				eFmt			- Format of the reloaded registers.
+
+ RETURNS	  : Nothing.
+*****************************************************************************/
+{
+	PARG		asReloadTemp;
+	IMG_PUINT32	auLiveChans;
+	PINST		psFlagsInst;
+	PINST		psFirstLoadInst, psLastLoadInst;
+	IMG_UINT32	uMember;
+	IMG_UINT32	uIdx;
+
+	asReloadTemp = UscAlloc(psState, sizeof(asReloadTemp[0]) * uMemberCount);
+	auLiveChans = UscAlloc(psState, sizeof(auLiveChans[0]) * uMemberCount);
+	for (uMember = 0; uMember < uMemberCount; uMember++)
+	{
+		InitInstArg(&asReloadTemp[uMember]);
+		asReloadTemp[uMember].uNumber = USC_UNDEF;
+		auLiveChans[uMember] = 0;
+	}
+
+	psFlagsInst = NULL;
+	for (uIdx = uFirstRef; uIdx <= uLastRef; uIdx++)
+	{
+		PREGION_SPILL_REF	psRef = &asRefs[uIdx];
+		PINST				psInst = psRef->psInst;
+		PARG				psReloadTemp = &asReloadTemp[psRef->uMember];
+
+		if (psRef->bReloaded || (psHeader != NULL && !IsBlockInSpillLoop(psInst->psBlock, psHeader)))
+		{
+			continue;
+		}
+
+		/*
+			The loads have to run for invalid instances if any of the instructions
+			using them does.
+		*/
+		if (psFlagsInst == NULL ||
+			(GetBit(psFlagsInst->auFlag, INST_SKIPINV) && !RequiresGradients(psFlagsInst) &&
+			 (!GetBit(psInst->auFlag, INST_SKIPINV) || RequiresGradients(psInst))))
+		{
+			psFlagsInst = psInst;
+		}
+
+		if (psReloadTemp->uNumber == USC_UNDEF)
+		{
+			MakeNewTempArg(psState, eFmt, psReloadTemp);
+			VectorSet(psState, &psRegState->sRegionReloads, psReloadTemp->uNumber, 1);
+		}
+
+		auLiveChans[psRef->uMember] |= GetLiveChansInArg(psState, psInst, psRef->psUseDef->uLocation);
+
+		UseDefSubstUse(psState, apsMembers[psRef->uMember], psRef->psUseDef, psReloadTemp);
+		psRef->bReloaded = IMG_TRUE;
+
+		/*
+			Once all the references in an instruction have been replaced give the
+			reloaded registers the same restrictions on their hardware register
+			numbers as the registers they replace.
+		*/
+		if (uIdx == uLastRef || asRefs[uIdx + 1].psInst != psInst)
+		{
+			REGISTER_GROUPS_DESC	sGroups;
+			IMG_UINT32				uGroup;
+
+			GetSourceRegisterGroups(psState, psInst, &sGroups);
+			for (uGroup = 0; uGroup < sGroups.uCount; uGroup++)
+			{
+				PREGISTER_GROUP_DESC	psGroupDesc = &sGroups.asGroups[uGroup];
+				PARG					psGroupArg = &psInst->asArg[psGroupDesc->uStart];
+
+				if (psGroupArg->uType == USEASM_REGTYPE_TEMP &&
+					VectorGet(psState, &psRegState->sRegionReloads, psGroupArg->uNumber))
+				{
+					MakeGroup(psState, psGroupArg, psGroupDesc->uCount, psGroupDesc->eAlign);
+				}
+			}
+		}
+	}
+	ASSERT(psFlagsInst != NULL);
+
+	psFirstLoadInst = psLastLoadInst = NULL;
+	for (uMember = 0; uMember < uMemberCount; uMember++)
+	{
+		PINST		psLoadInst;
+		IMG_UINT32	uSpillAddress;
+
+		if (asReloadTemp[uMember].uNumber == USC_UNDEF)
+		{
+			continue;
+		}
+
+		uSpillAddress = AllocateSpillSpace(psState, psRegState, apsMembers[uMember]->uNumber);
+
+		InsertSpill(psState,
+					psRegState,
+					psLoadBlock,
+					psFlagsInst,
+					psInsertBeforeInst,
+					asReloadTemp[uMember].uNumber,
+					IMG_TRUE /* bLoad */,
+					eFmt,
+					uSpillAddress,
+					USC_UNDEF /* uLiveChansInDest */,
+					&psLoadInst);
+		if (psFirstLoadInst == NULL)
+		{
+			psFirstLoadInst = psLoadInst;
+		}
+		psLastLoadInst = psLoadInst;
+
+		/*
+			The reloaded register has no other definitions so inside a loop it is live
+			everywhere: every block in the loop leads back to the header.
+		*/
+		if (psHeader != NULL)
+		{
+			PCFG	psCfg = psHeader->psOwner;
+
+			SetRegisterLiveMask(psState,
+								&psLoadBlock->sRegistersLiveOut,
+								USEASM_REGTYPE_TEMP,
+								asReloadTemp[uMember].uNumber,
+								0 /* uArrayOffset */,
+								auLiveChans[uMember]);
+			for (uIdx = 0; uIdx < psCfg->uNumBlocks; uIdx++)
+			{
+				PCODEBLOCK	psBlock = psCfg->apsAllBlocks[uIdx];
+
+				if (IsBlockInSpillLoop(psBlock, psHeader))
+				{
+					SetRegisterLiveMask(psState,
+										&psBlock->sRegistersLiveOut,
+										USEASM_REGTYPE_TEMP,
+										asReloadTemp[uMember].uNumber,
+										0 /* uArrayOffset */,
+										auLiveChans[uMember]);
+				}
+			}
+		}
+	}
+	SpillInternalRegisters(psState, psRegState, psLoadBlock, psFirstLoadInst, psLastLoadInst);
+
+	UscFree(psState, asReloadTemp);
+	UscFree(psState, auLiveChans);
+}
+
+static
+IMG_VOID SpillGroupByRegion(PINTERMEDIATE_STATE	psState,
+							PRAGCOL_STATE		psRegState,
+							PREGISTER_GROUP		psGroupHead,
+							IMG_UINT32			uGroupHeadTempNum)
+/*****************************************************************************
+ FUNCTION     : SpillGroupByRegion
+
+ PURPOSE      : Split the live range of a group of registers which is about to
+				be spilled so that it is kept in new registers inside loops, and
+				across nearby uses in a block, where it isn't written and the
+				register pressure is low. Each part is loaded from memory once
+				instead of at each use; the rest of the live range, including
+				the blocks where the pressure is high, is spilled as normal.
+
+ PARAMETERS	  : psState			- Compiler state.
+				psRegState		- Register allocator state.
+				psGroupHead		- First register to spill (NULL if the
+								register isn't part of a group).
+				uGroupHeadTempNum
+								- Temporary register number to spill.
+
+ RETURNS	  : Nothing.
+*****************************************************************************/
+{
+	PUSEDEF_CHAIN*		apsMembers;
+	PUSC_LIST_ENTRY*	apsNextRef;
+	PREGION_SPILL_REF	asRefs;
+	IMG_UINT32			uMemberCount;
+	IMG_UINT32			uRefCount;
+	IMG_UINT32			uMember;
+	IMG_UINT32			uIdx;
+	PREGISTER_GROUP		psGroup;
+
+	if (psGroupHead != NULL && IsPrecolouredNode(psGroupHead))
+	{
+		return;
+	}
+
+	uMemberCount = 1;
+	if (psGroupHead != NULL)
+	{
+		for (psGroup = psGroupHead->psNext; psGroup != NULL; psGroup = psGroup->psNext)
+		{
+			uMemberCount++;
+		}
+	}
+
+	apsMembers = UscAlloc(psState, sizeof(apsMembers[0]) * uMemberCount);
+	apsNextRef = UscAlloc(psState, sizeof(apsNextRef[0]) * uMemberCount);
+	uRefCount = 0;
+	psGroup = psGroupHead;
+	for (uMember = 0; uMember < uMemberCount; uMember++)
+	{
+		apsMembers[uMember] = UseDefGet(psState, USEASM_REGTYPE_TEMP, (uMember == 0) ? uGroupHeadTempNum : psGroup->uRegister);
+		apsNextRef[uMember] = apsMembers[uMember]->sList.psHead;
+		uRefCount += apsMembers[uMember]->uUseDefCount;
+		if (psGroup != NULL)
+		{
+			psGroup = psGroup->psNext;
+		}
+	}
+
+	/*
+		Make a copy of the references to the group in program order since
+		replacing them modifies the lists.
+	*/
+	asRefs = UscAlloc(psState, sizeof(asRefs[0]) * uRefCount);
+	uRefCount = 0;
+	for (;;)
+	{
+		PINST		psCurrentInst;
+		IMG_UINT32	uFirstInstRef;
+
+		psCurrentInst = NULL;
+		for (uMember = 0; uMember < uMemberCount; uMember++)
+		{
+			PUSEDEF	psUseDef;
+			PINST	psUseInst;
+
+			if (apsNextRef[uMember] == NULL)
+			{
+				continue;
+			}
+			psUseDef = IMG_CONTAINING_RECORD(apsNextRef[uMember], PUSEDEF, sListEntry);
+			psUseInst = UseDefGetInst(psUseDef);
+			if (psUseInst == NULL)
+			{
+				/*
+					Only references in instructions can be spilled.
+				*/
+				psCurrentInst = NULL;
+				uRefCount = 0;
+				break;
+			}
+			psCurrentInst = GetEarliestInst(psUseInst, psCurrentInst);
+		}
+		if (psCurrentInst == NULL)
+		{
+			break;
+		}
+
+		uFirstInstRef = uRefCount;
+		for (uMember = 0; uMember < uMemberCount; uMember++)
+		{
+			while (apsNextRef[uMember] != NULL)
+			{
+				PUSEDEF				psUseDef = IMG_CONTAINING_RECORD(apsNextRef[uMember], PUSEDEF, sListEntry);
+				PREGION_SPILL_REF	psRef;
+
+				if (UseDefGetInst(psUseDef) != psCurrentInst)
+				{
+					break;
+				}
+				apsNextRef[uMember] = apsNextRef[uMember]->psNext;
+
+				psRef = &asRefs[uRefCount++];
+				psRef->psUseDef = psUseDef;
+				psRef->psInst = psCurrentInst;
+				psRef->uMember = uMember;
+				psRef->bReloaded = IMG_FALSE;
+			}
+		}
+		CheckRegionReloadInst(psState, asRefs, uFirstInstRef, uRefCount - uFirstInstRef);
+	}
+
+	for (uIdx = 0; uIdx < uRefCount; uIdx++)
+	{
+		PREGION_SPILL_REF	psRef = &asRefs[uIdx];
+		PINST				psInst = psRef->psInst;
+		PCODEBLOCK			psBlock = psInst->psBlock;
+		UF_REGFORMAT		eFmt;
+		PINST				psPrevInst;
+		IMG_UINT32			uLastRef;
+		IMG_UINT32			uNextRef;
+		IMG_UINT32			uInstCount;
+
+		/*
+			Regions start at the first reference in an instruction.
+		*/
+		if (!psRef->bCanReload || psRef->bReloaded || (uIdx > 0 && asRefs[uIdx - 1].psInst == psInst))
+		{
+			continue;
+		}
+		eFmt = psInst->asArg[psRef->psUseDef->uLocation].eFmt;
+
+		/*
+			Look for the outermost loop containing the use which doesn't write the
+			group and reload before it if that costs less than reloading at each
+			use inside it.
+		*/
+		if (psRegState->bSpillLoopInfo)
+		{
+			PCODEBLOCK	psHeader;
+			PCODEBLOCK	psBestHeader = NULL;
+			PCODEBLOCK	psBestPreheader = NULL;
+
+			psHeader = IsLoopHeader(psBlock) ? psBlock : psBlock->psLoopHeader;
+			while (psHeader != NULL)
+			{
+				PCODEBLOCK	psPreheader;
+
+				psPreheader = GetSpillLoopPreheader(psState, psRegState, psHeader, uMemberCount, asRefs, uRefCount, eFmt);
+				if (psPreheader == NULL)
+				{
+					break;
+				}
+				psBestHeader = psHeader;
+				psBestPreheader = psPreheader;
+				psHeader = psHeader->psLoopHeader;
+			}
+
+			if (psBestHeader != NULL)
+			{
+				IMG_UINT32	uUseFrequency = 0;
+				IMG_UINT32	uRef;
+
+				for (uRef = uIdx; uRef < uRefCount; uRef++)
+				{
+					PINST	psRefInst = asRefs[uRef].psInst;
+
+					if (!asRefs[uRef].bReloaded &&
+						(uRef == uIdx || psRefInst != asRefs[uRef - 1].psInst) &&
+						IsBlockInSpillLoop(psRefInst->psBlock, psBestHeader))
+					{
+						uUseFrequency += GetSpillBlockFrequency(psRegState, psRefInst->psBlock);
+					}
+				}
+
+				if (uUseFrequency > GetSpillBlockFrequency(psRegState, psBestPreheader))
+				{
+					ReloadSpilledGroupForRegion(psState,
+												psRegState,
+												apsMembers,
+												uMemberCount,
+												asRefs,
+												uIdx,
+												uRefCount - 1,
+												psBestHeader,
+												psBestPreheader,
+												NULL /* psInsertBeforeInst */,
+												eFmt);
+					continue;
+				}
+			}
+		}
+
+		/*
+			Otherwise share one reload between instructions close together in the
+			same block.
+		*/
+		if (!IsRegionReloadBlock(psState, psBlock) || !IsRegionLowPressure(psState, psRegState, psBlock, 0))
+		{
+			continue;
+		}
+		uInstCount = 0;
+		uLastRef = uIdx;
+		uNextRef = uIdx;
+		psPrevInst = psInst;
+		while (uNextRef < uRefCount)
+		{
+			PINST		psNextInst = asRefs[uNextRef].psInst;
+			IMG_UINT32	uInstEnd;
+
+			if (psNextInst->psBlock != psBlock ||
+				(psNextInst->uBlockIndex - psPrevInst->uBlockIndex) > SPILL_REGION_MAX_USE_DISTANCE)
+			{
+				break;
+			}
+			for (uInstEnd = uNextRef; uInstEnd < uRefCount && asRefs[uInstEnd].psInst == psNextInst; uInstEnd++)
+			{
+				if (!IsRegionReloadRef(&asRefs[uInstEnd], eFmt))
+				{
+					break;
+				}
+			}
+			if (uInstEnd < uRefCount && asRefs[uInstEnd].psInst == psNextInst)
+			{
+				break;
+			}
+			uInstCount++;
+			uLastRef = uInstEnd - 1;
+			uNextRef = uInstEnd;
+			psPrevInst = psNextInst;
+		}
+		if (uInstCount > 1)
+		{
+			ReloadSpilledGroupForRegion(psState,
+										psRegState,
+										apsMembers,
+										uMemberCount,
+										asRefs,
+										uIdx,
+										uLastRef,
+										NULL /* psHeader */,
+										psBlock,
+										psInst,
+										eFmt);
+		}
+	}
+
+	UscFree(psState, apsMembers);
+	UscFree(psState, apsNextRef);
+	UscFree(psState, asRefs);
+}
+
 static
 IMG_VOID SpillRegistersBP(PINTERMEDIATE_STATE psState,
 						  PCODEBLOCK psBlock,
@@ -7707,6 +8532,15 @@ IMG_VOID SpillEntireGroup(PINTERMEDIATE_STATE	psState,
 	NodeToRegister(&psRegState->sRAData, uBaseNode, &uBaseRegType, &uBaseRegNum);
 	ASSERT(uBaseRegType == USEASM_REGTYPE_TEMP);
 
+	/*
+		Keep the register in a new register where it is used repeatedly without
+		being written and only spill the rest of its live range.
+	*/
+	if (!VectorGet(psState, &psRegState->sRegionReloads, uBaseRegNum))
+	{
+		SpillGroupByRegion(psState, psRegState, psBaseNode, uBaseRegNum);
+	}
+
 	SpillRegisterGroup(psState, psRegState, psBaseNode, uBaseRegNum);
 
 	if (psBaseNode == NULL)
@@ -7783,6 +8617,8 @@ IMG_VOID SpillPlainNodes(PINTERMEDIATE_STATE psState,
 {
 	PUSC_LIST_ENTRY	psListEntry;
 
+	ComputeSpillLoopInfo(psState, psRegState);
+
    /* Choose spill nodes */
 	InitializeList(&psRegState->sSpillList);
 	while ((psListEntry = RemoveListHead(&psRegState->sUncolouredList)) != NULL)
@@ -7967,6 +8803,13 @@ IMG_VOID PrepRegState(PINTERMEDIATE_STATE psState,
 		UscAlloc(psState, sizeof(IMG_UINT32) * UINTS_TO_SPAN_BITS(psRegState->sRAData.uNrRegisters * CHANS_PER_REGISTER));
 	sIntfContext.psRegState = psRegState;
 
+	if (psRegState->auBlockMaxLive != NULL)
+	{
+		UscFree(psState, psRegState->auBlockMaxLive);
+	}
+	psRegState->auBlockMaxLive = UscAlloc(psState, sizeof(psRegState->auBlockMaxLive[0]) * psState->uGlobalBlockCount);
+	memset(psRegState->auBlockMaxLive, 0, sizeof(psRegState->auBlockMaxLive[0]) * psState->uGlobalBlockCount);
+
 	/* Do per-block initialisation */
 	DoOnAllFuncGroupBasicBlocks(psState, ANY_ORDER, ConstructInterferenceGraphBP, IMG_FALSE, &sIntfContext, eFuncGroup);
 
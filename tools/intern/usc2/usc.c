@@ -3221,6 +3221,80 @@ PCODEBLOCK RemoveBlockWorkListHead(PINTERMEDIATE_STATE psState, PBLOCK_WORK_LIST
 	return psRemovedBlock;
 }
 
+static IMG_VOID GetBlocksInPostOrder(PINTERMEDIATE_STATE psState, PCFG psCfg, PCODEBLOCK* apsOrder)
+/******************************************************************************
+ Function		: GetBlocksInPostOrder
+ 
+ Description	: Lists the blocks of a CFG in the order a depth-first traversal
+				  from the entry finishes them (so, ignoring backedges, each block
+				  comes after all its successors). Blocks not reachable from the
+				  entry follow in index order. Doesn't change the block indices.
+
+ Parameters		: psState	- Current compilation context
+				  psCfg		- CFG whose blocks should be listed
+				  apsOrder	- Returns the blocks (uNumBlocks entries).
+
+ Returns		: None.
+******************************************************************************/
+{
+	PCODEBLOCK*	apsStack;
+	IMG_PUINT32	auNextSucc;
+	IMG_PUINT32	auVisited;
+	IMG_UINT32	uDepth;
+	IMG_UINT32	uCount;
+	IMG_UINT32	uBlock;
+
+	apsStack = UscAlloc(psState, psCfg->uNumBlocks * sizeof(apsStack[0]));
+	auNextSucc = UscAlloc(psState, psCfg->uNumBlocks * sizeof(auNextSucc[0]));
+	usc_alloc_bitnum(psState, auVisited, psCfg->uNumBlocks);
+	memset(auVisited, 0, UINTS_TO_SPAN_BITS(psCfg->uNumBlocks) * sizeof(IMG_UINT32));
+
+	uCount = 0;
+	uDepth = 0;
+	if (psCfg->psEntry != NULL)
+	{
+		SetBit(auVisited, psCfg->psEntry->uIdx, 1);
+		apsStack[0] = psCfg->psEntry;
+		auNextSucc[0] = 0;
+		uDepth = 1;
+	}
+	while (uDepth > 0)
+	{
+		PCODEBLOCK	psBlock = apsStack[uDepth - 1];
+
+		if (auNextSucc[uDepth - 1] < psBlock->uNumSuccs)
+		{
+			PCODEBLOCK	psSucc = psBlock->asSuccs[auNextSucc[uDepth - 1]++].psDest;
+
+			if (!GetBit(auVisited, psSucc->uIdx))
+			{
+				SetBit(auVisited, psSucc->uIdx, 1);
+				apsStack[uDepth] = psSucc;
+				auNextSucc[uDepth] = 0;
+				uDepth++;
+			}
+		}
+		else
+		{
+			apsOrder[uCount++] = psBlock;
+			uDepth--;
+		}
+	}
+
+	for (uBlock = 0; uBlock < psCfg->uNumBlocks; uBlock++)
+	{
+		if (!GetBit(auVisited, uBlock))
+		{
+			apsOrder[uCount++] = psCfg->apsAllBlocks[uBlock];
+		}
+	}
+	ASSERT(uCount == psCfg->uNumBlocks);
+
+	UscFree(psState, apsStack);
+	UscFree(psState, auNextSucc);
+	UscFree(psState, auVisited);
+}
+
 IMG_INTERNAL IMG_VOID DoDataflow(PINTERMEDIATE_STATE psState, PFUNC psFunc,
 								IMG_BOOL bForwards,
 								IMG_UINT32 uSize, IMG_PVOID pvWorking,
@@ -3253,17 +3327,21 @@ IMG_INTERNAL IMG_VOID DoDataflow(PINTERMEDIATE_STATE psState, PFUNC psFunc,
 	IMG_UINT32 i, uInputArraySize = 5;
 	IMG_PVOID *apvInputs = UscAlloc(psState, uInputArraySize * sizeof(IMG_PVOID));
 	PCODEBLOCK psWorkListHead = NULL, psWorkListTail = NULL;
+	PCODEBLOCK *apsOrder;
 
 	/*
-		set up work list. Since the order in which we consider blocks does not
-		affect correctness, we just use *whatever order the blocks happen to be
-		sorted in*; however, since said ordering may affect performance, we
-		take the chance of reversing it for backwards analyses.
+		set up work list. The order in which we consider blocks does not
+		affect correctness, but it does affect how many times each block is
+		visited before the values converge: start with reverse postorder for
+		forwards analyses and postorder for backwards ones, so (except around
+		loops) a block is first visited after the blocks its value depends on.
 	*/
+	apsOrder = UscAlloc(psState, psFunc->sCfg.uNumBlocks * sizeof(apsOrder[0]));
+	GetBlocksInPostOrder(psState, &psFunc->sCfg, apsOrder);
 	for (i = 0; i < psFunc->sCfg.uNumBlocks; i++)
 	{
-		IMG_UINT32 uIdx = (bForwards) ? i : (psFunc->sCfg.uNumBlocks - 1 - i);
-		PCODEBLOCK psAddToList = psFunc->sCfg.apsAllBlocks[ uIdx ];
+		IMG_UINT32 uIdx = (bForwards) ? (psFunc->sCfg.uNumBlocks - 1 - i) : i;
+		PCODEBLOCK psAddToList = apsOrder[ uIdx ];
 		if (psWorkListTail)
 		{
 			psWorkListTail->psWorkListNext = psAddToList;
@@ -3275,6 +3353,7 @@ IMG_INTERNAL IMG_VOID DoDataflow(PINTERMEDIATE_STATE psState, PFUNC psFunc,
 		psWorkListTail = psAddToList;
 		psAddToList->psWorkListNext = NULL;
 	}
+	UscFree(psState, apsOrder);
 	
 	//ok - just keep going while there are blocks to process.
 	while (psWorkListHead)
@@ -297,15 +297,11 @@ __attribute__ ((noreturn))
 #define usc_alloc_bitnum(state, array, count) array = UscAlloc(psState, UINTS_TO_SPAN_BITS(count) * sizeof(IMG_UINT32))
 
 /*
-	Macros for recording metrics
+	Macros for recording metrics. The callbacks are optional and only called
+	a few times per compile, so they are available in all builds.
 */
-#ifdef METRICS
 #define METRICS_START(state,x)	{if (state->pfnStart) state->pfnStart(state->pvMetricsFnDrvParam, USC_METRICS_##x ); }
 #define METRICS_FINISH(state,x)	{if (state->pfnFinish) state->pfnFinish(state->pvMetricsFnDrvParam, USC_METRICS_##x ); }
-#else
-#define METRICS_START(state,x)
-#define METRICS_FINISH(state,x)
-#endif /* #ifdef METRICS */
 
 /* Size macros */
 #define UINTS_TO_SPAN_BITS(B)	(((B) + 31) >> 5)
@@ -561,6 +557,16 @@ typedef struct
 	USC_VECTOR		sFpInternal;
 	IMG_UINT32		puIndexReg[UINTS_TO_SPAN_BITS(CHANS_PER_REGISTER)];
 	IMG_BOOL        bLinkReg;
+	/*
+		If non-NULL the live temporary channels and predicates are held in these
+		packed bit vectors instead of sTemp and sPredicate. Only the working sets
+		used by the liveness dataflow on programs with many registers are dense
+		(see dce.c); block and function livesets always use the vectors.
+	*/
+	IMG_PUINT32		auDenseTemp;
+	IMG_UINT32		uDenseTempWords;
+	IMG_PUINT32		auDensePredicate;
+	IMG_UINT32		uDensePredicateWords;
 } REGISTER_LIVESET, *PREGISTER_LIVESET;
 
 /*
@@ -0,0 +1,1457 @@
+/******************************************************************************
+ * Name         : useperf.c
+ * Title        : Static USE performance estimator
+ *
+ * Copyright    : 2002-2010 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means, electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Description  : Estimates the cost of a block of USE instructions from the
+ *                binary alone. The instructions are decoded with
+ *                UseDecodeInstruction, split into basic blocks at branches
+ *                and branch targets, and each block is timed twice:
+ *
+ *                - by issue slots, the cost when enough other tasks are
+ *                  resident to hide every latency;
+ *                - in order for a single task which waits for each result,
+ *                  which is the cost when the shader can't be overlapped.
+ *
+ *                Texture and memory latencies depend on the state of the
+ *                caches and are parameters. Bank conflicts (two different
+ *                registers read from the same unified store bank by one
+ *                instruction) are reported but not charged to the cycles.
+ *
+ * Modifications:-
+ * $Log: useperf.c $
+ *****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "sgxsupport.h"
+
+#include "sgxdefs.h"
+
+#include "use.h"
+#include "useasm.h"
+#include "usetab.h"
+#include "osglue.h"
+#include "useperf.h"
+
+/*
+	Register banks whose contents are tracked between instructions.
+*/
+typedef enum _USEPERF_BANK_
+{
+	USEPERF_BANK_TEMP,
+	USEPERF_BANK_OUTPUT,
+	USEPERF_BANK_PRIMATTR,
+	USEPERF_BANK_SECATTR,
+	USEPERF_BANK_FPINTERNAL,
+	USEPERF_BANK_INDEX,
+	USEPERF_BANK_PREDICATE,
+	USEPERF_BANK_COUNT,
+	USEPERF_BANK_NONE = USEPERF_BANK_COUNT
+} USEPERF_BANK;
+
+/*
+	Number of registers tracked in each bank. Accesses beyond this (or
+	through an index register) are treated as accesses to the whole bank.
+*/
+#define USEPERF_BANK_REGISTERS		(512)
+
+/*
+	Number of banks the unified store (temporaries, primary attributes and
+	outputs) is interleaved across by register number.
+*/
+#define USEPERF_UNIFIED_STORE_BANKS	(2)
+
+/*
+	Maximum number of register operands of an instruction (or a dual-issued
+	pair) including the index and predicate registers it reads.
+*/
+#define USEPERF_MAX_OPERANDS		(USE_MAX_ARGUMENTS * 4 + 2)
+
+/*
+	A range of registers read or written by an instruction.
+*/
+typedef struct _USEPERF_OPERAND_
+{
+	USEPERF_BANK	eBank;
+	IMG_UINT32		uFirst;
+	IMG_UINT32		uCount;
+	IMG_BOOL		bDest;
+	/* Is this a source in the unified store, which can conflict with other sources. */
+	IMG_BOOL		bUnifiedStore;
+} USEPERF_OPERAND, *PUSEPERF_OPERAND;
+
+/*
+	Fixed issue rules for each instruction class. The latency of texture
+	samples and memory loads comes from USEPERF_PARAMS instead.
+*/
+typedef struct _USEPERF_CLASS_DESC_
+{
+	IMG_PCHAR	pszName;
+	/* Cycles from the last issue slot of the instruction to its result being usable. */
+	IMG_UINT32	uLatency;
+} USEPERF_CLASS_DESC;
+
+static const USEPERF_CLASS_DESC g_asClassDesc[USEPERF_CLASS_COUNT] =
+{
+	{"alu",		1},		/* USEPERF_CLASS_ALU */
+	{"complex",	4},		/* USEPERF_CLASS_COMPLEX */
+	{"texture",	0},		/* USEPERF_CLASS_TEXTURE */
+	{"load",	0},		/* USEPERF_CLASS_LOAD */
+	{"store",	1},		/* USEPERF_CLASS_STORE */
+	{"wait",	1},		/* USEPERF_CLASS_WAIT */
+	{"branch",	1},		/* USEPERF_CLASS_BRANCH */
+	{"emit",	1},		/* USEPERF_CLASS_EMIT */
+	{"nop",		1},		/* USEPERF_CLASS_NOP */
+};
+
+/*
+	Decoded form of one hardware instruction.
+*/
+typedef struct _USEPERF_DECODED_
+{
+	USE_INST	sInst;
+	USE_INST	sCoInst;
+} USEPERF_DECODED, *PUSEPERF_DECODED;
+
+/*
+	Register timing while a block is being timed.
+*/
+typedef struct _USEPERF_REGSTATE_
+{
+	/* Cycle each register is written when the block runs in order. */
+	IMG_UINT32	aauReady[USEPERF_BANK_COUNT][USEPERF_BANK_REGISTERS];
+	/* Length of the dependency chain ending with the value in each register. */
+	IMG_UINT32	aauDepth[USEPERF_BANK_COUNT][USEPERF_BANK_REGISTERS];
+	/* Instruction which wrote each register, or USEPERF_UNDEF. */
+	IMG_UINT32	aauWriter[USEPERF_BANK_COUNT][USEPERF_BANK_REGISTERS];
+	/* The same for the data returned through each DRC. */
+	IMG_UINT32	auDRCReady[EURASIA_USE_DRC_BANK_SIZE];
+	IMG_UINT32	auDRCDepth[EURASIA_USE_DRC_BANK_SIZE];
+	IMG_UINT32	auDRCWriter[EURASIA_USE_DRC_BANK_SIZE];
+} USEPERF_REGSTATE, *PUSEPERF_REGSTATE;
+
+/*
+	Totals along the longest path starting at a block.
+*/
+typedef struct _USEPERF_PATH_
+{
+	IMG_BOOL	bDone;
+	IMG_BOOL	bOnStack;
+	IMG_UINT32	uBestSucc;
+	IMG_UINT32	uInsts;
+	IMG_UINT32	uIssueCycles;
+	IMG_UINT32	uLatencyCycles;
+	IMG_UINT32	uBankConflicts;
+} USEPERF_PATH, *PUSEPERF_PATH;
+
+/*****************************************************************************
+ FUNCTION	: UsePerfInitParams
+
+ PURPOSE	: Sets the default estimator parameters.
+
+ PARAMETERS	: psParams			- Parameters to initialise.
+
+ RETURNS	: Nothing.
+*****************************************************************************/
+IMG_INTERNAL
+IMG_VOID IMG_CALLCONV UsePerfInitParams(PUSEPERF_PARAMS psParams)
+{
+	psParams->uTextureLatency = USEPERF_DEFAULT_TEXTURE_LATENCY;
+	psParams->uMemoryLatency = USEPERF_DEFAULT_MEMORY_LATENCY;
+	psParams->uCodeOffset = 0;
+}
+
+/*****************************************************************************
+ FUNCTION	: UsePerfClassName
+
+ PURPOSE	: Gets a printable name for an instruction class.
+
+ PARAMETERS	: eClass			- Class.
+
+ RETURNS	: The name.
+*****************************************************************************/
+IMG_INTERNAL
+IMG_PCHAR IMG_CALLCONV UsePerfClassName(USEPERF_CLASS eClass)
+{
+	if (eClass >= USEPERF_CLASS_COUNT)
+	{
+		return "invalid";
+	}
+	return g_asClassDesc[eClass].pszName;
+}
+
+/*****************************************************************************
+ FUNCTION	: GetInstClass
+
+ PURPOSE	: Gets the class of issue rules an instruction follows.
+
+ PARAMETERS	: psInst			- Decoded instruction.
+
+ RETURNS	: The class.
+*****************************************************************************/
+static USEPERF_CLASS GetInstClass(PUSE_INST psInst)
+{
+	IMG_UINT32	uDescFlags = OpcodeDescFlags(psInst->uOpcode);
+
+	if (uDescFlags & USC_DESCFLAG_TEXTURESAMPLE)
+	{
+		return USEPERF_CLASS_TEXTURE;
+	}
+	if (uDescFlags & USE_DESCFLAG_DISASM_MEMORY_ST)
+	{
+		return USEPERF_CLASS_STORE;
+	}
+
+	switch (psInst->uOpcode)
+	{
+		case USEASM_OP_SMP1D:
+		case USEASM_OP_SMP2D:
+		case USEASM_OP_SMP3D:
+		case USEASM_OP_SMP1DBIAS:
+		case USEASM_OP_SMP2DBIAS:
+		case USEASM_OP_SMP3DBIAS:
+		case USEASM_OP_SMP1DREPLACE:
+		case USEASM_OP_SMP2DREPLACE:
+		case USEASM_OP_SMP3DREPLACE:
+		case USEASM_OP_SMP1DGRAD:
+		case USEASM_OP_SMP2DGRAD:
+		case USEASM_OP_SMP3DGRAD:
+		{
+			return USEPERF_CLASS_TEXTURE;
+		}
+
+		case USEASM_OP_LDAB:
+		case USEASM_OP_LDAW:
+		case USEASM_OP_LDAD:
+		case USEASM_OP_LDAQ:
+		case USEASM_OP_LDLB:
+		case USEASM_OP_LDLW:
+		case USEASM_OP_LDLD:
+		case USEASM_OP_LDLQ:
+		case USEASM_OP_LDTB:
+		case USEASM_OP_LDTW:
+		case USEASM_OP_LDTD:
+		case USEASM_OP_LDTQ:
+		case USEASM_OP_ELDD:
+		case USEASM_OP_ELDQ:
+		case USEASM_OP_LDR:
+		case USEASM_OP_LDATOMIC:
+		{
+			return USEPERF_CLASS_LOAD;
+		}
+
+		case USEASM_OP_STAB:
+		case USEASM_OP_STAW:
+		case USEASM_OP_STAD:
+		case USEASM_OP_STAQ:
+		case USEASM_OP_STLB:
+		case USEASM_OP_STLW:
+		case USEASM_OP_STLD:
+		case USEASM_OP_STLQ:
+		case USEASM_OP_STTB:
+		case USEASM_OP_STTW:
+		case USEASM_OP_STTD:
+		case USEASM_OP_STTQ:
+		case USEASM_OP_STR:
+		{
+			return USEPERF_CLASS_STORE;
+		}
+
+		case USEASM_OP_FRCP:
+		case USEASM_OP_FRSQ:
+		case USEASM_OP_FLOG:
+		case USEASM_OP_FEXP:
+		case USEASM_OP_FSQRT:
+		case USEASM_OP_FSIN:
+		case USEASM_OP_FCOS:
+		case USEASM_OP_VRCP:
+		case USEASM_OP_VRSQ:
+		case USEASM_OP_VLOG:
+		case USEASM_OP_VEXP:
+		{
+			return USEPERF_CLASS_COMPLEX;
+		}
+
+		case USEASM_OP_WDF:
+		case USEASM_OP_IDF:
+		case USEASM_OP_LOCK:
+		case USEASM_OP_RELEASE:
+		case USEASM_OP_PHAS:
+		case USEASM_OP_PHASIMM:
+		{
+			return USEPERF_CLASS_WAIT;
+		}
+
+		case USEASM_OP_BA:
+		case USEASM_OP_BR:
+		case USEASM_OP_LAPC:
+		case USEASM_OP_BEXCEPTION:
+		{
+			return USEPERF_CLASS_BRANCH;
+		}
+
+		case USEASM_OP_EMITPIXEL1:
+		case USEASM_OP_EMITPIXEL2:
+		case USEASM_OP_EMITPIXEL:
+		case USEASM_OP_EMITSTATE:
+		case USEASM_OP_EMITVERTEX:
+		case USEASM_OP_EMITPRIMITIVE:
+		case USEASM_OP_EMITPDS:
+		case USEASM_OP_EMITMTEVERTEX:
+		case USEASM_OP_EMITMTESTATE:
+		case USEASM_OP_EMITVCBVERTEX:
+		case USEASM_OP_EMITVCBSTATE:
+		{
+			return USEPERF_CLASS_EMIT;
+		}
+
+		case USEASM_OP_NOP:
+		case USEASM_OP_PADDING:
+		{
+			return USEPERF_CLASS_NOP;
+		}
+
+		default:
+		{
+			return USEPERF_CLASS_ALU;
+		}
+	}
+}
+
+/*****************************************************************************
+ FUNCTION	: IsVectorOpcode
+
+ PURPOSE	: Checks for an instruction whose mask is a vector write mask
+			  rather than a repeat mask.
+
+ PARAMETERS	: uOpcode			- Opcode.
+
+ RETURNS	: TRUE or FALSE.
+*****************************************************************************/
+static IMG_BOOL IsVectorOpcode(IMG_UINT32 uOpcode)
+{
+	return (IMG_BOOL)(uOpcode >= USEASM_OP_VDP3 && uOpcode <= USEASM_OP_VPCKC10C10);
+}
+
+/*****************************************************************************
+ FUNCTION	: GetVectorChannelsPerRegister
+
+ PURPOSE	: Gets how many channels of the destination of a vector
+			  instruction are packed in one 32-bit register.
+
+ PARAMETERS	: uOpcode			- Vector opcode.
+
+ RETURNS	: 1, 2 or 4.
+*****************************************************************************/
+static IMG_UINT32 GetVectorChannelsPerRegister(IMG_UINT32 uOpcode)
+{
+	if (uOpcode >= USEASM_OP_VF16MAD && uOpcode <= USEASM_OP_VF16SUB)
+	{
+		return 2;
+	}
+	if (uOpcode >= USEASM_OP_VPCKU8U8 && uOpcode <= USEASM_OP_VPCKO8F32)
+	{
+		return 4;
+	}
+	if (uOpcode >= USEASM_OP_VPCKU16U8 && uOpcode <= USEASM_OP_VPCKF16C10)
+	{
+		return 2;
+	}
+	if (uOpcode >= USEASM_OP_VPCKC10F16 && uOpcode <= USEASM_OP_VPCKC10C10)
+	{
+		return 4;
+	}
+	return 1;
+}
+
+/*****************************************************************************
+ FUNCTION	: GetHighestBit
+
+ PURPOSE	: Gets one more than the index of the highest set bit of a mask.
+
+ PARAMETERS	: uMask				- Mask.
+
+ RETURNS	: 0 for an empty mask.
+*****************************************************************************/
+static IMG_UINT32 GetHighestBit(IMG_UINT32 uMask)
+{
+	IMG_UINT32	uHighest = 0;
+
+	while (uMask != 0)
+	{
+		uHighest++;
+		uMask >>= 1;
+	}
+	return uHighest;
+}
+
+/*****************************************************************************
+ FUNCTION	: GetRepeats
+
+ PURPOSE	: Gets the number of times an instruction is issued, and how many
+			  consecutive registers each of its operands covers.
+
+ PARAMETERS	: psInst			- Decoded instruction.
+			  puIssues			- Returns the number of issue slots.
+			  puDestWidth		- Returns the registers written through the
+								  destination.
+			  puSrcWidth		- Returns the registers read through each
+								  source.
+
+ RETURNS	: Nothing.
+*****************************************************************************/
+static IMG_VOID GetRepeats(PUSE_INST	psInst,
+						   IMG_PUINT32	puIssues,
+						   IMG_PUINT32	puDestWidth,
+						   IMG_PUINT32	puSrcWidth)
+{
+	IMG_UINT32	uRepeat = (psInst->uFlags1 & ~USEASM_OPFLAGS1_REPEAT_CLRMSK) >> USEASM_OPFLAGS1_REPEAT_SHIFT;
+	IMG_UINT32	uMask = (psInst->uFlags1 & ~USEASM_OPFLAGS1_MASK_CLRMSK) >> USEASM_OPFLAGS1_MASK_SHIFT;
+
+	if (IsVectorOpcode(psInst->uOpcode))
+	{
+		IMG_UINT32	uChansPerReg = GetVectorChannelsPerRegister(psInst->uOpcode);
+		IMG_UINT32	uChans = GetHighestBit(uMask);
+
+		if (uRepeat == 0)
+		{
+			uRepeat = 1;
+		}
+		if (uChans == 0)
+		{
+			uChans = 4;
+		}
+
+		/*
+			An F32 vector instruction processes two channels per clock on
+			the vector cores, so a three or four channel destination takes
+			two slots.
+		*/
+		*puIssues = uRepeat;
+		if (uChansPerReg == 1 && uChans > 2 && psInst->uOpcode >= USEASM_OP_VMAD && psInst->uOpcode <= USEASM_OP_VSUB)
+		{
+			*puIssues = uRepeat * 2;
+		}
+
+		*puDestWidth = uRepeat * ((uChans + uChansPerReg - 1) / uChansPerReg);
+		*puSrcWidth = uRepeat * ((psInst->uOpcode >= USEASM_OP_VF16MAD && psInst->uOpcode <= USEASM_OP_VF16SUB) ? 2 : 4);
+	}
+	else if (uRepeat != 0)
+	{
+		*puIssues = uRepeat;
+		*puDestWidth = uRepeat;
+		*puSrcWidth = uRepeat;
+	}
+	else
+	{
+		IMG_UINT32	uIssues = 0;
+		IMG_UINT32	uBits;
+
+		/*
+			A repeat mask issues the instruction once for each set bit.
+		*/
+		for (uBits = uMask; uBits != 0; uBits &= uBits - 1)
+		{
+			uIssues++;
+		}
+		*puIssues = (uIssues > 0) ? uIssues : 1;
+		*puDestWidth = (uMask != 0) ? GetHighestBit(uMask) : 1;
+		*puSrcWidth = *puDestWidth;
+	}
+}
+
+/*****************************************************************************
+ FUNCTION	: GetRegisterBank
+
+ PURPOSE	: Maps a USEASM register type to the bank tracked for it.
+
+ PARAMETERS	: uType				- Register type.
+			  pbUnifiedStore	- Returns TRUE for a unified store bank.
+
+ RETURNS	: The bank, or USEPERF_BANK_NONE for registers which aren't
+			  written by programs (immediates, constants, special registers).
+*****************************************************************************/
+static USEPERF_BANK GetRegisterBank(IMG_UINT32 uType, IMG_PBOOL pbUnifiedStore)
+{
+	*pbUnifiedStore = IMG_FALSE;
+	switch (uType)
+	{
+		case USEASM_REGTYPE_TEMP:		*pbUnifiedStore = IMG_TRUE; return USEPERF_BANK_TEMP;
+		case USEASM_REGTYPE_OUTPUT:		*pbUnifiedStore = IMG_TRUE; return USEPERF_BANK_OUTPUT;
+		case USEASM_REGTYPE_PRIMATTR:	*pbUnifiedStore = IMG_TRUE; return USEPERF_BANK_PRIMATTR;
+		case USEASM_REGTYPE_SECATTR:	return USEPERF_BANK_SECATTR;
+		case USEASM_REGTYPE_FPINTERNAL:	return USEPERF_BANK_FPINTERNAL;
+		case USEASM_REGTYPE_INDEX:		return USEPERF_BANK_INDEX;
+		case USEASM_REGTYPE_PREDICATE:	return USEPERF_BANK_PREDICATE;
+		default:						return USEPERF_BANK_NONE;
+	}
+}
+
+/*****************************************************************************
+ FUNCTION	: AddOperand
+
+ PURPOSE	: Adds a register range to the operands of an instruction.
+
+ PARAMETERS	: asOperands		- Operand list.
+			  puCount			- Number of operands in the list.
+			  eBank				- Register bank.
+			  uFirst			- First register.
+			  uCount			- Number of registers, or USEPERF_UNDEF
+								  for the whole bank.
+			  bDest				- TRUE for a register written.
+			  bUnifiedStore		- TRUE for a unified store source.
+
+ RETURNS	: Nothing.
+*****************************************************************************/
+static IMG_VOID AddOperand(PUSEPERF_OPERAND	asOperands,
+						   IMG_PUINT32		puCount,
+						   USEPERF_BANK		eBank,
+						   IMG_UINT32		uFirst,
+						   IMG_UINT32		uCount,
+						   IMG_BOOL			bDest,
+						   IMG_BOOL			bUnifiedStore)
+{
+	PUSEPERF_OPERAND	psOperand;
+
+	if (*puCount >= USEPERF_MAX_OPERANDS)
+	{
+		return;
+	}
+	psOperand = &asOperands[(*puCount)++];
+
+	if (uCount == USEPERF_UNDEF || uFirst >= USEPERF_BANK_REGISTERS || uCount > USEPERF_BANK_REGISTERS - uFirst)
+	{
+		uFirst = 0;
+		uCount = USEPERF_BANK_REGISTERS;
+	}
+
+	psOperand->eBank = eBank;
+	psOperand->uFirst = uFirst;
+	psOperand->uCount = uCount;
+	psOperand->bDest = bDest;
+	psOperand->bUnifiedStore = (IMG_BOOL)(bUnifiedStore && !bDest);
+}
+
+/*****************************************************************************
+ FUNCTION	: GetOperands
+
+ PURPOSE	: Gets the registers read and written by an instruction.
+
+ PARAMETERS	: psInst			- Decoded instruction.
+			  eClass			- Class of the instruction.
+			  asOperands		- Operand list to add to.
+			  puCount			- Number of operands in the list.
+
+ RETURNS	: The number of issue slots the instruction takes.
+*****************************************************************************/
+static IMG_UINT32 GetOperands(PUSE_INST			psInst,
+							  USEPERF_CLASS		eClass,
+							  PUSEPERF_OPERAND	asOperands,
+							  IMG_PUINT32		puCount)
+{
+	IMG_UINT32	uArgCount = OpcodeArgumentCount(psInst->uOpcode);
+	IMG_UINT32	uDestCount;
+	IMG_UINT32	uIssues, uDestWidth, uSrcWidth;
+	IMG_UINT32	uPred;
+	IMG_UINT32	uArg;
+
+	GetRepeats(psInst, &uIssues, &uDestWidth, &uSrcWidth);
+
+	/*
+		Test instructions have an extra argument for the predicate they write.
+	*/
+	if (
+			(psInst->uFlags1 & USEASM_OPFLAGS1_TESTENABLE) &&
+			((psInst->uTest & ~USEASM_TEST_MASK_CLRMSK) >> USEASM_TEST_MASK_SHIFT) == USEASM_TEST_MASK_NONE &&
+			psInst->uOpcode != USEASM_OP_MOVC &&
+			psInst->uOpcode != USEASM_OP_VMOVC &&
+			psInst->uOpcode != USEASM_OP_VMOVCU8
+	   )
+	{
+		uArgCount++;
+		uDestCount = 2;
+	}
+	else
+	{
+		uDestCount = 1;
+	}
+
+	switch (eClass)
+	{
+		case USEPERF_CLASS_STORE:
+		case USEPERF_CLASS_WAIT:
+		case USEPERF_CLASS_BRANCH:
+		case USEPERF_CLASS_EMIT:
+		case USEPERF_CLASS_NOP:
+		{
+			uDestCount = 0;
+			break;
+		}
+		case USEPERF_CLASS_TEXTURE:
+		{
+			/*
+				The number of registers a sample writes depends on the texture
+				format, which isn't in the code: assume four.
+			*/
+			uDestWidth = 4;
+			break;
+		}
+		default:
+		{
+			break;
+		}
+	}
+
+	if (uArgCount > USE_MAX_ARGUMENTS)
+	{
+		uArgCount = USE_MAX_ARGUMENTS;
+	}
+
+	for (uArg = 0; uArg < uArgCount; uArg++)
+	{
+		PUSE_REGISTER	psArg = &psInst->asArg[uArg];
+		IMG_BOOL		bDest = (IMG_BOOL)(uArg < uDestCount);
+		IMG_BOOL		bUnifiedStore;
+		USEPERF_BANK	eBank = GetRegisterBank(psArg->uType, &bUnifiedStore);
+		IMG_UINT32		uWidth;
+
+		if (psArg->uType == USEASM_REGTYPE_DRC)
+		{
+			/*
+				Loads and samples end with the DRC; the argument count
+				includes optional arguments which aren't present.
+			*/
+			break;
+		}
+		if (eBank == USEPERF_BANK_NONE)
+		{
+			continue;
+		}
+
+		if (eBank == USEPERF_BANK_PREDICATE || eBank == USEPERF_BANK_INDEX)
+		{
+			uWidth = 1;
+		}
+		else if (eBank == USEPERF_BANK_FPINTERNAL)
+		{
+			/*
+				Each internal register holds a whole vector.
+			*/
+			uWidth = 1;
+		}
+		else
+		{
+			uWidth = bDest ? uDestWidth : uSrcWidth;
+		}
+
+		if (psArg->uIndex != USEREG_INDEX_NONE)
+		{
+			/*
+				Any register in the bank could be accessed.
+			*/
+			AddOperand(asOperands, puCount, USEPERF_BANK_INDEX, psArg->uIndex - 1, 1, IMG_FALSE, IMG_FALSE);
+			AddOperand(asOperands, puCount, eBank, 0, USEPERF_UNDEF, bDest, bUnifiedStore);
+		}
+		else
+		{
+			AddOperand(asOperands, puCount, eBank, psArg->uNumber, uWidth, bDest, bUnifiedStore);
+		}
+	}
+
+	/*
+		A predicated instruction reads its predicate.
+	*/
+	uPred = (psInst->uFlags1 & ~USEASM_OPFLAGS1_PRED_CLRMSK) >> USEASM_OPFLAGS1_PRED_SHIFT;
+	switch (uPred)
+	{
+		case USEASM_PRED_NONE:	break;
+		case USEASM_PRED_P0:
+		case USEASM_PRED_NEGP0:	AddOperand(asOperands, puCount, USEPERF_BANK_PREDICATE, 0, 1, IMG_FALSE, IMG_FALSE); break;
+		case USEASM_PRED_P1:
+		case USEASM_PRED_NEGP1:	AddOperand(asOperands, puCount, USEPERF_BANK_PREDICATE, 1, 1, IMG_FALSE, IMG_FALSE); break;
+		case USEASM_PRED_P2:
+		case USEASM_PRED_NEGP2:	AddOperand(asOperands, puCount, USEPERF_BANK_PREDICATE, 2, 1, IMG_FALSE, IMG_FALSE); break;
+		case USEASM_PRED_P3:	AddOperand(asOperands, puCount, USEPERF_BANK_PREDICATE, 3, 1, IMG_FALSE, IMG_FALSE); break;
+		default:				AddOperand(asOperands, puCount, USEPERF_BANK_PREDICATE, 0, EURASIA_USE_PREDICATE_BANK_SIZE, IMG_FALSE, IMG_FALSE); break;
+	}
+
+	return uIssues;
+}
+
+/*****************************************************************************
+ FUNCTION	: GetDRC
+
+ PURPOSE	: Gets the dependent read counter used by a load, sample or wait.
+
+ PARAMETERS	: psInst			- Decoded instruction.
+
+ RETURNS	: The DRC number.
+*****************************************************************************/
+static IMG_UINT32 GetDRC(PUSE_INST psInst)
+{
+	IMG_UINT32	uArg;
+
+	for (uArg = 0; uArg < USE_MAX_ARGUMENTS; uArg++)
+	{
+		if (psInst->asArg[uArg].uType == USEASM_REGTYPE_DRC)
+		{
+			return psInst->asArg[uArg].uNumber % EURASIA_USE_DRC_BANK_SIZE;
+		}
+	}
+	return 0;
+}
+
+/*****************************************************************************
+ FUNCTION	: GetBranchTarget
+
+ PURPOSE	: Gets the instruction a branch jumps to.
+
+ PARAMETERS	: psParams			- Estimator parameters.
+			  psInst			- Decoded BA or BR instruction.
+			  uInst				- Index of the branch.
+			  uInstCount		- Number of instructions in the program.
+
+ RETURNS	: The target, or USEPERF_UNDEF if it is outside the program.
+*****************************************************************************/
+static IMG_UINT32 GetBranchTarget(PCUSEPERF_PARAMS	psParams,
+								  PUSE_INST			psInst,
+								  IMG_UINT32		uInst,
+								  IMG_UINT32		uInstCount)
+{
+	IMG_UINT32	uTarget;
+
+	if (psInst->uOpcode == USEASM_OP_BR)
+	{
+		uTarget = (IMG_UINT32)((IMG_INT32)uInst + (IMG_INT32)psInst->asArg[0].uNumber);
+	}
+	else
+	{
+		uTarget = psInst->asArg[0].uNumber - psParams->uCodeOffset;
+	}
+
+	return (uTarget < uInstCount) ? uTarget : USEPERF_UNDEF;
+}
+
+/*****************************************************************************
+ FUNCTION	: CountBankConflicts
+
+ PURPOSE	: Counts the unified store sources of an instruction which read
+			  a different register from a bank another source has already
+			  read from.
+
+ PARAMETERS	: asOperands		- Operands of the instruction.
+			  uCount			- Number of operands.
+
+ RETURNS	: The number of conflicting reads.
+*****************************************************************************/
+static IMG_UINT32 CountBankConflicts(PUSEPERF_OPERAND asOperands, IMG_UINT32 uCount)
+{
+	IMG_UINT32	uConflicts = 0;
+	IMG_UINT32	uOp;
+
+	for (uOp = 0; uOp < uCount; uOp++)
+	{
+		PUSEPERF_OPERAND	psOp = &asOperands[uOp];
+		IMG_BOOL			bNew = IMG_TRUE;
+		IMG_BOOL			bBankUsed = IMG_FALSE;
+		IMG_UINT32			uPrev;
+
+		if (!psOp->bUnifiedStore)
+		{
+			continue;
+		}
+		for (uPrev = 0; uPrev < uOp; uPrev++)
+		{
+			PUSEPERF_OPERAND	psPrev = &asOperands[uPrev];
+
+			if (!psPrev->bUnifiedStore ||
+				(psPrev->uFirst % USEPERF_UNIFIED_STORE_BANKS) != (psOp->uFirst % USEPERF_UNIFIED_STORE_BANKS))
+			{
+				continue;
+			}
+			if (psPrev->eBank == psOp->eBank && psPrev->uFirst == psOp->uFirst)
+			{
+				bNew = IMG_FALSE;
+				break;
+			}
+			bBankUsed = IMG_TRUE;
+		}
+		if (bNew && bBankUsed)
+		{
+			uConflicts++;
+		}
+	}
+	return uConflicts;
+}
+
+/*****************************************************************************
+ FUNCTION	: ResetRegState
+
+ PURPOSE	: Marks every register as available at the start of a block.
+
+ PARAMETERS	: psRegState		- Register timing.
+
+ RETURNS	: Nothing.
+*****************************************************************************/
+static IMG_VOID ResetRegState(PUSEPERF_REGSTATE psRegState)
+{
+	IMG_UINT32	uDRC;
+
+	UseAsm_MemSet(psRegState->aauReady, 0, sizeof(psRegState->aauReady));
+	UseAsm_MemSet(psRegState->aauDepth, 0, sizeof(psRegState->aauDepth));
+	UseAsm_MemSet(psRegState->aauWriter, 0xFF, sizeof(psRegState->aauWriter));
+	for (uDRC = 0; uDRC < EURASIA_USE_DRC_BANK_SIZE; uDRC++)
+	{
+		psRegState->auDRCReady[uDRC] = 0;
+		psRegState->auDRCDepth[uDRC] = 0;
+		psRegState->auDRCWriter[uDRC] = USEPERF_UNDEF;
+	}
+}
+
+/*****************************************************************************
+ FUNCTION	: TimeBlock
+
+ PURPOSE	: Times the instructions in a basic block.
+
+ PARAMETERS	: psParams			- Estimator parameters.
+			  asDecoded			- Decoded instructions.
+			  psProgram			- Program being estimated.
+			  psBlock			- Block to time.
+			  psRegState		- Scratch register timing.
+
+ RETURNS	: Nothing.
+*****************************************************************************/
+static IMG_VOID TimeBlock(PCUSEPERF_PARAMS	psParams,
+						  PUSEPERF_DECODED	asDecoded,
+						  PUSEPERF_PROGRAM	psProgram,
+						  PUSEPERF_BLOCK	psBlock,
+						  PUSEPERF_REGSTATE	psRegState)
+{
+	IMG_UINT32	uTime = 0;
+	IMG_UINT32	uInst;
+
+	ResetRegState(psRegState);
+
+	psBlock->uCriticalPath = 0;
+	psBlock->uCriticalPathEnd = USEPERF_UNDEF;
+
+	for (uInst = psBlock->uFirstInst; uInst < psBlock->uFirstInst + psBlock->uInstCount; uInst++)
+	{
+		PUSEPERF_INST		psPerfInst = &psProgram->psInsts[uInst];
+		PUSE_INST			psInst = &asDecoded[uInst].sInst;
+		USEPERF_OPERAND		asOperands[USEPERF_MAX_OPERANDS];
+		IMG_UINT32			uOpCount = 0;
+		IMG_UINT32			uIssue = uTime;
+		IMG_UINT32			uDepth = 0;
+		IMG_UINT32			uPred = USEPERF_UNDEF;
+		IMG_UINT32			uLatency;
+		IMG_UINT32			uReady, uEndDepth;
+		IMG_UINT32			uOp;
+
+		psBlock->uIssueCycles += psPerfInst->uIssueCycles;
+
+		if (psPerfInst->bInvalid)
+		{
+			psPerfInst->uIssueTime = uTime;
+			psPerfInst->uReadyTime = uTime + 1;
+			psPerfInst->uCriticalPred = USEPERF_UNDEF;
+			uTime++;
+			continue;
+		}
+
+		GetOperands(psInst, psPerfInst->eClass, asOperands, &uOpCount);
+		if (psPerfInst->bDualIssue)
+		{
+			GetOperands(&asDecoded[uInst].sCoInst, GetInstClass(&asDecoded[uInst].sCoInst), asOperands, &uOpCount);
+		}
+
+		psPerfInst->uBankConflicts = CountBankConflicts(asOperands, uOpCount);
+		psBlock->uBankConflicts += psPerfInst->uBankConflicts;
+
+		/*
+			Wait for every source.
+		*/
+		for (uOp = 0; uOp < uOpCount; uOp++)
+		{
+			PUSEPERF_OPERAND	psOp = &asOperands[uOp];
+			IMG_UINT32			uReg;
+
+			if (psOp->bDest)
+			{
+				continue;
+			}
+			for (uReg = psOp->uFirst; uReg < psOp->uFirst + psOp->uCount; uReg++)
+			{
+				if (psRegState->aauReady[psOp->eBank][uReg] > uIssue)
+				{
+					uIssue = psRegState->aauReady[psOp->eBank][uReg];
+				}
+				if (psRegState->aauWriter[psOp->eBank][uReg] != USEPERF_UNDEF &&
+					(uPred == USEPERF_UNDEF || psRegState->aauDepth[psOp->eBank][uReg] > uDepth))
+				{
+					uDepth = psRegState->aauDepth[psOp->eBank][uReg];
+					uPred = psRegState->aauWriter[psOp->eBank][uReg];
+				}
+			}
+		}
+
+		/*
+			Waits for data from memory complete when the data has arrived.
+		*/
+		if (psInst->uOpcode == USEASM_OP_WDF || psInst->uOpcode == USEASM_OP_IDF)
+		{
+			IMG_UINT32	uDRC = GetDRC(psInst);
+
+			if (psRegState->auDRCReady[uDRC] > uIssue)
+			{
+				uIssue = psRegState->auDRCReady[uDRC];
+			}
+			if (psRegState->auDRCWriter[uDRC] != USEPERF_UNDEF &&
+				(uPred == USEPERF_UNDEF || psRegState->auDRCDepth[uDRC] > uDepth))
+			{
+				uDepth = psRegState->auDRCDepth[uDRC];
+				uPred = psRegState->auDRCWriter[uDRC];
+			}
+		}
+
+		switch (psPerfInst->eClass)
+		{
+			case USEPERF_CLASS_TEXTURE:	uLatency = psParams->uTextureLatency; break;
+			case USEPERF_CLASS_LOAD:	uLatency = psParams->uMemoryLatency; break;
+			default:					uLatency = g_asClassDesc[psPerfInst->eClass].uLatency; break;
+		}
+		if (uLatency == 0)
+		{
+			uLatency = 1;
+		}
+
+		uReady = uIssue + psPerfInst->uIssueCycles + uLatency - 1;
+		uEndDepth = uDepth + psPerfInst->uIssueCycles + uLatency - 1;
+
+		psPerfInst->uIssueTime = uIssue;
+		psPerfInst->uReadyTime = uReady;
+		psPerfInst->uCriticalPred = uPred;
+
+		/*
+			Record the results.
+		*/
+		for (uOp = 0; uOp < uOpCount; uOp++)
+		{
+			PUSEPERF_OPERAND	psOp = &asOperands[uOp];
+			IMG_UINT32			uReg;
+
+			if (!psOp->bDest)
+			{
+				continue;
+			}
+			for (uReg = psOp->uFirst; uReg < psOp->uFirst + psOp->uCount; uReg++)
+			{
+				psRegState->aauReady[psOp->eBank][uReg] = uReady;
+				psRegState->aauDepth[psOp->eBank][uReg] = uEndDepth;
+				psRegState->aauWriter[psOp->eBank][uReg] = uInst;
+			}
+		}
+		if (psPerfInst->eClass == USEPERF_CLASS_TEXTURE || psPerfInst->eClass == USEPERF_CLASS_LOAD)
+		{
+			IMG_UINT32	uDRC = GetDRC(psInst);
+
+			if (uReady >= psRegState->auDRCReady[uDRC])
+			{
+				psRegState->auDRCReady[uDRC] = uReady;
+			}
+			if (psRegState->auDRCWriter[uDRC] == USEPERF_UNDEF || uEndDepth >= psRegState->auDRCDepth[uDRC])
+			{
+				psRegState->auDRCDepth[uDRC] = uEndDepth;
+				psRegState->auDRCWriter[uDRC] = uInst;
+			}
+		}
+
+		if (uEndDepth > psBlock->uCriticalPath || psBlock->uCriticalPathEnd == USEPERF_UNDEF)
+		{
+			psBlock->uCriticalPath = uEndDepth;
+			psBlock->uCriticalPathEnd = uInst;
+		}
+
+		switch (psPerfInst->eClass)
+		{
+			case USEPERF_CLASS_TEXTURE:	psBlock->uTextureSamples++; break;
+			case USEPERF_CLASS_WAIT:	psBlock->uDeschedPoints++; break;
+			default:					break;
+		}
+		if (psPerfInst->bDualIssue)
+		{
+			psBlock->uDualIssued++;
+		}
+		if (psPerfInst->bEfo)
+		{
+			psBlock->uEfos++;
+		}
+
+		uTime = uIssue + psPerfInst->uIssueCycles;
+	}
+
+	psBlock->uLatencyCycles = uTime;
+}
+
+/*****************************************************************************
+ FUNCTION	: FindLongestPath
+
+ PURPOSE	: Finds the most expensive path from a block to the end of the
+			  program (or of the subroutine containing the block).
+
+ PARAMETERS	: psProgram			- Program being estimated.
+			  asPath			- Path totals for each block.
+			  abCall			- TRUE for blocks ending in a call.
+			  uBlock			- Block to start from.
+
+ RETURNS	: Nothing.
+*****************************************************************************/
+static IMG_VOID FindLongestPath(PUSEPERF_PROGRAM	psProgram,
+								PUSEPERF_PATH		asPath,
+								IMG_PBOOL			abCall,
+								IMG_UINT32			uBlock)
+{
+	PUSEPERF_BLOCK	psBlock = &psProgram->psBlocks[uBlock];
+	PUSEPERF_PATH	psPath = &asPath[uBlock];
+	IMG_UINT32		uSucc;
+
+	psPath->bOnStack = IMG_TRUE;
+	psPath->uBestSucc = USEPERF_UNDEF;
+	psPath->uInsts = psBlock->uInstCount;
+	psPath->uIssueCycles = psBlock->uIssueCycles;
+	psPath->uLatencyCycles = psBlock->uLatencyCycles;
+	psPath->uBankConflicts = psBlock->uBankConflicts;
+
+	for (uSucc = 0; uSucc < psBlock->uSuccCount; uSucc++)
+	{
+		IMG_UINT32	uSuccBlock = psBlock->auSucc[uSucc];
+
+		if (asPath[uSuccBlock].bOnStack)
+		{
+			/*
+				A loop: count the body once.
+			*/
+			psProgram->uLoops++;
+			continue;
+		}
+		if (!asPath[uSuccBlock].bDone)
+		{
+			FindLongestPath(psProgram, asPath, abCall, uSuccBlock);
+		}
+	}
+
+	if (abCall[uBlock])
+	{
+		/*
+			The subroutine runs and then returns to the next block.
+		*/
+		for (uSucc = 0; uSucc < psBlock->uSuccCount; uSucc++)
+		{
+			PUSEPERF_PATH	psSuccPath = &asPath[psBlock->auSucc[uSucc]];
+
+			if (!psSuccPath->bDone)
+			{
+				continue;
+			}
+			psPath->uInsts += psSuccPath->uInsts;
+			psPath->uIssueCycles += psSuccPath->uIssueCycles;
+			psPath->uLatencyCycles += psSuccPath->uLatencyCycles;
+			psPath->uBankConflicts += psSuccPath->uBankConflicts;
+		}
+	}
+	else
+	{
+		PUSEPERF_PATH	psBest = IMG_NULL;
+
+		for (uSucc = 0; uSucc < psBlock->uSuccCount; uSucc++)
+		{
+			PUSEPERF_PATH	psSuccPath = &asPath[psBlock->auSucc[uSucc]];
+
+			if (!psSuccPath->bDone)
+			{
+				continue;
+			}
+			if (
+					psBest == IMG_NULL ||
+					psSuccPath->uLatencyCycles > psBest->uLatencyCycles ||
+					(psSuccPath->uLatencyCycles == psBest->uLatencyCycles && psSuccPath->uIssueCycles > psBest->uIssueCycles)
+			   )
+			{
+				psBest = psSuccPath;
+				psPath->uBestSucc = psBlock->auSucc[uSucc];
+			}
+		}
+		if (psBest != IMG_NULL)
+		{
+			psPath->uInsts += psBest->uInsts;
+			psPath->uIssueCycles += psBest->uIssueCycles;
+			psPath->uLatencyCycles += psBest->uLatencyCycles;
+			psPath->uBankConflicts += psBest->uBankConflicts;
+		}
+	}
+
+	psPath->bOnStack = IMG_FALSE;
+	psPath->bDone = IMG_TRUE;
+}
+
+/*****************************************************************************
+ FUNCTION	: MarkLongestPath
+
+ PURPOSE	: Flags the blocks on the longest path from a block.
+
+ PARAMETERS	: psProgram			- Program being estimated.
+			  asPath			- Path totals for each block.
+			  abCall			- TRUE for blocks ending in a call.
+			  uBlock			- Block to start from.
+
+ RETURNS	: Nothing.
+*****************************************************************************/
+static IMG_VOID MarkLongestPath(PUSEPERF_PROGRAM	psProgram,
+								PUSEPERF_PATH		asPath,
+								IMG_PBOOL			abCall,
+								IMG_UINT32			uBlock)
+{
+	while (uBlock != USEPERF_UNDEF && !psProgram->psBlocks[uBlock].bOnLongestPath)
+	{
+		PUSEPERF_BLOCK	psBlock = &psProgram->psBlocks[uBlock];
+
+		psBlock->bOnLongestPath = IMG_TRUE;
+
+		if (abCall[uBlock] && psBlock->uSuccCount == 2)
+		{
+			MarkLongestPath(psProgram, asPath, abCall, psBlock->auSucc[1]);
+			uBlock = psBlock->auSucc[0];
+		}
+		else if (abCall[uBlock] && psBlock->uSuccCount == 1)
+		{
+			uBlock = psBlock->auSucc[0];
+		}
+		else
+		{
+			uBlock = asPath[uBlock].uBestSucc;
+		}
+	}
+}
+
+/*****************************************************************************
+ FUNCTION	: UsePerfAnalyse
+
+ PURPOSE	: Estimates the cost of a USE program.
+
+ PARAMETERS	: psTarget			- Target processor.
+			  psParams			- Estimator parameters.
+			  uInstCount		- Number of instructions.
+			  puInsts			- Instructions (two dwords each, as in
+								  memory).
+			  psProgram			- Returns the estimate. Free it with
+								  UsePerfFree.
+
+ RETURNS	: IMG_FALSE if out of memory.
+*****************************************************************************/
+IMG_INTERNAL
+IMG_BOOL IMG_CALLCONV UsePerfAnalyse(PCSGX_CORE_DESC		psTarget,
+									 PCUSEPERF_PARAMS	psParams,
+									 IMG_UINT32			uInstCount,
+									 IMG_PUINT32		puInsts,
+									 PUSEPERF_PROGRAM	psProgram)
+{
+	USEDIS_RUNTIME_STATE	sRuntimeState;
+	PUSEPERF_DECODED		asDecoded;
+	PUSEPERF_REGSTATE		psRegState;
+	PUSEPERF_PATH			asPath;
+	IMG_PBOOL				abLeader;
+	IMG_PBOOL				abCall;
+	IMG_PBOOL				abReached;
+	IMG_BOOL				bSuccess;
+	IMG_PUINT32				auBlockOfInst;
+	IMG_UINT32				uInst, uBlock;
+
+	UseAsm_MemSet(psProgram, 0, sizeof(*psProgram));
+	if (uInstCount == 0)
+	{
+		return IMG_TRUE;
+	}
+
+	psProgram->uInstCount = uInstCount;
+	psProgram->psInsts = UseAsm_Malloc(sizeof(USEPERF_INST) * uInstCount);
+	psProgram->psBlocks = UseAsm_Malloc(sizeof(USEPERF_BLOCK) * uInstCount);
+	asDecoded = UseAsm_Malloc(sizeof(USEPERF_DECODED) * uInstCount);
+	abLeader = UseAsm_Malloc(sizeof(IMG_BOOL) * (uInstCount + 1));
+	auBlockOfInst = UseAsm_Malloc(sizeof(IMG_UINT32) * uInstCount);
+	psRegState = UseAsm_Malloc(sizeof(USEPERF_REGSTATE));
+	if (
+			psProgram->psInsts == IMG_NULL ||
+			psProgram->psBlocks == IMG_NULL ||
+			asDecoded == IMG_NULL ||
+			abLeader == IMG_NULL ||
+			auBlockOfInst == IMG_NULL ||
+			psRegState == IMG_NULL
+	   )
+	{
+		if (asDecoded != IMG_NULL)
+		{
+			UseAsm_Free(asDecoded);
+		}
+		if (abLeader != IMG_NULL)
+		{
+			UseAsm_Free(abLeader);
+		}
+		if (auBlockOfInst != IMG_NULL)
+		{
+			UseAsm_Free(auBlockOfInst);
+		}
+		if (psRegState != IMG_NULL)
+		{
+			UseAsm_Free(psRegState);
+		}
+		UsePerfFree(psProgram);
+		return IMG_FALSE;
+	}
+	UseAsm_MemSet(psProgram->psInsts, 0, sizeof(USEPERF_INST) * uInstCount);
+	UseAsm_MemSet(psProgram->psBlocks, 0, sizeof(USEPERF_BLOCK) * uInstCount);
+	UseAsm_MemSet(abLeader, 0, sizeof(IMG_BOOL) * (uInstCount + 1));
+
+	sRuntimeState.eColourFormatControl = USEDIS_FORMAT_CONTROL_STATE_ON;
+	sRuntimeState.eEFOFormatControl = USEDIS_FORMAT_CONTROL_STATE_OFF;
+
+	/*
+		Decode and classify the instructions, and find where the basic
+		blocks start.
+	*/
+	abLeader[0] = IMG_TRUE;
+	for (uInst = 0; uInst < uInstCount; uInst++)
+	{
+		PUSEPERF_INST		psPerfInst = &psProgram->psInsts[uInst];
+		PUSE_INST			psInst = &asDecoded[uInst].sInst;
+		IMG_UINT32			uDestWidth, uSrcWidth;
+
+		psInst->psNext = &asDecoded[uInst].sCoInst;
+		if (UseDecodeInstruction(psTarget, puInsts[uInst * 2 + 0], puInsts[uInst * 2 + 1], &sRuntimeState, psInst) != USEDISASM_OK)
+		{
+			psPerfInst->eClass = USEPERF_CLASS_ALU;
+			psPerfInst->uIssueCycles = 1;
+			psPerfInst->bInvalid = IMG_TRUE;
+			psProgram->uInvalidInsts++;
+			continue;
+		}
+
+		psPerfInst->eClass = GetInstClass(psInst);
+		psPerfInst->bEfo = (IMG_BOOL)(psInst->uOpcode == USEASM_OP_EFO);
+		psPerfInst->bDualIssue = (IMG_BOOL)((psInst->uFlags1 & USEASM_OPFLAGS1_MAINISSUE) != 0);
+		GetRepeats(psInst, &psPerfInst->uIssueCycles, &uDestWidth, &uSrcWidth);
+		if (psPerfInst->bDualIssue)
+		{
+			IMG_UINT32	uCoIssues;
+
+			/*
+				Both halves of a dual-issued pair go down the pipeline together.
+			*/
+			GetRepeats(&asDecoded[uInst].sCoInst, &uCoIssues, &uDestWidth, &uSrcWidth);
+			if (uCoIssues > psPerfInst->uIssueCycles)
+			{
+				psPerfInst->uIssueCycles = uCoIssues;
+			}
+		}
+
+		if (psPerfInst->eClass == USEPERF_CLASS_BRANCH && psInst->uOpcode != USEASM_OP_BEXCEPTION)
+		{
+			if (psInst->uOpcode != USEASM_OP_LAPC)
+			{
+				IMG_UINT32	uTarget = GetBranchTarget(psParams, psInst, uInst, uInstCount);
+
+				if (uTarget != USEPERF_UNDEF)
+				{
+					abLeader[uTarget] = IMG_TRUE;
+				}
+			}
+			abLeader[uInst + 1] = IMG_TRUE;
+		}
+		if (psInst->uFlags1 & USEASM_OPFLAGS1_END)
+		{
+			abLeader[uInst + 1] = IMG_TRUE;
+		}
+	}
+
+	/*
+		Form the blocks.
+	*/
+	for (uInst = 0; uInst < uInstCount; uInst++)
+	{
+		if (abLeader[uInst])
+		{
+			psProgram->psBlocks[psProgram->uBlockCount].uFirstInst = uInst;
+			psProgram->uBlockCount++;
+		}
+		psProgram->psBlocks[psProgram->uBlockCount - 1].uInstCount++;
+		auBlockOfInst[uInst] = psProgram->uBlockCount - 1;
+	}
+
+	abCall = abLeader;
+	UseAsm_MemSet(abCall, 0, sizeof(IMG_BOOL) * psProgram->uBlockCount);
+
+	/*
+		Link the blocks and time them.
+	*/
+	for (uBlock = 0; uBlock < psProgram->uBlockCount; uBlock++)
+	{
+		PUSEPERF_BLOCK	psBlock = &psProgram->psBlocks[uBlock];
+		IMG_UINT32		uLast = psBlock->uFirstInst + psBlock->uInstCount - 1;
+		PUSE_INST		psLast = &asDecoded[uLast].sInst;
+		IMG_BOOL		bFallThrough = IMG_TRUE;
+
+		if (psProgram->psInsts[uLast].bInvalid)
+		{
+			/* Nothing is known about an undecodable instruction: assume it falls through. */
+		}
+		else if (psLast->uFlags1 & USEASM_OPFLAGS1_END)
+		{
+			bFallThrough = IMG_FALSE;
+		}
+		else if (psLast->uOpcode == USEASM_OP_LAPC || psLast->uOpcode == USEASM_OP_BEXCEPTION)
+		{
+			IMG_UINT32	uPred = (psLast->uFlags1 & ~USEASM_OPFLAGS1_PRED_CLRMSK) >> USEASM_OPFLAGS1_PRED_SHIFT;
+
+			bFallThrough = (IMG_BOOL)(uPred != USEASM_PRED_NONE);
+		}
+		else if (psLast->uOpcode == USEASM_OP_BA || psLast->uOpcode == USEASM_OP_BR)
+		{
+			IMG_UINT32	uPred = (psLast->uFlags1 & ~USEASM_OPFLAGS1_PRED_CLRMSK) >> USEASM_OPFLAGS1_PRED_SHIFT;
+			IMG_UINT32	uTarget = GetBranchTarget(psParams, psLast, uLast, uInstCount);
+			IMG_BOOL	bCall = (IMG_BOOL)((psLast->uFlags1 & USEASM_OPFLAGS1_SAVELINK) != 0);
+
+			if (bCall)
+			{
+				abCall[uBlock] = IMG_TRUE;
+			}
+			else if (uPred == USEASM_PRED_NONE)
+			{
+				bFallThrough = IMG_FALSE;
+			}
+
+			/*
+				For a call the return block is the first successor and the
+				subroutine the second.
+			*/
+			if (bCall && bFallThrough && uLast + 1 < uInstCount)
+			{
+				psBlock->auSucc[psBlock->uSuccCount++] = auBlockOfInst[uLast + 1];
+				bFallThrough = IMG_FALSE;
+			}
+			if (uTarget != USEPERF_UNDEF)
+			{
+				psBlock->auSucc[psBlock->uSuccCount++] = auBlockOfInst[uTarget];
+			}
+		}
+
+		if (bFallThrough && uLast + 1 < uInstCount)
+		{
+			IMG_UINT32	uNext = auBlockOfInst[uLast + 1];
+
+			if (psBlock->uSuccCount == 0 || psBlock->auSucc[0] != uNext)
+			{
+				psBlock->auSucc[psBlock->uSuccCount++] = uNext;
+			}
+		}
+
+		TimeBlock(psParams, asDecoded, psProgram, psBlock, psRegState);
+	}
+
+	/*
+		Find the longest path from the start of the program. Blocks which
+		nothing branches to or falls into after the first are the starts
+		of later phases and run after it.
+	*/
+	asPath = UseAsm_Malloc(sizeof(USEPERF_PATH) * psProgram->uBlockCount);
+	abReached = UseAsm_Malloc(sizeof(IMG_BOOL) * psProgram->uBlockCount);
+	bSuccess = (IMG_BOOL)(asPath != IMG_NULL && abReached != IMG_NULL);
+	if (bSuccess)
+	{
+		UseAsm_MemSet(asPath, 0, sizeof(USEPERF_PATH) * psProgram->uBlockCount);
+		UseAsm_MemSet(abReached, 0, sizeof(IMG_BOOL) * psProgram->uBlockCount);
+		for (uBlock = 0; uBlock < psProgram->uBlockCount; uBlock++)
+		{
+			IMG_UINT32	uSucc;
+
+			for (uSucc = 0; uSucc < psProgram->psBlocks[uBlock].uSuccCount; uSucc++)
+			{
+				abReached[psProgram->psBlocks[uBlock].auSucc[uSucc]] = IMG_TRUE;
+			}
+		}
+
+		for (uBlock = 0; uBlock < psProgram->uBlockCount; uBlock++)
+		{
+			PUSEPERF_PATH	psPath = &asPath[uBlock];
+
+			if (uBlock != 0 && abReached[uBlock])
+			{
+				continue;
+			}
+
+			FindLongestPath(psProgram, asPath, abCall, uBlock);
+			MarkLongestPath(psProgram, asPath, abCall, uBlock);
+
+			psProgram->uPathInsts += psPath->uInsts;
+			psProgram->uPathIssueCycles += psPath->uIssueCycles;
+			psProgram->uPathLatencyCycles += psPath->uLatencyCycles;
+			psProgram->uPathBankConflicts += psPath->uBankConflicts;
+		}
+	}
+
+	if (asPath != IMG_NULL)
+	{
+		UseAsm_Free(asPath);
+	}
+	if (abReached != IMG_NULL)
+	{
+		UseAsm_Free(abReached);
+	}
+	UseAsm_Free(asDecoded);
+	UseAsm_Free(abLeader);
+	UseAsm_Free(auBlockOfInst);
+	UseAsm_Free(psRegState);
+
+	if (!bSuccess)
+	{
+		UsePerfFree(psProgram);
+	}
+	return bSuccess;
+}
+
+/*****************************************************************************
+ FUNCTION	: UsePerfFree
+
+ PURPOSE	: Frees an estimate made by UsePerfAnalyse.
+
+ PARAMETERS	: psProgram			- Estimate to free.
+
+ RETURNS	: Nothing.
+*****************************************************************************/
+IMG_INTERNAL
+IMG_VOID IMG_CALLCONV UsePerfFree(PUSEPERF_PROGRAM psProgram)
+{
+	if (psProgram->psInsts != IMG_NULL)
+	{
+		UseAsm_Free(psProgram->psInsts);
+	}
+	if (psProgram->psBlocks != IMG_NULL)
+	{
+		UseAsm_Free(psProgram->psBlocks);
+	}
+	UseAsm_MemSet(psProgram, 0, sizeof(*psProgram));
+}
+
+/******************************************************************************
+ End of file (useperf.c)
+******************************************************************************/
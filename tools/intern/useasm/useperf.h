@@ -0,0 +1,150 @@
+/******************************************************************************
+ * Name         : useperf.h
+ * Title        : Static USE performance estimator
+ *
+ * Copyright    : 2002-2010 by Imagination Technologies Limited.
+ *              : All rights reserved. No part of this software, either
+ *              : material or conceptual may be copied or distributed,
+ *              : transmitted, transcribed, stored in a retrieval system or
+ *              : translated into any human or computer language in any form
+ *              : by any means, electronic, mechanical, manual or otherwise,
+ *              : or disclosed to third parties without the express written
+ *              : permission of Imagination Technologies Limited,
+ *              : Home Park Estate, Kings Langley, Hertfordshire,
+ *              : WD4 8LZ, U.K.
+ *
+ * Modifications:-
+ * $Log: useperf.h $
+ *****************************************************************************/
+
+#if !defined(__USEASM_USEPERF_H)
+#define __USEASM_USEPERF_H
+
+#include "img_defs.h"
+#include "img_types.h"
+
+/*
+	Classes of instruction with different issue rules.
+*/
+typedef enum _USEPERF_CLASS_
+{
+	USEPERF_CLASS_ALU,			/* Single cycle arithmetic, moves, tests and packs. */
+	USEPERF_CLASS_COMPLEX,		/* Complex ops: rcp, rsq, log, exp, sqrt, sin, cos. */
+	USEPERF_CLASS_TEXTURE,		/* Texture samples; the result arrives through a DRC. */
+	USEPERF_CLASS_LOAD,			/* Memory loads; the result arrives through a DRC. */
+	USEPERF_CLASS_STORE,		/* Memory stores. */
+	USEPERF_CLASS_WAIT,			/* WDF, IDF, LOCK, RELEASE, PHAS: points where the task can be descheduled. */
+	USEPERF_CLASS_BRANCH,		/* BA, BR, LAPC. */
+	USEPERF_CLASS_EMIT,			/* EMITPIXEL, EMITVERTEX, ... */
+	USEPERF_CLASS_NOP,			/* NOP and padding. */
+	USEPERF_CLASS_COUNT
+} USEPERF_CLASS;
+
+/*
+	Latencies the estimate depends on which can't be known from the code.
+*/
+typedef struct _USEPERF_PARAMS_
+{
+	/* Cycles from issuing a texture sample to the data being written. */
+	IMG_UINT32	uTextureLatency;
+	/* Cycles from issuing a memory load to the data being written. */
+	IMG_UINT32	uMemoryLatency;
+	/* Offset of the first instruction for targets of absolute branches. */
+	IMG_UINT32	uCodeOffset;
+} USEPERF_PARAMS, *PUSEPERF_PARAMS;
+
+typedef USEPERF_PARAMS const* PCUSEPERF_PARAMS;
+
+#define USEPERF_DEFAULT_TEXTURE_LATENCY		(60)
+#define USEPERF_DEFAULT_MEMORY_LATENCY		(100)
+
+#define USEPERF_UNDEF						(0xFFFFFFFFU)
+
+/*
+	Estimate for one hardware instruction.
+*/
+typedef struct _USEPERF_INST_
+{
+	USEPERF_CLASS	eClass;
+	/* Number of issue slots used (the repeat count). */
+	IMG_UINT32		uIssueCycles;
+	/* Extra unified store reads from a register bank already read by the instruction. */
+	IMG_UINT32		uBankConflicts;
+	/* Cycle (relative to the start of the block) the instruction issues when a task runs alone. */
+	IMG_UINT32		uIssueTime;
+	/* Cycle its results are available. */
+	IMG_UINT32		uReadyTime;
+	/* Previous instruction in the longest dependency chain ending here, or USEPERF_UNDEF. */
+	IMG_UINT32		uCriticalPred;
+	/* Two operations issued together. */
+	IMG_BOOL		bDualIssue;
+	IMG_BOOL		bEfo;
+	IMG_BOOL		bInvalid;
+} USEPERF_INST, *PUSEPERF_INST;
+
+/*
+	Estimate for one basic block.
+*/
+typedef struct _USEPERF_BLOCK_
+{
+	IMG_UINT32	uFirstInst;
+	IMG_UINT32	uInstCount;
+	/* Successor blocks. */
+	IMG_UINT32	uSuccCount;
+	IMG_UINT32	auSucc[2];
+	/* Issue slots used by the block: the cost when other tasks hide all latencies. */
+	IMG_UINT32	uIssueCycles;
+	IMG_UINT32	uBankConflicts;
+	/* Cycles for a single task to run the block in order, waiting for every result. */
+	IMG_UINT32	uLatencyCycles;
+	/* Length of the longest dependency chain in the block and the instruction ending it. */
+	IMG_UINT32	uCriticalPath;
+	IMG_UINT32	uCriticalPathEnd;
+	IMG_UINT32	uDualIssued;
+	IMG_UINT32	uEfos;
+	IMG_UINT32	uTextureSamples;
+	IMG_UINT32	uDeschedPoints;
+	/* Is this block on the longest path through the program. */
+	IMG_BOOL	bOnLongestPath;
+} USEPERF_BLOCK, *PUSEPERF_BLOCK;
+
+/*
+	Estimate for a program.
+*/
+typedef struct _USEPERF_PROGRAM_
+{
+	IMG_UINT32		uInstCount;
+	PUSEPERF_INST	psInsts;
+	IMG_UINT32		uBlockCount;
+	PUSEPERF_BLOCK	psBlocks;
+	/* Instructions which couldn't be decoded. */
+	IMG_UINT32		uInvalidInsts;
+	/* Branches back to an earlier block. */
+	IMG_UINT32		uLoops;
+	/*
+		Totals along the longest path from the first block with each loop
+		body counted once: per pixel (or vertex) when the instances take it.
+	*/
+	IMG_UINT32		uPathInsts;
+	IMG_UINT32		uPathIssueCycles;
+	IMG_UINT32		uPathLatencyCycles;
+	IMG_UINT32		uPathBankConflicts;
+} USEPERF_PROGRAM, *PUSEPERF_PROGRAM;
+
+IMG_VOID IMG_CALLCONV UsePerfInitParams(PUSEPERF_PARAMS psParams);
+
+IMG_BOOL IMG_CALLCONV UsePerfAnalyse(PCSGX_CORE_DESC		psTarget,
+									 PCUSEPERF_PARAMS	psParams,
+									 IMG_UINT32			uInstCount,
+									 IMG_PUINT32		puInsts,
+									 PUSEPERF_PROGRAM	psProgram);
+
+IMG_VOID IMG_CALLCONV UsePerfFree(PUSEPERF_PROGRAM psProgram);
+
+IMG_PCHAR IMG_CALLCONV UsePerfClassName(USEPERF_CLASS eClass);
+
+#endif /* __USEASM_USEPERF_H */
+
+/******************************************************************************
+ End of file (useperf.h)
+******************************************************************************/
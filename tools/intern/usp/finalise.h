@@ -94,7 +94,9 @@ IMG_INTERNAL IMG_BOOL FinaliseTextureWriteList(PUSP_CONTEXT psContext,
 /*
 	Create a HW-shader from a finalised USP shader
 */
-PUSP_HW_SHADER CreateHWShader(PUSP_CONTEXT psContext, PUSP_SHADER psShader);
+PUSP_HW_SHADER CreateHWShader(PUSP_CONTEXT	psContext,
+							  PUSP_SHADER	psShader,
+							  IMG_PUINT32	puHWShaderSize);
 
 #endif	/* #ifndef _FINALISE_H_ */
 /*****************************************************************************
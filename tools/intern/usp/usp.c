@@ -40,6 +40,7 @@
 #include "uspshrd.h"
 #include "uspshader.h"
 #include "finalise.h"
+#include "usp_cache.h"
 
 #if defined(SHARED_LIBRARY_FOR_TEST_ONLY)
 #define EXPORT_FOR_TEST_ONLY
@@ -80,6 +81,13 @@ EXPORT_FOR_TEST_ONLY IMG_PVOID IMG_CALLCONV PVRUniPatchCreateContext(USP_MEMALLO
 	psContext->pfnFree	= pfnFree;
 	psContext->pfnPrint	= pfnPrint;
 
+	if	(!USPCacheCreate(psContext))
+	{
+		pfnPrint("PVRUniPatchCreateContext: Cache creation failed\n");
+		pfnFree(psContext);
+		return IMG_NULL;
+	}
+
 	return psContext;
 }
 
@@ -108,8 +116,11 @@ EXPORT_FOR_TEST_ONLY IMG_PVOID IMG_CALLCONV PVRUniPatchCreateShader(IMG_PVOID		p
 	if	(!psUSPShader)
 	{
 		USP_DBGPRINT(("PVRUniPatchCreateShader: Error creating USP shader\n"));
+		return IMG_NULL;
 	}
 
+	USPCacheSetupShader(psContext, psUSPShader, psPCShader);
+
 	return psUSPShader;
 }
 
@@ -320,12 +331,28 @@ EXPORT_FOR_TEST_ONLY PUSP_HW_SHADER IMG_CALLCONV PVRUniPatchFinaliseShader(
 	PUSP_CONTEXT	psContext;
 	PUSP_SHADER		psShader;
 	PUSP_HW_SHADER	psHWShader;
+	IMG_UINT32		uHWShaderSize;
+	USP_CACHE_KEY	sKey;
+	IMG_BOOL		bCacheable;
 	IMG_UINT32		uSmpIdx;
 
 	psContext	= (PUSP_CONTEXT)pvContext;
 	psShader	= (PUSP_SHADER)pvShader;
 	psHWShader	= IMG_NULL;
 
+	/*
+		Share the HW shader from an earlier identical finalisation if possible
+	*/
+	bCacheable = USPCacheBuildKey(psContext, psShader, &sKey);
+	if	(bCacheable)
+	{
+		psHWShader = USPCacheFindHWShader(psContext, &sKey);
+		if	(psHWShader)
+		{
+			return psHWShader;
+		}
+	}
+
 	/*
 		Initialize all texture control words as not set
 	*/
@@ -450,7 +477,7 @@ EXPORT_FOR_TEST_ONLY PUSP_HW_SHADER IMG_CALLCONV PVRUniPatchFinaliseShader(
 	/*
 		Generate the HW structure encapsulating the finalised shader code
 	*/
-	psHWShader = CreateHWShader(psContext, psShader);
+	psHWShader = CreateHWShader(psContext, psShader, &uHWShaderSize);
 	if	(!psHWShader)
 	{
 		USP_DBGPRINT(( "PVRUniPatchFinaliseShader: Failed to create HW shader\n"));
@@ -463,17 +490,19 @@ EXPORT_FOR_TEST_ONLY PUSP_HW_SHADER IMG_CALLCONV PVRUniPatchFinaliseShader(
 	if	(!ResetShader(psContext, psShader))
 	{
 		USP_DBGPRINT(( "PVRUniPatchFinaliseShader: Error resetting shader for finalisation\n"));
-		psContext->pfnFree(psHWShader);
+		psContext->pfnFree(USP_CACHE_ENTRY_FROM_HWSHADER(psHWShader));
 		return IMG_NULL;
 	}
 
+	USPCacheAddHWShader(psContext, bCacheable ? &sKey : IMG_NULL, psHWShader, uHWShaderSize);
+
 	return psHWShader;
 }
 
 /*****************************************************************************
  Name:		PVRUniPatchDestroyHWShader
 
- Purpose:	Destroys a HW executeable shader, previously created from a
+ Purpose:	Releases a HW executeable shader, previously created from a
 			runtime-patchable shader using PVRUniPatchFinaliseShader.
 
  Inputs:	pvContext	- The current USP execution context
@@ -482,6 +511,9 @@ EXPORT_FOR_TEST_ONLY PUSP_HW_SHADER IMG_CALLCONV PVRUniPatchFinaliseShader(
  Outputs:	none
 
  Returns:	none
+
+ Notes:		Unreferenced HW shaders are kept in the cache of the context that
+			created them, to be shared by later finalisations.
 *****************************************************************************/
 EXPORT_FOR_TEST_ONLY IMG_VOID IMG_CALLCONV PVRUniPatchDestroyHWShader(
 													IMG_PVOID		pvContext,
@@ -492,10 +524,69 @@ EXPORT_FOR_TEST_ONLY IMG_VOID IMG_CALLCONV PVRUniPatchDestroyHWShader(
 	psContext = (PUSP_CONTEXT)pvContext;
 	if	(psHWShader)
 	{		
-		psContext->pfnFree(psHWShader);
+		USPCacheReleaseHWShader(psContext, psHWShader);
 	}
 }
 
+/*****************************************************************************
+ Name:		PVRUniPatchSerialiseCache
+
+ Purpose:	Serialise the HW shaders cached by a context, so that a later run
+			can reuse them through PVRUniPatchLoadCache.
+
+ Inputs:	pvContext	- The current USP execution context
+			pvBuffer	- Buffer to write the data to, or IMG_NULL to query
+						  the size required
+			uBufferSize	- The size of the buffer (in bytes)
+			
+ Outputs:	none
+
+ Returns:	The size of the serialised data (in bytes), or 0 on failure
+*****************************************************************************/
+EXPORT_FOR_TEST_ONLY IMG_UINT32 IMG_CALLCONV PVRUniPatchSerialiseCache(
+													IMG_PVOID		pvContext,
+													IMG_PVOID		pvBuffer,
+													IMG_UINT32		uBufferSize)
+{
+	PUSP_CONTEXT psContext;
+
+	psContext = (PUSP_CONTEXT)pvContext;
+
+	return USPCacheSerialise(psContext, pvBuffer, uBufferSize);
+}
+
+/*****************************************************************************
+ Name:		PVRUniPatchLoadCache
+
+ Purpose:	Add HW shaders serialised by PVRUniPatchSerialiseCache to the
+			cache of a context.
+
+ Inputs:	pvContext	- The current USP execution context
+			pvData		- The serialised data
+			uDataSize	- The size of the serialised data (in bytes)
+			
+ Outputs:	none
+
+ Returns:	IMG_FALSE if the data is invalid or incompatible
+*****************************************************************************/
+EXPORT_FOR_TEST_ONLY IMG_BOOL IMG_CALLCONV PVRUniPatchLoadCache(
+													IMG_PVOID		pvContext,
+													IMG_PVOID		pvData,
+													IMG_UINT32		uDataSize)
+{
+	PUSP_CONTEXT psContext;
+
+	psContext = (PUSP_CONTEXT)pvContext;
+
+	if	(!USPCacheLoad(psContext, pvData, uDataSize))
+	{
+		USP_DBGPRINT(("PVRUniPatchLoadCache: Cache data rejected\n"));
+		return IMG_FALSE;
+	}
+
+	return IMG_TRUE;
+}
+
 /*****************************************************************************
  Name:		PVRUniPatchDestroyShader
 
@@ -563,6 +654,8 @@ EXPORT_FOR_TEST_ONLY IMG_VOID IMG_CALLCONV PVRUniPatchDestroyContext(IMG_PVOID p
 
 	psContext = (PUSP_CONTEXT)pvContext;
 
+	USPCacheDestroy(psContext);
+
 	psContext->pfnFree(psContext);
 }
 
@@ -528,16 +528,43 @@ IMG_BOOL IMG_CALLCONV PVRUniPatchSetPreambleInstCount(IMG_PVOID		pvContext,
 
 /*
 	Generate a HW-executeable version of the shader
+
+	NB: HW shaders are shared between all shaders finalised from identical
+		precompiled data with identical patch settings, and must be treated
+		as read-only by the caller.
 */
 PUSP_HW_SHADER IMG_CALLCONV PVRUniPatchFinaliseShader(IMG_PVOID pvContext,
 													  IMG_PVOID pvShader);
 
 /*
-	Free a HW-executable shader created by PVRUniPatchFinaliseShader
+	Release a HW-executable shader created by PVRUniPatchFinaliseShader
 */
 IMG_VOID IMG_CALLCONV PVRUniPatchDestroyHWShader(IMG_PVOID		pvContext,
 												 PUSP_HW_SHADER	psHWShader);
 
+/*
+	Identification of serialised finalised-shader cache data
+*/
+#define USP_CACHE_DATA_ID	(('U' << 24) | ('S' << 16) | ('P' << 8) | ('C' << 0))
+#define USP_CACHE_DATA_VER	((0x0001 << 16) | (USP_PC_SHADER_VER & 0xFFFF))
+
+/*
+	Serialise the cached HW shaders of a context, so that they can be reloaded
+	by a later run with PVRUniPatchLoadCache. Returns the number of bytes
+	written, or the number required if pvBuffer is IMG_NULL (0 on failure).
+*/
+IMG_UINT32 IMG_CALLCONV PVRUniPatchSerialiseCache(IMG_PVOID		pvContext,
+												  IMG_PVOID		pvBuffer,
+												  IMG_UINT32	uBufferSize);
+
+/*
+	Add HW shaders serialised by PVRUniPatchSerialiseCache to the cache of a
+	context.
+*/
+IMG_BOOL IMG_CALLCONV PVRUniPatchLoadCache(IMG_PVOID	pvContext,
+										   IMG_PVOID	pvData,
+										   IMG_UINT32	uDataSize);
+
 /*
 	Destroy a patcheable shader created by PVRUniPatchCreateShader
 */
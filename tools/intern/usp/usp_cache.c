@@ -0,0 +1,1270 @@
+/******************************************************************************
+ Name           : USP_CACHE.C
+
+ Title          : Cache of finalised HW shaders
+
+ C Author       : Joe Molleson
+
+ Created        : 02/01/2002
+
+ Copyright      : 2002-2006 by Imagination Technologies Limited. All rights reserved.
+                : No part of this software, either material or conceptual
+                : may be copied or distributed, transmitted, transcribed,
+                : stored in a retrieval system or translated into any
+                : human or computer language in any form by any means,
+                : electronic, mechanical, manual or other-wise, or
+                : disclosed to third parties without the express written
+                : permission of Imagination Technologies Limited, Unit 8, HomePark
+                : Industrial Estate, King's Langley, Hertfordshire,
+                : WD4 8LZ, U.K.
+
+ Description    : Shares HW shaders between USP shaders created from identical
+                  precompiled data and finalised with identical patch settings,
+                  and serialises them for reuse by later runs.
+
+ Program Type   : 32-bit DLL
+
+ Version        : $Revision: 1.0 $
+
+ Modifications  :
+ $Log: usp_cache.c $
+******************************************************************************/
+#include <stddef.h>
+#include <string.h>
+#if defined(__psp2__)
+#include <kernel.h>
+#elif defined(LINUX)
+#include <pthread.h>
+#endif
+#include "img_types.h"
+#include "sgxdefs.h"
+#include "usp_typedefs.h"
+#include "usc.h"
+#include "usp.h"
+#include "hwinst.h"
+#include "uspbin.h"
+#include "uspshrd.h"
+#include "usp_cache.h"
+
+/******************************************************************************
+ OS layer
+******************************************************************************/
+
+#if defined(__psp2__)
+
+typedef SceKernelLwMutexWork	USP_CACHE_MUTEX;
+
+static IMG_BOOL CacheOSCreateMutex(USP_CACHE_MUTEX *psMutex)
+{
+	return (sceKernelCreateLwMutex(psMutex, "USPCache", 0, 0, IMG_NULL) == SCE_OK) ? IMG_TRUE : IMG_FALSE;
+}
+
+static IMG_VOID CacheOSDestroyMutex(USP_CACHE_MUTEX *psMutex)
+{
+	sceKernelDeleteLwMutex(psMutex);
+}
+
+static IMG_VOID CacheOSLock(USP_CACHE_MUTEX *psMutex)
+{
+	sceKernelLockLwMutex(psMutex, 1, IMG_NULL);
+}
+
+static IMG_VOID CacheOSUnlock(USP_CACHE_MUTEX *psMutex)
+{
+	sceKernelUnlockLwMutex(psMutex, 1);
+}
+
+#elif defined(LINUX)
+
+typedef pthread_mutex_t			USP_CACHE_MUTEX;
+
+static IMG_BOOL CacheOSCreateMutex(USP_CACHE_MUTEX *psMutex)
+{
+	return (pthread_mutex_init(psMutex, IMG_NULL) == 0) ? IMG_TRUE : IMG_FALSE;
+}
+
+static IMG_VOID CacheOSDestroyMutex(USP_CACHE_MUTEX *psMutex)
+{
+	pthread_mutex_destroy(psMutex);
+}
+
+static IMG_VOID CacheOSLock(USP_CACHE_MUTEX *psMutex)
+{
+	pthread_mutex_lock(psMutex);
+}
+
+static IMG_VOID CacheOSUnlock(USP_CACHE_MUTEX *psMutex)
+{
+	pthread_mutex_unlock(psMutex);
+}
+
+#else
+
+/* Other hosts only run the single-threaded offline tools */
+typedef IMG_UINT32				USP_CACHE_MUTEX;
+
+#define CacheOSCreateMutex(psMutex)		IMG_TRUE
+#define CacheOSDestroyMutex(psMutex)
+#define CacheOSLock(psMutex)
+#define CacheOSUnlock(psMutex)
+
+#endif
+
+/*
+	Cache of finalised HW shaders
+*/
+struct _USP_CACHE_
+{
+	/*
+		Protects everything below. The last reference to a HW shader may be
+		released through another context (sharing the object using it).
+	*/
+	USP_CACHE_MUTEX				sMutex;
+
+	/* Hash-chains of all cached HW shaders */
+	PUSP_CACHE_ENTRY			apsHashChains[USP_CACHE_HASH_BUCKET_COUNT];
+
+	/* Cached HW shaders without outstanding references (least-recently used first) */
+	PUSP_CACHE_ENTRY			psIdleHead;
+	PUSP_CACHE_ENTRY			psIdleTail;
+	IMG_UINT32					uIdleCount;
+
+	/* Total number of cached HW shaders */
+	IMG_UINT32					uEntryCount;
+
+	/* Lookup statistics */
+	IMG_UINT32					uHitCount;
+	IMG_UINT32					uMissCount;
+
+	/*
+		Set once the owning context has been destroyed. The cache is then
+		freed along with the last HW shader still referenced.
+	*/
+	IMG_BOOL					bOrphaned;
+};
+
+/*
+	Header of serialised cache data
+*/
+typedef struct _USP_CACHE_DATA_HDR_
+{
+	/* Should contain USP_CACHE_DATA_ID */
+	IMG_UINT32	uId;
+
+	/* Should contain USP_CACHE_DATA_VER */
+	IMG_UINT32	uVersion;
+
+	/* Layout of the HW shader data on the platform that wrote the cache */
+	IMG_UINT32	uPointerSize;
+	IMG_UINT32	uHWShaderHdrSize;
+
+	/* Number of HW shaders following the header */
+	IMG_UINT32	uEntryCount;
+
+	/* Size (in bytes) of the data following the header */
+	IMG_UINT32	uDataSize;
+
+	/* Digest of the data following the header */
+	IMG_UINT32	uChecksum;
+}USP_CACHE_DATA_HDR, *PUSP_CACHE_DATA_HDR;
+
+/*
+	Offsets of the pointers within a HW shader. Serialised HW shaders record
+	the offset of the referenced data from the start of the HW shader instead
+	(0 for IMG_NULL).
+*/
+static const IMG_UINT32 auHWShaderPtrOffsets[] =
+{
+	offsetof(USP_HW_SHADER, puInsts),
+	offsetof(USP_HW_SHADER, puSAUpdateInsts),
+	offsetof(USP_HW_SHADER, psPSInputLoads),
+	offsetof(USP_HW_SHADER, psMemConstLoads),
+	offsetof(USP_HW_SHADER, psRegConstLoads),
+	offsetof(USP_HW_SHADER, psRegTexStateLoads),
+	offsetof(USP_HW_SHADER, psMemTexStateLoads),
+	offsetof(USP_HW_SHADER, psTextCtrWords),
+	offsetof(USP_HW_SHADER, puValidShaderOutputs)
+};
+
+#define USP_CACHE_HWSHADER_PTR_COUNT	(sizeof(auHWShaderPtrOffsets) / sizeof(auHWShaderPtrOffsets[0]))
+
+#define USP_CACHE_ROTL32(X, N)			(((X) << (N)) | ((X) >> (32 - (N))))
+
+/*****************************************************************************
+ Name:		MixDigestWord
+
+ Purpose:	Final avalanche step for one word of a digest
+
+ Inputs:	uValue	- The word to mix
+
+ Outputs:	none
+
+ Returns:	The mixed word
+*****************************************************************************/
+static IMG_UINT32 MixDigestWord(IMG_UINT32 uValue)
+{
+	uValue ^= uValue >> 16;
+	uValue *= 0x85EBCA6BU;
+	uValue ^= uValue >> 13;
+	uValue *= 0xC2B2AE35U;
+	uValue ^= uValue >> 16;
+
+	return uValue;
+}
+
+/*****************************************************************************
+ Name:		DigestData
+
+ Purpose:	Calculate a 128-bit digest of a block of data (MurmurHash3,
+			x86 128-bit variant).
+
+ Inputs:	pbData		- The data to digest
+			uDataSize	- The size of the data (in bytes)
+
+ Outputs:	auDigest	- The digest of the data
+
+ Returns:	none
+*****************************************************************************/
+static IMG_VOID DigestData(const IMG_UINT8	*pbData,
+						   IMG_UINT32		uDataSize,
+						   IMG_UINT32		auDigest[USP_CACHE_DIGEST_DWORDS])
+{
+	static const IMG_UINT32 auMul[USP_CACHE_DIGEST_DWORDS] =
+	{
+		0x239B961BU, 0xAB0E9789U, 0x38B34AE5U, 0xA1E38B93U
+	};
+	static const IMG_UINT32 auRotK[USP_CACHE_DIGEST_DWORDS] = {15, 16, 17, 18};
+	static const IMG_UINT32 auRotH[USP_CACHE_DIGEST_DWORDS] = {19, 17, 15, 13};
+	static const IMG_UINT32 auAdd[USP_CACHE_DIGEST_DWORDS] =
+	{
+		0x561CCD1BU, 0x0BCAA747U, 0x96CD1C35U, 0x32AC3B17U
+	};
+	IMG_UINT32	auH[USP_CACHE_DIGEST_DWORDS];
+	IMG_UINT8	abTail[USP_CACHE_DIGEST_DWORDS * sizeof(IMG_UINT32)];
+	IMG_UINT32	uOffset;
+	IMG_UINT32	i;
+
+	for	(i = 0; i < USP_CACHE_DIGEST_DWORDS; i++)
+	{
+		auH[i] = 0x5553502EU;
+	}
+
+	for	(uOffset = 0; uOffset < uDataSize; uOffset += sizeof(abTail))
+	{
+		const IMG_UINT8	*pbBlock;
+		IMG_BOOL		bTail;
+
+		/*
+			Zero-pad the final partial block
+		*/
+		bTail = (IMG_BOOL)((uDataSize - uOffset) < sizeof(abTail));
+		if	(bTail)
+		{
+			memset(abTail, 0, sizeof(abTail));
+			memcpy(abTail, pbData + uOffset, uDataSize - uOffset);
+			pbBlock = abTail;
+		}
+		else
+		{
+			pbBlock = pbData + uOffset;
+		}
+
+		for	(i = 0; i < USP_CACHE_DIGEST_DWORDS; i++)
+		{
+			IMG_UINT32	uNext;
+			IMG_UINT32	uK;
+
+			uK = ((IMG_UINT32)pbBlock[i * 4 + 0] << 0)  |
+				 ((IMG_UINT32)pbBlock[i * 4 + 1] << 8)  |
+				 ((IMG_UINT32)pbBlock[i * 4 + 2] << 16) |
+				 ((IMG_UINT32)pbBlock[i * 4 + 3] << 24);
+
+			uNext = (i + 1) % USP_CACHE_DIGEST_DWORDS;
+
+			uK *= auMul[i];
+			uK  = USP_CACHE_ROTL32(uK, auRotK[i]);
+			uK *= auMul[uNext];
+			auH[i] ^= uK;
+
+			if	(!bTail)
+			{
+				auH[i]  = USP_CACHE_ROTL32(auH[i], auRotH[i]);
+				auH[i] += auH[uNext];
+				auH[i]  = auH[i] * 5 + auAdd[i];
+			}
+		}
+	}
+
+	for	(i = 0; i < USP_CACHE_DIGEST_DWORDS; i++)
+	{
+		auH[i] ^= uDataSize;
+	}
+	auH[0] += auH[1] + auH[2] + auH[3];
+	auH[1] += auH[0];
+	auH[2] += auH[0];
+	auH[3] += auH[0];
+
+	for	(i = 0; i < USP_CACHE_DIGEST_DWORDS; i++)
+	{
+		auH[i] = MixDigestWord(auH[i]);
+	}
+	auH[0] += auH[1] + auH[2] + auH[3];
+	auH[1] += auH[0];
+	auH[2] += auH[0];
+	auH[3] += auH[0];
+
+	memcpy(auDigest, auH, sizeof(auH));
+}
+
+/*****************************************************************************
+ Name:		HashKeyData
+
+ Purpose:	Calculate the hash used to select the hash-chain for a key
+
+ Inputs:	psKey	- The key to hash
+
+ Outputs:	none
+
+ Returns:	The hash of the key data
+*****************************************************************************/
+static IMG_UINT32 HashKeyData(PUSP_CACHE_KEY psKey)
+{
+	IMG_UINT32	uHash;
+	IMG_UINT32	i;
+
+	uHash = 0;
+	for	(i = 0; i < psKey->uDataCount; i++)
+	{
+		uHash += psKey->auData[i];
+		uHash += (uHash << 10);
+		uHash ^= (uHash >> 6);
+	}
+	uHash += (uHash << 3);
+	uHash ^= (uHash >> 11);
+	uHash += (uHash << 15);
+
+	return uHash;
+}
+
+/*****************************************************************************
+ Name:		AddSamplerToMask
+
+ Purpose:	Record that a sampler's description is used when finalising a
+			shader
+
+ Inputs:	uSamplerIdx	- Index of the sampler
+			puMask		- The mask of used samplers
+
+ Outputs:	puMask		- Updated to include the sampler
+
+ Returns:	IMG_FALSE if the sampler cannot be represented in the mask
+*****************************************************************************/
+static IMG_BOOL AddSamplerToMask(IMG_UINT32 uSamplerIdx, IMG_PUINT32 puMask)
+{
+	if	(uSamplerIdx >= USP_MAX_SAMPLER_IDX)
+	{
+		return IMG_FALSE;
+	}
+
+	*puMask |= 1U << uSamplerIdx;
+	return IMG_TRUE;
+}
+
+/*****************************************************************************
+ Name:		USPCacheCreate
+
+ Purpose:	Create the (empty) cache of a new USP execution context
+
+ Inputs:	psContext	- The new USP execution context
+
+ Outputs:	none
+
+ Returns:	IMG_FALSE on failure
+*****************************************************************************/
+IMG_INTERNAL IMG_BOOL USPCacheCreate(PUSP_CONTEXT psContext)
+{
+	PUSP_CACHE	psCache;
+
+	psCache = (PUSP_CACHE)psContext->pfnAlloc(sizeof(*psCache));
+	if	(!psCache)
+	{
+		USP_DBGPRINT(("USPCacheCreate: Failed to alloc cache\n"));
+		return IMG_FALSE;
+	}
+	memset(psCache, 0, sizeof(*psCache));
+
+	if	(!CacheOSCreateMutex(&psCache->sMutex))
+	{
+		USP_DBGPRINT(("USPCacheCreate: Failed to create cache mutex\n"));
+		psContext->pfnFree(psCache);
+		return IMG_FALSE;
+	}
+
+	psContext->psCache = psCache;
+
+	return IMG_TRUE;
+}
+
+/*****************************************************************************
+ Name:		USPCacheSetupShader
+
+ Purpose:	Record the digest of the precompiled data and the samplers used by
+			a newly created USP shader
+
+ Inputs:	psContext	- The current USP execution context
+			psShader	- The newly created USP shader
+			psPCShader	- The precompiled data it was created from
+
+ Outputs:	none
+
+ Returns:	none
+*****************************************************************************/
+IMG_INTERNAL IMG_VOID USPCacheSetupShader(PUSP_CONTEXT		psContext,
+										  PUSP_SHADER		psShader,
+										  PUSP_PC_SHADER	psPCShader)
+{
+	PUSP_INPUT_DATA		psInputData;
+	PUSP_SAMPLE			psSample;
+	PUSP_TEXTURE_WRITE	psTextureWrite;
+	TEX_SAMPLES_LIST	*psTexFormats;
+	IMG_UINT32			uMask;
+	IMG_BOOL			bCacheable;
+	IMG_UINT32			i;
+
+	USP_UNREFERENCED_PARAMETER(psContext);
+
+	psShader->uPCShaderSize = sizeof(USP_PC_SHADER) + psPCShader->uSize;
+	DigestData((const IMG_UINT8 *)psPCShader,
+			   psShader->uPCShaderSize,
+			   psShader->auPCShaderDigest);
+
+	/*
+		Collect every sampler whose description can be read while finalising
+		the shader. Shaders referencing a sampler outside of the range the
+		context describes are never shared.
+	*/
+	uMask		= 0;
+	bCacheable	= IMG_TRUE;
+
+	for	(psSample = psShader->psNonDepSamples; psSample; psSample = psSample->psNext)
+	{
+		bCacheable &= AddSamplerToMask(psSample->uTextureIdx, &uMask);
+	}
+	for	(psSample = psShader->psDepSamples; psSample; psSample = psSample->psNext)
+	{
+		bCacheable &= AddSamplerToMask(psSample->uTextureIdx, &uMask);
+	}
+	for	(psTextureWrite = psShader->psTextureWrites;
+		 psTextureWrite;
+		 psTextureWrite = psTextureWrite->psNext)
+	{
+		bCacheable &= AddSamplerToMask(psTextureWrite->uWriteID, &uMask);
+	}
+	for	(psTexFormats = psShader->psUsedTexFormats;
+		 psTexFormats;
+		 psTexFormats = psTexFormats->psNext)
+	{
+		bCacheable &= AddSamplerToMask(psTexFormats->uTexIdx, &uMask);
+	}
+
+	psInputData = psShader->psInputData;
+	if	(psInputData)
+	{
+		for	(i = 0; i < psInputData->uPreSampledDataCount; i++)
+		{
+			IMG_UINT32 uTextureIdx = psInputData->psPreSampledData[i].uTextureIdx;
+
+			if	(uTextureIdx != UNIFLEX_TEXTURE_NONE)
+			{
+				bCacheable &= AddSamplerToMask(uTextureIdx, &uMask);
+			}
+		}
+		for	(i = 0; i < psInputData->uTexStateDataCount; i++)
+		{
+			bCacheable &= AddSamplerToMask(psInputData->psTexStateData[i].uTextureIdx, &uMask);
+		}
+	}
+
+	psShader->uSamplerMask	= uMask;
+	psShader->bCacheable	= bCacheable;
+}
+
+/*****************************************************************************
+ Name:		USPCacheBuildKey
+
+ Purpose:	Build the key describing how a shader would be finalised with the
+			current context state
+
+ Inputs:	psContext	- The current USP execution context
+			psShader	- The USP shader about to be finalised
+
+ Outputs:	psKey		- The cache key for the shader
+
+ Returns:	IMG_FALSE if HW shaders finalised from the shader cannot be shared
+*****************************************************************************/
+IMG_INTERNAL IMG_BOOL USPCacheBuildKey(PUSP_CONTEXT		psContext,
+									   PUSP_SHADER		psShader,
+									   PUSP_CACHE_KEY	psKey)
+{
+	IMG_UINT32	uDataCount;
+	IMG_UINT32	uSamplerIdx;
+
+	if	(!psShader->bCacheable)
+	{
+		return IMG_FALSE;
+	}
+
+	memcpy(psKey->auData, psShader->auPCShaderDigest, sizeof(psShader->auPCShaderDigest));
+	uDataCount = USP_CACHE_DIGEST_DWORDS;
+
+	psKey->auData[uDataCount++] = psShader->uPCShaderSize;
+	psKey->auData[uDataCount++] = (IMG_UINT32)psContext->eOutputRegType;
+	psKey->auData[uDataCount++] = psContext->uPreambleInstCount;
+	psKey->auData[uDataCount++] = psShader->uSamplerMask;
+
+	for	(uSamplerIdx = 0; uSamplerIdx < USP_MAX_SAMPLER_IDX; uSamplerIdx++)
+	{
+		if	(psShader->uSamplerMask & (1U << uSamplerIdx))
+		{
+			memcpy(&psKey->auData[uDataCount],
+				   &psContext->asSamplerDesc[uSamplerIdx],
+				   sizeof(USP_SAMPLER_DESC));
+			uDataCount += USP_CACHE_SAMPLER_DESC_DWORDS;
+		}
+	}
+
+	psKey->uDataCount	= uDataCount;
+	psKey->uHash		= HashKeyData(psKey);
+
+	return IMG_TRUE;
+}
+
+/*****************************************************************************
+ Name:		RemoveIdleEntry
+
+ Purpose:	Remove a cache entry from the list of unreferenced HW shaders
+
+ Inputs:	psCache	- The cache containing the entry
+			psEntry	- The entry to remove
+
+ Outputs:	none
+
+ Returns:	none
+*****************************************************************************/
+static IMG_VOID RemoveIdleEntry(PUSP_CACHE psCache, PUSP_CACHE_ENTRY psEntry)
+{
+	if	(psEntry->psIdlePrev)
+	{
+		psEntry->psIdlePrev->psIdleNext = psEntry->psIdleNext;
+	}
+	else
+	{
+		psCache->psIdleHead = psEntry->psIdleNext;
+	}
+
+	if	(psEntry->psIdleNext)
+	{
+		psEntry->psIdleNext->psIdlePrev = psEntry->psIdlePrev;
+	}
+	else
+	{
+		psCache->psIdleTail = psEntry->psIdlePrev;
+	}
+
+	psEntry->psIdlePrev = IMG_NULL;
+	psEntry->psIdleNext = IMG_NULL;
+	psCache->uIdleCount--;
+}
+
+/*****************************************************************************
+ Name:		RemoveEntry
+
+ Purpose:	Remove an unreferenced entry (not on the idle list) from the
+			cache and free it
+
+ Inputs:	psContext	- The current USP execution context
+			psCache		- The cache containing the entry
+			psEntry		- The entry to free
+
+ Outputs:	none
+
+ Returns:	none
+*****************************************************************************/
+static IMG_VOID RemoveEntry(PUSP_CONTEXT		psContext,
+							PUSP_CACHE			psCache,
+							PUSP_CACHE_ENTRY	psEntry)
+{
+	PUSP_CACHE_ENTRY	*ppsLink;
+
+	ppsLink = &psCache->apsHashChains[psEntry->sKey.uHash % USP_CACHE_HASH_BUCKET_COUNT];
+	while	(*ppsLink != psEntry)
+	{
+		ppsLink = &(*ppsLink)->psHashNext;
+	}
+	*ppsLink = psEntry->psHashNext;
+
+	psCache->uEntryCount--;
+
+	psContext->pfnFree(psEntry);
+}
+
+/*****************************************************************************
+ Name:		AddIdleEntry
+
+ Purpose:	Record that nothing references a cached HW shader any more, freeing
+			the least-recently used unreferenced HW shaders if too many are
+			being kept.
+
+ Inputs:	psContext	- The current USP execution context
+			psCache		- The cache containing the entry
+			psEntry		- The newly unreferenced entry
+
+ Outputs:	none
+
+ Returns:	none
+*****************************************************************************/
+static IMG_VOID AddIdleEntry(PUSP_CONTEXT		psContext,
+							 PUSP_CACHE			psCache,
+							 PUSP_CACHE_ENTRY	psEntry)
+{
+	psEntry->psIdlePrev = psCache->psIdleTail;
+	psEntry->psIdleNext = IMG_NULL;
+
+	if	(psCache->psIdleTail)
+	{
+		psCache->psIdleTail->psIdleNext = psEntry;
+	}
+	else
+	{
+		psCache->psIdleHead = psEntry;
+	}
+	psCache->psIdleTail = psEntry;
+	psCache->uIdleCount++;
+
+	while	(psCache->uIdleCount > USP_CACHE_MAX_IDLE_ENTRIES)
+	{
+		psEntry = psCache->psIdleHead;
+
+		RemoveIdleEntry(psCache, psEntry);
+		RemoveEntry(psContext, psCache, psEntry);
+	}
+}
+
+/*****************************************************************************
+ Name:		FreeCache
+
+ Purpose:	Free a cache once it no longer indexes any HW shaders
+
+ Inputs:	psContext	- The current USP execution context
+			psCache		- The cache to free
+
+ Outputs:	none
+
+ Returns:	none
+*****************************************************************************/
+static IMG_VOID FreeCache(PUSP_CONTEXT psContext, PUSP_CACHE psCache)
+{
+	CacheOSDestroyMutex(&psCache->sMutex);
+
+	psContext->pfnFree(psCache);
+}
+
+/*****************************************************************************
+ Name:		FindEntry
+
+ Purpose:	Lookup the cache entry for a key
+
+ Inputs:	psCache	- The cache to search
+			psKey	- The key to look for
+
+ Outputs:	none
+
+ Returns:	The matching entry, or IMG_NULL if none
+*****************************************************************************/
+static PUSP_CACHE_ENTRY FindEntry(PUSP_CACHE psCache, PUSP_CACHE_KEY psKey)
+{
+	PUSP_CACHE_ENTRY	psEntry;
+
+	for	(psEntry = psCache->apsHashChains[psKey->uHash % USP_CACHE_HASH_BUCKET_COUNT];
+		 psEntry;
+		 psEntry = psEntry->psHashNext)
+	{
+		if	(
+				(psEntry->sKey.uHash == psKey->uHash) &&
+				(psEntry->sKey.uDataCount == psKey->uDataCount) &&
+				(memcmp(psEntry->sKey.auData,
+						psKey->auData,
+						psKey->uDataCount * sizeof(IMG_UINT32)) == 0)
+			)
+		{
+			return psEntry;
+		}
+	}
+
+	return IMG_NULL;
+}
+
+/*****************************************************************************
+ Name:		InsertEntry
+
+ Purpose:	Index a HW shader in the cache
+
+ Inputs:	psCache	- The cache to add the entry to
+			psEntry	- The entry to add (with its key already set)
+
+ Outputs:	none
+
+ Returns:	none
+*****************************************************************************/
+static IMG_VOID InsertEntry(PUSP_CACHE psCache, PUSP_CACHE_ENTRY psEntry)
+{
+	PUSP_CACHE_ENTRY	*ppsChain;
+
+	/*
+		Append, so that USPCacheLoad rebuilds each chain in the order
+		USPCacheSerialise wrote it, and serialising again gives the same data
+	*/
+	ppsChain = &psCache->apsHashChains[psEntry->sKey.uHash % USP_CACHE_HASH_BUCKET_COUNT];
+	while	(*ppsChain)
+	{
+		ppsChain = &(*ppsChain)->psHashNext;
+	}
+
+	psEntry->psCache	= psCache;
+	psEntry->psHashNext	= IMG_NULL;
+	psEntry->psIdlePrev	= IMG_NULL;
+	psEntry->psIdleNext	= IMG_NULL;
+	*ppsChain			= psEntry;
+
+	psCache->uEntryCount++;
+}
+
+/*****************************************************************************
+ Name:		USPCacheFindHWShader
+
+ Purpose:	Lookup (and reference) a previously finalised HW shader
+
+ Inputs:	psContext	- The current USP execution context
+			psKey		- Key describing the required HW shader
+
+ Outputs:	none
+
+ Returns:	The shared HW shader, or IMG_NULL if it must be finalised
+*****************************************************************************/
+IMG_INTERNAL PUSP_HW_SHADER USPCacheFindHWShader(PUSP_CONTEXT	psContext,
+												 PUSP_CACHE_KEY	psKey)
+{
+	PUSP_CACHE			psCache;
+	PUSP_CACHE_ENTRY	psEntry;
+
+	psCache = psContext->psCache;
+
+	CacheOSLock(&psCache->sMutex);
+
+	psEntry = FindEntry(psCache, psKey);
+	if	(psEntry)
+	{
+		if	(psEntry->uRefCount == 0)
+		{
+			RemoveIdleEntry(psCache, psEntry);
+		}
+		psEntry->uRefCount++;
+		psCache->uHitCount++;
+	}
+	else
+	{
+		psCache->uMissCount++;
+	}
+
+	CacheOSUnlock(&psCache->sMutex);
+
+	return psEntry ? USP_CACHE_HWSHADER_FROM_ENTRY(psEntry) : IMG_NULL;
+}
+
+/*****************************************************************************
+ Name:		USPCacheAddHWShader
+
+ Purpose:	Record a HW shader created by CreateHWShader, adding it to the
+			cache if a key is supplied
+
+ Inputs:	psContext		- The current USP execution context
+			psKey			- The key the shader was finalised with, or
+							  IMG_NULL if it must not be shared
+			psHWShader		- The new HW shader
+			uHWShaderSize	- The size of the HW shader data (in bytes)
+
+ Outputs:	none
+
+ Returns:	none
+*****************************************************************************/
+IMG_INTERNAL IMG_VOID USPCacheAddHWShader(PUSP_CONTEXT		psContext,
+										  PUSP_CACHE_KEY	psKey,
+										  PUSP_HW_SHADER	psHWShader,
+										  IMG_UINT32		uHWShaderSize)
+{
+	PUSP_CACHE_ENTRY	psEntry;
+
+	psEntry = USP_CACHE_ENTRY_FROM_HWSHADER(psHWShader);
+
+	psEntry->uRefCount		= 1;
+	psEntry->uHWShaderSize	= uHWShaderSize;
+
+	if	(psKey)
+	{
+		psEntry->sKey = *psKey;
+
+		CacheOSLock(&psContext->psCache->sMutex);
+		InsertEntry(psContext->psCache, psEntry);
+		CacheOSUnlock(&psContext->psCache->sMutex);
+	}
+	else
+	{
+		psEntry->psCache = IMG_NULL;
+	}
+}
+
+/*****************************************************************************
+ Name:		USPCacheReleaseHWShader
+
+ Purpose:	Release a reference to a HW shader returned by
+			PVRUniPatchFinaliseShader
+
+ Inputs:	psContext	- The current USP execution context
+			psHWShader	- The HW shader to release
+
+ Outputs:	none
+
+ Returns:	none
+
+ Notes:		The HW shader may be indexed by the cache of another context,
+			possibly one that has since been destroyed.
+*****************************************************************************/
+IMG_INTERNAL IMG_VOID USPCacheReleaseHWShader(PUSP_CONTEXT		psContext,
+											  PUSP_HW_SHADER	psHWShader)
+{
+	PUSP_CACHE_ENTRY	psEntry;
+	PUSP_CACHE			psCache;
+	IMG_BOOL			bFreeCache;
+
+	psEntry = USP_CACHE_ENTRY_FROM_HWSHADER(psHWShader);
+
+	/*
+		HW shaders that aren't cached have a single reference
+	*/
+	psCache = psEntry->psCache;
+	if	(!psCache)
+	{
+		psContext->pfnFree(psEntry);
+		return;
+	}
+
+	CacheOSLock(&psCache->sMutex);
+
+	bFreeCache = IMG_FALSE;
+
+	if	(psEntry->uRefCount == 0)
+	{
+		USP_DBGPRINT(("USPCacheReleaseHWShader: HW shader is not referenced\n"));
+	}
+	else if	(--psEntry->uRefCount == 0)
+	{
+		if	(psCache->bOrphaned)
+		{
+			RemoveEntry(psContext, psCache, psEntry);
+			bFreeCache = (psCache->uEntryCount == 0) ? IMG_TRUE : IMG_FALSE;
+		}
+		else
+		{
+			AddIdleEntry(psContext, psCache, psEntry);
+		}
+	}
+
+	CacheOSUnlock(&psCache->sMutex);
+
+	if	(bFreeCache)
+	{
+		FreeCache(psContext, psCache);
+	}
+}
+
+/*****************************************************************************
+ Name:		GetSerialisedEntrySize
+
+ Purpose:	Calculate the size of the serialised data for a cache entry
+
+ Inputs:	psEntry	- The cache entry
+
+ Outputs:	none
+
+ Returns:	The size (in bytes)
+*****************************************************************************/
+static IMG_UINT32 GetSerialisedEntrySize(PUSP_CACHE_ENTRY psEntry)
+{
+	return (1 + psEntry->sKey.uDataCount + 1 + USP_CACHE_HWSHADER_PTR_COUNT) * sizeof(IMG_UINT32) +
+		   psEntry->uHWShaderSize;
+}
+
+/*****************************************************************************
+ Name:		SerialiseEntries
+
+ Purpose:	Serialise all cached HW shaders, with the cache locked
+
+ Inputs:	psContext	- The current USP execution context
+			psCache		- The cache to serialise
+			pvBuffer	- Buffer to write the data to, or IMG_NULL to
+						  calculate the required size
+			uBufferSize	- Size of the buffer (in bytes)
+
+ Outputs:	none
+
+ Returns:	The size of the serialised data (in bytes), or 0 if the buffer is
+			too small.
+
+ Notes:		Each serialised HW shader is written as its key size, key data,
+			HW shader size, the offsets of the data referenced by each HW
+			shader pointer, and then the HW shader data with the pointers
+			cleared.
+*****************************************************************************/
+static IMG_UINT32 SerialiseEntries(PUSP_CONTEXT	psContext,
+								   PUSP_CACHE	psCache,
+								   IMG_PVOID	pvBuffer,
+								   IMG_UINT32	uBufferSize)
+{
+	PUSP_CACHE_ENTRY	psEntry;
+
+	PUSP_CACHE_DATA_HDR	psHdr;
+	IMG_PUINT32			puData;
+	IMG_UINT32			uDataSize;
+	IMG_UINT32			uEntryCount;
+	IMG_UINT32			uChainIdx;
+	IMG_UINT32			auDigest[USP_CACHE_DIGEST_DWORDS];
+
+	uDataSize	= 0;
+	uEntryCount	= 0;
+	for	(uChainIdx = 0; uChainIdx < USP_CACHE_HASH_BUCKET_COUNT; uChainIdx++)
+	{
+		for	(psEntry = psCache->apsHashChains[uChainIdx]; psEntry; psEntry = psEntry->psHashNext)
+		{
+			uDataSize += GetSerialisedEntrySize(psEntry);
+			uEntryCount++;
+		}
+	}
+
+	if	(!pvBuffer)
+	{
+		return sizeof(USP_CACHE_DATA_HDR) + uDataSize;
+	}
+	if	(uBufferSize < sizeof(USP_CACHE_DATA_HDR) + uDataSize)
+	{
+		USP_DBGPRINT(("USPCacheSerialise: Buffer too small\n"));
+		return 0;
+	}
+
+	psHdr	= (PUSP_CACHE_DATA_HDR)pvBuffer;
+	puData	= (IMG_PUINT32)(psHdr + 1);
+
+	for	(uChainIdx = 0; uChainIdx < USP_CACHE_HASH_BUCKET_COUNT; uChainIdx++)
+	{
+		for	(psEntry = psCache->apsHashChains[uChainIdx]; psEntry; psEntry = psEntry->psHashNext)
+		{
+			IMG_PUINT8	pbHWShader;
+			IMG_PUINT8	pbOut;
+			IMG_UINT32	uPtrIdx;
+
+			pbHWShader = (IMG_PUINT8)USP_CACHE_HWSHADER_FROM_ENTRY(psEntry);
+
+			*puData++ = psEntry->sKey.uDataCount;
+			memcpy(puData, psEntry->sKey.auData, psEntry->sKey.uDataCount * sizeof(IMG_UINT32));
+			puData += psEntry->sKey.uDataCount;
+
+			*puData++ = psEntry->uHWShaderSize;
+
+			pbOut = (IMG_PUINT8)(puData + USP_CACHE_HWSHADER_PTR_COUNT);
+			memcpy(pbOut, pbHWShader, psEntry->uHWShaderSize);
+
+			for	(uPtrIdx = 0; uPtrIdx < USP_CACHE_HWSHADER_PTR_COUNT; uPtrIdx++)
+			{
+				IMG_PUINT8	pbPtr;
+
+				memcpy(&pbPtr, pbHWShader + auHWShaderPtrOffsets[uPtrIdx], sizeof(pbPtr));
+
+				*puData++ = pbPtr ? (IMG_UINT32)(pbPtr - pbHWShader) : 0;
+				memset(pbOut + auHWShaderPtrOffsets[uPtrIdx], 0, sizeof(IMG_PVOID));
+			}
+
+			puData = (IMG_PUINT32)(pbOut + psEntry->uHWShaderSize);
+		}
+	}
+
+	DigestData((const IMG_UINT8 *)(psHdr + 1), uDataSize, auDigest);
+
+	psHdr->uId				= USP_CACHE_DATA_ID;
+	psHdr->uVersion			= USP_CACHE_DATA_VER;
+	psHdr->uPointerSize		= sizeof(IMG_PVOID);
+	psHdr->uHWShaderHdrSize	= sizeof(USP_HW_SHADER);
+	psHdr->uEntryCount		= uEntryCount;
+	psHdr->uDataSize		= uDataSize;
+	psHdr->uChecksum		= auDigest[0];
+
+	return sizeof(USP_CACHE_DATA_HDR) + uDataSize;
+}
+
+/*****************************************************************************
+ Name:		USPCacheSerialise
+
+ Purpose:	Serialise all cached HW shaders
+
+ Inputs:	psContext	- The current USP execution context
+			pvBuffer	- Buffer to write the data to, or IMG_NULL to
+						  calculate the required size
+			uBufferSize	- Size of the buffer (in bytes)
+
+ Outputs:	none
+
+ Returns:	The size of the serialised data (in bytes), or 0 if the buffer is
+			too small.
+*****************************************************************************/
+IMG_INTERNAL IMG_UINT32 USPCacheSerialise(PUSP_CONTEXT	psContext,
+										  IMG_PVOID		pvBuffer,
+										  IMG_UINT32	uBufferSize)
+{
+	PUSP_CACHE	psCache;
+	IMG_UINT32	uSize;
+
+	psCache = psContext->psCache;
+
+	CacheOSLock(&psCache->sMutex);
+	uSize = SerialiseEntries(psContext, psCache, pvBuffer, uBufferSize);
+	CacheOSUnlock(&psCache->sMutex);
+
+	return uSize;
+}
+
+/*****************************************************************************
+ Name:		LoadEntries
+
+ Purpose:	Add serialised HW shaders to the cache, with the cache locked
+
+ Inputs:	psContext	- The current USP execution context
+			psCache		- The cache to add the HW shaders to
+			pbData		- The serialised HW shaders
+			pbEnd		- The end of the serialised HW shaders
+			uEntryCount	- The number of serialised HW shaders
+
+ Outputs:	none
+
+ Returns:	IMG_FALSE if the data is invalid
+*****************************************************************************/
+static IMG_BOOL LoadEntries(PUSP_CONTEXT	psContext,
+							PUSP_CACHE		psCache,
+							IMG_PUINT8		pbData,
+							IMG_PUINT8		pbEnd,
+							IMG_UINT32		uEntryCount)
+{
+	IMG_UINT32	uEntryIdx;
+
+	for	(uEntryIdx = 0; uEntryIdx < uEntryCount; uEntryIdx++)
+	{
+		PUSP_CACHE_ENTRY	psEntry;
+		USP_CACHE_KEY		sKey;
+		IMG_UINT32			auPtrData[USP_CACHE_HWSHADER_PTR_COUNT];
+		IMG_UINT32			uHWShaderSize;
+		IMG_PUINT8			pbHWShader;
+		IMG_UINT32			uPtrIdx;
+
+		/*
+			Read and validate the key and the size of the HW shader
+		*/
+		if	((IMG_UINT32)(pbEnd - pbData) < sizeof(IMG_UINT32))
+		{
+			return IMG_FALSE;
+		}
+		memcpy(&sKey.uDataCount, pbData, sizeof(IMG_UINT32));
+		pbData += sizeof(IMG_UINT32);
+
+		if	(
+				(sKey.uDataCount < USP_CACHE_KEY_FIXED_DWORDS) ||
+				(sKey.uDataCount > USP_CACHE_MAX_KEY_DWORDS) ||
+				((IMG_UINT32)(pbEnd - pbData) < (sKey.uDataCount + 1 + USP_CACHE_HWSHADER_PTR_COUNT) * sizeof(IMG_UINT32))
+			)
+		{
+			return IMG_FALSE;
+		}
+		memcpy(sKey.auData, pbData, sKey.uDataCount * sizeof(IMG_UINT32));
+		pbData += sKey.uDataCount * sizeof(IMG_UINT32);
+
+		memcpy(&uHWShaderSize, pbData, sizeof(IMG_UINT32));
+		pbData += sizeof(IMG_UINT32);
+
+		memcpy(auPtrData, pbData, sizeof(auPtrData));
+		pbData += sizeof(auPtrData);
+
+		if	(
+				(uHWShaderSize < sizeof(USP_HW_SHADER)) ||
+				((IMG_UINT32)(pbEnd - pbData) < uHWShaderSize)
+			)
+		{
+			return IMG_FALSE;
+		}
+		for	(uPtrIdx = 0; uPtrIdx < USP_CACHE_HWSHADER_PTR_COUNT; uPtrIdx++)
+		{
+			if	(auPtrData[uPtrIdx] > uHWShaderSize)
+			{
+				return IMG_FALSE;
+			}
+		}
+
+		sKey.uHash = HashKeyData(&sKey);
+
+		/*
+			Keep the existing copy of HW shaders which are already cached
+		*/
+		if	(FindEntry(psCache, &sKey))
+		{
+			pbData += uHWShaderSize;
+			continue;
+		}
+
+		psEntry = (PUSP_CACHE_ENTRY)psContext->pfnAlloc(USP_CACHE_ENTRY_HDR_SIZE + uHWShaderSize);
+		if	(!psEntry)
+		{
+			USP_DBGPRINT(("USPCacheLoad: Failed to alloc cache entry\n"));
+			return IMG_FALSE;
+		}
+		memset(psEntry, 0, USP_CACHE_ENTRY_HDR_SIZE);
+
+		/*
+			Copy the HW shader and restore its pointers
+		*/
+		pbHWShader = (IMG_PUINT8)USP_CACHE_HWSHADER_FROM_ENTRY(psEntry);
+		memcpy(pbHWShader, pbData, uHWShaderSize);
+		pbData += uHWShaderSize;
+
+		for	(uPtrIdx = 0; uPtrIdx < USP_CACHE_HWSHADER_PTR_COUNT; uPtrIdx++)
+		{
+			IMG_PUINT8	pbPtr;
+
+			pbPtr = auPtrData[uPtrIdx] ? (pbHWShader + auPtrData[uPtrIdx]) : IMG_NULL;
+			memcpy(pbHWShader + auHWShaderPtrOffsets[uPtrIdx], &pbPtr, sizeof(pbPtr));
+		}
+
+		psEntry->uRefCount		= 0;
+		psEntry->uHWShaderSize	= uHWShaderSize;
+		psEntry->sKey			= sKey;
+
+		InsertEntry(psCache, psEntry);
+		AddIdleEntry(psContext, psCache, psEntry);
+	}
+
+	return IMG_TRUE;
+}
+
+/*****************************************************************************
+ Name:		USPCacheLoad
+
+ Purpose:	Add HW shaders serialised by USPCacheSerialise to the cache
+
+ Inputs:	psContext	- The current USP execution context
+			pvData		- The serialised data
+			uDataSize	- Size of the serialised data (in bytes)
+
+ Outputs:	none
+
+ Returns:	IMG_FALSE if the data is invalid or was written by an incompatible
+			version of the USP.
+*****************************************************************************/
+IMG_INTERNAL IMG_BOOL USPCacheLoad(PUSP_CONTEXT	psContext,
+								   IMG_PVOID	pvData,
+								   IMG_UINT32	uDataSize)
+{
+	PUSP_CACHE			psCache;
+	PUSP_CACHE_DATA_HDR	psHdr;
+	IMG_PUINT8			pbData;
+	IMG_PUINT8			pbEnd;
+	IMG_BOOL			bResult;
+	IMG_UINT32			auDigest[USP_CACHE_DIGEST_DWORDS];
+
+	psCache	= psContext->psCache;
+	psHdr	= (PUSP_CACHE_DATA_HDR)pvData;
+
+	if	(
+			(uDataSize < sizeof(USP_CACHE_DATA_HDR)) ||
+			(psHdr->uId != USP_CACHE_DATA_ID) ||
+			(psHdr->uVersion != USP_CACHE_DATA_VER) ||
+			(psHdr->uPointerSize != sizeof(IMG_PVOID)) ||
+			(psHdr->uHWShaderHdrSize != sizeof(USP_HW_SHADER)) ||
+			(psHdr->uDataSize > uDataSize - sizeof(USP_CACHE_DATA_HDR))
+		)
+	{
+		USP_DBGPRINT(("USPCacheLoad: Incompatible cache data\n"));
+		return IMG_FALSE;
+	}
+
+	pbData	= (IMG_PUINT8)(psHdr + 1);
+	pbEnd	= pbData + psHdr->uDataSize;
+
+	DigestData(pbData, psHdr->uDataSize, auDigest);
+	if	(auDigest[0] != psHdr->uChecksum)
+	{
+		USP_DBGPRINT(("USPCacheLoad: Corrupt cache data\n"));
+		return IMG_FALSE;
+	}
+
+	CacheOSLock(&psCache->sMutex);
+	bResult = LoadEntries(psContext, psCache, pbData, pbEnd, psHdr->uEntryCount);
+	CacheOSUnlock(&psCache->sMutex);
+
+	return bResult;
+}
+
+/*****************************************************************************
+ Name:		USPCacheDestroy
+
+ Purpose:	Free all cached HW shaders that are no longer referenced
+
+ Inputs:	psContext	- The USP execution context being destroyed
+
+ Outputs:	none
+
+ Returns:	none
+
+ Notes:		HW shaders still referenced (e.g. by objects shared with another
+			context) stay in the cache, which is freed when the last of them
+			is released.
+*****************************************************************************/
+IMG_INTERNAL IMG_VOID USPCacheDestroy(PUSP_CONTEXT psContext)
+{
+	PUSP_CACHE			psCache;
+	PUSP_CACHE_ENTRY	psEntry;
+	IMG_BOOL			bFreeCache;
+
+	psCache = psContext->psCache;
+	psContext->psCache = IMG_NULL;
+
+	CacheOSLock(&psCache->sMutex);
+
+	USP_DBGPRINT(("USPCacheDestroy: %u hits, %u misses, %u HW shaders cached\n",
+				  psCache->uHitCount, psCache->uMissCount, psCache->uEntryCount));
+
+	while	(psCache->psIdleHead)
+	{
+		psEntry = psCache->psIdleHead;
+
+		RemoveIdleEntry(psCache, psEntry);
+		RemoveEntry(psContext, psCache, psEntry);
+	}
+
+	psCache->bOrphaned	= IMG_TRUE;
+	bFreeCache			= (psCache->uEntryCount == 0) ? IMG_TRUE : IMG_FALSE;
+
+	CacheOSUnlock(&psCache->sMutex);
+
+	if	(bFreeCache)
+	{
+		FreeCache(psContext, psCache);
+	}
+}
+
+/******************************************************************************
+ End of file (USP_CACHE.C)
+******************************************************************************/
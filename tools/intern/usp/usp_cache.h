@@ -0,0 +1,97 @@
+ /*****************************************************************************
+ Name			: USP_CACHE.H
+
+ Title			: Interface for usp_cache.c
+
+ C Author 		: Joe Molleson
+
+ Created  		: 02/01/2002
+
+ Copyright      : 2002-2006 by Imagination Technologies Limited. All rights reserved.
+                : No part of this software, either material or conceptual
+                : may be copied or distributed, transmitted, transcribed,
+                : stored in a retrieval system or translated into any
+                : human or computer language in any form by any means,
+                : electronic, mechanical, manual or other-wise, or
+                : disclosed to third parties without the express written
+                : permission of Imagination Technologies Limited, Unit 8, HomePark
+                : Industrial Estate, King's Langley, Hertfordshire,
+                : WD4 8LZ, U.K.
+
+ Description 	: Definitions and prototypes for usp_cache.c
+
+ Program Type	: 32-bit DLL
+
+ Version	 	: $Revision: 1.0 $
+
+ Modifications	:
+
+ $Log: usp_cache.h $
+*****************************************************************************/
+#ifndef _USP_CACHE_H_
+#define _USP_CACHE_H_
+
+/*
+	Create the cache of a new context
+*/
+IMG_BOOL USPCacheCreate(PUSP_CONTEXT psContext);
+
+/*
+	Record the digest of the precompiled data and the samplers used by a
+	newly created USP shader
+*/
+IMG_VOID USPCacheSetupShader(PUSP_CONTEXT		psContext,
+							 PUSP_SHADER		psShader,
+							 PUSP_PC_SHADER		psPCShader);
+
+/*
+	Build the key describing how a shader would be finalised with the
+	current context state
+*/
+IMG_BOOL USPCacheBuildKey(PUSP_CONTEXT		psContext,
+						  PUSP_SHADER		psShader,
+						  PUSP_CACHE_KEY	psKey);
+
+/*
+	Lookup (and reference) a previously finalised HW shader
+*/
+PUSP_HW_SHADER USPCacheFindHWShader(PUSP_CONTEXT		psContext,
+									PUSP_CACHE_KEY		psKey);
+
+/*
+	Record a newly created HW shader, optionally adding it to the cache
+*/
+IMG_VOID USPCacheAddHWShader(PUSP_CONTEXT		psContext,
+							 PUSP_CACHE_KEY		psKey,
+							 PUSP_HW_SHADER		psHWShader,
+							 IMG_UINT32			uHWShaderSize);
+
+/*
+	Release a reference to a HW shader
+*/
+IMG_VOID USPCacheReleaseHWShader(PUSP_CONTEXT	psContext,
+								 PUSP_HW_SHADER	psHWShader);
+
+/*
+	Serialise all cached HW shaders
+*/
+IMG_UINT32 USPCacheSerialise(PUSP_CONTEXT	psContext,
+							 IMG_PVOID		pvBuffer,
+							 IMG_UINT32		uBufferSize);
+
+/*
+	Add previously serialised HW shaders to the cache
+*/
+IMG_BOOL USPCacheLoad(PUSP_CONTEXT	psContext,
+					  IMG_PVOID		pvData,
+					  IMG_UINT32	uDataSize);
+
+/*
+	Free all cached HW shaders that are no longer referenced
+*/
+IMG_VOID USPCacheDestroy(PUSP_CONTEXT psContext);
+
+#endif	/* #ifndef _USP_CACHE_H_ */
+/*****************************************************************************
+ End of file (USP_CACHE.H)
+*****************************************************************************/
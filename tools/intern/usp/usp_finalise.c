@@ -2911,11 +2911,17 @@ static IMG_BOOL SetTextureControlWords(PUSP_CONTEXT						psContext,
  Inputs:	psContext	- The current USP execution context
 			psShader	- The USP shader being finalised
 
- Outputs:	none
+ Outputs:	puHWShaderSize	- The size of the HW shader data (in bytes)
 
  Returns:	The created HW shader data, or IMG_NULL on failure
+
+ Notes:		The HW shader is allocated after space for a cache-entry header
+			(see USP_CACHE_ENTRY_FROM_HWSHADER), and all of it is zeroed so
+			that identical shaders have identical data.
 *****************************************************************************/
-IMG_INTERNAL PUSP_HW_SHADER CreateHWShader(PUSP_CONTEXT psContext, PUSP_SHADER psShader)
+IMG_INTERNAL PUSP_HW_SHADER CreateHWShader(PUSP_CONTEXT	psContext,
+										   PUSP_SHADER	psShader,
+										   IMG_PUINT32	puHWShaderSize)
 {
 	static const USP_HW_PSINPUT_COORD aeIteratedDataTypeToHWPSInputCoord[] = 
 	{
@@ -2957,6 +2963,7 @@ IMG_INTERNAL PUSP_HW_SHADER CreateHWShader(PUSP_CONTEXT psContext, PUSP_SHADER p
 	PUSP_PROGDESC			psProgDesc;
 	PUSP_INPUT_DATA			psInputData;
 	PUSP_INSTBLOCK			psLastInstBlock;
+	PUSP_CACHE_ENTRY		psCacheEntry;
 	PUSP_HW_SHADER			psHWShader;
 	PUSP_HW_SAREG_USE		psSARegUse;
 	PUSP_LABEL				psLabel;
@@ -3197,12 +3204,16 @@ IMG_INTERNAL PUSP_HW_SHADER CreateHWShader(PUSP_CONTEXT psContext, PUSP_SHADER p
 	/*
 		Allocate and initialise the top level structure
 	*/
-	psHWShader = (PUSP_HW_SHADER)psContext->pfnAlloc(uAllocSize);
-	if	(!psHWShader)
+	psCacheEntry = (PUSP_CACHE_ENTRY)psContext->pfnAlloc(USP_CACHE_ENTRY_HDR_SIZE + uAllocSize);
+	if	(!psCacheEntry)
 	{
 		USP_DBGPRINT(( "CreateHWShader: Failed to alloc USP_HW_SHADER\n"));
 		goto CreateHWShaderExit;
 	}
+	memset(psCacheEntry, 0, USP_CACHE_ENTRY_HDR_SIZE + uAllocSize);
+
+	psHWShader		= USP_CACHE_HWSHADER_FROM_ENTRY(psCacheEntry);
+	*puHWShaderSize	= uAllocSize;
 
 	psHWShader->uFlags = 0;
 	if	(psProgDesc->uHWFlags & UNIFLEX_HW_FLAGS_TEXKILL_USED)
@@ -3861,7 +3872,7 @@ IMG_INTERNAL PUSP_HW_SHADER CreateHWShader(PUSP_CONTEXT psContext, PUSP_SHADER p
 	{
 		if	(psHWShader)
 		{
-			psContext->pfnFree(psHWShader);
+			psContext->pfnFree(USP_CACHE_ENTRY_FROM_HWSHADER(psHWShader));
 			psHWShader = IMG_NULL;
 		}
 	}
@@ -84,6 +84,9 @@ typedef struct	_USP_SAMPLEUNPACK_			USP_SAMPLEUNPACK,		*PUSP_SAMPLEUNPACK;
 typedef struct	_USP_RESULTREF_				USP_RESULTREF,			*PUSP_RESULTREF;
 typedef struct	_USP_SHADER_				USP_SHADER,				*PUSP_SHADER;
 typedef struct	_USP_TEXTURE_WRITE_			USP_TEXTURE_WRITE,		*PUSP_TEXTURE_WRITE;
+typedef struct	_USP_CACHE_KEY_				USP_CACHE_KEY,			*PUSP_CACHE_KEY;
+typedef struct	_USP_CACHE_ENTRY_			USP_CACHE_ENTRY,		*PUSP_CACHE_ENTRY;
+typedef struct	_USP_CACHE_					USP_CACHE,				*PUSP_CACHE;
 
 #endif	/* #ifndef _USP_TYPEDEFS_H_ */
 /*****************************************************************************
@@ -111,6 +111,84 @@ typedef struct _USP_SAMPLER_CHAN_DESC_
 	IMG_BOOL			bGammaEnabled;
 }USP_SAMPLER_CHAN_DESC, *PUSP_SAMPLER_CHAN_DESC;
 
+/*
+	Number of DWORDs in the digest of a precompiled shader
+*/
+#define USP_CACHE_DIGEST_DWORDS			(4)
+
+/*
+	Maximum size of a finalised-shader cache key: the shader digest, the
+	shader size, the output register-type, the preamble count, the mask of
+	samplers referenced by the shader and a description of each of those
+	samplers.
+*/
+#define USP_CACHE_KEY_FIXED_DWORDS		(USP_CACHE_DIGEST_DWORDS + 4)
+#define USP_CACHE_SAMPLER_DESC_DWORDS	(sizeof(USP_SAMPLER_DESC) / sizeof(IMG_UINT32))
+#define USP_CACHE_MAX_KEY_DWORDS		(USP_CACHE_KEY_FIXED_DWORDS + \
+										 (USP_MAX_SAMPLER_IDX * USP_CACHE_SAMPLER_DESC_DWORDS))
+
+/*
+	Number of hash-chains used to index finalised shaders
+*/
+#define USP_CACHE_HASH_BUCKET_COUNT		(64)
+
+/*
+	Maximum number of finalised shaders kept in the cache once nothing
+	references them any more
+*/
+#define USP_CACHE_MAX_IDLE_ENTRIES		(48)
+
+/*
+	Everything that influences the result of finalising a shader
+*/
+struct _USP_CACHE_KEY_
+{
+	/* Hash of the key data, used to select a hash-chain */
+	IMG_UINT32					uHash;
+
+	/* Number of valid DWORDs in auData */
+	IMG_UINT32					uDataCount;
+
+	/* The key data */
+	IMG_UINT32					auData[USP_CACHE_MAX_KEY_DWORDS];
+};
+
+/*
+	Header placed immediately before every HW shader returned by the USP
+*/
+struct _USP_CACHE_ENTRY_
+{
+	/* The cache that this HW shader is indexed by, or IMG_NULL if not cached */
+	PUSP_CACHE					psCache;
+
+	/* Next entry on the same hash-chain */
+	PUSP_CACHE_ENTRY			psHashNext;
+
+	/* Neighbouring entries in the list of unreferenced cached shaders */
+	PUSP_CACHE_ENTRY			psIdlePrev;
+	PUSP_CACHE_ENTRY			psIdleNext;
+
+	/* Number of outstanding references returned by PVRUniPatchFinaliseShader */
+	IMG_UINT32					uRefCount;
+
+	/* Size (in bytes) of the HW shader data following this header */
+	IMG_UINT32					uHWShaderSize;
+
+	/* The key the HW shader was finalised with */
+	USP_CACHE_KEY				sKey;
+};
+
+/*
+	Offset of a HW shader from the start of its cache entry
+*/
+#define USP_CACHE_ENTRY_HDR_SIZE		((sizeof(USP_CACHE_ENTRY) + 7) & ~7)
+
+#define USP_CACHE_ENTRY_FROM_HWSHADER(psHWShader)	\
+	((PUSP_CACHE_ENTRY)((IMG_PUINT8)(psHWShader) - USP_CACHE_ENTRY_HDR_SIZE))
+
+#define USP_CACHE_HWSHADER_FROM_ENTRY(psEntry)	\
+	((PUSP_HW_SHADER)((IMG_PUINT8)(psEntry) + USP_CACHE_ENTRY_HDR_SIZE))
+
 /*
 	Unipatch execution context
 */
@@ -133,6 +211,9 @@ struct _USP_CONTEXT_
 
 	/* The number of preamble instructions to add at the start of the shader */
 	IMG_UINT32					uPreambleInstCount;
+
+	/* Finalised HW shaders, shared between identically patched shaders */
+	PUSP_CACHE					psCache;
 };
 
 /*
@@ -1200,6 +1281,22 @@ struct _USP_SHADER_
 	*/
 	IMG_UINT32				uTotalSmpTexCtrWrds;
 
+	/*
+		Digest and size of the precompiled data this shader was created from
+	*/
+	IMG_UINT32				auPCShaderDigest[USP_CACHE_DIGEST_DWORDS];
+	IMG_UINT32				uPCShaderSize;
+
+	/*
+		Mask of the samplers whose descriptions are read during finalisation
+	*/
+	IMG_UINT32				uSamplerMask;
+
+	/*
+		Whether HW shaders finalised from this shader can be shared
+	*/
+	IMG_BOOL				bCacheable;
+
 };
 
 /*
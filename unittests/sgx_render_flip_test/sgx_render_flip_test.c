@@ -2099,7 +2099,8 @@ static IMG_VOID srft_WriteSecondaryPixelCode(IMG_UINT32						**ppui32USSECpuVAdd
                             uUSEFragmentHeapBase, SGX_PIXSHADER_USE_CODE_BASE_INDEX);
 
     pui32PDSFragmentBuffer = PDSGeneratePixelShaderSAProgram(psPixelShaderSAProgram,
-                                                             pui32PDSFragmentBuffer);
+                                                             pui32PDSFragmentBuffer,
+                                                             IMG_NULL);
 
     if (bDebugProgramAddrs)
     {
@@ -2293,7 +2294,8 @@ static IMG_VOID srft_WritePrimaryPixelCode(IMG_UINT32				**ppui32USSECpuVAddr,
     */
     pui32PDSFragmentBuffer = PDSGeneratePixelShaderProgram(psTextureImageUnit,
                                                            psPixelShaderProgram,
-                                                           pui32PDSFragmentBuffer);
+                                                           pui32PDSFragmentBuffer,
+                                                           IMG_NULL);
 
     *ppui32USSECpuVAddr = pui32FragmentUSSEBuffer;
     *ppui32PDSCpuVAddr = pui32PDSFragmentBuffer;